@@ -64,15 +64,42 @@ class Element;
 
 #define MAX_FILENAMELENGTH 50
 
-extern double   ops_Dt;                // current delta T for current domain doing an update
+extern thread_local double   ops_Dt;                // current delta T for current domain doing an update
 // extern double  *ops_Gravity;        // gravity factors for current domain undergoing an update
-extern int ops_Creep;
-extern Domain  *ops_TheActiveDomain;   // current domain undergoing an update
-extern Element *ops_TheActiveElement;  // current element undergoing an update
+extern thread_local int ops_Creep;
+extern thread_local Domain  *ops_TheActiveDomain;   // current domain undergoing an update
+extern thread_local Element *ops_TheActiveElement;  // current element undergoing an update
 
 // global variable for initial state analysis
 // added: Chris McGann, University of Washington
-extern bool  ops_InitialStateAnalysis;
+extern thread_local bool  ops_InitialStateAnalysis;
+
+// the globals above are thread local, so analyses of different domains
+// can run in different threads. A thread that opens a parallel region
+// over the work of its domain captures them in an OPS_ThreadGlobals
+// and installs them in each worker thread of the region.
+class OPS_ThreadGlobals
+{
+  public:
+    OPS_ThreadGlobals()
+      :dt(ops_Dt), creep(ops_Creep), domain(ops_TheActiveDomain),
+       element(ops_TheActiveElement), initialState(ops_InitialStateAnalysis) {}
+
+    void install(void) const {
+      ops_Dt = dt;
+      ops_Creep = creep;
+      ops_TheActiveDomain = domain;
+      ops_TheActiveElement = element;
+      ops_InitialStateAnalysis = initialState;
+    }
+
+  private:
+    double dt;
+    int creep;
+    Domain *domain;
+    Element *element;
+    bool initialState;
+};
 
 #define OPS_DISPLAYMODE_MATERIAL_TAG 2
 #define OPS_DISPLAYMODE_ELEMENT_CLASS 3
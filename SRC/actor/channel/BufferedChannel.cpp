@@ -0,0 +1,268 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the implementation of the methods needed
+// to define the BufferedChannel class interface.
+
+#include <BufferedChannel.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+#include <string.h>
+
+BufferedChannel::BufferedChannel(Channel &other, int size)
+    :theChannel(&other), theAddress(0), batchSize(size),
+    sendSize(0), recvSize(0), recvPos(0)
+{
+    if (batchSize < 1024)
+	batchSize = 1024;
+    sendBuffer.resize(batchSize);
+}
+
+
+BufferedChannel::~BufferedChannel()
+{
+    if (sendSize != 0)
+	this->flush();
+}
+
+
+int
+BufferedChannel::flush(void)
+{
+    if (sendSize == 0)
+	return 0;
+
+    static ID header(1);
+    header(0) = sendSize;
+    int res = theChannel->sendID(0, 0, header, theAddress);
+    if (res == 0) {
+	Message theMessage(&sendBuffer[0], sendSize);
+	res = theChannel->sendMsg(0, 0, theMessage, theAddress);
+    }
+    sendSize = 0;
+
+    if (res < 0) {
+	opserr << "BufferedChannel::flush() - failed to send the batch\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+int
+BufferedChannel::append(const char *data, int nbytes, ChannelAddress *address)
+{
+    if (address != 0)
+	theAddress = address;
+
+    if (sendSize + nbytes > batchSize && sendSize != 0)
+	if (this->flush() < 0)
+	    return -1;
+
+    // an object bigger than a batch is sent as a batch of its own
+    if (nbytes > (int)sendBuffer.size())
+	sendBuffer.resize(nbytes);
+
+    memcpy(&sendBuffer[sendSize], data, nbytes);
+    sendSize += nbytes;
+
+    return 0;
+}
+
+
+int
+BufferedChannel::extract(char *data, int nbytes, ChannelAddress *address)
+{
+    // the other process may be waiting for what we have to send
+    if (this->flush() < 0)
+	return -1;
+
+    while (nbytes > 0) {
+	if (recvPos == recvSize) {
+	    static ID header(1);
+	    if (theChannel->recvID(0, 0, header, address) < 0) {
+		opserr << "BufferedChannel::extract() - failed to receive the batch size\n";
+		return -1;
+	    }
+	    recvSize = header(0);
+	    recvPos = 0;
+	    if (recvSize > (int)recvBuffer.size())
+		recvBuffer.resize(recvSize);
+	    Message theMessage(&recvBuffer[0], recvSize);
+	    if (recvSize <= 0 || theChannel->recvMsg(0, 0, theMessage, address) < 0) {
+		opserr << "BufferedChannel::extract() - failed to receive the batch\n";
+		recvSize = 0;
+		return -1;
+	    }
+	}
+
+	int n = recvSize - recvPos;
+	if (n > nbytes)
+	    n = nbytes;
+	memcpy(data, &recvBuffer[recvPos], n);
+	recvPos += n;
+	data += n;
+	nbytes -= n;
+    }
+
+    return 0;
+}
+
+
+char *
+BufferedChannel::addToProgram(void)
+{
+    return theChannel->addToProgram();
+}
+
+
+int
+BufferedChannel::setUpConnection(void)
+{
+    return theChannel->setUpConnection();
+}
+
+
+int
+BufferedChannel::setNextAddress(const ChannelAddress &address)
+{
+    return theChannel->setNextAddress(address);
+}
+
+
+ChannelAddress *
+BufferedChannel::getLastSendersAddress(void)
+{
+    return theChannel->getLastSendersAddress();
+}
+
+
+int
+BufferedChannel::isDatastore(void)
+{
+    return theChannel->isDatastore();
+}
+
+
+int
+BufferedChannel::getDbTag(void)
+{
+    return theChannel->getDbTag();
+}
+
+
+int
+BufferedChannel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *address)
+{
+    if (address != 0)
+	theAddress = address;
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+BufferedChannel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *address)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+BufferedChannel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *address)
+{
+    return this->append(msg.data, msg.length, address);
+}
+
+
+int
+BufferedChannel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *address)
+{
+    return this->extract(msg.data, msg.length, address);
+}
+
+
+int
+BufferedChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *address)
+{
+    opserr << "BufferedChannel::recvMsgUnknownSize() - not implemented\n";
+    return -1;
+}
+
+
+int
+BufferedChannel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *address)
+{
+    return this->append((const char *)theMatrix.data,
+			theMatrix.dataSize*sizeof(double), address);
+}
+
+
+int
+BufferedChannel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *address)
+{
+    return this->extract((char *)theMatrix.data,
+			 theMatrix.dataSize*sizeof(double), address);
+}
+
+
+int
+BufferedChannel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *address)
+{
+    return this->append((const char *)theVector.theData,
+			theVector.sz*sizeof(double), address);
+}
+
+
+int
+BufferedChannel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *address)
+{
+    return this->extract((char *)theVector.theData,
+			 theVector.sz*sizeof(double), address);
+}
+
+
+int
+BufferedChannel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *address)
+{
+    return this->append((const char *)theID.data, theID.sz*sizeof(int), address);
+}
+
+
+int
+BufferedChannel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *address)
+{
+    return this->extract((char *)theID.data, theID.sz*sizeof(int), address);
+}
@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the class definition for BufferedChannel.
+// A BufferedChannel is placed in front of another Channel, e.g. an
+// MPI_Channel or a TCP_Socket, to batch the many small messages the
+// sendSelf()/recvSelf() methods of the objects send one at a time.
+// The sent data is appended to one contiguous buffer which goes through
+// the other channel as a single message, a size then the bytes, when it
+// is full or before anything is received; received data is copied
+// straight from the last batch into the ID, Vector or Matrix. The two
+// processes must both use a BufferedChannel for the same messages.
+
+#ifndef BufferedChannel_h
+#define BufferedChannel_h
+
+#include <Channel.h>
+#include <vector>
+
+class BufferedChannel : public Channel
+{
+  public:
+    BufferedChannel(Channel &theChannel, int batchSize = 4194304);
+    ~BufferedChannel();
+
+    Channel &getChannel(void) {return *theChannel;};
+    int flush(void);
+    
+    char *addToProgram(void);
+    int setUpConnection(void);
+    int setNextAddress(const ChannelAddress &theAddress);
+    ChannelAddress *getLastSendersAddress(void);
+
+    int isDatastore(void);
+    int getDbTag(void);
+
+    int sendObj(int commitTag,
+		MovableObject &theObject, 
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject, 
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+		
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector, ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag, 
+	       const ID &theID, 
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag, 
+	       ID &theID, 
+	       ChannelAddress *theAddress =0);    
+    
+  private:
+    int append(const char *data, int nbytes, ChannelAddress *theAddress);
+    int extract(char *data, int nbytes, ChannelAddress *theAddress);
+
+    Channel *theChannel;
+    ChannelAddress *theAddress;   // where the batches are sent
+    int batchSize;
+
+    std::vector<char> sendBuffer;
+    int sendSize;
+
+    std::vector<char> recvBuffer;
+    int recvSize, recvPos;
+};
+
+#endif
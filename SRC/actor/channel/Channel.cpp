@@ -75,3 +75,34 @@ Channel::recvMsgUnknownSize(int dataTag, int commitTag, Message &, ChannelAddres
     return -1;
 }
 
+int
+Channel::isendVector(int dbTag, int commitTag, const Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->sendVector(dbTag, commitTag, theVector, theAddress);
+}
+
+int
+Channel::irecvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->recvVector(dbTag, commitTag, theVector, theAddress);
+}
+
+int
+Channel::isendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress)
+{
+    return this->sendID(dbTag, commitTag, theID, theAddress);
+}
+
+int
+Channel::irecvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress)
+{
+    return this->recvID(dbTag, commitTag, theID, theAddress);
+}
+
+int
+Channel::waitAll(void)
+{
+    // nothing posted, the default send & recv have completed
+    return 0;
+}
+
@@ -109,6 +109,23 @@ class Channel
 		    ID &theID, 
 		    ChannelAddress *theAddress =0) =0;      
 
+    // methods to post a send/receive and return before it completes; the
+    // data must not be touched until waitAll() returns. the default is the
+    // blocking send/receive, channels that can overlap messages override them.
+    virtual int isendVector(int dbTag, int commitTag, 
+			    const Vector &theVector, 
+			    ChannelAddress *theAddress =0);  
+    virtual int irecvVector(int dbTag, int commitTag, 
+			    Vector &theVector, 
+			    ChannelAddress *theAddress =0);  
+    virtual int isendID(int dbTag, int commitTag, 
+			const ID &theID, 
+			ChannelAddress *theAddress =0);  
+    virtual int irecvID(int dbTag, int commitTag, 
+			ID &theID, 
+			ChannelAddress *theAddress =0);  
+    virtual int waitAll(void);
+
   protected:
     
   private:
@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the implementation of LatencyMonitor.
+
+#include <LatencyMonitor.h>
+#include <math.h>
+#include <chrono>
+
+static double
+monotonicTime(void)
+{
+    return std::chrono::duration<double>(
+	std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+LatencyMonitor::LatencyMonitor()
+    :startTime(0.0), num(0), last(0.0), sum(0.0), sumSq(0.0), max(0.0),
+    stats(5)
+{
+
+}
+
+
+void
+LatencyMonitor::start(void)
+{
+    startTime = monotonicTime();
+}
+
+
+void
+LatencyMonitor::stop(void)
+{
+    this->add(monotonicTime() - startTime);
+}
+
+
+void
+LatencyMonitor::add(double seconds)
+{
+    num++;
+    last = seconds;
+    sum += seconds;
+    sumSq += seconds*seconds;
+    if (seconds > max)
+	max = seconds;
+}
+
+
+void
+LatencyMonitor::reset(void)
+{
+    num = 0;
+    last = sum = sumSq = max = 0.0;
+}
+
+
+const Vector &
+LatencyMonitor::getStats(void)
+{
+    stats.Zero();
+    if (num == 0)
+	return stats;
+
+    double mean = sum/num;
+    double var = sumSq/num - mean*mean;
+
+    stats(0) = num;
+    stats(1) = last;
+    stats(2) = mean;
+    stats(3) = max;
+    stats(4) = (var > 0.0) ? sqrt(var) : 0.0;
+
+    return stats;
+}
@@ -0,0 +1,53 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the class definition for LatencyMonitor.
+// A LatencyMonitor keeps the statistics of the times measured between
+// start() and stop(), e.g. of each exchange of an experimental element
+// with its remote process, so that the latency and its jitter can be
+// recorded for every step of a hybrid simulation.
+
+#ifndef LatencyMonitor_h
+#define LatencyMonitor_h
+
+#include <Vector.h>
+
+class LatencyMonitor
+{
+  public:
+    LatencyMonitor();
+
+    void start(void);
+    void stop(void);
+    void add(double seconds);
+    void reset(void);
+
+    // number, last, mean, maximum & standard deviation (the jitter)
+    // of the times, in seconds
+    const Vector &getStats(void);
+
+  private:
+    double startTime;
+    int num;
+    double last, sum, sumSq, max;
+    Vector stats;
+};
+
+#endif
@@ -493,3 +493,100 @@ MPI_Channel::addToProgram(void)
 }
 
 
+
+
+int
+MPI_Channel::setAddress(ChannelAddress *theAddress, const char *method)
+{
+    if (theAddress == 0)
+      return 0;
+
+    if (theAddress->getType() == MPI_TYPE) {
+      MPI_ChannelAddress *theMPI_ChannelAddress = (MPI_ChannelAddress *)theAddress;
+      otherTag = theMPI_ChannelAddress->otherTag;
+      otherComm= theMPI_ChannelAddress->otherComm;
+      return 0;
+    }
+
+    opserr << "MPI_Channel::" << method << "() - a MPI_Channel ";
+    opserr << "can only communicate with a MPI_Channel";
+    opserr << " address given is not of type MPI_ChannelAddress\n"; 
+    return -1;	    
+}
+
+
+// the posted sends & recvs use the same source, tag and communicator as
+// the blocking ones, so MPI matches them in the order they are posted
+
+int 
+MPI_Channel::isendVector(int dbTag, int commitTag, const Vector &theVector, ChannelAddress *theAddress)
+{	
+    if (this->setAddress(theAddress, "isendVector") < 0)
+      return -1;
+
+    MPI_Request request;
+    MPI_Isend((void *)theVector.theData, theVector.sz, MPI_DOUBLE, otherTag, 0, otherComm, &request);
+    posted.push_back(request);
+
+    return 0;
+}
+
+
+int 
+MPI_Channel::irecvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddress *theAddress)
+{	
+    if (this->setAddress(theAddress, "irecvVector") < 0)
+      return -1;
+
+    MPI_Request request;
+    MPI_Irecv((void *)theVector.theData, theVector.sz, MPI_DOUBLE, otherTag, 0, otherComm, &request);
+    posted.push_back(request);
+
+    return 0;
+}
+
+
+int 
+MPI_Channel::isendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress)
+{	
+    if (this->setAddress(theAddress, "isendID") < 0)
+      return -1;
+
+    MPI_Request request;
+    MPI_Isend((void *)theID.data, theID.sz, MPI_INT, otherTag, 0, otherComm, &request);
+    posted.push_back(request);
+
+    return 0;
+}
+
+
+int 
+MPI_Channel::irecvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress)
+{	
+    if (this->setAddress(theAddress, "irecvID") < 0)
+      return -1;
+
+    MPI_Request request;
+    MPI_Irecv((void *)theID.data, theID.sz, MPI_INT, otherTag, 0, otherComm, &request);
+    posted.push_back(request);
+
+    return 0;
+}
+
+
+int 
+MPI_Channel::waitAll(void)
+{
+    if (posted.empty())
+      return 0;
+
+    int res = MPI_Waitall((int)posted.size(), &posted[0], MPI_STATUSES_IGNORE);
+    posted.clear();
+
+    if (res != MPI_SUCCESS) {
+      opserr << "MPI_Channel::waitAll() - a posted send or recv failed\n";
+      return -1;
+    }
+
+    return 0;
+}
@@ -36,6 +36,7 @@
 
 #include <mpi.h>
 #include <Channel.h>
+#include <vector>
 
 class MPI_Channel : public Channel
 {
@@ -73,13 +74,22 @@ class MPI_Channel : public Channel
     
     int sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress =0);
     int recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress =0);    
+
+    int isendVector(int dbTag, int commitTag, const Vector &theVector, ChannelAddress *theAddress =0);
+    int irecvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddress *theAddress =0);
+    int isendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress =0);
+    int irecvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress =0);
+    int waitAll(void);
     
     
   protected:
 	
   private:
+    int setAddress(ChannelAddress *theAddress, const char *method);
+
     int otherTag;
     MPI_Comm otherComm;    
+    std::vector<MPI_Request> posted;   // requests not yet waited on
 };
 
 
@@ -0,0 +1,366 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the implementation of the methods needed
+// to define the SharedMemoryChannel class interface.
+
+#include <SharedMemoryChannel.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// a slot passes the messages of one direction; the writer waits for its
+// last message to be read, copies the next in and increments seq, the
+// reader waits for seq to pass ack, copies the message out and sets ack
+struct SharedMemorySlot {
+    std::atomic<unsigned long long> seq;
+    std::atomic<unsigned long long> ack;
+    int nbytes;
+    double sendTime;
+};
+
+struct SharedMemoryHeader {
+    std::atomic<int> connected;
+    int capacity;
+};
+
+static const int slotOffset = 64;
+
+static double
+monotonicTime(void)
+{
+    return std::chrono::duration<double>(
+	std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// spins on the flag for the lowest latency, yielding the processor now
+// and then so the other process can run on a busy machine
+static void
+waitFor(int &spins)
+{
+    if (++spins < 4096)
+	return;
+    spins = 0;
+    std::this_thread::yield();
+}
+
+
+SharedMemoryChannel::SharedMemoryChannel(unsigned int port, bool c, int cap)
+    :create(c), capacity(cap), segmentSize(0), segment(0),
+    sendSlot(0), recvSlot(0), lastLatency(0.0)
+{
+    snprintf(name, 32, "/OpenSees.%u", port);
+    if (capacity < 1024)
+	capacity = 1024;
+
+    // header then the two slots, each followed by its data
+    int slotSize = slotOffset + capacity;
+    segmentSize = slotOffset + 2*slotSize;
+}
+
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+#ifndef _WIN32
+    if (segment != 0) {
+	munlock(segment, segmentSize);
+	munmap(segment, segmentSize);
+    }
+    if (create == true)
+	shm_unlink(name);
+#endif
+}
+
+
+char *
+SharedMemoryChannel::addToProgram(void)
+{
+    return name;
+}
+
+
+int
+SharedMemoryChannel::setUpConnection(void)
+{
+#ifdef _WIN32
+    opserr << "SharedMemoryChannel::setUpConnection() - ";
+    opserr << "shared memory channels are not available on Windows\n";
+    return -1;
+#else
+    if (segment != 0)
+	return 0;
+
+    int fd = -1;
+    if (create == true) {
+	shm_unlink(name);
+	fd = shm_open(name, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+	if (fd < 0 || ftruncate(fd, segmentSize) != 0) {
+	    opserr << "SharedMemoryChannel::setUpConnection() - ";
+	    opserr << "could not create shared memory " << name << endln;
+	    if (fd >= 0)
+		close(fd);
+	    return -1;
+	}
+    } else {
+	// the other process may not have created the segment yet
+	while ((fd = shm_open(name, O_RDWR, S_IRUSR | S_IWUSR)) < 0)
+	    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	// nor sized it
+	struct stat info;
+	while (fstat(fd, &info) == 0 && info.st_size < segmentSize)
+	    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    void *ptr = mmap(0, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+	opserr << "SharedMemoryChannel::setUpConnection() - ";
+	opserr << "could not map shared memory " << name << endln;
+	return -2;
+    }
+    segment = (char *)ptr;
+
+    // keep the pages resident, it is not an error if this is not allowed
+    mlock(segment, segmentSize);
+
+    SharedMemoryHeader *header = (SharedMemoryHeader *)segment;
+    SharedMemorySlot *slot0 = (SharedMemorySlot *)(segment + slotOffset);
+    SharedMemorySlot *slot1 = (SharedMemorySlot *)(segment + 2*slotOffset + capacity);
+
+    if (create == true) {
+	new (header) SharedMemoryHeader;
+	new (slot0) SharedMemorySlot;
+	new (slot1) SharedMemorySlot;
+	slot0->seq = 0; slot0->ack = 0; slot0->nbytes = 0;
+	slot1->seq = 0; slot1->ack = 0; slot1->nbytes = 0;
+	header->capacity = capacity;
+	header->connected.store(0);
+
+	// wait for the other process
+	int spins = 0;
+	while (header->connected.load(std::memory_order_acquire) == 0) {
+	    if (spins == 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	    waitFor(spins);
+	}
+
+	sendSlot = slot1;
+	recvSlot = slot0;
+    } else {
+	if (header->capacity != capacity) {
+	    opserr << "SharedMemoryChannel::setUpConnection() - ";
+	    opserr << "the capacity of " << name << " is " << header->capacity;
+	    opserr << " not " << capacity << endln;
+	    return -3;
+	}
+	header->connected.store(1, std::memory_order_release);
+
+	sendSlot = slot0;
+	recvSlot = slot1;
+    }
+
+    return 0;
+#endif
+}
+
+
+int
+SharedMemoryChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+    opserr << "SharedMemoryChannel::setNextAddress() - ";
+    opserr << "a SharedMemoryChannel can only communicate with one other process\n";
+    return -1;
+}
+
+
+int
+SharedMemoryChannel::sendBytes(const char *data, int nbytes)
+{
+    if (sendSlot == 0) {
+	opserr << "SharedMemoryChannel::sendBytes() - no connection\n";
+	return -1;
+    }
+
+    char *buffer = (char *)sendSlot + slotOffset;
+    do {
+	// wait for the last message to be read
+	int spins = 0;
+	unsigned long long seq = sendSlot->seq.load(std::memory_order_relaxed);
+	while (sendSlot->ack.load(std::memory_order_acquire) != seq)
+	    waitFor(spins);
+
+	int n = (nbytes < capacity) ? nbytes : capacity;
+	memcpy(buffer, data, n);
+	sendSlot->nbytes = n;
+	sendSlot->sendTime = monotonicTime();
+	sendSlot->seq.store(seq+1, std::memory_order_release);
+
+	data += n;
+	nbytes -= n;
+    } while (nbytes > 0);
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::recvBytes(char *data, int nbytes)
+{
+    if (recvSlot == 0) {
+	opserr << "SharedMemoryChannel::recvBytes() - no connection\n";
+	return -1;
+    }
+
+    const char *buffer = (const char *)recvSlot + slotOffset;
+    do {
+	// wait for the next message
+	int spins = 0;
+	unsigned long long ack = recvSlot->ack.load(std::memory_order_relaxed);
+	while (recvSlot->seq.load(std::memory_order_acquire) == ack)
+	    waitFor(spins);
+
+	int n = recvSlot->nbytes;
+	if (n > nbytes) {
+	    opserr << "SharedMemoryChannel::recvBytes() - received " << n;
+	    opserr << " bytes, expecting " << nbytes << endln;
+	    recvSlot->ack.store(ack+1, std::memory_order_release);
+	    return -1;
+	}
+	memcpy(data, buffer, n);
+	lastLatency = monotonicTime() - recvSlot->sendTime;
+	recvSlot->ack.store(ack+1, std::memory_order_release);
+
+	data += n;
+	nbytes -= n;
+    } while (nbytes > 0);
+
+    return 0;
+}
+
+
+int
+SharedMemoryChannel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SharedMemoryChannel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SharedMemoryChannel::sendMsg(int dbTag, int commitTag,
+    const Message &msg, ChannelAddress *theAddress)
+{
+    return this->sendBytes(msg.data, msg.length);
+}
+
+
+int
+SharedMemoryChannel::recvMsg(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    return this->recvBytes(msg.data, msg.length);
+}
+
+
+int
+SharedMemoryChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &msg, ChannelAddress *theAddress)
+{
+    opserr << "SharedMemoryChannel::recvMsgUnknownSize() - not implemented\n";
+    return -1;
+}
+
+
+int
+SharedMemoryChannel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theMatrix.data,
+			   theMatrix.dataSize*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theMatrix.data,
+			   theMatrix.dataSize*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theVector.theData,
+			   theVector.sz*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theVector.theData,
+			   theVector.sz*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    return this->sendBytes((const char *)theID.data, theID.sz*sizeof(int));
+}
+
+
+int
+SharedMemoryChannel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    return this->recvBytes((char *)theID.data, theID.sz*sizeof(int));
+}
@@ -0,0 +1,108 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Purpose: This file contains the class definition for
+// SharedMemoryChannel. SharedMemoryChannel is a sub-class of channel
+// for two processes on the same machine, e.g. an experimental element
+// and an adapter element in a real-time hybrid simulation. The data is
+// passed through a POSIX shared memory segment named after the port,
+// with one single-producer single-consumer slot in each direction; a
+// receive spins on the slot's sequence number, so there is no system
+// call on the data path. Each message carries the time it was sent, so
+// the one-way latency of the last received message can be obtained.
+
+#ifndef SharedMemoryChannel_h
+#define SharedMemoryChannel_h
+
+#include <Channel.h>
+
+struct SharedMemorySlot;
+
+class SharedMemoryChannel : public Channel
+{
+  public:
+    // the process creating the segment waits for the one opening it
+    SharedMemoryChannel(unsigned int port, bool create,
+			int capacity = 65536);
+    ~SharedMemoryChannel();
+    
+    char *addToProgram(void);
+    
+    int setUpConnection(void);
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    ChannelAddress *getLastSendersAddress(void) {return 0;};
+
+    int sendObj(int commitTag,
+		MovableObject &theObject, 
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject, 
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+		
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector, ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag, 
+	       const ID &theID, 
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag, 
+	       ID &theID, 
+	       ChannelAddress *theAddress =0);    
+
+    // seconds between the send and the receive of the last message
+    double getLastLatency(void) {return lastLatency;};
+    
+  private:
+    int sendBytes(const char *data, int nbytes);
+    int recvBytes(char *data, int nbytes);
+
+    char name[32];
+    bool create;
+    int capacity;
+    int segmentSize;
+    char *segment;
+    SharedMemorySlot *sendSlot;
+    SharedMemorySlot *recvSlot;
+    double lastLatency;
+};
+
+#endif
@@ -39,6 +39,11 @@
 #include <MovableObject.h>
 #include <SocketAddress.h>
 
+// a send to a peer gone away fails rather than raising SIGPIPE
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
 static int GetHostAddr(char *host, char *IntAddr);
 static void inttoa(unsigned int no, char *string, int *cnt);
 
@@ -507,7 +512,9 @@ TCP_Socket::sendMsg(int dbTag, int commitTag,
     nleft = msg.length;
 
     while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
+        nwrite = send(sockfd,gMsg,nleft,MSG_NOSIGNAL);
+        if (nwrite < 0)
+            return -1;
         nleft -= nwrite;
 
         gMsg +=  nwrite;
@@ -607,7 +614,9 @@ TCP_Socket::sendMatrix(int dbTag, int commitTag,
 #endif
 
     while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
+        nwrite = send(sockfd,gMsg,nleft,MSG_NOSIGNAL);
+        if (nwrite < 0)
+            return -1;
         nleft -= nwrite;
         gMsg +=  nwrite;
     }
@@ -712,7 +721,9 @@ TCP_Socket::sendVector(int dbTag, int commitTag,
 #endif
 
     while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
+        nwrite = send(sockfd,gMsg,nleft,MSG_NOSIGNAL);
+        if (nwrite < 0)
+            return -1;
         nleft -= nwrite;
         gMsg +=  nwrite;
     }
@@ -817,7 +828,9 @@ TCP_Socket::sendID(int dbTag, int commitTag,
 #endif
 
     while (nleft > 0) {
-        nwrite = send(sockfd,gMsg,nleft,0);
+        nwrite = send(sockfd,gMsg,nleft,MSG_NOSIGNAL);
+        if (nwrite < 0)
+            return -1;
         nleft -= nwrite;
         gMsg +=  nwrite;
     }
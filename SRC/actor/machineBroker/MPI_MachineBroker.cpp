@@ -40,7 +40,12 @@ MPI_MachineBroker::MPI_MachineBroker(FEM_ObjectBroker *theBroker, int argc, char
   int flag = 0;
   MPI_Initialized(&flag);
   if (!flag) {
-      MPI_Init(&argc, &argv);
+      // the processes may run OpenMP threads for the element loops, only
+      // the main thread communicates
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+      if (provided < MPI_THREAD_FUNNELED)
+	opserr << "WARNING MPI_MachineBroker - MPI does not support threads, use 1 thread per process\n";
   }
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
@@ -359,6 +359,7 @@
 // element header files
 #include "Element.h"
 #include "truss/Truss.h"
+#include "generic/SuperElement.h"
 #include "truss/Truss2.h"
 #include "truss/TrussSection.h"
 #include "truss/CorotTruss.h"
@@ -625,6 +626,7 @@
 #include "NewtonLineSearch.h"
 #include "KrylovNewton.h"
 #include "AcceleratedNewton.h"
+#include "AdaptiveNewton.h"
 #include "ModifiedNewton.h"
 
 #include "accelerator/KrylovAccelerator.h"
@@ -678,6 +680,7 @@
 #include "KRAlphaExplicit_TP.h"
 #include "Newmark.h"
 #include "StagedNewmark.h"
+#include "ImplicitExplicit.h"
 #include "NewmarkExplicit.h"
 #include "NewmarkHSFixedNumIter.h"
 #include "NewmarkHSIncrLimit.h"
@@ -867,6 +870,9 @@ FEM_ObjectBrokerAllClasses::getNewElement(int classTag)
 	     
     case ELE_TAG_Truss:  
       return new Truss(); 
+
+    case ELE_TAG_SuperElement:
+      return new SuperElement();
       
     case ELE_TAG_Truss2:  
       return new Truss2(); 
@@ -2861,6 +2867,9 @@ FEM_ObjectBrokerAllClasses::getNewEquiSolnAlgo(int classTag)
 
 	case EquiALGORITHM_TAGS_AcceleratedNewton:  
 	     return new AcceleratedNewton();
+
+	case EquiALGORITHM_TAGS_AdaptiveNewton:  
+	     return new AdaptiveNewton();
 	     
 	case EquiALGORITHM_TAGS_ModifiedNewton:  
 	     return new ModifiedNewton(CURRENT_TANGENT);
@@ -3058,6 +3067,9 @@ FEM_ObjectBrokerAllClasses::getNewTransientIntegrator(int classTag)
         case INTEGRATOR_TAGS_StagedNewmark:
         return new StagedNewmark();
 
+        case INTEGRATOR_TAGS_ImplicitExplicit:
+        return new ImplicitExplicit();
+
     case INTEGRATOR_TAGS_NewmarkExplicit:  
 	     return new NewmarkExplicit();
 
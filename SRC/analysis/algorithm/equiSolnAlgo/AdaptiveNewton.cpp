@@ -0,0 +1,325 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of AdaptiveNewton.
+//
+// What: "@(#) AdaptiveNewton.cpp, revA"
+
+#include <AdaptiveNewton.h>
+#include <KrylovAccelerator.h>
+#include <AnalysisModel.h>
+#include <IncrementalIntegrator.h>
+#include <LinearSOE.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <ConvergenceTest.h>
+#include <ID.h>
+#include <elementAPI.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+
+// weight of the latest measurement in the running estimates
+#define ADAPTIVE_NEWTON_WEIGHT 0.5
+
+static double
+wallTime(void)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void* OPS_AdaptiveNewton()
+{
+    // algorithm AdaptiveNewton <-maxDim $m> <-stagnation $ratio> <-secant>
+    int formTangent = CURRENT_TANGENT;
+    int maxDim = 3;
+    double stagnation = 0.8;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* type = OPS_GetString();
+	if (strcmp(type,"-maxDim") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &maxDim) < 0) {
+		opserr << "WARNING AdaptiveNewton failed to read maxDim\n";
+		return 0;
+	    }
+	} else if (strcmp(type,"-stagnation") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetDoubleInput(&numData, &stagnation) < 0) {
+		opserr << "WARNING AdaptiveNewton failed to read stagnation ratio\n";
+		return 0;
+	    }
+	} else if (strcmp(type,"-secant") == 0 || strcmp(type,"-Secant") == 0) {
+	    formTangent = CURRENT_SECANT;
+	}
+    }
+
+    return new AdaptiveNewton(formTangent, maxDim, stagnation);
+}
+
+AdaptiveNewton::AdaptiveNewton(int theTangentToUse, int maxDim, double stag)
+:EquiSolnAlgo(EquiALGORITHM_TAGS_AdaptiveNewton),
+ tangent(theTangentToUse), maxDimension(maxDim), stagnation(stag),
+ theAccelerator(0), vAccel(0),
+ haveFactor(false), refactorNext(true), newtonOnly(false),
+ costNew(0.0), costReuse(0.0), gainNew(0.0), gainReuse(0.0),
+ numFactorizations(0), numIterations(0)
+{
+  theAccelerator = new KrylovAccelerator(maxDimension, NO_TANGENT);
+}
+
+AdaptiveNewton::AdaptiveNewton(ConvergenceTest &theT, int theTangentToUse,
+			       int maxDim, double stag)
+:EquiSolnAlgo(EquiALGORITHM_TAGS_AdaptiveNewton),
+ tangent(theTangentToUse), maxDimension(maxDim), stagnation(stag),
+ theAccelerator(0), vAccel(0),
+ haveFactor(false), refactorNext(true), newtonOnly(false),
+ costNew(0.0), costReuse(0.0), gainNew(0.0), gainReuse(0.0),
+ numFactorizations(0), numIterations(0)
+{
+  theTest = &theT;
+  theAccelerator = new KrylovAccelerator(maxDimension, NO_TANGENT);
+}
+
+AdaptiveNewton::~AdaptiveNewton()
+{
+  if (theAccelerator != 0)
+    delete theAccelerator;
+
+  if (vAccel != 0)
+    delete vAccel;
+}
+
+// updates the estimates with the iteration just done and decides how the
+// next one is to be done: rho is the ratio of the new to the old residual
+// norm and cost the wall time of the iteration
+void
+AdaptiveNewton::choose(bool fresh, double rho, double cost)
+{
+  const double w = ADAPTIVE_NEWTON_WEIGHT;
+
+  // no convergence (or divergence), a factor that is reused would do no
+  // better, so the rest of the step is done with full Newton
+  if (!(rho < stagnation)) {
+    newtonOnly = true;
+    return;
+  }
+
+  if (rho < 1.0e-16)
+    rho = 1.0e-16;
+  double gain = -log(rho);
+
+  if (fresh == true) {
+    costNew = (costNew == 0.0) ? cost : w*cost + (1.0-w)*costNew;
+    gainNew = (gainNew == 0.0) ? gain : w*gain + (1.0-w)*gainNew;
+  } else {
+    costReuse = (costReuse == 0.0) ? cost : w*cost + (1.0-w)*costReuse;
+    gainReuse = (gainReuse == 0.0) ? gain : w*gain + (1.0-w)*gainReuse;
+  }
+
+  // a reuse is tried after each new tangent, after that the factor is
+  // kept as long as it reduces the residual faster per second
+  if (fresh == true || costNew == 0.0 || costReuse == 0.0)
+    refactorNext = false;
+  else
+    refactorNext = (gainNew*costReuse > gainReuse*costNew);
+}
+
+// the factor in the SOE is of the old model, and the equations may be
+// the same in number but not in meaning, so a new tangent is formed
+int
+AdaptiveNewton::domainChanged(void)
+{
+  haveFactor = false;
+  refactorNext = true;
+
+  return this->EquiSolnAlgo::domainChanged();
+}
+
+int
+AdaptiveNewton::solveCurrentStep(void)
+{
+    // set up some pointers and check they are valid
+    AnalysisModel *theAnaModel = this->getAnalysisModelPtr();
+    IncrementalIntegrator *theIntegrator = this->getIncrementalIntegratorPtr();
+    LinearSOE *theSOE = this->getLinearSOEptr();
+
+    if ((theAnaModel == 0) || (theIntegrator == 0) || (theSOE == 0)
+	|| (theTest == 0)){
+	opserr << "WARNING AdaptiveNewton::solveCurrentStep() - setLinks() has";
+	opserr << " not been called - or no ConvergenceTest has been set\n";
+	return -5;
+    }
+
+    int numEqns = theSOE->getNumEqn();
+    if (vAccel == 0 || vAccel->Size() != numEqns) {
+      if (vAccel != 0)
+	delete vAccel;
+      vAccel = new Vector(numEqns);
+      haveFactor = false;
+    }
+
+    // the subspace only holds increments from the current factor
+    theAccelerator->newStep(*theSOE);
+    newtonOnly = false;
+
+    if (theIntegrator->formUnbalance() < 0) {
+      opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+      opserr << "the Integrator failed in formUnbalance()\n";
+      return -2;
+    }
+    double rOld = theSOE->getB().Norm();
+
+    // set itself as the ConvergenceTest objects EquiSolnAlgo
+    theTest->setEquiSolnAlgo(*this);
+    if (theTest->start() < 0) {
+      opserr << "AdaptiveNewton::solveCurrentStep() -";
+      opserr << "the ConvergenceTest object failed in start()\n";
+      return -3;
+    }
+
+    int result = -1;
+    int k = 1;
+
+    do {
+
+      double start = wallTime();
+
+      bool fresh = false;
+      if (newtonOnly == true || refactorNext == true || haveFactor == false) {
+	SOLUTION_ALGORITHM_tangentFlag = tangent;
+	if (theIntegrator->formTangent(tangent) < 0){
+	  opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+	  opserr << "the Integrator failed in formTangent()\n";
+	  return -1;
+	}
+	numFactorizations++;
+	haveFactor = true;
+	fresh = true;
+	theAccelerator->newStep(*theSOE);
+      }
+
+      if (theSOE->solve() < 0) {
+	opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+	opserr << "the LinearSysOfEqn failed in solve()\n";
+	haveFactor = false;
+	return -3;
+      }
+
+      *vAccel = theSOE->getX();
+
+      // a Newton iteration is not accelerated, the subspace is of no use
+      // when the next one forms a new tangent anyway
+      if (newtonOnly == false) {
+	if (theAccelerator->accelerate(*vAccel, *theSOE, *theIntegrator) < 0) {
+	  opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+	  opserr << "the Accelerator failed in accelerate()\n";
+	  return -1;
+	}
+	// restart a full subspace, the factor is kept
+	theAccelerator->updateTangent();
+      }
+
+      if (theIntegrator->update(*vAccel) < 0) {
+	opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+	opserr << "the Integrator failed in update()\n";
+	return -4;
+      }
+
+      if (theIntegrator->formUnbalance() < 0) {
+	opserr << "WARNING AdaptiveNewton::solveCurrentStep() -";
+	opserr << "the Integrator failed in formUnbalance()\n";
+	return -2;
+      }
+      double rNew = theSOE->getB().Norm();
+
+      numIterations++;
+
+      result = theTest->test();
+      if (result == -1 && newtonOnly == false)
+	this->choose(fresh, (rOld > 0.0) ? rNew/rOld : 0.0, wallTime() - start);
+
+      rOld = rNew;
+      this->record(k++);
+
+    } while (result == -1);
+
+    // a failed step usually ends in Newton iterations, it is retried
+    // (e.g. with a smaller increment) with the same choice
+    if (newtonOnly == true)
+      refactorNext = true;
+
+    if (result == -2) {
+      opserr << "AdaptiveNewton::solveCurrentStep() -";
+      opserr << "the ConvergenceTest object failed in test()\n";
+      return -3;
+    }
+
+    // note - if postive result we are returning what the convergence test returned
+    // which should be the number of iterations
+    return result;
+}
+
+int
+AdaptiveNewton::sendSelf(int cTag, Channel &theChannel)
+{
+  static Vector data(3);
+  data(0) = tangent;
+  data(1) = maxDimension;
+  data(2) = stagnation;
+  return theChannel.sendVector(this->getDbTag(), cTag, data);
+}
+
+int
+AdaptiveNewton::recvSelf(int cTag,
+			 Channel &theChannel,
+			 FEM_ObjectBroker &theBroker)
+{
+  static Vector data(3);
+  int res = theChannel.recvVector(this->getDbTag(), cTag, data);
+  if (res < 0) {
+    opserr << "AdaptiveNewton::recvSelf() - failed to recv data\n";
+    return res;
+  }
+  tangent = int(data(0));
+  maxDimension = int(data(1));
+  stagnation = data(2);
+
+  if (theAccelerator != 0)
+    delete theAccelerator;
+  theAccelerator = new KrylovAccelerator(maxDimension, NO_TANGENT);
+
+  haveFactor = false;
+  refactorNext = true;
+  return 0;
+}
+
+void
+AdaptiveNewton::Print(OPS_Stream &s, int flag)
+{
+  if (flag == 0) {
+    s << "AdaptiveNewton" << endln;
+    s << "\tMax subspace dimension: " << maxDimension << endln;
+    s << "\tStagnation ratio: " << stagnation << endln;
+    s << "\tFactorizations: " << numFactorizations;
+    s << " in " << numIterations << " iterations" << endln;
+    s << "\tEstimated cost of a new tangent: " << costNew;
+    s << " s, of a reused factor: " << costReuse << " s" << endln;
+  }
+}
@@ -0,0 +1,86 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef AdaptiveNewton_h
+#define AdaptiveNewton_h
+
+// Description: This file contains the class definition for
+// AdaptiveNewton. AdaptiveNewton chooses at every iteration between
+// forming and factoring a new tangent (a Newton iteration) and reusing
+// the factor already in the LinearSOE with Krylov subspace acceleration
+// (a KrylovNewton iteration). The choice compares the residual reduction
+// per second of wall time measured for each kind of iteration, so it
+// follows the relative cost of a factorization as the analysis goes on;
+// these estimates and the factor are carried from step to step. If the
+// residual stagnates the step finishes with full Newton iterations.
+//
+// What: "@(#) AdaptiveNewton.h, revA"
+
+#include <EquiSolnAlgo.h>
+#include <Vector.h>
+
+class KrylovAccelerator;
+
+class AdaptiveNewton: public EquiSolnAlgo
+{
+  public:
+    AdaptiveNewton(int tangent = CURRENT_TANGENT, int maxDim = 3,
+		   double stagnation = 0.8);
+    AdaptiveNewton(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT,
+		   int maxDim = 3, double stagnation = 0.8);
+    ~AdaptiveNewton();
+
+    int solveCurrentStep(void);
+    int domainChanged(void);
+
+    int getNumFactorizations(void) {return numFactorizations;}
+    int getNumIterations(void) {return numIterations;}
+
+    virtual int sendSelf(int commitTag, Channel &theChannel);
+    virtual int recvSelf(int commitTag, Channel &theChannel,
+			 FEM_ObjectBroker &theBroker);
+    void Print(OPS_Stream &s, int flag =0);
+
+  protected:
+
+  private:
+    void choose(bool fresh, double rho, double cost);
+
+    int tangent;
+    int maxDimension;
+    double stagnation;      // residual ratio taken as stagnation
+
+    KrylovAccelerator *theAccelerator;
+    Vector *vAccel;
+
+    bool haveFactor;        // the SOE holds a factor that can be reused
+    bool refactorNext;      // the next iteration forms a new tangent
+    bool newtonOnly;        // full Newton for the rest of the step
+
+    // running estimates of the cost (s) and of -log(residual ratio)
+    // of an iteration with a new tangent and of one reusing the factor
+    double costNew, costReuse;
+    double gainNew, gainReuse;
+
+    int numFactorizations;
+    int numIterations;
+};
+
+#endif
@@ -127,7 +127,7 @@ BisectionLineSearch::search(double s0,
       return -1;
     }
     
-    if (theIntegrator.formUnbalance() < 0) {
+    if (theIntegrator.formTrialUnbalance(etaJ) < 0) {
       opserr << "WARNING BisectionLineSearch::search() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
@@ -156,7 +156,7 @@ BisectionLineSearch::search(double s0,
     theSOE.setX(*x);
     *x *= -compoundFactor;
     theIntegrator.update(*x);
-    theIntegrator.formUnbalance();
+    theIntegrator.formTrialUnbalance(1.0);
     return 0; 
   }
 
@@ -191,7 +191,7 @@ BisectionLineSearch::search(double s0,
       return -1;
     }
     
-    if (theIntegrator.formUnbalance() < 0) {
+    if (theIntegrator.formTrialUnbalance(eta) < 0) {
       opserr << "WARNING BisectionLineSearch::search() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
@@ -44,6 +44,7 @@
 #include <IncrementalIntegrator.h>
 #include <LinearSOE.h>
 #include <ConvergenceTest.h>
+#include <AnalysisProfiler.h>
 
 EquiSolnAlgo::EquiSolnAlgo(int clasTag)
 :SolutionAlgorithm(clasTag),
@@ -109,5 +110,24 @@ EquiSolnAlgo::getLinearSOEptr(void) const
 {
     return theSysOfEqn;
 }
+
+
+
+int
+EquiSolnAlgo::updateIntegrator(IncrementalIntegrator *theIncIntegrator,
+			       const Vector &deltaU)
+{
+    ProfilePhase phase(AnalysisProfiler::IntegratorUpdate);
+    return theIncIntegrator->update(deltaU);
+}
+
+
+
+int
+EquiSolnAlgo::testConvergence(void)
+{
+    ProfilePhase phase(AnalysisProfiler::ConvergenceTest);
+    return theTest->test();
+}
     
 
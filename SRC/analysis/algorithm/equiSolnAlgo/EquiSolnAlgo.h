@@ -83,6 +83,12 @@ class EquiSolnAlgo: public SolutionAlgorithm
     LinearSOE	            *getLinearSOEptr(void) const;
 
   protected:
+    // the integrator update & the convergence test, each timed as its
+    // phase by the AnalysisProfiler
+    int updateIntegrator(IncrementalIntegrator *theIncIntegrator,
+			 const Vector &deltaU);
+    int testConvergence(void);
+
     ConvergenceTest *theTest;
     
   private:
@@ -133,7 +133,7 @@ InitialInterpolatedLineSearch::search(double s0,
       return -1;
     }
     
-    if (theIntegrator.formUnbalance() < 0) {
+    if (theIntegrator.formTrialUnbalance(eta) < 0) {
       opserr << "WARNInG InitialInterpolatedLineSearch::search() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
@@ -200,7 +200,7 @@ KrylovNewton::solveCurrentStep(void)
     }		    
 
     // Update system with v_k
-    if (theIntegrator->update(*(v[dim])) < 0) {
+    if (this->updateIntegrator(theIntegrator, *(v[dim])) < 0) {
       opserr << "WARNING KrylovNewton::solveCurrentStep() -";
       opserr << "the Integrator failed in update()\n";	
       return -4;
@@ -216,7 +216,7 @@ KrylovNewton::solveCurrentStep(void)
     // Increase current dimension of Krylov subspace
     dim++;
 
-    result = theTest->test();
+    result = this->testConvergence();
     this->record(k++);
 
   } while (result == -1);
@@ -130,7 +130,7 @@ Linear::solveCurrentStep(void)
 
     const Vector &deltaU = theSOE->getX();
 
-    if (theIncIntegrator->update(deltaU) < 0) {
+    if (this->updateIntegrator(theIncIntegrator, deltaU) < 0) {
 	opserr << "WARNING Linear::solveCurrentStep() -";
 	opserr << "the Integrator failed in update()\n";	
 	return -4;
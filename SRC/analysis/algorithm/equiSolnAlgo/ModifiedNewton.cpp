@@ -166,7 +166,7 @@ ModifiedNewton::solveCurrentStep(void)
 	//timer2.pause();
 	//opserr << "TIMER::SOLVE()- " << timer2;
 	
-	if (theIncIntegratorr->update(theSOE->getX()) < 0) {
+	if (this->updateIntegrator(theIncIntegratorr, theSOE->getX()) < 0) {
 	    opserr << "WARNING ModifiedNewton::solveCurrentStep() -";
 	    opserr << "the Integrator failed in update()\n";	
 	    return -4;
@@ -179,7 +179,7 @@ ModifiedNewton::solveCurrentStep(void)
 	}	
 
 	this->record(numIterations++);
-	result = theTest->test();
+	result = this->testConvergence();
 
 
     } while (result == -1);
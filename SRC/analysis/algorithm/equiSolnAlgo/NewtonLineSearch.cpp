@@ -44,16 +44,17 @@
 //Null Constructor
 NewtonLineSearch::NewtonLineSearch( )
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonLineSearch),
- theTest(0), theOtherTest(0), theLineSearch(0)
+ theTest(0), theOtherTest(0), theLineSearch(0), reducedSearch(false)
 {   
 }
 
 
 //Constructor 
 NewtonLineSearch::NewtonLineSearch( ConvergenceTest &theT, 
-				   LineSearch *theSearch) 
+				   LineSearch *theSearch,
+				   bool reduced) 
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonLineSearch),
- theTest(&theT), theLineSearch(theSearch)
+ theTest(&theT), theLineSearch(theSearch), reducedSearch(reduced)
 {
   theOtherTest = theTest->getCopy(10);
   theOtherTest->setEquiSolnAlgo(*this);
@@ -140,7 +141,7 @@ NewtonLineSearch::solveCurrentStep(void)
 	//initial value of s
 	double s0 = - (dx0 ^ Resid0) ; 
 
-	if (theIntegrator->update(theSOE->getX()) < 0) {
+	if (this->updateIntegrator(theIntegrator, theSOE->getX()) < 0) {
 	    opserr << "WARNING NewtonLineSearch::solveCurrentStep() -";
 	    opserr << "the Integrator failed in update()\n";	
 	    return -4;
@@ -163,13 +164,23 @@ NewtonLineSearch::solveCurrentStep(void)
 	  //new value of s 
 	  double s = - ( dx0 ^ Resid ) ;
 	  
-	  if (theLineSearch != 0)
+	  if (theLineSearch != 0) {
+	    if (reducedSearch == true)
+	      theIntegrator->beginReducedUnbalance(dx0);
+
 	    theLineSearch->search(s0, s, *theSOE, *theIntegrator);
+
+	    if (reducedSearch == true && theIntegrator->endReducedUnbalance() < 0) {
+	      opserr << "WARNING NewtonLineSearch::solveCurrentStep() -";
+	      opserr << "the Integrator failed in endReducedUnbalance()\n";
+	      return -4;
+	    }
+	  }
 	}
 
 	this->record(0);
 	  
-	result = theTest->test();
+	result = this->testConvergence();
 
     } while (result == -1);
 
@@ -193,8 +204,9 @@ NewtonLineSearch::getConvergenceTest(void)
 int
 NewtonLineSearch::sendSelf(int cTag, Channel &theChannel)
 {
-  static ID data(1);
+  static ID data(2);
   data(0) = theLineSearch->getClassTag();
+  data(1) = reducedSearch == true ? 1 : 0;
   if (theChannel.sendID(0, cTag, data) < 0) {
     opserr << "NewtonLineSearch::sendSelf(int cTag, Channel &theChannel)   - failed to send date\n";
     return -1;
@@ -213,13 +225,14 @@ NewtonLineSearch::recvSelf(int cTag,
 			Channel &theChannel, 
 			FEM_ObjectBroker &theBroker)
 {
-  static ID data(1);
+  static ID data(2);
   if (theChannel.recvID(0, cTag, data) < 0) {
     opserr << "NewtonLineSearch::recvSelf(int cTag, Channel &theChannel) - failed to recv data\n";
     return -1;
   }
 
   int lineSearchClassTag = data(0);
+  reducedSearch = (data(1) == 1);
 
   if (theLineSearch == 0 || theLineSearch->getClassTag() != lineSearchClassTag) {
     if (theLineSearch != 0)
@@ -247,6 +260,8 @@ NewtonLineSearch::Print(OPS_Stream &s, int flag)
 {
   if (flag == 0) 
     s << "NewtonLineSearch\n";
+  if (flag == 0 && reducedSearch == true)
+    s << "  trial points evaluate only the elements without a constant tangent\n";
 
   if (theLineSearch != 0)
     theLineSearch->Print(s, flag);
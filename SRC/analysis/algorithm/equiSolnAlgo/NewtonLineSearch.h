@@ -45,7 +45,8 @@ class NewtonLineSearch: public EquiSolnAlgo
 {
   public:
     NewtonLineSearch( );    
-    NewtonLineSearch(ConvergenceTest &theTest, LineSearch *theLineSearch);
+    NewtonLineSearch(ConvergenceTest &theTest, LineSearch *theLineSearch,
+		     bool reducedSearch = false);
     ~NewtonLineSearch( );
 
     int solveCurrentStep(void);    
@@ -64,6 +65,10 @@ class NewtonLineSearch: public EquiSolnAlgo
     ConvergenceTest *theTest;
     ConvergenceTest *theOtherTest;
     LineSearch *theLineSearch;
+
+    // the trial points of the search evaluate only the elements whose
+    // tangent is not constant, see IncrementalIntegrator
+    bool reducedSearch;
 };
 
 #endif
@@ -48,6 +48,7 @@
 #include <ConvergenceTest.h>
 #include <ID.h>
 #include <elementAPI.h>
+#include <LogCategory.h>
 #include <string>
 
 
@@ -56,10 +57,13 @@ void* OPS_NewtonRaphsonAlgorithm()
     int formTangent = CURRENT_TANGENT;
     double iFactor = 0;
     double cFactor = 1;
+    bool fused = false;
 
     while (OPS_GetNumRemainingInputArgs() > 0) {
       const char* type = OPS_GetString();
-      if(strcmp(type,"-secant")==0 || strcmp(type,"-Secant")==0) {
+      if(strcmp(type,"-fused")==0) {
+	fused = true;
+      } else if(strcmp(type,"-secant")==0 || strcmp(type,"-Secant")==0) {
 	formTangent = CURRENT_SECANT;
 	iFactor = 0;
 	cFactor = 1.0;
@@ -88,29 +92,29 @@ void* OPS_NewtonRaphsonAlgorithm()
       }
     }
 
-    return new NewtonRaphson(formTangent, iFactor, cFactor);
+    return new NewtonRaphson(formTangent, iFactor, cFactor, fused);
 
 }
 
 // Constructor
-NewtonRaphson::NewtonRaphson(int theTangentToUse, double iFact, double cFact)
+NewtonRaphson::NewtonRaphson(int theTangentToUse, double iFact, double cFact, bool fusedPass)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), fused(fusedPass)
 {
 
 }
 
 NewtonRaphson::NewtonRaphson()
 	:EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
-	tangent(CURRENT_TANGENT), iFactor(0.), cFactor(1.)
+	tangent(CURRENT_TANGENT), iFactor(0.), cFactor(1.), fused(false)
 {
 
 }
 
 
-NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact)
+NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact, bool fusedPass)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse), iFactor(iFact), cFactor(cFact)
+ tangent(theTangentToUse), iFactor(iFact), cFactor(cFact), fused(fusedPass)
 {
 
 }
@@ -140,9 +144,24 @@ NewtonRaphson::solveCurrentStep(void)
 	return -5;
     }	
 
-    if (theIntegrator->formUnbalance() < 0) {
-      opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-      opserr << "the Integrator failed in formUnbalance()\n";	
+    // in the fused mode the tangent for the coming iteration is formed in
+    // the same pass as the unbalance, at the cost of one unused tangent
+    // in the pass that converges
+    int firstTangent = (tangent == INITIAL_THEN_CURRENT_TANGENT) ? INITIAL_TANGENT : tangent;
+    int nextTangent = (tangent == INITIAL_THEN_CURRENT_TANGENT) ? CURRENT_TANGENT : tangent;
+
+    if (fused == true) {
+      SOLUTION_ALGORITHM_tangentFlag = firstTangent;
+      if (theIntegrator->formUnbalanceAndTangent(firstTangent, iFactor, cFactor) < 0) {
+	OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	  << "WARNING NewtonRaphson::solveCurrentStep() -"
+	  << "the Integrator failed in formUnbalanceAndTangent()\n";
+	return -2;
+      }	    
+    } else if (theIntegrator->formUnbalance() < 0) {
+      OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+        << "WARNING NewtonRaphson::solveCurrentStep() -"
+        << "the Integrator failed in formUnbalance()\n";
       return -2;
     }	    
 
@@ -159,19 +178,23 @@ NewtonRaphson::solveCurrentStep(void)
 
     do {
 
-      if (tangent == INITIAL_THEN_CURRENT_TANGENT) {
+      if (fused == true) {
+	; // formed with the unbalance
+      } else if (tangent == INITIAL_THEN_CURRENT_TANGENT) {
 	if (numIterations == 0) {
 	  SOLUTION_ALGORITHM_tangentFlag = INITIAL_TANGENT;
 	  if (theIntegrator->formTangent(INITIAL_TANGENT) < 0){
-	    opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	    opserr << "the Integrator failed in formTangent()\n";
+	    OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	      << "WARNING NewtonRaphson::solveCurrentStep() -"
+	      << "the Integrator failed in formTangent()\n";
 	    return -1;
 	  } 
 	} else {
 	  SOLUTION_ALGORITHM_tangentFlag = CURRENT_TANGENT;
 	  if (theIntegrator->formTangent(CURRENT_TANGENT) < 0){
-	    opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	    opserr << "the Integrator failed in formTangent()\n";
+	    OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	      << "WARNING NewtonRaphson::solveCurrentStep() -"
+	      << "the Integrator failed in formTangent()\n";
 	    return -1;
 	  } 
 	}
@@ -179,29 +202,42 @@ NewtonRaphson::solveCurrentStep(void)
 	
 	SOLUTION_ALGORITHM_tangentFlag = tangent;
 	if (theIntegrator->formTangent(tangent, iFactor, cFactor) < 0){
-	    opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	    opserr << "the Integrator failed in formTangent()\n";
+	    OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	      << "WARNING NewtonRaphson::solveCurrentStep() -"
+	      << "the Integrator failed in formTangent()\n";
 	    return -1;
 	}		    
       } 
       if (theSOE->solve() < 0) {
-	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	opserr << "the LinearSysOfEqn failed in solve()\n";	
+	OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	  << "WARNING NewtonRaphson::solveCurrentStep() -"
+	  << "the LinearSysOfEqn failed in solve()\n";
 	return -3;
       }	    
 
-      if (theIntegrator->update(theSOE->getX()) < 0) {
-	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	opserr << "the Integrator failed in update()\n";	
+      if (this->updateIntegrator(theIntegrator, theSOE->getX()) < 0) {
+	OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	  << "WARNING NewtonRaphson::solveCurrentStep() -"
+	  << "the Integrator failed in update()\n";
 	return -4;
       }	        
-      if (theIntegrator->formUnbalance() < 0) {
-	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
-	opserr << "the Integrator failed in formUnbalance()\n";	
+
+      if (fused == true) {
+	SOLUTION_ALGORITHM_tangentFlag = nextTangent;
+	if (theIntegrator->formUnbalanceAndTangent(nextTangent, iFactor, cFactor) < 0) {
+	  OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	    << "WARNING NewtonRaphson::solveCurrentStep() -"
+	    << "the Integrator failed in formUnbalanceAndTangent()\n";
+	  return -2;
+	}	
+      } else if (theIntegrator->formUnbalance() < 0) {
+	OPS_WARNING("NewtonRaphson::solveCurrentStep", "failed")
+	  << "WARNING NewtonRaphson::solveCurrentStep() -"
+	  << "the Integrator failed in formUnbalance()\n";
 	return -2;
       }	
 
-      result = theTest->test();
+      result = this->testConvergence();
        numIterations++;
       this->record(numIterations);
 
@@ -222,10 +258,11 @@ NewtonRaphson::solveCurrentStep(void)
 int
 NewtonRaphson::sendSelf(int cTag, Channel &theChannel)
 {
-  static Vector data(3);
+  static Vector data(4);
   data(0) = tangent;
   data(1) = iFactor;
   data(2) = cFactor;
+  data(3) = fused ? 1.0 : 0.0;
   return theChannel.sendVector(this->getDbTag(), cTag, data);
 }
 
@@ -234,11 +271,12 @@ NewtonRaphson::recvSelf(int cTag,
 			Channel &theChannel, 
 			FEM_ObjectBroker &theBroker)
 {
-  static Vector data(3);
+  static Vector data(4);
   theChannel.recvVector(this->getDbTag(), cTag, data);
   tangent = int(data(0));
   iFactor = data(1);
   cFactor = data(2);
+  fused = (data(3) != 0.0);
   return 0;
 }
 
@@ -49,8 +49,8 @@ class NewtonRaphson: public EquiSolnAlgo
 {
   public:
   NewtonRaphson();
-  NewtonRaphson(int tangent, double iFactor = 0.0, double cFactor = 1.0);    
-  NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0);
+  NewtonRaphson(int tangent, double iFactor = 0.0, double cFactor = 1.0, bool fused = false);    
+  NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT, double iFactor = 0.0, double cFactor = 1.0, bool fused = false);
   ~NewtonRaphson();
   
   int solveCurrentStep(void);    
@@ -71,6 +71,8 @@ class NewtonRaphson: public EquiSolnAlgo
   
   double iFactor;
   double cFactor;
+
+  bool fused;   // the unbalance & the next tangent are formed in one pass
 };
 
 #endif
@@ -130,7 +130,7 @@ SecantLineSearch::search(double s0,
       return -1;
     }
     
-    if (theIntegrator.formUnbalance() < 0) {
+    if (theIntegrator.formTrialUnbalance(eta) < 0) {
       opserr << "WARNING SecantLineSearch::search() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
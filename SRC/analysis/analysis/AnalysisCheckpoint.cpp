@@ -0,0 +1,108 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// AnalysisCheckpoint.
+
+#include <AnalysisCheckpoint.h>
+#include <CheckpointDatastore.h>
+#include <Domain.h>
+#include <OPS_Globals.h>
+#include <math.h>
+
+AnalysisCheckpoint::AnalysisCheckpoint(Domain &domain, CheckpointDatastore *datastore,
+				       int nSteps, double minutes)
+  :theDomain(&domain), theDatastore(datastore),
+   everySteps(nSteps), everySeconds(60.0*minutes),
+   numSteps(0), lastSave(std::chrono::steady_clock::now())
+{
+
+}
+
+
+AnalysisCheckpoint::~AnalysisCheckpoint()
+{
+  if (theDatastore != 0)
+    delete theDatastore;
+}
+
+
+int
+AnalysisCheckpoint::stepDone(void)
+{
+  numSteps++;
+
+  bool due = (everySteps > 0 && numSteps >= everySteps);
+  if (due == false && everySeconds > 0.0) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - lastSave;
+    due = (elapsed.count() >= everySeconds);
+  }
+
+  if (due == false)
+    return 0;
+
+  return this->save();
+}
+
+
+int
+AnalysisCheckpoint::save(void)
+{
+  numSteps = 0;
+  lastSave = std::chrono::steady_clock::now();
+
+  if (theDatastore->commitState(theDomain->getCommitTag()) < 0) {
+    opserr << "WARNING AnalysisCheckpoint::save() - failed to save the domain at time ";
+    opserr << theDomain->getCurrentTime() << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+AnalysisCheckpoint::resume(double dT)
+{
+  int commitTag = theDatastore->getLastCommitTag();
+  if (commitTag < 0) {
+    opserr << "AnalysisCheckpoint::resume() - no checkpoint found, the analysis starts from the beginning\n";
+    return 0;
+  }
+
+  double startTime = theDomain->getCurrentTime();
+
+  if (theDomain->restoreState(*theDatastore, commitTag) < 0) {
+    opserr << "WARNING AnalysisCheckpoint::resume() - failed to restore the checkpoint of commitTag ";
+    opserr << commitTag << endln;
+    return -1;
+  }
+
+  double time = theDomain->getCurrentTime();
+  opserr << "AnalysisCheckpoint::resume() - restored the checkpoint at time " << time << endln;
+
+  numSteps = 0;
+  lastSave = std::chrono::steady_clock::now();
+
+  if (dT <= 0.0 || time <= startTime)
+    return 0;
+
+  return (int)floor((time - startTime)/dT + 0.5);
+}
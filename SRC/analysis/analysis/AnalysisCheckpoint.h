@@ -0,0 +1,65 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef AnalysisCheckpoint_h
+#define AnalysisCheckpoint_h
+
+// Description: This file contains the class definition for
+// AnalysisCheckpoint. An AnalysisCheckpoint saves the domain into a
+// CheckpointDatastore every so many converged steps of a
+// DirectIntegrationAnalysis and/or every so many minutes of wall clock
+// time, so that a long run killed part way can be picked up again with
+// resume(). The analysis only holds a pointer to it; the checkpoint owns
+// its datastore.
+//
+// What: "@(#) AnalysisCheckpoint.h, revA"
+
+#include <chrono>
+
+class Domain;
+class CheckpointDatastore;
+
+class AnalysisCheckpoint
+{
+  public:
+    // everySteps or everyMinutes <= 0 is not used as a trigger
+    AnalysisCheckpoint(Domain &theDomain, CheckpointDatastore *theDatastore,
+		       int everySteps, double everyMinutes);
+    ~AnalysisCheckpoint();
+
+    // invoked after each converged step, saves when one is due
+    int stepDone(void);
+    int save(void);
+
+    // restores the latest checkpoint, if any, and returns the number of
+    // steps of size dT between the time of the domain before and after
+    int resume(double dT);
+
+  private:
+    Domain *theDomain;
+    CheckpointDatastore *theDatastore;
+    int everySteps;
+    double everySeconds;
+
+    int numSteps;                  // converged steps since the last save
+    std::chrono::steady_clock::time_point lastSave;
+};
+
+#endif
@@ -38,15 +38,19 @@
 #include <FE_EleIter.h>
 
 #include <DirectIntegrationAnalysis.h>
+#include <StepRetryPolicy.h>
+#include <AnalysisCheckpoint.h>
 #include <EquiSolnAlgo.h>
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
+#include <LinearSOESolver.h>
 #include <EigenSOE.h>
 #include <DOF_Numberer.h>
 #include <ConstraintHandler.h>
 #include <ConvergenceTest.h>
 #include <TransientIntegrator.h>
 #include <Domain.h>
+#include <AnalysisMetrics.h>
 
 #include <FE_Element.h>
 #include <DOF_Group.h>
@@ -78,6 +82,8 @@ DirectIntegrationAnalysis::DirectIntegrationAnalysis(Domain &the_Domain,
  theEigenSOE(0),
  theIntegrator(&theTransientIntegrator), 
  theTest(theConvergenceTest),
+ theRetryPolicy(0), theCheckpoint(0),
+ theAsyncEigenSOE(0), asyncDone(false), asyncNumMode(0), asyncResult(0),
  domainStamp(0),
  numSubLevels(num_SubLevels),
  numSubSteps(num_SubSteps)
@@ -103,12 +109,18 @@ DirectIntegrationAnalysis::~DirectIntegrationAnalysis()
   // we don't invoke the destructors in case user switching
   // from a static to a direct integration analysis 
   // clearAll() must be invoked if user wishes to invoke destructor
+  if (eigenThread.joinable())
+    eigenThread.join();
 }    
 
 void
 DirectIntegrationAnalysis::clearAll(void)
 {
   // invoke the destructor on all the objects in the aggregation
+  if (eigenThread.joinable())
+    eigenThread.join();
+  if (theAsyncEigenSOE != 0)
+    delete theAsyncEigenSOE;
   if (theAnalysisModel != 0)     
     delete theAnalysisModel;
   if (theConstraintHandler != 0) 
@@ -125,16 +137,21 @@ DirectIntegrationAnalysis::clearAll(void)
     delete theEigenSOE;
   if (theTest != 0)
     delete theTest;
-
-
-    theAnalysisModel =0;
-    theConstraintHandler =0;
-    theDOF_Numberer =0;
-    theIntegrator =0;
-    theAlgorithm =0;
-    theSOE =0;
-    theEigenSOE =0;
-    theTest =0;
+  if (theRetryPolicy != 0)
+    delete theRetryPolicy;
+
+
+  theAnalysisModel =0;
+  theConstraintHandler =0;
+  theDOF_Numberer =0;
+  theIntegrator =0;
+  theAlgorithm =0;
+  theSOE =0;
+  theEigenSOE =0;
+  theAsyncEigenSOE =0;
+  theTest =0;
+  theRetryPolicy =0;
+  theCheckpoint =0;
 }    
 
 #include <NodeIter.h>
@@ -148,8 +165,9 @@ DirectIntegrationAnalysis::initialize(void)
     // check if domain has undergone change
     int stamp = the_Domain->hasDomainChanged();
     if (stamp != domainStamp) {
+      int lastStamp = domainStamp;
       domainStamp = stamp;	
-      if (this->domainChanged() < 0) {
+      if (this->handleDomainChange(lastStamp) < 0) {
 	opserr << "DirectIntegrationAnalysis::initialize() - domainChanged() failed\n";
 	return -1;
       }	
@@ -168,18 +186,27 @@ int
 DirectIntegrationAnalysis::analyze(int numSteps, double dT, bool flush)
 {
   int result = 0;
+  Domain *the_Domain = this->getDomainPtr();
 
   for (int i=0; i<numSteps; i++) {
+    double tStart = the_Domain->getCurrentTime();
     result = this->analyzeStep(dT);
     if (result < 0) {
       if (numSubLevels != 0)
 	result = this->analyzeSubLevel(1, dT);
-      if (result < 0)
-	return result;
+      // the sub-levels keep the substeps that converged, only the rest of
+      // dT is retried
+      if (result < 0 && theRetryPolicy != 0)
+	result = this->retryStep(tStart + dT - the_Domain->getCurrentTime());
     }
+    if (AnalysisMetrics::isEnabled())
+      AnalysisMetrics::stepDone(this->getDomainPtr(), theAlgorithm, result >= 0);
+    if (result < 0)
+      return result;
+    if (theCheckpoint != 0)
+      theCheckpoint->stepDone();
   }
 
-  Domain *the_Domain = this->getDomainPtr();
   if (the_Domain != 0 && flush) {
     the_Domain->flushRecorders();
   }
@@ -193,6 +220,10 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
   int result = 0;
   Domain *the_Domain = this->getDomainPtr();
 
+  // a background eigen analysis that is done gets its results set
+  if (eigenThread.joinable() && asyncDone)
+    this->eigenWait();
+
   if (theAnalysisModel->analysisStep(dT) < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed";
     opserr << " at time " << the_Domain->getCurrentTime() << endln;
@@ -203,8 +234,9 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
   // check if domain has undergone change
   int stamp = the_Domain->hasDomainChanged();
   if (stamp != domainStamp) {
+    int lastStamp = domainStamp;
     domainStamp = stamp;	
-    if (this->domainChanged() < 0) {
+    if (this->handleDomainChange(lastStamp) < 0) {
       opserr << "DirectIntegrationAnalysis::analyze() - domainChanged() failed\n";
       return -1;
     }	
@@ -258,6 +290,73 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
   return result;
 }
 
+// makes theAlgo & theTest the ones used by analyzeStep(), without
+// deleting those they replace
+void
+DirectIntegrationAnalysis::linkSolver(EquiSolnAlgo *theAlgo, ConvergenceTest *theNewTest)
+{
+  theAlgorithm = theAlgo;
+  theTest = theNewTest;
+  theIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
+  theAlgorithm->setLinks(*theAnalysisModel, *theIntegrator, *theSOE, theTest);
+}
+
+// goes down the ladder of the retry policy after a failed step of dT;
+// substeps that converge are kept, so each rung splits what remains
+int
+DirectIntegrationAnalysis::retryStep(double dT)
+{
+  EquiSolnAlgo *theOrigAlgorithm = theAlgorithm;
+  ConvergenceTest *theOrigTest = theTest;
+  int origStamp = domainStamp;
+
+  double remaining = dT;
+  int result = -1;
+
+  int numRungs = theRetryPolicy->getNumRungs();
+  for (int rung = 0; rung < numRungs && result < 0; rung++) {
+
+    EquiSolnAlgo *theRungAlgorithm = theRetryPolicy->getAlgorithm(rung);
+    ConvergenceTest *theRungTest = theRetryPolicy->getConvergenceTest(rung);
+    if (theRungAlgorithm == 0)
+      theRungAlgorithm = theOrigAlgorithm;
+    if (theRungTest == 0)
+      theRungTest = theOrigTest;
+
+    this->linkSolver(theRungAlgorithm, theRungTest);
+    if (theRungAlgorithm != theOrigAlgorithm &&
+	theRetryPolicy->getDomainStamp(rung) != domainStamp)
+      theRungAlgorithm->domainChanged();
+
+    int numSteps = theRetryPolicy->getNumSubSteps(rung);
+    double stepDT = remaining/numSteps;
+
+    result = 0;
+    for (int i = 0; i < numSteps && result >= 0; i++) {
+      result = this->analyzeStep(stepDT);
+      if (result >= 0)
+	remaining -= stepDT;
+    }
+
+    if (theRungAlgorithm != theOrigAlgorithm)
+      theRetryPolicy->setDomainStamp(rung, domainStamp);
+    if (result >= 0)
+      theRetryPolicy->recordSuccess(rung);
+  }
+
+  // back to the solver of the analysis, it has missed any domain change
+  this->linkSolver(theOrigAlgorithm, theOrigTest);
+  if (domainStamp != origStamp)
+    theAlgorithm->domainChanged();
+
+  if (result < 0) {
+    opserr << "DirectIntegrationAnalysis::analyze() - the step failed on all ";
+    opserr << numRungs << " rungs of the retry policy\n";
+  }
+
+  return result;
+}
+
 int
 DirectIntegrationAnalysis::analyzeSubLevel(int level, double dT) {
   int result = 0;
@@ -297,9 +396,10 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
     int stamp = the_Domain->hasDomainChanged();
 
     if (stamp != domainStamp) {
+      int lastStamp = domainStamp;
       domainStamp = stamp;
   
-      result = this->domainChanged();
+      result = this->handleDomainChange(lastStamp);
       
       if (result < 0) {
 	     opserr << "DirectIntegrationAnalysis::eigen() - domainChanged failed";
@@ -308,11 +408,131 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
     }
 
 
+    result = this->formEigenSystem(*theEigenSOE, generalized);
+
+    // 
+    // solve for the eigen values & vectors
+    //
+
+    if (theEigenSOE->solve(numMode, generalized, findSmallest) < 0) {
+	opserr << "WARNING DirectIntegrationAnalysis::eigen() - EigenSOE failed in solve()\n";
+	return -4;
+    }
+	
+    //
+    // now set the eigenvalues and eigenvectors in the model
+    //
+
+    this->setEigenResults(*theEigenSOE, numMode);
+  
+    return 0;
+}
+
+
+int
+DirectIntegrationAnalysis::eigenAsync(int numMode, EigenSOE &theSOE,
+				      bool generalized, bool findSmallest)
+{
+    if (theAnalysisModel == 0 || theSOE.canSolveAsync() == false) {
+      opserr << "WARNING DirectIntegrationAnalysis::eigenAsync() - the EigenSOE can not be solved in the background\n";
+      return -1;
+    }
+
+    // one request at a time
+    this->eigenWait();
+
+    Domain *the_Domain = this->getDomainPtr();
+
+    theAnalysisModel->eigenAnalysis(numMode, generalized, findSmallest);
+
+    int stamp = the_Domain->hasDomainChanged();
+
+    if (stamp != domainStamp) {
+      int lastStamp = domainStamp;
+      domainStamp = stamp;
+
+      if (this->handleDomainChange(lastStamp) < 0) {
+	opserr << "DirectIntegrationAnalysis::eigenAsync() - domainChanged failed";
+	return -1;
+      }
+    }
+
+    if (theAsyncEigenSOE != &theSOE) {
+      if (theAsyncEigenSOE != 0)
+	delete theAsyncEigenSOE;
+      theAsyncEigenSOE = &theSOE;
+      theSOE.setLinks(*theAnalysisModel);
+      Graph &theGraph = theAnalysisModel->getDOFGraph();
+      int result = theSOE.setSize(theGraph);
+      theAnalysisModel->clearDOFGraph();
+      if (result < 0) {
+	opserr << "DirectIntegrationAnalysis::eigenAsync() - ";
+	opserr << "EigenSOE::setSize() failed";
+	return -3;
+      }
+    }
+
+    // K and M are copied into the EigenSOE here, the analysis can
+    // then change them while the thread solves
+    if (this->formEigenSystem(theSOE, generalized) < 0)
+      return -2;
+
+    asyncNumMode = numMode;
+    asyncResult = 0;
+    asyncDone = false;
+    eigenThread = std::thread([this, numMode, generalized, findSmallest]() {
+	asyncResult = theAsyncEigenSOE->solve(numMode, generalized, findSmallest);
+	asyncDone = true;
+      });
+
+    return 0;
+}
+
+
+int
+DirectIntegrationAnalysis::eigenWait(void)
+{
+    // nothing was asked for
+    if (eigenThread.joinable() == false)
+      return 1;
+
+    eigenThread.join();
+
+    if (asyncResult < 0) {
+	opserr << "WARNING DirectIntegrationAnalysis::eigenWait() - EigenSOE failed in solve()\n";
+	return -4;
+    }
+
+    this->setEigenResults(*theAsyncEigenSOE, asyncNumMode);
+
+    return 0;
+}
+
+
+bool
+DirectIntegrationAnalysis::eigenDone(void)
+{
+    return eigenThread.joinable() == false || asyncDone;
+}
+
+
+EigenSOE *
+DirectIntegrationAnalysis::getAsyncEigenSOE(void)
+{
+    return theAsyncEigenSOE;
+}
+
+
+int
+DirectIntegrationAnalysis::formEigenSystem(EigenSOE &theEigenSOE, bool generalized)
+{
+    int result = 0;
+
     //
     // zero A and M
     //
-    theEigenSOE->zeroA();
-    theEigenSOE->zeroM();
+    theEigenSOE.zeroA();
+    theEigenSOE.zeroM();
 
     //
     // form K
@@ -325,8 +545,8 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
     while((elePtr = theEles()) != 0) {
       elePtr->zeroTangent();
       elePtr->addKtToTang(1.0);
-      if (theEigenSOE->addA(elePtr->getTangent(0), elePtr->getID()) < 0) {
-	opserr << "WARNING DirectIntegrationAnalysis::eigen() -";
+      if (theEigenSOE.addA(elePtr->getTangent(0), elePtr->getID()) < 0) {
+	opserr << "WARNING DirectIntegrationAnalysis::formEigenSystem() -";
 	opserr << " failed in addA for ID " << elePtr->getID();	    
 	result = -2;
       }
@@ -342,8 +562,8 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
       while((elePtr = theEles2()) != 0) {     
 	elePtr->zeroTangent();
 	elePtr->addMtoTang(1.0);
-	if (theEigenSOE->addM(elePtr->getTangent(0), elePtr->getID()) < 0) {
-	  opserr << "WARNING DirectIntegrationAnalysis::eigen() -";
+	if (theEigenSOE.addM(elePtr->getTangent(0), elePtr->getID()) < 0) {
+	  opserr << "WARNING DirectIntegrationAnalysis::formEigenSystem() -";
 	  opserr << " failed in addA for ID " << elePtr->getID();	    
 	  result = -2;
 	}
@@ -354,36 +574,53 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
       while((dofPtr = theDofs()) != 0) {
 	dofPtr->zeroTangent();
 	dofPtr->addMtoTang(1.0);
-	if (theEigenSOE->addM(dofPtr->getTangent(0),dofPtr->getID()) < 0) {
-	  opserr << "WARNING DirectIntegrationAnalysis::eigen() -";
+	if (theEigenSOE.addM(dofPtr->getTangent(0),dofPtr->getID()) < 0) {
+	  opserr << "WARNING DirectIntegrationAnalysis::formEigenSystem() -";
 	  opserr << " failed in addM for ID " << dofPtr->getID();	    
 	  result = -3;
 	}
       }
-    }
-    
-    // 
-    // solve for the eigen values & vectors
-    //
 
-    if (theEigenSOE->solve(numMode, generalized, findSmallest) < 0) {
-	opserr << "WARNING DirectIntegrationAnalysis::eigen() - EigenSOE failed in solve()\n";
-	return -4;
+      if (theEigenSOE.needsC() == true) {
+	theEigenSOE.zeroC();
+	FE_EleIter &theEles3 = theAnalysisModel->getFEs();
+	while((elePtr = theEles3()) != 0) {
+	  elePtr->zeroTangent();
+	  elePtr->addCtoTang(1.0);
+	  if (theEigenSOE.addC(elePtr->getTangent(0), elePtr->getID()) < 0) {
+	    opserr << "WARNING DirectIntegrationAnalysis::formEigenSystem() -";
+	    opserr << " failed in addC for ID " << elePtr->getID();
+	    result = -2;
+	  }
+	}
+
+	DOF_GrpIter &theDofs2 = theAnalysisModel->getDOFs();
+	while((dofPtr = theDofs2()) != 0) {
+	  dofPtr->zeroTangent();
+	  dofPtr->addCtoTang(1.0);
+	  if (theEigenSOE.addC(dofPtr->getTangent(0),dofPtr->getID()) < 0) {
+	    opserr << "WARNING DirectIntegrationAnalysis::formEigenSystem() -";
+	    opserr << " failed in addC for ID " << dofPtr->getID();
+	    result = -3;
+	  }
+	}
+      }
     }
-	
-    //
-    // now set the eigenvalues and eigenvectors in the model
-    //
 
+    return result;
+}
+
+
+void
+DirectIntegrationAnalysis::setEigenResults(EigenSOE &theEigenSOE, int numMode)
+{
     theAnalysisModel->setNumEigenvectors(numMode);
     Vector theEigenvalues(numMode);
     for (int i = 1; i <= numMode; i++) {
-      theEigenvalues[i-1] = theEigenSOE->getEigenvalue(i);
-      theAnalysisModel->setEigenvector(i, theEigenSOE->getEigenvector(i));
+      theEigenvalues[i-1] = theEigenSOE.getEigenvalue(i);
+      theAnalysisModel->setEigenvector(i, theEigenSOE.getEigenvector(i));
     }    
     theAnalysisModel->setEigenvalues(theEigenvalues);
-  
-    return 0;
 }
 
 
@@ -391,6 +628,9 @@ DirectIntegrationAnalysis::eigen(int numMode, bool generalized, bool findSmalles
 int
 DirectIntegrationAnalysis::domainChanged(void)
 {
+    // the background eigen analysis has the old equation numbers
+    this->eigenWait();
+
     Domain *the_Domain = this->getDomainPtr();
     int stamp = the_Domain->hasDomainChanged();
     domainStamp = stamp;
@@ -414,6 +654,12 @@ DirectIntegrationAnalysis::domainChanged(void)
     // causes that object to determine its size
     Graph &theGraph = theAnalysisModel->getDOFGraph();
 
+    // tell the solver if the numberer has put the equations in a
+    // fill-reducing order, so it can skip its own reordering
+    LinearSOESolver *theSolver = theSOE->getSolver();
+    if (theSolver != 0)
+	theSolver->setEquationsOrdered(theDOF_Numberer->isFillReducing());
+
     int result = theSOE->setSize(theGraph);
     if (result < 0) {
 	opserr << "DirectIntegrationAnalysis::handle() - ";
@@ -430,6 +676,15 @@ DirectIntegrationAnalysis::domainChanged(void)
       }	    
     }
 
+    if (theAsyncEigenSOE != 0) {
+      result = theAsyncEigenSOE->setSize(theGraph);
+      if (result < 0) {
+	opserr << "DirectIntegrationAnalysis::handle() - ";
+	opserr << "EigenSOE::setSize() failed";
+	return -3;
+      }	    
+    }
+
     theAnalysisModel->clearDOFGraph();
 
     // we invoke domainChange() on the integrator and algorithm
@@ -439,6 +694,23 @@ DirectIntegrationAnalysis::domainChanged(void)
     return 0;
 }    
 
+// invoked when the domain stamp has moved on from lastStamp: when elements
+// have only been removed since, their FE_Elements are deleted and the
+// numbering and SOE are kept, else domainChanged() does the full setup.
+int
+DirectIntegrationAnalysis::handleDomainChange(int lastStamp)
+{
+    Domain *the_Domain = this->getDomainPtr();
+    if (lastStamp == 0 || the_Domain->onlyElementsRemovedSince(lastStamp) == false ||
+	theConstraintHandler->removeFE_Elements() < 0)
+	return this->domainChanged();
+
+    theIntegrator->domainChanged();
+    theAlgorithm->domainChanged();
+
+    return 0;
+}
+
 int 
 DirectIntegrationAnalysis::setNumberer(DOF_Numberer &theNewNumberer) 
 {
@@ -549,6 +821,24 @@ DirectIntegrationAnalysis::setEigenSOE(EigenSOE &theNewSOE)
   return 0;
 }
 
+int
+DirectIntegrationAnalysis::setRetryPolicy(StepRetryPolicy *thePolicy)
+{
+  // invoke the destructor on the old one
+  if (theRetryPolicy != 0 && theRetryPolicy != thePolicy)
+    delete theRetryPolicy;
+
+  theRetryPolicy = thePolicy;
+  return 0;
+}
+
+int
+DirectIntegrationAnalysis::setCheckpoint(AnalysisCheckpoint *checkpoint)
+{
+  theCheckpoint = checkpoint;
+  return 0;
+}
+
 int 
 DirectIntegrationAnalysis::setConvergenceTest(ConvergenceTest &theNewTest)
 {
@@ -577,8 +867,9 @@ DirectIntegrationAnalysis::checkDomainChange(void)
   // check if domain has undergone change
   int stamp = the_Domain->hasDomainChanged();
   if (stamp != domainStamp) {
+    int lastStamp = domainStamp;
     domainStamp = stamp;	
-    if (this->domainChanged() < 0) {
+    if (this->handleDomainChange(lastStamp) < 0) {
       opserr << "DirectIntegrationAnalysis::initialize() - domainChanged() failed\n";
       return -1;
     }	
@@ -38,6 +38,8 @@
 // What: "@(#) DirectIntegrationAnalysis.h, revA"
 
 #include <TransientAnalysis.h>
+#include <thread>
+#include <atomic>
 
 class ConstraintHandler;
 class DOF_Numberer;
@@ -47,6 +49,8 @@ class LinearSOE;
 class EquiSolnAlgo;
 class ConvergenceTest;
 class EigenSOE;
+class StepRetryPolicy;
+class AnalysisCheckpoint;
 
 class DirectIntegrationAnalysis: public TransientAnalysis
 {
@@ -71,6 +75,16 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     int analyzeStep(double dT);
     int analyzeSubLevel(int level, double dT);
     int eigen(int numMode, bool generlzed = true, bool findSmallest = true);
+
+    // eigen analysis on a background thread: K and M are assembled in the
+    // EigenSOE, which the analysis then owns, and solved while the steps
+    // go on; the results are set in the model by eigenWait() or at the
+    // first step once they are done
+    int eigenAsync(int numMode, EigenSOE &theSOE,
+		   bool generlzed = true, bool findSmallest = true);
+    int eigenWait(void);
+    bool eigenDone(void);
+    EigenSOE *getAsyncEigenSOE(void);
     int initialize(void);
     int domainChanged(void);
 
@@ -80,6 +94,9 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     int setLinearSOE(LinearSOE &theSOE); 
     int setConvergenceTest(ConvergenceTest &theTest);
     int setEigenSOE(EigenSOE &theSOE);
+    int setRetryPolicy(StepRetryPolicy *thePolicy);
+    // the analysis does not own the checkpoint
+    int setCheckpoint(AnalysisCheckpoint *theCheckpoint);
     
     int checkDomainChange(void);
 
@@ -91,6 +108,12 @@ class DirectIntegrationAnalysis: public TransientAnalysis
   protected:
     
   private:
+    int handleDomainChange(int lastStamp);
+    int retryStep(double dT);
+    void linkSolver(EquiSolnAlgo *theAlgo, ConvergenceTest *theTest);
+    int formEigenSystem(EigenSOE &theSOE, bool generalized);
+    void setEigenResults(EigenSOE &theSOE, int numMode);
+
     ConstraintHandler 	*theConstraintHandler;    
     DOF_Numberer 	*theDOF_Numberer;
     AnalysisModel 	*theAnalysisModel;
@@ -99,6 +122,14 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     EigenSOE 		*theEigenSOE;
     TransientIntegrator *theIntegrator;
     ConvergenceTest     *theTest;
+    StepRetryPolicy     *theRetryPolicy;
+    AnalysisCheckpoint  *theCheckpoint;
+
+    EigenSOE            *theAsyncEigenSOE;
+    std::thread         eigenThread;
+    std::atomic<bool>   asyncDone;
+    int asyncNumMode;
+    int asyncResult;
 
     int domainStamp;
     int numSubLevels;
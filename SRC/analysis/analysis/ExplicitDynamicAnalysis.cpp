@@ -0,0 +1,955 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// ExplicitDynamicAnalysis.
+//
+// What: "@(#) ExplicitDynamicAnalysis.cpp, revA"
+
+#include <ExplicitDynamicAnalysis.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <ElementalLoad.h>
+#include <ElementalLoadIter.h>
+#include <MeshRegion.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+#include <math.h>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <GraphColoring.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// the coarsest level whose substep starts at substep s of the finest one,
+// numLevels being the finest level
+static int
+activeLevel(int s, int numLevels)
+{
+  int level = 0;
+  while (level < numLevels && s % (1 << (numLevels - level)) != 0)
+    level++;
+  return level;
+}
+
+// orders elements finest level first
+struct FinerElement {
+  const std::vector<int> *level;
+  bool operator()(int a, int b) const { return (*level)[a] > (*level)[b]; }
+};
+
+ExplicitDynamicAnalysis::ExplicitDynamicAnalysis(Domain &the_Domain,
+						 double alpha)
+:TransientAnalysis(the_Domain),
+ alphaM(alpha), domainStamp(0), numEqn(0), lastDt(0.0), dtCritical(0.0),
+ numParallelEles(0), numColors(0), useKernels(false), numKernelEles(0),
+ maxLevel(0), regionTags(0), numLevels(0), levelDt(0.0)
+{
+
+}
+
+
+ExplicitDynamicAnalysis::~ExplicitDynamicAnalysis()
+{
+
+}
+
+
+void
+ExplicitDynamicAnalysis::clearAll(void)
+{
+  theNodes.clear();
+  nodeStart.clear();
+  theElements.clear();
+  eleOrder.clear();
+  numParallelAt.clear();
+  numSerialAt.clear();
+  eleStart.clear();
+  eleLoc.clear();
+  theSPs.clear();
+  spLoc.clear();
+  invMass.clear();
+  dampM.clear();
+  U.clear(); V.clear(); A.clear(); F.clear();
+  zero.clear();
+  threadF.clear();
+  eleColor.clear();
+  theKernel.clearAll();
+  numKernelEles = 0;
+  dofDt.clear();
+  dofNode.clear();
+  nodeLevel.clear();
+  eleLevel.clear();
+  Ustart.clear();
+  nodeDt.clear();
+  nodeDtCommit.clear();
+  Acommit.clear();
+  nodeT.clear();
+
+  numLevels = 0;
+  levelDt = 0.0;
+  numEqn = 0;
+  numParallelEles = 0;
+  domainStamp = 0;
+  lastDt = 0.0;
+  dtCritical = 0.0;
+}
+
+
+int
+ExplicitDynamicAnalysis::analyze(int numSteps, double dT, bool flush)
+{
+  if (dT <= 0.0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::analyze() - dT " << dT << " <= 0\n";
+    return -1;
+  }
+
+  Domain *the_Domain = this->getDomainPtr();
+
+  int result = 0;
+  for (int i=0; i<numSteps; i++) {
+    result = this->analyzeStep(dT);
+    if (result < 0)
+      break;
+  }
+
+  if (flush)
+    the_Domain->flushRecorders();
+
+  return result;
+}
+
+
+int
+ExplicitDynamicAnalysis::analyzeStep(double dT)
+{
+  Domain *the_Domain = this->getDomainPtr();
+
+  int stamp = the_Domain->hasDomainChanged();
+  if (stamp != domainStamp) {
+    domainStamp = stamp;
+    if (this->domainChanged() < 0) {
+      opserr << "ExplicitDynamicAnalysis::analyze() - domainChanged() failed\n";
+      domainStamp = 0;    // set up again by the next step
+      return -1;
+    }
+    if (maxLevel == 0 && dtCritical > 0.0 && dT > dtCritical)
+      opserr << "WARNING ExplicitDynamicAnalysis::analyze() - dT " << dT
+	     << " exceeds the estimated critical time step " << dtCritical << endln;
+  }
+
+  if (maxLevel > 0 && dT != levelDt)
+    this->setLevels(dT);
+
+  if (numLevels > 0)
+    return this->analyzeSubcycledStep(dT);
+
+  // velocity at t+dT/2 & displacement at t+dT, at the start V is at t
+  double dtV = (lastDt == 0.0) ? 0.5*dT : 0.5*(lastDt + dT);
+  double *u = &U[0];
+  double *v = &V[0];
+  const double *a = &A[0];
+  for (int i=0; i<numEqn; i++) {
+    v[i] += dtV*a[i];
+    u[i] += dT*v[i];
+  }
+
+  // apply the loads & constraint values at t+dT
+  double time = the_Domain->getCurrentTime() + dT;
+  the_Domain->applyLoad(time);
+
+  int numSPs = theSPs.size();
+  for (int i=0; i<numSPs; i++) {
+    int loc = spLoc[i];
+    double uOld = u[loc] - dT*v[loc];
+    u[loc] = theSPs[i]->getValue();
+    v[loc] = (u[loc] - uOld)/dT;
+  }
+
+  // the nodal accelerations are 0 while the element forces are formed,
+  // so the resisting forces contain no inertia
+  this->setNodeResponse(&zero[0]);
+
+  if (this->formForce() < 0) {
+    opserr << "ExplicitDynamicAnalysis::analyze() - failed to form the element forces at time ";
+    opserr << time << endln;
+    this->revertToLastCommit();
+    return -2;
+  }
+
+  double *acc = &A[0];
+  const double *f = &F[0];
+  const double *mInv = &invMass[0];
+  const double *c = &dampM[0];
+  for (int i=0; i<numEqn; i++)
+    acc[i] = mInv[i]*f[i] - c[i]*v[i];
+
+  // the nodes get the velocity at t+dT, F is free to hold it
+  double *vOut = &F[0];
+  for (int i=0; i<numEqn; i++)
+    vOut[i] = v[i] + 0.5*dT*acc[i];
+
+  Vector vel, accel;
+  int numNodes = theNodes.size();
+  for (int i=0; i<numNodes; i++) {
+    int ndf = nodeStart[i+1] - nodeStart[i];
+    vel.setData(vOut + nodeStart[i], ndf);
+    accel.setData(acc + nodeStart[i], ndf);
+    theNodes[i]->setTrialVel(vel);
+    theNodes[i]->setTrialAccel(accel);
+  }
+
+  lastDt = dT;
+
+  if (the_Domain->commit() < 0) {
+    opserr << "ExplicitDynamicAnalysis::analyze() - domain failed to commit at time ";
+    opserr << time << endln;
+    return -3;
+  }
+
+  return 0;
+}
+
+
+// one step dT with each node advanced by dT/2^level; the loop runs over
+// the substeps of the finest level
+int
+ExplicitDynamicAnalysis::analyzeSubcycledStep(double dT)
+{
+  Domain *the_Domain = this->getDomainPtr();
+
+  int numSub = 1 << numLevels;
+  double h = dT/numSub;
+  double t0 = the_Domain->getCurrentTime();
+  int numNodes = theNodes.size();
+  int numSPs = theSPs.size();
+
+  double *u = &U[0];
+  double *v = &V[0];
+  double *acc = &A[0];
+  double *u0 = &Ustart[0];
+  const double *f = &F[0];
+  const double *mInv = &invMass[0];
+  const double *c = &dampM[0];
+
+  // the substeps change A & nodeDt, restored if this step fails
+  Acommit = A;
+  nodeDtCommit = nodeDt;
+
+  for (int s=0; s<numSub; s++) {
+
+    // the nodes whose substep starts now take their half step velocity
+    int first = activeLevel(s, numLevels);
+    for (int n=0; n<numNodes; n++) {
+      int level = nodeLevel[n];
+      if (level < first)
+	continue;
+      double dt = dT/(1 << level);
+      double dtV = (nodeDt[n] == 0.0) ? 0.5*dt : 0.5*(nodeDt[n] + dt);
+      for (int i=nodeStart[n]; i<nodeStart[n+1]; i++) {
+	v[i] += dtV*acc[i];
+	u0[i] = u[i];
+      }
+      nodeDt[n] = dt;
+      nodeT[n] = t0 + s*h;
+    }
+
+    double time = t0 + (s+1)*h;
+    the_Domain->applyLoad(time);
+
+    // all the nodes, those of coarser levels between their steps, move
+    // along their straight line to time
+    for (int n=0; n<numNodes; n++) {
+      double tau = time - nodeT[n];
+      for (int i=nodeStart[n]; i<nodeStart[n+1]; i++)
+	u[i] = u0[i] + tau*v[i];
+    }
+
+    for (int i=0; i<numSPs; i++) {
+      int loc = spLoc[i];
+      double tau = time - nodeT[dofNode[loc]];
+      u[loc] = theSPs[i]->getValue();
+      v[loc] = (u[loc] - u0[loc])/tau;
+    }
+
+    this->setNodeResponse(&zero[0]);
+
+    // the forces are needed at the nodes whose substep ends now
+    int last = (s+1 == numSub) ? 0 : activeLevel(s+1, numLevels);
+    if (this->formForce(last) < 0) {
+      opserr << "ExplicitDynamicAnalysis::analyze() - failed to form the element forces at time ";
+      opserr << time << endln;
+      A = Acommit;
+      nodeDt = nodeDtCommit;
+      this->revertToLastCommit();
+      return -2;
+    }
+
+    for (int n=0; n<numNodes; n++) {
+      if (nodeLevel[n] < last)
+	continue;
+      for (int i=nodeStart[n]; i<nodeStart[n+1]; i++)
+	acc[i] = mInv[i]*f[i] - c[i]*v[i];
+    }
+
+    // the elements are not committed between the substeps, each trial
+    // state is taken from the state committed at the start of dT, so a
+    // failed substep reverts the whole step
+  }
+
+  // the nodes get the velocity at t+dT, F is free to hold it
+  double *vOut = &F[0];
+  Vector vel, accel;
+  for (int n=0; n<numNodes; n++) {
+    int start = nodeStart[n];
+    int ndf = nodeStart[n+1] - start;
+    for (int i=start; i<start+ndf; i++)
+      vOut[i] = v[i] + 0.5*nodeDt[n]*acc[i];
+    vel.setData(vOut + start, ndf);
+    accel.setData(acc + start, ndf);
+    theNodes[n]->setTrialVel(vel);
+    theNodes[n]->setTrialAccel(accel);
+  }
+
+  lastDt = dT;
+
+  if (the_Domain->commit() < 0) {
+    opserr << "ExplicitDynamicAnalysis::analyze() - domain failed to commit at time ";
+    opserr << t0 + dT << endln;
+    return -3;
+  }
+
+  return 0;
+}
+
+
+// after a failed step the domain & the flat U and V are taken back to the
+// last committed state; A only changes once the forces are formed
+void
+ExplicitDynamicAnalysis::revertToLastCommit(void)
+{
+  Domain *the_Domain = this->getDomainPtr();
+  the_Domain->revertToLastCommit();
+
+  for (int i=0; i<(int)theNodes.size(); i++) {
+    const Vector &disp = theNodes[i]->getDisp();
+    const Vector &vel = theNodes[i]->getVel();
+    int start = nodeStart[i];
+    int ndf = nodeStart[i+1] - start;
+    for (int j=0; j<ndf; j++) {
+      U[start+j] = disp(j);
+      V[start+j] = vel(j);
+    }
+  }
+
+  if (numLevels > 0) {
+    nodeT.assign(theNodes.size(), the_Domain->getCurrentTime());
+    Ustart = U;
+  }
+}
+
+
+// sets the level of each node & element for a step dT
+int
+ExplicitDynamicAnalysis::setLevels(double dT)
+{
+  Domain *the_Domain = this->getDomainPtr();
+  int numNodes = theNodes.size();
+  int numEle = theElements.size();
+
+  int lastLevels = numLevels;
+  levelDt = dT;
+  numLevels = 0;
+
+  // the level each dof needs, the node takes the finest
+  nodeLevel.assign(numNodes, 0);
+  int numUnstable = 0;
+  for (int i=0; i<numEqn; i++) {
+    if (dofDt[i] == 0.0)
+      continue;
+    int level = 0;
+    while (level < maxLevel && dT/(1 << level) > dofDt[i])
+      level++;
+    if (dT/(1 << level) > dofDt[i])
+      numUnstable++;
+    if (level > nodeLevel[dofNode[i]])
+      nodeLevel[dofNode[i]] = level;
+  }
+
+  if (numUnstable != 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::setLevels() - " << numUnstable;
+    opserr << " dofs need a step below dT/2^" << maxLevel << endln;
+  }
+
+  // the nodes of a region, and of its elements, share the finest level
+  if (regionTags.Size() != 0) {
+    std::map<int, int> nodeIndex, eleIndex;
+    for (int n=0; n<numNodes; n++)
+      nodeIndex[theNodes[n]->getTag()] = n;
+    for (int e=0; e<numEle; e++)
+      eleIndex[theElements[e]->getTag()] = e;
+
+    for (int r=0; r<regionTags.Size(); r++) {
+      MeshRegion *theRegion = the_Domain->getRegion(regionTags(r));
+      if (theRegion == 0) {
+	opserr << "WARNING ExplicitDynamicAnalysis::setLevels() - no region ";
+	opserr << regionTags(r) << endln;
+	continue;
+      }
+
+      std::vector<int> regionNodes;
+      const ID &theNodeTags = theRegion->getNodes();
+      for (int j=0; j<theNodeTags.Size(); j++) {
+	std::map<int, int>::iterator it = nodeIndex.find(theNodeTags(j));
+	if (it != nodeIndex.end())
+	  regionNodes.push_back(it->second);
+      }
+      const ID &theEleTags = theRegion->getElements();
+      for (int j=0; j<theEleTags.Size(); j++) {
+	std::map<int, int>::iterator it = eleIndex.find(theEleTags(j));
+	if (it != eleIndex.end())
+	  for (int k=eleStart[it->second]; k<eleStart[it->second+1]; k++)
+	    regionNodes.push_back(dofNode[eleLoc[k]]);
+      }
+
+      int level = 0;
+      for (unsigned int j=0; j<regionNodes.size(); j++)
+	if (nodeLevel[regionNodes[j]] > level)
+	  level = nodeLevel[regionNodes[j]];
+      for (unsigned int j=0; j<regionNodes.size(); j++)
+	nodeLevel[regionNodes[j]] = level;
+    }
+  }
+
+  for (int n=0; n<numNodes; n++)
+    if (nodeLevel[n] > numLevels)
+      numLevels = nodeLevel[n];
+
+  // an element goes at the rate of its finest node
+  eleLevel.assign(numEle, 0);
+  for (int e=0; e<numEle; e++)
+    for (int k=eleStart[e]; k<eleStart[e+1]; k++)
+      if (nodeLevel[dofNode[eleLoc[k]]] > eleLevel[e])
+	eleLevel[e] = nodeLevel[dofNode[eleLoc[k]]];
+
+  FinerElement finer;
+  finer.level = &eleLevel;
+  for (int e=0; e<numEle; e++)
+    eleOrder[e] = e;
+  std::stable_sort(eleOrder.begin(), eleOrder.begin() + numParallelEles, finer);
+  std::stable_sort(eleOrder.begin() + numParallelEles, eleOrder.end(), finer);
+
+  numParallelAt.assign(numLevels+1, 0);
+  numSerialAt.assign(numLevels+1, 0);
+  for (int e=0; e<numEle; e++) {
+    std::vector<int> &count = (e < numParallelEles) ? numParallelAt : numSerialAt;
+    for (int l=0; l<=eleLevel[e]; l++)
+      count[l]++;
+  }
+
+  // the nodes carry on from the last step of the whole domain
+  if (lastLevels == 0 || (int)nodeDt.size() != numNodes)
+    nodeDt.assign(numNodes, lastDt);
+  nodeT.assign(numNodes, the_Domain->getCurrentTime());
+  Ustart = U;
+
+  return 0;
+}
+
+
+int
+ExplicitDynamicAnalysis::setSubcycling(int levels, const ID &regions)
+{
+  if (levels < 0 || levels > 20) {
+    opserr << "WARNING ExplicitDynamicAnalysis::setSubcycling() - maxLevel ";
+    opserr << levels << " outside [0, 20]\n";
+    return -1;
+  }
+
+  if (levels > 0 && useKernels == true) {
+    opserr << "WARNING ExplicitDynamicAnalysis::setSubcycling() - not available with the force kernels\n";
+    return -1;
+  }
+
+  maxLevel = levels;
+  regionTags = regions;
+
+  // the levels are set again at the next step
+  levelDt = 0.0;
+  if (maxLevel == 0 && numLevels != 0) {
+    int numEle = theElements.size();
+    for (int e=0; e<numEle; e++)
+      eleOrder[e] = e;
+    numParallelAt.assign(1, numParallelEles);
+    numSerialAt.assign(1, numEle - numParallelEles);
+    numLevels = 0;
+  }
+
+  return 0;
+}
+
+
+int
+ExplicitDynamicAnalysis::setForceKernels(bool on)
+{
+  if (on == true && maxLevel > 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::setForceKernels() - not available with subcycling\n";
+    return -1;
+  }
+
+  if (on != useKernels)
+    domainStamp = 0;
+  useKernels = on;
+
+  return 0;
+}
+
+
+int
+ExplicitDynamicAnalysis::getNumKernelElements(void)
+{
+  return numKernelEles;
+}
+
+
+void
+ExplicitDynamicAnalysis::setNodeResponse(double *accel)
+{
+  Vector disp, vel, acc;
+  int numNodes = theNodes.size();
+  for (int i=0; i<numNodes; i++) {
+    int start = nodeStart[i];
+    int ndf = nodeStart[i+1] - start;
+    disp.setData(&U[start], ndf);
+    vel.setData(&V[start], ndf);
+    acc.setData(accel + start, ndf);
+    theNodes[i]->setTrialDisp(disp);
+    theNodes[i]->setTrialVel(vel);
+    theNodes[i]->setTrialAccel(acc);
+  }
+}
+
+
+// F = P - R, R the element resisting forces after update(); the thread
+// safe elements add into a copy of F per thread, summed at the end
+int
+ExplicitDynamicAnalysis::formForce(int minLevel)
+{
+  double *f = &F[0];
+
+  int numNodes = theNodes.size();
+  for (int i=0; i<numNodes; i++) {
+    const Vector &P = theNodes[i]->getUnbalancedLoad();
+    int start = nodeStart[i];
+    int ndf = nodeStart[i+1] - start;
+    for (int j=0; j<ndf; j++)
+      f[start+j] = P(j);
+  }
+
+  // the elements at minLevel or finer lead each part of eleOrder
+  int numParallel = numParallelAt[minLevel];
+  int numSerial = numSerialAt[minLevel];
+  const int *order = &eleOrder[0];
+  int numFailed = 0;
+
+  for (int k=0; k<numSerial; k++) {
+    int e = order[numParallelEles+k];
+    ops_TheActiveElement = theElements[e];
+    if (this->addElementForce(e, f) < 0)
+      numFailed++;
+  }
+
+  // deterministic: the elements of a color add straight into F, the
+  // colors one after the other, so each entry is summed in a fixed order
+  if (numParallel > 1 && this->getDomainPtr()->getDeterministic() == true) {
+    if ((int)eleColor.size() != numParallelEles)
+      this->colorElements();
+
+    colorStart.assign(numColors+1, 0);
+    for (int k=0; k<numParallel; k++)
+      colorStart[eleColor[order[k]]+1]++;
+    for (int c=0; c<numColors; c++)
+      colorStart[c+1] += colorStart[c];
+    colorOrder.resize(numParallel);
+    std::vector<int> next(colorStart.begin(), colorStart.end()-1);
+    for (int k=0; k<numParallel; k++)
+      colorOrder[next[eleColor[order[k]]]++] = order[k];
+
+    OPS_ThreadGlobals theGlobals;
+    for (int c=0; c<numColors; c++) {
+#pragma omp parallel for reduction(+:numFailed) schedule(dynamic, 64)
+      for (int k=colorStart[c]; k<colorStart[c+1]; k++) {
+	theGlobals.install();
+	ops_TheActiveElement = theElements[colorOrder[k]];
+	if (this->addElementForce(colorOrder[k], f) < 0)
+	  numFailed++;
+      }
+    }
+  } else
+#ifdef _OPENMP
+  if (omp_get_max_threads() > 1 && numParallel > 1) {
+    int numThreads = omp_get_max_threads();
+    threadF.assign((size_t)(numThreads-1)*numEqn, 0.0);
+    OPS_ThreadGlobals theGlobals;
+
+#pragma omp parallel reduction(+:numFailed)
+    {
+      theGlobals.install();
+      int t = omp_get_thread_num();
+      double *myF = (t == 0) ? f : &threadF[(size_t)(t-1)*numEqn];
+#pragma omp for schedule(dynamic, 64)
+      for (int k=0; k<numParallel; k++) {
+	ops_TheActiveElement = theElements[order[k]];
+	if (this->addElementForce(order[k], myF) < 0)
+	  numFailed++;
+      }
+    }
+
+    for (int t=1; t<numThreads; t++) {
+      const double *tF = &threadF[(size_t)(t-1)*numEqn];
+      for (int i=0; i<numEqn; i++)
+	f[i] += tF[i];
+    }
+  } else
+#endif
+  {
+    for (int k=0; k<numParallel; k++)
+      if (this->addElementForce(order[k], f) < 0)
+	numFailed++;
+  }
+
+  if (numKernelEles > 0 && theKernel.addForce(&U[0], f) < 0)
+    numFailed += numKernelEles;
+
+  if (numFailed != 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::formForce() - " << numFailed;
+    opserr << " elements failed in update\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+ExplicitDynamicAnalysis::colorElements(void)
+{
+  std::vector<int> cliqueStart(eleStart.begin(), eleStart.begin() + numParallelEles + 1);
+  numColors = GraphColoring::colorCliques(cliqueStart, eleLoc, numEqn, eleColor);
+  return numColors;
+}
+
+
+int
+ExplicitDynamicAnalysis::addElementForce(int e, double *force)
+{
+  Element *theEle = theElements[e];
+  if (theEle->update() < 0)
+    return -1;
+
+  const Vector &R = theEle->getResistingForceIncInertia();
+  const int *loc = &eleLoc[eleStart[e]];
+  int numDOF = eleStart[e+1] - eleStart[e];
+  for (int i=0; i<numDOF; i++)
+    force[loc[i]] -= R(i);
+
+  return 0;
+}
+
+
+// the elements without elemental loads that a kernel takes go to the end
+// of their part of eleOrder, out of the counts of the part
+int
+ExplicitDynamicAnalysis::setUpKernel(void)
+{
+  Domain *the_Domain = this->getDomainPtr();
+
+  // the kernels add with atomics, in no fixed order
+  if (the_Domain->getDeterministic() == true) {
+    opserr << "WARNING ExplicitDynamicAnalysis::setUpKernel() - force kernels not used in deterministic mode\n";
+    return 0;
+  }
+
+  std::set<int> loaded;
+  LoadPatternIter &thePatterns = the_Domain->getLoadPatterns();
+  LoadPattern *thePattern;
+  while ((thePattern = thePatterns()) != 0) {
+    ElementalLoadIter &theLoads = thePattern->getElementalLoads();
+    ElementalLoad *theLoad;
+    while ((theLoad = theLoads()) != 0)
+      loaded.insert(theLoad->getElementTag());
+  }
+
+  int numEle = theElements.size();
+  std::vector<int> others, taken;
+  for (int part=0; part<2; part++) {
+    int first = (part == 0) ? 0 : numParallelEles;
+    int last = (part == 0) ? numParallelEles : numEle;
+    taken.clear();
+    for (int e=first; e<last; e++) {
+      Element *theEle = theElements[e];
+      if (loaded.count(theEle->getTag()) == 0 &&
+	  theEle->addToForceKernel(theKernel, &eleLoc[eleStart[e]]) == 0)
+	taken.push_back(e);
+      else
+	others.push_back(e);
+    }
+    int numOthers = others.size() - first;
+    others.insert(others.end(), taken.begin(), taken.end());
+    numKernelEles += taken.size();
+    if (part == 0)
+      numParallelAt[0] = numOthers;
+    else
+      numSerialAt[0] = numOthers;
+  }
+  eleOrder = others;
+
+  if (numKernelEles > 0)
+    theKernel.setUp(numEqn);
+
+  return numKernelEles;
+}
+
+
+int
+ExplicitDynamicAnalysis::domainChanged(void)
+{
+  Domain *the_Domain = this->getDomainPtr();
+  int stamp = domainStamp;
+  this->clearAll();
+  domainStamp = stamp;
+
+  if (the_Domain->getNumMPs() != 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - MP_Constraints are not";
+    opserr << " supported, use a Transient analysis with CentralDifference\n";
+    this->clearAll();
+    return -1;
+  }
+
+  // the dofs of each node follow one another
+  std::map<int, int> nodeIndex;
+  NodeIter &theNodeIter = the_Domain->getNodes();
+  Node *nodePtr;
+  nodeStart.push_back(0);
+  while ((nodePtr = theNodeIter()) != 0) {
+    nodeIndex[nodePtr->getTag()] = theNodes.size();
+    theNodes.push_back(nodePtr);
+    numEqn += nodePtr->getNumberDOF();
+    nodeStart.push_back(numEqn);
+  }
+
+  if (numEqn == 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - no nodal dofs in the domain\n";
+    this->clearAll();
+    return -1;
+  }
+
+  std::vector<double> mass(numEqn, 0.0);
+  std::vector<double> rowK(numEqn, 0.0);
+  std::vector<bool> fixed(numEqn, false);
+
+  for (int i=0; i<(int)theNodes.size(); i++) {
+    const Matrix &M = theNodes[i]->getMass();
+    int start = nodeStart[i];
+    int ndf = nodeStart[i+1] - start;
+    if (M.noRows() == ndf)
+      for (int j=0; j<ndf; j++)
+	mass[start+j] += M(j,j);
+  }
+
+  // elements, the thread safe ones first; the mass of each is lumped & the
+  // row sums of |K| are kept for the critical time step
+  std::vector<Element *> serialEles;
+  ElementIter &theEleIter = the_Domain->getElements();
+  Element *elePtr;
+  while ((elePtr = theEleIter()) != 0) {
+    if (elePtr->isSubdomain() == true) {
+      opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - subdomains are not supported\n";
+      this->clearAll();
+      return -1;
+    }
+    if (elePtr->isThreadSafe() == true)
+      theElements.push_back(elePtr);
+    else
+      serialEles.push_back(elePtr);
+  }
+  numParallelEles = theElements.size();
+  theElements.insert(theElements.end(), serialEles.begin(), serialEles.end());
+
+  int numEle = theElements.size();
+  for (int e=0; e<numEle; e++)
+    eleOrder.push_back(e);
+  numParallelAt.push_back(numParallelEles);
+  numSerialAt.push_back(numEle - numParallelEles);
+  eleStart.push_back(0);
+  for (int e=0; e<numEle; e++) {
+    elePtr = theElements[e];
+    const ID &theNodeTags = elePtr->getExternalNodes();
+    int start = eleLoc.size();
+    for (int j=0; j<theNodeTags.Size(); j++) {
+      std::map<int, int>::iterator it = nodeIndex.find(theNodeTags(j));
+      if (it == nodeIndex.end()) {
+	opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - node " << theNodeTags(j);
+	opserr << " of element " << elePtr->getTag() << " not in the domain\n";
+	this->clearAll();
+	return -1;
+      }
+      for (int k=nodeStart[it->second]; k<nodeStart[it->second+1]; k++)
+	eleLoc.push_back(k);
+    }
+    int numDOF = eleLoc.size() - start;
+    eleStart.push_back(eleLoc.size());
+
+    if (numDOF != elePtr->getNumDOF()) {
+      opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - element " << elePtr->getTag();
+      opserr << " has " << elePtr->getNumDOF() << " dof, its nodes " << numDOF << endln;
+      this->clearAll();
+      return -1;
+    }
+
+    const int *loc = &eleLoc[start];
+    const Matrix &Me = elePtr->getMass();
+    if (Me.noRows() == numDOF) {
+      for (int i=0; i<numDOF; i++) {
+	double rowSum = 0.0;
+	for (int j=0; j<numDOF; j++)
+	  rowSum += Me(i,j);
+	mass[loc[i]] += (rowSum > 0.0) ? rowSum : Me(i,i);
+      }
+    }
+
+    const Matrix &Ke = elePtr->getTangentStiff();
+    if (Ke.noRows() == numDOF) {
+      for (int i=0; i<numDOF; i++) {
+	double rowSum = 0.0;
+	for (int j=0; j<numDOF; j++)
+	  rowSum += fabs(Ke(i,j));
+	rowK[loc[i]] += rowSum;
+      }
+    }
+  }
+
+  if (useKernels == true)
+    this->setUpKernel();
+
+  // the constrained dofs
+  SP_ConstraintIter &theSPIter = the_Domain->getDomainAndLoadPatternSPs();
+  SP_Constraint *spPtr;
+  while ((spPtr = theSPIter()) != 0) {
+    std::map<int, int>::iterator it = nodeIndex.find(spPtr->getNodeTag());
+    int dof = spPtr->getDOF_Number();
+    if (it == nodeIndex.end() || dof < 0 ||
+	dof >= nodeStart[it->second+1] - nodeStart[it->second]) {
+      opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - SP_Constraint ";
+      opserr << spPtr->getTag() << " has no valid node dof\n";
+      continue;
+    }
+    int loc = nodeStart[it->second] + dof;
+    fixed[loc] = true;
+    theSPs.push_back(spPtr);
+    spLoc.push_back(loc);
+  }
+
+  invMass.assign(numEqn, 0.0);
+  dampM.assign(numEqn, 0.0);
+  dofDt.assign(numEqn, 0.0);
+  dofNode.assign(numEqn, 0);
+  for (int i=0; i<(int)theNodes.size(); i++)
+    for (int j=nodeStart[i]; j<nodeStart[i+1]; j++)
+      dofNode[j] = i;
+
+  double omega2 = 0.0;
+  for (int i=0; i<numEqn; i++) {
+    if (fixed[i] == true)
+      continue;
+    if (mass[i] <= 0.0) {
+      opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - no mass at free dof ";
+      opserr << i << " of the domain\n";
+      this->clearAll();
+      return -1;
+    }
+    invMass[i] = 1.0/mass[i];
+    dampM[i] = alphaM;
+    double w2 = rowK[i]*invMass[i];
+    if (w2 > omega2)
+      omega2 = w2;
+    if (w2 > 0.0)
+      dofDt[i] = 2.0/sqrt(w2);
+  }
+  dtCritical = (omega2 > 0.0) ? 2.0/sqrt(omega2) : 0.0;
+
+  // the committed state of the nodes
+  U.assign(numEqn, 0.0);
+  V.assign(numEqn, 0.0);
+  A.assign(numEqn, 0.0);
+  F.assign(numEqn, 0.0);
+  zero.assign(numEqn, 0.0);
+  for (int i=0; i<(int)theNodes.size(); i++) {
+    const Vector &disp = theNodes[i]->getDisp();
+    const Vector &vel = theNodes[i]->getVel();
+    int start = nodeStart[i];
+    int ndf = nodeStart[i+1] - start;
+    for (int j=0; j<ndf; j++) {
+      U[start+j] = disp(j);
+      V[start+j] = vel(j);
+    }
+  }
+
+  // the acceleration at the start from the loads at the current time
+  the_Domain->applyLoad(the_Domain->getCurrentTime());
+  this->setNodeResponse(&zero[0]);
+  if (this->formForce() < 0) {
+    opserr << "WARNING ExplicitDynamicAnalysis::domainChanged() - failed to form the initial forces\n";
+    this->clearAll();
+    return -1;
+  }
+  for (int i=0; i<numEqn; i++)
+    A[i] = invMass[i]*F[i] - dampM[i]*V[i];
+  this->setNodeResponse(&A[0]);
+
+  return 0;
+}
+
+
+double
+ExplicitDynamicAnalysis::getCriticalTimeStep(void)
+{
+  Domain *the_Domain = this->getDomainPtr();
+  int stamp = the_Domain->hasDomainChanged();
+  if (stamp != domainStamp) {
+    domainStamp = stamp;
+    if (this->domainChanged() < 0)
+      return 0.0;
+  }
+
+  return dtCritical;
+}
@@ -0,0 +1,153 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExplicitDynamicAnalysis_h
+#define ExplicitDynamicAnalysis_h
+
+// Description: This file contains the class definition for
+// ExplicitDynamicAnalysis. ExplicitDynamicAnalysis is a TransientAnalysis
+// that integrates the equations of motion with the central difference
+// (leap-frog) scheme directly on the domain, without an AnalysisModel,
+// integrator or LinearSOE. The inverse of the lumped mass and the nodal
+// displacements, velocities, accelerations and forces are kept in flat
+// arrays, one entry per nodal dof, so the step is one sweep over them.
+// The element forces are formed concurrently for the elements that are
+// thread safe. Dofs with an SP_Constraint follow the constraint value;
+// MP_Constraints are not supported. The mass of the elements is lumped by
+// row sums and only mass proportional damping, alphaM, is applied here,
+// any damping the elements have themselves is in their resisting force.
+//
+// With subcycling the step dT is divided per node: a node is advanced
+// with dT/2^level, the smallest level whose step is within the stable
+// step of each of its dofs, and an element is evaluated at the rate of
+// its finest node. Over a substep of a finer group the coarser nodes
+// move on their leap-frog straight line; all groups meet at the end of
+// dT, where the domain is committed; the elements are only committed
+// there, a substep takes them from their state at the start of dT. The
+// nodes of a MeshRegion given to setSubcycling() all take the finest
+// level found in the region.
+//
+// With setForceKernels() the elements that agree to addToForceKernel(),
+// elastic trusses, tetrahedra and bricks, have their forces formed by an
+// ExplicitForceKernel, on the OpenMP target device if it is built for
+// one, and are neither updated nor asked for their forces during the
+// steps; the element level responses of those elements stay at their
+// state when the domain last changed. It cannot be used with subcycling.
+//
+// What: "@(#) ExplicitDynamicAnalysis.h, revA"
+
+#include <TransientAnalysis.h>
+#include <ExplicitForceKernel.h>
+#include <ID.h>
+#include <vector>
+
+class Node;
+class Element;
+class SP_Constraint;
+
+class ExplicitDynamicAnalysis : public TransientAnalysis
+{
+  public:
+    ExplicitDynamicAnalysis(Domain &theDomain, double alphaM = 0.0);
+    ~ExplicitDynamicAnalysis();
+
+    void clearAll(void);
+
+    int analyze(int numSteps, double dT, bool flush = true);
+    int domainChanged(void);
+
+    // 2/omega_max, with omega_max bounded by the row sums of |K| and the
+    // lumped mass; it is found when the domain changes
+    double getCriticalTimeStep(void);
+
+    // maxLevel 0 turns subcycling off
+    int setSubcycling(int maxLevel, const ID &regionTags);
+
+    // the forces of the elements a kernel can represent are formed there,
+    // set when the domain next changes
+    int setForceKernels(bool on);
+    int getNumKernelElements(void);
+
+  protected:
+
+  private:
+    int analyzeStep(double dT);
+    int analyzeSubcycledStep(double dT);
+    int setLevels(double dT);
+    void revertToLastCommit(void);
+    int formForce(int minLevel = 0);
+    int addElementForce(int ele, double *force);
+    int setUpKernel(void);
+    void setNodeResponse(double *accel);
+
+    double alphaM;
+    int domainStamp;
+    int numEqn;
+    double lastDt;        // 0 until the first step, V is then at a half step
+    double dtCritical;
+
+    std::vector<Node *> theNodes;
+    std::vector<int> nodeStart;      // first dof of each node, numNodes+1
+
+    std::vector<Element *> theElements;  // the thread safe ones first
+    int numParallelEles;
+    std::vector<int> eleOrder;       // in each part finest level first
+    std::vector<int> numParallelAt;  // elements at a level >= l in each part
+    std::vector<int> numSerialAt;
+    std::vector<int> eleStart;       // first entry of each element in eleLoc
+    std::vector<int> eleLoc;         // the dof of each element force entry
+
+    std::vector<SP_Constraint *> theSPs;
+    std::vector<int> spLoc;
+
+    std::vector<double> invMass;     // 0 at the constrained dofs
+    std::vector<double> dampM;       // alphaM, 0 at the constrained dofs
+    std::vector<double> U, V, A, F;
+    std::vector<double> zero;        // accelerations set while forming F
+    std::vector<double> threadF;     // force of each thread after the first
+
+    // deterministic: the thread safe elements colored so that those of a
+    // color share no dof, the elements of the step ordered color by color
+    int colorElements(void);
+    std::vector<int> eleColor;
+    int numColors;
+    std::vector<int> colorOrder;
+    std::vector<int> colorStart;
+
+    bool useKernels;
+    ExplicitForceKernel theKernel;   // last in each part of eleOrder, not counted
+    int numKernelEles;
+
+    int maxLevel;
+    ID regionTags;
+    int numLevels;                   // finest level in use, 0 no subcycling
+    double levelDt;                  // the dT the levels were set for
+    std::vector<double> dofDt;       // 2/sqrt(row sum |K| / m), 0 no limit
+    std::vector<int> dofNode;        // the node of each dof
+    std::vector<int> nodeLevel;
+    std::vector<int> eleLevel;
+    std::vector<double> Ustart;      // U at the start of the node's substep
+    std::vector<double> nodeDt;      // the last substep of each node
+    std::vector<double> nodeDtCommit; // nodeDt & A at the start of the step
+    std::vector<double> Acommit;
+    std::vector<double> nodeT;       // the time that substep started
+};
+
+#endif
@@ -0,0 +1,406 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// ExplicitForceKernel.
+//
+// What: "@(#) ExplicitForceKernel.cpp, revA"
+
+#include <ExplicitForceKernel.h>
+#include <math.h>
+
+// the sweeps go to the device with _OFFLOAD_EXPLICIT, to the threads of
+// the process otherwise; an element adds into F atomically as its nodes
+// are shared with the other elements of the sweep
+#if defined(_OFFLOAD_EXPLICIT)
+#define OPS_KERNEL_LOOP _Pragma("omp target teams distribute parallel for")
+#elif defined(_OPENMP)
+#define OPS_KERNEL_LOOP _Pragma("omp parallel for schedule(static)")
+#else
+#define OPS_KERNEL_LOOP
+#endif
+
+#ifdef _OFFLOAD_EXPLICIT
+template <class T>
+static void
+enterData(const std::vector<T> &v)
+{
+  if (v.empty())
+    return;
+  const T *p = &v[0];
+  size_t n = v.size();
+#pragma omp target enter data map(to: p[0:n])
+}
+
+template <class T>
+static void
+exitData(const std::vector<T> &v)
+{
+  if (v.empty())
+    return;
+  const T *p = &v[0];
+  size_t n = v.size();
+#pragma omp target exit data map(delete: p[0:n])
+}
+#endif
+
+#ifdef _OFFLOAD_EXPLICIT
+#pragma omp declare target
+#endif
+
+// f -= B^T sigma dvol over the gauss points of one element, the strains
+// ordered eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
+template <int NEN, int NGP>
+static inline void
+solidResist(const double *grad, const double *dvol, double lambda, double mu,
+	    const double *u, double *f)
+{
+  for (int g=0; g<NGP; g++) {
+    const double *dN = grad + g*3*NEN;
+    double e0 = 0.0, e1 = 0.0, e2 = 0.0, e3 = 0.0, e4 = 0.0, e5 = 0.0;
+    for (int a=0; a<NEN; a++) {
+      double nx = dN[3*a], ny = dN[3*a+1], nz = dN[3*a+2];
+      double ux = u[3*a], uy = u[3*a+1], uz = u[3*a+2];
+      e0 += nx*ux;
+      e1 += ny*uy;
+      e2 += nz*uz;
+      e3 += ny*ux + nx*uy;
+      e4 += nz*uy + ny*uz;
+      e5 += nz*ux + nx*uz;
+    }
+
+    double w = dvol[g];
+    double tr = lambda*(e0 + e1 + e2);
+    double s0 = w*(tr + 2.0*mu*e0);
+    double s1 = w*(tr + 2.0*mu*e1);
+    double s2 = w*(tr + 2.0*mu*e2);
+    double s3 = w*mu*e3;
+    double s4 = w*mu*e4;
+    double s5 = w*mu*e5;
+
+    for (int a=0; a<NEN; a++) {
+      double nx = dN[3*a], ny = dN[3*a+1], nz = dN[3*a+2];
+      f[3*a]   -= nx*s0 + ny*s3 + nz*s5;
+      f[3*a+1] -= ny*s1 + nx*s3 + nz*s4;
+      f[3*a+2] -= nz*s2 + ny*s4 + nx*s5;
+    }
+  }
+}
+
+#ifdef _OFFLOAD_EXPLICIT
+#pragma omp end declare target
+#endif
+
+template <int NEN, int NGP>
+static void
+solidForce(int num, const int *loc, const double *grad, const double *dvol,
+	   const double *lambda, const double *mu, const double *P0,
+	   const double *U, double *F)
+{
+OPS_KERNEL_LOOP
+  for (int e=0; e<num; e++) {
+    const int *l = loc + (size_t)e*3*NEN;
+    double u[3*NEN], f[3*NEN];
+    for (int k=0; k<3*NEN; k++) {
+      u[k] = U[l[k]];
+      f[k] = P0[(size_t)e*3*NEN+k];
+    }
+
+    solidResist<NEN,NGP>(grad + (size_t)e*3*NEN*NGP, dvol + (size_t)e*NGP,
+			 lambda[e], mu[e], u, f);
+
+    for (int k=0; k<3*NEN; k++) {
+#pragma omp atomic
+      F[l[k]] += f[k];
+    }
+  }
+}
+
+static void
+trussForce(int num, const int *loc, const double *dir, const double *K,
+	   const double *L0, const double *off, const double *U, double *F)
+{
+OPS_KERNEL_LOOP
+  for (int e=0; e<num; e++) {
+    const int *lA = loc + 6*e;
+    const int *lB = lA + 3;
+    const double *c = dir + 9*e;
+
+    double du[3];
+    for (int i=0; i<3; i++) {
+      double uA = (lA[i] >= 0) ? U[lA[i]] : 0.0;
+      double uB = (lB[i] >= 0) ? U[lB[i]] : 0.0;
+      du[i] = uB - uA;
+    }
+
+    // q the force on end A, -q that on end B
+    double q[3];
+    if (L0[e] == 0.0) {
+      double N = K[e]*(c[0]*du[0] + c[1]*du[1] + c[2]*du[2] - off[e]);
+      for (int i=0; i<3; i++)
+	q[i] = N*c[i];
+    } else {
+      // the offsets of end B in the basic system, c holding its rows
+      double d[3] = {L0[e], 0.0, 0.0};
+      for (int r=0; r<3; r++)
+	d[r] += c[3*r]*du[0] + c[3*r+1]*du[1] + c[3*r+2]*du[2];
+      double Ln = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+      double NoverL = (Ln > 0.0) ? K[e]*(Ln - L0[e])/Ln : 0.0;
+      for (int i=0; i<3; i++)
+	q[i] = NoverL*(c[i]*d[0] + c[3+i]*d[1] + c[6+i]*d[2]);
+    }
+
+    for (int i=0; i<3; i++) {
+      if (lA[i] >= 0) {
+#pragma omp atomic
+	F[lA[i]] += q[i];
+      }
+      if (lB[i] >= 0) {
+#pragma omp atomic
+	F[lB[i]] -= q[i];
+      }
+    }
+  }
+}
+
+
+ExplicitForceKernel::ExplicitForceKernel()
+:numEqn(0), onDevice(false), numTruss(0)
+{
+  tets.num = 0;
+  bricks.num = 0;
+}
+
+
+ExplicitForceKernel::~ExplicitForceKernel()
+{
+  this->clearAll();
+}
+
+
+void
+ExplicitForceKernel::clearAll(void)
+{
+  if (onDevice == true)
+    this->moveToDevice(false);
+
+  numTruss = 0;
+  trussLoc.clear();
+  trussDir.clear();
+  trussK.clear();
+  trussL0.clear();
+  trussOff.clear();
+
+  SolidGroup *groups[2] = {&tets, &bricks};
+  for (int i=0; i<2; i++) {
+    groups[i]->num = 0;
+    groups[i]->loc.clear();
+    groups[i]->grad.clear();
+    groups[i]->dvol.clear();
+    groups[i]->lambda.clear();
+    groups[i]->mu.clear();
+    groups[i]->P0.clear();
+  }
+
+  numEqn = 0;
+}
+
+
+int
+ExplicitForceKernel::addTruss(int ndm, const int *locA, const int *locB,
+			      const double *cosX, double EAoverL, double offset)
+{
+  if (onDevice == true || ndm < 1 || ndm > 3)
+    return -1;
+
+  for (int i=0; i<3; i++)
+    trussLoc.push_back((i < ndm) ? locA[i] : -1);
+  for (int i=0; i<3; i++)
+    trussLoc.push_back((i < ndm) ? locB[i] : -1);
+  for (int i=0; i<9; i++)
+    trussDir.push_back((i < ndm) ? cosX[i] : 0.0);
+  trussK.push_back(EAoverL);
+  trussL0.push_back(0.0);
+  trussOff.push_back(offset);
+  numTruss++;
+
+  return 0;
+}
+
+
+int
+ExplicitForceKernel::addCorotTruss(int ndm, const int *locA, const int *locB,
+				   const double *R, double L0, double EAoverL0)
+{
+  if (onDevice == true || ndm < 1 || ndm > 3 || L0 <= 0.0)
+    return -1;
+
+  for (int i=0; i<3; i++)
+    trussLoc.push_back((i < ndm) ? locA[i] : -1);
+  for (int i=0; i<3; i++)
+    trussLoc.push_back((i < ndm) ? locB[i] : -1);
+  for (int r=0; r<3; r++)
+    for (int i=0; i<3; i++)
+      trussDir.push_back((i < ndm) ? R[3*r+i] : 0.0);
+  trussK.push_back(EAoverL0);
+  trussL0.push_back(L0);
+  trussOff.push_back(0.0);
+  numTruss++;
+
+  return 0;
+}
+
+
+int
+ExplicitForceKernel::addTetrahedron(const int *loc, const double *grad,
+				    double dvol, double lambda, double mu,
+				    const double *P0, const double *u0)
+{
+  if (onDevice == true)
+    return -1;
+
+  // the force with no stress is folded into P0, R being linear in u
+  double f[12];
+  for (int k=0; k<12; k++)
+    f[k] = (P0 != 0) ? P0[k] : 0.0;
+  if (u0 != 0) {
+    double r[12];
+    for (int k=0; k<12; k++)
+      r[k] = 0.0;
+    solidResist<4,1>(grad, &dvol, lambda, mu, u0, r);
+    for (int k=0; k<12; k++)
+      f[k] -= r[k];
+  }
+
+  tets.loc.insert(tets.loc.end(), loc, loc+12);
+  tets.grad.insert(tets.grad.end(), grad, grad+12);
+  tets.dvol.push_back(dvol);
+  tets.lambda.push_back(lambda);
+  tets.mu.push_back(mu);
+  tets.P0.insert(tets.P0.end(), f, f+12);
+  tets.num++;
+
+  return 0;
+}
+
+
+int
+ExplicitForceKernel::addBrick(const int *loc, const double *grad,
+			      const double *dvol, double lambda, double mu,
+			      const double *P0)
+{
+  if (onDevice == true)
+    return -1;
+
+  bricks.loc.insert(bricks.loc.end(), loc, loc+24);
+  bricks.grad.insert(bricks.grad.end(), grad, grad+8*24);
+  bricks.dvol.insert(bricks.dvol.end(), dvol, dvol+8);
+  bricks.lambda.push_back(lambda);
+  bricks.mu.push_back(mu);
+  for (int k=0; k<24; k++)
+    bricks.P0.push_back((P0 != 0) ? P0[k] : 0.0);
+  bricks.num++;
+
+  return 0;
+}
+
+
+int
+ExplicitForceKernel::getNumElements(void) const
+{
+  return numTruss + tets.num + bricks.num;
+}
+
+
+int
+ExplicitForceKernel::setUp(int n)
+{
+  if (onDevice == true)
+    this->moveToDevice(false);
+
+  numEqn = n;
+  this->moveToDevice(true);
+
+  return 0;
+}
+
+
+void
+ExplicitForceKernel::moveToDevice(bool enter)
+{
+#ifdef _OFFLOAD_EXPLICIT
+  SolidGroup *groups[2] = {&tets, &bricks};
+  if (enter == true) {
+    enterData(trussLoc);
+    enterData(trussDir);
+    enterData(trussK);
+    enterData(trussL0);
+    enterData(trussOff);
+    for (int i=0; i<2; i++) {
+      enterData(groups[i]->loc);
+      enterData(groups[i]->grad);
+      enterData(groups[i]->dvol);
+      enterData(groups[i]->lambda);
+      enterData(groups[i]->mu);
+      enterData(groups[i]->P0);
+    }
+  } else {
+    exitData(trussLoc);
+    exitData(trussDir);
+    exitData(trussK);
+    exitData(trussL0);
+    exitData(trussOff);
+    for (int i=0; i<2; i++) {
+      exitData(groups[i]->loc);
+      exitData(groups[i]->grad);
+      exitData(groups[i]->dvol);
+      exitData(groups[i]->lambda);
+      exitData(groups[i]->mu);
+      exitData(groups[i]->P0);
+    }
+  }
+#endif
+  onDevice = enter;
+}
+
+
+int
+ExplicitForceKernel::addForce(const double *U, double *F)
+{
+  if (onDevice == false || numEqn == 0)
+    return -1;
+
+#ifdef _OFFLOAD_EXPLICIT
+#pragma omp target data map(to: U[0:numEqn]) map(tofrom: F[0:numEqn])
+#endif
+  {
+    if (numTruss > 0)
+      trussForce(numTruss, &trussLoc[0], &trussDir[0], &trussK[0],
+		 &trussL0[0], &trussOff[0], U, F);
+    if (tets.num > 0)
+      solidForce<4,1>(tets.num, &tets.loc[0], &tets.grad[0], &tets.dvol[0],
+		      &tets.lambda[0], &tets.mu[0], &tets.P0[0], U, F);
+    if (bricks.num > 0)
+      solidForce<8,8>(bricks.num, &bricks.loc[0], &bricks.grad[0], &bricks.dvol[0],
+		      &bricks.lambda[0], &bricks.mu[0], &bricks.P0[0], U, F);
+  }
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExplicitForceKernel_h
+#define ExplicitForceKernel_h
+
+// Description: This file contains the class definition for
+// ExplicitForceKernel. An ExplicitForceKernel forms the resisting forces
+// of a batch of elements whose force follows from the nodal displacements
+// alone: linear and corotational trusses with a linear elastic material
+// and small strain tetrahedra and bricks with a linear elastic isotropic
+// material. The geometry and moduli of the elements are kept in flat
+// arrays, one group per type, so the force is one sweep over each group
+// and the element objects are not involved. ExplicitDynamicAnalysis uses
+// it for the elements that agree to addToForceKernel().
+//
+// Built with _OFFLOAD_EXPLICIT the arrays are moved to the OpenMP target
+// device by setUp() and stay there; each addForce() then only copies the
+// displacements to the device and the forces back. Otherwise the groups
+// are swept by the threads of the process.
+//
+// What: "@(#) ExplicitForceKernel.h, revA"
+
+#include <vector>
+
+class ExplicitForceKernel
+{
+  public:
+    ExplicitForceKernel();
+    ~ExplicitForceKernel();
+
+    void clearAll(void);
+
+    // the loc of an element are equation numbers of the flat arrays of the
+    // analysis, -1 for a direction the element does not act in; locA &
+    // locB the translations of the end nodes of a truss, cosX its unit
+    // direction, offset the elongation with no force
+    int addTruss(int ndm, const int *locA, const int *locB,
+		 const double *cosX, double EAoverL, double offset = 0.0);
+    // R the rows of the basic system, the first along the truss of length
+    // L0, the force following the offsets of the ends in that system
+    int addCorotTruss(int ndm, const int *locA, const int *locB,
+		      const double *R, double L0, double EAoverL0);
+    // grad the shape function derivatives dN_a/dx_i at [a*3+i], for the
+    // brick at [(g*8+a)*3+i] for gauss point g; P0 the load on the nodes
+    // that does not depend on the displacement, may be 0; u0 the
+    // displacement with no stress, may be 0
+    int addTetrahedron(const int *loc, const double *grad, double dvol,
+		       double lambda, double mu, const double *P0 = 0,
+		       const double *u0 = 0);
+    int addBrick(const int *loc, const double *grad, const double *dvol,
+		 double lambda, double mu, const double *P0 = 0);
+
+    int getNumElements(void) const;
+
+    // done once the elements are added, numEqn the size of U and F
+    int setUp(int numEqn);
+
+    // F -= R(U) for all the elements of the kernel
+    int addForce(const double *U, double *F);
+
+  private:
+    struct SolidGroup {
+      int num;
+      std::vector<int> loc;        // 3*nen per element
+      std::vector<double> grad;    // 3*nen*ngp per element
+      std::vector<double> dvol;    // ngp per element
+      std::vector<double> lambda;
+      std::vector<double> mu;
+      std::vector<double> P0;      // 3*nen per element
+    };
+
+    void moveToDevice(bool enter);
+
+    int numEqn;
+    bool onDevice;
+
+    int numTruss;
+    std::vector<int> trussLoc;     // 6 per truss, end A then end B
+    std::vector<double> trussDir;  // 9 per truss, cosX or the rows of R
+    std::vector<double> trussK;    // EA/L, EA/L0
+    std::vector<double> trussL0;   // 0 for a linear truss
+    std::vector<double> trussOff;
+
+    SolidGroup tets;
+    SolidGroup bricks;
+};
+
+#endif
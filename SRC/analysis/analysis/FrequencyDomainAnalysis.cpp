@@ -0,0 +1,624 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// FrequencyDomainAnalysis.
+//
+// What: "@(#) FrequencyDomainAnalysis.cpp, revA"
+
+#include <FrequencyDomainAnalysis.h>
+#include <IncrementalIntegrator.h>
+#include <StaticAnalysis.h>
+#include <DirectIntegrationAnalysis.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Matrix.h>
+#include <elementAPI.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+int
+OPS_FrequencyDomainAnalysis(void)
+{
+    // frequencyAnalysis -freq $f1 $f2 $n <-log> | -freqList $f1 $f2 ..
+    //                   -node $tag $dof1 <$dof2 ..> <-node ..>
+    //                   <-structural $eta> <-reuse $tol <$maxIter>>
+    AnalysisModel *theModel = *OPS_GetAnalysisModel();
+    if (theModel == 0 || theModel->getDomainPtr() == 0) {
+	opserr << "WARNING frequencyAnalysis - no AnalysisModel, define an analysis first\n";
+	return -1;
+    }
+
+    int numData = 1;
+    std::vector<double> freqs;
+    double f1 = 0.0, f2 = 0.0;
+    int numFreq = 0;
+    bool logSpacing = false;
+    double eta = 0.0;
+    double reuseTol = 0.0;
+    int maxIter = 10;
+    ID nodes(0, 8), dofs(0, 8);
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-freq") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 3 ||
+		OPS_GetDoubleInput(&numData, &f1) < 0 ||
+		OPS_GetDoubleInput(&numData, &f2) < 0 ||
+		OPS_GetIntInput(&numData, &numFreq) < 0) {
+		opserr << "WARNING frequencyAnalysis -freq $f1 $f2 $n - invalid values\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-log") == 0) {
+	    logSpacing = true;
+	} else if (strcmp(opt, "-freqList") == 0) {
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		double value;
+		if (OPS_GetDoubleInput(&numData, &value) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		freqs.push_back(value);
+	    }
+	} else if (strcmp(opt, "-node") == 0) {
+	    int tag;
+	    if (OPS_GetNumRemainingInputArgs() < 2 || OPS_GetIntInput(&numData, &tag) < 0) {
+		opserr << "WARNING frequencyAnalysis -node $tag $dof1 .. - invalid node tag\n";
+		return -1;
+	    }
+	    int numDofs = 0;
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		int dof;
+		if (OPS_GetIntInput(&numData, &dof) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		nodes[nodes.Size()] = tag;
+		dofs[dofs.Size()] = dof-1;
+		numDofs++;
+	    }
+	    if (numDofs == 0) {
+		opserr << "WARNING frequencyAnalysis -node " << tag << " - no dofs given\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-structural") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &eta) < 0) {
+		opserr << "WARNING frequencyAnalysis - invalid structural damping ratio\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-reuse") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &reuseTol) < 0) {
+		opserr << "WARNING frequencyAnalysis - invalid reuse tolerance\n";
+		return -1;
+	    }
+	    if (OPS_GetNumRemainingInputArgs() > 0 && OPS_GetIntInput(&numData, &maxIter) < 0) {
+		OPS_ResetCurrentInputArg(-1);
+		maxIter = 10;
+	    }
+	} else {
+	    opserr << "WARNING frequencyAnalysis - unknown option " << opt << endln;
+	    return -1;
+	}
+    }
+
+    if (numFreq > 0) {
+	if (logSpacing == true && (f1 <= 0.0 || f2 <= 0.0)) {
+	    opserr << "WARNING frequencyAnalysis - -log needs positive frequencies\n";
+	    return -1;
+	}
+	for (int i = 0; i < numFreq; i++) {
+	    double s = numFreq > 1 ? double(i)/(numFreq-1) : 0.0;
+	    if (logSpacing == true)
+		freqs.push_back(f1*pow(f2/f1, s));
+	    else
+		freqs.push_back(f1 + s*(f2-f1));
+	}
+    }
+    if (freqs.empty() || nodes.Size() == 0) {
+	opserr << "WARNING want frequencyAnalysis -freq $f1 $f2 $n <-log> | -freqList $f ..";
+	opserr << " -node $tag $dof .. <-structural $eta> <-reuse $tol <$maxIter>>\n";
+	return -1;
+    }
+
+    // the numbering & constraint handling of the current analysis, brought
+    // up to date with the domain
+    StaticAnalysis *theStatic = *OPS_GetStaticAnalysis();
+    DirectIntegrationAnalysis *theTransient = *OPS_GetTransientAnalysis();
+    int res = 0;
+    if (theStatic != 0)
+	res = theStatic->domainChanged();
+    else if (theTransient != 0)
+	res = theTransient->domainChanged();
+    else {
+	opserr << "WARNING frequencyAnalysis - define an analysis first\n";
+	return -1;
+    }
+    if (res < 0) {
+	opserr << "WARNING frequencyAnalysis - the analysis failed to set up\n";
+	return -1;
+    }
+
+    Vector frequencies((int)freqs.size());
+    for (int i = 0; i < (int)freqs.size(); i++)
+	frequencies(i) = freqs[i];
+
+    FrequencyDomainAnalysis theAnalysis(theModel, frequencies, nodes, dofs,
+					eta, reuseTol, maxIter);
+    if (theAnalysis.analyze() < 0)
+	return -1;
+
+    // frequency, then real & imaginary part of each output
+    const std::vector<std::complex<double> > &theResponse = theAnalysis.getResponse();
+    int numOut = nodes.Size();
+    int numFreqs = frequencies.Size();
+    std::vector<double> data((size_t)numFreqs*(1 + 2*numOut));
+    size_t loc = 0;
+    for (int j = 0; j < numFreqs; j++) {
+	data[loc++] = frequencies(j);
+	for (int i = 0; i < numOut; i++) {
+	    const std::complex<double> &u = theResponse[(size_t)j*numOut + i];
+	    data[loc++] = u.real();
+	    data[loc++] = u.imag();
+	}
+    }
+
+    int size = (int)data.size();
+    if (OPS_SetDoubleOutput(&size, &data[0], false) < 0) {
+	opserr << "WARNING frequencyAnalysis - failed to set the output\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+// forms the terms of the element & nodal matrices selected by the
+// factors; the FE_Elements and DOF_Groups are only asked for these,
+// it is never used by an analysis
+class FrequencyIntegrator : public IncrementalIntegrator
+{
+  public:
+    FrequencyIntegrator() :IncrementalIntegrator(0), k(0.0), c(0.0), m(0.0) {};
+
+    int formEleTangent(FE_Element *theEle) {
+	theEle->zeroTangent();
+	if (k != 0.0)
+	    theEle->addKtToTang(k);
+	if (c != 0.0)
+	    theEle->addCtoTang(c);
+	if (m != 0.0)
+	    theEle->addMtoTang(m);
+	return 0;
+    };
+    int formNodTangent(DOF_Group *theDof) {
+	theDof->zeroTangent();
+	if (c != 0.0)
+	    theDof->addCtoTang(c);
+	if (m != 0.0)
+	    theDof->addMtoTang(m);
+	return 0;
+    };
+    int formEleResidual(FE_Element *theEle) {
+	theEle->zeroResidual();
+	theEle->addRtoResidual(1.0);
+	return 0;
+    };
+    int formNodUnbalance(DOF_Group *theDof) {
+	theDof->zeroUnbalance();
+	theDof->addPtoUnbalance(1.0);
+	return 0;
+    };
+
+    int update(const Vector &deltaU) {return -1;};
+    int sendSelf(int commitTag, Channel &theChannel) {return -1;};
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker) {return -1;};
+    void Print(OPS_Stream &s, int flag = 0) {};
+
+    double k, c, m;
+};
+
+
+FrequencyDomainAnalysis::FrequencyDomainAnalysis(AnalysisModel *model,
+						 const Vector &theFrequencies,
+						 const ID &theNodes, const ID &theDofs,
+						 double theEta, double tol, int iter)
+:theModel(model), frequencies(theFrequencies), nodes(theNodes), dofs(theDofs),
+ eta(theEta), reuseTol(tol), maxIter(iter), numEqn(0), numFactorizations(0)
+{
+
+}
+
+
+FrequencyDomainAnalysis::~FrequencyDomainAnalysis()
+{
+
+}
+
+
+int
+FrequencyDomainAnalysis::analyze(void)
+{
+    numEqn = theModel->getNumEqn();
+    if (numEqn <= 0) {
+	opserr << "WARNING FrequencyDomainAnalysis::analyze() - the model has no equations\n";
+	return -1;
+    }
+
+    // the equations of the outputs
+    Domain *theDomain = theModel->getDomainPtr();
+    int numOut = nodes.Size();
+    outputEqn.assign(numOut, -1);
+    for (int i = 0; i < numOut; i++) {
+	Node *theNode = theDomain->getNode(nodes(i));
+	if (theNode == 0) {
+	    opserr << "WARNING FrequencyDomainAnalysis::analyze() - node " << nodes(i);
+	    opserr << " does not exist\n";
+	    return -1;
+	}
+	DOF_Group *theDof = theNode->getDOF_GroupPtr();
+	if (theDof == 0 || dofs(i) < 0 || dofs(i) >= theDof->getID().Size()) {
+	    opserr << "WARNING FrequencyDomainAnalysis::analyze() - node " << nodes(i);
+	    opserr << " has no dof " << dofs(i)+1 << endln;
+	    return -1;
+	}
+	outputEqn[i] = theDof->getID()(dofs(i));
+    }
+
+    if (this->formProfile() < 0)
+	return -1;
+
+    FrequencyIntegrator theIntegrator;
+    theIntegrator.k = 1.0;
+    if (this->assemble(theIntegrator, K) < 0)
+	return -1;
+    theIntegrator.k = 0.0;
+    theIntegrator.c = 1.0;
+    if (this->assemble(theIntegrator, C) < 0)
+	return -1;
+    theIntegrator.c = 0.0;
+    theIntegrator.m = 1.0;
+    if (this->assemble(theIntegrator, M) < 0)
+	return -1;
+
+    if (this->formLoad(theIntegrator) < 0)
+	return -1;
+
+    double normP = 0.0;
+    for (int i = 0; i < numEqn; i++)
+	normP += P[i]*P[i];
+    normP = sqrt(normP);
+    if (normP == 0.0) {
+	opserr << "WARNING FrequencyDomainAnalysis::analyze() - zero reference load\n";
+	return -1;
+    }
+
+    // the frequencies are split in contiguous blocks over the threads, so
+    // a thread reuses its factors for neighbouring frequencies
+    int numFreq = frequencies.Size();
+    response.assign((size_t)numFreq*numOut, complex(0.0, 0.0));
+    size_t profileSize = colStart[numEqn];
+    int numFailed = 0;
+    int numFact = 0;
+
+#pragma omp parallel reduction(+:numFailed, numFact)
+    {
+	std::vector<complex> A(profileSize);
+	std::vector<complex> x(numEqn), r(numEqn);
+	bool haveFactors = false;
+
+#pragma omp for schedule(static)
+	for (int j = 0; j < numFreq; j++) {
+	    double omega = 2.0*M_PI*frequencies(j);
+	    bool converged = false;
+
+	    if (reuseTol > 0.0 && haveFactors == true) {
+		for (int i = 0; i < numEqn; i++)
+		    x[i] = P[i];
+		this->solve(&A[0], &x[0]);
+		for (int iter = 0; iter < maxIter; iter++) {
+		    this->multiply(omega, &x[0], &r[0]);
+		    double normR = 0.0;
+		    for (int i = 0; i < numEqn; i++) {
+			r[i] = P[i] - r[i];
+			normR += std::norm(r[i]);
+		    }
+		    if (sqrt(normR) <= reuseTol*normP) {
+			converged = true;
+			break;
+		    }
+		    this->solve(&A[0], &r[0]);
+		    for (int i = 0; i < numEqn; i++)
+			x[i] += r[i];
+		}
+	    }
+
+	    if (converged == false) {
+		haveFactors = false;
+		if (this->factor(omega, &A[0]) < 0) {
+		    numFailed++;
+		    continue;
+		}
+		haveFactors = true;
+		numFact++;
+		for (int i = 0; i < numEqn; i++)
+		    x[i] = P[i];
+		this->solve(&A[0], &x[0]);
+	    }
+
+	    for (int i = 0; i < numOut; i++)
+		if (outputEqn[i] >= 0)
+		    response[(size_t)j*numOut + i] = x[outputEqn[i]];
+	}
+    }
+
+    numFactorizations = numFact;
+    if (numFailed != 0) {
+	opserr << "WARNING FrequencyDomainAnalysis::analyze() - the system is singular at ";
+	opserr << numFailed << " of the frequencies\n";
+	return -2;
+    }
+
+    return 0;
+}
+
+
+// the profile of the system from the equation numbers of the
+// FE_Elements & DOF_Groups
+int
+FrequencyDomainAnalysis::formProfile(void)
+{
+    top.resize(numEqn);
+    for (int i = 0; i < numEqn; i++)
+	top[i] = i;
+
+    FE_EleIter &theFEs = theModel->getFEs();
+    FE_Element *theFE;
+    while ((theFE = theFEs()) != 0) {
+	const ID &id = theFE->getID();
+	int minEqn = numEqn;
+	for (int i = 0; i < id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < minEqn)
+		minEqn = id(i);
+	for (int i = 0; i < id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < numEqn && minEqn < top[id(i)])
+		top[id(i)] = minEqn;
+    }
+
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *theDof;
+    while ((theDof = theDOFs()) != 0) {
+	const ID &id = theDof->getID();
+	int minEqn = numEqn;
+	for (int i = 0; i < id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < minEqn)
+		minEqn = id(i);
+	for (int i = 0; i < id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < numEqn && minEqn < top[id(i)])
+		top[id(i)] = minEqn;
+    }
+
+    colStart.resize(numEqn+1);
+    colStart[0] = 0;
+    for (int j = 0; j < numEqn; j++)
+	colStart[j+1] = colStart[j] + (j - top[j] + 1);
+
+    return 0;
+}
+
+
+// adds the upper triangle of the element & nodal matrices into A; the
+// matrices are taken to be symmetric
+int
+FrequencyDomainAnalysis::assemble(Integrator &theIntegrator, std::vector<double> &A)
+{
+    A.assign(colStart[numEqn], 0.0);
+
+    FE_EleIter &theFEs = theModel->getFEs();
+    FE_Element *theFE;
+    while ((theFE = theFEs()) != 0) {
+	const ID &id = theFE->getID();
+	const Matrix &theMatrix = theFE->getTangent(&theIntegrator);
+	int n = id.Size();
+	if (theMatrix.noRows() < n) {
+	    opserr << "WARNING FrequencyDomainAnalysis::assemble() - matrix of the wrong size\n";
+	    return -1;
+	}
+	for (int b = 0; b < n; b++) {
+	    int j = id(b);
+	    if (j < 0 || j >= numEqn)
+		continue;
+	    double *Aj = &A[colStart[j]] - top[j];
+	    for (int a = 0; a < n; a++) {
+		int i = id(a);
+		if (i >= 0 && i <= j)
+		    Aj[i] += theMatrix(a, b);
+	    }
+	}
+    }
+
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *theDof;
+    while ((theDof = theDOFs()) != 0) {
+	const ID &id = theDof->getID();
+	const Matrix &theMatrix = theDof->getTangent(&theIntegrator);
+	int n = id.Size();
+	if (theMatrix.noRows() < n)
+	    continue;
+	for (int b = 0; b < n; b++) {
+	    int j = id(b);
+	    if (j < 0 || j >= numEqn)
+		continue;
+	    double *Aj = &A[colStart[j]] - top[j];
+	    for (int a = 0; a < n; a++) {
+		int i = id(a);
+		if (i >= 0 && i <= j)
+		    Aj[i] += theMatrix(a, b);
+	    }
+	}
+    }
+
+    return 0;
+}
+
+
+// the unbalance for a unit increase of the load factor of the patterns;
+// the load of the current time is reapplied afterwards
+int
+FrequencyDomainAnalysis::formLoad(Integrator &theIntegrator)
+{
+    Domain *theDomain = theModel->getDomainPtr();
+    double time = theDomain->getCurrentTime();
+
+    std::vector<double> P0(numEqn, 0.0);
+    P.assign(numEqn, 0.0);
+
+    for (int pass = 0; pass < 2; pass++) {
+	theModel->applyLoadDomain(time + pass);
+	std::vector<double> &B = (pass == 0) ? P0 : P;
+
+	FE_EleIter &theFEs = theModel->getFEs();
+	FE_Element *theFE;
+	while ((theFE = theFEs()) != 0) {
+	    const ID &id = theFE->getID();
+	    const Vector &theResidual = theFE->getResidual(&theIntegrator);
+	    for (int a = 0; a < id.Size() && a < theResidual.Size(); a++)
+		if (id(a) >= 0 && id(a) < numEqn)
+		    B[id(a)] += theResidual(a);
+	}
+
+	DOF_GrpIter &theDOFs = theModel->getDOFs();
+	DOF_Group *theDof;
+	while ((theDof = theDOFs()) != 0) {
+	    const ID &id = theDof->getID();
+	    const Vector &theUnbalance = theDof->getUnbalance(&theIntegrator);
+	    for (int a = 0; a < id.Size() && a < theUnbalance.Size(); a++)
+		if (id(a) >= 0 && id(a) < numEqn)
+		    B[id(a)] += theUnbalance(a);
+	}
+    }
+
+    theModel->setCurrentDomainTime(time);
+    theModel->applyLoadDomain(time);
+
+    for (int i = 0; i < numEqn; i++)
+	P[i] -= P0[i];
+
+    return 0;
+}
+
+
+// forms A = K (1 + i eta) - w^2 M + i w C and factors it into L D L'; the
+// column j holds L(j,i) above the diagonal and D(j) on it
+int
+FrequencyDomainAnalysis::factor(double omega, complex *A) const
+{
+    size_t size = colStart[numEqn];
+    complex kFactor(1.0, eta);
+    double w2 = omega*omega;
+    for (size_t k = 0; k < size; k++)
+	A[k] = kFactor*K[k] - w2*M[k] + complex(0.0, omega*C[k]);
+
+    for (int j = 0; j < numEqn; j++) {
+	complex *Aj = A + colStart[j] - top[j];
+	int topj = top[j];
+
+	// g(i) = A(i,j) - sum L(i,k) g(k)
+	for (int i = topj+1; i < j; i++) {
+	    const complex *Ai = A + colStart[i] - top[i];
+	    int k0 = top[i] > topj ? top[i] : topj;
+	    complex sum(0.0, 0.0);
+	    for (int k = k0; k < i; k++)
+		sum += Ai[k]*Aj[k];
+	    Aj[i] -= sum;
+	}
+
+	// L(j,i) = g(i)/D(i), D(j) = A(j,j) - sum g(i) L(j,i)
+	complex d = Aj[j];
+	for (int i = topj; i < j; i++) {
+	    complex l = Aj[i]/A[colStart[i] + i - top[i]];
+	    d -= l*Aj[i];
+	    Aj[i] = l;
+	}
+	if (std::abs(d) == 0.0)
+	    return -1;
+	Aj[j] = d;
+    }
+
+    return 0;
+}
+
+
+// solves L D L' x = b, x holding b on entry
+void
+FrequencyDomainAnalysis::solve(const complex *A, complex *x) const
+{
+    for (int j = 0; j < numEqn; j++) {
+	const complex *Aj = A + colStart[j] - top[j];
+	complex sum(0.0, 0.0);
+	for (int i = top[j]; i < j; i++)
+	    sum += Aj[i]*x[i];
+	x[j] -= sum;
+    }
+
+    for (int j = 0; j < numEqn; j++)
+	x[j] /= A[colStart[j] + j - top[j]];
+
+    for (int j = numEqn-1; j >= 0; j--) {
+	const complex *Aj = A + colStart[j] - top[j];
+	complex xj = x[j];
+	for (int i = top[j]; i < j; i++)
+	    x[i] -= Aj[i]*xj;
+    }
+}
+
+
+// y = (K (1 + i eta) - w^2 M + i w C) x
+void
+FrequencyDomainAnalysis::multiply(double omega, const complex *x, complex *y) const
+{
+    complex kFactor(1.0, eta);
+    double w2 = omega*omega;
+
+    for (int j = 0; j < numEqn; j++)
+	y[j] = 0.0;
+
+    for (int j = 0; j < numEqn; j++) {
+	size_t start = colStart[j] - top[j];
+	complex xj = x[j];
+	complex yj(0.0, 0.0);
+	for (int i = top[j]; i <= j; i++) {
+	    size_t k = start + i;
+	    complex a = kFactor*K[k] - w2*M[k] + complex(0.0, omega*C[k]);
+	    yj += a*x[i];
+	    if (i != j)
+		y[i] += a*xj;
+	}
+	y[j] += yj;
+    }
+}
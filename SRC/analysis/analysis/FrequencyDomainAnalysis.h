@@ -0,0 +1,93 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// FrequencyDomainAnalysis. FrequencyDomainAnalysis finds the steady
+// state response to harmonic loading at a set of frequencies by solving
+//    (K (1 + i eta) - w^2 M + i w C) U = P
+// for each w. K, C and M are assembled once through the AnalysisModel,
+// so the constraint handler and numbering of the current analysis are
+// used, at the current state of the model; P is the load of the load
+// patterns for a unit increase of their load factor. The complex
+// symmetric system is kept in profile storage and factored by LDL'
+// without pivoting. The frequencies are solved concurrently, each thread
+// with its own factors, and with a reuse tolerance a frequency is first
+// iterated on with the factors of the previous frequency of the thread,
+//    U(k+1) = U(k) + A0^-1 (P - A U(k)),
+// the factors being formed again only when that does not converge.
+//
+// What: "@(#) FrequencyDomainAnalysis.h, revA"
+
+#ifndef FrequencyDomainAnalysis_h
+#define FrequencyDomainAnalysis_h
+
+#include <Vector.h>
+#include <ID.h>
+#include <vector>
+#include <complex>
+
+class AnalysisModel;
+class Integrator;
+
+class FrequencyDomainAnalysis
+{
+  public:
+    // the response is found at the dofs of the nodes given, the frequencies
+    // in cycles per unit time; eta is a structural damping ratio
+    FrequencyDomainAnalysis(AnalysisModel *theModel, const Vector &frequencies,
+			    const ID &nodes, const ID &dofs, double eta = 0.0,
+			    double reuseTol = 0.0, int maxIter = 10);
+    ~FrequencyDomainAnalysis();
+
+    int analyze(void);
+
+    // the response of output i at frequency j is at j*numOutputs + i
+    const std::vector<std::complex<double> > &getResponse(void) const {return response;};
+    int getNumFactorizations(void) const {return numFactorizations;};
+
+  private:
+    typedef std::complex<double> complex;
+
+    int formProfile(void);
+    int assemble(Integrator &theIntegrator, std::vector<double> &A);
+    int formLoad(Integrator &theIntegrator);
+    int factor(double omega, complex *A) const;
+    void solve(const complex *A, complex *x) const;
+    void multiply(double omega, const complex *x, complex *y) const;
+
+    AnalysisModel *theModel;
+    Vector frequencies;
+    ID nodes, dofs;
+    double eta;
+    double reuseTol;
+    int maxIter;
+
+    int numEqn;
+    std::vector<int> top;        // first row of each column
+    std::vector<size_t> colStart;  // start of each column in the profile
+    std::vector<double> K, C, M;   // the profiles of the matrices
+    std::vector<double> P;
+    std::vector<int> outputEqn;    // equation of each output, -1 if none
+
+    std::vector<complex> response;
+    int numFactorizations;
+};
+
+#endif
@@ -0,0 +1,540 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// ModalTransientAnalysis.
+//
+// What: "@(#) ModalTransientAnalysis.cpp, revA"
+
+#include <ModalTransientAnalysis.h>
+#include <SDFSpectra.h>
+#include <AnalysisModel.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <Vector.h>
+#include <elementAPI.h>
+#include <string.h>
+#include <math.h>
+#include <unordered_map>
+
+int
+OPS_ModalTransientAnalysis(void)
+{
+    // modalTransient $numSteps $dt <-modes $n> <-damp $xi1 $xi2 ..>
+    //                <-nonlinear $eleTag1 ..> <-maxIter $n> <-tol $tol>
+    AnalysisModel *theModel = *OPS_GetAnalysisModel();
+    if (theModel == 0 || theModel->getDomainPtr() == 0) {
+	opserr << "WARNING modalTransient - no AnalysisModel, eigen has not been called\n";
+	return -1;
+    }
+
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING want modalTransient $numSteps $dt <-modes $n> <-damp $xi ..> <-nonlinear $eleTags> <-maxIter $n> <-tol $tol>\n";
+	return -1;
+    }
+
+    int numData = 1;
+    int numSteps;
+    double dT;
+    if (OPS_GetIntInput(&numData, &numSteps) < 0 || OPS_GetDoubleInput(&numData, &dT) < 0) {
+	opserr << "WARNING modalTransient - invalid numSteps or dt\n";
+	return -1;
+    }
+
+    int numModes = 0;
+    int maxIter = 20;
+    double tol = 1.0e-6;
+    Vector damping;
+    ID nonlinearEles(0, 16);
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-modes") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &numModes) < 0) {
+		opserr << "WARNING modalTransient - invalid number of modes\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-maxIter") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &maxIter) < 0) {
+		opserr << "WARNING modalTransient - invalid maxIter\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-tol") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &tol) < 0) {
+		opserr << "WARNING modalTransient - invalid tol\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-damp") == 0) {
+	    std::vector<double> values;
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		double value;
+		if (OPS_GetDoubleInput(&numData, &value) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		values.push_back(value);
+	    }
+	    damping.resize((int)values.size());
+	    for (int i = 0; i < (int)values.size(); i++)
+		damping(i) = values[i];
+	} else if (strcmp(opt, "-nonlinear") == 0) {
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		int tag;
+		if (OPS_GetIntInput(&numData, &tag) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		nonlinearEles[nonlinearEles.Size()] = tag;
+	    }
+	} else {
+	    opserr << "WARNING modalTransient - unknown option " << opt << endln;
+	    return -1;
+	}
+    }
+
+    // nothing is kept between calls, the modal response is found again
+    // from the committed response of the nodes
+    ModalTransientAnalysis theAnalysis(theModel, numModes, damping, nonlinearEles,
+				       maxIter, tol);
+    return theAnalysis.analyze(numSteps, dT);
+}
+
+
+ModalTransientAnalysis::ModalTransientAnalysis(AnalysisModel *model, int nModes,
+					       const Vector &theDamping,
+					       const ID &theNonlinearEles,
+					       int iter, double tolerance)
+:theModel(model), numModes(nModes), damping(theDamping),
+ nonlinearEles(theNonlinearEles), maxIter(iter), tol(tolerance), numDOF(0)
+{
+
+}
+
+
+ModalTransientAnalysis::~ModalTransientAnalysis()
+{
+
+}
+
+
+// finds for each dof of the element its index in the nodal dofs
+static int
+elementDofs(Element *theEle, std::unordered_map<int, int> &nodeIndex,
+	    const std::vector<int> &nodeStart, std::vector<int> &loc,
+	    std::vector<int> *theEleNodes = 0)
+{
+    loc.clear();
+    const ID &nodeTags = theEle->getExternalNodes();
+    for (int i = 0; i < nodeTags.Size(); i++) {
+	std::unordered_map<int, int>::iterator it = nodeIndex.find(nodeTags(i));
+	if (it == nodeIndex.end())
+	    return -1;
+	int index = it->second;
+	for (int j = nodeStart[index]; j < nodeStart[index+1]; j++)
+	    loc.push_back(j);
+	if (theEleNodes != 0)
+	    theEleNodes->push_back(index);
+    }
+    return 0;
+}
+
+
+int
+ModalTransientAnalysis::setUp(double dT)
+{
+    Domain *theDomain = theModel->getDomainPtr();
+
+    const Vector &eigenvalues = theDomain->getEigenvalues();
+    int numEigen = eigenvalues.Size();
+    if (numEigen == 0) {
+	opserr << "WARNING ModalTransientAnalysis::setUp() - eigen has not been called\n";
+	return -1;
+    }
+    if (numModes <= 0 || numModes > numEigen)
+	numModes = numEigen;
+
+    // the nodal dofs
+    theNodes.clear();
+    nodeStart.clear();
+    std::unordered_map<int, int> nodeIndex;
+    NodeIter &theNodeIter = theDomain->getNodes();
+    Node *nodePtr;
+    numDOF = 0;
+    while ((nodePtr = theNodeIter()) != 0) {
+	nodeIndex[nodePtr->getTag()] = (int)theNodes.size();
+	theNodes.push_back(nodePtr);
+	nodeStart.push_back(numDOF);
+	numDOF += nodePtr->getNumberDOF();
+    }
+    nodeStart.push_back(numDOF);
+    int numNodes = (int)theNodes.size();
+
+    // the mode shapes
+    phi.assign((size_t)numDOF*numModes, 0.0);
+    for (int n = 0; n < numNodes; n++) {
+	const Matrix &theEigenvectors = theNodes[n]->getEigenvectors();
+	if (theEigenvectors.noCols() < numModes) {
+	    opserr << "WARNING ModalTransientAnalysis::setUp() - node " << theNodes[n]->getTag();
+	    opserr << " has no eigenvectors\n";
+	    return -1;
+	}
+	int ndf = nodeStart[n+1] - nodeStart[n];
+	for (int i = 0; i < ndf; i++)
+	    for (int j = 0; j < numModes; j++)
+		phi[(size_t)(nodeStart[n]+i)*numModes + j] = theEigenvectors(i, j);
+    }
+
+    // M phi from the nodal & element masses
+    std::vector<double> Mphi((size_t)numDOF*numModes, 0.0);
+    for (int n = 0; n < numNodes; n++) {
+	const Matrix &theMass = theNodes[n]->getMass();
+	int ndf = nodeStart[n+1] - nodeStart[n];
+	if (theMass.noRows() != ndf)
+	    continue;
+	for (int a = 0; a < ndf; a++)
+	    for (int b = 0; b < ndf; b++) {
+		double mab = theMass(a, b);
+		if (mab == 0.0)
+		    continue;
+		double *Ma = &Mphi[(size_t)(nodeStart[n]+a)*numModes];
+		const double *phib = &phi[(size_t)(nodeStart[n]+b)*numModes];
+		for (int j = 0; j < numModes; j++)
+		    Ma[j] += mab*phib[j];
+	    }
+    }
+
+    std::vector<int> loc;
+    ElementIter &theEleIter = theDomain->getElements();
+    Element *elePtr;
+    while ((elePtr = theEleIter()) != 0) {
+	if (elementDofs(elePtr, nodeIndex, nodeStart, loc) < 0)
+	    continue;
+	const Matrix &theMass = elePtr->getMass();
+	int numEleDOF = (int)loc.size();
+	if (theMass.noRows() != numEleDOF)
+	    continue;
+	for (int a = 0; a < numEleDOF; a++)
+	    for (int b = 0; b < numEleDOF; b++) {
+		double mab = theMass(a, b);
+		if (mab == 0.0)
+		    continue;
+		double *Ma = &Mphi[(size_t)loc[a]*numModes];
+		const double *phib = &phi[(size_t)loc[b]*numModes];
+		for (int j = 0; j < numModes; j++)
+		    Ma[j] += mab*phib[j];
+	    }
+    }
+
+    genMass.assign(numModes, 0.0);
+    for (size_t i = 0; i < (size_t)numDOF*numModes; i++)
+	genMass[i % numModes] += phi[i]*Mphi[i];
+    for (int j = 0; j < numModes; j++)
+	if (genMass[j] <= 0.0) {
+	    opserr << "WARNING ModalTransientAnalysis::setUp() - mode " << j+1;
+	    opserr << " has no mass\n";
+	    return -2;
+	}
+
+    // the modal response from the committed nodal response
+    q.assign(numModes, 0.0);
+    qdot.assign(numModes, 0.0);
+    for (int n = 0; n < numNodes; n++) {
+	const Vector &disp = theNodes[n]->getDisp();
+	const Vector &vel = theNodes[n]->getVel();
+	int ndf = nodeStart[n+1] - nodeStart[n];
+	for (int i = 0; i < ndf; i++) {
+	    const double *Mi = &Mphi[(size_t)(nodeStart[n]+i)*numModes];
+	    double ui = disp(i);
+	    double vi = vel(i);
+	    if (ui == 0.0 && vi == 0.0)
+		continue;
+	    for (int j = 0; j < numModes; j++) {
+		q[j] += Mi[j]*ui;
+		qdot[j] += Mi[j]*vi;
+	    }
+	}
+    }
+    for (int j = 0; j < numModes; j++) {
+	q[j] /= genMass[j];
+	qdot[j] /= genMass[j];
+    }
+
+    // frequencies & damping ratios
+    const Vector *modalDamping = theModel->getModalDampingFactors();
+    omega.assign(numModes, 0.0);
+    xi.assign(numModes, 0.0);
+    for (int j = 0; j < numModes; j++) {
+	omega[j] = eigenvalues(j) > 0.0 ? sqrt(eigenvalues(j)) : 0.0;
+	if (damping.Size() > 0)
+	    xi[j] = damping(j < damping.Size() ? j : damping.Size()-1);
+	else if (modalDamping != 0 && modalDamping->Size() > 0)
+	    xi[j] = (*modalDamping)(j < modalDamping->Size() ? j : modalDamping->Size()-1);
+    }
+
+    // the nonlinear elements & the nodes they are attached to
+    theNonlinearEles.clear();
+    std::vector<bool> isNonlinearNode(numNodes, false);
+    nonlinearNodes.clear();
+    for (int i = 0; i < nonlinearEles.Size(); i++) {
+	Element *theEle = theDomain->getElement(nonlinearEles(i));
+	if (theEle == 0) {
+	    opserr << "WARNING ModalTransientAnalysis::setUp() - element " << nonlinearEles(i);
+	    opserr << " does not exist\n";
+	    return -3;
+	}
+	NonlinearElement nonlinearEle;
+	nonlinearEle.theElement = theEle;
+	std::vector<int> eleNodes;
+	if (elementDofs(theEle, nodeIndex, nodeStart, nonlinearEle.loc, &eleNodes) < 0)
+	    return -3;
+	nonlinearEle.Ki = theEle->getInitialStiff();
+	for (size_t n = 0; n < eleNodes.size(); n++)
+	    if (isNonlinearNode[eleNodes[n]] == false) {
+		isNonlinearNode[eleNodes[n]] = true;
+		nonlinearNodes.push_back(eleNodes[n]);
+	    }
+	theNonlinearEles.push_back(nonlinearEle);
+    }
+
+    U.assign(numDOF, 0.0);
+    V.assign(numDOF, 0.0);
+    A.assign(numDOF, 0.0);
+
+    this->formCoefficients(dT);
+
+    // the load at the start of the first step
+    pLast.assign(numModes, 0.0);
+    pNonlinear.assign(numModes, 0.0);
+    theDomain->applyLoad(theDomain->getCurrentTime());
+    this->formLoad(&pLast[0]);
+    if (theNonlinearEles.empty() == false) {
+	this->formPseudoForce(&q[0], &qdot[0], &pNonlinear[0]);
+	for (int j = 0; j < numModes; j++)
+	    pLast[j] += pNonlinear[j];
+    }
+
+    qddot.assign(numModes, 0.0);
+    for (int j = 0; j < numModes; j++)
+	qddot[j] = pLast[j]/genMass[j] - 2.0*xi[j]*omega[j]*qdot[j] - omega[j]*omega[j]*q[j];
+
+    return 0;
+}
+
+
+// the coefficients of the step of each mode, see SDFSpectra.h
+void
+ModalTransientAnalysis::formCoefficients(double dT)
+{
+    coef.assign(8*numModes, 0.0);
+    for (int j = 0; j < numModes; j++)
+	SDF_StepCoefficients(omega[j], xi[j], dT, SDF_EXACT, &coef[8*j]);
+}
+
+
+// p = phi' P for the nodal loads now in the domain
+void
+ModalTransientAnalysis::formLoad(double *p)
+{
+    for (int j = 0; j < numModes; j++)
+	p[j] = 0.0;
+
+    int numNodes = (int)theNodes.size();
+    for (int n = 0; n < numNodes; n++) {
+	const Vector &P = theNodes[n]->getUnbalancedLoad();
+	int ndf = nodeStart[n+1] - nodeStart[n];
+	for (int i = 0; i < ndf && i < P.Size(); i++) {
+	    double Pi = P(i);
+	    if (Pi == 0.0)
+		continue;
+	    const double *phii = &phi[(size_t)(nodeStart[n]+i)*numModes];
+	    for (int j = 0; j < numModes; j++)
+		p[j] += phii[j]*Pi;
+	}
+    }
+}
+
+
+// p = -phi' (f - Ki u) of the nonlinear elements at the response of q,
+// the nodes of those elements are left with that response
+void
+ModalTransientAnalysis::formPseudoForce(const double *theQ, const double *theQdot, double *p)
+{
+    for (int j = 0; j < numModes; j++)
+	p[j] = 0.0;
+
+    for (size_t n = 0; n < nonlinearNodes.size(); n++) {
+	int index = nonlinearNodes[n];
+	int start = nodeStart[index];
+	int ndf = nodeStart[index+1] - start;
+	for (int i = start; i < start+ndf; i++) {
+	    const double *phii = &phi[(size_t)i*numModes];
+	    double ui = 0.0, vi = 0.0;
+	    for (int j = 0; j < numModes; j++) {
+		ui += phii[j]*theQ[j];
+		vi += phii[j]*theQdot[j];
+	    }
+	    U[i] = ui;
+	    V[i] = vi;
+	}
+	Vector disp(&U[start], ndf);
+	Vector vel(&V[start], ndf);
+	theNodes[index]->setTrialDisp(disp);
+	theNodes[index]->setTrialVel(vel);
+    }
+
+    for (size_t e = 0; e < theNonlinearEles.size(); e++) {
+	NonlinearElement &theEle = theNonlinearEles[e];
+	theEle.theElement->update();
+	const Vector &force = theEle.theElement->getResistingForce();
+	int numEleDOF = (int)theEle.loc.size();
+	for (int a = 0; a < numEleDOF; a++) {
+	    double ra = force(a);
+	    for (int b = 0; b < numEleDOF; b++)
+		ra -= theEle.Ki(a, b)*U[theEle.loc[b]];
+	    if (ra == 0.0)
+		continue;
+	    const double *phia = &phi[(size_t)theEle.loc[a]*numModes];
+	    for (int j = 0; j < numModes; j++)
+		p[j] -= phia[j]*ra;
+	}
+    }
+}
+
+
+// sets the trial response of all the nodes from the modal response
+void
+ModalTransientAnalysis::setNodeResponse(void)
+{
+    int numNodes = (int)theNodes.size();
+    for (int n = 0; n < numNodes; n++) {
+	int start = nodeStart[n];
+	int ndf = nodeStart[n+1] - start;
+	for (int i = start; i < start+ndf; i++) {
+	    const double *phii = &phi[(size_t)i*numModes];
+	    double ui = 0.0, vi = 0.0, ai = 0.0;
+	    for (int j = 0; j < numModes; j++) {
+		ui += phii[j]*q[j];
+		vi += phii[j]*qdot[j];
+		ai += phii[j]*qddot[j];
+	    }
+	    U[i] = ui;
+	    V[i] = vi;
+	    A[i] = ai;
+	}
+	Vector disp(&U[start], ndf);
+	Vector vel(&V[start], ndf);
+	Vector accel(&A[start], ndf);
+	theNodes[n]->setTrialDisp(disp);
+	theNodes[n]->setTrialVel(vel);
+	theNodes[n]->setTrialAccel(accel);
+    }
+}
+
+
+int
+ModalTransientAnalysis::analyze(int numSteps, double dT)
+{
+    if (dT <= 0.0) {
+	opserr << "WARNING ModalTransientAnalysis::analyze() - dt must be positive\n";
+	return -1;
+    }
+
+    if (this->setUp(dT) < 0) {
+	opserr << "WARNING ModalTransientAnalysis::analyze() - failed to set up the modes\n";
+	return -1;
+    }
+
+    Domain *theDomain = theModel->getDomainPtr();
+    std::vector<double> pLoad(numModes), pNew(numModes);
+    std::vector<double> qNew(numModes), qdotNew(numModes), qddotNew(numModes);
+    bool isNonlinear = (theNonlinearEles.empty() == false);
+
+    for (int step = 0; step < numSteps; step++) {
+
+	double time = theDomain->getCurrentTime() + dT;
+	theDomain->applyLoad(time);
+	this->formLoad(&pLoad[0]);
+
+	// fixed point iteration on the pseudo force, starting from that
+	// at the end of the last step
+	bool converged = false;
+	for (int iter = 0; iter < maxIter && converged == false; iter++) {
+
+	    for (int j = 0; j < numModes; j++) {
+		double w = omega[j];
+		double c = 2.0*xi[j]*w;
+		double k = w*w;
+		double pEnd = (pLoad[j] + pNonlinear[j])/genMass[j];
+
+		const double *cj = &coef[8*j];
+		double p0 = pLast[j]/genMass[j];
+		qNew[j] = cj[0]*q[j] + cj[1]*qdot[j] + cj[2]*p0 + cj[3]*pEnd;
+		qdotNew[j] = cj[4]*q[j] + cj[5]*qdot[j] + cj[6]*p0 + cj[7]*pEnd;
+		qddotNew[j] = pEnd - c*qdotNew[j] - k*qNew[j];
+	    }
+
+	    if (isNonlinear == false) {
+		converged = true;
+		break;
+	    }
+
+	    this->formPseudoForce(&qNew[0], &qdotNew[0], &pNew[0]);
+
+	    double change = 0.0, norm = 0.0;
+	    for (int j = 0; j < numModes; j++) {
+		double dp = pNew[j] - pNonlinear[j];
+		double pj = pLoad[j] + pNew[j];
+		change += dp*dp;
+		norm += pj*pj;
+		pNonlinear[j] = pNew[j];
+	    }
+	    if (sqrt(change) <= tol*sqrt(norm) || change == 0.0)
+		converged = true;
+	}
+
+	if (converged == false) {
+	    opserr << "WARNING ModalTransientAnalysis::analyze() - the pseudo force did not converge";
+	    opserr << " in " << maxIter << " iterations at time " << time << endln;
+	    theModel->revertDomainToLastCommit();
+	    return -2;
+	}
+
+	for (int j = 0; j < numModes; j++) {
+	    q[j] = qNew[j];
+	    qdot[j] = qdotNew[j];
+	    qddot[j] = qddotNew[j];
+	    pLast[j] = pLoad[j] + pNonlinear[j];
+	}
+
+	// the nonlinear elements are already updated to this response
+	this->setNodeResponse();
+
+	if (theModel->commitDomain() < 0) {
+	    opserr << "WARNING ModalTransientAnalysis::analyze() - failed to commit the domain";
+	    opserr << " at time " << time << endln;
+	    return -3;
+	}
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// ModalTransientAnalysis. ModalTransientAnalysis integrates the response
+// to the loads in the domain by superposition of the modes found by the
+// last eigen analysis. Each modal equation
+//    q'' + 2 xi w q' + w^2 q = phi' (P - r) / phi' M phi
+// is advanced with the exact solution for a load varying linearly over
+// the step (the average acceleration method for modes with w = 0 or
+// xi >= 1), so the time step is only limited by the accuracy wanted for
+// the load history. P is the nodal load of the load patterns, ground
+// motions included through the nodal masses. r is the pseudo force of an
+// optional set of nonlinear elements: their resisting force less their
+// initial stiffness times the displacement, iterated on in each step as
+// in the fast nonlinear analysis of Wilson. The eigen analysis must then
+// have been done with the initial stiffness of those elements.
+//
+// What: "@(#) ModalTransientAnalysis.h, revA"
+
+#ifndef ModalTransientAnalysis_h
+#define ModalTransientAnalysis_h
+
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <vector>
+
+class AnalysisModel;
+class Domain;
+class Node;
+class Element;
+
+class ModalTransientAnalysis
+{
+  public:
+    // damping holds the ratio of each mode, if empty the modal damping
+    // factors of the domain are used
+    ModalTransientAnalysis(AnalysisModel *theModel, int numModes,
+			   const Vector &damping, const ID &nonlinearEles,
+			   int maxIter = 20, double tol = 1.0e-6);
+    ~ModalTransientAnalysis();
+
+    int analyze(int numSteps, double dT);
+
+  private:
+    struct NonlinearElement {
+	Element *theElement;
+	std::vector<int> loc;    // index of each element dof in the nodal dofs
+	Matrix Ki;
+    };
+
+    int setUp(double dT);
+    void formCoefficients(double dT);
+    void formLoad(double *p);
+    void formPseudoForce(const double *q, const double *qdot, double *p);
+    void setNodeResponse(void);
+
+    AnalysisModel *theModel;
+    int numModes;
+    Vector damping;
+    ID nonlinearEles;
+    int maxIter;
+    double tol;
+
+    int numDOF;                   // number of nodal dofs
+    std::vector<Node *> theNodes;
+    std::vector<int> nodeStart;   // first nodal dof of each node
+    std::vector<double> phi;      // mode shapes, numModes values per nodal dof
+    std::vector<double> genMass;  // phi' M phi of each mode
+    std::vector<double> omega, xi;
+    std::vector<double> coef;     // 8 coefficients of the step for each mode
+    std::vector<NonlinearElement> theNonlinearEles;
+    std::vector<int> nonlinearNodes;  // the nodes of those elements
+
+    std::vector<double> q, qdot, qddot;      // modal response
+    std::vector<double> pLast, pNonlinear;   // modal loads
+    std::vector<double> U, V, A;            // nodal response
+};
+
+#endif
@@ -0,0 +1,320 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the SDF spectra
+// functions & the sdfSpectra command.
+//
+// What: "@(#) SDFSpectra.cpp, revA"
+
+#include <SDFSpectra.h>
+#include <TimeSeries.h>
+#include <PathSeries.h>
+#include <OPS_Globals.h>
+#include <elementAPI.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// oscillators integrated together in the lanes of a block
+#define SDF_BLOCK_SIZE 16
+
+// a step of the average acceleration method for a unit mass
+static void
+newmarkStep(double k, double c, double dt, double u0, double v0,
+	    double p0, double p1, double &u1, double &v1)
+{
+    double a0 = p0 - c*v0 - k*u0;
+    double kHat = k + 2.0*c/dt + 4.0/(dt*dt);
+    double rhs = p1 + 4.0/(dt*dt)*u0 + 4.0/dt*v0 + a0 + c*(2.0/dt*u0 + v0);
+    u1 = rhs/kHat;
+    v1 = 2.0/dt*(u1 - u0) - v0;
+}
+
+
+int
+SDF_StepCoefficients(double w, double z, double dt, int method, double *coef)
+{
+    double k = w*w;
+
+    if (method == SDF_EXACT && w*dt > 1.0e-8 && z < 1.0) {
+	double root = sqrt(1.0 - z*z);
+	double wD = w*root;
+	double e = exp(-z*w*dt);
+	double s = sin(wD*dt);
+	double c = cos(wD*dt);
+	double r = z/root;
+
+	coef[0] = e*(r*s + c);
+	coef[1] = e*s/wD;
+	coef[2] = (2.0*z/(w*dt) + e*(((1.0 - 2.0*z*z)/(wD*dt) - r)*s - (1.0 + 2.0*z/(w*dt))*c))/k;
+	coef[3] = (1.0 - 2.0*z/(w*dt) + e*((2.0*z*z - 1.0)/(wD*dt)*s + 2.0*z/(w*dt)*c))/k;
+	coef[4] = -e*w/root*s;
+	coef[5] = e*(c - r*s);
+	coef[6] = (-1.0/dt + e*((w/root + r/dt)*s + c/dt))/k;
+	coef[7] = (1.0 - e*(r*s + c))/(k*dt);
+	return SDF_EXACT;
+    }
+
+    // the Newmark step is linear in (u, v, p(t), p(t+dt)), its
+    // coefficients are the response to each of them alone
+    double c = 2.0*z*w;
+    static const double unit[4][4] = {{1,0,0,0}, {0,1,0,0}, {0,0,1,0}, {0,0,0,1}};
+    for (int i = 0; i < 4; i++)
+	newmarkStep(k, c, dt, unit[i][0], unit[i][1], unit[i][2], unit[i][3],
+		    coef[i], coef[4+i]);
+
+    return SDF_NEWMARK;
+}
+
+
+int
+SDF_ElasticSpectra(const double *ag, int numPoints, double dt,
+		   const double *periods, int numPeriods,
+		   const double *zetas, int numZetas, int method,
+		   double *Sd, double *Sv, double *Sa)
+{
+    if (numPoints < 1 || dt <= 0.0)
+	return -1;
+
+    double pga = 0.0;
+    for (int i = 0; i < numPoints; i++)
+	if (fabs(ag[i]) > pga)
+	    pga = fabs(ag[i]);
+
+    int numOsc = numPeriods*numZetas;
+    int numBlocks = (numOsc + SDF_BLOCK_SIZE - 1)/SDF_BLOCK_SIZE;
+
+    // each block goes through the whole record with its state in the
+    // lanes, the record is the only data streamed
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < numBlocks; b++) {
+	double A[SDF_BLOCK_SIZE], B[SDF_BLOCK_SIZE], C[SDF_BLOCK_SIZE], D[SDF_BLOCK_SIZE];
+	double Ap[SDF_BLOCK_SIZE], Bp[SDF_BLOCK_SIZE], Cp[SDF_BLOCK_SIZE], Dp[SDF_BLOCK_SIZE];
+	double K[SDF_BLOCK_SIZE], Cd[SDF_BLOCK_SIZE];
+	double u[SDF_BLOCK_SIZE], v[SDF_BLOCK_SIZE];
+	double uMax[SDF_BLOCK_SIZE], vMax[SDF_BLOCK_SIZE], aMax[SDF_BLOCK_SIZE];
+
+	int first = b*SDF_BLOCK_SIZE;
+	for (int l = 0; l < SDF_BLOCK_SIZE; l++) {
+	    int osc = first + l;
+	    double coef[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	    double w = 0.0, z = 0.0;
+	    if (osc < numOsc && periods[osc % numPeriods] > 0.0) {
+		w = 2.0*M_PI/periods[osc % numPeriods];
+		z = zetas[osc / numPeriods];
+		SDF_StepCoefficients(w, z, dt, method, coef);
+	    }
+	    A[l] = coef[0]; B[l] = coef[1]; C[l] = coef[2]; D[l] = coef[3];
+	    Ap[l] = coef[4]; Bp[l] = coef[5]; Cp[l] = coef[6]; Dp[l] = coef[7];
+	    K[l] = w*w;
+	    Cd[l] = 2.0*z*w;
+	    u[l] = 0.0; v[l] = 0.0;
+	    uMax[l] = 0.0; vMax[l] = 0.0; aMax[l] = 0.0;
+	}
+
+	// at rest before the first point, the load is -ag
+	double p0 = 0.0;
+	for (int i = 0; i < numPoints; i++) {
+	    double p1 = -ag[i];
+#pragma omp simd
+	    for (int l = 0; l < SDF_BLOCK_SIZE; l++) {
+		double un = A[l]*u[l] + B[l]*v[l] + C[l]*p0 + D[l]*p1;
+		double vn = Ap[l]*u[l] + Bp[l]*v[l] + Cp[l]*p0 + Dp[l]*p1;
+		double an = fabs(K[l]*un + Cd[l]*vn);
+		double au = fabs(un);
+		double av = fabs(vn);
+		uMax[l] = au > uMax[l] ? au : uMax[l];
+		vMax[l] = av > vMax[l] ? av : vMax[l];
+		aMax[l] = an > aMax[l] ? an : aMax[l];
+		u[l] = un;
+		v[l] = vn;
+	    }
+	    p0 = p1;
+	}
+
+	for (int l = 0; l < SDF_BLOCK_SIZE && first+l < numOsc; l++) {
+	    int osc = first + l;
+	    // a rigid oscillator follows the ground
+	    if (periods[osc % numPeriods] <= 0.0)
+		aMax[l] = pga;
+	    Sd[osc] = uMax[l];
+	    Sv[osc] = vMax[l];
+	    Sa[osc] = aMax[l];
+	}
+    }
+
+    return 0;
+}
+
+
+int
+OPS_sdfSpectra(void)
+{
+    // sdfSpectra $tsTag $dt <-periods $T1 ..> <-periodRange $Tmin $Tmax $n>
+    //            <-damp $zeta1 ..> <-method exact|newmark> <-scale $factor>
+    // sdfSpectra -file $fileName $dtF $dt ...
+    // returns for each damping ratio in turn the Sd Sv Sa of each period
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING want sdfSpectra $tsTag $dt <-periods $T ..> <-periodRange $Tmin $Tmax $n> <-damp $zeta ..> <-method exact|newmark> <-scale $factor>\n";
+	return -1;
+    }
+
+    int numData = 1;
+    TimeSeries *theSeries = 0;
+    bool ownSeries = false;
+    const char *first = OPS_GetString();
+    if (strcmp(first, "-file") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 3) {
+	    opserr << "WARNING sdfSpectra -file $fileName $dtF $dt\n";
+	    return -1;
+	}
+	const char *fileName = OPS_GetString();
+	double dtF;
+	if (OPS_GetDoubleInput(&numData, &dtF) < 0) {
+	    opserr << "WARNING sdfSpectra - invalid dtF\n";
+	    return -1;
+	}
+	theSeries = new PathSeries(0, fileName, dtF);
+	ownSeries = true;
+    } else {
+	OPS_ResetCurrentInputArg(-1);
+	int tsTag;
+	if (OPS_GetIntInput(&numData, &tsTag) < 0) {
+	    opserr << "WARNING sdfSpectra - invalid timeSeries tag\n";
+	    return -1;
+	}
+	theSeries = OPS_getTimeSeries(tsTag);
+	if (theSeries == 0) {
+	    opserr << "WARNING sdfSpectra - timeSeries " << tsTag << " does not exist\n";
+	    return -1;
+	}
+    }
+
+    double dt;
+    if (OPS_GetDoubleInput(&numData, &dt) < 0 || dt <= 0.0) {
+	opserr << "WARNING sdfSpectra - invalid dt\n";
+	if (ownSeries)
+	    delete theSeries;
+	return -1;
+    }
+
+    std::vector<double> periods, zetas;
+    int method = SDF_EXACT;
+    double scale = 1.0;
+    int res = 0;
+
+    while (OPS_GetNumRemainingInputArgs() > 0 && res == 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-periods") == 0 || strcmp(opt, "-damp") == 0) {
+	    std::vector<double> &values = (opt[1] == 'p') ? periods : zetas;
+	    values.clear();
+	    while (OPS_GetNumRemainingInputArgs() > 0) {
+		double value;
+		if (OPS_GetDoubleInput(&numData, &value) < 0) {
+		    OPS_ResetCurrentInputArg(-1);
+		    break;
+		}
+		values.push_back(value);
+	    }
+	} else if (strcmp(opt, "-periodRange") == 0) {
+	    double range[2];
+	    int numRange = 2;
+	    int n;
+	    if (OPS_GetNumRemainingInputArgs() < 3 || OPS_GetDoubleInput(&numRange, range) < 0 ||
+		OPS_GetIntInput(&numData, &n) < 0 || range[0] <= 0.0 || range[1] < range[0] || n < 1) {
+		opserr << "WARNING sdfSpectra - invalid -periodRange $Tmin $Tmax $n\n";
+		res = -1;
+		break;
+	    }
+	    // log spaced
+	    periods.clear();
+	    for (int i = 0; i < n; i++)
+		periods.push_back(n == 1 ? range[0] : range[0]*pow(range[1]/range[0], (double)i/(n-1)));
+	} else if (strcmp(opt, "-method") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    const char *type = OPS_GetString();
+	    if (strcmp(type, "exact") == 0)
+		method = SDF_EXACT;
+	    else if (strcmp(type, "newmark") == 0 || strcmp(type, "Newmark") == 0)
+		method = SDF_NEWMARK;
+	    else {
+		opserr << "WARNING sdfSpectra - unknown method " << type << ", want exact or newmark\n";
+		res = -1;
+	    }
+	} else if (strcmp(opt, "-scale") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &scale) < 0) {
+		opserr << "WARNING sdfSpectra - invalid scale factor\n";
+		res = -1;
+	    }
+	} else {
+	    opserr << "WARNING sdfSpectra - unknown option " << opt << endln;
+	    res = -1;
+	}
+    }
+
+    if (res < 0) {
+	if (ownSeries)
+	    delete theSeries;
+	return -1;
+    }
+
+    if (periods.empty())
+	for (int i = 0; i < 100; i++)
+	    periods.push_back(0.01*pow(1000.0, i/99.0));
+    if (zetas.empty())
+	zetas.push_back(0.05);
+
+    // the record is sampled once, the series is not used by the threads
+    double duration = theSeries->getDuration();
+    int numPoints = (int)floor(duration/dt + 1.0e-8) + 1;
+    std::vector<double> ag(numPoints);
+    for (int i = 0; i < numPoints; i++)
+	ag[i] = scale*theSeries->getFactor(i*dt);
+
+    if (ownSeries)
+	delete theSeries;
+
+    int numOsc = (int)(periods.size()*zetas.size());
+    std::vector<double> Sd(numOsc), Sv(numOsc), Sa(numOsc);
+    if (SDF_ElasticSpectra(&ag[0], numPoints, dt, &periods[0], (int)periods.size(),
+			   &zetas[0], (int)zetas.size(), method,
+			   &Sd[0], &Sv[0], &Sa[0]) < 0) {
+	opserr << "WARNING sdfSpectra - failed to integrate the oscillators\n";
+	return -1;
+    }
+
+    std::vector<double> result(3*numOsc);
+    for (int i = 0; i < numOsc; i++) {
+	result[3*i] = Sd[i];
+	result[3*i+1] = Sv[i];
+	result[3*i+2] = Sa[i];
+    }
+
+    int numOutput = 3*numOsc;
+    if (OPS_SetDoubleOutput(&numOutput, &result[0], false) < 0) {
+	opserr << "WARNING sdfSpectra - failed to set the output\n";
+	return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the functions that integrate linear
+// single degree of freedom oscillators for the spectra of a record. Each
+// oscillator, of unit mass, is advanced with a recurrence
+//    u(t+dt) = A u + B v + C p(t) + D p(t+dt)
+//    v(t+dt) = A'u + B'v + C'p(t) + D'p(t+dt)
+// that is exact for a load varying linearly over the step (Nigam &
+// Jennings) or that of the average acceleration Newmark method. As the
+// recurrence is the same for all the oscillators they are integrated side
+// by side, blocks of them in SIMD lanes & the blocks over the threads.
+//
+// What: "@(#) SDFSpectra.h, revA"
+
+#ifndef SDFSpectra_h
+#define SDFSpectra_h
+
+#define SDF_EXACT    0
+#define SDF_NEWMARK  1
+
+// the 8 coefficients A B C D A' B' C' D' for the natural frequency
+// omega & damping ratio zeta; the exact recurrence falls back to Newmark
+// when omega*dt is ~0 or zeta >= 1, the method used is returned
+int SDF_StepCoefficients(double omega, double zeta, double dt, int method,
+			 double *coef);
+
+// the peak relative displacement Sd, relative velocity Sv & absolute
+// acceleration Sa for the ground acceleration ag sampled at dt; the
+// results are stored for each zeta the numPeriods values in turn
+int SDF_ElasticSpectra(const double *ag, int numPoints, double dt,
+		       const double *periods, int numPeriods,
+		       const double *zetas, int numZetas, int method,
+		       double *Sd, double *Sv, double *Sa);
+
+#endif
@@ -33,12 +33,15 @@
 #include <EquiSolnAlgo.h>
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
+#include <LinearSOESolver.h>
 #include <EigenSOE.h>
 #include <DOF_Numberer.h>
 #include <ConstraintHandler.h>
 #include <ConvergenceTest.h>
 #include <StaticIntegrator.h>
+#include <StepRetryPolicy.h>
 #include <Domain.h>
+#include <AnalysisMetrics.h>
 #include <FE_Element.h>
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
@@ -66,7 +69,7 @@ StaticAnalysis::StaticAnalysis(Domain &the_Domain,
  theDOF_Numberer(&theNumberer), theAnalysisModel(&theModel), 
  theAlgorithm(&theSolnAlgo), theSOE(&theLinSOE), theEigenSOE(0),
  theIntegrator(&theStaticIntegrator), theTest(theConvergenceTest),
- domainStamp(0)
+ theRetryPolicy(0), domainStamp(0)
 {
     // first we set up the links needed by the elements in the 
     // aggregation
@@ -111,6 +114,8 @@ StaticAnalysis::clearAll(void)
     delete theTest;
   if (theEigenSOE != 0)
     delete theEigenSOE;
+  if (theRetryPolicy != 0)
+    delete theRetryPolicy;
   
   theAnalysisModel =0;
   theConstraintHandler =0;
@@ -120,6 +125,7 @@ StaticAnalysis::clearAll(void)
   theSOE =0;
   theEigenSOE =0;
   theTest = 0;
+  theRetryPolicy = 0;
 }    
 
 
@@ -130,98 +136,199 @@ StaticAnalysis::analyze(int numSteps, bool flush)
     Domain *the_Domain = this->getDomainPtr();
 
     for (int i=0; i<numSteps; i++) {
+	result = this->analyzeStep(i, numSteps);
+	if (result < 0 && theRetryPolicy != 0)
+	    result = this->retryStep(i, numSteps);
+	if (AnalysisMetrics::isEnabled())
+	    AnalysisMetrics::stepDone(the_Domain, theAlgorithm, result >= 0);
+	if (result < 0)
+	    return result;
+    }
+
+  if (the_Domain != 0 && flush) {
+    the_Domain->flushRecorders();
+  }
+    
+    return 0;
+}
+
+
+// step i of numSteps, the numbers are only used in the messages
+int
+StaticAnalysis::analyzeStep(int i, int numSteps)
+{
+    int result = 0;
+    Domain *the_Domain = this->getDomainPtr();
 
-	result = theAnalysisModel->analysisStep();
+    result = theAnalysisModel->analysisStep();
+
+    if (result < 0) {
+	opserr << "StaticAnalysis::analyze() - the AnalysisModel failed";
+	opserr << " at step: " << i << " with domain at load factor ";
+	opserr << the_Domain->getCurrentTime() << endln;
+	the_Domain->revertToLastCommit();
+	return -2;
+    }
+
+    // check for change in Domain since last step. As a change can
+    // occur in a commit() in a domaindecomp with load balancing
+    // this must now be inside the loop
+
+    int stamp = the_Domain->hasDomainChanged();
+
+
+    if (stamp != domainStamp) {
+	int lastStamp = domainStamp;
+	domainStamp = stamp;
+
+	result = this->handleDomainChange(lastStamp);
 
 	if (result < 0) {
-	    opserr << "StaticAnalysis::analyze() - the AnalysisModel failed";
-	    opserr << " at step: " << i << " with domain at load factor ";
-	    opserr << the_Domain->getCurrentTime() << endln;
-	    the_Domain->revertToLastCommit();
-	    return -2;
+	    opserr << "StaticAnalysis::analyze() - domainChanged failed";
+	    opserr << " at step " << i << " of " << numSteps << endln;
+	    return -1;
 	}
+    }
 
-	// check for change in Domain since last step. As a change can
-	// occur in a commit() in a domaindecomp with load balancing
-	// this must now be inside the loop
+    result = theIntegrator->newStep();
+    if (result < 0) {
+	opserr << "StaticAnalysis::analyze() - the Integrator failed";
+	opserr << " at step: " << i << " with domain at load factor ";
+	opserr << the_Domain->getCurrentTime() << endln;
+	the_Domain->revertToLastCommit();
+	theIntegrator->revertToLastStep();
 
-	int stamp = the_Domain->hasDomainChanged();
 
-	
-	if (stamp != domainStamp) {
-	    domainStamp = stamp;
+	return -2;
+    }
 
-	    result = this->domainChanged();
+       result = theAlgorithm->solveCurrentStep();
+    if (result < 0) {
+	opserr << "StaticAnalysis::analyze() - the Algorithm failed";
+	opserr << " at step: " << i << " with domain at load factor ";
+	opserr << the_Domain->getCurrentTime() << endln;
+	the_Domain->revertToLastCommit();
+	theIntegrator->revertToLastStep();
 
-	    if (result < 0) {
-		opserr << "StaticAnalysis::analyze() - domainChanged failed";
-		opserr << " at step " << i << " of " << numSteps << endln;
-		return -1;
-	    }	
-	}
+	return -3;
+    }
+
+// AddingSensitivity:BEGIN ////////////////////////////////////
 
-	result = theIntegrator->newStep();
+#ifdef _RELIABILITY
+
+    if (theIntegrator->shouldComputeAtEachStep()) {
+
+	result = theIntegrator->computeSensitivities();
 	if (result < 0) {
-	    opserr << "StaticAnalysis::analyze() - the Integrator failed";
+	    opserr << "StaticAnalysis::analyze() - the SensitivityAlgorithm failed";
 	    opserr << " at step: " << i << " with domain at load factor ";
 	    opserr << the_Domain->getCurrentTime() << endln;
 	    the_Domain->revertToLastCommit();
 	    theIntegrator->revertToLastStep();
-
-	 
-	    return -2;
+	    return -5;
 	}
+    }
+#endif
 
-           result = theAlgorithm->solveCurrentStep();
-	if (result < 0) {
-	    opserr << "StaticAnalysis::analyze() - the Algorithm failed";
-	    opserr << " at step: " << i << " with domain at load factor ";
-	    opserr << the_Domain->getCurrentTime() << endln;
-	    the_Domain->revertToLastCommit();	    
-	    theIntegrator->revertToLastStep();
 
-	    return -3;
-	}    
+// AddingSensitivity:END //////////////////////////////////////
 
-// AddingSensitivity:BEGIN ////////////////////////////////////
+    result = theIntegrator->commit();
+    if (result < 0) {
+	opserr << "StaticAnalysis::analyze() - ";
+	opserr << "the Integrator failed to commit";
+	opserr << " at step: " << i << " with domain at load factor ";
+	opserr << the_Domain->getCurrentTime() << endln;
+	the_Domain->revertToLastCommit();
+	theIntegrator->revertToLastStep();
 
-#ifdef _RELIABILITY
+	return -4;
+    }
+
+    return result;
+}
+
+// makes theAlgo & theTest the ones used by analyzeStep(), without
+// deleting those they replace
+void
+StaticAnalysis::linkSolver(EquiSolnAlgo *theAlgo, ConvergenceTest *theNewTest)
+{
+    theAlgorithm = theAlgo;
+    theTest = theNewTest;
+    theIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
+    theAlgorithm->setLinks(*theAnalysisModel, *theIntegrator, *theSOE, theTest);
+}
 
-	if (theIntegrator->shouldComputeAtEachStep()) {
-
-	    result = theIntegrator->computeSensitivities();
-	    if (result < 0) {
-		opserr << "StaticAnalysis::analyze() - the SensitivityAlgorithm failed";
-		opserr << " at step: " << i << " with domain at load factor ";
-		opserr << the_Domain->getCurrentTime() << endln;
-		the_Domain->revertToLastCommit();	    
-		theIntegrator->revertToLastStep();
-		return -5;
-	    }    
+// goes down the ladder of the retry policy after a failed step; the
+// substeps take a fraction of the step size of the integrator, those
+// that converge are kept so each rung splits what remains
+int
+StaticAnalysis::retryStep(int step, int numSteps)
+{
+    EquiSolnAlgo *theOrigAlgorithm = theAlgorithm;
+    ConvergenceTest *theOrigTest = theTest;
+    int origStamp = domainStamp;
+
+    // 0 if the integrator can not change its increment
+    double stepSize = theIntegrator->getStepSize();
+    bool fixedStep = theIntegrator->isStepSizeFixed();
+
+    double remaining = 1.0;
+    int result = -1;
+
+    int numRungs = theRetryPolicy->getNumRungs();
+    for (int rung = 0; rung < numRungs && result < 0; rung++) {
+
+	int numSubSteps = theRetryPolicy->getNumSubSteps(rung);
+	if (numSubSteps > 1 && stepSize == 0.0) {
+	    opserr << "WARNING StaticAnalysis::analyze() - the integrator can not ";
+	    opserr << "be substepped, rung " << rung+1 << " of the retry policy skipped\n";
+	    continue;
 	}
-#endif
 
+	EquiSolnAlgo *theRungAlgorithm = theRetryPolicy->getAlgorithm(rung);
+	ConvergenceTest *theRungTest = theRetryPolicy->getConvergenceTest(rung);
+	if (theRungAlgorithm == 0)
+	    theRungAlgorithm = theOrigAlgorithm;
+	if (theRungTest == 0)
+	    theRungTest = theOrigTest;
+
+	this->linkSolver(theRungAlgorithm, theRungTest);
+	if (theRungAlgorithm != theOrigAlgorithm &&
+	    theRetryPolicy->getDomainStamp(rung) != domainStamp)
+	    theRungAlgorithm->domainChanged();
+
+	double fraction = remaining/numSubSteps;
+
+	result = 0;
+	for (int i = 0; i < numSubSteps && result >= 0; i++) {
+	    if (stepSize != 0.0)
+		theIntegrator->setStepSize(fraction*stepSize);
+	    result = this->analyzeStep(step, numSteps);
+	    if (result >= 0)
+		remaining -= fraction;
+	}
 
-// AddingSensitivity:END //////////////////////////////////////
+	if (theRungAlgorithm != theOrigAlgorithm)
+	    theRetryPolicy->setDomainStamp(rung, domainStamp);
+	if (result >= 0)
+	    theRetryPolicy->recordSuccess(rung);
+    }
 
-	result = theIntegrator->commit();
-	if (result < 0) {
-	    opserr << "StaticAnalysis::analyze() - ";
-	    opserr << "the Integrator failed to commit";
-	    opserr << " at step: " << i << " with domain at load factor ";
-	    opserr << the_Domain->getCurrentTime() << endln;
-	    the_Domain->revertToLastCommit();	    
-	    theIntegrator->revertToLastStep();
+    // back to the solver & step size of the analysis
+    this->linkSolver(theOrigAlgorithm, theOrigTest);
+    if (domainStamp != origStamp)
+	theAlgorithm->domainChanged();
+    if (stepSize != 0.0)
+	theIntegrator->setStepSize(stepSize, fixedStep);
 
-	    return -4;
-	}    	
+    if (result < 0) {
+	opserr << "StaticAnalysis::analyze() - step " << step << " failed on all ";
+	opserr << numRungs << " rungs of the retry policy\n";
     }
 
-  if (the_Domain != 0 && flush) {
-    the_Domain->flushRecorders();
-  }
-    
-    return 0;
+    return result;
 }
 
 
@@ -243,9 +350,10 @@ StaticAnalysis::eigen(int numMode, bool generalized, bool findSmallest)
     int stamp = the_Domain->hasDomainChanged();
 
     if (stamp != domainStamp) {
+      int lastStamp = domainStamp;
       domainStamp = stamp;
       
-      result = this->domainChanged();
+      result = this->handleDomainChange(lastStamp);
       
       if (result < 0) {
 	opserr << "StaticAnalysis::eigen() - domainChanged failed";
@@ -306,6 +414,31 @@ StaticAnalysis::eigen(int numMode, bool generalized, bool findSmallest)
 	  result = -3;
 	}
       }
+
+      if (theEigenSOE->needsC() == true) {
+	theEigenSOE->zeroC();
+	FE_EleIter &theEles3 = theAnalysisModel->getFEs();
+	while((elePtr = theEles3()) != 0) {
+	  elePtr->zeroTangent();
+	  elePtr->addCtoTang(1.0);
+	  if (theEigenSOE->addC(elePtr->getTangent(0), elePtr->getID()) < 0) {
+	    opserr << "WARNING StaticAnalysis::eigen() -";
+	    opserr << " failed in addC for ID " << elePtr->getID();
+	    result = -2;
+	  }
+	}
+
+	DOF_GrpIter &theDofs2 = theAnalysisModel->getDOFs();
+	while((dofPtr = theDofs2()) != 0) {
+	  dofPtr->zeroTangent();
+	  dofPtr->addCtoTang(1.0);
+	  if (theEigenSOE->addC(dofPtr->getTangent(0),dofPtr->getID()) < 0) {
+	    opserr << "WARNING StaticAnalysis::eigen() -";
+	    opserr << " failed in addC for ID " << dofPtr->getID();
+	    result = -3;
+	  }
+	}
+      }
     }
     
     // 
@@ -341,8 +474,9 @@ StaticAnalysis::initialize(void)
     // check if domain has undergone change
     int stamp = the_Domain->hasDomainChanged();
     if (stamp != domainStamp) {
+      int lastStamp = domainStamp;
       domainStamp = stamp;	
-      if (this->domainChanged() < 0) {
+      if (this->handleDomainChange(lastStamp) < 0) {
 	opserr << "DirectIntegrationAnalysis::initialize() - domainChanged() failed\n";
 	return -1;
       }	
@@ -410,6 +544,12 @@ StaticAnalysis::domainChanged(void)
 
     Graph &theGraph = theAnalysisModel->getDOFGraph();
 
+    // if the numberer has already put the equations in a fill-reducing
+    // order the solver is told, so that it does not reorder them again
+    LinearSOESolver *theSolver = theSOE->getSolver();
+    if (theSolver != 0)
+	theSolver->setEquationsOrdered(theDOF_Numberer->isFillReducing());
+
     result = theSOE->setSize(theGraph);
     if (result < 0) {
 	opserr << "StaticAnalysis::handle() - ";
@@ -449,6 +589,34 @@ StaticAnalysis::domainChanged(void)
     return 0;
 }    
 
+// invoked when the domain stamp has moved on from lastStamp. If all that
+// has happened since is the removal of elements, the DOF numbering and the
+// structure of the SOE are still good (the removed elements just leave
+// entries that stay zero) and only their FE_Elements are deleted;
+// otherwise domainChanged() sets up the analysis again.
+int
+StaticAnalysis::handleDomainChange(int lastStamp)
+{
+    Domain *the_Domain = this->getDomainPtr();
+    if (lastStamp == 0 || the_Domain->onlyElementsRemovedSince(lastStamp) == false ||
+	theConstraintHandler->removeFE_Elements() < 0)
+	return this->domainChanged();
+
+    if (theIntegrator->domainChanged() < 0) {
+	opserr << "StaticAnalysis::handleDomainChange() - ";
+	opserr << "Integrator::domainChanged() failed";
+	return -4;
+    }	    
+
+    if (theAlgorithm->domainChanged() < 0) {
+	opserr << "StaticAnalysis::handleDomainChange() - ";
+	opserr << "Algorithm::domainChanged() failed";
+	return -5;
+    }	        
+
+    return 0;
+}
+
 int 
 StaticAnalysis::setNumberer(DOF_Numberer &theNewNumberer) 
 {
@@ -573,6 +741,17 @@ StaticAnalysis::setEigenSOE(EigenSOE &theNewSOE)
 }
 
 
+int
+StaticAnalysis::setRetryPolicy(StepRetryPolicy *thePolicy)
+{
+    // invoke the destructor on the old one
+    if (theRetryPolicy != 0 && theRetryPolicy != thePolicy)
+	delete theRetryPolicy;
+
+    theRetryPolicy = thePolicy;
+    return 0;
+}
+
 int 
 StaticAnalysis::setConvergenceTest(ConvergenceTest &theNewTest)
 {
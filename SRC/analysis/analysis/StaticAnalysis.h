@@ -46,6 +46,7 @@ class LinearSOE;
 class EquiSolnAlgo;
 class ConvergenceTest;
 class EigenSOE;
+class StepRetryPolicy;
 
 class StaticAnalysis: public Analysis
 {
@@ -74,6 +75,7 @@ class StaticAnalysis: public Analysis
     int setLinearSOE(LinearSOE &theSOE);
     int setConvergenceTest(ConvergenceTest &theTest);
     int setEigenSOE(EigenSOE &theSOE);
+    int setRetryPolicy(StepRetryPolicy *thePolicy);
 
     EquiSolnAlgo     *getAlgorithm(void);
     StaticIntegrator *getIntegrator(void);
@@ -82,6 +84,11 @@ class StaticAnalysis: public Analysis
   protected: 
     
   private:
+    int handleDomainChange(int lastStamp);
+    int analyzeStep(int step, int numSteps);
+    int retryStep(int step, int numSteps);
+    void linkSolver(EquiSolnAlgo *theAlgo, ConvergenceTest *theTest);
+
     ConstraintHandler 	*theConstraintHandler;    
     DOF_Numberer 	*theDOF_Numberer;
     AnalysisModel 	*theAnalysisModel;
@@ -90,6 +97,7 @@ class StaticAnalysis: public Analysis
     EigenSOE 		*theEigenSOE;
     StaticIntegrator    *theIntegrator;
     ConvergenceTest     *theTest;
+    StepRetryPolicy     *theRetryPolicy;
     int domainStamp;
 
 };
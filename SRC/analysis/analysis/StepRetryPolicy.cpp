@@ -0,0 +1,127 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of StepRetryPolicy.
+//
+// What: "@(#) StepRetryPolicy.cpp, revA"
+
+#include <StepRetryPolicy.h>
+#include <EquiSolnAlgo.h>
+#include <ConvergenceTest.h>
+
+StepRetryPolicy::StepRetryPolicy()
+{
+
+}
+
+StepRetryPolicy::~StepRetryPolicy()
+{
+  this->clear();
+}
+
+int
+StepRetryPolicy::addRung(EquiSolnAlgo *theAlgo, ConvergenceTest *theTest,
+			 int numSubSteps)
+{
+  if (theAlgo == 0 && theTest == 0 && numSubSteps <= 1) {
+    opserr << "WARNING StepRetryPolicy::addRung() - a rung must change the ";
+    opserr << "algorithm, the test or the number of substeps\n";
+    return -1;
+  }
+
+  Rung theRung;
+  theRung.theAlgo = theAlgo;
+  theRung.theTest = theTest;
+  theRung.numSubSteps = (numSubSteps < 1) ? 1 : numSubSteps;
+  theRung.domainStamp = -1;
+  theRung.numSuccess = 0;
+  rungs.push_back(theRung);
+
+  return 0;
+}
+
+void
+StepRetryPolicy::clear(void)
+{
+  for (unsigned int i = 0; i < rungs.size(); i++) {
+    if (rungs[i].theAlgo != 0)
+      delete rungs[i].theAlgo;
+    if (rungs[i].theTest != 0)
+      delete rungs[i].theTest;
+  }
+  rungs.clear();
+}
+
+int
+StepRetryPolicy::getNumRungs(void) const
+{
+  return (int)rungs.size();
+}
+
+EquiSolnAlgo *
+StepRetryPolicy::getAlgorithm(int rung) const
+{
+  return rungs[rung].theAlgo;
+}
+
+ConvergenceTest *
+StepRetryPolicy::getConvergenceTest(int rung) const
+{
+  return rungs[rung].theTest;
+}
+
+int
+StepRetryPolicy::getNumSubSteps(int rung) const
+{
+  return rungs[rung].numSubSteps;
+}
+
+int
+StepRetryPolicy::getDomainStamp(int rung) const
+{
+  return rungs[rung].domainStamp;
+}
+
+void
+StepRetryPolicy::setDomainStamp(int rung, int stamp)
+{
+  rungs[rung].domainStamp = stamp;
+}
+
+void
+StepRetryPolicy::recordSuccess(int rung)
+{
+  rungs[rung].numSuccess++;
+}
+
+void
+StepRetryPolicy::Print(OPS_Stream &s, int flag)
+{
+  s << "StepRetryPolicy, " << (int)rungs.size() << " rungs" << endln;
+  for (unsigned int i = 0; i < rungs.size(); i++) {
+    s << "\trung " << (int)i+1 << ": ";
+    if (rungs[i].theAlgo != 0)
+      s << "own algorithm, ";
+    if (rungs[i].theTest != 0)
+      s << "own test, ";
+    s << rungs[i].numSubSteps << " substeps, ";
+    s << rungs[i].numSuccess << " steps recovered" << endln;
+  }
+}
@@ -0,0 +1,79 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef StepRetryPolicy_h
+#define StepRetryPolicy_h
+
+// Description: This file contains the class definition for
+// StepRetryPolicy. A StepRetryPolicy is an ordered ladder of fallbacks
+// tried by a StaticAnalysis or DirectIntegrationAnalysis when a step
+// fails: each rung gives an algorithm and a convergence test to use in
+// place of those of the analysis (either may be 0 to keep the analysis
+// one) and the number of substeps to split what is left of the step
+// into. The analysis reverts to the last commit itself, so a failed step
+// is retried without going back to the interpreter. The policy owns the
+// algorithms and tests of its rungs.
+//
+// What: "@(#) StepRetryPolicy.h, revA"
+
+#include <OPS_Stream.h>
+#include <vector>
+
+class EquiSolnAlgo;
+class ConvergenceTest;
+
+class StepRetryPolicy
+{
+  public:
+    StepRetryPolicy();
+    ~StepRetryPolicy();
+
+    int addRung(EquiSolnAlgo *theAlgo, ConvergenceTest *theTest,
+		int numSubSteps = 1);
+    void clear(void);
+
+    int getNumRungs(void) const;
+    EquiSolnAlgo *getAlgorithm(int rung) const;
+    ConvergenceTest *getConvergenceTest(int rung) const;
+    int getNumSubSteps(int rung) const;
+
+    // the domain stamp the algorithm of the rung was last set up for
+    int getDomainStamp(int rung) const;
+    void setDomainStamp(int rung, int stamp);
+
+    void recordSuccess(int rung);
+
+    void Print(OPS_Stream &s, int flag = 0);
+
+  protected:
+
+  private:
+    struct Rung {
+	EquiSolnAlgo *theAlgo;
+	ConvergenceTest *theTest;
+	int numSubSteps;
+	int domainStamp;
+	int numSuccess;     // steps that converged on this rung
+    };
+
+    std::vector<Rung> rungs;
+};
+
+#endif
@@ -39,9 +39,16 @@
 #include <TransientIntegrator.h>
 #include <Domain.h>
 #include <ConvergenceTest.h>
+#include <AnalysisMetrics.h>
 #include <float.h>
+#include <math.h>
 #include <AnalysisModel.h>
 
+// safety factor and bounds on the change of dT from the error estimate
+#define ERROR_DT_SAFETY 0.9
+#define ERROR_DT_MIN_FACTOR 0.2
+#define ERROR_DT_MAX_FACTOR 2.0
+
 // Constructor
 VariableTimeStepDirectIntegrationAnalysis::VariableTimeStepDirectIntegrationAnalysis(
 			      Domain &the_Domain,
@@ -54,7 +61,8 @@ VariableTimeStepDirectIntegrationAnalysis::VariableTimeStepDirectIntegrationAnal
 			      ConvergenceTest *theTest)
 
 :DirectIntegrationAnalysis(the_Domain, theHandler, theNumberer, theModel, 
-			   theSolnAlgo, theLinSOE, theTransientIntegrator, theTest)
+			   theSolnAlgo, theLinSOE, theTransientIntegrator, theTest),
+ errorTol(0.0), dispScale(0.0)
 {
 
 }    
@@ -64,6 +72,12 @@ VariableTimeStepDirectIntegrationAnalysis::~VariableTimeStepDirectIntegrationAna
 
 }    
 
+void
+VariableTimeStepDirectIntegrationAnalysis::setErrorTolerance(double tol)
+{
+  errorTol = (tol > 0.0) ? tol : 0.0;
+}
+
 int 
 VariableTimeStepDirectIntegrationAnalysis::analyze(int numSteps, double dT, double dtMin, double dtMax, int Jd, bool flush)
 {
@@ -134,6 +148,20 @@ VariableTimeStepDirectIntegrationAnalysis::analyze(int numSteps, double dT, doub
 #endif
     // AddingSensitivity:END //////////////////////////////////////
 
+    // with error control a converged step whose estimated local error is
+    // above the tolerance is rejected, unless dT is already at dtMin
+    double errRatio = -1.0;
+    if (result >= 0 && errorTol > 0.0) {
+      double errNorm, dispNorm;
+      if (theIntegratr->estimateLocalError(currentDt, errNorm, dispNorm) == 0) {
+	if (dispNorm > dispScale)
+	  dispScale = dispNorm;
+	errRatio = (dispScale > 0.0) ? errNorm/(errorTol*dispScale) : 0.0;
+	if (errRatio > 1.0 && currentDt > dtMin)
+	  result = -6;
+      }
+    }
+
     if (result >= 0) {
       result = theIntegratr->commit();
       if (result < 0) 
@@ -143,6 +171,9 @@ VariableTimeStepDirectIntegrationAnalysis::analyze(int numSteps, double dT, doub
     // if the time step was successful increment delta T for the analysis
     // otherwise revert the Domain to last committed state & see if can go on
 
+    if (AnalysisMetrics::isEnabled())
+      AnalysisMetrics::stepDone(theDom, theAlgo, result >= 0);
+
     if (result >= 0) 
       currentTimeIncr += currentDt;
     else {
@@ -163,8 +194,26 @@ VariableTimeStepDirectIntegrationAnalysis::analyze(int numSteps, double dT, doub
       result = 0;
     }
 
-    // now we determine a new delta T for next loop
+    // now we determine a new delta T for next loop, the error estimate
+    // (of order dT^3) can only make it smaller than the iterations allow
+    double lastDt = currentDt;
     currentDt = this->determineDt(currentDt, dtMin, dtMax, Jd, theTest);
+
+    if (errRatio >= 0.0) {
+      double factor = ERROR_DT_MAX_FACTOR;
+      if (errRatio > 0.0)
+	factor = ERROR_DT_SAFETY*pow(errRatio, -1.0/3.0);
+      if (factor < ERROR_DT_MIN_FACTOR)
+	factor = ERROR_DT_MIN_FACTOR;
+      else if (factor > ERROR_DT_MAX_FACTOR)
+	factor = ERROR_DT_MAX_FACTOR;
+
+      double errorDt = lastDt*factor;
+      if (errorDt < dtMin)
+	errorDt = dtMin;
+      if (errorDt < currentDt)
+	currentDt = errorDt;
+    }
   }
 
   if (theDom != 0 && flush) {
@@ -34,6 +34,10 @@
 // VariableTimeStepDirectIntegrationAnalysis. VariableTimeStepDirectIntegrationAnalysis 
 // is a subclass of DirectIntegrationAnalysis. It is used to perform a 
 // dynamic analysis on the FE\_Model using a direct integration scheme.  
+// The time step is adjusted from the number of iterations of the last
+// step and, if an error tolerance has been set and the integrator has
+// an estimate, from the local error in the displacements: steps with
+// too large an error are repeated with a smaller dT.
 //
 // What: "@(#) VariableTimeStepDirectIntegrationAnalysis.h, revA"
 
@@ -63,11 +67,17 @@ class VariableTimeStepDirectIntegrationAnalysis: public DirectIntegrationAnalysi
     int analyze(int numSteps, double dT, double dtMin, double dtMax,
                 int Jd, bool flush = true);
 
+    // tol is relative to the largest displacement norm reached, 0 turns
+    // the error control off
+    void setErrorTolerance(double tol);
+
    protected:
     virtual double determineDt(double dT, double dtMin, double dtMax, int Jd,
 			       ConvergenceTest *theTest);
 
   private:
+    double errorTol;
+    double dispScale;     // largest displacement norm reached
 };
 
 #endif
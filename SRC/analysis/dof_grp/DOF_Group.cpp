@@ -42,6 +42,7 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <TransientIntegrator.h>
+#include <MemoryReport.h>
 
 #define MAX_NUM_DOF 256
 
@@ -284,6 +285,19 @@ DOF_Group::getID(void) const
 }
 
 
+// the class wide tangent & unbalance are not counted
+size_t
+DOF_Group::getMemoryUsage(void)
+{
+    size_t bytes = MemoryReport::objectSize(this) + myID.Size()*sizeof(int);
+
+    if (numDOF > MAX_NUM_DOF)
+	bytes += MemoryReport::matrixSize(tangent) + MemoryReport::vectorSize(unbalance);
+
+    return bytes;
+}
+
+
 
 int
 DOF_Group::doneID(void)
@@ -642,6 +656,58 @@ DOF_Group::setNodeAccel(const Vector &udotdot)
 }
 
 
+// void setNodeResponse(const Vector &u, const Vector &udot, const Vector &udotdot);
+//	Method to set the corresponding nodes displacements, velocities
+//	and accelerations in one call; when all the dof of the node are
+//	in the system the current trial values need not be fetched first.
+
+void
+DOF_Group::setNodeResponse(const Vector &u, const Vector &udot,
+			   const Vector &udotdot)
+{
+    if (myNode == 0) {
+	opserr << "DOF_Group::setNodeResponse: no associated Node\n";
+	return;
+    }
+
+    bool allFree = true;
+    for (int i=0; i<numDOF; i++)
+	if (myID(i) < 0) {
+	    allFree = false;
+	    break;
+	}
+
+    Vector &resp = *unbalance;
+
+    if (allFree == false)
+	resp = myNode->getTrialDisp();
+    for (int i=0; i<numDOF; i++) {
+	int loc = myID(i);
+	if (loc >= 0)
+	    resp(i) = u(loc);
+    }
+    myNode->setTrialDisp(resp);
+
+    if (allFree == false)
+	resp = myNode->getTrialVel();
+    for (int i=0; i<numDOF; i++) {
+	int loc = myID(i);
+	if (loc >= 0)
+	    resp(i) = udot(loc);
+    }
+    myNode->setTrialVel(resp);
+
+    if (allFree == false)
+	resp = myNode->getTrialAccel();
+    for (int i=0; i<numDOF; i++) {
+	int loc = myID(i);
+	if (loc >= 0)
+	    resp(i) = udotdot(loc);
+    }
+    myNode->setTrialAccel(resp);
+}
+
+
 // void setNodeIncrDisp(const Vector &u);
 //	Method to set the corresponding nodes displacements to the
 //	values in u, components identified by myID;
@@ -808,6 +874,13 @@ DOF_Group::getT(void)
 }
 
 
+bool
+DOF_Group::hasConstantT(void)
+{
+    return true;
+}
+
+
 
 void  
 DOF_Group::addLocalM_Force(const Vector &accel, double fact)
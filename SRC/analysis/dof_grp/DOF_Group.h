@@ -61,6 +61,9 @@ class DOF_Group: public TaggedObject
     virtual const ID &getID(void) const;
     virtual int doneID(void);    
 
+    // bytes of the object & the storage it owns, for the memory report
+    virtual size_t getMemoryUsage(void);
+
     virtual int getNodeTag(void) const;
     virtual int getNumDOF(void) const;    
     virtual int getNumFreeDOF(void) const;
@@ -92,6 +95,8 @@ class DOF_Group: public TaggedObject
     virtual void setNodeDisp(const Vector &u);
     virtual void setNodeVel(const Vector &udot);
     virtual void setNodeAccel(const Vector &udotdot);
+    virtual void setNodeResponse(const Vector &u, const Vector &udot,
+				 const Vector &udotdot);
 
     virtual void incrNodeDisp(const Vector &u);
     virtual void incrNodeVel(const Vector &udot);
@@ -110,6 +115,7 @@ class DOF_Group: public TaggedObject
 	
     // method added for TransformationDOF_Groups
     virtual Matrix *getT(void);
+    virtual bool hasConstantT(void);
 
 // AddingSensitivity:BEGIN ////////////////////////////////////
     virtual void addM_ForceSensitivity(const Vector &Udotdot, double fact = 1.0);        
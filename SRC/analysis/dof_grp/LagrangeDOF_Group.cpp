@@ -144,6 +144,16 @@ LagrangeDOF_Group::setNodeAccel(const Vector &udotdot)
 }
 
 
+// the multipliers live in the displacement vector only, there is no node
+
+void
+LagrangeDOF_Group::setNodeResponse(const Vector &u, const Vector &udot,
+				   const Vector &udotdot)
+{
+    this->setNodeDisp(u);
+}
+
+
 // void setNodeIncrDisp(const Vector &u);
 //	Method to set the corresponding nodes displacements to the
 //	values in u, components identified by myID;
@@ -68,6 +68,8 @@ class LagrangeDOF_Group: public DOF_Group
     virtual void setNodeDisp(const Vector &u);
     virtual void setNodeVel(const Vector &udot);
     virtual void setNodeAccel(const Vector &udotdot);
+    virtual void setNodeResponse(const Vector &u, const Vector &udot,
+				 const Vector &udotdot);
 
     virtual void incrNodeDisp(const Vector &u);
     virtual void incrNodeVel(const Vector &udot);
@@ -655,6 +655,23 @@ TransformationDOF_Group::setNodeAccel(const Vector &u)
 }
 
 
+// the constrained response is formed from the retained node, which the
+// fused base class method knows nothing about, so each is set in turn
+void
+TransformationDOF_Group::setNodeResponse(const Vector &u, const Vector &udot,
+					 const Vector &udotdot)
+{
+    if (theMP == 0) {
+	this->DOF_Group::setNodeResponse(u, udot, udotdot);
+	return;
+    }
+
+    this->setNodeDisp(u);
+    this->setNodeVel(udot);
+    this->setNodeAccel(udotdot);
+}
+
+
 // void setNodeIncrDisp(const Vector &u);
 //	Method to set the corresponding nodes displacements to the
 //	values in u, components identified by myID;
@@ -922,6 +939,16 @@ TransformationDOF_Group::getT(void)
 }
 
 
+bool
+TransformationDOF_Group::hasConstantT(void)
+{
+    if (theMP == 0)
+	return true;
+
+    return (theMP->isTimeVarying() == false);
+}
+
+
 int
 TransformationDOF_Group::doneID(void)
 {
@@ -65,6 +65,7 @@ class TransformationDOF_Group: public DOF_Group
     const ID &getID(void) const; 
     virtual void setID(int dof, int value);    
     Matrix *getT(void);
+    bool hasConstantT(void);
     virtual int getNumDOF(void) const;    
     virtual int getNumFreeDOF(void) const;
     virtual int getNumConstrainedDOF(void) const;
@@ -89,6 +90,8 @@ class TransformationDOF_Group: public DOF_Group
     void setNodeDisp(const Vector &u);
     void setNodeVel(const Vector &udot);
     void setNodeAccel(const Vector &udotdot);
+    void setNodeResponse(const Vector &u, const Vector &udot,
+			 const Vector &udotdot);
 
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
@@ -42,14 +42,20 @@
 #include <AnalysisModel.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <AnalysisProfiler.h>
+#include <MemoryReport.h>
 
-#define MAX_NUM_DOF 64
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // static variables initialisation
 Matrix FE_Element::errMatrix(1,1);
 Vector FE_Element::errVector(1);
-Matrix **FE_Element::theMatrices; // pointers to class wide matrices
-Vector **FE_Element::theVectors;  // pointers to class widde vectors
+Matrix **FE_Element::theMatrices(0); // pointers to class wide matrices
+Vector **FE_Element::theVectors(0);  // pointers to class widde vectors
+int FE_Element::maxNumDOF(0);        // largest size of class wide objects
+int FE_Element::numThreads(0);       // threads with class wide objects
 int FE_Element::numFEs(0);           // number of objects
 
 //  FE_Element(Element *, Integrator *theIntegrator);
@@ -58,7 +64,8 @@ FE_Element::FE_Element(int tag, Element *ele)
   :TaggedObject(tag),
    myDOF_Groups((ele->getExternalNodes()).Size()), myID(ele->getNumDOF()), 
    numDOF(ele->getNumDOF()), theModel(0), myEle(ele), 
-   theResidual(0), theTangent(0), theIntegrator(0)
+   theResidual(0), theTangent(0), theIntegrator(0), sharedStorage(false), theElementK(0),
+   theElementKStamp(0)
 {
   if (numDOF <= 0) {
     opserr << "FE_Element::FE_Element(Element *) ";
@@ -96,59 +103,15 @@ FE_Element::FE_Element(int tag, Element *ele)
 	}
     }
 
-    // if this is the first FE_Element we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numFEs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "FE_Element::FE_Element(Element *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }
-
     if (ele->isSubdomain() == false) {
 	
-	// if Elements are not subdomains, set up pointers to
-	// objects to return tangent Matrix and residual Vector.
-
-	if (numDOF <= MAX_NUM_DOF) {
-	    // use class wide objects
-	    if (theVectors[numDOF] == 0) {
-		theVectors[numDOF] = new Vector(numDOF);
-		theMatrices[numDOF] = new Matrix(numDOF,numDOF);
-		theResidual = theVectors[numDOF];
-		theTangent = theMatrices[numDOF];
-		if (theResidual == 0 || theResidual->Size() != numDOF ||	
-		    theTangent == 0 || theTangent->noCols() != numDOF)	{  
-		    opserr << "FE_Element::FE_Element(Element *) ";
-		    opserr << " ran out of memory for vector/Matrix of size :";
-		    opserr << numDOF << endln;
-		    exit(-1);
-		}
-	    } else {
-		theResidual = theVectors[numDOF];
-		theTangent = theMatrices[numDOF];
-	    }
-	} else {
-	    // create matrices and vectors for each object instance
-	    theResidual = new Vector(numDOF);
-	    theTangent = new Matrix(numDOF, numDOF);
-	    if (theResidual == 0 || theTangent ==0 ||
-		theTangent ==0 || theTangent->noRows() ==0) {
-	    
-		opserr << "FE_Element::FE_Element(Element *) ";
-		opserr << " ran out of memory for vector/Matrix of size :";
-		opserr << numDOF << endln;
-		exit(-1);
-	    }
-	} 
+	// if Elements are not subdomains, the tangent Matrix and residual
+	// Vector are class wide objects of the size, whatever the size,
+	// so no FE_Element keeps a copy of its own
+	growStorage(1, numDOF);
+	sharedStorage = true;
+	this->setStorage();
+
     } else {
 
 	// as subdomains have own matrix for tangent and residual don't need
@@ -167,28 +130,12 @@ FE_Element::FE_Element(int tag, Element *ele)
 FE_Element::FE_Element(int tag, int numDOF_Group, int ndof)
   :TaggedObject(tag),
    myDOF_Groups(numDOF_Group), myID(ndof), numDOF(ndof), theModel(0),
-   myEle(0), theResidual(0), theTangent(0), theIntegrator(0)
+   myEle(0), theResidual(0), theTangent(0), theIntegrator(0),
+   sharedStorage(false), theElementK(0), theElementKStamp(0)
 {
     // this is for a subtype, the subtype must set the myDOF_Groups ID array
     numFEs++;
 
-    // if this is the first FE_Element we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numFEs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "FE_Element::FE_Element(Element *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }
-    
     // as subtypes have no access to the tangent or residual we don't set them
     // this way we can detect if subclass does not provide all methods it should
 }
@@ -203,16 +150,18 @@ FE_Element::~FE_Element()
     // decrement number of FE_Elements
     numFEs--;
 
-    // delete tangent and residual if created specially
-    if (numDOF > MAX_NUM_DOF) {
-	if (theTangent != 0) delete theTangent;
-	if (theResidual != 0) delete theResidual;
-    }
+    // delete the residual of a Subdomain, the others are class wide
+    if (sharedStorage == false && theResidual != 0)
+	delete theResidual;
+
+    if (theElementK != 0)
+	delete theElementK;
 
     // if this is the last FE_Element, clean up the
     // storage for the matrix and vector objects
-    if (numFEs == 0) {
-	for (int i=0; i<MAX_NUM_DOF; i++) {
+    if (numFEs == 0 && theMatrices != 0) {
+	int size = 2*numThreads*(maxNumDOF+1);
+	for (int i=0; i<size; i++) {
 	    if (theVectors[i] != 0)
 		delete theVectors[i];
 	    if (theMatrices[i] != 0)
@@ -220,10 +169,104 @@ FE_Element::~FE_Element()
 	}	
 	delete [] theMatrices;
 	delete [] theVectors;
+	theMatrices = 0;
+	theVectors = 0;
+	maxNumDOF = 0;
+	numThreads = 0;
     }
 }    
 
 
+// static void growStorage(int theNumThreads, int theNumDOF);
+//	grows the class wide arrays to hold a tangent and residual for
+//	each of theNumThreads, each of the 2 sets and each size up to
+//	theNumDOF; the objects themselves are created the first time they
+//	are needed. Not to be invoked while FE_Elements are used concurrently.
+
+void
+FE_Element::growStorage(int theNumThreads, int theNumDOF)
+{
+    if (theNumThreads < numThreads)
+	theNumThreads = numThreads;
+    if (theNumDOF < maxNumDOF)
+	theNumDOF = maxNumDOF;
+    if (theNumThreads == numThreads && theNumDOF == maxNumDOF)
+	return;
+
+    int size = 2*theNumThreads*(theNumDOF+1);
+    Matrix **newMatrices = new Matrix *[size];
+    Vector **newVectors = new Vector *[size];
+    for (int i=0; i<size; i++) {
+	newMatrices[i] = 0;
+	newVectors[i] = 0;
+    }
+
+    for (int s=0; s<2*numThreads; s++)
+	for (int n=0; n<=maxNumDOF; n++) {
+	    newMatrices[s*(theNumDOF+1)+n] = theMatrices[s*(maxNumDOF+1)+n];
+	    newVectors[s*(theNumDOF+1)+n] = theVectors[s*(maxNumDOF+1)+n];
+	}
+
+    if (theMatrices != 0) {
+	delete [] theMatrices;
+	delete [] theVectors;
+    }
+
+    theMatrices = newMatrices;
+    theVectors = newVectors;
+    numThreads = theNumThreads;
+    maxNumDOF = theNumDOF;
+}
+
+
+// static void getStorage(int theNumDOF, int set, Matrix *&, Vector *&);
+//	sets theMatrix & theVector to the class wide objects of the size
+//	in the set of the calling thread, growStorage() must have made room
+//	for them before; these are only used until the next object of the
+//	same size and set is formed by the thread.
+
+void
+FE_Element::getStorage(int theNumDOF, int set, Matrix *&theMatrix, Vector *&theVector)
+{
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    if (t >= numThreads || theNumDOF > maxNumDOF) {
+	opserr << "FATAL FE_Element::getStorage() - no class wide objects of size ";
+	opserr << theNumDOF << " for thread " << t;
+	opserr << ", setPrivateStorage() was not invoked before the concurrent loop\n";
+	exit(-1);
+    }
+
+    int i = (2*t + set)*(maxNumDOF+1) + theNumDOF;
+    if (theMatrices[i] == 0) {
+	theMatrices[i] = new Matrix(theNumDOF, theNumDOF);
+	theVectors[i] = new Vector(theNumDOF);
+	if (theMatrices[i]->noCols() != theNumDOF || theVectors[i]->Size() != theNumDOF) {
+	    opserr << "FE_Element::getStorage() ";
+	    opserr << " ran out of memory for vector/Matrix of size :";
+	    opserr << theNumDOF << endln;
+	    exit(-1);
+	}
+    }
+
+    theMatrix = theMatrices[i];
+    theVector = theVectors[i];
+}
+
+
+// void setStorage(void);
+//	points theTangent & theResidual at the class wide objects of the
+//	calling thread.
+
+void
+FE_Element::setStorage(void)
+{
+    getStorage(numDOF, 0, theTangent, theResidual);
+}
+
+
 const ID &
 FE_Element::getDOFtags(void) const 
 {
@@ -240,6 +283,21 @@ FE_Element::getID(void) const
     return myID;
 }
 
+
+// the class wide tangent & residual are not counted
+size_t
+FE_Element::getMemoryUsage(void)
+{
+    size_t bytes = MemoryReport::objectSize(this)
+	+ (myDOF_Groups.Size() + myID.Size())*sizeof(int);
+
+    if (sharedStorage == false)
+	bytes += MemoryReport::vectorSize(theResidual);
+    bytes += MemoryReport::matrixSize(theElementK);
+
+    return bytes;
+}
+
 void 
 FE_Element::setAnalysisModel(AnalysisModel &theAnalysisModel)
 {
@@ -297,8 +355,17 @@ FE_Element::getTangent(Integrator *theNewIntegrator)
     }
 
     if (myEle->isSubdomain() == false) {
-      if (theNewIntegrator != 0)
-	theNewIntegrator->formEleTangent(this);	    	    
+      if (theNewIntegrator != 0) {
+	this->setStorage();
+	ProfileClass cost(ProfileClass::Element, myEle);
+	if (Element::measureCost == false)
+	  theNewIntegrator->formEleTangent(this);	    	    
+	else {
+	  double start = Element::wallTime();
+	  theNewIntegrator->formEleTangent(this);	    	    
+	  myEle->addMeasuredCost(Element::wallTime() - start);
+	}
+      }
 
       return *theTangent;
     } else {
@@ -324,6 +391,8 @@ FE_Element::getResidual(Integrator *theNewIntegrator)
     }    
 
     if (myEle->isSubdomain() == false) {
+      this->setStorage();
+      ProfileClass cost(ProfileClass::Element, myEle);
       theNewIntegrator->formEleResidual(this);
       return *theResidual;
     } else {
@@ -358,7 +427,7 @@ FE_Element::addKtToTang(double fact)
 	    return;
 	else if (myEle->isSubdomain() == false)	    
 	{
-	    const Matrix& Kt = myEle->getTangentStiff();
+	    const Matrix& Kt = this->getElementTangentStiff();
 	    theTangent->addMatrix(1.0, Kt,fact);
 	}
 	else {
@@ -368,6 +437,50 @@ FE_Element::addKtToTang(double fact)
     }
 }
 
+// returns the element tangent stiffness. For an element whose tangent 
+// does not change with its state the tangent is obtained on the first 
+// call and kept; it is obtained again when the parameter stamp of the
+// domain has changed, as Parameters can change the element properties.
+// A frozen element returns its tangent at the freeze.
+const Matrix &
+FE_Element::getElementTangentStiff(void)
+{
+    if (myEle->isFrozen() == true)
+	return myEle->getFrozenTangent();
+
+    if (myEle->hasConstantTangent() == false)
+	return myEle->getTangentStiff();
+
+    Domain *theDomain = myEle->getDomain();
+    if (theDomain == 0) {
+	if (theElementK != 0) {
+	    delete theElementK;
+	    theElementK = 0;
+	}
+	return myEle->getTangentStiff();
+    }
+
+    int stamp = theDomain->getParameterStamp();
+    if (theElementK != 0 && theElementKStamp != stamp) {
+	*theElementK = myEle->getTangentStiff();
+	theElementKStamp = stamp;
+    }
+
+    if (theElementK == 0) {
+	theElementK = new Matrix(myEle->getTangentStiff());
+	theElementKStamp = stamp;
+	if (theElementK == 0 || theElementK->noRows() != numDOF) {
+	    opserr << "WARNING FE_Element::getElementTangentStiff() - ";
+	    opserr << "ran out of memory for the element tangent\n";
+	    if (theElementK != 0) delete theElementK;
+	    theElementK = 0;
+	    return myEle->getTangentStiff();
+	}
+    }
+
+    return *theElementK;
+}
+
 void  
 FE_Element::addCtoTang(double fact)
 {
@@ -490,6 +603,10 @@ FE_Element::addRtoResidual(double fact)
     if (fact == 0.0 || !myEle->isActive()) 
       return;
     else if (myEle->isSubdomain() == false) {
+      if (myEle->isFrozen() == true) {
+	theResidual->addVector(1.0, myEle->getFrozenResistingForce(), -fact);
+	return;
+      }
       const Vector &eleResisting = myEle->getResistingForce();
       theResidual->addVector(1.0, eleResisting, -fact);
     }
@@ -515,6 +632,12 @@ FE_Element::addRIncInertiaToResidual(double fact)
 	else if (myEle->isSubdomain() == false) {
 	  const Vector &eleResisting = myEle->getResistingForceIncInertia();
 	  theResidual->addVector(1.0, eleResisting, -fact);
+	  // a frozen element has its resisting force replaced by the one
+	  // from the freeze, the inertia and damping forces are kept
+	  if (myEle->isFrozen() == true) {
+	    theResidual->addVector(1.0, myEle->getResistingForce(), fact);
+	    theResidual->addVector(1.0, myEle->getFrozenResistingForce(), -fact);
+	  }
 	}
 	else {
 	    opserr << "WARNING FE_Element::addRtoResidual() - ";
@@ -600,7 +723,7 @@ FE_Element::getK_Force(const Vector &disp, double fact)
 	    tmp(i) = 0.0;
 	}
 
-	if (theResidual->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0){
+	if (theResidual->addMatrixVector(1.0, this->getElementTangentStiff(), tmp, fact) < 0){
 	  opserr << "WARNING FE_Element::getKForce() - ";
 	  opserr << "- addMatrixVector returned error\n";		 
 	}		
@@ -854,7 +977,7 @@ FE_Element::addK_Force(const Vector &disp, double fact)
 		    tmp(i) = 0.0;		
 	    }	  
 		
-	    if (theResidual->addMatrixVector(1.0, myEle->getTangentStiff(), tmp, fact) < 0){
+	    if (theResidual->addMatrixVector(1.0, this->getElementTangentStiff(), tmp, fact) < 0){
 		opserr << "WARNING FE_Element::addK_Force() - ";
 		opserr << "- addMatrixVector returned error\n";		 
 	    }		
@@ -1104,7 +1227,7 @@ FE_Element::commitSensitivity(int gradNum, int numGrads)
 int  
 FE_Element::updateElement(void)
 {
-  if (myEle != 0 && myEle->isActive()) {
+  if (myEle != 0 && myEle->isActive() && myEle->isFrozen() == false) {
     return myEle->update();
     opserr << "FE_Element::update()"; myEle->Print(opserr, 0);
   }
@@ -1114,6 +1237,49 @@ FE_Element::updateElement(void)
 }
 
 
+// bool isThreadSafe(void);
+//	returns true if getTangent() and getResidual() may be invoked for
+//	this object concurrently with other FE_Elements; this requires the
+//	element to be thread safe and storage not shared with other objects.
+//	a subdomain keeps its own condensed tangent and residual, so it is
+//	thread safe when the subdomain itself says so.
+
+bool
+FE_Element::isThreadSafe(void)
+{
+  if (myEle == 0)
+    return false;
+
+  return myEle->isThreadSafe();
+}
+
+
+// int setPrivateStorage(void);
+//	makes room for a class wide tangent and residual of the size for
+//	every thread, so getTangent() and getResidual() can be invoked
+//	concurrently with other FE_Elements; each thread forms into its
+//	own objects and no storage is kept by this object.
+
+int
+FE_Element::setPrivateStorage(void)
+{
+  if (myEle == 0)
+    return -1;
+
+  // the subdomain forms into its own objects already
+  if (myEle->isSubdomain() == true)
+    return 0;
+
+  int num = 1;
+#ifdef _OPENMP
+  num = omp_get_max_threads();
+#endif
+  growStorage(num, numDOF);
+
+  return 0;
+}
+
+
 void FE_Element::activate()
 { 
 	myEle->activate();
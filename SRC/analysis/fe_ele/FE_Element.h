@@ -56,6 +56,9 @@ class FE_Element: public TaggedObject
     virtual const ID &getID(void) const;
     void setAnalysisModel(AnalysisModel &theModel);
     virtual int  setID(void);
+
+    // bytes of the object & the storage it owns, for the memory report
+    virtual size_t getMemoryUsage(void);
     
     // methods to form and obtain the tangent and residual
     virtual const Matrix &getTangent(Integrator *theIntegrator);
@@ -89,6 +92,10 @@ class FE_Element: public TaggedObject
 
     virtual int updateElement(void);
 
+    // methods for concurrent formation of tangent and residual
+    virtual bool isThreadSafe(void);
+    virtual int  setPrivateStorage(void);
+
     virtual Integrator *getLastIntegrator(void);
     virtual const Vector &getLastResponse(void);
     Element *getElement(void);
@@ -117,7 +124,16 @@ class FE_Element: public TaggedObject
     ID myDOF_Groups;
     ID myID;
 
+    // the class wide objects, set 0 of them is for the FE_Element and
+    // set 1 for the objects a subclass forms from its tangent & residual
+    static void growStorage(int theNumThreads, int theNumDOF);
+    static void getStorage(int theNumDOF, int set,
+			   Matrix *&theMatrix, Vector *&theVector);
+
   private:
+    const Matrix &getElementTangentStiff(void);
+    void setStorage(void);
+
     // private variables - a copy for each object of the class    
     int numDOF;
     AnalysisModel *theModel;
@@ -125,12 +141,17 @@ class FE_Element: public TaggedObject
     Vector *theResidual;
     Matrix *theTangent;
     Integrator *theIntegrator; // need for Subdomain
+    bool sharedStorage;        // true if theTangent & theResidual are class wide
+    Matrix *theElementK;       // tangent of an element with a constant tangent
+    int theElementKStamp;      // parameter stamp of the domain theElementK was formed at
     
     // static variables - single copy for all objects of the class	
     static Matrix errMatrix;
     static Vector errVector;
-    static Matrix **theMatrices; // array of pointers to class wide matrices
-    static Vector **theVectors;  // array of pointers to class widde vectors
+    static Matrix **theMatrices; // class wide matrices, by thread, set and size
+    static Vector **theVectors;  // class wide vectors, by thread, set and size
+    static int maxNumDOF;        // largest size in the class wide arrays
+    static int numThreads;       // number of threads in the class wide arrays
     static int numFEs;           // number of objects
     
 
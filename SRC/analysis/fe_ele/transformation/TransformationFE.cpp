@@ -41,26 +41,43 @@
 #include <Matrix.h>
 #include <Vector.h>
 #include <TransformationConstraintHandler.h>
+#include <TransformationGlobalTangent.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define MAX_NUM_DOF 64
 
+static bool
+isSameMatrix(const Matrix &A, const Matrix &B)
+{
+    int numRows = A.noRows();
+    int numCols = A.noCols();
+    if (B.noRows() != numRows || B.noCols() != numCols)
+	return false;
+
+    for (int j=0; j<numCols; j++)
+	for (int i=0; i<numRows; i++)
+	    if (A(i,j) != B(i,j))
+		return false;
+
+    return true;
+}
+
 // static variables initialisation
-Matrix **TransformationFE::modMatrices; 
-Vector **TransformationFE::modVectors;  
-Matrix **TransformationFE::theTransformations; 
 int TransformationFE::numTransFE(0);           
 int TransformationFE::transCounter(0);           
-int TransformationFE::sizeTransformations(0);          
 double *TransformationFE::dataBuffer = 0;          
-double *TransformationFE::localKbuffer = 0;          
-int    *TransformationFE::dofData = 0;    ;          
 int TransformationFE::sizeBuffer(0);            
 
 //  TransformationFE(Element *, Integrator *theIntegrator);
 //	construictor that take the corresponding model element.
 TransformationFE::TransformationFE(int tag, Element *ele)
 :FE_Element(tag, ele), theDOFs(0), numSPs(0), theSPs(0), modID(0), 
-  modTangent(0), modResidual(0), numGroups(0), numTransformedDOF(0)
+  modTangent(0), modResidual(0), numGroups(0), numTransformedDOF(0),
+  constantT(false), unitT(false),
+  lastTangent(0), lastModTangent(0), theGlobal(0)
 {
   // set number of original dof at ele
     numOriginalDOF = ele->getNumDOF();
@@ -95,42 +112,17 @@ TransformationFE::TransformationFE(int tag, Element *ele)
 	theDOFs[i] = theDofGroup;
     }
 
-    // see if theTransformation array is big enough
-    // if not delete the old and create a new one
-    if (numNodes > sizeTransformations) {
-	if (theTransformations != 0) 
-	    delete [] theTransformations;
-	
-	theTransformations = new Matrix *[numNodes];
-	if (theTransformations == 0) {
-	    opserr << "FATAL TransformationFE::TransformationFE() - out of memory ";
-	    opserr << "for array of pointers for Transformation matrices of size ";
-	    opserr << numNodes;
-	    exit(-1);
-	}		    
-	sizeTransformations = numNodes;
-    }	
-
-    // if this is the first element of this type create the arrays for 
-    // modified tangent and residual matrices
+    // if this is the first element of this type create the buffer; the
+    // modified tangent and residual are class wide objects of FE_Element
     if (numTransFE == 0) {
 
-	modMatrices = new Matrix *[MAX_NUM_DOF+1];
-	modVectors  = new Vector *[MAX_NUM_DOF+1];
 	dataBuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	localKbuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	dofData      = new int[MAX_NUM_DOF];
 	sizeBuffer = MAX_NUM_DOF*MAX_NUM_DOF;
 	
-	if (modMatrices == 0 || modVectors == 0 || dataBuffer == 0 ||
-	    localKbuffer == 0 || dofData == 0) {
+	if (dataBuffer == 0) {
 	    opserr << "TransformationFE::TransformationFE(Element *) ";
 	    opserr << " ran out of memory";	    
 	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    modMatrices[i] = 0;
-	    modVectors[i] = 0;
-	}
     }
 
     // increment the number of transformations
@@ -152,41 +144,19 @@ TransformationFE::~TransformationFE()
     if (theSPs != 0)
 	delete [] theSPs;
 
-    int numDOF = 0;    
-    if (modID != 0)
-	numDOF = modID->Size();
-    
     if (modID != 0)
 	delete modID;
 
-    if (numDOF > MAX_NUM_DOF) {
-	// tangent and residual may have been  created specially
-	if (modTangent != 0) delete modTangent;
-	if (modResidual != 0) delete modResidual;
-    }
+    if (lastTangent != 0)
+	delete lastTangent;
+    if (lastModTangent != 0)
+	delete lastModTangent;
 
     // if this is the last FE_Element, clean up the
     // storage for the matrix and vector objects
     if (numTransFE == 0) {
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    if (modVectors[i] != 0)
-		delete modVectors[i];
-	    if (modMatrices[i] != 0)
-		delete modMatrices[i];
-	}
-	delete [] modMatrices;
-	delete [] modVectors;
-	delete [] theTransformations;
 	delete [] dataBuffer;
-	delete [] localKbuffer;
-	delete [] dofData;
-	modMatrices = 0;
-	modVectors = 0;
-	theTransformations = 0;
 	dataBuffer = 0;
-	localKbuffer = 0;
-	dofData = 0;
-	sizeTransformations = 0;
 	sizeBuffer = 0;
 	transCounter = 0;
     }
@@ -252,190 +222,328 @@ TransformationFE::setID(void)
 	    }		
     }
     
-    // set the pointers to the modified tangent matrix and residual vector
-    if (numTransformedDOF <= MAX_NUM_DOF) {
-	// use class wide objects
-	if (modVectors[numTransformedDOF] == 0) {
-	    modVectors[numTransformedDOF] = new Vector(numTransformedDOF);
-	    modMatrices[numTransformedDOF] = new Matrix(numTransformedDOF,numTransformedDOF);
-	    modResidual = modVectors[numTransformedDOF];
-	    modTangent = modMatrices[numTransformedDOF];
-	    if (modResidual == 0 || modResidual->Size() != numTransformedDOF ||	
-		modTangent == 0 || modTangent->noCols() != numTransformedDOF)	{  
-		opserr << "TransformationFE::setID() ";
-		opserr << " ran out of memory for vector/Matrix of size :";
-		opserr << numTransformedDOF << endln;
-		exit(-1);
+    // the modified tangent matrix and residual vector are the class wide
+    // objects of the size, of the calling thread
+    growStorage(1, numTransformedDOF);
+    this->setModStorage();
+
+    // the transformations of the DOF_Groups were set in doneID(), if none
+    // varies with time they are compressed once here
+    constantT = true;
+    for (int k=0; k<numGroups; k++)
+	if (theDOFs[k]->hasConstantT() == false)
+	    constantT = false;
+
+    if (lastTangent != 0)
+	delete lastTangent;
+    if (lastModTangent != 0)
+	delete lastModTangent;
+    lastTangent = 0;
+    lastModTangent = 0;
+
+    globalDOF.clear();
+    globalLoc.clear();
+
+    if (constantT == true) {
+	if (this->formT() < 0)
+	    return -1;
+	this->addGlobalPattern();
+    }
+
+    return 0;
+}
+
+
+void
+TransformationFE::setGlobalTangent(TransformationGlobalTangent *global)
+{
+    theGlobal = global;
+}
+
+
+bool
+TransformationFE::isUnitRow(int a) const
+{
+    return (tStart[a+1] - tStart[a] == 1 && tVal[tStart[a]] == 1.0);
+}
+
+
+// void addGlobalPattern(void);
+//	in the -global mode adds to theGlobal the DOF_Groups and the tangent
+//	entries (a,b) for which row a or row b of T is not a single 1.
+
+void
+TransformationFE::addGlobalPattern(void)
+{
+    if (theGlobal == 0 || unitT == true)
+	return;
+
+    Element *theEle = this->getElement();
+    if (theEle == 0 || theEle->isSubdomain() == true)
+	return;
+
+    globalDOF.resize(numOriginalDOF);
+    int row = 0;
+    for (int i=0; i<numGroups; i++) {
+	const Matrix *Ti = theDOFs[i]->getT();
+	int numRows = (Ti != 0) ? Ti->noRows() : theDOFs[i]->getNumDOF();
+	int first = theGlobal->addDOF_Group(theDOFs[i]);
+	for (int a=0; a<numRows && row<numOriginalDOF; a++)
+	    globalDOF[row++] = first + a;
+    }
+
+    for (int b=0; b<numOriginalDOF; b++)
+	for (int a=0; a<numOriginalDOF; a++)
+	    if (this->isUnitRow(a) == false || this->isUnitRow(b) == false)
+		theGlobal->addEntry(globalDOF[a], globalDOF[b]);
+}
+
+
+// int setGlobalLocations(void);
+//	invoked by the handler once theGlobal has the entries of all the
+//	TransformationFEs.
+
+int
+TransformationFE::setGlobalLocations(void)
+{
+    globalLoc.clear();
+    if (theGlobal == 0 || globalDOF.empty())
+	return 0;
+
+    globalLoc.assign(numOriginalDOF*numOriginalDOF, -1);
+    for (int b=0; b<numOriginalDOF; b++)
+	for (int a=0; a<numOriginalDOF; a++)
+	    if (this->isUnitRow(a) == false || this->isUnitRow(b) == false) {
+		int loc = theGlobal->getLocation(globalDOF[a], globalDOF[b]);
+		if (loc < 0) {
+		    opserr << "WARNING TransformationFE::setGlobalLocations() - entry not in the ";
+		    opserr << "global tangent for element " << this->getElement()->getTag() << endln;
+		    globalLoc.clear();
+		    return -1;
+		}
+		globalLoc[a + b*numOriginalDOF] = loc;
 	    }
-	} else {
-	    modResidual = modVectors[numTransformedDOF];
-	    modTangent = modMatrices[numTransformedDOF];
+
+    return 0;
+}
+
+
+// int formT(void);
+//	sets tStart, tCol and tVal from the T of the DOF_Groups, a DOF_Group
+//	with no T contributing the identity.
+
+int
+TransformationFE::formT(void)
+{
+    tStart.resize(numOriginalDOF+1);
+    tCol.clear();
+    tVal.clear();
+    unitT = true;
+
+    int row = 0;
+    int startCol = 0;
+    for (int i=0; i<numGroups; i++) {
+	const Matrix *Ti = theDOFs[i]->getT();
+	int numRows = (Ti != 0) ? Ti->noRows() : theDOFs[i]->getNumDOF();
+	int numCols = (Ti != 0) ? Ti->noCols() : numRows;
+
+	if (row + numRows > numOriginalDOF) {
+	    opserr << "WARNING TransformationFE::formT() - the DOF_Groups have more dof";
+	    opserr << " than the element " << this->getElement()->getTag() << endln;
+	    return -1;
 	}
-    } else {
-	// create matrices and vectors for each object instance
-	modResidual = new Vector(numTransformedDOF);
-	modTangent = new Matrix(numTransformedDOF, numTransformedDOF);
-	if (modResidual == 0 || modResidual->Size() ==0 ||
-	    modTangent ==0 || modTangent->noRows() ==0) {
-	    
-	    opserr << "TransformationFE::setID() ";
-	    opserr << " ran out of memory for vector/Matrix of size :";
-	    opserr << numTransformedDOF << endln;
-	    exit(-1);
+
+	for (int a=0; a<numRows; a++) {
+	    tStart[row++] = tCol.size();
+	    if (Ti == 0) {
+		tCol.push_back(startCol + a);
+		tVal.push_back(1.0);
+		continue;
+	    }
+	    int numEntries = 0;
+	    for (int b=0; b<numCols; b++) {
+		double value = (*Ti)(a,b);
+		if (value != 0.0) {
+		    tCol.push_back(startCol + b);
+		    tVal.push_back(value);
+		    if (value != 1.0)
+			unitT = false;
+		    numEntries++;
+		}
+	    }
+	    if (numEntries != 1)
+		unitT = false;
 	}
-    }     
+	startCol += numCols;
+    }
+
+    for ( ; row <= numOriginalDOF; row++)
+	tStart[row] = tCol.size();
 
     return 0;
 }
 
+
+// void transformTangent(const Matrix &theTangent);
+//	sets modTangent to T^t theTangent T using only the non-zeros of T;
+//	when every row of T is a single 1 the product is a scatter of
+//	theTangent into modTangent.
+
+void
+TransformationFE::transformTangent(const Matrix &theTangent)
+{
+    if (constantT == false)
+	this->formT();
+
+    Matrix &modK = *modTangent;
+    modK.Zero();
+
+    const int *start = &tStart[0];
+    const int *col = tCol.empty() ? 0 : &tCol[0];
+    const double *val = tVal.empty() ? 0 : &tVal[0];
+
+    if (unitT == true) {
+	for (int b=0; b<numOriginalDOF; b++) {
+	    int d = col[start[b]];
+	    for (int a=0; a<numOriginalDOF; a++)
+		modK(col[start[a]], d) += theTangent(a,b);
+	}
+	return;
+    }
+
+    for (int b=0; b<numOriginalDOF; b++) {
+	int qEnd = start[b+1];
+	for (int a=0; a<numOriginalDOF; a++) {
+	    double kab = theTangent(a,b);
+	    if (kab == 0.0)
+		continue;
+	    int pEnd = start[a+1];
+	    for (int q=start[b]; q<qEnd; q++) {
+		int d = col[q];
+		double kabT = kab*val[q];
+		for (int p=start[a]; p<pEnd; p++)
+		    modK(col[p], d) += val[p]*kabT;
+	    }
+	}
+    }
+}
+
 const Matrix &
 TransformationFE::getTangent(Integrator *theNewIntegrator)
 {
+    this->setModStorage();
     const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
 
-    static ID numDOFs(dofData, 1);
-    numDOFs.setData(dofData, numGroups);
-    
     // DO THE SP STUFF TO THE TANGENT 
-    
-    // get the transformation matrix from each dof group & number of local dof
-    // for original node.
-    int numNode = numGroups;
-    for (int a = 0; a<numNode; a++) {
-      Matrix *theT = theDOFs[a]->getT();
-      theTransformations[a] = theT;
-      if (theT != 0)
-	numDOFs[a] = theT->noRows(); // T^ 
-      else
-	numDOFs[a] = theDOFs[a]->getNumDOF();
-    }
 
-    // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRow = 0;
-    int noRowsTransformed = 0;
-    int noRowsOriginal = 0;
-
-    static Matrix localK;
-
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
-
-	int startCol = 0;
-	int numDOFi = numDOFs[i];	
-	int noColsOriginal = 0;
-
-	for (int j=0; j<numNode; j++) {
-
-	    const Matrix *Ti = theTransformations[i];
-	    const Matrix *Tj = theTransformations[j];
-	    int numDOFj = numDOFs[j];	
-	    localK.setData(localKbuffer, numDOFi, numDOFj);
-
-	    // copy K(i,j) into localK matrix
-	    // CHECK SIZE OF BUFFER	    
-	    for (int a=0; a<numDOFi; a++)
-		for (int b=0; b<numDOFj; b++)
-		    localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-
-	    // now perform the matrix computation T(i)^T localK T(j)
-	    // note: if T == 0 then the Identity is assumed
-	    int noColsTransformed = 0;
-	    static Matrix localTtKT;
-	    
-	    if (Ti != 0 && Tj != 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK * (*Tj);
-		localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-	    } else if (Ti == 0 && Tj != 0) {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		// localTtKT = localK * (*Tj);	       
-		localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-	    } else if (Ti != 0 && Tj == 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK;
-		localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-	    } else {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		localTtKT = localK;
+    // in the -global mode the entries coupling a constrained dof go to
+    // theGlobal, the others are transformed (scattered) here
+    if (globalLoc.empty() == false && theGlobal->isCollecting() == true) {
+	Matrix &modK = *modTangent;
+	modK.Zero();
+	const int *loc = &globalLoc[0];
+	for (int b=0; b<numOriginalDOF; b++) {
+	    int d = (this->isUnitRow(b) == true) ? tCol[tStart[b]] : -1;
+	    for (int a=0; a<numOriginalDOF; a++, loc++) {
+		double kab = theTangent(a,b);
+		if (kab == 0.0)
+		    continue;
+		if (*loc >= 0)
+		    theGlobal->add(*loc, kab);
+		else
+		    modK(tCol[tStart[a]], d) += kab;
 	    }
-	    // now copy into modTangent the T(i)^t K(i,j) T(j) product
-	    for (int c=0; c<noRowsTransformed; c++) 
-		for (int d=0; d<noColsTransformed; d++) 
-		    (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-	    
-	    startCol += noColsTransformed;
-	    noColsOriginal += numDOFj;
 	}
+	return *modTangent;
+    }
+
+    // the tangent of a linear element usually repeats, when it does the
+    // last transformation is reused
+    Element *theEle = this->getElement();
+    bool cache = (constantT == true && unitT == false && theEle != 0 &&
+		  theEle->isSubdomain() == false && theEle->hasConstantTangent() == true);
+
+    if (cache == true && lastTangent != 0 && isSameMatrix(*lastTangent, theTangent)) {
+	*modTangent = *lastModTangent;
+	return *modTangent;
+    }
+
+    // perform Tt K T
+    this->transformTangent(theTangent);
 
-	noRowsOriginal += numDOFi;
-	startRow += noRowsTransformed;
+    if (cache == true) {
+	if (lastTangent == 0) {
+	    lastTangent = new Matrix(theTangent);
+	    lastModTangent = new Matrix(*modTangent);
+	} else {
+	    *lastTangent = theTangent;
+	    *lastModTangent = *modTangent;
+	}
     }
 
     return *modTangent;
 }
 
 
+bool
+TransformationFE::isThreadSafe(void)
+{
+  // a time varying T is formed in the DOF_Group when it is used, which
+  // the DOF_Group does in storage shared by all its elements
+  if (constantT == false)
+    return false;
+
+  return this->FE_Element::isThreadSafe();
+}
+
+
+int
+TransformationFE::setPrivateStorage(void)
+{
+  if (this->FE_Element::setPrivateStorage() < 0)
+    return -1;
+
+  // each thread transforms into its own class wide objects
+  int num = 1;
+#ifdef _OPENMP
+  num = omp_get_max_threads();
+#endif
+  growStorage(num, numTransformedDOF);
+
+  return 0;
+}
+
+
+// void setModStorage(void);
+//	points modTangent & modResidual at the class wide objects of the
+//	calling thread, kept apart from those the FE_Element forms into.
+
+void
+TransformationFE::setModStorage(void)
+{
+  getStorage(numTransformedDOF, 1, modTangent, modResidual);
+}
+
+
 const Vector &
 TransformationFE::getResidual(Integrator *theNewIntegrator)
 
 {
+    this->setModStorage();
     const Vector &theResidual = this->FE_Element::getResidual(theNewIntegrator);
     // DO THE SP STUFF TO THE TANGENT
     
-    // perform Tt R  -- as T is block diagonal do T(i)^T R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowTransformed = 0;
-    int startRowOriginal = 0;
-    int numNode = numGroups;
-
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
-	int noRows = 0;
-	int noCols = 0;
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	  noRows = Ti->noCols(); // T^
-	  noCols = Ti->noRows();
-
-	  /*
-	  Vector orig(noCols);
-	  Vector mod(noRows);
-	  for (int k=startRowOriginal; k<startRowOriginal+noCols; k++)
-	    orig(k-startRowOriginal)= theResidual(k);
-	  mod = (*Ti)^orig;
-	  for (int k=startRowTransformed; k<startRowTransformed+noRows; k++)
-	    (*modResidual)(k) = mod (k-startRowTransformed);
-
-	  */
-
-	  for (int j=0; j<noRows; j++) {
-	    double sum = 0.0;
-	    for (int k=0; k<noCols; k++)
-	      sum += (*Ti)(k,j) * theResidual(startRowOriginal + k);
-	    (*modResidual)(startRowTransformed +j) = sum;
-	  }
+    if (constantT == false)
+	this->formT();
 
-	} else {
-	  noCols = theDOFs[i]->getNumDOF();
-	  noRows = noCols;
-	  for (int j=0; j<noRows; j++)
-	    (*modResidual)(startRowTransformed +j) = theResidual(startRowOriginal + j);
-	}
-	startRowTransformed += noRows;
-	startRowOriginal += noCols;
+    // perform Tt R
+    modResidual->Zero();
+    for (int a=0; a<numOriginalDOF; a++) {
+	double ra = theResidual(a);
+	if (ra == 0.0)
+	    continue;
+	for (int p=tStart[a]; p<tStart[a+1]; p++)
+	    (*modResidual)(tCol[p]) += tVal[p]*ra;
     }
 
     return *modResidual;
@@ -447,6 +555,7 @@ TransformationFE::getResidual(Integrator *theNewIntegrator)
 const Vector &
 TransformationFE::getTangForce(const Vector &disp, double fact)
 {
+    this->setModStorage();
     opserr << "TransformationFE::getTangForce() - not yet implemented\n";
     modResidual->Zero();
     return *modResidual;
@@ -455,100 +564,13 @@ TransformationFE::getTangForce(const Vector &disp, double fact)
 const Vector &
 TransformationFE::getK_Force(const Vector &accel, double fact)
 {
+  this->setModStorage();
   this->FE_Element::zeroTangent();    
   this->FE_Element::addKtToTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  // perform Tt K T
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -570,100 +592,13 @@ TransformationFE::getK_Force(const Vector &accel, double fact)
 const Vector &
 TransformationFE::getKi_Force(const Vector &accel, double fact)
 {
+  this->setModStorage();
   this->FE_Element::zeroTangent();    
   this->FE_Element::addKiToTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  // perform Tt K T
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -684,100 +619,13 @@ TransformationFE::getKi_Force(const Vector &accel, double fact)
 const Vector &
 TransformationFE::getM_Force(const Vector &accel, double fact)
 {
+  this->setModStorage();
   this->FE_Element::zeroTangent();    
   this->FE_Element::addMtoTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  // perform Tt K T
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -798,100 +646,13 @@ TransformationFE::getM_Force(const Vector &accel, double fact)
 const Vector &
 TransformationFE::getC_Force(const Vector &accel, double fact)
 {
+  this->setModStorage();
   this->FE_Element::zeroTangent();    
   this->FE_Element::addCtoTang();    
   const Matrix &theTangent = this->FE_Element::getTangent(0);
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
+  // perform Tt K T
+  this->transformTangent(theTangent);
   
   // get the components we need out of the vector
   // and place in a temporary vector
@@ -913,6 +674,7 @@ TransformationFE::getC_Force(const Vector &accel, double fact)
 void  
 TransformationFE::addD_Force(const Vector &disp,  double fact)
 {
+    this->setModStorage();
     if (fact == 0.0)
 	return;
 
@@ -933,6 +695,7 @@ TransformationFE::addD_Force(const Vector &disp,  double fact)
 void  
 TransformationFE::addM_Force(const Vector &disp,  double fact)
 {
+    this->setModStorage();
     if (fact == 0.0)
 	return;
 
@@ -956,6 +719,7 @@ TransformationFE::addM_Force(const Vector &disp,  double fact)
 const Vector &
 TransformationFE::getLastResponse(void)
 {
+    this->setModStorage();
     Integrator *theLastIntegrator = this->getLastIntegrator();
     if (theLastIntegrator != 0) {
 	if (theLastIntegrator->getLastResponse(*modResidual,*modID) < 0) {
@@ -978,34 +742,15 @@ int
 TransformationFE::transformResponse(const Vector &modResp, 
 				    Vector &unmodResp)
 {
-    // perform T R  -- as T is block diagonal do T(i) R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowOriginal = 0;
-    int startRowTransformed = 0;
-    int numNode = numGroups;
-    int noRows = 0;
-    int noCols = 0;
-
-    for (int i=0; i<numNode; i++) {
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	    noRows = Ti->noRows();
-	    noCols = Ti->noCols();
-	    for (int j=0; j<noRows; j++) {
-		double sum = 0.0;
-		for (int k=0; k<noCols; k++)
-		    sum += (*Ti)(j,k) * modResp(startRowTransformed +k) ;
-		unmodResp(startRowOriginal + j) = sum;
-	    }
-	} else {
-	    noCols = theDOFs[i]->getNumDOF();
-	    noRows = noCols;
-	    for (int j=0; j<noCols; j++)
-		unmodResp(startRowOriginal + j) = modResp(startRowTransformed +j);
-	}
-	startRowOriginal += noRows;
-	startRowTransformed += noCols;
+    // perform T R
+    if (constantT == false)
+	this->formT();
+
+    for (int a=0; a<numOriginalDOF; a++) {
+	double sum = 0.0;
+	for (int p=tStart[a]; p<tStart[a+1]; p++)
+	    sum += tVal[p]*modResp(tCol[p]);
+	unmodResp(a) = sum;
     }
 
     return 0;
@@ -1016,6 +761,7 @@ TransformationFE::transformResponse(const Vector &modResp,
 void  
 TransformationFE::addD_ForceSensitivity(int gradNumber, const Vector &disp,  double fact)
 {
+    this->setModStorage();
     if (fact == 0.0)
 	return;
 
@@ -1036,6 +782,7 @@ TransformationFE::addD_ForceSensitivity(int gradNumber, const Vector &disp,  dou
 void  
 TransformationFE::addM_ForceSensitivity(int gradNumber, const Vector &disp,  double fact)
 {
+    this->setModStorage();
     if (fact == 0.0)
 	return;
 
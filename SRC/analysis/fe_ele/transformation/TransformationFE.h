@@ -33,13 +33,20 @@
 // Description: This file contains the class definition for TransformationFE.
 // TransformationFE objects handle MP_Constraints using the transformation
 // method T^t K T. SP_Constraints are handled by the TransformationConstraintHandler.
+// The T matrices of the DOF_Groups are kept in compressed row form, as the
+// rows of a rigid diaphragm, rigid link or equalDOF constraint have only one
+// to three non-zeros, and the product is formed with the non-zeros alone.
+// In the -global mode of the handler the entries of the tangent coupling a
+// constrained dof are instead added to a TransformationGlobalTangent.
 //
 // What: "@(#) TransformationFE.h, revA"
 
 #include <FE_Element.h>
+#include <vector>
 class SP_Constraint;
 class DOF_Group;
 class TransformationConstraintHandler;
+class TransformationGlobalTangent;
 
 class TransformationFE: public FE_Element
 {
@@ -56,6 +63,8 @@ class TransformationFE: public FE_Element
     // methods to form and obtain the tangent and residual
     virtual const Matrix &getTangent(Integrator *theIntegrator);
     virtual const Vector &getResidual(Integrator *theIntegrator);
+    virtual bool isThreadSafe(void);
+    virtual int  setPrivateStorage(void);
     
     // methods for ele-by-ele strategies
     virtual const Vector &getTangForce(const Vector &x, double fact = 1.0);
@@ -69,6 +78,10 @@ class TransformationFE: public FE_Element
     const Vector &getLastResponse(void);
     int addSP(SP_Constraint &theSP);
 
+    // for the -global mode of the TransformationConstraintHandler
+    void setGlobalTangent(TransformationGlobalTangent *theGlobal);
+    int setGlobalLocations(void);
+
 
     // AddingSensitivity:BEGIN ////////////////////////////////////
     virtual void addM_ForceSensitivity       (int gradNumber, const Vector &vect, double fact = 1.0);
@@ -79,7 +92,13 @@ class TransformationFE: public FE_Element
     int transformResponse(const Vector &modResponse, Vector &unmodResponse);
     
   private:
+    int formT(void);
+    void transformTangent(const Matrix &theTangent);
+    bool isUnitRow(int a) const;
+    void addGlobalPattern(void);
+    void setModStorage(void);
     
+
     // private variables - a copy for each object of the class        
     DOF_Group **theDOFs;
     int numSPs;
@@ -90,17 +109,28 @@ class TransformationFE: public FE_Element
     int numGroups;
     int numTransformedDOF;
     int numOriginalDOF;
+
+    // T of all the nodes in compressed row form: the entries of original
+    // dof a are tCol & tVal from tStart[a] to tStart[a+1]-1
+    std::vector<int> tStart, tCol;
+    std::vector<double> tVal;
+    bool constantT;             // no T is time varying, so tStart.. are set in setID()
+    bool unitT;                 // each row is a single 1, identity & equalDOF
+
+    // for an element with a constant tangent, the last tangent & its transformation
+    Matrix *lastTangent;
+    Matrix *lastModTangent;
+
+    // the dofs in theGlobal of the original dofs, and the location in it
+    // of each tangent entry (column major), -1 if the entry is transformed here
+    TransformationGlobalTangent *theGlobal;
+    std::vector<int> globalDOF;
+    std::vector<int> globalLoc;
     
     // static variables - single copy for all objects of the class	
-    static Matrix **modMatrices; // array of pointers to class wide matrices
-    static Vector **modVectors;  // array of pointers to class widde vectors
-    static Matrix **theTransformations; // for holding pointers to the T matrices
     static int numTransFE;     // number of objects    
     static int transCounter;   // a counter used to indicate when to do something
-    static int sizeTransformations; // size of theTransformations array
     static double *dataBuffer;
-    static double *localKbuffer;
-    static int    *dofData;
     static int sizeBuffer;
 };
 
@@ -0,0 +1,264 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of
+// TransformationGlobalTangent.
+//
+// What: "@(#) TransformationGlobalTangent.cpp, revA"
+
+#include <TransformationGlobalTangent.h>
+#include <DOF_Group.h>
+#include <LinearSOE.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <algorithm>
+
+TransformationGlobalTangent::TransformationGlobalTangent()
+  :collecting(false)
+{
+  groupStart.push_back(0);
+  tStart.push_back(0);
+}
+
+
+TransformationGlobalTangent::~TransformationGlobalTangent()
+{
+
+}
+
+
+void
+TransformationGlobalTangent::clear(void)
+{
+  groupIndex.clear();
+  groupStart.assign(1, 0);
+  tStart.assign(1, 0);
+  tEqn.clear();
+  tVal.clear();
+  pattern.clear();
+  rowStart.clear();
+  colIndex.clear();
+  values.clear();
+  collecting = false;
+}
+
+
+// int addDOF_Group(DOF_Group *theDOF);
+//	returns the number of the first dof of the DOF_Group, adding the
+//	rows of its T (the identity if it has none) the first time.
+
+int
+TransformationGlobalTangent::addDOF_Group(DOF_Group *theDOF)
+{
+  std::map<int, int>::iterator it = groupIndex.find(theDOF->getTag());
+  if (it != groupIndex.end())
+    return groupStart[it->second];
+
+  int group = groupStart.size() - 1;
+  groupIndex[theDOF->getTag()] = group;
+
+  const Matrix *T = theDOF->getT();
+  const ID &theID = theDOF->getID();
+  int numRows = (T != 0) ? T->noRows() : theDOF->getNumDOF();
+  int numCols = (T != 0) ? T->noCols() : numRows;
+
+  for (int a=0; a<numRows; a++) {
+    if (T == 0) {
+      if (theID(a) >= 0) {
+	tEqn.push_back(theID(a));
+	tVal.push_back(1.0);
+      }
+    } else {
+      for (int b=0; b<numCols; b++) {
+	double value = (*T)(a,b);
+	if (value != 0.0 && theID(b) >= 0) {
+	  tEqn.push_back(theID(b));
+	  tVal.push_back(value);
+	}
+      }
+    }
+    tStart.push_back(tEqn.size());
+  }
+
+  int first = groupStart[group];
+  groupStart.push_back(first + numRows);
+  pattern.resize(first + numRows);
+
+  return first;
+}
+
+
+void
+TransformationGlobalTangent::addEntry(int row, int col)
+{
+  pattern[row].push_back(col);
+}
+
+
+int
+TransformationGlobalTangent::donePattern(void)
+{
+  int numRows = pattern.size();
+  rowStart.assign(numRows+1, 0);
+  colIndex.clear();
+
+  for (int i=0; i<numRows; i++) {
+    std::vector<int> &cols = pattern[i];
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    colIndex.insert(colIndex.end(), cols.begin(), cols.end());
+    rowStart[i+1] = colIndex.size();
+  }
+
+  pattern.clear();
+  values.assign(colIndex.size(), 0.0);
+
+  return 0;
+}
+
+
+int
+TransformationGlobalTangent::getLocation(int row, int col) const
+{
+  if (row < 0 || row+1 >= (int)rowStart.size())
+    return -1;
+
+  const int *first = colIndex.empty() ? 0 : &colIndex[0] + rowStart[row];
+  const int *last = colIndex.empty() ? 0 : &colIndex[0] + rowStart[row+1];
+  const int *loc = std::lower_bound(first, last, col);
+  if (loc == last || *loc != col)
+    return -1;
+
+  return loc - &colIndex[0];
+}
+
+
+void
+TransformationGlobalTangent::begin(void)
+{
+  std::fill(values.begin(), values.end(), 0.0);
+  collecting = !values.empty();
+}
+
+
+// int addToSOE(LinearSOE &theSOE);
+//	adds T^t K T to the SOE, one block of rows for the dofs at each node:
+//	the block is over the equations of the T rows of those dofs and of the
+//	dofs they are coupled to. The blocks are formed concurrently, their
+//	addition into the SOE is serialized.
+
+void
+TransformationGlobalTangent::addEquations(int dof, int numEqn, std::vector<int> &local,
+					  std::vector<int> &eqns) const
+{
+  for (int p=tStart[dof]; p<tStart[dof+1]; p++) {
+    int eqn = tEqn[p];
+    if (eqn < numEqn && local[eqn] < 0) {
+      local[eqn] = eqns.size();
+      eqns.push_back(eqn);
+    }
+  }
+}
+
+
+int
+TransformationGlobalTangent::addToSOE(LinearSOE &theSOE)
+{
+  if (collecting == false)
+    return 0;
+  collecting = false;
+
+  int numGroups = groupStart.size() - 1;
+  int numEqn = theSOE.getNumEqn();
+  int numFailed = 0;
+
+#pragma omp parallel reduction(+:numFailed)
+  {
+    std::vector<int> local(numEqn, -1);   // equation -> position in the block
+    std::vector<int> eqns;
+    std::vector<double> block;
+
+#pragma omp for schedule(dynamic, 16)
+    for (int g=0; g<numGroups; g++) {
+      int firstRow = groupStart[g];
+      int lastRow = groupStart[g+1];
+
+      bool nonZero = false;
+      for (int k=rowStart[firstRow]; k<rowStart[lastRow] && nonZero == false; k++)
+	if (values[k] != 0.0)
+	  nonZero = true;
+      if (nonZero == false)
+	continue;
+
+      // the equations of the block
+      eqns.clear();
+      for (int r=firstRow; r<lastRow; r++) {
+	addEquations(r, numEqn, local, eqns);
+	for (int k=rowStart[r]; k<rowStart[r+1]; k++)
+	  addEquations(colIndex[k], numEqn, local, eqns);
+      }
+
+      int n = eqns.size();
+      if (n == 0)
+	continue;
+      block.assign(n*n, 0.0);
+
+      for (int r=firstRow; r<lastRow; r++) {
+	for (int k=rowStart[r]; k<rowStart[r+1]; k++) {
+	  double kab = values[k];
+	  if (kab == 0.0)
+	    continue;
+	  int c = colIndex[k];
+	  for (int q=tStart[c]; q<tStart[c+1]; q++) {
+	    if (tEqn[q] >= numEqn)
+	      continue;
+	    double *blockCol = &block[0] + local[tEqn[q]]*n;
+	    double kabT = kab*tVal[q];
+	    for (int p=tStart[r]; p<tStart[r+1]; p++)
+	      if (tEqn[p] < numEqn)
+		blockCol[local[tEqn[p]]] += tVal[p]*kabT;
+	  }
+	}
+      }
+
+      Matrix theBlock(&block[0], n, n);
+      ID theID(&eqns[0], n);
+
+      int ok;
+#pragma omp critical (TransformationGlobalTangent_SOE)
+      ok = theSOE.addA(theBlock, theID);
+      if (ok < 0)
+	numFailed++;
+
+      for (int i=0; i<n; i++)
+	local[eqns[i]] = -1;
+    }
+  }
+
+  std::fill(values.begin(), values.end(), 0.0);
+
+  if (numFailed != 0) {
+    opserr << "WARNING TransformationGlobalTangent::addToSOE() - addA failed for ";
+    opserr << numFailed << " blocks\n";
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for
+// TransformationGlobalTangent. In the -global mode of the
+// TransformationConstraintHandler the TransformationFEs do not transform
+// the entries of their tangent that couple a constrained dof; they add
+// them untransformed into this object, which holds them in a sparse
+// matrix over the dofs of the nodes involved, so the contributions of all
+// elements meeting at a node add up before T^t K T is formed. The product
+// is formed once per tangent, in parallel over the nodes, and added to the
+// LinearSOE.
+//
+// What: "@(#) TransformationGlobalTangent.h, revA"
+
+#ifndef TransformationGlobalTangent_h
+#define TransformationGlobalTangent_h
+
+#include <vector>
+#include <map>
+
+class DOF_Group;
+class LinearSOE;
+
+class TransformationGlobalTangent
+{
+  public:
+    TransformationGlobalTangent();
+    ~TransformationGlobalTangent();
+
+    // setting up once the DOF_Groups are numbered: the FE_Elements add
+    // their DOF_Groups & the entries they will add, then donePattern()
+    void clear(void);
+    int addDOF_Group(DOF_Group *theDOF);
+    void addEntry(int row, int col);
+    int donePattern(void);
+    int getLocation(int row, int col) const;
+
+    // between begin() and addToSOE() the TransformationFEs add into values
+    void begin(void);
+    bool isCollecting(void) const {return collecting;};
+    inline void add(int loc, double value);
+    int addToSOE(LinearSOE &theSOE);
+
+  protected:
+
+  private:
+    void addEquations(int dof, int numEqn, std::vector<int> &local,
+		      std::vector<int> &eqns) const;
+
+    std::map<int, int> groupIndex;   // DOF_Group tag -> number of the group
+    std::vector<int> groupStart;     // first dof of each group, numGroups+1
+
+    // the row of T of each dof, in equation numbers
+    std::vector<int> tStart, tEqn;
+    std::vector<double> tVal;
+
+    // the untransformed entries, in compressed row form
+    std::vector<std::vector<int> > pattern;
+    std::vector<int> rowStart, colIndex;
+    std::vector<double> values;
+
+    bool collecting;
+};
+
+inline void
+TransformationGlobalTangent::add(int loc, double value)
+{
+#pragma omp atomic
+  values[loc] += value;
+}
+
+#endif
@@ -54,12 +54,15 @@
 #include <TransformationDOF_Group.h>
 #include <TransformationFE.h>
 #include <PenaltyMP_FE.h>
+#include <LagrangeMP_FE.h>
+#include <LagrangeDOF_Group.h>
 #include <elementAPI.h>
 
 #include <cmath>
 #include <algorithm>
 #include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <sstream>
 #include <iomanip>
@@ -81,9 +84,10 @@ void* OPS_AutoConstraintHandler()
 	bool auto_penalty = true;
 	double auto_penalty_oom = 3.0;
 	double user_penalty = 0.0;
+	bool lagrange_mp = false;
 
 	// utils
-	const char* header = "constraints Auto <-verbose> <-autoPenalty $oom> <-userPenalty $userPenalty>";
+	const char* header = "constraints Auto <-verbose> <-autoPenalty $oom> <-userPenalty $userPenalty> <-lagrange>";
 
 	// parse
 	bool auto_penalty_done = false;
@@ -133,6 +137,9 @@ void* OPS_AutoConstraintHandler()
 			auto_penalty = false;
 			user_penalty_done = true;
 		}
+		else if ((strcmp(type, "-lagrange") == 0) || (strcmp(type, "-Lagrange") == 0)) {
+			lagrange_mp = true;
+		}
 	}
 
 	// done
@@ -140,7 +147,8 @@ void* OPS_AutoConstraintHandler()
 		verbose,
 		auto_penalty,
 		auto_penalty_oom,
-		user_penalty);
+		user_penalty,
+		lagrange_mp);
 }
 
 namespace {
@@ -293,12 +301,14 @@ AutoConstraintHandler::AutoConstraintHandler(
 	bool _verbose,
 	bool _auto_penalty, 
 	double _auto_penalty_oom,
-	double _user_penalty)
+	double _user_penalty,
+	bool _lagrange_mp)
 	: ConstraintHandler(HANDLER_TAG_AutoConstraintHandler)
 	, verbose(_verbose)
 	, auto_penalty(_auto_penalty)
 	, auto_penalty_oom(_auto_penalty_oom)
 	, user_penalty(_user_penalty)
+	, lagrange_mp(_lagrange_mp)
 {
 }
 
@@ -334,6 +344,40 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 			sp_map.emplace(std::make_pair(theSP->getNodeTag(), theSP));
 	}
 
+	// split the MP_Constraints into those eliminated by transformation
+	// (key = constrained NodeID) and the others. An MP_Constraint is
+	// eliminated if its constrained node is constrained by no other MP,
+	// is retained by none (so no other constraint refers to its eliminated
+	// DOFs) and has no SP_Constraint on its constrained DOFs
+	std::unordered_map<int, MP_Constraint*> mp_transf;
+	std::vector<MP_Constraint*> mps_other;
+	{
+		std::unordered_map<int, int> num_constrained;
+		std::unordered_set<int> retained;
+		MP_ConstraintIter& theMPs = theDomain->getMPs();
+		MP_Constraint* mpPtr;
+		while ((mpPtr = theMPs()) != 0) {
+			num_constrained[mpPtr->getNodeConstrained()]++;
+			retained.insert(mpPtr->getNodeRetained());
+		}
+		MP_ConstraintIter& theMPs2 = theDomain->getMPs();
+		while ((mpPtr = theMPs2()) != 0) {
+			int cNode = mpPtr->getNodeConstrained();
+			bool eliminate = num_constrained[cNode] == 1 &&
+				retained.count(cNode) == 0 &&
+				mpPtr->getNodeRetained() != cNode;
+			const ID& cDOFs = mpPtr->getConstrainedDOFs();
+			auto it_range = sp_map.equal_range(cNode);
+			for (auto it = it_range.first; it != it_range.second && eliminate; it++)
+				if (cDOFs.getLocation(it->second->getDOF_Number()) >= 0)
+					eliminate = false;
+			if (eliminate)
+				mp_transf[cNode] = mpPtr;
+			else
+				mps_other.push_back(mpPtr);
+		}
+	}
+
 	// create a DOF_Group for each Node and add it to the AnalysisModel
 	// create a TrasformationDOF_Group for nodes constrained in SP_Constraints
 	int countDOF = 0;
@@ -350,7 +394,24 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 			// if the node is constrained in an SP constraint
 			// handle it with the transformation method
 			auto it_range = sp_map.equal_range(nodeTag);
-			if (it_range.first != it_range.second) {
+			auto it_mp = mp_transf.find(nodeTag);
+			if (it_mp != mp_transf.end()) {
+
+				// this node is constrained in an MP_Constraint that is
+				// eliminated, together with its SP_Constraints if any
+				TransformationDOF_Group* tDofPtr =
+					new TransformationDOF_Group(numDofGrp++, nodPtr, it_mp->second, nullptr);
+				dofPtr = tDofPtr;
+				int numSPs = 0;
+				for (auto it = it_range.first; it != it_range.second; it++) {
+					tDofPtr->addSP_Constraint(*(it->second));
+					numSPs++;
+				}
+				theDOFs.push_back(tDofPtr);
+				countDOF += nodPtr->getNumberDOF() - it_mp->second->getConstrainedDOFs().Size() - numSPs;
+
+			}
+			else if (it_range.first != it_range.second) {
 
 				// this node is constrained in 1 or more SP_Constraints.
 				// handle it with a TransformationDOF_Group.
@@ -387,9 +448,6 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 		}
 	}
 
-	// set the number of equations
-	theModel->setNumEqn(countDOF);
-
 	// now see if we have to set any of the dof's to -3
 	int count3 = 0;
 	if (nodesLast != 0) {
@@ -421,7 +479,15 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 	int numFeEle = 0;
 	FE_Element* fePtr;
 
-	// first standard elements
+	// first standard elements, those connected to a node with an
+	// eliminated MP_Constraint are transformed
+	auto newFE = [&mp_transf](int tag, Element* elePtr) -> FE_Element* {
+		const ID& nodes = elePtr->getExternalNodes();
+		for (int i = 0; i < nodes.Size(); i++)
+			if (mp_transf.find(nodes(i)) != mp_transf.end())
+				return new TransformationFE(tag, elePtr);
+		return new FE_Element(tag, elePtr);
+	};
 	while ((elePtr = theEle()) != 0) {
 		// only create an FE_Element for a subdomain element if it does not
 		// do independent analysis .. then subdomain part of this analysis so create
@@ -429,39 +495,49 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 		if (elePtr->isSubdomain() == true) {
 			Subdomain* theSub = (Subdomain*)elePtr;
 			if (theSub->doesIndependentAnalysis() == false) {
-				fePtr = new FE_Element(numFeEle++, elePtr);
+				fePtr = newFE(numFeEle++, elePtr);
 				theModel->addFE_Element(fePtr);
 				theSub->setFE_ElementPtr(fePtr);
 			}
 		}
 		else {
 			// just a regular element .. create an FE_Element for it & add to AnalysisModel
-			fePtr = new FE_Element(numFeEle++, elePtr);
+			fePtr = newFE(numFeEle++, elePtr);
 			theModel->addFE_Element(fePtr);
 		}
 	}
 
-	// then MP Penalty elements
-	// Note: now we get all MPs and handle them with penalty.
-	// In the future we may split valid MPs and conflicting MPs. valid one will be handled
-	// by the transformation method
-	std::vector<MP_Constraint*> mps_penalty;
-	{
-		MP_ConstraintIter& theMPs = theDomain->getMPs();
-		MP_Constraint* mpPtr;
-		while ((mpPtr = theMPs()) != 0)
-			mps_penalty.push_back(mpPtr);
-	}
+	// then the MP_Constraints that are not eliminated, with Lagrange
+	// multipliers or penalty elements
 	std::shared_ptr<PenaltyEvaluator> peval;
-	if (auto_penalty) 
-		peval = std::make_shared<PenaltyEvaluator>(theDomain, mps_penalty, auto_penalty_oom);
-	for(MP_Constraint* mp : mps_penalty) {
-		double penalty = auto_penalty ? peval->getPenaltyValue(mp) : user_penalty;
-		fePtr = new PenaltyMP_FE(numFeEle, *theDomain, *mp, penalty);
-		theModel->addFE_Element(fePtr);
-		numFeEle++;
+	if (lagrange_mp) {
+		int numDofGrp = theModel->getNumDOF_Groups();
+		for (MP_Constraint* mp : mps_other) {
+			DOF_Group* dofPtr = new LagrangeDOF_Group(numDofGrp++, *mp);
+			const ID& id = dofPtr->getID();
+			for (int j = 0; j < id.Size(); j++) {
+				dofPtr->setID(j, -2);
+				countDOF++;
+			}
+			theModel->addDOF_Group(dofPtr);
+			fePtr = new LagrangeMP_FE(numFeEle++, *theDomain, *mp, *dofPtr);
+			theModel->addFE_Element(fePtr);
+		}
+	}
+	else {
+		if (auto_penalty)
+			peval = std::make_shared<PenaltyEvaluator>(theDomain, mps_other, auto_penalty_oom);
+		for (MP_Constraint* mp : mps_other) {
+			double penalty = auto_penalty ? peval->getPenaltyValue(mp) : user_penalty;
+			fePtr = new PenaltyMP_FE(numFeEle, *theDomain, *mp, penalty);
+			theModel->addFE_Element(fePtr);
+			numFeEle++;
+		}
 	}
 
+	// set the number of equations
+	theModel->setNumEqn(countDOF);
+
 	// give some info
 	if (verbose) {
 		std::stringstream ss;
@@ -498,8 +574,12 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 			}
 		}
 		ss << "+ MP Constraints:\n";
-		ss << "   + " << mps_penalty.size() << " constraints handled with the Penalty method\n";
-		if (auto_penalty) {
+		ss << "   + " << mp_transf.size() << " constraints handled with the Transformation method\n";
+		if (lagrange_mp) {
+			ss << "   + " << mps_other.size() << " constraints handled with the Lagrange method\n";
+		}
+		else if (auto_penalty) {
+			ss << "   + " << mps_other.size() << " constraints handled with the Penalty method\n";
 			ss << "   + Global Penalty values:\n";
 			ss << "      + KMIN = " << std::scientific << peval->m_gp_min << "\n";
 			ss << "      + KMAX = " << std::scientific << peval->m_gp_max << "\n";
@@ -507,10 +587,11 @@ AutoConstraintHandler::handle(const ID* nodesLast)
 			ss << "      + PVAL = " << std::scientific << peval->m_global_penalty 
 				<< std::defaultfloat << " ( Selected penalty value = 10^(round(log10(KAVG))+" << auto_penalty_oom << ") )\n";
 			ss << "   + Automatic Penalty values for each MP Constraint:\n";
-			for (MP_Constraint* mp : mps_penalty) 
+			for (MP_Constraint* mp : mps_other) 
 				ss << "      + MP(tag = " << mp->getTag() << ") = " << std::scientific << peval->getPenaltyValue(mp) << "\n";
 		}
 		else {
+			ss << "   + " << mps_other.size() << " constraints handled with the Penalty method\n";
 			ss << "   + Uniform User-Defined penalty = " << std::scientific << user_penalty << "\n";
 		}
 		std::string ss_value = ss.str();
@@ -541,12 +622,13 @@ AutoConstraintHandler::clearAll(void)
 int
 AutoConstraintHandler::sendSelf(int cTag, Channel& theChannel)
 {
-	Vector data(4);
+	Vector data(5);
 	int result = 0;
 	data(0) = static_cast<double>(verbose);
 	data(1) = static_cast<double>(auto_penalty);
 	data(2) = auto_penalty_oom;
 	data(3) = user_penalty;
+	data(4) = static_cast<double>(lagrange_mp);
 	result = theChannel.sendVector(this->getDbTag(), cTag, data);
 	if (result != 0)
 		opserr << "AutoConstraintHandler::sendSelf() - error sending Vector\n";
@@ -558,13 +640,14 @@ AutoConstraintHandler::recvSelf(int cTag,
 	Channel& theChannel,
 	FEM_ObjectBroker& theBroker)
 {
-	Vector data(4);
+	Vector data(5);
 	int result = 0;
 	result = theChannel.recvVector(this->getDbTag(), cTag, data);
 	verbose = static_cast<bool>(data(0));
 	auto_penalty = static_cast<bool>(data(1));
 	auto_penalty_oom = data(2);
 	user_penalty = data(3);
+	lagrange_mp = static_cast<bool>(data(4));
 	if (result != 0)
 		opserr << "AutoConstraintHandler::recvSelf() - error receiving Vector\n";
 	return result;
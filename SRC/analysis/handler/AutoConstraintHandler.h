@@ -35,12 +35,17 @@
 //
 // 1) regular FE_Element and DOF_Groups if there is no SP_Constraint or MP_Constraint;
 // 2) TransformationDOF_Group for SP constraints (as in the Transformation method)
-// 3) PenaltyMP_FE for MP constraints
+// 3) TransformationDOF_Group and TransformationFE for MP constraints that
+//    can be eliminated, i.e. whose constrained node appears in no other
+//    MP constraint and has no SP constraint on the constrained DOFs
+// 4) PenaltyMP_FE (or LagrangeMP_FE with -lagrange) for the other MP constraints
 //
 // Notes:
 // 1) For each PenaltyMP_FE, by default it automatically selects a proper penalty
 //    value based on the stiffness values found on the DOFs involved in the
 //    MP constraint
+// 2) In a chain of MP constraints, the links whose constrained node is
+//    retained by another link are not eliminated
 //
 // What: "@(#) AutoConstraintHandler.h, revA"
 
@@ -61,7 +66,8 @@ public:
         bool _verbose,
         bool _auto_penalty,
         double _auto_penalty_oom,
-        double _user_penalty);
+        double _user_penalty,
+        bool _lagrange_mp = false);
     ~AutoConstraintHandler();
 
     int handle(const ID* nodesNumberedLast = 0);
@@ -78,6 +84,7 @@ private:
     bool auto_penalty = true;
     double auto_penalty_oom = 3.0;
     double user_penalty = 0.0;
+    bool lagrange_mp = false;
     std::vector<TransformationDOF_Group*> theDOFs;
 };
 
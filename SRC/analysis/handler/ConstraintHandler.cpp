@@ -36,6 +36,10 @@
 #include <Integrator.h>
 #include <FE_EleIter.h>
 #include <FE_Element.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <algorithm>
+#include <vector>
 
 ConstraintHandler::ConstraintHandler(int clasTag)
 :MovableObject(clasTag),
@@ -60,6 +64,43 @@ ConstraintHandler::doneNumberingDOF(void)
   return 0;
 }
 
+// removes from the AnalysisModel & deletes the FE_Elements whose Elements
+// are no longer in the Domain, leaving the DOF_Groups and their equation
+// numbers as they are. The Elements may have been deleted so only their
+// addresses are compared. Subclasses that keep their own lists of
+// FE_Elements must return a negative number unless they also update them.
+int
+ConstraintHandler::removeFE_Elements(void)
+{
+  if (theDomainPtr == 0 || theAnalysisModelPtr == 0)
+    return -1;
+
+  std::vector<Element *> theElements;
+  ElementIter &theEles = theDomainPtr->getElements();
+  Element *elePtr;
+  while ((elePtr = theEles()) != 0)
+    theElements.push_back(elePtr);
+  std::sort(theElements.begin(), theElements.end());
+
+  std::vector<int> removed;
+  FE_EleIter &theFEs = theAnalysisModelPtr->getFEs();
+  FE_Element *fePtr;
+  while ((fePtr = theFEs()) != 0) {
+    Element *theEle = fePtr->getElement();
+    if (theEle != 0 &&
+	std::binary_search(theElements.begin(), theElements.end(), theEle) == false)
+      removed.push_back(fePtr->getTag());
+  }
+
+  for (int i=0; i<(int)removed.size(); i++) {
+    fePtr = theAnalysisModelPtr->removeFE_Element(removed[i]);
+    if (fePtr != 0)
+      delete fePtr;
+  }
+
+  return 0;
+}
+
 void 
 ConstraintHandler::setLinks(Domain &theDomain, 
 			    AnalysisModel &theModel,
@@ -84,6 +125,20 @@ ConstraintHandler::applyLoad(void)
 }
 
 
+int
+ConstraintHandler::beginTangent(void)
+{
+  return 0;
+}
+
+
+int
+ConstraintHandler::endTangent(LinearSOE &theSOE)
+{
+  return 0;
+}
+
+
 Domain *
 ConstraintHandler::getDomainPtr(void) const
 {
@@ -46,6 +46,7 @@ class Domain;
 class AnalysisModel;
 class Integrator;
 class FEM_ObjectBroker;
+class LinearSOE;
 
 class ConstraintHandler : public MovableObject
 {
@@ -62,6 +63,12 @@ class ConstraintHandler : public MovableObject
     virtual int update(void);
     virtual int applyLoad(void);
     virtual int doneNumberingDOF(void);
+    virtual int removeFE_Elements(void);
+
+    // invoked by the integrator before & after the FE_Elements add their
+    // tangents, for handlers that add to the tangent themselves
+    virtual int beginTangent(void);
+    virtual int endTangent(LinearSOE &theSOE);
     virtual void clearAll(void) =0;    
 
   protected:
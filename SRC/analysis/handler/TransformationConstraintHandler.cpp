@@ -53,17 +53,36 @@
 #include <FEM_ObjectBroker.h>
 #include <TransformationDOF_Group.h>
 #include <TransformationFE.h>
+#include <TransformationGlobalTangent.h>
+#include <elementAPI.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
 
 void* OPS_TransformationConstraintHandler()
 {
-    return new TransformationConstraintHandler;
+    // constraints Transformation <-global>
+    bool global = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-global") == 0)
+	    global = true;
+	else {
+	    opserr << "WARNING constraints Transformation <-global> - unknown option " << opt << endln;
+	    return 0;
+	}
+    }
+
+    return new TransformationConstraintHandler(global);
 }
 
-TransformationConstraintHandler::TransformationConstraintHandler()
+TransformationConstraintHandler::TransformationConstraintHandler(bool global)
 :ConstraintHandler(HANDLER_TAG_TransformationConstraintHandler),
- theFEs(0), theDOFs(0),numFE(0),numDOF(0),numConstrainedNodes(0)
+ theFEs(0), theDOFs(0),numFE(0),numDOF(0),numConstrainedNodes(0),
+ theGlobal(0)
 {
-
+  if (global == true)
+    theGlobal = new TransformationGlobalTangent();
 }
 
 TransformationConstraintHandler::~TransformationConstraintHandler()
@@ -73,6 +92,9 @@ TransformationConstraintHandler::~TransformationConstraintHandler()
 
   if (theFEs != 0)
     delete [] theFEs;
+
+  if (theGlobal != 0)
+    delete theGlobal;
 }
 
 int
@@ -358,7 +380,8 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	    return -5;
 	  }	
 	} else {
-	  if ((fePtr = new TransformationFE(numFeEle, elePtr)) == 0) {		
+	  TransformationFE *theTransFE = new TransformationFE(numFeEle, elePtr);
+	  if (theTransFE == 0) {		
 	    opserr << "WARNING TransformationConstraintHandler::handle()";
 	    opserr << " - ran out of memory";
 	    opserr << " creating TransformationFE " << elePtr->getTag() << endln; 
@@ -366,6 +389,8 @@ TransformationConstraintHandler::handle(const ID *nodesLast)
 	    if (sps != 0) delete [] sps;
 	    return -6;		    
 	  }
+	  theTransFE->setGlobalTangent(theGlobal);
+	  fePtr = theTransFE;
 	  theFEs[numFE++] = fePtr;
 	}
 	
@@ -424,6 +449,9 @@ TransformationConstraintHandler::clearAll(void)
     theFEs = 0;
     theDOFs = 0;
 
+    if (theGlobal != 0)
+	theGlobal->clear();
+
     // for the nodes reset the DOF_Group pointers to 0
     Domain *theDomain = this->getDomainPtr();
     if (theDomain == 0)
@@ -480,6 +508,30 @@ TransformationConstraintHandler::enforceSPs(void)
     return 0;
 }
 
+int
+TransformationConstraintHandler::removeFE_Elements(void)
+{
+    if (this->ConstraintHandler::removeFE_Elements() < 0)
+	return -1;
+
+    // drop the TransformationFEs just deleted from theFEs
+    AnalysisModel *theModel = this->getAnalysisModelPtr();
+    std::vector<FE_Element *> remaining;
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0)
+	remaining.push_back(elePtr);
+    std::sort(remaining.begin(), remaining.end());
+
+    int numKept = 0;
+    for (int j=0; j<numFE; j++)
+	if (std::binary_search(remaining.begin(), remaining.end(), theFEs[j]) == true)
+	    theFEs[numKept++] = theFEs[j];
+    numFE = numKept;
+
+    return 0;
+}
+
 int 
 TransformationConstraintHandler::doneNumberingDOF(void)
 {
@@ -492,7 +544,11 @@ TransformationConstraintHandler::doneNumberingDOF(void)
     }
 
 
-    // iterate through the FE_Element getting them to set their IDs
+    // iterate through the FE_Element getting them to set their IDs, in
+    // the -global mode the TransformationFEs add their entries to theGlobal
+    if (theGlobal != 0)
+      theGlobal->clear();
+
     AnalysisModel *theModel=this->getAnalysisModelPtr();
     FE_EleIter &theEle = theModel->getFEs();
     FE_Element *elePtr;
@@ -500,5 +556,35 @@ TransformationConstraintHandler::doneNumberingDOF(void)
       elePtr->setID();
     }
 
+    if (theGlobal != 0) {
+      theGlobal->donePattern();
+      for (int j=0; j<numFE; j++) {
+	// upward cast - safe as only TransformationFEs are in theFEs
+	TransformationFE *theTransFE = (TransformationFE *)theFEs[j];
+	if (theTransFE->setGlobalLocations() < 0)
+	  return -1;
+      }
+    }
+
+    return 0;
+}
+
+
+int
+TransformationConstraintHandler::beginTangent(void)
+{
+    if (theGlobal != 0)
+	theGlobal->begin();
+
+    return 0;
+}
+
+
+int
+TransformationConstraintHandler::endTangent(LinearSOE &theSOE)
+{
+    if (theGlobal != 0)
+	return theGlobal->addToSOE(theSOE);
+
     return 0;
 }
@@ -44,11 +44,12 @@
 
 class FE_Element;
 class DOF_Group;
+class TransformationGlobalTangent;
 
 class TransformationConstraintHandler : public ConstraintHandler
 {
   public:
-    TransformationConstraintHandler();
+    TransformationConstraintHandler(bool global = false);
     ~TransformationConstraintHandler();
 
     int handle(const ID *nodesNumberedLast =0);
@@ -56,6 +57,10 @@ class TransformationConstraintHandler : public ConstraintHandler
     void clearAll(void);    
     int enforceSPs(void);    
     int doneNumberingDOF(void);        
+    int removeFE_Elements(void);
+
+    int beginTangent(void);
+    int endTangent(LinearSOE &theSOE);
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -73,6 +78,10 @@ class TransformationConstraintHandler : public ConstraintHandler
     int numConstrainedNodes;
 
     int numTransformationFEs;
+
+    // for the -global mode, the entries of the tangents coupling
+    // constrained dofs, transformed after all the elements are added
+    TransformationGlobalTangent *theGlobal;
 };
 
 #endif
@@ -64,6 +64,9 @@ public:
     int revertToLastStep(void);
     int update(const Vector &deltaU);
     int commit(void);
+    // formed in separate passes, this class has its own formElementResidual()
+    int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT, double iFact = 0.0, double cFact = 1.0)
+      {return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag, iFact, cFact);};
 
     const Vector &getVel(void);
     
@@ -64,7 +64,7 @@ void* OPS_ArcLength()
 {
     double arcLength;
     if (OPS_GetNumRemainingInputArgs() < 2) {
-	opserr << "WARNING integrator ArcLength arcLength alpha \n";
+	opserr << "WARNING integrator ArcLength arcLength alpha <Jd minArcLength maxArcLength>\n";
 	return 0;
     }
 
@@ -73,24 +73,51 @@ void* OPS_ArcLength()
 	opserr << "WARNING integrator ArcLength failed to read arc length\n";
 	return 0;
     }
+    double alpha = 1.0;
     if (OPS_GetNumRemainingInputArgs() > 0) {
-      double alpha;
-      if (OPS_GetDoubleInput(&numdata, &alpha) < 0) {
-	opserr << "WARNING integrator ArcLength failed to read alpha\n";
-	return 0;
-      }
-      return new ArcLength(arcLength,alpha);
-    } else {
-      return new ArcLength(arcLength);
+	if (OPS_GetDoubleInput(&numdata, &alpha) < 0) {
+	    opserr << "WARNING integrator ArcLength failed to read alpha\n";
+	    return 0;
+	}
+    }
+
+    // optional adaptive arc length, scaled by Jd over the iterations
+    // of the last step and held to [minArcLength, maxArcLength]
+    int numIter = 0;
+    double minArcLength = 0.0;
+    double maxArcLength = 0.0;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetIntInput(&numdata, &numIter) < 0) {
+	    opserr << "WARNING integrator ArcLength failed to read Jd\n";
+	    return 0;
+	}
     }
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetDoubleInput(&numdata, &minArcLength) < 0) {
+	    opserr << "WARNING integrator ArcLength failed to read minArcLength\n";
+	    return 0;
+	}
+    }
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetDoubleInput(&numdata, &maxArcLength) < 0) {
+	    opserr << "WARNING integrator ArcLength failed to read maxArcLength\n";
+	    return 0;
+	}
+    }
+
+    return new ArcLength(arcLength, alpha, numIter, minArcLength, maxArcLength);
 }
 
-ArcLength::ArcLength(double arcLength, double alpha)
+ArcLength::ArcLength(double arcLength, double alpha, int numIter,
+                     double minArc, double maxArc)
 :StaticIntegrator(INTEGRATOR_TAGS_ArcLength),
- arcLength2(arcLength*arcLength), alpha2(alpha*alpha),
- deltaUhat(0), deltaUbar(0), deltaU(0), deltaUstep(0),deltaUstep2(0),dDeltaUstepdh(0), 
- phat(0), deltaLambdaStep(0.0),dDeltaLambdaStepdh(0.0), currentLambda(0.0), dLAMBDA(0.0),dLAMBDA2(0.0),dlambda1dh(0.0),dLAMBDAdh(0),Residual(0),sensU(0),sensitivityFlag(0),
- signLastDeltaLambdaStep(1), dUhatdh(0),dphatdh(0),dUIJdh(0),dlambdaJdh(0.0),gradNumber(0), a(0.0),b(0.0),c(0.0),b24ac(0.0)
+ arcLength2(arcLength*arcLength), alpha2(alpha*alpha), a(0.0),b(0.0),c(0.0),b24ac(0.0),
+ deltaUhat(0), deltaUbar(0), deltaU(0), deltaUstep(0),deltaUstep2(0),
+ phat(0), dUhatdh(0),dphatdh(0),dLAMBDAdh(0),dUIJdh(0),dDeltaUstepdh(0),sensU(0),Residual(0),
+ deltaLambdaStep(0.0),dDeltaLambdaStepdh(0.0), currentLambda(0.0), dlambdaJdh(0.0),
+ signLastDeltaLambdaStep(1), dLAMBDA(0.0),dLAMBDA2(0.0),dlambda1dh(0.0),gradNumber(0),sensitivityFlag(0),
+ specNumIncrStep(numIter), numIncrLastStep(numIter),
+ minArcLength(minArc), maxArcLength(maxArc), fixedStep(false), dUhatStamp(-1)
 {
 
 }
@@ -140,6 +167,19 @@ ArcLength::newStep(void)
 	return -1;
     }
 
+    // scale the arc length by the iterations of the last step
+    if (fixedStep == true)
+	fixedStep = false;
+    else if (specNumIncrStep > 0 && numIncrLastStep > 0) {
+	double ds = sqrt(arcLength2)*specNumIncrStep/numIncrLastStep;
+	if (minArcLength > 0.0 && ds < minArcLength)
+	    ds = minArcLength;
+	else if (maxArcLength > 0.0 && ds > maxArcLength)
+	    ds = maxArcLength;
+	arcLength2 = ds*ds;
+    }
+    numIncrLastStep = 0;
+
     // get the current load factor
     currentLambda = theModel->getCurrentDomainTime();
 
@@ -158,6 +198,7 @@ ArcLength::newStep(void)
     }
 
     (*deltaUhat) = theLinSOE->getX();
+    dUhatStamp = tangentStamp;
     Vector &dUhat = *deltaUhat;
     
     // determine delta lambda(1) == dlambda
@@ -239,11 +280,14 @@ ArcLength::update(const Vector &dU)
 //opserr<<"deltaUbar= "<<*deltaUbar<<endln;
 
 //opserr<<"Update:   phat is = "<<*phat<<"////////////////////////////"<<endln;
-    // determine dUhat    
-    theLinSOE->setB(*phat);
-    theLinSOE->solve();
-
-    (*deltaUhat) = theLinSOE->getX();    
+    // determine dUhat; it is still K^-1 phat if no tangent has been
+    // formed since it was last solved for, e.g. modified Newton
+    if (dUhatStamp != tangentStamp) {
+      theLinSOE->setB(*phat);
+      theLinSOE->solve();
+      (*deltaUhat) = theLinSOE->getX();
+      dUhatStamp = tangentStamp;
+    }
 
     // determine the coeeficients of our quadratic equation
            a = alpha2 + ((*deltaUhat)^(*deltaUhat));
@@ -306,10 +350,28 @@ dLAMBDA2=dLambda;
     
     // set the X soln in linearSOE to be deltaU for convergence Test
     theLinSOE->setX(*deltaU);
+
+    numIncrLastStep++;
 //opserr<<" update:  end"<<endln;
     return 0;
 }
 
+double
+ArcLength::getStepSize(void)
+{
+    return sqrt(arcLength2);
+}
+
+// the next step takes newSize as it is, without the min/max bounds
+int
+ArcLength::setStepSize(double newSize)
+{
+    numIncrLastStep = specNumIncrStep;
+    arcLength2 = newSize*newSize;
+    fixedStep = true;
+    return 0;
+}
+
 
 
 int 
@@ -484,6 +546,7 @@ if (deltaUstep2 == 0 || deltaUstep2->Size() != size) {
     theModel->applyLoadDomain(currentLambda);    
     this->formUnbalance(); // NOTE: this assumes unbalance at last was 0
     (*phat) = theLinSOE->getB();
+    dUhatStamp = -1;
     currentLambda -= 1.0;
     theModel->setCurrentDomainTime(currentLambda);    
     
@@ -510,12 +573,16 @@ ArcLength::sendSelf(int cTag,
 {
  //  opserr<<"sendSelf: start"<<endln;
 
-  Vector data(5);
+  Vector data(9);
   data(0) = arcLength2;
   data(1) = alpha2;
   data(2) = deltaLambdaStep;
   data(3) = currentLambda;
   data(4)  = signLastDeltaLambdaStep;
+  data(5) = specNumIncrStep;
+  data(6) = numIncrLastStep;
+  data(7) = minArcLength;
+  data(8) = maxArcLength;
 
   if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0) {
       opserr << "ArcLength::sendSelf() - failed to send the data\n";
@@ -532,7 +599,7 @@ ArcLength::recvSelf(int cTag,
 {
  //  opserr<<"ArcLength:: recSelf: start"<<endln;
 
-  Vector data(5);
+  Vector data(9);
   if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
       opserr << "ArcLength::sendSelf() - failed to send the data\n";
       return -1;
@@ -544,6 +611,11 @@ ArcLength::recvSelf(int cTag,
   deltaLambdaStep = data(2);
   currentLambda = data(3);
   signLastDeltaLambdaStep = data(4);
+  specNumIncrStep = (int)data(5);
+  numIncrLastStep = (int)data(6);
+  minArcLength = data(7);
+  maxArcLength = data(8);
+  dUhatStamp = -1;
  // opserr<<"recSelf: end"<<endln;
 
   return 0;
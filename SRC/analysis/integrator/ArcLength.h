@@ -53,13 +53,18 @@ class Domain;
 class ArcLength : public StaticIntegrator
 {
   public:
-    ArcLength(double arcLength, double alpha = 1.0);
+    ArcLength(double arcLength, double alpha = 1.0, int numIter = 0,
+              double minArcLength = 0.0, double maxArcLength = 0.0);
  //   ArcLength(int node, int dof,Domain *domain);
     ~ArcLength();
 
     int newStep(void);    
     int update(const Vector &deltaU);
     int domainChanged(void);
+
+    // the arc length of the next step, used to substep a failed one
+    double getStepSize(void);
+    int setStepSize(double newSize);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -99,6 +104,12 @@ class ArcLength : public StaticIntegrator
     double dlambda1dh;
     int gradNumber;
    int sensitivityFlag;
+
+    // the arc length is scaled by Jd/J(i-1) when Jd is not 0
+    int specNumIncrStep, numIncrLastStep; // Jd & J(i-1)
+    double minArcLength, maxArcLength;
+    bool fixedStep;      // the next step uses the arc length as it is
+    int dUhatStamp;      // tangent stamp deltaUhat was solved at
 };
 
 #endif
@@ -52,33 +52,59 @@ void* OPS_ArcLength1()
 {
     double arcLength;
     if (OPS_GetNumRemainingInputArgs() < 2) {
-	opserr << "WARNING integrator ArcLength arcLength alpha \n";
+	opserr << "WARNING integrator ArcLength1 arcLength alpha <Jd minArcLength maxArcLength>\n";
 	return 0;
     }
 
     int numdata = 1;
     if (OPS_GetDoubleInput(&numdata, &arcLength) < 0) {
-	opserr << "WARNING integrator ArcLength failed to read arc length\n";
+	opserr << "WARNING integrator ArcLength1 failed to read arc length\n";
 	return 0;
     }
+    double alpha = 1.0;
     if (OPS_GetNumRemainingInputArgs() > 0) {
-        double alpha;
 	if (OPS_GetDoubleInput(&numdata, &alpha) < 0) {
-	  opserr << "WARNING integrator ArcLength failed to read alpha\n";
-	  return 0;
+	    opserr << "WARNING integrator ArcLength1 failed to read alpha\n";
+	    return 0;
 	}
-	return new ArcLength1(arcLength,alpha);
-    } else {
-      return new ArcLength1(arcLength);
     }
+
+    // optional adaptive arc length, scaled by Jd over the iterations
+    // of the last step and held to [minArcLength, maxArcLength]
+    int numIter = 0;
+    double minArcLength = 0.0;
+    double maxArcLength = 0.0;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetIntInput(&numdata, &numIter) < 0) {
+	    opserr << "WARNING integrator ArcLength1 failed to read Jd\n";
+	    return 0;
+	}
+    }
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetDoubleInput(&numdata, &minArcLength) < 0) {
+	    opserr << "WARNING integrator ArcLength1 failed to read minArcLength\n";
+	    return 0;
+	}
+    }
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetDoubleInput(&numdata, &maxArcLength) < 0) {
+	    opserr << "WARNING integrator ArcLength1 failed to read maxArcLength\n";
+	    return 0;
+	}
+    }
+
+    return new ArcLength1(arcLength, alpha, numIter, minArcLength, maxArcLength);
 }
 
-ArcLength1::ArcLength1(double arcLength, double alpha)
+ArcLength1::ArcLength1(double arcLength, double alpha, int numIter,
+                       double minArc, double maxArc)
 :StaticIntegrator(INTEGRATOR_TAGS_ArcLength1),
  arcLength2(arcLength*arcLength), alpha2(alpha*alpha),
  deltaUhat(0), deltaUbar(0), deltaU(0), deltaUstep(0), 
  phat(0), deltaLambdaStep(0.0), currentLambda(0.0), 
- signLastDeltaLambdaStep(1)
+ signLastDeltaLambdaStep(1),
+ specNumIncrStep(numIter), numIncrLastStep(numIter),
+ minArcLength(minArc), maxArcLength(maxArc), fixedStep(false), dUhatStamp(-1)
 {
 
 }
@@ -110,6 +136,19 @@ ArcLength1::newStep(void)
 	return -1;
     }
 
+    // scale the arc length by the iterations of the last step
+    if (fixedStep == true)
+	fixedStep = false;
+    else if (specNumIncrStep > 0 && numIncrLastStep > 0) {
+	double ds = sqrt(arcLength2)*specNumIncrStep/numIncrLastStep;
+	if (minArcLength > 0.0 && ds < minArcLength)
+	    ds = minArcLength;
+	else if (maxArcLength > 0.0 && ds > maxArcLength)
+	    ds = maxArcLength;
+	arcLength2 = ds*ds;
+    }
+    numIncrLastStep = 0;
+
     // get the current load factor
     currentLambda = theModel->getCurrentDomainTime();
 
@@ -123,6 +162,7 @@ ArcLength1::newStep(void)
     theLinSOE->setB(*phat);
     theLinSOE->solve();
     (*deltaUhat) = theLinSOE->getX();
+    dUhatStamp = tangentStamp;
     Vector &dUhat = *deltaUhat;
     
     // determine delta lambda(1) == dlambda
@@ -158,10 +198,14 @@ ArcLength1::update(const Vector &dU)
 
     (*deltaUbar) = dU; // have to do this as the SOE is gonna change
 
-    // determine dUhat    
-    theLinSOE->setB(*phat);
-    theLinSOE->solve();
-    (*deltaUhat) = theLinSOE->getX();    
+    // determine dUhat; it is still K^-1 phat if no tangent has been
+    // formed since it was last solved for, e.g. modified Newton
+    if (dUhatStamp != tangentStamp) {
+      theLinSOE->setB(*phat);
+      theLinSOE->solve();
+      (*deltaUhat) = theLinSOE->getX();
+      dUhatStamp = tangentStamp;
+    }
 
     // determine delta lambda(i)
     double a = (*deltaUstep)^(*deltaUbar);
@@ -190,6 +234,24 @@ ArcLength1::update(const Vector &dU)
     // set the X soln in linearSOE to be deltaU for convergence Test
     theLinSOE->setX(*deltaU);
 
+    numIncrLastStep++;
+
+    return 0;
+}
+
+double
+ArcLength1::getStepSize(void)
+{
+    return sqrt(arcLength2);
+}
+
+// the next step takes newSize as it is, without the min/max bounds
+int
+ArcLength1::setStepSize(double newSize)
+{
+    numIncrLastStep = specNumIncrStep;
+    arcLength2 = newSize*newSize;
+    fixedStep = true;
     return 0;
 }
 
@@ -272,6 +334,7 @@ ArcLength1::domainChanged(void)
     theModel->applyLoadDomain(currentLambda);    
     this->formUnbalance(); // NOTE: this assumes unbalance at last was 0
     (*phat) = theLinSOE->getB();
+    dUhatStamp = -1;
     currentLambda -= 1.0;
     theModel->setCurrentDomainTime(currentLambda);    
     
@@ -282,12 +345,16 @@ int
 ArcLength1::sendSelf(int cTag,
 		    Channel &theChannel)
 {
-  Vector data(5);
+  Vector data(9);
   data(0) = arcLength2;
   data(1) = alpha2;
   data(2) = deltaLambdaStep;
   data(3) = currentLambda;
   data(4)  = signLastDeltaLambdaStep;
+  data(5) = specNumIncrStep;
+  data(6) = numIncrLastStep;
+  data(7) = minArcLength;
+  data(8) = maxArcLength;
 
   if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0) {
       opserr << "ArcLength1::sendSelf() - failed to send the data\n";
@@ -301,7 +368,7 @@ int
 ArcLength1::recvSelf(int cTag,
 		    Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-  Vector data(5);
+  Vector data(9);
   if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
       opserr << "ArcLength1::sendSelf() - failed to send the data\n";
       return -1;
@@ -313,6 +380,11 @@ ArcLength1::recvSelf(int cTag,
   deltaLambdaStep = data(2);
   currentLambda = data(3);
   signLastDeltaLambdaStep = data(4);
+  specNumIncrStep = (int)data(5);
+  numIncrLastStep = (int)data(6);
+  minArcLength = data(7);
+  maxArcLength = data(8);
+  dUhatStamp = -1;
   return 0;
 }
 
@@ -53,13 +53,18 @@ class Vector;
 class ArcLength1 : public StaticIntegrator
 {
   public:
-    ArcLength1(double arcLength, double alpha = 1.0);
+    ArcLength1(double arcLength, double alpha = 1.0, int numIter = 0,
+               double minArcLength = 0.0, double maxArcLength = 0.0);
 
     ~ArcLength1();
 
     int newStep(void);    
     int update(const Vector &deltaU);
     int domainChanged(void);
+
+    // the arc length of the next step, used to substep a failed one
+    double getStepSize(void);
+    int setStepSize(double newSize);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -76,6 +81,12 @@ class ArcLength1 : public StaticIntegrator
     Vector *phat; // the reference load vector
     double deltaLambdaStep, currentLambda;
     int signLastDeltaLambdaStep;
+
+    // the arc length is scaled by Jd/J(i-1) when Jd is not 0
+    int specNumIncrStep, numIncrLastStep; // Jd & J(i-1)
+    double minArcLength, maxArcLength;
+    bool fixedStep;      // the next step uses the arc length as it is
+    int dUhatStamp;      // tangent stamp deltaUhat was solved at
 };
 
 #endif
@@ -154,6 +154,8 @@ DisplacementControl::DisplacementControl(int node, int dof,
            
    }
 
+   fixedStep = false;
+   dUhatStamp = -1;
 }
 
 DisplacementControl::~DisplacementControl()
@@ -210,13 +212,17 @@ DisplacementControl::newStep(void)
      theDomain = theModel->getDomainPtr();   
      
    // determine increment for this iteration
-   double factor = double(specNumIncrStep)/numIncrLastStep;
-   theIncrement *=factor;
-
-   if (theIncrement < minIncrement)
-      theIncrement = minIncrement;
-   else if (theIncrement > maxIncrement)
-      theIncrement = maxIncrement;
+   if (fixedStep == true)
+      fixedStep = false;
+   else {
+      double factor = double(specNumIncrStep)/numIncrLastStep;
+      theIncrement *=factor;
+
+      if (theIncrement < minIncrement)
+	 theIncrement = minIncrement;
+      else if (theIncrement > maxIncrement)
+	 theIncrement = maxIncrement;
+   }
 
 
    // get the current load factor
@@ -231,6 +237,7 @@ DisplacementControl::newStep(void)
    }
 
    (*deltaUhat) = theLinSOE->getX();
+   dUhatStamp = tangentStamp;
    Vector &dUhat = *deltaUhat;// this is the Uft in the nonlinear lecture notes
    double dUahat = dUhat(theDofID);// this is the component of the Uft in our nonlinear lecture notes
 
@@ -316,10 +323,14 @@ int DisplacementControl::update(const Vector &dU)
    double dUabar = (*deltaUbar)(theDofID);//dUbar is the vector of residual displacement and dUabar is its component
     // opserr<<" DisplacementControl:: deltaUbar = "<<*deltaUbar<<endln; 
 
-   // determine dUhat    
-   theLinSOE->setB(*phat);
-   theLinSOE->solve();
-   (*deltaUhat) = theLinSOE->getX();    
+   // determine dUhat; it is still K^-1 phat if no tangent has been
+   // formed since it was last solved for, e.g. modified Newton
+   if (dUhatStamp != tangentStamp) {
+     theLinSOE->setB(*phat);
+     theLinSOE->solve();
+     (*deltaUhat) = theLinSOE->getX();
+     dUhatStamp = tangentStamp;
+   }
 
    double dUahat = (*deltaUhat)(theDofID);
    if (dUahat == 0.0) {
@@ -359,6 +370,31 @@ int DisplacementControl::update(const Vector &dU)
 
 
 
+double
+DisplacementControl::getStepSize(void)
+{
+   return theIncrement;
+}
+
+// a fixed next step takes newSize as it is, without the min/max bounds
+int
+DisplacementControl::setStepSize(double newSize, bool fixed)
+{
+   if (fixed == true)
+      numIncrLastStep = specNumIncrStep;
+   theIncrement = newSize;
+   fixedStep = fixed;
+   return 0;
+}
+
+bool
+DisplacementControl::isStepSizeFixed(void)
+{
+   return fixedStep;
+}
+
+
+
 int 
 DisplacementControl::domainChanged(void)
 {
@@ -519,6 +555,7 @@ DisplacementControl::domainChanged(void)
    theModel->applyLoadDomain(currentLambda);    
    this->formUnbalance(); // NOTE: this assumes unbalance at last was 0
    (*phat) = theLinSOE->getB();
+   dUhatStamp = -1;
 
    currentLambda -= 1.0;
    theModel->setCurrentDomainTime(currentLambda);    
@@ -64,6 +64,10 @@ class DisplacementControl : public StaticIntegrator
       int update(const Vector &deltaU);
       int domainChanged(void);
 
+      double getStepSize(void);
+      int setStepSize(double newSize, bool fixed = true);
+      bool isStepSizeFixed(void);
+
       int sendSelf(int commitTag, Channel &theChannel);
       int recvSelf(int commitTag, Channel &theChannel, 
 	    FEM_ObjectBroker &theBroker);
@@ -130,6 +134,9 @@ class DisplacementControl : public StaticIntegrator
       int gradNumber;
       int sensitivityFlag;
       FE_Element *theEle;
+
+      bool fixedStep;      // the next step uses theIncrement as it is
+      int dUhatStamp;      // tangent stamp deltaUhat was solved at
 };
 
 #endif
@@ -301,11 +301,14 @@ DistributedDisplacementControl::domainChanged(void)
 	  theDofID = data(0);
       }
       
+      // the same value goes to all, post the sends together
+      data(0) = theDofID;
       for (int k=0; k<numChannels; k++) {
 	Channel *theChannel = theChannels[k];
-	data(0) = theDofID;
-	theChannel->sendID(0, 0, data);
+	theChannel->isendID(0, 0, data);
       }
+      for (int k=0; k<numChannels; k++)
+	theChannels[k]->waitAll();
     }
 
     if (deltaUhat == 0 || deltaUhat->Size() != size) { // create new Vector
@@ -430,6 +430,19 @@ HHT::getVel()
   return *Udot;
 }
 
+
+int
+HHT::estimateLocalError(double deltaT, double &errNorm, double &dispNorm)
+{
+  if (U == 0 || Udotdot == 0 || Utdotdot == 0)
+    return -1;
+
+  // the estimate of the underlying Newmark scheme
+  errNorm = accelJumpError(beta - 1.0/6.0, deltaT, *Udotdot, *Utdotdot);
+  dispNorm = U->Norm();
+  return 0;
+}
+
 int HHT::sendSelf(int cTag, Channel &theChannel)
 {
     Vector data(3);
@@ -441,6 +441,19 @@ HHTGeneralized::getVel()
   return *Udot;
 }
 
+
+int
+HHTGeneralized::estimateLocalError(double deltaT, double &errNorm, double &dispNorm)
+{
+  if (U == 0 || Udotdot == 0 || Utdotdot == 0)
+    return -1;
+
+  // the estimate of the underlying Newmark scheme
+  errNorm = accelJumpError(beta - 1.0/6.0, deltaT, *Udotdot, *Utdotdot);
+  dispNorm = U->Norm();
+  return 0;
+}
+
 int HHTGeneralized::sendSelf(int cTag, Channel &theChannel)
 {
     Vector data(4);
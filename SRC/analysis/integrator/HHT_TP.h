@@ -52,6 +52,9 @@ public:
     
     // method to set up the system of equations
     int formUnbalance(void);
+    // formed in separate passes, this class has its own formUnbalance()
+    int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT, double iFact = 0.0, double cFact = 1.0)
+      {return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag, iFact, cFact);};
     
     // methods which define what the FE_Element and DOF_Groups add
     // to the system of equation object.
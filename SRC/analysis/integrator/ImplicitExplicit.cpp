@@ -0,0 +1,382 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of ImplicitExplicit.
+//
+// What: "@(#) ImplicitExplicit.cpp, revA"
+
+#include <ImplicitExplicit.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <Element.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <Domain.h>
+#include <MeshRegion.h>
+#include <Channel.h>
+#include <elementAPI.h>
+#include <classTags.h>
+#include <string.h>
+#include <algorithm>
+
+// reads the integers following a flag, stops at the next flag
+static int
+getTagList(ID &theTags)
+{
+    int numTags = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	int tag;
+	int numData = 1;
+	if (OPS_GetIntInput(&numData, &tag) < 0) {
+	    OPS_ResetCurrentInputArg(-1);
+	    break;
+	}
+	theTags[numTags++] = tag;
+    }
+    return numTags;
+}
+
+void *
+OPS_ImplicitExplicit(void)
+{
+    // integrator ImplicitExplicit $gamma $beta <-ele $tags> <-region $tags>
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING - incorrect number of args want ImplicitExplicit $gamma $beta <-ele $eleTags> <-region $regionTags>\n";
+	return 0;
+    }
+
+    double dData[2];
+    int numData = 2;
+    if (OPS_GetDouble(&numData, dData) != 0) {
+	opserr << "WARNING - invalid args want ImplicitExplicit $gamma $beta <-ele $eleTags> <-region $regionTags>\n";
+	return 0;
+    }
+
+    ID eleTags(0, 16);
+    ID regionTags(0, 4);
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-ele") == 0) {
+	    ID theTags(0, 16);
+	    int numTags = getTagList(theTags);
+	    for (int i = 0; i < numTags; i++)
+		eleTags[eleTags.Size()] = theTags(i);
+	} else if (strcmp(opt, "-region") == 0) {
+	    ID theTags(0, 4);
+	    int numTags = getTagList(theTags);
+	    for (int i = 0; i < numTags; i++)
+		regionTags[regionTags.Size()] = theTags(i);
+	} else {
+	    opserr << "WARNING ImplicitExplicit - unknown option " << opt << endln;
+	    return 0;
+	}
+    }
+
+    if (eleTags.Size() == 0 && regionTags.Size() == 0)
+	opserr << "WARNING ImplicitExplicit - no explicit elements given, all are implicit\n";
+
+    return new ImplicitExplicit(dData[0], dData[1], eleTags, regionTags);
+}
+
+
+ImplicitExplicit::ImplicitExplicit()
+:Newmark(INTEGRATOR_TAGS_ImplicitExplicit),
+ explicitEles(0), explicitRegions(0), explicitForce(0), allEqns(0),
+ formingExplicit(false)
+{
+
+}
+
+
+ImplicitExplicit::ImplicitExplicit(double _gamma, double _beta,
+				   const ID &theEles, const ID &theRegions)
+:Newmark(_gamma, _beta, 1, false, INTEGRATOR_TAGS_ImplicitExplicit),
+ explicitEles(theEles), explicitRegions(theRegions), explicitForce(0), allEqns(0),
+ formingExplicit(false)
+{
+
+}
+
+
+ImplicitExplicit::~ImplicitExplicit()
+{
+
+}
+
+
+bool
+ImplicitExplicit::isExplicit(FE_Element *theEle)
+{
+    // FE_Elements of the constraint handlers have no Element
+    Element *theElement = theEle->getElement();
+    if (theElement == 0)
+	return false;
+
+    return std::binary_search(explicitTags.begin(), explicitTags.end(),
+			      theElement->getTag());
+}
+
+
+int
+ImplicitExplicit::domainChanged(void)
+{
+    if (this->Newmark::domainChanged() < 0)
+	return -1;
+
+    AnalysisModel *theModel = this->getAnalysisModel();
+    Domain *theDomain = theModel->getDomainPtr();
+
+    // the regions are looked up again, their elements may have changed
+    explicitTags.clear();
+    for (int i = 0; i < explicitEles.Size(); i++)
+	explicitTags.push_back(explicitEles(i));
+
+    for (int i = 0; i < explicitRegions.Size(); i++) {
+	MeshRegion *theRegion = theDomain->getRegion(explicitRegions(i));
+	if (theRegion == 0) {
+	    opserr << "WARNING ImplicitExplicit::domainChanged() - region ";
+	    opserr << explicitRegions(i) << " does not exist\n";
+	    return -2;
+	}
+	const ID &theEles = theRegion->getElements();
+	for (int j = 0; j < theEles.Size(); j++)
+	    explicitTags.push_back(theEles(j));
+    }
+
+    std::sort(explicitTags.begin(), explicitTags.end());
+    explicitTags.erase(std::unique(explicitTags.begin(), explicitTags.end()),
+		       explicitTags.end());
+
+    int size = U->Size();
+    if (explicitForce.Size() != size) {
+	explicitForce.resize(size);
+	allEqns = ID(size);
+	for (int i = 0; i < size; i++)
+	    allEqns(i) = i;
+    }
+    explicitForce.Zero();
+
+    return 0;
+}
+
+
+int
+ImplicitExplicit::newStep(double deltaT)
+{
+    if (beta == 0 || gamma == 0) {
+	opserr << "ImplicitExplicit::newStep() - error in variable\n";
+	opserr << "gamma = " << gamma << " beta = " << beta << endln;
+	return -1;
+    }
+
+    if (deltaT <= 0.0) {
+	opserr << "ImplicitExplicit::newStep() - error in variable\n";
+	opserr << "dT = " << deltaT << endln;
+	return -2;
+    }
+
+    if (U == 0) {
+	opserr << "ImplicitExplicit::newStep() - domainChange() failed or hasn't been called\n";
+	return -3;
+    }
+
+    AnalysisModel *theModel = this->getAnalysisModel();
+
+    c1 = 1.0;
+    c2 = gamma/(beta*deltaT);
+    c3 = 1.0/(beta*deltaT*deltaT);
+
+    (*Ut) = *U;
+    (*Utdot) = *Udot;
+    (*Utdotdot) = *Udotdot;
+
+    // the predictor, the Newmark relations with a(t+deltaT) = 0; update()
+    // then gives u = u~ + beta dt^2 a and v = v~ + gamma dt a
+    U->addVector(1.0, *Utdot, deltaT);
+    U->addVector(1.0, *Utdotdot, deltaT*deltaT*(0.5 - beta));
+    Udot->addVector(1.0, *Utdotdot, deltaT*(1.0 - gamma));
+    Udotdot->Zero();
+
+    theModel->setResponse(*U, *Udot, *Udotdot);
+
+    double time = theModel->getCurrentDomainTime();
+    time += deltaT;
+    if (theModel->updateDomain(time, deltaT) < 0) {
+	opserr << "ImplicitExplicit::newStep() - failed to update the domain\n";
+	return -4;
+    }
+
+    // the force of the explicit elements at the predictor, held for the step
+    explicitForce.Zero();
+    if (explicitTags.empty())
+	return 0;
+
+    formingExplicit = true;
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0) {
+	if (this->isExplicit(elePtr) == false)
+	    continue;
+
+	const Vector &theResidual = elePtr->getResidual(this);
+	const ID &theID = elePtr->getID();
+	for (int i = 0; i < theID.Size(); i++) {
+	    int loc = theID(i);
+	    if (loc >= 0)
+		explicitForce(loc) += theResidual(i);
+	}
+    }
+    formingExplicit = false;
+
+    return 0;
+}
+
+
+int
+ImplicitExplicit::formEleTangent(FE_Element *theEle)
+{
+    if (determiningMass == true || this->isExplicit(theEle) == false)
+	return this->Newmark::formEleTangent(theEle);
+
+    theEle->zeroTangent();
+    theEle->addMtoTang(c3);
+
+    return 0;
+}
+
+
+int
+ImplicitExplicit::formEleResidual(FE_Element *theEle)
+{
+    if (this->isExplicit(theEle) == false)
+	return this->Newmark::formEleResidual(theEle);
+
+    // at the predictor the nodal accelerations are 0 and this is the
+    // resisting & damping force, afterwards only the inertia is added
+    theEle->zeroResidual();
+    if (formingExplicit == true)
+	theEle->addRIncInertiaToResidual();
+    else
+	theEle->addM_Force(*Udotdot, -1.0);
+
+    return 0;
+}
+
+
+int
+ImplicitExplicit::formElementResidual(void)
+{
+    int res = this->IncrementalIntegrator::formElementResidual();
+
+    if (explicitTags.empty() || explicitForce.Size() == 0)
+	return res;
+
+    LinearSOE *theSOE = this->getLinearSOE();
+    if (theSOE->addB(explicitForce, allEqns) < 0) {
+	opserr << "WARNING ImplicitExplicit::formElementResidual -";
+	opserr << " failed to add the force of the explicit elements\n";
+	res = -2;
+    }
+
+    return res;
+}
+
+
+int
+ImplicitExplicit::sendSelf(int cTag, Channel &theChannel)
+{
+    int numEles = explicitEles.Size();
+    int numRegions = explicitRegions.Size();
+
+    Vector data(4);
+    data(0) = gamma;
+    data(1) = beta;
+    data(2) = numEles;
+    data(3) = numRegions;
+
+    if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0) {
+	opserr << "WARNING ImplicitExplicit::sendSelf() - could not send data\n";
+	return -1;
+    }
+
+    if (numEles + numRegions == 0)
+	return 0;
+
+    ID tags(numEles + numRegions);
+    for (int i = 0; i < numEles; i++)
+	tags(i) = explicitEles(i);
+    for (int i = 0; i < numRegions; i++)
+	tags(numEles+i) = explicitRegions(i);
+
+    if (theChannel.sendID(this->getDbTag(), cTag, tags) < 0) {
+	opserr << "WARNING ImplicitExplicit::sendSelf() - could not send the tags\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+int
+ImplicitExplicit::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    Vector data(4);
+    if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0) {
+	opserr << "WARNING ImplicitExplicit::recvSelf() - could not receive data\n";
+	return -1;
+    }
+
+    gamma = data(0);
+    beta = data(1);
+    displ = 1;
+    int numEles = (int)data(2);
+    int numRegions = (int)data(3);
+
+    explicitEles = ID(numEles);
+    explicitRegions = ID(numRegions);
+    if (numEles + numRegions == 0)
+	return 0;
+
+    ID tags(numEles + numRegions);
+    if (theChannel.recvID(this->getDbTag(), cTag, tags) < 0) {
+	opserr << "WARNING ImplicitExplicit::recvSelf() - could not receive the tags\n";
+	return -1;
+    }
+
+    for (int i = 0; i < numEles; i++)
+	explicitEles(i) = tags(i);
+    for (int i = 0; i < numRegions; i++)
+	explicitRegions(i) = tags(numEles+i);
+
+    return 0;
+}
+
+
+void
+ImplicitExplicit::Print(OPS_Stream &s, int flag)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel != 0) {
+	s << "\t ImplicitExplicit - currentTime: " << theModel->getCurrentDomainTime();
+	s << "  gamma: " << gamma << "  beta: " << beta << endln;
+	s << "  explicit elements: " << (int)explicitTags.size() << endln;
+    } else
+	s << "\t ImplicitExplicit - no associated AnalysisModel\n";
+}
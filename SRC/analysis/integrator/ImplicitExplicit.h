@@ -0,0 +1,80 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ImplicitExplicit_h
+#define ImplicitExplicit_h
+
+// Description: This file contains the class definition for ImplicitExplicit.
+// ImplicitExplicit is a Newmark integrator that treats a subset of the
+// elements explicitly (the partitioned scheme of Hughes & Liu). At the
+// start of each step the response is set to the Newmark predictor,
+//    u~ = u + dt v + dt^2 (1/2 - beta) a,   v~ = v + dt (1 - gamma) a,
+// and the resisting force of the explicit elements is formed once at that
+// state and then held over the iterations of the step; those elements only
+// add their mass to the tangent & their inertia force to the residual. The
+// other elements are integrated with the implicit Newmark scheme. The
+// explicit elements are given by element tags or by the mesh regions they
+// are in, e.g. the soil box of a DRM model, and should have a lumped mass
+// so the rows of their dofs are diagonal. The explicit part is only
+// conditionally stable, dt < 2/omega_max for gamma = 1/2.
+//
+// What: "@(#) ImplicitExplicit.h, revA"
+
+#include <Newmark.h>
+#include <ID.h>
+#include <vector>
+
+class ImplicitExplicit : public Newmark
+{
+public:
+    ImplicitExplicit();
+    ImplicitExplicit(double gamma, double beta,
+		     const ID &explicitEles, const ID &explicitRegions);
+    ~ImplicitExplicit();
+
+    int formEleTangent(FE_Element *theEle);
+    int formEleResidual(FE_Element *theEle);
+
+    // the residual is formed in its own pass, see formElementResidual()
+    int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT, double iFact = 0.0, double cFact = 1.0)
+      {return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag, iFact, cFact);};
+
+    int domainChanged(void);
+    int newStep(double deltaT);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+    void Print(OPS_Stream &s, int flag = 0);
+
+protected:
+    int formElementResidual(void);
+
+private:
+    bool isExplicit(FE_Element *theEle);
+
+    ID explicitEles, explicitRegions;
+    std::vector<int> explicitTags;  // sorted tags of all the explicit elements
+    Vector explicitForce;           // force of the explicit elements at the predictor
+    ID allEqns;                     // 0 .. numEqn-1 to add explicitForce to the SOE
+    bool formingExplicit;           // newStep() is forming explicitForce
+};
+
+#endif
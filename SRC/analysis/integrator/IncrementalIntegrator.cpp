@@ -32,21 +32,76 @@
 
 #include <IncrementalIntegrator.h>
 #include <FE_Element.h>
+#include <Element.h>
 #include <LinearSOE.h>
 #include <AnalysisModel.h>
 #include <Vector.h>
+#include <ID.h>
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
 #include <EigenSOE.h>
+#include <Domain.h>
+#include <Parameter.h>
+#include <ParameterIter.h>
+#include <Matrix.h>
+#include <AnalysisProfiler.h>
+#include <ConstraintHandler.h>
+#include <GraphColoring.h>
+#include <vector>
 #include <cmath>
 
+// the serial additions into the SOE, the profiler counts them as assembly
+static int
+addTangent(LinearSOE *theSOE, const Matrix &theTangent, const ID &theID)
+{
+    ProfilePhase phase(AnalysisProfiler::Assembly);
+    return theSOE->addA(theTangent, theID);
+}
+
+static int
+addResidual(LinearSOE *theSOE, const Vector &theResidual, const ID &theID)
+{
+    ProfilePhase phase(AnalysisProfiler::Assembly);
+    return theSOE->addB(theResidual, theID);
+}
+
+// the ConstraintHandler may add to the tangent once the FE_Elements have
+// added theirs, as the TransformationConstraintHandler does in -global mode
+static void
+beginHandlerTangent(AnalysisModel *theModel)
+{
+    ConstraintHandler *theHandler = theModel->getHandlerPtr();
+    if (theHandler != 0)
+	theHandler->beginTangent();
+}
+
+static int
+endHandlerTangent(AnalysisModel *theModel, LinearSOE *theSOE, int res)
+{
+    ConstraintHandler *theHandler = theModel->getHandlerPtr();
+    if (theHandler == 0)
+	return res;
+
+    ProfilePhase phase(AnalysisProfiler::Assembly);
+    if (theHandler->endTangent(*theSOE) < 0) {
+	opserr << "WARNING IncrementalIntegrator - the ConstraintHandler failed to add to the tangent\n";
+	return -3;
+    }
+    return res;
+}
+
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
 :Integrator(clasTag),
- statusFlag(CURRENT_TANGENT), theEigenSOE(0), 
+ statusFlag(CURRENT_TANGENT), tangentStamp(0), theEigenSOE(0), 
  eigenVectors(0), eigenValues(0), dampingForces(0),isDiagonal(false),diagMass(0),
  mV(0),tmpV1(0),tmpV2(0),
- theSOE(0), theAnalysisModel(0), theTest(0)
+ theSOE(0), theAnalysisModel(0), theTest(0),
+ theAssemblyFEs(0), numAssemblyFEs(0), numThreadSafeFEs(0), sizeAssemblyFEs(0),
+ assemblyChunk(32), assemblyColored(false), assemblyStamp(-1), assemblySOE(0),
+ reducedActive(false), reducedUsed(false), reducedEta(1.0),
+ reducedTime(0.0), linearB1(0), linearG(0), linearB(0),
+ linearID(0)
 {
   
 }
@@ -65,6 +120,16 @@ IncrementalIntegrator::~IncrementalIntegrator()
     delete tmpV1;
   if (tmpV2 != 0)
     delete tmpV2;
+  if (theAssemblyFEs != 0)
+    delete [] theAssemblyFEs;
+  if (linearB1 != 0)
+    delete linearB1;
+  if (linearG != 0)
+    delete linearG;
+  if (linearB != 0)
+    delete linearB;
+  if (linearID != 0)
+    delete linearID;
 }
 
 void
@@ -84,6 +149,7 @@ IncrementalIntegrator::setEigenSOE(EigenSOE *theEigSOE) {
 int 
 IncrementalIntegrator::formTangent(int statFlag)
 {
+    ProfilePhase phase(AnalysisProfiler::TangentFormation);
     int result = 0;
     statusFlag = statFlag;
 
@@ -95,19 +161,14 @@ IncrementalIntegrator::formTangent(int statFlag)
 
     // zero the A matrix of the linearSOE
     theSOE->zeroA();
+    tangentStamp++;
 
     // the loops to form and add the tangents are broken into two for 
     // efficiency when performing parallel computations - CHANGE
 
     // loop through the FE_Elements adding their contributions to the tangent
-    FE_Element *elePtr;
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0)     
-	if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
-	    opserr << "WARNING IncrementalIntegrator::formTangent -";
-	    opserr << " failed in addA for ID " << elePtr->getID();	    
-	    result = -3;
-	}
+    if (this->formElementTangent() < 0)
+	result = -3;
 
     return result;
 }
@@ -120,6 +181,15 @@ IncrementalIntegrator::formTangent(int statFlag, double iFact, double cFact)
     return this->formTangent(statFlag);
 }
 
+int
+IncrementalIntegrator::formUnbalanceAndTangent(int statFlag, double iFact, double cFact)
+{
+    if (this->formUnbalance() < 0)
+	return -2;
+
+    return this->formTangent(statFlag, iFact, cFact);
+}
+
 int
 IncrementalIntegrator::formIndependentSensitivityLHS(int statFlag)
 {
@@ -129,6 +199,8 @@ IncrementalIntegrator::formIndependentSensitivityLHS(int statFlag)
 int 
 IncrementalIntegrator::formUnbalance(void)
 {
+    ProfilePhase phase(AnalysisProfiler::ResidualFormation);
+
     if (theAnalysisModel == 0 || theSOE == 0) {
 	opserr << "WARNING IncrementalIntegrator::formUnbalance -";
 	opserr << " no AnalysisModel or LinearSOE has been set\n";
@@ -151,6 +223,156 @@ IncrementalIntegrator::formUnbalance(void)
 
     return 0;
 }
+
+
+// beginReducedUnbalance(dU):
+//	called with the unbalance of the full step dU formed; splits the
+//	FE_Elements into those with a constant tangent, whose unbalance is
+//	B1 + (eta-1)*G along the line, and the others, and stops the domain
+//	from updating the former. Returns 0 without doing anything if there
+//	are no constant tangent elements.
+
+int
+IncrementalIntegrator::beginReducedUnbalance(const Vector &dU)
+{
+    if (theAnalysisModel == 0 || theSOE == 0) {
+	opserr << "WARNING IncrementalIntegrator::beginReducedUnbalance -";
+	opserr << " no AnalysisModel or LinearSOE has been set\n";
+	return -1;
+    }
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    if (theDomain == 0)
+	return -1;
+
+    this->endReducedUnbalance();
+
+    // frozen and inactive elements are never updated, they are evaluated
+    // as in a full unbalance
+    FE_EleIter &theEles = theAnalysisModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0) {
+	Element *theEle = elePtr->getElement();
+	if (theEle != 0 && theEle->isSubdomain() == false &&
+	    theEle->isFrozen() == false && theEle->isActive() == true &&
+	    theEle->hasConstantTangent() == true)
+	    linearFEs.push_back(elePtr);
+	else
+	    reducedFEs.push_back(elePtr);
+    }
+
+    if (linearFEs.empty() == true) {
+	reducedFEs.clear();
+	return 0;
+    }
+
+    int numEqn = theSOE->getNumEqn();
+    if (linearB1 == 0 || linearB1->Size() != numEqn) {
+	if (linearB1 != 0) {
+	    delete linearB1;
+	    delete linearG;
+	    delete linearB;
+	    delete linearID;
+	}
+	linearB1 = new Vector(numEqn);
+	linearG = new Vector(numEqn);
+	linearB = new Vector(numEqn);
+	linearID = new ID(numEqn);
+	for (int i=0; i<numEqn; i++)
+	    (*linearID)(i) = i;
+    }
+
+    // the unbalance of the full step is put back once B1 and G are formed
+    *linearB = theSOE->getB();
+
+    int res = 0;
+    theSOE->zeroB();
+    for (FE_Element *theFE : linearFEs)
+	if (addResidual(theSOE, theFE->getResidual(this), theFE->getID()) < 0)
+	    res = -2;
+    *linearB1 = theSOE->getB();
+
+    theSOE->zeroB();
+    for (FE_Element *theFE : linearFEs)
+	if (addResidual(theSOE, theFE->getTangForce(dU, -1.0), theFE->getID()) < 0)
+	    res = -2;
+    *linearG = theSOE->getB();
+
+    theSOE->setB(*linearB);
+
+    if (res < 0) {
+	opserr << "WARNING IncrementalIntegrator::beginReducedUnbalance -";
+	opserr << " failed in addB, the full unbalance is used\n";
+	linearFEs.clear();
+	reducedFEs.clear();
+	return res;
+    }
+
+    reducedTime = theDomain->getCurrentTime();
+    reducedEta = 1.0;
+    reducedActive = true;
+    theDomain->setSkipConstantTangent(true);
+
+    return 0;
+}
+
+
+// formTrialUnbalance(eta):
+//	forms the unbalance once the domain has been updated to eta*dU from
+//	the start of the search. The extrapolation needs the loads to be
+//	those at the start; if the integrator moved the load factor with the
+//	trial point, or forms the element residual itself, the constant
+//	tangent elements are brought up to date and the full unbalance is
+//	used for the rest of the search.
+
+int
+IncrementalIntegrator::formTrialUnbalance(double eta)
+{
+    if (reducedActive == true) {
+	Domain *theDomain = theAnalysisModel->getDomainPtr();
+	if (theDomain->getCurrentTime() == reducedTime) {
+	    reducedEta = eta;
+	    reducedUsed = false;
+	    int res = this->formUnbalance();
+	    if (res < 0 || reducedUsed == true)
+		return res;
+	}
+
+	if (this->endReducedUnbalance() < 0)
+	    return -1;
+    }
+
+    return this->formUnbalance();
+}
+
+
+// endReducedUnbalance():
+//	updates the constant tangent elements to the current trial state and
+//	lets the domain update them again.
+
+int
+IncrementalIntegrator::endReducedUnbalance(void)
+{
+    int res = 0;
+
+    if (reducedActive == true) {
+	reducedActive = false;
+	Domain *theDomain = theAnalysisModel->getDomainPtr();
+	theDomain->setSkipConstantTangent(false);
+
+	for (FE_Element *theFE : linearFEs)
+	    if (theFE->getElement()->update() < 0)
+		res = -1;
+
+	if (res < 0)
+	    opserr << "WARNING IncrementalIntegrator::endReducedUnbalance - element failed in update\n";
+    }
+
+    linearFEs.clear();
+    reducedFEs.clear();
+
+    return res;
+}
     
 int
 IncrementalIntegrator::getLastResponse(Vector &result, const ID &id)
@@ -242,6 +464,89 @@ IncrementalIntegrator::getAnalysisModel(void) const
     return theAnalysisModel;
 }
 
+// number of parameters whose right-hand sides are solved together
+#define SENSITIVITY_BLOCK_SIZE 32
+
+int
+IncrementalIntegrator::computeParameterSensitivities(void)
+{
+    if (theSOE == 0 || theAnalysisModel == 0) {
+	opserr << "WARNING IncrementalIntegrator::computeParameterSensitivities() -";
+	opserr << " no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+
+    // Zero out the old right-hand side of the SOE
+    theSOE->zeroB();
+
+    // Form the part of the RHS which are independent of parameter
+    this->formIndependentSensitivityRHS();
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    int numGrads = theDomain->getNumParameters();
+    int numEqn = theSOE->getNumEqn();
+
+    // De-activate all parameters
+    std::vector<Parameter *> theParams;
+    theParams.reserve(numGrads);
+    ParameterIter &paramIter = theDomain->getParameters();
+    Parameter *theParam;
+    while ((theParam = paramIter()) != 0) {
+	theParam->activate(false);
+	theParams.push_back(theParam);
+    }
+
+    // the right-hand side of a parameter does not depend on the
+    // sensitivities of the others, so those of a block are all formed
+    // before they are solved with one factorization of the tangent
+    Matrix rhs, sens;
+    for (int first = 0; first < (int)theParams.size(); first += SENSITIVITY_BLOCK_SIZE) {
+	int numInBlock = (int)theParams.size() - first;
+	if (numInBlock > SENSITIVITY_BLOCK_SIZE)
+	    numInBlock = SENSITIVITY_BLOCK_SIZE;
+	if (rhs.noRows() != numEqn || rhs.noCols() != numInBlock)
+	    rhs.resize(numEqn, numInBlock);
+
+	for (int j = 0; j < numInBlock; j++) {
+	    theParam = theParams[first+j];
+	    theParam->activate(true);
+	    theSOE->zeroB();
+	    this->formSensitivityRHS(theParam->getGradIndex());
+	    const Vector &B = theSOE->getB();
+	    for (int i = 0; i < numEqn; i++)
+		rhs(i,j) = B(i);
+	    theParam->activate(false);
+	}
+
+	// Solve for displacement sensitivity
+	if (theSOE->solveMultiple(rhs, sens) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::computeParameterSensitivities() -";
+	    opserr << " failed to solve for the sensitivities\n";
+	    return -1;
+	}
+
+	Vector x(numEqn);
+	for (int j = 0; j < numInBlock; j++) {
+	    theParam = theParams[first+j];
+	    int gradIndex = theParam->getGradIndex();
+	    theParam->activate(true);
+
+	    // Save sensitivity to nodes
+	    for (int i = 0; i < numEqn; i++)
+		x(i) = sens(i,j);
+	    this->saveSensitivity(x, gradIndex, numGrads);
+
+	    // Commit unconditional history variables (also for elastic problems; strain sens may be needed anyway)
+	    this->commitSensitivity(gradIndex, numGrads);
+
+	    // De-activate this parameter for next sensitivity calc
+	    theParam->activate(false);
+	}
+    }
+
+    return 0;
+}
+
 int 
 IncrementalIntegrator::formNodalUnbalance(void)
 {
@@ -253,7 +558,7 @@ IncrementalIntegrator::formNodalUnbalance(void)
     while ((dofPtr = theDOFs()) != 0) { 
       //      opserr << "NODPTR: " << dofPtr->getUnbalance(this);
 
-	if (theSOE->addB(dofPtr->getUnbalance(this),dofPtr->getID()) <0) {
+	if (addResidual(theSOE, dofPtr->getUnbalance(this), dofPtr->getID()) <0) {
 	    opserr << "WARNING IncrementalIntegrator::formNodalUnbalance -";
 	    opserr << " failed in addB for ID " << dofPtr->getID();
 	    res = -2;
@@ -271,19 +576,368 @@ IncrementalIntegrator::formElementResidual(void)
 
     int res = 0;    
 
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0) {
+    // the trial point of a reduced line search: the constant tangent
+    // elements are not updated, their part is extrapolated along dU
+    if (reducedActive == true) {
+	reducedUsed = true;
+
+	*linearB = *linearB1;
+	linearB->addVector(1.0, *linearG, reducedEta - 1.0);
+	if (addResidual(theSOE, *linearB, *linearID) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+	    opserr << " failed in addB for the constant tangent elements\n";
+	    res = -2;
+	}
+
+	for (FE_Element *theFE : reducedFEs) {
+	    if (addResidual(theSOE, theFE->getResidual(this), theFE->getID()) <0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+		opserr << " failed in addB for ID " << theFE->getID();
+		res = -2;
+	    }
+	}
+
+	return res;
+    }
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    if (theDomain == 0 || theDomain->getParallelUpdate() == false) {
+
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0) {
 
-	if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) <0) {
+	    if (addResidual(theSOE, elePtr->getResidual(this), elePtr->getID()) <0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+		opserr << " failed in addB for ID " << elePtr->getID();
+		res = -2;
+	    }
+	}
+
+	return res;
+    }
+
+    if (this->sortFEsForAssembly() < 0)
+	return -1;
+
+    // FE_Elements that are not thread safe are added in serial
+    for (int i=numThreadSafeFEs; i<numAssemblyFEs; i++) {
+	elePtr = theAssemblyFEs[i];
+	if (addResidual(theSOE, elePtr->getResidual(this), elePtr->getID()) <0) {
 	    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
 	    opserr << " failed in addB for ID " << elePtr->getID();
 	    res = -2;
 	}
     }
 
+    // the others are formed concurrently into their own storage, the
+    // addition into the SOE is serialized unless they are colored
+    int numFailed = 0;
+    OPS_ThreadGlobals theGlobals;
+    if (assemblyColored == false && theDomain->getDeterministic() == true) {
+	// formed concurrently and copied, then added in order
+	orderedResiduals.resize(numThreadSafeFEs);
+#pragma omp parallel for schedule(dynamic, assemblyChunk)
+	for (int i=0; i<numThreadSafeFEs; i++) {
+	    theGlobals.install();
+	    orderedResiduals[i] = theAssemblyFEs[i]->getResidual(this);
+	}
+	for (int i=0; i<numThreadSafeFEs; i++)
+	    if (theSOE->addB(orderedResiduals[i], theAssemblyFEs[i]->getID()) < 0)
+		numFailed++;
+    } else
+    for (size_t g=0; g+1<assemblyGroups.size(); g++) {
+#pragma omp parallel for reduction(+:numFailed) schedule(dynamic, assemblyChunk)
+    for (int i=assemblyGroups[g]; i<assemblyGroups[g+1]; i++) {
+	theGlobals.install();
+	FE_Element *theFE = theAssemblyFEs[i];
+	const Vector &theResidual = theFE->getResidual(this);
+	int ok;
+	if (assemblyColored)
+	    ok = theSOE->addB(theResidual, theFE->getID());
+	else {
+#pragma omp critical (IncrementalIntegrator_SOE)
+	    ok = theSOE->addB(theResidual, theFE->getID());
+	}
+	if (ok < 0)
+	    numFailed++;
+    }
+    }
+
+    if (numFailed != 0) {
+	opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+	opserr << " failed in addB for " << numFailed << " FE_Elements\n";
+	res = -2;
+    }
+
     return res;	    
 }
 
+
+int
+IncrementalIntegrator::formElementTangent(void)
+{
+    // loop through the FE_Elements adding their contributions to the tangent
+    FE_Element *elePtr;
+
+    int res = 0;
+    beginHandlerTangent(theAnalysisModel);
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    if (theDomain == 0 || theDomain->getParallelUpdate() == false) {
+
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0)     
+	    if (addTangent(theSOE, elePtr->getTangent(this), elePtr->getID()) < 0) {
+		opserr << "WARNING IncrementalIntegrator::formElementTangent -";
+		opserr << " failed in addA for ID " << elePtr->getID();	    
+		res = -3;
+	    }
+
+	return endHandlerTangent(theAnalysisModel, theSOE, res);
+    }
+
+    if (this->sortFEsForAssembly() < 0)
+	return endHandlerTangent(theAnalysisModel, theSOE, -1);
+
+    // FE_Elements that are not thread safe are added in serial
+    for (int i=numThreadSafeFEs; i<numAssemblyFEs; i++) {
+	elePtr = theAssemblyFEs[i];
+	if (addTangent(theSOE, elePtr->getTangent(this), elePtr->getID()) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementTangent -";
+	    opserr << " failed in addA for ID " << elePtr->getID();	    
+	    res = -3;
+	}
+    }
+
+    // the others are formed concurrently into their own storage, the
+    // addition into the SOE is serialized unless they are colored
+    int numFailed = 0;
+    OPS_ThreadGlobals theGlobals;
+    if (assemblyColored == false && theDomain->getDeterministic() == true) {
+	// formed concurrently and copied, then added in order
+	orderedTangents.resize(numThreadSafeFEs);
+#pragma omp parallel for schedule(dynamic, assemblyChunk)
+	for (int i=0; i<numThreadSafeFEs; i++) {
+	    theGlobals.install();
+	    orderedTangents[i] = theAssemblyFEs[i]->getTangent(this);
+	}
+	for (int i=0; i<numThreadSafeFEs; i++)
+	    if (theSOE->addA(orderedTangents[i], theAssemblyFEs[i]->getID()) < 0)
+		numFailed++;
+    } else
+    for (size_t g=0; g+1<assemblyGroups.size(); g++) {
+#pragma omp parallel for reduction(+:numFailed) schedule(dynamic, assemblyChunk)
+    for (int i=assemblyGroups[g]; i<assemblyGroups[g+1]; i++) {
+	theGlobals.install();
+	FE_Element *theFE = theAssemblyFEs[i];
+	const Matrix &theTangent = theFE->getTangent(this);
+	int ok;
+	if (assemblyColored)
+	    ok = theSOE->addA(theTangent, theFE->getID());
+	else {
+#pragma omp critical (IncrementalIntegrator_SOE)
+	    ok = theSOE->addA(theTangent, theFE->getID());
+	}
+	if (ok < 0)
+	    numFailed++;
+    }
+    }
+
+    if (numFailed != 0) {
+	opserr << "WARNING IncrementalIntegrator::formElementTangent -";
+	opserr << " failed in addA for " << numFailed << " FE_Elements\n";
+	res = -3;
+    }
+
+    return endHandlerTangent(theAnalysisModel, theSOE, res);
+}
+
+
+// adds the residual & the tangent of each FE_Element into the SOE, the
+// element's state is still in cache when the tangent follows the residual
+int
+IncrementalIntegrator::formElementResidualAndTangent(void)
+{
+    FE_Element *elePtr;
+
+    int res = 0;
+    beginHandlerTangent(theAnalysisModel);
+
+    Domain *theDomain = theAnalysisModel->getDomainPtr();
+    if (theDomain == 0 || theDomain->getParallelUpdate() == false) {
+
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0) {
+	    if (addResidual(theSOE, elePtr->getResidual(this), elePtr->getID()) <0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidualAndTangent -";
+		opserr << " failed in addB for ID " << elePtr->getID();
+		res = -2;
+	    }
+	    if (addTangent(theSOE, elePtr->getTangent(this), elePtr->getID()) < 0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidualAndTangent -";
+		opserr << " failed in addA for ID " << elePtr->getID();	    
+		res = -3;
+	    }
+	}
+
+	return endHandlerTangent(theAnalysisModel, theSOE, res);
+    }
+
+    if (this->sortFEsForAssembly() < 0)
+	return endHandlerTangent(theAnalysisModel, theSOE, -1);
+
+    // FE_Elements that are not thread safe are added in serial
+    for (int i=numThreadSafeFEs; i<numAssemblyFEs; i++) {
+	elePtr = theAssemblyFEs[i];
+	if (addResidual(theSOE, elePtr->getResidual(this), elePtr->getID()) <0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementResidualAndTangent -";
+	    opserr << " failed in addB for ID " << elePtr->getID();
+	    res = -2;
+	}
+	if (addTangent(theSOE, elePtr->getTangent(this), elePtr->getID()) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementResidualAndTangent -";
+	    opserr << " failed in addA for ID " << elePtr->getID();	    
+	    res = -3;
+	}
+    }
+
+    // the others are formed concurrently into their own storage, the
+    // addition into the SOE is serialized unless they are colored
+    int numFailed = 0;
+    OPS_ThreadGlobals theGlobals;
+    if (assemblyColored == false && theDomain->getDeterministic() == true) {
+	// formed concurrently and copied, then added in order
+	orderedResiduals.resize(numThreadSafeFEs);
+	orderedTangents.resize(numThreadSafeFEs);
+#pragma omp parallel for schedule(dynamic, assemblyChunk)
+	for (int i=0; i<numThreadSafeFEs; i++) {
+	    theGlobals.install();
+	    orderedResiduals[i] = theAssemblyFEs[i]->getResidual(this);
+	    orderedTangents[i] = theAssemblyFEs[i]->getTangent(this);
+	}
+	for (int i=0; i<numThreadSafeFEs; i++) {
+	    const ID &theID = theAssemblyFEs[i]->getID();
+	    if (theSOE->addB(orderedResiduals[i], theID) < 0 ||
+		theSOE->addA(orderedTangents[i], theID) < 0)
+		numFailed++;
+	}
+    } else
+    for (size_t g=0; g+1<assemblyGroups.size(); g++) {
+#pragma omp parallel for reduction(+:numFailed) schedule(dynamic, assemblyChunk)
+    for (int i=assemblyGroups[g]; i<assemblyGroups[g+1]; i++) {
+	theGlobals.install();
+	FE_Element *theFE = theAssemblyFEs[i];
+	const Vector &theResidual = theFE->getResidual(this);
+	const Matrix &theTangent = theFE->getTangent(this);
+	int ok;
+	if (assemblyColored) {
+	  ok = theSOE->addB(theResidual, theFE->getID());
+	  if (ok == 0)
+	    ok = theSOE->addA(theTangent, theFE->getID());
+	} else {
+#pragma omp critical (IncrementalIntegrator_SOE)
+	{
+	  ok = theSOE->addB(theResidual, theFE->getID());
+	  if (ok == 0)
+	    ok = theSOE->addA(theTangent, theFE->getID());
+	}
+	}
+	if (ok < 0)
+	    numFailed++;
+    }
+    }
+
+    if (numFailed != 0) {
+	opserr << "WARNING IncrementalIntegrator::formElementResidualAndTangent -";
+	opserr << " failed in addB or addA for " << numFailed << " FE_Elements\n";
+	res = -3;
+    }
+
+    return endHandlerTangent(theAnalysisModel, theSOE, res);
+}
+
+
+int
+IncrementalIntegrator::sortFEsForAssembly(void)
+{
+    // the order is kept until the FE_Elements or their equations change
+    if (assemblyStamp == theAnalysisModel->getStamp() && assemblySOE == theSOE)
+	return 0;
+
+    int numFE = theAnalysisModel->getNumFE_Elements();
+    if (numFE > sizeAssemblyFEs) {
+	if (theAssemblyFEs != 0)
+	    delete [] theAssemblyFEs;
+	theAssemblyFEs = new FE_Element *[numFE];
+	sizeAssemblyFEs = numFE;
+    }
+
+    // thread safe FE_Elements are placed at the front of the array, the
+    // others from the back; the front ones are given their own storage;
+    // a subdomain is a whole condensation, so when one is among them
+    // the FE_Elements are handed to the threads one at a time
+    numThreadSafeFEs = 0;
+    assemblyChunk = 32;
+    int numSerial = 0;
+    FE_Element *elePtr;
+    FE_EleIter &theEles = theAnalysisModel->getFEs();    
+    while ((elePtr = theEles()) != 0 && numThreadSafeFEs + numSerial < numFE) {
+	if (elePtr->isThreadSafe() == true && elePtr->setPrivateStorage() == 0) {
+	    theAssemblyFEs[numThreadSafeFEs++] = elePtr;
+	    Element *theEle = elePtr->getElement();
+	    if (theEle != 0 && theEle->isSubdomain() == true)
+		assemblyChunk = 1;
+	} else
+	    theAssemblyFEs[numFE - 1 - numSerial++] = elePtr;
+    }
+    numAssemblyFEs = numFE;
+
+    // compact if the iterator returned fewer than numFE objects
+    if (numThreadSafeFEs + numSerial < numFE) {
+	for (int i=0; i<numSerial; i++)
+	    theAssemblyFEs[numThreadSafeFEs+i] = theAssemblyFEs[numFE-numSerial+i];
+	numAssemblyFEs = numThreadSafeFEs + numSerial;
+    }
+
+    assemblyGroups.assign(1, 0);
+    assemblyGroups.push_back(numThreadSafeFEs);
+    assemblyColored = false;
+
+    // color the thread safe FE_Elements by the equations they share and
+    // order them color by color, keeping their order within a color
+    int numEqn = theSOE->getNumEqn();
+    if (theSOE->isAddConcurrent() == true && numThreadSafeFEs > 1 && numEqn > 0) {
+	std::vector<int> cliqueStart(numThreadSafeFEs+1, 0);
+	std::vector<int> cliqueEqns;
+	for (int i=0; i<numThreadSafeFEs; i++) {
+	    const ID &theID = theAssemblyFEs[i]->getID();
+	    for (int j=0; j<theID.Size(); j++)
+		cliqueEqns.push_back(theID(j));
+	    cliqueStart[i+1] = int(cliqueEqns.size());
+	}
+
+	std::vector<int> colors;
+	int numColors = GraphColoring::colorCliques(cliqueStart, cliqueEqns, numEqn, colors);
+
+	assemblyGroups.assign(numColors+1, 0);
+	for (int i=0; i<numThreadSafeFEs; i++)
+	    assemblyGroups[colors[i]+1]++;
+	for (int c=0; c<numColors; c++)
+	    assemblyGroups[c+1] += assemblyGroups[c];
+
+	std::vector<FE_Element *> theSafeFEs(theAssemblyFEs, theAssemblyFEs+numThreadSafeFEs);
+	std::vector<int> next(assemblyGroups.begin(), assemblyGroups.end()-1);
+	for (int i=0; i<numThreadSafeFEs; i++)
+	    theAssemblyFEs[next[colors[i]]++] = theSafeFEs[i];
+	assemblyColored = true;
+    }
+
+    assemblyStamp = theAnalysisModel->getStamp();
+    assemblySOE = theSOE;
+
+    return 0;
+}
+
 /*
 int
 IncrementalIntegrator::setModalDampingFactors(const Vector &factors)
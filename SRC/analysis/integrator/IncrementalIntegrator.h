@@ -37,6 +37,9 @@
 // What: "@(#) IncrementalIntegrator.h, revA"
 
 #include <Integrator.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <vector>
 
 class LinearSOE;
 class EigenSOE;
@@ -45,6 +48,7 @@ class ConvergenceTest;
 class FE_Element;
 class DOF_Group;
 class Vector;
+class ID;
 
 #define CURRENT_TANGENT 0
 #define INITIAL_TANGENT 1
@@ -74,6 +78,13 @@ class IncrementalIntegrator : public Integrator
 			     double cFactor);    
     virtual int  formUnbalance(void);
 
+    // forms the unbalance & then the tangent at the current state; here
+    // they are formed as two separate passes, Static & TransientIntegrator
+    // form both in one pass over the FE_Elements & DOF_Groups
+    virtual int  formUnbalanceAndTangent(int statusFlag = CURRENT_TANGENT,
+					 double iFactor = 0.0,
+					 double cFactor = 1.0);
+
     // pure virtual methods to define the FE_ELe and DOF_Group contributions
     virtual int formEleTangent(FE_Element *theEle) =0;
     virtual int formNodTangent(DOF_Group *theDof) =0;    
@@ -92,6 +103,16 @@ class IncrementalIntegrator : public Integrator
     int addModalDampingForce(const Vector *modalDampingValues);
     int addModalDampingMatrix(const Vector *modalDampingValues);
     virtual double getCFactor(void);
+
+    // residual-only evaluation of the trial points of a line search along
+    // dU: between beginReducedUnbalance(), called at the full step, and
+    // endReducedUnbalance() the elements with a constant tangent are not
+    // updated and their part of the unbalance is extrapolated as B1 +
+    // (eta-1)*G, G being its derivative along dU, so that
+    // formTrialUnbalance(eta) only evaluates the other elements
+    int beginReducedUnbalance(const Vector &dU);
+    int formTrialUnbalance(double eta);
+    int endReducedUnbalance(void);
     
     virtual const Vector &getVel(void);
     int doMv(const Vector &v, Vector &res);
@@ -111,10 +132,22 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+    virtual int  formElementTangent(void);
+    int formElementResidualAndTangent(void);
+
+    // the direct differentiation loop over the parameters, the
+    // right-hand sides of a block of parameters are solved together
+    int computeParameterSensitivities(void);
+
     int statusFlag;
     double iFactor;
     double cFactor;
 
+    // incremented whenever the A matrix of the LinearSOE is formed; while
+    // it is unchanged a solution for another right-hand side obtained
+    // with the current factorization is still valid
+    int tangentStamp;
+
     //    Vector *modalDampingValues;
     EigenSOE *theEigenSOE;
     double *eigenVectors;
@@ -131,6 +164,42 @@ class IncrementalIntegrator : public Integrator
     AnalysisModel *theAnalysisModel;
     ConvergenceTest *theTest;
 
+    // FE_Elements ordered for concurrent assembly, the first
+    // numThreadSafeFEs of them are formed in parallel
+    int sortFEsForAssembly(void);
+    FE_Element **theAssemblyFEs;
+    int numAssemblyFEs;
+    int numThreadSafeFEs;
+    int sizeAssemblyFEs;
+    int assemblyChunk;   // 1 when a subdomain is formed in parallel
+
+    // the thread safe FE_Elements are grouped in assemblyGroups; when the
+    // SOE can be added to concurrently they are colored so those of a group
+    // share no equation and are added without a lock, in a fixed order
+    std::vector<int> assemblyGroups;
+    bool assemblyColored;
+    int assemblyStamp;   // AnalysisModel stamp the order was made for
+    LinearSOE *assemblySOE;
+    // deterministic assembly into an SOE that is not colored: the
+    // contributions are formed concurrently and copied here, one for each
+    // thread safe FE_Element, as the FE_Elements of a thread share their
+    // storage; they are then added in order
+    std::vector<Vector> orderedResiduals;
+    std::vector<Matrix> orderedTangents;
+
+    // the reduced unbalance of the line search trial points: the FE_Elements
+    // evaluated at each point, the constant tangent ones, and the linear
+    // part B1 + (eta-1)*G of the unbalance they give
+    bool reducedActive;
+    bool reducedUsed;
+    double reducedEta;
+    double reducedTime;
+    std::vector<FE_Element *> reducedFEs;
+    std::vector<FE_Element *> linearFEs;
+    Vector *linearB1;
+    Vector *linearG;
+    Vector *linearB;
+    ID *linearID;
 };
 
 #endif
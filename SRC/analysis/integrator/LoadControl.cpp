@@ -98,6 +98,7 @@ LoadControl::LoadControl(double dLambda, int numIncr, double min, double max, in
     specNumIncrStep = 1.0;
     numIncrLastStep = 1.0;
   }
+  fixedStep = false;
 }
 
 
@@ -116,13 +117,17 @@ LoadControl::newStep(void)
     }
 
     // determine delta lambda for this step based on dLambda and #iter of last step
-    double factor = specNumIncrStep/numIncrLastStep;
-    deltaLambda *=factor;
-
-    if (deltaLambda < dLambdaMin)
-      deltaLambda = dLambdaMin;
-    else if (deltaLambda > dLambdaMax)
-      deltaLambda = dLambdaMax;
+    if (fixedStep == true)
+      fixedStep = false;
+    else {
+      double factor = specNumIncrStep/numIncrLastStep;
+      deltaLambda *=factor;
+
+      if (deltaLambda < dLambdaMin)
+	deltaLambda = dLambdaMin;
+      else if (deltaLambda > dLambdaMax)
+	deltaLambda = dLambdaMax;
+    }
     
     double currentLambda = theModel->getCurrentDomainTime();
 
@@ -169,6 +174,29 @@ LoadControl::setDeltaLambda(double newValue)
   return 0;
 }
 
+double
+LoadControl::getStepSize(void)
+{
+  return deltaLambda;
+}
+
+// unlike setDeltaLambda() a fixed next step is not held to dLambdaMin/Max
+int
+LoadControl::setStepSize(double newValue, bool fixed)
+{
+  if (fixed == true)
+    numIncrLastStep = specNumIncrStep;
+  deltaLambda = newValue;
+  fixedStep = fixed;
+  return 0;
+}
+
+bool
+LoadControl::isStepSizeFixed(void)
+{
+  return fixedStep;
+}
+
 
 int
 LoadControl::sendSelf(int cTag,
@@ -349,91 +377,6 @@ return false;
 int 
 LoadControl::computeSensitivities(void)
 {
-//  opserr<<" computeSensitivity::start"<<endln; 
-    LinearSOE *theSOE = this->getLinearSOE();
-
-    /*
-  if (theAlgorithm == 0) {
-    opserr << "ERROR the FE algorithm must be defined before ";
-    opserr << "the sensitivity algorithm\n";
-    return -1;
-  }
-*/
-/*
-   // Get pointer to the system of equations (SOE)
-	LinearSOE *theSOE = theAlgorithm->getLinearSOEptr();
-	if (theSOE == 0) {
-	  opserr << "ERROR the FE linearSOE must be defined before ";
-	  opserr << "the sensitivity algorithm\n";
-	  return -1;
-	}
-
-	// Get pointer to incremental integrator
-	IncrementalIntegrator *theIncInt = theAlgorithm->getIncrementalIntegratorPtr();
-//	IncrementalIntegrator *theIncIntSens=theAlgorithm->getIncrementalIntegratorPtr();//Abbas
-	if (theIncInt == 0 ) {
-	  opserr << "ERROR the FE integrator must be defined before ";
-	  opserr << "the sensitivity algorithm\n";
-	  return -1;
-	}
-
-	// Form current tangent at converged state
-	// (would be nice with an if-statement here in case
-	// the current tangent is already formed)
-	if (this->formTangent(CURRENT_TANGENT) < 0){
-		opserr << "WARNING SensitivityAlgorithm::computeGradients() -";
-		opserr << "the Integrator failed in formTangent()\n";
-		return -1;
-	}
-	*/
-	// Zero out the old right-hand side of the SOE
-	theSOE->zeroB();
-
-	// Form the part of the RHS which are independent of parameter
-	this->formIndependentSensitivityRHS();
-	AnalysisModel *theModel = this->getAnalysisModel();  
-	Domain *theDomain=theModel->getDomainPtr();
-	ParameterIter &paramIter = theDomain->getParameters();
-	
-	Parameter *theParam;
-	// De-activate all parameters
-	while ((theParam = paramIter()) != 0)
-	  theParam->activate(false);
-	
-	// Now, compute sensitivity wrt each parameter
-	int numGrads = theDomain->getNumParameters();
-	paramIter = theDomain->getParameters();
-	
-	while ((theParam = paramIter()) != 0) {
-
-	  // Activate this parameter
-	  theParam->activate(true);
-
-	  // Zero the RHS vector
-	  theSOE->zeroB();
-
-	  // Get the grad index for this parameter
-	  int gradIndex = theParam->getGradIndex();
-
-	  // Form the RHS
-	  this->formSensitivityRHS(gradIndex);
-         
-	  // Solve for displacement sensitivity
-	 
-	  theSOE->solve();
-	  // Save sensitivity to nodes
-	  this->saveSensitivity( theSOE->getX(), gradIndex, numGrads );
-	 
-
-
-	  // Commit unconditional history variables (also for elastic problems; strain sens may be needed anyway)
-	  this->commitSensitivity(gradIndex, numGrads);
-	  
-	  // De-activate this parameter for next sensitivity calc
-	  theParam->activate(false);
-	//  opserr<<"LoadControl::..........ComputeSensitivities. end"<<endln;
-	}
-
-	return 0;
+    return this->computeParameterSensitivities();
 }
 
@@ -60,6 +60,10 @@ class LoadControl : public StaticIntegrator
     int update(const Vector &deltaU);
     int setDeltaLambda(double newDeltaLambda);
 
+    double getStepSize(void);
+    int setStepSize(double newSize, bool fixed = true);
+    bool isStepSizeFixed(void);
+
     // Public methods for Output
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -94,6 +98,8 @@ protected:
    // EquiSolnAlgo *theAlgorithm;
     ReliabilityDomain *theDomain;
     ////////////////////
+
+    bool fixedStep;      // the next step uses deltaLambda as it is
 };
 
 #endif
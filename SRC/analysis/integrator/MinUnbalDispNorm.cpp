@@ -118,6 +118,8 @@ MinUnbalDispNorm::MinUnbalDispNorm(double lambda1, int specNumIter,
     specNumIncrStep = 1.0;
     numIncrLastStep = 1.0;
   }
+
+  dUhatStamp = -1;
 }
 
 MinUnbalDispNorm::~MinUnbalDispNorm()
@@ -178,6 +180,7 @@ MinUnbalDispNorm::newStep(void)
       return -1;
     }
     (*deltaUhat) = theLinSOE->getX();
+    dUhatStamp = tangentStamp;
     Vector &dUhat = *deltaUhat;
 
     // determine delta lambda(1) == dlambda
@@ -305,10 +308,14 @@ MinUnbalDispNorm::update(const Vector &dU)
 
     (*deltaUbar) = dU; // have to do this as the SOE is gonna change
 
-    // determine dUhat    
-    theLinSOE->setB(*phat);
-    theLinSOE->solve();
-    (*deltaUhat) = theLinSOE->getX();    
+    // determine dUhat; it is still K^-1 phat if no tangent has been
+    // formed since it was last solved for, e.g. modified Newton
+    if (dUhatStamp != tangentStamp) {
+      theLinSOE->setB(*phat);
+      theLinSOE->solve();
+      (*deltaUhat) = theLinSOE->getX();
+      dUhatStamp = tangentStamp;
+    }
 
     // determine delta lambda(i)
     double a = (*deltaUhat)^(*deltaUbar);
@@ -510,6 +517,7 @@ MinUnbalDispNorm::domainChanged(void)
     theModel->applyLoadDomain(currentLambda);    
     this->formUnbalance(); // NOTE: this assumes unbalance at last was 0
     (*phat) = theLinSOE->getB();
+    dUhatStamp = -1;
     currentLambda -= 1.0;
     theModel->setCurrentDomainTime(currentLambda);    
 
@@ -130,6 +130,7 @@ class MinUnbalDispNorm : public StaticIntegrator
       int sensitivityFlag;
       FE_Element *theEle;
 
+      int dUhatStamp;      // tangent stamp deltaUhat was solved at
 };
 
 #endif
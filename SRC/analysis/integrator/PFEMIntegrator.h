@@ -58,6 +58,9 @@ public:
     int formEleResidual(FE_Element* theEle);
     int formNodUnbalance(DOF_Group* theDof);
     int formTangent(int statFlag);
+    // formed in separate passes, this class has its own formTangent()
+    int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT, double iFact = 0.0, double cFact = 1.0)
+      {return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag, iFact, cFact);};
 
     int domainChanged(void);
     int newStep(double deltaT);
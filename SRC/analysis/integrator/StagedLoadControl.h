@@ -58,6 +58,9 @@ public:
 
 
     int  formTangent(int statusFlag = CURRENT_TANGENT);
+    // formed in separate passes, this class has its own formTangent()
+    int formUnbalanceAndTangent(int statFlag = CURRENT_TANGENT, double iFact = 0.0, double cFact = 1.0)
+      {return this->IncrementalIntegrator::formUnbalanceAndTangent(statFlag, iFact, cFact);};
 
 
 };
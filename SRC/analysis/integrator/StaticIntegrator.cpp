@@ -53,6 +53,7 @@
 #include <DOF_GrpIter.h>
 #include <LoadPattern.h>
 #include <LoadPatternIter.h>
+#include <AnalysisProfiler.h>
 
 StaticIntegrator::StaticIntegrator(int clasTag)
  :IncrementalIntegrator(clasTag)
@@ -65,6 +66,46 @@ StaticIntegrator::~StaticIntegrator()
 {
 }
 
+// one pass over the FE_Elements adds both the residual & the tangent,
+// the DOF_Groups only add their unbalance in a static analysis
+int
+StaticIntegrator::formUnbalanceAndTangent(int statFlag, double iFact, double cFact)
+{
+    // formed together, counted as tangent formation
+    ProfilePhase phase(AnalysisProfiler::TangentFormation);
+
+    statusFlag = statFlag;
+    iFactor = iFact;
+    cFactor = cFact;
+
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theLinSOE == 0 || theModel == 0) {
+	opserr << "WARNING StaticIntegrator::formUnbalanceAndTangent() -";
+	opserr << " no AnalysisModel or LinearSOE have been set\n";
+	return -1;
+    }
+
+    theLinSOE->zeroA();
+    theLinSOE->zeroB();
+    tangentStamp++;
+
+    int res = this->formElementResidualAndTangent();
+    if (res < 0) {
+	opserr << "WARNING StaticIntegrator::formUnbalanceAndTangent() -";
+	opserr << " this->formElementResidualAndTangent failed\n";
+	return res;
+    }
+
+    if (this->formNodalUnbalance() < 0) {
+	opserr << "WARNING StaticIntegrator::formUnbalanceAndTangent() -";
+	opserr << " this->formNodalUnbalance failed\n";
+	return -2;
+    }
+
+    return 0;
+}
+
 int
 StaticIntegrator::formEleTangent(FE_Element *theEle)
 {
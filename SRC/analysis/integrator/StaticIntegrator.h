@@ -54,6 +54,10 @@ class StaticIntegrator : public IncrementalIntegrator
 
     virtual ~StaticIntegrator();
 
+    virtual int formUnbalanceAndTangent(int statusFlag = CURRENT_TANGENT,
+					double iFactor = 0.0,
+					double cFactor = 1.0);
+
     // methods which define what the FE_Element and DOF_Groups add
     // to the system of equation object.
     virtual int formEleTangent(FE_Element *theEle);
@@ -64,6 +68,14 @@ class StaticIntegrator : public IncrementalIntegrator
    
    virtual int newStep(void) =0;    
 
+   // the increment of the next step, used to substep a failed one; an
+   // integrator that can not be substepped returns 0.0 & -1. With fixed
+   // the next step takes newSize as it is, otherwise it adapts it from
+   // the iterations of the last step as usual
+   virtual double getStepSize(void) {return 0.0;}
+   virtual int setStepSize(double newSize, bool fixed = true) {return -1;}
+   virtual bool isStepSizeFixed(void) {return false;}
+
   protected:
 
  
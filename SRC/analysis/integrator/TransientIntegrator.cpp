@@ -44,6 +44,8 @@
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
+#include <AnalysisProfiler.h>
+#include <math.h>
 
 TransientIntegrator::TransientIntegrator(int clasTag)
 :IncrementalIntegrator(clasTag)
@@ -67,6 +69,7 @@ TransientIntegrator::formTangent(int statFlag, double iFact, double cFact)
 int 
 TransientIntegrator::formTangent(int statFlag)
 {
+    ProfilePhase phase(AnalysisProfiler::TangentFormation);
     int result = 0;
     statusFlag = statFlag;
 
@@ -82,6 +85,7 @@ TransientIntegrator::formTangent(int statFlag)
     // efficiency when performing parallel computations
     
     theLinSOE->zeroA();
+    tangentStamp++;
 
     // do modal damping
     bool inclModalMatrix=theModel->inclModalDampingMatrix();
@@ -105,14 +109,11 @@ TransientIntegrator::formTangent(int statFlag)
     }    
 
     // loop through the FE_Elements getting them to add the tangent    
-    FE_EleIter &theEles2 = theModel->getFEs();    
-    FE_Element *elePtr;    
-    while((elePtr = theEles2()) != 0)     {
-	if (theLinSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
-	    opserr << "TransientIntegrator::formTangent() - failed to addA:ele\n";
-	    result = -2;
-	}
+    if (this->formElementTangent() < 0) {
+	opserr << "TransientIntegrator::formTangent() - failed to addA:ele\n";
+	result = -2;
     }
+
     return result;
 }
 
@@ -152,6 +153,61 @@ TransientIntegrator::formUnbalance(void) {
     return 0;
 }
     
+// the unbalance & the tangent in one pass over the DOF_Groups and one
+// over the FE_Elements, each object adding both before the next is visited
+int
+TransientIntegrator::formUnbalanceAndTangent(int statFlag, double iFact, double cFact)
+{
+    // formed together, counted as tangent formation
+    ProfilePhase phase(AnalysisProfiler::TangentFormation);
+    statusFlag = statFlag;
+    iFactor = iFact;
+    cFactor = cFact;
+
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theLinSOE == 0 || theModel == 0) {
+	opserr << "WARNING TransientIntegrator::formUnbalanceAndTangent() ";
+	opserr << "no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+
+    theLinSOE->zeroA();
+    theLinSOE->zeroB();
+    tangentStamp++;
+
+    // do modal damping
+    const Vector *modalValues = theModel->getModalDampingFactors();
+    if (modalValues != 0) {
+      this->addModalDampingForce(modalValues);
+      if (theModel->inclModalDampingMatrix() == true)
+	this->addModalDampingMatrix(modalValues);
+    }
+
+    int result = 0;
+
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0) {
+	if (theLinSOE->addA(dofPtr->getTangent(this),dofPtr->getID()) <0) {
+	    opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to addA:dof\n";
+	    result = -1;
+	}
+	if (theLinSOE->addB(dofPtr->getUnbalance(this),dofPtr->getID()) <0) {
+	    opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to addB:dof\n";
+	    result = -1;
+	}
+    }
+
+    if (this->formElementResidualAndTangent() < 0) {
+	opserr << "TransientIntegrator::formUnbalanceAndTangent() - failed to add:ele\n";
+	result = -2;
+    }
+
+    return result;
+}
+
+
 int
 TransientIntegrator::formEleResidual(FE_Element *theEle)
 {
@@ -170,3 +226,30 @@ TransientIntegrator::formNodUnbalance(DOF_Group *theDof)
 
 
 
+
+int
+TransientIntegrator::estimateLocalError(double deltaT, double &errNorm, double &dispNorm)
+{
+  errNorm = 0.0;
+  dispNorm = 0.0;
+  return -1;
+}
+
+double
+TransientIntegrator::accelJumpError(double coef, double deltaT,
+				    const Vector &accel, const Vector &accelCommitted)
+{
+  int size = accel.Size();
+  if (accelCommitted.Size() != size)
+    return 0.0;
+
+  double sum = 0.0;
+  for (int i = 0; i < size; i++) {
+    double da = accel(i) - accelCommitted(i);
+    sum += da*da;
+  }
+
+  if (coef < 0.0)
+    coef = -coef;
+  return coef*deltaT*deltaT*sqrt(sum);
+}
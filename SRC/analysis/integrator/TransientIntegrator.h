@@ -59,6 +59,9 @@ class TransientIntegrator : public IncrementalIntegrator
 			    double cFactor);    
 
     virtual int formUnbalance(void);
+    virtual int formUnbalanceAndTangent(int statusFlag = CURRENT_TANGENT,
+					double iFactor = 0.0,
+					double cFactor = 1.0);
     virtual int formEleResidual(FE_Element *theEle);
     virtual int formNodUnbalance(DOF_Group *theDof);    
 
@@ -66,7 +69,15 @@ class TransientIntegrator : public IncrementalIntegrator
     
     virtual int initialize(void) {return 0;};
 
+    // estimate of the local error in the displacements of the step just
+    // solved with deltaT, returns -1 if the scheme does not provide one
+    virtual int estimateLocalError(double deltaT, double &errNorm, double &dispNorm);
+
   protected:
+    // norm of coef*deltaT^2*(accel - accelCommitted), the estimate of
+    // Zienkiewicz & Xie for the Newmark family of methods
+    static double accelJumpError(double coef, double deltaT,
+				 const Vector &accel, const Vector &accelCommitted);
     
   private:
 };
@@ -56,6 +56,9 @@
 #define START_EQN_NUM 0
 #define START_VERTEX_NUM 0
 
+// stamps are unique over all the AnalysisModel objects
+static int nextStamp = 0;
+
 //  AnalysisModel();
 //	constructor
 
@@ -63,7 +66,7 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), theStamp(++nextStamp)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +80,7 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), theStamp(++nextStamp)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +93,7 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), theStamp(++nextStamp)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -159,6 +162,7 @@ AnalysisModel::addFE_Element(FE_Element *theElement)
   if (result == true) {
     theElement->setAnalysisModel(*this);
     numFE_Ele++;
+    theStamp = ++nextStamp;
     return true;  // o.k.
   } else
     return false;
@@ -170,6 +174,29 @@ AnalysisModel::addFE_Element(FE_Element *theElement)
 
 
 
+// FE_Element *removeFE_Element(int tag);
+//	Method to remove an element from the model, the caller is left
+//	to delete it. The DOF graphs, if built, are no longer valid.
+
+FE_Element *
+AnalysisModel::removeFE_Element(int tag)
+{
+  if (theFEs == 0)
+    return 0;
+
+  TaggedObject *mc = theFEs->removeComponent(tag);
+  if (mc == 0)
+    return 0;
+
+  numFE_Ele--;
+  theStamp = ++nextStamp;
+  this->clearDOFGraph();
+  this->clearDOFGroupGraph();
+
+  return (FE_Element *)mc;
+}
+
+
 // void addDOF_Group(DOF_Group *);
 //	Method to add an element to the model.
 
@@ -219,6 +246,7 @@ AnalysisModel::clearAll(void)
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    theStamp = ++nextStamp;
 }
 
 void
@@ -249,6 +277,13 @@ AnalysisModel::getNumDOF_Groups(void) const
 }
 
 
+int
+AnalysisModel::getNumFE_Elements(void) const
+{
+  return numFE_Ele;
+}
+
+
 DOF_Group *
 AnalysisModel::getDOF_GroupPtr(int tag)
 {
@@ -279,6 +314,7 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+    theStamp = ++nextStamp;
 }
 
 int 
@@ -439,11 +475,8 @@ AnalysisModel::setResponse(const Vector &disp,
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
-    while ((dofPtr = theDOFGrps()) != 0) {
-	dofPtr->setNodeDisp(disp);
-	dofPtr->setNodeVel(vel);
-	dofPtr->setNodeAccel(accel);	
-    }
+    while ((dofPtr = theDOFGrps()) != 0)
+	dofPtr->setNodeResponse(disp, vel, accel);
 }	
 	
 void 
@@ -733,6 +766,13 @@ AnalysisModel::getDomainPtr(void) const
 }
 
 
+ConstraintHandler *
+AnalysisModel::getHandlerPtr(void) const
+{
+    return myHandler;
+}
+
+
 int
 AnalysisModel::sendSelf(int cTag, Channel &theChannel)
 {
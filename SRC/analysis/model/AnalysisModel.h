@@ -64,12 +64,14 @@ class AnalysisModel: public MovableObject
     // methods to populate/depopulate the AnalysisModel
     virtual bool addFE_Element(FE_Element *theFE_Ele);
     virtual bool addDOF_Group(DOF_Group *theDOF_Grp);
+    virtual FE_Element *removeFE_Element(int tag);
     virtual void clearAll(void);
     virtual void clearDOFGraph(void);
     virtual void clearDOFGroupGraph(void);
     
     // methods to access the FE_Elements and DOF_Groups and their numbers
     virtual int getNumDOF_Groups(void) const;		
+    virtual int getNumFE_Elements(void) const;
     virtual DOF_Group *getDOF_GroupPtr(int tag);	
     virtual FE_EleIter &getFEs();
     virtual DOF_GrpIter &getDOFs();
@@ -77,6 +79,10 @@ class AnalysisModel: public MovableObject
     // method to access the connectivity for SysOfEqn to size itself
     virtual void setNumEqn(int) ;	
     virtual int getNumEqn(void) const ; 
+
+    // changes whenever FE_Elements are added or removed or the equations
+    // are numbered, for what is kept from one assembly to the next
+    int getStamp(void) const {return theStamp;};
     virtual Graph &getDOFGraph(void);
     virtual Graph &getDOFGroupGraph(void);
     
@@ -120,6 +126,7 @@ class AnalysisModel: public MovableObject
 			 FEM_ObjectBroker &theBroker);
 
     Domain *getDomainPtr(void) const;
+    ConstraintHandler *getHandlerPtr(void) const;
 
   protected:
 
@@ -134,6 +141,7 @@ class AnalysisModel: public MovableObject
     int numFE_Ele;             // number of FE_Elements objects added
     int numDOF_Grp;            // number of DOF_Group objects added
     int numEqn;                // numEqn set by the ConstraintHandler typically
+    int theStamp;
 
     TaggedObjectStorage  *theFEs;
     TaggedObjectStorage  *theDOFs;
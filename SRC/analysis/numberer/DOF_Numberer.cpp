@@ -410,6 +410,16 @@ DOF_Numberer::getAnalysisModelPtr(void) const
 }
 
 
+// returns true if the equation numbers are in a fill-reducing order, as
+// they are when the GraphNumberer is one, e.g. AMD or NestedDissection
+bool
+DOF_Numberer::isFillReducing(void)
+{
+    if (theGraphNumberer == 0)
+	return false;
+    return theGraphNumberer->isFillReducing();
+}
+
 GraphNumberer *
 DOF_Numberer::getGraphNumbererPtr(void) const
 {
@@ -59,6 +59,7 @@ class DOF_Numberer: public MovableObject
     // pure virtual functions
     virtual int numberDOF(int lastDOF_Group = -1);
     virtual int numberDOF(ID &lastDOF_Groups);    
+    virtual bool isFillReducing(void);
 
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, 
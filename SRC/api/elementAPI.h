@@ -57,6 +57,14 @@ typedef struct modState modelState;
 
 typedef void (*matFunct)(struct matObject*, modelState*, double* strain, double* tang, double* stress, int* isw, int* error);
 
+// version 2 of the material interface adds an optional batched entry
+// point, exported by a library as <name>_batch next to <name>: it is
+// invoked with the isw of matFunct on n materials of that function, with
+// strain[i], tang[i] and stress[i] pointing to the arrays of material i
+#define OPS_MATERIAL_API_VERSION 2
+
+typedef void (*matBatchFunct)(int n, struct matObject** mats, modelState*, double** strain, double** tang, double** stress, int* isw, int* error);
+
 struct matObject {
     int tag;
     int matType;
@@ -67,6 +75,7 @@ struct matObject {
     double* tState;
     matFunct matFunctPtr;
     void* matObjectPtr;
+    matBatchFunct matBatchFunctPtr;  // 0 if the library has no batched entry
 };
 
 typedef struct matObject matObj;
@@ -129,6 +138,7 @@ class ConvergenceTest;
 #define OPS_SetDoubleListsOutput ops_setdoublelistsoutput_
 #define OPS_SetDoubleDictOutput ops_setdoubledictoutput_
 #define OPS_SetDoubleDictListOutput ops_setdoubledictlistoutput_
+#define OPS_SetDoubleArrayOutput ops_setdoublearrayoutput_
 #define OPS_AllocateMaterial ops_allocatematerial_
 #define OPS_AllocateElement ops_allocateelement_
 #define OPS_GetMaterialType ops_getmaterialtype_
@@ -203,6 +213,7 @@ extern "C" int         OPS_SetDoubleOutput(int* numData, double* data, bool scal
 extern "C" int         OPS_SetDoubleListsOutput(std::vector<std::vector<double>>& data);
 extern "C" int         OPS_SetDoubleDictOutput(std::map<const char*, double>& data);
 extern "C" int         OPS_SetDoubleDictListOutput(std::map<const char*, std::vector<double>>& data);
+extern "C" int         OPS_SetDoubleArrayOutput(int numRows, int numCols, double* data); // row major, numCols 0 for a vector
 extern "C" const char* OPS_GetString(); // does a strcpy
 extern "C" const char* OPS_GetStringFromAll(char* buffer, int len); // does a strcpy
 extern "C" int         OPS_SetString(const char* str);
@@ -57,6 +57,7 @@ typedef struct elementFunction {
 typedef struct materialFunction {
   char *funcName;
   matFunct theFunct; 
+  matBatchFunct theBatchFunct;
   struct materialFunction *next;
 } MaterialFunction;
 
@@ -195,6 +196,7 @@ matObj *OPS_GetMaterial(int *matTag, int *matType)
       theMatObject->tState = 0;
       theMatObject->cState = 0;
       theMatObject->matFunctPtr = OPS_InvokeMaterialObject;
+      theMatObject->matBatchFunctPtr = 0;
 
       theMatObject->matObjectPtr = theCopy;
       
@@ -316,6 +318,7 @@ matObj *OPS_GetMaterialType(char *type, int sizeType) {
       
       matObj *theMatObject = new matObj;
       theMatObject->matFunctPtr = matFunction->theFunct;
+      theMatObject->matBatchFunctPtr = matFunction->theBatchFunct;
       /* opserr << "matObj *OPS_GetMaterialType() - FOUND " << endln;  */
       return theMatObject;
     }
@@ -60,6 +60,7 @@ typedef struct elementFunction {
 typedef struct materialFunction {
     char* funcName;
     matFunct theFunct;
+    matBatchFunct theBatchFunct;
     struct materialFunction* next;
 } MaterialFunction;
 
@@ -627,6 +628,7 @@ matObj * OPS_GetMaterial(int* matTag, int* matType)
             theMatObject->tState = 0;
             theMatObject->cState = 0;
             theMatObject->matFunctPtr = OPS_InvokeMaterialObject;
+            theMatObject->matBatchFunctPtr = 0;
 
             theMatObject->matObjectPtr = theCopy;
 
@@ -772,6 +774,7 @@ matObj * OPS_GetMaterialType(char* type, int sizeType) {
 
             matObj* theMatObject = new matObj;
             theMatObject->matFunctPtr = matFunction->theFunct;
+            theMatObject->matBatchFunctPtr = matFunction->theBatchFunct;
             /* opserr << "matObj *OPS_GetMaterialType() - FOUND " << endln;  */
             return theMatObject;
         }
@@ -794,6 +797,16 @@ matObj * OPS_GetMaterialType(char* type, int sizeType) {
         matFunction = new MaterialFunction;
         matFunction->theFunct = matFunctPtr;
         matFunction->funcName = funcName;
+
+        // and its batched version, if the library has one
+        matBatchFunct matBatchFunctPtr = 0;
+        char* batchName = new char[strlen(type) + 7];
+        strcpy(batchName, type);
+        strcat(batchName, "_batch");
+        if (getLibraryFunction(type, batchName, &libHandle, (void**)&matBatchFunctPtr) != 0)
+            matBatchFunctPtr = 0;
+        delete[] batchName;
+        matFunction->theBatchFunct = matBatchFunctPtr;
         matFunction->next = theMaterialFunctions;
         theMaterialFunctions = matFunction;
 
@@ -803,6 +816,7 @@ matObj * OPS_GetMaterialType(char* type, int sizeType) {
         //eleObj *theEleObject = (eleObj *)malloc(sizeof( eleObj));;      
 
         theMatObject->matFunctPtr = matFunction->theFunct;
+        theMatObject->matBatchFunctPtr = matFunction->theBatchFunct;
 
         //    fprintf(stderr,"getMaterial Address %p\n",theMatObject);
 
@@ -51,12 +51,14 @@
 #define EigenSOE_TAGS_FullGenEigenSOE   4
 #define EigenSOE_TAGS_ArpackSOE 	5
 #define EigenSOE_TAGS_GeneralArpackSOE 	6
+#define EigenSOE_TAGS_DampedArpackSOE 	7
 #define EigenSOLVER_TAGS_BandArpackSolver 	1
 #define EigenSOLVER_TAGS_SymArpackSolver 	2
 #define EigenSOLVER_TAGS_SymBandEigenSolver     3
 #define EigenSOLVER_TAGS_FullGenEigenSolver  4
 #define EigenSOLVER_TAGS_ArpackSolver  5
 #define EigenSOLVER_TAGS_GeneralArpackSolver  6
+#define EigenSOLVER_TAGS_DampedArpackSolver  7
 
 #define EigenALGORITHM_TAGS_Frequency 1
 #define EigenALGORITHM_TAGS_Standard  2
@@ -899,6 +901,8 @@
 #define ELE_TAG_Pipe                      269
 #define ELE_TAG_CurvedPipe                      270
 #define ELE_TAG_PML3DVISCOUS               271 // Amin Pakzad
+#define ELE_TAG_SuperElement               272
+#define ELE_TAG_UserBatchElement           273
 
 
 #define FRN_TAG_Coulomb            1
@@ -1006,6 +1010,7 @@
 #define GraphNUMBERER_TAG_MyRCM   		3
 #define GraphNUMBERER_TAG_Metis   		4
 #define GraphNUMBERER_TAG_AMD   		5
+#define GraphNUMBERER_TAG_NestedDissection	6
 
 
 #define AnaMODEL_TAGS_AnalysisModel 	1
@@ -1026,6 +1031,7 @@
 #define EquiALGORITHM_TAGS_ElasticAlgorithm 14
 #define EquiALGORITHM_TAGS_NewtonHallM 15
 #define EquiALGORITHM_TAGS_ExpressNewton 16
+#define EquiALGORITHM_TAGS_AdaptiveNewton 17
 
 #define ACCELERATOR_TAGS_Krylov		1
 #define ACCELERATOR_TAGS_Secant		2
@@ -1101,6 +1107,7 @@
 #define INTEGRATOR_TAGS_StagedLoadControl               58
 #define INTEGRATOR_TAGS_StagedNewmark                   59
 #define INTEGRATOR_TAGS_HarmonicSteadyState             60
+#define INTEGRATOR_TAGS_ImplicitExplicit                61
 
 
 #define LinSOE_TAGS_FullGenLinSOE		1
@@ -1133,6 +1140,10 @@
 #define LinSOE_TAGS_PFEMCompressibleLinSOE 28
 #define LinSOE_TAGS_PFEMQuasiLinSOE 29
 #define LinSOE_TAGS_PFEMDiaLinSOE 30
+#define LinSOE_TAGS_SparseSPDLinSOE 31
+#define LinSOE_TAGS_MatrixFreeLinSOE 32
+#define LinSOE_TAGS_AutoLinearSOE 33
+#define LinSOE_TAGS_BlockSparseLinSOE 34
 #define LinSOE_TAGS_PARDISOGenLinSOE 99990
 
 
@@ -1169,6 +1180,11 @@
 #define SOLVER_TAGS_CuSP                                31
 #define SOLVER_TAGS_PFEMQuasiSolver                     32
 #define SOLVER_TAGS_PFEMDiaSolver                       33
+#define SOLVER_TAGS_SparseSPDLinSolver                  34
+#define SOLVER_TAGS_CuDSSSolver                         35
+#define SOLVER_TAGS_SparseKrylovSolver                  36
+#define SOLVER_TAGS_MatrixFreeLinSolver                 37
+#define SOLVER_TAGS_BlockSparseLinSolver                38
 
 #define RECORDER_TAGS_ElementRecorder		1
 #define RECORDER_TAGS_NodeRecorder		2
@@ -1195,6 +1211,9 @@
 #define RECORDER_TAGS_NodeRecorderRMS               23
 #define RECORDER_TAGS_ElementRecorderRMS               24
 #define RECORDER_TAGS_VTKHDF_Recorder               25
+#define RECORDER_TAGS_MetricsRecorder               26
+#define RECORDER_TAGS_FiberSectionRecorder          27
+#define RECORDER_TAGS_LiveViewRecorder              28
 
 #define OPS_STREAM_TAGS_FileStream		1
 #define OPS_STREAM_TAGS_StandardStream		2
@@ -1207,6 +1226,7 @@
 #define OPS_STREAM_TAGS_ChannelStream           9
 #define OPS_STREAM_TAGS_DataTurbineStream      10
 #define OPS_STREAM_TAGS_DataFileStreamAdd      11
+#define OPS_STREAM_TAGS_ColumnarFileStream     12
 
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
@@ -40,6 +40,7 @@
 #include <EquiSolnAlgo.h>
 #include <LinearSOE.h>
 #include <elementAPI.h>
+#include <LogCategory.h>
 
 void* OPS_CTestEnergyIncr()
 {
@@ -143,9 +144,9 @@ int CTestEnergyIncr::test(void)
     }
     
     // determine the energy & save value in norms vector
-    const Vector &b = theSOE->getB();
-    const Vector &x = theSOE->getX();    
-    double product = x ^ b;
+    // the norms printed with it are found in the same pass
+    double normB, normX, product;
+    theSOE->getNorms(nType, &normB, &normX, &product);
     if (product < 0.0)
         product *= -0.5;
     else
@@ -157,13 +158,13 @@ int CTestEnergyIncr::test(void)
     // print the data if required
     if (printFlag == 1) {
         opserr << "CTestEnergyIncr::test() - iteration: " << currentIter;
-        opserr << " current EnergyIncr: " << product << " (max: " << tol << " norm x: " << x.pNorm(nType) << " norm b: " << b.pNorm(nType) << ")\n";
+        opserr << " current EnergyIncr: " << product << " (max: " << tol << " norm x: " << normX << " norm b: " << normB << ")\n";
     }
     if (printFlag == 4) {
         opserr << "CTestEnergyIncr::test() - iteration: " << currentIter;
         opserr << " current EnergyIncr: " << product << " (max: " << tol << ")\n";
-        opserr << "\tNorm deltaX: " << x.pNorm(nType) << ", Norm R: " << b.pNorm(nType) << endln;
-        opserr << "\tdeltaX: " << x << "\tdeltaR: " << b;
+        opserr << "\tNorm deltaX: " << normX << ", Norm R: " << normB << endln;
+        opserr << "\tdeltaX: " << theSOE->getX() << "\tdeltaR: " << theSOE->getB();
     }
     
     //
@@ -179,7 +180,7 @@ int CTestEnergyIncr::test(void)
                 opserr << endln;
             else if (printFlag == 2 || printFlag == 6) {
                 opserr << "CTestEnergyIncr::test() - iteration: " << currentIter;
-                opserr << " last EnergyIncr: " << product << " (max: " << tol << " norm x: " << x.pNorm(nType) << " norm b: " << b.pNorm(nType) << ")\n";
+                opserr << " last EnergyIncr: " << product << " (max: " << tol << " norm x: " << normX << " norm b: " << normB << ")\n";
             }
         }
         
@@ -191,16 +192,17 @@ int CTestEnergyIncr::test(void)
     else if ((printFlag == 5 || printFlag == 6) && currentIter >= maxNumIter) {
         opserr << "WARNING: CTestEnergyIncr::test() - failed to converge but going on -";
         opserr << " current EnergyIncr: " << product << " (max: " << tol << ")\n";
-        opserr << "\tNorm deltaX: " << x.pNorm(nType) << ", Norm deltaR: " << b.pNorm(nType) << endln;
+        opserr << "\tNorm deltaX: " << normX << ", Norm deltaR: " << normB << endln;
         return currentIter;
     }
     
     // algo failed to converged after specified number of iterations - return FAILURE -2
     else if (currentIter >= maxNumIter || product > maxTol) { // >= in case algorithm does not check
-        opserr << "WARNING: CTestEnergyIncr::test() - failed to converge \n";
-        opserr << "after: " << currentIter << " iterations\n";	
-        opserr << " current EnergyIncr: " << product << " (max: " << tol << ") ";
-        opserr << "\tNorm deltaX: " << x.pNorm(nType) << ", Norm deltaR: " << b.pNorm(nType) << endln;
+        OPS_WARNING("CTestEnergyIncr::test", "failed to converge")
+            << "WARNING: CTestEnergyIncr::test() - failed to converge \n"
+            << "after: " << currentIter << " iterations\n"
+            << " current EnergyIncr: " << product << " (max: " << tol << ") "
+            << "\tNorm deltaX: " << normX << ", Norm deltaR: " << normB << endln;
         currentIter++;    
         return -2;
     } 
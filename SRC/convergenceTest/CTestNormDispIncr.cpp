@@ -29,6 +29,7 @@
 #include <EquiSolnAlgo.h>
 #include <LinearSOE.h>
 #include <elementAPI.h>
+#include <LogCategory.h>
 
 void* OPS_CTestNormDispIncr()
 {
@@ -134,8 +135,10 @@ int CTestNormDispIncr::test(void)
     }
     
     // get the X vector & determine it's norm & save the value in norms vector
-    const Vector &x = theSOE->getX();
-    double norm = x.pNorm(nType);
+    // the norm of R is only needed for printing, for a distributed
+    // system getB() is an exchange so it is only asked for then
+    double norm, normB = 0.0;
+    theSOE->getNorms(nType, (printFlag != 0) ? &normB : 0, &norm);
     if (currentIter <= maxNumIter) 
         norms(currentIter-1) = norm;
     
@@ -143,13 +146,13 @@ int CTestNormDispIncr::test(void)
     if (printFlag == 1) {
         opserr << "CTestNormDispIncr::test() - iteration: " << currentIter;
         opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm R: " << theSOE->getB().pNorm(nType) << ")\n";
+        opserr << ", Norm R: " << normB << ")\n";
     } 
     if (printFlag == 4) {
         opserr << "CTestNormDispIncr::test() - iteration: " << currentIter;
         opserr << " current Norm: " << norm << " (max: " << tol << ")\n";
-        opserr << "\tNorm deltaX: " << norm << ", Norm R: " << theSOE->getB().pNorm(nType) << endln;
-        opserr << "\tdeltaX: " << x << "\tdeltaR: " << theSOE->getB();
+        opserr << "\tNorm deltaX: " << norm << ", Norm R: " << normB << endln;
+        opserr << "\tdeltaX: " << theSOE->getX() << "\tdeltaR: " << theSOE->getB();
     } 
     
     //
@@ -166,7 +169,7 @@ int CTestNormDispIncr::test(void)
             else if (printFlag == 2 || printFlag == 6) {
                 opserr << "CTestNormDispIncr::test() - iteration: " << currentIter;
                 opserr << " current Norm: " << norm << " (max: " << tol;
-                opserr << ", Norm deltaR: " << theSOE->getB().pNorm(nType) << ")\n";
+                opserr << ", Norm deltaR: " << normB << ")\n";
             }
         }
         
@@ -178,16 +181,17 @@ int CTestNormDispIncr::test(void)
     else if ((printFlag == 5 || printFlag == 6) && currentIter >= maxNumIter) {
         opserr << "WARNING: CTestNormDispIncr::test() - failed to converge but going on - ";
         opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm deltaR: " << theSOE->getB().pNorm(nType) << ")\n";
+        opserr << ", Norm deltaR: " << normB << ")\n";
         return currentIter;
     }
     
     // algo failed to converged after specified number of iterations - return FAILURE -2
     else if (currentIter >= maxNumIter || norm > maxTol) { // fails to converge
-        opserr << "WARNING: CTestNormDispIncr::test() - failed to converge \n";
-        opserr << "after: " << currentIter << " iterations ";	
-        opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm deltaR: " << theSOE->getB().pNorm(nType) << ")\n";
+        OPS_WARNING("CTestNormDispIncr::test", "failed to converge")
+            << "WARNING: CTestNormDispIncr::test() - failed to converge \n"
+            << "after: " << currentIter << " iterations "
+            << " current Norm: " << norm << " (max: " << tol
+            << ", Norm deltaR: " << theSOE->getB().pNorm(nType) << ")\n";
         currentIter++;    
         return -2;
     } 
@@ -31,6 +31,7 @@
 #include <elementAPI.h>
 #include <iostream>
 #include <fstream>
+#include <LogCategory.h>
 
 void* OPS_CTestNormUnbalance()
 {
@@ -137,8 +138,9 @@ int CTestNormUnbalance::test(void)
     }
     
     // get the B vector & determine it's norm & save the value in norms vector
-    const Vector &x = theSOE->getB();
-    double norm = x.pNorm(nType);
+    // the norm of deltaX for printing comes with it from the same pass
+    double norm, normX;
+    theSOE->getNorms(nType, &norm, &normX);
     if (currentIter <= maxNumIter) 
         norms(currentIter-1) = norm;
 
@@ -152,13 +154,13 @@ int CTestNormUnbalance::test(void)
     if (printFlag == 1) {
         opserr << "CTestNormUnbalance::test() - iteration: " << currentIter;
         opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm deltaX: " << theSOE->getX().pNorm(nType) << ")\n";
+        opserr << ", Norm deltaX: " << normX << ")\n";
     }
     if (printFlag == 4) {
         opserr << "CTestNormUnbalance::test() - iteration: " << currentIter;
         opserr << " current Norm: " << norm << " (max: " << tol << ")\n";
-        opserr << "\tNorm deltaX: " << theSOE->getX().pNorm(nType) << ", Norm deltaR: " << norm << endln;
-        opserr << "\tdeltaX: " << theSOE->getX() << "\tdeltaR: " << x;
+        opserr << "\tNorm deltaX: " << normX << ", Norm deltaR: " << norm << endln;
+        opserr << "\tdeltaX: " << theSOE->getX() << "\tdeltaR: " << theSOE->getB();
     }
 
     if (printFlag == 7) {
@@ -198,7 +200,7 @@ int CTestNormUnbalance::test(void)
             else if (printFlag == 2 || printFlag == 6 || printFlag == 7) {
                 opserr << "CTestNormUnbalance::test() - iteration: " << currentIter;
                 opserr << " current Norm: " << norm << " (max: " << tol;
-                opserr << ", Norm deltaX: " << theSOE->getX().pNorm(nType) << ")\n";
+                opserr << ", Norm deltaX: " << normX << ")\n";
             }
         }
         
@@ -210,16 +212,17 @@ int CTestNormUnbalance::test(void)
     else if ((printFlag == 5 || printFlag == 6) && (currentIter >= maxNumIter||numIncr>=maxIncr)) {
         opserr << "WARNING: CTestNormUnbalance::test() - failed to converge but going on -";
         opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm deltaX: " << theSOE->getX().pNorm(nType) << ")\n";
+        opserr << ", Norm deltaX: " << normX << ")\n";
         return currentIter;
     }
     
     // algo failed to converged after specified number of iterations - return FAILURE -2
     else if (currentIter >= maxNumIter || numIncr >= maxIncr || norm > maxTol) { // the algorithm failed to converge
-        opserr << "WARNING: CTestNormUnbalance::test() - failed to converge \n";
-        opserr << "after: " << currentIter << " iterations ";	
-        opserr << " current Norm: " << norm << " (max: " << tol;
-        opserr << ", Norm deltaX: " << theSOE->getX().pNorm(nType) << ")\n";
+        OPS_WARNING("CTestNormUnbalance::test", "failed to converge")
+            << "WARNING: CTestNormUnbalance::test() - failed to converge \n"
+            << "after: " << currentIter << " iterations "
+            << " current Norm: " << norm << " (max: " << tol
+            << ", Norm deltaX: " << normX << ")\n";
         currentIter++;  // we increment in case analysis does not check for convergence
         return -2;
     } 
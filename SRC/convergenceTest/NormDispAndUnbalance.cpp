@@ -134,12 +134,9 @@ int NormDispAndUnbalance::test(void)
         return -2;
     }
     
-    // get the X vector & determine it's norm & save the value in norms vector
-    const Vector &x = theSOE->getX();
-    double normX = x.pNorm(nType);
-
-    const Vector &b = theSOE->getB();
-    double normB = b.pNorm(nType);
+    // determine the norms of X & B in one pass & save them in norms vector
+    double normX, normB;
+    theSOE->getNorms(nType, &normB, &normX);
 
     if((currentIter>1 && norms(currentIter-2)<normX) || (currentIter>1 && norms(maxNumIter+currentIter-2)<normB)) {
         numIncr++;
@@ -160,7 +157,7 @@ int NormDispAndUnbalance::test(void)
         opserr << "NormDispAndUnbalance::test() - iteration: " << currentIter;
         opserr << " current NormX: " << normX;
         opserr << ", NormB: " << normB  << ", NormIncr: " << numIncr << "\n";
-        opserr << "\tdeltaX: " << x << "\tdeltaR: " << theSOE->getB();
+        opserr << "\tdeltaX: " << theSOE->getX() << "\tdeltaR: " << theSOE->getB();
     } 
     
     //
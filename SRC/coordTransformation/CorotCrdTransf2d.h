@@ -80,6 +80,7 @@ public:
 // AddingSensitivity:END //////////////////////////////////
 
     CrdTransf *getCopy2d(void);
+    bool isThreadSafe(void) {return true;}
     
     int sendSelf(int cTag, Channel &theChannel);
     int recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -122,13 +123,13 @@ private:
     Vector ubcommit;           // committed basic displacements
     Vector ubpr;               // previous basic displacements
     
-    static Matrix Tlg;         // matrix that transforms from global to local coordinates
-    static Matrix Tbl;         // matrix that transforms from local  to basic coordinates
-    static Matrix kg;          // global stiffness matrix
-    static Vector uxg;     
-    static Vector pg;     
-    static Vector dub;     
-    static Vector Dub;     
+    static thread_local Matrix Tlg;         // matrix that transforms from global to local coordinates
+    static thread_local Matrix Tbl;         // matrix that transforms from local  to basic coordinates
+    static thread_local Matrix kg;          // global stiffness matrix
+    static thread_local Vector uxg;     
+    static thread_local Vector pg;     
+    static thread_local Vector dub;     
+    static thread_local Vector Dub;     
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
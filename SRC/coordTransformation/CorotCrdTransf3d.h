@@ -39,6 +39,7 @@
 #include <CrdTransf.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <Matrix3D.h>
 
 class CorotCrdTransf3d: public CrdTransf
 {
@@ -71,6 +72,7 @@ public:
     const Matrix &getInitialGlobalStiffMatrix(const Matrix &basicStiff);
     
     CrdTransf *getCopy3d(void);
+    bool isThreadSafe(void) {return true;}
     
     int sendSelf(int cTag, Channel &theChannel);
     int recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -90,18 +92,9 @@ public:
   
 private:
     void compTransfMatrixBasicGlobal(void);
-    void compTransfMatrixBasicGlobalNew(void);
     void compTransfMatrixLocalGlobal(Matrix &Tlg);
     void compTransfMatrixBasicLocal(Matrix &Tbl);
     const Vector &getQuaternionFromRotMatrix(const Matrix &RotMatrix) const;
-    const Vector &getQuaternionFromPseudoRotVector(const Vector &theta) const;
-    const Vector &getTangScaledPseudoVectorFromQuaternion(const Vector &theta) const;
-    const Vector &quaternionProduct(const Vector &q1, const Vector &q2) const;
-    const Matrix &getRotationMatrixFromQuaternion(const Vector &q) const;
-    const Matrix &getRotMatrixFromTangScaledPseudoVector(const Vector &w) const;
-    const Matrix &getSkewSymMatrix(const Vector &theta) const;
-    const Matrix &getLMatrix(const Vector &ri) const;
-    const Matrix &getKs2Matrix(const Vector &ri, const Vector &z) const;
     
     // internal data
     Node *nodeIPtr, *nodeJPtr;  // pointers to the element two endnodes
@@ -127,17 +120,18 @@ private:
     Vector ulcommit;            // committed local displacements
     Vector ulpr;                // previous local displacements
     
-    static Matrix RI;           // nodal triad for node 1
-    static Matrix RJ;           // nodal triad for node 2
-    static Matrix Rbar;         // mean nodal triad 
-    static Matrix e;            // base vectors
-    static Matrix Tp;           // transformation matrix to renumber dofs
-    static Matrix T;            // transformation matrix from basic to global system
-    static Matrix Tlg;          // transformation matrix from global to local system
-    static Matrix TlgInv;       // inverse of transformation matrix from global to local system
-    static Matrix Tbl;          // transformation matrix from local to basic system
-    static Matrix kg;           // global stiffness matrix
-    static Matrix Lr2, Lr3, A;  // auxiliary matrices
+    static thread_local OpenSees::Matrix3D RI;    // nodal triad for node 1
+    static thread_local OpenSees::Matrix3D RJ;    // nodal triad for node 2
+    static thread_local OpenSees::Matrix3D Rbar;  // mean nodal triad 
+    static thread_local OpenSees::Matrix3D e;     // base vectors
+    static thread_local Matrix Tp;           // transformation matrix to renumber dofs
+    static thread_local Matrix T;            // transformation matrix from basic to global system
+    static thread_local Matrix Tlg;          // transformation matrix from global to local system
+    static thread_local Matrix TlgInv;       // inverse of transformation matrix from global to local system
+    static thread_local Matrix Tbl;          // transformation matrix from local to basic system
+    static thread_local Matrix kg;           // global stiffness matrix
+    static thread_local OpenSees::Matrix3D A;     // auxiliary matrices
+    static thread_local OpenSees::Matrix3D Lr2[2], Lr3[2]; // blocks L1, L2 of L = [L1; L2; -L1; L2]
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
@@ -40,6 +40,7 @@
 #include <CrdTransfResponse.h>
 
 static MapOfTaggedObjects theCrdTransfObjects;
+static bool theCrdTransfObjectsRegistered = MapOfTaggedObjects::addModelStorage(theCrdTransfObjects);
 
 bool 
 OPS_addCrdTransf(CrdTransf *newComponent) {
@@ -59,6 +59,10 @@ public:
     virtual CrdTransf *getCopy3d(void) {return 0;};
   virtual int getLocalAxes(Vector &xAxis, Vector &yAxis, Vector &zAxis);
   virtual int getRigidOffsets(Vector &offsets);
+
+    // true if the methods of the object may be invoked concurrently with
+    // those of other transformations, i.e. its work areas are thread local
+    virtual bool isThreadSafe(void) {return false;}
   
     virtual int    initialize(Node *node1Pointer, Node *node2Pointer) = 0;
     virtual int    update(void) = 0;
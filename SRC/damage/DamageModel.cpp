@@ -37,6 +37,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theDamageModelObjects;
+static bool theDamageModelObjectsRegistered = MapOfTaggedObjects::addModelStorage(theDamageModelObjects);
 
 bool OPS_addDamageModel(DamageModel *newComponent) {
   return theDamageModelObjects.addComponent(newComponent);
@@ -44,6 +44,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theDampingObjects;
+static bool theDampingObjectsRegistered = MapOfTaggedObjects::addModelStorage(theDampingObjects);
 
 bool OPS_addDamping(Damping *newComponent)
 {
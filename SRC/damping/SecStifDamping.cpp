@@ -114,7 +114,7 @@ SecStifDamping::setDomain(Domain *domain, int nComp)
 
 
 int
-SecStifDamping::update(Vector q)
+SecStifDamping::update(const Vector &q)
 {       
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
@@ -50,7 +50,7 @@ public:
   const char *getClassType() const {return "SecStifDamping";};
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
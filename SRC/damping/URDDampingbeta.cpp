@@ -148,7 +148,7 @@ URDDampingbeta::setDomain(Domain *domain, int nC)
 
 
 int
-URDDampingbeta::update(Vector q)
+URDDampingbeta::update(const Vector &q)
 {
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
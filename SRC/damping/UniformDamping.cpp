@@ -67,7 +67,7 @@ UniformDamping::UniformDamping(int tag, double cd, double f1, double f2, double
 Damping(tag, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(cd), freq1(f1), freq2(f2), ta(t1), td(t2), fac(f),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), state(0), stateSize(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
 {
   if (eta <= 0.0) opserr << "UniformDamping::UniformDamping:  Invalid damping ratio\n";
   if (freq1 <= 0.0 || freq2 <= 0.0 || freq1 >= freq2)
@@ -81,7 +81,7 @@ UniformDamping::UniformDamping(int tag, double cd, double f1, double f2, double
 Damping(tag, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(cd), freq1(f1), freq2(f2), ta(t1), td(t2), fac(f),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), state(0), stateSize(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
 {
   if (eta <= 0.0) opserr << "UniformDamping::UniformDamping:  Invalid damping ratio\n";
   if (freq1 <= 0.0 || freq2 <= 0.0 || freq1 >= freq2)
@@ -105,7 +105,7 @@ UniformDamping::UniformDamping():
 Damping(0, DMP_TAG_UniformDamping),
 nComp(0), nFilter(0),
 eta(0.0), freq1(0.0), freq2(0.0), ta(0.0), td(0.0), fac(0),
-alpha(0), omegac(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
+alpha(0), omegac(0), state(0), stateSize(0), qL(0), qLC(0), qd(0), qdC(0), q0(0), q0C(0)
 {
 
 }
@@ -123,6 +123,7 @@ UniformDamping::~UniformDamping()
   if (qdC) delete qdC;
   if (q0) delete q0;
   if (q0C) delete q0C;
+  if (state) delete [] state;
 }
 
 int
@@ -202,9 +203,8 @@ UniformDamping::Initialize(void)
 int
 UniformDamping::commitState(void)
 {
-  *qdC = *qd;
-  *q0C = *q0;
-  *qLC = *qL;
+  for (int i = 0; i < stateSize; ++i)
+    state[stateSize + i] = state[i];
   return 0;
 }
 
@@ -212,9 +212,8 @@ UniformDamping::commitState(void)
 int
 UniformDamping::revertToLastCommit(void)
 {
-  *qd = *qdC;
-  *q0 = *q0C;
-  *qL = *qLC;
+  for (int i = 0; i < stateSize; ++i)
+    state[i] = state[stateSize + i];
   return 0;
 }
 
@@ -222,12 +221,8 @@ UniformDamping::revertToLastCommit(void)
 int
 UniformDamping::revertToStart(void)
 {
-  (*qd).Zero();
-  (*qdC).Zero();
-  (*q0).Zero();
-  (*q0C).Zero();
-  (*qL).Zero();
-  (*qLC).Zero();
+  for (int i = 0; i < 2 * stateSize; ++i)
+    state[i] = 0.0;
   return 0;
 }
 
@@ -237,36 +232,66 @@ UniformDamping::setDomain(Domain *domain, int nC)
 {
   theDomain = domain;
   nComp = nC;
-  
-  qd = new Vector(nComp);
-  qdC = new Vector(nComp);
-  q0 = new Vector(nComp);
-  q0C = new Vector(nComp);
-  qL = new Matrix(nComp, nFilter);
-  qLC = new Matrix(nComp, nFilter);
+
+  if (state) delete [] state;
+  if (qd) delete qd;
+  if (qdC) delete qdC;
+  if (q0) delete q0;
+  if (q0C) delete q0C;
+  if (qL) delete qL;
+  if (qLC) delete qLC;
+
+  stateSize = nComp * (2 + nFilter);
+  state = new double[2 * stateSize];
+  for (int i = 0; i < 2 * stateSize; ++i)
+    state[i] = 0.0;
+
+  double *stateC = state + stateSize;
+  qd = new Vector(state, nComp);
+  qdC = new Vector(stateC, nComp);
+  q0 = new Vector(state + nComp, nComp);
+  q0C = new Vector(stateC + nComp, nComp);
+  qL = new Matrix(state + 2 * nComp, nComp, nFilter);
+  qLC = new Matrix(stateC + 2 * nComp, nComp, nFilter);
   
   return 0;
 }
 
 
 int
-UniformDamping::update(Vector q)
+UniformDamping::update(const Vector &q)
 {
   double t = theDomain->getCurrentTime();
   double dT = theDomain->getDT();
   StaticAnalysis **theStaticAnalysis = OPS_GetStaticAnalysis();
+
+  // the filters are updated on the flat state, filter i of qL is at
+  // qL + i*nComp, so the loops over the components are unit stride
+  double *qdT = state;
+  double *q0T = state + nComp;
+  double *qLT = state + 2 * nComp;
+  const double *qdc = qdT + stateSize;
+  const double *q0c = q0T + stateSize;
+  const double *qLc = qLT + stateSize;
+
   if (*theStaticAnalysis)
   {
-    *q0 = q;
-    (*qd).Zero();
+    for (int j = 0; j < nComp; ++j)
+    {
+      q0T[j] = q(j);
+      qdT[j] = 0.0;
+    }
     for (int i = 0; i < nFilter; ++i)
       for (int j = 0; j < nComp; ++j)
-        (*qL)(j,i) = q(j);
+        qLT[i * nComp + j] = q0T[j];
   }
   else if (dT > 0.0)
   {
-    *q0 = q;
-    (*qd).Zero();
+    for (int j = 0; j < nComp; ++j)
+    {
+      q0T[j] = q(j);
+      qdT[j] = 0.0;
+    }
     if (t < td)
     {
       if (t > ta)
@@ -277,21 +302,30 @@ UniformDamping::update(Vector q)
           double cd = 4.0 * (*alpha)(i) * eta / (2.0 + dTomegac);
           double c0 = dTomegac / (2.0 + dTomegac);
           double cL = (2.0 - dTomegac) / (2.0 + dTomegac);
+          double *qLi = qLT + i * nComp;
+          const double *qLci = qLc + i * nComp;
           for (int j = 0; j < nComp; ++j)
           {
-            (*qd)(j) += cd * ((*q0C)(j) + (*q0)(j) - 2.0 * (*qLC)(j,i));
-            (*qL)(j,i) = c0 * ((*q0C)(j) + (*q0)(j)) + cL * (*qLC)(j,i);
+            double qsum = q0c[j] + q0T[j];
+            qdT[j] += cd * (qsum - 2.0 * qLci[j]);
+            qLi[j] = c0 * qsum + cL * qLci[j];
           }
         }
-        *qd -= *qdC;
+        for (int j = 0; j < nComp; ++j)
+          qdT[j] -= qdc[j];
       }
       else
       {
         for (int i = 0; i < nFilter; ++i)
           for (int j = 0; j < nComp; ++j)
-            (*qL)(j,i) = q(j);
+            qLT[i * nComp + j] = q0T[j];
+      }
+      if (fac)
+      {
+        double f = fac->getFactor(t);
+        for (int j = 0; j < nComp; ++j)
+          qdT[j] *= f;
       }
-      if (fac) *qd *= fac->getFactor(t);
     }
   }
   return 0;
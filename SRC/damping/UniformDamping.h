@@ -69,7 +69,7 @@ public:
   int Initialize(void);
   
   int setDomain(Domain *domain, int nComp);
-  int update(Vector q);
+  int update(const Vector &q);
   
   int commitState(void);
   int revertToLastCommit(void);    
@@ -95,6 +95,10 @@ private:
   double eta, freq1, freq2, ta, td;
   TimeSeries *fac;
   Vector *alpha, *omegac;
+  // the trial filter states qd, q0 & qL, followed by the committed ones,
+  // are kept in one block; the Vectors & Matrices wrap it
+  double *state;
+  int stateSize;
   Matrix *qL, *qLC;
   Vector *qd, *qdC, *q0, *q0C;
   Domain *theDomain;
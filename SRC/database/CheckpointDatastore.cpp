@@ -0,0 +1,405 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// CheckpointDatastore.
+
+#include <CheckpointDatastore.h>
+#include <Message.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char checkpointMagic[8] = {'O','P','S','C','K','P','T','\0'};
+static const char blockMagic[4] = {'B','L','K','\0'};
+static const int checkpointVersion = 1;
+
+// the kinds of record, in the order they are written in a block
+enum {ID_RECORDS, VECTOR_RECORDS, MATRIX_RECORDS, MESSAGE_RECORDS, NUM_KINDS};
+
+CheckpointDatastore::CheckpointDatastore(const char *name, Domain &theDomain,
+					 FEM_ObjectBroker &theObjBroker)
+  :MemoryDatastore(theDomain, theObjBroker),
+   fileName(name), fileRead(false), lastCommitTag(-1),
+   async(false), theWriter(), writeError(0)
+{
+
+}
+
+
+CheckpointDatastore::~CheckpointDatastore()
+{
+  this->waitForWriter();
+}
+
+
+void
+CheckpointDatastore::setAsync(bool onOff)
+{
+  if (onOff == false)
+    this->waitForWriter();
+  async = onOff;
+}
+
+
+int
+CheckpointDatastore::getLastCommitTag(void)
+{
+  if (fileRead == false) {
+    // no file yet is no checkpoint, not an error
+    FILE *theFile = fopen(fileName.c_str(), "rb");
+    if (theFile == 0)
+      return lastCommitTag;
+    fclose(theFile);
+
+    if (this->readFile() < 0)
+      return -1;
+    fileRead = true;
+  }
+
+  return lastCommitTag;
+}
+
+
+int
+CheckpointDatastore::sendMsg(int dbTag, int commitTag,
+			     const Message &theMessage,
+			     ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, 0};
+  newMessages.insert(key);
+  return this->MemoryDatastore::sendMsg(dbTag, commitTag, theMessage, theAddress);
+}
+
+
+int
+CheckpointDatastore::sendMatrix(int dbTag, int commitTag,
+				const Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theMatrix.noRows()*theMatrix.noCols()};
+  newMatrices.insert(key);
+  return this->MemoryDatastore::sendMatrix(dbTag, commitTag, theMatrix, theAddress);
+}
+
+
+int
+CheckpointDatastore::sendVector(int dbTag, int commitTag,
+				const Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theVector.Size()};
+  newVectors.insert(key);
+  return this->MemoryDatastore::sendVector(dbTag, commitTag, theVector, theAddress);
+}
+
+
+int
+CheckpointDatastore::sendID(int dbTag, int commitTag,
+			    const ID &theID,
+			    ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theID.Size()};
+  newIDs.insert(key);
+  return this->MemoryDatastore::sendID(dbTag, commitTag, theID, theAddress);
+}
+
+
+int
+CheckpointDatastore::commitState(int commitTag)
+{
+  int res = this->MemoryDatastore::commitState(commitTag);
+  if (res < 0)
+    return res;
+
+  return this->writeBlock(commitTag);
+}
+
+
+int
+CheckpointDatastore::restoreState(int commitTag)
+{
+  if (this->waitForWriter() < 0)
+    return -1;
+
+  // a new process has nothing in memory yet
+  if (fileRead == false) {
+    if (this->readFile() < 0)
+      return -1;
+    fileRead = true;
+  }
+
+  return this->MemoryDatastore::restoreState(commitTag);
+}
+
+
+// appends to the buffer the table of contents entry of a record
+static void
+addEntry(std::vector<char> &buffer, int dbTag, int commitTag, int size, int count)
+{
+  int entry[4] = {dbTag, commitTag, size, count};
+  const char *data = (const char *)entry;
+  buffer.insert(buffer.end(), data, data + sizeof(entry));
+}
+
+
+static void
+addData(std::vector<char> &buffer, const void *data, size_t numBytes)
+{
+  if (numBytes > 0)
+    buffer.insert(buffer.end(), (const char *)data, (const char *)data + numBytes);
+}
+
+
+int
+CheckpointDatastore::writeBlock(int commitTag)
+{
+  int num[NUM_KINDS];
+  num[ID_RECORDS] = (int)newIDs.size();
+  num[VECTOR_RECORDS] = (int)newVectors.size();
+  num[MATRIX_RECORDS] = (int)newMatrices.size();
+  num[MESSAGE_RECORDS] = (int)newMessages.size();
+
+  //
+  // table of contents then the data, each in the order of the kinds
+  //
+
+  std::vector<char> toc, data;
+  std::set<Key>::iterator it;
+
+  for (it = newIDs.begin(); it != newIDs.end(); it++) {
+    std::vector<int> &values = theIDs[*it];
+    addEntry(toc, it->dbTag, it->commitTag, it->size, (int)values.size());
+    addData(data, values.empty() ? 0 : &values[0], values.size()*sizeof(int));
+  }
+  for (it = newVectors.begin(); it != newVectors.end(); it++) {
+    std::vector<double> &values = theVectors[*it];
+    addEntry(toc, it->dbTag, it->commitTag, it->size, (int)values.size());
+    addData(data, values.empty() ? 0 : &values[0], values.size()*sizeof(double));
+  }
+  for (it = newMatrices.begin(); it != newMatrices.end(); it++) {
+    std::vector<double> &values = theMatrices[*it];
+    addEntry(toc, it->dbTag, it->commitTag, it->size, (int)values.size());
+    addData(data, values.empty() ? 0 : &values[0], values.size()*sizeof(double));
+  }
+  for (it = newMessages.begin(); it != newMessages.end(); it++) {
+    std::vector<char> &values = theMessages[*it];
+    addEntry(toc, it->dbTag, it->commitTag, it->size, (int)values.size());
+    addData(data, values.empty() ? 0 : &values[0], values.size());
+  }
+
+  long long numBytes = (long long)(toc.size() + data.size());
+
+  std::vector<char> block;
+  block.reserve(sizeof(blockMagic) + (NUM_KINDS+1)*sizeof(int) + sizeof(numBytes) + numBytes);
+  addData(block, blockMagic, sizeof(blockMagic));
+  addData(block, &commitTag, sizeof(int));
+  addData(block, num, sizeof(num));
+  addData(block, &numBytes, sizeof(numBytes));
+  block.insert(block.end(), toc.begin(), toc.end());
+  block.insert(block.end(), data.begin(), data.end());
+
+  newIDs.clear();
+  newVectors.clear();
+  newMatrices.clear();
+  newMessages.clear();
+
+  // the previous block must be out before this one is appended
+  if (this->waitForWriter() < 0)
+    return -1;
+
+  lastCommitTag = commitTag;
+
+  if (async == true) {
+    theWriter = std::thread(&CheckpointDatastore::writeToFile, this, std::move(block));
+    return 0;
+  }
+
+  this->writeToFile(std::move(block));
+  return this->waitForWriter();
+}
+
+
+void
+CheckpointDatastore::writeToFile(std::vector<char> block)
+{
+  FILE *theFile = fopen(fileName.c_str(), "ab");
+  if (theFile == 0) {
+    writeError = -1;
+    return;
+  }
+
+  // a new file starts with the header
+  fseek(theFile, 0, SEEK_END);
+  if (ftell(theFile) == 0) {
+    int header[4] = {checkpointVersion, (int)sizeof(int), (int)sizeof(double), 0};
+    fwrite(checkpointMagic, 1, sizeof(checkpointMagic), theFile);
+    fwrite(header, sizeof(int), 4, theFile);
+  }
+
+  size_t written = fwrite(&block[0], 1, block.size(), theFile);
+  int res = fclose(theFile);
+  if (written != block.size() || res != 0)
+    writeError = -1;
+}
+
+
+int
+CheckpointDatastore::waitForWriter(void)
+{
+  if (theWriter.joinable())
+    theWriter.join();
+
+  if (writeError != 0) {
+    opserr << "CheckpointDatastore - failed to write to file " << fileName.c_str() << endln;
+    writeError = 0;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+CheckpointDatastore::readFile(void)
+{
+  if (this->waitForWriter() < 0)
+    return -1;
+
+  FILE *theFile = fopen(fileName.c_str(), "rb");
+  if (theFile == 0) {
+    opserr << "CheckpointDatastore::restoreState() - could not open file " << fileName.c_str() << endln;
+    return -1;
+  }
+
+  fseek(theFile, 0, SEEK_END);
+  long fileSize = ftell(theFile);
+  fseek(theFile, 0, SEEK_SET);
+
+  std::vector<char> contents(fileSize > 0 ? fileSize : 0);
+  size_t numRead = (fileSize > 0) ? fread(&contents[0], 1, fileSize, theFile) : 0;
+  fclose(theFile);
+
+  const size_t headerSize = sizeof(checkpointMagic) + 4*sizeof(int);
+  if (numRead != contents.size() || numRead < headerSize ||
+      memcmp(&contents[0], checkpointMagic, sizeof(checkpointMagic)) != 0) {
+    opserr << "CheckpointDatastore::restoreState() - " << fileName.c_str() << " is not a checkpoint file\n";
+    return -1;
+  }
+
+  int header[4];
+  memcpy(header, &contents[sizeof(checkpointMagic)], sizeof(header));
+  if (header[0] != checkpointVersion || header[1] != (int)sizeof(int) || header[2] != (int)sizeof(double)) {
+    opserr << "CheckpointDatastore::restoreState() - " << fileName.c_str() << " is version " << header[0];
+    opserr << " or was written on a machine with other int or double sizes\n";
+    return -1;
+  }
+
+  theIDs.clear();
+  theVectors.clear();
+  theMatrices.clear();
+  theMessages.clear();
+  lastCommitTag = -1;
+
+  //
+  // read the blocks in turn, later records replace those of earlier blocks
+  //
+
+  const size_t blockHeaderSize = sizeof(blockMagic) + (NUM_KINDS+1)*sizeof(int) + sizeof(long long);
+  size_t loc = headerSize;
+  while (loc < contents.size()) {
+
+    if (contents.size() - loc < blockHeaderSize ||
+	memcmp(&contents[loc], blockMagic, sizeof(blockMagic)) != 0) {
+      opserr << "CheckpointDatastore::restoreState() - " << fileName.c_str();
+      opserr << " is truncated, the blocks after byte " << (int)loc << " are ignored\n";
+      break;
+    }
+
+    int num[NUM_KINDS];
+    long long numBytes;
+    memcpy(num, &contents[loc + sizeof(blockMagic) + sizeof(int)], sizeof(num));
+    memcpy(&numBytes, &contents[loc + sizeof(blockMagic) + (NUM_KINDS+1)*sizeof(int)], sizeof(numBytes));
+
+    size_t start = loc + blockHeaderSize;
+    if (numBytes < 0 || (size_t)numBytes > contents.size() - start) {
+      opserr << "CheckpointDatastore::restoreState() - " << fileName.c_str();
+      opserr << " is truncated, the blocks after byte " << (int)loc << " are ignored\n";
+      break;
+    }
+
+    int numRecords = 0;
+    for (int kind=0; kind<NUM_KINDS; kind++)
+      numRecords += num[kind];
+
+    const char *toc = &contents[start];
+    const char *data = toc + numRecords*4*sizeof(int);
+    const char *end = &contents[start] + numBytes;
+
+    bool ok = (data <= end);
+    for (int kind=0, k=0; ok && kind<NUM_KINDS; kind++) {
+      for (int i=0; i<num[kind]; i++, k++) {
+	int entry[4];
+	memcpy(entry, toc + k*sizeof(entry), sizeof(entry));
+	Key key = {entry[0], entry[1], entry[2]};
+	int count = entry[3];
+
+	size_t width = (kind == ID_RECORDS) ? sizeof(int) :
+	  ((kind == MESSAGE_RECORDS) ? 1 : sizeof(double));
+	if (count < 0 || (size_t)count*width > (size_t)(end - data)) {
+	  ok = false;
+	  break;
+	}
+
+	if (kind == ID_RECORDS) {
+	  std::vector<int> &values = theIDs[key];
+	  values.resize(count);
+	  if (count > 0)
+	    memcpy(&values[0], data, count*width);
+	} else if (kind == VECTOR_RECORDS || kind == MATRIX_RECORDS) {
+	  std::vector<double> &values = (kind == VECTOR_RECORDS) ? theVectors[key] : theMatrices[key];
+	  values.resize(count);
+	  if (count > 0)
+	    memcpy(&values[0], data, count*width);
+	} else {
+	  std::vector<char> &values = theMessages[key];
+	  values.assign(data, data + count);
+	}
+	data += count*width;
+      }
+    }
+
+    if (ok == false) {
+      opserr << "CheckpointDatastore::restoreState() - " << fileName.c_str();
+      opserr << " has a corrupt block at byte " << (int)loc << ", it and those after are ignored\n";
+      break;
+    }
+
+    int commitTag;
+    memcpy(&commitTag, &contents[loc + sizeof(blockMagic)], sizeof(int));
+    lastCommitTag = commitTag;
+
+    loc = start + numBytes;
+  }
+
+  return 0;
+}
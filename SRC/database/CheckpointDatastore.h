@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef CheckpointDatastore_h
+#define CheckpointDatastore_h
+
+// Description: This file contains the class definition for
+// CheckpointDatastore. CheckpointDatastore is a MemoryDatastore that also
+// keeps what is sent to it in a single binary file, so a run can be
+// restarted from it in a new process. The file starts with a versioned
+// header; each commitState() then appends one block holding only the
+// records sent by that commit, the table of contents of the block (the
+// dbTag, commitTag and size of every record) followed by the contiguous
+// data of its IDs, Vectors, Matrices and Messages. Each block is written
+// with a single write. The first restoreState() of a new process reads the
+// whole file in one go, later blocks replacing the records of earlier ones;
+// the domain then receives its state from memory. With setAsync() the
+// blocks are written by a background thread while the next is gathered,
+// so at most one block is waiting to be written.
+//
+// What: "@(#) CheckpointDatastore.h, revA"
+
+#include <MemoryDatastore.h>
+#include <set>
+#include <string>
+#include <vector>
+#include <thread>
+
+class CheckpointDatastore: public MemoryDatastore
+{
+  public:
+    CheckpointDatastore(const char *fileName, Domain &theDomain,
+			FEM_ObjectBroker &theBroker);
+    ~CheckpointDatastore();
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    int commitState(int commitTag);
+    int restoreState(int commitTag);
+
+    void setAsync(bool onOff);
+
+    // the commitTag of the last complete block, -1 if there is none
+    int getLastCommitTag(void);
+
+  protected:
+
+  private:
+    int writeBlock(int commitTag);
+    void writeToFile(std::vector<char> block);
+    int waitForWriter(void);
+    int readFile(void);
+
+    std::string fileName;
+    bool fileRead;
+    int lastCommitTag;
+
+    bool async;
+    std::thread theWriter;
+    int writeError;
+
+    // the records sent since the last block was written
+    std::set<Key> newIDs, newVectors, newMatrices, newMessages;
+};
+
+#endif
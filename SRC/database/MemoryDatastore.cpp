@@ -0,0 +1,199 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// MemoryDatastore.
+
+#include <MemoryDatastore.h>
+#include <FEM_ObjectBroker.h>
+#include <Domain.h>
+#include <Message.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <string.h>
+
+MemoryDatastore::MemoryDatastore(Domain &theDomain, FEM_ObjectBroker &theObjBroker)
+  :FE_Datastore(theDomain, theObjBroker)
+{
+
+}
+
+
+MemoryDatastore::~MemoryDatastore()
+{
+
+}
+
+
+int
+MemoryDatastore::sendMsg(int dbTag, int commitTag,
+			 const Message &theMessage,
+			 ChannelAddress *theAddress)
+{
+  Message &msg = const_cast<Message &>(theMessage);
+  int size = msg.getSize();
+  Key key = {dbTag, commitTag, 0};
+
+  std::vector<char> &data = theMessages[key];
+  data.resize(size);
+  if (size > 0)
+    memcpy(&data[0], msg.getData(), size);
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::recvMsg(int dbTag, int commitTag,
+			 Message &theMessage,
+			 ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, 0};
+  std::map<Key, std::vector<char> >::iterator it = theMessages.find(key);
+  if (it == theMessages.end() || (int)it->second.size() != theMessage.getSize()) {
+    opserr << "MemoryDatastore::recvMsg() - no Message of that size saved for dbTag ";
+    opserr << dbTag << " and commitTag " << commitTag << endln;
+    return -1;
+  }
+
+  if (!it->second.empty())
+    memcpy(const_cast<char *>(theMessage.getData()), &(it->second[0]), it->second.size());
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::recvMsgUnknownSize(int dbTag, int commitTag,
+				    Message &theMessage,
+				    ChannelAddress *theAddress)
+{
+  opserr << "MemoryDatastore::recvMsgUnknownSize() - not yet implemented\n";
+  return -1;
+}
+
+
+int
+MemoryDatastore::sendMatrix(int dbTag, int commitTag,
+			    const Matrix &theMatrix,
+			    ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theMatrix.dataSize};
+
+  std::vector<double> &data = theMatrices[key];
+  data.resize(theMatrix.dataSize);
+  if (theMatrix.dataSize > 0)
+    memcpy(&data[0], theMatrix.data, theMatrix.dataSize*sizeof(double));
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::recvMatrix(int dbTag, int commitTag,
+			    Matrix &theMatrix,
+			    ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theMatrix.dataSize};
+  std::map<Key, std::vector<double> >::iterator it = theMatrices.find(key);
+  if (it == theMatrices.end()) {
+    opserr << "MemoryDatastore::recvMatrix() - no Matrix of that size saved for dbTag ";
+    opserr << dbTag << " and commitTag " << commitTag << endln;
+    return -1;
+  }
+
+  if (theMatrix.dataSize > 0)
+    memcpy(theMatrix.data, &(it->second[0]), theMatrix.dataSize*sizeof(double));
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::sendVector(int dbTag, int commitTag,
+			    const Vector &theVector,
+			    ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theVector.sz};
+
+  std::vector<double> &data = theVectors[key];
+  data.resize(theVector.sz);
+  if (theVector.sz > 0)
+    memcpy(&data[0], theVector.theData, theVector.sz*sizeof(double));
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::recvVector(int dbTag, int commitTag,
+			    Vector &theVector,
+			    ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theVector.sz};
+  std::map<Key, std::vector<double> >::iterator it = theVectors.find(key);
+  if (it == theVectors.end()) {
+    opserr << "MemoryDatastore::recvVector() - no Vector of that size saved for dbTag ";
+    opserr << dbTag << " and commitTag " << commitTag << endln;
+    return -1;
+  }
+
+  if (theVector.sz > 0)
+    memcpy(theVector.theData, &(it->second[0]), theVector.sz*sizeof(double));
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::sendID(int dbTag, int commitTag,
+			const ID &theID,
+			ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theID.sz};
+
+  std::vector<int> &data = theIDs[key];
+  data.resize(theID.sz);
+  if (theID.sz > 0)
+    memcpy(&data[0], theID.data, theID.sz*sizeof(int));
+
+  return 0;
+}
+
+
+int
+MemoryDatastore::recvID(int dbTag, int commitTag,
+			ID &theID,
+			ChannelAddress *theAddress)
+{
+  Key key = {dbTag, commitTag, theID.sz};
+  std::map<Key, std::vector<int> >::iterator it = theIDs.find(key);
+  if (it == theIDs.end()) {
+    opserr << "MemoryDatastore::recvID() - no ID of that size saved for dbTag ";
+    opserr << dbTag << " and commitTag " << commitTag << endln;
+    return -1;
+  }
+
+  if (theID.sz > 0)
+    memcpy(theID.data, &(it->second[0]), theID.sz*sizeof(int));
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MemoryDatastore_h
+#define MemoryDatastore_h
+
+// Description: This file contains the class definition for MemoryDatastore.
+// MemoryDatastore is a concrete subclass of FE_Datastore that keeps what is
+// sent to it in memory instead of in files. Each ID, Vector and Matrix is
+// held as a flat array under its dbTag, commitTag and size; saving again
+// under the same commitTag overwrites the arrays in place. As the datastore
+// is the same channel each time, restoring a domain whose geometry has not
+// changed only has the existing nodes, elements and materials receive their
+// committed state back, so a saved state can be returned to cheaply.
+//
+// What: "@(#) MemoryDatastore.h, revA"
+
+#include <FE_Datastore.h>
+#include <map>
+#include <vector>
+
+class FEM_ObjectBroker;
+
+class MemoryDatastore: public FE_Datastore
+{
+  public:
+    MemoryDatastore(Domain &theDomain, FEM_ObjectBroker &theBroker);
+    ~MemoryDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+  protected:
+    struct Key {
+      int dbTag, commitTag, size;
+      bool operator<(const Key &other) const {
+	if (dbTag != other.dbTag) return dbTag < other.dbTag;
+	if (commitTag != other.commitTag) return commitTag < other.commitTag;
+	return size < other.size;
+      }
+    };
+
+    std::map<Key, std::vector<int> > theIDs;
+    std::map<Key, std::vector<double> > theVectors;
+    std::map<Key, std::vector<double> > theMatrices;
+    std::map<Key, std::vector<char> > theMessages;
+
+  private:
+};
+
+#endif
@@ -601,6 +601,9 @@ void IGASurfacePatch::setDomain(Domain *theDomain)
     // opserr << "*quadWeight = " << *quadWeight << endln;
     // opserr << "*quadPoint = " << *quadPoint << endln;
 
+    // Evaluate the basis once for all the quadrature points of the patch
+    this->precomputeBasis();
+
     int idU;
     int idV;
     Vector xiE(2);
@@ -970,6 +973,84 @@ bool IGASurfacePatch::generateIGA2DMesh(int & noElems, int & noElemsU, int & noE
 }
 
 int IGASurfacePatch::Nurbs2DBasis2ndDers(double xi, double eta, Vector & R, Vector & dRdxi, Vector & dRdeta, Vector & dR2dxi, Vector & dR2deta, Vector & dR2dxideta)
+{
+    // The elements ask for the same quadrature points at every state
+    // determination, so those come from the cache filled by setDomain().
+    // Any other point is evaluated.
+    auto found = basisIndex.find(std::make_pair(xi, eta));
+    if (found == basisIndex.end())
+        return this->evalNurbs2DBasis2ndDers(xi, eta, R, dRdxi, dRdeta, dR2dxi, dR2deta, dR2dxideta);
+
+    int nf = (P + 1) * (Q + 1);
+    const double *basis = &basisCache[found->second];
+    for (int k = 0; k < nf; ++k)
+    {
+        R(k)          = basis[k];
+        dRdxi(k)      = basis[k +   nf];
+        dRdeta(k)     = basis[k + 2*nf];
+        dR2dxi(k)     = basis[k + 3*nf];
+        dR2deta(k)    = basis[k + 4*nf];
+        dR2dxideta(k) = basis[k + 5*nf];
+    }
+
+    return 0;
+}
+
+void IGASurfacePatch::precomputeBasis(void)
+{
+    basisCache.clear();
+    basisIndex.clear();
+
+    // same quadrature as the IGAKLShell elements
+    int nf = (P + 1) * (Q + 1);
+    int ngauss = (P + 1) * (Q + 1);
+
+    Matrix quadPt(ngauss, 2);
+    Vector quadWt(ngauss);
+    gaussQuad2dNurbs(P + 1, Q + 1, &quadPt, &quadWt);
+
+    Vector R(nf), dRdxi(nf), dRdeta(nf), dR2dxi(nf), dR2deta(nf), dR2dxideta(nf);
+    Vector xiE(2), etaE(2);
+
+    basisCache.reserve((size_t)noElems * ngauss * 6 * nf);
+
+    for (int e = 0; e < noElems; ++e)
+    {
+        int idU = (*index)(e, 0);
+        int idV = (*index)(e, 1);
+
+        xiE(0) = (*elRangeU)(idU, 0);
+        xiE(1) = (*elRangeU)(idU, 1);
+        etaE(0) = (*elRangeV)(idV, 0);
+        etaE(1) = (*elRangeV)(idV, 1);
+
+        for (int gp = 0; gp < ngauss; ++gp)
+        {
+            double xi = parent2ParametricSpace(xiE, quadPt(gp, 0));
+            double eta = parent2ParametricSpace(etaE, quadPt(gp, 1));
+
+            std::pair<double,double> pt(xi, eta);
+            if (basisIndex.find(pt) != basisIndex.end())
+                continue;
+
+            R.Zero();
+            dRdxi.Zero();
+            dRdeta.Zero();
+            dR2dxi.Zero();
+            dR2deta.Zero();
+            dR2dxideta.Zero();
+            this->evalNurbs2DBasis2ndDers(xi, eta, R, dRdxi, dRdeta, dR2dxi, dR2deta, dR2dxideta);
+
+            basisIndex[pt] = (int)basisCache.size();
+            const Vector *blocks[6] = {&R, &dRdxi, &dRdeta, &dR2dxi, &dR2deta, &dR2dxideta};
+            for (int b = 0; b < 6; ++b)
+                for (int k = 0; k < nf; ++k)
+                    basisCache.push_back((*blocks[b])(k));
+        }
+    }
+}
+
+int IGASurfacePatch::evalNurbs2DBasis2ndDers(double xi, double eta, Vector & R, Vector & dRdxi, Vector & dRdeta, Vector & dR2dxi, Vector & dR2deta, Vector & dR2dxideta)
 {
     bool result = false;
 
@@ -44,6 +44,9 @@
 #include <Information.h>
 #include <Parameter.h>
 
+#include <vector>
+#include <unordered_map>
+
 
 
 typedef enum 
@@ -99,6 +102,8 @@ public:
 private:
     bool generateIGA2DMesh(int & noElems, int & noElemsU, int & noElemsV);//, Matrix & index, Matrix & elRangeU, Matrix & elRangeV, Matrix & elConnU, Matrix & elConnV);
     bool buildConnectivity(int p, const Vector & knotVec, int nE, Matrix * elRange, Matrix * elConn);
+    int evalNurbs2DBasis2ndDers(double xi, double eta, Vector& R, Vector& dRdxi, Vector& dRdeta, Vector& dR2dxi, Vector& dR2deta, Vector& dR2dxideta);
+    void precomputeBasis(void);
 
     int setParameter(const char **argv, int argc, Parameter &param);
     int updateParameter(int parameterID, Information &info);
@@ -147,6 +152,20 @@ private:
     // Guardar puntero a vector de posiciones
     Vector* Zk;
 
+    // Basis functions and derivatives at the quadrature points of all the
+    // elements, evaluated once by setDomain(). Each point holds six
+    // consecutive blocks of (P+1)*(Q+1) values: R, dRdxi, dRdeta, dR2dxi,
+    // dR2deta and dR2dxideta. basisIndex maps the parametric point to the
+    // offset of its first block.
+    struct PointHash {
+        size_t operator()(const std::pair<double,double> &pt) const {
+            std::hash<double> h;
+            return h(pt.first) ^ (h(pt.second) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+    std::vector<double> basisCache;
+    std::unordered_map<std::pair<double,double>, int, PointHash> basisIndex;
+
 
 
 };
@@ -29,25 +29,27 @@
 #include <Domain.h>
 #include <Element.h>
 #include <ElementIter.h>
+#include <NDMaterial.h>
 #include <Channel.h>
 
 MaterialStageParameter::MaterialStageParameter(int theTag, int materialTag)
 :Parameter(theTag, PARAMETER_TAG_MaterialStageParameter),
- theMaterialTag(materialTag)
+ theMaterialTag(materialTag), theMaterials(0), numMaterials(0)
 {
 
 }
 
 MaterialStageParameter::MaterialStageParameter()
   :Parameter(), 
-   theMaterialTag(0)
+   theMaterialTag(0), theMaterials(0), numMaterials(0)
 {
 
 }
 
 MaterialStageParameter::~MaterialStageParameter()
 {
-
+  if (theMaterials != 0)
+    delete [] theMaterials;
 }
 
 void
@@ -82,9 +84,40 @@ MaterialStageParameter::setDomain(Domain *theDomain)
 
   theResult = 0;
 
+  // keep the NDMaterials found, unless there are other objects as well
+  if (theMaterials != 0)
+    delete [] theMaterials;
+  theMaterials = 0;
+  numMaterials = 0;
+
+  if (numObjects > 0) {
+    theMaterials = new NDMaterial *[numObjects];
+    for (int i = 0; i < numObjects; i++) {
+      NDMaterial *theMaterial = dynamic_cast<NDMaterial *>(theObjects[i]);
+      if (theMaterial == 0) {
+	delete [] theMaterials;
+	theMaterials = 0;
+	numMaterials = 0;
+	break;
+      }
+      theMaterials[numMaterials++] = theMaterial;
+    }
+  }
+
   return;
 }
 
+int
+MaterialStageParameter::update(int newValue)
+{
+  // switch the materials directly, otherwise through updateParameter()
+  if (numMaterials > 0 &&
+      NDMaterial::setMaterialStageGroups(numMaterials, theMaterials, newValue) == 0)
+    return 0;
+
+  return this->Parameter::update(newValue);
+}
+
 int 
 MaterialStageParameter::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -27,6 +27,7 @@
 
 #include <Parameter.h>
 class Domain;
+class NDMaterial;
 
 class MaterialStageParameter : public Parameter
 {
@@ -36,6 +37,8 @@ class MaterialStageParameter : public Parameter
   virtual ~MaterialStageParameter();
 
   virtual void Print(OPS_Stream &s, int flag =0);
+
+  virtual int update(int newValue); 
   
   virtual int sendSelf(int commitTag, Channel &theChannel);  
   virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -50,6 +53,10 @@ class MaterialStageParameter : public Parameter
   int theMaterialTag;
   int theParameterID;
 
+  // the NDMaterials found by setDomain(), switched directly by update()
+  NDMaterial **theMaterials;
+  int numMaterials;
+
   Domain *theDomain;
 };
 
@@ -56,6 +56,7 @@
 
 #include <MapOfTaggedObjects.h>
 #include <MapOfTaggedObjectsIter.h>
+#include <HashOfTaggedObjects.h>
 
 #include <SingleDomEleIter.h>
 #include <SingleDomNodIter.h>
@@ -81,20 +82,48 @@
 #include <FEM_ObjectBroker.h>
 
 #include <DomainModalProperties.h>
+#include <NodeSearchGrid.h>
+#include <ResponseCache.h>
+#include <AnalysisProfiler.h>
 
 //
 // global variables
 //
 
-Domain       *ops_TheActiveDomain = 0;
-double        ops_Dt = 0.0;
-bool          ops_InitialStateAnalysis = false;
-int           ops_Creep = 0;
+thread_local Domain       *ops_TheActiveDomain = 0;
+thread_local double        ops_Dt = 0.0;
+thread_local bool          ops_InitialStateAnalysis = false;
+thread_local int           ops_Creep = 0;
+
+// updates an element, adding the time taken to its measured cost when
+// the element costs are being measured for load balancing; frozen and
+// inactive elements are not updated, nor those with a constant tangent
+// when skipConstant is set
+static inline int
+updateElement(Element *theEle, bool skipConstant)
+{
+  if (theEle->isFrozen() == true || theEle->isActive() == false)
+    return 0;
+
+  if (skipConstant == true && theEle->hasConstantTangent() == true)
+    return 0;
+
+  ProfileClass cost(ProfileClass::Element, theEle);
+
+  if (Element::measureCost == false)
+    return theEle->update();
+
+  double start = Element::wallTime();
+  int res = theEle->update();
+  theEle->addMeasuredCost(Element::wallTime() - start);
+  return res;
+}
 
 Domain::Domain()
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), onlyElementsRemovedFlag(false), lastStructuralGeoTag(0),
+ theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false),  nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
@@ -103,15 +132,19 @@ Domain::Domain()
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ parallelUpdate(false), deterministic(false), updateListBuiltFlag(false), skipConstantTangent(false),
+ theUpdateEles(0), numUpdateEles(0), numParallelEles(0),
+ theNodeGrid(0), nodeGridBuiltFlag(false),
+ stateStamp(0), parameterStamp(0), theResponseCache(0)
 {
   
     // init the arrays for storing the domain components
-    theElements = new MapOfTaggedObjects();
-    theNodes    = new MapOfTaggedObjects();
-    theSPs      = new MapOfTaggedObjects();
-    thePCs      = new MapOfTaggedObjects();
-    theMPs      = new MapOfTaggedObjects();    
+    theElements = new HashOfTaggedObjects();
+    theNodes    = new HashOfTaggedObjects();
+    theSPs      = new HashOfTaggedObjects();
+    thePCs      = new HashOfTaggedObjects();
+    theMPs      = new HashOfTaggedObjects();    
     theLoadPatterns = new MapOfTaggedObjects();
     theParameters   = new MapOfTaggedObjects();
 
@@ -150,7 +183,8 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
 	       int numLoadPatterns)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), onlyElementsRemovedFlag(false), lastStructuralGeoTag(0),
+ theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0),
@@ -158,14 +192,18 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ parallelUpdate(false), deterministic(false), updateListBuiltFlag(false), skipConstantTangent(false),
+ theUpdateEles(0), numUpdateEles(0), numParallelEles(0),
+ theNodeGrid(0), nodeGridBuiltFlag(false),
+ stateStamp(0), parameterStamp(0), theResponseCache(0)
 {
     // init the arrays for storing the domain components
-    theElements = new MapOfTaggedObjects();
-    theNodes    = new MapOfTaggedObjects();
-    theSPs      = new MapOfTaggedObjects();
-    thePCs      = new MapOfTaggedObjects();
-    theMPs      = new MapOfTaggedObjects();    
+    theElements = new HashOfTaggedObjects();
+    theNodes    = new HashOfTaggedObjects();
+    theSPs      = new HashOfTaggedObjects();
+    thePCs      = new HashOfTaggedObjects();
+    theMPs      = new HashOfTaggedObjects();    
     theLoadPatterns = new MapOfTaggedObjects();
     theParameters   = new MapOfTaggedObjects();
     
@@ -206,7 +244,8 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
 	       TaggedObjectStorage &theLoadPatternsStorage)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), onlyElementsRemovedFlag(false), lastStructuralGeoTag(0),
+ theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
@@ -219,7 +258,11 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ parallelUpdate(false), deterministic(false), updateListBuiltFlag(false), skipConstantTangent(false),
+ theUpdateEles(0), numUpdateEles(0), numParallelEles(0),
+ theNodeGrid(0), nodeGridBuiltFlag(false),
+ stateStamp(0), parameterStamp(0), theResponseCache(0)
 {
     // init the arrays for storing the domain components
     thePCs      = new MapOfTaggedObjects();
@@ -270,7 +313,8 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
 Domain::Domain(TaggedObjectStorage &theStorage)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), onlyElementsRemovedFlag(false), lastStructuralGeoTag(0),
+ theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
@@ -278,7 +322,11 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ parallelUpdate(false), deterministic(false), updateListBuiltFlag(false), skipConstantTangent(false),
+ theUpdateEles(0), numUpdateEles(0), numParallelEles(0),
+ theNodeGrid(0), nodeGridBuiltFlag(false),
+ stateStamp(0), parameterStamp(0), theResponseCache(0)
 {
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
@@ -394,6 +442,9 @@ Domain::~Domain()
 
   if (theModalDampingFactors != 0)
     delete theModalDampingFactors;
+
+  if (theNodeGrid != 0)
+    delete theNodeGrid;
   
   int i;
   for (i=0; i<numRecorders; i++) 
@@ -415,6 +466,10 @@ Domain::~Domain()
   
   theRecorders = 0;
   numRecorders = 0;
+
+  // after the recorders, which release the responses they share
+  if (theResponseCache != 0)
+    delete theResponseCache;
 }
 
 
@@ -473,6 +528,28 @@ Domain::addElement(Element *element)
 
 
 
+// only the hashed storage can grow without reorganising the objects it
+// already holds; the other storage types grow on their own as needed
+int
+Domain::reserveNodes(int numNodes)
+{
+  HashOfTaggedObjects *theStorage = dynamic_cast<HashOfTaggedObjects *>(theNodes);
+  if (theStorage == 0 || numNodes <= 0)
+    return 0;
+  return theStorage->setSize(theStorage->getNumComponents() + numNodes);
+}
+
+
+int
+Domain::reserveElements(int numElements)
+{
+  HashOfTaggedObjects *theStorage = dynamic_cast<HashOfTaggedObjects *>(theElements);
+  if (theStorage == 0 || numElements <= 0)
+    return 0;
+  return theStorage->setSize(theStorage->getNumComponents() + numElements);
+}
+
+
 // void addNode(Node *);
 //	Method to add a Node to the model.
 
@@ -857,6 +934,7 @@ Domain::addParameter(Parameter *theParam)
   }
 
   theParam->setDomain(this);
+  parameterStamp++;
   return result;
 }
 
@@ -984,6 +1062,8 @@ Domain::clearAll(void) {
   // clean out the containers
   theElements->clearAll();
   theNodes->clearAll();
+  if (theResponseCache != 0)
+    theResponseCache->invalidate();
   theSPs->clearAll();
   thePCs->clearAll();
   theMPs->clearAll();
@@ -1033,6 +1113,8 @@ Domain::clearAll(void) {
   
   // rest the flag to be as initial
   hasDomainChangedFlag = false;
+  onlyElementsRemovedFlag = false;
+  lastStructuralGeoTag = 0;
   nodeGraphBuiltFlag = false;
   eleGraphBuiltFlag = false;
   
@@ -1044,6 +1126,8 @@ Domain::clearAll(void) {
 
   // rest the flag to be as initial
   hasDomainChangedFlag = false;
+  onlyElementsRemovedFlag = false;
+  lastStructuralGeoTag = 0;
   nodeGraphBuiltFlag = false;
   eleGraphBuiltFlag = false;
 
@@ -1054,6 +1138,17 @@ Domain::clearAll(void) {
   if (theElementGraph != 0)
     delete theElementGraph;
   theElementGraph = 0;
+
+  if (theUpdateEles != 0)
+    delete [] theUpdateEles;
+  theUpdateEles = 0;
+  numUpdateEles = 0;
+  numParallelEles = 0;
+  updateListBuiltFlag = false;
+
+  if (theNodeGrid != 0)
+    theNodeGrid->clear();
+  nodeGridBuiltFlag = false;
   
   dbEle =0; dbNod =0; dbSPs =0; dbPCs = 0; dbMPs =0; dbLPs = 0; dbParam = 0;
 }
@@ -1069,8 +1164,15 @@ Domain::removeElement(int tag)
   if (mc == 0) 
       return 0;
 
-  // otherwise mark the domain as having changed
+  // otherwise mark the domain as having changed, noting if removing
+  // elements is all that has been done to it since the last stamp
+  bool onlyRemoved = (hasDomainChangedFlag == false || onlyElementsRemovedFlag == true);
   this->domainChange();
+  onlyElementsRemovedFlag = onlyRemoved;
+
+  // the responses of the element are no longer shared or used for queries
+  if (theResponseCache != 0)
+    theResponseCache->invalidate(tag);
   
   // perform a downward cast to an Element (safe as only Element added to
   // this container, 0 the Elements DomainPtr and return the result of the cast  
@@ -1092,6 +1194,10 @@ Domain::removeNode(int tag)
   // mark the domain has having changed 
   this->domainChange();
 
+  // the elements of the node may hold responses that refer to it
+  if (theResponseCache != 0)
+    theResponseCache->invalidate();
+
   // adjust node bounds 
   resetBounds = true;
   
@@ -1275,6 +1381,7 @@ Domain::removeParameter(int tag)
     theParameters->removeComponent(tag);
 
     numParameters--;
+    parameterStamp++;
   }
 
   return 0;
@@ -1735,6 +1842,13 @@ Domain::getElementResponse(int eleTag, const char **argv, int argc)
 	return &responseData;
       }
     }
+
+    // a response a recorder holds is evaluated once for the step
+    if (theResponseCache != 0) {
+      const Vector *data = theResponseCache->getData(eleTag, argv, argc);
+      if (data != 0)
+	return data;
+    }
 	
     DummyStream dummy;
     Response *theResponse = theEle->setResponse(argv, argc, dummy);
@@ -1950,6 +2064,8 @@ Domain::unsetLoadConstant(void)
 int
 Domain::initialize(void)
 {
+  stateStamp++;
+
   Element *elePtr;
   ElementIter &theElemIter = this->getElements();    
   while ((elePtr = theElemIter()) != 0) 
@@ -1990,6 +2106,7 @@ int
 Domain::record(bool fromAnalysis)
 {
   int res = 0;
+  ProfilePhase phase(AnalysisProfiler::RecorderOutput);
 
   // invoke record on all recorders
   for (int i=0; i<numRecorders; i++)
@@ -2005,6 +2122,8 @@ Domain::record(bool fromAnalysis)
 int
 Domain::commit(void)
 {
+    ProfilePhase phase(AnalysisProfiler::Commit);
+
     // 
     // first invoke commit on all nodes and elements in the domain
     //
@@ -2014,11 +2133,16 @@ Domain::commit(void)
       nodePtr->commitState();
     }
 
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
-      elePtr->commitState();
+    // the thread safe elements concurrently when parallelUpdate is set
+    if (parallelUpdate == false || this->commitElementsInParallel(false) < 0) {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
+	if (elePtr->isFrozen() == false)
+	  elePtr->commitState();
+      }
     }
+    stateStamp++;
 
     // set the new committed time in the domain
     committedTime = currentTime;
@@ -2037,6 +2161,8 @@ Domain::commit(void)
 int
 Domain::revertToLastCommit(void)
 {
+    stateStamp++;
+
     // 
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
@@ -2046,10 +2172,14 @@ Domain::revertToLastCommit(void)
     while ((nodePtr = theNodeIter()) != 0)
 	nodePtr->revertToLastCommit();
     
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
-	elePtr->revertToLastCommit();
+    // the thread safe elements concurrently when parallelUpdate is set
+    if (parallelUpdate == false || this->commitElementsInParallel(true) < 0) {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
+	if (elePtr->isFrozen() == false)
+	  elePtr->revertToLastCommit();
+      }
     }
 
     // set the current time and load factor in the domain to last committed
@@ -2065,6 +2195,8 @@ Domain::revertToLastCommit(void)
 int
 Domain::revertToStart(void)
 {
+    stateStamp++;
+
     // 
     // first invoke revertToLastCommit  on all nodes and 
     // elements in the domain
@@ -2101,19 +2233,55 @@ Domain::revertToStart(void)
 int
 Domain::update(void)
 {
+  ProfilePhase phase(AnalysisProfiler::ElementUpdate);
+
+  stateStamp++;
+
   // set the global constants
   ops_Dt = dT;
   ops_TheActiveDomain = this;
 
+  // the contact search sees the positions of this update
+  if (nodeGridBuiltFlag == true)
+    theNodeGrid->update();
+
   int ok = 0;
 
-  // invoke update on all the ele's
-  ElementIter &theEles = this->getElements();
-  Element *theEle;
+  if (parallelUpdate == true) {
 
-  while ((theEle = theEles()) != 0) {
-    ops_TheActiveElement = theEle;
-    ok += theEle->update();
+    if (updateListBuiltFlag == false)
+      if (this->buildUpdateList() < 0)
+	return -1;
+
+    // elements not certified thread safe are updated in serial first
+    for (int i=numParallelEles; i<numUpdateEles; i++) {
+      ops_TheActiveElement = theUpdateEles[i];
+      ok += updateElement(theUpdateEles[i], skipConstantTangent);
+    }
+
+    // then the thread safe elements are updated concurrently, each
+    // thread with the globals of this update
+    OPS_ThreadGlobals theGlobals;
+#pragma omp parallel reduction(+:ok)
+    {
+      theGlobals.install();
+#pragma omp for schedule(dynamic, 64)
+      for (int i=0; i<numParallelEles; i++) {
+	ops_TheActiveElement = theUpdateEles[i];
+	ok += updateElement(theUpdateEles[i], skipConstantTangent);
+      }
+    }
+
+  } else {
+
+    // invoke update on all the ele's
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
+
+    while ((theEle = theEles()) != 0) {
+      ops_TheActiveElement = theEle;
+      ok += updateElement(theEle, skipConstantTangent);
+    }
   }
 
   if (ok != 0)
@@ -2123,6 +2291,132 @@ Domain::update(void)
 }
 
 
+// commitElementsInParallel(revert):
+//	invokes commitState(), or revertToLastCommit() when revert is
+//	true, on the elements of the update list that are not frozen, the
+//	thread safe ones concurrently; returns -1 if the list could not be
+//	built, in which case nothing has been done.
+
+int
+Domain::commitElementsInParallel(bool revert)
+{
+  if (updateListBuiltFlag == false)
+    if (this->buildUpdateList() < 0)
+      return -1;
+
+  for (int i=numParallelEles; i<numUpdateEles; i++) {
+    if (theUpdateEles[i]->isFrozen() == true)
+      continue;
+    if (revert == true)
+      theUpdateEles[i]->revertToLastCommit();
+    else
+      theUpdateEles[i]->commitState();
+  }
+
+  OPS_ThreadGlobals theGlobals;
+#pragma omp parallel
+  {
+    theGlobals.install();
+#pragma omp for schedule(dynamic, 64)
+    for (int i=0; i<numParallelEles; i++)
+      if (theUpdateEles[i]->isFrozen() == false) {
+	if (revert == true)
+	  theUpdateEles[i]->revertToLastCommit();
+	else
+	  theUpdateEles[i]->commitState();
+      }
+  }
+
+  return 0;
+}
+
+int
+Domain::buildUpdateList(void)
+{
+  if (theUpdateEles != 0)
+    delete [] theUpdateEles;
+  theUpdateEles = 0;
+  numUpdateEles = 0;
+  numParallelEles = 0;
+
+  int numEle = theElements->getNumComponents();
+  if (numEle != 0) {
+    theUpdateEles = new Element *[numEle];
+    if (theUpdateEles == 0) {
+      opserr << "Domain::buildUpdateList - out of memory\n";
+      return -1;
+    }
+  }
+
+  // thread safe elements are placed at the front of the array, the
+  // remaining ones are placed from the back
+  int numSerial = 0;
+  ElementIter &theEles = this->getElements();
+  Element *theEle;
+  while ((theEle = theEles()) != 0) {
+    if (theEle->isThreadSafe() == true)
+      theUpdateEles[numParallelEles++] = theEle;
+    else
+      theUpdateEles[numEle - 1 - numSerial++] = theEle;
+  }
+
+  numUpdateEles = numParallelEles + numSerial;
+  updateListBuiltFlag = true;
+
+  return 0;
+}
+
+
+void
+Domain::setParallelUpdate(bool onOff)
+{
+  parallelUpdate = onOff;
+  updateListBuiltFlag = false;
+}
+
+
+bool
+Domain::getParallelUpdate(void) const
+{
+  return parallelUpdate;
+}
+
+
+void
+Domain::setSkipConstantTangent(bool onOff)
+{
+  skipConstantTangent = onOff;
+}
+
+
+// the broad phase for contact elements; the grid is built on the first
+// request and again after the domain has changed, update() refreshes the
+// node positions before the elements are updated
+NodeSearchGrid &
+Domain::getNodeSearchGrid(void)
+{
+  if (theNodeGrid == 0)
+    theNodeGrid = new NodeSearchGrid();
+
+  if (nodeGridBuiltFlag == false) {
+    theNodeGrid->build(*this);
+    nodeGridBuiltFlag = true;
+  }
+
+  return *theNodeGrid;
+}
+
+
+ResponseCache &
+Domain::getResponseCache(void)
+{
+  if (theResponseCache == 0)
+    theResponseCache = new ResponseCache(*this);
+
+  return *theResponseCache;
+}
+
+
 int
 Domain::update(double newTime, double dT)
 {
@@ -2146,6 +2440,8 @@ Domain::updateParameter(int tag, int value)
   // convert to a parameter & update
   Parameter *result = (Parameter *)mc;
   int res = result->update(value);
+  stateStamp++;
+  parameterStamp++;
 
   return res;
 }
@@ -2164,6 +2460,8 @@ Domain::updateParameter(int tag, double value)
 
   Parameter *theParam = (Parameter *)mc;
   int res =  theParam->update(value);
+  stateStamp++;
+  parameterStamp++;
   return res;
 }
 
@@ -2297,6 +2595,19 @@ void
 Domain::setDomainChangeStamp(int newStamp)
 {
     currentGeoTag = newStamp;
+    lastStructuralGeoTag = newStamp;
+}
+
+
+// returns true if since the domain change stamp was stamp the only thing
+// done to the domain has been to remove elements; an analysis can then
+// keep its numbering and system of equation, dropping the removed ones.
+bool
+Domain::onlyElementsRemovedSince(int stamp)
+{
+    if (hasDomainChangedFlag == true && onlyElementsRemovedFlag == false)
+	return false;
+    return lastStructuralGeoTag <= stamp;
 }
 
 
@@ -2304,6 +2615,10 @@ void
 Domain::domainChange(void)
 {
     hasDomainChangedFlag = true;
+    onlyElementsRemovedFlag = false;
+    updateListBuiltFlag = false;
+    nodeGridBuiltFlag = false;
+    stateStamp++;
 }
 
 
@@ -2324,6 +2639,9 @@ Domain::hasDomainChanged(void)
     hasDomainChangedFlag = false;
     if (result == true) {
 	currentGeoTag++;
+	if (onlyElementsRemovedFlag == false)
+	    lastStructuralGeoTag = currentGeoTag;
+	onlyElementsRemovedFlag = false;
 	nodeGraphBuiltFlag = false;
 	eleGraphBuiltFlag = false;
     }
@@ -2505,6 +2823,61 @@ int Domain::flushRecorders() {
     return 0;
 }
 
+// forgets the recorders without deleting them, for a forked copy of the
+// process that must neither write to nor close the files they hold open
+int
+Domain::releaseRecorders(void)
+{
+    if (theRecorders != 0)
+      delete [] theRecorders;
+
+    theRecorders = 0;
+    numRecorders = 0;
+    return 0;
+}
+
+// exchanges the recorders with the num in recorders, so a set can be held
+// aside while others record; the caller owns the ones it gets back
+void
+Domain::swapRecorders(Recorder **&recorders, int &num)
+{
+    Recorder **otherRecorders = recorders;
+    int numOther = num;
+
+    recorders = theRecorders;
+    num = numRecorders;
+
+    theRecorders = otherRecorders;
+    numRecorders = numOther;
+}
+
+int
+Domain::restoreState(FE_Datastore &theDatastore, int cTag)
+{
+    // recvSelf() rebuilding the domain would otherwise delete them
+    Recorder **keptRecorders = theRecorders;
+    int numKept = numRecorders;
+    theRecorders = 0;
+    numRecorders = 0;
+
+    int res = theDatastore.restoreState(cTag);
+
+    // the responses shared until now are of the elements replaced
+    if (theResponseCache != 0)
+      theResponseCache->invalidate();
+
+    for (int i=0; i<numKept; i++)
+      if (keptRecorders[i] != 0) {
+	this->addRecorder(*keptRecorders[i]);
+	keptRecorders[i]->domainChanged();
+      }
+
+    if (keptRecorders != 0)
+      delete [] keptRecorders;
+
+    return res;
+}
+
 int
 Domain::removeRecorder(int tag)
 {
@@ -3680,6 +4053,20 @@ Domain::getRecorder(int tag)
 	return res;
 }
 
+size_t
+Domain::getRecorderMemoryUsage(int &num)
+{
+  size_t result = 0;
+  num = 0;
+  for (int i=0; i<numRecorders; i++)
+    if (theRecorders[i] != 0) {
+      result += theRecorders[i]->getMemoryUsage();
+      num++;
+    }
+
+  return result;
+}
+
 
 
 
@@ -76,6 +76,9 @@ class FEM_ObjectBroker;
 class TaggedObjectStorage;
 
 class DomainModalProperties;
+class NodeSearchGrid;
+class ResponseCache;
+class FE_Datastore;
 
 class Domain
 {
@@ -97,6 +100,9 @@ class Domain
     // methods to populate a domain
     virtual  bool addElement(Element *);
     virtual  bool addNode(Node *);
+    // make room for this many more nodes/elements before adding in bulk
+    virtual  int reserveNodes(int numNodes);
+    virtual  int reserveElements(int numElements);
     virtual  bool addSP_Constraint(SP_Constraint *);
     virtual  bool addPressure_Constraint(Pressure_Constraint *);
     virtual  int  addSP_Constraint(int axisDirn, 
@@ -192,6 +198,38 @@ class Domain
     virtual  int  update(double newTime, double dT);
     virtual  int  updateParameter(int tag, int value);
     virtual  int  updateParameter(int tag, double value);    
+
+    // methods for concurrent element state determination, used by
+    // update() and by the IncrementalIntegrator assembly loops
+    virtual  void setParallelUpdate(bool onOff);
+    virtual  bool getParallelUpdate(void) const;
+
+    // while set, the parallel sums (assembly, explicit forces, norms) are
+    // made in an order fixed by the model alone, so the results are the
+    // same bit for bit whatever the number of threads
+    void setDeterministic(bool onOff) {deterministic = onOff;};
+    bool getDeterministic(void) const {return deterministic;};
+
+    // while set, update() leaves out the elements with a constant
+    // tangent, e.g. during the trial points of a line search
+    virtual  void setSkipConstantTangent(bool onOff);
+
+    // spatial search of the current node positions, for contact elements
+    virtual  NodeSearchGrid &getNodeSearchGrid(void);
+
+    // element responses shared by the recorders, evaluated once for each
+    // state stamp; the stamp changes whenever the state of the domain may
+    virtual  ResponseCache &getResponseCache(void);
+    int getStateStamp(void) const {return stateStamp;};
+
+    // changes whenever a Parameter is added, removed or updated; the
+    // element terms kept because they do not change with the state are
+    // kept together with it and formed again when it changes
+    int getParameterStamp(void) const {return parameterStamp;};
+
+    // for changes of the element properties not made through a Parameter,
+    // e.g. a material stage switched directly on the materials
+    void parameterChange(void) {stateStamp++; parameterStamp++;};
     
     virtual  int  analysisStep(double dT);
     virtual  int  eigenAnalysis(int numMode, bool generalized, bool findSmallest);
@@ -212,6 +250,7 @@ class Domain
     virtual bool getDomainChangeFlag(void);    
     virtual void domainChange(void);    
     virtual void setDomainChangeStamp(int newStamp);
+    virtual bool onlyElementsRemovedSince(int stamp);
 
 
     // methods for output
@@ -220,6 +259,13 @@ class Domain
     virtual int  removeRecorder(int tag);
     virtual int  record(bool fromAnalysis=true);
     virtual int flushRecorders();
+    virtual int releaseRecorders(void);
+    virtual void swapRecorders(Recorder **&recorders, int &num);
+
+    // restores the domain saved under commitTag in theDatastore keeping
+    // the recorders, which are set to the restored domain
+    virtual int restoreState(FE_Datastore &theDatastore, int commitTag);
+    virtual size_t getRecorderMemoryUsage(int &numRecorders);
 
     virtual int  addRegion(MeshRegion &theRegion);    	
     virtual MeshRegion *getRegion(int region);    	
@@ -248,6 +294,8 @@ class Domain
 
     virtual int buildEleGraph(Graph *theEleGraph);
     virtual int buildNodeGraph(Graph *theNodeGraph);
+    virtual int buildUpdateList(void);
+    virtual int commitElementsInParallel(bool revert);
 
     Recorder **theRecorders;
     int numRecorders;    
@@ -258,6 +306,8 @@ class Domain
     double dT;                        // difference between committed and current time
     int	   currentGeoTag;             // an integer used to mark if domain has changed
     bool   hasDomainChangedFlag;      // a bool flag used to indicate if GeoTag needs to be ++
+    bool   onlyElementsRemovedFlag;   // true if the pending change is only the removal of elements
+    int    lastStructuralGeoTag;      // the last value of currentGeoTag not due to element removal only
     int    theDbTag;                   // the Domains unique database tag == 0
     int    lastGeoSendTag;            // the value of currentGeoTag when sendSelf was last invoked
     int dbEle, dbNod, dbSPs, dbPCs, dbMPs, dbLPs, dbParam; // database tags for storing info
@@ -309,6 +359,24 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    // element list used by update() when parallelUpdate is set; the
+    // first numParallelEles are those reporting isThreadSafe() true
+    bool parallelUpdate;
+    bool deterministic;
+    bool updateListBuiltFlag;
+    bool skipConstantTangent;
+    Element **theUpdateEles;
+    int numUpdateEles;
+    int numParallelEles;
+
+    // grid of the node positions, refreshed in update()
+    NodeSearchGrid *theNodeGrid;
+    bool nodeGridBuiltFlag;
+
+    int stateStamp;
+    int parameterStamp;
+    ResponseCache *theResponseCache;
 };
 
 #endif
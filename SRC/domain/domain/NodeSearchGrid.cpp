@@ -0,0 +1,308 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of NodeSearchGrid.
+//
+// What: "@(#) NodeSearchGrid.cpp, revA"
+
+#include <NodeSearchGrid.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Vector.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+
+#include <math.h>
+#include <float.h>
+
+// the cell indices are packed in 21 bits each; cells that are 2^21 cells
+// apart share a key, which only costs some extra distance checks
+#define GRID_BITS 21
+#define GRID_MASK ((1LL << GRID_BITS) - 1)
+
+NodeSearchGrid::NodeSearchGrid()
+:ndm(0), h(1.0)
+{
+
+}
+
+
+NodeSearchGrid::~NodeSearchGrid()
+{
+
+}
+
+
+void
+NodeSearchGrid::clear(void)
+{
+  theNodes.clear();
+  x.clear();
+  cellOf.clear();
+  slot.clear();
+  cells.clear();
+  ndm = 0;
+}
+
+
+int
+NodeSearchGrid::build(Domain &theDomain, double cellSize)
+{
+  this->clear();
+
+  int numNodes = theDomain.getNumNodes();
+  theNodes.reserve(numNodes);
+
+  Node *theNode;
+  NodeIter &theIter = theDomain.getNodes();
+  while ((theNode = theIter()) != 0) {
+    int size = theNode->getCrds().Size();
+    if (size > ndm)
+      ndm = size;
+    theNodes.push_back(theNode);
+  }
+  if (ndm > 3)
+    ndm = 3;
+
+  numNodes = (int)theNodes.size();
+  x.assign(3*numNodes, 0.0);
+  cellOf.assign(numNodes, 0);
+  slot.assign(numNodes, -1);
+
+  for (int i = 0; i < numNodes; i++)
+    this->position(i);
+
+  h = cellSize;
+  if (h <= 0.0) {
+    // about one node per cell over the extent of the mesh
+    double volume = 1.0;
+    int numDim = 0;
+    double maxExtent = 0.0;
+    for (int d = 0; d < ndm; d++) {
+      double lo = DBL_MAX, hi = -DBL_MAX;
+      for (int i = 0; i < numNodes; i++) {
+	double xi = x[3*i+d];
+	if (xi < lo) lo = xi;
+	if (xi > hi) hi = xi;
+      }
+      double extent = (numNodes > 0) ? hi - lo : 0.0;
+      if (extent > maxExtent)
+	maxExtent = extent;
+      if (extent > 0.0) {
+	volume *= extent;
+	numDim++;
+      }
+    }
+    if (numDim > 0 && numNodes > 1)
+      h = pow(volume/numNodes, 1.0/numDim);
+    if (h <= 0.0 || h < 1.0e-6*maxExtent)
+      h = (maxExtent > 0.0) ? maxExtent/numNodes : 1.0;
+  }
+
+  cells.reserve(numNodes);
+  for (int i = 0; i < numNodes; i++)
+    this->insert(i, this->cellKey(&x[3*i]));
+
+  return 0;
+}
+
+
+int
+NodeSearchGrid::update(void)
+{
+  int numNodes = (int)theNodes.size();
+  for (int i = 0; i < numNodes; i++) {
+    this->position(i);
+    CellKey key = this->cellKey(&x[3*i]);
+    if (key != cellOf[i]) {
+      this->remove(i);
+      this->insert(i, key);
+    }
+  }
+
+  return 0;
+}
+
+
+int
+NodeSearchGrid::findNodes(const double *center, double radius, ID &nodeTags) const
+{
+  double xMin[3] = {0.0, 0.0, 0.0};
+  double xMax[3] = {0.0, 0.0, 0.0};
+  for (int d = 0; d < ndm; d++) {
+    xMin[d] = center[d] - radius;
+    xMax[d] = center[d] + radius;
+  }
+
+  this->collect(xMin, xMax, center, radius, nodeTags);
+  return nodeTags.Size();
+}
+
+
+int
+NodeSearchGrid::findNodes(const double *xMin, const double *xMax, ID &nodeTags) const
+{
+  this->collect(xMin, xMax, 0, 0.0, nodeTags);
+  return nodeTags.Size();
+}
+
+
+// the current position of node loc, its coordinates plus the
+// translational part of its trial displacement
+void
+NodeSearchGrid::position(int loc)
+{
+  Node *theNode = theNodes[loc];
+  const Vector &crd = theNode->getCrds();
+  const Vector &disp = theNode->getTrialDisp();
+  double *pos = &x[3*loc];
+
+  int numCrd = crd.Size();
+  int numDisp = disp.Size();
+  for (int d = 0; d < ndm; d++) {
+    pos[d] = (d < numCrd) ? crd(d) : 0.0;
+    if (d < numDisp && d < numCrd)
+      pos[d] += disp(d);
+  }
+}
+
+
+NodeSearchGrid::CellKey
+NodeSearchGrid::cellKey(long long i, long long j, long long k) const
+{
+  return ((i & GRID_MASK) << (2*GRID_BITS)) | ((j & GRID_MASK) << GRID_BITS) | (k & GRID_MASK);
+}
+
+
+NodeSearchGrid::CellKey
+NodeSearchGrid::cellKey(const double *pos) const
+{
+  long long ijk[3] = {0, 0, 0};
+  for (int d = 0; d < ndm; d++)
+    ijk[d] = (long long)floor(pos[d]/h);
+
+  return this->cellKey(ijk[0], ijk[1], ijk[2]);
+}
+
+
+void
+NodeSearchGrid::insert(int loc, CellKey key)
+{
+  std::vector<int> &members = cells[key];
+  cellOf[loc] = key;
+  slot[loc] = (int)members.size();
+  members.push_back(loc);
+}
+
+
+void
+NodeSearchGrid::remove(int loc)
+{
+  std::unordered_map<CellKey, std::vector<int> >::iterator it = cells.find(cellOf[loc]);
+  if (it == cells.end())
+    return;
+
+  // the last node of the cell takes the place of the removed one
+  std::vector<int> &members = it->second;
+  int last = members.back();
+  members[slot[loc]] = last;
+  slot[last] = slot[loc];
+  members.pop_back();
+  slot[loc] = -1;
+
+  if (members.empty())
+    cells.erase(it);
+}
+
+
+// the tags of the nodes inside the box, and if center is given also
+// within distance radius of it
+void
+NodeSearchGrid::collect(const double *xMin, const double *xMax,
+			const double *center, double radius, ID &nodeTags) const
+{
+  nodeTags.resize(0);
+
+  int numNodes = (int)theNodes.size();
+  if (numNodes == 0)
+    return;
+
+  long long lo[3] = {0, 0, 0};
+  long long hi[3] = {0, 0, 0};
+  double numCells = 1.0;
+  for (int d = 0; d < ndm; d++) {
+    lo[d] = (long long)floor(xMin[d]/h);
+    hi[d] = (long long)floor(xMax[d]/h);
+    if (hi[d] < lo[d])
+      return;
+    numCells *= (double)(hi[d] - lo[d] + 1);
+  }
+
+  double r2 = radius*radius;
+  int numFound = 0;
+
+  // a box spanning more cells than there are nodes is cheaper to
+  // search by going through the nodes
+  if (numCells > numNodes) {
+    for (int i = 0; i < numNodes; i++) {
+      const double *pos = &x[3*i];
+      bool inside = true;
+      double dist2 = 0.0;
+      for (int d = 0; d < ndm; d++) {
+	if (pos[d] < xMin[d] || pos[d] > xMax[d])
+	  inside = false;
+	if (center != 0)
+	  dist2 += (pos[d]-center[d])*(pos[d]-center[d]);
+      }
+      if (inside == true && (center == 0 || dist2 <= r2))
+	nodeTags[numFound++] = theNodes[i]->getTag();
+    }
+    return;
+  }
+
+  for (long long i = lo[0]; i <= hi[0]; i++) {
+    for (long long j = lo[1]; j <= hi[1]; j++) {
+      for (long long k = lo[2]; k <= hi[2]; k++) {
+	std::unordered_map<CellKey, std::vector<int> >::const_iterator it =
+	  cells.find(this->cellKey(i, j, k));
+	if (it == cells.end())
+	  continue;
+
+	const std::vector<int> &members = it->second;
+	for (size_t m = 0; m < members.size(); m++) {
+	  int loc = members[m];
+	  const double *pos = &x[3*loc];
+	  bool inside = true;
+	  double dist2 = 0.0;
+	  for (int d = 0; d < ndm; d++) {
+	    if (pos[d] < xMin[d] || pos[d] > xMax[d])
+	      inside = false;
+	    if (center != 0)
+	      dist2 += (pos[d]-center[d])*(pos[d]-center[d]);
+	  }
+	  // with wrapped keys a cell may also hold far away nodes
+	  if (inside == true && (center == 0 || dist2 <= r2))
+	    nodeTags[numFound++] = theNodes[loc]->getTag();
+	}
+      }
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NodeSearchGrid_h
+#define NodeSearchGrid_h
+
+// Description: This file contains the class definition for NodeSearchGrid.
+// NodeSearchGrid is a uniform grid of cubic cells, hashed on the cell
+// indices, holding the current positions (coordinates plus trial
+// displacements) of the nodes of a Domain. It is the broad phase of a
+// contact search: elements ask for the nodes near a point or inside a box
+// and only test those. update() refreshes the positions, moving between
+// cells only the nodes that have left their cell; build() starts over
+// and is needed when nodes are added to or removed from the Domain.
+//
+// What: "@(#) NodeSearchGrid.h, revA"
+
+#include <vector>
+#include <unordered_map>
+
+class Domain;
+class Node;
+class ID;
+
+class NodeSearchGrid
+{
+  public:
+    NodeSearchGrid();
+    ~NodeSearchGrid();
+
+    // cellSize <= 0 picks one from the spacing of the nodes
+    int build(Domain &theDomain, double cellSize = 0.0);
+    int update(void);
+    void clear(void);
+
+    // the tags of the nodes within distance radius of x, or inside the
+    // box [xMin, xMax]; x, xMin & xMax have getNDM() components
+    int findNodes(const double *x, double radius, ID &nodeTags) const;
+    int findNodes(const double *xMin, const double *xMax, ID &nodeTags) const;
+
+    int getNDM(void) const {return ndm;};
+    int getNumNodes(void) const {return (int)theNodes.size();};
+    double getCellSize(void) const {return h;};
+    const double *getPosition(int loc) const {return &x[3*loc];};
+
+  private:
+    typedef long long CellKey;
+
+    void position(int loc);
+    CellKey cellKey(const double *pos) const;
+    CellKey cellKey(long long i, long long j, long long k) const;
+    void insert(int loc, CellKey key);
+    void remove(int loc);
+    void collect(const double *xMin, const double *xMax,
+		 const double *center, double radius, ID &nodeTags) const;
+
+    int ndm;
+    double h;                          // cell size
+    std::vector<Node *> theNodes;
+    std::vector<double> x;             // 3 per node, unused ones 0
+    std::vector<CellKey> cellOf;       // the cell a node is in
+    std::vector<int> slot;             // where in that cell's list it is
+    std::unordered_map<CellKey, std::vector<int> > cells;
+};
+
+#endif
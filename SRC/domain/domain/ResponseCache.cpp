@@ -0,0 +1,167 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// ResponseCache.
+//
+// What: "@(#) ResponseCache.cpp, revA"
+
+#include <ResponseCache.h>
+#include <Domain.h>
+#include <Response.h>
+#include <Information.h>
+#include <Vector.h>
+#include <stdio.h>
+
+// the Response a recorder holds: all those of one entry evaluate the
+// entry's Response only when the state of the domain has changed
+class SharedResponse : public Response
+{
+ public:
+  SharedResponse(ResponseCache &cache, ResponseCache::Entry *entry)
+    :Response(), theCache(&cache), theEntry(entry) {}
+  ~SharedResponse() {theCache->release(theEntry);}
+
+  int getResponse(void) {return theCache->evaluate(*theEntry);}
+  int getResponseSensitivity(int gradNumber)
+    {return theEntry->theResponse->getResponseSensitivity(gradNumber);}
+  Information &getInformation(void) {return theEntry->theResponse->getInformation();}
+
+  void Print(OPS_Stream &s, int flag = 0) {theEntry->theResponse->Print(s, flag);}
+  void Print(ofstream &s, int flag = 0) {theEntry->theResponse->Print(s, flag);}
+
+ private:
+  ResponseCache *theCache;
+  ResponseCache::Entry *theEntry;
+};
+
+
+ResponseCache::ResponseCache(Domain &domain)
+  :theDomain(&domain), theEntries(), generation(0)
+{
+
+}
+
+ResponseCache::~ResponseCache()
+{
+  std::map<std::string, Entry *>::iterator it;
+  for (it = theEntries.begin(); it != theEntries.end(); it++) {
+    delete it->second->theResponse;
+    delete it->second;
+  }
+}
+
+std::string
+ResponseCache::key(int eleTag, const char **argv, int argc)
+{
+  char buffer[16];
+  snprintf(buffer, 16, "%d", eleTag);
+  std::string theKey(buffer);
+  for (int i=0; i<argc; i++) {
+    theKey += '\x1f';
+    theKey += argv[i];
+  }
+  return theKey;
+}
+
+Response *
+ResponseCache::share(int eleTag, const char **argv, int argc, Response *theResponse)
+{
+  if (theResponse == 0)
+    return 0;
+
+  std::string theKey = key(eleTag, argv, argc);
+
+  Entry *theEntry;
+  std::map<std::string, Entry *>::iterator it = theEntries.find(theKey);
+  if (it != theEntries.end() && it->second->generation == generation) {
+    // theResponse has written its header to the recorder's stream and is
+    // not needed further, the one already held gives the same data
+    theEntry = it->second;
+    delete theResponse;
+  } else {
+    theEntry = new Entry;
+    theEntry->key = theKey;
+    theEntry->theResponse = theResponse;
+    theEntry->refCount = 0;
+    theEntry->stamp = theDomain->getStateStamp() - 1;
+    theEntry->result = 0;
+    theEntry->generation = generation;
+    theEntries[theKey] = theEntry;
+  }
+
+  theEntry->refCount++;
+  return new SharedResponse(*this, theEntry);
+}
+
+const Vector *
+ResponseCache::getData(int eleTag, const char **argv, int argc)
+{
+  if (theEntries.empty())
+    return 0;
+
+  std::map<std::string, Entry *>::iterator it = theEntries.find(key(eleTag, argv, argc));
+  if (it == theEntries.end())
+    return 0;
+
+  Entry *theEntry = it->second;
+  if (theEntry->generation != generation || this->evaluate(*theEntry) < 0)
+    return 0;
+
+  return &(theEntry->theResponse->getInformation().getData());
+}
+
+void
+ResponseCache::invalidate(int eleTag)
+{
+  // the keys of the element are its tag, alone or followed by '\x1f' & the
+  // arguments, they sort together from the tag
+  std::string theKey = key(eleTag, 0, 0);
+  std::map<std::string, Entry *>::iterator it = theEntries.lower_bound(theKey);
+  while (it != theEntries.end() && it->first.compare(0, theKey.size(), theKey) == 0) {
+    if (it->first.size() == theKey.size() || it->first[theKey.size()] == '\x1f')
+      it->second->generation = generation - 1;
+    it++;
+  }
+}
+
+int
+ResponseCache::evaluate(Entry &theEntry)
+{
+  int stamp = theDomain->getStateStamp();
+  if (theEntry.stamp != stamp) {
+    theEntry.result = theEntry.theResponse->getResponse();
+    theEntry.stamp = stamp;
+  }
+  return theEntry.result;
+}
+
+void
+ResponseCache::release(Entry *theEntry)
+{
+  if (--(theEntry->refCount) > 0)
+    return;
+
+  std::map<std::string, Entry *>::iterator it = theEntries.find(theEntry->key);
+  if (it != theEntries.end() && it->second == theEntry)
+    theEntries.erase(it);
+  delete theEntry->theResponse;
+  delete theEntry;
+}
@@ -0,0 +1,86 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ResponseCache_h
+#define ResponseCache_h
+
+// Description: This file contains the class definition for ResponseCache.
+// A ResponseCache lets the recorders of a Domain, and the queries made of
+// it, share the element Response objects they set up. Each distinct
+// element tag & response arguments pair is held once; the Response handed
+// to a recorder by share() evaluates it at most once per state stamp of
+// the Domain, so two recorders asking for the same forces of the same
+// elements cost one getResponse() of each element per step.
+//
+// What: "@(#) ResponseCache.h, revA"
+
+#include <map>
+#include <string>
+
+class Domain;
+class Response;
+class Vector;
+
+class ResponseCache
+{
+  public:
+    ResponseCache(Domain &theDomain);
+    ~ResponseCache();
+
+    // takes theResponse set up by a recorder for element eleTag and
+    // returns the Response it should keep, one sharing the evaluation of
+    // any other request of the same element and arguments; the caller
+    // owns the returned object
+    Response *share(int eleTag, const char **argv, int argc, Response *theResponse);
+
+    // the current data of a shared response, 0 if no recorder holds one
+    const Vector *getData(int eleTag, const char **argv, int argc);
+
+    int getNumShared(void) const {return (int)theEntries.size();};
+
+    // the elements have been replaced, the responses held until now are
+    // no longer shared or used for queries
+    void invalidate(void) {generation++;};
+
+    // the same for the responses of element eleTag only, as it is removed
+    void invalidate(int eleTag);
+
+  private:
+    friend class SharedResponse;
+
+    struct Entry {
+      std::string key;
+      Response *theResponse;
+      int refCount;
+      int stamp;               // state stamp of the domain when last evaluated
+      int result;
+      int generation;
+    };
+
+    static std::string key(int eleTag, const char **argv, int argc);
+    int evaluate(Entry &theEntry);
+    void release(Entry *theEntry);
+
+    Domain *theDomain;
+    std::map<std::string, Entry *> theEntries;
+    int generation;
+};
+
+#endif
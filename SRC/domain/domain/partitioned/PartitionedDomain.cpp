@@ -86,7 +86,8 @@ typedef MAP_VERTEX::iterator     MAP_VERTEX_ITERATOR;
 PartitionedDomain::PartitionedDomain()
   : Domain(),
     theSubdomains(0), theDomainPartitioner(0),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    measureCost(false), balanceInterval(1), commitsSinceBalance(0), balanceRatio(0.0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -109,7 +110,8 @@ PartitionedDomain::PartitionedDomain()
 PartitionedDomain::PartitionedDomain(DomainPartitioner &thePartitioner)
   : Domain(),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    measureCost(false), balanceInterval(1), commitsSinceBalance(0), balanceRatio(0.0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -136,7 +138,8 @@ PartitionedDomain::PartitionedDomain(int numNodes, int numElements,
 
   : Domain(numNodes, 0, numSPs, numMPs, numLoadPatterns),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    measureCost(false), balanceInterval(1), commitsSinceBalance(0), balanceRatio(0.0)
 {
   elements = new MapOfTaggedObjects();//(numElements);
   theSubdomains = new ArrayOfTaggedObjects(numSubdomains);
@@ -1018,20 +1021,60 @@ PartitionedDomain::setRayleighDampingFactors(double alphaM, double betaK, double
 }
 
 
+void
+PartitionedDomain::setParallelUpdate(bool onOff)
+{
+  this->Domain::setParallelUpdate(onOff);
+
+  // do the same for all the subdomains
+  if (theSubdomains != 0) {
+    ArrayOfTaggedObjectsIter theSubsIter(*theSubdomains);
+    TaggedObject *theObject;
+    while ((theObject = theSubsIter()) != 0) {
+      Subdomain *theSub = (Subdomain *)theObject;
+      theSub->setParallelUpdate(onOff);
+    }
+  }
+}
+
+
 int
 PartitionedDomain::update(void)
 {
   int res = this->Domain::update();
 
-  // do the same for all the subdomains
+  // do the same for all the subdomains; with parallel update on, the
+  // subdomains in this process that are thread safe are done concurrently
   if (theSubdomains != 0) {
+    int numSubs = theSubdomains->getNumComponents();
+    Subdomain **theSubs = new Subdomain *[numSubs];
+    int numParallel = 0;
+    int numSerial = 0;
+    bool parallel = this->getParallelUpdate();
     ArrayOfTaggedObjectsIter theSubsIter(*theSubdomains);
     TaggedObject *theObject;
-    while ((theObject = theSubsIter()) != 0) {
+    while ((theObject = theSubsIter()) != 0 && numParallel + numSerial < numSubs) {
       Subdomain *theSub = (Subdomain *)theObject;
-      theSub->computeNodalResponse();
-      res += theSub->update();
+      if (parallel == true && theSub->isThreadSafe() == true)
+	theSubs[numParallel++] = theSub;
+      else
+	theSubs[numSubs - 1 - numSerial++] = theSub;
     }
+
+    for (int i=numSubs-numSerial; i<numSubs; i++) {
+      theSubs[i]->computeNodalResponse();
+      res += theSubs[i]->update();
+    }
+
+    OPS_ThreadGlobals theGlobals;
+#pragma omp parallel for reduction(+:res) schedule(dynamic, 1)
+    for (int i=0; i<numParallel; i++) {
+      theGlobals.install();
+      theSubs[i]->computeNodalResponse();
+      res += theSubs[i]->update();
+    }
+
+    delete [] theSubs;
   }
 
 #ifdef _PARALLEL_PROCESSING
@@ -1285,12 +1328,33 @@ PartitionedDomain::commit(void)
   // opserr << "Subdomain # MASTER " << " update_time = " << this->Domain::update_time_committed << endln;
 
 
-  // now we load balance if we have subdomains and a partitioner
+  // now we load balance if we have subdomains, a partitioner and the
+  // element costs are measured; the costs are those since the last check
   int numSubdomains = this->getNumSubdomains();
-  if (numSubdomains != 0 && theDomainPartitioner != 0)  {
-    // opserr << "Subdomain # MASTER " << " BALANCING! " << endln;
+  if (numSubdomains != 0 && theDomainPartitioner != 0 && measureCost == true &&
+      ++commitsSinceBalance >= balanceInterval)  {
+    commitsSinceBalance = 0;
     Graph &theSubGraphs = this->getSubdomainGraph();
-    theDomainPartitioner->balance(theSubGraphs);
+
+    double maxCost = 0.0;
+    double sumCost = 0.0;
+    SubdomainIter &theSubs = this->getSubdomains();
+    Subdomain *theSub;
+    while ((theSub = theSubs()) != 0) {
+      Vertex *theVertex = theSubGraphs.getVertexPtr(theSub->getTag());
+      if (theVertex == 0)
+	continue;
+      double cost = theVertex->getWeight();
+      sumCost += cost;
+      if (cost > maxCost)
+	maxCost = cost;
+    }
+
+    if (balanceRatio <= 0.0 ||
+	(sumCost > 0.0 && maxCost*numSubdomains/sumCost > balanceRatio)) {
+      // opserr << "Subdomain # MASTER " << " BALANCING! " << endln;
+      theDomainPartitioner->balance(theSubGraphs);
+    }
   }
 
   return 0;
@@ -1506,7 +1570,18 @@ PartitionedDomain::partition(int numPartitions, bool usingMain, int mainPartitio
   DomainPartitioner *thePartitioner = this->getPartitioner();
   if (thePartitioner != 0) {
     thePartitioner->setPartitionedDomain(*this);
+
+    // the nodes, elements, loads .. go to the remote subdomains in batches
+    SubdomainIter &theSubs = this->getSubdomains();
+    Subdomain *theSub;
+    while ((theSub = theSubs()) != 0)
+      theSub->setBatchedTransfer(true);
+
     result =  thePartitioner->partition(numPartitions, usingMain, mainPartitionID, specialElementTag);
+
+    SubdomainIter &theSubs2 = this->getSubdomains();
+    while ((theSub = theSubs2()) != 0)
+      theSub->setBatchedTransfer(false);
   } else {
     opserr << "PartitionedDomain::partition(int numPartitions) - no associated partitioner\n";
     return -1;
@@ -1582,6 +1657,10 @@ PartitionedDomain::addSubdomain(Subdomain *theSubdomain)
   bool result = theSubdomains->addComponent(theSubdomain);
   if (result == true) {
     theSubdomain->setDomain(this);
+    if (this->getParallelUpdate() == true)
+      theSubdomain->setParallelUpdate(true);
+    if (measureCost == true)
+      theSubdomain->setMeasureCost(true);
     this->domainChange();
   }
 
@@ -1589,6 +1668,30 @@ PartitionedDomain::addSubdomain(Subdomain *theSubdomain)
 
 }
 
+int
+PartitionedDomain::setLoadBalancing(int numCommits, double ratio)
+{
+  if (numCommits < 1) {
+    opserr << "WARNING PartitionedDomain::setLoadBalancing - number of commits " << numCommits << " < 1\n";
+    return -1;
+  }
+
+  balanceInterval = numCommits;
+  balanceRatio = ratio;
+  commitsSinceBalance = 0;
+
+  // the elements in all the processes start timing themselves
+  measureCost = true;
+  Element::measureCost = true;
+  SubdomainIter &theSubs = this->getSubdomains();
+  Subdomain *theSub;
+  while ((theSub = theSubs()) != 0)
+    theSub->setMeasureCost(true);
+
+  return 0;
+}
+
+
 int
 PartitionedDomain::getNumSubdomains(void)
 {
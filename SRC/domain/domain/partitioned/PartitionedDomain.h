@@ -103,6 +103,7 @@ class PartitionedDomain: public Domain
     virtual  void applyLoad(double pseudoTime);
     virtual  void setLoadConstant(void);    
     virtual  int  setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc);
+    virtual  void setParallelUpdate(bool onOff);
 
     virtual  int commit(void);    
     virtual  int revertToLastCommit(void);        
@@ -140,6 +141,11 @@ class PartitionedDomain: public Domain
     virtual Node *removeExternalNode(int tag);        
     virtual Graph &getSubdomainGraph(void);
 
+    // starts measuring the element costs & rebalances every numCommits
+    // commits if the most loaded subdomain has more than ratio times the
+    // mean cost; ratio <= 0 rebalances at every check
+    virtual int setLoadBalancing(int numCommits, double ratio);
+
     // nodal methods required in domain interface for parallel interprter
     virtual const Vector *getNodeResponse(int nodeTag, NodeResponseType); 
     virtual const Vector *getElementResponse(int eleTag, const char **argv, int argc); 
@@ -174,6 +180,10 @@ class PartitionedDomain: public Domain
     Graph *mySubdomainGraph;    // a graph of subdomain connectivity
 
     bool has_sent_yet;
+    bool measureCost;           // element costs measured for balancing
+    int balanceInterval;        // commits between balance checks
+    int commitsSinceBalance;
+    double balanceRatio;        // max/mean subdomain cost that triggers it
 };
 
 #endif
@@ -145,8 +145,9 @@ GroundMotion::integrate(TimeSeries *theSeries, double delta)
     return 0;
   }
 
-  // integrate the series, if no vel series exists set it to new one
-  TimeSeries *theNewSeries = theIntegrator->integrate(theSeries, delta);
+  // integrate the series, if no vel series exists set it to new one; the
+  // integral of a record is shared by all the motions using the record
+  TimeSeries *theNewSeries = theIntegrator->integrateShared(theSeries, delta);
 
   if(theNewSeries == 0) {
     opserr << "GroundMotion::integrate - no TimeSeriesIntegrator failed to integrate\n";
@@ -32,6 +32,7 @@
 // What: "@(#) Node.h, revA"
    
 #include <Node.h>
+#include <NodeStateArena.h>
 #include <stdlib.h>
 
 #include <Element.h>
@@ -59,6 +60,27 @@
 
 #include <OPS_Globals.h>
 #include <elementAPI.h>
+#include <MemoryReport.h>
+
+static void
+zeroSensitivity(std::vector<double *> &theColumns)
+{
+  for (size_t i=0; i<theColumns.size(); i++)
+    if (theColumns[i] != 0) {
+      delete [] theColumns[i];
+      theColumns[i] = 0;
+    }
+}
+
+static size_t
+sensitivitySize(const std::vector<double *> &theColumns, int numDOF)
+{
+  size_t bytes = theColumns.capacity()*sizeof(double *);
+  for (size_t i=0; i<theColumns.size(); i++)
+    if (theColumns[i] != 0)
+      bytes += numDOF*sizeof(double);
+  return bytes;
+}
 
 Matrix **Node::theMatrices = 0;
 int Node::numMatrices = 0;
@@ -220,6 +242,85 @@ int OPS_Node()
     return 0;
 }
 
+// nodes tags coords <-ndf ndf>
+// creates many nodes in one call; tags is a list of n node tags and coords
+// the list of their n*ndm coordinates, node after node
+int OPS_Nodes()
+{
+    Domain* theDomain = OPS_GetDomain();
+    int ndm = OPS_GetNDM();
+    int ndf = OPS_GetNDF();
+
+    if(theDomain == 0) {
+	opserr<<"WARNING: domain is not defined\n";
+	return -1;
+    }
+    if(ndm<=0 || ndf<=0) {
+	opserr<<"WARNING: system ndm and ndf are zero\n";
+	return -1;
+    }
+
+    if(OPS_GetNumRemainingInputArgs() < 2) {
+	opserr<<"insufficient number of arguments: nodes tags coords <-ndf ndf>\n";
+	return -1;
+    }
+
+    Vector tags, crds;
+    int numNodes = 0, numCrds = 0;
+    if(OPS_GetDoubleListInput(&numNodes, &tags) < 0) {
+	opserr<<"WARNING nodes - tags is not a list of integers\n";
+	return -1;
+    }
+    if(OPS_GetDoubleListInput(&numCrds, &crds) < 0) {
+	opserr<<"WARNING nodes - coords is not a list of doubles\n";
+	return -1;
+    }
+    if(numCrds != numNodes*ndm) {
+	opserr<<"WARNING nodes - "<<numNodes<<" tags need "<<numNodes*ndm;
+	opserr<<" coordinates, "<<numCrds<<" given\n";
+	return -1;
+    }
+
+    while(OPS_GetNumRemainingInputArgs() > 0) {
+	const char* type = OPS_GetString();
+	if(strcmp(type,"-ndf")==0 || strcmp(type,"-NDF")==0) {
+	    int numdata = 1;
+	    if(OPS_GetIntInput(&numdata, &ndf) < 0 || ndf <= 0) {
+		opserr << "WARNING: failed to read ndf\n";
+		return -1;
+	    }
+	}
+    }
+
+    theDomain->reserveNodes(numNodes);
+
+    for(int i=0; i<numNodes; i++) {
+	int tag = int(tags(i));
+	if(tag != tags(i)) {
+	    opserr<<"WARNING nodes - tag "<<tags(i)<<" is not an integer\n";
+	    return -1;
+	}
+
+	const double *x = &crds(i*ndm);
+	Node* theNode = 0;
+	if(ndm == 1) {
+	    theNode = new Node(tag,ndf,x[0]);
+	} else if(ndm == 2) {
+	    theNode = new Node(tag,ndf,x[0],x[1]);
+	} else {
+	    theNode = new Node(tag,ndf,x[0],x[1],x[2]);
+	}
+
+	if(theDomain->addNode(theNode) == false) {
+	    opserr<<"WARNING: failed to add node "<<tag<<" to domain\n";
+	    delete theNode;
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
 // for FEM_Object Broker to use
 Node::Node(int theClassTag)
 :DomainComponent(0,theClassTag), 
@@ -235,9 +336,6 @@ Node::Node(int theClassTag)
   // for FEM_ObjectBroker, recvSelf() must be invoked on object
 
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -260,9 +358,6 @@ Node::Node(int tag, int theClassTag)
   // their own data structures.
   
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -281,9 +376,6 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  index(-1), reaction(0), displayLocation(0), temperature(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -314,9 +406,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  reaction(0), displayLocation(0), temperature(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -349,9 +438,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  reaction(0), displayLocation(0), temperature(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -385,9 +471,6 @@ Node::Node(const Node &otherNode, bool copyMass)
    reaction(0), displayLocation(0), temperature(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
-  dispSensitivity = 0;
-  velSensitivity = 0;
-  accSensitivity = 0;
   parameterID = 0;
   // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -503,13 +586,13 @@ Node::~Node()
 	delete unbalLoad;
     
     if (disp != 0)
-	delete [] disp;
+	NodeStateArena::release(disp, 4*numberDOF);
 
     if (vel != 0)
-	delete [] vel;
+	NodeStateArena::release(vel, 2*numberDOF);
 
     if (accel != 0)
-	delete [] accel;
+	NodeStateArena::release(accel, 2*numberDOF);
 
     if (mass != 0)
 	delete mass;
@@ -524,12 +607,9 @@ Node::~Node()
       delete theEigenvectors;
 
     // AddingSensitivity:BEGIN ///////////////////////////////////////
-    if (dispSensitivity != 0)
-      delete dispSensitivity;
-    if (velSensitivity != 0)
-	delete velSensitivity;
-    if (accSensitivity != 0)
-      delete accSensitivity;
+    zeroSensitivity(dispSensitivity);
+    zeroSensitivity(velSensitivity);
+    zeroSensitivity(accSensitivity);
     // AddingSensitivity:END /////////////////////////////////////////
 
     if (reaction != 0)
@@ -985,12 +1065,15 @@ Node::addInertiaLoadToUnbalance(const Vector &accelG, double fact)
       }  
   }
 
-  // form - fact * M*R*accelG and add it to the unbalanced load
+  // form - fact * M*(R*accelG) and add it to the unbalanced load, the
+  // product R*accelG avoids forming M*R for every node at every step
   //(*unbalLoad) -= ((*mass) * (*R) * accelG)*fact;
 
-  Matrix MR(mass->noRows(), R->noCols());
-  MR.addMatrixProduct(0.0, *mass, *R, 1.0);
-  unbalLoad->addMatrixVector(1.0, MR, accelG, -fact);
+  static thread_local Vector RaccelG;
+  if (RaccelG.Size() != numberDOF)
+    RaccelG.resize(numberDOF);
+  RaccelG.addMatrixVector(0.0, *R, accelG, 1.0);
+  unbalLoad->addMatrixVector(1.0, *mass, RaccelG, -fact);
 
   return 0;
 }
@@ -1094,24 +1177,17 @@ Node::commitState()
 {
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
-      for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
-      }
+      memcpy(&disp[numberDOF], disp, numberDOF*sizeof(double));
+      memset(&disp[2*numberDOF], 0, 2*numberDOF*sizeof(double));
     }		    
     
     // check vel exists, if does set commit = trial    
-    if (trialVel != 0) {
-      for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
-    }
+    if (trialVel != 0)
+      memcpy(&vel[numberDOF], vel, numberDOF*sizeof(double));
     
     // check accel exists, if does set commit = trial        
-    if (trialAccel != 0) {
-      for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
-    }
+    if (trialAccel != 0)
+      memcpy(&accel[numberDOF], accel, numberDOF*sizeof(double));
 
     if (rotation != nullptr)
         rotation[0] = rotation[1];
@@ -1126,24 +1202,17 @@ Node::revertToLastCommit()
 {
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
-      for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
-      }
+      memcpy(disp, &disp[numberDOF], numberDOF*sizeof(double));
+      memset(&disp[2*numberDOF], 0, 2*numberDOF*sizeof(double));
     }
     
     // check vel exists, if does set trial = last commit
-    if (vel != 0) {
-      for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
-    }
+    if (vel != 0)
+      memcpy(vel, &vel[numberDOF], numberDOF*sizeof(double));
 
     // check accel exists, if does set trial = last commit
-    if (accel != 0) {    
-      for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
-    }
+    if (accel != 0)
+      memcpy(accel, &accel[numberDOF], numberDOF*sizeof(double));
 
     if (rotation != nullptr)
         rotation[1] = rotation[0];
@@ -1156,22 +1225,16 @@ int
 Node::revertToStart()
 {
     // check disp exists, if does set all to zero
-    if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
-    }
+    if (disp != 0)
+      memset(disp, 0, 4*numberDOF*sizeof(double));
 
     // check vel exists, if does set all to zero
-    if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
-    }
+    if (vel != 0)
+      memset(vel, 0, 2*numberDOF*sizeof(double));
 
     // check accel exists, if does set all to zero
-    if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
-    }
+    if (accel != 0)
+      memset(accel, 0, 2*numberDOF*sizeof(double));
     
     if (unbalLoad != 0) 
 	(*unbalLoad) *= 0;
@@ -1184,14 +1247,9 @@ Node::revertToStart()
 
 
 // AddingSensitivity: BEGIN /////////////////////////////////
-	if (dispSensitivity != 0) 
-		dispSensitivity->Zero();
-	
-	if (velSensitivity != 0) 
-		velSensitivity->Zero();
-	
-	if (accSensitivity != 0) 
-		accSensitivity->Zero();
+	zeroSensitivity(dispSensitivity);
+	zeroSensitivity(velSensitivity);
+	zeroSensitivity(accSensitivity);
 // AddingSensitivity: END ///////////////////////////////////
 
 
@@ -1727,6 +1785,31 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
 
 
+size_t
+Node::getMemoryUsage(void)
+{
+  size_t bytes = MemoryReport::objectSize(this);
+
+  // the state arrays of the arena & the Vectors that wrap them
+  if (disp != 0)
+    bytes += 4*numberDOF*sizeof(double) + 4*sizeof(Vector);
+  if (vel != 0)
+    bytes += 2*numberDOF*sizeof(double) + 2*sizeof(Vector);
+  if (accel != 0)
+    bytes += 2*numberDOF*sizeof(double) + 2*sizeof(Vector);
+
+  bytes += MemoryReport::vectorSize(Crd) + MemoryReport::vectorSize(unbalLoad)
+    + MemoryReport::vectorSize(unbalLoadWithInertia) + MemoryReport::vectorSize(reaction)
+    + MemoryReport::vectorSize(displayLocation);
+  bytes += MemoryReport::matrixSize(R) + MemoryReport::matrixSize(mass)
+    + MemoryReport::matrixSize(theEigenvectors);
+  bytes += sensitivitySize(dispSensitivity, numberDOF) + sensitivitySize(velSensitivity, numberDOF)
+    + sensitivitySize(accSensitivity, numberDOF);
+
+  return bytes;
+}
+
+
 void
 Node::Print(OPS_Stream &s, int flag)
 {
@@ -1815,15 +1898,13 @@ int
 Node::createDisp(void)
 {
   // trial , committed, incr = (committed-trial)
-  disp = new double[4*numberDOF];
+  disp = NodeStateArena::allocate(4*numberDOF);
     
   if (disp == 0) {
-    opserr << "WARNING - Node::createDisp() ran out of memory for array of size " << 2*numberDOF << endln;
+    opserr << "WARNING - Node::createDisp() ran out of memory for array of size " << 4*numberDOF << endln;
 			    
     return -1;
   }
-  for (int i=0; i<4*numberDOF; i++)
-    disp[i] = 0.0;
     
   commitDisp = new Vector(&disp[numberDOF], numberDOF); 
   trialDisp = new Vector(disp, numberDOF);
@@ -1843,14 +1924,12 @@ Node::createDisp(void)
 int
 Node::createVel(void)
 {
-    vel = new double[2*numberDOF];
+    vel = NodeStateArena::allocate(2*numberDOF);
     
     if (vel == 0) {
       opserr << "WARNING - Node::createVel() ran out of memory for array of size " << 2*numberDOF << endln;
       return -1;
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = 0.0;
     
     commitVel = new Vector(&vel[numberDOF], numberDOF); 
     trialVel = new Vector(vel, numberDOF);
@@ -1867,14 +1946,12 @@ Node::createVel(void)
 int
 Node::createAccel(void)
 {
-    accel = new double[2*numberDOF];
+    accel = NodeStateArena::allocate(2*numberDOF);
     
     if (accel == 0) {
       opserr << "WARNING - Node::createAccel() ran out of memory for array of size " << 2*numberDOF << endln;
       return -1;
     }
-    for (int i=0; i<2*numberDOF; i++)
-	accel[i] = 0.0;
     
     commitAccel = new Vector(&accel[numberDOF], numberDOF);
     trialAccel = new Vector(accel, numberDOF);
@@ -2042,80 +2119,87 @@ Node::activateParameter(int passedParameterID)
 	return 0;
 }
 
-int 
-Node::saveDispSensitivity(const Vector &v, int gradIndex, int numGrads)
+// the sensitivities are kept per gradient; a gradient whose sensitivity
+// is zero at the node has no storage, so fixed nodes and the nodes a
+// parameter does not reach take none
+static int
+saveSensitivity(std::vector<double *> &theColumns, const Vector &v,
+		int gradIndex, int numGrads, int numDOF)
 {
-  // If the sensitivity matrices are not already created:
-  if (dispSensitivity == 0) {
-    dispSensitivity = new Matrix( numberDOF, numGrads );
-  } 
+  if ((int)theColumns.size() != numGrads) {
+    zeroSensitivity(theColumns);
+    theColumns.assign(numGrads, (double *)0);
+  }
+
+  if (gradIndex < 0 || gradIndex >= numGrads || v.Size() < numDOF)
+    return -1;
+
+  double *&theColumn = theColumns[gradIndex];
 
-  if (dispSensitivity->noRows() != numberDOF ||
-      dispSensitivity->noCols() != numGrads) {
-    delete dispSensitivity;
-    dispSensitivity = new Matrix( numberDOF, numGrads );
+  bool isZero = true;
+  for (int i=0; i<numDOF && isZero; i++)
+    if (v(i) != 0.0)
+      isZero = false;
+
+  if (isZero == true) {
+    if (theColumn != 0)
+      delete [] theColumn;
+    theColumn = 0;
+    return 0;
   }
 
-  //opserr << "Node::saveDispSens " << dispSensitivity->noRows() << ' ' << dispSensitivity->noCols() << endln;
-  for (int i=0; i<numberDOF; i++ )
-    (*dispSensitivity)(i,gradIndex) = v(i);
+  if (theColumn == 0)
+    theColumn = new double[numDOF];
+
+  for (int i=0; i<numDOF; i++)
+    theColumn[i] = v(i);
 
   return 0;
 }
 
-int 
-Node::saveVelSensitivity(const Vector &vdot, int gradIndex, int numGrads)
+static inline double
+getSensitivity(const std::vector<double *> &theColumns, int dof, int gradIndex)
 {
-  // If the sensitivity matrices are not already created:
-  if (velSensitivity == 0) {
-    velSensitivity = new Matrix( numberDOF, numGrads );
-  } 
-
-  for (int i=0; i<numberDOF; i++ )
-    (*velSensitivity)(i,gradIndex) = vdot(i);
+  if (gradIndex < 0 || gradIndex >= (int)theColumns.size() || theColumns[gradIndex] == 0)
+    return 0.0;
 
-  return 0;
+  return theColumns[gradIndex][dof-1];
 }
 
 int 
-Node::saveAccelSensitivity(const Vector &vdotdot, int gradIndex, int numGrads)
+Node::saveDispSensitivity(const Vector &v, int gradIndex, int numGrads)
 {
-  // If the sensitivity matrices are not already created:
-  if (accSensitivity == 0) {
-    accSensitivity = new Matrix( numberDOF, numGrads );
-  } 
+  return saveSensitivity(dispSensitivity, v, gradIndex, numGrads, numberDOF);
+}
 
-  for (int i=0; i<numberDOF; i++ )
-    (*accSensitivity)(i,gradIndex) = vdotdot(i);
+int 
+Node::saveVelSensitivity(const Vector &vdot, int gradIndex, int numGrads)
+{
+  return saveSensitivity(velSensitivity, vdot, gradIndex, numGrads, numberDOF);
+}
 
-  return 0;
+int 
+Node::saveAccelSensitivity(const Vector &vdotdot, int gradIndex, int numGrads)
+{
+  return saveSensitivity(accSensitivity, vdotdot, gradIndex, numGrads, numberDOF);
 }
 
 double 
 Node::getDispSensitivity(int dof, int gradIndex)
 {
-  if (dispSensitivity != 0)
-    return (*dispSensitivity)(dof-1,gradIndex);
-  else 
-    return 0.0;
+  return getSensitivity(dispSensitivity, dof, gradIndex);
 }
 
 double 
 Node::getVelSensitivity(int dof, int gradIndex)
 {
-  if (velSensitivity != 0)
-    return (*velSensitivity)(dof-1,gradIndex);
-  else
-    return 0.0;
+  return getSensitivity(velSensitivity, dof, gradIndex);
 }
 
 double 
 Node::getAccSensitivity(int dof, int gradIndex)
 {
-  if (accSensitivity != 0)
-    return (*accSensitivity)(dof-1,gradIndex);
-  else
-    return 0.0;
+  return getSensitivity(accSensitivity, dof, gradIndex);
 }
 // AddingSensitivity:END /////////////////////////////////////////
 
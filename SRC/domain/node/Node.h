@@ -39,6 +39,7 @@
 // What: "@(#) Node.h, revA"
 
 #include <DomainComponent.h>
+#include <vector>
 
 
 class Element;
@@ -134,6 +135,9 @@ class Node : public DomainComponent
     virtual void Print(OPS_Stream &s, int flag = 0);
     virtual int displaySelf(Renderer &theRenderer, int theEleMode, int theNodeMode, float fact);
 
+    // bytes of the node & the storage it owns, for the memory report
+    virtual size_t getMemoryUsage(void);
+
     // AddingSensitivity:BEGIN /////////////////////////////////////////
     int addInertiaLoadSensitivityToUnbalance(const Vector &accel, 
 					     double fact = 1.0, 
@@ -206,9 +210,10 @@ class Node : public DomainComponent
     Matrix *theEigenvectors;
 
     // AddingSensitivity:BEGIN /////////////////////////////////////////
-    Matrix *dispSensitivity;
-    Matrix *velSensitivity;
-    Matrix *accSensitivity;
+    // one column per gradient, 0 for a gradient whose sensitivity is zero
+    std::vector<double *> dispSensitivity;
+    std::vector<double *> velSensitivity;
+    std::vector<double *> accSensitivity;
     int parameterID;
     // AddingSensitivity:END ///////////////////////////////////////////
 
@@ -0,0 +1,103 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of NodeStateArena.
+//
+// What: "@(#) NodeStateArena.cpp, revA"
+
+#include <NodeStateArena.h>
+#include <string.h>
+#include <new>
+
+// doubles in each block (256 kB); arrays larger than a quarter of a block
+// are not worth pooling & go straight to the heap
+#define NODE_ARENA_BLOCK_SIZE 32768
+#define NODE_ARENA_MAX_ARRAY (NODE_ARENA_BLOCK_SIZE/4)
+
+NodeStateArena::NodeStateArena()
+:blockUsed(NODE_ARENA_BLOCK_SIZE)
+{
+
+}
+
+
+// the arena is never destroyed: nodes of a domain still alive while the
+// static objects are torn down at exit can still give their arrays back
+NodeStateArena &
+NodeStateArena::getArena(void)
+{
+  static NodeStateArena *theArena = new NodeStateArena();
+  return *theArena;
+}
+
+
+double *
+NodeStateArena::allocate(int n)
+{
+  if (n <= 0)
+    return 0;
+
+  double *array = 0;
+
+  if (n > NODE_ARENA_MAX_ARRAY) {
+    array = new (std::nothrow) double[n];
+
+  } else {
+    NodeStateArena &theArena = getArena();
+    std::lock_guard<std::mutex> lock(theArena.theMutex);
+
+    std::map<int, std::vector<double *> >::iterator it = theArena.freeArrays.find(n);
+    if (it != theArena.freeArrays.end() && !it->second.empty()) {
+      array = it->second.back();
+      it->second.pop_back();
+    } else {
+      if (theArena.blockUsed + n > NODE_ARENA_BLOCK_SIZE) {
+	double *block = new (std::nothrow) double[NODE_ARENA_BLOCK_SIZE];
+	if (block == 0)
+	  return 0;
+	theArena.blocks.push_back(block);
+	theArena.blockUsed = 0;
+      }
+      array = theArena.blocks.back() + theArena.blockUsed;
+      theArena.blockUsed += n;
+    }
+  }
+
+  if (array != 0)
+    memset(array, 0, n*sizeof(double));
+
+  return array;
+}
+
+
+void
+NodeStateArena::release(double *array, int n)
+{
+  if (array == 0 || n <= 0)
+    return;
+
+  if (n > NODE_ARENA_MAX_ARRAY)
+    delete [] array;
+  else {
+    NodeStateArena &theArena = getArena();
+    std::lock_guard<std::mutex> lock(theArena.theMutex);
+    theArena.freeArrays[n].push_back(array);
+  }
+}
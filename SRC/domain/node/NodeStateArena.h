@@ -0,0 +1,61 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for NodeStateArena.
+// NodeStateArena hands out the arrays in which a Node keeps its trial,
+// committed and incremental displacements, velocities and accelerations.
+// The arrays are carved one after the other out of large blocks, so that
+// the state of nodes created together lies together in memory and the
+// element loops and the commit of the domain walk through a few pages
+// instead of many small scattered allocations. An array given back is
+// kept on a free list for its size and handed out again; the blocks
+// themselves are only returned when the program ends. There is a single
+// arena for all the Domains of the process, nodes are created and
+// destroyed outside any Domain, so allocate() and release() lock it and
+// may be called from any thread.
+//
+// What: "@(#) NodeStateArena.h, revA"
+
+#ifndef NodeStateArena_h
+#define NodeStateArena_h
+
+#include <vector>
+#include <map>
+#include <mutex>
+
+class NodeStateArena
+{
+  public:
+    // returns an array of n doubles set to zero, 0 if out of memory
+    static double *allocate(int n);
+    // gives back an array of n doubles obtained from allocate()
+    static void release(double *array, int n);
+
+  private:
+    NodeStateArena();
+    static NodeStateArena &getArena(void);
+
+    std::vector<double *> blocks;
+    int blockUsed;                               // doubles used in the last block
+    std::map<int, std::vector<double *> > freeArrays;  // by size
+    std::mutex theMutex;                         // guards the above
+};
+
+#endif
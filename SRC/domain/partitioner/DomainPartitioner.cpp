@@ -50,6 +50,7 @@
 #include <VertexIter.h>
 #include <Graph.h>
 #include <Vector.h>
+#include <ID.h>
 #include <NodalLoad.h>
 #include <ElementalLoad.h>
 #include <NodalLoadIter.h>
@@ -57,6 +58,7 @@
 #include <LoadBalancer.h>
 #include <LoadPatternIter.h>
 #include <LoadPattern.h>
+#include <map>
  
 //#include <Timer.h>
 
@@ -734,6 +736,10 @@ DomainPartitioner::balance(Graph &theWeightedPGraph)
 	// call on the LoadBalancer to partition		
 
     // timer.start();
+	// the element vertices carry the costs measured in the subdomains,
+	// so a partition's weight follows the elements released from it
+	this->setElementWeights();
+
     // If we have a balancer, then call the balance function
 	res = theBalancer->balance(theWeightedPGraph);
 	    
@@ -1575,29 +1581,46 @@ DomainPartitioner::releaseVertex(int from,
       maxAttraction = attraction(j);
     }
 
+  Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
+  Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
+  if (fromVertex == 0 || toVertex == 0)
+    return swapVertex(from, partition, vertexTag, adjacentVertexNotInOther);
+
+  double fromWeight = fromVertex->getWeight();
+  double toWeight  = toVertex->getWeight();
+
   // swap the vertex
+  bool doSwap = false;
   if (mustReleaseToLighter == false)
-    return swapVertex(from, partition, vertexTag, adjacentVertexNotInOther);
+    doSwap = true;
   
   else { // check the other partition has a lighter load
-    Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
-    Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
-    
-    double fromWeight = fromVertex->getWeight();
-    double toWeight  = toVertex->getWeight();
-    
     if (fromWeight == toWeight)
       opserr << "DomainPartitioner::releaseVertex - TO CHANGE >= to >\n";
 
     if (fromWeight >= toWeight) {
       if (toWeight == 0.0) 
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-      if (fromWeight/toWeight > factorGreater)        
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
+	doSwap = true;
+      else if (fromWeight/toWeight > factorGreater)        
+	doSwap = true;
     }
   }
+
+  if (doSwap == false)
+    return 0;
+
+  // the element's measured cost goes with it, so the next vertex
+  // released sees the loads as they now are
+  Vertex *eleVertex = theElementGraph->getVertexPtr(vertexTag);
+  double eleWeight = (eleVertex != 0) ? eleVertex->getWeight() : 0.0;
+
+  int res = swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);
+  if (res == 0 && eleWeight != 0.0) {
+    fromVertex->setWeight(fromWeight - eleWeight);
+    toVertex->setWeight(toWeight + eleWeight);
+  }
   
-  return 0;
+  return res;
 }
 
 
@@ -1655,6 +1678,38 @@ DomainPartitioner::releaseBoundary(int from,
 }
 
 
+// sets the weight of each element vertex to the cost measured for the
+// element in its subdomain since the last balance check
+int
+DomainPartitioner::setElementWeights(void)
+{
+  if (theElementGraph == 0)
+    return 0;
+
+  std::map<int, Vertex *> eleVertex;
+  VertexIter &theVertices = theElementGraph->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0)
+    eleVertex[vertexPtr->getRef()] = vertexPtr;
+
+  static ID eleTags(0);
+  static Vector eleCosts(0);
+
+  SubdomainIter &theSubDomains = myDomain->getSubdomains();
+  Subdomain *theSubDomain;
+  while ((theSubDomain = theSubDomains()) != 0) {
+    theSubDomain->getElementCosts(eleTags, eleCosts);
+    for (int i=0; i<eleTags.Size(); i++) {
+      std::map<int, Vertex *>::iterator it = eleVertex.find(eleTags(i));
+      if (it != eleVertex.end())
+	it->second->setWeight(eleCosts(i));
+    }
+  }
+
+  return 0;
+}
+
+
 GraphPartitioner* DomainPartitioner::getGraphPartitioner()
 {
   std::cout << "DomainPartitioner::getGraphPartitioner() - thePartitioner is @ " << static_cast<void*>(&thePartitioner)  << "\n" << std::endl;
@@ -94,6 +94,8 @@ class DomainPartitioner
   protected:    
     
   private:
+    int setElementWeights(void);
+
     PartitionedDomain *myDomain; 
     GraphPartitioner  &thePartitioner;
     LoadBalancer      *theBalancer;    
@@ -112,7 +112,7 @@ LoadPattern::LoadPattern(int tag, int clasTag, double fact)
  theSeries(0), 
  currentGeoTag(0), lastGeoSendTag(-1),
  theNodalLoads(0), theElementalLoads(0), theSPs(0),
- theNodIter(0), theEleIter(0), theSpIter(0), lastChannel(0)
+ theNodIter(0), theEleIter(0), theSpIter(0), arraysGeoTag(-1), lastChannel(0)
 {
     // constructor for subclass
     theNodalLoads = new MapOfTaggedObjects();
@@ -146,7 +146,7 @@ LoadPattern::LoadPattern()
  currentGeoTag(0), lastGeoSendTag(-1),
  dbSPs(0), dbNod(0), dbEle(0), 
  theNodalLoads(0), theElementalLoads(0), theSPs(0),
- theNodIter(0), theEleIter(0), theSpIter(0), lastChannel(0)
+ theNodIter(0), theEleIter(0), theSpIter(0), arraysGeoTag(-1), lastChannel(0)
 {
     theNodalLoads = new MapOfTaggedObjects();
     theElementalLoads = new MapOfTaggedObjects();
@@ -179,7 +179,7 @@ LoadPattern::LoadPattern(int tag, double fact)
  currentGeoTag(0), lastGeoSendTag(-1),
  dbSPs(0), dbNod(0), dbEle(0), 
  theNodalLoads(0), theElementalLoads(0), theSPs(0),
- theNodIter(0), theEleIter(0), theSpIter(0), lastChannel(0)
+ theNodIter(0), theEleIter(0), theSpIter(0), arraysGeoTag(-1), lastChannel(0)
 {
     theNodalLoads = new MapOfTaggedObjects();
     theElementalLoads = new MapOfTaggedObjects();
@@ -357,6 +357,7 @@ LoadPattern::clearAll(void)
     theNodalLoads->clearAll();
     theSPs->clearAll();
     currentGeoTag++;
+    arraysGeoTag = -1;
     lastChannel = 0;
     if (dLambdadh != 0) {
       dLambdadh->Zero();
@@ -410,21 +411,43 @@ LoadPattern::applyLoad(double pseudoTime)
     loadFactor *= scaleFactor;
   }
 
+  if (arraysGeoTag != currentGeoTag)
+    this->formLoadArrays();
+
+  for (size_t i = 0; i < nodalLoadArray.size(); i++)
+    nodalLoadArray[i]->applyLoad(loadFactor);
+    
+  for (size_t i = 0; i < elementalLoadArray.size(); i++)
+    elementalLoadArray[i]->applyLoad(loadFactor);
+
+  for (size_t i = 0; i < spArray.size(); i++)
+    spArray[i]->applyConstraint(loadFactor);
+}
+
+// copies the pointers to the loads and constraints out of the storage
+// objects, so applyLoad() at each step does not go through the iterators
+void
+LoadPattern::formLoadArrays(void)
+{
+  nodalLoadArray.clear();
   NodalLoad *nodLoad;
   NodalLoadIter &theNodalIter = this->getNodalLoads();
-
   while ((nodLoad = theNodalIter()) != 0)
-    nodLoad->applyLoad(loadFactor);
-    
+    nodalLoadArray.push_back(nodLoad);
+
+  elementalLoadArray.clear();
   ElementalLoad *eleLoad;
   ElementalLoadIter &theElementalIter = this->getElementalLoads();
   while ((eleLoad = theElementalIter()) != 0)
-    eleLoad->applyLoad(loadFactor);
+    elementalLoadArray.push_back(eleLoad);
 
+  spArray.clear();
   SP_Constraint *sp;
   SP_ConstraintIter &theIter = this->getSPs();
   while ((sp = theIter()) != 0)
-    sp->applyConstraint(loadFactor);
+    spArray.push_back(sp);
+
+  arraysGeoTag = currentGeoTag;
 }
 
 void
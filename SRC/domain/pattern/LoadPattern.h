@@ -40,6 +40,7 @@
 
 #include <DomainComponent.h>
 #include <Vector.h>
+#include <vector>
 
 class NodalLoad;
 class TimeSeries;
@@ -114,6 +115,8 @@ class LoadPattern : public DomainComponent
     int    isConstant;     // to indictae whether setConstant has been called
 	
   private:
+    void formLoadArrays(void);
+
     double loadFactor;     // current load factor
     double scaleFactor;    // factor to scale load factor from time series
 
@@ -133,6 +136,13 @@ class LoadPattern : public DomainComponent
     ElementalLoadIter   *theEleIter;
     SingleDomSP_Iter    *theSpIter;    
 
+    // the loads and constraints in arrays for applyLoad(), formed again
+    // when currentGeoTag shows they have changed
+    std::vector<NodalLoad *> nodalLoadArray;
+    std::vector<ElementalLoad *> elementalLoadArray;
+    std::vector<SP_Constraint *> spArray;
+    int arraysGeoTag;
+
     // AddingSensitivity:BEGIN //////////////////////////////////////
     Vector *randomLoads;
     bool RVisRandomProcessDiscretizer;
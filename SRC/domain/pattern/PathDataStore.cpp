@@ -0,0 +1,195 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of PathDataStore.
+
+#include <PathDataStore.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/stat.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace {
+
+  struct FileEntry {
+    std::weak_ptr<const std::vector<double> > data;
+    time_t modified;
+    long long size;
+  };
+
+  std::map<std::string, FileEntry> theFiles;
+  std::mutex theFilesMutex;
+
+  struct DerivedEntry {
+    std::weak_ptr<const std::vector<double> > source;
+    std::weak_ptr<const std::vector<double> > data;
+    std::vector<double> description;
+  };
+
+  typedef std::pair<const void *, std::vector<double> > DerivedKey;
+  std::map<DerivedKey, DerivedEntry> theDerived;
+  std::mutex theDerivedMutex;
+
+  // reads the whole file into buf, returns false if it can not be opened
+  bool
+  readFile(const char *fileName, std::string &buf)
+  {
+    FILE *theFile = fopen(fileName, "rb");
+    if (theFile == 0)
+      return false;
+
+    char chunk[65536];
+    size_t numRead;
+    while ((numRead = fread(chunk, 1, sizeof(chunk), theFile)) > 0)
+      buf.append(chunk, numRead);
+
+    fclose(theFile);
+    return true;
+  }
+
+  // parses the numbers in the text up to the first entry that is not a number
+  void
+  parseText(const std::string &buf, std::vector<double> &values)
+  {
+    const char *p = buf.c_str();
+    while (*p != '\0') {
+      while (isspace((unsigned char)*p))
+	p++;
+      if (*p == '\0')
+	break;
+      char *end;
+      double value = strtod(p, &end);
+      if (end == p)
+	break;
+      values.push_back(value);
+      p = end;
+    }
+  }
+}
+
+PathDataStore::Data
+PathDataStore::getFileData(const char *fileName, bool prependZero, bool binary)
+{
+  struct stat fileStat;
+  if (stat(fileName, &fileStat) != 0) {
+    opserr << "WARNING - PathDataStore::getFileData()";
+    opserr << " - could not open file " << fileName << endln;
+    return Data();
+  }
+
+  std::string key(fileName);
+  key += prependZero ? "|0" : "|";
+  key += binary ? "|b" : "|";
+
+  std::lock_guard<std::mutex> lock(theFilesMutex);
+
+  // reuse the data if the file has not changed since it was read
+  std::map<std::string, FileEntry>::iterator found = theFiles.find(key);
+  if (found != theFiles.end()) {
+    Data theData = found->second.data.lock();
+    if (theData && found->second.modified == fileStat.st_mtime &&
+	found->second.size == (long long)fileStat.st_size)
+      return theData;
+  }
+
+  std::string buf;
+  if (readFile(fileName, buf) == false) {
+    opserr << "WARNING - PathDataStore::getFileData()";
+    opserr << " - could not open file " << fileName << endln;
+    return Data();
+  }
+
+  std::shared_ptr<std::vector<double> > values = std::make_shared<std::vector<double> >();
+  if (prependZero)
+    values->push_back(0.0);
+
+  if (binary) {
+    size_t numValues = buf.size()/sizeof(double);
+    if (numValues*sizeof(double) != buf.size()) {
+      opserr << "WARNING - PathDataStore::getFileData()";
+      opserr << " - size of binary file " << fileName << " is not a multiple of ";
+      opserr << (int)sizeof(double) << " bytes\n";
+    }
+    size_t start = values->size();
+    values->resize(start + numValues);
+    if (numValues != 0)
+      memcpy(&(*values)[start], buf.data(), numValues*sizeof(double));
+  } else
+    parseText(buf, *values);
+
+  // a file without values gives no data, with or without the zero
+  if (values->size() == (prependZero ? 1u : 0u))
+    values->clear();
+
+  FileEntry &theEntry = theFiles[key];
+  theEntry.data = values;
+  theEntry.modified = fileStat.st_mtime;
+  theEntry.size = (long long)fileStat.st_size;
+
+  return values;
+}
+
+PathDataStore::Data
+PathDataStore::getDerivedData(const Data &source, const std::vector<double> &key,
+			      std::vector<double> &description,
+			      const std::function<Data(std::vector<double> &)> &derive)
+{
+  if (!source)
+    return derive(description);
+
+  // held while deriving, so that a record is not derived twice at once
+  std::lock_guard<std::mutex> lock(theDerivedMutex);
+
+  DerivedKey theKey(source.get(), key);
+  std::map<DerivedKey, DerivedEntry>::iterator found = theDerived.find(theKey);
+  if (found != theDerived.end()) {
+    Data theData = found->second.data.lock();
+    if (theData && found->second.source.lock() == source) {
+      description = found->second.description;
+      return theData;
+    }
+  }
+
+  Data theData = derive(description);
+  if (!theData)
+    return theData;
+
+  // drop the entries of the data no series uses any more
+  std::map<DerivedKey, DerivedEntry>::iterator entry = theDerived.begin();
+  while (entry != theDerived.end()) {
+    if (entry->second.data.expired() || entry->second.source.expired())
+      theDerived.erase(entry++);
+    else
+      ++entry;
+  }
+
+  DerivedEntry &theEntry = theDerived[theKey];
+  theEntry.source = source;
+  theEntry.data = theData;
+  theEntry.description = description;
+
+  return theData;
+}
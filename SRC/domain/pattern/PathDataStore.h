@@ -0,0 +1,59 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for PathDataStore.
+// PathDataStore reads the data files of the path time series. Each file
+// is read in one pass and the values are kept in a buffer shared by all
+// the series that use the file, so a record used by many load patterns
+// or supports is read and stored once. A file is read again only if it
+// has changed since it was read. Binary files hold the values as native
+// doubles. Data derived from shared data, such as the velocities and
+// displacements integrated from an acceleration record, is kept the same
+// way, so it is computed and stored once for all the series using it.
+//
+// What: "@(#) PathDataStore.h, revA"
+
+#ifndef PathDataStore_h
+#define PathDataStore_h
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class PathDataStore
+{
+  public:
+    typedef std::shared_ptr<const std::vector<double> > Data;
+
+    // returns the values in the file, with a zero in front of them if
+    // prependZero, or an empty pointer if the file can not be read
+    static Data getFileData(const char *fileName, bool prependZero = false,
+			    bool binary = false);
+
+    // returns the data derived from source by the derivation described by
+    // key; derive is only called when it is not held already, it forms the
+    // data and the description the derived series is to be built with,
+    // which is also returned in description
+    static Data getDerivedData(const Data &source, const std::vector<double> &key,
+			       std::vector<double> &description,
+			       const std::function<Data(std::vector<double> &)> &derive);
+};
+
+#endif
@@ -65,7 +65,7 @@ void *OPS_PathSeries() {
     double factor = 1.0, dt = -1.0;
     const char *fileTime = 0, *filePath = 0, *fileName = 0;
     std::vector<double> values, times;
-    bool useLast = false, prependZero = false;
+    bool useLast = false, prependZero = false, binaryFile = false;
     double startTime = 0.0;
 
     // check inputs
@@ -166,6 +166,15 @@ void *OPS_PathSeries() {
             filePath = OPS_GetString();
             loc++;
 
+        } else if (strcmp(arg, "-filePathBinary") == 0) {
+            if (OPS_GetNumRemainingInputArgs() < 1) {
+                opserr << "WARNING no file path is given\n";
+                return 0;
+            }
+            filePath = OPS_GetString();
+            binaryFile = true;
+            loc++;
+
         } else if (strcmp(arg, "-fileTime") == 0) {
             if (OPS_GetNumRemainingInputArgs() < 1) {
                 opserr << "WARNING no file time is given\n";
@@ -216,7 +225,7 @@ void *OPS_PathSeries() {
     } else if (dt > 0 && filePath != 0) {
         return new PathSeries(tag, filePath, dt, factor,
                               useLast, prependZero,
-                              startTime);
+                              startTime, binaryFile);
 
     } else if (times.empty() == false &&
                values.empty() == false) {
@@ -256,23 +265,38 @@ PathSeries::PathSeries(int tag,
    thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor),
    otherDbTag(0), lastSendCommitTag(-1), useLast(last), startTime(tStart), parameterID(0)
 {
-  // create a copy of the vector containing path points
-  if (prependZero == false) {
-    thePath = new Vector(theLoadPath);
-  } else if (theLoadPath != 0) {
-    // prepend a zero value
-    thePath = new Vector(1 + theLoadPath.Size());
-    thePath->Assemble(theLoadPath, 1);
-  }
-
-  // ensure we did not run out of memory
-  if (thePath == 0 || thePath->Size() == 0) {
+  // copy the path points into data that the copies of the series share
+  int size = theLoadPath.Size();
+  std::shared_ptr<std::vector<double> > values = std::make_shared<std::vector<double> >();
+  if (prependZero == true)
+    values->push_back(0.0);
+  for (int i = 0; i < size; i++)
+    values->push_back(theLoadPath(i));
+
+  if (values->empty()) {
     opserr << "PathSeries::PathSeries() - ran out of memory constructing";
     opserr << " a Vector of size: " <<  theLoadPath.Size() << endln;
-    if (thePath != 0)
-      delete thePath; 
-    thePath = 0;
+    return;
   }
+
+  pathData = values;
+  thePath = new Vector(values->data(), (int)values->size());
+}
+
+PathSeries::PathSeries(int tag,
+		       PathDataStore::Data theData,
+		       double theTimeIncr,
+		       double theFactor,
+		       bool last,
+		       double tStart)
+  :TimeSeries(tag, TSERIES_TAG_PathSeries),
+   thePath(0), pathData(theData), pathTimeIncr(theTimeIncr), cFactor(theFactor),
+   otherDbTag(0), lastSendCommitTag(-1), useLast(last), startTime(tStart), parameterID(0)
+{
+  if (pathData && pathData->empty() == false)
+    thePath = new Vector(const_cast<double *>(pathData->data()), (int)pathData->size());
+  else
+    pathData.reset();
 }
 
 PathSeries::PathSeries(int tag,
@@ -281,70 +305,20 @@ PathSeries::PathSeries(int tag,
 		       double theFactor,
 		       bool last,
                bool prependZero,
-               double tStart)
+               double tStart,
+               bool binaryFile)
   :TimeSeries(tag, TSERIES_TAG_PathSeries),
    thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor),
    otherDbTag(0), lastSendCommitTag(-1), useLast(last), startTime(tStart), parameterID(0)
 {
-  // determine the number of data points .. open file and count num entries
-  int numDataPoints = 0;
-  double dataPoint;
-
-  ifstream theFile;
-  theFile.open(fileName);
-
-  if (theFile.bad() || !theFile.is_open()) {
-    opserr << "WARNING - PathSeries::PathSeries()";
-    opserr << " - could not open file " << fileName << endln;
-  } else {
-    while (theFile >> dataPoint)
-      numDataPoints++;
-  }   
-  theFile.close();
-
-  // create a vector and read in the data
-  if (numDataPoints != 0) {
-
-    // increment size if we need to prepend a zero value
-    if (prependZero == true)
-      numDataPoints++;
-    
-    // first open the file
-    ifstream theFile1;
-    theFile1.open(fileName, ios::in);
-    if (theFile1.bad() || !theFile1.is_open()) {
-      opserr << "WARNING - PathSeries::PathSeries()";
-      opserr << " - could not open file " << fileName << endln;
-    } else {
-
-      // now create the vector
-      thePath = new Vector(numDataPoints);
-
-      // ensure we did not run out of memory
-      if (thePath == 0 || thePath->Size() == 0) {
-	opserr << "PathSeries::PathSeries() - ran out of memory constructing";
-	opserr << " a Vector of size: " << numDataPoints << endln;
-
-	if (thePath != 0)
-	  delete thePath;
-	thePath = 0;
-      }
-
-      // read the data from the file
-      else {
-	int count = 0;
-    if (prependZero == true)
-      count++;
-	while (theFile1 >> dataPoint) {
-	  (*thePath)(count) = dataPoint;
-	  count++;
-	}
-      }
+  // the data of the file is shared with the other series using it,
+  // thePath only refers to it
+  pathData = PathDataStore::getFileData(fileName, prependZero, binaryFile);
 
-      // finally close the file
-      theFile1.close();
-    }
-  }
+  if (pathData && pathData->empty() == false)
+    thePath = new Vector(const_cast<double *>(pathData->data()), (int)pathData->size());
+  else
+    pathData.reset();
 }
 
 PathSeries::~PathSeries()
@@ -353,13 +327,38 @@ PathSeries::~PathSeries()
     delete thePath;
 }
 
+PathDataStore::Data
+PathSeries::getData(std::vector<double> &description) const
+{
+  description.resize(4);
+  description[0] = pathTimeIncr;
+  description[1] = cFactor;
+  description[2] = useLast ? 1.0 : 0.0;
+  description[3] = startTime;
+
+  return pathData;
+}
+
 TimeSeries *
 PathSeries::getCopy(void) {
-	if (thePath != 0)
-  return new PathSeries(this->getTag(), *thePath, pathTimeIncr, cFactor,
-                        useLast, false, startTime);
-	else
-		return 0;
+  if (thePath == 0)
+    return 0;
+
+  if (!pathData)
+    return new PathSeries(this->getTag(), *thePath, pathTimeIncr, cFactor,
+                          useLast, false, startTime);
+
+  // a copy shares the data of the series
+  PathSeries *theCopy = new PathSeries();
+  theCopy->setTag(this->getTag());
+  theCopy->pathData = pathData;
+  theCopy->thePath = new Vector(const_cast<double *>(pathData->data()), (int)pathData->size());
+  theCopy->pathTimeIncr = pathTimeIncr;
+  theCopy->cFactor = cFactor;
+  theCopy->useLast = useLast;
+  theCopy->startTime = startTime;
+
+  return theCopy;
 }
 
 double
@@ -510,8 +509,13 @@ PathSeries::recvSelf(int commitTag, Channel &theChannel,
 
   startTime = data(6);
   
-  // get the path vector, only receive it once as it can't change
-  if (thePath == 0 && size > 0) {
+  // get the path vector, only receive it once as it can't change; a path
+  // shared with other series is let go first, the series then owns the
+  // path it receives
+  if ((thePath == 0 || pathData) && size > 0) {
+    if (thePath != 0)
+      delete thePath;
+    pathData.reset();
     thePath = new Vector(size);
     if (thePath == 0 || thePath->Size() == 0) {
       opserr << "PathSeries::recvSelf() - ran out of memory";
@@ -36,6 +36,7 @@
 // apart. (could be provided in another vector if different)
 
 #include <TimeSeries.h>
+#include <PathDataStore.h>
 
 class Vector;
 
@@ -56,6 +57,13 @@ class PathSeries : public TimeSeries
         double cfactor = 1.0,
         bool useLast = false,
         bool prependZero = false,
+        double startTime = 0.0,
+        bool binaryFile = false);
+    PathSeries(int tag,
+        PathDataStore::Data theData,
+        double pathTimeIncr = 1.0,
+        double cfactor = 1.0,
+        bool useLast = false,
         double startTime = 0.0);
     PathSeries();
     
@@ -70,6 +78,10 @@ class PathSeries : public TimeSeries
     double getPeakFactor ();
     double getTimeIncr (double pseudoTime) {return pathTimeIncr;}
     double getStartTime() ;
+
+    // the shared data of the series, with the time increment, factor,
+    // useLast and start time in description
+    PathDataStore::Data getData(std::vector<double> &description) const;
     
     // methods for output
     int sendSelf(int commitTag, Channel &theChannel);
@@ -89,6 +101,7 @@ class PathSeries : public TimeSeries
     
   private:
     Vector *thePath;      // vector containing the data points
+    PathDataStore::Data pathData; // data of a file, shared with other series
     double pathTimeIncr;  // specifies the time increment used in load path vector
     double cFactor;       // additional factor on the returned load factor
     int otherDbTag;       // a database tag needed for the vector object
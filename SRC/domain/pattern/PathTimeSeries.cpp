@@ -36,6 +36,7 @@
 
 
 #include <PathTimeSeries.h>
+#include <PathDataStore.h>
 #include <Vector.h>
 #include <Channel.h>
 #include <math.h>
@@ -97,102 +98,22 @@ PathTimeSeries::PathTimeSeries(int tag,
    thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
    dbTag1(0), dbTag2(0), useLast(last)
 {
-  // determine the number of data points
-  int numDataPoints1 =0;
-  int numDataPoints2 =0;
-  double dataPoint;
-  ifstream theFile;
-  
-  // first open and go through file containing path
-  theFile.open(filePathName, ios::in);
-  if (theFile.bad() || !theFile.is_open()) {
-    opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-    opserr << " - could not open file " << filePathName << endln;
-  } else {
-    while (theFile >> dataPoint)
-      numDataPoints1++;
-  }   
-  theFile.close();
-
-  // now open and go through file containing time
-  ifstream theFile1;
-  theFile1.open(fileTimeName, ios::in);
-  if (theFile1.bad() || !theFile1.is_open()) {
-    opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-    opserr << " - could not open file " << fileTimeName << endln;
-  } else {
-    while (theFile1 >> dataPoint)
-      numDataPoints2++;
-  }   
-  theFile1.close();
+  // read the files containing the path and the time
+  PathDataStore::Data pathData = PathDataStore::getFileData(filePathName);
+  PathDataStore::Data timeData = PathDataStore::getFileData(fileTimeName);
+  if (!pathData || !timeData)
+    return;
 
   // check number of data entries in both are the same
-  if (numDataPoints1 != numDataPoints2) {
+  if (pathData->size() != timeData->size()) {
     opserr << "WARNING PathTimeSeries::PathTimeSeries() - files containing data ";
     opserr << "points for path and time do not contain same number of points\n";
-  } else {
-
-
-    // create a vector and read in the data
-    if (numDataPoints1 != 0) {
-
-      // now create the two vector
-      thePath = new Vector(numDataPoints1);
-      time = new Vector(numDataPoints1);
-
-      // ensure did not run out of memory creating copies
-      if (thePath == 0 || thePath->Size() == 0 ||
-	  time == 0 || time->Size() == 0) {
-	  
-        opserr << "WARNING PathTimeSeries::PathTimeSeries() - out of memory\n ";
-	if (thePath != 0)
-	  delete thePath;
-	if (time != 0)
-	  delete time;
-	thePath = 0;
-	time = 0;
-      }
-      
-      // first open the path file and read in the data
-      ifstream theFile2;
-      theFile2.open(filePathName, ios::in);
-      if (theFile2.bad() || !theFile2.is_open()) {
-	opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-	opserr << " - could not open file " << filePathName << endln;
-	delete thePath;
-	delete time;
-	thePath = 0;
-	time =0;
-      } else { // read in the path data and then do the time
-	int count = 0;
-	while (theFile2 >> dataPoint) {
-	  (*thePath)(count) = dataPoint;
-	  count++;
-	}
-
-	// finally close the file
-	theFile2.close();
-
-	// now open the time file and read in the data
-	ifstream theFile3;
-	theFile3.open(fileTimeName, ios::in);
-	if (theFile3.bad() || !theFile3.is_open()) {
-	  opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-	  opserr << " - could not open file " << fileTimeName << endln;
-	  delete thePath;
-	  delete time;
-	  thePath = 0;
-	  time =0;
-	} else { // read in the data
-	  int count = 0;
-	  while (theFile3 >> dataPoint) {
-	    (*time)(count) = dataPoint;
-	    count++;
-	  }
-	  theFile3.close();
-	} // read in the data 
-      }   // read in the path data and then do the time
-    }
+  } else if (pathData->empty() == false) {
+    // the series keeps copies of the data
+    Vector path(const_cast<double *>(pathData->data()), (int)pathData->size());
+    Vector times(const_cast<double *>(timeData->data()), (int)timeData->size());
+    thePath = new Vector(path);
+    time = new Vector(times);
   }
 }
 
@@ -204,77 +125,27 @@ PathTimeSeries::PathTimeSeries(int tag,
    thePath(0), time(0), currentTimeLoc(0), cFactor(theFactor),
    dbTag1(0), dbTag2(0), useLast(last)
 {
-  // determine the number of data points
-  int numDataPoints = 0;
-  double dataPoint;
-  ifstream theFile;
-  
-  // first open and go through file counting entries
-  theFile.open(fileName, ios::in);
-  if (theFile.bad() || !theFile.is_open()) {
-    opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-    opserr << " - could not open file " << fileName << endln;
-  }
-  else {
-    while (theFile >> dataPoint) {
-      numDataPoints++;
-      theFile >> dataPoint;	// Read in second value of pair
-    }
-  }
+  // read the file containing the time and value pairs
+  PathDataStore::Data data = PathDataStore::getFileData(fileName);
+  if (!data)
+    return;
 
+  int numDataPoints = (int)data->size();
   if ((numDataPoints % 2) != 0) {
     opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
     opserr << " - num data entries in file NOT EVEN! " << fileName << endln;
     numDataPoints--;
   }
 
-
-  theFile.close();
-
-  // create a vector and read in the data
   if (numDataPoints != 0) {
-    
-    // now create the two vector
     thePath = new Vector(numDataPoints/2);
     time = new Vector(numDataPoints/2);
-    
-    // ensure did not run out of memory creating copies
-    if (thePath == 0 || thePath->Size() == 0 || time == 0 || time->Size() == 0) {
-      
-      opserr << "WARNING PathTimeSeries::PathTimeSeries() - out of memory\n ";
-      if (thePath != 0)
-	delete thePath;
-      if (time != 0)
-	delete time;
-      thePath = 0;
-      time = 0;
-    }
-    
-    // first open the file and read in the data
-    ifstream theFile1;
-    theFile1.open(fileName, ios::in);
-    if (theFile1.bad() || !theFile1.is_open()) {
-      
-      opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-      opserr << " - could not open file " << fileName << endln;
-      delete thePath;
-      delete time;
-      thePath = 0;
-      time =0;
+
+    const double *values = data->data();
+    for (int i = 0; i < numDataPoints/2; i++) {
+      (*time)(i) = values[2*i];
+      (*thePath)(i) = values[2*i+1];
     }
-    else { // read in the time and then read the value
-      int count = 0;
-      while (theFile1 >> dataPoint) {
-	(*time)(count) = dataPoint;
-	theFile1 >> dataPoint;
-	(*thePath)(count) = dataPoint;
-
-	count++;
-      }
-      
-      // finally close the file
-      theFile1.close();
-    } 
   }
 }
 
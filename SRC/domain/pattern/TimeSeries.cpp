@@ -39,6 +39,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theTimeSeriesObjects;
+static bool theTimeSeriesObjectsRegistered = MapOfTaggedObjects::addModelStorage(theTimeSeriesObjects);
 
 bool OPS_addTimeSeries(TimeSeries *newComponent) {
   return theTimeSeriesObjects.addComponent(newComponent);
@@ -32,6 +32,8 @@
 // What: "@(#) TimeSeriesIntegrator.C, revA"
 
 #include <TimeSeriesIntegrator.h>
+#include <PathSeries.h>
+#include <classTags.h>
 #include <elementAPI.h>
 
 
@@ -80,3 +82,38 @@ TimeSeriesIntegrator::~TimeSeriesIntegrator()
 {
 
 }
+
+
+TimeSeries*
+TimeSeriesIntegrator::integrateShared(TimeSeries *theSeries, double delta)
+{
+  if (theSeries == 0 || theSeries->getClassTag() != TSERIES_TAG_PathSeries)
+    return this->integrate(theSeries, delta);
+
+  std::vector<double> key;
+  PathDataStore::Data source = ((PathSeries *)theSeries)->getData(key);
+  if (!source)
+    return this->integrate(theSeries, delta);
+
+  key.push_back(this->getClassTag());
+  key.push_back(delta);
+
+  std::vector<double> description;
+  PathDataStore::Data theData =
+    PathDataStore::getDerivedData(source, key, description,
+				  [this, theSeries, delta](std::vector<double> &desc) {
+      PathDataStore::Data result;
+      TimeSeries *theIntegral = this->integrate(theSeries, delta);
+      if (theIntegral != 0 && theIntegral->getClassTag() == TSERIES_TAG_PathSeries)
+	result = ((PathSeries *)theIntegral)->getData(desc);
+      if (theIntegral != 0)
+	delete theIntegral;
+      return result;
+    });
+
+  if (!theData || description.size() < 4)
+    return this->integrate(theSeries, delta);
+
+  return new PathSeries(0, theData, description[0], description[1],
+			description[2] != 0.0, description[3]);
+}
@@ -50,6 +50,10 @@ class TimeSeriesIntegrator : public MovableObject
 
     virtual TimeSeries* integrate(TimeSeries *theSeries, double delta) = 0;
 
+    // integrate() for a series whose data is shared; the integral is
+    // formed once for all the series sharing the data & is shared by them
+    TimeSeries* integrateShared(TimeSeries *theSeries, double delta);
+
   protected:
 
   private:
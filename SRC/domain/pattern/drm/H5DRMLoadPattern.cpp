@@ -40,6 +40,7 @@
 
 #include <OPS_Globals.h>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <Message.h>
 
@@ -206,6 +207,7 @@ H5DRMLoadPattern::H5DRMLoadPattern()
       flag_initialized(false),
       station_id2data_pos(100),
       ih5_fname(0), ih5_vel(0), ih5_vel_ds(0), ih5_dis(0), ih5_dis_ds(0), ih5_acc(0), ih5_acc_ds(0), ih5_one_node_ms(0), ih5_xfer_plist(0),       
+      cache_num_tsteps(0), cache_start(0), cache_len(0), next_start(0), next_len(0), next_ok(false),
       do_coordinate_transformation(true),
       T(3, 3),
       x0(3)
@@ -259,6 +261,7 @@ H5DRMLoadPattern::H5DRMLoadPattern(
       flag_initialized(false),
       station_id2data_pos(100),
       ih5_fname(0), ih5_vel(0), ih5_vel_ds(0), ih5_dis(0), ih5_dis_ds(0), ih5_acc(0), ih5_acc_ds(0), ih5_one_node_ms(0), ih5_xfer_plist(0),
+      cache_num_tsteps(0), cache_start(0), cache_len(0), next_start(0), next_len(0), next_ok(false),
       do_coordinate_transformation(do_coordinate_transformation_),
       T(3, 3),
       x0(3)
@@ -445,7 +448,7 @@ void H5DRMLoadPattern::do_intitialization()
     double d_err = 0;
     int n_nodes_found = 0;
 
-    node_matching_BruteForce(d_tol, internal, xyz, drmbox_x0, d_err, n_nodes_found );
+    node_matching(d_tol, internal, xyz, drmbox_x0, d_err, n_nodes_found );
 
 
     if (MPI_local_rank == 0)
@@ -562,7 +565,11 @@ void H5DRMLoadPattern::do_intitialization()
     }
 
 
-    // Identify Elements on DRM boundary
+    // Identify Elements on DRM boundary. The local positions of their nodes
+    // are kept, element after element, so that the forces at each step need
+    // no lookups of the node tags.
+    DRM_Elements.resize(0);
+    DRM_Element_Pos.clear();
     Element * element_ptr = 0;
     ElementIter& element_iter = theDomain->getElements();
     while ((element_ptr = element_iter()) != 0)
@@ -574,11 +581,17 @@ void H5DRMLoadPattern::do_intitialization()
         for (int nodenum = 0; nodenum < nnodes; ++nodenum)
         {
             int node_tag = element_nodelist(nodenum);
-            if (DRM_Nodes.getLocation(node_tag) >= 0)
+            if (nodetag2local_pos.find(node_tag) != nodetag2local_pos.end())
                 count++;
+            else
+                break;
         }
         if (count == nnodes)
-            DRM_Elements.insert(element_tag);
+        {
+            DRM_Elements[DRM_Elements.Size()] = element_tag;
+            for (int nodenum = 0; nodenum < nnodes; ++nodenum)
+                DRM_Element_Pos.push_back(nodetag2local_pos[element_nodelist(nodenum)]);
+        }
     }
 
     N_local_elements = DRM_Elements.Size();
@@ -730,6 +743,9 @@ H5DRMLoadPattern::~H5DRMLoadPattern()
 
 void H5DRMLoadPattern::cleanup()
 {
+    // Stop the read-ahead and drop the cached motions
+    drm_cache_clear();
+
     // Clear mappings
     nodetag2station_id.clear();
     nodetag2local_pos.clear();
@@ -872,7 +888,7 @@ H5DRMLoadPattern::applyLoad(double time)
         for (int i = 0; i < DRM_Nodes.Size(); i++)
         {
             int nodeTag = DRM_Nodes[i] ;
-            int local_pos = nodetag2local_pos[nodeTag];
+            int local_pos = i;
             theNode = theDomain->getNode( nodeTag );
             if ( theNode == 0 )
                 continue;
@@ -949,8 +965,15 @@ bool H5DRMLoadPattern::drm_direct_read(double t)
         return true;
     }
 
+    if (cache_row.size() == 0 && !drm_cache_setup())
+    {
+        return false;
+    }
+
     int i1 = (int) floor( (t - tstart) / dt);
-    int i2 = (int) floor( (t - tstart) / dt) + 1;
+    i1 = i1 > cache_num_tsteps - 2 ? cache_num_tsteps - 2 : i1;
+    i1 = i1 < 0 ? 0 : i1;
+    int i2 = i1 + 1;
     double t1 = i1 * dt + tstart;
     double t2 = i2 * dt + tstart;
     double dtau = (t - t1) / (t2 - t1);
@@ -960,77 +983,39 @@ bool H5DRMLoadPattern::drm_direct_read(double t)
         H5DRMout << "t = " << t << " dt = " << dt << " i1 = " << i1 << " i2 = " << i2 << " t1 = " << t1 << " t2 = " << t2 << " dtau = " << dtau << endln;
     }
 
-    ih5_acc_ds = H5Dget_space(ih5_acc);
-    ih5_dis_ds = H5Dget_space(ih5_dis);
+    if (!drm_cache_load(i1, i2))
+    {
+        H5DRMerror << "H5DRMLoadPattern::drm_direct_read - Failed to read displacement or acceleration array!!\n" <<
+                   " i1 = " << i1 << endln <<
+                   " i2 = " << i2 << endln <<
+                   " last_integration_time = " << last_integration_time << endln;
+        exit(-1);
+    }
 
     double umax = -std::numeric_limits<double>::infinity();
     double amax = -std::numeric_limits<double>::infinity();
     double umin =  std::numeric_limits<double>::infinity();
     double amin =  std::numeric_limits<double>::infinity();
 
+    int c1 = i1 - cache_start;
+    int c2 = i2 - cache_start;
+
     for (int n = 0; n < DRM_Nodes.Size(); ++n)
     {
         int nodeTag = DRM_Nodes(n);
-        int station_id = nodetag2station_id[nodeTag];
-        int data_pos = station_id2data_pos[station_id];
         int local_pos = nodetag2local_pos[nodeTag];
 
         double d1[3], d2[3];
         double a1[3], a2[3];
 
-        d1[0] = d1[1] = d1[2] = 0.;
-        d2[0] = d2[1] = d2[2] = 0.;
-        a1[0] = a1[1] = a1[2] = 0.;
-        a2[0] = a2[1] = a2[2] = 0.;
-
-        hsize_t start[2]  = {(hsize_t) data_pos , (hsize_t) i1};
-        hsize_t stride[2] = {1                  , 1};
-        hsize_t count[2]  = {3                  , 1};
-        hsize_t block[2]  = {1                  , 1};
-
-        //Selection in dataspace
-        H5Sselect_hyperslab(
-            ih5_dis_ds,
-            H5S_SELECT_SET, start, stride, count, block );
-        H5Sselect_hyperslab(
-            ih5_acc_ds,
-            H5S_SELECT_SET, start, stride, count, block );
-
-
-        //Selection in memspace
-        hsize_t rank_one_array = 1;
-        hsize_t one_node_data_dims[1] = {3};
-        hsize_t one_node_data_maxdims[1] = {3};
-        hid_t memspace  = H5Screate_simple(rank_one_array, one_node_data_dims, one_node_data_maxdims);       // create dataspace of memory
-
-
-        hsize_t mem_start[1] = {0};
-        hsize_t mem_stride[1] = {1};
-        hsize_t mem_count[1] = {3};
-        hsize_t mem_block[1] = {1};
-        H5Sselect_hyperslab(
-            memspace,
-            H5S_SELECT_SET, mem_start, mem_stride, mem_count, mem_block );
-
-        //Read data
-        herr_t errorflag1 = H5Dread( ih5_dis, H5T_NATIVE_DOUBLE, memspace,
-                                     ih5_dis_ds, ih5_xfer_plist,  d1 );
-        herr_t errorflag2 = H5Dread(ih5_acc, H5T_NATIVE_DOUBLE, memspace,
-                                    ih5_acc_ds, ih5_xfer_plist,  a1 );
-        start[1] = (hsize_t) i2;
-        H5Sselect_hyperslab(
-            ih5_dis_ds,
-            H5S_SELECT_SET, start, stride, count, block );
-        H5Sselect_hyperslab(
-            ih5_acc_ds,
-            H5S_SELECT_SET, start, stride, count, block );
-
-
-        herr_t errorflag3 = H5Dread( ih5_dis, H5T_NATIVE_DOUBLE, memspace,
-                                     ih5_dis_ds, ih5_xfer_plist,  d2 );
-        herr_t errorflag4 = H5Dread(ih5_acc, H5T_NATIVE_DOUBLE, memspace,
-                                    ih5_acc_ds, ih5_xfer_plist,  a2 );
-        H5Sclose(memspace);
+        for (int i = 0; i < 3; ++i)
+        {
+            size_t offset = (size_t) cache_row[3 * n + i] * cache_len;
+            d1[i] = cache_dis[offset + c1];
+            d2[i] = cache_dis[offset + c2];
+            a1[i] = cache_acc[offset + c1];
+            a2[i] = cache_acc[offset + c2];
+        }
 
         bool nanfound = false;
         for (int i = 0; i < 3; ++i)
@@ -1053,27 +1038,17 @@ bool H5DRMLoadPattern::drm_direct_read(double t)
         }
 
 
-        if (errorflag1 < 0 || errorflag2 < 0 || errorflag3 < 0 || errorflag4 < 0 || nanfound)
+        if (nanfound)
         {
-            H5DRMerror << "H5DRMLoadPattern::drm_direct_read - Failed to read displacement or acceleration array!!\n" <<
+            H5DRMerror << "H5DRMLoadPattern::drm_direct_read - NaN found in displacement or acceleration array!!\n" <<
                        " n = " << n << endln <<
                        " nodeTag = " << nodeTag << endln <<
-                       " station_id = " << station_id << endln <<
+                       " station_id = " << nodetag2station_id[nodeTag] << endln <<
                        " i1 = " << i1 << endln <<
-                       " data_pos = " << data_pos << endln <<
                        " local_pos = " << local_pos << endln <<
-                       " Nt = " << 1 << endln <<
                        " last_integration_time = " << last_integration_time << endln <<
-                       " start   = [" << start[0] << ", " << start[1] << "]" << endln <<
-                       " mem_start  = [" << mem_start[0] << "]" << endln <<
-                       " stride  = [" << stride[0] << ", " << stride[1] << "]" << endln <<
-                       " count   = [" << count[0] << ", " << count[1] << "]" << endln <<
-                       " block   = [" << block[0] << ", " << block[1] << "]" << endln <<
-                       " errorflag1 = [" << errorflag1 << ", " << block[1] << "]" << endln <<
-                       " errorflag2 = [" << errorflag2 << ", " << block[1] << "]" << endln <<
-                       " errorflag3 = [" << errorflag3 << ", " << block[1] << "]" << endln <<
-                       " errorflag4 = [" << errorflag4 << ", " << block[1] << "]" << endln <<
-                       " nanfound   = [" << nanfound << ", " << block[1] << "]" << endln ;
+                       " cache_start = " << cache_start << endln <<
+                       " cache_len = " << cache_len << endln;
 
             exit(-1);
         }
@@ -1100,6 +1075,208 @@ bool H5DRMLoadPattern::drm_direct_read(double t)
 }
 
 
+// Collects the dataset rows of the local DRM nodes, sorted & without
+// repetitions, and the position in the cache of each node dof.
+bool H5DRMLoadPattern::drm_cache_setup()
+{
+    hsize_t dims[2] = {0, 0};
+    if (H5Sget_simple_extent_ndims(ih5_dis_ds) != 2 ||
+            H5Sget_simple_extent_dims(ih5_dis_ds, dims, NULL) < 0)
+    {
+        H5DRMerror << "H5DRMLoadPattern::drm_cache_setup - displacement dataset is not two dimensional\n";
+        return false;
+    }
+    cache_num_tsteps = (int) dims[1];
+
+    hsize_t acc_dims[2] = {0, 0};
+    if (H5Sget_simple_extent_ndims(ih5_acc_ds) != 2 ||
+            H5Sget_simple_extent_dims(ih5_acc_ds, acc_dims, NULL) < 0 ||
+            acc_dims[0] != dims[0] || acc_dims[1] != dims[1])
+    {
+        H5DRMerror << "H5DRMLoadPattern::drm_cache_setup - displacement and acceleration datasets differ in size\n";
+        return false;
+    }
+
+    if (cache_num_tsteps < 2)
+    {
+        H5DRMerror << "H5DRMLoadPattern::drm_cache_setup - motion datasets have less than two time steps\n";
+        return false;
+    }
+
+    int num_nodes = DRM_Nodes.Size();
+    cache_file_rows.resize(3 * num_nodes);
+    for (int n = 0; n < num_nodes; ++n)
+    {
+        int nodeTag = DRM_Nodes(n);
+        int data_pos = station_id2data_pos[nodetag2station_id[nodeTag]];
+        for (int i = 0; i < 3; ++i)
+        {
+            cache_file_rows[3 * n + i] = (hsize_t) data_pos + i;
+        }
+    }
+
+    std::vector<hsize_t> node_rows(cache_file_rows);
+    std::sort(cache_file_rows.begin(), cache_file_rows.end());
+    cache_file_rows.erase(std::unique(cache_file_rows.begin(), cache_file_rows.end()), cache_file_rows.end());
+
+    if (cache_file_rows.back() >= dims[0])
+    {
+        H5DRMerror << "H5DRMLoadPattern::drm_cache_setup - data location out of the motion datasets\n";
+        cache_file_rows.clear();
+        return false;
+    }
+
+    cache_row.resize(3 * num_nodes);
+    for (int k = 0; k < 3 * num_nodes; ++k)
+    {
+        cache_row[k] = (int) (std::lower_bound(cache_file_rows.begin(), cache_file_rows.end(), node_rows[k]) - cache_file_rows.begin());
+    }
+
+    if (MPI_local_rank == 0)
+    {
+        H5DRMout << "caching " << (int) cache_file_rows.size() << " rows of motion in blocks of " << H5DRM_CACHE_TSTEPS << " time steps\n";
+    }
+
+    return true;
+}
+
+
+// Reads the time steps [start, start + len) of all the cached rows of
+// the displacement and acceleration datasets, one read per dataset.
+bool H5DRMLoadPattern::drm_cache_read_block(int start, int len,
+        std::vector<double>& dis, std::vector<double>& acc)
+{
+    hsize_t num_rows = cache_file_rows.size();
+    dis.resize(num_rows * len);
+    acc.resize(num_rows * len);
+
+    hid_t dis_fs = H5Dget_space(ih5_dis);
+    hid_t acc_fs = H5Dget_space(ih5_acc);
+    H5Sselect_none(dis_fs);
+    H5Sselect_none(acc_fs);
+
+    // consecutive rows are selected as one hyperslab
+    size_t r0 = 0;
+    while (r0 < num_rows)
+    {
+        size_t r1 = r0 + 1;
+        while (r1 < num_rows && cache_file_rows[r1] == cache_file_rows[r1 - 1] + 1)
+        {
+            r1++;
+        }
+
+        hsize_t file_start[2] = {cache_file_rows[r0], (hsize_t) start};
+        hsize_t file_count[2] = {(hsize_t) (r1 - r0), (hsize_t) len};
+        H5Sselect_hyperslab(dis_fs, H5S_SELECT_OR, file_start, NULL, file_count, NULL);
+        H5Sselect_hyperslab(acc_fs, H5S_SELECT_OR, file_start, NULL, file_count, NULL);
+
+        r0 = r1;
+    }
+
+    // the selection is traversed in row major order, which is the order
+    // of the rows in the cache
+    hsize_t mem_dims[2] = {num_rows, (hsize_t) len};
+    hid_t memspace = H5Screate_simple(2, mem_dims, NULL);
+
+    herr_t errorflag1 = H5Dread(ih5_dis, H5T_NATIVE_DOUBLE, memspace, dis_fs, ih5_xfer_plist, dis.data());
+    herr_t errorflag2 = H5Dread(ih5_acc, H5T_NATIVE_DOUBLE, memspace, acc_fs, ih5_xfer_plist, acc.data());
+
+    H5Sclose(memspace);
+    H5Sclose(dis_fs);
+    H5Sclose(acc_fs);
+
+    return errorflag1 >= 0 && errorflag2 >= 0;
+}
+
+
+// Makes the cached block cover steps i1 & i2, taking the block read
+// ahead when it does. Consecutive blocks share one step so that both
+// ends of an interval are always in the same block.
+bool H5DRMLoadPattern::drm_cache_load(int i1, int i2)
+{
+    if (cache_len > 0 && i1 >= cache_start && i2 < cache_start + cache_len)
+    {
+        return true;
+    }
+
+#ifdef H5_HAVE_THREADSAFE
+    if (prefetcher.joinable())
+    {
+        prefetcher.join();
+    }
+#endif
+
+    if (next_len > 0 && next_ok && i1 >= next_start && i2 < next_start + next_len)
+    {
+        cache_start = next_start;
+        cache_len = next_len;
+        cache_dis.swap(next_dis);
+        cache_acc.swap(next_acc);
+    }
+    else
+    {
+        int len = cache_num_tsteps - i1;
+        len = len > H5DRM_CACHE_TSTEPS ? H5DRM_CACHE_TSTEPS : len;
+        cache_start = i1;
+        cache_len = len;
+        if (!drm_cache_read_block(cache_start, cache_len, cache_dis, cache_acc))
+        {
+            cache_len = 0;
+            return false;
+        }
+    }
+    next_len = 0;
+    next_ok = false;
+
+    drm_cache_prefetch();
+
+    return true;
+}
+
+
+// Starts reading the block after the cached one. Without a thread-safe
+// HDF5 library there is no read-ahead, the block is read when needed.
+void H5DRMLoadPattern::drm_cache_prefetch()
+{
+#ifdef H5_HAVE_THREADSAFE
+    int start = cache_start + cache_len - 1;
+    int len = cache_num_tsteps - start;
+    len = len > H5DRM_CACHE_TSTEPS ? H5DRM_CACHE_TSTEPS : len;
+    if (len < 2)
+    {
+        return;
+    }
+
+    next_start = start;
+    next_len = len;
+    prefetcher = std::thread([this]() {
+        next_ok = drm_cache_read_block(next_start, next_len, next_dis, next_acc);
+    });
+#endif
+}
+
+
+void H5DRMLoadPattern::drm_cache_clear()
+{
+#ifdef H5_HAVE_THREADSAFE
+    if (prefetcher.joinable())
+    {
+        prefetcher.join();
+    }
+#endif
+    cache_file_rows.clear();
+    cache_row.clear();
+    cache_dis.clear();
+    cache_acc.clear();
+    next_dis.clear();
+    next_acc.clear();
+    cache_num_tsteps = 0;
+    cache_start = cache_len = 0;
+    next_start = next_len = 0;
+    next_ok = false;
+}
+
+
 bool H5DRMLoadPattern::drm_differentiate_displacements(double t)
 {
 
@@ -1340,19 +1517,23 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
         BoundaryNodes.resize(MaxNodes);
         ExteriorNodes.resize(MaxNodes);
 
+        // the local positions of the element nodes, found at initialization
+        const int* elementPos = DRM_Element_Pos.data();
+
         for (int elemIndex = 0; elemIndex < DRM_Elements.Size(); ++elemIndex)
         {
             int elementTag = DRM_Elements[elemIndex];
             theElement = theDomain->getElement(elementTag);
             const ID& elementNodeIDs = theElement->getExternalNodes();
             numElementNodes = elementNodeIDs.Size();
+            const int* localPos = elementPos;
+            elementPos += numElementNodes;
 
             // Identify boundary and exterior nodes
             int boundaryCount = 0, exteriorCount = 0;
             for (int nodeIndex = 0; nodeIndex < numElementNodes; ++nodeIndex)
             {
-                int nodeTag = elementNodeIDs(nodeIndex);
-                int localPosition = nodetag2local_pos[nodeTag];
+                int localPosition = localPos[nodeIndex];
 
                 if (DRM_Boundary_Flag[localPosition])
                 {
@@ -1405,9 +1586,7 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
 
                 for (int i = 0; i < boundaryCount; ++i)
                 {
-                    int b = BoundaryNodes(i);
-                    int nodeTag = elementNodeIDs(b);
-                    int localPosition = nodetag2local_pos[nodeTag];
+                    int localPosition = localPos[BoundaryNodes(i)];
                     for (int ci = 0; ci < 3; ++ci)
                     {
                         u_b(3 * i + ci) = DRM_D[3 * localPosition + ci];
@@ -1417,9 +1596,7 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
 
                 for (int j = 0; j < exteriorCount; ++j)
                 {
-                    int e = ExteriorNodes(j);
-                    int nodeTag = elementNodeIDs(e);
-                    int localPosition = nodetag2local_pos[nodeTag];
+                    int localPosition = localPos[ExteriorNodes(j)];
                     for (int cj = 0; cj < 3; ++cj)
                     {
                         u_e(3 * j + cj) = DRM_D[3 * localPosition + cj];
@@ -1440,9 +1617,7 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
                 // Now add the DRM forces for this element to the global DRM forces
                 for (int i = 0; i < boundaryCount; ++i)
                 {
-                    int b = BoundaryNodes(i);
-                    int nodeTag = elementNodeIDs(b);
-                    int localPosition = nodetag2local_pos[nodeTag];
+                    int localPosition = localPos[BoundaryNodes(i)];
                     for (int ci = 0; ci < 3; ++ci)
                     {
                         DRM_F[3 * localPosition + ci] += Peff_b[3*i+ci];
@@ -1451,9 +1626,7 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
 
                 for (int j = 0; j < exteriorCount; ++j)
                 {
-                    int e = ExteriorNodes(j);
-                    int nodeTag = elementNodeIDs(e);
-                    int localPosition = nodetag2local_pos[nodeTag];
+                    int localPosition = localPos[ExteriorNodes(j)];
                     for (int cj = 0; cj < 3; ++cj)
                     {
                         DRM_F[3 * localPosition + cj] += Peff_e[3*j+cj];
@@ -1464,7 +1637,7 @@ bool H5DRMLoadPattern::CalculateBoundaryForces(double currentTime)
                 for (int k = 0; k < numElementNodes; ++k)
                 {
                     int nodeTag = elementNodeIDs(k);
-                    int localPosition = nodetag2local_pos[nodeTag];
+                    int localPosition = localPos[k];
 
                     if (isnan(DRM_F(3 * localPosition)) || isnan(DRM_F(3 * localPosition + 1)) || isnan(DRM_F(3 * localPosition + 2)))
                     {
@@ -1593,15 +1766,28 @@ H5DRMLoadPattern::getNodalLoad(int nodeTag, double time)
 
 
 
-void H5DRMLoadPattern::node_matching_BruteForce(double d_tol, const ID & internal, const Matrix & xyz, const Vector & drmbox_x0, double & d_err, int & n_nodes_found)
+// The key of a grid cell mixes its three indices. Two cells sharing a key
+// only add candidates, the distances are always checked.
+static inline unsigned long long H5DRM_cell_key(long long i, long long j, long long k)
+{
+    return ((unsigned long long)i * 73856093ULL) ^ ((unsigned long long)j * 19349663ULL) ^ ((unsigned long long)k * 83492791ULL);
+}
+
+// Node matching. Every node in the local domain is paired with the closest
+// DRM station, if that one is within d_tol. The stations are hashed on a grid
+// of cells of side d_tol, so the stations within d_tol of a node are all in
+// the 27 cells around the one holding the node. Nodes outside the box of the
+// stations are skipped at once. The brute force search over all stations is
+// kept for the debug output and for a null tolerance.
+void H5DRMLoadPattern::node_matching(double d_tol, const ID & internal, const Matrix & xyz, const Vector & drmbox_x0, double & d_err, int & n_nodes_found)
 {
 
     if (MPI_local_rank == 0)
     {
-        H5DRMout << "node_matching_BruteForce - Begin! d_tol = " << d_tol << "\n";
-        H5DRMout << "                                  drmbox_x0(0) = " << drmbox_x0(0) << "\n";
-        H5DRMout << "                                  drmbox_x0(1) = " << drmbox_x0(1) << "\n";
-        H5DRMout << "                                  drmbox_x0(2) = " << drmbox_x0(2) << "\n";
+        H5DRMout << "node_matching - Begin! d_tol = " << d_tol << "\n";
+        H5DRMout << "                       drmbox_x0(0) = " << drmbox_x0(0) << "\n";
+        H5DRMout << "                       drmbox_x0(1) = " << drmbox_x0(1) << "\n";
+        H5DRMout << "                       drmbox_x0(2) = " << drmbox_x0(2) << "\n";
     }
 
     char debugfilename[100];
@@ -1620,6 +1806,44 @@ void H5DRMLoadPattern::node_matching_BruteForce(double d_tol, const ID & interna
         accounted_for[i] = false;
     }
 
+    // Box of the stations and grid of cells holding them
+    double bmin[3], bmax[3];
+    for (int dir = 0; dir < 3; ++dir)
+    {
+        bmin[dir] = std::numeric_limits<double>::infinity();
+        bmax[dir] = -std::numeric_limits<double>::infinity();
+    }
+    for (int ii = 0; ii < Nstations; ++ii)
+    {
+        for (int dir = 0; dir < 3; ++dir)
+        {
+            double c = xyz(ii, dir);
+            if (c < bmin[dir]) bmin[dir] = c;
+            if (c > bmax[dir]) bmax[dir] = c;
+        }
+    }
+
+    bool use_grid = !DEBUG_NODE_MATCHING && d_tol > 0 && Nstations > 0;
+    for (int dir = 0; use_grid && dir < 3; ++dir)
+    {
+        // cell indices must stay well within a long long
+        if ((bmax[dir] - bmin[dir]) / d_tol > 1.0e15)
+            use_grid = false;
+    }
+
+    std::unordered_map<unsigned long long, std::vector<int> > cells;
+    long long cell[3];
+    if (use_grid)
+    {
+        cells.reserve(Nstations);
+        for (int ii = 0; ii < Nstations; ++ii)
+        {
+            for (int dir = 0; dir < 3; ++dir)
+                cell[dir] = (long long)floor((xyz(ii, dir) - bmin[dir]) / d_tol);
+            cells[H5DRM_cell_key(cell[0], cell[1], cell[2])].push_back(ii);
+        }
+    }
+
     Domain *theDomain = this->getDomain();
     NodeIter& node_iter = theDomain->getNodes();
     int NDRM_points = theDomain->getNumNodes();
@@ -1638,17 +1862,55 @@ void H5DRMLoadPattern::node_matching_BruteForce(double d_tol, const ID & interna
             fprintf(fptrdrm, "%d %f %f %f\n", ++drmtag, node_xyz[0] , node_xyz[1] , node_xyz[2] );
         }
 
-        Vector station_xyz(3);
-        for (int ii = 0; ii < xyz.noRows(); ++ii)
+        if (use_grid)
+        {
+            bool inside = true;
+            for (int dir = 0; dir < 3; ++dir)
+            {
+                if (node_xyz(dir) < bmin[dir] - d_tol || node_xyz(dir) > bmax[dir] + d_tol)
+                    inside = false;
+                else
+                    cell[dir] = (long long)floor((node_xyz(dir) - bmin[dir]) / d_tol);
+            }
+
+            for (int di = -1; inside && di <= 1; ++di)
+            for (int dj = -1; dj <= 1; ++dj)
+            for (int dk = -1; dk <= 1; ++dk)
+            {
+                std::unordered_map<unsigned long long, std::vector<int> >::const_iterator it =
+                    cells.find(H5DRM_cell_key(cell[0] + di, cell[1] + dj, cell[2] + dk));
+                if (it == cells.end())
+                    continue;
+                const std::vector<int>& stations = it->second;
+                for (size_t s = 0; s < stations.size(); ++s)
+                {
+                    int ii = stations[s];
+                    double dx = node_xyz(0) - xyz(ii, 0);
+                    double dy = node_xyz(1) - xyz(ii, 1);
+                    double dz = node_xyz(2) - xyz(ii, 2);
+                    double d = sqrt(dx * dx + dy * dy + dz * dz);
+                    // ties go to the lowest station, as in the brute force
+                    if (d < dmin || (d == dmin && ii < ii_station_min))
+                    {
+                        dmin = d;
+                        ii_station_min = ii;
+                    }
+                }
+            }
+        }
+        else
         {
-            station_xyz(0) = xyz(ii, 0);
-            station_xyz(1) = xyz(ii, 1);
-            station_xyz(2) = xyz(ii, 2);
-            double d = (node_xyz - station_xyz).Norm();
-            if (d < dmin)
+            for (int ii = 0; ii < Nstations; ++ii)
             {
-                dmin = d;
-                ii_station_min = ii;
+                double dx = node_xyz(0) - xyz(ii, 0);
+                double dy = node_xyz(1) - xyz(ii, 1);
+                double dz = node_xyz(2) - xyz(ii, 2);
+                double d = sqrt(dx * dx + dy * dy + dz * dz);
+                if (d < dmin)
+                {
+                    dmin = d;
+                    ii_station_min = ii;
+                }
             }
         }
 
@@ -1732,7 +1994,7 @@ void H5DRMLoadPattern::node_matching_BruteForce(double d_tol, const ID & interna
 
     if (MPI_local_rank == 0)
     {
-        H5DRMout << "node_matching_BruteForce - End!\n";
+        H5DRMout << "node_matching - End!\n";
         H5DRMout << "Accounted for " << n_accounted_for << " out of " << Nstations << " stations\n";
     }
 
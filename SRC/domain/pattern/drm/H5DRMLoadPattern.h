@@ -57,7 +57,12 @@
 //    needed. Please let me (jaabell) know if you think this is needed in
 //    some case, I would be happy to discuss and implement this and also
 //    know why it might be needed. (coupled poroelasticity?)
-//  + It has been tested to work in parallel. 
+//  + It has been tested to work in parallel. Each process only reads the
+//    motions of its own DRM nodes.
+//  + Motions are read in blocks of H5DRM_CACHE_TSTEPS time steps for all
+//    the local DRM nodes at once (one read per dataset and block) and
+//    interpolated from memory. With a thread-safe HDF5 library the next
+//    block is read in the background while the current one is used.
 //  + The H5DRM data format specification is documented in [3].
 //  + Based on and and extends the work done for my PhD thesis [4].
 // 
@@ -92,6 +97,9 @@
 #include <string>
 
 #include <hdf5.h>
+#ifdef H5_HAVE_THREADSAFE
+#include <thread>
+#endif
 
 #include <ID.h>
 #include <Vector.h>
@@ -108,6 +116,7 @@
 #include <LoadPattern.h>
 
 #define H5DRM_PREALLOC_TSTEPS 10
+#define H5DRM_CACHE_TSTEPS 32
 #define H5DRM_MAX_RETURN_OPEN_OBJS 100
 #define H5DRM_MAX_FILENAME 200
 #define H5DRM_MAX_STRINGSIZE 80
@@ -150,11 +159,16 @@ protected:
     bool  drm_differentiate_displacements(double next_integration_time);
     bool  drm_integrate_velocity(double next_integration_time);
     bool  drm_direct_read(double next_integration_time);
+    bool  drm_cache_setup();
+    bool  drm_cache_read_block(int start, int len, std::vector<double>& dis, std::vector<double>& acc);
+    bool  drm_cache_load(int i1, int i2);
+    void  drm_cache_prefetch();
+    void  drm_cache_clear();
     Vector *getNodalLoad(int node, double time);
 
     void do_intitialization();
 
-    void node_matching_BruteForce(double d_tol, const ID& internal, const Matrix& xyz, const Vector& drmbox_x0, double& d_err, int & n_nodes_found);
+    void node_matching(double d_tol, const ID& internal, const Matrix& xyz, const Vector& drmbox_x0, double& d_err, int & n_nodes_found);
 
 private:
 
@@ -163,6 +177,7 @@ private:
     ID DRM_Elements;                
     ID DRM_Nodes;                  
     ID DRM_Boundary_Flag;              
+    std::vector<int> DRM_Element_Pos;   // local positions of the nodes of each DRM element, in turn
 
     Vector DRM_F;    // vector containing the DRM equivalent-loads
     Vector DRM_D;    // vector containing the displacements at DRM boundary nodes
@@ -197,6 +212,22 @@ private:
     hid_t ih5_one_node_ms;
     hid_t ih5_xfer_plist;
 
+    // Time-block cache of the motions of the local DRM nodes. The rows of
+    // the motion datasets used by this process are kept sorted in
+    // cache_file_rows, cache_row gives the cache row of each DRM node dof.
+    // A block holds cache_len steps starting at cache_start, row major.
+    int cache_num_tsteps;               // number of time samples in the datasets
+    std::vector<hsize_t> cache_file_rows;
+    std::vector<int> cache_row;
+    int cache_start, cache_len;
+    std::vector<double> cache_dis, cache_acc;
+    int next_start, next_len;           // the block read ahead, if any
+    std::vector<double> next_dis, next_acc;
+    bool next_ok;
+#ifdef H5_HAVE_THREADSAFE
+    std::thread prefetcher;
+#endif
+
     int MPI_local_rank;         // MPI Process-id (rank) in the case of parallel processing
 
     bool do_coordinate_transformation;
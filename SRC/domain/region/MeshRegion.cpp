@@ -320,6 +320,56 @@ MeshRegion::setRayleighDampingFactors(double alpham, double betak, double betak0
   return 0;
 }
 
+int
+MeshRegion::setActive(bool active)
+{
+  Domain *theDomain = this->getDomain();
+  if (theDomain == 0) {
+    opserr << "MeshRegion::setActive() - no domain yet set\n";
+    return -1;
+  }
+
+  if (theElements != 0) {
+    if (active == true)
+      theDomain->activateElements(*theElements);
+    else
+      theDomain->deactivateElements(*theElements);
+  }
+
+  return 0;
+}
+
+// setFrozen(frozen):
+//	freezes the elements of the region, which are then represented by
+//	their tangent and resisting force at the freeze and are no longer
+//	updated or committed, or thaws them.
+
+int
+MeshRegion::setFrozen(bool frozen)
+{
+  Domain *theDomain = this->getDomain();
+  if (theDomain == 0) {
+    opserr << "MeshRegion::setFrozen() - no domain yet set\n";
+    return -1;
+  }
+
+  int res = 0;
+  if (theElements != 0) {
+    for (int i=0; i<theElements->Size(); i++) {
+      int eleTag = (*theElements)(i);
+      Element *theEle = theDomain->getElement(eleTag);
+      if (theEle == 0)
+	continue;
+      if (frozen == true)
+	res += theEle->freeze();
+      else
+	res += theEle->thaw();
+    }
+  }
+
+  return res;
+}
+
 int
 MeshRegion::setDamping(Damping *theDamping)
 {
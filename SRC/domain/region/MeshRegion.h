@@ -70,6 +70,11 @@ class MeshRegion : public DomainComponent
 					  double betaKc);
 
     virtual int setDamping(Damping *theDamping);
+
+    // methods to activate or deactivate the elements of the region, and
+    // to freeze them at their current state or thaw them again
+    virtual int setActive(bool active);
+    virtual int setFrozen(bool frozen);
     virtual int setParameter(const char **argv, int argc, Parameter &param);
 
     // methods to send & recv data for database/parallel applications
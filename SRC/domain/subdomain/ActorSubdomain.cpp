@@ -24,6 +24,7 @@
                                                                         
 #include <ActorSubdomain.h>
 #include <FEM_ObjectBroker.h>
+#include <BufferedChannel.h>
 #include <Element.h>
 #include <Node.h>
 #include <SP_Constraint.h>
@@ -48,6 +49,10 @@
 #include <ArrayOfTaggedObjects.h>
 #include <ShadowActorSubdomain.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // 2 procedurs defined in SP_Constraint.cpp
 int SP_Constraint_GetNextTag();
 int SP_Constraint_SetNextTag(int);
@@ -55,14 +60,17 @@ int SP_Constraint_SetNextTag(int);
 ActorSubdomain::ActorSubdomain(Channel &theChannel,
 			       FEM_ObjectBroker &theBroker)
 :Subdomain(0), Actor(theChannel,theBroker,0),
- msgData(4),lastResponse(0)
+ msgData(4),lastResponse(0), theBatch(0)
 {
   // does nothing
 }
     
 ActorSubdomain::~ActorSubdomain()
 {
-  // does nothing
+  if (theBatch != 0) {
+    theChannel = &theBatch->getChannel();
+    delete theBatch;
+  }
 }
 
 
@@ -959,6 +967,48 @@ opserr << "ActorSubdomain::addSP_AXIS :: DONE\n";
 	   delete theV;
 	   break;
 
+	  case ShadowActorSubdomain_setParallelUpdate:
+	    this->Subdomain::setParallelUpdate(msgData(1) != 0);
+#ifdef _OPENMP
+	    if (msgData(2) > 0)
+	      omp_set_num_threads(msgData(2));
+#endif
+	    break;
+
+	  case ShadowActorSubdomain_getElementCosts:
+	    {
+	      ID eleTags(0);
+	      Vector eleCosts(0);
+	      this->Subdomain::getElementCosts(eleTags, eleCosts);
+	      msgData(0) = eleTags.Size();
+	      this->sendID(msgData);
+	      if (eleTags.Size() != 0) {
+		this->sendID(eleTags);
+		this->sendVector(eleCosts);
+	      }
+	    }
+	    break;
+
+	  case ShadowActorSubdomain_setMeasureCost:
+	    this->Subdomain::setMeasureCost(msgData(1) != 0);
+	    break;
+
+	  case ShadowActorSubdomain_beginBatch:
+	    if (theBatch == 0) {
+	      theBatch = new BufferedChannel(*theChannel);
+	      theChannel = theBatch;
+	    }
+	    break;
+
+	  case ShadowActorSubdomain_endBatch:
+	    if (theBatch != 0) {
+	      theBatch->flush();
+	      theChannel = &theBatch->getChannel();
+	      delete theBatch;
+	      theBatch = 0;
+	    }
+	    break;
+
 
          case ShadowActorSubdomain_addParameter:
 	    theType = msgData(1);
@@ -39,6 +39,8 @@
 #include "Subdomain.h"
 #include <Actor.h>
 
+class BufferedChannel;
+
 class ActorSubdomain: public Subdomain, public Actor
 {
   public:
@@ -60,6 +62,7 @@ class ActorSubdomain: public Subdomain, public Actor
   private:
     ID msgData;
     Vector *lastResponse;
+    BufferedChannel *theBatch; // non-zero while the messages are batched
 };
 	
 		   
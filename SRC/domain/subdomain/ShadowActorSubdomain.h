@@ -102,3 +102,8 @@ static const int ShadowActorSubdomain_addSP_ConstraintAXIS = 103;
 static const int ShadowActorSubdomain_getDomainChangeFlag = 104;
 static const int ShadowActorSubdomain_record = 105;
 static const int ShadowActorSubdomain_getElementResponse = 106;
+static const int ShadowActorSubdomain_setParallelUpdate = 107;
+static const int ShadowActorSubdomain_getElementCosts = 108;
+static const int ShadowActorSubdomain_setMeasureCost = 109;
+static const int ShadowActorSubdomain_beginBatch = 110;
+static const int ShadowActorSubdomain_endBatch = 111;
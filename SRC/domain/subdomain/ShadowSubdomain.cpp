@@ -34,6 +34,7 @@
 
 
 #include <ShadowSubdomain.h>
+#include <BufferedChannel.h>
 #include <stdlib.h>
 
 #include <Node.h> 
@@ -68,6 +69,10 @@
 #include <ShadowActorSubdomain.h>
 #include <actor/message/Message.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 int ShadowSubdomain::count = 0; // MHS
 int ShadowSubdomain::numShadowSubdomains = 0;
 ShadowSubdomain **ShadowSubdomain::theShadowSubdomains = 0;
@@ -138,7 +143,7 @@ ShadowSubdomain::ShadowSubdomain(int tag,
    numDOF(0),numElements(0),numNodes(0),numExternalNodes(0),
    numSPs(0),numMPs(0), buildRemote(false), gotRemoteData(false), 
    theFEele(0),
-   theVector(0), theMatrix(0)
+   theVector(0), theMatrix(0), theBatch(0)
 {
 
   numShadowSubdomains++;
@@ -176,6 +181,11 @@ ShadowSubdomain::~ShadowSubdomain()
   delete theShadowSPs;
   delete theShadowMPs;
   delete theShadowLPs;
+
+  if (theBatch != 0) {
+    theChannel = &theBatch->getChannel();
+    delete theBatch;
+  }
 }
 
 /*
@@ -967,6 +977,25 @@ ShadowSubdomain::setRayleighDampingFactors(double alphaM, double betaK, double b
 
 
 
+// the actor's subdomain is told to do the same, with as many OpenMP
+// threads as this process has, so each rank updates & assembles its
+// elements with threads while the messages stay one per subdomain
+void
+ShadowSubdomain::setParallelUpdate(bool onOff)
+{
+    this->Subdomain::setParallelUpdate(onOff);
+
+    msgData(0) = ShadowActorSubdomain_setParallelUpdate;
+    msgData(1) = onOff ? 1 : 0;
+#ifdef _OPENMP
+    msgData(2) = omp_get_max_threads();
+#else
+    msgData(2) = 0;
+#endif
+    this->sendID(msgData);
+}
+
+
 int
 ShadowSubdomain::update(void)
 {
@@ -1443,15 +1472,72 @@ ShadowSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
 double
 ShadowSubdomain::getCost(void)    
 {
-  /*
     msgData(0) = ShadowActorSubdomain_getCost;
     
     this->sendID(msgData);
-    Vector cost(2);
+    Vector cost(4);
     this->recvVector(cost);
     return cost(0);
-  */
-  return 0.0;
+}
+
+
+int
+ShadowSubdomain::getElementCosts(ID &eleTags, Vector &eleCosts)
+{
+    msgData(0) = ShadowActorSubdomain_getElementCosts;
+    this->sendID(msgData);
+
+    this->recvID(msgData);
+    int numEle = msgData(0);
+    eleTags.resize(numEle);
+    eleCosts.resize(numEle);
+    if (numEle != 0) {
+      this->recvID(eleTags);
+      this->recvVector(eleCosts);
+    }
+
+    return 0;
+}
+
+
+void
+ShadowSubdomain::setMeasureCost(bool onOff)
+{
+    msgData(0) = ShadowActorSubdomain_setMeasureCost;
+    msgData(1) = onOff ? 1 : 0;
+    this->sendID(msgData);
+}
+
+
+int
+ShadowSubdomain::setBatchedTransfer(bool onOff)
+{
+    // while on, the many small messages sent by addNode(), addElement()
+    // .. and the sendSelf() of the objects are collected and sent
+    // in a few large messages
+    if (onOff == true) {
+      if (theBatch != 0)
+	return 0;
+      msgData(0) = ShadowActorSubdomain_beginBatch;
+      this->sendID(msgData);
+      theBatch = new BufferedChannel(*theChannel);
+      theChannel = theBatch;
+    } else {
+      if (theBatch == 0)
+	return 0;
+      msgData(0) = ShadowActorSubdomain_endBatch;
+      this->sendID(msgData);
+      int res = theBatch->flush();
+      theChannel = &theBatch->getChannel();
+      delete theBatch;
+      theBatch = 0;
+      if (res < 0) {
+	opserr << "ShadowSubdomain::setBatchedTransfer() - failed to send the last batch\n";
+	return -1;
+      }
+    }
+
+    return 0;
 }
 
 
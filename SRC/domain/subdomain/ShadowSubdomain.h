@@ -41,6 +41,8 @@
 #include <actor/shadow/Shadow.h>
 #include <remote.h>
 
+class BufferedChannel;
+
 class ShadowSubdomain: public Shadow, public Subdomain
 {
   public:
@@ -77,6 +79,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
 
     virtual bool hasNode(int tag);
     virtual bool hasElement(int tag);
+    virtual bool isThreadSafe(void) {return false;} // one channel to the actor
 
     virtual void clearAll(void);	
     virtual Element 	  *removeElement(int tag);
@@ -121,6 +124,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
     virtual  void applyLoad(double pseudoTime);
     virtual  void setLoadConstant(void);    
     virtual  int  setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc);
+    virtual  void setParallelUpdate(bool onOff);
 
     virtual  int update(void);    
     virtual  int update(double newTime, double dT);    
@@ -166,6 +170,9 @@ class ShadowSubdomain: public Shadow, public Subdomain
 			 FEM_ObjectBroker &theBroker);    
 
     virtual double getCost(void);
+    virtual int getElementCosts(ID &eleTags, Vector &eleCosts);
+    virtual void setMeasureCost(bool onOff);
+    virtual int setBatchedTransfer(bool onOff);
     
     virtual  void Print(OPS_Stream &s, int flag =0);
     virtual void Print(OPS_Stream &s, ID *nodeTags, ID *eleTags, int flag =0);
@@ -211,6 +218,8 @@ class ShadowSubdomain: public Shadow, public Subdomain
 
     Vector *theVector; // for storing residual info
     Matrix *theMatrix; // for storing tangent info
+
+    BufferedChannel *theBatch; // non-zero while the messages are batched
     
     static char *shadowSubdomainProgram;
 
@@ -39,6 +39,8 @@
 #include <DomainComponent.h>
 #include <Element.h>
 #include <Node.h>
+#include <ID.h>
+#include <Vector.h>
 #include <SP_Constraint.h>
 #include <MP_Constraint.h>
 #include <MapOfTaggedObjects.h>
@@ -67,7 +69,7 @@ Subdomain::Subdomain(int tag)
 :Element(tag,ELE_TAG_Subdomain),
  Domain(),
  mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
- realCost(0.0),cpuCost(0),pageCost(0),
+ realCost(0.0),cpuCost(0),pageCost(0),costTags(0),eleCosts(0),
  theAnalysis(0), extNodes(0), theFEele(0) 
 {
 
@@ -106,7 +108,7 @@ Subdomain::Subdomain(int tag,
    mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
    internalNodes(&theInternalNodeStorage),
    externalNodes(&theExternalNodeStorage), 
-   realCost(0.0),cpuCost(0),pageCost(0),
+   realCost(0.0),cpuCost(0),pageCost(0),costTags(0),eleCosts(0),
    theAnalysis(0), extNodes(0), theFEele(0)
 {
   //thePartitionedModelBuilder = 0;
@@ -147,6 +149,11 @@ Subdomain::~Subdomain()
     delete mappedVect;
   if (mappedMatrix != 0)
     delete mappedMatrix;
+
+  if (costTags != 0)
+    delete costTags;
+  if (eleCosts != 0)
+    delete eleCosts;
 }
 
 
@@ -673,6 +680,27 @@ Subdomain::isSubdomain(void)
 }
 
 
+// bool isThreadSafe(void);
+//	a subdomain in this process has its own nodes, analysis and condensed
+//	matrices, so it can be condensed and updated concurrently with other
+//	subdomains when all its elements are thread safe.
+
+bool
+Subdomain::isThreadSafe(void)
+{
+    if (theAnalysis == 0)
+	return false;
+
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
+    while ((theEle = theEles()) != 0)
+	if (theEle->isThreadSafe() == false)
+	    return false;
+
+    return true;
+}
+
+
 int 
 Subdomain::setRayleighDampingFactors(double alphaM, double betaK, double betaK0, double betaKc)
 {
@@ -875,10 +903,63 @@ Subdomain::getCost(void)
     cpuCost = 0.0;
     pageCost = 0;
 
+    // add in the time measured in the elements since the last call, the
+    // element costs are kept for getElementCosts() & then restarted
+    int numEle = this->getNumElements();
+    if (costTags == 0) {
+      costTags = new ID(numEle);
+      eleCosts = new Vector(numEle);
+    } else if (costTags->Size() != numEle) {
+      costTags->resize(numEle);
+      eleCosts->resize(numEle);
+    }
+
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
+    int i = 0;
+    while ((theEle = theEles()) != 0) {
+      double cost = theEle->getMeasuredCost();
+      (*costTags)(i) = theEle->getTag();
+      (*eleCosts)(i) = cost;
+      lastRealCost += cost;
+      theEle->resetMeasuredCost();
+      i++;
+    }
+
     return lastRealCost;
 }
 
 
+int
+Subdomain::getElementCosts(ID &eleTags, Vector &theCosts)
+{
+    if (costTags == 0) {
+      eleTags.resize(0);
+      theCosts.resize(0);
+      return 0;
+    }
+
+    eleTags = *costTags;
+    theCosts = *eleCosts;
+    return 0;
+}
+
+
+void
+Subdomain::setMeasureCost(bool onOff)
+{
+    Element::measureCost = onOff;
+}
+
+
+int
+Subdomain::setBatchedTransfer(bool onOff)
+{
+    // a local subdomain has nothing to send
+    return 0;
+}
+
+
 int
 Subdomain::buildMap(void)
 {
@@ -133,6 +133,7 @@ class Subdomain: public Element, public Domain
     virtual const Vector &getResistingForce(void);    
     virtual const Vector &getResistingForceIncInertia(void);        
     virtual bool isSubdomain(void);    
+    virtual bool isThreadSafe(void);
     virtual int setRayleighDampingFactors(double alphaM, 
 					  double betaK, 
 					  double betaK0, 
@@ -158,6 +159,9 @@ class Subdomain: public Element, public Domain
 			 FEM_ObjectBroker &theBroker);
 
     virtual double getCost(void);
+    virtual int getElementCosts(ID &eleTags, Vector &eleCosts);
+    virtual void setMeasureCost(bool onOff);
+    virtual int setBatchedTransfer(bool onOff);
     virtual int addResistingForceToNodalReaction(bool inclInertia);
     
   protected:    
@@ -178,6 +182,8 @@ class Subdomain: public Element, public Domain
     double realCost;
     double cpuCost;
     int pageCost;
+    ID *costTags;        // element costs summed in the last getCost()
+    Vector *eleCosts;
     DomainDecompositionAnalysis *theAnalysis;
     ID *extNodes;
     FE_Element *theFEele;
@@ -43,8 +43,13 @@
 #include <Matrix.h>
 #include <Node.h>
 #include <Domain.h>
+#include <chrono>
 
-Element  *ops_TheActiveElement = 0;
+thread_local Element  *ops_TheActiveElement = 0;
+
+bool Element::measureCost = false;
+bool Element::parallelPoints = false;
+bool Element::cacheGeometry = false;
 
 Matrix **Element::theMatrices; 
 Vector **Element::theVectors1; 
@@ -58,8 +63,9 @@ int  Element::numMatrices(0);
 Element::Element(int tag, int cTag) 
   :DomainComponent(tag, cTag), alphaM(0.0), 
   betaK(0.0), betaK0(0.0), betaKc(0.0), 
-      Kc(0), previousK(0), numPreviousK(0), index(-1), nodeIndex(-1),
-      is_this_element_active(true)
+      Kc(0), Cconst(0), CconstStamp(0), previousK(0), numPreviousK(0), index(-1), nodeIndex(-1),
+      is_this_element_active(true), measuredCost(0.0),
+      frozenK(0), frozenR(0), frozenU(0), frozenF(0)
 {
   // does nothing
   ops_TheActiveElement = this;
@@ -70,6 +76,11 @@ Element::~Element()
   if (Kc != 0)
     delete Kc;
 
+  if (Cconst != 0)
+    delete Cconst;
+
+  this->thaw();
+
   if (previousK != 0) {
     for (int i=0; i<numPreviousK; i++)
       delete previousK[i];
@@ -120,6 +131,12 @@ Element::setRayleighDampingFactors(double alpham, double betak, double betak0, d
   betaK0 = betak0;
   betaKc = betakc;
 
+  // the constant terms are formed again with the new factors
+  if (Cconst != 0) {
+    delete Cconst;
+    Cconst = 0;
+  }
+
   // check that memory has been allocated to store compute/return
   // damping matrix & residual force calculations
   if (index == -1) {
@@ -210,19 +227,38 @@ Element::setDamping(Domain *theDomain, Damping *theDamping)
 const Matrix &
 Element::getDamp(void) 
 {
+  // with no Rayleigh factors the damping matrix is zero; a thread local
+  // matrix is returned so that the class wide storage is not touched
+  if (alphaM == 0.0 && betaK == 0.0 && betaK0 == 0.0 && betaKc == 0.0) {
+    static thread_local Matrix zeroDamp;
+    int numDOF = this->getNumDOF();
+    if (zeroDamp.noRows() != numDOF)
+      zeroDamp.resize(numDOF, numDOF);
+    zeroDamp.Zero();
+    return zeroDamp;
+  }
+
   if (index  == -1) {
     this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
   }
 
-  // now compute the damping matrix
+  // if the tangent is constant so is the whole damping matrix
+  bool constantK = this->hasConstantTangent();
+  const Matrix *theConstant = this->getConstantDamp(constantK);
+  if (theConstant != 0 && constantK == true)
+    return *theConstant;
+
+  // now compute the damping matrix, the betaK0 term is kept
   Matrix *theMatrix = theMatrices[index]; 
   theMatrix->Zero();
+  if (theConstant != 0)
+    theMatrix->addMatrix(0.0, *theConstant, 1.0);
+  else if (betaK0 != 0.0)
+    theMatrix->addMatrix(1.0, this->getInitialStiff(), betaK0);      
   if (alphaM != 0.0)
-    theMatrix->addMatrix(0.0, this->getMass(), alphaM);
+    theMatrix->addMatrix(1.0, this->getMass(), alphaM);
   if (betaK != 0.0)
     theMatrix->addMatrix(1.0, this->getTangentStiff(), betaK);      
-  if (betaK0 != 0.0)
-    theMatrix->addMatrix(1.0, this->getInitialStiff(), betaK0);      
   if (betaKc != 0.0)
     theMatrix->addMatrix(1.0, *Kc, betaKc);      
 
@@ -231,6 +267,62 @@ Element::getDamp(void)
 }
 
 
+// getConstantDamp(bool constantK):
+//	returns the Rayleigh damping terms that do not change with the
+//	state of the element, betaK0*K0, or the whole damping matrix if
+//	constantK is true. They are formed on the first call and kept; they
+//	are formed again when the parameter stamp of the domain has changed,
+//	as Parameters can change the element properties. Returns 0 if there
+//	is nothing to keep.
+
+const Matrix *
+Element::getConstantDamp(bool constantK)
+{
+  if (betaK0 == 0.0 && constantK == false)
+    return 0;
+
+  Domain *theDomain = this->getDomain();
+  if (theDomain == 0) {
+    if (Cconst != 0) {
+      delete Cconst;
+      Cconst = 0;
+    }
+    return 0;
+  }
+
+  int stamp = theDomain->getParameterStamp();
+  if (Cconst != 0 && CconstStamp != stamp) {
+    delete Cconst;
+    Cconst = 0;
+  }
+
+  if (Cconst == 0) {
+    CconstStamp = stamp;
+    int numDOF = this->getNumDOF();
+    Cconst = new Matrix(numDOF, numDOF);
+    if (Cconst == 0 || Cconst->noRows() != numDOF) {
+      opserr << "WARNING Element::getConstantDamp() - out of memory\n";
+      if (Cconst != 0) delete Cconst;
+      Cconst = 0;
+      return 0;
+    }
+
+    if (betaK0 != 0.0)
+      Cconst->addMatrix(0.0, this->getInitialStiff(), betaK0);
+    if (constantK == true) {
+      if (alphaM != 0.0)
+	Cconst->addMatrix(1.0, this->getMass(), alphaM);
+      if (betaK != 0.0)
+	Cconst->addMatrix(1.0, this->getTangentStiff(), betaK);
+      if (betaKc != 0.0)
+	Cconst->addMatrix(1.0, *Kc, betaKc);
+    }
+  }
+
+  return Cconst;
+}
+
+
 
 const Matrix &
 Element::getMass(void)
@@ -319,7 +411,6 @@ Element::getRayleighDampingForces(void)
     this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
   }
 
-  Matrix *theMatrix = theMatrices[index]; 
   Vector *theVector = theVectors2[index];
   Vector *theVector2 = theVectors1[index];
 
@@ -339,19 +430,11 @@ Element::getRayleighDampingForces(void)
     }
   }
 
-  // now compute the damping matrix
-  theMatrix->Zero();
-  if (alphaM != 0.0)
-    theMatrix->addMatrix(0.0, this->getMass(), alphaM);
-  if (betaK != 0.0)
-    theMatrix->addMatrix(1.0, this->getTangentStiff(), betaK);      
-  if (betaK0 != 0.0)
-    theMatrix->addMatrix(1.0, this->getInitialStiff(), betaK0);      
-  if (betaKc != 0.0)
-    theMatrix->addMatrix(1.0, *Kc, betaKc);      
+  // the rayleigh damping matrix, not that of a subclass
+  const Matrix &theDamp = this->Element::getDamp();
 
   // finally the D * v
-  theVector->addMatrixVector(0.0, *theMatrix, *theVector2, 1.0);
+  theVector->addMatrixVector(0.0, theDamp, *theVector2, 1.0);
 
   return *theVector;
 }
@@ -415,6 +498,48 @@ Element::isSubdomain(void)
     return false;
 }
 
+// isThreadSafe():
+//	returns true only if the state determination methods of this
+//	element, update(), getTangentStiff(), getInitialStiff(), getDamp(),
+//	getMass(), getResistingForce() and getResistingForceIncInertia(),
+//	as well as commitState() and revertToLastCommit(), may be invoked
+//	concurrently with those of other elements in the domain, i.e. they
+//	neither write to static/global data nor to objects shared with
+//	other elements. Default is false; subclasses must opt in.
+
+bool
+Element::isThreadSafe(void)
+{
+    return false;
+}
+
+// hasConstantTangent():
+//	returns true only if getTangentStiff() returns the same matrix for
+//	any trial state of the element, so that it may be formed once and
+//	reused; the element properties are then only changed via
+//	setParameter()/updateParameter(). Default is false.
+
+bool
+Element::hasConstantTangent(void)
+{
+    return false;
+}
+
+// addToForceKernel():
+//	adds the element to an ExplicitForceKernel, which then forms its
+//	resisting force from the trial displacements of its nodes without
+//	invoking the element; loc gives the equation number of each entry
+//	of the element force vector. Returns 0 if added, -1 if the element
+//	in its present configuration (material, damping, loads) cannot be
+//	represented there. The state of an element in a kernel is not
+//	updated. Default is -1.
+
+int
+Element::addToForceKernel(ExplicitForceKernel &theKernel, const int *loc)
+{
+    return -1;
+}
+
 Response*
 Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
@@ -814,6 +939,115 @@ void Element::onDeactivate()
 }    
 
 
+// freeze():
+//	keeps the tangent and resisting force of the element at its current
+//	state, and the displacements of its nodes, so that it can be
+//	represented by them until thaw() is invoked. Returns -1 if the
+//	element is not in a domain or if its nodes are not found.
+
+int
+Element::freeze(void)
+{
+  if (frozenK != 0)
+    return 0;
+
+  int numDOF = this->getNumDOF();
+  Vector *u = new Vector(numDOF);
+  if (u == 0 || u->Size() != numDOF || this->getNodalDisp(*u) < 0) {
+    opserr << "WARNING Element::freeze() - element " << this->getTag();
+    opserr << " could not be frozen\n";
+    if (u != 0) delete u;
+    return -1;
+  }
+
+  frozenU = u;
+  frozenK = new Matrix(this->getTangentStiff());
+  frozenF = new Vector(numDOF);
+
+  // R - K*u0 is kept, the force is then that plus K*u
+  frozenR = new Vector(this->getResistingForce());
+  frozenR->addMatrixVector(1.0, *frozenK, *frozenU, -1.0);
+
+  return 0;
+}
+
+int
+Element::thaw(void)
+{
+  if (frozenK != 0)
+    delete frozenK;
+  if (frozenR != 0)
+    delete frozenR;
+  if (frozenU != 0)
+    delete frozenU;
+  if (frozenF != 0)
+    delete frozenF;
+
+  frozenK = 0;
+  frozenR = 0;
+  frozenU = 0;
+  frozenF = 0;
+
+  return 0;
+}
+
+const Matrix &
+Element::getFrozenTangent(void)
+{
+  if (frozenK == 0)
+    return this->getTangentStiff();
+
+  return *frozenK;
+}
+
+// getFrozenResistingForce():
+//	returns R + K*(u - u0), R, K and u0 the resisting force, tangent
+//	and nodal displacements at the freeze and u the current trial
+//	displacements of the nodes.
+
+const Vector &
+Element::getFrozenResistingForce(void)
+{
+  if (frozenK == 0)
+    return this->getResistingForce();
+
+  this->getNodalDisp(*frozenU);
+  *frozenF = *frozenR;
+  frozenF->addMatrixVector(1.0, *frozenK, *frozenU, 1.0);
+
+  return *frozenF;
+}
+
+int
+Element::getNodalDisp(Vector &u)
+{
+  Node **theNodes = this->getNodePtrs();
+  int numNodes = this->getNumExternalNodes();
+  if (theNodes == 0)
+    return -1;
+
+  int loc = 0;
+  for (int i = 0; i < numNodes; i++) {
+    if (theNodes[i] == 0)
+      return -1;
+    const Vector &disp = theNodes[i]->getTrialDisp();
+    if (loc + disp.Size() > u.Size())
+      return -1;
+    for (int j = 0; j < disp.Size(); j++)
+      u(loc++) = disp(j);
+  }
+
+  return (loc == u.Size()) ? 0 : -1;
+}
+
+
+double
+Element::wallTime(void)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
 bool  Element::isActive()
 {
     // opserr << "Element::isActive() [tag = " << this->getTag() << "] = ";
@@ -47,6 +47,8 @@ class Response;
 class ElementalLoad;
 class Node;
 class Damping;
+class ExplicitForceKernel;
+class SectionForceDeformation;
 
 class Element : public DomainComponent
 {
@@ -67,6 +69,9 @@ class Element : public DomainComponent
     virtual int revertToStart(void);                
     virtual int update(void);
     virtual bool isSubdomain(void);
+    virtual bool isThreadSafe(void);
+    virtual bool hasConstantTangent(void);
+    virtual int addToForceKernel(ExplicitForceKernel &theKernel, const int *loc);
     
     // methods to return the current linearized stiffness,
     // damping and mass matrices
@@ -98,6 +103,15 @@ class Element : public DomainComponent
 
     virtual int displaySelf(Renderer &, int mode, float fact, const char **displayModes=0, int numModes=0);
 
+    // bytes of the material & section objects of the element, for the
+    // memory report; 0 if the element does not account for them
+    virtual size_t getMaterialMemoryUsage(void) {return 0;};
+
+    // the sections of a beam-column, for the recorders reading them
+    // directly; 0 sections if the element gives no access to them
+    virtual int getNumSections(void) {return 0;};
+    virtual SectionForceDeformation *getSection(int i) {return 0;};
+
 // AddingSensitivity:BEGIN //////////////////////////////////////////
     virtual int addInertiaLoadSensitivityToUnbalance(const Vector &accel, bool tag);
     virtual const Vector & getResistingForceSensitivity(int gradIndex);
@@ -122,13 +136,45 @@ class Element : public DomainComponent
 
     bool isActive();
 
+    // a frozen element is kept at its state when frozen; update() and
+    // commits are not invoked on it and its tangent and resisting force
+    // are those at the freeze, the force changing linearly with the
+    // displacement of its nodes since then
+    int freeze(void);
+    int thaw(void);
+    bool isFrozen(void) const {return frozenK != 0;};
+    const Matrix &getFrozenTangent(void);
+    const Vector &getFrozenResistingForce(void);
+
+    // wall clock time spent in update() and in forming the tangent,
+    // summed while Element::measureCost is set; the partitioner uses it
+    // to weight the element graph when it rebalances the subdomains
+    static bool measureCost;
+    static double wallTime(void);
+    void addMeasuredCost(double seconds) {measuredCost += seconds;};
+    double getMeasuredCost(void) {return measuredCost;};
+    void resetMeasuredCost(void) {measuredCost = 0.0;};
+
+    // while set, elements with many integration points may split their
+    // loops over the points into tasks run by the threads of the process
+    static bool parallelPoints;
+
+    // while set, small strain elements keep their shape function
+    // derivatives and integration weights at the points, formed from the
+    // nodal coordinates, instead of forming them on every state call;
+    // trades memory per element for the time of the Jacobians
+    static bool cacheGeometry;
+
 
 
 protected:
 	const Vector& getRayleighDampingForces(void);
+	const Matrix *getConstantDamp(bool constantK);
 
     double alphaM, betaK, betaK0, betaKc;
     Matrix *Kc; // pointer to hold last committed matrix if needed for rayleigh damping
+    Matrix *Cconst; // the rayleigh damping terms that don't change with the state
+    int CconstStamp; // parameter stamp of the domain Cconst was formed at
 
     Matrix **previousK;
     int numPreviousK;
@@ -143,6 +189,14 @@ protected:
     bool is_this_element_active;
 
   private:
+    double measuredCost;
+
+    // tangent and R - K*u0 at the freeze, nodal displacements & force
+    Matrix *frozenK;
+    Vector *frozenR;
+    Vector *frozenU;
+    Vector *frozenF;
+    int getNodalDisp(Vector &u);
 };
 
 
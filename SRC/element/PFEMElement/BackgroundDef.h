@@ -33,9 +33,11 @@
 #include <Vector.h>
 #include <math.h>
 
+#include <deque>
 #include <iostream>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 class Particle;
@@ -73,6 +75,80 @@ double dotVDouble(const VDouble& v1, const VDouble& v2);
 void crossVDouble(const VDouble& v1, const VDouble& v2, VDouble& res);
 double distanceVDouble(const VDouble& v1, const VDouble& v2);
 
+// hash of a grid index
+struct VIntHash {
+    size_t operator()(const VInt& v) const {
+        size_t h = v.size();
+        for (int i = 0; i < (int)v.size(); ++i) {
+            h ^= (size_t)(unsigned int)v[i] + 0x9e3779b9 + (h << 6) +
+                 (h >> 2);
+        }
+        return h;
+    }
+};
+
+// grid objects (cells or nodes) hashed on their grid index and kept
+// in blocks in the order they were added, so that references and
+// iterators stay valid when more are added and the i-th one can be
+// reached directly by the parallel loops over them
+template <class T>
+class BGridMap {
+   public:
+    typedef std::pair<VInt, T> value_type;
+
+    class iterator {
+       public:
+        iterator() : map(0), pos(0) {}
+        iterator(BGridMap* m, int p) : map(m), pos(p) {}
+        value_type& operator*() const { return map->items[pos]; }
+        value_type* operator->() const { return &(map->items[pos]); }
+        iterator& operator++() {
+            ++pos;
+            return *this;
+        }
+        bool operator==(const iterator& other) const {
+            return pos == other.pos;
+        }
+        bool operator!=(const iterator& other) const {
+            return pos != other.pos;
+        }
+
+       private:
+        BGridMap* map;
+        int pos;
+    };
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, (int)items.size()); }
+    iterator find(const VInt& index) {
+        typename std::unordered_map<VInt, int, VIntHash>::const_iterator
+            it = locs.find(index);
+        if (it == locs.end()) return end();
+        return iterator(this, it->second);
+    }
+    T& operator[](const VInt& index) {
+        std::pair<typename std::unordered_map<VInt, int,
+                                              VIntHash>::iterator,
+                  bool>
+            res = locs.insert(std::make_pair(index, (int)items.size()));
+        if (res.second) {
+            items.push_back(value_type(index, T()));
+        }
+        return items[res.first->second].second;
+    }
+    value_type& at(int i) { return items[i]; }
+    int size() const { return (int)items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() {
+        items.clear();
+        locs.clear();
+    }
+
+   private:
+    std::deque<value_type> items;
+    std::unordered_map<VInt, int, VIntHash> locs;
+};
+
 // BACKGROUND_FLUID - a grid fluid node
 // BACKGROUND_STRUCTURE - a structural node
 // BACKGROUND_FLUID_STRUCTURE - a structural node for SSI and a fluid node for FSI
@@ -501,7 +501,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
             index[0] = i;
             for (int j = minind[1]; j < maxind[1]; ++j) {
                 index[1] = j;
-                std::map<VInt, BCell>::iterator it =
+                BGridMap<BCell>::iterator it =
                     bcells.find(index);
                 if (it != bcells.end()) {
                     BCell& cell = it->second;
@@ -521,7 +521,7 @@ void BackgroundMesh::gatherParticles(const VInt& minind,
                 index[1] = j;
                 for (int k = minind[2]; k < maxind[2]; ++k) {
                     index[2] = k;
-                    std::map<VInt, BCell>::iterator it =
+                    BGridMap<BCell>::iterator it =
                         bcells.find(index);
                     if (it != bcells.end()) {
                         BCell& cell = it->second;
@@ -787,7 +787,7 @@ void BackgroundMesh::clearGrid() {
     if (domain == 0) return;
 
     // remove cells
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
+    for (BGridMap<BNode>::iterator it = bnodes.begin();
          it != bnodes.end(); ++it) {
         BNode& bnode = it->second;
         const VInt& tags = bnode.getTags();
@@ -1185,6 +1185,8 @@ int BackgroundMesh::addStructure() {
 // add the particle to the cell
 // add bnodes to the cell
 int BackgroundMesh::addParticles() {
+    int ndm = OPS_GetNDM();
+
     // for all particles
     TaggedObjectIter& meshes = OPS_getAllMesh();
     Mesh* mesh = 0;
@@ -1205,30 +1207,40 @@ int BackgroundMesh::addParticles() {
         }
 
         // remove particles
-        VInt rm(group->numParticles(), 0);
+        int numpts = group->numParticles();
+        VInt rm(numpts, 0);
 
-        // for all particles
-        for (int j = 0; j < group->numParticles(); j++) {
-            // get particle
+        // the cell indices of the particles, found in parallel
+        VInt pindex(numpts * ndm, 0);
+#pragma omp parallel for schedule(static, 1024)
+        for (int j = 0; j < numpts; j++) {
             Particle* p = group->getParticle(j);
             if (p == 0) continue;
-
-            // get particle coordinates
             const VDouble& crds = p->getCrds();
-
-            // get index
-            VInt index;
-            lowerIndex(crds, index);
-
-            // if out of range
-            for (int i = 0; i < (int)index.size(); ++i) {
-                if (index[i] < lower[i] || index[i] >= upper[i]) {
+            for (int i = 0; i < ndm; ++i) {
+                int ind = (int)floor(crds[i] / bsize);
+                pindex[j * ndm + i] = ind;
+                if (ind < lower[i] || ind >= upper[i]) {
                     rm[j] = 1;
-                    break;
                 }
             }
+        }
+
+        // then the particles are added to the cells in order
+        VInt index(ndm);
+        for (int j = 0; j < numpts; j++) {
+            // get particle
+            Particle* p = group->getParticle(j);
+            if (p == 0) continue;
+
+            // if out of range
             if (rm[j] == 1) continue;
 
+            // get index
+            for (int i = 0; i < ndm; ++i) {
+                index[i] = pindex[j * ndm + i];
+            }
+
             // get bcell
             BCell& bcell = bcells[index];
 
@@ -1272,30 +1284,19 @@ int BackgroundMesh::gridNodes() {
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
 
-    // vector of iterators
-    std::vector<std::map<VInt, BNode>::iterator> iters;
-    iters.reserve(bnodes.size());
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
-         it != bnodes.end(); ++it) {
-        iters.push_back(it);
-    }
-
     // vector of new objects
+    int numnodes = bnodes.size();
     int ndtag = Mesh::nextNodeTag();
-    std::vector<Node*> newnodes(iters.size(), 0),
-        newpnodes(iters.size(), 0);
-    std::vector<Pressure_Constraint*> newpcs(iters.size(), 0);
+    std::vector<Node*> newnodes(numnodes, 0), newpnodes(numnodes, 0);
+    std::vector<Pressure_Constraint*> newpcs(numnodes, 0);
 
     int res = 0;
 
-#pragma omp parallel for
-    for (int j = 0; j < (int)iters.size(); ++j) {
-        // get iterator
-        std::map<VInt, BNode>::iterator it = iters[j];
-
-        // get cell
-        const VInt& index = it->first;
-        BNode& bnode = it->second;
+#pragma omp parallel for schedule(dynamic, 64) reduction(min : res)
+    for (int j = 0; j < numnodes; ++j) {
+        // get node
+        const VInt& index = bnodes.at(j).first;
+        BNode& bnode = bnodes.at(j).second;
         if (bnode.getType() == BACKGROUND_FIXED) {
             continue;
         }
@@ -1783,20 +1784,34 @@ int BackgroundMesh::moveFixedParticles() {
     return 0;
 }
 
+// adds to the domain the center nodes of the cells flagged in
+// needcenter, with the tags used for them in elends; a cell whose
+// center node could not be created has its elements dropped
+void BackgroundMesh::createCenterNodes(const std::vector<BCell*>& cells,
+                                       const VInt& needcenter,
+                                       int ndtag, int numele,
+                                       VVInt& elends) {
+    for (int j = 0; j < (int)cells.size(); ++j) {
+        if (needcenter[j] == 0) continue;
+        Node* center_node =
+            cells[j]->setCenterNode(ndtag + 2 * j + 1, ndtag + 2 * j + 2);
+        if (center_node == 0) {
+            for (int i = 0; i < numele; ++i) {
+                elends[numele * j + i].clear();
+            }
+        }
+    }
+}
+
 int BackgroundMesh::gridFluid() {
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
     int ndm = OPS_GetNDM();
 
     // store cells in a vector
-    std::vector<BCell*> cells;
-    VVInt indices;
-    cells.reserve(bcells.size());
-    indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
-        indices.push_back(it->first);
-        cells.push_back(&(it->second));
+    std::vector<BCell*> cells(bcells.size());
+    for (int j = 0; j < (int)cells.size(); ++j) {
+        cells[j] = &(bcells.at(j).second);
     }
 
     // create elements in each cell
@@ -1821,8 +1836,11 @@ int BackgroundMesh::gridFluid() {
     VVInt elends(numele * cells.size());
     VInt gtags(numele * cells.size());
     int ndtag = Mesh::nextNodeTag();
-// #pragma omp parallel for
-// TODO: setCenterNode will add nodes to domain. Can't be in parallel.
+
+    // the center nodes are added to the domain after the loop, in
+    // the order of the cells; their tags are known in advance
+    VInt needcenter(cells.size(), 0);
+#pragma omp parallel for schedule(dynamic, 64)
     for (int j = 0; j < (int)cells.size(); ++j) {
         // structural cell
         if (cells[j]->getType() == BACKGROUND_STRUCTURE) continue;
@@ -1865,16 +1883,11 @@ int BackgroundMesh::gridFluid() {
             }
         }
 
-        // create center node
-        Node* center_node = 0;
+        // center node
+        int center_tag = 0;
         if (use_center_node) {
-            center_node =
-                cells[j]->setCenterNode(
-                    ndtag + 2 * j + 1,
-                    ndtag + 2 * j + 2);
-            if (center_node == 0) {
-                continue;
-            }
+            center_tag = ndtag + 2 * j + 1;
+            needcenter[j] = 1;
         }
         for (int i = 0; i < numele; ++i) {
             elends[numele * j + i].resize(numelenodes);
@@ -1882,7 +1895,7 @@ int BackgroundMesh::gridFluid() {
 
         // create elements
         if (ndm == 2) {
-            if (center_node == 0) {
+            if (!use_center_node) {
                 // two elements
                 elends[numele * j][0] = cnodes[0];
                 elends[numele * j][1] = cnodes[3];
@@ -1893,7 +1906,6 @@ int BackgroundMesh::gridFluid() {
                 elends[numele * j + 1][2] = cnodes[3];
             } else {
                 // four elements
-                int center_tag = center_node->getTag();
                 elends[numele * j][0] = center_tag;
                 elends[numele * j][1] = cnodes[2];
                 elends[numele * j][2] = cnodes[0];
@@ -1913,7 +1925,7 @@ int BackgroundMesh::gridFluid() {
 
 
         } else if (ndm == 3) {
-            if (center_node == 0) {
+            if (!use_center_node) {
                 // six elements
                 elends[numele * j][0] = cnodes[0];
                 elends[numele * j][1] = cnodes[7];
@@ -1946,7 +1958,6 @@ int BackgroundMesh::gridFluid() {
                 elends[numele * j + 5][3] = cnodes[7];
             } else {
                 // twelve elements
-                int center_tag = center_node->getTag();
 
                 // front
                 elends[numele * j][0] = center_tag;
@@ -2018,6 +2029,9 @@ int BackgroundMesh::gridFluid() {
         }
     }
 
+    // create center nodes, no elements in a cell without one
+    createCenterNodes(cells, needcenter, ndtag, numele, elends);
+
     // get particle group tags
     std::map<int, ID> elenodes;
     for (int i = 0; i < (int)elends.size(); ++i) {
@@ -2081,7 +2095,11 @@ int BackgroundMesh::gridFSInoDT() {
     VInt gtags(numele * cells.size());
     VInt contact3Ddir(numele * cells.size(), -1);
     int ndtag = Mesh::nextNodeTag();
-// #pragma omp parallel for
+
+    // the center nodes are added to the domain after the loop, in
+    // the order of the cells; their tags are known in advance
+    VInt needcenter(cells.size(), 0);
+#pragma omp parallel for schedule(dynamic, 16)
     for (int j = 0; j < (int)cells.size(); ++j) {
         // get indices
         auto& cindices = cells[j]->getIndices();
@@ -2226,18 +2244,13 @@ int BackgroundMesh::gridFSInoDT() {
             gtags[numele * j + i] = gtag;
         }
 
-        // create center node
-        Node* center_node = cells[j]->setCenterNode(
-            ndtag + 2 * j + 1, 
-            ndtag + 2 * j + 2);
-        if (center_node == 0) {
-            continue;
-        }
+        // center node
+        int center_tag = ndtag + 2 * j + 1;
+        needcenter[j] = 1;
 
         // add to elenodes
         if (ndm == 2) {
             // four elements
-            int center_tag = center_node->getTag();
             if (types[0] != BACKGROUND_FIXED &&
                 types[2] != BACKGROUND_FIXED && (
                     types[1] != BACKGROUND_FIXED ||
@@ -2357,7 +2370,6 @@ int BackgroundMesh::gridFSInoDT() {
 
         } else if (ndm == 3) {
             // twelve elements
-            int center_tag = center_node->getTag();
 
             // front
             if (types[0] != BACKGROUND_FIXED &&
@@ -2654,6 +2666,9 @@ int BackgroundMesh::gridFSInoDT() {
         }
     }
 
+    // create center nodes, no elements in a cell without one
+    createCenterNodes(cells, needcenter, ndtag, numele, elends);
+
     // get particle group tags
     std::map<int, ID> elenodes;
     int nextEletag = Mesh::nextEleTag();
@@ -2859,7 +2874,7 @@ int BackgroundMesh::gridFSI() {
 
     // gather bnodes
     std::map<VInt, BNode*> fsibnodes;
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
+    for (BGridMap<BCell>::iterator it = bcells.begin();
          it != bcells.end(); ++it) {
         // only for structural cells
         BCell& bcell = it->second;
@@ -3056,7 +3071,7 @@ int BackgroundMesh::gridFSI() {
                     for (int k = minind[1]; k < maxind[1]; ++k) {
                         currind[0] = j;
                         currind[1] = k;
-                        std::map<VInt, BCell>::iterator it =
+                        BGridMap<BCell>::iterator it =
                             bcells.find(currind);
                         if (it == bcells.end()) {
                             outside = true;
@@ -3078,7 +3093,7 @@ int BackgroundMesh::gridFSI() {
                             currind[0] = j;
                             currind[1] = k;
                             currind[2] = l;
-                            std::map<VInt, BCell>::iterator it =
+                            BGridMap<BCell>::iterator it =
                                 bcells.find(currind);
                             if (it == bcells.end()) {
                                 outside = true;
@@ -3120,7 +3135,7 @@ int BackgroundMesh::gridFSI() {
             VVInt indices;
             getCorners(ind, 1, indices);
             for (int k = 0; k < (int)indices.size(); ++k) {
-                std::map<VInt, BCell>::iterator cellit =
+                BGridMap<BCell>::iterator cellit =
                     bcells.find(indices[k]);
                 if (cellit == bcells.end()) continue;
                 if (cellit->second.getType() == BACKGROUND_STRUCTURE)
@@ -3460,9 +3475,10 @@ int BackgroundMesh::moveParticles() {
     double dt = domain->getCurrentTime() - currentTime;
 
     // get current disp and velocity
-    for (std::map<VInt, BNode>::iterator it = bnodes.begin();
-         it != bnodes.end(); ++it) {
-        BNode& bnode = it->second;
+    int numnodes = bnodes.size();
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int j = 0; j < numnodes; ++j) {
+        BNode& bnode = bnodes.at(j).second;
         VInt& tags = bnode.getTags();
 
         for (int i = 0; i < (int)bnode.size(); ++i) {
@@ -3481,31 +3497,22 @@ int BackgroundMesh::moveParticles() {
                 const Vector& accel = nd->getTrialAccel();
                 auto& vn = bnode.getVel();
                 auto& dvn = bnode.getAccel();
-                for (int j = 0; j < ndm; ++j) {
-                    vn[i][j] = vel(j);
-                    dvn[i][j] = accel(j);
+                for (int k = 0; k < ndm; ++k) {
+                    vn[i][k] = vel(k);
+                    dvn[i][k] = accel(k);
                 }
             }
         }
     }
 
-    // store cells in a vector
-    std::vector<BCell*> cells;
-    VVInt indices;
-    cells.reserve(bcells.size());
-    indices.reserve(bcells.size());
-    for (std::map<VInt, BCell>::iterator it = bcells.begin();
-         it != bcells.end(); ++it) {
-        indices.push_back(it->first);
-        cells.push_back(&(it->second));
-    }
-
     // move particles in each cell
+    int numcells = bcells.size();
     int res = 0;
-#pragma omp parallel for
-    for (int j = 0; j < (int)cells.size(); ++j) {
+#pragma omp parallel for schedule(dynamic, 64) reduction(min : res)
+    for (int j = 0; j < numcells; ++j) {
         // get particles in cell
-        const VParticle& pts = cells[j]->getPts();
+        const VInt& index = bcells.at(j).first;
+        const VParticle& pts = bcells.at(j).second.getPts();
 
         // move the particle
         for (int i = 0; i < (int)pts.size(); ++i) {
@@ -3514,7 +3521,7 @@ int BackgroundMesh::moveParticles() {
             pts[i]->needUpdate(dt);
 
             // convect the particle
-            if (convectParticle(pts[i], indices[j], numsub) < 0) {
+            if (convectParticle(pts[i], index, numsub) < 0) {
                 opserr << "WARNING: failed to convect particle";
                 opserr << " -- BgMesh::moveParticles\n";
                 res = -1;
@@ -96,6 +96,9 @@ class BackgroundMesh {
     int gridFSI();
     int gridFSInoDT();
     int gridEles();
+    void createCenterNodes(const std::vector<BCell*>& cells,
+                           const VInt& needcenter, int ndtag,
+                           int numele, VVInt& elends);
     static int createContact(const VInt& ndtags, const VInt& sids,
                              VInt& elends);
     static int createContact3D(const VInt& ndtags, const VInt& sids,
@@ -154,8 +157,8 @@ class BackgroundMesh {
 
    private:
     VInt lower, upper;
-    std::map<VInt, BCell> bcells;
-    std::map<VInt, BNode> bnodes;
+    BGridMap<BCell> bcells;
+    BGridMap<BNode> bnodes;
     double tol;
     double bsize;
     int numave, numsub;
@@ -89,6 +89,7 @@ void *OPS_CorotTrussElement(const ID &info);
 
 // msh objects
 static MapOfTaggedObjects theMeshObjects;
+static bool theMeshObjectsRegistered = MapOfTaggedObjects::addModelStorage(theMeshObjects);
 
 bool OPS_addMesh(Mesh *msh) {
     return theMeshObjects.addComponent(msh);
@@ -153,6 +154,7 @@ Mesh::clearEles() {
     }
     eletags = ID();
     elenodes = ID();
+    eleconn.clear();
 
     return 0;
 }
@@ -526,6 +528,38 @@ Mesh::addEleNodes(const ID &tags) {
     }
 }
 
+// elements without a state between steps, which can be kept when the
+// remeshing gives them again
+static bool
+reusableEleType(int type) {
+    switch (type) {
+        case ELE_TAG_PFEMElement2DBubble:
+        case ELE_TAG_PFEMElement3DBubble:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the sorted nodes of an element followed by the parity of the sort, so
+// that an element given again with the same nodes and orientation has
+// the same key
+static void
+connectivityKey(const ID &elends, int start, int num, std::vector<int> &key) {
+    key.resize(num + 1);
+    int swaps = 0;
+    for (int i = 0; i < num; ++i) {
+        int tag = elends(start + i);
+        int j = i;
+        for (; j > 0 && key[j - 1] > tag; --j) {
+            key[j] = key[j - 1];
+            ++swaps;
+        }
+        key[j] = tag;
+    }
+    key[num] = swaps % 2;
+}
+
 int
 Mesh::newElements(const ID &elends) {
     Domain *domain = OPS_GetDomain();
@@ -671,5 +705,77 @@ Mesh::newElements(const ID &elends) {
 
     this->addEleTags(neweletags);
 
+    // remember the connectivity of the elements that can be kept
+    if (reusableEleType(eleType)) {
+        std::vector<int> key;
+        for (int i = 0; i < neweletags.Size(); ++i) {
+            connectivityKey(elends, numelenodes * i, numelenodes, key);
+            eleconn[key] = neweletags(i);
+        }
+    }
+
     return 0;
 }
+
+int
+Mesh::renewElements(const ID &elends) {
+    Domain *domain = OPS_GetDomain();
+    if (domain == 0) {
+        opserr << "WARNING: domain is not created\n";
+        return -1;
+    }
+
+    if (!reusableEleType(eleType) || numelenodes <= 0) {
+        if (this->clearEles() < 0) {
+            return -1;
+        }
+        return this->newElements(elends);
+    }
+
+    // the elements given again are kept
+    int numeles = elends.Size() / numelenodes;
+    ID keeptags(0, numeles);
+    ID newelends(0, elends.Size());
+    std::vector<Element *> keepeles;
+    std::map<std::vector<int>, int> keepconn;
+    std::vector<int> key;
+    for (int i = 0; i < numeles; ++i) {
+        connectivityKey(elends, numelenodes * i, numelenodes, key);
+        std::map<std::vector<int>, int>::iterator it = eleconn.find(key);
+        Element *ele = 0;
+        if (it != eleconn.end()) {
+            ele = domain->getElement(it->second);
+        }
+        if (ele != 0) {
+            keeptags[keeptags.Size()] = it->second;
+            keepeles.push_back(ele);
+            keepconn.insert(*it);
+            eleconn.erase(it);
+        } else {
+            for (int j = 0; j < numelenodes; ++j) {
+                newelends[newelends.Size()] = elends(numelenodes * i + j);
+            }
+        }
+    }
+
+    // remove the others
+    for (std::map<std::vector<int>, int>::iterator it = eleconn.begin();
+         it != eleconn.end(); ++it) {
+        Element *ele = domain->removeElement(it->second);
+        if (ele != 0) {
+            delete ele;
+        }
+    }
+    eletags = keeptags;
+    elenodes = ID();
+    eleconn.swap(keepconn);
+
+    // the nodes may have moved and the pressure constraints been
+    // disconnected since the kept elements were created
+    for (unsigned int i = 0; i < keepeles.size(); ++i) {
+        keepeles[i]->setDomain(domain);
+    }
+
+    // create the new ones
+    return this->newElements(newelends);
+}
@@ -33,6 +33,8 @@
 #include <TaggedObject.h>
 #include <TaggedObjectIter.h>
 #include <ID.h>
+#include <map>
+#include <vector>
 
 class Node;
 class Element;
@@ -90,6 +92,10 @@ public:
 
     // create new element
     virtual int newElements(const ID& elenodes);
+
+    // replace the elements by those in elenodes, the elements that are
+    // given again with the same nodes are kept instead of recreated
+    virtual int renewElements(const ID& elenodes);
     virtual Node* newNode(int tag, const Vector& crds);
 
     // find the next available tag
@@ -108,6 +114,9 @@ private:
     int eleType;
     bool fluid;
 
+    // sorted nodes + orientation -> tag of the elements that can be kept
+    std::map<std::vector<int>, int> eleconn;
+
     static int startNodeTag;
 };
 
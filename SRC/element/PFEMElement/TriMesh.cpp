@@ -682,12 +682,7 @@ TriMesh::remesh(double alpha) {
 
             // remove mesh for id<0
             if (id < 0) {
-                if (msh->clearEles() < 0) {
-                    opserr << "WARNING: failed to clear element in mesh" << mtag << "\n";
-                    return -1;
-                }
-
-                if (msh->newElements(elenodes) < 0) {
+                if (msh->renewElements(elenodes) < 0) {
                     opserr << "WARNING: failed to create new elements in mesh" << mtag << "\n";
                     return -1;
                 }
@@ -49,6 +49,8 @@
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
 #include <fstream>
+#include <map>
+#include <vector>
 
 
 // =======================================================================
@@ -86,8 +88,16 @@ void* OPS_PML3D()
 		return 0;
 	}
 
+	// optional row sum lumping of mass and damping for explicit schemes
+	bool lumped = false;
+	while (OPS_GetNumRemainingInputArgs() > 0) {
+		const char* opt = OPS_GetString();
+		if (strcmp(opt, "-lumped") == 0)
+			lumped = true;
+	}
+
 	// create a new PML3D element and add it to the Domain
-	return new PML3D(idata[0], &idata[1], Newmark, dData);
+	return new PML3D(idata[0], &idata[1], Newmark, dData, lumped);
 }
 
 // =======================================================================
@@ -104,6 +114,20 @@ double  PML3D::dt = 0.;
 int     PML3D::eleCount = 0;
 // int     PML3D::numberOfElements = 0;
 
+// the matrices are constant for a fixed geometry, elements that would get
+// the same ones from the fortran routine share a single copy
+static std::map<std::vector<double>, PML3DMatrices*> thePML3DMatrices;
+
+static void
+releasePML3DMatrices(PML3DMatrices* theMatrices)
+{
+	if (theMatrices == 0 || --theMatrices->refCount > 0)
+		return;
+
+	thePML3DMatrices.erase(std::vector<double>(theMatrices->key, theMatrices->key + PML3D_NUM_KEY));
+	delete theMatrices;
+}
+
 
 // =======================================================================
 // null constructor
@@ -111,8 +135,9 @@ int     PML3D::eleCount = 0;
 PML3D::PML3D()
 	:Element(0, ELE_TAG_PML3D),
 	connectedExternalNodes(PML3D_NUM_NODES),
-	ubar(PML3D_NUM_DOF),
-	ubart(PML3D_NUM_DOF)
+	theMatrices(0), lumped(false),
+	ubart(PML3D_NUM_DOF),
+	ubar(PML3D_NUM_DOF)
 {
 	for (int i = 0; i < PML3D_NUM_NODES; i++) {
 		nodePointers[i] = 0;
@@ -131,11 +156,12 @@ PML3D::PML3D()
 // =======================================================================
 // Full constructor
 // =======================================================================
-PML3D::PML3D(int tag, int* nodeTags, double* nemwarks, double* eleData)
+PML3D::PML3D(int tag, int* nodeTags, double* nemwarks, double* eleData, bool lump)
 	:Element(tag, ELE_TAG_PML3D),
 	connectedExternalNodes(PML3D_NUM_NODES),
-	ubar(PML3D_NUM_DOF),
-	ubart(PML3D_NUM_DOF)
+	theMatrices(0), lumped(lump),
+	ubart(PML3D_NUM_DOF),
+	ubar(PML3D_NUM_DOF)
 {
 	eleCount++;
 	if (eleCount == 1) {
@@ -168,7 +194,7 @@ PML3D::PML3D(int tag, int* nodeTags, double* nemwarks, double* eleData)
 // ======================================================================= 
 PML3D::~PML3D()
 {
-
+	releasePML3DMatrices(theMatrices);
 }
 
 // =======================================================================
@@ -201,17 +227,65 @@ void  PML3D::setDomain(Domain* theDomain)
 	// make props[10] and props[11] zero
 	props[10] = 0.0;
 	props[11] = 0.0;
-	double H[PML3D_NUM_DOF*PML3D_NUM_DOF];
-	pml3d_(M, C, K, G, H, &NDOFEL, props, coords, &MCRD, &NNODE, &LFLAGS);
 	dt = theDomain->getDT();
 
-	// // make C zero 
-	for (int i = 0; i < PML3D_NUM_DOF*PML3D_NUM_DOF; i++) {
-		// C[i] = 0.0;
-		// K[i] = 0.0;
-		// M[i] = 0.0;
-		// G[i] = 0.0;
+	// the matrices depend on the properties, on the shape of the element
+	// and, through the PML profile, on the distance (x - x0)*n into the
+	// layer; in a direction with n = 0 they don't change by translation
+	std::vector<double> key(PML3D_NUM_KEY);
+	for (int i = 0; i < PML3D_NUM_PROPS; i++)
+		key[i] = props[i];
+	for (int i = 0; i < PML3D_NUM_NODES; i++) {
+		for (int j = 0; j < 3; j++) {
+			double origin = (props[8 + j] != 0.0) ? props[5 + j] : coords[j];
+			key[PML3D_NUM_PROPS + i * 3 + j] = coords[i * 3 + j] - origin;
+		}
+	}
+	key[PML3D_NUM_KEY - 1] = lumped ? 1.0 : 0.0;
+
+	releasePML3DMatrices(theMatrices);
+	std::map<std::vector<double>, PML3DMatrices*>::iterator found = thePML3DMatrices.find(key);
+	if (found != thePML3DMatrices.end()) {
+		theMatrices = found->second;
+		theMatrices->refCount++;
+		return;
+	}
+
+	theMatrices = new PML3DMatrices;
+	theMatrices->refCount = 1;
+	theMatrices->cg = 0.0;
+	for (int i = 0; i < PML3D_NUM_KEY; i++)
+		theMatrices->key[i] = key[i];
+	thePML3DMatrices[key] = theMatrices;
+
+	static double H[PML3D_NUM_DOF*PML3D_NUM_DOF];
+	pml3d_(theMatrices->M, theMatrices->C, theMatrices->K, theMatrices->G, H,
+	       &NDOFEL, props, coords, &MCRD, &NNODE, &LFLAGS);
+
+	// row sum lumping, so that an explicit scheme sees diagonal M and C
+	if (lumped) {
+		double* M = theMatrices->M;
+		double* C = theMatrices->C;
+		for (int i = 0; i < PML3D_NUM_DOF; i++) {
+			double mSum = 0.0;
+			double cSum = 0.0;
+			for (int j = 0; j < PML3D_NUM_DOF; j++) {
+				mSum += M[j * PML3D_NUM_DOF + i];
+				cSum += C[j * PML3D_NUM_DOF + i];
+			}
+			for (int j = 0; j < PML3D_NUM_DOF; j++) {
+				M[j * PML3D_NUM_DOF + i] = 0.0;
+				C[j * PML3D_NUM_DOF + i] = 0.0;
+			}
+			M[i * PML3D_NUM_DOF + i] = mSum;
+			C[i * PML3D_NUM_DOF + i] = cSum;
+		}
 	}
+
+	const double* K = theMatrices->K;
+	double* Keff = theMatrices->Keff;
+	for (int i = 0; i < PML3D_NUM_DOF*PML3D_NUM_DOF; i++)
+		Keff[i] = K[i];
 }
 
 // =======================================================================
@@ -249,11 +323,17 @@ const Matrix& PML3D::getTangentStiff()
 {
 	// check if the dt is changed to update the tangent stiffness matrix
 	double cg = eta*dt/beta;
-	//keff = k + cg*g( k and g are symmetric matrices)
-	for (int i = 0; i < PML3D_NUM_DOF*PML3D_NUM_DOF; i++) {
-		Keff[i] = K[i] + cg*G[i];
+	if (cg != theMatrices->cg) {
+		//keff = k + cg*g( k and g are symmetric matrices)
+		const double* K = theMatrices->K;
+		const double* G = theMatrices->G;
+		double* Keff = theMatrices->Keff;
+		for (int i = 0; i < PML3D_NUM_DOF*PML3D_NUM_DOF; i++) {
+			Keff[i] = K[i] + cg*G[i];
+		}
+		theMatrices->cg = cg;
 	}
-	tangent.setData(Keff, PML3D_NUM_DOF, PML3D_NUM_DOF);
+	tangent.setData(theMatrices->Keff, PML3D_NUM_DOF, PML3D_NUM_DOF);
 	return tangent;
 }
 
@@ -270,7 +350,7 @@ const Matrix& PML3D::getInitialStiff()
 // =======================================================================
 const Matrix& PML3D::getMass()
 {
-	mass.setData(M, PML3D_NUM_DOF, PML3D_NUM_DOF);
+	mass.setData(theMatrices->M, PML3D_NUM_DOF, PML3D_NUM_DOF);
 	// mass.Zero();
 	return mass;
 }
@@ -280,7 +360,7 @@ const Matrix& PML3D::getMass()
 // =======================================================================
 const Matrix& PML3D::getDamp()
 {
-	damping.setData(C, PML3D_NUM_DOF, PML3D_NUM_DOF);
+	damping.setData(theMatrices->C, PML3D_NUM_DOF, PML3D_NUM_DOF);
 	// damping.Zero();
 	return damping;
 }
@@ -298,7 +378,7 @@ const Vector& PML3D::getResistingForce()
 	static Vector theVector(PML3D_NUM_DOF);
 
 	// get K into stiff
-	tangent.setData(K, PML3D_NUM_DOF, PML3D_NUM_DOF);
+	tangent.setData(theMatrices->K, PML3D_NUM_DOF, PML3D_NUM_DOF);
 
 	//
 	// perform: R = K * u
@@ -322,47 +402,40 @@ const Vector& PML3D::getResistingForce()
 const Vector&
 PML3D::getResistingForceIncInertia()
 {
-    // R += K*u
-	static Vector theVector(PML3D_NUM_DOF);
-	tangent.setData(K, PML3D_NUM_DOF, PML3D_NUM_DOF);
-
+	// R = K*u + M*a + C*v + G*ubar, in one pass over the columns of the
+	// four (column major) matrices so the inner loop is a contiguous axpy
+	static double u[PML3D_NUM_DOF], v[PML3D_NUM_DOF], a[PML3D_NUM_DOF];
 	int loc = 0;
 	for (int i = 0; i < PML3D_NUM_NODES; i++) {
 		const Vector& uNode = nodePointers[i]->getTrialDisp();
-		for (int j = 0; j < 9; j++)
-			theVector(loc++) = uNode(j);
-	}
-	resid.addMatrixVector(0.0, tangent, theVector, 1.0);
-
-
-
-	// R += M*a
-	loc = 0;
-	Node** theNodes = this->getNodePtrs();
-	for (int i = 0; i < PML3D_NUM_NODES; i++) {
-		const Vector& acc = theNodes[i]->getTrialAccel();
+		const Vector& vNode = nodePointers[i]->getTrialVel();
+		const Vector& aNode = nodePointers[i]->getTrialAccel();
 		for (int j = 0; j < 9; j++) {
-			theVector(loc++) = acc(j);
+			u[loc] = uNode(j);
+			v[loc] = vNode(j);
+			a[loc] = aNode(j);
+			loc++;
 		}
 	}
-	resid.addMatrixVector(1.0, this->getMass(), theVector, 1.0);
 
-	// R += C*v
-	loc = 0;
-	for (int i = 0; i < PML3D_NUM_NODES; i++) {
-		const Vector& vel = theNodes[i]->getTrialVel();
-		for (int j = 0; j < 9; j++) {
-			theVector(loc++) = vel[j];
-		}
+	const double* K = theMatrices->K;
+	const double* M = theMatrices->M;
+	const double* C = theMatrices->C;
+	const double* G = theMatrices->G;
+	double* r = &resid(0);
+	for (int i = 0; i < PML3D_NUM_DOF; i++)
+		r[i] = 0.0;
+
+	for (int j = 0; j < PML3D_NUM_DOF; j++) {
+		const double uj = u[j];
+		const double vj = v[j];
+		const double aj = a[j];
+		const double bj = ubar(j);
+		const int col = j * PML3D_NUM_DOF;
+		for (int i = 0; i < PML3D_NUM_DOF; i++)
+			r[i] += K[col + i]*uj + M[col + i]*aj + C[col + i]*vj + G[col + i]*bj;
 	}
-	resid.addMatrixVector(1.0, this->getDamp(), theVector, 1.0);
-
 
-	// R += G*ubar
-	tangent.setData(G, PML3D_NUM_DOF, PML3D_NUM_DOF);
-	resid.addMatrixVector(1.0, tangent, ubar, 1.0);
-	
-	
 	return resid;
 }
 
@@ -479,7 +552,7 @@ int  PML3D::sendSelf(int commitTag,
 
 	// PML3D packs its data into a Vector and sends this to theChannel
 	// along with its dbTag and the commitTag passed in the arguments
-	static Vector data(PML3D_NUM_PROPS + 4);
+	static Vector data(PML3D_NUM_PROPS + 5);
 	data(0) = this->getTag();
 
 	for (int ii = 1; ii <= PML3D_NUM_PROPS; ii++) {
@@ -488,6 +561,7 @@ int  PML3D::sendSelf(int commitTag,
 	data(PML3D_NUM_PROPS+1) = eta;
 	data(PML3D_NUM_PROPS+2) = beta;
 	data(PML3D_NUM_PROPS+3) = gamma;
+	data(PML3D_NUM_PROPS+4) = lumped ? 1.0 : 0.0;
 
 	res += theChannel.sendVector(dataTag, commitTag, data);
 	if (res < 0) {
@@ -519,7 +593,7 @@ int  PML3D::recvSelf(int commitTag,
 
 	// PML3D creates a Vector, receives the Vector and then sets the 
 	// internal data with the data in the Vector
-	static Vector data(PML3D_NUM_PROPS + 4);
+	static Vector data(PML3D_NUM_PROPS + 5);
 	res += theChannel.recvVector(dataTag, commitTag, data);
 	if (res < 0) {
 		opserr << "WARNING PML3D::recvSelf() - failed to receive Vector\n";
@@ -536,6 +610,7 @@ int  PML3D::recvSelf(int commitTag,
 	eta   = data(PML3D_NUM_PROPS+1);
 	beta  = data(PML3D_NUM_PROPS+2);
 	gamma = data(PML3D_NUM_PROPS+3);
+	lumped = (data(PML3D_NUM_PROPS+4) != 0.0);
 
 	// PML3D now receives the tags of its four external nodes
 	res += theChannel.recvID(dataTag, commitTag, connectedExternalNodes);
@@ -43,6 +43,20 @@
 #define PML3D_NUM_DOF 72
 #define PML3D_NUM_PROPS 12
 #define PML3D_NUM_NODES 8
+#define PML3D_NUM_KEY (PML3D_NUM_PROPS + 3*PML3D_NUM_NODES + 1)
+
+// the constant matrices of a PML3D element, shared by all the elements
+// with the same properties and the same shape at the same depth in the PML
+struct PML3DMatrices {
+	double K[PML3D_NUM_DOF * PML3D_NUM_DOF];        // stiffness matrix
+	double C[PML3D_NUM_DOF * PML3D_NUM_DOF];        // damping matrix
+	double M[PML3D_NUM_DOF * PML3D_NUM_DOF];        // mass matrix
+	double G[PML3D_NUM_DOF * PML3D_NUM_DOF];        // G matrix
+	double Keff[PML3D_NUM_DOF * PML3D_NUM_DOF];     // effective stiffness matrix K + cg*G
+	double cg;                                      // the cg Keff was formed with
+	int refCount;                                   // number of elements using them
+	double key[PML3D_NUM_KEY];                      // what the matrices depend on
+};
 
 #ifdef _WIN32
 
@@ -83,7 +97,8 @@ class PML3D : public Element {
 public:
 
 	PML3D();                                                                         //null constructor
-	PML3D(int tag, int* nodeTags, double* newmarks, double* dData);                  // full constructor
+	PML3D(int tag, int* nodeTags, double* newmarks, double* dData,
+	      bool lumped = false);                                                      // full constructor
 	virtual ~PML3D();                                                                //destructor
 	const char* getClassType(void) const { return "PML3D"; };                        //return class type
 	void setDomain(Domain* theDomain);                                               // set domain
@@ -118,11 +133,8 @@ private:
 	double props[PML3D_NUM_PROPS];                  // material properties
 	ID connectedExternalNodes;  					//eight node numbers
 	Node* nodePointers[PML3D_NUM_NODES];    	    //pointers to eight nodes
-	double K[PML3D_NUM_DOF * PML3D_NUM_DOF];        // stiffness matrix
-	double C[PML3D_NUM_DOF * PML3D_NUM_DOF];        // damping matrix
-	double M[PML3D_NUM_DOF * PML3D_NUM_DOF];        // mass matrix
-    double G[PML3D_NUM_DOF * PML3D_NUM_DOF];        // G matrix
-	double Keff[PML3D_NUM_DOF * PML3D_NUM_DOF];     // effective stiffness matrix
+	PML3DMatrices* theMatrices;                     // shared K, C, M, G and Keff
+	bool lumped;                                    // row sum lumped mass and damping
 	static double eta;                              // Newmark parameters: eta
 	static double beta; 					  	    // Newmark parameters: beta
 	static double gamma; 					  	// Newmark parameters: gamma
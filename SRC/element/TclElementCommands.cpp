@@ -193,6 +193,7 @@ extern void *OPS_Actuator(void);
 extern void *OPS_ActuatorCorot(void);
 extern void *OPS_GenericClient(void);
 extern void *OPS_GenericCopy(void);
+extern void *OPS_SuperElement(void);
 extern void *OPS_ElastomericBearingPlasticity2d(void);
 extern void *OPS_ElastomericBearingPlasticity3d(void);
 extern void *OPS_ElastomericBearingBoucWen2d(void);
@@ -1629,6 +1630,18 @@ TclModelBuilderElementCommand(ClientData clientData, Tcl_Interp *interp,
   }
   }
 
+  else if (strcmp(argv[1], "superElement") == 0) {
+  void *theEle = OPS_SuperElement();
+  if (theEle != 0) {
+      theElement = (Element*)theEle;
+  }
+  else {
+      opserr << "tclelementcommand -- unable to create element of type : "
+          << argv[1] << endln;
+      return TCL_ERROR;
+  }
+  }
+
   else if (strcmp(argv[1], "elastomericBearing") == 0
   || (strcmp(argv[1], "elastomericBearingPlasticity")) == 0) {
   Element *theEle = 0;
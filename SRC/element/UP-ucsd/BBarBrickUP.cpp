@@ -146,7 +146,7 @@ const double  BBarBrickUP::wg[] = { 1.0, 1.0, 1.0, 1.0,
 //null constructor
 BBarBrickUP::BBarBrickUP( ) :
 Element( 0, ELE_TAG_BBarBrickUP ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(0), rho(0)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(0), rho(0), shapeCache(0)
 {
   for (int i=0; i<8; i++ ) {
     materialPointers[i] = 0;
@@ -172,7 +172,7 @@ BBarBrickUP::BBarBrickUP(int tag,
 			 double p1, double p2, double p3,
 			 double b1, double b2, double b3) :
 Element( tag, ELE_TAG_BBarBrickUP ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(bulk), rho(rhof)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(bulk), rho(rhof), shapeCache(0)
 {
   connectedExternalNodes(0) = node1 ;
   connectedExternalNodes(1) = node2 ;
@@ -226,6 +226,9 @@ BBarBrickUP::~BBarBrickUP( )
 
   if (Ki != 0)
     delete Ki;
+
+  if (shapeCache != 0)
+    delete [] shapeCache;
 }
 
 
@@ -234,6 +237,12 @@ void  BBarBrickUP::setDomain( Domain *theDomain )
 {
   int i,dof ;
 
+  //the shape functions are formed again from the new nodes
+  if (shapeCache != 0) {
+    delete [] shapeCache;
+    shapeCache = 0;
+  }
+
   // Check Domain is not null - invoked when object removed from a domain
   if (theDomain == 0) {
     for ( i=0; i<8; i++ )
@@ -424,111 +433,22 @@ const Matrix&  BBarBrickUP::getInitialStiff( )
   if (Ki != 0)
     return *Ki;
 
-  //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
-  static const int ndm = 3 ;
-  static const int ndf = 3 ;
-  static const int ndff = 4 ;
   static const int nstress = 6 ;
-  static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
-  static const int nShape = 4 ;
 
-  int i, j, k, p, q ;
-  int jj, kk ;
-
-  static double xsj ;  // determinant jacaobian matrix
-  static double gaussPoint[ndm] ;
-  static Vector strain(nstress) ;  //strain
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness
   static Matrix dd(nstress,nstress) ;  //material tangent
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-
-  //---------B-matrices------------------------------------
-  static Matrix BJ(nstress,ndf) ;      // B matrix node J
-  static Matrix BJtran(ndf,nstress) ;
-  static Matrix BK(nstress,ndf) ;      // B matrix node k
-  static Matrix BJtranD(ndf,nstress) ;
 
-
-  //zero stiffness and residual
+  //zero stiffness
   stiff.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	    gaussPoint[1] = sg[j] ;
-	    gaussPoint[2] = sg[k] ;
-
-	    //get shape functions
-	    shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	    //save shape functions
-	    for ( p = 0; p < nShape; p++ ) {
-	      for ( q = 0; q < numberNodes; q++ )
-	        Shape[p][q][count] = shp[p][q] ;
-	    } // end for p
-
-	    //volume element to also be saved
-	    dvol[count] = wg[count] * xsj ;
-
-        count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
-  computeBBar();
+  //shape functions, volume elements and Bbar at the gauss points
+  formGeometry( ) ;
 
   //gauss loop
-  for ( i = 0; i < numberGauss; i++ ) {
-
+  for ( int i = 0; i < numberGauss; i++ ) {
     dd = materialPointers[i]->getInitialTangent( ) ;
     dd *= dvol[i] ;
-
-    jj = 0;
-    for ( j = 0; j < numberNodes; j++ ) {
-
-      BJ = computeB(j, i) ;
-
-      //transpose
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	    for (q=0; q<nstress; q++)
-	      BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-      //BJtranD = BJtran * dd ;
-      BJtranD.addMatrixProduct(0.0,  BJtran, dd, 1.0) ;
-
-      kk = 0 ;
-      for ( k = 0; k < numberNodes; k++ ) {
-
-	    BK = computeB(k, i) ;
-
-    	//stiffJK =  BJtranD * BK  ;
-    	stiffJK.addMatrixProduct(0.0,  BJtranD, BK, 1.0) ;
-
-    	for ( p = 0; p < ndf; p++ )  {
-    	  for ( q = 0; q < ndf; q++ )
-    	    stiff( jj+p, kk+q ) += stiffJK( p, q ) ;
-    	} //end for p
-
-    	kk += ndff ;
-
-      } // end for k loop
-
-      jj += ndff ;
-
-    } // end for j loop
+    addSolidStiffness( stiff, dd, i ) ;
   } //end for i gauss loop
 
   Ki = new Matrix(stiff);
@@ -560,57 +480,20 @@ const Matrix&  BBarBrickUP::getDamp( )
 
 void BBarBrickUP::formDampingTerms( int tangFlag )
 {
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
   static const int numberDOFs = 32 ;
-  static const int nShape = 4 ;
-  static double xsj ;  // determinant jacaobian matrix
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-  static double gaussPoint[ndm] ;
   static Vector a(ndff*numberNodes) ;
 
-  int i, j, k, p, q, m, i1, j1;
+  int i, j, k, p, m, i1, j1;
 
   //zero damp
   damp.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
-  computeBBar();
+  //shape functions, volume elements and Bbar at the gauss points
+  formGeometry( ) ;
 
   if (betaK != 0.0)
     damp.addMatrix(1.0, this->getTangentStiff(), betaK);
@@ -631,38 +514,38 @@ void BBarBrickUP::formDampingTerms( int tangFlag )
     }
   }
 
-  // Compute coupling matrix
+  // Compute coupling and permeability matrices, one pass per node pair
+  for (m = 0; m < numberGauss; m++) {
+    double divB[numberNodes][ndf] ; //column sums of the volumetric Bbar rows
+    for (i1 = 0; i1 < numberNodes; i1++) {
+      for (p = 0; p < ndf; p++)
+        divB[i1][p] = BBar[0][p][i1][m]+BBar[1][p][i1][m]+BBar[2][p][i1][m];
+    }
+
+    for (i1 = 0; i1 < numberNodes; i1++) {
+      i = i1*ndff;
+      for (j1 = 0; j1 < numberNodes; j1++) {
+        j = j1*ndff + 3;
+        double Np = -dvol[m]*Shape[3][j1][m];
+        damp(i,j) += Np*divB[i1][0];
+        damp(i+1,j) += Np*divB[i1][1];
+        damp(i+2,j) += Np*divB[i1][2];
+
+        damp(i+3,j) -= dvol[m]*(perm[0]*BBarp[0][i1][m]*BBarp[0][j1][m] +
+                                perm[1]*BBarp[1][i1][m]*BBarp[1][j1][m] +
+                                perm[2]*BBarp[2][i1][m]*BBarp[2][j1][m]);
+      }
+    }
+  }
+
   for (i = 0; i < numberDOFs; i += ndff) {
-    i1 = i / ndff;
     for (j = 3; j < numberDOFs; j += ndff) {
-      j1 = (j-3) / ndff;
-      for (m = 0; m < numberGauss; m++) {
-	    damp(i,j) += -dvol[m]*Shape[3][j1][m]
-	                 *(BBar[0][0][i1][m]+BBar[1][0][i1][m]+BBar[2][0][i1][m]);
-	    damp(i+1,j) += -dvol[m]*Shape[3][j1][m]
-	                 *(BBar[0][1][i1][m]+BBar[1][1][i1][m]+BBar[2][1][i1][m]);
-	    damp(i+2,j) += -dvol[m]*Shape[3][j1][m]
-	                 *(BBar[0][2][i1][m]+BBar[1][2][i1][m]+BBar[2][2][i1][m]);
-	  }
       damp(j,i) = damp(i,j);
       damp(j,i+1) = damp(i+1,j);
       damp(j,i+2) = damp(i+2,j);
     }
   }
 
-  // Compute permeability matrix
-  for (i = 3; i < numberDOFs; i += ndff) {
-    int i1 = (i-3) / ndff;
-    for (j = 3; j < numberDOFs; j += ndff) {
-      int j1 = (j-3) / ndff;
-      for (m = 0; m < numberGauss; m++) {
-	    damp(i,j) -= dvol[m]*(perm[0]*BBarp[0][i1][m]*BBarp[0][j1][m] +
-	                          perm[1]*BBarp[1][i1][m]*BBarp[1][j1][m]+
-					          perm[2]*BBarp[2][i1][m]*BBarp[2][j1][m]);
-	  }
-    }
-  }
-
   if (tangFlag == 0) {
     for ( k = 0; k < numberNodes; k++ ) {
       const Vector &vel = nodePointers[k]->getTrialVel();
@@ -795,19 +678,13 @@ const Vector&  BBarBrickUP::getResistingForceIncInertia( )
 
 void   BBarBrickUP::formInertiaTerms( int tangFlag )
 {
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
-  static const int nShape = 4 ;
-  static const int massIndex = nShape - 1 ;
-  static double xsj ;  // determinant jacaobian matrix
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-  static double gaussPoint[ndm] ;
   static Vector a(ndff*numberNodes) ;
 
-  int i, j, k, p, q ;
+  int i, j, k, p ;
   int jj, kk ;
 
   double temp, rhot, massJK ;
@@ -816,41 +693,8 @@ void   BBarBrickUP::formInertiaTerms( int tangFlag )
   //zero mass
   mass.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	    gaussPoint[1] = sg[j] ;
-	    gaussPoint[2] = sg[k] ;
-
-	    //get shape functions
-	    shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	    //save shape functions
-	    for ( p = 0; p < nShape; p++ ) {
-	      for ( q = 0; q < numberNodes; q++ )
-	        Shape[p][q][count] = shp[p][q] ;
-	    } // end for p
-
-
-	    //volume element to also be saved
-	    dvol[count] = wg[count] * xsj ;
-
-	    count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
-  computeBBar();
+  //shape functions, volume elements and Bbar at the gauss points
+  formGeometry( ) ;
 
   //gauss loop
   for ( i = 0; i < numberGauss; i++ ) {
@@ -858,6 +702,8 @@ void   BBarBrickUP::formInertiaTerms( int tangFlag )
     // average material density
       rhot = mixtureRho(i);
 
+    double compress = -dvol[i]/kc ;
+
     //mass and compressibility calculations node loops
     jj = 0 ;
     for ( j = 0; j < numberNodes; j++ ) {
@@ -877,7 +723,7 @@ void   BBarBrickUP::formInertiaTerms( int tangFlag )
 	      mass( jj+p, kk+p ) += massJK ;
 
           // Compute compressibility terms
-          mass( jj+3, kk+3 ) += -dvol[i]*Shape[3][j][i]*Shape[3][k][i]/kc;
+          mass( jj+3, kk+3 ) += compress*Shape[3][j][i]*Shape[3][k][i];
 
           kk += ndff ;
       } // end for k loop
@@ -905,206 +751,216 @@ void  BBarBrickUP::formResidAndTangent( int tang_flag )
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
 
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int nstress = 6 ;
   static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
-  static const int nShape = 4 ;
-
-  int i, j, k, p, q ;
-  int jj, kk ;
 
-  int success ;
+  int i, j, p, q ;
+  int jj ;
 
-  static double xsj ;  // determinant jacaobian matrix
-  static double gaussPoint[ndm] ;
-  static Vector strain(nstress) ;  //strain
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-  static Vector residJ(ndf) ; //nodeJ residual
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness
-  static Vector stress(nstress) ;  //stress
+  static double gaussStrain[numberGauss*nstress] ; //strains at the gauss points
+  static double ul[numberNodes][ndf] ; //nodal displacements
   static Matrix dd(nstress,nstress) ;  //material tangent
 
 
-  //---------B-matrices------------------------------------
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
-    static Matrix BJtran(ndf,nstress) ;
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-    static Matrix BJtranD(ndf,nstress) ;
-  //-------------------------------------------------------
-
-
   //zero stiffness and residual
   stiff.Zero( ) ;
   resid.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	    gaussPoint[1] = sg[j] ;
-	    gaussPoint[2] = sg[k] ;
-
-	    //get shape functions
-	    shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	    //save shape functions
-	    for ( p = 0; p < nShape; p++ ) {
-	      for ( q = 0; q < numberNodes; q++ )
-	        Shape[p][q][count] = shp[p][q] ;
-	    } // end for p
+  //shape functions, volume elements and Bbar at the gauss points
+  formGeometry( ) ;
 
-    	//volume element to also be saved
-    	dvol[count] = wg[count] * xsj ;
-
-    	count++ ;
+  for ( j = 0; j < numberNodes; j++ ) {
+    const Vector &disp = nodePointers[j]->getTrialDisp( ) ;
+    ul[j][0] = disp(0) ;
+    ul[j][1] = disp(1) ;
+    ul[j][2] = disp(2) ;
+  }
 
-      } //end for k
-    } //end for j
-  } // end for i
+  //strain = sum of Bbar_j * u_j
+  for ( i = 0; i < numberGauss; i++ ) {
+    double *strain = &gaussStrain[i*nstress] ;
+    for ( p = 0; p < nstress; p++ ) {
+      strain[p] = 0.0 ;
+      for ( j = 0; j < numberNodes; j++ )
+        strain[p] += BBar[p][0][j][i]*ul[j][0] + BBar[p][1][j][i]*ul[j][1] +
+	             BBar[p][2][j][i]*ul[j][2] ;
+    } // end for p
+  } //end for i gauss loop
 
-  computeBBar();
+  //send the strains to the materials, each run of one class in one call
+  NDMaterial::setTrialStrainGroups( numberGauss, materialPointers, gaussStrain, nstress ) ;
 
-  //gauss loop
+  //residual and tangent calculations
   for ( i = 0; i < numberGauss; i++ ) {
 
-	double rhot;
+    if ( tang_flag == 1 ) {
+      dd = materialPointers[i]->getTangent( ) ;
+      dd *= dvol[i] ;
+      addSolidStiffness( stiff, dd, i ) ;
+      continue ;
+    } //end if tang_flag
 
-    //zero the strains
-    strain.Zero( ) ;
+    //compute the stress, multiplied by the volume element
+    const Vector &stress = materialPointers[i]->getStress( ) ;
+    double sv[nstress] ;
+    for ( q = 0; q < nstress; q++ )
+      sv[q] = stress(q)*dvol[i] ;
 
-    // j-node loop to compute strain
-    for ( j = 0; j < numberNodes; j++ )  {
+    double rhot = mixtureRho(i);
+    const double *bf = (applyLoad == 0) ? b : appliedB ;
 
-      //compute B matrix
-      BJ = computeB( j, i ) ;
+    jj = 0 ;
+    for ( j = 0; j < numberNodes; j++ ) {
+      double N = dvol[i]*rhot*Shape[3][j][i] ;
+
+      //residual, Bbar_j^T * stress less the equiv. body forces
+      for ( p = 0; p < ndf; p++ ) {
+        double r = -N*bf[p] ;
+        for ( q = 0; q < nstress; q++ )
+          r += BBar[q][p][j][i]*sv[q] ;
+        resid( jj+p ) += r ;
+      }
 
-      //nodal displacements
-      const Vector &ul = nodePointers[j]->getTrialDisp( ) ;
-      Vector ul3(3);
-	  ul3(0) = ul(0);
-      ul3(1) = ul(1);
-	  ul3(2) = ul(2);
-      //compute the strain
-      //strain += (BJ*ul) ;
-      strain.addMatrixVector(1.0,BJ,ul3,1.0 ) ;
+      // Subtract fluid body force
+      resid( jj+3 ) += dvol[i]*rho*(perm[0]*bf[0]*BBarp[0][j][i] +
+				    perm[1]*bf[1]*BBarp[1][j][i] +
+				    perm[2]*bf[2]*BBarp[2][j][i]);
 
-    } // end for j
+      jj += ndff ;
+    } // end for j loop
 
-    //send the strain to the material
-    success = materialPointers[i]->setTrialStrain( strain ) ;
+  } //end for i gauss loop
 
+  return ;
+}
 
-    //residual and tangent calculations node loops
 
-    if ( tang_flag == 1 ) {
-      dd = materialPointers[i]->getTangent( ) ;
-      dd *= dvol[i] ;
-    } //end if tang_flag
+double BBarBrickUP::mixtureRho(int i)
+{
+  double rhoi;
 
+  rhoi= materialPointers[i]->getRho();
+  //e = 0.7;  //theMaterial[i]->getVoidRatio();
+  //n = e / (1.0 + e);
+  //return n * rho + (1.0-n) * rhoi;
+  return rhoi;
+}
 
-    if ( tang_flag == 0 ) {
-      //compute the stress
-      stress = materialPointers[i]->getStress( ) ;
+//************************************************************************
+//shape functions, volume elements and Bbar at the gauss points
 
-      //multiply by volume element
-      stress  *= dvol[i] ;
+void   BBarBrickUP::formGeometry( )
+{
+  static const int ndm = 3 ;
+  static const int numberNodes = 8 ;
+  static const int numberGauss = 8 ;
+  static const int nShape = 4 ;
+  static const int numberShape = nShape*numberNodes*numberGauss ;
 
-      rhot = mixtureRho(i);
-    }
+  int i, j, k, p, q ;
 
-    jj = 0 ;
-    for ( j = 0; j < numberNodes; j++ ) {
+  //the geometry of a small strain brick does not change, so with the
+  //cache on the Jacobians are formed once and copied afterwards
+  if ( shapeCache != 0 && Element::cacheGeometry ) {
+    for ( i = 0; i < numberShape; i++ )
+      (&Shape[0][0][0])[i] = shapeCache[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      dvol[i] = shapeCache[numberShape + i] ;
+    computeBBar( ) ;
+    return ;
+  }
 
-      BJ = computeB( j, i ) ;
+  double xsj ;  // determinant jacaobian matrix
+  double gaussPoint[ndm] ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-      //transpose
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	    for (q=0; q<nstress; q++)
-	      BJtran(p,q) = BJ(q,p) ;
-      }//end for p
+  //compute basis vectors and local nodal coordinates
+  computeBasis( ) ;
 
-      if ( tang_flag == 0 ) {
-        //residual
-        //residJ = BJtran * stress ;
-        residJ.addMatrixVector(0.0,  BJtran,stress,1.0);
+  //gauss loop to compute and save shape functions
 
-        for ( p = 0; p < ndf; p++ ) {
-          resid( jj + p ) += residJ(p)  ;
+  int count = 0 ;
 
-          // Subtract equiv. body forces from the nodes
-	  if (applyLoad == 0) {
-	    resid( jj + p ) -= dvol[i]*rhot*b[p]*Shape[3][j][i];
-	  } else {
-	    resid( jj + p ) -= dvol[i]*rhot*appliedB[p]*Shape[3][j][i];
-	  }
-	}
+  for ( i = 0; i < 2; i++ ) {
+    for ( j = 0; j < 2; j++ ) {
+      for ( k = 0; k < 2; k++ ) {
 
-        // Subtract fluid body force
-		if (applyLoad == 0) {
-			resid( jj + 3 ) += dvol[i]*rho*(perm[0]*b[0]*BBarp[0][j][i] +
-                                        perm[1]*b[1]*BBarp[1][j][i] +
-										perm[2]*b[2]*BBarp[2][j][i]);
-		} else {
-			resid( jj + 3 ) += dvol[i]*rho*(perm[0]*appliedB[0]*BBarp[0][j][i] +
-                                        perm[1]*appliedB[1]*BBarp[1][j][i] +
-										perm[2]*appliedB[2]*BBarp[2][j][i]);
-		}
-      } // end if tang_flag
+        gaussPoint[0] = sg[i] ;
+	    gaussPoint[1] = sg[j] ;
+	    gaussPoint[2] = sg[k] ;
 
-      if ( tang_flag == 1 ) {
-	     //BJtranD = BJtran * dd ;
-	     BJtranD.addMatrixProduct(0.0,  BJtran,dd,1.0) ;
+	    //get shape functions
+	    shp3d( gaussPoint, xsj, shp, xl ) ;
 
-         kk = 0 ;
-         for ( k = 0; k < numberNodes; k++ ) {
+	    //save shape functions
+	    for ( p = 0; p < nShape; p++ ) {
+	      for ( q = 0; q < numberNodes; q++ )
+	        Shape[p][q][count] = shp[p][q] ;
+	    } // end for p
 
-            BK = computeB( k, i ) ;
+	    //volume element to also be saved
+	    dvol[count] = wg[count] * xsj ;
 
-            //stiffJK =  BJtranD * BK  ;
-	        stiffJK.addMatrixProduct(0.0,  BJtranD,BK,1.0) ;
+        count++ ;
 
-            for ( p = 0; p < ndf; p++ )  {
-               for ( q = 0; q < ndf; q++ )
-                  stiff( jj+p, kk+q ) += stiffJK( p, q ) ;
-            } //end for p
+      } //end for k
+    } //end for j
+  } // end for i
 
-            kk += ndff ;
-         } // end for k loop
+  if ( Element::cacheGeometry ) {
+    if ( shapeCache == 0 )
+      shapeCache = new double[numberShape + numberGauss] ;
+    for ( i = 0; i < numberShape; i++ )
+      shapeCache[i] = (&Shape[0][0][0])[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      shapeCache[numberShape + i] = dvol[i] ;
+  }
 
-      } // end if tang_flag
+  computeBBar( ) ;
+}
 
-      jj += ndff ;
-    } // end for j loop
 
-  } //end for i gauss loop
+//************************************************************************
+//add Bbar_j^T dd Bbar_k of each node pair j,k at gauss point g to the
+//solid block (3x3 at rows & columns 4j, 4k) of stiff
 
-  return ;
-}
+void  BBarBrickUP::addSolidStiffness( Matrix &stiff, const Matrix &dd, int g )
+{
+  static const int numberNodes = 8 ;
+  static const int ndff = 4 ;
 
+  for ( int j = 0; j < numberNodes; j++ ) {
 
-double BBarBrickUP::mixtureRho(int i)
-{
-  double rhoi, e, n;
+    //BJtranD = BJ^T * dd
+    double BtD[3][6] ;
+    for ( int p = 0; p < 3; p++ ) {
+      for ( int q = 0; q < 6; q++ ) {
+        double sum = 0.0 ;
+        for ( int r = 0; r < 6; r++ )
+          sum += BBar[r][p][j][g]*dd(r,q) ;
+        BtD[p][q] = sum ;
+      }
+    }
 
-  rhoi= materialPointers[i]->getRho();
-  //e = 0.7;  //theMaterial[i]->getVoidRatio();
-  //n = e / (1.0 + e);
-  //return n * rho + (1.0-n) * rhoi;
-  return rhoi;
+    int jj = j*ndff ;
+    for ( int k = 0; k < numberNodes; k++ ) {
+      int kk = k*ndff ;
+      for ( int p = 0; p < 3; p++ ) {
+        for ( int c = 0; c < 3; c++ ) {
+          double sum = 0.0 ;
+          for ( int q = 0; q < 6; q++ )
+            sum += BtD[p][q]*BBar[q][c][k][g] ;
+          stiff( jj+p, kk+c ) += sum ;
+        }
+      }
+    }
+  }
 }
 
+
 //************************************************************************
 //compute local coordinates and basis
 
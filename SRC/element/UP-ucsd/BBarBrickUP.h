@@ -203,6 +203,12 @@ class BBarBrickUP : public Element {
     //compute coordinate system
     void computeBasis( ) ;
 
+    //shape functions, volume elements and Bbar at the gauss points
+    void formGeometry( ) ;
+
+    //add the solid stiffness of gauss point g
+    static void addSolidStiffness( Matrix &stiff, const Matrix &dd, int g ) ;
+
     //compute Bbar matrix
     void computeBBar() ;
 
@@ -214,4 +220,5 @@ class BBarBrickUP : public Element {
 
     Vector *load;
     Matrix *Ki;
+    double *shapeCache ;  //saved Shape and dvol, see formGeometry
 } ;
@@ -138,7 +138,7 @@ const double  BrickUP::wg[] = { 1.0, 1.0, 1.0, 1.0,
 //null constructor
 BrickUP::BrickUP( ) :
 Element( 0, ELE_TAG_BrickUP ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(0), rho(0)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(0), rho(0), shapeCache(0)
 {
   for (int i=0; i<8; i++ ) {
     materialPointers[i] = 0;
@@ -164,7 +164,7 @@ BrickUP::BrickUP(  int tag,
 			double p1, double p2, double p3,
 		   double b1, double b2, double b3) :
 Element( tag, ELE_TAG_BrickUP ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(bulk), rho(rhof)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), kc(bulk), rho(rhof), shapeCache(0)
 {
   connectedExternalNodes(0) = node1 ;
   connectedExternalNodes(1) = node2 ;
@@ -218,6 +218,9 @@ BrickUP::~BrickUP( )
 
   if (Ki != 0)
     delete Ki;
+
+  if (shapeCache != 0)
+    delete [] shapeCache;
 }
 
 
@@ -226,6 +229,12 @@ void  BrickUP::setDomain( Domain *theDomain )
 {
   int i,dof ;
 
+  //the shape functions are formed again from the new nodes
+  if (shapeCache != 0) {
+    delete [] shapeCache;
+    shapeCache = 0;
+  }
+
   // Check Domain is not null - invoked when object removed from a domain
   if (theDomain == 0) {
     for ( i=0; i<8; i++ )
@@ -416,132 +425,24 @@ const Matrix&  BrickUP::getInitialStiff( )
   if (Ki != 0)
     return *Ki;
 
-  //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
-  static const int ndm = 3 ;
-  static const int ndf = 3 ;
-  static const int ndff = 4 ;
   static const int nstress = 6 ;
-  static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
-  static const int nShape = 4 ;
 
-  int i, j, k, p, q ;
-  int jj, kk ;
-
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix
   static double dvol[numberGauss] ; //volume element
-  static double gaussPoint[ndm] ;
-  static Vector strain(nstress) ;  //strain
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
-  static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness
+  static double Shape[4][8][numberGauss] ; //all the shape functions
   static Matrix dd(nstress,nstress) ;  //material tangent
 
-
-  //---------B-matrices------------------------------------
-
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
-
-    static Matrix BJtran(ndf,nstress) ;
-
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-
-    static Matrix BJtranD(ndf,nstress) ;
-
-  //-------------------------------------------------------
-
-
-  //zero stiffness and residual
+  //zero stiffness
   stiff.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-  volume = 0.0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-	//volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
 
   //gauss loop
-  for ( i = 0; i < numberGauss; i++ ) {
-
-    //extract shape functions from saved array
-    for ( p = 0; p < nShape; p++ ) {
-       for ( q = 0; q < numberNodes; q++ )
-	  shp[p][q]  = Shape[p][q][i] ;
-    } // end for p
-
-
+  for ( int i = 0; i < numberGauss; i++ ) {
     dd = materialPointers[i]->getInitialTangent( ) ;
     dd *= dvol[i] ;
-
-    jj = 0;
-    for ( j = 0; j < numberNodes; j++ ) {
-
-      BJ = computeB( j, shp ) ;
-
-      //transpose
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	for (q=0; q<nstress; q++)
-	  BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-      //BJtranD = BJtran * dd ;
-      BJtranD.addMatrixProduct(0.0,  BJtran, dd, 1.0) ;
-
-      kk = 0 ;
-      for ( k = 0; k < numberNodes; k++ ) {
-
-	BK = computeB( k, shp ) ;
-
-
-	//stiffJK =  BJtranD * BK  ;
-	stiffJK.addMatrixProduct(0.0,  BJtranD, BK, 1.0) ;
-
-	for ( p = 0; p < ndf; p++ )  {
-	  for ( q = 0; q < ndf; q++ )
-	    stiff( jj+p, kk+q ) += stiffJK( p, q ) ;
-	} //end for p
-
-	kk += ndff ;
-
-      } // end for k loop
-
-      jj += ndff ;
-
-    } // end for j loop
+    addSolidStiffness( stiff, dd, Shape, i ) ;
   } //end for i gauss loop
 
   Ki = new Matrix(stiff);
@@ -573,68 +474,24 @@ const Matrix&  BrickUP::getDamp( )
 
 void BrickUP::formDampingTerms( int tangFlag )
 {
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
   static const int numberDOFs = 32 ;
   static const int nShape = 4 ;
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix
   static double dvol[numberGauss] ; //volume element
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static double gaussPoint[ndm] ;
   static Vector a(ndff*numberNodes) ;
 
-  int i, j, k, p, q, m, i1, j1;
-  //int jj, kk ;
-  //double temp, rhot, massJK ;
+  int i, j, k, p, m, i1, j1;
 
 
   //zero damp
   damp.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //zero volume
-  volume = 0.0 ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-        //add to volume
-	volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
 
   if (betaK != 0.0)
     damp.addMatrix(1.0, this->getTangentStiff(), betaK);
@@ -655,32 +512,29 @@ void BrickUP::formDampingTerms( int tangFlag )
     }
   }
 
-  // Compute coupling matrix
-  for (i = 0; i < numberDOFs; i += ndff) {
-    i1 = i / ndff;
-    for (j = 3; j < numberDOFs; j += ndff) {
-      j1 = (j-3) / ndff;
+  // Compute coupling & permeability matrices, the 3x1 and 1x1 blocks
+  // of each node pair
+  for (i1 = 0; i1 < numberNodes; i1++) {
+    i = i1*ndff;
+    for (j1 = 0; j1 < numberNodes; j1++) {
+      j = j1*ndff + 3;
+      double c0 = 0.0, c1 = 0.0, c2 = 0.0, h = 0.0;
       for (m = 0; m < numberGauss; m++) {
-	    damp(i,j) += -dvol[m]*Shape[0][i1][m]*Shape[3][j1][m];
-	    damp(i+1,j) += -dvol[m]*Shape[1][i1][m]*Shape[3][j1][m];
-	    damp(i+2,j) += -dvol[m]*Shape[2][i1][m]*Shape[3][j1][m];
-	  }
+        double dNp = dvol[m]*Shape[3][j1][m];
+        c0 += Shape[0][i1][m]*dNp;
+        c1 += Shape[1][i1][m]*dNp;
+        c2 += Shape[2][i1][m]*dNp;
+        h += dvol[m]*(perm[0]*Shape[0][i1][m]*Shape[0][j1][m] +
+                      perm[1]*Shape[1][i1][m]*Shape[1][j1][m] +
+                      perm[2]*Shape[2][i1][m]*Shape[2][j1][m]);
+      }
+      damp(i,j) -= c0;
+      damp(i+1,j) -= c1;
+      damp(i+2,j) -= c2;
       damp(j,i) = damp(i,j);
       damp(j,i+1) = damp(i+1,j);
       damp(j,i+2) = damp(i+2,j);
-    }
-  }
-
-  // Compute permeability matrix
-  for (i = 3; i < numberDOFs; i += ndff) {
-    int i1 = (i-3) / ndff;
-    for (j = 3; j < numberDOFs; j += ndff) {
-      int j1 = (j-3) / ndff;
-      for (m = 0; m < numberGauss; m++) {
-	    damp(i,j) -= dvol[m]*(perm[0]*Shape[0][i1][m]*Shape[0][j1][m] +
-	                          perm[1]*Shape[1][i1][m]*Shape[1][j1][m]+
-					          perm[2]*Shape[2][i1][m]*Shape[2][j1][m]);
-	  }
+      damp(i+3,j) -= h;
     }
   }
 
@@ -818,22 +672,17 @@ const Vector&  BrickUP::getResistingForceIncInertia( )
 
 void   BrickUP::formInertiaTerms( int tangFlag )
 {
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int numberNodes = 8 ;
   static const int numberGauss = 8 ;
   static const int nShape = 4 ;
   static const int massIndex = nShape - 1 ;
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix
   static double dvol[numberGauss] ; //volume element
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static double gaussPoint[ndm] ;
   static Vector a(ndff*numberNodes) ;
 
-  int i, j, k, p, q ;
+  int i, j, k, p ;
   int jj, kk ;
 
   double temp, rhot, massJK ;
@@ -842,63 +691,22 @@ void   BrickUP::formInertiaTerms( int tangFlag )
   //zero mass
   mass.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //zero volume
-  volume = 0.0 ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-        //add to volume
-	volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
 
   //gauss loop
   for ( i = 0; i < numberGauss; i++ ) {
 
-    //extract shape functions from saved array
-    for ( p = 0; p < nShape; p++ ) {
-       for ( q = 0; q < numberNodes; q++ )
-	  shp[p][q]  = Shape[p][q][i] ;
-    } // end for p
-
     // average material density
       rhot = mixtureRho(i);
 
+    double compress = -dvol[i]/kc ;
+
     //mass and compressibility calculations node loops
     jj = 0 ;
     for ( j = 0; j < numberNodes; j++ ) {
 
-      temp = shp[massIndex][j] * dvol[i] ;
+      temp = Shape[massIndex][j][i] * dvol[i] ;
 
 	 //multiply by density
 	 temp *= rhot ;
@@ -907,13 +715,14 @@ void   BrickUP::formInertiaTerms( int tangFlag )
          kk = 0 ;
          for ( k = 0; k < numberNodes; k++ ) {
 
-	    massJK = temp * shp[massIndex][k] ;
+	    double NjNk = Shape[massIndex][j][i] * Shape[massIndex][k][i] ;
+	    massJK = temp * Shape[massIndex][k][i] ;
 
             for ( p = 0; p < ndf; p++ )
 	          mass( jj+p, kk+p ) += massJK ;
 
             // Compute compressibility terms
-            mass( jj+3, kk+3 ) += -dvol[i]*Shape[3][j][i]*Shape[3][k][i]/kc;
+            mass( jj+3, kk+3 ) += compress*NjNk;
 
             kk += ndff ;
           } // end for k loop
@@ -941,7 +750,6 @@ void  BrickUP::formResidAndTangent( int tang_flag )
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
 
-  static const int ndm = 3 ;
   static const int ndf = 3 ;
   static const int ndff = 4 ;
   static const int nstress = 6 ;
@@ -949,203 +757,215 @@ void  BrickUP::formResidAndTangent( int tang_flag )
   static const int numberGauss = 8 ;
   static const int nShape = 4 ;
 
-  int i, j, k, p, q ;
-  int jj, kk ;
-
-  int success ;
+  int i, j, p ;
+  int jj ;
 
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix
   static double dvol[numberGauss] ; //volume element
-  static double gaussPoint[ndm] ;
-  static Vector strain(nstress) ;  //strain
-  static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
-  static Vector residJ(ndf) ; //nodeJ residual
-  static Matrix stiffJK(ndf,ndf) ; //nodeJK stiffness
-  static Vector stress(nstress) ;  //stress
+  static double gaussStrain[numberGauss*nstress] ; //strains at the gauss points
+  static double ul[numberNodes][ndf] ; //nodal displacements
   static Matrix dd(nstress,nstress) ;  //material tangent
 
 
-  //---------B-matrices------------------------------------
-    static Matrix BJ(nstress,ndf) ;      // B matrix node J
-    static Matrix BJtran(ndf,nstress) ;
-    static Matrix BK(nstress,ndf) ;      // B matrix node k
-    static Matrix BJtranD(ndf,nstress) ;
-  //-------------------------------------------------------
-
-
   //zero stiffness and residual
   stiff.Zero( ) ;
   resid.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
 
-  int count = 0 ;
-  volume = 0.0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
+  for ( j = 0; j < numberNodes; j++ ) {
+    const Vector &disp = nodePointers[j]->getTrialDisp( ) ;
+    ul[j][0] = disp(0) ;
+    ul[j][1] = disp(1) ;
+    ul[j][2] = disp(2) ;
+  }
 
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
+  //strain = sum of B_j * u_j, B_j the 6x3 block of node j
+  for ( i = 0; i < numberGauss; i++ ) {
+    double *strain = &gaussStrain[i*nstress] ;
+    for ( p = 0; p < nstress; p++ )
+      strain[p] = 0.0 ;
 
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
+    for ( j = 0; j < numberNodes; j++ )  {
+      double nx = Shape[0][j][i] ;
+      double ny = Shape[1][j][i] ;
+      double nz = Shape[2][j][i] ;
+      strain[0] += nx*ul[j][0] ;
+      strain[1] += ny*ul[j][1] ;
+      strain[2] += nz*ul[j][2] ;
+      strain[3] += ny*ul[j][0] + nx*ul[j][1] ;
+      strain[4] += nz*ul[j][1] + ny*ul[j][2] ;
+      strain[5] += nz*ul[j][0] + nx*ul[j][2] ;
+    } // end for j
+  } //end for i gauss loop
 
+  //send the strains to the materials, each run of one class in one call
+  NDMaterial::setTrialStrainGroups( numberGauss, materialPointers, gaussStrain, nstress ) ;
 
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
+  //residual and tangent calculations
+  for ( i = 0; i < numberGauss; i++ ) {
 
-	//volume += dvol[count] ;
+    if ( tang_flag == 1 ) {
+      dd = materialPointers[i]->getTangent( ) ;
+      dd *= dvol[i] ;
+      addSolidStiffness( stiff, dd, Shape, i ) ;
+      continue ;
+    } //end if tang_flag
 
-	count++ ;
+    //compute the stress, multiplied by the volume element
+    const Vector &stress = materialPointers[i]->getStress( ) ;
+    double s0 = stress(0)*dvol[i] ;
+    double s1 = stress(1)*dvol[i] ;
+    double s2 = stress(2)*dvol[i] ;
+    double s3 = stress(3)*dvol[i] ;
+    double s4 = stress(4)*dvol[i] ;
+    double s5 = stress(5)*dvol[i] ;
 
-      } //end for k
-    } //end for j
-  } // end for i
+    double rhot = mixtureRho(i);
+    const double *bf = (applyLoad == 0) ? b : appliedB ;
 
+    jj = 0 ;
+    for ( j = 0; j < numberNodes; j++ ) {
+      double nx = Shape[0][j][i] ;
+      double ny = Shape[1][j][i] ;
+      double nz = Shape[2][j][i] ;
+      double N = dvol[i]*Shape[3][j][i] ;
 
-  //gauss loop
-  for ( i = 0; i < numberGauss; i++ ) {
+      //residual, B_j^T * stress less the equiv. body forces
+      resid( jj   ) += nx*s0 + ny*s3 + nz*s5 - N*rhot*bf[0] ;
+      resid( jj+1 ) += ny*s1 + nx*s3 + nz*s4 - N*rhot*bf[1] ;
+      resid( jj+2 ) += nz*s2 + ny*s4 + nx*s5 - N*rhot*bf[2] ;
 
-    //extract shape functions from saved array
-    for ( p = 0; p < nShape; p++ ) {
-       for ( q = 0; q < numberNodes; q++ )
-	  shp[p][q]  = Shape[p][q][i] ;
-    } // end for p
+      // Subtract fluid body force
+      resid( jj+3 ) += dvol[i]*rho*(perm[0]*bf[0]*nx + perm[1]*bf[1]*ny +
+				    perm[2]*bf[2]*nz);
 
+      jj += ndff ;
+    } // end for j loop
 
-	double rhot;
+  } //end for i gauss loop
 
-    //zero the strains
-    strain.Zero( ) ;
 
-    // j-node loop to compute strain
-    for ( j = 0; j < numberNodes; j++ )  {
+  return ;
+}
 
-      //compute B matrix
-      BJ = computeB( j, shp ) ;
 
-      //nodal displacements
-      const Vector &ul = nodePointers[j]->getTrialDisp( ) ;
-      Vector ul3(3);
-	  ul3(0) = ul(0);
-      ul3(1) = ul(1);
-	  ul3(2) = ul(2);
-      //compute the strain
-      //strain += (BJ*ul) ;
-      strain.addMatrixVector(1.0,BJ,ul3,1.0 ) ;
+//*********************************************************************
+//add B_j^T dd B_k of each node pair j,k at gauss point g to the solid
+//block (3x3 at rows & columns 4j, 4k) of stiff; the strain-displacement
+//block B_j of node j has the rows
+//  [ N,1 0 0 ], [ 0 N,2 0 ], [ 0 0 N,3 ], [ N,2 N,1 0 ], [ 0 N,3 N,2 ], [ N,3 0 N,1 ]
 
-    } // end for j
+void  BrickUP::addSolidStiffness( Matrix &stiff, const Matrix &dd,
+				  const double Shape[4][8][8], int g )
+{
+  static const int numberNodes = 8 ;
+  static const int ndff = 4 ;
 
-    //send the strain to the material
-    success = materialPointers[i]->setTrialStrain( strain ) ;
+  for ( int j = 0; j < numberNodes; j++ ) {
+    double nx = Shape[0][j][g] ;
+    double ny = Shape[1][j][g] ;
+    double nz = Shape[2][j][g] ;
+
+    //BJtranD = BJ^T * dd
+    double BtD[3][6] ;
+    for ( int q = 0; q < 6; q++ ) {
+      BtD[0][q] = nx*dd(0,q) + ny*dd(3,q) + nz*dd(5,q) ;
+      BtD[1][q] = ny*dd(1,q) + nx*dd(3,q) + nz*dd(4,q) ;
+      BtD[2][q] = nz*dd(2,q) + ny*dd(4,q) + nx*dd(5,q) ;
+    }
 
+    int jj = j*ndff ;
+    for ( int k = 0; k < numberNodes; k++ ) {
+      double mx = Shape[0][k][g] ;
+      double my = Shape[1][k][g] ;
+      double mz = Shape[2][k][g] ;
+      int kk = k*ndff ;
+      for ( int p = 0; p < 3; p++ ) {
+	stiff( jj+p, kk   ) += BtD[p][0]*mx + BtD[p][3]*my + BtD[p][5]*mz ;
+	stiff( jj+p, kk+1 ) += BtD[p][1]*my + BtD[p][3]*mx + BtD[p][4]*mz ;
+	stiff( jj+p, kk+2 ) += BtD[p][2]*mz + BtD[p][4]*my + BtD[p][5]*mx ;
+      }
+    }
+  }
+}
 
-    //residual and tangent calculations node loops
 
-    if ( tang_flag == 1 ) {
-      dd = materialPointers[i]->getTangent( ) ;
-      dd *= dvol[i] ;
-    } //end if tang_flag
+//************************************************************************
+//shape functions and volume elements at the gauss points
 
+void   BrickUP::shapeFunctions( double Shape[4][8][8], double dvol[8] )
+{
+  static const int ndm = 3 ;
+  static const int numberNodes = 8 ;
+  static const int numberGauss = 8 ;
+  static const int nShape = 4 ;
+  static const int cacheSize = nShape*numberNodes*numberGauss + numberGauss ;
 
-    if ( tang_flag == 0 ) {
-      //compute the stress
-      stress = materialPointers[i]->getStress( ) ;
+  int i, j, k, p, q ;
 
-      //multiply by volume element
-      stress  *= dvol[i] ;
+  //the geometry of a small strain brick does not change, so with the
+  //cache on the Jacobians are formed once and copied afterwards
+  if ( shapeCache != 0 && Element::cacheGeometry ) {
+    for ( i = 0; i < nShape*numberNodes*numberGauss; i++ )
+      (&Shape[0][0][0])[i] = shapeCache[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      dvol[i] = shapeCache[nShape*numberNodes*numberGauss + i] ;
+    return ;
+  }
 
-      rhot = mixtureRho(i);
-    }
+  double xsj ;  // determinant jacaobian matrix
+  double gaussPoint[ndm] ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
-    jj = 0 ;
-    for ( j = 0; j < numberNodes; j++ ) {
+  //compute basis vectors and local nodal coordinates
+  computeBasis( ) ;
 
-      BJ = computeB( j, shp ) ;
-
-      //transpose
-      //BJtran = transpose( nstress, ndf, BJ ) ;
-      for (p=0; p<ndf; p++) {
-	    for (q=0; q<nstress; q++)
-	      BJtran(p,q) = BJ(q,p) ;
-      }//end for p
-
-      if ( tang_flag == 0 ) {
-        //residual
-        //residJ = BJtran * stress ;
-        residJ.addMatrixVector(0.0,  BJtran,stress,1.0);
-
-        for ( p = 0; p < ndf; p++ ) {
-          resid( jj + p ) += residJ(p)  ;
-
-          // Subtract equiv. body forces from the nodes
-		  if (applyLoad == 0) {
-	      	resid( jj + p ) -= dvol[i]*rhot*b[p]*Shape[3][j][i];
-		  } else {
-			resid( jj + p ) -= dvol[i]*rhot*appliedB[p]*Shape[3][j][i];
-		  }
-		}
-
-        // Subtract fluid body force
-		if (applyLoad == 0) {
-			resid( jj + 3 ) += dvol[i]*rho*(perm[0]*b[0]*Shape[0][j][i] +
-                                        perm[1]*b[1]*Shape[1][j][i] +
-										perm[2]*b[2]*Shape[2][j][i]);
-		} else {
-			resid( jj + 3 ) += dvol[i]*rho*(perm[0]*appliedB[0]*Shape[0][j][i] +
-                                        perm[1]*appliedB[1]*Shape[1][j][i] +
-										perm[2]*appliedB[2]*Shape[2][j][i]);
-		}
-      } // end if tang_flag
-
-      if ( tang_flag == 1 ) {
-	     //BJtranD = BJtran * dd ;
-	     BJtranD.addMatrixProduct(0.0,  BJtran,dd,1.0) ;
+  //gauss loop to compute and save shape functions
 
-         kk = 0 ;
-         for ( k = 0; k < numberNodes; k++ ) {
+  int count = 0 ;
 
-            BK = computeB( k, shp ) ;
+  for ( i = 0; i < 2; i++ ) {
+    for ( j = 0; j < 2; j++ ) {
+      for ( k = 0; k < 2; k++ ) {
 
-            //stiffJK =  BJtranD * BK  ;
-	        stiffJK.addMatrixProduct(0.0,  BJtranD,BK,1.0) ;
+        gaussPoint[0] = sg[i] ;
+	gaussPoint[1] = sg[j] ;
+	gaussPoint[2] = sg[k] ;
 
-            for ( p = 0; p < ndf; p++ )  {
-               for ( q = 0; q < ndf; q++ )
-                  stiff( jj+p, kk+q ) += stiffJK( p, q ) ;
-            } //end for p
+	//get shape functions
+	shp3d( gaussPoint, xsj, shp, xl ) ;
 
-            kk += ndff ;
-          } // end for k loop
+	//save shape functions
+	for ( p = 0; p < nShape; p++ ) {
+	  for ( q = 0; q < numberNodes; q++ )
+	    Shape[p][q][count] = shp[p][q] ;
+	} // end for p
 
-      } // end if tang_flag
+	//volume element to also be saved
+	dvol[count] = wg[count] * xsj ;
 
-      jj += ndff ;
-    } // end for j loop
+	count++ ;
 
-  } //end for i gauss loop
+      } //end for k
+    } //end for j
+  } // end for i
 
+  if ( Element::cacheGeometry ) {
+    if ( shapeCache == 0 )
+      shapeCache = new double[cacheSize] ;
+    for ( i = 0; i < nShape*numberNodes*numberGauss; i++ )
+      shapeCache[i] = (&Shape[0][0][0])[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      shapeCache[nShape*numberNodes*numberGauss + i] = dvol[i] ;
+  }
 
-  return ;
 }
 
 double BrickUP::mixtureRho(int i)
 {
-  double rhoi, e, n;
+  double rhoi;
 
   rhoi= materialPointers[i]->getRho();
   //e = 0.7;  //theMaterial[i]->getVoidRatio();
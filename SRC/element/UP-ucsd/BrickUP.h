@@ -182,6 +182,13 @@ class BrickUP : public Element {
     //form residual and tangent
     void formResidAndTangent( int tang_flag ) ;
 
+    //shape functions and volume elements at the gauss points
+    void shapeFunctions( double Shape[4][8][8], double dvol[8] ) ;
+
+    //add the solid phase stiffness at a gauss point
+    static void addSolidStiffness( Matrix &stiff, const Matrix &dd,
+				   const double Shape[4][8][8], int g ) ;
+
 	// Mixture mass density at integration point i
 	double mixtureRho(int ipt);
 
@@ -201,6 +208,7 @@ class BrickUP : public Element {
 
     Vector *load;
     Matrix *Ki;
+    double *shapeCache ;  //saved Shape and dvol, see shapeFunctions
 } ;
 
 
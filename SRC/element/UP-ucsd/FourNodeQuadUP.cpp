@@ -112,7 +112,7 @@ FourNodeQuadUP::FourNodeQuadUP(int tag, int nd1, int nd2, int nd3, int nd4,
   theMaterial(0), connectedExternalNodes(4),
   nd1Ptr(0), nd2Ptr(0), nd3Ptr(0), nd4Ptr(0), Ki(0),
  Q(12), pressureLoad(12), applyLoad(0), thickness(t), kc(bulk), rho(r), pressure(p),
- end1InitDisp(0),end2InitDisp(0),end3InitDisp(0),end4InitDisp(0)
+ shapeCache(0), end1InitDisp(0),end2InitDisp(0),end3InitDisp(0),end4InitDisp(0)
 {
 	pts[0][0] = -0.5773502691896258;
 	pts[0][1] = -0.5773502691896258;
@@ -167,7 +167,7 @@ FourNodeQuadUP::FourNodeQuadUP()
   theMaterial(0), connectedExternalNodes(4),
  nd1Ptr(0), nd2Ptr(0), nd3Ptr(0), nd4Ptr(0), Ki(0),
  Q(12), pressureLoad(12), applyLoad(0), thickness(0.0), kc(0.0), rho(0.0), pressure(0.0),
- end1InitDisp(0),end2InitDisp(0),end3InitDisp(0),end4InitDisp(0)
+ shapeCache(0), end1InitDisp(0),end2InitDisp(0),end3InitDisp(0),end4InitDisp(0)
 {
 	pts[0][0] = -0.577350269189626;
 	pts[0][1] = -0.577350269189626;
@@ -205,6 +205,8 @@ FourNodeQuadUP::~FourNodeQuadUP()
       delete [] end3InitDisp;
     if (end4InitDisp != 0)
       delete [] end4InitDisp;
+    if (shapeCache != 0)
+      delete [] shapeCache;
 }
 
 int
@@ -239,6 +241,12 @@ FourNodeQuadUP::getNumDOF()
 void
 FourNodeQuadUP::setDomain(Domain *theDomain)
 {
+  // The shape functions are formed again from the new nodes
+  if (shapeCache != 0) {
+    delete [] shapeCache;
+    shapeCache = 0;
+  }
+
   // Check Domain is not null - invoked when object removed from a domain
   if (theDomain == 0) {
     nd1Ptr = 0;
@@ -395,10 +403,8 @@ FourNodeQuadUP::update()
     u[1][3] = disp4(1) - end4InitDisp[1];;
   }
 
-  static Vector eps(3);
+  static double eps[4][3];
 
-  int ret = 0;
-  
   // Determine Jacobian for this integration point
   this->shapeFunction();
   
@@ -408,18 +414,16 @@ FourNodeQuadUP::update()
     // Interpolate strains
     //eps = B*u;
     //eps.addMatrixVector(0.0, B, u, 1.0);
-    eps.Zero();
+    eps[i][0] = eps[i][1] = eps[i][2] = 0.0;
     for (int beta = 0; beta < 4; beta++) {
-      eps(0) += shp[0][beta][i]*u[0][beta];
-      eps(1) += shp[1][beta][i]*u[1][beta];
-      eps(2) += shp[0][beta][i]*u[1][beta] + shp[1][beta][i]*u[0][beta];
+      eps[i][0] += shp[0][beta][i]*u[0][beta];
+      eps[i][1] += shp[1][beta][i]*u[1][beta];
+      eps[i][2] += shp[0][beta][i]*u[1][beta] + shp[1][beta][i]*u[0][beta];
     }
-    
-    // Set the material strain
-    ret += theMaterial[i]->setTrialStrain(eps);
   }
   
-  return ret;
+  // Set the material strains, each run of one class in one call
+  return NDMaterial::setTrialStrainGroups(4, theMaterial, &eps[0][0], 3);
 }
  
  
@@ -544,34 +548,21 @@ FourNodeQuadUP::getDamp()
   // Determine Jacobian for this integration point
   this->shapeFunction();
 
-  // Compute coupling matrix
-  double vol = dvol[0] + dvol[1] + dvol[2] + dvol[3];
-  for (i = 0; i < 12; i += 3) {
-    i1 = i / 3;
-    for (j = 2; j < 12; j += 3) {
-      j1 = (j-2) / 3;
-      //K(i,j) += -vol*shpBar[0][i1]*shpBar[2][j1];
-      //K(i+1,j) += -vol*shpBar[1][i1]*shpBar[2][j1];
+  // Compute coupling and permeability matrices, one pass per node pair
+  for (i = 0, i1 = 0; i < 12; i += 3, i1++) {
+    for (j = 2, j1 = 0; j < 12; j += 3, j1++) {
+      double c0 = 0.0, c1 = 0.0, kp = 0.0;
       for (m = 0; m < 4; m++) {
-	    Kdamp(i,j) += -dvol[m]*shp[0][i1][m]*shp[2][j1][m];
-	    Kdamp(i+1,j) += -dvol[m]*shp[1][i1][m]*shp[2][j1][m];
+	    c0 -= dvol[m]*shp[0][i1][m]*shp[2][j1][m];
+	    c1 -= dvol[m]*shp[1][i1][m]*shp[2][j1][m];
+	    kp -= dvol[m]*(perm[0]*shp[0][i1][m]*shp[0][j1][m] +
+	                   perm[1]*shp[1][i1][m]*shp[1][j1][m]);
 	  }
+      Kdamp(i,j) += c0;
+      Kdamp(i+1,j) += c1;
       Kdamp(j,i) = Kdamp(i,j);
       Kdamp(j,i+1) = Kdamp(i+1,j);
-    }
-  }
-
-  // Compute permeability matrix
-  for (i = 2; i < 12; i += 3) {
-    int i1 = (i-2) / 3;
-    for (j = 2; j < 12; j += 3) {
-      int j1 = (j-2) / 3;
-      //K(i,j) = - (vol*perm[0]*shpBar[0][i1]*shpBar[0][j1] +
-		//  vol*perm[1]*shpBar[1][i1]*shpBar[1][j1]);
-      for (m = 0; m < 4; m++) {
-	    Kdamp(i,j) += - dvol[m]*(perm[0]*shp[0][i1][m]*shp[0][j1][m] +
-	                  perm[1]*shp[1][i1][m]*shp[1][j1][m]);
-	  }
+      Kdamp(i+2,j) += kp;
     }
   }
 
@@ -604,11 +595,16 @@ FourNodeQuadUP::getMass()
     }
   }*/
 
+  // Mixture density times volume element at the integration points
+  double rhoVol[4];
+  for (m = 0; m < 4; m++)
+    rhoVol[m] = dvol[m]*mixtureRho(m);
+
     // Compute consistent mass matrix
   for (i = 0, i1 = 0; i < 12; i += 3, i1++) {
     for (j = 0, j1 = 0; j < 12; j += 3, j1++) {
     for (m = 0; m < 4; m++) {
-    Nrho = dvol[m]*mixtureRho(m)*shp[2][i1][m]*shp[2][j1][m];
+    Nrho = rhoVol[m]*shp[2][i1][m]*shp[2][j1][m];
     K(i,j) += Nrho;
     K(i+1,j+1) += Nrho;
     }
@@ -722,7 +718,9 @@ FourNodeQuadUP::getResistingForce()
 
   // Determine Jacobian for this integration point
   this->shapeFunction();
-  double vol = dvol[0] + dvol[1] + dvol[2] + dvol[3];
+
+  // Body force from the element or from the load pattern
+  const double *bf = (applyLoad == 0) ? b : appliedB;
 
   int i;
   // Loop over the integration points
@@ -730,6 +728,7 @@ FourNodeQuadUP::getResistingForce()
 
     // Get material stress response
     const Vector &sigma = theMaterial[i]->getStress();
+    double r = mixtureRho(i);
 
     // Perform numerical integration on internal force
     //P = P + (B^ sigma) * intWt(i)*intWt(j) * detJ;
@@ -744,29 +743,12 @@ FourNodeQuadUP::getResistingForce()
       //P = P - (N^ b) * intWt(i)*intWt(j) * detJ;
       //P.addMatrixTransposeVector(1.0, N, b, -intWt(i)*intWt(j)*detJ);
 
-      double r = mixtureRho(i);
-	  if (applyLoad == 0) {
-      	P(ia) -= dvol[i]*(shp[2][alpha][i]*r*b[0]);
-      	P(ia+1) -= dvol[i]*(shp[2][alpha][i]*r*b[1]);
-	  } else {
-		P(ia) -= dvol[i]*(shp[2][alpha][i]*r*appliedB[0]);
-      	P(ia+1) -= dvol[i]*(shp[2][alpha][i]*r*appliedB[1]);
-	  }
-    }
-  }
+      P(ia) -= dvol[i]*(shp[2][alpha][i]*r*bf[0]);
+      P(ia+1) -= dvol[i]*(shp[2][alpha][i]*r*bf[1]);
 
-  // Subtract fluid body force
-  for (int alpha = 0, ia = 0; alpha < 4; alpha++, ia += 3) {
-    //P(ia+2) += vol*rho*(perm[0]*b[0]*shpBar[0][alpha]
-	//		+perm[1]*b[1]*shpBar[1][alpha]);
-    for (i = 0; i < 4; i++) {
-		if (applyLoad == 0) {
-      		P(ia+2) += dvol[i]*rho*(perm[0]*b[0]*shp[0][alpha][i] +
-      		           perm[1]*b[1]*shp[1][alpha][i]);
-		} else {
-			P(ia+2) += dvol[i]*rho*(perm[0]*appliedB[0]*shp[0][alpha][i] +
-      		           perm[1]*appliedB[1]*shp[1][alpha][i]);
-		}
+      // Subtract fluid body force
+      P(ia+2) += dvol[i]*rho*(perm[0]*bf[0]*shp[0][alpha][i] +
+                 perm[1]*bf[1]*shp[1][alpha][i]);
     }
   }
 
@@ -1270,6 +1252,18 @@ void FourNodeQuadUP::shapeFunction(void)
 				 vol = 0.0;
   int k, l;
 
+  // The geometry does not change, so with the cache on the Jacobians
+  // are formed once and copied afterwards
+  if (shapeCache != 0 && Element::cacheGeometry) {
+    for (k = 0; k < 48; k++)
+      (&shp[0][0][0])[k] = shapeCache[k];
+    for (k = 0; k < 12; k++)
+      (&shpBar[0][0])[k] = shapeCache[48+k];
+    for (k = 0; k < 4; k++)
+      dvol[k] = shapeCache[60+k];
+    return;
+  }
+
 	for (k=0; k<3; k++) {
 		for (l=0; l<4; l++) {
 			shpBar[k][l] = 0.0;
@@ -1357,6 +1351,18 @@ void FourNodeQuadUP::shapeFunction(void)
 	    shpBar[k][l] /= vol;
 		}
 	}
+
+  // Save shp, shpBar and dvol
+  if (Element::cacheGeometry) {
+    if (shapeCache == 0)
+      shapeCache = new double[64];
+    for (k = 0; k < 48; k++)
+      shapeCache[k] = (&shp[0][0][0])[k];
+    for (k = 0; k < 12; k++)
+      shapeCache[48+k] = (&shpBar[0][0])[k];
+    for (k = 0; k < 4; k++)
+      shapeCache[60+k] = dvol[k];
+  }
 }
 
 
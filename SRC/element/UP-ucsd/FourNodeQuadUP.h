@@ -119,6 +119,7 @@ class FourNodeQuadUP : public Element
     void setPressureLoadAtNodes(void);
 
     Matrix *Ki;
+    double *shapeCache;  // Saved shp, shpBar and dvol, see shapeFunction
     static Node *theNodes[4];
 
     double *end1InitDisp;
@@ -368,7 +368,7 @@ SSPbrickUP::update(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 
 	// assemble displacement vector
-	Vector u(24);
+	static Vector u(24);
 	u(0) =  mDisp_1(0);
 	u(1) =  mDisp_1(1);
 	u(2) =  mDisp_1(2);
@@ -395,8 +395,8 @@ SSPbrickUP::update(void)
 	u(23) = mDisp_8(2);
 
 	// compute strain and send it to the material
-	Vector strain(6);
-	strain = Bnot*u;
+	static Vector strain(6);
+	strain.addMatrixVector(0.0, Bnot, u, 1.0);
 	theMaterial->setTrialStrain(strain);
 
 	return 0;
@@ -455,7 +455,8 @@ SSPbrickUP::getInitialStiff(void)
 const Matrix &
 SSPbrickUP::getDamp(void)
 {
-	Matrix dampC(24,24);
+	static Matrix dampC(24,24);
+	dampC.Zero();
 
 	// solid phase stiffness matrix
 	GetSolidStiffness();
@@ -473,17 +474,12 @@ SSPbrickUP::getDamp(void)
     	dampC.addMatrix(1.0, mSolidK, betaKc);
 	}
 
-	// compute coupling matrix Q
-	Matrix couple(24,8);
-	Matrix INp(6,8);
-
-	INp.Zero();
-	INp(0,0) = 0.125; INp(0,1) = 0.125; INp(0,2) = 0.125; INp(0,3) = 0.125; INp(0,4) = 0.125; INp(0,5) = 0.125; INp(0,6) = 0.125; INp(0,7) = 0.125;
-	INp(1,0) = 0.125; INp(1,1) = 0.125; INp(1,2) = 0.125; INp(1,3) = 0.125; INp(1,4) = 0.125; INp(1,5) = 0.125; INp(1,6) = 0.125; INp(1,7) = 0.125;
-	INp(2,0) = 0.125; INp(2,1) = 0.125; INp(2,2) = 0.125; INp(2,3) = 0.125; INp(2,4) = 0.125; INp(2,5) = 0.125; INp(2,6) = 0.125; INp(2,7) = 0.125;
-
-	couple.Zero();
-	couple.addMatrixTransposeProduct(0.0, Bnot, INp, mVol);	
+	// compute coupling matrix Q = mVol*Bnot'*INp; the first three rows of INp
+	// are all 0.125 and the rest zero, so every column of Q is the same
+	double couple[24];
+	for (int k = 0; k < 24; k++) {
+		couple[k] = 0.125*mVol*(Bnot(0,k) + Bnot(1,k) + Bnot(2,k));
+	}
 
 	// assemble full element damping matrix   [  C  -Q ]
 	// comprised of C, Q, and H submatrices   [ -Q' -H ]
@@ -520,12 +516,12 @@ SSPbrickUP::getDamp(void)
         	mDamp(IIp1,JJp2) = dampC(Ip1,Jp2);
         
         	// contribution of fluid-solid coupling
-        	mDamp(JJp3,II)   = -couple(I,j);
-        	mDamp(JJp3,IIp1) = -couple(Ip1,j);
-        	mDamp(JJp3,IIp2) = -couple(Ip2,j);
-        	mDamp(II,JJp3)   = -couple(I,j);
-        	mDamp(IIp1,JJp3) = -couple(Ip1,j);
-        	mDamp(IIp2,JJp3) = -couple(Ip2,j);
+        	mDamp(JJp3,II)   = -couple[I];
+        	mDamp(JJp3,IIp1) = -couple[Ip1];
+        	mDamp(JJp3,IIp2) = -couple[Ip2];
+        	mDamp(II,JJp3)   = -couple[I];
+        	mDamp(IIp1,JJp3) = -couple[Ip1];
+        	mDamp(IIp2,JJp3) = -couple[Ip2];
         
         	// contribution of permeability matrix
         	mDamp(IIp3,JJp3) = -mPerm(i,j);
@@ -686,13 +682,11 @@ const Vector &
 SSPbrickUP::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
-	Vector f1(24);
-    f1.Zero();
-	Vector f2(8);
-    f2.Zero();
+	static Vector f1(24);
+	double f2[8];
 	
 	// get stress from the material
-	Vector mStress = theMaterial->getStress();
+	const Vector &mStress = theMaterial->getStress();
 
 	// get trial displacement
 	const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -705,7 +699,7 @@ SSPbrickUP::getResistingForce(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 	
 	// assemble displacement vector
-	Vector d(24);
+	static Vector d(24);
 	d(0) =  mDisp_1(0);
 	d(1) =  mDisp_1(1);
 	d(2) =  mDisp_1(2);
@@ -732,7 +726,7 @@ SSPbrickUP::getResistingForce(void)
 	d(23) = mDisp_8(2);
 
 	// add stabilization force to internal force vector
-	f1 = Kstab*d;
+	f1.addMatrixVector(0.0, Kstab, d, 1.0);
 
 	// add internal force from the stress  ->  fint = Kstab*d + 8*Jo*Bnot'*stress
 	f1.addMatrixTransposeVector(1.0, Bnot, mStress, mVol);
@@ -768,58 +762,49 @@ SSPbrickUP::getResistingForce(void)
 		}
 	}
 
-	// account for fluid body forces
-	Matrix k(3,3);
-	Vector body(3);
-	// permeability tensor
-	k(0,0) = perm[0];
-	k(1,1) = perm[1];
-	k(2,2) = perm[2];
-	// body force vector
-	if (applyLoad == 0) {
-		body(0) = b[0];
-		body(1) = b[1];
-		body(2) = b[2];
-	} else {
-		body(0) = appliedB[0];
-		body(1) = appliedB[1];
-		body(2) = appliedB[2];
+	// account for fluid body forces, f2 = mVol*rho_f*dNmod*k*body with the
+	// diagonal permeability tensor k
+	const double *body = (applyLoad == 0) ? b : appliedB;
+	double kb0 = mVol*fDens*perm[0]*body[0];
+	double kb1 = mVol*fDens*perm[1]*body[1];
+	double kb2 = mVol*fDens*perm[2]*body[2];
+	for (int i = 0; i < 8; i++) {
+		f2[i] = dNmod(i,0)*kb0 + dNmod(i,1)*kb1 + dNmod(i,2)*kb2;
 	}
-	f2 = mVol*fDens*dNmod*k*body;
 
 	// assemble full internal force vector for the element
 	mInternalForces(0)  = f1(0);
 	mInternalForces(1)  = f1(1);
 	mInternalForces(2)  = f1(2);
-	mInternalForces(3)  = f2(0);
+	mInternalForces(3)  = f2[0];
 	mInternalForces(4)  = f1(3);
 	mInternalForces(5)  = f1(4);
 	mInternalForces(6)  = f1(5);
-	mInternalForces(7)  = f2(1);
+	mInternalForces(7)  = f2[1];
 	mInternalForces(8)  = f1(6);
 	mInternalForces(9)  = f1(7);
 	mInternalForces(10) = f1(8);
-	mInternalForces(11) = f2(2);
+	mInternalForces(11) = f2[2];
 	mInternalForces(12) = f1(9);
 	mInternalForces(13) = f1(10);
 	mInternalForces(14) = f1(11);
-	mInternalForces(15) = f2(3);
+	mInternalForces(15) = f2[3];
 	mInternalForces(16) = f1(12);
 	mInternalForces(17) = f1(13);
 	mInternalForces(18) = f1(14);
-	mInternalForces(19) = f2(4);
+	mInternalForces(19) = f2[4];
 	mInternalForces(20) = f1(15);
 	mInternalForces(21) = f1(16);
 	mInternalForces(22) = f1(17);
-	mInternalForces(23) = f2(5);
+	mInternalForces(23) = f2[5];
 	mInternalForces(24) = f1(18);
 	mInternalForces(25) = f1(19);
 	mInternalForces(26) = f1(20);
-	mInternalForces(27) = f2(6);
+	mInternalForces(27) = f2[6];
 	mInternalForces(28) = f1(21);
 	mInternalForces(29) = f1(22);
 	mInternalForces(30) = f1(23);
-	mInternalForces(31) = f2(7);
+	mInternalForces(31) = f2[7];
 
 	// inertial unbalance load
 	mInternalForces.addVector(1.0, Q, -1.0);
@@ -845,7 +830,7 @@ SSPbrickUP::getResistingForceIncInertia()
 	const Vector &accel7 = theNodes[6]->getTrialAccel();
 	const Vector &accel8 = theNodes[7]->getTrialAccel();
 
-	Vector a(32);
+	static Vector a(32);
 	a(0) =  accel1(0);
 	a(1) =  accel1(1);
 	a(2) =  accel1(2);
@@ -891,7 +876,7 @@ SSPbrickUP::getResistingForceIncInertia()
 	const Vector &vel7 = theNodes[6]->getTrialVel();
 	const Vector &vel8 = theNodes[7]->getTrialVel();
 
-	Vector v(32);
+	static Vector v(32);
 	v(0) =  vel1(0);
 	v(1) =  vel1(1);
 	v(2) =  vel1(2);
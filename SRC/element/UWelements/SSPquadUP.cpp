@@ -367,18 +367,24 @@ SSPquadUP::update(void)
     const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
         
     // assemble displacement vector
-    Vector u(8);
-    u(0) = mDisp_1(0);
-    u(1) = mDisp_1(1);
-    u(2) = mDisp_2(0);
-    u(3) = mDisp_2(1);
-    u(4) = mDisp_3(0);
-    u(5) = mDisp_3(1);
-    u(6) = mDisp_4(0);
-    u(7) = mDisp_4(1);
-
-    Vector strain(3);
-    strain = Mmem*u;
+    double u[8];
+    u[0] = mDisp_1(0);
+    u[1] = mDisp_1(1);
+    u[2] = mDisp_2(0);
+    u[3] = mDisp_2(1);
+    u[4] = mDisp_3(0);
+    u[5] = mDisp_3(1);
+    u[6] = mDisp_4(0);
+    u[7] = mDisp_4(1);
+
+    // strain = Mmem*u, using the sparsity of the mapping matrix
+    static Vector strain(3);
+    strain.Zero();
+    for (int i = 0; i < 4; i++) {
+        strain(0) += dN(i,0)*u[2*i];
+        strain(1) += dN(i,1)*u[2*i+1];
+        strain(2) += dN(i,1)*u[2*i] + dN(i,0)*u[2*i+1];
+    }
     theMaterial->setTrialStrain(strain);
 
     return 0;
@@ -429,7 +435,8 @@ SSPquadUP::getInitialStiff(void)
 const Matrix &
 SSPquadUP::getDamp(void)
 {
-    Matrix dampC(8,8);
+    static Matrix dampC(8,8);
+    dampC.Zero();
 
     // solid phase stiffness matrix
     GetSolidStiffness();
@@ -498,14 +505,9 @@ SSPquadUP::getMass(void)
     // get mass density from the material
     double density = theMaterial->getRho();
 
-    // transpose the shape function derivative array
-    Matrix dNp(2,4);
-    dNp(0,0) = dN(0,0); dNp(0,1) = dN(1,0); dNp(0,2) = dN(2,0); dNp(0,3) = dN(3,0);
-    dNp(1,0) = dN(0,1); dNp(1,1) = dN(1,1); dNp(1,2) = dN(2,1); dNp(1,3) = dN(3,1);
-
-    // compute stabilization matrix for incompressible problems
-    Matrix Kp(4,4);
-    Kp = -4.0*mAlpha*J0*mThickness*dN*dNp;
+    // stabilization matrix for incompressible problems, Kp = -4*alpha*J0*t*dN*dN'
+    //  (formed term by term below)
+    double kpFact = -4.0*mAlpha*J0*mThickness;
 
     // return zero matrix if density is zero
     if (density == 0.0) {
@@ -536,7 +538,7 @@ SSPquadUP::getMass(void)
             mMass(II,JJp1)   = mSolidM(I,Jp1);
 
             // contribution of compressibility matrix
-            mMass(IIp2,JJp2) = Kp(i,j) + oneOverQ;
+            mMass(IIp2,JJp2) = kpFact*(dN(i,0)*dN(j,0) + dN(i,1)*dN(j,1)) + oneOverQ;
         }
     }
 
@@ -625,12 +627,11 @@ const Vector &
 SSPquadUP::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
-    Vector f1(8);
-    Vector f2(4);
-    Vector mStress(3); 
-        
+    static Vector f1(8);
+    double f2[4];
+
     // get stress from the material
-    mStress = theMaterial->getStress();
+    const Vector &mStress = theMaterial->getStress();
 
     // get trial displacement
     const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -638,7 +639,7 @@ SSPquadUP::getResistingForce(void)
     const Vector &mDisp_3 = theNodes[2]->getTrialDisp();
     const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
 
-    Vector d(8);
+    static Vector d(8);
     d(0) = mDisp_1(0);
     d(1) = mDisp_1(1);
     d(2) = mDisp_2(0);
@@ -649,7 +650,7 @@ SSPquadUP::getResistingForce(void)
     d(7) = mDisp_4(1);
 
     // add stabilization force to internal force vector 
-    f1 = Kstab*d;
+    f1.addMatrixVector(0.0, Kstab, d, 1.0);
 
     // add internal force from the stress
     f1.addMatrixTransposeVector(1.0, Mmem, mStress, 4.0*mThickness*J0);
@@ -675,35 +676,27 @@ SSPquadUP::getResistingForce(void)
         }
     }
 
-    // account for fluid body forces
-    Matrix k(2,2);
-    Vector body(2);
-    // permeability tensor
-    k(0,0) = perm[0];
-    k(1,1) = perm[1];
-    // body force vector
-    if (applyLoad == 0) {
-        body(0) = b[0];
-        body(1) = b[1];
-    } else {
-        body(0) = appliedB[0];
-        body(1) = appliedB[1];
-    }
-    f2 = 4.0*J0*mThickness*fDens*dN*k*body;
+    // account for fluid body forces, f2 = 4*J0*t*rho_f*dN*k*body with the
+    // diagonal permeability tensor k
+    const double *body = (applyLoad == 0) ? b : appliedB;
+    double kb0 = 4.0*J0*mThickness*fDens*perm[0]*body[0];
+    double kb1 = 4.0*J0*mThickness*fDens*perm[1]*body[1];
+    for (int i = 0; i < 4; i++)
+        f2[i] = dN(i,0)*kb0 + dN(i,1)*kb1;
 
     // assemble full internal force vector for the element
     mInternalForces(0)  = f1(0);
     mInternalForces(1)  = f1(1);
-    mInternalForces(2)  = f2(0);
+    mInternalForces(2)  = f2[0];
     mInternalForces(3)  = f1(2);
     mInternalForces(4)  = f1(3);
-    mInternalForces(5)  = f2(1);
+    mInternalForces(5)  = f2[1];
     mInternalForces(6)  = f1(4);
     mInternalForces(7)  = f1(5);
-    mInternalForces(8)  = f2(2);
+    mInternalForces(8)  = f2[2];
     mInternalForces(9)  = f1(6);
     mInternalForces(10) = f1(7);
-    mInternalForces(11) = f2(3);
+    mInternalForces(11) = f2[3];
 
     //LM change
     // Subtract pressure loading from internal force vector
@@ -733,7 +726,7 @@ SSPquadUP::getResistingForceIncInertia()
 	// compute mass matrix
 	this->getMass();
 
-	Vector a(12);
+	static Vector a(12);
 	a(0)  = accel1(0);
 	a(1)  = accel1(1);
 	a(2)  = accel1(2);
@@ -755,7 +748,7 @@ SSPquadUP::getResistingForceIncInertia()
 	const Vector &vel3 = theNodes[2]->getTrialVel();
 	const Vector &vel4 = theNodes[3]->getTrialVel();
 	
-	Vector v(12);
+	static Vector v(12);
 	v(0)  = vel1(0);
 	v(1)  = vel1(1);
 	v(2)  = vel1(2);
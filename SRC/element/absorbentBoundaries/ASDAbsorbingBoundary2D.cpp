@@ -382,6 +382,7 @@ void ASDAbsorbingBoundary2D::setDomain(Domain* theDomain)
 
     // call base class implementation
     DomainComponent::setDomain(theDomain);
+    m_matrices_formed = false;
 }
 
 void ASDAbsorbingBoundary2D::Print(OPS_Stream& s, int flag)
@@ -433,25 +434,17 @@ int ASDAbsorbingBoundary2D::revertToLastCommit()
     return 0;
 }
 
-const Matrix& ASDAbsorbingBoundary2D::getTangentStiff(void)
+bool ASDAbsorbingBoundary2D::hasConstantTangent(void)
 {
-    // initialize matrix
-    static Matrix K;
-    K.resize(m_num_dofs, m_num_dofs);
-    K.Zero();
-
-    // fill K matrix
-    if (m_stage == Stage_StaticConstraint) {
-        addKPenaltyStage0(K);
-    }
-    else {
-        addKPenaltyStage1(K);
-        addKff(K);
-        addKffToSoil(K);
-    }
+    // the stage and the properties only change through updateParameter
+    return true;
+}
 
-    // done
-    return K;
+const Matrix& ASDAbsorbingBoundary2D::getTangentStiff(void)
+{
+    if (!m_matrices_formed)
+        formMatrices();
+    return m_K;
 }
 
 const Matrix& ASDAbsorbingBoundary2D::getInitialStiff(void)
@@ -461,35 +454,16 @@ const Matrix& ASDAbsorbingBoundary2D::getInitialStiff(void)
 
 const Matrix& ASDAbsorbingBoundary2D::getDamp(void)
 {
-    // initialize matrix
-    static Matrix C;
-    C.resize(m_num_dofs, m_num_dofs);
-    C.Zero();
-
-    // fill the C matrix
-    if (m_stage == Stage_Absorbing) {
-        addCff(C);
-        addClk(C);
-    }
-
-    // done
-    return C;
+    if (!m_matrices_formed)
+        formMatrices();
+    return m_C;
 }
 
 const Matrix& ASDAbsorbingBoundary2D::getMass(void)
 {
-    // initialize matrix
-    static Matrix M;
-    M.resize(m_num_dofs, m_num_dofs);
-    M.Zero();
-
-    if (m_stage == Stage_Absorbing) {
-        // free-field mass
-        addMff(M);
-    }
-
-    // done
-    return M;
+    if (!m_matrices_formed)
+        formMatrices();
+    return m_M;
 }
 
 int ASDAbsorbingBoundary2D::addInertiaLoadToUnbalance(const Vector& accel)
@@ -731,6 +705,7 @@ int ASDAbsorbingBoundary2D::recvSelf(int commitTag, Channel& theChannel, FEM_Obj
     }
     // initialization flag
     m_initialized = static_cast<bool>(idData(pos++));
+    m_matrices_formed = false;
     // double data size (not known at compile-time)
     int dsize = idData(pos++);
 
@@ -815,6 +790,9 @@ int ASDAbsorbingBoundary2D::setParameter(const char** argv, int argc, Parameter&
 
 int ASDAbsorbingBoundary2D::updateParameter(int parameterID, Information& info)
 {
+    // all parameters change the matrices
+    m_matrices_formed = false;
+
     switch (parameterID)
     {
     case 1:
@@ -1014,6 +992,39 @@ void ASDAbsorbingBoundary2D::updateStage()
 
     // update stage
     m_stage = Stage_Absorbing;
+    m_matrices_formed = false;
+}
+
+void ASDAbsorbingBoundary2D::formMatrices()
+{
+    // the matrices are linear and only depend on the geometry, the
+    // properties and the stage, so they are formed once and kept
+    m_K.resize(m_num_dofs, m_num_dofs);
+    m_K.Zero();
+    m_C.resize(m_num_dofs, m_num_dofs);
+    m_C.Zero();
+    m_M.resize(m_num_dofs, m_num_dofs);
+    m_M.Zero();
+
+    // fill K matrix
+    if (m_stage == Stage_StaticConstraint) {
+        addKPenaltyStage0(m_K);
+    }
+    else {
+        addKPenaltyStage1(m_K);
+        addKff(m_K);
+        addKffToSoil(m_K);
+    }
+
+    // fill the C and M matrices
+    if (m_stage == Stage_Absorbing) {
+        addCff(m_C);
+        addClk(m_C);
+        // free-field mass
+        addMff(m_M);
+    }
+
+    m_matrices_formed = true;
 }
 
 void ASDAbsorbingBoundary2D::penaltyFactor(double& sp, double& mp)
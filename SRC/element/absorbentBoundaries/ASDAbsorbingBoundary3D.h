@@ -85,6 +85,7 @@ public:
 
     // methods to return the current linearized stiffness,
     // damping and mass matrices
+    bool hasConstantTangent(void);
     const Matrix& getTangentStiff(void);
     const Matrix& getInitialStiff(void);
     const Matrix& getDamp(void);
@@ -121,6 +122,8 @@ private:
     const Vector& getAcceleration();
     // update stage
     void updateStage();
+    // forms the K, C and M matrices of the current stage
+    void formMatrices();
     // compute a consistent penalty value
     void penaltyFactor(double& sp, double& mp);
     // fills the penalty stiffness matrix in stage = 0
@@ -197,6 +200,11 @@ private:
     bool m_is_computing_reactions = false;
     // initialized flag
     bool m_initialized = false;
+    // the (constant) matrices of the current stage, and whether they are up to date
+    Matrix m_K;
+    Matrix m_C;
+    Matrix m_M;
+    bool m_matrices_formed = false;
     // time series for base actions
     TimeSeries* m_tsx = nullptr;
     TimeSeries* m_tsy = nullptr;
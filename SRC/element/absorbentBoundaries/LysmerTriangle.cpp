@@ -130,6 +130,9 @@ LysmerTriangle::LysmerTriangle(int tag, int Nd1, int Nd2, int Nd3, double rho_,
    dcrd2(SL_NUM_NDF),
    dcrd3(SL_NUM_NDF),
    gnd_velocity(3),
+   constantStiffness(SL_NUM_DOF, SL_NUM_DOF),
+   constantDamping(SL_NUM_DOF, SL_NUM_DOF),
+   matricesFormed(false),
    stage(stage)
 {
     myExternalNodes(0) = Nd1;
@@ -164,6 +167,9 @@ LysmerTriangle::LysmerTriangle()
    	dcrd2(SL_NUM_NDF),
    	dcrd3(SL_NUM_NDF),
     gnd_velocity(3),
+    constantStiffness(SL_NUM_DOF, SL_NUM_DOF),
+    constantDamping(SL_NUM_DOF, SL_NUM_DOF),
+    matricesFormed(false),
     stage(0)
 {
 }
@@ -217,6 +223,7 @@ LysmerTriangle::setDomain(Domain *theDomain)
     this->DomainComponent::setDomain(theDomain);
 
     UpdateBase(GsPts[0][0], GsPts[0][0]);
+    matricesFormed = false;
 
     Bmat(0,0) = 0.5;
     Bmat(1,1) = 0.5;
@@ -301,10 +308,14 @@ LysmerTriangle::UpdateBase(double Xi, double Eta)
     return 0;
 }
 
-const Matrix &
-LysmerTriangle::getTangentStiff(void)
+void
+LysmerTriangle::formMatrices(void)
 {
-    tangentStiffness.Zero();
+    // the matrices are linear and only depend on the geometry, the
+    // properties and the stage, so they are formed once and kept
+    constantStiffness.Zero();
+    constantDamping.Zero();
+
     // = 0 (pure damping) 
     // = 1 (pure stiffness) 
     // = 2 (damping and stiffness) 
@@ -330,7 +341,6 @@ LysmerTriangle::getTangentStiff(void)
       static Matrix T(3,3);
       static Matrix K(3,3);
       subStiff.Zero();
-      tangentStiffness.Zero();
       K.Zero();
       T.Zero();
       // K(0,0) = G/L;
@@ -361,34 +371,15 @@ LysmerTriangle::getTangentStiff(void)
       //   do_once = false;
       // }
 
-      tangentStiffness.addMatrixTripleProduct(1, Bmat, subStiff, 1.0);
+      constantStiffness.addMatrixTripleProduct(1, Bmat, subStiff, 1.0);
     }
 
-    return tangentStiffness;
-}
-
-const Matrix &
-LysmerTriangle::getInitialStiff(void)
-{
-    return getTangentStiff();
-}
-   
-const Matrix &
-LysmerTriangle::getDamp(void)
-{
-
-    // = 0 (pure damping) 
-    // = 1 (pure stiffness) 
-    // = 2 (damping and stiffness) 
-    // = 3 (damping but preserve elastic forces from springs after gravity analysis)
-    tangentDamping.Zero();
     if(stage == 0 || stage == 2 || stage == 3)
     {
       static Matrix subDamp(3,3);
       static Matrix T(3,3);
       static Matrix C(3,3);
       subDamp.Zero();
-      tangentDamping.Zero();
       T.Zero();
       C.Zero();
       C(0,0) = rho*Vs;
@@ -403,10 +394,41 @@ LysmerTriangle::getDamp(void)
       }
   
       subDamp.addMatrixTripleProduct(1., T, C, A);
-      tangentDamping.addMatrixTripleProduct(1,Bmat, subDamp, 1.0);
+      constantDamping.addMatrixTripleProduct(1,Bmat, subDamp, 1.0);
     }
 
-    return tangentDamping;
+    matricesFormed = true;
+}
+
+bool
+LysmerTriangle::hasConstantTangent(void)
+{
+    // the stage and the properties only change through updateParameter
+    return true;
+}
+
+const Matrix &
+LysmerTriangle::getTangentStiff(void)
+{
+    if (!matricesFormed)
+      this->formMatrices();
+
+    return constantStiffness;
+}
+
+const Matrix &
+LysmerTriangle::getInitialStiff(void)
+{
+    return getTangentStiff();
+}
+   
+const Matrix &
+LysmerTriangle::getDamp(void)
+{
+    if (!matricesFormed)
+      this->formMatrices();
+
+    return constantDamping;
 } 
 
 
@@ -456,7 +478,7 @@ LysmerTriangle::getResistingForce()
     static Vector displacements(9);
     springForces.Zero();
 
-    tangentStiffness = getTangentStiff();
+    const Matrix &K = this->getTangentStiff();
 
     int count = 0;
     for (int node = 0; node < 3; ++node)
@@ -467,7 +489,7 @@ LysmerTriangle::getResistingForce()
       displacements(count++) = d(2);
     }
 
-    springForces.addMatrixVector(0, tangentStiffness, displacements, 1.0);
+    springForces.addMatrixVector(0, K, displacements, 1.0);
     // internalForces += springForces;
   } 
   if (stage == 3) //whatever is in spring forces is directly added as a reaction force
@@ -491,7 +513,7 @@ LysmerTriangle::getResistingForceIncInertia()
     static Vector velocities(9);
     internalForces.Zero();
 
-    tangentDamping = getDamp();
+    const Matrix &C = this->getDamp();
 
     int count = 0;
     for (int node = 0; node < 3; ++node)
@@ -502,7 +524,7 @@ LysmerTriangle::getResistingForceIncInertia()
       velocities(count++) = 0*v(2) + gnd_velocity(2);
     }
 
-    internalForces.addMatrixVector(0.0, tangentDamping, velocities, 1.0);
+    internalForces.addMatrixVector(0.0, C, velocities, 1.0);
   } 
   else if (stage == 1)
   {
@@ -622,6 +644,7 @@ LysmerTriangle::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &t
   mLoadFactor = data(5);
   element_length = data(6);
   stage = (int )data(7);
+  matricesFormed = false;
   A = data(8);
 
 
@@ -762,6 +785,9 @@ LysmerTriangle::setParameter(const char **argv, int argc, Parameter &param)
 int
 LysmerTriangle::updateParameter(int parameterID, Information &info)
 {
+  // all parameters change the matrices
+  matricesFormed = false;
+
   switch(parameterID) {
   case 1:
     
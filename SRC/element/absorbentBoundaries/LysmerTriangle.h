@@ -72,6 +72,7 @@ class LysmerTriangle : public Element
     
     // public methods to obtain stiffness, mass, damping and 
     // residual information    
+    bool hasConstantTangent(void);
     const Matrix &getTangentStiff(void);
     const Matrix &getInitialStiff(void);   
     const Matrix &getDamp(void);     
@@ -102,6 +103,8 @@ class LysmerTriangle : public Element
 
     // method to update base vectors g1 & g2
     int UpdateBase(double Xi, double Eta);
+    // method to form the constant stiffness and damping matrices
+    void formMatrices(void);
 
     Vector internalForces;    // vector of Internal Forces
     Vector springForces;      // vector of spring forces
@@ -139,6 +142,10 @@ class LysmerTriangle : public Element
     static Matrix Bmat;
 
 	double mLoadFactor;       // factor from load pattern
+
+    Matrix constantStiffness; // stiffness and damping of the current stage and
+    Matrix constantDamping;   // properties, formed once after setDomain
+    bool matricesFormed;
     
     int stage;    // =0 (pure damping) 
                   // =1 (pure stiffness) 
@@ -35,6 +35,7 @@
 #include <ElementResponse.h>
 #include <TCP_Socket.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 #ifdef SSL
     #include <TCP_SocketSSL.h>
 #endif
@@ -60,7 +61,7 @@ void* OPS_ActuatorCorot()
     // check the number of arguments is correct
     if (OPS_GetNumRemainingInputArgs() < 5) {
         opserr << "WARNING insufficient arguments\n";
-        opserr << "Want: element actuator eleTag iNode jNode EA ipPort <-ssl> <-udp> <-doRayleigh> <-rho rho>\n";
+        opserr << "Want: element actuator eleTag iNode jNode EA ipPort <-ssl> <-udp> <-shm> <-doRayleigh> <-rho rho>\n";
         return 0;
     }
     
@@ -94,17 +95,20 @@ void* OPS_ActuatorCorot()
     }
     
     // options
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int doRayleigh = 0;
     double rho = 0.0;
     
 	while (OPS_GetNumRemainingInputArgs() > 0) {
 		const char* flag = OPS_GetString();
 		if (strcmp(flag, "-ssl") == 0) {
-			ssl = 1; udp = 0;
+			ssl = 1; udp = 0; shm = 0;
 		}
 		else if (strcmp(flag, "-udp") == 0) {
-			udp = 1; ssl = 0;
+			udp = 1; ssl = 0; shm = 0;
+		}
+		else if (strcmp(flag, "-shm") == 0) {
+			shm = 1; ssl = 0; udp = 0;
 		}
 		else if (strcmp(flag, "-doRayleigh") == 0) {
 			doRayleigh = 1;
@@ -123,17 +127,18 @@ void* OPS_ActuatorCorot()
     
     // now create the actuator and add it to the Domain
     return new ActuatorCorot(tag, ndm, iNode, jNode, EA, ipPort,
-			     ssl, udp, doRayleigh, rho);
+			     ssl, udp, doRayleigh, rho, shm);
 }
 
 
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 ActuatorCorot::ActuatorCorot(int tag, int dim, int Nd1, int Nd2,
-    double ea, int ipport, int _ssl, int _udp, int addRay, double r)
+    double ea, int ipport, int _ssl, int _udp, int addRay, double r,
+    int _shm)
     : Element(tag, ELE_TAG_ActuatorCorot), numDIM(dim), numDOF(0),
     connectedExternalNodes(2), EA(ea), ipPort(ipport), ssl(_ssl),
-    udp(_udp), addRayleigh(addRay), rho(r), L(0.0), Ln(0.0),
+    udp(_udp), shm(_shm), addRayleigh(addRay), rho(r), L(0.0), Ln(0.0),
     tPast(0.0), theMatrix(0), theVector(0), theLoad(0), R(3,3), db(1), q(1),
     theChannel(0), rData(0), recvData(0), sData(0), sendData(0),
     ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
@@ -159,7 +164,7 @@ ActuatorCorot::ActuatorCorot(int tag, int dim, int Nd1, int Nd2,
 ActuatorCorot::ActuatorCorot()
     : Element(0, ELE_TAG_ActuatorCorot), numDIM(0), numDOF(0),
     connectedExternalNodes(2), EA(0.0), ipPort(0), ssl(0),
-    udp(0), addRayleigh(0), rho(0.0), L(0.0), Ln(0.0), tPast(0.0),
+    udp(0), shm(0), addRayleigh(0), rho(0.0), L(0.0), Ln(0.0), tPast(0.0),
     theMatrix(0), theVector(0), theLoad(0), R(3,3), db(1), q(1),
     theChannel(0), rData(0), recvData(0), sData(0), sendData(0),
     ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0)
@@ -643,6 +648,13 @@ const Vector& ActuatorCorot::getResistingForce()
             theChannel->recvVector(0, 0, *recvData, 0);
         }
         
+        // the time since the last trial response, for its jitter
+        if (rData[0] == RemoteTest_setTrialResponse)  {
+            if (tPast > 0.0)
+                stepPeriod.stop();
+            stepPeriod.start();
+        }
+        
         if (rData[0] != RemoteTest_setTrialResponse)  {
             if (rData[0] == RemoteTest_DIE)  {
                 opserr << "\nThe Simulation has successfully completed.\n";
@@ -722,7 +734,7 @@ const Vector& ActuatorCorot::getResistingForceIncInertia()
 int ActuatorCorot::sendSelf(int commitTag, Channel &sChannel)
 {
     // send element parameters
-    static Vector data(13);
+    static Vector data(14);
     data(0) = this->getTag();
     data(1) = numDIM;
     data(2) = numDOF;
@@ -736,6 +748,7 @@ int ActuatorCorot::sendSelf(int commitTag, Channel &sChannel)
     data(10) = betaK;
     data(11) = betaK0;
     data(12) = betaKc;
+    data(13) = shm;
     sChannel.sendVector(0, commitTag, data);
     
     // send the two end nodes
@@ -749,7 +762,7 @@ int ActuatorCorot::recvSelf(int commitTag, Channel &rChannel,
     FEM_ObjectBroker &theBroker)
 {
     // receive element parameters
-    static Vector data(13);
+    static Vector data(14);
     rChannel.recvVector(0, commitTag, data);
     this->setTag((int)data(0));
     numDIM = (int)data(1);
@@ -764,6 +777,7 @@ int ActuatorCorot::recvSelf(int commitTag, Channel &rChannel,
     betaK = data(10);
     betaK0 = data(11);
     betaKc = data(12);
+    shm = (int)data(13);
     
     // receive the two end nodes
     rChannel.recvID(0, commitTag, connectedExternalNodes);
@@ -889,6 +903,18 @@ Response* ActuatorCorot::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 6, Vector(1));
     }
     
+    // time between the trial responses from the remote process
+    else if (strcmp(argv[0],"stepPeriod") == 0)
+    {
+        output.tag("ResponseType","num");
+        output.tag("ResponseType","last");
+        output.tag("ResponseType","mean");
+        output.tag("ResponseType","max");
+        output.tag("ResponseType","jitter");
+        
+        theResponse = new ElementResponse(this, 20, Vector(5));
+    }
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -942,6 +968,9 @@ int ActuatorCorot::getResponse(int responseID, Information &eleInformation)
         }
         return 0;
         
+    case 20:  // time between the trial responses
+        return eleInformation.setVector(stepPeriod.getStats());
+        
     default:
         return 0;
     }
@@ -951,7 +980,9 @@ int ActuatorCorot::getResponse(int responseID, Information &eleInformation)
 int ActuatorCorot::setupConnection()
 {
     // setup the connection
-    if (udp)
+    if (shm)
+        theChannel = new SharedMemoryChannel(ipPort, true);
+    else if (udp)
         theChannel = new UDP_Socket(ipPort);
 #ifdef SSL
     else if (ssl)
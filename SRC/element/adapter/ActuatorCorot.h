@@ -33,6 +33,7 @@
 
 #include <Element.h>
 #include <Matrix.h>
+#include <LatencyMonitor.h>
 
 #define RemoteTest_open              1
 #define RemoteTest_setup             2
@@ -60,7 +61,7 @@ public:
     // constructors
     ActuatorCorot(int tag, int dim, int Nd1, int Nd2,
         double EA, int ipPort, int ssl = 0, int udp = 0,
-        int addRayleigh = 0, double rho = 0.0);
+        int addRayleigh = 0, double rho = 0.0, int shm = 0);
     ActuatorCorot();
     
     // destructor
@@ -119,6 +120,7 @@ private:
     int ipPort;         // ipPort
     int ssl;            // secure socket layer flag
     int udp;            // udp socket flag
+    int shm;            // shared memory channel flag
     int addRayleigh;    // flag to add Rayleigh damping
     double rho;         // rho: mass per unit length
     double L;           // undeformed actuator length
@@ -157,6 +159,8 @@ private:
     static Vector ActuatorCorotV6;   // class wide Vector for size 6
     static Vector ActuatorCorotV12;  // class wide Vector for size 12
     
+    LatencyMonitor stepPeriod;  // time between the trial responses
+    
     int setupConnection();
 };
 
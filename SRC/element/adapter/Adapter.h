@@ -33,6 +33,7 @@
 
 #include <Element.h>
 #include <Matrix.h>
+#include <LatencyMonitor.h>
 
 #define RemoteTest_open              1
 #define RemoteTest_setup             2
@@ -60,7 +61,7 @@ public:
     // constructors
     Adapter(int tag, ID nodes, ID *dof, const Matrix &stif,
         int ipPort, int ssl = 0, int udp = 0,
-        int addRayleigh = 0, const Matrix *mass = 0);
+        int addRayleigh = 0, const Matrix *mass = 0, int shm = 0);
     Adapter();
     
     // destructor
@@ -122,6 +123,7 @@ private:
     int ipPort;                 // ipPort
     int ssl;                    // secure socket layer flag
     int udp;                    // udp socket flag
+    int shm;                    // shared memory channel flag
     int addRayleigh;            // flag to add Rayleigh damping
     Matrix *mb;                 // mass matrix in basic system
     double tPast;               // past time
@@ -152,6 +154,8 @@ private:
     
     Node **theNodes;
     
+    LatencyMonitor stepPeriod;  // time between the trial responses
+    
     int setupConnection();
 };
 
@@ -111,7 +111,7 @@ const double  BbarBrick::wg[] = { 1.0, 1.0, 1.0, 1.0,
 //null constructor
 BbarBrick::BbarBrick( ) :
 Element( 0, ELE_TAG_BbarBrick ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), shapeCache(0)
 {
   for (int i=0; i<8; i++ ) {
     materialPointers[i] = 0;
@@ -137,7 +137,7 @@ BbarBrick::BbarBrick(  int tag,
 			 NDMaterial &theMaterial,
 			 double b1, double b2, double b3) :
 Element( tag, ELE_TAG_BbarBrick ),
-connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
+connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), shapeCache(0)
 {
   connectedExternalNodes(0) = node1 ;
   connectedExternalNodes(1) = node2 ;
@@ -187,6 +187,9 @@ BbarBrick::~BbarBrick( )
 
   if (Ki != 0)
     delete Ki;
+
+  if (shapeCache != 0)
+    delete [] shapeCache;
 }
 
 
@@ -200,6 +203,12 @@ void  BbarBrick::setDomain( Domain *theDomain )
   for ( i=0; i<8; i++ )
      nodePointers[i] = theDomain->getNode( connectedExternalNodes(i) ) ;
 
+  //the nodes may have moved, form the shape functions again
+  if (shapeCache != 0) {
+    delete [] shapeCache;
+    shapeCache = 0;
+  }
+
   this->DomainComponent::setDomain(theDomain);
 
 }
@@ -331,8 +340,6 @@ const Matrix&  BbarBrick::getInitialStiff( )
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ;
 
   static const int nstress = 6 ;
@@ -346,14 +353,9 @@ const Matrix&  BbarBrick::getInitialStiff( )
   int i, j, k, p, q ;
   int jj, kk ;
 
-  static double volume ;
-
-  static double xsj ;  // determinant jacaobian matrix
 
   static double dvol[numberGauss] ; //volume element
 
-  static double gaussPoint[ndm] ;
-
   static Vector strain(nstress) ;  //strain
 
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
@@ -384,63 +386,8 @@ const Matrix&  BbarBrick::getInitialStiff( )
   stiff.Zero( ) ;
 
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //zero mean shape functions
-  for ( p = 0; p < nShape; p++ ) {
-    for ( q = 0; q < numberNodes; q++ )
-      shpBar[p][q] = 0.0 ;
-  } // end for p
-
-  //zero volume
-  volume = 0.0 ;
-
-
-  //gauss loop to compute and save shape functions
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-        //add to volume
-	volume += dvol[count] ;
-
-	//add to mean shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    shpBar[p][q] += ( dvol[count] * shp[p][q] ) ;
-	} // end for p
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
-
-  //mean value of shape functions
-  for ( p = 0; p < nShape; p++ ) {
-    for ( q = 0; q < numberNodes; q++ )
-      shpBar[p][q] /= volume ;
-  } // end for p
+  //shape functions, volume elements and mean shape functions
+  shapeFunctions( Shape, dvol, shpBar ) ;
 
 
   //gauss loop
@@ -639,8 +586,6 @@ const Vector&  BbarBrick::getResistingForceIncInertia( )
 void   BbarBrick::formInertiaTerms( int tangFlag )
 {
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ;
 
   static const int numberNodes = 8 ;
@@ -651,18 +596,16 @@ void   BbarBrick::formInertiaTerms( int tangFlag )
 
   static const int massIndex = nShape - 1 ;
 
-  double xsj ;  // determinant jacaobian matrix
-
   double dvol[numberGauss] ; //volume element
 
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
 
-  static double gaussPoint[ndm] ;
-
   static Vector momentum(ndf) ;
 
+  double shpBar[nShape][numberNodes] ;  //not needed for the mass
+
   int i, j, k, p, q ;
   int jj, kk ;
 
@@ -672,38 +615,8 @@ void   BbarBrick::formInertiaTerms( int tangFlag )
   //zero mass
   mass.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol, shpBar ) ;
 
 
 
@@ -777,8 +690,6 @@ void  BbarBrick::formResidAndTangent( int tang_flag )
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ;
 
   static const int nstress = 6 ;
@@ -794,14 +705,9 @@ void  BbarBrick::formResidAndTangent( int tang_flag )
 
   int success ;
 
-  static double volume ;
-
-  static double xsj ;  // determinant jacaobian matrix
 
   static double dvol[numberGauss] ; //volume element
 
-  static double gaussPoint[ndm] ;
-
   static Vector strain(nstress) ;  //strain
 
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
@@ -836,64 +742,8 @@ void  BbarBrick::formResidAndTangent( int tang_flag )
   stiff.Zero( ) ;
   resid.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-
-  //zero mean shape functions
-  for ( p = 0; p < nShape; p++ ) {
-    for ( q = 0; q < numberNodes; q++ )
-      shpBar[p][q] = 0.0 ;
-  } // end for p
-
-  //zero volume
-  volume = 0.0 ;
-
-
-  //gauss loop to compute and save shape functions
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;
-	gaussPoint[1] = sg[j] ;
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;
-
-        //add to volume
-	volume += dvol[count] ;
-
-	//add to mean shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    shpBar[p][q] += ( dvol[count] * shp[p][q] ) ;
-	} // end for p
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i
-
-
-  //mean value of shape functions
-  for ( p = 0; p < nShape; p++ ) {
-    for ( q = 0; q < numberNodes; q++ )
-      shpBar[p][q] /= volume ;
-  } // end for p
+  //shape functions, volume elements and mean shape functions
+  shapeFunctions( Shape, dvol, shpBar ) ;
 
 
   //gauss loop
@@ -1008,6 +858,104 @@ void  BbarBrick::formResidAndTangent( int tang_flag )
 }
 
 
+//************************************************************************
+//shape functions, volume elements and mean shape functions
+
+void   BbarBrick::shapeFunctions( double Shape[4][8][8], double dvol[8],
+				  double shpBar[4][8] )
+{
+  static const int ndm = 3 ;
+  static const int numberNodes = 8 ;
+  static const int numberGauss = 8 ;
+  static const int nShape = 4 ;
+  static const int nShapeAll = nShape*numberNodes*numberGauss ;
+  static const int cacheSize = nShapeAll + numberGauss + nShape*numberNodes ;
+
+  int i, j, k, p, q ;
+
+  //the geometry of a small strain brick does not change, so with the
+  //cache on the Jacobians are formed once and copied afterwards
+  if ( shapeCache != 0 && Element::cacheGeometry ) {
+    for ( i = 0; i < nShapeAll; i++ )
+      (&Shape[0][0][0])[i] = shapeCache[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      dvol[i] = shapeCache[nShapeAll + i] ;
+    for ( i = 0; i < nShape*numberNodes; i++ )
+      (&shpBar[0][0])[i] = shapeCache[nShapeAll + numberGauss + i] ;
+    return ;
+  }
+
+  double xsj ;  // determinant jacaobian matrix
+  double gaussPoint[ndm] ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+  double volume = 0.0 ;
+
+  //compute basis vectors and local nodal coordinates
+  computeBasis( ) ;
+
+  //zero mean shape functions
+  for ( p = 0; p < nShape; p++ ) {
+    for ( q = 0; q < numberNodes; q++ )
+      shpBar[p][q] = 0.0 ;
+  } // end for p
+
+  //gauss loop to compute and save shape functions
+  int count = 0 ;
+
+  for ( i = 0; i < 2; i++ ) {
+    for ( j = 0; j < 2; j++ ) {
+      for ( k = 0; k < 2; k++ ) {
+
+        gaussPoint[0] = sg[i] ;
+	gaussPoint[1] = sg[j] ;
+	gaussPoint[2] = sg[k] ;
+
+	//get shape functions
+	shp3d( gaussPoint, xsj, shp, xl ) ;
+
+	//save shape functions
+	for ( p = 0; p < nShape; p++ ) {
+	  for ( q = 0; q < numberNodes; q++ )
+	    Shape[p][q][count] = shp[p][q] ;
+	} // end for p
+
+	//volume element to also be saved
+	dvol[count] = wg[count] * xsj ;
+
+        //add to volume
+	volume += dvol[count] ;
+
+	//add to mean shape functions
+	for ( p = 0; p < nShape; p++ ) {
+	  for ( q = 0; q < numberNodes; q++ )
+	    shpBar[p][q] += ( dvol[count] * shp[p][q] ) ;
+	} // end for p
+
+	count++ ;
+
+      } //end for k
+    } //end for j
+  } // end for i
+
+  //mean value of shape functions
+  for ( p = 0; p < nShape; p++ ) {
+    for ( q = 0; q < numberNodes; q++ )
+      shpBar[p][q] /= volume ;
+  } // end for p
+
+  if ( Element::cacheGeometry ) {
+    if ( shapeCache == 0 )
+      shapeCache = new double[cacheSize] ;
+    for ( i = 0; i < nShapeAll; i++ )
+      shapeCache[i] = (&Shape[0][0][0])[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      shapeCache[nShapeAll + i] = dvol[i] ;
+    for ( i = 0; i < nShape*numberNodes; i++ )
+      shapeCache[nShapeAll + numberGauss + i] = (&shpBar[0][0])[i] ;
+  }
+
+}
+
 //************************************************************************
 //compute local coordinates and basis
 
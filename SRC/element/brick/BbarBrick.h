@@ -158,6 +158,11 @@ class BbarBrick : public Element {
     //compute coordinate system
     void computeBasis( ) ;
 
+    //shape functions, volume elements and mean shape functions, cached
+    //when Element::cacheGeometry is set
+    void shapeFunctions( double Shape[4][8][8], double dvol[8],
+			 double shpBar[4][8] ) ;
+
     //compute Bbar matrix
     const Matrix& computeBbar( int node, 
 			       const double shp[4][8], 
@@ -168,6 +173,8 @@ class BbarBrick : public Element {
 
     Vector *load;
     Matrix *Ki;
+
+    double *shapeCache ;  //saved Shape, dvol and shpBar, see shapeFunctions
 } ; 
 
 
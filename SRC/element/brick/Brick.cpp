@@ -39,6 +39,7 @@
 #include <Domain.h>
 #include <ErrorHandler.h>
 #include <Brick.h>
+#include <MemoryReport.h>
 #include <shp3d.h>
 #include <Renderer.h>
 #include <ElementResponse.h>
@@ -48,6 +49,10 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <AnalysisProfiler.h>
+#include <ElasticIsotropicMaterial.h>
+#include <ExplicitForceKernel.h>
+#include <string.h>
 
 void* OPS_Brick()
 {
@@ -130,7 +135,7 @@ static Matrix B(6,3) ;
 //null constructor
 Brick::Brick( ) 
 :Element( 0, ELE_TAG_Brick ),
- connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
+ connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), shapeCache(0)
 {
   B.Zero();
 
@@ -163,7 +168,7 @@ Brick::Brick(int tag,
 	     double b1, double b2, double b3,
        Damping *damping)
   :Element(tag, ELE_TAG_Brick),
-   connectedExternalNodes(8), applyLoad(0), load(0), Ki(0)
+   connectedExternalNodes(8), applyLoad(0), load(0), Ki(0), shapeCache(0)
 {
   B.Zero();
 
@@ -225,6 +230,9 @@ Brick::~Brick( )
   if (Ki != 0)
     delete Ki;
 
+  if (shapeCache != 0)
+    delete [] shapeCache;
+
   for (int i = 0; i < 8; i++)
   {
     if (theDamping[i])
@@ -247,6 +255,12 @@ void  Brick::setDomain( Domain *theDomain )
   for ( i=0; i<8; i++ ) 
      nodePointers[i] = theDomain->getNode( connectedExternalNodes(i) ) ;
 
+  //the nodes may have moved, form the shape functions again
+  if (shapeCache != 0) {
+    delete [] shapeCache;
+    shapeCache = 0;
+  }
+
     
   for (int i = 0; i < 8; i++)
   {
@@ -323,8 +337,11 @@ int  Brick::commitState( )
   }    
 
 
-  for (int i=0; i<8; i++ ) 
-    success += materialPointers[i]->commitState( ) ;
+  if ( this->isSingleMaterialType( ) )
+    success += materialPointers[0]->commitStateBatch( 8, materialPointers ) ;
+  else
+    for (int i=0; i<8; i++ ) 
+      success += materialPointers[i]->commitState( ) ;
 
   for (int i = 0; i < 8; i++ )
     if (theDamping[i]) success += theDamping[i]->commitState();
@@ -341,8 +358,11 @@ int  Brick::revertToLastCommit( )
   int i ;
   int success = 0 ;
 
-  for ( i=0; i<8; i++ ) 
-    success += materialPointers[i]->revertToLastCommit( ) ;
+  if ( this->isSingleMaterialType( ) )
+    success += materialPointers[0]->revertToLastCommitBatch( 8, materialPointers ) ;
+  else
+    for ( i=0; i<8; i++ ) 
+      success += materialPointers[i]->revertToLastCommit( ) ;
 
   for (int i = 0; i < 8; i++ )
     if (theDamping[i]) success += theDamping[i]->revertToLastCommit();
@@ -366,6 +386,17 @@ int  Brick::revertToStart( )
   return success ;
 }
 
+size_t
+Brick::getMaterialMemoryUsage(void)
+{
+  size_t result = 0;
+  for (int i = 0; i < 8; i++)
+    if (materialPointers[i] != 0)
+      result += MemoryReport::objectSize(materialPointers[i]);
+
+  return result;
+}
+
 //print out element data
 void  Brick::Print(OPS_Stream &s, int flag)
 {
@@ -477,7 +508,6 @@ const Matrix&  Brick::getInitialStiff( )
     return *Ki;
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31 
-  static const int ndm = 3 ;
   static const int ndf = 3 ; 
   static const int nstress = 6 ;
   static const int numberNodes = 8 ;
@@ -488,10 +518,7 @@ const Matrix&  Brick::getInitialStiff( )
   int jj, kk ;
 
   
-  static double volume ;
-  static double xsj ;  // determinant jacaobian matrix 
   static double dvol[numberGauss] ; //volume element
-  static double gaussPoint[ndm] ;
   static Vector strain(nstress) ;  //strain
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
@@ -515,42 +542,8 @@ const Matrix&  Brick::getInitialStiff( )
   //zero stiffness and residual 
   stiff.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions 
-
-  int count = 0 ;
-  volume = 0.0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;        
-	gaussPoint[1] = sg[j] ;        
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions    
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;  
-
-	//volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i 
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
   
 
   //gauss loop 
@@ -753,8 +746,6 @@ const Vector&  Brick::getResistingForceIncInertia( )
 void   Brick::formInertiaTerms( int tangFlag ) 
 {
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ; 
 
   static const int numberNodes = 8 ;
@@ -765,16 +756,12 @@ void   Brick::formInertiaTerms( int tangFlag )
 
   static const int massIndex = nShape - 1 ;
 
-  double xsj ;  // determinant jacaobian matrix 
-
   double dvol[numberGauss] ; //volume element
 
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
 
-  static double gaussPoint[ndm] ;
-
   static Vector momentum(ndf) ;
 
   int i, j, k, p, q ;
@@ -786,39 +773,8 @@ void   Brick::formInertiaTerms( int tangFlag )
   //zero mass 
   mass.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions 
-
-  int count = 0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;        
-	gaussPoint[1] = sg[j] ;        
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions    
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;  
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i 
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
   
 
 
@@ -886,6 +842,52 @@ void   Brick::formInertiaTerms( int tangFlag )
 
 }
 
+//*********************************************************************
+//the same linear elastic isotropic material at the gauss points & no
+//damping; the body forces go into the constant part of the force
+int
+Brick::addToForceKernel(ExplicitForceKernel &theKernel, const int *loc)
+{
+  if (this->getNumDOF() != 24 || this->isFrozen() || !this->isActive())
+    return -1;
+  if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+    return -1;
+
+  double E = 0.0, nu = 0.0 ;
+  for ( int i = 0; i < 8; i++ ) {
+    if (theDamping[i] != 0 ||
+	strcmp(materialPointers[i]->getClassType(), "ElasticIsotropicThreeDimensional") != 0)
+      return -1;
+    ElasticIsotropicMaterial *theElastic = (ElasticIsotropicMaterial *)materialPointers[i];
+    if (i == 0) {
+      E = theElastic->getElasticModulus();
+      nu = theElastic->getPoissonsRatio();
+    } else if (theElastic->getElasticModulus() != E || theElastic->getPoissonsRatio() != nu)
+      return -1;
+  }
+  double lambda = E*nu/((1.0+nu)*(1.0-2.0*nu));
+  double mu = 0.5*E/(1.0+nu);
+
+  double Shape[4][8][8] ;
+  double dvol[8] ;
+  shapeFunctions( Shape, dvol ) ;
+
+  double grad[8*24], P0[24] ;
+  for ( int k = 0; k < 24; k++ )
+    P0[k] = 0.0 ;
+  for ( int g = 0; g < 8; g++ ) {
+    for ( int a = 0; a < 8; a++ ) {
+      for ( int i = 0; i < 3; i++ ) {
+	grad[(g*8+a)*3+i] = Shape[i][a][g] ;
+	P0[3*a+i] += dvol[g]*b[i]*Shape[3][a][g] ;
+      }
+    }
+  }
+
+  return theKernel.addBrick(loc, grad, dvol, lambda, mu, P0);
+}
+
+
 //*********************************************************************
 //form residual and tangent
 int  
@@ -894,8 +896,6 @@ Brick::update(void)
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31 
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ; 
 
   static const int nstress = 6 ;
@@ -906,19 +906,16 @@ Brick::update(void)
 
   static const int nShape = 4 ;
 
-  int i, j, k, p, q ;
+  int i, j, p, q ;
   int success ;
   
-  static double volume ;
-
-  static double xsj ;  // determinant jacaobian matrix 
 
   static double dvol[numberGauss] ; //volume element
 
-  static double gaussPoint[ndm] ;
-
   static Vector strain(nstress) ;  //strain
 
+  static double gaussStrain[numberGauss*nstress] ;  //strains at all gauss points
+
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
@@ -936,42 +933,8 @@ Brick::update(void)
   //-------------------------------------------------------
 
   
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions 
-
-  int count = 0 ;
-  volume = 0.0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;        
-	gaussPoint[1] = sg[j] ;        
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions    
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;  
-
-	//volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i 
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
   
 
   //gauss loop 
@@ -1045,15 +1008,38 @@ Brick::update(void)
 
     } // end for j
     
-    //send the strain to the material 
-    success = materialPointers[i]->setTrialStrain( strain ) ;
+    //save the strain for the material 
+    for ( p = 0; p < nstress; p++ )
+      gaussStrain[i*nstress+p] = strain(p) ;
 
   } //end for i gauss loop 
 
+  //send the strains to the materials, in one call if they are of one class
+  if ( this->isSingleMaterialType( ) ) {
+    ProfileClass cost( ProfileClass::Material, materialPointers[0] ) ;
+    success = materialPointers[0]->setTrialStrainBatch( numberGauss, materialPointers,
+							 gaussStrain, nstress ) ;
+  }
+  else
+    success = materialPointers[0]->NDMaterial::setTrialStrainBatch( numberGauss, materialPointers,
+								     gaussStrain, nstress ) ;
+
   return 0;
 }
 
 
+//all materials of one class
+bool  Brick::isSingleMaterialType( ) const
+{
+  int classTag = materialPointers[0]->getClassTag( ) ;
+  for ( int i = 1; i < 8; i++ )
+    if ( materialPointers[i]->getClassTag( ) != classTag )
+      return false ;
+
+  return true ;
+}
+
+
 //*********************************************************************
 //form residual and tangent
 void  Brick::formResidAndTangent( int tang_flag ) 
@@ -1061,8 +1047,6 @@ void  Brick::formResidAndTangent( int tang_flag )
 
   //strains ordered : eps11, eps22, eps33, 2*eps12, 2*eps23, 2*eps31 
 
-  static const int ndm = 3 ;
-
   static const int ndf = 3 ; 
 
   static const int nstress = 6 ;
@@ -1076,14 +1060,9 @@ void  Brick::formResidAndTangent( int tang_flag )
   int i, j, k, p, q ;
 
 
-  static double volume ;
-
-  static double xsj ;  // determinant jacaobian matrix 
 
   static double dvol[numberGauss] ; //volume element
 
-  static double gaussPoint[ndm] ;
-
   static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
   static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
@@ -1116,42 +1095,8 @@ void  Brick::formResidAndTangent( int tang_flag )
   stiff.Zero( ) ;
   resid.Zero( ) ;
 
-  //compute basis vectors and local nodal coordinates
-  computeBasis( ) ;
-
-  //gauss loop to compute and save shape functions 
-
-  int count = 0 ;
-  volume = 0.0 ;
-
-  for ( i = 0; i < 2; i++ ) {
-    for ( j = 0; j < 2; j++ ) {
-      for ( k = 0; k < 2; k++ ) {
-
-        gaussPoint[0] = sg[i] ;        
-	gaussPoint[1] = sg[j] ;        
-	gaussPoint[2] = sg[k] ;
-
-	//get shape functions    
-	shp3d( gaussPoint, xsj, shp, xl ) ;
-
-	//save shape functions
-	for ( p = 0; p < nShape; p++ ) {
-	  for ( q = 0; q < numberNodes; q++ )
-	    Shape[p][q][count] = shp[p][q] ;
-	} // end for p
-
-
-	//volume element to also be saved
-	dvol[count] = wg[count] * xsj ;  
-
-	//volume += dvol[count] ;
-
-	count++ ;
-
-      } //end for k
-    } //end for j
-  } // end for i 
+  //shape functions and volume elements at the gauss points
+  shapeFunctions( Shape, dvol ) ;
   
 
   //gauss loop 
@@ -1288,6 +1233,77 @@ void  Brick::formResidAndTangent( int tang_flag )
 }
 
 
+//************************************************************************
+//shape functions and volume elements at the gauss points
+
+void   Brick::shapeFunctions( double Shape[4][8][8], double dvol[8] )
+{
+  static const int ndm = 3 ;
+  static const int numberNodes = 8 ;
+  static const int numberGauss = 8 ;
+  static const int nShape = 4 ;
+  static const int cacheSize = nShape*numberNodes*numberGauss + numberGauss ;
+
+  int i, j, k, p, q ;
+
+  //the geometry of a small strain brick does not change, so with the
+  //cache on the Jacobians are formed once and copied afterwards
+  if ( shapeCache != 0 && Element::cacheGeometry ) {
+    for ( i = 0; i < nShape*numberNodes*numberGauss; i++ )
+      (&Shape[0][0][0])[i] = shapeCache[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      dvol[i] = shapeCache[nShape*numberNodes*numberGauss + i] ;
+    return ;
+  }
+
+  double xsj ;  // determinant jacaobian matrix 
+  double gaussPoint[ndm] ;
+  double shp[nShape][numberNodes] ;  //shape functions at a gauss point
+
+  //compute basis vectors and local nodal coordinates
+  computeBasis( ) ;
+
+  //gauss loop to compute and save shape functions 
+
+  int count = 0 ;
+
+  for ( i = 0; i < 2; i++ ) {
+    for ( j = 0; j < 2; j++ ) {
+      for ( k = 0; k < 2; k++ ) {
+
+        gaussPoint[0] = sg[i] ;        
+	gaussPoint[1] = sg[j] ;        
+	gaussPoint[2] = sg[k] ;
+
+	//get shape functions    
+	shp3d( gaussPoint, xsj, shp, xl ) ;
+
+	//save shape functions
+	for ( p = 0; p < nShape; p++ ) {
+	  for ( q = 0; q < numberNodes; q++ )
+	    Shape[p][q][count] = shp[p][q] ;
+	} // end for p
+
+	//volume element to also be saved
+	dvol[count] = wg[count] * xsj ;  
+
+	count++ ;
+
+      } //end for k
+    } //end for j
+  } // end for i 
+
+  if ( Element::cacheGeometry ) {
+    if ( shapeCache == 0 )
+      shapeCache = new double[cacheSize] ;
+    for ( i = 0; i < nShape*numberNodes*numberGauss; i++ )
+      shapeCache[i] = (&Shape[0][0][0])[i] ;
+    for ( i = 0; i < numberGauss; i++ )
+      shapeCache[nShape*numberNodes*numberGauss + i] = dvol[i] ;
+  }
+
+}
+
 //************************************************************************
 //compute local coordinates and basis
 
@@ -95,9 +95,11 @@ class Brick : public Element {
 
     // update
     int update(void);
+    int addToForceKernel(ExplicitForceKernel &theKernel, const int *loc);
 
     //print out element data
     void Print( OPS_Stream &s, int flag ) ;
+    size_t getMaterialMemoryUsage(void);
 	
     //return stiffness matrix 
     const Matrix &getTangentStiff();
@@ -178,6 +180,13 @@ class Brick : public Element {
     //compute coordinate system
     void computeBasis( ) ;
 
+    //shape functions and volume elements at the gauss points, cached
+    //when Element::cacheGeometry is set
+    void shapeFunctions( double Shape[4][8][8], double dvol[8] ) ;
+
+    //true if all the materials are of one class, so they can go as a batch
+    bool isSingleMaterialType( ) const ;
+
     //compute B matrix
     const Matrix& computeB( int node, const double shp[4][8] ) ;
   
@@ -186,6 +195,8 @@ class Brick : public Element {
 
     Damping *theDamping[8];
 
+    double *shapeCache ;  //saved Shape and dvol, see shapeFunctions
+
 } ; 
 
 #endif
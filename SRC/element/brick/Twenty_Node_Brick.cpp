@@ -47,6 +47,42 @@
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// invokes f(0) ... f(n-1), as tasks of the threads of the process when
+// parallel is set: inside a parallel region, e.g. the threaded element
+// update of the domain, the calls become tasks taken up by the idle
+// threads of the team, otherwise a parallel region is opened for them
+template <class F>
+static void
+forEachTask(int n, bool parallel, F f)
+{
+#ifdef _OPENMP
+	if (parallel) {
+		// the tasks may run in other threads, with other globals
+		OPS_ThreadGlobals theGlobals;
+		if (omp_in_parallel()) {
+#pragma omp taskloop grainsize(1)
+			for (int i = 0; i < n; i++) {
+				theGlobals.install();
+				f(i);
+			}
+		} else {
+#pragma omp parallel for schedule(dynamic, 1)
+			for (int i = 0; i < n; i++) {
+				theGlobals.install();
+				f(i);
+			}
+		}
+		return;
+	}
+#endif
+	for (int i = 0; i < n; i++)
+		f(i);
+}
+
 void* OPS_Twenty_Node_Brick()
 {
     if (OPS_GetNDM() != 3 ) {
@@ -113,7 +149,7 @@ double Twenty_Node_Brick::dvolu[27];
 //null constructor
 Twenty_Node_Brick::Twenty_Node_Brick( ) :
 Element( 0, ELE_TAG_Twenty_Node_Brick ),
-connectedExternalNodes(20), applyLoad(0), load(0), Ki(0)//, kc(0), rho(0)
+connectedExternalNodes(20), applyLoad(0), load(0), Ki(0), shapeTable(0)//, kc(0), rho(0)
 {
 	for (int i=0; i<20; i++ ) {
 		nodePointers[i] = 0;
@@ -151,7 +187,7 @@ Twenty_Node_Brick::Twenty_Node_Brick(int tag,
 											   NDMaterial &theMaterial,
 											   double b1, double b2, double b3) :
 Element( tag, ELE_TAG_Twenty_Node_Brick ),
-connectedExternalNodes(20), applyLoad(0), load(0), Ki(0)//, kc(bulk), rho(rhof)
+connectedExternalNodes(20), applyLoad(0), load(0), Ki(0), shapeTable(0)//, kc(bulk), rho(rhof)
 {
 	connectedExternalNodes(0) = node1 ;
 	connectedExternalNodes(1) = node2 ;
@@ -226,6 +262,9 @@ Twenty_Node_Brick::~Twenty_Node_Brick( )
 
 	if (Ki != 0)
 		delete Ki;
+
+	if (shapeTable != 0)
+		delete [] shapeTable;
 }
 
 
@@ -239,6 +278,10 @@ void  Twenty_Node_Brick::setDomain( Domain *theDomain )
 			nodePointers[i] = 0;
 		return;
 	}
+	// the shape function tables are formed again for the new nodes
+	if (shapeTable != 0)
+		delete [] shapeTable;
+	shapeTable = 0;
 	//node pointers
 	for ( i=0; i<nenu; i++ ) {
 		nodePointers[i] = theDomain->getNode( connectedExternalNodes(i) ) ;
@@ -426,93 +469,54 @@ void  Twenty_Node_Brick::Print(OPS_Stream &s, int flag)
 int
 Twenty_Node_Brick::update()
 {
-	int i, j, k, k1;
-	static double u[3][20];
-	static double xsj;
-	static Matrix B(6, 3);
-	double volume = 0.;
-
-	for (i = 0; i < nenu; i++) {
-	     const Vector &disp = nodePointers[i]->getTrialDisp();
-	     u[0][i] = disp(0);
-	     u[1][i] = disp(1);
-	     u[2][i] = disp(2);
-    }
-
-	static Vector eps(6);
-
-	int ret = 0;
-
-	//compute basis vectors and local nodal coordinates
-	computeBasis( ) ;
-
-	for( i = 0; i < nintu; i++ ) {
-		// compute Jacobian and global shape functions
-		Jacobian3d(i, xsj, 0);
-		//volume element to also be saved
-		dvolu[i] = wu[i] * xsj ;
-		volume += dvolu[i];
-	} // end for i
-    //printf("volume = %f\n", volume);
-
-	// Loop over the integration points
-	for (i = 0; i < nintu; i++) {
-
-		// Interpolate strains
-		//eps = B*u;
-		//eps.addMatrixVector(0.0, B, u, 1.0);
-		eps.Zero();
-		for ( j = 0; j < nenu; j++) {
-
-
-			B(0,0) = shgu[0][j][i];
-			B(0,1) = 0.;
-			B(0,2) = 0.;
-			B(1,0) = 0.;
-			B(1,1) = shgu[1][j][i];
-			B(1,2) = 0.;
-			B(2,0) = 0.;
-			B(2,1) = 0.;
-			B(2,2) = shgu[2][j][i];
-			B(3,0) = shgu[1][j][i];
-			B(3,1) = shgu[0][j][i];
-			B(3,2) = 0.;
-			B(4,0) = 0.;
-			B(4,1) = shgu[2][j][i];
-			B(4,2) = shgu[1][j][i];
-			B(5,0) = shgu[2][j][i];
-			B(5,1) = 0.;
-			B(5,2) = shgu[0][j][i];
-
-			//BJ = computeB( j, shp ) ;
-
-			//nodal displacements
-			const Vector &ul = nodePointers[j]->getTrialDisp( ) ;
-			Vector ul3(3);
-			ul3(0) = ul(0);
-			ul3(1) = ul(1);
-			ul3(2) = ul(2);
-			//compute the strain
-			//strain += (BJ*ul) ;
-			eps.addMatrixVector(1.0,B,ul3,1.0 ) ;
-
-			/* for( k = 0; k < 6; k++) {
-			for( k1 = 0; k1 < 3; k1++) {
-			eps[k] += BJ(k, k1)*u[k1][j];
-			}
-		}	*/
-
+	if (shapeTable == 0)
+		this->formShapeTables();
+
+	double u[3][20];
+	for (int j = 0; j < nenu; j++) {
+		const Vector &disp = nodePointers[j]->getTrialDisp();
+		u[0][j] = disp(0);
+		u[1][j] = disp(1);
+		u[2][j] = disp(2);
+	}
 
+	// interpolate the strains at the integration points, eps = B*u
+	double eps[27][6];
+	for (int i = 0; i < nintu; i++) {
+		const double *shx = &shapeTable[i*80];
+		const double *shy = shx + 20;
+		const double *shz = shx + 40;
+
+		double e0 = 0.0, e1 = 0.0, e2 = 0.0, e3 = 0.0, e4 = 0.0, e5 = 0.0;
+		for (int j = 0; j < nenu; j++) {
+			e0 += shx[j]*u[0][j];
+			e1 += shy[j]*u[1][j];
+			e2 += shz[j]*u[2][j];
+			e3 += shy[j]*u[0][j] + shx[j]*u[1][j];
+			e4 += shz[j]*u[1][j] + shy[j]*u[2][j];
+			e5 += shz[j]*u[0][j] + shx[j]*u[2][j];
 		}
+		eps[i][0] = e0; eps[i][1] = e1; eps[i][2] = e2;
+		eps[i][3] = e3; eps[i][4] = e4; eps[i][5] = e5;
+	}
 
-		// Set the material strain
-		ret += materialPointers[i]->setTrialStrain(eps);
+	// set the material strains, concurrently if all the materials allow it
+	if (Element::parallelPoints && this->isThreadSafeMaterial()) {
+		int ret[27];
+		forEachTask(nintu, true, [&](int i) {
+			Vector epsi(eps[i], 6);
+			ret[i] = materialPointers[i]->setTrialStrain(epsi);
+		});
+
+		int res = 0;
+		for (int i = 0; i < nintu; i++)
+			res += ret[i];
+		return res;
 	}
 
-	return ret;
+	return NDMaterial::setTrialStrainGroups(nintu, materialPointers, &eps[0][0], 6);
 }
 
-
 //return tangent stiffness matrix
 
 const Matrix&  Twenty_Node_Brick::getTangentStiff( )
@@ -538,227 +542,88 @@ const Matrix&  Twenty_Node_Brick::getInitialStiff( )
 
 
 // compute stiffness matrix
-
 const Matrix&  Twenty_Node_Brick::getStiff( int flag )
-
 {
-
 	if (flag != 0 && flag != 1) {
-
 		opserr << "FATAL Twenty_Node_Brick::getStiff() - illegal use\n";
-
 		exit(-1);
-
 	}
 
-
-
 	if (flag == 0 && Ki != 0)
-
 		return *Ki;
 
-
-
-	int i, j ;
-
-
-
-	static double xsj ;  // determinant jacaobian matrix
-
-	double volume = 0.;
-
-	//-------------------------------------------------------
-
-	int j3, j3m1, j3m2, ik, ib, jk, jb;
-
-	static Matrix B(6,nenu*3);
-
-	static Matrix BTDB(nenu*3,nenu*3);
-
-	static Matrix D(6, 6);
-
-	B.Zero();
-
-	BTDB.Zero();
-
-	stiff.Zero();
-
-//		FILE *fp;
-
-//		fp = fopen("stiff.dat","w");
-
-
-
-	//compute basis vectors and local nodal coordinates
-
-	computeBasis( ) ;
-
-
-
-	for( i = 0; i < nintu; i++ ) {
-
-		// compute Jacobian and global shape functions
-
-		Jacobian3d(i, xsj, 0);
-
-		//volume element to also be saved
-
-		dvolu[i] = wu[i] * xsj ;
-
-		volume += dvolu[i];
-
-	} // end for i
-
-    //printf("volume = %f\n", volume);
-
-
-
-//	for( i = 0; i < nintu; i++ ) {
-
-//		for(int j = 0; j < nenu; j++ ) {
-
-//			printf("%5d %5d %15.6e %15.6e %15.6e %15.6e\n", i,j,
-
-//				shgu[0][j][i], shgu[1][j][i], shgu[2][j][i], shgu[3][j][i]);
-
-//		}
-
-//	}
-
-//	exit(-1);
-
-
-
-	// Loop over the integration points
-
-	for (i = 0; i < nintu; i++) {
-
-
-
-		// Get the material tangent
-
-		if( flag == 0 )
-
-			D = materialPointers[i]->getInitialTangent();
-
-		else
-
-			D = materialPointers[i]->getTangent();
-
-		//const Matrix &D = materialPointers[i]->getTangent();
-
-
-
-
-
-		for (j=0; j<nenu; j++) {
-
-
-
-			j3   = 3*j+2;
-
-			j3m1 = j3 - 1;
-
-			j3m2 = j3 - 2;
-
-
-
-			B(0,j3m2) = shgu[0][j][i];
-
-			B(0,j3m1) = 0.;
-
-			B(0,j3  ) = 0.;
-
-
-
-			B(1,j3m2) = 0.;
-
-			B(1,j3m1) = shgu[1][j][i];
-
-			B(1,j3  ) = 0.;
-
-
-
-			B(2,j3m2) = 0.;
-
-			B(2,j3m1) = 0.;
-
-			B(2,j3  ) = shgu[2][j][i];
-
-
-
-			B(3,j3m2) = shgu[1][j][i];
-
-			B(3,j3m1) = shgu[0][j][i];
-
-			B(3,j3  ) = 0.;
-
-
-
-			B(4,j3m2) = 0.;
-
-			B(4,j3m1) = shgu[2][j][i];
-
-			B(4,j3  ) = shgu[1][j][i];
-
-
-
-			B(5,j3m2) = shgu[2][j][i];
-
-			B(5,j3m1) = 0.;
-
-			B(5,j3  ) = shgu[0][j][i];
-
-
-
-		}
-
-
-
-		// Perform numerical integration
-
-		//K = K + (B^ D * B) * intWt(i) * detJ;
-
-		BTDB.addMatrixTripleProduct(1.0, B, D, dvolu[i]);
-
+	if (shapeTable == 0)
+		this->formShapeTables();
+
+	// the material tangents are collected first, the materials may
+	// return work areas shared with other materials
+	double D[27][36];
+	for (int i = 0; i < nintu; i++) {
+		const Matrix &Di = (flag == 0) ? materialPointers[i]->getInitialTangent() :
+			materialPointers[i]->getTangent();
+		for (int p = 0; p < 6; p++)
+			for (int q = 0; q < 6; q++)
+				D[i][p*6+q] = Di(p,q);
 	}
 
-    for( i = 0; i < 60; i++)
-
-		for( j = 0; j < 60; j++)
+	// K = sum over the points of B^T D B dvol; the rows of node j are a
+	// task of their own, so the tasks write to disjoint parts of stiff
+	forEachTask(nenu, Element::parallelPoints, [&](int j) {
+		double Kj[3][60];
+		for (int p = 0; p < 3; p++)
+			for (int q = 0; q < 60; q++)
+				Kj[p][q] = 0.0;
 
-			stiff(i,j) = BTDB(i,j);
+		for (int i = 0; i < nintu; i++) {
+			const double *shx = &shapeTable[i*80];
+			const double *shy = shx + 20;
+			const double *shz = shx + 40;
+			const double *Di = D[i];
+
+			double a = shx[j]*dvolTable[i];
+			double b = shy[j]*dvolTable[i];
+			double c = shz[j]*dvolTable[i];
+
+			// BtD = B_j^T D dvol
+			double BtD[3][6];
+			for (int q = 0; q < 6; q++) {
+				BtD[0][q] = a*Di[q] + b*Di[18+q] + c*Di[30+q];
+				BtD[1][q] = b*Di[6+q] + a*Di[18+q] + c*Di[24+q];
+				BtD[2][q] = c*Di[12+q] + b*Di[24+q] + a*Di[30+q];
+			}
 
+			for (int k = 0; k < nenu; k++) {
+				double ak = shx[k];
+				double bk = shy[k];
+				double ck = shz[k];
+				for (int p = 0; p < 3; p++) {
+					const double *t = BtD[p];
+					Kj[p][3*k]   += t[0]*ak + t[3]*bk + t[5]*ck;
+					Kj[p][3*k+1] += t[1]*bk + t[3]*ak + t[4]*ck;
+					Kj[p][3*k+2] += t[2]*ck + t[4]*bk + t[5]*ak;
+				}
+			}
+		}
 
+		for (int p = 0; p < 3; p++)
+			for (int q = 0; q < 60; q++)
+				stiff(3*j+p, q) = Kj[p][q];
+	});
 
 	if( flag == 1) {
-
 		return stiff;
-
 	}
 
 	Ki = new Matrix(stiff);
-
 	if (Ki == 0) {
-
 		opserr << "FATAL Twenty_Node_Brick::getStiff() -";
-
 		opserr << "ran out of memory\n";
-
 		exit(-1);
-
 	}
 
-
-
 	return *Ki;
-
 }
 
-
-
-
-
 //return mass matrix
 
 const Matrix&  Twenty_Node_Brick::getMass( )
@@ -987,172 +852,46 @@ Twenty_Node_Brick::addInertiaLoadToUnbalance(const Vector &accel)
 //get residual
 
 const Vector&  Twenty_Node_Brick::getResistingForce( )
-
 {
-
-	int i, j, jk, k, k1;
-
-	double xsj;
-
-	static Matrix B(6, 3);
-
-	double volume = 0.;
-
-
-
-//	printf("calling getResistingForce()\n");
+	if (shapeTable == 0)
+		this->formShapeTables();
 
 	resid.Zero();
 
-
-
-	//compute basis vectors and local nodal coordinates
-
-	computeBasis( ) ;
-
-	//gauss loop to compute and save shape functions
-
-	for( i = 0; i < nintu; i++ ) {
-
-		// compute Jacobian and global shape functions
-
-		Jacobian3d(i, xsj, 0);
-
-		//volume element to also be saved
-
-		dvolu[i] = wu[i] * xsj ;
-
-		volume += dvolu[i];
-
-	} // end for i
-
-	//printf("volume = %f\n", volume);
-
-
-
 	// Loop over the integration points
-
-	for (i = 0; i < nintu; i++) {
-
-
+	for (int i = 0; i < nintu; i++) {
 
 		// Get material stress response
-
 		const Vector &sigma = materialPointers[i]->getStress();
-
-
-
-		// Perform numerical integration on internal force
-
-		//P = P + (B^ sigma) * intWt(i)*intWt(j) * detJ;
-
-		//P.addMatrixTransposeVector(1.0, B, sigma, intWt(i)*intWt(j)*detJ);
-
-		for (j = 0; j < nenu; j++) {
-
-
-
-			B(0,0) = shgu[0][j][i];
-
-			B(0,1) = 0.;
-
-			B(0,2) = 0.;
-
-			B(1,0) = 0.;
-
-			B(1,1) = shgu[1][j][i];
-
-			B(1,2) = 0.;
-
-			B(2,0) = 0.;
-
-			B(2,1) = 0.;
-
-			B(2,2) = shgu[2][j][i];
-
-			B(3,0) = shgu[1][j][i];
-
-			B(3,1) = shgu[0][j][i];
-
-			B(3,2) = 0.;
-
-			B(4,0) = 0.;
-
-			B(4,1) = shgu[2][j][i];
-
-			B(4,2) = shgu[1][j][i];
-
-			B(5,0) = shgu[2][j][i];
-
-			B(5,1) = 0.;
-
-			B(5,2) = shgu[0][j][i];
-
-
-
-
-
-			for(k = 0; k < 3; k++) {
-
-				for(k1 = 0; k1 < 6; k1++)
-
-					resid(j*3+k) += dvolu[i]*(B(k1,k)*sigma(k1));
-
-			}
-
-			// Subtract equiv. body forces from the nodes
-
-			//P = P - (N^ b) * intWt(i)*intWt(j) * detJ;
-
-			//P.addMatrixTransposeVector(1.0, N, b, -intWt(i)*intWt(j)*detJ);
-
-			double r = mixtureRho(i);
-
-			if (applyLoad == 0) {
-
-				resid(j*3) -= dvolu[i]*(shgu[3][j][i]*r*b[0]);
-
-				resid(j*3+1) -= dvolu[i]*(shgu[3][j][i]*r*b[1]);
-
-				resid(j*3+2) -= dvolu[i]*(shgu[3][j][i]*r*b[2]);
-			} else {
-				resid(j*3) -= dvolu[i]*(shgu[3][j][i]*r*appliedB[0]);
-
-				resid(j*3+1) -= dvolu[i]*(shgu[3][j][i]*r*appliedB[1]);
-
-				resid(j*3+2) -= dvolu[i]*(shgu[3][j][i]*r*appliedB[2]);
-			}
-
+		double s0 = sigma(0), s1 = sigma(1), s2 = sigma(2);
+		double s3 = sigma(3), s4 = sigma(4), s5 = sigma(5);
+
+		const double *shx = &shapeTable[i*80];
+		const double *shy = shx + 20;
+		const double *shz = shx + 40;
+		const double *sh = shx + 60;
+		double dv = dvolTable[i];
+
+		// equiv. body forces, P = P - (N^ b) * intWt * detJ
+		double r = mixtureRho(i);
+		const double *bf = (applyLoad == 0) ? b : appliedB;
+		double b0 = r*bf[0], b1 = r*bf[1], b2 = r*bf[2];
+
+		// internal force, P = P + (B^ sigma) * intWt * detJ
+		for (int j = 0; j < nenu; j++) {
+			resid(j*3)   += dv*(shx[j]*s0 + shy[j]*s3 + shz[j]*s5 - sh[j]*b0);
+			resid(j*3+1) += dv*(shy[j]*s1 + shx[j]*s3 + shz[j]*s4 - sh[j]*b1);
+			resid(j*3+2) += dv*(shz[j]*s2 + shy[j]*s4 + shx[j]*s5 - sh[j]*b2);
 		}
-
 	}
 
-
-
 	// Subtract other external nodal loads ... P_res = P_int - P_ext
-
-//	opserr<<"resid before:"<<resid<<endln;
-
-
-
 	if (load != 0)
-
 		resid -= *load;
 
-
-
-//	opserr<<"resid "<<resid<<endln;
-
-
-
 	return resid ;
-
 }
 
-
-
-
-
 //get residual with inertia terms
 
 const Vector&  Twenty_Node_Brick::getResistingForceIncInertia( )
@@ -1840,6 +1579,38 @@ Twenty_Node_Brick::getResponse(int responseID, Information &eleInfo)
 
 
 
+// global shape functions and derivatives and volume weights at the
+// integration points, the kinematics are linear so they depend on the
+// initial nodal coordinates only
+void
+Twenty_Node_Brick::formShapeTables(void)
+{
+	if (shapeTable == 0)
+		shapeTable = new double[27*4*20];
+
+	double xsj;
+
+	computeBasis( ) ;
+	for (int i = 0; i < nintu; i++) {
+		Jacobian3d(i, xsj, 0);
+		dvolTable[i] = wu[i] * xsj;
+		for (int k = 0; k < 4; k++)
+			for (int j = 0; j < nenu; j++)
+				shapeTable[(i*4+k)*20+j] = shgu[k][j][i];
+	}
+}
+
+// true if the state of all the materials may be set concurrently
+bool
+Twenty_Node_Brick::isThreadSafeMaterial(void)
+{
+	for (int i = 0; i < nintu; i++)
+		if (materialPointers[i]->isThreadSafe() == false)
+			return false;
+
+	return true;
+}
+
 // calculate local shape functions
 
 void
@@ -175,6 +175,14 @@ private :
     Vector *load;
     Matrix *Ki;
 
+    // global shape functions and derivatives at the integration points,
+    // stored point by point as [27][4][20], and the volume weights
+    double *shapeTable;
+    double dvolTable[27];
+    void formShapeTables(void);
+
+    bool isThreadSafeMaterial(void);
+
 	// compute local shape functions
 	void compuLocalShapeFunction();
 	void Jacobian3d(int gaussPoint, double& xsj, int mode);
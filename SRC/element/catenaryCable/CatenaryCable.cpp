@@ -177,6 +177,12 @@ CatenaryCable::CatenaryCable(int tag, int node1, int node2, double weight_, doub
   first_step(true),
   massType(massType_)
 {
+    f1 = f2 = f3 = 0.;
+    f1_n = f2_n = f3_n = 0.;
+    have_converged_forces = false;
+    commit_converged = false;
+    chord_current = false;
+
     
     // ensure the connectedExternalNode ID is of correct size & set values
     if (connectedExternalNodes.Size() != 2) {
@@ -214,6 +220,12 @@ CatenaryCable::CatenaryCable()
   first_step(true),
   massType(0)
 {
+  f1 = f2 = f3 = 0.;
+  f1_n = f2_n = f3_n = 0.;
+  have_converged_forces = false;
+  commit_converged = false;
+  chord_current = false;
+
     // ensure the connectedExternalNode ID is of correct size 
   if (connectedExternalNodes.Size() != 2) {
       opserr << "FATAL CatenaryCable::CatenaryCable - failed to create an ID of size 2\n";
@@ -357,6 +369,10 @@ CatenaryCable::commitState()
   int retVal = 0;
 
   *load_lastcommit = *load;
+  f1_n = f1;
+  f2_n = f2;
+  f3_n = f3;
+  commit_converged = have_converged_forces;
   KE_n = KE;
   PE_n = PE;
 
@@ -372,12 +388,23 @@ CatenaryCable::commitState()
 int
 CatenaryCable::revertToLastCommit()
 {
+  // the next force iteration restarts from the committed forces
+  f1 = f1_n;
+  f2 = f2_n;
+  f3 = f3_n;
+  have_converged_forces = commit_converged;
+  chord_current = false;
   return 0;
 }
 
 int
 CatenaryCable::revertToStart()
 {
+  f1 = f2 = f3 = 0.;
+  f1_n = f2_n = f3_n = 0.;
+  have_converged_forces = false;
+  commit_converged = false;
+  chord_current = false;
   return 0;
 }
 
@@ -392,39 +419,15 @@ CatenaryCable::update(void)
   const Vector &end1Disp = theNodes[0]->getTrialDisp();
   const Vector &end2Disp = theNodes[1]->getTrialDisp();
 
-
-  // double acc1 = 0;
-  // double acc2 = 0;
-  // double acc3 = 0;
-  // int count = 0;
-  // for (int i = 0; i < 2; i++) 
-  // {
-  //   const Vector &accel = theNodes[i]->getTrialAccel();
-  //   acc1 += 0.5*accel(0);
-  //   acc2 += 0.5*accel(1);
-  //   acc3 += 0.5*accel(2);
-  // }
-  // w1 += -rho*acc1;
-  // w2 += -rho*acc2;
-  // w3 += -rho*acc3;
-
-
-  // const Vector &end1Disp_commit = theNodes[0]->getTrialDisp();
-  // const Vector &end2Disp_commit = theNodes[1]->getTrialDisp();
-
   lx0 = end2Crd(0) + end2Disp(0) - (end1Crd(0) + end1Disp(0));
   ly0 = end2Crd(1) + end2Disp(1) - (end1Crd(1) + end1Disp(1));
   lz0 = end2Crd(2) + end2Disp(2) - (end1Crd(2) + end1Disp(2));
 
-  // opserr << "end1Crd = " << end1Crd << endln;
-  // opserr << "end1Disp = " << end1Disp << endln;
-  // opserr << "end2Crd = " << end2Crd << endln;
-  // opserr << "end2Disp = " << end2Disp << endln;
-
-  // opserr <<"   w1 = " <<  w1 << endln; 
-  // opserr <<"   w2 = " <<  w2 << endln; 
-  // opserr <<"   w3 = " <<  w3 << endln; 
-
+  // quick return if neither the chord nor the loads changed since the
+  // last converged state determination
+  if (chord_current && lx0 == lx0_c && ly0 == ly0_c && lz0 == lz0_c
+      && w1 == w1_c && w2 == w2_c && w3 == w3_c)
+    return 0;
 
   compute_lambda0();
 
@@ -446,140 +449,159 @@ CatenaryCable::update(void)
   double f10n = cos(theta)*f10 - sin(theta)*f20;
   double f20n = sin(theta)*f10 + cos(theta)*f20;
   double f30n = f30;
-  
-  f1 = f10n;
-  f2 = f20n;
-  f3 = f30n;
-
-  // opserr <<"   lambda0 = " <<  lambda0 << endln; 
-  // opserr <<"   f10n = " <<  f10n << endln; 
-  // opserr <<"   f20n = " <<  f20n << endln; 
-  // opserr <<"   f30n = " <<  f30n << endln; 
-
-
-  compute_projected_lengths();
 
-
-  // opserr <<"   f1 = " <<  f1 << endln; 
-  // opserr <<"   f2 = " <<  f2 << endln; 
-  // opserr <<"   f3 = " <<  f3 << endln; 
-
-  // opserr <<"   l1 = " <<  l1 << endln; 
-  // opserr <<"   l2 = " <<  l2 << endln; 
-  // opserr <<"   l3 = " <<  l3 << endln; 
+  // The iterations are first warm started from the last converged forces,
+  // which are normally much closer to the solution than the catenary
+  // estimate above. If that fails, the cold start is tried.
+  int first_attempt = have_converged_forces ? 0 : 1;
+  have_converged_forces = false;
+  chord_current = false;
 
   //Misclosure vector   dl = sp.matrix([[lx0-lxi],[ly0-lyi],[lz0-lzi]], dtype = sp.double())
   static Vector dl(3);
-  dl.Zero();
-
-  dl(0) = lx0 - l1;
-  dl(1) = ly0 - l2;
-  dl(2) = lz0 - l3;
-  
-  // const double error_tol = 1e-6;
-
   static Vector Fi0(3);
-  Fi0(0) = f1;
-  Fi0(1) = f2;
-  Fi0(2) = f3;
+  static Vector dF(3);
 
-  double dl_max = dl.pNorm(-1);   // Computes the infinity norm
-  double relative_error = fabs(dl_max)/L0;
+  double relative_error = 0;
   double max_relative_error = 0;
   int iter_max = 0;
   double min_relative_error = 1/error_tol;
   int iter_min = 0;
-  // opserr << " update: relative_error = " << relative_error << endln;
-
   int iter = 0;
-  while( relative_error > error_tol)
+
+  for (int attempt = first_attempt; attempt < 2; attempt++)
   {
-    if(relative_error < min_relative_error)
-    {
-      min_relative_error = relative_error;
-      iter_min = iter;
+    if (attempt == 0) {
+      Fi0(0) = f1;
+      Fi0(1) = f2;
+      Fi0(2) = f3;
+    } else {
+      Fi0(0) = f10n;
+      Fi0(1) = f20n;
+      Fi0(2) = f30n;
     }
-    if(relative_error > max_relative_error)
-    {
-      max_relative_error = relative_error;
-      iter_max = iter;
-    }
-    // opserr << " update: relative_error = " << relative_error << endln;
     f1 = Fi0(0);
     f2 = Fi0(1);
     f3 = Fi0(2);
-    // f4 = -f1 - w1*L0;
-    // f5 = -f2 - w2*L0;
-    // f6 = -f3 - w3*L0;
 
-    compute_projected_lengths();
+    // lengths and flexibility share all their intermediate terms, so both
+    // are evaluated together at each iterate
+    compute_lengths_and_flexibility();
 
-    //Update misclosure
     dl(0) = lx0 - l1;
     dl(1) = ly0 - l2;
     dl(2) = lz0 - l3;
 
-    // const int Nsubstep = 1;
-    for(int substep = 0; substep < Nsubsteps; substep++)
+    double dl_max = dl.pNorm(-1);   // Computes the infinity norm
+    relative_error = fabs(dl_max)/L0;
+    max_relative_error = 0;
+    iter_max = 0;
+    min_relative_error = 1/error_tol;
+    iter_min = 0;
+
+    iter = 0;
+    bool converged = true;
+    while( relative_error > error_tol)
     {
-        f1 = Fi0(0);
-        f2 = Fi0(1);
-        f3 = Fi0(2);
-        // f4 = -f1
-        // f5 = -f2
-        // f6 = -f3 - w3*L0
-
-        compute_flexibility_matrix();
-    
-        // static Matrix K(3,3);
-        static Vector dF(3);
-        
-        Flexibility.Solve(dl, dF);
-    
-        dF  = dF / Nsubsteps;
-          
-        Fi0 = Fi0 + dF;
-    }
+      if(relative_error < min_relative_error)
+      {
+        min_relative_error = relative_error;
+        iter_min = iter;
+      }
+      if(relative_error > max_relative_error)
+      {
+        max_relative_error = relative_error;
+        iter_max = iter;
+      }
 
-    dl_max = dl.pNorm(-1);   // Computes the infinity norm
-    relative_error = fabs(dl_max)/L0;
+      for(int substep = 0; substep < Nsubsteps; substep++)
+      {
+          // the first substep uses the flexibility evaluated with the misclosure
+          if (substep > 0)
+          {
+            f1 = Fi0(0);
+            f2 = Fi0(1);
+            f3 = Fi0(2);
+            compute_flexibility_matrix();
+          }
+
+          Flexibility.Solve(dl, dF);
+
+          dF  = dF / Nsubsteps;
+
+          Fi0 = Fi0 + dF;
+      }
+
+      f1 = Fi0(0);
+      f2 = Fi0(1);
+      f3 = Fi0(2);
+
+      compute_lengths_and_flexibility();
 
-    iter+= 1;
+      //Update misclosure
+      dl(0) = lx0 - l1;
+      dl(1) = ly0 - l2;
+      dl(2) = lz0 - l3;
 
-    if(iter > 100)
+      dl_max = dl.pNorm(-1);   // Computes the infinity norm
+      relative_error = fabs(dl_max)/L0;
+
+      iter+= 1;
+
+      if(iter > 100)
+      {
+        converged = false;
+        break;
+      }
+    }
+
+    if (converged)
     {
-      opserr << "CatenaryCable::update() - Failed to converge.\n";
-      opserr << "   tag = " << this->getTag() << endln;
-      opserr << "   L0 = " << L0 << endln;
-      opserr << "   relative_error = " << relative_error << endln;
-      opserr << "   iteratations = " << iter << endln;
-      opserr << "   min_relative_error = " << min_relative_error << " at iter = " << iter_min << endln;
-      opserr << "   max_relative_error = " << max_relative_error << " at iter = " << iter_max << endln;
-      opserr << "   Nsubsteps = " << Nsubsteps << endln;
-      opserr << "   end1Crd = " << end1Crd << endln;
-      opserr << "   end1Disp = " << end1Disp << endln;
-      opserr << "   end2Crd = " << end2Crd << endln;
-      opserr << "   end2Disp = " << end2Disp << endln;
-      opserr << "    w1 = " <<  w1 << endln; 
-      opserr << "    w2 = " <<  w2 << endln; 
-      opserr << "    w3 = " <<  w3 << endln; 
-      opserr << "    lambda0 = " <<  lambda0 << endln; 
-      opserr << "    f10n = " <<  f10n << endln; 
-      opserr << "    f20n = " <<  f20n << endln; 
-      opserr << "    f30n = " <<  f30n << endln; 
-      opserr << "    f1 = " <<  f1 << endln; 
-      opserr << "    f2 = " <<  f2 << endln; 
-      opserr << "    f3 = " <<  f3 << endln; 
-      opserr << "    l1 = " <<  l1 << endln; 
-      opserr << "    l2 = " <<  l2 << endln; 
-      opserr << "    l3 = " <<  l3 << endln; 
-      return -1;
+      // keep the flexibility at the converged forces for getTangentStiff()
+      for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+          flex_trial[i][j] = Flexibility(i,j);
+
+      lx0_c = lx0;
+      ly0_c = ly0;
+      lz0_c = lz0;
+      w1_c = w1;
+      w2_c = w2;
+      w3_c = w3;
+      have_converged_forces = true;
+      chord_current = true;
+
+      // opserr << "niter = " << iter << endln;
+      return 0;
     }
   }
 
-  // opserr << "niter = " << iter << endln;
-
-  return 0;
+  opserr << "CatenaryCable::update() - Failed to converge.\n";
+  opserr << "   tag = " << this->getTag() << endln;
+  opserr << "   L0 = " << L0 << endln;
+  opserr << "   relative_error = " << relative_error << endln;
+  opserr << "   iteratations = " << iter << endln;
+  opserr << "   min_relative_error = " << min_relative_error << " at iter = " << iter_min << endln;
+  opserr << "   max_relative_error = " << max_relative_error << " at iter = " << iter_max << endln;
+  opserr << "   Nsubsteps = " << Nsubsteps << endln;
+  opserr << "   end1Crd = " << end1Crd << endln;
+  opserr << "   end1Disp = " << end1Disp << endln;
+  opserr << "   end2Crd = " << end2Crd << endln;
+  opserr << "   end2Disp = " << end2Disp << endln;
+  opserr << "    w1 = " <<  w1 << endln; 
+  opserr << "    w2 = " <<  w2 << endln; 
+  opserr << "    w3 = " <<  w3 << endln; 
+  opserr << "    lambda0 = " <<  lambda0 << endln; 
+  opserr << "    f10n = " <<  f10n << endln; 
+  opserr << "    f20n = " <<  f20n << endln; 
+  opserr << "    f30n = " <<  f30n << endln; 
+  opserr << "    f1 = " <<  f1 << endln; 
+  opserr << "    f2 = " <<  f2 << endln; 
+  opserr << "    f3 = " <<  f3 << endln; 
+  opserr << "    l1 = " <<  l1 << endln; 
+  opserr << "    l2 = " <<  l2 << endln; 
+  opserr << "    l3 = " <<  l3 << endln; 
+  return -1;
 }
 
 
@@ -589,8 +611,16 @@ CatenaryCable::getTangentStiff(void)
   static Matrix K(3,3);
   K.Zero();
   Stiffness.Zero();
-  
-  compute_flexibility_matrix();
+
+  // reuse the flexibility from the converged iteration in update()
+  if (chord_current)
+  {
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        Flexibility(i,j) = flex_trial[i][j];
+  }
+  else
+    compute_flexibility_matrix();
 
   Flexibility.Invert(K);
 
@@ -1248,6 +1278,58 @@ void CatenaryCable::compute_flexibility_matrix(void)
 }
 
 
+// Evaluates the projected lengths (residual) and the flexibility matrix
+// (its Jacobian) at the current forces in one pass, since both depend on
+// the same norms and logarithm.
+void CatenaryCable::compute_lengths_and_flexibility(void)
+{
+    FLOATTYPE w_1 = w1;
+    FLOATTYPE w_2 = w2;
+    FLOATTYPE w_3 = w3;
+
+    FLOATTYPE w = SQRT(w_1*w_1 + w_2*w_2 + w_3*w_3);
+    FLOATTYPE a1 = (f1*w_1) + (f2*w_2) + (f3*w_3);
+    FLOATTYPE t1 = SQRT((f1*f1 ) + (f2*f2) + (f3*f3));
+    FLOATTYPE a = (-(w_1*L0) - f1);
+    FLOATTYPE b = (-(w_2*L0) - f2);
+    FLOATTYPE c = (-(w_3*L0) - f3);
+    FLOATTYPE t2 = SQRT(a*a + b*b + c*c);
+
+    FLOATTYPE lg = LOG(((a1/w)+t1)/((L0*w)+(a1/w)+t2));
+    FLOATTYPE cw = (1.+alpha*temperature_change)/(w*w*w);
+
+    FLOATTYPE W[3] = {w_1, w_2, w_3};
+    FLOATTYPE F[6] = {f1, f2, f3, a, b, c};
+
+    l1 = (-(L0*f1)/(E*A))-(((L0*L0)*w_1)/(2.*E*A))+cw*((w*w_1*(t1-t2))+(((w*w)*f1)-(a1*w_1))*lg);
+    l2 = (-(L0*f2)/(E*A))-(((L0*L0)*w_2)/(2.*E*A))+cw*((w*w_2*(t1-t2))+(((w*w)*f2)-(a1*w_2))*lg);
+    l3 = (-(L0*f3)/(E*A))-(((L0*L0)*w_3)/(2.*E*A))+cw*((w*w_3*(t1-t2))+(((w*w)*f3)-(a1*w_3))*lg);
+
+    // terms of the flexibility that only depend on the column
+    FLOATTYPE d2 = t2 * (L0*w*w + a1 + w*t2);
+    FLOATTYPE d1 = t1 * (a1 + w*t1);
+    FLOATTYPE g[3];
+    FLOATTYPE h[3];
+    for(int j = 0; j < 3; j++)
+    {
+      g[j] = F[j+3]/t2 + F[j]/t1;
+      h[j] = (w*F[j] + W[j]*(L0*w + t2)) / d2 - (w*F[j] + W[j]*t1) / d1;
+    }
+
+    for(int i = 0; i < 3; i++)
+    {
+      FLOATTYPE ci = w*w * F[i] - a1 * W[i];
+      for(int j = 0; j < 3; j++)
+      {
+        FLOATTYPE b1 = -w * W[i] * g[j] + ci * h[j];
+        FLOATTYPE b0 = (i == j) ? -L0 / (E*A) : 0.;
+        FLOATTYPE b2 = (i == j) ? W[i]*W[i] - w*w : W[i]*W[j];
+        Flexibility(i, j) = b0 - cw*(b1 + b2*lg);
+      }
+    }
+}
+
+
 void CatenaryCable::computeMass()
 {
   switch (massType)
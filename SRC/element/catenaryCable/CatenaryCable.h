@@ -117,6 +117,7 @@ class CatenaryCable : public Element
     void compute_lambda0(void) ;
     void compute_projected_lengths(void) ;
     void compute_flexibility_matrix(void) ;
+    void compute_lengths_and_flexibility(void) ;
     void computeMass();
     void computeMassLumped();
     void computeMassByIntegration();
@@ -145,6 +146,15 @@ class CatenaryCable : public Element
     double f1, f2, f3;
     double l1, l2, l3;
 
+    // last converged state, used to warm start the force iterations
+    double f1_n, f2_n, f3_n;        // committed end forces
+    double lx0_c, ly0_c, lz0_c;     // chord of the last converged trial state
+    double w1_c, w2_c, w3_c;        // loads of the last converged trial state
+    bool have_converged_forces;     // f1..f3 are a usable starting point
+    bool commit_converged;
+    bool chord_current;             // f1..f3 and flex_trial match lx0_c..w3_c
+    double flex_trial[3][3];        // flexibility at the converged trial forces
+
     double lambda0;
     double l[3];            //Projected lengths
 
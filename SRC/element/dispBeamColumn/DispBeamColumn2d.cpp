@@ -28,6 +28,7 @@
 // Description: This file contains the class definition for DispBeamColumn2d.
 
 #include <DispBeamColumn2d.h>
+#include <MemoryReport.h>
 #include <Node.h>
 #include <SectionForceDeformation.h>
 #include <CrdTransf.h>
@@ -1438,6 +1439,20 @@ opserr << "DispBeamColumn2d::recvSelf() - out of memory creating sections array
   return 0;
 }
 
+size_t
+DispBeamColumn2d::getMaterialMemoryUsage(void)
+{
+  if (theSections == 0)
+    return 0;
+
+  size_t result = 0;
+  for (int i = 0; i < numSections; i++)
+    if (theSections[i] != 0)
+      result += theSections[i]->getMemoryUsage();
+
+  return result;
+}
+
 void
 DispBeamColumn2d::Print(OPS_Stream &s, int flag)
 {
@@ -94,6 +94,10 @@ class DispBeamColumn2d : public Element
 		  &theBroker);
     int displaySelf(Renderer &theViewer, int displayMode, float fact, const char **displayModes=0, int numModes=0);
     void Print(OPS_Stream &s, int flag =0);
+    size_t getMaterialMemoryUsage(void);
+    int getNumSections(void) {return numSections;}
+    SectionForceDeformation *getSection(int i)
+      {return (i >= 0 && i < numSections) ? theSections[i] : 0;}
 
     Response *setResponse(const char **argv, int argc, OPS_Stream &s);
     int getResponse(int responseID, Information &eleInfo);
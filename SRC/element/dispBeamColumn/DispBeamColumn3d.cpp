@@ -28,6 +28,7 @@
 // Description: This file contains the class definition for DispBeamColumn3d.
 
 #include <DispBeamColumn3d.h>
+#include <MemoryReport.h>
 #include <Node.h>
 #include <SectionForceDeformation.h>
 #include <CrdTransf.h>
@@ -571,8 +572,7 @@ DispBeamColumn3d::update(void)
   double oneOverL = 1.0/L;
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -630,10 +630,8 @@ DispBeamColumn3d::getTangentStiff()
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
+  const double *wt = beamInt->getCachedWeights(numSections, L);
 
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -759,10 +757,8 @@ DispBeamColumn3d::getBasicStiff(Matrix &kb, int initial)
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
+  const double *wt = beamInt->getCachedWeights(numSections, L);
   
   // Loop over the integration points
   for (int i = 0; i < numSections; i++) {
@@ -1055,10 +1051,8 @@ DispBeamColumn3d::getResistingForce()
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
+  const double *wt = beamInt->getCachedWeights(numSections, L);
 
   // Zero for integration
   q.Zero();
@@ -1501,6 +1495,20 @@ DispBeamColumn3d::recvSelf(int commitTag, Channel &theChannel,
   return 0;
 }
 
+size_t
+DispBeamColumn3d::getMaterialMemoryUsage(void)
+{
+  if (theSections == 0)
+    return 0;
+
+  size_t result = 0;
+  for (int i = 0; i < numSections; i++)
+    if (theSections[i] != 0)
+      result += theSections[i]->getMemoryUsage();
+
+  return result;
+}
+
 void
 DispBeamColumn3d::Print(OPS_Stream &s, int flag)
 {
@@ -1921,8 +1929,7 @@ DispBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 10) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamInt->getSectionLocations(numSections, L, pts);
+    const double *pts = beamInt->getCachedLocations(numSections, L);
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -1931,8 +1938,7 @@ DispBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 11) {
     double L = crdTransf->getInitialLength();
-    double wts[maxNumSections];
-    beamInt->getSectionWeights(numSections, L, wts);
+    const double *wts = beamInt->getCachedWeights(numSections, L);
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wts[i]*L;
@@ -2139,10 +2145,8 @@ DispBeamColumn3d::getResistingForceSensitivity(int gradNumber)
   
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
   //const Vector &wts = quadRule.getIntegrPointWeights(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
-  double wt[maxNumSections];
-  beamInt->getSectionWeights(numSections, L, wt);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
+  const double *wt = beamInt->getCachedWeights(numSections, L);
 
   // Zero for integration
   static Vector dqdh(6);
@@ -2327,8 +2331,7 @@ DispBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
-  double xi[maxNumSections];
-  beamInt->getSectionLocations(numSections, L, xi);
+  const double *xi = beamInt->getCachedLocations(numSections, L);
 
   // Some extra declarations
   double d1oLdh = crdTransf->getd1overLdh();
@@ -55,9 +55,9 @@
 
 #include <map>
 
-Matrix ElasticBeam2d::K(6,6);
-Vector ElasticBeam2d::P(6);
-Matrix ElasticBeam2d::kb(3,3);
+thread_local Matrix ElasticBeam2d::K(6,6);
+thread_local Vector ElasticBeam2d::P(6);
+thread_local Matrix ElasticBeam2d::kb(3,3);
 
 void *OPS_ElasticBeam2d(const ID &info) {
     /*!
@@ -664,6 +664,31 @@ ElasticBeam2d::update(void)
   return theCoordTransf->update();
 }
 
+bool
+ElasticBeam2d::isThreadSafe(void)
+{
+  // the work areas of this class and of the transformation must be
+  // thread local; the Rayleigh/Damping paths go through shared storage
+  // in Element and Damping and so are excluded
+  if (theCoordTransf == 0 || theCoordTransf->isThreadSafe() == false)
+    return false;
+
+  if (theDamping != 0 ||
+      alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+    return false;
+
+  return true;
+}
+
+bool
+ElasticBeam2d::hasConstantTangent(void)
+{
+  // only the linear transformation gives a stiffness independent of the
+  // displacements
+  return (theCoordTransf != 0 &&
+	  theCoordTransf->getClassTag() == CRDTR_TAG_LinearCrdTransf2d);
+}
+
 const Matrix &
 ElasticBeam2d::getTangentStiff(void)
 {
@@ -753,7 +778,7 @@ ElasticBeam2d::getMass(void)
             K(0,0) = K(1,1) = K(3,3) = K(4,4) = m;
         } else  {
             // consistent mass matrix
-            static Matrix ml(6,6);
+            static thread_local Matrix ml(6,6);
             double m = rho*L/420.0;
             ml(0,0) = ml(3,3) = m*140.0;
             ml(0,3) = ml(3,0) = m*70.0;
@@ -982,7 +1007,7 @@ ElasticBeam2d::addInertiaLoadToUnbalance(const Vector &accel)
     Q(4) -= m * Raccel2(1);
   } else  {
     // use matrix vector multip. for consistent mass matrix
-    static Vector Raccel(6);
+    static thread_local Vector Raccel(6);
     for (int i=0; i<3; i++)  {
       Raccel(i)   = Raccel1(i);
       Raccel(i+3) = Raccel2(i);
@@ -1026,7 +1051,7 @@ ElasticBeam2d::getResistingForceIncInertia()
     P(4) += m * accel2(1);
   } else  {
     // use matrix vector multip. for consistent mass matrix
-    static Vector accel(6);
+    static thread_local Vector accel(6);
     for (int i=0; i<3; i++)  {
       accel(i)   = accel1(i);
       accel(i+3) = accel2(i);
@@ -1099,7 +1124,7 @@ ElasticBeam2d::sendSelf(int cTag, Channel &theChannel)
 {
   int res = 0;
 
-    static Vector data(19);
+    static thread_local Vector data(19);
     
     data(0) = A;
     data(1) = E; 
@@ -1173,7 +1198,7 @@ ElasticBeam2d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBrok
 {
     int res = 0;
 	
-    static Vector data(19);
+    static thread_local Vector data(19);
 
     res += theChannel.recvVector(this->getDbTag(), cTag, data);
     if (res < 0) {
@@ -1316,9 +1341,9 @@ ElasticBeam2d::Print(OPS_Stream &s, int flag)
 int
 ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, const char **modes, int numMode)
 {
-  static Vector v1(3);
-  static Vector v2(3);
-  static Vector vp(3);
+  static thread_local Vector v1(3);
+  static thread_local Vector v2(3);
+  static thread_local Vector vp(3);
 
   theNodes[0]->getDisplayCrds(v1, fact, displayMode);
   theNodes[1]->getDisplayCrds(v2, fact, displayMode);
@@ -1351,7 +1376,7 @@ ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, con
 
       d1 = q(1);
       d2 = q(2);
-      static Vector delta(3); delta = v2-v1; delta/=20.;
+      static thread_local Vector delta(3); delta = v2-v1; delta/=20.;
       res += theViewer.drawPoint(v1+delta, d1, this->getTag(), i);
       res += theViewer.drawPoint(v2-delta, d2, this->getTag(), i);
 
@@ -1359,7 +1384,7 @@ ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, con
       d1 = q(0);
       d2 = q(1);
       d3 = q(2);
-      static Vector delta(3); delta = v2-v1; delta/=20;
+      static thread_local Vector delta(3); delta = v2-v1; delta/=20;
       res += theViewer.drawPoint(v1+delta, d2, this->getTag(), i);
       res += theViewer.drawPoint(v2-delta, d3, this->getTag(), i);
       res +=theViewer.drawLine(v1, v2, d1, d1, this->getTag(), i);
@@ -1372,7 +1397,7 @@ ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, con
 
       d1 = vp(1);
       d2 = vp(2);
-      static Vector delta(3); delta = v2-v1; delta/=20.;
+      static thread_local Vector delta(3); delta = v2-v1; delta/=20.;
       res += theViewer.drawPoint(v1+delta, d1, this->getTag(), i);
       res += theViewer.drawPoint(v2-delta, d2, this->getTag(), i);
 
@@ -1380,7 +1405,7 @@ ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, con
       d1 = vp(0);
       d2 = vp(1);
       d3 = vp(2);
-      static Vector delta(3); delta = v2-v1; delta/=20;
+      static thread_local Vector delta(3); delta = v2-v1; delta/=20;
       res += theViewer.drawPoint(v1+delta, d2, this->getTag(), i);
       res += theViewer.drawPoint(v2-delta, d3, this->getTag(), i);
       res +=theViewer.drawLine(v1, v2, d1, d1, this->getTag(), i);
@@ -1389,7 +1414,7 @@ ElasticBeam2d::displaySelf(Renderer &theViewer, int displayMode, float fact, con
       d1 = 0.;
       d2 = 0.;
       d3 = 0.;
-      static Vector delta(3); delta = v2-v1; delta/=20;
+      static thread_local Vector delta(3); delta = v2-v1; delta/=20;
       res += theViewer.drawPoint(v1+delta, d2, this->getTag(), i);
       res += theViewer.drawPoint(v2-delta, d3, this->getTag(), i);
       res +=theViewer.drawLine(v1, v2, d1, d1, this->getTag(), i);
@@ -1533,8 +1558,8 @@ ElasticBeam2d::getResponse (int responseID, Information &eleInfo)
 {
   double N, M1, M2, V;
   double L = theCoordTransf->getInitialLength();
-  static Vector Sd(3);
-  static Matrix kb(3,3);
+  static thread_local Vector Sd(3);
+  static thread_local Matrix kb(3,3);
   
   this->getResistingForce();
 
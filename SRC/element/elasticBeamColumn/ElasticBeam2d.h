@@ -77,6 +77,8 @@ class ElasticBeam2d : public Element
     int revertToStart(void);
     
     int update(void);
+    bool isThreadSafe(void);
+    bool hasConstantTangent(void);
     const Matrix &getTangentStiff(void);
     const Matrix &getInitialStiff(void);
     const Matrix &getMass(void);    
@@ -109,11 +111,11 @@ class ElasticBeam2d : public Element
 
     int release;      // moment release 0=none, 1=I, 2=J, 3=I,J
     
-    static Matrix K;
-    static Vector P;
+    static thread_local Matrix K;
+    static thread_local Vector P;
     Vector Q;
     
-    static Matrix kb;
+    static thread_local Matrix kb;
     Vector q;
     double q0[3];  // Fixed end forces in basic system
     double p0[3];  // Reactions in basic system
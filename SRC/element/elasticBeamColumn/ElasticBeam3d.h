@@ -78,6 +78,8 @@ class ElasticBeam3d : public Element
     int revertToStart(void);
     
     int update(void);
+    bool isThreadSafe(void);
+    bool hasConstantTangent(void);
     const Matrix &getTangentStiff(void);
     const Matrix &getInitialStiff(void);
     const Matrix &getMass(void);    
@@ -111,11 +113,11 @@ class ElasticBeam3d : public Element
     int releasez; // moment release for bending about z-axis 0=none, 1=I, 2=J, 3=I,J
     int releasey; // same for y-axis
     
-    static Matrix K;
-    static Vector P;
+    static thread_local Matrix K;
+    static thread_local Vector P;
     Vector Q;
     
-    static Matrix kb;
+    static thread_local Matrix kb;
     Vector q;
     double q0[5];  // Fixed end forces in basic system (no torsion)
     double p0[5];  // Reactions in basic system (no torsion)
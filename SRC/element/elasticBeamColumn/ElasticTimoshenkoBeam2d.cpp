@@ -465,6 +465,13 @@ int ElasticTimoshenkoBeam2d::update()
 }
 
 
+bool ElasticTimoshenkoBeam2d::hasConstantTangent()
+{
+    // without the geometric nonlinearity the stiffness is Tgl^T kl Tgl
+    return (nlGeo == 0);
+}
+
+
 const Matrix& ElasticTimoshenkoBeam2d::getTangentStiff()
 {
     // zero the matrix
@@ -475,6 +475,13 @@ int ElasticTimoshenkoBeam3d::update()
 }
 
 
+bool ElasticTimoshenkoBeam3d::hasConstantTangent()
+{
+    // without the geometric nonlinearity the stiffness is Tgl^T kl Tgl
+    return (nlGeo == 0);
+}
+
+
 const Matrix& ElasticTimoshenkoBeam3d::getTangentStiff()
 {
     // zero the matrix
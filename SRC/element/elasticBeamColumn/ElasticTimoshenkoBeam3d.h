@@ -71,6 +71,7 @@ public:
     int update();
     
     // public methods to obtain stiffness, mass, damping and residual information
+    bool hasConstantTangent(void);
     const Matrix &getTangentStiff();
     const Matrix &getInitialStiff();
     const Matrix &getMass();
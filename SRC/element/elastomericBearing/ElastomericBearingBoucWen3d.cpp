@@ -496,8 +496,9 @@ int ElastomericBearingBoucWen3d::update()
     
     // 2) calculate shear forces and stiffnesses in basic y- and z-direction
     // get displacement increments (trial - committed)
-    Vector delta_ub = ub - ubC;
-    if (sqrt(pow(delta_ub(1),2)+pow(delta_ub(2),2)) > DBL_EPSILON)  {
+    double dub1 = ub(1) - ubC(1);
+    double dub2 = ub(2) - ubC(2);
+    if (sqrt(pow(dub1,2)+pow(dub2,2)) > DBL_EPSILON)  {
     
         // get yield displacement
         double uy = qYield/k0;
@@ -505,32 +506,32 @@ int ElastomericBearingBoucWen3d::update()
         // calculate hysteretic evolution parameter z using Newton-Raphson
         int iter = 0;
         double zNrm, tmp1, tmp2, tmp3, tmp4, tmp5, du1du2, du2du1;
-        Vector f(2), delta_z(2);
-        Matrix Df(2,2);
+        // the 2x2 system is solved in closed form, without temporaries
+        double f0, f1, Df00, Df01, Df10, Df11, dz0, dz1, dzNrm;
         do  {
             zNrm = z.Norm();
             if (zNrm == 0.0)  // check because of negative exponents
                 zNrm = DBL_EPSILON;
-            tmp1 = z(0)*delta_ub(1) + z(1)*delta_ub(2);
+            tmp1 = z(0)*dub1 + z(1)*dub2;
             tmp2 = gamma + beta*sgn(tmp1);
             tmp3 = pow(zNrm,eta-2.0)*tmp1*tmp2;
             tmp4 = pow(zNrm,eta-4.0)*tmp2;
             
             // function and derivative
-            f(0) = z(0) - zC(0) - 1.0/uy*(A*delta_ub(1) - z(0)*tmp3);
-            f(1) = z(1) - zC(1) - 1.0/uy*(A*delta_ub(2) - z(1)*tmp3);
+            f0 = z(0) - zC(0) - 1.0/uy*(A*dub1 - z(0)*tmp3);
+            f1 = z(1) - zC(1) - 1.0/uy*(A*dub2 - z(1)*tmp3);
             
-            Df(0,0) = 1.0 + tmp4/uy*(pow(z(1),3)*delta_ub(2) + 2.0*pow(z(1),2)*z(0)*delta_ub(1)
-                + z(1)*pow(z(0),2)*delta_ub(2)*(eta-1.0) + pow(z(0),3)*delta_ub(1)*eta);
-            Df(1,0) = z(1)*tmp4/uy*(pow(z(1),2)*delta_ub(1) + z(0)*z(1)*delta_ub(2)*(eta-2.0)
-                + pow(z(0),2)*delta_ub(1)*(eta-1.0));
-            Df(0,1) = z(0)*tmp4/uy*(pow(z(0),2)*delta_ub(2) + z(0)*z(1)*delta_ub(1)*(eta-2.0)
-                + pow(z(1),2)*delta_ub(2)*(eta-1.0));
-            Df(1,1) = 1.0 + tmp4/uy*(pow(z(0),3)*delta_ub(1) + 2.0*pow(z(0),2)*z(1)*delta_ub(2)
-                + z(0)*pow(z(1),2)*delta_ub(1)*(eta-1.0) + pow(z(1),3)*delta_ub(2)*eta);
+            Df00 = 1.0 + tmp4/uy*(pow(z(1),3)*dub2 + 2.0*pow(z(1),2)*z(0)*dub1
+                + z(1)*pow(z(0),2)*dub2*(eta-1.0) + pow(z(0),3)*dub1*eta);
+            Df10 = z(1)*tmp4/uy*(pow(z(1),2)*dub1 + z(0)*z(1)*dub2*(eta-2.0)
+                + pow(z(0),2)*dub1*(eta-1.0));
+            Df01 = z(0)*tmp4/uy*(pow(z(0),2)*dub2 + z(0)*z(1)*dub1*(eta-2.0)
+                + pow(z(1),2)*dub2*(eta-1.0));
+            Df11 = 1.0 + tmp4/uy*(pow(z(0),3)*dub1 + 2.0*pow(z(0),2)*z(1)*dub2
+                + z(0)*pow(z(1),2)*dub1*(eta-1.0) + pow(z(1),3)*dub2*eta);
             
             // issue warning if diagonal of derivative Df is zero
-            if ((fabs(Df(0,0)) <= DBL_EPSILON) || (fabs(Df(1,1)) <= DBL_EPSILON))  {
+            if ((fabs(Df00) <= DBL_EPSILON) || (fabs(Df11) <= DBL_EPSILON))  {
                 opserr << "WARNING: ElastomericBearingBoucWen3d::update() - "
                     << "zero Jacobian in Newton-Raphson scheme for hysteretic "
                     << "evolution parameter z.\n";
@@ -538,24 +539,28 @@ int ElastomericBearingBoucWen3d::update()
             }
             
             // advance one step
-            delta_z = f/Df;
-            z -= delta_z;
+            double det = Df00*Df11 - Df01*Df10;
+            dz0 = (Df11*f0 - Df01*f1)/det;
+            dz1 = (Df00*f1 - Df10*f0)/det;
+            z(0) -= dz0;
+            z(1) -= dz1;
+            dzNrm = sqrt(dz0*dz0 + dz1*dz1);
             iter++;
-        } while ((delta_z.Norm() >= tol) && (iter < maxIter));
+        } while ((dzNrm >= tol) && (iter < maxIter));
         
         // issue warning if Newton-Raphson scheme did not converge
         if (iter >= maxIter)   {
             opserr << "WARNING: ElastomericBearingBoucWen3d::update() - "
                 << "did not find the hysteretic evolution parameters z after "
-                << iter << " iterations and norm: " << delta_z.Norm() << endln;
+                << iter << " iterations and norm: " << dzNrm << endln;
             return -2;
         }
         
         // get derivatives of hysteretic evolution parameters * uy
         tmp5 = pow(zNrm,eta-2.0)*tmp2;
-        du1du2 = delta_ub(1)/delta_ub(2);
-        du2du1 = delta_ub(2)/delta_ub(1);
-        if (delta_ub(1)*delta_ub(2) == 0)  {
+        du1du2 = dub1/dub2;
+        du2du1 = dub2/dub1;
+        if (dub1*dub2 == 0)  {
             du1du2 = 0.0;
             du2du1 = 0.0;
         }
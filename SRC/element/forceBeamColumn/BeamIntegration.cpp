@@ -24,10 +24,13 @@
 
 #include <BeamIntegration.h>
 #include <Matrix.h>
+#include <Domain.h>
+#include <elementAPI.h>
 
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theBeamIntegrationRuleObjects;
+static bool theBeamIntegrationRuleObjectsRegistered = MapOfTaggedObjects::addModelStorage(theBeamIntegrationRuleObjects);
 
 bool OPS_addBeamIntegrationRule(BeamIntegrationRule *newComponent) {
   return theBeamIntegrationRuleObjects.addComponent(newComponent);
@@ -50,7 +53,7 @@ void OPS_clearAllBeamIntegrationRule(void) {
 }
 
 BeamIntegration::BeamIntegration(int classTag):
-  MovableObject(classTag)
+  MovableObject(classTag), cacheNIP(0), cacheL(0.0), cacheStamp(-1)
 {
   // Nothing to do
 }
@@ -60,6 +63,39 @@ BeamIntegration::~BeamIntegration()
   // Nothing to do
 }
 
+void
+BeamIntegration::formCache(int nIP, double L)
+{
+  Domain *theDomain = OPS_GetDomain();
+  int stamp = theDomain != 0 ? theDomain->getParameterStamp() : 0;
+
+  if (nIP == cacheNIP && L == cacheL && stamp == cacheStamp)
+    return;
+
+  cacheXi.resize(nIP > 0 ? nIP : 1);
+  cacheWt.resize(nIP > 0 ? nIP : 1);
+  this->getSectionLocations(nIP, L, &cacheXi[0]);
+  this->getSectionWeights(nIP, L, &cacheWt[0]);
+
+  cacheNIP = nIP;
+  cacheL = L;
+  cacheStamp = stamp;
+}
+
+const double *
+BeamIntegration::getCachedLocations(int nIP, double L)
+{
+  this->formCache(nIP, L);
+  return &cacheXi[0];
+}
+
+const double *
+BeamIntegration::getCachedWeights(int nIP, double L)
+{
+  this->formCache(nIP, L);
+  return &cacheWt[0];
+}
+
 void
 BeamIntegration::getLocationsDeriv(int nIP, double L, double dLdh,
 				   double *dptsdh)
@@ -29,6 +29,7 @@
 #include <MovableObject.h>
 #include <TaggedObject.h>
 #include <ID.h>
+#include <vector>
 
 class Matrix;
 class ElementalLoad;
@@ -43,6 +44,11 @@ class BeamIntegration : public MovableObject
   virtual void getSectionLocations(int nIP, double L, double *xi) = 0;
   virtual void getSectionWeights(int nIP, double L, double *wt) = 0;
 
+  // the locations and weights of the last call with the same nIP and L,
+  // formed again when a parameter of the domain has been updated since
+  const double *getCachedLocations(int nIP, double L);
+  const double *getCachedWeights(int nIP, double L);
+
   /*
   virtual void addElasticDeformations(ElementalLoad *theLoad,
 				      double loadFactor,
@@ -69,6 +75,14 @@ class BeamIntegration : public MovableObject
   */
 
   virtual void Print(OPS_Stream &s, int flag = 0) = 0;
+
+ private:
+  void formCache(int nIP, double L);
+
+  int cacheNIP;
+  double cacheL;
+  int cacheStamp;
+  std::vector<double> cacheXi, cacheWt;
 };
 
 // a BeamIntegrationRule store BeamIntegration and section tags
@@ -121,6 +121,10 @@ class ForceBeamColumn2d: public Element
   
   friend OPS_Stream &operator<<(OPS_Stream &s, ForceBeamColumn2d &E);        
   void Print(OPS_Stream &s, int flag =0);    
+  size_t getMaterialMemoryUsage(void);
+  int getNumSections(void) {return numSections;}
+  SectionForceDeformation *getSection(int i)
+    {return (i >= 0 && i < numSections) ? sections[i] : 0;}
   
   Response *setResponse(const char **argv, int argc, OPS_Stream &s);
   int getResponse(int responseID, Information &eleInformation);
@@ -197,9 +201,9 @@ class ForceBeamColumn2d: public Element
 
   Matrix *Ki;
   
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
+  static thread_local Matrix theMatrix;
+  static thread_local Vector theVector;
+  static thread_local double workArea[];
   
   enum {maxNumSections = 30};
   enum {maxSectionOrder = 5};
@@ -208,9 +212,9 @@ class ForceBeamColumn2d: public Element
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
   double subdivideFactor;
   
-  static Vector vsSubdivide[];
-  static Vector SsrSubdivide[];
-  static Matrix fsSubdivide[];
+  static thread_local Vector vsSubdivide[];
+  static thread_local Vector SsrSubdivide[];
+  static thread_local Matrix fsSubdivide[];
   //static int maxNumSections;
 
   // AddingSensitivity:BEGIN //////////////////////////////////////////
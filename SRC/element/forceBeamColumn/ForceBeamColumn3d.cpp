@@ -66,6 +66,7 @@ Journal of Structural Engineering, Approved for publication, February 2007.
 #include <Information.h>
 #include <Parameter.h>
 #include <ForceBeamColumn3d.h>
+#include <MemoryReport.h>
 #include <MatrixUtil.h>
 #include <Domain.h>
 #include <Channel.h>
@@ -81,16 +82,19 @@ using std::ifstream;
 #include <CompositeResponse.h>
 #include <ElementalLoad.h>
 #include <ElementIter.h>
+#include <LogCategory.h>
 
 #define DefaultLoverGJ 1.0e-10
 
-Matrix ForceBeamColumn3d::theMatrix(12,12);
-Vector ForceBeamColumn3d::theVector(12);
-double ForceBeamColumn3d::workArea[200];
+thread_local Matrix ForceBeamColumn3d::theMatrix(12,12);
+thread_local Vector ForceBeamColumn3d::theVector(12);
+thread_local double ForceBeamColumn3d::workArea[200];
 
-Vector ForceBeamColumn3d::vsSubdivide[maxNumSections];
-Matrix ForceBeamColumn3d::fsSubdivide[maxNumSections];
-Vector ForceBeamColumn3d::SsrSubdivide[maxNumSections];
+thread_local Vector ForceBeamColumn3d::vsSubdivide[maxNumSections];
+thread_local Matrix ForceBeamColumn3d::fsSubdivide[maxNumSections];
+thread_local Vector ForceBeamColumn3d::SsrSubdivide[maxNumSections];
+
+long ForceBeamColumn3d::iterHistogram[maxHistogramIters+1];
 
 void* OPS_ForceBeamColumn3d()
 {
@@ -119,10 +123,13 @@ void* OPS_ForceBeamColumn3d()
     // options
     double mass = 0.0, tol=1e-12, subFac=10.0;
     int maxIter = 10, numSub = 4;
+    bool nonIterative = false;
     numData = 1;
     while(OPS_GetNumRemainingInputArgs() > 0) {
 	const char* type = OPS_GetString();
-	if(strcmp(type,"-iter") == 0) {
+	if(strcmp(type,"-nonIterative") == 0) {
+	    nonIterative = true;
+	} else if(strcmp(type,"-iter") == 0) {
 	    if(OPS_GetNumRemainingInputArgs() > 1) {
 		if(OPS_GetIntInput(&numData,&maxIter) < 0) {
 		    opserr << "WARNING invalid maxIter\n";
@@ -197,7 +204,8 @@ void* OPS_ForceBeamColumn3d()
     }
 
     Element *theEle =  new ForceBeamColumn3d(iData[0],iData[1],iData[2],secTags.Size(),sections,
-					     *bi,*theTransf,mass,maxIter,tol,numSub,subFac,theDamping);
+					     *bi,*theTransf,mass,maxIter,tol,numSub,subFac,theDamping,
+					     nonIterative);
     delete [] sections;
     return theEle;
 }
@@ -207,6 +215,7 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
     int iData[5];
     double mass = 0.0, tol = 1e-12, subFac=10.0;
     int maxIter = 10, numSub = 4;
+    bool nonIterative = false;
     int numData;
     int dampingTag = 0;
     Damping* theDamping = 0;
@@ -248,7 +257,9 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
         numData = 1;
         while (OPS_GetNumRemainingInputArgs() > 0) {
             const char *type = OPS_GetString();
-            if (strcmp(type, "-iter") == 0) {
+            if (strcmp(type, "-nonIterative") == 0) {
+                nonIterative = true;
+            } else if (strcmp(type, "-iter") == 0) {
                 if (OPS_GetNumRemainingInputArgs() > 1) {
                     if (OPS_GetIntInput(&numData, &maxIter) < 0) {
                         opserr << "WARNING invalid maxIter\n";
@@ -304,7 +315,7 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
 
         // save the data for a mesh
         Vector &mdata = meshdata[info(1)];
-        mdata.resize(7);
+        mdata.resize(8);
         mdata(0) = iData[3];
         mdata(1) = iData[4];
         mdata(2) = mass;
@@ -312,6 +323,7 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
         mdata(4) = maxIter;
 	mdata(5) = numSub;
 	mdata(6) = subFac;	
+	mdata(7) = nonIterative ? 1.0 : 0.0;
         return &meshdata;
     }
 
@@ -337,6 +349,8 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
         maxIter = mdata(4);
 	numSub = mdata(5);
 	subFac = mdata(6);
+	if (mdata.Size() > 7)
+	    nonIterative = mdata(7) != 0.0;
     }
 
     // 5: create element
@@ -373,7 +387,8 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
 
     Element *theEle = new ForceBeamColumn3d(
         iData[0], iData[1], iData[2], secTags.Size(), sections, *bi,
-        *theTransf, mass, maxIter, tol, numSub, subFac,theDamping);
+        *theTransf, mass, maxIter, tol, numSub, subFac,theDamping,
+        nonIterative);
     delete[] sections;
     return theEle;
 }
@@ -383,14 +398,14 @@ void *OPS_ForceBeamColumn3d(const ID &info) {
 ForceBeamColumn3d::ForceBeamColumn3d(): 
   Element(0,ELE_TAG_ForceBeamColumn3d), connectedExternalNodes(2), 
   beamIntegr(0), numSections(0), sections(0), crdTransf(0),
-  rho(0.0), maxIters(0), tol(0.0),
+  rho(0.0), maxIters(0), tol(0.0), nonIterative(false), residualCarried(false),
   initialFlag(0),
   kv(NEBD,NEBD), Se(NEBD),
   kvcommit(NEBD,NEBD), Secommit(NEBD),
   fs(0), vs(0), Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(1), subdivideFactor(1.0), parameterID(0),
-  theDamping(0)
+  theDamping(0), lastIters(0), mostIters(0), totalIters(0), numUpdates(0)
 {
   load.Zero();
 
@@ -407,17 +422,18 @@ ForceBeamColumn3d::ForceBeamColumn3d (int tag, int nodeI, int nodeJ,
 				      CrdTransf &coordTransf, double massDensPerUnitLength,
 				      int maxNumIters, double tolerance,
 				      int maxNumSub, double subFac,
-				      Damping *damping):
+				      Damping *damping, bool nonIter):
   Element(tag,ELE_TAG_ForceBeamColumn3d), connectedExternalNodes(2),
   beamIntegr(0), numSections(0), sections(0), crdTransf(0),
   rho(massDensPerUnitLength),maxIters(maxNumIters), tol(tolerance), 
+  nonIterative(nonIter), residualCarried(false),
   initialFlag(0),
   kv(NEBD,NEBD), Se(NEBD), 
   kvcommit(NEBD,NEBD), Secommit(NEBD),
   fs(0), vs(0),Ssr(0), vscommit(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), load(12),
   Ki(0), isTorsion(false), maxSubdivisions(maxNumSub), subdivideFactor(subFac), parameterID(0),
-  theDamping(0)
+  theDamping(0), lastIters(0), mostIters(0), totalIters(0), numUpdates(0)
 {
   if (maxSubdivisions < 1)
     maxSubdivisions = 1;
@@ -718,6 +734,11 @@ int ForceBeamColumn3d::revertToStart()
   kv.Zero();
   
   initialFlag = 0;
+  residualCarried = false;
+  lastIters = 0;
+  mostIters = 0;
+  totalIters = 0;
+  numUpdates = 0;
   // this->update();
 
   if (theDamping && (err = theDamping->revertToStart()))
@@ -734,17 +755,17 @@ ForceBeamColumn3d::getInitialStiff(void)
   if (Ki != 0)
     return *Ki;
 
-  static Matrix f(NEBD,NEBD);   // element flexibility matrix  
+  static thread_local Matrix f(NEBD,NEBD);   // element flexibility matrix  
   this->getInitialFlexibility(f);
   
-  static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse  
+  static thread_local Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse  
   I.Zero();
   for (int i=0; i<NEBD; i++)
     I(i,i) = 1.0;
   
   // calculate element stiffness matrix
   // invert3by3Matrix(f, kv);
-  static Matrix kvInit(NEBD, NEBD);
+  static thread_local Matrix kvInit(NEBD, NEBD);
   if (f.Solve(I, kvInit) < 0)
     opserr << "ForceBeamColumn3d::getInitialStiff() -- could not invert flexibility for element with tag: " << this->getTag() << endln;
 
@@ -964,28 +985,27 @@ void
     // get basic displacements and increments
     const Vector &v = crdTransf->getBasicTrialDisp();    
 
-    static Vector dv(NEBD);
+    static thread_local Vector dv(NEBD);
     dv = crdTransf->getBasicIncrDeltaDisp();    
 
-    if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
+    if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0 &&
+	residualCarried == false)
       return 0;
 
-    static Vector vin(NEBD);
+    static thread_local Vector vin(NEBD);
     vin = v;
     vin -= dv;
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
 
-    double xi[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, xi);
+    const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
-    double wt[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wt);
+    const double *wt = beamIntegr->getCachedWeights(numSections, L);
 
-    static Vector vr(NEBD);       // element residual displacements
-    static Matrix f(NEBD,NEBD);   // element flexibility matrix
+    static thread_local Vector vr(NEBD);       // element residual displacements
+    static thread_local Matrix f(NEBD,NEBD);   // element flexibility matrix
 
-    static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
+    static thread_local Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
     double dW;                    // section strain energy (work) norm 
     int i, j;
 
@@ -995,11 +1015,11 @@ void
 
     int numSubdivide = 1;
     bool converged = false;
-    static Vector dSe(NEBD);
-    static Vector dvToDo(NEBD);
-    static Vector dvTrial(NEBD);
-    static Vector SeTrial(NEBD);
-    static Matrix kvTrial(NEBD, NEBD);
+    static thread_local Vector dSe(NEBD);
+    static thread_local Vector dvToDo(NEBD);
+    static thread_local Vector dvTrial(NEBD);
+    static thread_local Vector SeTrial(NEBD);
+    static thread_local Matrix kvTrial(NEBD, NEBD);
 
     dvToDo = dv;
     dvTrial = dvToDo;
@@ -1007,6 +1027,7 @@ void
     //static double factor = 10;
     double factor = subdivideFactor;
     double dW0 = 0.0;
+    int numItersTaken = 0;        // local iterations in this update
 
     //maxSubdivisions = 10;
 
@@ -1050,6 +1071,8 @@ void
 
 	  for (j=0; j <numIters; j++) {
 
+	    numItersTaken++;
+
 	    // initialize f and vr for integration
 	    f.Zero();
 	    vr.Zero();
@@ -1059,10 +1082,10 @@ void
 	  int order      = sections[i]->getOrder();
 	  const ID &code = sections[i]->getType();
 	  
-	  static Vector Ss;
-	  static Vector dSs;
-	  static Vector dvs;
-	  static Matrix fb;
+	  static thread_local Vector Ss;
+	  static thread_local Vector dSs;
+	  static thread_local Vector dvs;
+	  static thread_local Matrix fb;
 	  
 	  Ss.setData(workArea, order);
 	  dSs.setData(&workArea[order], order);
@@ -1330,8 +1353,12 @@ void
 
 	    SeTrial += dSe;
 
-	    // check for convergence of this interval
-	    if (fabs(dW) < tol) { 
+	    // check for convergence of this interval, in the non-iterative
+	    // form the first iterate is accepted and its residual
+	    // deformations are removed in the next update()
+	    if (fabs(dW) < tol || nonIterative == true) { 
+
+	      residualCarried = (fabs(dW) >= tol);
 
 	      // set the target displacement
 	      dvToDo -= dvTrial;
@@ -1383,12 +1410,20 @@ void
     theDamping->update(Se);
   }
 
+    lastIters = numItersTaken;
+    if (numItersTaken > mostIters)
+      mostIters = numItersTaken;
+    totalIters += numItersTaken;
+    numUpdates++;
+    iterHistogram[(numItersTaken < maxHistogramIters) ? numItersTaken : maxHistogramIters]++;
+
     // if fail to converge we return an error flag & print an error message
 
     if (converged == false) {
-      opserr << "WARNING - ForceBeamColumn3d::update - failed to get compatible ";
-      opserr << "element forces & deformations for element: ";
-      opserr << this->getTag() << "(dW: << " << dW << ", dW0: " << dW0 << ")\n";
+      OPS_WARNING("ForceBeamColumn3d::update", "failed to converge")
+	<< "WARNING - ForceBeamColumn3d::update - failed to get compatible "
+	<< "element forces & deformations for element: "
+	<< this->getTag() << "(dW: << " << dW << ", dW0: " << dW0 << ")\n";
 
       /*
       opserr << "Section Tangent Condition Numbers: ";
@@ -1533,8 +1568,7 @@ ForceBeamColumn3d::computeSectionForces(Vector &sp, int isec)
 
   double L = crdTransf->getInitialLength();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
   double x = xi[isec]*L;
 
   int order = sections[isec]->getOrder();
@@ -1742,8 +1776,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
   double L = crdTransf->getInitialLength();
   double dLdh = crdTransf->getdLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double dxidh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dxidh);
@@ -1961,6 +1994,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     idData(5) = initialFlag;
     idData(6) = (isTorsion) ? 1 : 0;
     idData(13) = maxSubdivisions;
+    idData(14) = (nonIterative) ? 1 : 0;
     
     idData(7) = crdTransf->getClassTag();
     int crdTransfDbTag  = crdTransf->getDbTag();
@@ -2126,6 +2160,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     initialFlag = idData(5);
     isTorsion = (idData(6) == 1) ? true : false;
     maxSubdivisions = idData(13);
+    nonIterative = (idData(14) == 1) ? true : false;
     
     int crdTransfClassTag = idData(7);
     int crdTransfDbTag = idData(8);
@@ -2422,11 +2457,9 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
 
-    double xi[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, xi);
+    const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
-    double wt[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wt);
+    const double *wt = beamIntegr->getCachedWeights(numSections, L);
 
     for (int i = 0; i < numSections; i++) {
 
@@ -2545,11 +2578,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0 / L;
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = beamIntegr->getCachedWeights(numSections, L);
 
   for (int i = 0; i < numSections; i++) {
 
@@ -2560,7 +2591,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
       double xL1 = xL - 1.0;
       double wtL = wt[i] * L;
 
-      static Vector sp;
+      static thread_local Vector sp;
       sp.setData(workArea, order);
       sp.Zero();
 
@@ -2568,7 +2599,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 
       const Matrix &fse = sections[i]->getInitialFlexibility();
 
-      static Vector e;
+      static thread_local Vector e;
       e.setData(&workArea[order], order);
 
       e.addMatrixVector(0.0, fse, sp, 1.0);
@@ -2608,14 +2639,13 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 					      Vector sectionDispls[]) const
   {
      // get basic displacements and increments
-     static Vector ub(NEBD);
+     static thread_local Vector ub(NEBD);
      ub = crdTransf->getBasicTrialDisp();    
 
      double L = crdTransf->getInitialLength();
 
      // get integration point positions and weights
-     static double pts[maxNumSections];
-     beamIntegr->getSectionLocations(numSections, L, pts);
+     const double *pts = beamIntegr->getCachedLocations(numSections, L);
 
      // setup Vandermode and CBDI influence matrices
      int i;
@@ -2628,7 +2658,7 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
      // get section curvatures
      Vector kappa_y(numSections);  // curvature
      Vector kappa_z(numSections);  // curvature
-     static Vector vs;                // section deformations 
+     static thread_local Vector vs;                // section deformations 
 
      for (i=0; i<numSections; i++) {
 	 // THIS IS VERY INEFFICIENT ... CAN CHANGE IF RUNS TOO SLOW
@@ -2663,8 +2693,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
      //cout << "kappa_z: " << kappa_z;   
 
      Vector v(numSections), w(numSections);
-     static Vector xl(NDM), uxb(NDM);
-     static Vector xg(NDM), uxg(NDM); 
+     static thread_local Vector xl(NDM), uxb(NDM);
+     static thread_local Vector xg(NDM), uxg(NDM); 
      // double theta;                             // angle of twist of the sections
 
      // v = ls * kappa_z;  
@@ -2695,6 +2725,20 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
     return;	       
   }
 
+size_t
+ForceBeamColumn3d::getMaterialMemoryUsage(void)
+{
+  if (sections == 0)
+    return 0;
+
+  size_t result = 0;
+  for (int i = 0; i < numSections; i++)
+    if (sections[i] != 0)
+      result += sections[i]->getMemoryUsage();
+
+  return result;
+}
+
   void
   ForceBeamColumn3d::Print(OPS_Stream &s, int flag)
   {
@@ -2739,9 +2783,9 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 
     // flag set to 2 used to print everything .. used for viewing data for UCSD renderer  
     else if (flag == 2) {
-       static Vector xAxis(3);
-       static Vector yAxis(3);
-       static Vector zAxis(3);
+       static thread_local Vector xAxis(3);
+       static thread_local Vector yAxis(3);
+       static thread_local Vector zAxis(3);
 
 
        crdTransf->getLocalAxes(xAxis, yAxis, zAxis);
@@ -2786,8 +2830,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 	 << T << ' ' << MY2 << ' '  <<  MZ2 << endln;
 
        // plastic hinge rotation
-       static Vector vp(6);
-       static Matrix fe(6,6);
+       static thread_local Vector vp(6);
+       static thread_local Matrix fe(6,6);
        this->getInitialFlexibility(fe);
        vp = crdTransf->getBasicTrialDisp();
        vp.addMatrixVector(1.0, fe, Se, -1.0);
@@ -2898,8 +2942,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
   int
   ForceBeamColumn3d::displaySelf(Renderer &theViewer, int displayMode, float fact, const char** displayModes, int numModes)
   {
-    static Vector v1(3);
-    static Vector v2(3);
+    static thread_local Vector v1(3);
+    static thread_local Vector v2(3);
 
     theNodes[0]->getDisplayCrds(v1, fact, displayMode);
     theNodes[1]->getDisplayCrds(v2, fact, displayMode);
@@ -3065,6 +3109,14 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
     } else if (strcmp(argv[0],"tangentDrift") == 0) {
       theResponse = new ElementResponse(this, 6, Vector(4));
       
+      // local iteration statistics: last, most, total and number of updates
+    } else if (strcmp(argv[0],"iterations") == 0) {
+      theResponse = new ElementResponse(this, 13, Vector(4));
+
+      // number of update() calls of all elements by local iterations taken
+    } else if (strcmp(argv[0],"iterationHistogram") == 0) {
+      theResponse = new ElementResponse(this, 14, Vector(maxHistogramIters+1));
+
     } else if (strcmp(argv[0],"getRemCriteria1") == 0) {
       theResponse = new ElementResponse(this, 77, Vector(2));
 
@@ -3221,8 +3273,8 @@ ForceBeamColumn3d::getInitialDeformations(Vector &v0)
 int 
 ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 {
-  static Vector vp(6);
-  static Matrix fe(6,6);
+  static thread_local Vector vp(6);
+  static thread_local Matrix fe(6,6);
 
   if (responseID == 1)
     return eleInfo.setVector(this->getResistingForce());
@@ -3330,8 +3382,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 10) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -3340,8 +3391,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 11) {
     double L = crdTransf->getInitialLength();
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    const double *wts = beamIntegr->getCachedWeights(numSections, L);
     Vector weights(numSections);
     for (int i = 0; i < numSections; i++)
       weights(i) = wts[i]*L;
@@ -3357,8 +3407,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
   
   else if (responseID == 111 || responseID == 1111) {
     double L = crdTransf->getInitialLength();
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
     // CBDI influence matrix
     Matrix ls(numSections, numSections);
     getCBDIinfluenceMatrix(numSections, pts, L, ls);
@@ -3381,9 +3430,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     Vector dispsz(numSections); // along local z    
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);    
-    beamIntegr->getSectionLocations(numSections, L, pts);
-    static Vector uxb(3);
-    static Vector uxg(3);
+    static thread_local Vector uxb(3);
+    static thread_local Vector uxg(3);
     Matrix disps(numSections,3);
     vp = crdTransf->getBasicTrialDisp();
     for (int i = 0; i < numSections; i++) {
@@ -3403,8 +3451,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
   else if (responseID == 112) {
     double L = crdTransf->getInitialLength();
-    double ipts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, ipts);
+    const double *ipts = beamIntegr->getCachedLocations(numSections, L);
     // CBDI influence matrix
     double pts[1];
     pts[0] = eleInfo.theDouble;
@@ -3429,8 +3476,8 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
     Vector dispsz(1); // along local z    
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);
-    static Vector uxb(3);
-    static Vector uxg(3);
+    static thread_local Vector uxb(3);
+    static thread_local Vector uxg(3);
     Matrix disps(1,3);
     vp = crdTransf->getBasicTrialDisp();
     uxb(0) = pts[0]*vp(0); // linear shape function
@@ -3447,9 +3494,25 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
   else if (responseID == 12)
     return eleInfo.setVector(this->getRayleighDampingForces());
 
+  else if (responseID == 13) {
+    static thread_local Vector iters(4);
+    iters(0) = lastIters;
+    iters(1) = mostIters;
+    iters(2) = totalIters;
+    iters(3) = numUpdates;
+    return eleInfo.setVector(iters);
+  }
+
+  else if (responseID == 14) {
+    static thread_local Vector histogram(maxHistogramIters+1);
+    for (int i = 0; i <= maxHistogramIters; i++)
+      histogram(i) = iterHistogram[i];
+    return eleInfo.setVector(histogram);
+  }
+
   // Point of inflection
   else if (responseID == 5) {
-    static Vector LI(2);
+    static thread_local Vector LI(2);
     LI(0) = 0.0;
     LI(1) = 0.0;
 
@@ -3473,11 +3536,9 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 
     double L = crdTransf->getInitialLength();
 
-    double wts[maxNumSections];
-    beamIntegr->getSectionWeights(numSections, L, wts);
+    const double *wts = beamIntegr->getCachedWeights(numSections, L);
 
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
 
     // Location of inflection point from node I
     double LIz = 0.0;
@@ -3533,7 +3594,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
       }
     }
 
-    static Vector d(4);
+    static thread_local Vector d(4);
     d(0) = d2z;
     d(1) = d3z;
     d(2) = d2y;
@@ -3647,7 +3708,7 @@ ForceBeamColumn3d::getResponse(int responseID, Information &eleInfo)
 	indata.close();
       }
 
-      static Vector result8(2);
+      static thread_local Vector result8(2);
       result8(0) = value;
       result8(1) = checkvalue1;      
       
@@ -3684,7 +3745,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Basic force sensitivity
   else if (responseID == 7) {
-    static Vector dqdh(6);
+    static thread_local Vector dqdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3709,7 +3770,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
       this->computeSectionForceSensitivity(dsdh, sectionNum-1, gradNumber);
     }
     //opserr << "FBC3d::getRespSens dspdh: " << dsdh;
-    static Vector dqdh(6);
+    static thread_local Vector dqdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -3721,8 +3782,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
  
     double L = crdTransf->getInitialLength();
     double oneOverL  = 1.0/L;  
-    double pts[maxNumSections];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
     
     const ID &code = sections[sectionNum-1]->getType();
       
@@ -3802,14 +3862,14 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Plastic deformation sensitivity
   else if (responseID == 4) {
-    static Vector dvpdh(6);
+    static thread_local Vector dvpdh(6);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
     dvpdh = dvdh;
     //opserr << dvpdh;
 
-    static Matrix fe(6,6);
+    static thread_local Matrix fe(6,6);
     this->getInitialFlexibility(fe);
 
     const Vector &dqdh = this->computedqdh(gradNumber);
@@ -3817,7 +3877,7 @@ ForceBeamColumn3d::getResponseSensitivity(int responseID, int gradNumber,
     dvpdh.addMatrixVector(1.0, fe, dqdh, -1.0);
     //opserr << dvpdh;
 
-    static Matrix fek(6,6);
+    static thread_local Matrix fek(6,6);
     fek.addMatrixProduct(0.0, fe, kv, 1.0);
 
     dvpdh.addMatrixVector(1.0, fek, dvdh, -1.0);
@@ -3983,7 +4043,7 @@ ForceBeamColumn3d::getMassSensitivity(int gradNumber)
 const Vector&
 ForceBeamColumn3d::getResistingForceSensitivity(int gradNumber)
 {
-  static Vector dqdh(6);
+  static thread_local Vector dqdh(6);
   dqdh = this->computedqdh(gradNumber);
 
   // Transform forces
@@ -3993,7 +4053,7 @@ ForceBeamColumn3d::getResistingForceSensitivity(int gradNumber)
   this->computeReactionSensitivity(dp0dh, gradNumber);
   Vector dp0dhVec(dp0dh, 6);
 
-  static Vector P(12);
+  static thread_local Vector P(12);
   P.Zero();
 
   if (crdTransf->isShapeSensitivity()) {
@@ -4018,11 +4078,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
-  
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  const double *pts = beamIntegr->getCachedLocations(numSections, L);
 
   double dLdh = crdTransf->getdLdh();
 
@@ -4031,7 +4087,7 @@ ForceBeamColumn3d::commitSensitivity(int gradNumber, int numGrads)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dqdh(6);
+  static thread_local Vector dqdh(6);
   dqdh = this->computedqdh(gradNumber);
 
   // dvdh = A dudh + dAdh u
@@ -4129,11 +4185,9 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
   double L = crdTransf->getInitialLength();
   double oneOverL = 1.0/L;
   
-  double pts[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, pts);
+  const double *pts = beamIntegr->getCachedLocations(numSections, L);
   
-  double wts[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wts);
+  const double *wts = beamIntegr->getCachedWeights(numSections, L);
 
   double dLdh = crdTransf->getdLdh();
 
@@ -4145,7 +4199,7 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dvdh(6);
+  static thread_local Vector dvdh(6);
   dvdh.Zero();
 
   // Loop over the integration points
@@ -4276,12 +4330,12 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
     }
   }
 
-  static Matrix dfedh(6,6);
+  static thread_local Matrix dfedh(6,6);
   dfedh.Zero();
 
   //opserr << "dfedh: " << dfedh << endln;
 
-  static Vector dqdh(6);
+  static thread_local Vector dqdh(6);
   dqdh.addMatrixVector(0.0, kv, dvdh, 1.0);
   
   //opserr << "dqdh: " << dqdh << endln;
@@ -4292,7 +4346,7 @@ ForceBeamColumn3d::computedqdh(int gradNumber)
 const Matrix&
 ForceBeamColumn3d::computedfedh(int gradNumber)
 {
-  static Matrix dfedh(6,6);
+  static thread_local Matrix dfedh(6,6);
 
   dfedh.Zero();
 
@@ -4302,11 +4356,9 @@ ForceBeamColumn3d::computedfedh(int gradNumber)
   double dLdh = crdTransf->getdLdh();
   double d1oLdh = crdTransf->getd1overLdh();
 
-  double xi[maxNumSections];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
   
-  double wt[maxNumSections];
-  beamIntegr->getSectionWeights(numSections, L, wt);
+  const double *wt = beamIntegr->getCachedWeights(numSections, L);
 
   double dptsdh[maxNumSections];
   beamIntegr->getLocationsDeriv(numSections, L, dLdh, dptsdh);
@@ -84,7 +84,7 @@ class ForceBeamColumn3d: public Element
 		    CrdTransf &coordTransf, double rho = 0.0, 
 		    int maxNumIters = 10, double tolerance = 1.0e-12,
 		    int maxNumSubdivide = 4, double subdivideFactor = 10.0,		    
-		    Damping *theDamping = 0);
+		    Damping *theDamping = 0, bool nonIterative = false);
   
   ~ForceBeamColumn3d();
 
@@ -121,6 +121,10 @@ class ForceBeamColumn3d: public Element
   
   friend OPS_Stream &operator<<(OPS_Stream &s, ForceBeamColumn3d &E);        
   void Print(OPS_Stream &s, int flag =0);    
+  size_t getMaterialMemoryUsage(void);
+  int getNumSections(void) {return numSections;}
+  SectionForceDeformation *getSection(int i)
+    {return (i >= 0 && i < numSections) ? sections[i] : 0;}
   
   Response *setResponse(const char **argv, int argc, OPS_Stream &s);
   int getResponse(int responseID, Information &eleInformation);
@@ -166,6 +170,9 @@ class ForceBeamColumn3d: public Element
   double rho;                    // mass density per unit length
   int    maxIters;               // maximum number of local iterations
   double tol;	                   // tolerance for relative energy norm for local iterations
+  bool   nonIterative;           // accept the state after one local iteration and
+                                 // carry the residual deformations to the next update
+  bool   residualCarried;        // the last update() accepted an unconverged state
   
   int    initialFlag;            // indicates if the element has been initialized
   
@@ -201,9 +208,9 @@ class ForceBeamColumn3d: public Element
 
   Damping *theDamping;
   
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
+  static thread_local Matrix theMatrix;
+  static thread_local Vector theVector;
+  static thread_local double workArea[];
   
   enum {maxNumSections = 10};
   
@@ -211,11 +218,21 @@ class ForceBeamColumn3d: public Element
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
   double subdivideFactor;
   
-  static Vector vsSubdivide[];
-  static Vector SsrSubdivide[];
-  static Matrix fsSubdivide[];
+  static thread_local Vector vsSubdivide[];
+  static thread_local Vector SsrSubdivide[];
+  static thread_local Matrix fsSubdivide[];
   //static int maxNumSections;
 
+  // local iteration statistics, of the element and of all elements;
+  // the histogram counts the update() calls by number of iterations,
+  // the last bin holding those with maxHistogramIters or more
+  int  lastIters;                // local iterations in the last update()
+  int  mostIters;                // most local iterations in one update()
+  long totalIters;               // local iterations since the start
+  long numUpdates;               // update() calls that iterated
+  enum {maxHistogramIters = 20};
+  static long iterHistogram[maxHistogramIters+1];
+
   // AddingSensitivity:BEGIN //////////////////////////////////////////
   int parameterID;
   const Vector &computedqdh(int gradNumber);
@@ -29,6 +29,7 @@
 // Description: This file contains the class definition for FourNodeQuad.
 
 #include <FourNodeQuad.h>
+#include <MemoryReport.h>
 #include <Node.h>
 #include <NDMaterial.h>
 #include <Matrix.h>
@@ -293,7 +294,7 @@ FourNodeQuad::FourNodeQuad(int tag, int nd1, int nd2, int nd3, int nd4,
          Damping *damping)
 :Element (tag, ELE_TAG_FourNodeQuad), 
   theMaterial(0), connectedExternalNodes(4), 
- Q(8), pressureLoad(8), thickness(t), applyLoad(0), pressure(p), rho(r), Ki(0)
+ Q(8), pressureLoad(8), thickness(t), applyLoad(0), pressure(p), rho(r), Ki(0), shapeCache(0)
 {
 	pts[0][0] = -0.5773502691896258;
 	pts[0][1] = -0.5773502691896258;
@@ -370,7 +371,7 @@ FourNodeQuad::FourNodeQuad(int tag, int nd1, int nd2, int nd3, int nd4,
 FourNodeQuad::FourNodeQuad()
 :Element (0,ELE_TAG_FourNodeQuad),
   theMaterial(0), connectedExternalNodes(4), 
- Q(8), pressureLoad(8), thickness(0.0), applyLoad(0), pressure(0.0), Ki(0)
+ Q(8), pressureLoad(8), thickness(0.0), applyLoad(0), pressure(0.0), Ki(0), shapeCache(0)
 {
   pts[0][0] = -0.577350269189626;
   pts[0][1] = -0.577350269189626;
@@ -415,6 +416,9 @@ FourNodeQuad::~FourNodeQuad()
 
   if (Ki != 0)
     delete Ki;
+
+  if (shapeCache != 0)
+    delete [] shapeCache;
 }
 
 int
@@ -445,6 +449,11 @@ FourNodeQuad::getNumDOF()
 void
 FourNodeQuad::setDomain(Domain *theDomain)
 {
+    // the cached shape functions are formed again for the new nodes
+    if (shapeCache != 0)
+	delete [] shapeCache;
+    shapeCache = 0;
+
 	// Check Domain is not null - invoked when object removed from a domain
     if (theDomain == 0) {
 	theNodes[0] = 0;
@@ -599,7 +608,7 @@ FourNodeQuad::update()
 	for (int i = 0; i < 4; i++) {
 
 		// Determine Jacobian for this integration point
-		this->shapeFunction(pts[i][0], pts[i][1]);
+		this->shapeFunction(i);
 
 		// Interpolate strains
 		//eps = B*u;
@@ -633,7 +642,7 @@ FourNodeQuad::getTangentStiff()
 	for (int i = 0; i < 4; i++) {
 
 	  // Determine Jacobian for this integration point
-	  dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+	  dvol = this->shapeFunction(i);
 	  dvol *= (thickness*wts[i]);
 	  
 	  // Get the material tangent
@@ -696,7 +705,7 @@ FourNodeQuad::getInitialStiff()
   for (int i = 0; i < 4; i++) {
     
     // Determine Jacobian for this integration point
-    dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    dvol = this->shapeFunction(i);
     dvol *= (thickness*wts[i]);
     
     // Get the material tangent
@@ -760,7 +769,7 @@ FourNodeQuad::getMass()
 	for (i = 0; i < 4; i++) {
 
 		// Determine Jacobian for this integration point
-		rhodvol = this->shapeFunction(pts[i][0], pts[i][1]);
+		rhodvol = this->shapeFunction(i);
 
 		// Element plus material density ... MAY WANT TO REMOVE ELEMENT DENSITY
 		rhodvol *= (rhoi[i]*thickness*wts[i]);
@@ -872,7 +881,7 @@ FourNodeQuad::getResistingForce()
 	for (int i = 0; i < 4; i++) {
 
 		// Determine Jacobian for this integration point
-		dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+		dvol = this->shapeFunction(i);
 		dvol *= (thickness*wts[i]);
 
 		// Get material stress response
@@ -1213,6 +1222,20 @@ FourNodeQuad::recvSelf(int commitTag, Channel &theChannel,
   return res;
 }
 
+size_t
+FourNodeQuad::getMaterialMemoryUsage(void)
+{
+  if (theMaterial == 0)
+    return 0;
+
+  size_t result = 0;
+  for (int i = 0; i < 4; i++)
+    if (theMaterial[i] != 0)
+      result += MemoryReport::objectSize(theMaterial[i]);
+
+  return result;
+}
+
 void
 FourNodeQuad::Print(OPS_Stream &s, int flag)
 {
@@ -1642,6 +1665,33 @@ FourNodeQuad::updateParameter(int parameterID, Information &info)
   }
 }
 
+// shape functions and derivatives at integration point i, from the
+// cache of the element while Element::cacheGeometry is set
+double FourNodeQuad::shapeFunction(int i)
+{
+	if (Element::cacheGeometry == false)
+		return this->shapeFunction(pts[i][0], pts[i][1]);
+
+	// shp[3][4] and detJ of each of the four points
+	if (shapeCache == 0) {
+		shapeCache = new double[4*13];
+		for (int j = 0; j < 4; j++) {
+			double *data = &shapeCache[13*j];
+			data[12] = this->shapeFunction(pts[j][0], pts[j][1]);
+			for (int k = 0; k < 3; k++)
+				for (int alpha = 0; alpha < 4; alpha++)
+					data[4*k+alpha] = shp[k][alpha];
+		}
+	}
+
+	const double *data = &shapeCache[13*i];
+	for (int k = 0; k < 3; k++)
+		for (int alpha = 0; alpha < 4; alpha++)
+			shp[k][alpha] = data[4*k+alpha];
+
+	return data[12];
+}
+
 double FourNodeQuad::shapeFunction(double xi, double eta)
 {
 	const Vector &nd1Crds = theNodes[0]->getCrds();
@@ -92,6 +92,7 @@ class FourNodeQuad : public Element
 
     int displaySelf(Renderer &, int mode, float fact, const char **displayModes=0, int numModes=0);
     void Print(OPS_Stream &s, int flag =0);
+    size_t getMaterialMemoryUsage(void);
 
     Response *setResponse(const char **argv, int argc, 
 			  OPS_Stream &s);
@@ -138,10 +139,12 @@ class FourNodeQuad : public Element
 
     // private member functions - only objects of this class can call these
     double shapeFunction(double xi, double eta);
+    double shapeFunction(int i);
     void setPressureLoadAtNodes(void);
 
     Matrix *Ki;
     Damping *theDamping[4];
+    double *shapeCache;  // shape functions and detJ at the points, see Element::cacheGeometry
 };
 
 #endif
@@ -822,11 +822,11 @@ int FPBearingPTV::update()
 	
     // 2) calculate shear forces and stiffnesses in basic y- and z-direction
     int iter = 0;
-    Vector qbOld(2);
+    double qbOld[2];
     do  {
         // save old shear forces
-        qbOld(0) = qb(1);
-        qbOld(1) = qb(2);
+        qbOld[0] = qb(1);
+        qbOld[1] = qb(2);
         
         // get normal forces			
 		N = -qb(0);
@@ -850,19 +850,19 @@ int FPBearingPTV::update()
 		}
 				
 		// get trial shear forces of hysteretic component
-        Vector qTrial(2);
-        qTrial(0) = k0y*(ub(1) - ubPlasticC(0));
-        qTrial(1) = k0z*(ub(2) - ubPlasticC(1));
+        double qTrial[2];
+        qTrial[0] = k0y*(ub(1) - ubPlasticC(0));
+        qTrial[1] = k0z*(ub(2) - ubPlasticC(1));
         
         // compute yield criterion of hysteretic component
-        double qTrialNorm = qTrial.Norm();
+        double qTrialNorm = sqrt(qTrial[0]*qTrial[0] + qTrial[1]*qTrial[1]);
         double Y = qTrialNorm - qYield;
         
         // elastic step -> no updates required
         if (Y <= 0.0)  {
             // set shear forces
-            qb(1) = qTrial(0) - N*ul(5) + k2y*ub(1);
-            qb(2) = qTrial(1) + N*ul(4) + k2z*ub(2);
+            qb(1) = qTrial[0] - N*ul(5) + k2y*ub(1);
+            qb(2) = qTrial[1] + N*ul(4) + k2z*ub(2);
             // set tangent stiffnesses
             kb(1,1) = kb(2,2) = k0;
             kb(1,2) = kb(2,1) = 0.0;	
@@ -878,11 +878,11 @@ int FPBearingPTV::update()
             double dGammaY = Y/k0y;
 			double dGammaZ = Y/k0z;
             // update plastic displacements
-            ubPlastic(0) = ubPlasticC(0) + dGammaY*qTrial(0)/qTrialNorm;
-            ubPlastic(1) = ubPlasticC(1) + dGammaZ*qTrial(1)/qTrialNorm;
+            ubPlastic(0) = ubPlasticC(0) + dGammaY*qTrial[0]/qTrialNorm;
+            ubPlastic(1) = ubPlasticC(1) + dGammaZ*qTrial[1]/qTrialNorm;
             // set shear forces
-            qb(1) = qYield*qTrial(0)/qTrialNorm - N*ul(5) + k2y*ub(1);
-            qb(2) = qYield*qTrial(1)/qTrialNorm + N*ul(4) + k2z*ub(2);			
+            qb(1) = qYield*qTrial[0]/qTrialNorm - N*ul(5) + k2y*ub(1);
+            qb(2) = qYield*qTrial[1]/qTrialNorm + N*ul(4) + k2z*ub(2);			
             // set tangent stiffnesses
             //Account for uplift
 			double k0Plastic = k0;
@@ -890,13 +890,13 @@ int FPBearingPTV::update()
 				k0Plastic = kFactUplift*k0;				
 			}
             double D = pow(qTrialNorm,3);
-            kb(1,1) =  k0Plastic*(1.0-(qYield*qTrial(1)*qTrial(1)/D)) + k2y;
-            kb(1,2) = -qYield*k0Plastic*qTrial(0)*qTrial(1)/D;
+            kb(1,1) =  k0Plastic*(1.0-(qYield*qTrial[1]*qTrial[1]/D)) + k2y;
+            kb(1,2) = -qYield*k0Plastic*qTrial[0]*qTrial[1]/D;
             kb(2,1) =  kb(1,2);
-            kb(2,2) =  k0Plastic*(1.0-(qYield*qTrial(0)*qTrial(0)/D)) + k2z;				
+            kb(2,2) =  k0Plastic*(1.0-(qYield*qTrial[0]*qTrial[0]/D)) + k2z;				
         }
         iter++;
-    } while ((sqrt(pow(qb(1)-qbOld(0),2)+pow(qb(2)-qbOld(1),2)) >= tol) && (iter <= maxIter));
+    } while ((sqrt(pow(qb(1)-qbOld[0],2)+pow(qb(2)-qbOld[1],2)) >= tol) && (iter <= maxIter));
 		
 	
 
@@ -905,7 +905,7 @@ int FPBearingPTV::update()
         opserr << "WARNING: FPBearingPTV::update() - element: "
             << this->getTag() << " - did not find the shear force after "
             << iter << " iterations and norm: "
-            << sqrt(pow(qb(1)-qbOld(0),2)+pow(qb(2)-qbOld(1),2)) << ".\n";
+            << sqrt(pow(qb(1)-qbOld[0],2)+pow(qb(2)-qbOld[1],2)) << ".\n";
         return -1;
     }
     
@@ -559,12 +559,12 @@ int SingleFPSimple3d::update()
     
     // 2) calculate shear forces and stiffnesses in basic y- and z-direction
     int iter = 0;
-    Vector qbOld(2);
+    double qbOld[2];
     do  {
         // save old shear forces
         iter++;
-        qbOld(0) = qb(1);
-        qbOld(1) = qb(2);
+        qbOld[0] = qb(1);
+        qbOld[1] = qb(2);
         
         // get normal and friction (yield) forces
         double N = -qb(0) + qb(1)/Ry*ub(1) + qb(2)/Rz*ub(2)
@@ -582,19 +582,19 @@ int SingleFPSimple3d::update()
         double k0z = kInit - k2z;
         
         // get trial shear forces of hysteretic component
-        Vector qTrial(2);
-        qTrial(0) = k0y*(ub(1) - ubPlasticC(0));
-        qTrial(1) = k0z*(ub(2) - ubPlasticC(1));
+        double qTrial[2];
+        qTrial[0] = k0y*(ub(1) - ubPlasticC(0));
+        qTrial[1] = k0z*(ub(2) - ubPlasticC(1));
         
         // compute yield criterion of hysteretic component
-        double qTrialNorm = qTrial.Norm();
+        double qTrialNorm = sqrt(qTrial[0]*qTrial[0] + qTrial[1]*qTrial[1]);
         double Y = qTrialNorm - qYield;
         
         // elastic step -> no updates required
         if (Y <= 0.0)  {
             // set shear forces
-            qb(1) = qTrial(0) + k2y*ub(1) - N*ul(5);
-            qb(2) = qTrial(1) + k2z*ub(2) + N*ul(4);
+            qb(1) = qTrial[0] + k2y*ub(1) - N*ul(5);
+            qb(2) = qTrial[1] + k2z*ub(2) + N*ul(4);
             // set tangent stiffnesses
             kb(1,1) = kb(2,2) = kInit;
             kb(1,2) = kb(2,1) = 0.0;
@@ -605,26 +605,26 @@ int SingleFPSimple3d::update()
             double dGammaY = Y/k0y;
             double dGammaZ = Y/k0z;
             // update plastic displacements
-            ubPlastic(0) = ubPlasticC(0) + dGammaY*qTrial(0)/qTrialNorm;
-            ubPlastic(1) = ubPlasticC(1) + dGammaZ*qTrial(1)/qTrialNorm;
+            ubPlastic(0) = ubPlasticC(0) + dGammaY*qTrial[0]/qTrialNorm;
+            ubPlastic(1) = ubPlasticC(1) + dGammaZ*qTrial[1]/qTrialNorm;
             // set shear forces
-            qb(1) = qYield*qTrial(0)/qTrialNorm + k2y*ub(1) - N*ul(5);
-            qb(2) = qYield*qTrial(1)/qTrialNorm + k2z*ub(2) + N*ul(4);
+            qb(1) = qYield*qTrial[0]/qTrialNorm + k2y*ub(1) - N*ul(5);
+            qb(2) = qYield*qTrial[1]/qTrialNorm + k2z*ub(2) + N*ul(4);
             // set tangent stiffnesses
             double D = pow(qTrialNorm,3);
-            kb(1,1) =  qYield*k0y*qTrial(1)*qTrial(1)/D + k2y;
-            kb(1,2) = -qYield*k0z*qTrial(1)*qTrial(0)/D;
-            kb(2,1) = -qYield*k0y*qTrial(0)*qTrial(1)/D;
-            kb(2,2) =  qYield*k0z*qTrial(0)*qTrial(0)/D + k2z;
+            kb(1,1) =  qYield*k0y*qTrial[1]*qTrial[1]/D + k2y;
+            kb(1,2) = -qYield*k0z*qTrial[1]*qTrial[0]/D;
+            kb(2,1) = -qYield*k0y*qTrial[0]*qTrial[1]/D;
+            kb(2,2) =  qYield*k0z*qTrial[0]*qTrial[0]/D + k2z;
         }
-    } while ((sqrt(pow(qb(1)-qbOld(0),2)+pow(qb(2)-qbOld(1),2)) >= tol) && (iter <= maxIter));
+    } while ((sqrt(pow(qb(1)-qbOld[0],2)+pow(qb(2)-qbOld[1],2)) >= tol) && (iter <= maxIter));
     
     // issue warning if iteration did not converge
     if (iter >= maxIter)   {
         opserr << "WARNING: SingleFPSimple3d::update() - element: "
             << this->getTag() << " - did not find the shear force after "
             << iter << " iterations and norm: "
-            << sqrt(pow(qb(1)-qbOld(0),2)+pow(qb(2)-qbOld(1),2)) << ".\n";
+            << sqrt(pow(qb(1)-qbOld[0],2)+pow(qb(2)-qbOld[1],2)) << ".\n";
         return -1;
     }
     
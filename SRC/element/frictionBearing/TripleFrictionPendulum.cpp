@@ -583,17 +583,15 @@ int TripleFrictionPendulum::update()
 
 const Matrix& TripleFrictionPendulum::getTangentStiff()
 {
-    Matrix a(2,12);
-    Matrix aT(12,2);
-    
-    a.Zero();
-    aT.Zero();
-    a(0,0) = a(1,1) = -1;
-    a(0,6) = a(1,7) =  1;
-    aT(0,0) = aT(1,1) = -1;
-    aT(6,0) = aT(7,1) =  1;
-    eleK= aT*K*a;
-    eleK *= -Fvert;
+    // aT*K*a with a = [-I 0 I 0], written out
+    eleK.Zero();
+    for (int i=0; i<2; i++) {
+        for (int j=0; j<2; j++) {
+            double kij = -Fvert*K(i,j);
+            eleK(i,j) = eleK(i+6,j+6) = kij;
+            eleK(i,j+6) = eleK(i+6,j) = -kij;
+        }
+    }
     
     eleK(2,2) = eleK(8,8) = Kvert;
     eleK(2,8) = eleK(8,2) = -Kvert;
@@ -610,20 +608,13 @@ const Matrix& TripleFrictionPendulum::getTangentStiff()
 
 const Matrix& TripleFrictionPendulum::getInitialStiff()
 {
-    Matrix a(2,12);
-    Matrix aT(12,2);
-    Matrix Kinit(2,2);
-    
-    Kinit.Zero();
-    Kinit(0,0) = Kinit(1,1) = E1/3.0;
-    a.Zero();
-    aT.Zero();
-    a(0,0) = a(1,1) = -1;
-    a(0,6) = a(1,7) =  1;
-    aT(0,0) = aT(1,1) = -1;
-    aT(6,0) = aT(7,1) =  1;
-    eleKinit = aT*Kinit*a;
-    eleKinit *= W;
+    // aT*Kinit*a with a = [-I 0 I 0] and Kinit = E1/3*I, written out
+    eleKinit.Zero();
+    double kInit = W*E1/3.0;
+    for (int i=0; i<2; i++) {
+        eleKinit(i,i) = eleKinit(i+6,i+6) = kInit;
+        eleKinit(i,i+6) = eleKinit(i+6,i) = -kInit;
+    }
     
     eleKinit(2,2) = eleKinit(8,8) = theMaterials[0]->getInitialTangent();
     eleKinit(2,8) = eleKinit(8,2) = -eleKinit(2,2);
@@ -667,12 +658,12 @@ const Matrix& TripleFrictionPendulum::getMass()
 
 const Vector& TripleFrictionPendulum::getResistingForce()
 {
-    Matrix aT(12,2);
-    aT.Zero();
-    aT(0,0) = aT(1,1) = -1;
-    aT(6,0) = aT(7,1) = 1;
-    eleR = aT*f;
-    eleR *= -Fvert;
+    // aT*f with a = [-I 0 I 0], written out
+    eleR.Zero();
+    eleR(0) = Fvert*f(0);
+    eleR(1) = Fvert*f(1);
+    eleR(6) = -Fvert*f(0);
+    eleR(7) = -Fvert*f(1);
     double Mx, My, Mz;
     Mx = -Fvert*Dy + eleR(7)*Hisolator;
     My = Fvert*Dx - eleR(6)*Hisolator;
@@ -1154,7 +1145,7 @@ int TripleFrictionPendulum::getResponse(int responseID, Information &eleInfo)
 }
 
 
-void TripleFrictionPendulum::CircularElasticGap(Matrix &kj, Vector &fj, double Ej, double Gapj, Vector di)
+void TripleFrictionPendulum::CircularElasticGap(Matrix &kj, Vector &fj, double Ej, double Gapj, const Vector &di)
 {
     double r = di.Norm();
     if (r == 0) {
@@ -1178,16 +1169,17 @@ void TripleFrictionPendulum::CircularElasticGap(Matrix &kj, Vector &fj, double E
 }
 
 
-void TripleFrictionPendulum::BidirectionalPlastic(Matrix &ki, Vector &fi, Vector &epitmp, Vector &qitmp, double Fyi, double Ei, double Hi, Vector epi, Vector qi, Vector di)
+void TripleFrictionPendulum::BidirectionalPlastic(Matrix &ki, Vector &fi, Vector &epitmp, Vector &qitmp, double Fyi, double Ei, double Hi, const Vector &epi, const Vector &qi, const Vector &di)
 {
     // This part was adapted to the source code of Bidirectional section in OpenSees
-    Vector xsi;
-    Vector ntmp(2);
+    double xsi[2];
     double normxsi;
     double fn;
-    fi = Ei*(di - epi);  //trial stress
-    xsi = fi - qi;
-    normxsi = xsi.Norm();
+    fi(0) = Ei*(di(0) - epi(0));  //trial stress
+    fi(1) = Ei*(di(1) - epi(1));
+    xsi[0] = fi(0) - qi(0);
+    xsi[1] = fi(1) - qi(1);
+    normxsi = sqrt(xsi[0]*xsi[0] + xsi[1]*xsi[1]);
     fn = normxsi - Fyi;  //yield function
     
     // Elastic step
@@ -1200,8 +1192,8 @@ void TripleFrictionPendulum::BidirectionalPlastic(Matrix &ki, Vector &fi, Vector
     }
     else {
         double dlam = fn/(Ei+Hi);
-        double n1 = xsi(0)/normxsi;
-        double n2 = xsi(1)/normxsi;
+        double n1 = xsi[0]/normxsi;
+        double n2 = xsi[1]/normxsi;
         double A = Ei*Ei/(Ei+Hi);
         double B = Ei*Ei*dlam/normxsi;
         double EB = Ei-B;
@@ -1214,45 +1206,50 @@ void TripleFrictionPendulum::BidirectionalPlastic(Matrix &ki, Vector &fi, Vector
         n2 = n2*dlam;
         fi(0) -= Ei*n1;
         fi(1) -= Ei*n2;	
-        ntmp(0) = n1;
-        ntmp(1) = n2;
-        epitmp = epi + ntmp;
-        qitmp = qi + ntmp*Hi;
+        epitmp(0) = epi(0) + n1;
+        epitmp(1) = epi(1) + n2;
+        qitmp(0) = qi(0) + n1*Hi;
+        qitmp(1) = qi(1) + n2*Hi;
     }
 }
 
 
-void TripleFrictionPendulum::Segment(Vector &epitmp, Vector &qitmp, bool &conv, Matrix &kij, Vector &di, Vector epi, Vector qi, Vector f, Vector df, double Fyi, double Ei, double Hi, double Ej, double Gapj, double Tol, int Niter)
+void TripleFrictionPendulum::Segment(Vector &epitmp, Vector &qitmp, bool &conv, Matrix &kij, Vector &di, const Vector &epi, const Vector &qi, const Vector &f, const Vector &df, double Fyi, double Ei, double Hi, double Ej, double Gapj, double Tol, int Niter)
 {
-    Vector dftmp = df;
-    Vector dd;
-    Matrix ki(2,2);
-    Matrix kj(2,2);
-    Vector fi(2);
-    Vector fj(2);
-    Vector fprime(2);
-    Matrix invkij(2,2);
-    
-    kij.Invert(invkij);
-    dd = invkij*dftmp;
+    static Matrix ki(2,2);
+    static Matrix kj(2,2);
+    static Vector fi(2);
+    static Vector fj(2);
+    
+    // the 2x2 systems are solved in closed form
+    double dftmp0 = df(0);
+    double dftmp1 = df(1);
+    double det = kij(0,0)*kij(1,1) - kij(0,1)*kij(1,0);
+    double dd0 = (kij(1,1)*dftmp0 - kij(0,1)*dftmp1)/det;
+    double dd1 = (kij(0,0)*dftmp1 - kij(1,0)*dftmp0)/det;
     int iter = 1;
     epitmp = epi;
     qitmp = qi;
     
     bool enterloop = false;
     
-    while (((dd.Norm() > 0.01*Tol) && (iter <= Niter)) || (!enterloop))
+    while (((sqrt(dd0*dd0 + dd1*dd1) > 0.01*Tol) && (iter <= Niter)) || (!enterloop))
     {
         enterloop = true;
         iter++;
-        di = di + dd;
+        di(0) += dd0;
+        di(1) += dd1;
         BidirectionalPlastic(ki, fi, epitmp, qitmp, Fyi, Ei, Hi, epi, qi, di);
         CircularElasticGap(kj, fj, Ej, Gapj, di);
-        kij = ki + kj;
-        fprime = fi + fj;
-        dftmp = f + df - fprime;
-        kij.Invert(invkij);
-        dd = invkij*dftmp;
+        kij(0,0) = ki(0,0) + kj(0,0);
+        kij(0,1) = ki(0,1) + kj(0,1);
+        kij(1,0) = ki(1,0) + kj(1,0);
+        kij(1,1) = ki(1,1) + kj(1,1);
+        dftmp0 = f(0) + df(0) - fi(0) - fj(0);
+        dftmp1 = f(1) + df(1) - fi(1) - fj(1);
+        det = kij(0,0)*kij(1,1) - kij(0,1)*kij(1,0);
+        dd0 = (kij(1,1)*dftmp0 - kij(0,1)*dftmp1)/det;
+        dd1 = (kij(0,0)*dftmp1 - kij(1,0)*dftmp0)/det;
     }
     if (iter > Niter)
         conv = false;
@@ -1261,14 +1258,14 @@ void TripleFrictionPendulum::Segment(Vector &epitmp, Vector &qitmp, bool &conv,
 }
 
 
-void TripleFrictionPendulum::TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3tmp, Vector &ep5tmp, Vector &q1tmp, Vector &q3tmp, Vector &q5tmp, Matrix &K, Vector &f, Matrix &k12, Matrix &k34, Matrix &k56, Vector &d1, Vector &d3, Vector &d5, Vector ep1, Vector ep3, Vector ep5, Vector q1, Vector q3, Vector q5, Vector u, Vector dusub, double Fy1, double Fy3, double Fy5, double E1, double E3, double E5, double H1, double H3, double H5, double E2, double E4, double E6, double Gap2, double Gap4, double Gap6, double Tol, int Niter)
+void TripleFrictionPendulum::TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3tmp, Vector &ep5tmp, Vector &q1tmp, Vector &q3tmp, Vector &q5tmp, Matrix &K, Vector &f, Matrix &k12, Matrix &k34, Matrix &k56, Vector &d1, Vector &d3, Vector &d5, const Vector &ep1, const Vector &ep3, const Vector &ep5, const Vector &q1, const Vector &q3, const Vector &q5, const Vector &u, const Vector &dusub, double Fy1, double Fy3, double Fy5, double E1, double E3, double E5, double H1, double H3, double H5, double E2, double E4, double E6, double Gap2, double Gap4, double Gap6, double Tol, int Niter)
 {
-    Vector df(2);
-    Vector du(2);
+    static Vector df(2);
+    static Vector du(2);
     du = dusub;
     int iter = 1;
     bool conv = true;
-    Vector uprime(2);
+    static Vector uprime(2);
     
     Conv = true;
     ep1tmp = ep1;
@@ -1283,7 +1280,8 @@ void TripleFrictionPendulum::TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3t
     {
         enterloop = true;
         iter++;
-        df = K*du;
+        df(0) = K(0,0)*du(0) + K(0,1)*du(1);
+        df(1) = K(1,0)*du(0) + K(1,1)*du(1);
         Segment(ep1tmp, q1tmp, conv, k12, d1, ep1, q1, f, df, Fy1, E1, H1, E2, Gap2, Tol, Niter);
         if (!conv)
         {
@@ -1302,7 +1300,8 @@ void TripleFrictionPendulum::TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3t
             Conv = false;
             break;
         }
-        f = f + df;
+        f(0) += df(0);
+        f(1) += df(1);
         
         uprime(0) = d1(0) + d3(0) + d5(0);
         uprime(1) = d1(1) + d3(1) + d5(1);
@@ -1315,15 +1314,15 @@ void TripleFrictionPendulum::TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3t
 }
 
 
-void TripleFrictionPendulum::StiffnessForm(Matrix &K, Matrix k12, Matrix k34, Matrix k56)
+void TripleFrictionPendulum::StiffnessForm(Matrix &K, const Matrix &k12, const Matrix &k34, const Matrix &k56)
 {
-    Matrix K88(8,8);
-    Matrix ktt(4,4);
-    Matrix Ktmp1(4,4);
-    Matrix Ktmp2(4,4);
-    Matrix kot(4,4);
-    Matrix kto(4,4);
-    Matrix invktt(4,4);
+    static Matrix K88(8,8);
+    static Matrix ktt(4,4);
+    static Matrix Ktmp1(4,4);
+    static Matrix Ktmp2(4,4);
+    static Matrix kot(4,4);
+    static Matrix kto(4,4);
+    static Matrix invktt(4,4);
     
     K88.Zero();	
     K88(0,0) = k12(0,0);
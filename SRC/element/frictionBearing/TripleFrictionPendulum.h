@@ -100,11 +100,11 @@ protected:
 
 private:
     // private member functions - only available to objects of the class
-    void CircularElasticGap(Matrix &kj, Vector &fj, double Ej,double Gapj,Vector di);
-    void BidirectionalPlastic(Matrix &ki, Vector &fi, Vector &epitmp, Vector &qitmp, double Fyi, double Ei, double Hi, Vector epi, Vector qi, Vector di);
-    void Segment(Vector &epitmp, Vector &qitmp, bool &conv, Matrix &kij, Vector &di, Vector epi, Vector qi, Vector f, Vector df, double Fyi, double Ei, double Hi, double Ej, double Gapj, double Tol, int Niter);
-    void TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3tmp, Vector &ep5tmp, Vector &q1tmp, Vector &q3tmp, Vector &q5tmp, Matrix &K, Vector &f, Matrix &k12, Matrix &k34, Matrix &k56, Vector &d1, Vector &d3, Vector &d5, Vector ep1, Vector ep3, Vector ep5, Vector q1, Vector q3, Vector q5, Vector u, Vector dusub, double Fy1, double Fy3, double Fy5, double E1, double E3, double E5, double H1, double H3, double H5, double E2, double E4, double E6, double Gap2, double Gap4, double Gap6, double Tol, int Niter);
-    void StiffnessForm(Matrix &K, Matrix k12, Matrix k34, Matrix k56);
+    void CircularElasticGap(Matrix &kj, Vector &fj, double Ej,double Gapj,const Vector &di);
+    void BidirectionalPlastic(Matrix &ki, Vector &fi, Vector &epitmp, Vector &qitmp, double Fyi, double Ei, double Hi, const Vector &epi, const Vector &qi, const Vector &di);
+    void Segment(Vector &epitmp, Vector &qitmp, bool &conv, Matrix &kij, Vector &di, const Vector &epi, const Vector &qi, const Vector &f, const Vector &df, double Fyi, double Ei, double Hi, double Ej, double Gapj, double Tol, int Niter);
+    void TFPElement(bool &Conv, Vector &ep1tmp, Vector &ep3tmp, Vector &ep5tmp, Vector &q1tmp, Vector &q3tmp, Vector &q5tmp, Matrix &K, Vector &f, Matrix &k12, Matrix &k34, Matrix &k56, Vector &d1, Vector &d3, Vector &d5, const Vector &ep1, const Vector &ep3, const Vector &ep5, const Vector &q1, const Vector &q3, const Vector &q5, const Vector &u, const Vector &dusub, double Fy1, double Fy3, double Fy5, double E1, double E3, double E5, double H1, double H3, double H5, double E2, double E4, double E6, double Gap2, double Gap4, double Gap6, double Tol, int Niter);
+    void StiffnessForm(Matrix &K, const Matrix &k12, const Matrix &k34, const Matrix &k56);
     
     FrictionModel *theFrnMdls[3];  // array of friction models for three sliding surfaces
     UniaxialMaterial *theMaterials[4];  // array of uniaxial materials
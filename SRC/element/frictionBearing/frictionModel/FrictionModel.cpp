@@ -35,6 +35,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theFrictionModelObjects;
+static bool theFrictionModelObjectsRegistered = MapOfTaggedObjects::addModelStorage(theFrictionModelObjects);
 
 
 bool OPS_addFrictionModel(FrictionModel *newComponent)
@@ -36,6 +36,7 @@
 #include <ElementResponse.h>
 #include <TCP_Socket.h>
 #include <UDP_Socket.h>
+#include <SharedMemoryChannel.h>
 #ifdef SSL
     #include <TCP_SocketSSL.h>
 #endif
@@ -51,7 +52,7 @@ void* OPS_GenericClient()
     int ndf = OPS_GetNDF();
     if (OPS_GetNumRemainingInputArgs() < 7) {
         opserr << "WARNING insufficient arguments\n";
-        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> <-noRayleigh>\n";
+        opserr << "Want: element genericClient eleTag -node Ndi Ndj ... -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-shm> <-dataSize size> <-noRayleigh>\n";
         return 0;
     }
     
@@ -136,7 +137,7 @@ void* OPS_GenericClient()
     // options
     char* ipAddr = new char[10];
     strcpy(ipAddr, "127.0.0.1");
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = 256;
     int doRayleigh = 1;
     
@@ -144,6 +145,7 @@ void* OPS_GenericClient()
         type = OPS_GetString();
         if (strcmp(type, "-ssl") != 0 &&
             strcmp(type, "-udp") != 0 &&
+            strcmp(type, "-shm") != 0 &&
             strcmp(type, "-dataSize") != 0 &&
             strcmp(type, "-noRayleigh") != 0 &&
             strcmp(type, "-doRayleigh") != 0) {
@@ -152,10 +154,13 @@ void* OPS_GenericClient()
             strcpy(ipAddr, type);
         }
         else if (strcmp(type, "-ssl") == 0) {
-            ssl = 1; udp = 0;
+            ssl = 1; udp = 0; shm = 0;
         }
         else if (strcmp(type, "-udp") == 0) {
-            udp = 1; ssl = 0;
+            udp = 1; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-shm") == 0) {
+            shm = 1; ssl = 0; udp = 0;
         }
         else if (strcmp(type, "-dataSize") == 0) {
             if (OPS_GetNumRemainingInputArgs() < 1) {
@@ -178,7 +183,7 @@ void* OPS_GenericClient()
     
     // create object
     Element *theEle = new GenericClient(tag, nodes, dofs, ipPort,
-        ipAddr, ssl, udp, dataSize, doRayleigh);
+        ipAddr, ssl, udp, dataSize, doRayleigh, shm);
     
     // cleanup dynamic memory
     if (dofs != 0)
@@ -192,11 +197,12 @@ void* OPS_GenericClient()
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 GenericClient::GenericClient(int tag, ID nodes, ID *dof, int _port,
-    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay)
+    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay,
+    int _shm)
     : Element(tag, ELE_TAG_GenericClient),
     connectedExternalNodes(nodes), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(_port), machineInetAddr(0), ssl(_ssl),
-    udp(_udp), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
+    udp(_udp), shm(_shm), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -252,7 +258,7 @@ GenericClient::GenericClient()
     : Element(0, ELE_TAG_GenericClient),
     connectedExternalNodes(1), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(0), machineInetAddr(0), ssl(0),
-    udp(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
+    udp(0), shm(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -477,8 +483,10 @@ const Matrix& GenericClient::getTangentStiff()
     
     // get tangent stiffness from remote element
     sData[0] = RemoteTest_getTangentStiff;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     theMatrix.Assemble(*rMatrix, basicDOF, basicDOF);
     
     return theMatrix;
@@ -494,8 +502,10 @@ const Matrix& GenericClient::getInitialStiff()
         
         // get initial stiffness from remote element
         sData[0] = RemoteTest_getInitialStiff;
+        latency.start();
         theChannel->sendVector(0, 0, *sendData, 0);
         theChannel->recvVector(0, 0, *recvData, 0);
+        latency.stop();
         
         theInitStiff.Assemble(*rMatrix, basicDOF, basicDOF);
         initStiffFlag = true;
@@ -518,8 +528,10 @@ const Matrix& GenericClient::getDamp()
     
     // now add damping from remote element
     sData[0] = RemoteTest_getDamp;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     theMatrix.Assemble(*rMatrix, basicDOF, basicDOF);
     
     return theMatrix;
@@ -535,8 +547,10 @@ const Matrix& GenericClient::getMass()
         
         // get mass matrix from remote element
         sData[0] = RemoteTest_getMass;
+        latency.start();
         theChannel->sendVector(0, 0, *sendData, 0);
         theChannel->recvVector(0, 0, *recvData, 0);
+        latency.stop();
         
         theMass.Assemble(*rMatrix, basicDOF, basicDOF);
         massFlag = true;
@@ -590,8 +604,10 @@ const Vector& GenericClient::getResistingForce()
     
     // get resisting forces from remote element
     sData[0] = RemoteTest_getForce;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     
     // save corresponding ctrl response for recorder
     dbCtrl = (*db);
@@ -644,8 +660,10 @@ const Vector& GenericClient::getResistingForceIncInertia()
 /*const Vector& GenericClient::getTime()
 {
     sData[0] = RemoteTest_getTime;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     
     return *tDaq;
 }
@@ -654,8 +672,10 @@ const Vector& GenericClient::getResistingForceIncInertia()
 const Vector& GenericClient::getBasicDisp()
 {
     sData[0] = RemoteTest_getDisp;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     
     return *dbDaq;
 }
@@ -664,8 +684,10 @@ const Vector& GenericClient::getBasicDisp()
 const Vector& GenericClient::getBasicVel()
 {
     sData[0] = RemoteTest_getVel;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     
     return *vbDaq;
 }
@@ -674,8 +696,10 @@ const Vector& GenericClient::getBasicVel()
 const Vector& GenericClient::getBasicAccel()
 {
     sData[0] = RemoteTest_getAccel;
+    latency.start();
     theChannel->sendVector(0, 0, *sendData, 0);
     theChannel->recvVector(0, 0, *recvData, 0);
+    latency.stop();
     
     return *abDaq;
 }*/
@@ -684,7 +708,7 @@ const Vector& GenericClient::getBasicAccel()
 int GenericClient::sendSelf(int commitTag, Channel &sChannel)
 {
     // send element parameters
-    static Vector data(12);
+    static Vector data(13);
     data(0) = this->getTag();
     data(1) = numExternalNodes;
     data(2) = port;
@@ -697,6 +721,7 @@ int GenericClient::sendSelf(int commitTag, Channel &sChannel)
     data(9) = betaK;
     data(10) = betaK0;
     data(11) = betaKc;
+    data(12) = shm;
     sChannel.sendVector(0, commitTag, data);
     
     // send the end nodes and dofs
@@ -724,7 +749,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
         delete[] machineInetAddr;
     
     // receive element parameters
-    static Vector data(12);
+    static Vector data(13);
     rChannel.recvVector(0, commitTag, data);
     this->setTag((int)data(0));
     numExternalNodes = (int)data(1);
@@ -738,6 +763,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
     betaK = data(9);
     betaK0 = data(10);
     betaKc = data(11);
+    shm = (int)data(12);
     
     // initialize nodes and receive them
     connectedExternalNodes.resize(numExternalNodes);
@@ -971,6 +997,17 @@ Response* GenericClient::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(numBasicDOF));
     }*/
     
+    // round trip times of the exchanges with the remote process
+    else if (strcmp(argv[0],"latency") == 0)
+    {
+        output.tag("ResponseType","num");
+        output.tag("ResponseType","last");
+        output.tag("ResponseType","mean");
+        output.tag("ResponseType","max");
+        output.tag("ResponseType","jitter");
+        theResponse = new ElementResponse(this, 10, Vector(5));
+    }
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1007,6 +1044,9 @@ int GenericClient::getResponse(int responseID, Information &eleInfo)
     case 9:  // daq basic accelerations
         return eleInfo.setVector(this->getBasicAccel());*/
         
+    case 10:  // round trip times
+        return eleInfo.setVector(latency.getStats());
+        
     default:
         return -1;
     }
@@ -1016,7 +1056,10 @@ int GenericClient::getResponse(int responseID, Information &eleInfo)
 int GenericClient::setupConnection()
 {
     // setup the connection
-    if (udp)  {
+    if (shm)  {
+        theChannel = new SharedMemoryChannel(port, false);
+    }
+    else if (udp)  {
         if (machineInetAddr == 0)
             theChannel = new UDP_Socket(port, "127.0.0.1");
         else
@@ -32,6 +32,7 @@
 
 #include <Element.h>
 #include <Matrix.h>
+#include <LatencyMonitor.h>
 
 #define RemoteTest_open              1
 #define RemoteTest_setup             2
@@ -60,7 +61,7 @@ public:
     GenericClient(int tag, ID nodes, ID *dof,
           int port, char *machineInetAddr = 0,
           int ssl = 0, int udp = 0, int dataSize = 256,
-          int addRayleigh = 1);
+          int addRayleigh = 1, int shm = 0);
     GenericClient();
     
     // destructor
@@ -129,6 +130,7 @@ private:
     char *machineInetAddr;      // ipAddress
     int ssl;                    // secure socket layer flag
     int udp;                    // udp socket flag
+    int shm;                    // shared memory channel flag
     int dataSize;               // data size of send/recv vectors
     int addRayleigh;            // flag to add Rayleigh damping
     
@@ -161,6 +163,8 @@ private:
     
     Node **theNodes;
     
+    LatencyMonitor latency;     // round trip time of each exchange
+    
     int setupConnection();
 };
 
@@ -0,0 +1,940 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the SuperElement class.
+
+#include "SuperElement.h"
+
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <ElementIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <NodalLoad.h>
+#include <NodalLoadIter.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <Renderer.h>
+#include <Information.h>
+#include <ElementResponse.h>
+
+#include <map>
+#include <set>
+#include <vector>
+#include <fstream>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elementAPI.h>
+
+// written at the start of the files of SuperElement::save()
+static const char superElementMagic[8] = {'O','P','S','S','U','P','E','1'};
+
+
+void* OPS_SuperElement()
+{
+    if (OPS_GetNumRemainingInputArgs() < 5) {
+        opserr << "WARNING insufficient arguments\n";
+        opserr << "Want: element superElement eleTag -node Ndi ... "
+            << "<-ele eleTagi ... <-save fileName>> <-file fileName>\n";
+        return 0;
+    }
+    
+    // tags
+    int tag;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &tag) < 0) {
+        opserr << "WARNING: invalid tag\n";
+        return 0;
+    }
+    
+    // boundary nodes
+    const char* type = OPS_GetString();
+    if (strcmp(type, "-node") != 0) {
+        opserr << "WARNING expecting -node Ndi Ndj ...\n";
+        return 0;
+    }
+    ID nodes(32);
+    int numNodes = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        int node;
+        numdata = 1;
+        if (OPS_GetIntInput(&numdata, &node) < 0) {
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+        nodes(numNodes++) = node;
+    }
+    nodes.resize(numNodes);
+    
+    // condensed elements or file
+    ID eles(32);
+    int numEles = 0;
+    const char *saveFile = 0;
+    const char *loadFile = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        type = OPS_GetString();
+        if (strcmp(type, "-ele") == 0) {
+            while (OPS_GetNumRemainingInputArgs() > 0) {
+                int ele;
+                numdata = 1;
+                if (OPS_GetIntInput(&numdata, &ele) < 0) {
+                    OPS_ResetCurrentInputArg(-1);
+                    break;
+                }
+                eles(numEles++) = ele;
+            }
+        } else if (strcmp(type, "-save") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+            saveFile = OPS_GetString();
+        } else if (strcmp(type, "-file") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+            loadFile = OPS_GetString();
+        } else {
+            opserr << "WARNING unknown option " << type
+                << " for superElement " << tag << endln;
+            return 0;
+        }
+    }
+    eles.resize(numEles);
+    
+    if (loadFile != 0)
+        return SuperElement::load(tag, nodes, loadFile);
+    
+    if (numEles == 0) {
+        opserr << "WARNING superElement " << tag
+            << " needs -ele eleTagi ... or -file fileName\n";
+        return 0;
+    }
+    
+    Domain *theDomain = OPS_GetDomain();
+    if (theDomain == 0)
+        return 0;
+    
+    Matrix K, M, C, R;
+    ID interiorNodes, interiorDOFs;
+    if (SuperElement::condense(*theDomain, nodes, eles, K, M, C, R,
+        interiorNodes, interiorDOFs) < 0) {
+        opserr << "WARNING failed to condense superElement " << tag << endln;
+        return 0;
+    }
+    
+    SuperElement *theEle = new SuperElement(tag, nodes, K, M, C, R,
+        interiorNodes, interiorDOFs);
+    if (saveFile != 0 && theEle->save(saveFile) < 0) {
+        delete theEle;
+        return 0;
+    }
+    
+    // the condensed elements and the interior nodes are replaced
+    std::set<int> interior;
+    for (int i = 0; i < interiorNodes.Size(); i++)
+        interior.insert(interiorNodes(i));
+    for (int i = 0; i < numEles; i++) {
+        Element *theCondensed = theDomain->removeElement(eles(i));
+        if (theCondensed != 0)
+            delete theCondensed;
+    }
+    
+    SP_ConstraintIter &theSPs = theDomain->getSPs();
+    SP_Constraint *theSP;
+    std::vector<int> spTags;
+    while ((theSP = theSPs()) != 0)
+        if (interior.count(theSP->getNodeTag()) != 0)
+            spTags.push_back(theSP->getTag());
+    for (size_t i = 0; i < spTags.size(); i++) {
+        theSP = theDomain->removeSP_Constraint(spTags[i]);
+        if (theSP != 0)
+            delete theSP;
+    }
+    
+    LoadPatternIter &thePatterns = theDomain->getLoadPatterns();
+    LoadPattern *thePattern;
+    while ((thePattern = thePatterns()) != 0) {
+        NodalLoadIter &theLoads = thePattern->getNodalLoads();
+        NodalLoad *theNodalLoad;
+        std::vector<int> loadTags;
+        while ((theNodalLoad = theLoads()) != 0)
+            if (interior.count(theNodalLoad->getNodeTag()) != 0)
+                loadTags.push_back(theNodalLoad->getTag());
+        if (!loadTags.empty())
+            opserr << "WARNING superElement " << tag << " - the loads on its "
+                << "interior nodes in pattern " << thePattern->getTag()
+                << " are removed\n";
+        for (size_t i = 0; i < loadTags.size(); i++) {
+            theNodalLoad = thePattern->removeNodalLoad(loadTags[i]);
+            if (theNodalLoad != 0)
+                delete theNodalLoad;
+        }
+    }
+    
+    for (std::set<int>::iterator it = interior.begin(); it != interior.end(); ++it) {
+        Node *theNode = theDomain->removeNode(*it);
+        if (theNode != 0)
+            delete theNode;
+    }
+    
+    return theEle;
+}
+
+
+// responsible for allocating the necessary space needed
+// by each object and storing the tags of the end nodes.
+SuperElement::SuperElement(int tag, const ID &nodes,
+    const Matrix &K, const Matrix &M, const Matrix &C,
+    const Matrix &R, const ID &intNodes, const ID &intDOFs)
+    : Element(tag, ELE_TAG_SuperElement),
+    connectedExternalNodes(nodes), numExternalNodes(0), numDOF(K.noRows()),
+    theStiff(K), theMass(M), theDamp(C), theRecovery(R),
+    interiorNodes(intNodes), interiorDOFs(intDOFs),
+    theMatrix(K.noRows(),K.noRows()), theVector(K.noRows()),
+    theLoad(K.noRows()), theInterior(R.noRows())
+{
+    // initialize nodes
+    numExternalNodes = connectedExternalNodes.Size();
+    theNodes = new Node* [numExternalNodes];
+    if (!theNodes)  {
+        opserr << "SuperElement::SuperElement() "
+            << "- failed to create node array\n";
+        exit(-1);
+    }
+    
+    // set node pointers to NULL
+    for (int i=0; i<numExternalNodes; i++)
+        theNodes[i] = 0;
+}
+
+
+// invoked by a FEM_ObjectBroker - blank object that recvSelf
+// needs to be invoked upon
+SuperElement::SuperElement()
+    : Element(0, ELE_TAG_SuperElement),
+    connectedExternalNodes(1), numExternalNodes(0), numDOF(0),
+    theStiff(1,1), theMass(1,1), theDamp(1,1), theRecovery(1,1),
+    interiorNodes(1), interiorDOFs(1),
+    theMatrix(1,1), theVector(1), theLoad(1), theInterior(1)
+{
+    // initialize variables
+    theNodes = 0;
+}
+
+
+// delete must be invoked on any objects created by the object.
+SuperElement::~SuperElement()
+{
+    // invoke the destructor on any objects created by the object
+    // that the object still holds a pointer to
+    if (theNodes != 0)
+        delete [] theNodes;
+}
+
+
+int SuperElement::condense(Domain &theDomain, const ID &nodes,
+    const ID &eleTags, Matrix &K, Matrix &M, Matrix &C, Matrix &R,
+    ID &intNodes, ID &intDOFs)
+{
+    // the first equation of each node, the boundary nodes come first
+    std::map<int, int> nodeStart;
+    std::vector<int> nodeOrder;
+    int n = 0;
+    for (int i=0; i<nodes.Size(); i++)  {
+        Node *theNode = theDomain.getNode(nodes(i));
+        if (theNode == 0 || nodeStart.count(nodes(i)) != 0)  {
+            opserr << "SuperElement::condense() - boundary node "
+                << nodes(i) << " does not exist or is repeated\n";
+            return -1;
+        }
+        nodeStart[nodes(i)] = n;
+        nodeOrder.push_back(nodes(i));
+        n += theNode->getNumberDOF();
+    }
+    int nb = n;
+    
+    std::vector<Element *> theEles;
+    std::set<int> eleSet;
+    for (int i=0; i<eleTags.Size(); i++)  {
+        Element *theEle = theDomain.getElement(eleTags(i));
+        if (theEle == 0)  {
+            opserr << "SuperElement::condense() - element "
+                << eleTags(i) << " does not exist\n";
+            return -1;
+        }
+        if (eleSet.insert(eleTags(i)).second == false)
+            continue;
+        theEles.push_back(theEle);
+        const ID &eleNodes = theEle->getExternalNodes();
+        for (int j=0; j<eleNodes.Size(); j++)  {
+            if (nodeStart.count(eleNodes(j)) != 0)
+                continue;
+            Node *theNode = theDomain.getNode(eleNodes(j));
+            if (theNode == 0)
+                return -1;
+            nodeStart[eleNodes(j)] = n;
+            nodeOrder.push_back(eleNodes(j));
+            n += theNode->getNumberDOF();
+        }
+    }
+    
+    // an interior node may not be used by any other element
+    ElementIter &theAll = theDomain.getElements();
+    Element *theOther;
+    while ((theOther = theAll()) != 0)  {
+        if (eleSet.count(theOther->getTag()) != 0)
+            continue;
+        const ID &eleNodes = theOther->getExternalNodes();
+        for (int j=0; j<eleNodes.Size(); j++)  {
+            std::map<int, int>::iterator it = nodeStart.find(eleNodes(j));
+            if (it != nodeStart.end() && it->second >= nb)  {
+                opserr << "SuperElement::condense() - interior node "
+                    << eleNodes(j) << " is used by element "
+                    << theOther->getTag() << ", add it to the boundary nodes\n";
+                return -1;
+            }
+        }
+    }
+    
+    // nor by a multi point constraint
+    MP_ConstraintIter &theMPs = theDomain.getMPs();
+    MP_Constraint *theMP;
+    while ((theMP = theMPs()) != 0)  {
+        std::map<int, int>::iterator itR = nodeStart.find(theMP->getNodeRetained());
+        std::map<int, int>::iterator itC = nodeStart.find(theMP->getNodeConstrained());
+        if ((itR != nodeStart.end() && itR->second >= nb) ||
+            (itC != nodeStart.end() && itC->second >= nb))  {
+            opserr << "SuperElement::condense() - an interior node is used "
+                << "by a multi point constraint\n";
+            return -1;
+        }
+    }
+    
+    // the interior DOFs that are fixed are dropped
+    std::vector<bool> fixed(n, false);
+    SP_ConstraintIter &theSPs = theDomain.getSPs();
+    SP_Constraint *theSP;
+    while ((theSP = theSPs()) != 0)  {
+        std::map<int, int>::iterator it = nodeStart.find(theSP->getNodeTag());
+        if (it == nodeStart.end() || it->second < nb)
+            continue;
+        if (theSP->getValue() != 0.0)
+            opserr << "WARNING SuperElement::condense() - the constraint on "
+                << "interior node " << theSP->getNodeTag() << " is taken as zero\n";
+        fixed[it->second + theSP->getDOF_Number()] = true;
+    }
+    
+    // the equations of the reduced system, boundary then free interior DOFs
+    std::vector<int> eqn(n, -1);
+    int ni = 0;
+    for (int i=0; i<n; i++)  {
+        if (i < nb)
+            eqn[i] = i;
+        else if (fixed[i] == false)
+            eqn[i] = nb + ni++;
+    }
+    int m = nb + ni;
+    
+    Matrix Kf(m,m), Mf(m,m), Cf(m,m);
+    for (size_t e=0; e<theEles.size(); e++)  {
+        Element *theEle = theEles[e];
+        const ID &eleNodes = theEle->getExternalNodes();
+        ID loc(theEle->getNumDOF());
+        int k = 0;
+        for (int j=0; j<eleNodes.Size(); j++)  {
+            int start = nodeStart[eleNodes(j)];
+            int ndf = theDomain.getNode(eleNodes(j))->getNumberDOF();
+            for (int d=0; d<ndf && k<loc.Size(); d++)
+                loc(k++) = eqn[start+d];
+        }
+        
+        const Matrix &eleK = theEle->getInitialStiff();
+        const Matrix &eleM = theEle->getMass();
+        const Matrix &eleC = theEle->getDamp();
+        for (int i=0; i<k; i++)  {
+            if (loc(i) < 0)
+                continue;
+            for (int j=0; j<k; j++)  {
+                if (loc(j) < 0)
+                    continue;
+                Kf(loc(i),loc(j)) += eleK(i,j);
+                Mf(loc(i),loc(j)) += eleM(i,j);
+                Cf(loc(i),loc(j)) += eleC(i,j);
+            }
+        }
+    }
+    
+    // the masses of the interior nodes, those of the boundary stay there
+    for (size_t i=0; i<nodeOrder.size(); i++)  {
+        int start = nodeStart[nodeOrder[i]];
+        if (start < nb)
+            continue;
+        Node *theNode = theDomain.getNode(nodeOrder[i]);
+        const Matrix &nodeM = theNode->getMass();
+        int ndf = theNode->getNumberDOF();
+        for (int a=0; a<ndf; a++)  {
+            if (eqn[start+a] < 0)
+                continue;
+            for (int b=0; b<ndf; b++)
+                if (eqn[start+b] >= 0)
+                    Mf(eqn[start+a],eqn[start+b]) += nodeM(a,b);
+        }
+    }
+    
+    // interior displacements are -Kii^-1 Kib times the boundary ones
+    Matrix X(ni,nb);
+    if (ni > 0)  {
+        Matrix Kii(ni,ni), Kib(ni,nb);
+        Kii.Extract(Kf, nb, nb);
+        Kib.Extract(Kf, nb, 0);
+        if (Kii.Solve(Kib, X) < 0)  {
+            opserr << "SuperElement::condense() - the interior stiffness "
+                << "is singular, are the interior nodes fixed enough?\n";
+            return -1;
+        }
+    }
+    
+    Matrix T(m,nb);
+    for (int i=0; i<nb; i++)
+        T(i,i) = 1.0;
+    T.Assemble(X, nb, 0, -1.0);
+    
+    K.resize(nb,nb);
+    K.addMatrixTripleProduct(0.0, T, Kf, 1.0);
+    M.resize(nb,nb);
+    M.addMatrixTripleProduct(0.0, T, Mf, 1.0);
+    C.resize(nb,nb);
+    C.addMatrixTripleProduct(0.0, T, Cf, 1.0);
+    R.resize(ni,nb);
+    R.Zero();
+    R.addMatrix(0.0, X, -1.0);
+    
+    intNodes.resize(ni);
+    intDOFs.resize(ni);
+    for (size_t i=0; i<nodeOrder.size(); i++)  {
+        int start = nodeStart[nodeOrder[i]];
+        if (start < nb)
+            continue;
+        int ndf = theDomain.getNode(nodeOrder[i])->getNumberDOF();
+        for (int d=0; d<ndf; d++)  {
+            int row = eqn[start+d] - nb;
+            if (row >= 0)  {
+                intNodes(row) = nodeOrder[i];
+                intDOFs(row) = d;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+int SuperElement::save(const char *fileName)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::binary);
+    if (!file.is_open())  {
+        opserr << "SuperElement::save() - could not open file "
+            << fileName << endln;
+        return -1;
+    }
+    
+    int numInterior = theRecovery.noRows();
+    int header[3] = {numExternalNodes, numDOF, numInterior};
+    file.write(superElementMagic, sizeof(superElementMagic));
+    file.write((const char *)header, sizeof(header));
+    for (int i=0; i<numExternalNodes; i++)  {
+        int node = connectedExternalNodes(i);
+        file.write((const char *)&node, sizeof(int));
+    }
+    
+    // matrices column by column, as they are stored
+    const Matrix *theMatrices[3] = {&theStiff, &theMass, &theDamp};
+    for (int k=0; k<3; k++)
+        for (int j=0; j<numDOF; j++)
+            for (int i=0; i<numDOF; i++)  {
+                double v = (*theMatrices[k])(i,j);
+                file.write((const char *)&v, sizeof(double));
+            }
+    for (int j=0; j<numDOF; j++)
+        for (int i=0; i<numInterior; i++)  {
+            double v = theRecovery(i,j);
+            file.write((const char *)&v, sizeof(double));
+        }
+    for (int i=0; i<numInterior; i++)  {
+        int data[2] = {interiorNodes(i), interiorDOFs(i)};
+        file.write((const char *)data, sizeof(data));
+    }
+    
+    if (!file.good())  {
+        opserr << "SuperElement::save() - failed to write file "
+            << fileName << endln;
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+SuperElement *SuperElement::load(int tag, const ID &nodes, const char *fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open())  {
+        opserr << "SuperElement::load() - could not open file "
+            << fileName << endln;
+        return 0;
+    }
+    
+    char magic[sizeof(superElementMagic)];
+    int header[3];
+    file.read(magic, sizeof(magic));
+    file.read((char *)header, sizeof(header));
+    if (!file.good() || memcmp(magic, superElementMagic, sizeof(magic)) != 0)  {
+        opserr << "SuperElement::load() - " << fileName
+            << " is not a superElement file\n";
+        return 0;
+    }
+    
+    int numNodes = header[0];
+    int nb = header[1];
+    int ni = header[2];
+    if (numNodes != nodes.Size())  {
+        opserr << "SuperElement::load() - " << fileName << " has "
+            << numNodes << " boundary nodes, " << nodes.Size() << " given\n";
+        return 0;
+    }
+    for (int i=0; i<numNodes; i++)  {
+        int node;
+        file.read((char *)&node, sizeof(int));
+    }
+    
+    // the matrices are read straight into their storage
+    Matrix K(nb,nb), M(nb,nb), C(nb,nb), R(ni,nb);
+    Matrix *theMatrices[4] = {&K, &M, &C, &R};
+    for (int k=0; k<4; k++)
+        for (int j=0; j<nb; j++)
+            for (int i=0; i<theMatrices[k]->noRows(); i++)  {
+                double v;
+                file.read((char *)&v, sizeof(double));
+                (*theMatrices[k])(i,j) = v;
+            }
+    ID intNodes(ni), intDOFs(ni);
+    for (int i=0; i<ni; i++)  {
+        int data[2];
+        file.read((char *)data, sizeof(data));
+        intNodes(i) = data[0];
+        intDOFs(i) = data[1];
+    }
+    
+    if (!file.good())  {
+        opserr << "SuperElement::load() - failed to read file "
+            << fileName << endln;
+        return 0;
+    }
+    
+    return new SuperElement(tag, nodes, K, M, C, R, intNodes, intDOFs);
+}
+
+
+int SuperElement::getNumExternalNodes() const
+{
+    return numExternalNodes;
+}
+
+
+const ID& SuperElement::getExternalNodes()
+{
+    return connectedExternalNodes;
+}
+
+
+Node** SuperElement::getNodePtrs()
+{
+    return theNodes;
+}
+
+
+int SuperElement::getNumDOF()
+{
+    return numDOF;
+}
+
+
+// to set a link to the enclosing Domain and to set the node pointers.
+void SuperElement::setDomain(Domain *theDomain)
+{
+    // check Domain is not null - invoked when object removed from a domain
+    int i;
+    if (!theDomain)  {
+        for (i=0; i<numExternalNodes; i++)
+            theNodes[i] = 0;
+        return;
+    }
+    
+    // now set the node pointers
+    for (i=0; i<numExternalNodes; i++)
+        theNodes[i] = theDomain->getNode(connectedExternalNodes(i));
+    
+    // if can't find all - send a warning message
+    int ndof = 0;
+    for (i=0; i<numExternalNodes; i++)  {
+        if (!theNodes[i])  {
+            opserr << "SuperElement::setDomain() - Nd" << i << ": " 
+                << connectedExternalNodes(i) << " does not exist in the "
+                << "model for SuperElement ele: " << this->getTag() << endln;
+            return;
+        }
+        ndof += theNodes[i]->getNumberDOF();
+    }
+    
+    // the condensed matrices must fit the nodes
+    if (ndof != numDOF)  {
+        opserr << "SuperElement::setDomain() "
+            << "- the nodes have " << ndof << " DOFs, the condensed "
+            << "matrices " << numDOF << endln;
+        return;
+    }
+    
+    // call the base class method
+    this->DomainComponent::setDomain(theDomain);
+}
+
+
+int SuperElement::commitState()
+{
+    // does nothing
+    return 0;
+}
+
+
+int SuperElement::revertToLastCommit()
+{
+    // does nothing
+    return 0;
+}
+
+
+int SuperElement::revertToStart()
+{
+    // does nothing
+    return 0;
+}
+
+
+int SuperElement::update()
+{
+    // does nothing
+    return 0;
+}
+
+
+const Matrix& SuperElement::getTangentStiff()
+{
+    return theStiff;
+}
+
+
+const Matrix& SuperElement::getInitialStiff()
+{
+    return theStiff;
+}
+
+
+const Matrix& SuperElement::getDamp()
+{
+    // the condensed damping plus any Rayleigh damping set on the element
+    theMatrix = this->Element::getDamp();
+    theMatrix.addMatrix(1.0, theDamp, 1.0);
+    
+    return theMatrix;
+}
+
+
+const Matrix& SuperElement::getMass()
+{
+    return theMass;
+}
+
+
+void SuperElement::zeroLoad()
+{
+    theLoad.Zero();
+}
+
+
+int SuperElement::addLoad(ElementalLoad *theLoad, double loadFactor)
+{
+    opserr <<"SuperElement::addLoad() - "
+        << "load type unknown for element: "
+        << this->getTag() << endln;
+    
+    return -1;
+}
+
+
+int SuperElement::addInertiaLoadToUnbalance(const Vector &accel)
+{
+    int ndim = 0, i;
+    Vector Raccel(numDOF);
+    
+    // assemble Raccel vector
+    for (i=0; i<numExternalNodes; i++ )  {
+        Raccel.Assemble(theNodes[i]->getRV(accel), ndim);
+        ndim += theNodes[i]->getNumberDOF();
+    }
+    
+    // want to add ( - fact * M R * accel ) to unbalance
+    theLoad.addMatrixVector(1.0, theMass, Raccel, -1.0);
+    
+    return 0;
+}
+
+
+void SuperElement::getNodalVector(Vector &v, int type)
+{
+    int ndim = 0;
+    for (int i=0; i<numExternalNodes; i++ )  {
+        if (type == 0)
+            v.Assemble(theNodes[i]->getTrialDisp(), ndim);
+        else if (type == 1)
+            v.Assemble(theNodes[i]->getTrialVel(), ndim);
+        else
+            v.Assemble(theNodes[i]->getTrialAccel(), ndim);
+        ndim += theNodes[i]->getNumberDOF();
+    }
+}
+
+
+const Vector& SuperElement::getResistingForce()
+{
+    // the substructure is linear, the forces are K times the displacements
+    static Vector disp;
+    disp.resize(numDOF);
+    this->getNodalVector(disp, 0);
+    theVector.addMatrixVector(0.0, theStiff, disp, 1.0);
+    
+    return theVector;
+}
+
+
+const Vector& SuperElement::getResistingForceIncInertia()
+{
+    this->getResistingForce();
+    
+    // subtract external load
+    theVector.addVector(1.0, theLoad, -1.0);
+    
+    // add the damping and inertia forces
+    static Vector v;
+    v.resize(numDOF);
+    this->getNodalVector(v, 1);
+    theVector.addMatrixVector(1.0, this->getDamp(), v, 1.0);
+    this->getNodalVector(v, 2);
+    theVector.addMatrixVector(1.0, theMass, v, 1.0);
+    
+    return theVector;
+}
+
+
+const Vector& SuperElement::getInteriorDisp()
+{
+    static Vector disp;
+    disp.resize(numDOF);
+    this->getNodalVector(disp, 0);
+    theInterior.addMatrixVector(0.0, theRecovery, disp, 1.0);
+    
+    return theInterior;
+}
+
+
+int SuperElement::sendSelf(int commitTag, Channel &sChannel)
+{
+    // send element parameters
+    static ID idData(4);
+    idData(0) = this->getTag();
+    idData(1) = numExternalNodes;
+    idData(2) = numDOF;
+    idData(3) = theRecovery.noRows();
+    sChannel.sendID(0, commitTag, idData);
+    
+    // send the nodes and the condensed matrices
+    sChannel.sendID(0, commitTag, connectedExternalNodes);
+    sChannel.sendMatrix(0, commitTag, theStiff);
+    sChannel.sendMatrix(0, commitTag, theMass);
+    sChannel.sendMatrix(0, commitTag, theDamp);
+    if (theRecovery.noRows() > 0)  {
+        sChannel.sendMatrix(0, commitTag, theRecovery);
+        sChannel.sendID(0, commitTag, interiorNodes);
+        sChannel.sendID(0, commitTag, interiorDOFs);
+    }
+    
+    return 0;
+}
+
+
+int SuperElement::recvSelf(int commitTag, Channel &rChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    // delete dynamic memory
+    if (theNodes != 0)
+        delete [] theNodes;
+    
+    // receive element parameters
+    static ID idData(4);
+    rChannel.recvID(0, commitTag, idData);
+    this->setTag(idData(0));
+    numExternalNodes = idData(1);
+    numDOF = idData(2);
+    int numInterior = idData(3);
+    
+    // initialize nodes and receive them
+    connectedExternalNodes.resize(numExternalNodes);
+    rChannel.recvID(0, commitTag, connectedExternalNodes);
+    theNodes = new Node* [numExternalNodes];
+    if (!theNodes)  {
+        opserr << "SuperElement::recvSelf() "
+            << "- failed to create node array\n";
+        return -1;
+    }
+    for (int i=0; i<numExternalNodes; i++)
+        theNodes[i] = 0;
+    
+    // receive the condensed matrices
+    theStiff.resize(numDOF,numDOF);
+    theMass.resize(numDOF,numDOF);
+    theDamp.resize(numDOF,numDOF);
+    rChannel.recvMatrix(0, commitTag, theStiff);
+    rChannel.recvMatrix(0, commitTag, theMass);
+    rChannel.recvMatrix(0, commitTag, theDamp);
+    theRecovery.resize(numInterior,numDOF);
+    interiorNodes.resize(numInterior);
+    interiorDOFs.resize(numInterior);
+    if (numInterior > 0)  {
+        rChannel.recvMatrix(0, commitTag, theRecovery);
+        rChannel.recvID(0, commitTag, interiorNodes);
+        rChannel.recvID(0, commitTag, interiorDOFs);
+    }
+    
+    theMatrix.resize(numDOF,numDOF);
+    theVector.resize(numDOF);
+    theLoad.resize(numDOF);
+    theInterior.resize(numInterior);
+    
+    return 0;
+}
+
+
+int SuperElement::displaySelf(Renderer &theViewer,
+    int displayMode, float fact, const char **modes, int numMode)
+{
+    int rValue = 0;
+
+    if (numExternalNodes > 1) {
+        for (int i = 0; i < numExternalNodes - 1; i++) {
+            static Vector v1(3);
+            static Vector v2(3);
+
+            theNodes[i]->getDisplayCrds(v1, fact, displayMode);
+            theNodes[i + 1]->getDisplayCrds(v2, fact, displayMode);
+
+            rValue += theViewer.drawLine(v1, v2, 1.0, 1.0, this->getTag(), 0);
+        }
+    }
+
+    return rValue;
+}
+
+
+void SuperElement::Print(OPS_Stream &s, int flag)
+{
+    int i;
+    if (flag == 0)  {
+        // print everything
+        s << "Element: " << this->getTag() << endln;
+        s << "  type: SuperElement";
+        for (i=0; i<numExternalNodes; i++ )
+            s << ", Node" << i+1 << ": " << connectedExternalNodes(i);
+        s << endln;
+        s << "  condensed DOFs: " << numDOF << ", interior DOFs: "
+            << theRecovery.noRows() << endln;
+        // determine resisting forces in global system
+        s << "  resisting force: " << this->getResistingForce() << endln;
+    } else if (flag == 1)  {
+        // does nothing
+    }
+}
+
+
+Response* SuperElement::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    Response *theResponse = 0;
+
+    int i;
+    char outputData[32];
+
+    output.tag("ElementOutput");
+    output.attr("eleType","SuperElement");
+    output.attr("eleTag",this->getTag());
+    for (i=0; i<numExternalNodes; i++ )  {
+        sprintf(outputData,"node%d",i+1);
+        output.attr(outputData,connectedExternalNodes[i]);
+    }
+
+    // global forces
+    if (strcmp(argv[0],"force") == 0 || strcmp(argv[0],"forces") == 0 ||
+        strcmp(argv[0],"globalForce") == 0 || strcmp(argv[0],"globalForces") == 0)
+    {
+        for (i=0; i<numDOF; i++)  {
+            sprintf(outputData,"P%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ElementResponse(this, 1, theVector);
+    }
+
+    // displacements of the condensed interior DOFs
+    else if (strcmp(argv[0],"interiorDisp") == 0 ||
+        strcmp(argv[0],"interiorDisplacement") == 0)
+    {
+        for (i=0; i<theRecovery.noRows(); i++)  {
+            sprintf(outputData,"U%d_%d",interiorNodes(i),interiorDOFs(i)+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ElementResponse(this, 2, theInterior);
+    }
+
+    output.endTag(); // ElementOutput
+
+    return theResponse;
+}
+
+
+int SuperElement::getResponse(int responseID, Information &eleInfo)
+{
+    switch (responseID)  {
+    case 1:  // global forces
+        return eleInfo.setVector(this->getResistingForce());
+        
+    case 2:  // interior displacements
+        return eleInfo.setVector(this->getInteriorDisp());
+        
+    default:
+        return -1;
+    }
+}
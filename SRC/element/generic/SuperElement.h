@@ -0,0 +1,126 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SuperElement_h
+#define SuperElement_h
+
+// Description: This file contains the class definition for SuperElement.
+// A SuperElement is a linear substructure condensed to the DOFs of its
+// boundary nodes. The reduced stiffness, mass and damping are computed
+// once by static (Guyan) condensation of a set of elements, which are
+// then removed from the domain, or read from a file written before.
+// The matrix giving the interior displacements from the boundary ones
+// is kept so that the interior response can be recovered on demand.
+
+#include <Element.h>
+#include <Matrix.h>
+
+class SuperElement : public Element
+{
+public:
+    // constructors
+    SuperElement(int tag, const ID &nodes,
+        const Matrix &K, const Matrix &M, const Matrix &C,
+        const Matrix &R, const ID &interiorNodes, const ID &interiorDOFs);
+    SuperElement();
+    
+    // destructor
+    ~SuperElement();
+    
+    // method to get class type
+    const char *getClassType() const {return "SuperElement";};
+    
+    // condense the elements eleTags of theDomain to the DOFs of nodes,
+    // the interior DOFs that have a single point constraint are dropped
+    static int condense(Domain &theDomain, const ID &nodes, const ID &eleTags,
+        Matrix &K, Matrix &M, Matrix &C, Matrix &R,
+        ID &interiorNodes, ID &interiorDOFs);
+    
+    // the condensed matrices in a binary file
+    int save(const char *fileName);
+    static SuperElement *load(int tag, const ID &nodes, const char *fileName);
+    
+    // public methods to obtain information about dof & connectivity
+    int getNumExternalNodes() const;
+    const ID &getExternalNodes();
+    Node **getNodePtrs();
+    int getNumDOF();
+    void setDomain(Domain *theDomain);
+    bool hasConstantTangent(void) {return true;};
+    
+    // public methods to set the state of the element
+    int commitState();
+    int revertToLastCommit();
+    int revertToStart();
+    int update();
+    
+    // public methods to obtain stiffness, mass, damping and residual information
+    const Matrix &getTangentStiff();
+    const Matrix &getInitialStiff();
+    const Matrix &getDamp();
+    const Matrix &getMass();
+    
+    void zeroLoad();
+    int addLoad(ElementalLoad *theLoad, double loadFactor);
+    int addInertiaLoadToUnbalance(const Vector &accel);
+    
+    const Vector &getResistingForce();
+    const Vector &getResistingForceIncInertia();
+    
+    // the displacements of the interior DOFs
+    const Vector &getInteriorDisp();
+    
+    // public methods for element output
+    int sendSelf(int commitTag, Channel &sChannel);
+    int recvSelf(int commitTag, Channel &rChannel, FEM_ObjectBroker &theBroker);
+    int displaySelf(Renderer &theViewer, int displayMode, float fact, const char **modes, int numMode);
+    void Print(OPS_Stream &s, int flag = 0);
+    
+    // public methods for element recorder
+    Response *setResponse(const char **argv, int argc, OPS_Stream &s);
+    int getResponse(int responseID, Information &eleInfo);
+    
+protected:
+    
+private:
+    void getNodalVector(Vector &v, int type);
+    
+    // private attributes - a copy for each object of the class
+    ID connectedExternalNodes;  // contains the tags of the boundary nodes
+    
+    int numExternalNodes;       // number of boundary nodes
+    int numDOF;                 // number of boundary DOF
+    
+    Matrix theStiff;            // condensed stiffness matrix
+    Matrix theMass;             // condensed mass matrix
+    Matrix theDamp;             // condensed damping matrix
+    Matrix theRecovery;         // interior from boundary displacements
+    ID interiorNodes;           // node and dof of each interior row
+    ID interiorDOFs;
+    
+    Matrix theMatrix;           // objects matrix
+    Vector theVector;           // objects vector
+    Vector theLoad;             // load vector
+    Vector theInterior;         // interior displacements
+    
+    Node **theNodes;
+};
+
+#endif
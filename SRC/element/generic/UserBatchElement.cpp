@@ -0,0 +1,747 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the UserBatchElement class.
+
+#include "UserBatchElement.h"
+
+#include <Domain.h>
+#include <Node.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <Renderer.h>
+#include <Information.h>
+#include <ElementResponse.h>
+
+#include <map>
+#include <vector>
+#include <string.h>
+#include <elementAPI.h>
+
+
+// the elements of a type, with their rows of the arrays passed to the
+// function of the type
+class UserBatchType
+{
+public:
+    UserBatchType(int tag);
+    
+    int join(UserBatchElement *theEle);
+    void leave(UserBatchElement *theEle);
+    void setNumState(int num);
+    
+    int update(int i);
+    int evaluate();
+    int evaluateInitial();
+    int fail();
+    
+    int tag;
+    int numState;
+    int numCrd;
+    int numDOF;
+    UserBatchFunction fn;
+    void *data;
+    void (*release)(void *);
+    
+    std::vector<UserBatchElement *> members;
+    std::vector<char> updated;  // members updated since the last evaluation
+    int numUpdated;
+    bool current;               // K and P are those of the trial state
+    bool failed;                // the last evaluation failed, K and P are zero
+    bool haveInit;              // Kinit is that of the members
+    
+    std::vector<double> x, u, state, stateCommit, K, P, Kinit;
+};
+
+static std::map<int, UserBatchType *> theUserBatchTypes;
+
+
+UserBatchType::UserBatchType(int t)
+    :tag(t), numState(0), numCrd(0), numDOF(0),
+    fn(0), data(0), release(0),
+    numUpdated(0), current(false), failed(false), haveInit(false)
+{
+    
+}
+
+
+int UserBatchType::join(UserBatchElement *theEle)
+{
+    int crd = 0;
+    int dof = 0;
+    for (int i=0; i<theEle->numExternalNodes; i++)  {
+        crd += theEle->theNodes[i]->getCrds().Size();
+        dof += theEle->theNodes[i]->getNumberDOF();
+    }
+    
+    // all the elements of a type have the same layout
+    if (members.empty())  {
+        numCrd = crd;
+        numDOF = dof;
+    } else if (crd != numCrd || dof != numDOF)  {
+        opserr << "UserBatchElement::setDomain() - element " << theEle->getTag()
+            << " has " << dof << " DOFs and " << crd << " coordinates, the other elements of type "
+            << tag << " have " << numDOF << " and " << numCrd << endln;
+        return -1;
+    }
+    
+    int numEle = (int)members.size() + 1;
+    x.resize(numEle*numCrd);
+    u.resize(numEle*numDOF, 0.0);
+    state.resize(numEle*numState, 0.0);
+    stateCommit.resize(numEle*numState, 0.0);
+    K.resize(numEle*numDOF*numDOF, 0.0);
+    P.resize(numEle*numDOF, 0.0);
+    updated.push_back(0);
+    
+    double *row = &x[(numEle-1)*numCrd];
+    for (int i=0; i<theEle->numExternalNodes; i++)  {
+        const Vector &crds = theEle->theNodes[i]->getCrds();
+        for (int j=0; j<crds.Size(); j++)
+            *row++ = crds(j);
+    }
+    
+    theEle->index = numEle-1;
+    members.push_back(theEle);
+    current = false;
+    haveInit = false;
+    
+    return 0;
+}
+
+
+void UserBatchType::leave(UserBatchElement *theEle)
+{
+    int i = theEle->index;
+    int last = (int)members.size() - 1;
+    if (i < 0 || i > last || members[i] != theEle)
+        return;
+    
+    // the last element takes the place of the one leaving
+    if (i != last)  {
+        memcpy(&x[i*numCrd], &x[last*numCrd], numCrd*sizeof(double));
+        memcpy(&u[i*numDOF], &u[last*numDOF], numDOF*sizeof(double));
+        memcpy(&P[i*numDOF], &P[last*numDOF], numDOF*sizeof(double));
+        memcpy(&K[i*numDOF*numDOF], &K[last*numDOF*numDOF], numDOF*numDOF*sizeof(double));
+        if (numState > 0)  {
+            memcpy(&state[i*numState], &state[last*numState], numState*sizeof(double));
+            memcpy(&stateCommit[i*numState], &stateCommit[last*numState], numState*sizeof(double));
+        }
+        members[i] = members[last];
+        members[i]->index = i;
+    }
+    
+    if (updated[i] != 0)
+        numUpdated--;
+    updated[i] = updated[last];
+    
+    members.pop_back();
+    updated.pop_back();
+    x.resize(last*numCrd);
+    u.resize(last*numDOF);
+    P.resize(last*numDOF);
+    K.resize(last*numDOF*numDOF);
+    state.resize(last*numState);
+    stateCommit.resize(last*numState);
+    haveInit = false;
+    
+    theEle->index = -1;
+}
+
+
+void UserBatchType::setNumState(int num)
+{
+    if (num < 0)
+        num = 0;
+    if (num == numState)
+        return;
+    
+    numState = num;
+    state.assign(members.size()*numState, 0.0);
+    stateCommit.assign(members.size()*numState, 0.0);
+    current = false;
+    haveInit = false;
+}
+
+
+// the function is called once all the members have been updated, the
+// members are normally all updated one after the other by the Domain; a
+// failed evaluation, also one made for getTangentStiff() or
+// getResistingForce(), fails the updates until an evaluation succeeds
+int UserBatchType::update(int i)
+{
+    current = false;
+    if (updated[i] == 0)  {
+        updated[i] = 1;
+        numUpdated++;
+    }
+    
+    if (numUpdated == (int)members.size())
+        return this->evaluate();
+    
+    return failed ? -1 : 0;
+}
+
+
+int UserBatchType::evaluate()
+{
+    int numEle = (int)members.size();
+    for (int i=0; i<numEle; i++)
+        updated[i] = 0;
+    numUpdated = 0;
+    current = true;
+    failed = false;
+    
+    if (numEle == 0)
+        return 0;
+    
+    if (fn == 0)  {
+        opserr << "WARNING UserBatchElement - no function set for type " << tag << endln;
+        return this->fail();
+    }
+    
+    // the trial displacements of all the members
+    for (int i=0; i<numEle; i++)  {
+        UserBatchElement *theEle = members[i];
+        double *row = &u[i*numDOF];
+        for (int j=0; j<theEle->numExternalNodes; j++)  {
+            const Vector &disp = theEle->theNodes[j]->getTrialDisp();
+            for (int k=0; k<disp.Size(); k++)
+                *row++ = disp(k);
+        }
+    }
+    
+    // the function starts from the committed state
+    state = stateCommit;
+    
+    int res = fn(numEle, numCrd, numDOF, numState, &x[0], &u[0],
+        numState > 0 ? &state[0] : 0, &K[0], &P[0], data);
+    if (res != 0)  {
+        opserr << "WARNING UserBatchElement - the function of type " << tag << " failed\n";
+        return this->fail();
+    }
+    
+    return 0;
+}
+
+
+// flags the evaluation as failed; no tangent or resisting force is made
+// up for the members, they are zero until the next evaluation
+int UserBatchType::fail()
+{
+    failed = true;
+    K.assign(K.size(), 0.0);
+    P.assign(P.size(), 0.0);
+    
+    return -1;
+}
+
+
+// the tangents at zero displacements from the start state
+int UserBatchType::evaluateInitial()
+{
+    int numEle = (int)members.size();
+    haveInit = true;
+    
+    if (numEle == 0 || fn == 0)
+        return -1;
+    
+    Kinit.assign(numEle*numDOF*numDOF, 0.0);
+    std::vector<double> uZero(numEle*numDOF, 0.0);
+    std::vector<double> stateStart(numEle*numState, 0.0);
+    std::vector<double> PZero(numEle*numDOF, 0.0);
+    
+    int res = fn(numEle, numCrd, numDOF, numState, &x[0], &uZero[0],
+        numState > 0 ? &stateStart[0] : 0, &Kinit[0], &PZero[0], data);
+    if (res != 0)  {
+        opserr << "WARNING UserBatchElement - the function of type " << tag << " failed\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+void* OPS_UserBatchElement()
+{
+    if (OPS_GetNumRemainingInputArgs() < 3) {
+        opserr << "WARNING insufficient arguments\n";
+        opserr << "Want: element userBatch eleTag typeTag Nd1 Nd2 ...\n";
+        return 0;
+    }
+    
+    // tags
+    int idata[2];
+    int numdata = 2;
+    if (OPS_GetIntInput(&numdata, idata) < 0) {
+        opserr << "WARNING: invalid tags\n";
+        return 0;
+    }
+    
+    if (!UserBatchElement::hasType(idata[1])) {
+        opserr << "WARNING userBatch element " << idata[0] << " - type "
+            << idata[1] << " has no function set\n";
+        return 0;
+    }
+    
+    // nodes
+    int numNodes = OPS_GetNumRemainingInputArgs();
+    ID nodes(numNodes);
+    for (int i=0; i<numNodes; i++) {
+        int node;
+        numdata = 1;
+        if (OPS_GetIntInput(&numdata, &node) < 0) {
+            opserr << "WARNING: invalid node tag for userBatch element " << idata[0] << endln;
+            return 0;
+        }
+        nodes(i) = node;
+    }
+    
+    return new UserBatchElement(idata[0], idata[1], nodes);
+}
+
+
+int UserBatchElement::setTypeFunction(int typeTag, int numState,
+    UserBatchFunction fn, void *data, void (*release)(void *))
+{
+    UserBatchType *theType = 0;
+    std::map<int, UserBatchType *>::iterator it = theUserBatchTypes.find(typeTag);
+    if (it == theUserBatchTypes.end())  {
+        theType = new UserBatchType(typeTag);
+        theUserBatchTypes[typeTag] = theType;
+    } else
+        theType = it->second;
+    
+    if (theType->release != 0 && theType->data != 0)
+        theType->release(theType->data);
+    
+    theType->fn = fn;
+    theType->data = data;
+    theType->release = release;
+    theType->setNumState(numState);
+    theType->current = false;
+    theType->haveInit = false;
+    
+    return 0;
+}
+
+
+bool UserBatchElement::hasType(int typeTag)
+{
+    std::map<int, UserBatchType *>::iterator it = theUserBatchTypes.find(typeTag);
+    return it != theUserBatchTypes.end() && it->second->fn != 0;
+}
+
+
+UserBatchElement::UserBatchElement(int tag, int tt, const ID &nodes)
+    : Element(tag, ELE_TAG_UserBatchElement),
+    connectedExternalNodes(nodes), theNodes(0),
+    numExternalNodes(nodes.Size()), numDOF(0),
+    typeTag(tt), theType(0), index(-1)
+{
+    // initialize node pointers
+    theNodes = new Node* [numExternalNodes];
+    for (int i=0; i<numExternalNodes; i++)
+        theNodes[i] = 0;
+}
+
+
+UserBatchElement::UserBatchElement()
+    : Element(0, ELE_TAG_UserBatchElement),
+    connectedExternalNodes(0), theNodes(0),
+    numExternalNodes(0), numDOF(0),
+    typeTag(0), theType(0), index(-1)
+{
+    
+}
+
+
+UserBatchElement::~UserBatchElement()
+{
+    if (theType != 0)
+        theType->leave(this);
+    
+    if (theNodes != 0)
+        delete [] theNodes;
+}
+
+
+int UserBatchElement::getNumExternalNodes() const
+{
+    return numExternalNodes;
+}
+
+
+const ID& UserBatchElement::getExternalNodes()
+{
+    return connectedExternalNodes;
+}
+
+
+Node** UserBatchElement::getNodePtrs()
+{
+    return theNodes;
+}
+
+
+int UserBatchElement::getNumDOF()
+{
+    return numDOF;
+}
+
+
+// to set a link to the enclosing Domain, to set the node pointers and to
+// join the elements of the type
+void UserBatchElement::setDomain(Domain *theDomain)
+{
+    // check Domain is not null - invoked when object removed from a domain
+    int i;
+    if (!theDomain)  {
+        if (theType != 0)
+            theType->leave(this);
+        theType = 0;
+        for (i=0; i<numExternalNodes; i++)
+            theNodes[i] = 0;
+        return;
+    }
+    
+    // now set the node pointers
+    numDOF = 0;
+    for (i=0; i<numExternalNodes; i++)  {
+        theNodes[i] = theDomain->getNode(connectedExternalNodes(i));
+        if (!theNodes[i])  {
+            opserr << "UserBatchElement::setDomain() - Nd" << i << ": " 
+                << connectedExternalNodes(i) << " does not exist in the "
+                << "model for UserBatchElement ele: " << this->getTag() << endln;
+            return;
+        }
+        numDOF += theNodes[i]->getNumberDOF();
+    }
+    
+    theMatrix.resize(numDOF,numDOF);
+    theVector.resize(numDOF);
+    theLoad.resize(numDOF);
+    theMatrix.Zero();
+    theVector.Zero();
+    theLoad.Zero();
+    
+    if (theType == 0)  {
+        std::map<int, UserBatchType *>::iterator it = theUserBatchTypes.find(typeTag);
+        if (it == theUserBatchTypes.end())  {
+            opserr << "UserBatchElement::setDomain() - type " << typeTag
+                << " does not exist for UserBatchElement ele: " << this->getTag() << endln;
+            return;
+        }
+        if (it->second->join(this) < 0)
+            return;
+        theType = it->second;
+    }
+    
+    // call the base class method
+    this->DomainComponent::setDomain(theDomain);
+}
+
+
+int UserBatchElement::commitState()
+{
+    int retVal = 0;
+    if ((retVal = this->Element::commitState()) != 0)  {
+        opserr << "UserBatchElement::commitState () - failed in base class";
+    }
+    
+    if (theType == 0)
+        return -1;
+    
+    // the state left by a failed evaluation is not kept
+    if (theType->failed)  {
+        opserr << "WARNING UserBatchElement::commitState() - element " << this->getTag()
+            << " - the last evaluation of type " << typeTag << " failed\n";
+        return -1;
+    }
+    
+    int numState = theType->numState;
+    if (numState > 0)
+        memcpy(&theType->stateCommit[index*numState], &theType->state[index*numState],
+            numState*sizeof(double));
+    
+    return retVal;
+}
+
+
+int UserBatchElement::revertToLastCommit()
+{
+    // the function starts from the committed state anyway
+    if (theType != 0)  {
+        theType->current = false;
+        theType->failed = false;
+    }
+    
+    return 0;
+}
+
+
+int UserBatchElement::revertToStart()
+{
+    if (theType == 0)
+        return 0;
+    
+    int numState = theType->numState;
+    for (int i=0; i<numState; i++)
+        theType->stateCommit[index*numState+i] = 0.0;
+    theType->current = false;
+    theType->failed = false;
+    
+    return 0;
+}
+
+
+int UserBatchElement::update()
+{
+    if (theType == 0)
+        return -1;
+    
+    return theType->update(index);
+}
+
+
+const Matrix& UserBatchElement::getTangentStiff()
+{
+    if (theType == 0)
+        return theMatrix;
+    
+    // a failure is flagged for update() and commitState()
+    if (!theType->current)
+        theType->evaluate();
+    
+    // the stacked tangents are row major
+    const double *Kdata = &theType->K[index*numDOF*numDOF];
+    for (int i=0; i<numDOF; i++)
+        for (int j=0; j<numDOF; j++)
+            theMatrix(i,j) = Kdata[i*numDOF+j];
+    
+    return theMatrix;
+}
+
+
+const Matrix& UserBatchElement::getInitialStiff()
+{
+    if (theType == 0)
+        return theMatrix;
+    
+    if (!theType->haveInit)
+        theType->evaluateInitial();
+    
+    if (theType->Kinit.size() < (size_t)(index+1)*numDOF*numDOF)  {
+        theMatrix.Zero();
+        return theMatrix;
+    }
+    
+    const double *Kdata = &theType->Kinit[index*numDOF*numDOF];
+    for (int i=0; i<numDOF; i++)
+        for (int j=0; j<numDOF; j++)
+            theMatrix(i,j) = Kdata[i*numDOF+j];
+    
+    return theMatrix;
+}
+
+
+const Matrix& UserBatchElement::getMass()
+{
+    // the function gives no mass
+    theMatrix.Zero();
+    
+    return theMatrix;
+}
+
+
+void UserBatchElement::zeroLoad()
+{
+    theLoad.Zero();
+}
+
+
+int UserBatchElement::addLoad(ElementalLoad *theLoad, double loadFactor)
+{
+    opserr <<"UserBatchElement::addLoad() - "
+        << "load type unknown for element: "
+        << this->getTag() << endln;
+    
+    return -1;
+}
+
+
+int UserBatchElement::addInertiaLoadToUnbalance(const Vector &accel)
+{
+    // the element has no mass
+    return 0;
+}
+
+
+const Vector& UserBatchElement::getResistingForce()
+{
+    if (theType == 0)
+        return theVector;
+    
+    // a failure is flagged for update() and commitState()
+    if (!theType->current)
+        theType->evaluate();
+    
+    const double *Pdata = &theType->P[index*numDOF];
+    for (int i=0; i<numDOF; i++)
+        theVector(i) = Pdata[i];
+    
+    return theVector;
+}
+
+
+const Vector& UserBatchElement::getResistingForceIncInertia()
+{
+    this->getResistingForce();
+    
+    // subtract external load
+    theVector.addVector(1.0, theLoad, -1.0);
+    
+    // add the damping forces if rayleigh damping
+    if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+        theVector.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+    
+    return theVector;
+}
+
+
+int UserBatchElement::sendSelf(int commitTag, Channel &sChannel)
+{
+    // the function of the type can not be sent
+    opserr << "UserBatchElement::sendSelf() - not implemented\n";
+    return -1;
+}
+
+
+int UserBatchElement::recvSelf(int commitTag, Channel &rChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    opserr << "UserBatchElement::recvSelf() - not implemented\n";
+    return -1;
+}
+
+
+int UserBatchElement::displaySelf(Renderer &theViewer,
+    int displayMode, float fact, const char **modes, int numMode)
+{
+    int rValue = 0;
+
+    if (numExternalNodes > 1) {
+        for (int i = 0; i < numExternalNodes - 1; i++) {
+            static Vector v1(3);
+            static Vector v2(3);
+
+            theNodes[i]->getDisplayCrds(v1, fact, displayMode);
+            theNodes[i + 1]->getDisplayCrds(v2, fact, displayMode);
+
+            rValue += theViewer.drawLine(v1, v2, 1.0, 1.0, this->getTag(), 0);
+        }
+    }
+
+    return rValue;
+}
+
+
+void UserBatchElement::Print(OPS_Stream &s, int flag)
+{
+    int i;
+    if (flag == 0)  {
+        // print everything
+        s << "Element: " << this->getTag() << endln;
+        s << "  type: UserBatchElement, userType: " << typeTag;
+        for (i=0; i<numExternalNodes; i++ )
+            s << ", Node" << i+1 << ": " << connectedExternalNodes(i);
+        s << endln;
+        if (theType != 0)
+            s << "  elements of the type: " << (int)theType->members.size()
+                << ", state variables: " << theType->numState << endln;
+    } else if (flag == 1)  {
+        // does nothing
+    }
+}
+
+
+Response* UserBatchElement::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    Response *theResponse = 0;
+
+    int i;
+    char outputData[32];
+
+    output.tag("ElementOutput");
+    output.attr("eleType","UserBatchElement");
+    output.attr("eleTag",this->getTag());
+    for (i=0; i<numExternalNodes; i++ )  {
+        sprintf(outputData,"node%d",i+1);
+        output.attr(outputData,connectedExternalNodes[i]);
+    }
+
+    // global forces
+    if (strcmp(argv[0],"force") == 0 || strcmp(argv[0],"forces") == 0 ||
+        strcmp(argv[0],"globalForce") == 0 || strcmp(argv[0],"globalForces") == 0)
+    {
+        for (i=0; i<numDOF; i++)  {
+            sprintf(outputData,"P%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ElementResponse(this, 1, theVector);
+    }
+
+    // the trial state kept for the function
+    else if (strcmp(argv[0],"state") == 0 && theType != 0)
+    {
+        for (i=0; i<theType->numState; i++)  {
+            sprintf(outputData,"s%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ElementResponse(this, 2, Vector(theType->numState));
+    }
+
+    output.endTag(); // ElementOutput
+
+    return theResponse;
+}
+
+
+int UserBatchElement::getResponse(int responseID, Information &eleInfo)
+{
+    switch (responseID)  {
+    case 1:  // global forces
+        return eleInfo.setVector(this->getResistingForce());
+        
+    case 2: {  // state
+        if (theType == 0)
+            return -1;
+        int numState = theType->numState;
+        Vector stateData(numState);
+        for (int i=0; i<numState; i++)
+            stateData(i) = theType->state[index*numState+i];
+        return eleInfo.setVector(stateData);
+    }
+        
+    default:
+        return -1;
+    }
+}
@@ -0,0 +1,122 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef UserBatchElement_h
+#define UserBatchElement_h
+
+// Description: This file contains the class definition for UserBatchElement.
+// The tangent and resisting force of a UserBatchElement are computed by a
+// user function of its type, which is called once for all the elements of
+// the type with their displacements and states stacked in arrays, rather
+// than once for each element. This is what makes formulations written in an
+// interpreted language (e.g. Python with NumPy) usable in large models.
+
+#include <Element.h>
+#include <Matrix.h>
+
+class UserBatchType;
+
+// the function of a type gets, row major and one row per element:
+//   x     numEle x numCrd     initial coordinates of the nodes
+//   u     numEle x numDOF     trial displacements
+//   state numEle x numState   the committed state, to be left as the trial state
+// and is to fill K (numEle x numDOF x numDOF) and P (numEle x numDOF), the
+// tangents and resisting forces. It returns 0 if all went well; if not, the
+// tangents and forces of the type are zero and its elements fail update()
+// and commitState() until the function succeeds.
+typedef int (*UserBatchFunction)(int numEle, int numCrd, int numDOF, int numState,
+    const double *x, const double *u, double *state, double *K, double *P,
+    void *data);
+
+class UserBatchElement : public Element
+{
+public:
+    // constructors
+    UserBatchElement(int tag, int typeTag, const ID &nodes);
+    UserBatchElement();
+    
+    // destructor
+    ~UserBatchElement();
+    
+    // method to get class type
+    const char *getClassType() const {return "UserBatchElement";};
+    
+    // set the function of the type typeTag, over the one set before; release
+    // is called with data when the function is replaced
+    static int setTypeFunction(int typeTag, int numState, UserBatchFunction fn,
+        void *data, void (*release)(void *));
+    static bool hasType(int typeTag);
+    
+    // public methods to obtain information about dof & connectivity
+    int getNumExternalNodes() const;
+    const ID &getExternalNodes();
+    Node **getNodePtrs();
+    int getNumDOF();
+    void setDomain(Domain *theDomain);
+    
+    // public methods to set the state of the element
+    int commitState();
+    int revertToLastCommit();
+    int revertToStart();
+    int update();
+    
+    // public methods to obtain stiffness, mass, damping and residual information
+    const Matrix &getTangentStiff();
+    const Matrix &getInitialStiff();
+    const Matrix &getMass();
+    
+    void zeroLoad();
+    int addLoad(ElementalLoad *theLoad, double loadFactor);
+    int addInertiaLoadToUnbalance(const Vector &accel);
+    
+    const Vector &getResistingForce();
+    const Vector &getResistingForceIncInertia();
+    
+    // public methods for element output
+    int sendSelf(int commitTag, Channel &sChannel);
+    int recvSelf(int commitTag, Channel &rChannel, FEM_ObjectBroker &theBroker);
+    int displaySelf(Renderer &theViewer, int displayMode, float fact, const char **modes, int numMode);
+    void Print(OPS_Stream &s, int flag = 0);
+    
+    // public methods for element recorder
+    Response *setResponse(const char **argv, int argc, OPS_Stream &s);
+    int getResponse(int responseID, Information &eleInfo);
+    
+protected:
+    
+private:
+    friend class UserBatchType;
+    
+    // private attributes - a copy for each object of the class
+    ID connectedExternalNodes;  // contains the tags of the end nodes
+    Node **theNodes;            // array of node pointers
+    
+    int numExternalNodes;       // number of nodes
+    int numDOF;                 // number of element DOF
+    int typeTag;                // tag of the type giving the function
+    UserBatchType *theType;     // the type, once the element is in a domain
+    int index;                  // row of the element in the arrays of its type
+    
+    Matrix theMatrix;           // objects matrix
+    Vector theVector;           // objects vector
+    Vector theLoad;             // load vector
+};
+
+#endif
@@ -224,10 +224,11 @@ GradientInelasticBeamColumn2d::GradientInelasticBeamColumn2d(int tag, int nodeI,
 	cnstH(constH), secLR1(R1), secLR2(R2),
 	correctionControl(corControl), maxEpsInc(maxEps), maxPhiInc(maxPhi),
 	L(0.0), F_tol_q(0.0), F_tol_f_ms(0.0), 
-	hh(0), H(0), H_init(0), H_inv(0),
-	B_q(0), B_Q(0), B_q_H_inv_init(0), K0(0),
+	B_q(0), B_Q(0), H(0), H_init(0), B_q_H_inv(0),
+	LU_H(0), LU_H_init(0), piv_H(0), piv_H_init(0), work_H(0), bw_H(0), modH(false), rows_H(0),
+	B_q_H_inv_init(0), K0(0),
 	J(0), J_init(0), J_commit(0),
-	k_init(3), flex_ms_init(0), trial_change(0), max_trial_change(0),
+	k_init(3), flex_ms_init(0), trial_change(0), max_trial_change(0), hh(0),
 	initialFlag(0), Q(3), Q_commit(3),
 	d_sec(0), d_sec_commit(0), d_tot(0), d_tot_commit(0), d_nl_tot(0), d_nl_tot_commit(0),
 	F_ms(0), F_ms_commit(0),
@@ -295,7 +296,8 @@ GradientInelasticBeamColumn2d::GradientInelasticBeamColumn2d(int tag, int nodeI,
 
 	H = new Matrix(numSections * secOrder, numSections * secOrder);
 	H_init = new Matrix(numSections * secOrder, numSections * secOrder);
-	H_inv = new Matrix(numSections * secOrder, numSections * secOrder);
+	B_q_H_inv = new Matrix(3, numSections * secOrder);
+	rows_H = new ID(numSections);
 	hh = new Vector(numSections * secOrder);
 
 	B_q_H_inv_init = new Matrix(3, numSections * secOrder);
@@ -351,7 +353,8 @@ GradientInelasticBeamColumn2d::setSectionPointers(void)
   
   H = new Matrix(numSections * secOrder, numSections * secOrder);
   H_init = new Matrix(numSections * secOrder, numSections * secOrder);
-  H_inv = new Matrix(numSections * secOrder, numSections * secOrder);
+  B_q_H_inv = new Matrix(3, numSections * secOrder);
+  rows_H = new ID(numSections);
   hh = new Vector(numSections * secOrder);
   
   B_q_H_inv_init = new Matrix(3, numSections * secOrder);
@@ -382,10 +385,11 @@ GradientInelasticBeamColumn2d::GradientInelasticBeamColumn2d()
     cnstH(0), secLR1(0.0), secLR2(0.0),
     correctionControl(0), maxEpsInc(0.0), maxPhiInc(0.0),    
     L(0.0), F_tol_q(0.0), F_tol_f_ms(0.0),
-    hh(0), H(0), H_init(0), H_inv(0),
-    B_q(0), B_Q(0), B_q_H_inv_init(0), K0(0),
+    B_q(0), B_Q(0), H(0), H_init(0), B_q_H_inv(0),
+	LU_H(0), LU_H_init(0), piv_H(0), piv_H_init(0), work_H(0), bw_H(0), modH(false), rows_H(0),
+    B_q_H_inv_init(0), K0(0),
     J(0), J_init(0), J_commit(0),
-    k_init(3), flex_ms_init(0), trial_change(0), max_trial_change(0),
+    k_init(3), flex_ms_init(0), trial_change(0), max_trial_change(0), hh(0),
     initialFlag(0), Q(3), Q_commit(3),
     d_sec(0), d_sec_commit(0), d_tot(0), d_tot_commit(0), d_nl_tot(0), d_nl_tot_commit(0),
     F_ms(0), F_ms_commit(0),
@@ -413,8 +417,26 @@ GradientInelasticBeamColumn2d::~GradientInelasticBeamColumn2d()
 	if (H_init != 0)
 		delete H_init;
 
-	if (H_inv != 0)
-		delete H_inv;
+	if (B_q_H_inv != 0)
+		delete B_q_H_inv;
+
+	if (LU_H != 0)
+		delete[] LU_H;
+
+	if (LU_H_init != 0)
+		delete[] LU_H_init;
+
+	if (piv_H != 0)
+		delete[] piv_H;
+
+	if (piv_H_init != 0)
+		delete[] piv_H_init;
+
+	if (work_H != 0)
+		delete[] work_H;
+
+	if (rows_H != 0)
+		delete rows_H;
 
 	if (hh != 0)
 		delete hh;
@@ -484,6 +506,97 @@ GradientInelasticBeamColumn2d::~GradientInelasticBeamColumn2d()
 		delete[] d_sec_commit;
 }
 
+#ifdef _WIN32
+
+extern "C" int DGBTRF(int *M, int *N, int *KL, int *KU, double *A, 
+			       int *LDA, int *iPiv, int *INFO);
+
+extern "C" int DGBTRS(char *TRANS, 
+			       int *N, int *KL, int *KU, int *NRHS,
+			       double *A, int *LDA, int *iPiv, 
+			       double *B, int *LDB, int *INFO);
+
+#else
+
+extern "C" int dgbtrf_(int *M, int *N, int *KL, int *KU, double *A, 
+		       int *LDA, int *iPiv, int *INFO);
+
+extern "C" int dgbtrs_(char *TRANS, int *N, int *KL, int *KU, int *NRHS, 
+		       double *A, int *LDA, int *iPiv, double *B, int *LDB, 
+		       int *INFO);
+
+#endif
+
+// Definition of Method to Factor [H] in LAPACK Band Storage
+int
+GradientInelasticBeamColumn2d::factorH(const Matrix &theH, double *LU, int *piv)
+{
+	int n = numSections * secOrder;
+	int kl = bw_H;
+	int ku = bw_H;
+	int ldLU = 2 * kl + ku + 1;
+
+	for (int i = 0; i < ldLU * n; i++)
+		LU[i] = 0.0;
+
+	for (int j = 0; j < n; j++) {
+		int iStart = (j - ku > 0) ? j - ku : 0;
+		int iEnd = (j + kl < n - 1) ? j + kl : n - 1;
+
+		for (int i = iStart; i <= iEnd; i++)
+			LU[j * ldLU + kl + ku + i - j] = theH(i, j);
+	}
+
+	int info;
+#ifdef _WIN32
+	DGBTRF(&n, &n, &kl, &ku, LU, &ldLU, piv, &info);
+#else
+	dgbtrf_(&n, &n, &kl, &ku, LU, &ldLU, piv, &info);
+#endif
+
+	return (info == 0) ? 0 : -1;
+}
+
+// Definition of Method to Solve with Factored [H] (or Its Transpose) for the nrhs Vectors in work_H
+int
+GradientInelasticBeamColumn2d::solveH(const double *LU, const int *piv, int nrhs, bool transpose)
+{
+	int n = numSections * secOrder;
+	int kl = bw_H;
+	int ku = bw_H;
+	int ldLU = 2 * kl + ku + 1;
+	char *trans = transpose ? (char *)"T" : (char *)"N";
+
+	int info;
+#ifdef _WIN32
+	DGBTRS(trans, &n, &kl, &ku, &nrhs, (double *)LU, &ldLU, (int *)piv, work_H, &n, &info);
+#else
+	dgbtrs_(trans, &n, &kl, &ku, &nrhs, (double *)LU, &ldLU, (int *)piv, work_H, &n, &info);
+#endif
+
+	return (info == 0) ? 0 : -1;
+}
+
+// Definition of Method to Form B_q/H from Factored [H], as the Transpose of H^-T*B_q^T
+int
+GradientInelasticBeamColumn2d::formBqHinv(const double *LU, const int *piv, Matrix &BqHinv)
+{
+	int n = numSections * secOrder;
+
+	for (int k = 0; k < 3; k++)
+		for (int j = 0; j < n; j++)
+			work_H[k * n + j] = (*B_q)(k, j);
+
+	if (this->solveH(LU, piv, 3, true) < 0)
+		return -1;
+
+	for (int k = 0; k < 3; k++)
+		for (int j = 0; j < n; j++)
+			BqHinv(k, j) = work_H[k * n + j];
+
+	return 0;
+}
+
 // Definition of setDomain()
 void
 GradientInelasticBeamColumn2d::setDomain(Domain *theDomain)
@@ -681,13 +794,40 @@ GradientInelasticBeamColumn2d::setDomain(Domain *theDomain)
 		F_ms_commit->Zero();
 	}
 	
-	// Compute H_inv and B_q_H_inv
-	if (H_init->Invert(*H_inv) < 0) {
-	  opserr << "WARNING! GradientInelasticBeamColumn2d::setDomain() - element: " << this->getTag() << " - could not invert H matrix\n";
-	  exit(0);
+	// Factor [H], which is banded since it only couples nearby sections,
+	// and Compute B_q_H_inv
+	int nH = numSections * secOrder;
+	bw_H = 0;
+	for (int i = 0; i < nH; i++)
+		for (int j = 0; j < nH; j++)
+			if ((*H_init)(i, j) != 0.0 && abs(i - j) > bw_H)
+				bw_H = abs(i - j);
+
+	if (LU_H != 0)
+		delete[] LU_H;
+	if (LU_H_init != 0)
+		delete[] LU_H_init;
+	if (piv_H != 0)
+		delete[] piv_H;
+	if (piv_H_init != 0)
+		delete[] piv_H_init;
+	if (work_H != 0)
+		delete[] work_H;
+
+	LU_H = new double[(3 * bw_H + 1) * nH];
+	LU_H_init = new double[(3 * bw_H + 1) * nH];
+	piv_H = new int[nH];
+	piv_H_init = new int[nH];
+	work_H = new double[3 * nH];
+
+	if (this->factorH(*H_init, LU_H_init, piv_H_init) < 0 || this->formBqHinv(LU_H_init, piv_H_init, *B_q_H_inv_init) < 0) {
+		opserr << "WARNING! GradientInelasticBeamColumn2d::setDomain() - element: " << this->getTag() << " - could not invert H matrix\n";
+		exit(0);
 	}
-	
-	*B_q_H_inv_init = (*B_q) * (*H_inv);
+
+	*B_q_H_inv = *B_q_H_inv_init;
+	rows_H->Zero();
+	modH = false;
 	//}
 		
 	// Form Initial Jacobian Matrix
@@ -1023,7 +1163,7 @@ GradientInelasticBeamColumn2d::update(void)
 	Vector trial_old(3 + numSections * secOrder);
 	Vector trial_new(3 + numSections * secOrder);
 	Matrix K_ms(numSections * secOrder, numSections * secOrder);
-	Matrix B_q_H_inv(3, numSections * secOrder);
+	ID rows(numSections);
 	Matrix J_prev = *J_commit;
 
 	bool bothConverged;
@@ -1072,6 +1212,7 @@ GradientInelasticBeamColumn2d::update(void)
 				if (!cnstH) {
 					//Update[H]
 					*H = *H_init;
+					rows.Zero();
 
 					double E_sec, eps_sec;
 
@@ -1090,18 +1231,36 @@ GradientInelasticBeamColumn2d::update(void)
 
 								(*H)(i + k, i + k) = 1.0;
 							}
+
+							rows(i / secOrder) = 1;
 						}
 					}
 
-					// Invert [H]
-					if (H->Invert(*H_inv) < 0) {
-						opserr << "WARNING! GradientInelasticBeamColumn2d::update() - element: " << this->getTag() << " - could not invert [H]\n";
-						return -1;
+					// Refactor [H] Only When the Set of Replaced Rows Changes
+					if (rows != *rows_H) {
+						*rows_H = rows;
+						modH = (rows != 0);
+
+						if (!modH)
+							*B_q_H_inv = *B_q_H_inv_init;
+						else if (this->factorH(*H, LU_H, piv_H) < 0 || this->formBqHinv(LU_H, piv_H, *B_q_H_inv) < 0) {
+							opserr << "WARNING! GradientInelasticBeamColumn2d::update() - element: " << this->getTag() << " - could not invert [H]\n";
+							return -1;
+						}
 					}
 				}
 
 				// Compute Macroscopic Section Strains
-				*d_nl_tot = d_nl_tot_prev + ((*H_inv) * d_inc_tot);
+				for (int i = 0; i < numSections * secOrder; i++)
+					work_H[i] = d_inc_tot(i);
+
+				if (modH)
+					this->solveH(LU_H, piv_H, 1, false);
+				else
+					this->solveH(LU_H_init, piv_H_init, 1, false);
+
+				*d_nl_tot = d_nl_tot_prev;
+				d_nl_tot->addVector(1.0, Vector(work_H, numSections * secOrder), 1.0);
 
 				// Check Convergence
 				bothConverged = false;
@@ -1119,24 +1278,14 @@ GradientInelasticBeamColumn2d::update(void)
 					// Assemble Jacobian Metrix
 					switch (l) {
 					case 0:
-						if (!cnstH) {
-							B_q_H_inv = (*B_q) * (*H_inv);
-							this->assembleMatrix(*J, B_q_H_inv, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
-						}
-						else
-							this->assembleMatrix(*J, *B_q_H_inv_init, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
+						this->assembleMatrix(*J, *B_q_H_inv, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
 
 						this->getSectionsTangentStiff(K_ms);
 						this->assembleMatrix(*J, K_ms, 0, numSections * secOrder - 1, 3, numSections * secOrder + 2, -1.0);
 
 						break;
 					case 1:
-						if (!cnstH) {
-							B_q_H_inv = (*B_q) * (*H_inv);
-							this->assembleMatrix(*J, B_q_H_inv, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
-						}
-						else
-							this->assembleMatrix(*J, *B_q_H_inv_init, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
+						this->assembleMatrix(*J, *B_q_H_inv, numSections * secOrder, numSections * secOrder + 2, 3, numSections * secOrder + 2, -1.0);
 
 						this->getSectionsTangentStiff(K_ms);
 						this->assembleMatrix(*J, K_ms, 0, numSections * secOrder - 1, 3, numSections * secOrder + 2, -1.0);
@@ -1329,10 +1478,7 @@ GradientInelasticBeamColumn2d::getBasicStiff(void)
 		opserr << "WARNING! GradientInelasticBeamColumn2d::getBasicStiff() - element: " << this->getTag() << " - could not invert K_ms\n";
 	}
 
-	if (!cnstH)
-		F = ((*B_q) * (*H_inv)) * K_ms_inv_BQ;
-	else
-		F = (*B_q_H_inv_init) * K_ms_inv_BQ;
+	F = (*B_q_H_inv) * K_ms_inv_BQ;
 
 	if (F.Invert(K) < 0) {
 		opserr << "WARNING! GradientInelasticBeamColumn2d::getBasicStiff() - element: " << this->getTag() << " - could not invert element flexibility matrix\n";
@@ -1709,7 +1855,7 @@ GradientInelasticBeamColumn2d::sendSelf(int commitTag, Channel &theChannel)
   Matrix *B_q;	3 x (Np*order)	// Formed in setDomain
   Matrix *B_Q;	(Np*order) x 3  // Formed in setDomain
   Matrix *H_init;   (Np*order) x (Np*order) // Formed in setDomain
-  Matrix *H_inv;    (Np*order) x (Np*order) // Formed in setDomain
+  double *LU_H_init; (3*bw+1) x (Np*order) // Formed in setDomain
   Matrix *B_q_H_inv_init; 3 x (Np*order) // Formed in setDomain	
   Matrix *J_init;    (3+Np*order) x (3+Np*order) // Formed in setDomain
   Vector k_init;     3 // Formed in setDomain
@@ -137,7 +137,15 @@ private:
 	Matrix *B_Q;			// total force interpolation matrix
 	Matrix *H;				// nonlocal averaging matrix
 	Matrix *H_init;			// initial nonlocal averaging matrix
-	Matrix *H_inv;			// inverse of nonlocal averaging matrix
+	Matrix *B_q_H_inv;		// B_q/H with the current [H]
+	double *LU_H;			// banded LU factors of the current [H]
+	double *LU_H_init;		// banded LU factors of the initial [H]
+	int *piv_H;				// pivots of LU_H
+	int *piv_H_init;		// pivots of LU_H_init
+	double *work_H;			// right hand sides of the solves with [H]
+	int bw_H;				// half bandwidth of [H]
+	bool modH;				// indicates whether LU_H differs from LU_H_init or not
+	ID *rows_H;				// sections whose rows of [H] are replaced in LU_H
 	Matrix *B_q_H_inv_init;	// initial B_q/H
 	Matrix *K0;				// pointer to initial stiffness matrix in the basic system
 
@@ -186,6 +194,10 @@ private:
 	const Matrix &getBasicStiff(void);
 	const Matrix &getInitialBasicStiff(void);
 
+	int factorH(const Matrix &theH, double *LU, int *piv);
+	int solveH(const double *LU, const int *piv, int nrhs, bool transpose);
+	int formBqHinv(const double *LU, const int *piv, Matrix &BqHinv);
+
 	double weightedNorm(const Vector &W, const Vector &V, bool sqRt = true);
 
 	bool qConvergence(const int &iter, const Vector &qt, const Vector &dnl_tot, Vector &Dq, double &dqNorm);
@@ -163,11 +163,11 @@ class BeamColumnJoint2d : public Element
   void getBCJoint(void);
   void getdg_df(void);
   void getdDef_du(void);
-  void matDiag(Vector, Matrix&);
-  void getMatResponse(Vector, Vector&, Vector&);
-  void formR(Vector);
-  void formK(Vector);
-  double getStepSize(double,double,Vector,Vector,Vector,Vector,double);
+  void getSpringConnectivity(void);
+  void getMatResponse(const Vector&, Vector&, Vector&);
+  void formR(const Vector&);
+  void formK(const Vector&);
+  double getStepSize(double,double,const Vector&,const Vector&,const Vector&,const Vector&,double);
   
   // material info
   UniaxialMaterial **MaterialPtr;  // pointer to the 13 different materials
@@ -195,6 +195,11 @@ class BeamColumnJoint2d : public Element
   Matrix dg_df;         // matrix of derivative of internal equilibrium 
   Matrix dDef_du;       // matrix of a portion of BCJoint reqd. for static condensation
   
+  // nonzero terms of each row of BCJoint, set in setDomain()
+  int numSpringDOF[13];
+  int springDOF[13][16];
+  double springCoef[13][16];
+  
   Matrix K;              // element stiffness matrix
   Vector R;              // element residual matrix  
 };
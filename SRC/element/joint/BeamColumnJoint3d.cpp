@@ -46,10 +46,6 @@
 #include <ElementResponse.h>
 #include <elementAPI.h>
 
-// class wide matrices 
-Matrix BeamColumnJoint3d::Transf(12,24);
-Matrix BeamColumnJoint3d::Tran(3,6);
-
 
 void* OPS_BeamColumnJoint3d()
 {
@@ -113,7 +109,8 @@ BeamColumnJoint3d::BeamColumnJoint3d(int tag,int Nd1, int Nd2, int Nd3, int Nd4,
   connectedExternalNodes(4), elemActHeight(0.0), elemActWidth(0.0), 
   elemWidth(0.0), elemHeight(0.0), HgtFac(1.0), WdtFac(1.0),
   Uecommit(24), UeIntcommit(4), UeprCommit(24), UeprIntCommit(4),
-  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3)
+  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3),
+  Transf(12,24), Tran(3,6)
 {  
 // ensure the connectedExternalNode ID is of correct size & set values
     if (connectedExternalNodes.Size() != 4)
@@ -204,7 +201,8 @@ BeamColumnJoint3d::BeamColumnJoint3d(int tag,int Nd1, int Nd2, int Nd3, int Nd4,
   connectedExternalNodes(4), elemActHeight(0.0), elemActWidth(0.0), 
   elemWidth(0), elemHeight(0), HgtFac(elHgtFac), WdtFac(elWdtFac),
   Uecommit(24), UeIntcommit(4), UeprCommit(24), UeprIntCommit(4),
-  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3)
+  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3),
+  Transf(12,24), Tran(3,6)
 {  
 // ensure the connectedExternalNode ID is of correct size & set values
     if (connectedExternalNodes.Size() != 4)
@@ -281,7 +279,8 @@ BeamColumnJoint3d::BeamColumnJoint3d():
   connectedExternalNodes(4), elemActHeight(0.0), elemActWidth(0.0), 
   elemWidth(0), elemHeight(0), HgtFac(1.0), WdtFac(1.0),
   Uecommit(24), UeIntcommit(4), UeprCommit(24), UeprIntCommit(4),
-  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3)
+  BCJoint(13,16), dg_df(4,13), dDef_du(13,4), K(24,24), R(24), Node1(3), Node2(3), Node3(3), Node4(3),
+  Transf(12,24), Tran(3,6)
 {
     nodePtr[0] = 0;
 	nodePtr[1] = 0;
@@ -398,6 +397,7 @@ BeamColumnJoint3d::setDomain(Domain *theDomain)
 	}
 
 	getBCJoint();
+	getSpringConnectivity();
 	getdg_df();
 	getdDef_du();
 	formTransfMat();
@@ -457,7 +457,7 @@ int
 BeamColumnJoint3d::update()
 {	
 
-	Vector Ue(28);
+	static Vector Ue(28);
 	Ue.Zero();
 
 	// determine committed displacements given trial displacements
@@ -506,24 +506,24 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 	double dLoadStep = 1.0;
 	double stepSize;
 
-	Vector uExtOld(24);       uExtOld.Zero();
-	Vector uExt(12);          uExt.Zero();
-	Vector duExt(12);         duExt.Zero();
-	Vector uIntOld(4);        uIntOld.Zero();
-	Vector uInt(4);           uInt.Zero();
-	Vector duInt(4);          duInt.Zero();
-	Vector duIntTemp(4);      duIntTemp.Zero();
-	Vector intEq(4);          intEq.Zero();
-	Vector intEqLast(4);      intEqLast.Zero();
-	Vector Uepr(24);          Uepr.Zero();
-	Vector UeprInt(4);        UeprInt.Zero();
-	Vector Ut(24);            Ut.Zero();
-	Vector duExtTemp(24);     duExtTemp.Zero();
-
-    Vector disp1 = nodePtr[0]->getTrialDisp(); 
-    Vector disp2 = nodePtr[1]->getTrialDisp();
-    Vector disp3 = nodePtr[2]->getTrialDisp();
-    Vector disp4 = nodePtr[3]->getTrialDisp();
+	static Vector uExtOld(24);       uExtOld.Zero();
+	static Vector uExt(12);          uExt.Zero();
+	static Vector duExt(12);         duExt.Zero();
+	static Vector uIntOld(4);        uIntOld.Zero();
+	static Vector uInt(4);           uInt.Zero();
+	static Vector duInt(4);          duInt.Zero();
+	static Vector duIntTemp(4);      duIntTemp.Zero();
+	static Vector intEq(4);          intEq.Zero();
+	static Vector intEqLast(4);      intEqLast.Zero();
+	static Vector Uepr(24);          Uepr.Zero();
+	static Vector UeprInt(4);        UeprInt.Zero();
+	static Vector Ut(24);            Ut.Zero();
+	static Vector duExtTemp(24);     duExtTemp.Zero();
+
+    const Vector &disp1 = nodePtr[0]->getTrialDisp(); 
+    const Vector &disp2 = nodePtr[1]->getTrialDisp();
+    const Vector &disp3 = nodePtr[2]->getTrialDisp();
+    const Vector &disp4 = nodePtr[3]->getTrialDisp();
 
 	for (int i = 0; i < 6; i++)
     {
@@ -539,7 +539,8 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 
 	uExtOld = Uepr;
 
-	duExtTemp = Ut - Uepr;
+	duExtTemp = Ut;
+	duExtTemp -= Uepr;
 	duExt.addMatrixVector(0.0,Transf,duExtTemp,1.0);
 	uExt.addMatrixVector(0.0,Transf,uExtOld,1.0);  
 
@@ -556,16 +557,14 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 	double normIntEq = tolIntEq;
 	double normIntEqdU = tolIntEqdU;
 	    
-	Vector u(16);   u.Zero();
+	static Vector u(16);   u.Zero();
 
 	double engrLast = 0.0;
 	double engr = 0.0;
 
-	Vector fSpring(13);          fSpring.Zero();
-	Vector kSpring(13);          kSpring.Zero();
-	Matrix dintEq_du(4,4);       dintEq_du.Zero();
-	Matrix df_dDef(13,13);       df_dDef.Zero();
-	Matrix tempintEq_du (4,13);  tempintEq_du.Zero();
+	static Vector fSpring(13);          fSpring.Zero();
+	static Vector kSpring(13);          kSpring.Zero();
+	static Matrix dintEq_du(4,4);       dintEq_du.Zero();
 
 
 	while ((loadStep < 1.0) && (totalCount < maxTotalCount))
@@ -600,11 +599,14 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 		intEq(2) = -fSpring(4)-fSpring(8)+fSpring(10)+fSpring(12)/elemHeight; 
 		intEq(3) = fSpring(0)-fSpring(6)-fSpring(11)-fSpring(12)/elemWidth; 
 
-		matDiag(kSpring, df_dDef);
-
-		//////////////////////// dintEq_du = dg_df*df_dDef*dDef_du
-		tempintEq_du.addMatrixProduct(0.0,dg_df,df_dDef,1.0);
-		dintEq_du.addMatrixProduct(0.0,tempintEq_du,dDef_du,1.0);
+		//////////////////////// dintEq_du = dg_df*diag(kSpring)*dDef_du
+		for (int ia = 0; ia < 4; ia++)
+			for (int ib = 0; ib < 4; ib++) {
+				double sum = 0.0;
+				for (int ja = 0; ja < 13; ja++)
+					sum += dg_df(ia,ja)*kSpring(ja)*dDef_du(ja,ib);
+				dintEq_du(ia,ib) = sum;
+			}
 		normIntEq = intEq.Norm();
 		normIntEqdU = 0.0;
 		for (int jc = 0; jc<4 ; jc++)
@@ -653,7 +655,7 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 			normDuInt = duInt.Norm();
 			if (!linesearch)
 			{
-				uInt = uInt + duInt;
+				uInt += duInt;
 			}
 			else
 			{
@@ -675,16 +677,16 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 					
 					if (fabs(stepSize) > 0.001)
 					{
-						uInt = uInt + stepSize*duInt;
+						uInt.addVector(1.0,duInt,stepSize);
 					}
 					else
 					{
-						uInt = uInt + duInt;
+						uInt += duInt;
 					}
 				}
 				else
 				{
-					uInt = uInt + duInt;
+					uInt += duInt;
 				}
 				intEqLast = intEq;
 			}
@@ -707,7 +709,7 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 
 				uInt = uIntOld;
 				duInt.Zero();
-				duExt = duExt*0.1;
+				duExt *= 0.1;
 
 				dLoadStep = dLoadStep*0.1;
 			}
@@ -719,10 +721,10 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 			normDuInt = toluInt;
 			if ((incCount < maxCount) || dtConverge)
 			{
-				uExt = uExt + duExt;
+				uExt += duExt;
 				if (loadStep + dLoadStep > 1.0)
 				{
-					duExt = duExt*(1.0 - loadStep)/dLoadStep;
+					duExt *= (1.0 - loadStep)/dLoadStep;
 					dLoadStep = 1.0 - loadStep;
 					incCount = 9;
 				}
@@ -730,11 +732,11 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 			else
 			{
 				incCount = 0;
-				uExt = uExt + duExt;
+				uExt += duExt;
 				dLoadStep = dLoadStep*10;
 				if (loadStep + dLoadStep > 1.0)
 				{
-					uExt = uExt + duExt*(1.0 - loadStep)/dLoadStep;
+					uExt.addVector(1.0,duExt,(1.0 - loadStep)/dLoadStep);
 					dLoadStep = 1.0 - loadStep;
 					incCount = 9;
 				}
@@ -764,18 +766,24 @@ void BeamColumnJoint3d::getGlobalDispls(Vector &dg)
 
 }
 
-void BeamColumnJoint3d::getMatResponse(Vector U, Vector &fS, Vector &kS)
+void BeamColumnJoint3d::getMatResponse(const Vector &U, Vector &fS, Vector &kS)
 {
 	double jh = HgtFac;            // factor for beams
 	double jw = WdtFac;            // factor for column
 
 	// obtains the material response from the material class
-	Vector defSpring(13);
-	defSpring.Zero();
+	static Vector defSpring(13);
 	fS.Zero();
 	kS.Zero();
 
-	defSpring.addMatrixVector(0.0, BCJoint, U, 1.0);
+	// defSpring = BCJoint*U, over the nonzero terms of each row
+	for (int jd=0; jd<13; jd++)
+	{
+		double sum = 0.0;
+		for (int n=0; n<numSpringDOF[jd]; n++)
+			sum += springCoef[jd][n]*U(springDOF[jd][n]);
+		defSpring(jd) = sum;
+	}
 
 	// slip @ bar = slip @ spring * tc couple
 
@@ -822,6 +830,22 @@ void BeamColumnJoint3d::getMatResponse(Vector U, Vector &fS, Vector &kS)
 }
 
 
+void BeamColumnJoint3d::getSpringConnectivity(void)
+{
+	// the nonzero terms of each row of BCJoint, so the spring deformations,
+	// residual and stiffness skip the zeros of the 13x16 transformation
+	for (int j=0; j<13; j++)
+	{
+		numSpringDOF[j] = 0;
+		for (int i=0; i<16; i++)
+			if (BCJoint(j,i) != 0.0) {
+				springDOF[j][numSpringDOF[j]] = i;
+				springCoef[j][numSpringDOF[j]] = BCJoint(j,i);
+				numSpringDOF[j]++;
+			}
+	}
+}
+
 void BeamColumnJoint3d::getdDef_du()
 {
 	
@@ -835,58 +859,50 @@ void BeamColumnJoint3d::getdDef_du()
 	}
 }
 
-void BeamColumnJoint3d::matDiag(Vector k,Matrix &dfd)
-{
-	dfd.Zero();
-	// takes in a vector and converts it to a diagonal matrix (could have been placed as a method in matrix class)
-	for (int ja=0; ja<13; ja++)
-	{
-		dfd(ja,ja) = k(ja);
-	}
-
-}
-
-void BeamColumnJoint3d::formR(Vector f)
+void BeamColumnJoint3d::formR(const Vector &f)
 {
 	
 	// develops the element residual force vector
-	Vector rForceTemp(16);
-	Vector Rtempo(12);
-	rForceTemp.Zero();
-	
-	rForceTemp.addMatrixTransposeVector(0.0,BCJoint,f,1.0);   // rForceTemp = BCJoint'*f
-	Rtempo.Extract(rForceTemp,0,1.0);
+	static Vector Rtempo(12);
+	// Rtempo = BCJoint'*f for the external dofs, over the nonzero terms of each row
+	Rtempo.Zero();
+	for (int j=0; j<13; j++)
+		for (int n=0; n<numSpringDOF[j]; n++)
+			if (springDOF[j][n] < 12)
+				Rtempo(springDOF[j][n]) += springCoef[j][n]*f(j);
 
 	R.addMatrixTransposeVector(0.0,Transf,Rtempo,1.0);    // R = Transf'*Rtempo
 }
 
-void BeamColumnJoint3d::formK(Vector k)
+void BeamColumnJoint3d::formK(const Vector &k)
 {
     // develops the element stiffness matrix
-	Matrix kSprDiag(13,13);
-	kSprDiag.Zero();
-    Matrix kRForce(16,16);
+    static Matrix kRForce(16,16);
 	kRForce.Zero();
-	Matrix kRFT1(4,12);
+	static Matrix kRFT1(4,12);
 	kRFT1.Zero();
-	Matrix kRFT2(4,4);
+	static Matrix kRFT2(4,4);
 	kRFT2.Zero();
-	Matrix kRFT3(12,4);
+	static Matrix kRFT3(12,4);
 	kRFT3.Zero();
-	Matrix I(4,4);
+	static Matrix I(4,4);
 	I.Zero();
-	Matrix kRSTinv(4,4);
+	static Matrix kRSTinv(4,4);
 	kRSTinv.Zero();
-    Matrix kRF(12,12);
+    static Matrix kRF(12,12);
 	kRF.Zero();
-	Matrix K2Temp(12,4);
+	static Matrix K2Temp(12,4);
 	K2Temp.Zero();
-	Matrix K2(12,12);
+	static Matrix K2(12,12);
 	K2.Zero();
 
-	matDiag(k,kSprDiag);
-
-	kRForce.addMatrixTripleProduct(0.0,BCJoint,kSprDiag,1.0);    // kRForce = BCJoint'*kSprDiag*BCJoint
+	// kRForce = BCJoint'*diag(k)*BCJoint, over the nonzero terms of each row
+	for (int j=0; j<13; j++)
+		for (int m=0; m<numSpringDOF[j]; m++) {
+			double km = k(j)*springCoef[j][m];
+			for (int n=0; n<numSpringDOF[j]; n++)
+				kRForce(springDOF[j][m],springDOF[j][n]) += km*springCoef[j][n];
+		}
 	kRFT2.Extract(kRForce,12,12,1.0);
 	kRFT1.Extract(kRForce,12,0,1.0);
 	kRFT3.Extract(kRForce,0,12,1.0);
@@ -1019,13 +1035,13 @@ void BeamColumnJoint3d::getBCJoint()
 
 }
 
-double BeamColumnJoint3d::getStepSize(double s0,double s1,Vector uExt,Vector duExt,Vector uInt,Vector duInt,double tol)
+double BeamColumnJoint3d::getStepSize(double s0,double s1,const Vector &uExt,const Vector &duExt,const Vector &uInt,const Vector &duInt,double tol)
 {
 	// finds out the factor to be used for linesearch method
-	Vector u(16);    u.Zero();
-	Vector fSpr(13); fSpr.Zero();
-	Vector kSpr(13); kSpr.Zero();
-	Vector intEq(4); intEq.Zero();
+	static Vector u(16);    u.Zero();
+	static Vector fSpr(13); fSpr.Zero();
+	static Vector kSpr(13); kSpr.Zero();
+	static Vector intEq(4); intEq.Zero();
 
 	double r0 = 0.0;            // tolerance check for line-search
 	double tolerance = 0.8;     // slack region tolerance set for line-search
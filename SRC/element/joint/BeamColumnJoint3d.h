@@ -160,12 +160,12 @@ class BeamColumnJoint3d : public Element
   void getBCJoint(void);
   void getdg_df(void);
   void getdDef_du(void);
-  void matDiag(Vector, Matrix&);
-  void getMatResponse(Vector, Vector&, Vector&);
-  void formR(Vector);
-  void formK(Vector);
+  void getSpringConnectivity(void);
+  void getMatResponse(const Vector&, Vector&, Vector&);
+  void formR(const Vector&);
+  void formK(const Vector&);
   void formTransfMat();
-  double getStepSize(double,double,Vector,Vector,Vector,Vector,double);
+  double getStepSize(double,double,const Vector&,const Vector&,const Vector&,const Vector&,double);
   
   // material info
   UniaxialMaterial **MaterialPtr;  // pointer to the 13 different materials
@@ -193,12 +193,17 @@ class BeamColumnJoint3d : public Element
   Matrix dg_df;         // matrix of derivative of internal equilibrium 
   Matrix dDef_du;       // matrix of a portion of BCJoint reqd. for static condensation
   
+  // nonzero terms of each row of BCJoint, set in setDomain()
+  int numSpringDOF[13];
+  int springDOF[13][16];
+  double springCoef[13][16];
+  
   Matrix K;               // element stiffness matrix
   Vector R;               // element residual matrix
   
-  // static transformation matrices
-  static Matrix Transf;
-  static Matrix Tran;
+  // transformation matrices, set in setDomain() from the node coordinates
+  Matrix Transf;
+  Matrix Tran;
   
 };
 
@@ -737,8 +737,7 @@ int MixedBeamColumn3d::revertToStart()
   initialLength = crdTransf->getInitialLength();
 
   // Get the numerical integration weights
-  double wt[MAX_NUM_SECTIONS]; // weights of sections or gauss points of integration points
-  beamIntegr->getSectionWeights(numSections, initialLength, wt);
+  const double *wt = beamIntegr->getCachedWeights(numSections, initialLength); // weights of sections or gauss points of integration points
 
   // Vector of zeros to use at initial natural displacements
   Vector myZeros(NDM_NATURAL);
@@ -928,8 +927,7 @@ int MixedBeamColumn3d::update() {
   lastNaturalDisp = naturalDisp;
 
   // Get the numerical integration weights
-  double wt[MAX_NUM_SECTIONS]; // weights of sections or gauss points of integration points
-  beamIntegr->getSectionWeights(numSections, initialLength, wt);
+  const double *wt = beamIntegr->getCachedWeights(numSections, initialLength); // weights of sections or gauss points of integration points
 
   // Define Variables
   double GJ;
@@ -1138,8 +1136,7 @@ int MixedBeamColumn3d::addLoad(ElementalLoad *theLoad, double loadFactor) {
 
   double L = crdTransf->getInitialLength();
 
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   if (type == LOAD_TAG_Beam3dUniformLoad) {
     double wy = data(0)*loadFactor;  // Transverse
@@ -1263,10 +1260,8 @@ void MixedBeamColumn3d::Print(OPS_Stream &s, int flag) {
 
   } else if (flag == 33) {
     s << "\nElement: " << this->getTag() << " Type: MixedBeamColumn3d ";
-    double xi[MAX_NUM_SECTIONS]; // location of sections or gauss points or integration points
-    beamIntegr->getSectionLocations(numSections, initialLength, xi);
-    double wt[MAX_NUM_SECTIONS]; // weights of sections or gauss points of integration points
-    beamIntegr->getSectionWeights(numSections, initialLength, wt);
+    const double *xi = beamIntegr->getCachedLocations(numSections, initialLength); // location of sections or gauss points or integration points
+    const double *wt = beamIntegr->getCachedWeights(numSections, initialLength); // weights of sections or gauss points of integration points
     s << "\n section xi wt";
     for (int i = 0; i < numSections; i++)
       s << "\n"<<i<<" "<<xi[i]<<" "<<wt[i];
@@ -1595,8 +1590,7 @@ int MixedBeamColumn3d::getResponse(int responseID, Information &eleInfo) {
   } else if (responseID == 100) { // integration points
 
     double L = crdTransf->getInitialLength();
-    double pts[MAX_NUM_SECTIONS];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
     Vector locs(numSections);
     for (int i = 0; i < numSections; i++)
       locs(i) = pts[i]*L;
@@ -1604,8 +1598,7 @@ int MixedBeamColumn3d::getResponse(int responseID, Information &eleInfo) {
 
   } else if (responseID == 101) { // integration weights
       double L = crdTransf->getInitialLength();
-      double wts[MAX_NUM_SECTIONS];
-      beamIntegr->getSectionWeights(numSections, L, wts);
+      const double *wts = beamIntegr->getCachedWeights(numSections, L);
       Vector weights(numSections);
       for (int i = 0; i < numSections; i++)
         weights(i) = wts[i]*L;
@@ -1632,8 +1625,7 @@ int MixedBeamColumn3d::getResponse(int responseID, Information &eleInfo) {
 
   else if (responseID == 111 || responseID == 1111) {
     double L = crdTransf->getInitialLength();
-    double pts[MAX_NUM_SECTIONS];
-    beamIntegr->getSectionLocations(numSections, L, pts);
+    const double *pts = beamIntegr->getCachedLocations(numSections, L);
     // CBDI influence matrix
     Matrix ls(numSections, numSections);
     getCBDIinfluenceMatrix(numSections, pts, L, ls);
@@ -1656,7 +1648,6 @@ int MixedBeamColumn3d::getResponse(int responseID, Information &eleInfo) {
     Vector dispsz(numSections); // along local z    
     dispsy.addMatrixVector(0.0, ls, kappaz,  1.0);
     dispsz.addMatrixVector(0.0, ls, kappay, -1.0);    
-    beamIntegr->getSectionLocations(numSections, L, pts);
     static Vector uxb(3);
     static Vector uxg(3);
     Matrix disps(numSections,3);
@@ -1707,8 +1698,7 @@ int MixedBeamColumn3d::getResponse(int responseID, Information &eleInfo) {
 }
 
 Vector MixedBeamColumn3d::getd_hat(int sec, const Vector &v, double L, bool geomLinear) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double x, C, E, F;
   Vector D_hat(NDM_SECTION);
@@ -1745,8 +1735,7 @@ Vector MixedBeamColumn3d::getd_hat(int sec, const Vector &v, double L, bool geom
 }
 
 Matrix MixedBeamColumn3d::getKg(int sec, double P, double L) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double temp_x, temp_A, temp_B;
 
@@ -1772,8 +1761,7 @@ Matrix MixedBeamColumn3d::getKg(int sec, double P, double L) {
 }
 
 Matrix MixedBeamColumn3d::getMd(int sec, Vector dShapeFcn, Vector dFibers, double L) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double x, A, B;
 
@@ -1793,8 +1781,7 @@ Matrix MixedBeamColumn3d::getMd(int sec, Vector dShapeFcn, Vector dFibers, doubl
 }
 
 Matrix MixedBeamColumn3d::getNld_hat(int sec, const Vector &v, double L, bool geomLinear) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double x, C, E, F;
   Matrix Nld_hat(NDM_SECTION,NDM_NATURAL);
@@ -1835,8 +1822,7 @@ Matrix MixedBeamColumn3d::getNld_hat(int sec, const Vector &v, double L, bool ge
 }
 
 Matrix MixedBeamColumn3d::getNd2(int sec, double P, double L) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double temp_x, temp_A, temp_B;
 
@@ -1857,8 +1843,7 @@ Matrix MixedBeamColumn3d::getNd2(int sec, double P, double L) {
 }
 
 Matrix MixedBeamColumn3d::getNd1(int sec, const Vector &v, double L, bool geomLinear) {
-  double xi[MAX_NUM_SECTIONS];
-  beamIntegr->getSectionLocations(numSections, L, xi);
+  const double *xi = beamIntegr->getCachedLocations(numSections, L);
 
   double x = L*xi[sec];
 
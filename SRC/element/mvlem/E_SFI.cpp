@@ -41,6 +41,24 @@
 #include <ElementResponse.h>
 #include <ElementalLoad.h>
 #include <elementAPI.h>
+#include <vector>
+
+// sets the trial strains of the m panel materials, strain holds the m x 
+// strains, then the m y strains and the m shear strains of the panels
+static int
+setPanelTrialStrain(int m, NDMaterial **theMaterials, const double *strain)
+{
+	static thread_local std::vector<double> panelStrain;
+	panelStrain.resize(3 * m);
+
+	for (int i = 0; i < m; i++) {
+		panelStrain[3 * i] = strain[i];
+		panelStrain[3 * i + 1] = strain[i + m];
+		panelStrain[3 * i + 2] = strain[i + 2 * m];
+	}
+
+	return NDMaterial::setTrialStrainGroups(m, theMaterials, panelStrain.data(), 3);
+}
 
 // Read input parameters and build the material
 void* OPS_E_SFI()
@@ -558,9 +576,7 @@ int E_SFI::commitState()
 	int errCode = 0;
 
 	// Commit material models
-	for (int i = 0; i < m; i++)
-
-		errCode += theMaterial[i]->commitState();
+	errCode += NDMaterial::commitStateGroups(m, theMaterial);
 
 	return errCode;
 }
@@ -571,9 +587,7 @@ int E_SFI::revertToLastCommit()
 	int errCode = 0;
 
 	// Revert material models
-	for (int i = 0; i < m; i++)
-
-		errCode += theMaterial[i]->revertToLastCommit();
+	errCode += NDMaterial::revertToLastCommitGroups(m, theMaterial);
 
 	return errCode;
 }
@@ -605,17 +619,8 @@ int E_SFI::update()
 	// Set the strain in the materials
 	int errCode1 = 0;
 
-	for (int i = 0; i < m; i++) {
-
-		Vector strain(3);
-
-		strain(0) = E_SFIStrain[i];
-		strain(1) = E_SFIStrain[i + m];
-		strain(2) = E_SFIStrain[i + 2 * m];
-
-		// Set trial response for material models
-		errCode1 += theMaterial[i]->setTrialStrain(strain);
-	}
+	// Set trial response for material models
+	errCode1 += setPanelTrialStrain(m, theMaterial, E_SFIStrain);
 	return errCode1;
 }
 
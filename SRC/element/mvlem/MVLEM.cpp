@@ -49,6 +49,65 @@ Matrix MVLEM::MVLEMD(6, 6);
 Vector MVLEM::MVLEMR(6);
 
 #include <elementAPI.h>
+#include <vector>
+
+// true when the n materials are all of the class of theMaterials[0], so 
+// their state can be updated in one batch call
+static bool
+isSingleClass(int n, UniaxialMaterial **theMaterials)
+{
+	int classTag = theMaterials[0]->getClassTag();
+	for (int i = 1; i < n; i++)
+		if (theMaterials[i]->getClassTag() != classTag)
+			return false;
+
+	return true;
+}
+
+// sets the trial strains of the n macro-fiber materials
+static int
+setFiberTrialStrain(int n, UniaxialMaterial **theMaterials, const double *strain)
+{
+	if (n > 1 && isSingleClass(n, theMaterials)) {
+		static thread_local std::vector<double> stress;
+		static thread_local std::vector<double> tangent;
+		stress.resize(n);
+		tangent.resize(n);
+		return theMaterials[0]->setTrialBatch(n, theMaterials, strain, stress.data(), tangent.data());
+	}
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->setTrialStrain(strain[i]);
+
+	return errCode;
+}
+
+static int
+commitFiberState(int n, UniaxialMaterial **theMaterials)
+{
+	if (n > 1 && isSingleClass(n, theMaterials))
+		return theMaterials[0]->commitStateBatch(n, theMaterials);
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->commitState();
+
+	return errCode;
+}
+
+static int
+revertFiberState(int n, UniaxialMaterial **theMaterials)
+{
+	if (n > 1 && isSingleClass(n, theMaterials))
+		return theMaterials[0]->revertToLastCommitBatch(n, theMaterials);
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->revertToLastCommit();
+
+	return errCode;
+}
 
 // Read input parameters and build the material
 void *OPS_MVLEM(void)
@@ -602,12 +661,10 @@ MVLEM::commitState()
 	int errCode = 0;
 
 	// Commit Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsConcrete[i]->commitState();
+	errCode += commitFiberState(m, theMaterialsConcrete);
 
 	// Commit Steel material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsSteel[i]->commitState();
+	errCode += commitFiberState(m, theMaterialsSteel);
 
 	// Commit Shear material models
 	for (int i = 0; i < 1; i++)
@@ -622,12 +679,10 @@ MVLEM::revertToLastCommit()
 	int errCode = 0;
 
 	// Revert Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsConcrete[i]->revertToLastCommit();
+	errCode += revertFiberState(m, theMaterialsConcrete);
 
 	// Revert Steel material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsSteel[i]->revertToLastCommit();
+	errCode += revertFiberState(m, theMaterialsSteel);
 
 	// Revert Shear material model
 	for (int i = 0; i < 1; i++)
@@ -666,12 +721,10 @@ MVLEM::update()
 	int errCode1 = 0;
 
 	// Set trial response for Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode1 += theMaterialsConcrete[i]->setTrialStrain(MVLEMStrain[i]);
+	errCode1 += setFiberTrialStrain(m, theMaterialsConcrete, MVLEMStrain);
 
 	// Set trial response for Steel material models
-	for (int i = 0; i < m; i++)
-		errCode1 += theMaterialsSteel[i]->setTrialStrain(MVLEMStrain[i]);
+	errCode1 += setFiberTrialStrain(m, theMaterialsSteel, MVLEMStrain);
 
 	// Set trial response for Shear material model
 		errCode1 += theMaterialsShear[0]->setTrialStrain(MVLEMStrain[m]); 
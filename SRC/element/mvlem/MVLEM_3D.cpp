@@ -63,6 +63,110 @@ Matrix MVLEM_3D::MVLEM_3DMlocal(24, 24);
 Vector MVLEM_3D::MVLEM_3DRlocal(24);
 
 #include <elementAPI.h>
+#include <vector>
+
+// true when the n materials are all of the class of theMaterials[0], so 
+// their state can be updated in one batch call
+static bool
+isSingleClass(int n, UniaxialMaterial **theMaterials)
+{
+	int classTag = theMaterials[0]->getClassTag();
+	for (int i = 1; i < n; i++)
+		if (theMaterials[i]->getClassTag() != classTag)
+			return false;
+
+	return true;
+}
+
+// sets the trial strains of the n macro-fiber materials
+static int
+setFiberTrialStrain(int n, UniaxialMaterial **theMaterials, const double *strain)
+{
+	if (n > 1 && isSingleClass(n, theMaterials)) {
+		static thread_local std::vector<double> stress;
+		static thread_local std::vector<double> tangent;
+		stress.resize(n);
+		tangent.resize(n);
+		return theMaterials[0]->setTrialBatch(n, theMaterials, strain, stress.data(), tangent.data());
+	}
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->setTrialStrain(strain[i]);
+
+	return errCode;
+}
+
+static int
+commitFiberState(int n, UniaxialMaterial **theMaterials)
+{
+	if (n > 1 && isSingleClass(n, theMaterials))
+		return theMaterials[0]->commitStateBatch(n, theMaterials);
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->commitState();
+
+	return errCode;
+}
+
+static int
+revertFiberState(int n, UniaxialMaterial **theMaterials)
+{
+	if (n > 1 && isSingleClass(n, theMaterials))
+		return theMaterials[0]->revertToLastCommitBatch(n, theMaterials);
+
+	int errCode = 0;
+	for (int i = 0; i < n; i++)
+		errCode += theMaterials[i]->revertToLastCommit();
+
+	return errCode;
+}
+
+// Kg = T^T Kl T for the block diagonal transformation T built in 
+// setTransformation(), i.e. a 3x3 block Tt for each triple of the first
+// numNodalDOF dofs and identity for the remaining (internal) dofs; the
+// blocks are applied directly instead of the dense triple product and
+// the zero blocks of Kl are skipped
+static void
+transformToGlobal(const Matrix &Tt, const Matrix &Kl, Matrix &Kg, int numNodalDOF)
+{
+	int n = Kl.noRows();
+
+	static thread_local Matrix W;
+	if (W.noRows() != n)
+		W.resize(n, n);
+
+	// W = Kl T
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < numNodalDOF; j += 3) {
+			double k0 = Kl(i, j); double k1 = Kl(i, j + 1); double k2 = Kl(i, j + 2);
+			if (k0 == 0.0 && k1 == 0.0 && k2 == 0.0) {
+				W(i, j) = 0.0; W(i, j + 1) = 0.0; W(i, j + 2) = 0.0;
+				continue;
+			}
+			for (int c = 0; c < 3; c++)
+				W(i, j + c) = k0 * Tt(0, c) + k1 * Tt(1, c) + k2 * Tt(2, c);
+		}
+		for (int j = numNodalDOF; j < n; j++)
+			W(i, j) = Kl(i, j);
+	}
+
+	// Kg = T^T W
+	for (int j = 0; j < n; j++) {
+		for (int i = 0; i < numNodalDOF; i += 3) {
+			double w0 = W(i, j); double w1 = W(i + 1, j); double w2 = W(i + 2, j);
+			if (w0 == 0.0 && w1 == 0.0 && w2 == 0.0) {
+				Kg(i, j) = 0.0; Kg(i + 1, j) = 0.0; Kg(i + 2, j) = 0.0;
+				continue;
+			}
+			for (int r = 0; r < 3; r++)
+				Kg(i + r, j) = Tt(0, r) * w0 + Tt(1, r) * w1 + Tt(2, r) * w2;
+		}
+		for (int i = numNodalDOF; i < n; i++)
+			Kg(i, j) = W(i, j);
+	}
+}
 
 // Read input parameters and build the material
 void* OPS_MVLEM_3D(void)
@@ -750,12 +854,10 @@ int MVLEM_3D::commitState() {
 	int errCode = 0;
 
 	// Commit Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsConcrete[i]->commitState();
+	errCode += commitFiberState(m, theMaterialsConcrete);
 
 	// Commit Steel material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsSteel[i]->commitState();
+	errCode += commitFiberState(m, theMaterialsSteel);
 
 	// Commit Shear material models
 	for (int i = 0; i < 1; i++)
@@ -770,12 +872,10 @@ int MVLEM_3D::revertToLastCommit() {
 	int errCode = 0;
 
 	// Revert Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsConcrete[i]->revertToLastCommit();
+	errCode += revertFiberState(m, theMaterialsConcrete);
 
 	// Revert Steel material models
-	for (int i = 0; i < m; i++)
-		errCode += theMaterialsSteel[i]->revertToLastCommit();
+	errCode += revertFiberState(m, theMaterialsSteel);
 
 	// Revert Shear material model
 	for (int i = 0; i < 1; i++)
@@ -814,12 +914,10 @@ int MVLEM_3D::update() {
 	int errCode1 = 0;
 
 	// Set trial response for Concrete material models
-	for (int i = 0; i < m; i++)
-		errCode1 += theMaterialsConcrete[i]->setTrialStrain(MVLEM_3DStrain[i]);
+	errCode1 += setFiberTrialStrain(m, theMaterialsConcrete, MVLEM_3DStrain);
 
 	// Set trial response for Steel material models
-	for (int i = 0; i < m; i++)
-		errCode1 += theMaterialsSteel[i]->setTrialStrain(MVLEM_3DStrain[i]);
+	errCode1 += setFiberTrialStrain(m, theMaterialsSteel, MVLEM_3DStrain);
 
 	// Set trial response for Shear material model
 	errCode1 += theMaterialsShear[0]->setTrialStrain(MVLEM_3DStrain[m]);
@@ -1493,7 +1591,7 @@ const Matrix& MVLEM_3D::getInitialStiff(void)
 	MVLEM_3DKlocal(23, 23) = (Km + Kh * (h * h) * ((c - 1.0) * (c - 1.0))) / ((2.0 * (d * d) + 2.0) * (2.0 * (d * d) + 2.0)) + (4.0 * Eib * Iib) / Lw;
 
 	// Convert matrix from local to global cs 
-	MVLEM_3DK.addMatrixTripleProduct(0.0, T, MVLEM_3DKlocal, 1.0);
+	transformToGlobal(Tt, MVLEM_3DKlocal, MVLEM_3DK, 24);
 
 	// Return element stiffness matrix
 	return MVLEM_3DK;
@@ -2123,7 +2221,7 @@ const Matrix& MVLEM_3D::getTangentStiff(void)
 	MVLEM_3DKlocal(23, 23) = (Km + Kh * (h * h) * ((c - 1.0) * (c - 1.0))) / ((2.0 * (d * d) + 2.0) * (2.0 * (d * d) + 2.0)) + (4.0 * Eib * Iib) / Lw;
 
 	// Convert matrix from local to global cs
-	MVLEM_3DK.addMatrixTripleProduct(0.0, T, MVLEM_3DKlocal, 1.0);
+	transformToGlobal(Tt, MVLEM_3DKlocal, MVLEM_3DK, 24);
 
 	// Return element stiffness matrix
 	return MVLEM_3DK;
@@ -2151,7 +2249,7 @@ const Matrix & MVLEM_3D::getMass(void)
 	MVLEM_3DMlocal(20, 20) = NodeMass;
 
 	// Convert matrix from local to global cs
-	MVLEM_3DM.addMatrixTripleProduct(0.0, T, MVLEM_3DMlocal, 1.0); 
+	transformToGlobal(Tt, MVLEM_3DMlocal, MVLEM_3DM, 24);
 
 	// Return element mass matrix
 	return MVLEM_3DM;
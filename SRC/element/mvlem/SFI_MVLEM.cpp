@@ -51,6 +51,24 @@
 
 
 #include <elementAPI.h>
+#include <vector>
+
+// sets the trial strains of the m panel materials, strain holds the m x 
+// strains, then the m y strains and the m shear strains of the panels
+static int
+setPanelTrialStrain(int m, NDMaterial **theMaterials, const double *strain)
+{
+	static thread_local std::vector<double> panelStrain;
+	panelStrain.resize(3 * m);
+
+	for (int i = 0; i < m; i++) {
+		panelStrain[3 * i] = strain[i];
+		panelStrain[3 * i + 1] = strain[i + m];
+		panelStrain[3 * i + 2] = strain[i + 2 * m];
+	}
+
+	return NDMaterial::setTrialStrainGroups(m, theMaterials, panelStrain.data(), 3);
+}
 
 // Read input parameters and build the material
 void *OPS_SFI_MVLEM(void)
@@ -709,9 +727,7 @@ int SFI_MVLEM::commitState()
   int errCode = 0;
   
   // Commit material models
-  for (int i=0; i < m; i++)
-    
-    errCode += theMaterial[i]->commitState();
+  errCode += NDMaterial::commitStateGroups(m, theMaterial);
   
   return errCode;
 }
@@ -722,9 +738,7 @@ int SFI_MVLEM::revertToLastCommit()
   int errCode = 0;
   
   // Revert material models
-  for (int i=0; i < m; i++)
-    
-    errCode += theMaterial[i]->revertToLastCommit();
+  errCode += NDMaterial::revertToLastCommitGroups(m, theMaterial);
   
   return errCode;
 }
@@ -756,17 +770,8 @@ int SFI_MVLEM::update()
   // Set the strain in the materials
   int errCode1 = 0;
   
-  for (int i=0; i < m; i++) {
-    
-    Vector strain(3);
-    
-    strain(0) = SFI_MVLEMStrain[i];
-    strain(1) = SFI_MVLEMStrain[i+m];
-    strain(2) = SFI_MVLEMStrain[i+2*m];
-    
-    // Set trial response for material models
-    errCode1 += theMaterial[i]->setTrialStrain(strain); 
-  }
+  // Set trial response for material models
+  errCode1 += setPanelTrialStrain(m, theMaterial, SFI_MVLEMStrain);
   return errCode1 ;
 }
 
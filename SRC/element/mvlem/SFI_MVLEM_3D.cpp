@@ -52,6 +52,69 @@
 #include <DummyStream.h>
 
 #include <elementAPI.h>
+#include <vector>
+
+// sets the trial strains of the m panel materials, strain holds the m x 
+// strains, then the m y strains and the m shear strains of the panels
+static int
+setPanelTrialStrain(int m, NDMaterial **theMaterials, const double *strain)
+{
+	static thread_local std::vector<double> panelStrain;
+	panelStrain.resize(3 * m);
+
+	for (int i = 0; i < m; i++) {
+		panelStrain[3 * i] = strain[i];
+		panelStrain[3 * i + 1] = strain[i + m];
+		panelStrain[3 * i + 2] = strain[i + 2 * m];
+	}
+
+	return NDMaterial::setTrialStrainGroups(m, theMaterials, panelStrain.data(), 3);
+}
+
+// Kg = T^T Kl T for the block diagonal transformation T built in 
+// setTransformation(), i.e. a 3x3 block Tt for each triple of the first
+// numNodalDOF dofs and identity for the remaining (internal) dofs; the
+// blocks are applied directly instead of the dense triple product and
+// the zero blocks of Kl are skipped
+static void
+transformToGlobal(const Matrix &Tt, const Matrix &Kl, Matrix &Kg, int numNodalDOF)
+{
+	int n = Kl.noRows();
+
+	static thread_local Matrix W;
+	if (W.noRows() != n)
+		W.resize(n, n);
+
+	// W = Kl T
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < numNodalDOF; j += 3) {
+			double k0 = Kl(i, j); double k1 = Kl(i, j + 1); double k2 = Kl(i, j + 2);
+			if (k0 == 0.0 && k1 == 0.0 && k2 == 0.0) {
+				W(i, j) = 0.0; W(i, j + 1) = 0.0; W(i, j + 2) = 0.0;
+				continue;
+			}
+			for (int c = 0; c < 3; c++)
+				W(i, j + c) = k0 * Tt(0, c) + k1 * Tt(1, c) + k2 * Tt(2, c);
+		}
+		for (int j = numNodalDOF; j < n; j++)
+			W(i, j) = Kl(i, j);
+	}
+
+	// Kg = T^T W
+	for (int j = 0; j < n; j++) {
+		for (int i = 0; i < numNodalDOF; i += 3) {
+			double w0 = W(i, j); double w1 = W(i + 1, j); double w2 = W(i + 2, j);
+			if (w0 == 0.0 && w1 == 0.0 && w2 == 0.0) {
+				Kg(i, j) = 0.0; Kg(i + 1, j) = 0.0; Kg(i + 2, j) = 0.0;
+				continue;
+			}
+			for (int r = 0; r < 3; r++)
+				Kg(i + r, j) = Tt(0, r) * w0 + Tt(1, r) * w1 + Tt(2, r) * w2;
+		}
+		for (int i = numNodalDOF; i < n; i++)
+			Kg(i, j) = W(i, j);
+	}
+}
 
 // Read input parameters and build the element
 void* OPS_SFI_MVLEM_3D(void)
@@ -856,9 +919,7 @@ int SFI_MVLEM_3D::commitState()
 	int errCode = 0;
 
 	// Commit material models
-	for (int i = 0; i < m; i++) {
-		errCode += theMaterial[i]->commitState();
-	}
+	errCode += NDMaterial::commitStateGroups(m, theMaterial);
 
 	return errCode;
 }
@@ -869,9 +930,7 @@ int SFI_MVLEM_3D::revertToLastCommit()
 	int errCode = 0;
 
 	// Revert material models
-	for (int i = 0; i < m; i++) {
-		errCode += theMaterial[i]->revertToLastCommit();
-	}
+	errCode += NDMaterial::revertToLastCommitGroups(m, theMaterial);
 
 	return errCode;
 }
@@ -899,18 +958,8 @@ int SFI_MVLEM_3D::update()
 	// Set the strain in the materials
 	int errCode = 0;
 
-	for (int i = 0; i < m; i++) {
-
-		Vector strain(3);
-
-		strain(0) = SFI_MVLEM_3DStrain[i];
-		strain(1) = SFI_MVLEM_3DStrain[i + m];
-		strain(2) = SFI_MVLEM_3DStrain[i + 2 * m];
-
-		// Set trial response for material models
-		errCode += theMaterial[i]->setTrialStrain(strain);
-
-	}
+	// Set trial response for material models
+	errCode += setPanelTrialStrain(m, theMaterial, SFI_MVLEM_3DStrain);
 
 	return errCode;
 }
@@ -1622,7 +1671,7 @@ const Matrix & SFI_MVLEM_3D::getInitialStiff(void)
 	SFI_MVLEM_3DKlocal(23, 22) = SFI_MVLEM_3DKlocal(22, 23);
 	SFI_MVLEM_3DKlocal(23, 23) = (Km + Kh*(h*h)*((c - 1.0)*(c - 1.0))) / ((2.0 * (d*d) + 2.0)*(2.0 * (d*d) + 2.0)) + (4.0 * Eib*Iib) / Lw;
 
-	SFI_MVLEM_3DK.addMatrixTripleProduct(0.0, T, SFI_MVLEM_3DKlocal, 1.0);  // Convert matrix from local to global cs
+	transformToGlobal(Tt, SFI_MVLEM_3DKlocal, SFI_MVLEM_3DK, 24);  // Convert matrix from local to global cs
 
 	// Return element stiffness matrix
 	return SFI_MVLEM_3DK;
@@ -2265,7 +2314,7 @@ const Matrix & SFI_MVLEM_3D::getTangentStiff(void)
 	SFI_MVLEM_3DKlocal(23, 22) = SFI_MVLEM_3DKlocal(22, 23);
 	SFI_MVLEM_3DKlocal(23, 23) = (Km + Kh * (h * h) * ((c - 1.0) * (c - 1.0))) / ((2.0 * (d * d) + 2.0) * (2.0 * (d * d) + 2.0)) + (4.0 * Eib * Iib) / Lw;
 
-	SFI_MVLEM_3DK.addMatrixTripleProduct(0.0, T, SFI_MVLEM_3DKlocal, 1.0); // Convert matrix from local to global cs
+	transformToGlobal(Tt, SFI_MVLEM_3DKlocal, SFI_MVLEM_3DK, 24); // Convert matrix from local to global cs
 
 	// Return element Global stiffness matrix
 	return SFI_MVLEM_3DK;
@@ -2297,7 +2346,7 @@ const Matrix & SFI_MVLEM_3D::getMass(void)
 	SFI_MVLEM_3DMlocal(20, 20) = NodeMass;
 
 	// Convert matrix from local to global cs
-	SFI_MVLEM_3DM.addMatrixTripleProduct(0.0, T, SFI_MVLEM_3DMlocal, 1.0); 
+	transformToGlobal(Tt, SFI_MVLEM_3DMlocal, SFI_MVLEM_3DM, 24);
 
 	// Return element mass matrix
 	return SFI_MVLEM_3DM;
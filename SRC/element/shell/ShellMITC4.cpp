@@ -43,6 +43,7 @@
 #include <Domain.h>
 #include <ErrorHandler.h>
 #include <ShellMITC4.h>
+#include <MemoryReport.h>
 #include <R3vectors.h>
 #include <Renderer.h>
 #include <ElementResponse.h>
@@ -521,6 +522,17 @@ int  ShellMITC4::revertToStart( )
   return success ;
 }
 
+size_t
+ShellMITC4::getMaterialMemoryUsage(void)
+{
+  size_t result = 0;
+  for (int i = 0; i < 4; i++)
+    if (materialPointers[i] != 0)
+      result += materialPointers[i]->getMemoryUsage();
+
+  return result;
+}
+
 //print out element data
 void  ShellMITC4::Print( OPS_Stream &s, int flag )
 {
@@ -91,6 +91,7 @@ class ShellMITC4 : public Element {
 
     //print out element data
     void Print( OPS_Stream &s, int flag ) ;
+    size_t getMaterialMemoryUsage(void);
 	
     //return stiffness matrix 
     const Matrix &getTangentStiff( ) ;
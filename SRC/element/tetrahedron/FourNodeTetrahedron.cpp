@@ -46,6 +46,9 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <ElasticIsotropicMaterial.h>
+#include <ExplicitForceKernel.h>
+#include <string.h>
 #include <map>
 
 void* OPS_FourNodeTetrahedron()
@@ -1150,6 +1153,46 @@ FourNodeTetrahedron::update(void)
 }
 
 
+//*********************************************************************
+//a linear elastic isotropic material & no damping; the body forces and
+//the initial displacements go into the constant part of the force
+int
+FourNodeTetrahedron::addToForceKernel(ExplicitForceKernel &theKernel, const int *loc)
+{
+  if (!do_update || this->getNumDOF() != 12 || this->isFrozen() || !this->isActive())
+    return -1;
+  if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+    return -1;
+
+  if (strcmp(materialPointers[0]->getClassType(), "ElasticIsotropicThreeDimensional") != 0)
+    return -1;
+  ElasticIsotropicMaterial *theElastic = (ElasticIsotropicMaterial *)materialPointers[0];
+  double E = theElastic->getElasticModulus();
+  double nu = theElastic->getPoissonsRatio();
+  double lambda = E*nu/((1.0+nu)*(1.0-2.0*nu));
+  double mu = 0.5*E/(1.0+nu);
+
+  double xsj ;
+  double shp[4][4] ;
+  double gaussPoint[3] = {sg[0], sg[0], sg[0]} ;
+
+  computeBasis( ) ;
+  shp3d( gaussPoint, xsj, shp, xl ) ;
+  double dvol = wg[0] * xsj ;
+
+  double grad[12], P0[12], u0[12] ;
+  for ( int a = 0; a < 4; a++ ) {
+    for ( int i = 0; i < 3; i++ ) {
+      grad[3*a+i] = shp[i][a] ;
+      P0[3*a+i] = dvol*b[i]*shp[3][a] ;
+      u0[3*a+i] = initDisp[a](i) ;
+    }
+  }
+
+  return theKernel.addTetrahedron(loc, grad, dvol, lambda, mu, P0, u0);
+}
+
+
 //*********************************************************************
 //form residual and tangent
 void  FourNodeTetrahedron::formResidAndTangent( int tang_flag ) 
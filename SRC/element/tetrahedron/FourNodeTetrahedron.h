@@ -94,6 +94,7 @@ class FourNodeTetrahedron : public Element {
 
     // update
     int update(void);
+    int addToForceKernel(ExplicitForceKernel &theKernel, const int *loc);
 
     //print out element data
     void Print( OPS_Stream &s, int flag ) ;
@@ -47,6 +47,7 @@
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
 #include <map>
+#include <AnalysisProfiler.h>
 
 void* OPS_TenNodeTetrahedron()
 {
@@ -397,8 +398,11 @@ int  TenNodeTetrahedron::commitState( )
     }
 
 
-    for (int i = 0; i < NumGaussPoints; i++ )
-        success += materialPointers[i]->commitState( ) ;
+    if ( this->isSingleMaterialType( ) )
+        success += materialPointers[0]->commitStateBatch( NumGaussPoints, materialPointers ) ;
+    else
+        for (int i = 0; i < NumGaussPoints; i++ )
+            success += materialPointers[i]->commitState( ) ;
 
     return success ;
 }
@@ -410,8 +414,11 @@ int  TenNodeTetrahedron::revertToLastCommit( )
     int i ;
     int success = 0 ;
 
-    for ( i = 0; i < NumGaussPoints; i++ )
-        success += materialPointers[i]->revertToLastCommit( ) ;
+    if ( this->isSingleMaterialType( ) )
+        success += materialPointers[0]->revertToLastCommitBatch( NumGaussPoints, materialPointers ) ;
+    else
+        for ( i = 0; i < NumGaussPoints; i++ )
+            success += materialPointers[i]->revertToLastCommit( ) ;
 
     return success ;
 }
@@ -1034,6 +1041,8 @@ TenNodeTetrahedron::update(void)
 
     static Vector strain(nstress) ;  //strain
 
+    static double gaussStrain[numberGauss*nstress] ;  //strains at all gauss points
+
     static double shp[nShape][numberNodes] ;  //shape functions at a gauss point
 
     static double Shape[nShape][numberNodes][numberGauss] ; //all the shape functions
@@ -1171,18 +1180,40 @@ TenNodeTetrahedron::update(void)
         } // end for j
         // opserr << "TenNodeTetrahedron::update -- 4.3 i = " << i << endln;
 
-        //send the strain to the material
-        success = materialPointers[i]->setTrialStrain( strain ) ;
-
-        // opserr << "TenNodeTetrahedron::update -- 4.4 i = " << i << "strain = " << strain << endln;
+        //save the strain for the material
+        for ( p = 0; p < nstress; p++ )
+            gaussStrain[i*nstress+p] = strain(p) ;
 
     } //end for i gauss loop
+
+    //send the strains to the materials, in one call if they are of one class
+    if ( this->isSingleMaterialType( ) ) {
+        ProfileClass cost( ProfileClass::Material, materialPointers[0] ) ;
+        success = materialPointers[0]->setTrialStrainBatch( numberGauss, materialPointers,
+                                                             gaussStrain, nstress ) ;
+    }
+    else
+        success = materialPointers[0]->NDMaterial::setTrialStrainBatch( numberGauss, materialPointers,
+                                                                         gaussStrain, nstress ) ;
+
     // opserr << "TenNodeTetrahedron::update -- 5" << endln;
     // opserr << "TenNodeTetrahedron::update -- END" << endln;
     return 0;
 }
 
 
+//all materials of one class
+bool  TenNodeTetrahedron::isSingleMaterialType( ) const
+{
+    int classTag = materialPointers[0]->getClassTag( ) ;
+    for ( int i = 1; i < NumGaussPoints; i++ )
+        if ( materialPointers[i]->getClassTag( ) != classTag )
+            return false ;
+
+    return true ;
+}
+
+
 //*********************************************************************
 //form residual and tangent
 void  TenNodeTetrahedron::formResidAndTangent( int tang_flag )
@@ -204,6 +204,9 @@ private :
     //compute coordinate system
     void computeBasis( ) ;
 
+    //true if all the materials are of one class, so they can go as a batch
+    bool isSingleMaterialType( ) const ;
+
     //compute B matrix
     const Matrix& computeB( int node, const double shp[4][NumNodes] ) ;
 
@@ -35,6 +35,8 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <UniaxialMaterial.h>
+#include <ElasticMaterial.h>
+#include <ExplicitForceKernel.h>
 #include <Renderer.h>
 
 #include <Parameter.h>
@@ -606,6 +608,31 @@ CorotTruss::update(void)
   return theMaterial->setTrialStrain(strain,rate);
 }
 
+// a linear elastic material & no damping
+int
+CorotTruss::addToForceKernel(ExplicitForceKernel &theKernel, const int *loc)
+{
+  if (Lo == 0.0 || this->isFrozen() || !this->isActive())
+    return -1;
+  if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+    return -1;
+
+  ElasticMaterial *theElastic = dynamic_cast<ElasticMaterial *>(theMaterial);
+  if (theElastic == 0)
+    return -1;
+  double E = theElastic->getLinearModulus();
+  if (E == 0.0)
+    return -1;
+
+  double rows[9];
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      rows[3*i+j] = R(i,j);
+
+  return theKernel.addCorotTruss(numDIM, loc, loc + numDOF/2, rows,
+				 Lo, E*A/Lo);
+}
+
 const Matrix &
 CorotTruss::getTangentStiff(void)
 {
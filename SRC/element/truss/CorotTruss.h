@@ -69,6 +69,7 @@ class CorotTruss : public Element
     int revertToLastCommit(void);        
     int revertToStart(void);        
     int update(void);
+    int addToForceKernel(ExplicitForceKernel &theKernel, const int *loc);
     
     // public methods to obtain stiffness, mass, damping and residual information    
     const Matrix &getTangentStiff(void);
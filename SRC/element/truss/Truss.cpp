@@ -40,6 +40,8 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <UniaxialMaterial.h>
+#include <ElasticMaterial.h>
+#include <ExplicitForceKernel.h>
 #include <Renderer.h>
 
 #include <math.h>
@@ -523,6 +525,33 @@ Truss::update(void)
 }
 
 
+// a linear elastic material & no damping; the elongation at the
+// initial displacement carries no force
+int
+Truss::addToForceKernel(ExplicitForceKernel &theKernel, const int *loc)
+{
+    if (L == 0.0 || this->isFrozen() || !this->isActive())
+      return -1;
+    if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+      return -1;
+
+    ElasticMaterial *theElastic = dynamic_cast<ElasticMaterial *>(theMaterial);
+    if (theElastic == 0)
+      return -1;
+    double E = theElastic->getLinearModulus();
+    if (E == 0.0)
+      return -1;
+
+    double offset = 0.0;
+    if (useInitialDisp && initialDisp != 0)
+      for (int i = 0; i < dimension; i++)
+	offset += initialDisp[i]*cosX[i];
+
+    return theKernel.addTruss(dimension, loc, loc + numDOF/2, cosX,
+			      E*A/L, offset);
+}
+
+
 const Matrix &
 Truss::getTangentStiff(void)
 {
@@ -73,6 +73,7 @@ class Truss : public Element
     int revertToLastCommit(void);        
     int revertToStart(void);        
     int update(void);
+    int addToForceKernel(ExplicitForceKernel &theKernel, const int *loc);
     
     // public methods to obtain stiffness, mass, damping and residual information    
     const Matrix &getKi(void);
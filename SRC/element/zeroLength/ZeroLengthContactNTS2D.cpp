@@ -35,6 +35,7 @@
 #include <Information.h>
 
 #include <Domain.h>
+#include <NodeSearchGrid.h>
 #include <Node.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -43,6 +44,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <ElementResponse.h>
 
 static int numZeroLengthContactNTS2D = 0;
@@ -179,6 +181,8 @@ ZeroLengthContactNTS2D::ZeroLengthContactNTS2D(int tag, int sNdNum, int pNdNum,
   // allocate shear gap vector
   shear_gap.resize(numberNodes);
   stored_shear_gap.resize(numberNodes);
+  nodeContactFlag.resize(numberNodes);
+  nodeContactFlag.Zero();
   
   // ensure the connectedExternalNode ID is of correct size & set values
   if (connectedExternalNodes.Size() != numberNodes)
@@ -296,6 +300,15 @@ ZeroLengthContactNTS2D::setDomain(Domain *theDomain)
 		numDOF += dofNd;
 	}
 
+	// to go from the nodes found by the contact search to the local ones
+	localNode.clear();
+	for (int i = 0; i < numberNodes; i++) {
+		if (localNode.insert(std::make_pair(connectedExternalNodes(i), i)).second == false) {
+			localNode.clear();
+			break;
+		}
+	}
+
 /*
     // Check that length is zero within tolerance
     const Vector &end1Crd = nodePointers[0]->getCrds();
@@ -320,8 +333,8 @@ int
 ZeroLengthContactNTS2D::commitState()
 {
    // need to update stick point here
-    if (ContactFlag == 2 )   // slide case, update stick point
-		for(int i = 0; i < numberNodes; i++) 
+	for(int i = 0; i < numberNodes; i++) 
+		if (nodeContactFlag(i) == 2)   // slide case, update stick point
 			stored_shear_gap(i) = shear_gap(i);
 
 	return 0;
@@ -562,8 +575,9 @@ int ZeroLengthContactNTS2D::contactDetect(int s, int m1, int m2, int stage)
 	 double alpha_bar = 0;
 	 for (int i = 0; i < 2; i++) 
 		 alpha_bar += (1/L_bar) * (xs(i) - x1(i)) * ContactTangent(i);
-     // shear deformation given before and after deformation along segment
-     shear_gap(s) = (alpha - alpha_bar) * L_bar;
+     // shear deformation given before and after deformation along segment,
+     // kept only for the segment the node is in contact with
+     double sgap = (alpha - alpha_bar) * L_bar;
 
 /*
      /////////////////////////////// for transient gap ///////////////////////////////
@@ -585,6 +599,7 @@ int ZeroLengthContactNTS2D::contactDetect(int s, int m1, int m2, int stage)
 	 // stage = 1 means searching primary nodes against secondary segments
      if ((stage == 0  && normal_gap(s) >= 0 && alpha > 0 && alpha < 1) ||
 		 (stage == 1  && normal_gap(s) >= 0 && alpha >= 0 && alpha <= 1)) { // in contact
+		 shear_gap(s) = sgap;
 		 N(0) = ContactNormal(0);
 	     N(1) = ContactNormal(1);
 	     N(2) = -(1 - alpha) * N(0);
@@ -613,9 +628,6 @@ void  ZeroLengthContactNTS2D::formLocalResidAndTangent( int tang_flag , int seco
 	double Phi;
 	int i, j;
 
-	for (i = 0; i < numberNodes; i++) 
-		pressure(i) = 0;
-
     t_trial=0;
 
 	//int IsContact;
@@ -668,6 +680,7 @@ void  ZeroLengthContactNTS2D::formLocalResidAndTangent( int tang_flag , int seco
             double shear = fc * pressure(secondary) * (t_trial/TtrNorm);
 			for (i = 0; i < 6; i++) resid(loctoglob[i]) += (pressure(secondary) * N(i)) + (shear * T(i)) ;      //2D
 		} //endif slide
+		nodeContactFlag(secondary) = ContactFlag;
 	}  // endif ContactFlag==1
 }
 
@@ -678,6 +691,31 @@ void  ZeroLengthContactNTS2D::formGlobalResidAndTangent( int tang_flag )
 	// but on contrary in the second loop the node to node contact 
 	// will be considered and this can be controlled by "stage = 0 or 1"
 
+	// the contact state of each node is that of this evaluation
+	for (int i = 0; i < numberNodes; i++) {
+		pressure(i) = 0;
+		nodeContactFlag(i) = 0;
+	}
+
+	if (this->getDomain() != 0 && localNode.empty() == false) {
+		// a node in contact with a segment is within a segment length
+		// from one of its ends, only those segments are tested
+		double radius = maxSegmentLength(SecondaryNodeNum, SecondaryNodeNum + PrimaryNodeNum);
+		for (int i = 0 ; i < SecondaryNodeNum; i++) {
+			findSegments(i, SecondaryNodeNum, SecondaryNodeNum + PrimaryNodeNum, radius);
+			for (size_t k = 0; k < segments.size(); k++)
+				formLocalResidAndTangent( tang_flag, i, segments[k], segments[k]+1 , 0);  // stage = 0 //
+		}
+
+		radius = maxSegmentLength(0, SecondaryNodeNum);
+		for (int i = SecondaryNodeNum ; i < SecondaryNodeNum + PrimaryNodeNum; i++) {
+			findSegments(i, 0, SecondaryNodeNum, radius);
+			for (size_t k = 0; k < segments.size(); k++)
+				formLocalResidAndTangent( tang_flag, i, segments[k], segments[k]+1 , 1);  // stage = 1 //
+		}
+		return;
+	}
+
 	// loop over sedondary nodes and find the nodes 
     // which are in contact with primary's segments
 	for (int i = 0 ; i < SecondaryNodeNum; i++) {
@@ -694,3 +732,58 @@ void  ZeroLengthContactNTS2D::formGlobalResidAndTangent( int tang_flag )
         } // endfor j
     } // endfor i
 }
+
+// longest current length of the segments of the nodes first to last-1
+double ZeroLengthContactNTS2D::maxSegmentLength(int first, int last)
+{
+	double Lmax = 0.0;
+	for (int j = first; j < last - 1; j++) {
+		const Vector &x1 = nodePointers[j]->getCrds();
+		const Vector &u1 = nodePointers[j]->getTrialDisp();
+		const Vector &x2 = nodePointers[j+1]->getCrds();
+		const Vector &u2 = nodePointers[j+1]->getTrialDisp();
+		double dx = x2(0) + u2(0) - x1(0) - u1(0);
+		double dy = x2(1) + u2(1) - x1(1) - u1(1);
+		double L = sqrt(dx*dx + dy*dy);
+		if (L > Lmax)
+			Lmax = L;
+	}
+	return Lmax;
+}
+
+// the segments (j,j+1) of the nodes first to last-1 with an end within
+// radius of node, in increasing order of j; a node with none nearby, as
+// one that has penetrated deeper than radius, gets all the segments
+void ZeroLengthContactNTS2D::findSegments(int node, int first, int last, double radius)
+{
+	segments.clear();
+
+	const Vector &x = nodePointers[node]->getCrds();
+	const Vector &u = nodePointers[node]->getTrialDisp();
+	double pos[3] = {x(0) + u(0), x(1) + u(1), 0.0};
+
+	NodeSearchGrid &theGrid = this->getDomain()->getNodeSearchGrid();
+	int numFound = theGrid.findNodes(pos, radius, foundNodes);
+
+	for (int k = 0; k < numFound; k++) {
+		std::map<int,int>::const_iterator it = localNode.find(foundNodes(k));
+		if (it == localNode.end())
+			continue;
+		int j = it->second;
+		if (j < first || j >= last)
+			continue;
+		if (j > first)
+			segments.push_back(j-1);
+		if (j < last - 1)
+			segments.push_back(j);
+	}
+
+	if (segments.empty()) {
+		for (int j = first; j < last - 1; j++)
+			segments.push_back(j);
+		return;
+	}
+
+	std::sort(segments.begin(), segments.end());
+	segments.erase(std::unique(segments.begin(), segments.end()), segments.end());
+}
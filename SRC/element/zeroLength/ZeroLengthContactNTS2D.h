@@ -68,6 +68,10 @@
  [6] As opposed to node-to-node contact, predefined normal vector for node-to-segment (NTS) element is not required 
          because contact normal will be calculated automatically at each step.
  [7] The contact element is implemented to handle large deformations.
+ [8] The node-segment pairs are found with the node search grid of the Domain: a node is only
+        tested against the segments with an end within the longest segment length of it.
+        The contact state, and so the stick point updated on commit, is kept for each node,
+        it does not depend on the order in which the pairs are evaluated.
 
 
   References:
@@ -79,6 +83,9 @@
 
 #include <Element.h>
 #include <Matrix.h>
+#include <ID.h>
+#include <map>
+#include <vector>
 
 // Tolerance for zero length of element
 //#define	LENTOL 1.0e-6
@@ -156,12 +163,16 @@ class ZeroLengthContactNTS2D: public Element
   Vector T;
   Vector ContactNormal;  // out normal of primary element
   int ContactFlag;                    // 0: not contact; 1: stick; 2: slide
+  ID nodeContactFlag;                 // ContactFlag of each node in contact
   int numDOF;	                        // number of dof for ZeroLength
   // detect the contact and set flag
   int contactDetect(int s, int m1, int m2, int stage);
   //form residual and tangent
   void formLocalResidAndTangent( int tang_flag , int secondary, int primary1, int primary2, int stage);
   void formGlobalResidAndTangent(int tang_flag );
+  // broad phase of the contact search
+  double maxSegmentLength(int first, int last);
+  void findSegments(int node, int first, int last, double radius);
   Matrix *Ki; 	    	// pointer to objects matrix (a class Matrix)
   Vector *load;         	// pointer to objects vector (a class Vector)
   // variables for 2D contact
@@ -171,6 +182,9 @@ class ZeroLengthContactNTS2D: public Element
   int SecondaryNodeNum;
   int PrimaryNodeNum;
   double *restore_shear_gap;
+  std::map<int,int> localNode;   // local index of the node tags, empty if a tag repeats
+  ID foundNodes;
+  std::vector<int> segments;     // first nodes of the candidate segments
 };
 
 #endif
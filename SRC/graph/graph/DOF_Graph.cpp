@@ -43,6 +43,7 @@
 #include <DOF_GrpIter.h>
 #include <FE_Element.h>
 #include <FE_EleIter.h>
+#include <vector>
 
 #define START_EQN_NUM 0
 // constructs the Graph
@@ -106,32 +107,29 @@ DOF_Graph::DOF_Graph(AnalysisModel &theModel)
   }
 
   // now add the edges, by looping over the FE_elements, getting their
-  // IDs and adding edges between DOFs for equation numbers >= START_EQN_NUM
+  // IDs and collecting the DOFs with equation numbers >= START_EQN_NUM;
+  // the DOFs of each element are a clique of the graph, the edges of all
+  // the cliques are then added in one go
   
+  std::vector<int> cliqueStart(1, 0);
+  std::vector<int> cliqueVertices;
+
   FE_Element *elePtr =0;
   FE_EleIter &eleIter = myModel.getFEs();
-  int cnt = 0;
 
   while((elePtr = eleIter()) != 0) {
     const ID &id = elePtr->getID();
-    cnt++;
     int size = id.Size();
     for (int i=0; i<size; i++) {
-      int eqn1 = id(i);
-	    
-      // if eqnNum of DOF is a valid eqn number add an edge
-      // to all other DOFs with valid eqn numbers.
-      
-      if (eqn1 >=START_EQN_NUM) {
-	for (int j=i+1; j<size; j++) {
-	  int eqn2 = id(j);
-	  if (eqn2 >=START_EQN_NUM)
-	    this->addEdge(eqn1-START_EQN_NUM+START_VERTEX_NUM,
-			  eqn2-START_EQN_NUM+START_VERTEX_NUM);
-	}
-      }
+      int eqn = id(i);
+      if (eqn >=START_EQN_NUM)
+	cliqueVertices.push_back(eqn-START_EQN_NUM+START_VERTEX_NUM);
     }
+    cliqueStart.push_back(cliqueVertices.size());
   }
+
+  if (this->addCliques(cliqueStart, cliqueVertices) < 0)
+    opserr << "WARNING DOF_Graph::DOF_Graph - error adding edges\n";
 }
 
 DOF_Graph::~DOF_Graph()
@@ -40,6 +40,7 @@
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
+#include <vector>
 
 // constructs the Graph
 DOF_GroupGraph::DOF_GroupGraph(AnalysisModel &theModel)
@@ -79,24 +80,26 @@ DOF_GroupGraph::DOF_GroupGraph(AnalysisModel &theModel)
     }
 
 
-    // now add the edges, by looping over the Elements, getting their
-    // IDs and adding edges between DOFs for equation numbers >= START_EQN_NUM
+    // now add the edges, by looping over the Elements, getting the tags
+    // of their DOF_Groups; those of each element form a clique & the
+    // edges of all the cliques are added at once
     
+    std::vector<int> cliqueStart(1, 0);
+    std::vector<int> cliqueVertices;
+
     FE_Element *elePtr;
     FE_EleIter &eleIter = myModel.getFEs();
 
     while((elePtr = eleIter()) != 0) {
 	const ID &id = elePtr->getDOFtags();
 	int size = id.Size();
-	for (int i=0; i<size; i++) {
-	    int dof1 = id(i);
-	    for (int j=0; j<size; j++) 
-		if (i != j) {
-		    int dof2 = id(j);
-		    this->addEdge(dof1,dof2);
-		}
-	}
+	for (int i=0; i<size; i++)
+	    cliqueVertices.push_back(id(i));
+	cliqueStart.push_back(cliqueVertices.size());
     }
+
+    if (this->addCliques(cliqueStart, cliqueVertices) < 0)
+	opserr << "WARNING DOF_GroupGraph::DOF_GroupGraph - error adding edges\n";
 }
 
 DOF_GroupGraph::~DOF_GroupGraph()
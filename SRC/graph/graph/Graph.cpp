@@ -36,16 +36,17 @@
 #include <Graph.h>
 #include <Vertex.h>
 #include <VertexIter.h>
-#include <MapOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <Vector.h>
+#include <algorithm>
 
 Graph::Graph()
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
   vertices()
 {
-    myVertices = new MapOfTaggedObjects();
+    myVertices = new HashOfTaggedObjects();
     theVertexIter = new VertexIter(myVertices);
 }
 
@@ -54,7 +55,9 @@ Graph::Graph(int numVertices)
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
   vertices()
 {
-    myVertices = new MapOfTaggedObjects();
+    myVertices = new HashOfTaggedObjects();
+    if (numVertices > 0)
+      myVertices->setSize(numVertices);
     theVertexIter = new VertexIter(myVertices);
 }
 
@@ -78,7 +81,7 @@ Graph::Graph(Graph &other)
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
   vertices()
 {
-  myVertices = new MapOfTaggedObjects();
+  myVertices = new HashOfTaggedObjects();
   theVertexIter = new VertexIter(myVertices);
 
   VertexIter &otherVertices = other.getVertices();
@@ -275,6 +278,116 @@ Graph::addEdgeFast(int vertexTag, int otherVertexTag)
     return result;
 }
 
+// int addCliques(const std::vector<int> &cliqueStart, 
+//                const std::vector<int> &cliqueVertices);
+// Adds an edge between every pair of vertices in each clique: clique i
+// holds the vertex tags cliqueVertices[cliqueStart[i]] up to, but not
+// including, cliqueVertices[cliqueStart[i+1]]; tags < 0 are ignored. All
+// the vertices must be in the graph. Instead of inserting the edges one
+// at a time the adjacency of each vertex is gathered from the cliques it
+// is in, which is done in parallel when OpenMP is enabled. Returns 0 if
+// successful, a negative number if not.
+
+int
+Graph::addCliques(const std::vector<int> &cliqueStart,
+		  const std::vector<int> &cliqueVertices)
+{
+    int numClique = int(cliqueStart.size()) - 1;
+    if (numClique <= 0)
+	return 0;
+
+    // a dense local number for each vertex
+    std::vector<Vertex *> theVertices;
+    int maxTag = -1;
+    VertexIter &theIter = this->getVertices();
+    Vertex *vertexPtr;
+    while ((vertexPtr = theIter()) != 0) {
+	theVertices.push_back(vertexPtr);
+	if (vertexPtr->getTag() > maxTag)
+	    maxTag = vertexPtr->getTag();
+    }
+    int numVertex = int(theVertices.size());
+
+    std::vector<int> local(maxTag+1, -1);
+    for (int i=0; i<numVertex; i++)
+	if (theVertices[i]->getTag() >= 0)
+	    local[theVertices[i]->getTag()] = i;
+
+    // the cliques each vertex is in
+    std::vector<int> memberStart(numVertex+1, 0);
+    for (int c=0; c<numClique; c++)
+	for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++) {
+	    int tag = cliqueVertices[k];
+	    if (tag < 0)
+		continue;
+	    if (tag > maxTag || local[tag] < 0) {
+		opserr << "WARNING Graph::addCliques() - vertex " << tag << " not in Graph\n";
+		return -1;
+	    }
+	    memberStart[local[tag]+1]++;
+	}
+    for (int i=0; i<numVertex; i++)
+	memberStart[i+1] += memberStart[i];
+
+    std::vector<int> members(memberStart[numVertex]);
+    std::vector<int> next(memberStart.begin(), memberStart.end()-1);
+    for (int c=0; c<numClique; c++)
+	for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++) {
+	    int tag = cliqueVertices[k];
+	    if (tag >= 0)
+		members[next[local[tag]]++] = c;
+	}
+
+    // gather the adjacency of each vertex: the edges it already has and
+    // the other vertices of its cliques, each once
+    int numAdjacent = 0;
+
+#pragma omp parallel reduction(+:numAdjacent)
+    {
+	std::vector<int> marker(maxTag+1, -1);
+	std::vector<int> adjacent;
+
+#pragma omp for schedule(dynamic, 256)
+	for (int i=0; i<numVertex; i++) {
+	    Vertex *theVertex = theVertices[i];
+	    int tag = theVertex->getTag();
+	    adjacent.clear();
+	    marker[tag] = i;
+
+	    const ID &old = theVertex->getAdjacency();
+	    for (int k=0; k<old.Size(); k++) {
+		int other = old(k);
+		if (other >= 0 && other <= maxTag && marker[other] != i) {
+		    marker[other] = i;
+		    adjacent.push_back(other);
+		}
+	    }
+
+	    for (int m=memberStart[i]; m<memberStart[i+1]; m++) {
+		int c = members[m];
+		for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++) {
+		    int other = cliqueVertices[k];
+		    if (other >= 0 && marker[other] != i) {
+			marker[other] = i;
+			adjacent.push_back(other);
+		    }
+		}
+	    }
+
+	    std::sort(adjacent.begin(), adjacent.end());
+	    int size = int(adjacent.size());
+	    ID adjacency(size);
+	    for (int k=0; k<size; k++)
+		adjacency(k) = adjacent[k];
+	    theVertex->setAdjacency(adjacency);
+	    numAdjacent += size;
+	}
+    }
+
+    numEdge = numAdjacent/2;
+    return 0;
+}
+
 Vertex *
 Graph::getVertexPtr(int vertexTag)
 {
@@ -59,6 +59,8 @@ class Graph
     virtual int addEdge(int vertexTag, int otherVertexTag);
     virtual void startAddEdge();
     virtual int addEdgeFast(int vertexTag, int otherVertexTag);
+    virtual int addCliques(const std::vector<int> &cliqueStart,
+			   const std::vector<int> &cliqueVertices);
     
     virtual Vertex *getVertexPtr(int vertexTag);
     virtual VertexIter &getVertices(void);
@@ -0,0 +1,128 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of GraphColoring.
+//
+// What: "@(#) GraphColoring.C, revA"
+
+#include <GraphColoring.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+
+// the least used color not forbidden to item, a new one if all are
+static int
+leastUsedColor(std::vector<int> &colorSize, const std::vector<int> &forbidden, int item)
+{
+    int theColor = -1;
+    int numColors = int(colorSize.size());
+    for (int c=0; c<numColors; c++)
+	if (forbidden[c] != item && (theColor < 0 || colorSize[c] < colorSize[theColor]))
+	    theColor = c;
+
+    if (theColor < 0) {
+	theColor = numColors;
+	colorSize.push_back(0);
+    }
+    colorSize[theColor]++;
+    return theColor;
+}
+
+int
+GraphColoring::color(Graph &theGraph)
+{
+    Vertex *vertexPtr;
+    VertexIter &theVertices = theGraph.getVertices();
+    while ((vertexPtr = theVertices()) != 0)
+	vertexPtr->setColor(-1);
+
+    std::vector<int> colorSize;
+    std::vector<int> forbidden;
+    int count = 0;
+
+    VertexIter &theVertices2 = theGraph.getVertices();
+    while ((vertexPtr = theVertices2()) != 0) {
+	const ID &adjacency = vertexPtr->getAdjacency();
+	for (int i=0; i<adjacency.Size(); i++) {
+	    Vertex *otherPtr = theGraph.getVertexPtr(adjacency(i));
+	    if (otherPtr != 0 && otherPtr->getColor() >= 0)
+		forbidden[otherPtr->getColor()] = count;
+	}
+	int theColor = leastUsedColor(colorSize, forbidden, count);
+	if (int(forbidden.size()) < int(colorSize.size()))
+	    forbidden.resize(colorSize.size(), -1);
+	vertexPtr->setColor(theColor);
+	count++;
+    }
+
+    return int(colorSize.size());
+}
+
+int
+GraphColoring::colorCliques(const std::vector<int> &cliqueStart,
+			    const std::vector<int> &cliqueVertices,
+			    int numVertex, std::vector<int> &colors)
+{
+    int numClique = int(cliqueStart.size()) - 1;
+    colors.assign(numClique > 0 ? numClique : 0, -1);
+    if (numClique <= 0)
+	return 0;
+
+    // the cliques each vertex is in
+    std::vector<int> memberStart(numVertex+1, 0);
+    for (int i=0; i<numClique; i++)
+	for (int j=cliqueStart[i]; j<cliqueStart[i+1]; j++) {
+	    int v = cliqueVertices[j];
+	    if (v >= 0 && v < numVertex)
+		memberStart[v+1]++;
+	}
+    for (int v=0; v<numVertex; v++)
+	memberStart[v+1] += memberStart[v];
+
+    std::vector<int> members(memberStart[numVertex]);
+    std::vector<int> next(memberStart.begin(), memberStart.end()-1);
+    for (int i=0; i<numClique; i++)
+	for (int j=cliqueStart[i]; j<cliqueStart[i+1]; j++) {
+	    int v = cliqueVertices[j];
+	    if (v >= 0 && v < numVertex)
+		members[next[v]++] = i;
+	}
+
+    std::vector<int> colorSize;
+    std::vector<int> forbidden;
+    for (int i=0; i<numClique; i++) {
+	for (int j=cliqueStart[i]; j<cliqueStart[i+1]; j++) {
+	    int v = cliqueVertices[j];
+	    if (v < 0 || v >= numVertex)
+		continue;
+	    for (int k=memberStart[v]; k<memberStart[v+1]; k++) {
+		int other = colors[members[k]];
+		if (other >= 0)
+		    forbidden[other] = i;
+	    }
+	}
+	colors[i] = leastUsedColor(colorSize, forbidden, i);
+	if (int(forbidden.size()) < int(colorSize.size()))
+	    forbidden.resize(colorSize.size(), -1);
+    }
+
+    return int(colorSize.size());
+}
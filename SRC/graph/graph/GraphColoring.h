@@ -0,0 +1,54 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for GraphColoring.
+// GraphColoring colors the vertices of a Graph, or a set of cliques, so
+// that no two adjacent ones have the same color. The colors are balanced:
+// each one is given the least used of the colors allowed to it, the lowest
+// on ties, and the vertices or cliques are taken in order, so the result
+// is deterministic.
+//
+// What: "@(#) GraphColoring.h, revA"
+
+#ifndef GraphColoring_h
+#define GraphColoring_h
+
+#include <vector>
+
+class Graph;
+
+class GraphColoring
+{
+  public:
+    // sets the color of each vertex of theGraph, 0 through numColors-1,
+    // with adjacent vertices of different colors; returns numColors
+    static int color(Graph &theGraph);
+
+    // colors the cliques, clique i holding the vertices with the numbers
+    // cliqueVertices[cliqueStart[i]] up to cliqueVertices[cliqueStart[i+1]],
+    // 0 through numVertex-1 (others are ignored), so that no two cliques
+    // sharing a vertex have the same color: the distance-2 coloring of the
+    // graph of the cliques and their vertices; returns numColors
+    static int colorCliques(const std::vector<int> &cliqueStart,
+			    const std::vector<int> &cliqueVertices,
+			    int numVertex, std::vector<int> &colors);
+};
+
+#endif
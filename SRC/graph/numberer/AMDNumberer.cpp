@@ -61,6 +61,10 @@ AMD::number(Graph &theGraph, int startVertex)
   if (numVertex == 0) 
     return theResult;
 
+  // or keep the last ordering, repaired, if warm started
+  if (this->repairOrdering(theGraph, theResult))
+    return theResult;
+
   theResult.resize(numVertex);
 
   int nnz = 0;
@@ -100,11 +104,20 @@ AMD::number(Graph &theGraph, int startVertex)
   delete [] Ap;
   delete [] Ai;
 
+  this->keepOrdering(theGraph, theResult);
+
   return theResult;
 }
 
 
 
+bool
+AMD::isFillReducing(void)
+{
+    return true;
+}
+
+
 int
 AMD::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -33,8 +33,15 @@
 
 
 #include <GraphNumberer.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <vector>
+#include <algorithm>
+
 GraphNumberer::GraphNumberer(int cTag)
-:MovableObject(cTag)
+:MovableObject(cTag), warmTol(0.0), fullCost(-1.0)
 {
     // does nothing
 }
@@ -44,6 +51,222 @@ GraphNumberer::~GraphNumberer()
     // does nothing
 }
 
+bool
+GraphNumberer::isFillReducing(void)
+{
+    return false;
+}
+
+void
+GraphNumberer::setWarmStart(double tol)
+{
+    warmTol = tol;
+    if (warmTol <= 0.0) {
+	lastPosition.clear();
+	fullCost = -1.0;
+    }
+}
+
+// bool repairOrdering(Graph &theGraph, ID &theResult)
+//    Method to order the graph from the last ordering. The vertices kept
+// are ordered as before, those added get the mean position of the vertices
+// they are attached to, level after level, and any left unattached go at
+// the end. Vertices are matched through their reference, for the group
+// graph the node tag. Returns false, leaving the full ordering to the
+// caller, when there is no last ordering or the cost has grown too much.
+
+bool
+GraphNumberer::repairOrdering(Graph &theGraph, ID &theResult)
+{
+    if (warmTol <= 0.0 || fullCost < 0.0 || lastPosition.empty())
+	return false;
+
+    int numVertex = theGraph.getNumVertex();
+    if (numVertex == 0)
+	return false;
+
+    std::vector<int> tags(numVertex);
+    std::vector<double> key(numVertex, 0.0);
+    std::vector<char> known(numVertex, 0);
+    std::vector<int> unknown;
+
+    Vertex *vertexPtr;
+    VertexIter &vertexIter = theGraph.getVertices();
+    int count = 0;
+    double maxKey = 0.0;
+    while ((vertexPtr = vertexIter()) != 0 && count < numVertex) {
+	vertexPtr->setTmp(count);
+	tags[count] = vertexPtr->getTag();
+	std::map<int,int>::const_iterator it = lastPosition.find(vertexPtr->getRef());
+	if (it != lastPosition.end()) {
+	    key[count] = it->second;
+	    known[count] = 1;
+	    if (key[count] > maxKey)
+		maxKey = key[count];
+	} else
+	    unknown.push_back(count);
+	count++;
+    }
+
+    if (count != numVertex || (int)unknown.size() == numVertex)
+	return false;
+
+    // place the new vertices
+    std::vector<int> level;
+    std::vector<double> levelKey;
+    while (!unknown.empty()) {
+	level.clear();
+	levelKey.clear();
+	std::vector<int> rest;
+	for (size_t u = 0; u < unknown.size(); u++) {
+	    int i = unknown[u];
+	    const ID &adjacency = theGraph.getVertexPtr(tags[i])->getAdjacency();
+	    double sum = 0.0;
+	    int num = 0;
+	    for (int j = 0; j < adjacency.Size(); j++) {
+		Vertex *otherPtr = theGraph.getVertexPtr(adjacency(j));
+		if (otherPtr == 0)
+		    continue;
+		int other = otherPtr->getTmp();
+		if (known[other]) {
+		    sum += key[other];
+		    num++;
+		}
+	    }
+	    if (num > 0) {
+		level.push_back(i);
+		levelKey.push_back(sum/num);
+	    } else
+		rest.push_back(i);
+	}
+
+	if (level.empty()) {
+	    for (size_t u = 0; u < rest.size(); u++) {
+		key[rest[u]] = maxKey + 1.0 + u;
+		known[rest[u]] = 1;
+	    }
+	    break;
+	}
+
+	for (size_t l = 0; l < level.size(); l++) {
+	    key[level[l]] = levelKey[l];
+	    known[level[l]] = 1;
+	}
+	unknown.swap(rest);
+    }
+
+    // order by key, then by tag
+    std::vector<std::pair<double,int> > order(numVertex);
+    for (int i = 0; i < numVertex; i++)
+	order[i] = std::pair<double,int>(key[i], tags[i]);
+    std::sort(order.begin(), order.end());
+
+    theResult.resize(numVertex);
+    for (int i = 0; i < numVertex; i++)
+	theResult(i) = order[i].second;
+
+    double cost = this->orderingCost(theGraph, theResult);
+    if (cost > warmTol*fullCost)
+	return false;
+
+    lastPosition.clear();
+    for (int i = 0; i < numVertex; i++)
+	lastPosition[theGraph.getVertexPtr(theResult(i))->getRef()] = i;
+
+    return true;
+}
+
+// void keepOrdering(Graph &theGraph, const ID &theResult)
+//    Method to remember a full ordering, and its cost, as the start of
+// the next one.
+
+void
+GraphNumberer::keepOrdering(Graph &theGraph, const ID &theResult)
+{
+    if (warmTol <= 0.0)
+	return;
+
+    int numVertex = theResult.Size();
+    lastPosition.clear();
+    fullCost = -1.0;
+    if (numVertex == 0)
+	return;
+
+    fullCost = this->orderingCost(theGraph, theResult);
+
+    for (int i = 0; i < numVertex; i++) {
+	Vertex *vertexPtr = theGraph.getVertexPtr(theResult(i));
+	if (vertexPtr != 0)
+	    lastPosition[vertexPtr->getRef()] = i;
+    }
+
+    // references must tell the vertices apart
+    if ((int)lastPosition.size() != numVertex) {
+	lastPosition.clear();
+	fullCost = -1.0;
+    }
+}
+
+// double orderingCost(Graph &theGraph, const ID &theResult)
+//    Method to return the size per vertex of the profile of the ordering,
+// or of the factor for a fill-reducing one. The factor is counted row by
+// row along the elimination tree, built on the way. As RCM, sets the Tmp
+// of the vertices to their number, 1 through numVertex.
+
+double
+GraphNumberer::orderingCost(Graph &theGraph, const ID &theResult)
+{
+    int numVertex = theResult.Size();
+    if (numVertex == 0)
+	return 0.0;
+
+    for (int i = 0; i < numVertex; i++) {
+	Vertex *vertexPtr = theGraph.getVertexPtr(theResult(i));
+	if (vertexPtr == 0)
+	    return -1.0;
+	vertexPtr->setTmp(i+1);
+    }
+
+    double size = numVertex;
+
+    if (this->isFillReducing() == false) {
+	for (int i = 0; i < numVertex; i++) {
+	    const ID &adjacency = theGraph.getVertexPtr(theResult(i))->getAdjacency();
+	    int first = i;
+	    for (int j = 0; j < adjacency.Size(); j++) {
+		Vertex *otherPtr = theGraph.getVertexPtr(adjacency(j));
+		if (otherPtr != 0 && otherPtr->getTmp()-1 < first)
+		    first = otherPtr->getTmp()-1;
+	    }
+	    size += i - first;
+	}
+	return size/numVertex;
+    }
+
+    std::vector<int> parent(numVertex, -1);
+    std::vector<int> mark(numVertex, -1);
+    for (int k = 0; k < numVertex; k++) {
+	mark[k] = k;
+	const ID &adjacency = theGraph.getVertexPtr(theResult(k))->getAdjacency();
+	for (int j = 0; j < adjacency.Size(); j++) {
+	    Vertex *otherPtr = theGraph.getVertexPtr(adjacency(j));
+	    if (otherPtr == 0)
+		continue;
+	    int i = otherPtr->getTmp()-1;
+	    if (i >= k)
+		continue;
+	    while (mark[i] != k) {
+		mark[i] = k;
+		size += 1.0;
+		if (parent[i] == -1)
+		    parent[i] = k;
+		i = parent[i];
+	    }
+	}
+    }
+    return size/numVertex;
+}
+
 
 
 
@@ -38,6 +38,7 @@
 #ifndef GraphNumberer_h
 #define GraphNumberer_h
 #include <MovableObject.h>
+#include <map>
 
 class ID;
 class Graph;
@@ -52,11 +53,27 @@ class GraphNumberer : public MovableObject
     
     virtual const ID &number(Graph &theGraph, int lastVertex = -1) =0;
     virtual const ID &number(Graph &theGraph, const ID &lastVertices) =0;
+
+    // true if the numbering is a fill-reducing ordering, in which case
+    // the sparse solvers can keep the equations in the order given
+    virtual bool isFillReducing(void);
+
+    // warm start: when the graph changes, the last ordering is repaired
+    // for the vertices added and removed, and kept while its profile (or
+    // fill, for a fill-reducing ordering) per vertex stays within tol times
+    // that of the last full ordering. tol <= 0 always orders from scratch.
+    void setWarmStart(double tol);
     
   protected:
+    bool repairOrdering(Graph &theGraph, ID &theResult);
+    void keepOrdering(Graph &theGraph, const ID &theResult);
     
   private:
-    
+    double orderingCost(Graph &theGraph, const ID &theResult);
+
+    double warmTol;                 // allowed growth of the cost, 0 if off
+    double fullCost;                // cost per vertex of the last full ordering
+    std::map<int,int> lastPosition; // vertex ref -> position in last ordering
 };
 
 #endif
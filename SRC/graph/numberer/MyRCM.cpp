@@ -111,6 +111,10 @@ MyRCM::number(Graph &theGraph, int startVertex)
     
     if (numVertex == 0) 
 	return *theRefResult;
+
+    // or keep the last ordering, repaired, if warm started
+    if (this->repairOrdering(theGraph, *theRefResult))
+	return *theRefResult;
 	    
 
     // we first set the Tmp of all vertices to -1, indicating
@@ -204,6 +208,9 @@ MyRCM::number(Graph &theGraph, int startVertex)
 
     theGraph.Print(opserr, 3);
     opserr << *theRefResult;
+
+    this->keepOrdering(theGraph, *theRefResult);
+
     return *theRefResult;
 }
 
@@ -0,0 +1,184 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of NestedDissection.
+//
+// What: "@(#) NestedDissection.C, revA"
+
+#include <NestedDissectionNumberer.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <vector>
+
+#ifdef _USE_METIS_5p1
+#include <metis.h>
+#else
+extern "C"
+void METIS_NodeND(int *nvtxs, int *xadj, int *adjncy, int *numflag,
+		  int *options, int *perm, int *iperm);
+#endif
+
+NestedDissection::NestedDissection()
+:GraphNumberer(GraphNUMBERER_TAG_NestedDissection)
+{
+
+}
+
+NestedDissection::~NestedDissection()
+{
+
+}
+
+
+// const ID &number(Graph &theGraph, int lastVertex = -1)
+//	Returns the tags of the vertices in the nested dissection order
+//	found by METIS; if lastVertex is given it is numbered last.
+const ID &
+NestedDissection::number(Graph &theGraph, int lastVertex)
+{
+  if (lastVertex < 0) {
+    ID noLast(0);
+    return this->number(theGraph, noLast);
+  }
+
+  ID lastVertices(1);
+  lastVertices(0) = lastVertex;
+  return this->number(theGraph, lastVertices);
+}
+
+
+// const ID &number(Graph &theGraph, const ID &lastVertices)
+//	Returns the tags of the vertices in the nested dissection order
+//	found by METIS; those in lastVertices are moved to the end.
+const ID &
+NestedDissection::number(Graph &theGraph, const ID &lastVertices)
+{
+  int numVertex = theGraph.getNumVertex();
+
+  theResult.resize(numVertex);
+  if (numVertex == 0) 
+    return theResult;
+
+  // METIS wants the vertices numbered 0 through numVertex-1
+  std::vector<int> tags(numVertex);
+  int maxTag = 0;
+  Vertex *vertexPtr;
+  VertexIter &vertexIter = theGraph.getVertices();
+  int count = 0;
+  while ((vertexPtr = vertexIter()) != 0 && count < numVertex) {
+    tags[count++] = vertexPtr->getTag();
+    if (vertexPtr->getTag() > maxTag)
+      maxTag = vertexPtr->getTag();
+  }
+
+  std::vector<int> local(maxTag+1, -1);
+  for (int i=0; i<numVertex; i++)
+    if (tags[i] >= 0)
+      local[tags[i]] = i;
+
+  std::vector<int> xadj(numVertex+1, 0);
+  std::vector<int> adjncy;
+  adjncy.reserve(2*theGraph.getNumEdge());
+  for (int i=0; i<numVertex; i++) {
+    const ID &adjacency = theGraph.getVertexPtr(tags[i])->getAdjacency();
+    for (int j=0; j<adjacency.Size(); j++) {
+      int other = adjacency(j);
+      if (other >= 0 && other <= maxTag && local[other] >= 0 && local[other] != i)
+	adjncy.push_back(local[other]);
+    }
+    xadj[i+1] = adjncy.size();
+  }
+
+  std::vector<int> perm(numVertex), iperm(numVertex);
+  if (adjncy.empty() == false) {
+#ifdef _USE_METIS_5p1
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+    options[METIS_OPTION_NUMBERING] = 0;
+    idx_t nvtxs = numVertex;
+    if (METIS_NodeND(&nvtxs, &xadj[0], &adjncy[0], NULL, options,
+		     &perm[0], &iperm[0]) != METIS_OK) {
+      opserr << "WARNING NestedDissection::number - METIS_NodeND failed, ";
+      opserr << "vertices left in their original order\n";
+      for (int i=0; i<numVertex; i++)
+	perm[i] = i;
+    }
+#else
+    int numflag = 0;
+    int options[8];
+    options[0] = 0;   // default options
+    METIS_NodeND(&numVertex, &xadj[0], &adjncy[0], &numflag, options,
+		 &perm[0], &iperm[0]);
+#endif
+  } else {
+    for (int i=0; i<numVertex; i++)
+      perm[i] = i;
+  }
+
+  // perm(k) is the vertex eliminated k'th, those in lastVertices go
+  // at the end in the order given
+  std::vector<char> isLast(numVertex, 0);
+  int numLast = 0;
+  for (int i=0; i<lastVertices.Size(); i++) {
+    int tag = lastVertices(i);
+    if (tag >= 0 && tag <= maxTag && local[tag] >= 0 && isLast[local[tag]] == 0) {
+      isLast[local[tag]] = 1;
+      numLast++;
+    }
+  }
+
+  count = 0;
+  for (int k=0; k<numVertex; k++)
+    if (isLast[perm[k]] == 0)
+      theResult(count++) = tags[perm[k]];
+  for (int i=0; i<lastVertices.Size() && count < numVertex; i++) {
+    int tag = lastVertices(i);
+    if (tag >= 0 && tag <= maxTag && local[tag] >= 0 && isLast[local[tag]] == 1) {
+      isLast[local[tag]] = 2;
+      theResult(count++) = tag;
+    }
+  }
+
+  return theResult;
+}
+
+
+bool
+NestedDissection::isFillReducing(void)
+{
+  return true;
+}
+
+
+int
+NestedDissection::sendSelf(int commitTag, Channel &theChannel)
+{
+    return 0;
+}
+
+int
+NestedDissection::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
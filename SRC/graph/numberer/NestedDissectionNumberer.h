@@ -0,0 +1,56 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for
+// NestedDissection. NestedDissection is a GraphNumberer that orders the
+// vertices of a graph with the multilevel nested dissection of METIS
+// (METIS_NodeND), a fill-reducing ordering. The DOF_Numberer using it
+// tells the sparse solvers that the equations are already ordered, so
+// they need not reorder the matrix again.
+//
+// What: "@(#) NestedDissection.h, revA"
+
+#ifndef NestedDissection_h
+#define NestedDissection_h
+
+#include <GraphNumberer.h>
+#include <ID.h>
+
+class NestedDissection: public GraphNumberer
+{
+  public:
+    NestedDissection(); 
+    ~NestedDissection();
+
+    const ID &number(Graph &theGraph, int lastVertex = -1);
+    const ID &number(Graph &theGraph, const ID &lastVertices);
+    bool isFillReducing(void);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker);
+    
+  protected:
+
+  private:
+    ID theResult;
+};
+
+#endif
@@ -94,6 +94,10 @@ RCM::number(Graph &theGraph, int startVertex)
     
     if (numVertex == 0) 
 	return *theRefResult;
+
+    // or keep the last ordering, repaired, if warm started
+    if (this->repairOrdering(theGraph, *theRefResult))
+	return *theRefResult;
 	    
 
     // we first set the Tmp of all vertices to -1, indicating
@@ -191,7 +195,9 @@ RCM::number(Graph &theGraph, int startVertex)
 		for (int i=0; i<startLastLevelSet; i++)
 		    lastLevelSet(i) = (*theRefResult)(i);
 		
-		return this->number(theGraph,lastLevelSet);
+		const ID &theResult = this->number(theGraph,lastLevelSet);
+		this->keepOrdering(theGraph, theResult);
+		return theResult;
 	    }
 
 	}
@@ -268,6 +274,8 @@ RCM::number(Graph &theGraph, int startVertex)
 	(*theRefResult)(i) = vertexPtr->getTag();
     }
 
+    this->keepOrdering(theGraph, *theRefResult);
+
     return *theRefResult;
 }
 
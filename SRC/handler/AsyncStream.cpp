@@ -0,0 +1,433 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for AsyncStream.
+
+#include <AsyncStream.h>
+#include <Vector.h>
+#include <ID.h>
+
+std::atomic<long> AsyncStream::numRowsBuffered(0);
+
+long
+AsyncStream::getNumRowsBuffered(void)
+{
+  return numRowsBuffered;
+}
+
+AsyncStream::AsyncStream(OPS_Stream *stream, int max)
+  :OPS_Stream(stream->getClassTag()),
+   theStream(stream), maxRows(max), first(0), count(0),
+   writing(false), done(false), result(0)
+{
+  if (maxRows < 1)
+    maxRows = 1;
+  rows.resize(maxRows);
+
+  theWriter = std::thread(&AsyncStream::writer, this);
+}
+
+AsyncStream::~AsyncStream()
+{
+  {
+    std::unique_lock<std::mutex> lock(theMutex);
+    done = true;
+  }
+  rowAdded.notify_one();
+  theWriter.join();
+
+  delete theStream;
+}
+
+// the writer thread, it returns once done is set and the ring is empty
+void
+AsyncStream::writer(void)
+{
+  Vector data;
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (true) {
+    while (count == 0 && done == false)
+      rowAdded.wait(lock);
+
+    if (count == 0)
+      break;
+
+    // the row is written from the ring while the lock is released, the
+    // recorder can not reuse its slot until count is decreased
+    std::vector<double> &row = rows[first];
+    writing = true;
+    lock.unlock();
+
+    data.setData(row.empty() ? 0 : &row[0], row.size());
+    int res = theStream->write(data);
+
+    lock.lock();
+    if (res < 0 && result == 0)
+      result = res;
+    writing = false;
+    first = (first + 1) % maxRows;
+    count--;
+    numRowsBuffered--;
+    rowWritten.notify_all();
+  }
+}
+
+void
+AsyncStream::drain(void)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (count != 0 || writing == true)
+    rowWritten.wait(lock);
+}
+
+int
+AsyncStream::write(Vector &data)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (count == maxRows)
+    rowWritten.wait(lock);
+
+  int last = (first + count) % maxRows;
+  int size = data.Size();
+  std::vector<double> &row = rows[last];
+  row.resize(size);
+  for (int i=0; i<size; i++)
+    row[i] = data(i);
+  count++;
+  numRowsBuffered++;
+
+  int res = result;
+  result = 0;
+  lock.unlock();
+
+  rowAdded.notify_one();
+
+  return res;
+}
+
+int
+AsyncStream::flush()
+{
+  this->drain();
+  return theStream->flush();
+}
+
+int
+AsyncStream::setFile(const char *fileName, openMode mode, bool echo)
+{
+  this->drain();
+  return theStream->setFile(fileName, mode, echo);
+}
+
+int
+AsyncStream::setPrecision(int prec)
+{
+  this->drain();
+  return theStream->setPrecision(prec);
+}
+
+int
+AsyncStream::setFloatField(floatField field)
+{
+  this->drain();
+  return theStream->setFloatField(field);
+}
+
+int
+AsyncStream::setCompression(const char *codec)
+{
+  this->drain();
+  return theStream->setCompression(codec);
+}
+
+int
+AsyncStream::precision(int prec)
+{
+  this->drain();
+  return theStream->precision(prec);
+}
+
+int
+AsyncStream::width(int w)
+{
+  this->drain();
+  return theStream->width(w);
+}
+
+int
+AsyncStream::tag(const char *tagName)
+{
+  this->drain();
+  return theStream->tag(tagName);
+}
+
+int
+AsyncStream::tag(const char *tagName, const char *value)
+{
+  this->drain();
+  return theStream->tag(tagName, value);
+}
+
+int
+AsyncStream::endTag()
+{
+  this->drain();
+  return theStream->endTag();
+}
+
+int
+AsyncStream::attr(const char *name, int value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, double value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, const char *value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::open(void)
+{
+  this->drain();
+  return theStream->open();
+}
+
+int
+AsyncStream::close(openMode nextOpen)
+{
+  this->drain();
+  return theStream->close(nextOpen);
+}
+
+OPS_Stream &
+AsyncStream::write(const char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const unsigned char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const signed char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const void *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const double *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(signed char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const unsigned char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const signed char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const void *p)
+{
+  this->drain();
+  *theStream << p;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(bool b)
+{
+  this->drain();
+  *theStream << b;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(double n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(float n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+void
+AsyncStream::setAddCommon(int flag)
+{
+  this->drain();
+  theStream->setAddCommon(flag);
+}
+
+int
+AsyncStream::setOrder(const ID &order)
+{
+  this->drain();
+  return theStream->setOrder(order);
+}
+
+int
+AsyncStream::setSharded(bool onOff)
+{
+  this->drain();
+  return theStream->setSharded(onOff);
+}
+
+int
+AsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  this->drain();
+  return theStream->sendSelf(commitTag, theChannel);
+}
+
+int
+AsyncStream::recvSelf(int commitTag, Channel &theChannel,
+		      FEM_ObjectBroker &theBroker)
+{
+  this->drain();
+  return theStream->recvSelf(commitTag, theChannel, theBroker);
+}
@@ -0,0 +1,123 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _AsyncStream
+#define _AsyncStream
+
+// Description: This file contains the class definition for AsyncStream.
+// An AsyncStream takes over another OPS_Stream and moves the formatting
+// and the file output of the rows recorded, that is of write(Vector &), to
+// a writer thread. A row is copied into a ring of at most maxRows buffered
+// rows and the call returns; when the ring is full the recorder waits for
+// the writer to catch up. Any other call on the stream first waits until
+// the rows already buffered have been written, so the output is that of
+// the wrapped stream. The stream is drained when it is flushed and when it
+// is deleted with its recorder, on wipe and on exit.
+
+#include <OPS_Stream.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class AsyncStream : public OPS_Stream
+{
+ public:
+  AsyncStream(OPS_Stream *theStream, int maxRows = 1000);
+  ~AsyncStream();
+
+  // output format
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int setPrecision(int precision);
+  int setFloatField(floatField);
+  int setCompression(const char *codec);
+  int precision(int precision);
+  int width(int width);
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+  int flush();
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+
+  // regular stuff
+  OPS_Stream& write(const char *s, int n);
+  OPS_Stream& write(const unsigned char *s, int n);
+  OPS_Stream& write(const signed char *s, int n);
+  OPS_Stream& write(const void *s, int n);
+  OPS_Stream& write(const double *s, int n);
+
+  OPS_Stream& operator<<(char c);
+  OPS_Stream& operator<<(unsigned char c);
+  OPS_Stream& operator<<(signed char c);
+  OPS_Stream& operator<<(const char *s);
+  OPS_Stream& operator<<(const unsigned char *s);
+  OPS_Stream& operator<<(const signed char *s);
+  OPS_Stream& operator<<(const void *p);
+  OPS_Stream& operator<<(int n);
+  OPS_Stream& operator<<(unsigned int n);
+  OPS_Stream& operator<<(long n);
+  OPS_Stream& operator<<(unsigned long n);
+  OPS_Stream& operator<<(short n);
+  OPS_Stream& operator<<(unsigned short n);
+  OPS_Stream& operator<<(bool b);
+  OPS_Stream& operator<<(double n);
+  OPS_Stream& operator<<(float n);
+
+  // parallel stuff
+  void setAddCommon(int);
+  int setOrder(const ID &order);
+  int setSharded(bool onOff);
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+  // the rows buffered by all the streams, not yet written
+  static long getNumRowsBuffered(void);
+
+ private:
+  void drain(void);
+  void writer(void);
+
+  OPS_Stream *theStream;
+
+  std::vector<std::vector<double> > rows;   // the ring
+  int maxRows;
+  int first, count;                         // oldest row & rows buffered
+  bool writing;                             // the writer holds a row
+  bool done;
+  int result;                               // first failure of the writer
+
+  std::mutex theMutex;
+  std::condition_variable rowAdded, rowWritten;
+  std::thread theWriter;
+
+  static std::atomic<long> numRowsBuffered;
+};
+
+#endif
@@ -44,7 +44,8 @@ BinaryFileStream::BinaryFileStream()
   :OPS_Stream(OPS_STREAM_TAGS_BinaryFileStream), 
    fileOpen(0), fileName(0), sendSelfCount(0),
    theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0)
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0),
+   theCompression(0)
 {
 
 }
@@ -53,7 +54,8 @@ BinaryFileStream::BinaryFileStream(const char *file, openMode mode)
   :OPS_Stream(OPS_STREAM_TAGS_BinaryFileStream), 
    fileOpen(0), fileName(0), sendSelfCount(0),
    theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0)
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0),
+   theCompression(0)
 {
   this->setFile(file, mode);
 }
@@ -61,7 +63,7 @@ BinaryFileStream::BinaryFileStream(const char *file, openMode mode)
 BinaryFileStream::~BinaryFileStream()
 {
   if (fileOpen == 1)
-    theFile.close();
+    this->closeFile();
 
   if (theChannels != 0) {
 
@@ -77,6 +79,9 @@ BinaryFileStream::~BinaryFileStream()
   if (fileName != 0)
     delete [] fileName;
 
+  if (theCompression != 0)
+    delete theCompression;
+
   if (sendSelfCount > 0) {
 
     for (int i=0; i<=sendSelfCount; i++) {
@@ -124,7 +129,7 @@ BinaryFileStream::setFile(const char *name, openMode mode)
 
   // if file already open, close it
   if (fileOpen == 1) {
-    theFile.close();
+    this->closeFile();
     fileOpen = 0;
   }
 
@@ -150,7 +155,9 @@ BinaryFileStream::open(void)
     return 0;
   }
 
-  if (theOpenMode == OVERWRITE) 
+  if (theCompression != 0)
+    theCompression->open(theFile, fileName, theOpenMode == APPEND);
+  else if (theOpenMode == OVERWRITE) 
     theFile.open(fileName, ios::out | ios::binary);
   else
     theFile.open(fileName, ios::out | ios::app | ios::binary);
@@ -172,7 +179,7 @@ int
 BinaryFileStream::close(void)
 {
   if (fileOpen != 0)
-    theFile.close();
+    this->closeFile();
   fileOpen = 0;
 
   return 0;
@@ -192,6 +199,33 @@ BinaryFileStream::setFloatField(floatField field)
 }
 
 
+int 
+BinaryFileStream::setCompression(const char *codec)
+{
+  int type = CompressedFileBuf::getCodec(codec);
+  // not in this build, or too late for a file already written to
+  if (type < 0 || fileOpen == 1)
+    return -1;
+
+  if (theCompression != 0)
+    delete theCompression;
+  theCompression = 0;
+
+  if (type != CompressedFileBuf::NONE)
+    theCompression = new CompressedFileBuf(type);
+
+  return 0;
+}
+
+void
+BinaryFileStream::closeFile(void)
+{
+  if (theCompression != 0 && theCompression->isOpen())
+    theCompression->close(theFile);
+  else
+    theFile.close();
+}
+
 int 
 BinaryFileStream::tag(const char *tagName)
 {
@@ -884,7 +918,7 @@ BinaryFileStream::setOrder(const ID &orderData)
 
 int
 BinaryFileStream::flush() {
-  if (theFile.is_open() && theFile.good()) {
+  if (fileOpen != 0 && theFile.good()) {
     theFile.flush();
   }
   return 0;
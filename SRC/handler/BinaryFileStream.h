@@ -26,6 +26,7 @@
 #define _BinaryFileStream
 
 #include <OPS_Stream.h>
+#include <CompressedFileBuf.h>
 
 #include <fstream>
 using std::ofstream;
@@ -50,6 +51,7 @@ class BinaryFileStream : public OPS_Stream
 
   int setPrecision(int precision);
   int setFloatField(floatField);
+  int setCompression(const char *codec);
   int precision(int precision) {return 0;};
   int width(int width) {return 0;};
   const char *getFileName(void) {return fileName;}
@@ -109,6 +111,9 @@ class BinaryFileStream : public OPS_Stream
   ID **theColumns;
   double **theData;
   Vector **theRemoteData;
+
+  void closeFile(void);
+  CompressedFileBuf *theCompression;  // 0 for a plain file
 };
 
 #endif
@@ -0,0 +1,334 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// ColumnarFileStream.
+
+#include <ColumnarFileStream.h>
+#include <Vector.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+#include <string.h>
+#include <stdio.h>
+
+using std::ios;
+
+#define COLUMNAR_PREAMBLE_SIZE 32
+
+ColumnarFileStream::ColumnarFileStream(int rows)
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   fileOpen(0), startTagOpen(false), numColumns(0), chunkRows(rows),
+   headerBytes(0), numRows(0), rowsInChunk(0)
+{
+  if (chunkRows < 1)
+    chunkRows = 1;
+}
+
+ColumnarFileStream::ColumnarFileStream(const char *file, openMode mode, int rows)
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   fileOpen(0), startTagOpen(false), numColumns(0), chunkRows(rows),
+   headerBytes(0), numRows(0), rowsInChunk(0)
+{
+  if (chunkRows < 1)
+    chunkRows = 1;
+  this->setFile(file, mode);
+}
+
+ColumnarFileStream::~ColumnarFileStream()
+{
+  this->close();
+}
+
+int
+ColumnarFileStream::setFile(const char *name, openMode mode, bool echo)
+{
+  if (name == 0) {
+    opserr << "ColumnarFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  this->close();
+
+  // the layout has a single header, so the file is always rewritten
+  if (mode == APPEND)
+    opserr << "ColumnarFileStream::setFile() - " << name << " can not be appended to, it is overwritten\n";
+
+  fileName = name;
+  description.clear();
+  openTags.clear();
+  startTagOpen = false;
+  numColumns = 0;
+  numRows = 0;
+  rowsInChunk = 0;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::open(void)
+{
+  if (fileName.empty()) {
+    opserr << "ColumnarFileStream::open(void) - no file name has been set\n";
+    return -1;
+  }
+
+  if (fileOpen == 1)
+    return 0;
+
+  theFile.open(fileName.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+  if (!theFile.is_open() || theFile.bad()) {
+    opserr << "WARNING - ColumnarFileStream::open()";
+    opserr << " - could not open file " << fileName.c_str() << endln;
+    fileOpen = 0;
+    return -1;
+  }
+
+  fileOpen = 1;
+  return 0;
+}
+
+int
+ColumnarFileStream::close(openMode nextOpen)
+{
+  if (fileOpen == 0)
+    return 0;
+
+  this->flush();
+  theFile.close();
+  fileOpen = 0;
+
+  return 0;
+}
+
+// writes the partly filled chunk and the row count so the file is complete
+// as it stands; the chunk is rewritten in place once it fills
+int
+ColumnarFileStream::flush()
+{
+  if (fileOpen == 0 || numColumns == 0)
+    return 0;
+
+  if (rowsInChunk != 0 && this->writeChunk() < 0)
+    return -1;
+
+  theFile.flush();
+  return 0;
+}
+
+// the preamble & the column description, the row count is updated in place
+int
+ColumnarFileStream::writeHeader(void)
+{
+  if (headerBytes == 0) {
+    this->closeStartTag();
+    while (!openTags.empty())
+      this->endTag();
+    int length = COLUMNAR_PREAMBLE_SIZE + description.size() + 1;
+    headerBytes = ((length + 7)/8)*8;
+
+    std::vector<char> header(headerBytes, 0);
+    memcpy(&header[COLUMNAR_PREAMBLE_SIZE], description.c_str(), description.size());
+    theFile.seekp(0);
+    theFile.write(&header[0], headerBytes);
+  }
+
+  char preamble[COLUMNAR_PREAMBLE_SIZE];
+  memset(preamble, 0, COLUMNAR_PREAMBLE_SIZE);
+  strcpy(preamble, "OPSCOL1");
+  int ints[4] = {headerBytes, numColumns, chunkRows, 0};
+  memcpy(&preamble[8], ints, sizeof(ints));
+  long long rows = numRows;
+  memcpy(&preamble[24], &rows, sizeof(rows));
+
+  theFile.seekp(0);
+  theFile.write(preamble, COLUMNAR_PREAMBLE_SIZE);
+
+  if (theFile.bad()) {
+    opserr << "ColumnarFileStream - failed to write header of " << fileName.c_str() << endln;
+    return -1;
+  }
+  return 0;
+}
+
+int
+ColumnarFileStream::writeChunk(void)
+{
+  long long chunkIndex = (numRows - rowsInChunk)/chunkRows;
+  long long chunkBytes = (long long)numColumns*chunkRows*sizeof(double);
+
+  theFile.seekp(headerBytes + chunkIndex*chunkBytes);
+  theFile.write((const char *)&chunk[0], chunkBytes);
+
+  if (theFile.bad()) {
+    opserr << "ColumnarFileStream - failed to write to " << fileName.c_str() << endln;
+    return -1;
+  }
+
+  return this->writeHeader();
+}
+
+void
+ColumnarFileStream::closeStartTag(void)
+{
+  if (startTagOpen == true) {
+    description += ">\n";
+    startTagOpen = false;
+  }
+}
+
+int
+ColumnarFileStream::tag(const char *tagName)
+{
+  if (numColumns != 0)
+    return 0;
+
+  this->closeStartTag();
+  description.append(2*openTags.size(), ' ');
+  description += "<";
+  description += tagName;
+  openTags.push_back(tagName);
+  startTagOpen = true;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *tagName, const char *value)
+{
+  if (numColumns != 0)
+    return 0;
+
+  this->closeStartTag();
+  description.append(2*openTags.size(), ' ');
+  description += "<";
+  description += tagName;
+  description += ">";
+  description += value;
+  description += "</";
+  description += tagName;
+  description += ">\n";
+
+  return 0;
+}
+
+int
+ColumnarFileStream::endTag()
+{
+  if (numColumns != 0 || openTags.empty())
+    return 0;
+
+  if (startTagOpen == true) {
+    description += "/>\n";
+    startTagOpen = false;
+  } else {
+    description.append(2*(openTags.size()-1), ' ');
+    description += "</";
+    description += openTags.back();
+    description += ">\n";
+  }
+  openTags.pop_back();
+
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, int value)
+{
+  char buffer[32];
+  sprintf(buffer, "%d", value);
+  return this->attr(name, buffer);
+}
+
+int
+ColumnarFileStream::attr(const char *name, double value)
+{
+  char buffer[32];
+  sprintf(buffer, "%.16g", value);
+  return this->attr(name, buffer);
+}
+
+int
+ColumnarFileStream::attr(const char *name, const char *value)
+{
+  if (numColumns != 0 || startTagOpen == false)
+    return 0;
+
+  description += " ";
+  description += name;
+  description += "=\"";
+  description += value;
+  description += "\"";
+
+  return 0;
+}
+
+int
+ColumnarFileStream::write(Vector &data)
+{
+  if (fileOpen == 0 && this->open() < 0)
+    return -1;
+
+  int size = data.Size();
+
+  // the first row fixes the number of columns
+  if (numColumns == 0) {
+    if (size == 0)
+      return 0;
+    numColumns = size;
+    chunk.assign((size_t)numColumns*chunkRows, 0.0);
+    if (this->writeHeader() < 0)
+      return -1;
+  }
+
+  if (size != numColumns) {
+    opserr << "ColumnarFileStream::write() - " << fileName.c_str() << " has " << numColumns;
+    opserr << " columns, row of size " << size << " truncated or padded\n";
+  }
+
+  double *row = &chunk[rowsInChunk];
+  for (int j=0; j<numColumns; j++)
+    row[(size_t)j*chunkRows] = (j < size) ? data(j) : 0.0;
+
+  rowsInChunk++;
+  numRows++;
+
+  if (rowsInChunk == chunkRows) {
+    int res = this->writeChunk();
+    rowsInChunk = 0;
+    return res;
+  }
+
+  return 0;
+}
+
+int
+ColumnarFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "ColumnarFileStream::sendSelf() - not available in parallel, use -binary\n";
+  return -1;
+}
+
+int
+ColumnarFileStream::recvSelf(int commitTag, Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+  opserr << "ColumnarFileStream::recvSelf() - not available in parallel, use -binary\n";
+  return -1;
+}
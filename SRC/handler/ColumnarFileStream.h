@@ -0,0 +1,99 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _ColumnarFileStream
+#define _ColumnarFileStream
+
+// Description: This file contains the class definition for
+// ColumnarFileStream. A ColumnarFileStream writes the rows a recorder
+// sends it in a binary, column oriented file that can be read in part,
+// for example through a memory map, without parsing. The rows are kept
+// in memory and written chunkRows at a time, one write per chunk. The
+// file layout, all values in the byte order of the machine, is:
+//
+//   bytes 0-7     "OPSCOL1" and a null
+//   bytes 8-11    int    headerBytes, offset of the first chunk
+//   bytes 12-15   int    numColumns
+//   bytes 16-19   int    chunkRows
+//   bytes 20-23   int    unused, 0
+//   bytes 24-31   int64  numRows written so far
+//   bytes 32-     the description of the columns, as the xml a
+//                 XmlFileStream would write, null padded to headerBytes
+//
+// and then the chunks, each numColumns*chunkRows doubles, column by column;
+// the value of row r and column c is therefore at
+//   headerBytes + 8*(numColumns*chunkRows*(r/chunkRows) + chunkRows*c + r%chunkRows)
+// Rows past numRows in the last chunk are undefined.
+
+#include <OPS_Stream.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+using std::fstream;
+
+class ColumnarFileStream : public OPS_Stream
+{
+ public:
+  ColumnarFileStream(int chunkRows = 1024);
+  ColumnarFileStream(const char *fileName, openMode mode = OVERWRITE, int chunkRows = 1024);
+  ~ColumnarFileStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+  int flush();
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // parallel stuff
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  int writeHeader(void);
+  int writeChunk(void);
+  void closeStartTag(void);
+
+  fstream theFile;
+  int fileOpen;
+  std::string fileName;
+
+  std::string description;       // column description, until the first row
+  std::vector<std::string> openTags;
+  bool startTagOpen;
+
+  int numColumns;                // 0 until the first row
+  int chunkRows;
+  int headerBytes;
+  long long numRows;             // rows written, including those buffered
+  std::vector<double> chunk;     // the current chunk, column by column
+  int rowsInChunk;
+};
+
+#endif
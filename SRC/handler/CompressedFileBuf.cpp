@@ -0,0 +1,260 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// CompressedFileBuf.
+
+#include <CompressedFileBuf.h>
+#include <string.h>
+
+#ifdef _ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef _LZ4
+#include <lz4frame.h>
+#endif
+
+static const size_t CompressedFileBuf_blockSize = 1048576;
+
+int
+CompressedFileBuf::getCodec(const char *name)
+{
+  if (name == 0 || strcmp(name, "none") == 0)
+    return NONE;
+#ifdef _ZSTD
+  if (strcmp(name, "zstd") == 0)
+    return ZSTD;
+#endif
+#ifdef _LZ4
+  if (strcmp(name, "lz4") == 0)
+    return LZ4;
+#endif
+  return -1;
+}
+
+CompressedFileBuf::CompressedFileBuf(int type)
+  :codec(type), theOutput(0), inBuf(0), outBuf(0), sizeOut(0), theContext(0)
+{
+  inBuf = new char[CompressedFileBuf_blockSize];
+
+#ifdef _ZSTD
+  if (codec == ZSTD) {
+    sizeOut = ZSTD_CStreamOutSize();
+    theContext = ZSTD_createCCtx();
+  }
+#endif
+#ifdef _LZ4
+  if (codec == LZ4) {
+    // room for the frame header and one block
+    sizeOut = LZ4F_compressBound(CompressedFileBuf_blockSize, 0) + LZ4F_HEADER_SIZE_MAX;
+    LZ4F_cctx *theCtx = 0;
+    if (LZ4F_isError(LZ4F_createCompressionContext(&theCtx, LZ4F_VERSION)) == 0)
+      theContext = theCtx;
+  }
+#endif
+
+  if (sizeOut != 0)
+    outBuf = new char[sizeOut];
+}
+
+CompressedFileBuf::~CompressedFileBuf()
+{
+  if (theOutput != 0) {
+    this->compress(2);
+    fclose(theOutput);
+  }
+
+#ifdef _ZSTD
+  if (codec == ZSTD && theContext != 0)
+    ZSTD_freeCCtx((ZSTD_CCtx *)theContext);
+#endif
+#ifdef _LZ4
+  if (codec == LZ4 && theContext != 0)
+    LZ4F_freeCompressionContext((LZ4F_cctx *)theContext);
+#endif
+
+  if (inBuf != 0)
+    delete [] inBuf;
+  if (outBuf != 0)
+    delete [] outBuf;
+}
+
+// int open(std::ofstream &theFile, const char *fileName, bool append);
+//	opens the file and starts a frame; theFile then writes through
+//	this buffer until close() is invoked.
+
+int
+CompressedFileBuf::open(std::ofstream &theFile, const char *fileName, bool append)
+{
+  if (theOutput != 0)
+    this->close(theFile);
+
+  if (theContext == 0 || outBuf == 0) {
+    theFile.setstate(std::ios::badbit);
+    return -1;
+  }
+
+  theOutput = fopen(fileName, append ? "ab" : "wb");
+  if (theOutput == 0) {
+    theFile.setstate(std::ios::badbit);
+    return -1;
+  }
+
+#ifdef _LZ4
+  if (codec == LZ4) {
+    LZ4F_preferences_t prefs;
+    memset(&prefs, 0, sizeof(prefs));
+    prefs.frameInfo.blockSizeID = LZ4F_max1MB;
+    size_t n = LZ4F_compressBegin((LZ4F_cctx *)theContext, outBuf, sizeOut, &prefs);
+    if (LZ4F_isError(n) || this->writeOut(outBuf, n) < 0) {
+      fclose(theOutput);
+      theOutput = 0;
+      theFile.setstate(std::ios::badbit);
+      return -1;
+    }
+  }
+#endif
+
+  this->setp(inBuf, inBuf + CompressedFileBuf_blockSize);
+  theFile.clear();
+  theFile.std::ios::rdbuf(this);
+
+  return 0;
+}
+
+// int close(std::ofstream &theFile);
+//	ends the frame, closes the file and gives theFile its own buffer
+//	back.
+
+int
+CompressedFileBuf::close(std::ofstream &theFile)
+{
+  int res = 0;
+  if (theOutput != 0) {
+    res = this->compress(2);
+    if (fclose(theOutput) != 0)
+      res = -1;
+    theOutput = 0;
+  }
+
+  theFile.std::ios::rdbuf(theFile.rdbuf());
+  this->setp(0, 0);
+
+  return res;
+}
+
+int
+CompressedFileBuf::overflow(int c)
+{
+  if (theOutput == 0)
+    return traits_type::eof();
+
+  if (this->compress(0) < 0)
+    return traits_type::eof();
+
+  if (c != traits_type::eof()) {
+    *pptr() = (char)c;
+    pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+int
+CompressedFileBuf::sync(void)
+{
+  if (theOutput == 0)
+    return 0;
+
+  if (this->compress(1) < 0 || fflush(theOutput) != 0)
+    return -1;
+
+  return 0;
+}
+
+int
+CompressedFileBuf::writeOut(const char *data, size_t n)
+{
+  if (n != 0 && fwrite(data, 1, n, theOutput) != n)
+    return -1;
+  return 0;
+}
+
+// int compress(int mode);
+//	compresses the bytes in the block and writes what the compressor
+//	gives out; a flush makes all of them reach the file, the end of
+//	the frame also writes the frame epilogue.
+
+int
+CompressedFileBuf::compress(int mode)
+{
+  int res = 0;
+
+#ifdef _ZSTD
+  if (codec == ZSTD) {
+    size_t numIn = pptr() - pbase();
+    ZSTD_EndDirective op = ZSTD_e_continue;
+    if (mode == 1)
+      op = ZSTD_e_flush;
+    else if (mode == 2)
+      op = ZSTD_e_end;
+
+    ZSTD_inBuffer in = {inBuf, numIn, 0};
+    bool finished = false;
+    while (finished == false) {
+      ZSTD_outBuffer out = {outBuf, sizeOut, 0};
+      size_t left = ZSTD_compressStream2((ZSTD_CCtx *)theContext, &out, &in, op);
+      if (ZSTD_isError(left) || this->writeOut(outBuf, out.pos) < 0) {
+	res = -1;
+	break;
+      }
+      if (op == ZSTD_e_continue)
+	finished = (in.pos == in.size);
+      else
+	finished = (left == 0);
+    }
+  }
+#endif
+
+#ifdef _LZ4
+  if (codec == LZ4) {
+    LZ4F_cctx *theCtx = (LZ4F_cctx *)theContext;
+    size_t numIn = pptr() - pbase();
+    size_t n = 0;
+    if (numIn != 0) {
+      n = LZ4F_compressUpdate(theCtx, outBuf, sizeOut, inBuf, numIn, 0);
+      if (LZ4F_isError(n) || this->writeOut(outBuf, n) < 0)
+	res = -1;
+    }
+    if (res == 0 && mode != 0) {
+      if (mode == 1)
+	n = LZ4F_flush(theCtx, outBuf, sizeOut, 0);
+      else
+	n = LZ4F_compressEnd(theCtx, outBuf, sizeOut, 0);
+      if (LZ4F_isError(n) || this->writeOut(outBuf, n) < 0)
+	res = -1;
+    }
+  }
+#endif
+
+  this->setp(inBuf, inBuf + CompressedFileBuf_blockSize);
+  return res;
+}
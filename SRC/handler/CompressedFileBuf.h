@@ -0,0 +1,68 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _CompressedFileBuf
+#define _CompressedFileBuf
+
+// Description: This file contains the class definition for
+// CompressedFileBuf. A CompressedFileBuf is a std::streambuf that
+// compresses what is written to it into a zstd or lz4 frame in a file.
+// The bytes are gathered in blocks of 1 MB and each full block is
+// compressed and written out, so a file stream writing through it works
+// as before, only on a compressed file. Appending to a file adds a new
+// frame, which both the zstd and lz4 tools decompress as one stream.
+// The codecs are those the build links, _ZSTD and _LZ4.
+
+#include <streambuf>
+#include <fstream>
+#include <stdio.h>
+
+class CompressedFileBuf : public std::streambuf
+{
+ public:
+  enum {NONE, ZSTD, LZ4};
+
+  // the codec for a name, -1 if unknown or not in this build
+  static int getCodec(const char *name);
+
+  CompressedFileBuf(int codec);
+  ~CompressedFileBuf();
+
+  int open(std::ofstream &theFile, const char *fileName, bool append);
+  int close(std::ofstream &theFile);
+  bool isOpen(void) {return theOutput != 0;}
+
+ protected:
+  int overflow(int c);
+  int sync(void);
+
+ private:
+  int compress(int mode);   // 0 continue, 1 flush, 2 end of frame
+  int writeOut(const char *data, size_t n);
+
+  int codec;
+  FILE *theOutput;
+  char *inBuf;
+  char *outBuf;
+  size_t sizeOut;
+  void *theContext;
+};
+
+#endif
@@ -33,6 +33,8 @@
 #include <Channel.h>
 #include <Message.h>
 #include <Matrix.h>
+#include <stdio.h>
+#include <charconv>
 
 using std::cerr;
 using std::ios;
@@ -43,8 +45,11 @@ using std::getline;
 
 DataFileStream::DataFileStream(int indent)
   :OPS_Stream(OPS_STREAM_TAGS_DataFileStream), 
-   fileOpen(0), fileName(0), indentSize(indent), sendSelfCount(0), theChannels(0), numDataRows(0),
-   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), doCSV(0), commonColumns(0)
+   fileOpen(0), fileName(0), indentSize(indent), sendSelfCount(0), theChannels(0), numDataRows(0), sharded(false),
+   mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), doCSV(0),
+   closeOnWrite(false), thePrecision(6), doScientific(false), commonColumns(0),
+   theBuffer(0), numBuffer(0), floatFormat(0),
+   theCompression(0)
 {
   if (indentSize < 1) indentSize = 1;
   indentString = new char[indentSize+5];
@@ -56,13 +61,17 @@ DataFileStream::DataFileStream(int indent)
 DataFileStream::DataFileStream(const char *file, openMode mode, int indent, int csv, bool closeWrite, int prec, bool scientific)
   :OPS_Stream(OPS_STREAM_TAGS_DataFileStream), 
    fileOpen(0), fileName(0), indentSize(indent), sendSelfCount(0), 
-   theChannels(0), numDataRows(0),
+   theChannels(0), numDataRows(0), sharded(false),
    mapping(0), maxCount(0), sizeColumns(0), 
    theColumns(0), theData(0), theRemoteData(0), 
-   doCSV(csv), closeOnWrite(closeWrite), commonColumns(0)
+   doCSV(csv), closeOnWrite(closeWrite), commonColumns(0),
+   theBuffer(0), numBuffer(0), floatFormat(0),
+   theCompression(0)
 {
   thePrecision = prec;
   doScientific = scientific;
+  if (doScientific == true)
+    floatFormat = 2;
 
   if (indentSize < 1) indentSize = 1;
   indentString = new char[indentSize+1];
@@ -75,8 +84,16 @@ DataFileStream::DataFileStream(const char *file, openMode mode, int indent, int
 
 DataFileStream::~DataFileStream()
 {
-  if (fileOpen == 1)
-    theFile.close();
+  if (fileOpen == 1) {
+    this->flushBuffer();
+    this->closeFile();
+  }
+
+  if (theBuffer != 0)
+    delete [] theBuffer;
+
+  if (theCompression != 0)
+    delete theCompression;
 
   if (theChannels != 0) {
     delete [] theChannels;
@@ -139,7 +156,8 @@ DataFileStream::setFile(const char *name, openMode mode)
 
   // if file already open, close it
   if (fileOpen == 1) {
-    theFile.close();
+    this->flushBuffer();
+    this->closeFile();
     fileOpen = 0;
   }
 
@@ -165,7 +183,9 @@ DataFileStream::open(void)
     return 0;
   }
 
-  if (theOpenMode == OVERWRITE) 
+  if (theCompression != 0)
+    theCompression->open(theFile, fileName, theOpenMode == APPEND);
+  else if (theOpenMode == OVERWRITE) 
     theFile.open(fileName, ios::out);
   else
     theFile.open(fileName, ios::out| ios::app);
@@ -191,8 +211,10 @@ DataFileStream::open(void)
 int 
 DataFileStream::close(openMode nextOpenMode)
 {
-  if (fileOpen != 0)
-    theFile.close();
+  if (fileOpen != 0) {
+    this->flushBuffer();
+    this->closeFile();
+  }
   fileOpen = 0;
   
   theOpenMode = nextOpenMode;
@@ -207,6 +229,7 @@ DataFileStream::setPrecision(int prec)
   if (fileOpen == 0)
     this->open();
 
+  thePrecision = prec;
   if (fileOpen != 0)
     theFile << std::setprecision(prec);
 
@@ -220,10 +243,12 @@ DataFileStream::setFloatField(floatField field)
     this->open();
 
   if (field == FIXEDD) {
+    floatFormat = 1;
     if (fileOpen != 0)
       theFile << setiosflags(ios::fixed);
   }
   else if (field == SCIENTIFIC) {
+    floatFormat = 2;
     if (fileOpen != 0)
       theFile << setiosflags(ios::scientific);
   }
@@ -232,6 +257,33 @@ DataFileStream::setFloatField(floatField field)
 }
 
 
+int 
+DataFileStream::setCompression(const char *codec)
+{
+  int type = CompressedFileBuf::getCodec(codec);
+  // not in this build, or too late for a file already written to
+  if (type < 0 || fileOpen == 1)
+    return -1;
+
+  if (theCompression != 0)
+    delete theCompression;
+  theCompression = 0;
+
+  if (type != CompressedFileBuf::NONE)
+    theCompression = new CompressedFileBuf(type);
+
+  return 0;
+}
+
+void
+DataFileStream::closeFile(void)
+{
+  if (theCompression != 0 && theCompression->isOpen())
+    theCompression->close(theFile);
+  else
+    theFile.close();
+}
+
 int 
 DataFileStream::tag(const char *tagName)
 {
@@ -279,6 +331,18 @@ DataFileStream::write(Vector &data)
   // if not parallel, just write the data
   //
 
+  if (sharded == true && sendSelfCount != 0) {
+    // each process writes its own columns, see setOrder()
+    if (data.Size() != 0) {
+      if (fileOpen == 0)
+	this->open();
+      (*this) << data;
+      if (closeOnWrite == true)
+	this->close();
+    }
+    return 0;
+  }
+
   if (sendSelfCount == 0) {
     (*this) << data;  
     if (closeOnWrite == true)
@@ -339,7 +403,8 @@ DataFileStream::write(Vector &data)
 	int startLoc = (int)printMapping(1,i);
 	double *data = theData[fileID];
 	for (int j=0; j<numData; j++) {
-	  theFile << data[startLoc++] << " ";
+	  this->writeValue(data[startLoc++]);
+	  this->writeChar(' ');
 	}
       } 
 
@@ -358,11 +423,12 @@ DataFileStream::write(Vector &data)
 	    else
 	      value += data[startLoc+j];
 	  }
-	  theFile << value << " ";
+	  this->writeValue(value);
+	  this->writeChar(' ');
 	}
       }
     }
-    theFile << "\n";
+    this->writeChar('\n');
   } else {
 
     for (int i=0; i<maxCount+1; i++) {
@@ -377,11 +443,13 @@ DataFileStream::write(Vector &data)
 	double *data = theData[fileID];
 	int nM1 = numData-1;
 
-	for (int j=0; j<numData; j++)
+	for (int j=0; j<numData; j++) {
+	  this->writeValue(data[startLoc++]);
 	  if ((i ==maxCount) && (j == nM1))
-	    theFile << data[startLoc++] << "\n";
+	    this->writeChar('\n');
 	  else
-	    theFile << data[startLoc++] << ",";
+	    this->writeChar(',');
+	}
       } 
 
       else {
@@ -400,10 +468,11 @@ DataFileStream::write(Vector &data)
 	    else
 	      value += data[startLoc+j];
 	  }
+	  this->writeValue(value);
 	  if ((i ==maxCount) && (j == nM1))
-	    theFile << value << "\n";
+	    this->writeChar('\n');
 	  else
-	    theFile << value << ",";
+	    this->writeChar(',');
 	}
       }
     }
@@ -423,6 +492,7 @@ DataFileStream::write(const char *s,int n)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile.write(s, n);
 
@@ -435,6 +505,7 @@ DataFileStream::write(const unsigned char*s,int n)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile.write((const char *) s, n);
 
@@ -446,6 +517,7 @@ DataFileStream::write(const signed char*s,int n)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile.write((const char *) s, n);
 
@@ -457,6 +529,7 @@ DataFileStream::write(const void *s, int n)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile.write((const char *) s, n);
 
@@ -473,18 +546,16 @@ DataFileStream::write(const double *s, int n)
 
   if (fileOpen != 0) {
     if (n > 0) {
-      if (doCSV == 0) {
-	int nm1 = n-1;
-	for (int i=0; i<nm1; i++) {
-	  theFile << s[i] << " ";
-	}
-	theFile << s[nm1] << "\n";
-      } else { int nm1 = n-1;
-	for (int i=0; i<nm1; i++) {
-	  theFile << s[i] << ",";
-	}
-	theFile << s[nm1] << "\n";
+      char sep = ' ';
+      if (doCSV != 0)
+	sep = ',';
+      int nm1 = n-1;
+      for (int i=0; i<nm1; i++) {
+	this->writeValue(s[i]);
+	this->writeChar(sep);
       }
+      this->writeValue(s[nm1]);
+      this->writeChar('\n');
     }
   }
   return *this;
@@ -497,6 +568,7 @@ DataFileStream::operator<<(char c)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile << c;
 
@@ -508,6 +580,7 @@ DataFileStream::operator<<(unsigned char c)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile << c;
 
@@ -519,6 +592,7 @@ DataFileStream::operator<<(signed char c)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile << c;
 
@@ -533,6 +607,7 @@ DataFileStream::operator<<(const char *s)
   // note that we do the flush so that a "/n" before
   // a crash will cause a flush() - similar to what 
   if (fileOpen != 0) {
+    this->flushBuffer();
     theFile << s;
     theFile.flush();
   }
@@ -545,6 +620,7 @@ DataFileStream::operator<<(const unsigned char *s)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile << s;
 
@@ -556,6 +632,7 @@ DataFileStream::operator<<(const signed char *s)
   if (fileOpen == 0)
     this->open();
 
+  this->flushBuffer();
   if (fileOpen != 0)
     theFile << s;
 
@@ -580,7 +657,7 @@ DataFileStream::operator<<(int n)
     this->open();
 
   if (fileOpen != 0)
-    theFile << 1.0*n;
+    this->writeValue(1.0*n);
 
   return *this;
 }
@@ -591,7 +668,7 @@ DataFileStream::operator<<(unsigned int n)
     this->open();
 
   if (fileOpen != 0)
-    theFile << 1.0*n;
+    this->writeValue(1.0*n);
 
   return *this;
 }
@@ -662,7 +739,7 @@ DataFileStream::operator<<(double n)
     this->open();
 
   if (fileOpen != 0)
-    theFile << n;
+    this->writeValue(n);
 
   return *this;
 }
@@ -673,7 +750,7 @@ DataFileStream::operator<<(float n)
     this->open();
 
   if (fileOpen != 0)
-    theFile << n;
+    this->writeValue(n);
 
   return *this;
 }
@@ -692,7 +769,7 @@ DataFileStream::sendSelf(int commitTag, Channel &theChannel)
     delete [] theChannels;
   theChannels = theNextChannels;
 
-  static ID idData(3);
+  static ID idData(6);
   int fileNameLength = 0;
   if (fileName != 0)
     fileNameLength = int(strlen(fileName));
@@ -705,6 +782,9 @@ DataFileStream::sendSelf(int commitTag, Channel &theChannel)
     idData(1) = 1;
 
   idData(2) = sendSelfCount;
+  idData(3) = (sharded == true) ? 1 : 0;
+  idData(4) = doCSV;
+  idData(5) = thePrecision;
 
   if (theChannel.sendID(0, commitTag, idData) < 0) {
     opserr << "DataFileStream::sendSelf() - failed to send id data\n";
@@ -725,7 +805,7 @@ DataFileStream::sendSelf(int commitTag, Channel &theChannel)
 int 
 DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
-  static ID idData(3);
+  static ID idData(6);
 
   sendSelfCount = -1;
   theChannels = new Channel *[1];
@@ -742,6 +822,13 @@ DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &t
   else
     theOpenMode = APPEND;
 
+  // a shard is written here as P0 would write it, from the start
+  sharded = (idData(3) != 0);
+  if (sharded == true)
+    theOpenMode = OVERWRITE;
+  doCSV = idData(4);
+  thePrecision = idData(5);
+
   if (fileNameLength != 0) {
     if (fileName != 0)
       delete [] fileName;
@@ -761,7 +848,7 @@ DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &t
 
     sprintf(&fileName[fileNameLength],".%d",tag);
 
-    /* don't write anymore .. so don't need to open file
+    /* don't write anymore .. so don't need to open file, unless sharded
 
     if (this->setFile(fileName, theOpenMode) < 0) {
       opserr << "DataFileStream::DataFileStream() - setFile() failed\n";
@@ -777,9 +864,73 @@ DataFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &t
 }
 
 
+int
+DataFileStream::setSharded(bool onOff)
+{
+  // the processes must know before the stream is sent to them
+  if (sendSelfCount != 0)
+    return -1;
+
+  sharded = onOff;
+  return 0;
+}
+
+
+// int writeShardIndex(void);
+//	called on P0 in setOrder() once the column order of all the
+//	processes is in: writes the index of the shards to fileName, a line
+//	for each process with columns, giving its shard, the number of values
+//	in a row and the output column of each value, then moves the output
+//	of P0 itself to fileName.0.
+
+int
+DataFileStream::writeShardIndex(void)
+{
+  if (fileName == 0)
+    return -1;
+
+  if (fileOpen == 1) {
+    this->flushBuffer();
+    this->closeFile();
+    fileOpen = 0;
+  }
+
+  ofstream theIndex(fileName, ios::out);
+  if (theIndex.bad()) {
+    opserr << "WARNING DataFileStream::setOrder() - could not open shard index " << fileName << endln;
+    return -1;
+  }
+
+  theIndex << "# shards of " << fileName << ": file, values in a row, output column of each value\n";
+  if (addCommonFlag != 0)
+    theIndex << "# a column in more than one shard is " 
+	     << ((addCommonFlag == 2) ? "the same in each\n" : "the sum of them\n");
+
+  for (int i=0; i<=sendSelfCount; i++) {
+    int numColumns = (*sizeColumns)(i);
+    if (numColumns == 0)
+      continue;
+    theIndex << fileName << "." << i << " " << numColumns;
+    const ID &theOrder = *theColumns[i];
+    for (int j=0; j<numColumns; j++)
+      theIndex << " " << theOrder(j);
+    theIndex << "\n";
+  }
+  theIndex.close();
+
+  char *shardName = new char[strlen(fileName)+10];
+  sprintf(shardName, "%s.0", fileName);
+  int res = this->setFile(shardName, OVERWRITE);
+  delete [] shardName;
+
+  return res;
+}
+
+
 void
 DataFileStream::indent(void)
 {
+  this->flushBuffer();
   if (fileOpen != 0)
     for (int i=0; i<numIndent; i++)
       theFile << indentString;
@@ -860,6 +1011,10 @@ DataFileStream::setOrder(const ID &orderData)
       }
     }
 
+    // only the order is gathered, the processes write their own rows
+    if (sharded == true)
+      return this->writeShardIndex();
+
     ID currentLoc(sendSelfCount+1);
     ID currentCount(sendSelfCount+1);
 	
@@ -946,8 +1101,89 @@ DataFileStream::setOrder(const ID &orderData)
 }
 
 int DataFileStream::flush() {
-  if (theFile.is_open() && theFile.good()) {
+  if (fileOpen != 0 && theFile.good()) {
+    this->flushBuffer();
     theFile.flush();
   }
   return 0;
 }
+
+
+// the buffer is written out in blocks of this size; the reserve is room
+// for the longest number of the fixed format at a usual precision
+static const int DataFileStream_bufferSize = 65536;
+static const int DataFileStream_reserve = 512;
+
+void
+DataFileStream::writeValue(double value)
+{
+  if (theBuffer == 0) {
+    theBuffer = new char[DataFileStream_bufferSize];
+    numBuffer = 0;
+  }
+
+  if (numBuffer > DataFileStream_bufferSize - DataFileStream_reserve)
+    this->flushBuffer();
+
+  char *first = theBuffer + numBuffer;
+  char *last = theBuffer + DataFileStream_bufferSize;
+  bool ok = true;
+
+  // the same text as the stream gives with its precision and float
+  // field, i.e. printf() %g, %f or %e
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  std::chars_format fmt = std::chars_format::general;
+  if (floatFormat == 1)
+    fmt = std::chars_format::fixed;
+  else if (floatFormat == 2)
+    fmt = std::chars_format::scientific;
+
+  std::to_chars_result res;
+  if (thePrecision < 0)
+    res = std::to_chars(first, last, value, fmt);
+  else
+    res = std::to_chars(first, last, value, fmt, thePrecision);
+
+  if (res.ec == std::errc())
+    numBuffer = int(res.ptr - theBuffer);
+  else
+    ok = false;
+#else
+  const char *fmt = "%.*g";
+  if (floatFormat == 1)
+    fmt = "%.*f";
+  else if (floatFormat == 2)
+    fmt = "%.*e";
+
+  int prec = thePrecision < 0 ? 17 : thePrecision;
+  int n = snprintf(first, last-first, fmt, prec, value);
+  if (n >= 0 && n < last-first)
+    numBuffer += n;
+  else
+    ok = false;
+#endif
+
+  // too long for the buffer, let the stream do it
+  if (ok == false) {
+    this->flushBuffer();
+    theFile << value;
+  }
+}
+
+void
+DataFileStream::writeChar(char c)
+{
+  if (theBuffer == 0 || numBuffer == DataFileStream_bufferSize) {
+    this->flushBuffer();
+    theFile << c;
+  } else
+    theBuffer[numBuffer++] = c;
+}
+
+void
+DataFileStream::flushBuffer(void)
+{
+  if (numBuffer != 0 && fileOpen != 0)
+    theFile.write(theBuffer, numBuffer);
+  numBuffer = 0;
+}
@@ -26,6 +26,7 @@
 #define _DataFileStream
 
 #include <OPS_Stream.h>
+#include <CompressedFileBuf.h>
 
 #include <fstream>
 using std::ofstream;
@@ -44,8 +45,10 @@ class DataFileStream : public OPS_Stream
   int open(void);
   int flush();
 
+  // a negative precision writes the shortest round trip form of each double
   int setPrecision(int precision);
   int setFloatField(floatField);
+  int setCompression(const char *codec);
   int precision(int precision) {return 0;};
   int width(int width) {return 0;};
   const char *getFileName(void) {return fileName;}
@@ -85,6 +88,7 @@ class DataFileStream : public OPS_Stream
 
   // parallel stuff
   int setOrder(const ID &orderOfData);
+  int setSharded(bool onOff);
   int sendSelf(int commitTag, Channel &theChannel);  
   int recvSelf(int commitTag, Channel &theChannel, 
 	       FEM_ObjectBroker &theBroker);
@@ -104,6 +108,11 @@ class DataFileStream : public OPS_Stream
   Channel **theChannels;
   int numDataRows;
 
+  // each process writes its own columns to fileName.n, P0 writes an
+  // index of the shards to fileName instead of gathering the rows
+  bool sharded;
+  int writeShardIndex(void);
+
   Matrix *mapping;
   int maxCount;
   ID *sizeColumns;
@@ -118,6 +127,18 @@ class DataFileStream : public OPS_Stream
   bool doScientific;
 
   ID *commonColumns;
+
+  // the doubles are formatted into a buffer, written to the file when
+  // full and before anything else goes to the file
+  void writeValue(double value);
+  void writeChar(char c);
+  void flushBuffer(void);
+  char *theBuffer;
+  int numBuffer;
+  int floatFormat; // 0 general, 1 fixed, 2 scientific
+
+  void closeFile(void);
+  CompressedFileBuf *theCompression;  // 0 for a plain file
 };
 
 #endif
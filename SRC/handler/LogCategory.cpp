@@ -0,0 +1,150 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of LogCategory.
+
+#include <LogCategory.h>
+#include <OPS_Globals.h>
+
+#include <map>
+#include <mutex>
+
+static std::mutex theCategoriesMutex;
+static long theDefaultLimit = -1;
+
+// the categories by name; never destroyed, as warnings may be issued
+// while the static objects of the program are being destroyed
+static std::map<std::string, LogCategory *> &
+getCategories(void)
+{
+  static std::map<std::string, LogCategory *> *theCategories =
+    new std::map<std::string, LogCategory *>;
+  return *theCategories;
+}
+
+LogCategory::LogCategory(const char *theName, const char *theWhat)
+  :name(theName), what(theWhat), count(0), limit(theDefaultLimit),
+   ownLimit(false)
+{
+
+}
+
+LogCategory &
+LogCategory::get(const char *theName, const char *theWhat)
+{
+  std::lock_guard<std::mutex> lock(theCategoriesMutex);
+  std::map<std::string, LogCategory *> &theCategories = getCategories();
+  std::map<std::string, LogCategory *>::iterator it = theCategories.find(theName);
+  if (it != theCategories.end()) {
+    if (it->second->what.empty())
+      it->second->what = theWhat;
+    return *(it->second);
+  }
+
+  LogCategory *theCategory = new LogCategory(theName, theWhat);
+  theCategories[theCategory->name] = theCategory;
+  return *theCategory;
+}
+
+bool
+LogCategory::report(void)
+{
+  long n = ++count;
+  long theLimit = limit;
+  if (theLimit < 0 || n <= theLimit)
+    return true;
+
+  // said once, when the first one is held back
+  if (n == theLimit+1)
+    opserr << "WARNING further " << name.c_str() << " warnings ("
+	   << what.c_str() << ") are not printed, they are counted\n";
+
+  return false;
+}
+
+int
+LogCategory::setLimit(const char *theName, long theLimit)
+{
+  std::lock_guard<std::mutex> lock(theCategoriesMutex);
+  std::map<std::string, LogCategory *> &theCategories = getCategories();
+
+  if (theName == 0) {
+    theDefaultLimit = theLimit;
+    std::map<std::string, LogCategory *>::iterator it;
+    for (it = theCategories.begin(); it != theCategories.end(); ++it)
+      if (it->second->ownLimit == false)
+	it->second->limit = theLimit;
+    return 0;
+  }
+
+  std::map<std::string, LogCategory *>::iterator it = theCategories.find(theName);
+  LogCategory *theCategory;
+  if (it != theCategories.end()) {
+    theCategory = it->second;
+  } else {
+    // set before its first warning, it is told what it counts then
+    theCategory = new LogCategory(theName, "");
+    theCategories[theCategory->name] = theCategory;
+  }
+
+  theCategory->limit = theLimit;
+  theCategory->ownLimit = true;
+  return 0;
+}
+
+void
+LogCategory::reset(void)
+{
+  std::lock_guard<std::mutex> lock(theCategoriesMutex);
+  std::map<std::string, LogCategory *> &theCategories = getCategories();
+  std::map<std::string, LogCategory *>::iterator it;
+  for (it = theCategories.begin(); it != theCategories.end(); ++it)
+    it->second->count = 0;
+}
+
+void
+LogCategory::getCounts(std::vector<std::pair<std::string, long> > &counts)
+{
+  std::lock_guard<std::mutex> lock(theCategoriesMutex);
+  std::map<std::string, LogCategory *> &theCategories = getCategories();
+  std::map<std::string, LogCategory *>::iterator it;
+  counts.clear();
+  for (it = theCategories.begin(); it != theCategories.end(); ++it)
+    if (it->second->count != 0)
+      counts.push_back(std::make_pair(it->first, it->second->count.load()));
+}
+
+void
+LogCategory::printSummary(OPS_Stream &s)
+{
+  std::lock_guard<std::mutex> lock(theCategoriesMutex);
+  std::map<std::string, LogCategory *> &theCategories = getCategories();
+  std::map<std::string, LogCategory *>::iterator it;
+  for (it = theCategories.begin(); it != theCategories.end(); ++it) {
+    LogCategory *theCategory = it->second;
+    if (theCategory->count == 0)
+      continue;
+    s << theCategory->name.c_str() << " " << theCategory->what.c_str()
+      << " " << theCategory->count.load() << " times";
+    if (theCategory->limit >= 0 && theCategory->count > theCategory->limit)
+      s << " (" << theCategory->limit << " printed)";
+    s << endln;
+  }
+}
@@ -0,0 +1,80 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _LogCategory
+#define _LogCategory
+
+// Description: This file contains the class definition for LogCategory.
+// A LogCategory counts the occurrences of one kind of warning, e.g. the
+// failures of the state determination of an element, and decides if each
+// is printed. A warning is written as
+//
+//   OPS_WARNING("ForceBeamColumn3d::update", "failed to converge")
+//     << "WARNING - ForceBeamColumn3d::update - ... " << tag << endln;
+//
+// The category is looked up once per call site, and when it is suppressed
+// the message is not formatted at all. By default all are printed; a
+// limit stops the printing after that many and a summary reports the
+// counts, e.g. "ForceBeamColumn3d::update failed to converge 37512 times".
+
+#include <OPS_Stream.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <utility>
+
+class LogCategory
+{
+ public:
+  // the category of name, created on the first call
+  static LogCategory &get(const char *name, const char *what);
+
+  // counts an occurrence, returns true if it is to be printed
+  bool report(void);
+
+  const char *getName(void) const {return name.c_str();}
+  long getCount(void) const {return count;}
+
+  // number of occurrences printed, -1 for all; with a name of 0 the
+  // limit applies to all categories, including those not created yet
+  static int setLimit(const char *name, long limit);
+  static void reset(void);
+  static void printSummary(OPS_Stream &s);
+
+  // the name & count of each category that occurred
+  static void getCounts(std::vector<std::pair<std::string, long> > &counts);
+
+ private:
+  LogCategory(const char *name, const char *what);
+
+  std::string name;
+  std::string what;
+  std::atomic<long> count;
+  long limit;
+  bool ownLimit;
+};
+
+#define OPS_WARNING(name, what) \
+  if (!([]() -> bool { \
+    static LogCategory &theCategory = LogCategory::get(name, what); \
+    return theCategory.report(); })()) ; else opserr
+
+#endif
@@ -41,6 +41,7 @@ class OPS_Stream:  public MovableObject
   virtual int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false) {return 0;}
   virtual int setPrecision(int precision) {return 0;}
   virtual int setFloatField(floatField) {return 0;}
+  virtual int setCompression(const char *codec) {return -1;}
   virtual int precision(int precision) {return 0;}
   virtual int width(int width) {return 0;}
 
@@ -83,6 +84,7 @@ class OPS_Stream:  public MovableObject
   // parallel stuff
   virtual void setAddCommon(int);
   virtual int setOrder(const ID &order);
+  virtual int setSharded(bool onOff) {return -1;}
   virtual int sendSelf(int commitTag, Channel &theChannel) =0;  
   virtual int recvSelf(int commitTag, Channel &theChannel, 
 		       FEM_ObjectBroker &theBroker) =0;
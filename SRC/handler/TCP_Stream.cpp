@@ -31,11 +31,37 @@
 #include <ID.h>
 #include <Channel.h>
 #include <Message.h>
+#include <CompressedFileBuf.h>
 
 #include <TCP_Socket.h>
 
+#include <string.h>
+#include <stdint.h>
+#include <thread>
+#include <chrono>
+
+#ifdef _ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef _LZ4
+#include <lz4frame.h>
+#endif
+
+static const int TCP_Stream_defaultBatch = 100;
+static const size_t TCP_Stream_headerSize = 32;
+
+static char *
+TCP_Stream_put(char *p, const void *value, size_t n)
+{
+  memcpy(p, value, n);
+  return p + n;
+}
+
 TCP_Stream::TCP_Stream()
-  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0) 
+  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0),
+   port(0), inetAddr(0), checkEndian(false), batchRows(0),
+   codec(CompressedFileBuf::NONE), numCols(0), numRows(0), sequence(0), numDropped(0)
 {
   theChannel = new TCP_Socket();
 }
@@ -43,9 +69,17 @@ TCP_Stream::TCP_Stream()
 
 TCP_Stream::TCP_Stream(unsigned int other_Port, 
 		       const char *other_InetAddr,
-		       bool checkEndianness)
-  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0) 
-{
+		       bool checkEndianness,
+		       int rows)
+  :OPS_Stream(OPS_STREAM_TAGS_TCP_Stream), sendSize(0), data(1), theChannel(0),
+   port(other_Port), inetAddr(0), checkEndian(checkEndianness), batchRows(rows),
+   codec(CompressedFileBuf::NONE), numCols(0), numRows(0), sequence(0), numDropped(0)
+{
+  if (other_InetAddr != 0) {
+    inetAddr = new char[strlen(other_InetAddr)+1];
+    strcpy(inetAddr, other_InetAddr);
+  }
+
   theChannel = new TCP_Socket(other_Port, other_InetAddr, checkEndianness);
   if (theChannel->setUpConnection() < 0) {
     opserr << "TCP_Stream - Failed to set up connection\n";
@@ -57,12 +91,30 @@ TCP_Stream::TCP_Stream(unsigned int other_Port,
 
 TCP_Stream::~TCP_Stream()
 {
-  data(0) = -1;
-  if (theChannel != 0 && theChannel->sendVector(0,0, data) < 0)
-    opserr << "TCP_Stream - failed to send close signal\n";
+  if (batchRows > 0) {
+
+    // what is left, then an empty chunk to mark the end
+    if (numRows > 0)
+      this->sendChunk();
+    numCols = 0;
+    if (this->sendChunk() < 0)
+      opserr << "TCP_Stream - failed to send close signal\n";
+
+    if (numDropped > 0)
+      opserr << "WARNING TCP_Stream - " << (int)numDropped 
+	     << " rows were dropped while " << inetAddr << " could not be reached\n";
+
+  } else {
+    data(0) = -1;
+    if (theChannel != 0 && theChannel->sendVector(0,0, data) < 0)
+      opserr << "TCP_Stream - failed to send close signal\n";
+  }
 
   if (theChannel != 0) 
     delete theChannel;
+
+  if (inetAddr != 0)
+    delete [] inetAddr;
 }
 
 int 
@@ -83,6 +135,32 @@ TCP_Stream::close(void)
   return 0;
 }
 
+int 
+TCP_Stream::flush(void)
+{
+  if (batchRows > 0 && numRows > 0)
+    return this->sendChunk();
+
+  return 0;
+}
+
+int 
+TCP_Stream::setCompression(const char *name)
+{
+  int theCodec = CompressedFileBuf::getCodec(name);
+  if (theCodec < 0)
+    return -1;
+
+  // a codec needs the chunked protocol
+  if (numRows > 0)
+    this->sendChunk();
+  codec = theCodec;
+  if (codec != CompressedFileBuf::NONE && batchRows <= 0)
+    batchRows = TCP_Stream_defaultBatch;
+
+  return 0;
+}
+
 int 
 TCP_Stream::tag(const char *tagName)
 {
@@ -124,6 +202,27 @@ int
 TCP_Stream::write(Vector &dataToSend)
 {
   int sizeToSend = dataToSend.Size();
+
+  if (batchRows > 0) {
+    if (sizeToSend == 0)
+      return 0;
+
+    // a chunk holds rows of one size
+    if (numRows > 0 && sizeToSend != numCols && this->sendChunk() < 0)
+      opserr << "TCP_Stream - failed to send data\n";
+
+    numCols = sizeToSend;
+    for (int i=0; i<sizeToSend; i++)
+      batch.push_back(dataToSend(i));
+    numRows++;
+
+    if (numRows >= batchRows && this->sendChunk() < 0) {
+      opserr << "TCP_Stream - failed to send data\n";
+      return -1;
+    }
+    return 0;
+  }
+
   if (sizeToSend == 0 || theChannel == 0)
     return 0;
 
@@ -262,6 +361,145 @@ TCP_Stream::operator<<(float n)
 }
 
 
+// int connect(void);
+//	opens a new connection to the collector, retrying a few times with
+//	a growing wait; returns -1 if it could not be reached.
+
+int 
+TCP_Stream::connect(void)
+{
+  if (theChannel != 0)
+    delete theChannel;
+  theChannel = 0;
+
+  if (inetAddr == 0)
+    return -1;
+
+  for (int i=0; i<maxRetries; i++) {
+    if (i > 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(100 << i));
+
+    TCP_Socket *theSocket = new TCP_Socket(port, inetAddr, checkEndian);
+    if (theSocket->setUpConnection() == 0) {
+      theChannel = theSocket;
+      return 0;
+    }
+    delete theSocket;
+  }
+
+  return -1;
+}
+
+// int sendChunk(void);
+//	packs the rows in the batch into a chunk, compressed if a codec is
+//	set and it pays, adds it to the chunks pending and sends those.
+
+int 
+TCP_Stream::sendChunk(void)
+{
+  uint32_t rawBytes = (uint32_t)(batch.size()*sizeof(double));
+  const char *raw = batch.empty() ? 0 : (const char *)&batch[0];
+
+  std::vector<char> theChunk;
+  uint8_t used = CompressedFileBuf::NONE;
+  uint32_t payloadBytes = rawBytes;
+
+#ifdef _ZSTD
+  if (codec == CompressedFileBuf::ZSTD && rawBytes > 0) {
+    size_t bound = ZSTD_compressBound(rawBytes);
+    theChunk.resize(TCP_Stream_headerSize + bound);
+    size_t n = ZSTD_compress(&theChunk[TCP_Stream_headerSize], bound, raw, rawBytes, 1);
+    if (!ZSTD_isError(n) && n < rawBytes) {
+      used = CompressedFileBuf::ZSTD;
+      payloadBytes = (uint32_t)n;
+    }
+  }
+#endif
+
+#ifdef _LZ4
+  if (codec == CompressedFileBuf::LZ4 && rawBytes > 0) {
+    size_t bound = LZ4F_compressFrameBound(rawBytes, 0);
+    theChunk.resize(TCP_Stream_headerSize + bound);
+    size_t n = LZ4F_compressFrame(&theChunk[TCP_Stream_headerSize], bound, raw, rawBytes, 0);
+    if (!LZ4F_isError(n) && n < rawBytes) {
+      used = CompressedFileBuf::LZ4;
+      payloadBytes = (uint32_t)n;
+    }
+  }
+#endif
+
+  if (used == CompressedFileBuf::NONE) {
+    theChunk.resize(TCP_Stream_headerSize + rawBytes);
+    if (rawBytes > 0)
+      memcpy(&theChunk[TCP_Stream_headerSize], raw, rawBytes);
+  } else
+    theChunk.resize(TCP_Stream_headerSize + payloadBytes);
+
+  // the header
+  int one = 1;
+  uint8_t version = 1;
+  uint16_t flags = (*(char *)&one == 1) ? 0 : 1;
+  uint32_t cols = numCols;
+  uint32_t rows = numRows;
+  uint64_t seq = sequence++;
+
+  char *p = &theChunk[0];
+  p = TCP_Stream_put(p, "OPSR", 4);
+  p = TCP_Stream_put(p, &version, 1);
+  p = TCP_Stream_put(p, &used, 1);
+  p = TCP_Stream_put(p, &flags, 2);
+  p = TCP_Stream_put(p, &cols, 4);
+  p = TCP_Stream_put(p, &rows, 4);
+  p = TCP_Stream_put(p, &rawBytes, 4);
+  p = TCP_Stream_put(p, &payloadBytes, 4);
+  TCP_Stream_put(p, &seq, 8);
+
+  batch.clear();
+  numRows = 0;
+
+  // hold at most maxPending chunks, the oldest goes first
+  if ((int)pending.size() >= maxPending) {
+    uint32_t lost;
+    memcpy(&lost, &pending.front()[12], 4);
+    numDropped += lost;
+    pending.pop_front();
+  }
+  pending.push_back(std::vector<char>());
+  pending.back().swap(theChunk);
+
+  return this->sendPending();
+}
+
+// int sendPending(void);
+//	sends the chunks held, oldest first, reconnecting when a send
+//	fails; what could not be sent is kept for the next chunk.
+
+int 
+TCP_Stream::sendPending(void)
+{
+  int numTries = 0;
+  while (!pending.empty()) {
+    if (theChannel == 0) {
+      if (numTries++ > 0 || this->connect() < 0) {
+	opserr << "WARNING TCP_Stream - could not reach " << inetAddr << " " << (int)port 
+	       << ", holding " << (int)pending.size() << " chunks\n";
+	return -1;
+      }
+    }
+
+    std::vector<char> &theChunk = pending.front();
+    Message theMessage(&theChunk[0], (int)theChunk.size());
+    if (theChannel->sendMsg(0, 0, theMessage) < 0) {
+      delete theChannel;
+      theChannel = 0;
+      continue;
+    }
+    pending.pop_front();
+  }
+
+  return 0;
+}
+
 int 
 TCP_Stream::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -28,8 +28,39 @@
 #ifndef _TCP_Stream
 #define _TCP_Stream
 
+// Description: This file contains the class definition for TCP_Stream.
+// A TCP_Stream sends the rows recorded, write(Vector &), to a process
+// listening on a socket. By default each row is sent as a Vector, preceded
+// by its size whenever that changes, and -1 is sent on close.
+//
+// Given batchRows > 0 (or a codec through setCompression()) the rows are
+// instead gathered into chunks of at most batchRows rows, optionally
+// compressed with zstd or lz4, and each chunk is sent as
+//
+//   char    magic[4]      "OPSR"
+//   uint8   version       1
+//   uint8   codec         0 none, 1 zstd, 2 lz4 (CompressedFileBuf)
+//   uint16  flags         1 if the values are big endian
+//   uint32  numCols       values in each row
+//   uint32  numRows       rows in the chunk, 0 for the end of the stream
+//   uint32  rawBytes      8*numCols*numRows
+//   uint32  payloadBytes  bytes that follow, a zstd or lz4 frame if coded
+//   uint64  sequence      chunk number, counted from 0 over all connections
+//
+// followed by the payload, the rows of doubles one after the other. A
+// chunk is sent when full, when the number of values in a row changes,
+// on flush() and on close. If a send fails the stream reconnects, with
+// a few retries, and sends the chunks it still holds again; at most
+// maxPending chunks are held, the oldest is dropped when more pile up,
+// the gap showing in the sequence. The send itself happens on the
+// recorder's thread; wrapped in an AsyncStream (-async) the sends and
+// any reconnect happen on the writer thread and a slow collector makes
+// the recorder wait once the ring is full.
+
 #include <OPS_Stream.h>
 #include <Vector.h>
+#include <vector>
+#include <deque>
 class TCP_Socket;
 
 class TCP_Stream : public OPS_Stream
@@ -38,13 +69,16 @@ class TCP_Stream : public OPS_Stream
     TCP_Stream();        
     TCP_Stream(unsigned int other_Port, 
 	       const char *other_InetAddr,
-	       bool checkEndianness = false); 
+	       bool checkEndianness = false,
+	       int batchRows = 0); 
 
     ~TCP_Stream();
 
     int setFile(const char *fileName, openMode mode = OVERWRITE);
     int open(void);
     int close(void);
+    int flush(void);
+    int setCompression(const char *codec);
     
     // xml stuff
     int tag(const char *);
@@ -82,9 +116,28 @@ class TCP_Stream : public OPS_Stream
 		 FEM_ObjectBroker &theBroker);
     
  private:
+    int connect(void);
+    int sendChunk(void);
+    int sendPending(void);
+
     int sendSize;
     Vector data;
     TCP_Socket *theChannel;
+
+    // the chunked protocol
+    unsigned int port;
+    char *inetAddr;
+    bool checkEndian;
+    int batchRows;
+    int codec;
+    int numCols, numRows;
+    std::vector<double> batch;
+    std::deque<std::vector<char> > pending;
+    unsigned long long sequence;
+    long numDropped;
+
+    static const int maxPending = 16;
+    static const int maxRetries = 4;
 };
 
 #endif
@@ -44,9 +44,9 @@
 StandardStream sserr;
 OPS_Stream *opserrPtr = &sserr;
 
-double        ops_Dt = 0;
-Domain       *ops_TheActiveDomain = 0;
-Element      *ops_TheActiveElement = 0;
+thread_local double        ops_Dt = 0;
+thread_local Domain       *ops_TheActiveDomain = 0;
+thread_local Element      *ops_TheActiveElement = 0;
 
 int main(int argc, char **argv)
 {
@@ -45,7 +45,8 @@ XmlFileStream::XmlFileStream(int indent)
    fileOpen(0), fileName(0), filePrecision(6), indentSize(indent), numIndent(-1),
    attributeMode(false), numTag(0), sizeTags(0), tags(0), sendSelfCount(0), theChannels(0), numDataRows(0),
    mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), 
-   xmlOrderProcessed(0), xmlString(0), xmlStringLength(0), numXMLTags(0), xmlColumns(0)
+   xmlOrderProcessed(0), xmlString(0), xmlStringLength(0), numXMLTags(0), xmlColumns(0),
+   theCompression(0)
 {
   if (indentSize < 1) indentSize = 1;
   indentString = new char[indentSize+1];
@@ -58,7 +59,8 @@ XmlFileStream::XmlFileStream(const char *name, openMode mode, int indent)
    fileOpen(0), fileName(0), filePrecision(6), indentSize(indent), numIndent(-1),
    attributeMode(false), numTag(0), sizeTags(0), tags(0), sendSelfCount(0), theChannels(0), numDataRows(0),
    mapping(0), maxCount(0), sizeColumns(0), theColumns(0), theData(0), theRemoteData(0), 
-   xmlOrderProcessed(0), xmlString(0), xmlStringLength(0), numXMLTags(0), xmlColumns(0)
+   xmlOrderProcessed(0), xmlString(0), xmlStringLength(0), numXMLTags(0), xmlColumns(0),
+   theCompression(0)
 {
   if (indentSize < 1) indentSize = 1;
   indentString = new char[indentSize+1];
@@ -93,6 +95,9 @@ XmlFileStream::~XmlFileStream()
   if (fileName != 0)
     delete [] fileName;
 
+  if (theCompression != 0)
+    delete theCompression;
+
   if (sendSelfCount > 0) {
 
     for (int i=0; i<=sendSelfCount; i++) {
@@ -161,7 +166,7 @@ XmlFileStream::setFile(const char *name, openMode mode)
 
   // if file already open, close it
   if (fileOpen == 1) {
-    theFile.close();
+    this->closeFile();
     fileOpen = 0;
   }
 
@@ -191,8 +196,10 @@ XmlFileStream::open(void)
     strcat(fileName,".0");
   }
   
-  // open file
-  if (theOpenMode == OVERWRITE) 
+  // open file, the pieces of a parallel file are merged as text
+  if (theCompression != 0 && sendSelfCount == 0)
+    theCompression->open(theFile, fileName, theOpenMode == APPEND);
+  else if (theOpenMode == OVERWRITE) 
     theFile.open(fileName, ios::out);
   else
     theFile.open(fileName, ios::out| ios::app);
@@ -234,7 +241,7 @@ XmlFileStream::close(void)
     }
 
     theFile << "</OpenSees>\n";
-    theFile.close();
+    this->closeFile();
   }
 
   fileOpen = 0;
@@ -274,6 +281,33 @@ XmlFileStream::setFloatField(floatField field)
 }
 
 
+int 
+XmlFileStream::setCompression(const char *codec)
+{
+  int type = CompressedFileBuf::getCodec(codec);
+  // not in this build, or too late for a file already written to
+  if (type < 0 || fileOpen == 1)
+    return -1;
+
+  if (theCompression != 0)
+    delete theCompression;
+  theCompression = 0;
+
+  if (type != CompressedFileBuf::NONE)
+    theCompression = new CompressedFileBuf(type);
+
+  return 0;
+}
+
+void
+XmlFileStream::closeFile(void)
+{
+  if (theCompression != 0 && theCompression->isOpen())
+    theCompression->close(theFile);
+  else
+    theFile.close();
+}
+
 int 
 XmlFileStream::tag(const char *tagName)
 {
@@ -1333,7 +1367,7 @@ XmlFileStream::mergeXML()
 {
   int fileNameLength = int(strlen(fileName));
 
-  theFile.close();
+  this->closeFile();
   fileOpen = 0;
   
   if (sendSelfCount < 0) {
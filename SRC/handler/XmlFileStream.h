@@ -26,6 +26,7 @@
 #define _XmlFileStream
 
 #include <OPS_Stream.h>
+#include <CompressedFileBuf.h>
 
 #include <fstream>
 using std::ofstream;
@@ -46,6 +47,7 @@ class XmlFileStream : public OPS_Stream
 
   int setPrecision(int precision);
   int setFloatField(floatField);
+  int setCompression(const char *codec);
   int precision(int precision) {return 0;};
   int width(int width) {return 0;};
   const char *getFileName(void) {return fileName;}
@@ -125,6 +127,9 @@ class XmlFileStream : public OPS_Stream
 
   int numXMLTags;
   ID *xmlColumns;
+
+  void closeFile(void);
+  CompressedFileBuf *theCompression;  // 0 for a plain file
 };
 
 #endif
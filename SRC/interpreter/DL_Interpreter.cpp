@@ -151,6 +151,14 @@ int DL_Interpreter::setDouble(std::map<const char*, std::vector<double>>& data)
     return -1;
 }
 
+// a row major array, numCols 0 for a vector; by default a flat list
+int
+DL_Interpreter::setDoubleArray(double *data, int numRows, int numCols)
+{
+    int numArgs = (numCols > 0) ? numRows*numCols : numRows;
+    return this->setDouble(data, numArgs, false);
+}
+
 int
 DL_Interpreter::setString(const char*)
 {
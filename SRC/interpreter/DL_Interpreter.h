@@ -83,6 +83,7 @@ class DL_Interpreter
     virtual int setDouble(std::vector<std::vector<double>>& data);
     virtual int setDouble(std::map<const char*, double>& data);
     virtual int setDouble(std::map<const char*, std::vector<double>>& data);
+    virtual int setDoubleArray(double *, int numRows, int numCols);
     virtual int setString(const char*);
     virtual int setString(std::vector<const char*>& data);
     virtual int setString(std::vector<std::vector<const char*>>& data);
@@ -56,6 +56,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <PlainHandler.h>
 #include <RCM.h>
 #include <AMDNumberer.h>
+#include <NestedDissectionNumberer.h>
 #include <LimitCurve.h>
 #include <DamageModel.h>
 #include <FrictionModel.h>
@@ -66,6 +67,9 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <YieldSurface_BC.h>
 #include <CyclicModel.h>
 #include <FileStream.h>
+#include <AnalysisProfiler.h>
+#include <MemoryReport.h>
+#include <AnalysisMetrics.h>
 #include <CTestNormUnbalance.h>
 #include <NewtonRaphson.h>
 #include <TransformationConstraintHandler.h>
@@ -75,11 +79,13 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <ProfileSPDLinSolver.h>
 #include <ProfileSPDLinDirectSolver.h>
 #include <ProfileSPDLinSOE.h>
+#include <LinearSOESolver.h>
 #include <SymBandEigenSolver.h>
 #include <SymBandEigenSOE.h>
 #include <FullGenEigenSolver.h>
 #include <FullGenEigenSOE.h>
 #include <ArpackSOE.h>
+#include <DampedArpackSOE.h>
 #include <LoadControl.h>
 #include <CTestPFEM.h>
 #include <PFEMIntegrator.h>
@@ -101,12 +107,21 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <RegulaFalsiLineSearch.h>
 #include <NewtonLineSearch.h>
 #include <FileDatastore.h>
+#include <MemoryDatastore.h>
+#include <CheckpointDatastore.h>
+#include <AnalysisCheckpoint.h>
 #include <Mesh.h>
 #ifdef _MUMPS
 #include <MumpsSolver.h>
 #include <MumpsSOE.h>
 #endif
 #include <BackgroundMesh.h>
+#include <Node.h>
+#include <DOF_Group.h>
+#include <Matrix.h>
+#include <vector>
+#include <algorithm>
+#include <MapOfTaggedObjects.h>
 
 #ifdef _PARALLEL_INTERPRETERS
 bool setMPIDSOEFlag = false;
@@ -152,8 +167,11 @@ OpenSeesCommands::OpenSeesCommands(DL_Interpreter* interp)
      theVariableTimeStepTransientAnalysis(0),
      thePFEMAnalysis(0),
      theAnalysisModel(0), theTest(0), numEigen(0), theDatabase(0),
+     theCheckpoint(0), theRetryPolicy(0), buildingRung(false),
+     theRungAlgorithm(0), theRungTest(0),
      theBroker(), theTimer(), theSimulationInfo(), theMachineBroker(0),
-     theChannels(0), numChannels(0), reliability(0)
+     theChannels(0), numChannels(0), reliability(0),
+     otherContexts(), currentContext(0), nextContext(1)
 {
 #ifdef _PARALLEL_INTERPRETERS
     theMachineBroker = new MPI_MachineBroker(&theBroker, 0, 0);
@@ -183,7 +201,13 @@ OpenSeesCommands::OpenSeesCommands(DL_Interpreter* interp)
 
 OpenSeesCommands::~OpenSeesCommands()
 {
+    while (!otherContexts.empty()) {
+	this->removeModelContext(otherContexts.begin()->first);
+    }
+
     if (reliability != 0) delete reliability;
+    if (theCheckpoint != 0) delete theCheckpoint;
+    this->discardRetryRung();
     if (theDomain != 0) delete theDomain;
     if (theDatabase != 0) delete theDatabase;
     cmds = 0;
@@ -292,6 +316,10 @@ OpenSeesCommands::eigen(int typeSolver, double shift,
 							     *theSOE,
 							     *theTransientIntegrator,
 							     theTest);
+	if (theCheckpoint != 0)
+	    theTransientAnalysis->setCheckpoint(theCheckpoint);
+	if (theRetryPolicy != 0)
+	    theTransientAnalysis->setRetryPolicy(theRetryPolicy);
 	newanalysis = true;
     }
 
@@ -316,6 +344,10 @@ OpenSeesCommands::eigen(int typeSolver, double shift,
 	    FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
 	    theEigenSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
 
+	} else if (typeSolver == EigenSOE_TAGS_DampedArpackSOE) {
+
+	    theEigenSOE = new DampedArpackSOE();
+
 	} else {
 
 	    theEigenSOE = new ArpackSOE(shift);
@@ -348,18 +380,78 @@ OpenSeesCommands::eigen(int typeSolver, double shift,
     }
 
     if (result == 0) {
+	// the damped solver also returns the damping ratios of the modes
+	DampedArpackSOE *theDampedSOE = 0;
+	if (theEigenSOE->getClassTag() == EigenSOE_TAGS_DampedArpackSOE)
+	    theDampedSOE = (DampedArpackSOE *)theEigenSOE;
 	const Vector &eigenvalues = theDomain->getEigenvalues();
-	double* data = new double[numEigen];
+	int numData = theDampedSOE != 0 ? 2*numEigen : numEigen;
+	double* data = new double[numData];
 	for (int i=0; i<numEigen; i++) {
 	    data[i] = eigenvalues(i);
+	    if (theDampedSOE != 0)
+		data[numEigen+i] = theDampedSOE->getDampingRatio(i+1);
 	}
-	OPS_SetDoubleOutput(&numEigen, data, false);
+	OPS_SetDoubleOutput(&numData, data, false);
 	delete [] data;
     }
 
     return result;
 }
 
+int
+OpenSeesCommands::eigenAsync(int typeSolver, bool generalizedAlgo, bool findSmallest)
+{
+    if (theTransientAnalysis == 0) {
+	opserr << "WARNING eigen -async - needs a transient analysis\n";
+	return -1;
+    }
+
+    // the analysis owns the EigenSOE of the background solve
+    EigenSOE *theAsyncSOE = theTransientAnalysis->getAsyncEigenSOE();
+    if (theAsyncSOE == 0 || theAsyncSOE->getClassTag() != typeSolver) {
+	if (typeSolver == EigenSOE_TAGS_SymBandEigenSOE) {
+	    SymBandEigenSolver *theEigenSolver = new SymBandEigenSolver();
+	    theAsyncSOE = new SymBandEigenSOE(*theEigenSolver, *theAnalysisModel);
+	} else if (typeSolver == EigenSOE_TAGS_FullGenEigenSOE) {
+	    FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
+	    theAsyncSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
+	} else {
+	    opserr << "WARNING eigen -async - needs the symmBandLapack or fullGenLapack solver\n";
+	    return -1;
+	}
+    }
+
+    return theTransientAnalysis->eigenAsync(numEigen, *theAsyncSOE,
+					    generalizedAlgo, findSmallest);
+}
+
+int
+OpenSeesCommands::eigenWait()
+{
+    if (theTransientAnalysis == 0) {
+	return 0;
+    }
+
+    int result = theTransientAnalysis->eigenWait();
+    if (result < 0) {
+	return result;
+    }
+
+    const Vector &eigenvalues = theDomain->getEigenvalues();
+    int num = eigenvalues.Size();
+    if (num > 0) {
+	double* data = new double[num];
+	for (int i=0; i<num; i++) {
+	    data[i] = eigenvalues(i);
+	}
+	OPS_SetDoubleOutput(&num, data, false);
+	delete [] data;
+    }
+
+    return 0;
+}
+
 int* OPS_GetNumEigen()                                                          
 {                                                                               
     static int numEigen = 0;                                                    
@@ -422,6 +514,13 @@ OpenSeesCommands::setHandler(ConstraintHandler* handler)
 void
 OpenSeesCommands::setCTest(ConvergenceTest* test)
 {
+    // the retryPolicy rung being built takes it
+    if (buildingRung) {
+	if (theRungTest != 0) delete theRungTest;
+	theRungTest = test;
+	return;
+    }
+
     // if not in analysis object, delete old one and set new one
     if (theStaticAnalysis==0 && theTransientAnalysis==0) {
 	if (theTest != 0) {
@@ -523,6 +622,13 @@ void OpenSeesCommands::setIntegrator(Integrator* inte,
 void
 OpenSeesCommands::setAlgorithm(EquiSolnAlgo* algorithm)
 {
+    // the retryPolicy rung being built takes it
+    if (buildingRung) {
+	if (theRungAlgorithm != 0) delete theRungAlgorithm;
+	theRungAlgorithm = algorithm;
+	return;
+    }
+
     // if not in analysis object, delete old one
     if (theStaticAnalysis==0 && theTransientAnalysis==0) {
 	if (theAlgorithm != 0) {
@@ -621,6 +727,8 @@ OpenSeesCommands::setStaticAnalysis(bool suppress)
     if (theEigenSOE != 0) {
 	theStaticAnalysis->setEigenSOE(*theEigenSOE);
     }
+    if (theRetryPolicy != 0)
+	theStaticAnalysis->setRetryPolicy(theRetryPolicy);
 
 #ifdef _PARALLEL_INTERPRETERS
     if (setMPIDSOEFlag) {
@@ -795,6 +903,10 @@ OpenSeesCommands::setVariableAnalysis(bool suppress)
 
     // set the pointer for variable time step analysis
     theTransientAnalysis = theVariableTimeStepTransientAnalysis;
+    if (theCheckpoint != 0)
+	theTransientAnalysis->setCheckpoint(theCheckpoint);
+    if (theRetryPolicy != 0)
+	theTransientAnalysis->setRetryPolicy(theRetryPolicy);
 
     if (theEigenSOE != 0) {
 	theTransientAnalysis->setEigenSOE(*theEigenSOE);
@@ -889,6 +1001,10 @@ OpenSeesCommands::setTransientAnalysis(bool suppress)
 							 *theSOE,
 							 *theTransientIntegrator,
 							 theTest, numSubLevels, numSubSteps);
+    if (theCheckpoint != 0)
+	theTransientAnalysis->setCheckpoint(theCheckpoint);
+    if (theRetryPolicy != 0)
+	theTransientAnalysis->setRetryPolicy(theRetryPolicy);
     if (theEigenSOE != 0) {
 	theTransientAnalysis->setEigenSOE(*theEigenSOE);
     }
@@ -913,6 +1029,12 @@ OpenSeesCommands::wipeAnalysis()
 	if (theTest != 0) delete theTest;
     }
 
+    // an existing analysis deletes the retry policy in clearAll()
+    if (theRetryPolicy != 0 && theStaticAnalysis == 0 && theTransientAnalysis == 0)
+	delete theRetryPolicy;
+    theRetryPolicy = 0;
+    this->discardRetryRung();
+
     if (theStaticAnalysis != 0) {
     	theStaticAnalysis->clearAll();
     	delete theStaticAnalysis;
@@ -949,6 +1071,8 @@ OpenSeesCommands::wipe()
 	theDatabase = 0;
     }
 
+    this->setCheckpoint(0);
+
     // wipe domain
     if (theDomain != 0) {
 	theDomain->clearAll();
@@ -1004,6 +1128,186 @@ OpenSeesCommands::wipe()
 
 }
 
+// the state of a model that is not the current one
+struct OpenSeesCommands::ModelContext
+{
+    ModelContext()
+	:theDomain(0), ndf(0), ndm(0),
+	 theSOE(0), theEigenSOE(0), theNumberer(0), theHandler(0),
+	 theStaticIntegrator(0), theTransientIntegrator(0),
+	 theAlgorithm(0), theStaticAnalysis(0), theTransientAnalysis(0),
+	 thePFEMAnalysis(0), theVariableTimeStepTransientAnalysis(0),
+	 theAnalysisModel(0), theTest(0), numEigen(0), theDatabase(0),
+	 theCheckpoint(0), theRetryPolicy(0), reliability(0), storages(),
+	 dt(0.0), initialStateAnalysis(false), creep(0)
+    {
+	std::vector<MapOfTaggedObjects*>& global =
+	    MapOfTaggedObjects::getModelStorages();
+	for (int i = 0; i < (int)global.size(); ++i) {
+	    storages.push_back(new MapOfTaggedObjects);
+	}
+    }
+
+    ~ModelContext()
+    {
+	for (int i = 0; i < (int)storages.size(); ++i) {
+	    delete storages[i];
+	}
+    }
+
+    Domain* theDomain;
+    int ndf, ndm;
+
+    LinearSOE* theSOE;
+    EigenSOE* theEigenSOE;
+    DOF_Numberer* theNumberer;
+    ConstraintHandler* theHandler;
+    StaticIntegrator *theStaticIntegrator;
+    TransientIntegrator *theTransientIntegrator;
+    EquiSolnAlgo *theAlgorithm;
+    StaticAnalysis* theStaticAnalysis;
+    DirectIntegrationAnalysis* theTransientAnalysis;
+    PFEMAnalysis* thePFEMAnalysis;
+    VariableTimeStepDirectIntegrationAnalysis* theVariableTimeStepTransientAnalysis;
+    AnalysisModel* theAnalysisModel;
+    ConvergenceTest *theTest;
+
+    int numEigen;
+    FE_Datastore* theDatabase;
+    AnalysisCheckpoint* theCheckpoint;
+    StepRetryPolicy* theRetryPolicy;
+    OpenSeesReliabilityCommands* reliability;
+
+    // the modelling objects, in the order of getModelStorages()
+    std::vector<MapOfTaggedObjects*> storages;
+
+    // the globals of the domain being updated
+    double dt;
+    bool initialStateAnalysis;
+    int creep;
+};
+
+void
+OpenSeesCommands::swapModelContext(ModelContext& other)
+{
+    std::swap(theDomain, other.theDomain);
+    std::swap(ndf, other.ndf);
+    std::swap(ndm, other.ndm);
+
+    std::swap(theSOE, other.theSOE);
+    std::swap(theEigenSOE, other.theEigenSOE);
+    std::swap(theNumberer, other.theNumberer);
+    std::swap(theHandler, other.theHandler);
+    std::swap(theStaticIntegrator, other.theStaticIntegrator);
+    std::swap(theTransientIntegrator, other.theTransientIntegrator);
+    std::swap(theAlgorithm, other.theAlgorithm);
+    std::swap(theStaticAnalysis, other.theStaticAnalysis);
+    std::swap(theTransientAnalysis, other.theTransientAnalysis);
+    std::swap(thePFEMAnalysis, other.thePFEMAnalysis);
+    std::swap(theVariableTimeStepTransientAnalysis,
+	      other.theVariableTimeStepTransientAnalysis);
+    std::swap(theAnalysisModel, other.theAnalysisModel);
+    std::swap(theTest, other.theTest);
+
+    std::swap(numEigen, other.numEigen);
+    std::swap(theDatabase, other.theDatabase);
+    std::swap(theCheckpoint, other.theCheckpoint);
+    std::swap(theRetryPolicy, other.theRetryPolicy);
+    std::swap(reliability, other.reliability);
+
+    // the map contents are exchanged, no object is copied
+    std::vector<MapOfTaggedObjects*>& global =
+	MapOfTaggedObjects::getModelStorages();
+    for (int i = 0; i < (int)global.size(); ++i) {
+	global[i]->swap(*other.storages[i]);
+    }
+
+    std::swap(ops_Dt, other.dt);
+    std::swap(ops_InitialStateAnalysis, other.initialStateAnalysis);
+    std::swap(ops_Creep, other.creep);
+    ops_TheActiveDomain = theDomain;
+
+    if (reliability != 0) {
+	reliability->setActive();
+    }
+}
+
+int
+OpenSeesCommands::newModelContext()
+{
+    ModelContext* context = new ModelContext;
+    context->theDomain = new Domain;
+    context->reliability = new OpenSeesReliabilityCommands(context->theDomain);
+
+    // the constructor above made the new one active
+    if (reliability != 0) {
+	reliability->setActive();
+    }
+
+    int handle = nextContext++;
+    otherContexts[handle] = context;
+
+    return handle;
+}
+
+int
+OpenSeesCommands::setModelContext(int handle)
+{
+    if (handle == currentContext) {
+	return 0;
+    }
+
+    std::map<int, ModelContext*>::iterator it = otherContexts.find(handle);
+    if (it == otherContexts.end()) {
+	opserr << "WARNING model context " << handle << " does not exist\n";
+	return -1;
+    }
+
+    // the context object now keeps the model being left
+    ModelContext* context = it->second;
+    this->swapModelContext(*context);
+    otherContexts.erase(it);
+    otherContexts[currentContext] = context;
+    currentContext = handle;
+
+    return 0;
+}
+
+int
+OpenSeesCommands::removeModelContext(int handle)
+{
+    if (handle == currentContext) {
+	opserr << "WARNING can not remove the current model context " << handle << "\n";
+	return -1;
+    }
+
+    std::map<int, ModelContext*>::iterator it = otherContexts.find(handle);
+    if (it == otherContexts.end()) {
+	opserr << "WARNING model context " << handle << " does not exist\n";
+	return -1;
+    }
+
+    // bring the model in to destroy its analysis and domain, but not
+    // with wipe(), which also clears the background mesh all share
+    ModelContext* context = it->second;
+    this->swapModelContext(*context);
+    this->wipeAnalysis();
+    if (theDatabase != 0) delete theDatabase;
+    theDatabase = 0;
+    this->setCheckpoint(0);
+    if (reliability != 0) delete reliability;
+    if (theDomain != 0) delete theDomain;
+    reliability = 0;
+    theDomain = 0;
+    this->swapModelContext(*context);
+
+    // the context storages destroy its modelling objects
+    otherContexts.erase(it);
+    delete context;
+
+    return 0;
+}
+
 void
 OpenSeesCommands::setFileDatabase(const char* filename)
 {
@@ -1014,6 +1318,73 @@ OpenSeesCommands::setFileDatabase(const char* filename)
     }
 }
 
+void
+OpenSeesCommands::setMemoryDatabase(void)
+{
+    if (theDatabase != 0) delete theDatabase;
+    theDatabase = new MemoryDatastore(*theDomain, theBroker);
+}
+
+void
+OpenSeesCommands::setCheckpoint(AnalysisCheckpoint* checkpoint)
+{
+    if (theCheckpoint != 0) {
+	if (theTransientAnalysis != 0)
+	    theTransientAnalysis->setCheckpoint(0);
+	delete theCheckpoint;
+    }
+
+    theCheckpoint = checkpoint;
+    if (theCheckpoint != 0 && theTransientAnalysis != 0)
+	theTransientAnalysis->setCheckpoint(theCheckpoint);
+}
+
+void
+OpenSeesCommands::setRetryRung(bool building)
+{
+    buildingRung = building;
+}
+
+void
+OpenSeesCommands::discardRetryRung()
+{
+    if (theRungAlgorithm != 0) delete theRungAlgorithm;
+    if (theRungTest != 0) delete theRungTest;
+    theRungAlgorithm = 0;
+    theRungTest = 0;
+    buildingRung = false;
+}
+
+int
+OpenSeesCommands::addRetryRung(int numSubSteps)
+{
+    if (theRetryPolicy == 0) {
+	theRetryPolicy = new StepRetryPolicy();
+	if (theStaticAnalysis != 0)
+	    theStaticAnalysis->setRetryPolicy(theRetryPolicy);
+	else if (theTransientAnalysis != 0)
+	    theTransientAnalysis->setRetryPolicy(theRetryPolicy);
+    }
+
+    // the policy owns the rung objects from now on
+    if (theRetryPolicy->addRung(theRungAlgorithm, theRungTest, numSubSteps) < 0) {
+	this->discardRetryRung();
+	return -1;
+    }
+    theRungAlgorithm = 0;
+    theRungTest = 0;
+    buildingRung = false;
+
+    return 0;
+}
+
+void
+OpenSeesCommands::setCheckpointDatabase(const char* filename)
+{
+    if (theDatabase != 0) delete theDatabase;
+    theDatabase = new CheckpointDatastore(filename, *theDomain, theBroker);
+}
+
 /////////////////////////////
 //// OpenSees APIs  /// /////
 /////////////////////////////
@@ -1109,6 +1480,13 @@ int OPS_SetDoubleDictListOutput(std::map<const char*, std::vector<double>>& data
     return interp->setDouble(data);
 }
 
+int OPS_SetDoubleArrayOutput(int numRows, int numCols, double* data)
+{
+    if (cmds == 0) return 0;
+    DL_Interpreter* interp = cmds->getInterpreter();
+    return interp->setDoubleArray(data, numRows, numCols);
+}
+
 
 
 const char * OPS_GetString(void)
@@ -1298,6 +1676,57 @@ int OPS_wipeAnalysis()
     return 0;
 }
 
+int OPS_modelContext()
+{
+    // modelContext 'new'
+    // modelContext 'set' handle
+    // modelContext 'remove' handle
+    // modelContext 'current'
+    if (cmds == 0) return 0;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING want - modelContext 'new' or 'set', 'remove' handle or 'current'\n";
+	return -1;
+    }
+
+    const char* opt = OPS_GetString();
+    int numdata = 1;
+    int handle = 0;
+
+    if (strcmp(opt, "new") == 0) {
+	handle = cmds->newModelContext();
+
+    } else if (strcmp(opt, "set") == 0 || strcmp(opt, "remove") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 1) {
+	    opserr << "WARNING want - modelContext " << opt << " handle\n";
+	    return -1;
+	}
+	if (OPS_GetIntInput(&numdata, &handle) < 0) {
+	    opserr << "WARNING modelContext - failed to read handle\n";
+	    return -1;
+	}
+	int res = (strcmp(opt, "set") == 0) ?
+	    cmds->setModelContext(handle) : cmds->removeModelContext(handle);
+	if (res < 0) {
+	    return -1;
+	}
+
+    } else if (strcmp(opt, "current") == 0) {
+	handle = cmds->getModelContext();
+
+    } else {
+	opserr << "WARNING modelContext - unknown option " << opt << "\n";
+	return -1;
+    }
+
+    if (OPS_SetIntOutput(&numdata, &handle, true) < 0) {
+	opserr << "WARNING modelContext - failed to set output\n";
+	return -1;
+    }
+
+    return 0;
+}
+
 int OPS_model()
 {
     // num args
@@ -1454,6 +1883,21 @@ int OPS_System()
 	theSOE = (LinearSOE*)OPS_SuperLUSolver();
 
 
+    } else if (strcmp(type,"SupernodalSPD") == 0) {
+	theSOE = (LinearSOE*)OPS_SparseSPDLinSolver();
+
+    } else if (strcmp(type,"Krylov") == 0) {
+	theSOE = (LinearSOE*)OPS_SparseKrylovSolver();
+
+    } else if (strcmp(type,"MatrixFree") == 0) {
+	theSOE = (LinearSOE*)OPS_MatrixFreeLinSolver();
+
+    } else if (strcmp(type,"BlockSparse") == 0) {
+	theSOE = (LinearSOE*)OPS_BlockSparseLinSolver();
+
+    } else if (strcmp(type,"Auto") == 0) {
+	theSOE = (LinearSOE*)OPS_AutoLinearSOE();
+
     } else if ((strcmp(type,"SparseSPD") == 0) || (strcmp(type,"SparseSYM") == 0)) {
 	// now must determine the type of solver to create from rest of args
 	theSOE = (LinearSOE*)OPS_SymSparseLinSolver();
@@ -1462,6 +1906,11 @@ int OPS_System()
 
 	theSOE = (LinearSOE*)OPS_UmfpackGenLinSolver();
 
+#ifdef _CUDSS
+    } else if (strcmp(type,"CuDSS") == 0) {
+	theSOE = (LinearSOE*)OPS_CuDSSSolver();
+#endif
+
     } else if (strcmp(type,"FullGeneral") == 0) {
 	// now must determine the type of solver to create from rest of args
 	theSOE = (LinearSOE*)OPS_FullGenLinLapackSolver();
@@ -1485,6 +1934,24 @@ int OPS_System()
     return 0;
 }
 
+// numberer type ... <-warmStart tol>
+static int OPS_NumbererOptions(GraphNumberer *theGN)
+{
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "-warmStart") == 0) {
+	    double tol;
+	    int numdata = 1;
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numdata, &tol) < 0) {
+		opserr << "WARNING numberer -warmStart: invalid tol\n";
+		return -1;
+	    }
+	    theGN->setWarmStart(tol);
+	}
+    }
+    return 0;
+}
+
 int OPS_Numberer()
 {
     if (OPS_GetNumRemainingInputArgs() < 1) {
@@ -1503,12 +1970,24 @@ int OPS_Numberer()
     } else if (strcmp(type,"RCM") == 0) {
 
     	RCM *theRCM = new RCM(false);
+    	if (OPS_NumbererOptions(theRCM) < 0) {
+    	    delete theRCM;
+    	    return -1;
+    	}
     	theNumberer = new DOF_Numberer(*theRCM);
 
     } else if (strcmp(type,"AMD") == 0) {
 
         AMD *theAMD = new AMD();
+        if (OPS_NumbererOptions(theAMD) < 0) {
+            delete theAMD;
+            return -1;
+        }
         theNumberer = new DOF_Numberer(*theAMD);
+    } else if (strcmp(type,"ND") == 0 || strcmp(type,"NestedDissection") == 0) {
+
+        NestedDissection *theND = new NestedDissection();
+        theNumberer = new DOF_Numberer(*theND);
     } else if (strcmp(type, "ParallelPlain") == 0) {
 
         theNumberer = (DOF_Numberer*)OPS_ParallelNumberer();
@@ -1673,6 +2152,9 @@ int OPS_Integrator()
     } else if (strcmp(type,"Newmark") == 0) {
 	ti = (TransientIntegrator*)OPS_Newmark();
 
+    } else if (strcmp(type,"ImplicitExplicit") == 0) {
+	ti = (TransientIntegrator*)OPS_ImplicitExplicit();
+
     } else if (strcmp(type,"GimmeMCK") == 0 || strcmp(type,"ZZTop") == 0) {
 	ti = (TransientIntegrator*)OPS_GimmeMCK();
 
@@ -1852,6 +2334,9 @@ int OPS_Algorithm()
     } else if (strcmp(type, "ExpressNewton") == 0) {
 	theAlgo = (EquiSolnAlgo*) OPS_ExpressNewton();	
 
+    } else if (strcmp(type, "AdaptiveNewton") == 0) {
+	theAlgo = (EquiSolnAlgo*) OPS_AdaptiveNewton();
+
     } else if (strcmp(type, "Broyden") == 0) {
 	theAlgo = (EquiSolnAlgo*)OPS_Broyden();
 
@@ -1922,6 +2407,69 @@ int OPS_Analysis() {
   return 0;
 }
 
+// retryPolicy('add', <'-subSteps', n>) adds a rung with the algorithm and
+// test read by OPS_RetryRung() before; retryPolicy('clear') empties it
+int OPS_RetryPolicy()
+{
+    if (cmds == 0) return 0;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING want - retryPolicy add <-subSteps n> <-algorithm [type args]> <-test [type args]>\n";
+	opserr << "          or - retryPolicy clear\n";
+	cmds->discardRetryRung();
+	return -1;
+    }
+
+    const char* opt = OPS_GetString();
+    if (strcmp(opt, "clear") == 0) {
+	cmds->discardRetryRung();
+	if (cmds->getRetryPolicy() != 0)
+	    cmds->getRetryPolicy()->clear();
+	return 0;
+    }
+
+    if (strcmp(opt, "add") != 0) {
+	opserr << "WARNING retryPolicy - unknown option " << opt << ", want add or clear\n";
+	cmds->discardRetryRung();
+	return -1;
+    }
+
+    int numSubSteps = 1;
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	opt = OPS_GetString();
+	if (strcmp(opt, "-subSteps") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    if (OPS_GetIntInput(&numData, &numSubSteps) < 0 || numSubSteps < 1) {
+		opserr << "WARNING retryPolicy add - invalid number of subSteps\n";
+		cmds->discardRetryRung();
+		return -1;
+	    }
+	} else {
+	    opserr << "WARNING retryPolicy add - unknown option " << opt << "\n";
+	    cmds->discardRetryRung();
+	    return -1;
+	}
+    }
+
+    return cmds->addRetryRung(numSubSteps);
+}
+
+// the command line is an algorithm or test command for the rung that
+// the next retryPolicy('add', ...) adds
+int OPS_RetryRung(bool algorithm)
+{
+    if (cmds == 0) return 0;
+
+    cmds->setRetryRung(true);
+    int res = algorithm ? OPS_Algorithm() : OPS_CTest();
+    cmds->setRetryRung(false);
+
+    if (res < 0)
+	cmds->discardRetryRung();
+
+    return res;
+}
+
 int OPS_analyze() {
   if (cmds == 0) return 0;
 
@@ -1985,15 +2533,36 @@ int OPS_analyze() {
 
     if (OPS_GetNumRemainingInputArgs() == 0) {
       result = theTransientAnalysis->analyze(numIncr, dt, true);
-    } else if (OPS_GetNumRemainingInputArgs() == 1) {
+    } else if (OPS_GetNumRemainingInputArgs() <= 2) {
       bool flush = true;
-      if (OPS_GetNumRemainingInputArgs() > 0) {
+      bool resume = false;
+      while (OPS_GetNumRemainingInputArgs() > 0) {
         const char* opt = OPS_GetString();
         if (strcmp(opt, "-noFlush") == 0) {
             flush = false;
+        } else if (strcmp(opt, "-resume") == 0) {
+            resume = true;
+        } else {
+            opserr << "WARNING insufficient args for variable transient "
+                      "need: dtMin dtMax Jd \n";
+            return -1;
+        }
+      }
+
+      // pick up from the latest checkpoint the steps it already covers
+      if (resume) {
+        AnalysisCheckpoint* theCheckpoint = cmds->getCheckpoint();
+        if (theCheckpoint == 0) {
+          opserr << "WARNING analyze -resume - no checkpoint has been specified\n";
+          return -1;
         }
+        int numDone = theCheckpoint->resume(dt);
+        if (numDone < 0)
+          return -1;
+        numIncr -= numDone;
       }
-      result = theTransientAnalysis->analyze(numIncr, dt, flush);
+      if (numIncr > 0)
+        result = theTransientAnalysis->analyze(numIncr, dt, flush);
 
     } else if (OPS_GetNumRemainingInputArgs() < 3) {
       opserr << "WARNING insufficient args for variable transient "
@@ -2018,10 +2587,17 @@ int OPS_analyze() {
         return -1;
       }
       bool flush = true;
-      if (OPS_GetNumRemainingInputArgs() > 0) {
+      double errorTol = 0.0;
+      while (OPS_GetNumRemainingInputArgs() > 0) {
         const char* opt = OPS_GetString();
         if (strcmp(opt, "-noFlush") == 0) {
             flush = false;
+        } else if (strcmp(opt, "-errorTol") == 0 &&
+                   OPS_GetNumRemainingInputArgs() > 0) {
+            if (OPS_GetDoubleInput(&numdata, &errorTol) < 0) {
+                opserr << "WARNING: invalid errorTol\n";
+                return -1;
+            }
         }
       }
       // Included getVariableAnalysis here as dont need it except
@@ -2029,6 +2605,7 @@ int OPS_analyze() {
       VariableTimeStepDirectIntegrationAnalysis*
           theVariableTimeStepTransientAnalysis =
               cmds->getVariableAnalysis();
+      theVariableTimeStepTransientAnalysis->setErrorTolerance(errorTol);
       result = theVariableTimeStepTransientAnalysis->analyze(
           numIncr, dt, dtMin, dtMax, Jd, flush);
     }
@@ -2051,6 +2628,59 @@ int OPS_analyze() {
   return 0;
 }
 
+// analyzes numIncr steps in groups of every steps without returning to
+// the interpreter in between, the callback is called after each group;
+// dt is ignored by static analyses
+int OPS_analyzeSteps(int numIncr, double dt, int every,
+                     OPS_StepCallback callback, void *data) {
+  if (cmds == 0) return 0;
+
+  StaticAnalysis* theStaticAnalysis = cmds->getStaticAnalysis();
+  TransientAnalysis* theTransientAnalysis =
+      cmds->getTransientAnalysis();
+  PFEMAnalysis* thePFEMAnalysis = cmds->getPFEMAnalysis();
+
+  if (theStaticAnalysis == 0 && theTransientAnalysis == 0 &&
+      thePFEMAnalysis == 0) {
+    opserr << "WARNING No Analysis type has been specified \n";
+    return -1;
+  }
+
+  if (every < 1) every = 1;
+
+  int result = 0;
+  int step = 0;
+  while (step < numIncr) {
+    int num = numIncr - step;
+    if (num > every) num = every;
+
+    if (theStaticAnalysis != 0) {
+      result = theStaticAnalysis->analyze(num, true);
+    } else if (thePFEMAnalysis != 0) {
+      for (int i = 0; i < num && result >= 0; i++)
+        result = thePFEMAnalysis->analyze(true);
+    } else {
+      ops_Dt = dt;
+      result = theTransientAnalysis->analyze(num, dt, true);
+    }
+
+    if (result < 0) {
+      opserr << "OpenSees > analyze failed, returned: " << result
+             << " error flag\n";
+      return result;
+    }
+    step += num;
+
+    if (callback != 0) {
+      int res = callback(step, dt, data);
+      if (res < 0) return -1;
+      if (res > 0) break;
+    }
+  }
+
+  return result;
+}
+
 int OPS_eigenAnalysis()
 {
     static bool warning_displayed = false;
@@ -2061,11 +2691,26 @@ int OPS_eigenAnalysis()
 	return -1;
     }
 
+    // eigen -wait returns the eigenvalues of the last eigen -async
+    if (OPS_GetNumRemainingInputArgs() == 1) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "-wait") == 0) {
+	    if (cmds->eigenWait() < 0) {
+		opserr<<"WANRING failed to do eigen analysis\n";
+		return -1;
+	    }
+	    return 0;
+	}
+	OPS_ResetCurrentInputArg(-1);
+    }
+
     // 0 - frequency/generalized (default),1 - standard, 2 - buckling
     bool generalizedAlgo = true;
 
 
     int typeSolver = EigenSOE_TAGS_ArpackSOE;
+    bool solverGiven = false;
+    bool async = false;
     double shift = 0.0;
     bool findSmallest = true;
 
@@ -2087,17 +2732,24 @@ int OPS_eigenAnalysis()
 	else if ((strcmp(type,"-findLargest") == 0))
 	    findSmallest = false;
 
+	else if ((strcmp(type,"-async") == 0))
+	    async = true;
+
 	else if ((strcmp(type,"genBandArpack") == 0) ||
 		 (strcmp(type,"-genBandArpack") == 0) ||
 		 (strcmp(type,"genBandArpackEigen") == 0) ||
-		 (strcmp(type,"-genBandArpackEigen") == 0))
+		 (strcmp(type,"-genBandArpackEigen") == 0)) {
 	    typeSolver = EigenSOE_TAGS_ArpackSOE;
+	    solverGiven = true;
+	}
 
 	else if ((strcmp(type,"symmBandLapack") == 0) ||
 		 (strcmp(type,"-symmBandLapack") == 0) ||
 		 (strcmp(type,"symmBandLapackEigen") == 0) ||
-		 (strcmp(type,"-symmBandLapackEigen") == 0))
+		 (strcmp(type,"-symmBandLapackEigen") == 0)) {
 	    typeSolver = EigenSOE_TAGS_SymBandEigenSOE;
+	    solverGiven = true;
+	}
 
     else if ((strcmp(type, "fullGenLapack") == 0) ||
                 (strcmp(type, "-fullGenLapack") == 0) ||
@@ -2108,8 +2760,15 @@ int OPS_eigenAnalysis()
             warning_displayed = true;
 		}
         typeSolver = EigenSOE_TAGS_FullGenEigenSOE;
+        solverGiven = true;
     }
 
+	else if ((strcmp(type,"dampedArpack") == 0) ||
+		 (strcmp(type,"-dampedArpack") == 0)) {
+	    typeSolver = EigenSOE_TAGS_DampedArpackSOE;
+	    solverGiven = true;
+	}
+
     else {
         opserr << "eigen - unknown option specified " << type
                 << endln;
@@ -2130,6 +2789,18 @@ int OPS_eigenAnalysis()
     }
     cmds->setNumEigen(numEigen);
 
+    // the background solve needs an EigenSOE that holds its own K and M
+    if (async) {
+	if (solverGiven == false)
+	    typeSolver = generalizedAlgo ? EigenSOE_TAGS_FullGenEigenSOE :
+		EigenSOE_TAGS_SymBandEigenSOE;
+	if (cmds->eigenAsync(typeSolver,generalizedAlgo,findSmallest) < 0) {
+	    opserr<<"WANRING failed to start eigen analysis\n";
+	    return -1;
+	}
+	return 0;
+    }
+
     // set eigen soe
     if (cmds->eigen(typeSolver,shift,generalizedAlgo,findSmallest) < 0) {
 	opserr<<"WANRING failed to do eigen analysis\n";
@@ -2805,13 +3476,17 @@ void* OPS_NewtonLineSearch()
     double minEta     = 0.1;
     int    pFlag      = 1;
     int    typeSearch = 0;
+    bool   reduced    = false;
 
     int numdata = 1;
 
     while (OPS_GetNumRemainingInputArgs() > 0) {
 	const char* flag = OPS_GetString();
 
-	if (strcmp(flag, "-tol") == 0 && OPS_GetNumRemainingInputArgs()>0) {
+	if (strcmp(flag, "-reduced") == 0) {
+	    reduced = true;
+
+	} else if (strcmp(flag, "-tol") == 0 && OPS_GetNumRemainingInputArgs()>0) {
 
 	    if (OPS_GetDoubleInput(&numdata, &tol) < 0) {
 		opserr << "WARNING NewtonLineSearch failed to read tol\n";
@@ -2873,7 +3548,7 @@ void* OPS_NewtonLineSearch()
     else if (typeSearch == 3)
 	theLineSearch = new RegulaFalsiLineSearch(tol, maxIter, minEta, maxEta, pFlag);
 
-    return new NewtonLineSearch(*theTest, theLineSearch);
+    return new NewtonLineSearch(*theTest, theLineSearch, reduced);
 }
 
 int OPS_getCTestNorms()
@@ -2928,7 +3603,7 @@ int OPS_Database()
     if (cmds == 0) return 0;
     // make sure at least one other argument to contain integrator
     if (OPS_GetNumRemainingInputArgs() < 1) {
-	opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+	opserr << "WARNING need to specify a Database type; valid type File, Memory, Checkpoint, MySQL, BerkeleyDB \n";
 	return -1;
     }
 
@@ -2948,14 +3623,85 @@ int OPS_Database()
 	const char* filename = OPS_GetString();
 	cmds->setFileDatabase(filename);
 
+	return 0;
+    } else if (strcmp(type,"Memory") == 0) {
+	cmds->setMemoryDatabase();
+	return 0;
+    } else if (strcmp(type,"Checkpoint") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 1) {
+	    opserr << "WARNING database Checkpoint fileName? ";
+	    return -1;
+	}
+
+	const char* filename = OPS_GetString();
+	cmds->setCheckpointDatabase(filename);
+
 	return 0;
     }
     opserr << "WARNING No database type exists ";
-    opserr << "for database of type:" << type << "valid database type File\n";
+    opserr << "for database of type:" << type << "valid database type File, Memory, Checkpoint\n";
 
     return -1;
 }
 
+// saves the domain as a transient analysis goes:
+//   checkpoint fileName <-steps n> <-minutes m> <-async>
+//   checkpoint off
+int OPS_checkpoint()
+{
+    if (cmds == 0) return 0;
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING want - checkpoint fileName <-steps n> <-minutes m> <-async>\n";
+	opserr << "          or - checkpoint off\n";
+	return -1;
+    }
+
+    const char* filename = OPS_GetString();
+    cmds->setCheckpoint(0);
+    if (strcmp(filename, "off") == 0)
+	return 0;
+
+    int everySteps = 0;
+    double everyMinutes = 0.0;
+    bool async = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	int numdata = 1;
+	if (strcmp(opt, "-steps") == 0) {
+	    if (OPS_GetIntInput(&numdata, &everySteps) < 0) {
+		opserr << "WARNING checkpoint - invalid -steps\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-minutes") == 0) {
+	    if (OPS_GetDoubleInput(&numdata, &everyMinutes) < 0) {
+		opserr << "WARNING checkpoint - invalid -minutes\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-async") == 0) {
+	    async = true;
+	} else {
+	    opserr << "WARNING checkpoint - unknown option " << opt << "\n";
+	    return -1;
+	}
+    }
+
+    if (everySteps <= 0 && everyMinutes <= 0.0) {
+	opserr << "WARNING checkpoint - need -steps n and/or -minutes m\n";
+	return -1;
+    }
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    CheckpointDatastore* theDatastore =
+	new CheckpointDatastore(filename, *theDomain, cmds->getBroker());
+    theDatastore->setAsync(async);
+    cmds->setCheckpoint(new AnalysisCheckpoint(*theDomain, theDatastore,
+					       everySteps, everyMinutes));
+
+    return 0;
+}
+
 int OPS_save()
 {
     if (cmds == 0) return 0;
@@ -3037,6 +3783,173 @@ int OPS_stopTimer()
     return 0;
 }
 
+// profile on <-classes>|off|reset, or profile <-json> <-file fileName>:
+// prints the times of the analysis phases, and of the element and
+// material classes with -classes, as a table or returns them as JSON
+int OPS_profile()
+{
+    bool json = false;
+    const char* filename = 0;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "on") == 0 || strcmp(opt, "start") == 0) {
+	    bool classes = false;
+	    if (OPS_GetNumRemainingInputArgs() > 0) {
+		const char* flag = OPS_GetString();
+		if (strcmp(flag, "-classes") == 0)
+		    classes = true;
+		else
+		    OPS_ResetCurrentInputArg(-1);
+	    }
+	    AnalysisProfiler::enableClasses(classes);
+	    AnalysisProfiler::enable(true);
+	    return 0;
+	} else if (strcmp(opt, "off") == 0 || strcmp(opt, "stop") == 0) {
+	    AnalysisProfiler::enable(false);
+	    return 0;
+	} else if (strcmp(opt, "reset") == 0) {
+	    AnalysisProfiler::reset();
+	    return 0;
+	} else if (strcmp(opt, "-json") == 0) {
+	    json = true;
+	} else if (strcmp(opt, "-file") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    filename = OPS_GetString();
+	} else {
+	    opserr << "WARNING profile on <-classes>|off|reset or profile <-json> <-file fileName>\n";
+	    return -1;
+	}
+    }
+
+    if (filename != 0) {
+	FileStream outputFile;
+	if (outputFile.setFile(filename) != 0) {
+	    opserr << "profile -file fileName - failed to open file: " << filename << endln;
+	    return -1;
+	}
+	AnalysisProfiler::Print(outputFile, json);
+	return 0;
+    }
+
+    if (json) {
+	std::string result = AnalysisProfiler::getJSON();
+	if (OPS_SetString(result.c_str()) < 0) {
+	    opserr << "WARNING profile - failed to set output\n";
+	    return -1;
+	}
+	return 0;
+    }
+
+    AnalysisProfiler::Print(opserr);
+    return 0;
+}
+
+int OPS_metrics()
+{
+    // metrics -file fileName <-interval seconds> <-label run>
+    // metrics -write
+    // metrics -stop
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING metrics -file fileName <-interval seconds> <-label run>|-write|-stop\n";
+	return -1;
+    }
+
+    const char* filename = 0;
+    const char* label = 0;
+    double interval = 10.0;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "-stop") == 0) {
+	    AnalysisMetrics::stop();
+	    return 0;
+	} else if (strcmp(opt, "-write") == 0) {
+	    return AnalysisMetrics::write();
+	} else if (strcmp(opt, "-file") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    filename = OPS_GetString();
+	} else if (strcmp(opt, "-label") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    label = OPS_GetString();
+	} else if (strcmp(opt, "-interval") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    int numdata = 1;
+	    if (OPS_GetDoubleInput(&numdata, &interval) < 0) {
+		opserr << "WARNING metrics - failed to read interval\n";
+		return -1;
+	    }
+	} else {
+	    opserr << "WARNING metrics -file fileName <-interval seconds> <-label run>|-write|-stop\n";
+	    return -1;
+	}
+    }
+
+    if (filename == 0) {
+	opserr << "WARNING metrics - need -file fileName\n";
+	return -1;
+    }
+
+    // the file is there from the start, before the first step is done
+    if (AnalysisMetrics::start(filename, interval, label) < 0)
+	return -1;
+    return AnalysisMetrics::write();
+}
+
+int OPS_memoryReport()
+{
+    bool json = false;
+    const char* filename = 0;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "-json") == 0) {
+	    json = true;
+	} else if (strcmp(opt, "-file") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    filename = OPS_GetString();
+	} else {
+	    opserr << "WARNING memoryReport <-json> <-file fileName>\n";
+	    return -1;
+	}
+    }
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return 0;
+
+    AnalysisModel* theModel = 0;
+    LinearSOE* theSOE = 0;
+    if (cmds != 0) {
+	AnalysisModel** theModelPtr = cmds->getAnalysisModel();
+	if (theModelPtr != 0)
+	    theModel = *theModelPtr;
+	theSOE = cmds->getSOE();
+    }
+
+    MemoryReport theReport;
+    if (theReport.compute(*theDomain, theModel, theSOE) < 0) {
+	opserr << "WARNING memoryReport - failed to walk the model\n";
+	return -1;
+    }
+
+    if (filename != 0) {
+	FileStream outputFile;
+	if (outputFile.setFile(filename) != 0) {
+	    opserr << "memoryReport -file fileName - failed to open file: " << filename << endln;
+	    return -1;
+	}
+	theReport.Print(outputFile, json);
+	return 0;
+    }
+
+    if (json) {
+	std::string result = theReport.getJSON();
+	if (OPS_SetString(result.c_str()) < 0) {
+	    opserr << "WARNING memoryReport - failed to set output\n";
+	    return -1;
+	}
+	return 0;
+    }
+
+    theReport.Print(opserr);
+    return 0;
+}
+
 int OPS_modalDamping()
 {
     if (cmds == 0) return 0;
@@ -3519,6 +4432,124 @@ int OPS_systemSize()
     return 0;
 }
 
+// influenceMatrix node1 dof1 <node2 dof2 ...> <-resp nodeA dofA ...>
+// returns the displacements of the response DOFs (by default the loaded
+// ones) due to a unit load at each loaded DOF, with the tangent last
+// formed in the system, one row per response DOF; the unit loads are
+// solved for together, a constrained DOF gives zeros
+int OPS_influenceMatrix()
+{
+    if (cmds == 0) return 0;
+    LinearSOE* theSOE = cmds->getSOE();
+    Domain* theDomain = cmds->getDomain();
+    if (theSOE == 0 || theDomain == 0) {
+	opserr << "WARNING no system is set\n";
+	return -1;
+    }
+
+    std::vector<int> loadEqn, respEqn;
+    std::vector<int> *eqns = &loadEqn;
+    int numdata = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (opt != 0 && strcmp(opt, "-resp") == 0) {
+	    eqns = &respEqn;
+	    continue;
+	}
+	OPS_ResetCurrentInputArg(-1);
+
+	int data[2];
+	numdata = 2;
+	if (OPS_GetNumRemainingInputArgs() < 2 || OPS_GetIntInput(&numdata, data) < 0) {
+	    opserr << "WARNING influenceMatrix - want node dof pairs\n";
+	    return -1;
+	}
+
+	Node *theNode = theDomain->getNode(data[0]);
+	if (theNode == 0) {
+	    opserr << "WARNING influenceMatrix - node " << data[0] << " not found\n";
+	    return -1;
+	}
+	DOF_Group *theDOFs = theNode->getDOF_GroupPtr();
+	if (theDOFs == 0 || data[1] < 1 || data[1] > theNode->getNumberDOF()) {
+	    opserr << "WARNING influenceMatrix - node " << data[0] << " has no dof " << data[1];
+	    opserr << " in the analysis\n";
+	    return -1;
+	}
+	eqns->push_back(theDOFs->getID()(data[1]-1));
+    }
+
+    if (loadEqn.empty() == true) {
+	opserr << "WARNING want - influenceMatrix node1 dof1 <node2 dof2 ...> <-resp nodeA dofA ...>\n";
+	return -1;
+    }
+    if (respEqn.empty() == true)
+	respEqn = loadEqn;
+
+    int numEqn = theSOE->getNumEqn();
+    int numLoad = (int)loadEqn.size();
+    int numResp = (int)respEqn.size();
+
+    Matrix B(numEqn, numLoad);
+    for (int j = 0; j < numLoad; j++)
+	if (loadEqn[j] >= 0 && loadEqn[j] < numEqn)
+	    B(loadEqn[j], j) = 1.0;
+
+    Matrix X(numEqn, numLoad);
+    if (numEqn > 0 && theSOE->solveMultiple(B, X) < 0) {
+	opserr << "WARNING influenceMatrix - the system failed to solve\n";
+	return -1;
+    }
+
+    std::vector<double> values(numResp*numLoad, 0.0);
+    for (int i = 0; i < numResp; i++)
+	if (respEqn[i] >= 0 && respEqn[i] < numEqn)
+	    for (int j = 0; j < numLoad; j++)
+		values[i*numLoad+j] = X(respEqn[i], j);
+
+    numdata = numResp*numLoad;
+    if (OPS_SetDoubleOutput(&numdata, &values[0], false) < 0) {
+	opserr << "WARNING failed to set output\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+// numFactorizations <-reset>
+// returns the number of symbolic and numeric factorizations done by the solver
+int OPS_numFactorizations()
+{
+    if (cmds == 0) return 0;
+    LinearSOE* theSOE = cmds->getSOE();
+    if (theSOE == 0) {
+	opserr << "WARNING no system is set\n";
+	return -1;
+    }
+    LinearSOESolver* theSolver = theSOE->getSolver();
+    if (theSolver == 0) {
+	opserr << "WARNING no solver is set\n";
+	return -1;
+    }
+
+    int value[2];
+    value[0] = theSolver->getNumSymbolicFactor();
+    value[1] = theSolver->getNumNumericFactor();
+    int numdata = 2;
+    if (OPS_SetIntOutput(&numdata, value, false) < 0) {
+	opserr << "WARNING failed to set output\n";
+	return -1;
+    }
+
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* opt = OPS_GetString();
+	if (strcmp(opt, "-reset") == 0)
+	    theSolver->resetFactorCounts();
+    }
+
+    return 0;
+}
+
 int OPS_domainCommitTag() {
     if (cmds == 0) {
         return 0;
@@ -3650,10 +4681,17 @@ void* OPS_MumpsSolver() {
     int icntl14 = 20;
     int icntl7 = 7;
     int matType = 0; // 0: unsymmetric, 1: symmetric positive definite, 2: symmetric general
-    while (OPS_GetNumRemainingInputArgs() > 2) {
+    int numThreads = 0;
+#ifdef _MUMPS
+    std::string oocDir;
+    bool ooc = false;
+#endif
+    while (OPS_GetNumRemainingInputArgs() > 0) {
         const char* opt = OPS_GetString();
         int num = 1;
-        if (strcmp(opt, "-ICNTL14") == 0) {
+        if (opt == 0) {
+            continue;
+        } else if (strcmp(opt, "-ICNTL14") == 0) {
             if (OPS_GetIntInput(&num, &icntl14) < 0) {
                 opserr << "WARNING: failed to get icntl14\n";
                 return 0;
@@ -3672,6 +4710,25 @@ void* OPS_MumpsSolver() {
                 opserr << "Mumps Warning: wrong -matrixType value (" << matType << "). Unsymmetric matrix assumed\n";
                 matType = 0;
             }
+#ifdef _MUMPS
+        } else if (strcmp(opt, "-ooc") == 0) {
+            // directory of the out-of-core factor files
+            const char* dir = 0;
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                dir = OPS_GetString();
+            if (dir == 0) {
+                opserr << "WARNING: failed to get the -ooc directory\n";
+                return 0;
+            }
+            oocDir = dir;
+            ooc = true;
+#endif
+        } else if (strcmp(opt, "-numThreads") == 0) {
+            // OpenMP threads inside MUMPS, 0 for its default
+            if (OPS_GetIntInput(&num, &numThreads) < 0 || numThreads < 0) {
+                opserr << "WARNING: failed to get -numThreads\n";
+                return 0;
+            }
         }
     }
 
@@ -3679,7 +4736,9 @@ void* OPS_MumpsSolver() {
 #ifdef _MUMPS
     MumpsParallelSOE* soe = 0;
 
-    MumpsParallelSolver *solver= new MumpsParallelSolver(icntl7, icntl14);
+    MumpsParallelSolver *solver= new MumpsParallelSolver(icntl7, icntl14,
+                                                         ooc ? oocDir.c_str() : 0,
+                                                         numThreads);
     soe = new MumpsParallelSOE(*solver, matType);
 
     MachineBroker* machine = cmds->getMachineBroker();
@@ -3693,8 +4752,9 @@ void* OPS_MumpsSolver() {
 #endif
 #else
 #ifdef _MUMPS
-    MumpsSolver *theSolver = new MumpsSolver(icntl7, icntl14);
-    theSOE = new MumpsSOE(*theSolver, matType);
+    MumpsSolver *theSolver = new MumpsSolver(icntl7, icntl14, ooc ? oocDir.c_str() : 0,
+                                             numThreads);
+    MumpsSOE *theSOE = new MumpsSOE(*theSolver, matType);
     return theSOE;
 #endif
 #endif
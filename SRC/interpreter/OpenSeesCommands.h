@@ -59,11 +59,14 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <FEM_ObjectBrokerAllClasses.h>
 #include <PFEMAnalysis.h>
 #include <VariableTimeStepDirectIntegrationAnalysis.h>
+#include <AnalysisCheckpoint.h>
+#include <StepRetryPolicy.h>
 #include <Timer.h>
 #include <SimulationInformation.h>
 #include <elementAPI.h>
 #include <MachineBroker.h>
 #include "OpenSeesReliabilityCommands.h"
+#include <map>
 
 class OpenSeesCommands
 {
@@ -145,8 +148,21 @@ public:
     EigenSOE** getEigenSOEPointer() {return &theEigenSOE;}
 
     void setFileDatabase(const char* filename);
+    void setMemoryDatabase(void);
+    void setCheckpointDatabase(const char* filename);
     FE_Datastore* getDatabase() {return theDatabase;}
 
+    void setCheckpoint(AnalysisCheckpoint* checkpoint);
+    AnalysisCheckpoint* getCheckpoint() {return theCheckpoint;}
+
+    // the retryPolicy rung being built takes the algorithm and test
+    // set while setRetryRung(true) is on
+    void setRetryRung(bool building);
+    void discardRetryRung();
+    int addRetryRung(int numSubSteps);
+    StepRetryPolicy* getRetryPolicy() {return theRetryPolicy;}
+    FEM_ObjectBroker& getBroker() {return theBroker;}
+
     Timer* getTimer() {return &theTimer;}
     SimulationInformation* getSimulationInformation() {return &theSimulationInfo;}
 
@@ -158,9 +174,22 @@ public:
     void wipe();
     int eigen(int typeSolver, double shift,
 	      bool generalizedAlgo, bool findSmallest);
+    int eigenAsync(int typeSolver, bool generalizedAlgo, bool findSmallest);
+    int eigenWait();
+
+    // model contexts: each holds its own domain, analysis objects and
+    // modelling objects (materials, sections, ...); only the current
+    // one is seen by the commands, the others are kept aside
+    int newModelContext();
+    int setModelContext(int handle);
+    int removeModelContext(int handle);
+    int getModelContext() const {return currentContext;}
 
 private:
 
+    struct ModelContext;
+    void swapModelContext(ModelContext& other);
+
     DL_Interpreter* interpreter;
     Domain* theDomain;
     int ndf, ndm;
@@ -181,6 +210,11 @@ private:
 
     int numEigen;
     FE_Datastore* theDatabase;
+    AnalysisCheckpoint* theCheckpoint;
+    StepRetryPolicy* theRetryPolicy;
+    bool buildingRung;
+    EquiSolnAlgo* theRungAlgorithm;
+    ConvergenceTest* theRungTest;
     FEM_ObjectBrokerAllClasses theBroker;
     Timer theTimer;
     SimulationInformation theSimulationInfo;
@@ -191,6 +225,8 @@ private:
 
     OpenSeesReliabilityCommands* reliability;
 
+    std::map<int, ModelContext*> otherContexts;
+    int currentContext, nextContext;
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -229,6 +265,7 @@ int OPS_setParameter();
 
 /* OpenSeesElementCommands.cpp */
 int OPS_Element();
+int OPS_Elements();
 int OPS_doBlock2D();
 int OPS_doBlock3D();
 
@@ -278,6 +315,9 @@ int OPS_eleDynamicalForce();
 int OPS_nodeUnbalance();
 int OPS_nodeVel();
 int OPS_nodeAccel();
+int OPS_nodeDispAll();
+int OPS_nodeVelAll();
+int OPS_nodeAccelAll();
 int OPS_nodeResponse();
 int OPS_nodeCoord();
 int OPS_setNodeCoord();
@@ -371,10 +411,18 @@ int OPS_send();
 int OPS_recv();
 int OPS_Bcast();
 int OPS_sdfResponse();
+int OPS_sdfSpectra();
 int OPS_getNumThreads();
 int OPS_setNumThreads();
+int OPS_setParallelUpdate();
+int OPS_setGeometryCache();
+int OPS_logWarnings();
+int OPS_benchMaterial();
+int OPS_benchElement();
 int OPS_setStartNodeTag();
 int OPS_partition();
+int OPS_setPartition();
+bool OPS_isLocalElement(Element *theEle);
 
 // OpenSeesReliabilityCommands.cpp
 int OPS_randomVariable();
@@ -409,6 +457,7 @@ int OPS_gradientEvaluator();
 int OPS_wipeReliability();
 int OPS_runFOSMAnalysis();
 int OPS_runFORMAnalysis();
+int OPS_runParametricReliabilityAnalysis();
 int OPS_runSORMAnalysis();
 int OPS_runImportanceSamplingAnalysis();
 ReliabilityDomain* OPS_GetReliabilityDomain();
@@ -416,6 +465,7 @@ ReliabilityDomain* OPS_GetReliabilityDomain();
 /* OpenSeesCommands.cpp */
 int OPS_wipe();
 int OPS_wipeAnalysis();
+int OPS_modelContext();
 int OPS_model();
 int OPS_System();
 int OPS_Numberer();
@@ -424,7 +474,15 @@ int OPS_CTest();
 int OPS_Integrator();
 int OPS_Algorithm();
 int OPS_Analysis();
+int OPS_RetryPolicy();
+int OPS_RetryRung(bool algorithm);
 int OPS_analyze();
+// called after each group of steps of OPS_analyzeSteps with the number
+// of steps done, may change dt; returns 0 to go on, > 0 to stop and < 0
+// for an error
+typedef int (*OPS_StepCallback)(int step, double &dt, void *data);
+int OPS_analyzeSteps(int numIncr, double dt, int every,
+		     OPS_StepCallback callback, void *data);
 int OPS_eigenAnalysis();
 int OPS_resetModel();
 int OPS_initializeAnalysis();
@@ -433,10 +491,14 @@ int OPS_printB();
 int OPS_printX();
 int OPS_printModel();
 int OPS_Database();
+int OPS_checkpoint();
 int OPS_save();
 int OPS_restore();
 int OPS_startTimer();
 int OPS_stopTimer();
+int OPS_profile();
+int OPS_metrics();
+int OPS_memoryReport();
 int OPS_modalDamping();
 int OPS_modalDampingQ();
 int OPS_neesMetaData();
@@ -448,6 +510,8 @@ int OPS_numFact();
 int OPS_numIter();
 int* OPS_GetNumEigen();
 int OPS_systemSize();
+int OPS_numFactorizations();
+int OPS_influenceMatrix();
 int OPS_domainCommitTag();
 
 void* OPS_KrylovNewton();
@@ -457,6 +521,7 @@ void* OPS_SecantNewton();
 void* OPS_PeriodicNewton();
 void* OPS_NewtonLineSearch();
 void* OPS_ExpressNewton();
+void* OPS_AdaptiveNewton();
 
 void* OPS_ParallelNumberer();
 void* OPS_ParallelRCM();
@@ -472,6 +537,7 @@ int OPS_sensitivityAlgorithm();
 
 /* Defined in its own class.cpp*/
 int OPS_Node();
+int OPS_Nodes();
 int OPS_HomogeneousBC();
 int OPS_EqualDOF();
 int OPS_EqualDOF_Mixed();
@@ -482,6 +548,8 @@ int OPS_ShallowFoundationGen();
 int OPS_Pressure_Constraint();
 int OPS_DomainModalProperties();
 int OPS_ResponseSpectrumAnalysis();
+int OPS_ModalTransientAnalysis();
+int OPS_FrequencyDomainAnalysis();
 
 void* OPS_TimeSeriesIntegrator();
 
@@ -500,6 +568,14 @@ void* OPS_PFEMSolver_Mumps();
 void* OPS_PFEMSolver_Laplace();
 void* OPS_PFEMSolver_LumpM();
 void* OPS_SymSparseLinSolver();
+void* OPS_SparseSPDLinSolver();
+void* OPS_SparseKrylovSolver();
+void* OPS_AutoLinearSOE();
+void* OPS_MatrixFreeLinSolver();
+void* OPS_BlockSparseLinSolver();
+#ifdef _CUDSS
+void* OPS_CuDSSSolver();
+#endif
 void* OPS_FullGenLinLapackSolver();
 
 void* OPS_PlainNumberer();
@@ -525,6 +601,7 @@ void* OPS_CTestRelativeTotalNormDispIncr();
 void* OPS_LoadControlIntegrator();
 void* OPS_DisplacementControlIntegrator();
 void* OPS_Newmark();
+void* OPS_ImplicitExplicit();
 void* OPS_GimmeMCK();
 void* OPS_HarmonicSteadyState();
 void* OPS_ArcLength();
@@ -0,0 +1,217 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: the benchElement command, a driver that times one element
+// of the model in isolation, with random trial displacements set on its
+// nodes and no analysis around it:
+//
+//   benchElement eleTag? <-steps n?> <-repeat n?> <-amplitude a?> <-seed s?>
+//
+// The displacements of every node dof follow a bounded random walk of
+// the given amplitude, the same for every run with the same seed. Each
+// step sets them, then times update, getTangentStiff, getResistingForce
+// and commitState, and the result is
+//
+//   numSteps nsPerUpdate nsPerTangent nsPerResistingForce nsPerCommit allocationsPerStep
+//
+// The element and its nodes are left in the state of the last step, so
+// the command is meant for a model built for it. Allocations are counted
+// when the interpreter is built with _OPS_COUNT_ALLOCATIONS, otherwise
+// -1 is returned for them.
+
+#include <elementAPI.h>
+#include <Domain.h>
+#include <Element.h>
+#include <Node.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <chrono>
+#include <vector>
+#include <string.h>
+
+// in OpenSeesMaterialBenchCommands.cpp
+long OPS_getNumAllocations();
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+inline double elapsed(clock_type::time_point t0, clock_type::time_point t1)
+{
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+}
+
+int OPS_benchElement()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING: need benchElement eleTag? <-steps n?> <-repeat n?> <-amplitude a?> <-seed s?>\n";
+	return -1;
+    }
+
+    int tag;
+    int numData = 1;
+    if (OPS_GetIntInput(&numData, &tag) < 0) {
+	opserr << "WARNING: invalid element tag -- benchElement\n";
+	return -1;
+    }
+
+    int numSteps = 1000;
+    int repeat = 1;
+    int seed = 12345;
+    double amplitude = 1.0e-3;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-steps") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &numSteps) < 0 || numSteps < 1) {
+		opserr << "WARNING: need -steps n -- benchElement\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-repeat") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &repeat) < 0 || repeat < 1) {
+		opserr << "WARNING: need -repeat n -- benchElement\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-amplitude") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &amplitude) < 0) {
+		opserr << "WARNING: need -amplitude a -- benchElement\n";
+		return -1;
+	    }
+	} else if (strcmp(opt, "-seed") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &seed) < 0) {
+		opserr << "WARNING: need -seed s -- benchElement\n";
+		return -1;
+	    }
+	} else {
+	    opserr << "WARNING: unknown option " << opt << " -- benchElement\n";
+	    return -1;
+	}
+    }
+
+    Domain *theDomain = OPS_GetDomain();
+    Element *theElement = theDomain != 0 ? theDomain->getElement(tag) : 0;
+    if (theElement == 0) {
+	opserr << "WARNING: element " << tag << " not found -- benchElement\n";
+	return -1;
+    }
+
+    int numNodes = theElement->getNumExternalNodes();
+    Node **theNodes = theElement->getNodePtrs();
+    std::vector<Vector> disp;
+    for (int i = 0; i < numNodes; i++) {
+	if (theNodes[i] == 0) {
+	    opserr << "WARNING: element " << tag << " is not connected to its nodes -- benchElement\n";
+	    return -1;
+	}
+	disp.push_back(theNodes[i]->getTrialDisp());
+    }
+
+    // the random walks, made up front so that they are not timed; a
+    // linear congruential generator keeps them the same on every platform
+    int numDOF = 0;
+    for (int i = 0; i < numNodes; i++)
+	numDOF += disp[i].Size();
+    std::vector<double> history((size_t)numSteps*numDOF);
+    std::vector<double> walk(numDOF, 0.0);
+    unsigned long state = (unsigned long)seed;
+    for (int n = 0; n < numSteps; n++) {
+	for (int j = 0; j < numDOF; j++) {
+	    state = (1103515245UL*state + 12345UL) % 2147483648UL;
+	    double r = state/2147483648.0 - 0.5;
+	    walk[j] += 0.2*amplitude*r;
+	    if (walk[j] > amplitude)
+		walk[j] = amplitude;
+	    else if (walk[j] < -amplitude)
+		walk[j] = -amplitude;
+	    history[(size_t)n*numDOF + j] = walk[j];
+	}
+    }
+
+    const int numCalibration = 1000;
+    clock_type::time_point t0 = clock_type::now();
+    for (int i = 0; i < numCalibration; i++)
+	clock_type::now();
+    double clockCost = elapsed(t0, clock_type::now())/numCalibration;
+
+    double updateTime = 0.0, tangentTime = 0.0, forceTime = 0.0, commitTime = 0.0;
+    double sum = 0.0;
+    long allocations = OPS_getNumAllocations();
+
+    for (int r = 0; r < repeat; r++) {
+	for (int n = 0; n < numSteps; n++) {
+	    const double *u = &history[(size_t)n*numDOF];
+	    for (int i = 0; i < numNodes; i++) {
+		Vector &d = disp[i];
+		for (int j = 0; j < d.Size(); j++)
+		    d(j) = *u++;
+		theNodes[i]->setTrialDisp(d);
+	    }
+
+	    clock_type::time_point a = clock_type::now();
+	    theElement->update();
+	    clock_type::time_point b = clock_type::now();
+	    sum += theElement->getTangentStiff()(0,0);
+	    clock_type::time_point c = clock_type::now();
+	    sum += theElement->getResistingForce()(0);
+	    clock_type::time_point d = clock_type::now();
+	    theElement->commitState();
+	    clock_type::time_point f = clock_type::now();
+
+	    updateTime += elapsed(a, b);
+	    tangentTime += elapsed(b, c);
+	    forceTime += elapsed(c, d);
+	    commitTime += elapsed(d, f);
+	}
+    }
+
+    allocations = OPS_getNumAllocations() - allocations;
+
+    for (int i = 0; i < numNodes; i++)
+	theNodes[i]->commitState();
+
+    double totalSteps = (double)numSteps*repeat;
+    double result[6];
+    result[0] = totalSteps;
+    result[1] = updateTime/totalSteps - clockCost;
+    result[2] = tangentTime/totalSteps - clockCost;
+    result[3] = forceTime/totalSteps - clockCost;
+    result[4] = commitTime/totalSteps - clockCost;
+#ifdef _OPS_COUNT_ALLOCATIONS
+    result[5] = allocations/totalSteps;
+#else
+    result[5] = -1.0;
+#endif
+    for (int i = 1; i < 5; i++)
+	if (result[i] < 0.0)
+	    result[i] = 0.0;
+
+    // keeps the calls from being optimized away
+    if (sum != sum)
+	opserr << "WARNING: element " << tag << " returned NaN -- benchElement\n";
+
+    numData = 6;
+    if (OPS_SetDoubleOutput(&numData, result, false) < 0) {
+	opserr << "WARNING: failed to set output -- benchElement\n";
+	return -1;
+    }
+
+    return 0;
+}
@@ -70,6 +70,8 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <ForceBeamColumn2d.h>
 #include <ForceBeamColumn3d.h>
 
+bool OPS_isLocalElement(Element *theEle);
+
 void* OPS_ZeroLengthND();
 void* OPS_ZeroLengthSection();
 void* OPS_ZeroLength();
@@ -217,6 +219,8 @@ void* OPS_Actuator();
 void* OPS_ActuatorCorot();
 void* OPS_GenericClient();
 void* OPS_GenericCopy();
+void* OPS_SuperElement();
+void* OPS_UserBatchElement();
 void* OPS_FlatSliderSimple2d();
 void* OPS_FlatSliderSimple3d();
 void* OPS_SingleFPSimple2d();
@@ -623,6 +627,8 @@ namespace {
 	functionMap.insert(std::make_pair("corotActuator", &OPS_ActuatorCorot));
 	functionMap.insert(std::make_pair("genericClient", &OPS_GenericClient));
 	functionMap.insert(std::make_pair("genericCopy", &OPS_GenericCopy));
+	functionMap.insert(std::make_pair("superElement", &OPS_SuperElement));
+	functionMap.insert(std::make_pair("userBatch", &OPS_UserBatchElement));
 	functionMap.insert(std::make_pair("beamColumnJoint", &OPS_BeamColumnJoint));
 	functionMap.insert(std::make_pair("elastic2dGNL", &OPS_Elastic2DGNL));
 	functionMap.insert(std::make_pair("element2dGNL", &OPS_Elastic2DGNL));
@@ -863,6 +869,12 @@ OPS_Element()
 	}
     }
 
+    // the element belongs to another processor, see setPartition
+    if (OPS_isLocalElement(theEle) == false) {
+	delete theEle;
+	return 0;
+    }
+
     // Now add the element to the domain
     Domain* theDomain = OPS_GetDomain();
     if (theDomain == 0) return -1;
@@ -877,6 +889,120 @@ OPS_Element()
 
 }
 
+// elements type tags connectivity eleArgs...
+// creates many elements of one type & one material in a single call;
+// tags is a list of n element tags and connectivity the list of their
+// node tags, element after element. The eleArgs are those of block2D and
+// block3D: stdBrick, bbarBrick, SSPbrick matTag; FourNodeTetrahedron
+// matTag; quad thick type matTag.
+int
+OPS_Elements()
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 4) {
+	opserr<<"WARNING too few arguments: elements type? tags? connectivity? eleArgs?\n";
+	return -1;
+    }
+
+    const char* type = OPS_GetString();
+
+    int numEleNodes = 0;
+    if (strcmp(type, "stdBrick") == 0 || strcmp(type, "bbarBrick") == 0 ||
+	strcmp(type, "SSPbrick") == 0 || strcmp(type, "SSPBrick") == 0)
+	numEleNodes = 8;
+    else if (strcmp(type, "quad") == 0 || strcmp(type, "stdQuad") == 0 ||
+	     strcmp(type, "FourNodeTetrahedron") == 0)
+	numEleNodes = 4;
+    else {
+	opserr << "WARNING element type "<<type<<" is currently unknown by this command.\n";
+	return -1;
+    }
+
+    Vector tags, conn;
+    int numEle = 0, numConn = 0;
+    if (OPS_GetDoubleListInput(&numEle, &tags) < 0) {
+	opserr << "WARNING elements - tags is not a list of integers\n";
+	return -1;
+    }
+    if (OPS_GetDoubleListInput(&numConn, &conn) < 0) {
+	opserr << "WARNING elements - connectivity is not a list of integers\n";
+	return -1;
+    }
+    if (numConn != numEle*numEleNodes) {
+	opserr << "WARNING elements - "<<numEle<<" "<<type<<" elements need ";
+	opserr << numEle*numEleNodes<<" node tags, "<<numConn<<" given\n";
+	return -1;
+    }
+
+    // element args
+    double thick = 1.0;
+    const char* subtype = "";
+    int matTag = -1;
+    int numdata = 1;
+    if (numEleNodes == 4 && strcmp(type, "FourNodeTetrahedron") != 0) {
+	if (OPS_GetDoubleInput(&numdata, &thick) < 0) {
+	    opserr << "WARNING invalid thick\n";
+	    return -1;
+	}
+	subtype = OPS_GetString();
+	if (subtype == 0) {
+	    opserr << "WARNING invalid type\n";
+	    return -1;
+	}
+    }
+    if (OPS_GetIntInput(&numdata, &matTag) < 0) {
+	opserr << "WARNING invalid matTag\n";
+	return -1;
+    }
+
+    NDMaterial* mat = OPS_getNDMaterial(matTag);
+    if (mat == 0) {
+	opserr << "WARNING material not found\n";
+	opserr << "Material: " << matTag << "\n";
+	return -1;
+    }
+
+    theDomain->reserveElements(numEle);
+
+    int nd[8];
+    for (int i=0; i<numEle; i++) {
+	int eleID = int(tags(i));
+	for (int j=0; j<numEleNodes; j++)
+	    nd[j] = int(conn(i*numEleNodes+j));
+
+	Element* theEle = 0;
+	if (strcmp(type, "stdBrick") == 0) {
+	    theEle = new Brick(eleID,nd[0],nd[1],nd[2],nd[3],nd[4],nd[5],nd[6],nd[7],
+			       *mat,0.,0.,0.);
+	} else if (strcmp(type, "bbarBrick") == 0) {
+	    theEle = new BbarBrick(eleID,nd[0],nd[1],nd[2],nd[3],nd[4],nd[5],nd[6],nd[7],
+				   *mat,0.,0.,0.);
+	} else if (numEleNodes == 8) {
+	    theEle = new SSPbrick(eleID,nd[0],nd[1],nd[2],nd[3],nd[4],nd[5],nd[6],nd[7],
+				  *mat,0.,0.,0.);
+	} else if (strcmp(type, "FourNodeTetrahedron") == 0) {
+	    theEle = new FourNodeTetrahedron(eleID,nd[0],nd[1],nd[2],nd[3],*mat,0.,0.,0.);
+	} else {
+	    theEle = new FourNodeQuad(eleID,nd[0],nd[1],nd[2],nd[3],*mat,subtype,thick);
+	}
+
+	if (OPS_isLocalElement(theEle) == false) {
+	    delete theEle;
+	    continue;
+	}
+
+	if (theDomain->addElement(theEle) == false) {
+	    opserr<<"WARNING failed to add element "<<eleID<<" to domain\n";
+	    delete theEle;
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
 int OPS_doBlock2D()
 {
     int ndm = OPS_GetNDM();
@@ -1074,10 +1200,53 @@ int OPS_doBlock2D()
 	}
     }
 
+    // the element type, its material or section and the node count are
+    // checked once here, so that a bad call does not leave half a block
+    enum {QUAD, SHELL_MITC4, SHELL_NLDKGQ, SHELL_DKGQ, BBAR_QUAD, ENHANCED_QUAD, SSP_QUAD} eleType;
+    if (strcmp(type, "quad") == 0  || (strcmp(type,"stdQuad") == 0))
+	eleType = QUAD;
+    else if (strcmp(type, "ShellMITC4") == 0 || strcmp(type, "shellMITC4") == 0 ||
+	     strcmp(type, "shell") == 0 || strcmp(type, "Shell") == 0)
+	eleType = SHELL_MITC4;
+    else if (strcmp(type, "ShellNLDKGQ") == 0 || strcmp(type, "shellNLDKGQ") == 0)
+	eleType = SHELL_NLDKGQ;
+    else if (strcmp(type, "ShellDKGQ") == 0 || strcmp(type, "shellDKGQ") == 0)
+	eleType = SHELL_DKGQ;
+    else if (strcmp(type, "bbarQuad") == 0 || strcmp(type,"mixedQuad") == 0)
+	eleType = BBAR_QUAD;
+    else if (strcmp(type, "enhancedQuad") == 0)
+	eleType = ENHANCED_QUAD;
+    else
+	eleType = SSP_QUAD;
+
+    if (numEleNodes != 4) {
+	opserr<<"WARNING "<<type<<" element only needs four nodes\n";
+	return -1;
+    }
+
+    NDMaterial* mat = 0;
+    SectionForceDeformation *sec = 0;
+    if (secTag != -1) {
+	sec = OPS_getSectionForceDeformation(secTag);
+	if (sec == 0) {
+	    opserr << "WARNING:  section " << secTag << " not found\n";
+	    return -1;
+	}
+    } else {
+	mat = OPS_getNDMaterial(matTag);
+	if (mat == 0) {
+	    opserr << "WARNING material not found\n";
+	    opserr << "Material: " << matTag << "\n";
+	    return -1;
+	}
+    }
+
     // create Block2D object
     Block2D theBlock(idata[0], idata[1], haveNode, Coordinates, numEleNodes);
 
     // create the nodes: (numX+1)*(numY+1) nodes to be created
+    theDomain->reserveNodes((idata[0]+1)*(idata[1]+1));
+
     int nodeID = idata[2];
     Node* theNode = 0;
     for (int j=0; j<=idata[1]; j++) {
@@ -1117,149 +1286,44 @@ int OPS_doBlock2D()
 	idata[1] /= 2;
     }
 
+    theDomain->reserveElements(idata[0]*idata[1]);
+
     Element* theEle = 0;
     for (int j=0; j<idata[1]; j++) {
 	for (int i=0; i<idata[0]; i++) {
 	    const ID& nodeTags = theBlock.getElementNodes(i,j);
+	    int nd1 = nodeTags(0) + idata[2];
+	    int nd2 = nodeTags(1) + idata[2];
+	    int nd3 = nodeTags(2) + idata[2];
+	    int nd4 = nodeTags(3) + idata[2];
 
-	    if (strcmp(type, "quad") == 0  || (strcmp(type,"stdQuad") == 0)) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING quad element only needs four nodes\n";
-		    return -1;
-		}
-		NDMaterial* mat = OPS_getNDMaterial(matTag);
-		if (mat == 0) {
-		    opserr << "WARNING material not found\n";
-		    opserr << "Material: " << matTag;
-		    opserr << "\nFourNodeQuad \n";
-		    return -1;
-		}
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+	    switch (eleType) {
+	    case QUAD:
 		theEle = new FourNodeQuad(eleID,nd1,nd2,nd3,nd4,*mat,subtype,thick);
-
-
-	    } else if (strcmp(type, "ShellMITC4") == 0 || strcmp(type, "shellMITC4") == 0 ||
-		       strcmp(type, "shell") == 0 || strcmp(type, "Shell") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING ShellMITC4 element only needs four nodes\n";
-		    return -1;
-		}
-		SectionForceDeformation *sec = OPS_getSectionForceDeformation(secTag);
-
-		if (sec == 0) {
-		    opserr << "WARNING:  section " << secTag << " not found\n";
-		    return -1;
-		}
-
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+		break;
+	    case SHELL_MITC4:
 		theEle = new ShellMITC4(eleID,nd1,nd2,nd3,nd4,*sec);
-
-
-			
-	    } else if (strcmp(type, "ShellNLDKGQ") == 0 || strcmp(type, "shellNLDKGQ") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING ShellNLDKGQ element only needs four nodes\n";
-		    return -1;
-		}
-		SectionForceDeformation *sec = OPS_getSectionForceDeformation(secTag);
-
-		if (sec == 0) {
-		    opserr << "WARNING:  section " << secTag << " not found\n";
-		    return -1;
-		}
-
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+		break;
+	    case SHELL_NLDKGQ:
 		theEle = new ShellNLDKGQ(eleID,nd1,nd2,nd3,nd4,*sec);
-
-	    } else if (strcmp(type, "ShellDKGQ") == 0 || strcmp(type, "shellDKGQ") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING ShellDKGQ element only needs four nodes\n";
-		    return -1;
-		}
-		SectionForceDeformation *sec = OPS_getSectionForceDeformation(secTag);
-
-		if (sec == 0) {
-		    opserr << "WARNING:  section " << secTag << " not found\n";
-		    return -1;
-		}
-
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
-		theEle = new ShellDKGQ(eleID,nd1,nd2,nd3,nd4,*sec);		
-
-		
-			
-	    } else if (strcmp(type, "bbarQuad") == 0 || strcmp(type,"mixedQuad") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING ConstantPressureVolumeQuad element only needs four nodes\n";
-		    return -1;
-		}
-		NDMaterial* mat = OPS_getNDMaterial(matTag);
-		if (mat == 0) {
-		    opserr << "WARNING material not found\n";
-		    opserr << "Material: " << matTag << "\n";
-		    return -1;
-		}
-
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+		break;
+	    case SHELL_DKGQ:
+		theEle = new ShellDKGQ(eleID,nd1,nd2,nd3,nd4,*sec);
+		break;
+	    case BBAR_QUAD:
 		theEle = new ConstantPressureVolumeQuad(eleID,nd1,nd2,nd3,nd4,*mat,thick);
-
-	    } else if (strcmp(type, "enhancedQuad") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING EnhancedQuad element only needs four nodes\n";
-		    return -1;
-		}
-		NDMaterial* mat = OPS_getNDMaterial(matTag);
-		if (mat == 0) {
-		    opserr << "WARNING material not found\n";
-		    opserr << "Material: " << matTag << "\n";
-		    return -1;
-		}
-
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+		break;
+	    case ENHANCED_QUAD:
 		theEle = new EnhancedQuad(eleID,nd1,nd2,nd3,nd4,*mat,subtype,thick);
-
-	    } else if (strcmp(type, "SSPquad") == 0 || strcmp(type, "SSPQuad") == 0) {
-
-		if (numEleNodes != 4) {
-		    opserr<<"WARNING SSPquad element only needs four nodes\n";
-		    return -1;
-		}
-		NDMaterial* mat = OPS_getNDMaterial(matTag);
-		if (mat == 0) {
-		    opserr << "WARNING material not found\n";
-		    opserr << "Material: " << matTag;
-		    opserr << "\nFourNodeQuad \n";
-		    return -1;
-		}
-		int nd1 = nodeTags(0) + idata[2];
-		int nd2 = nodeTags(1) + idata[2];
-		int nd3 = nodeTags(2) + idata[2];
-		int nd4 = nodeTags(3) + idata[2];
+		break;
+	    case SSP_QUAD:
 		theEle = new SSPquad(eleID,nd1,nd2,nd3,nd4,*mat,subtype,thick);
+		break;
+	    }
+
+	    if (OPS_isLocalElement(theEle) == false) {
+	        delete theEle;
+	        continue;
 	    }
 
 	    if (theDomain->addElement(theEle) == false) {
@@ -1353,10 +1417,33 @@ int OPS_doBlock3D()
 	}
     }
 
+    // the element type and material are checked once here, so that a bad
+    // call does not leave half a block
+    enum {STD_BRICK, BBAR_BRICK, SSP_BRICK} eleType;
+    if (strcmp(type, "stdBrick") == 0)
+	eleType = STD_BRICK;
+    else if (strcmp(type, "bbarBrick") == 0)
+	eleType = BBAR_BRICK;
+    else if (strcmp(type, "SSPbrick") == 0 || strcmp(type,"SSPBrick") == 0)
+	eleType = SSP_BRICK;
+    else {
+	opserr << "WARNING element type " << type << " is currently unknown by this command.\n";
+	return -1;
+    }
+
+    NDMaterial* mat = OPS_getNDMaterial(matTag);
+    if (mat == 0) {
+	opserr << "WARNING material not found\n";
+	opserr << "Material: " << matTag << "\n";
+	return -1;
+    }
+
     // create Block3D object
     Block3D theBlock(idata[0], idata[1], idata[2], haveNode, Coordinates);
 
     // create the nodes: (numX+1)*(numY+1)*(numZ+1) nodes to be created
+    theDomain->reserveNodes((idata[0]+1)*(idata[1]+1)*(idata[2]+1));
+
     int nodeID = idata[3];
     Node* theNode = 0;
     for (int k=0; k<=idata[2]; k++) {
@@ -1391,14 +1478,7 @@ int OPS_doBlock3D()
     int eleID = idata[4];
     Element* theEle = 0;
 
-    NDMaterial* mat = OPS_getNDMaterial(matTag);
-    if (mat == 0) {
-	opserr << "WARNING material not found\n";
-	opserr << "Material: " << matTag << "\n";
-	return -1;
-    }
-
-
+    theDomain->reserveElements(idata[0]*idata[1]*idata[2]);
 
     for (int k=0; k<idata[2]; k++) {
 	for (int j=0; j<idata[1]; j++) {
@@ -1414,24 +1494,24 @@ int OPS_doBlock3D()
 		int nd7 = nodeTags(6) + idata[3];
 		int nd8 = nodeTags(7) + idata[3];
 
-		if (strcmp(type, "stdBrick") == 0) {
-
+		switch (eleType) {
+		case STD_BRICK:
 		    theEle = new Brick(eleID,nd1,nd2,nd3,nd4,nd5,nd6,nd7,nd8,
 				       *mat,0.,0.,0.);
-
-
-		} else if (strcmp(type, "bbarBrick") == 0) {
+		    break;
+		case BBAR_BRICK:
 		    theEle = new BbarBrick(eleID,nd1,nd2,nd3,nd4,nd5,nd6,nd7,nd8,
 					   *mat,0.,0.,0.);
-
-		} else if (strcmp(type, "SSPbrick") == 0 || strcmp(type,"SSPBrick") == 0) {
-
+		    break;
+		case SSP_BRICK:
 		    theEle = new SSPbrick(eleID,nd1,nd2,nd3,nd4,nd5,nd6,nd7,nd8,
 					   *mat,0.,0.,0.);
+		    break;
+		}
 
-		} else {
-		    opserr << "WARNING element type " << type << " is currently unknown by this command.\n";
-		    return -1;
+		if (OPS_isLocalElement(theEle) == false) {
+		    delete theEle;
+		    continue;
 		}
 
 		if (theDomain->addElement(theEle) == false) {
@@ -0,0 +1,344 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: the benchMaterial command, a driver that times a copy of
+// a uniaxial, nD or section material along a strain history read from a
+// file, without an element or an analysis in between:
+//
+//   benchMaterial uniaxial|nD|section tag? protocolFile? <-repeat n?>
+//
+// Each line of the protocol file holds the strain (deformation)
+// components of one step, lines starting with # are skipped. Every step
+// is a trial, a revert to the last commit, the same trial again and a
+// commit, the pattern of a Newton iteration, and the result is
+//
+//   numSteps nsPerTrial nsPerCommit nsPerRevert allocationsPerStep
+//
+// The trial time includes getting the stress and tangent. Allocations
+// are counted when the interpreter is built with _OPS_COUNT_ALLOCATIONS,
+// otherwise -1 is returned for them.
+
+#include <elementAPI.h>
+#include <UniaxialMaterial.h>
+#include <NDMaterial.h>
+#include <SectionForceDeformation.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+
+#ifdef _OPS_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every operator new of the program goes through here, the material
+// and element drivers read the count before and after their loops
+static std::atomic<long> numAllocations(0);
+
+void *operator new(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size > 0 ? size : 1);
+    if (p == 0)
+	throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+long OPS_getNumAllocations()
+{
+    return numAllocations.load(std::memory_order_relaxed);
+}
+#else
+long OPS_getNumAllocations()
+{
+    return 0;
+}
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+inline double elapsed(clock_type::time_point t0, clock_type::time_point t1)
+{
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+// the strains of the protocol file, numComp per step
+int readProtocol(const char *fileName, int numComp, std::vector<double> &history)
+{
+    std::ifstream in(fileName);
+    if (!in.is_open()) {
+	opserr << "WARNING: benchMaterial - could not open protocol file " << fileName << "\n";
+	return -1;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+	lineNo++;
+	std::istringstream words(line);
+	std::vector<double> values;
+	std::string word;
+	while (words >> word) {
+	    if (values.empty() && word[0] == '#')
+		break;
+	    values.push_back(atof(word.c_str()));
+	}
+	if (values.empty())
+	    continue;
+	if ((int)values.size() != numComp) {
+	    opserr << "WARNING: benchMaterial - line " << lineNo << " of " << fileName
+		   << " has " << (int)values.size() << " values, the material needs "
+		   << numComp << "\n";
+	    return -1;
+	}
+	history.insert(history.end(), values.begin(), values.end());
+    }
+
+    if (history.empty()) {
+	opserr << "WARNING: benchMaterial - no steps in protocol file " << fileName << "\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+// what the three material families look like to the driver
+struct UniaxialDriver {
+    UniaxialMaterial *mat;
+    double sum;
+    void trial(const double *e) {
+	mat->setTrialStrain(e[0]);
+	sum += mat->getStress() + mat->getTangent();
+    }
+    void commit() {mat->commitState();}
+    void revert() {mat->revertToLastCommit();}
+};
+
+struct NDDriver {
+    NDMaterial *mat;
+    Vector strain;
+    double sum;
+    void trial(const double *e) {
+	for (int i = 0; i < strain.Size(); i++)
+	    strain(i) = e[i];
+	mat->setTrialStrain(strain);
+	sum += mat->getStress()(0) + mat->getTangent()(0,0);
+    }
+    void commit() {mat->commitState();}
+    void revert() {mat->revertToLastCommit();}
+};
+
+struct SectionDriver {
+    SectionForceDeformation *sec;
+    Vector def;
+    double sum;
+    void trial(const double *e) {
+	for (int i = 0; i < def.Size(); i++)
+	    def(i) = e[i];
+	sec->setTrialSectionDeformation(def);
+	sum += sec->getStressResultant()(0) + sec->getSectionTangent()(0,0);
+    }
+    void commit() {sec->commitState();}
+    void revert() {sec->revertToLastCommit();}
+};
+
+// the step loop; the clock is read around each call and its own cost,
+// measured first, is taken off
+template <class Driver>
+void runProtocol(Driver &driver, const std::vector<double> &history, int numComp,
+		 int repeat, double *result)
+{
+    int numSteps = (int)history.size()/numComp;
+
+    const int numCalibration = 1000;
+    clock_type::time_point t0 = clock_type::now();
+    for (int i = 0; i < numCalibration; i++)
+	clock_type::now();
+    double clockCost = elapsed(t0, clock_type::now())/numCalibration;
+
+    double trialTime = 0.0, commitTime = 0.0, revertTime = 0.0;
+    long allocations = OPS_getNumAllocations();
+
+    for (int r = 0; r < repeat; r++) {
+	for (int n = 0; n < numSteps; n++) {
+	    const double *e = &history[n*numComp];
+
+	    clock_type::time_point a = clock_type::now();
+	    driver.trial(e);
+	    clock_type::time_point b = clock_type::now();
+	    driver.revert();
+	    clock_type::time_point c = clock_type::now();
+	    driver.trial(e);
+	    clock_type::time_point d = clock_type::now();
+	    driver.commit();
+	    clock_type::time_point f = clock_type::now();
+
+	    trialTime += elapsed(a, b) + elapsed(c, d);
+	    revertTime += elapsed(b, c);
+	    commitTime += elapsed(d, f);
+	}
+    }
+
+    allocations = OPS_getNumAllocations() - allocations;
+
+    double totalSteps = (double)numSteps*repeat;
+    result[0] = totalSteps;
+    result[1] = trialTime/(2.0*totalSteps) - clockCost;
+    result[2] = commitTime/totalSteps - clockCost;
+    result[3] = revertTime/totalSteps - clockCost;
+#ifdef _OPS_COUNT_ALLOCATIONS
+    result[4] = allocations/totalSteps;
+#else
+    result[4] = -1.0;
+#endif
+    for (int i = 1; i < 4; i++)
+	if (result[i] < 0.0)
+	    result[i] = 0.0;
+}
+
+}
+
+int OPS_benchMaterial()
+{
+    if (OPS_GetNumRemainingInputArgs() < 3) {
+	opserr << "WARNING: need benchMaterial uniaxial|nD|section tag? protocolFile? <-repeat n?>\n";
+	return -1;
+    }
+
+    std::string type = OPS_GetString();
+
+    int tag;
+    int numData = 1;
+    if (OPS_GetIntInput(&numData, &tag) < 0) {
+	opserr << "WARNING: invalid material tag -- benchMaterial\n";
+	return -1;
+    }
+
+    std::string fileName = OPS_GetString();
+
+    int repeat = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-repeat") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &repeat) < 0 || repeat < 1) {
+		opserr << "WARNING: need -repeat n -- benchMaterial\n";
+		return -1;
+	    }
+	} else {
+	    opserr << "WARNING: unknown option " << opt << " -- benchMaterial\n";
+	    return -1;
+	}
+    }
+
+    // a copy is driven, so the material of the model keeps its state
+    double result[5];
+    std::vector<double> history;
+
+    if (type == "uniaxial" || type == "uniaxialMaterial") {
+	UniaxialMaterial *theMaterial = OPS_getUniaxialMaterial(tag);
+	if (theMaterial == 0) {
+	    opserr << "WARNING: uniaxialMaterial " << tag << " not found -- benchMaterial\n";
+	    return -1;
+	}
+	if (readProtocol(fileName.c_str(), 1, history) < 0)
+	    return -1;
+	UniaxialDriver driver = {theMaterial->getCopy(), 0.0};
+	runProtocol(driver, history, 1, repeat, result);
+	delete driver.mat;
+    }
+    else if (type == "nD" || type == "nDMaterial") {
+	NDMaterial *theMaterial = OPS_getNDMaterial(tag);
+	if (theMaterial == 0) {
+	    opserr << "WARNING: nDMaterial " << tag << " not found -- benchMaterial\n";
+	    return -1;
+	}
+	NDMaterial *copy = theMaterial->getCopy();
+	int numComp = copy->getOrder();
+	if (numComp <= 0)
+	    numComp = copy->getStrain().Size();
+	if (readProtocol(fileName.c_str(), numComp, history) < 0) {
+	    delete copy;
+	    return -1;
+	}
+	NDDriver driver = {copy, Vector(numComp), 0.0};
+	runProtocol(driver, history, numComp, repeat, result);
+	delete copy;
+    }
+    else if (type == "section") {
+	SectionForceDeformation *theSection = OPS_getSectionForceDeformation(tag);
+	if (theSection == 0) {
+	    opserr << "WARNING: section " << tag << " not found -- benchMaterial\n";
+	    return -1;
+	}
+	SectionForceDeformation *copy = theSection->getCopy();
+	int numComp = copy->getOrder();
+	if (readProtocol(fileName.c_str(), numComp, history) < 0) {
+	    delete copy;
+	    return -1;
+	}
+	SectionDriver driver = {copy, Vector(numComp), 0.0};
+	runProtocol(driver, history, numComp, repeat, result);
+	delete copy;
+    }
+    else {
+	opserr << "WARNING: unknown material type " << type.c_str() << ", want uniaxial, nD or section -- benchMaterial\n";
+	return -1;
+    }
+
+    numData = 5;
+    if (OPS_SetDoubleOutput(&numData, result, false) < 0) {
+	opserr << "WARNING: failed to set output -- benchMaterial\n";
+	return -1;
+    }
+
+    return 0;
+}
@@ -52,10 +52,12 @@
 #include <RigidBeam.h>
 #include <RigidDiaphragm.h>
 #include <vector>
+#include <cmath>
 #include <TriMesh.h>
 #include <TetMesh.h>
 #include <Damping.h>
 #include <BackgroundMesh.h>
+#include <LogCategory.h>
 #ifdef _PARALLEL_INTERPRETERS
 #include <mpi.h>
 #include <metis.h>
@@ -790,6 +792,10 @@ int OPS_MeshRegion()
     double betaKc = 0.0;
     Damping *theDamping = 0;
 
+    // -1 to leave the elements as they are, 0 or 1 to set
+    int active = -1;
+    int frozen = -1;
+
     ID *theNodes = 0;
     ID *theElements = 0;
     int numNodes = 0;
@@ -993,6 +999,14 @@ int OPS_MeshRegion()
 		opserr << "damping not found\n";
 	    return -1;
 		}
+	} else if (strcmp(flag,"-activate") == 0) {
+	    active = 1;
+	} else if (strcmp(flag,"-deactivate") == 0) {
+	    active = 0;
+	} else if (strcmp(flag,"-freeze") == 0) {
+	    frozen = 1;
+	} else if (strcmp(flag,"-thaw") == 0) {
+	    frozen = 0;
 	}
     }
 
@@ -1039,6 +1053,21 @@ int OPS_MeshRegion()
 	
 	if(theDamping) theRegion->setDamping(theDamping);
 
+    // the elements of the region are thawed before being deactivated,
+    // and activated before being frozen
+    if (frozen == 0 && theRegion->setFrozen(false) < 0) {
+	opserr << "WARNING region " << tag << " - could not thaw the elements\n";
+	return -1;
+    }
+    if (active != -1 && theRegion->setActive(active == 1) < 0) {
+	opserr << "WARNING region " << tag << " - could not set the elements active\n";
+	return -1;
+    }
+    if (frozen == 1 && theRegion->setFrozen(true) < 0) {
+	opserr << "WARNING region " << tag << " - could not freeze the elements\n";
+	return -1;
+    }
+
     if (theElements != 0) {
 	delete theElements;
     }
@@ -1941,11 +1970,139 @@ int OPS_setNumThreads()
     }
 
     omp_set_num_threads(num);
+
+    // subdomains in other processes are sent the thread count with the
+    // parallel update flag, send it again so they pick up the new one
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain != 0 && theDomain->getParallelUpdate() == true)
+	theDomain->setParallelUpdate(true);
 #endif
 
     return 0;
 }
 
+int OPS_setParallelUpdate()
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING: need setParallelUpdate 0|1 <-gaussPoints 0|1> <-deterministic 0|1>\n";
+	return -1;
+    }
+
+    int onOff;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata,&onOff) < 0) {
+	opserr << "WARNING: failed to read flag -- setParallelUpdate\n";
+	return -1;
+    }
+
+    // -gaussPoints also splits the loops over the integration points of
+    // the elements that support it
+    bool points = Element::parallelPoints;
+    bool ordered = theDomain->getDeterministic();
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-gaussPoints") == 0) {
+	    int pointsOnOff;
+	    if (OPS_GetNumRemainingInputArgs() < 1 ||
+		OPS_GetIntInput(&numdata,&pointsOnOff) < 0) {
+		opserr << "WARNING: need -gaussPoints 0|1 -- setParallelUpdate\n";
+		return -1;
+	    }
+	    points = pointsOnOff != 0;
+	} else if (strcmp(opt, "-deterministic") == 0) {
+	    // the parallel sums in an order that does not depend on the
+	    // threads, for results reproducible bit for bit
+	    int orderedOnOff;
+	    if (OPS_GetNumRemainingInputArgs() < 1 ||
+		OPS_GetIntInput(&numdata,&orderedOnOff) < 0) {
+		opserr << "WARNING: need -deterministic 0|1 -- setParallelUpdate\n";
+		return -1;
+	    }
+	    ordered = orderedOnOff != 0;
+	} else {
+	    opserr << "WARNING: unknown option " << opt << " -- setParallelUpdate\n";
+	    return -1;
+	}
+    }
+
+    theDomain->setParallelUpdate(onOff != 0);
+    theDomain->setDeterministic(ordered);
+    Element::parallelPoints = points;
+
+    return 0;
+}
+
+int OPS_setGeometryCache()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING: need setGeometryCache 0|1\n";
+	return -1;
+    }
+
+    int onOff;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata,&onOff) < 0) {
+	opserr << "WARNING: failed to read flag -- setGeometryCache\n";
+	return -1;
+    }
+
+    Element::cacheGeometry = onOff != 0;
+
+    return 0;
+}
+
+int OPS_logWarnings()
+{
+    // logWarnings -limit n <category>
+    // logWarnings -off <category>
+    // logWarnings -on <category>
+    // logWarnings -summary
+    // logWarnings -reset
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING: need logWarnings -limit n|-off|-on <category>, -summary or -reset\n";
+	return -1;
+    }
+
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-summary") == 0) {
+	LogCategory::printSummary(opserr);
+	return 0;
+    }
+    if (strcmp(opt, "-reset") == 0) {
+	LogCategory::reset();
+	return 0;
+    }
+
+    long limit;
+    if (strcmp(opt, "-limit") == 0) {
+	int n;
+	int numdata = 1;
+	if (OPS_GetNumRemainingInputArgs() < 1 ||
+	    OPS_GetIntInput(&numdata, &n) < 0) {
+	    opserr << "WARNING: need -limit n -- logWarnings\n";
+	    return -1;
+	}
+	limit = n;
+    } else if (strcmp(opt, "-off") == 0) {
+	limit = 0;
+    } else if (strcmp(opt, "-on") == 0) {
+	limit = -1;
+    } else {
+	opserr << "WARNING: unknown option " << opt << " -- logWarnings\n";
+	return -1;
+    }
+
+    // without a category it applies to all
+    const char *name = 0;
+    if (OPS_GetNumRemainingInputArgs() > 0)
+	name = OPS_GetString();
+
+    return LogCategory::setLimit(name, limit);
+}
+
 int OPS_setStartNodeTag() {
     if (OPS_GetNumRemainingInputArgs() < 1) {
         opserr << "WARNING: needs tag\n";
@@ -1964,6 +2121,263 @@ int OPS_setStartNodeTag() {
     return 0;
 }
 
+#ifdef _PARALLEL_INTERPRETERS
+// the partition given to setPartition, the elements of the other
+// processors are not created while it is on
+static struct {
+    bool on;
+    int dir;                         // slab partition along dir ..
+    double xmin, xmax;               // .. between xmin and xmax
+    std::map<int, int> elePart;      // or the processor of each element
+    std::map<int, int> nodePart;     // lowest processor at each node
+} modelPartition = {false, -1, 0.0, 0.0};
+
+// once only the elements of this processor are left in the domain,
+// remove the nodes, constraints and loads they do not need; nind maps
+// the node tags to their index in npart, the processor of the node
+static int removeRemoteObjects(Domain *domain, std::map<int, idx_t> &nind,
+                               std::vector<idx_t> &npart, int pid)
+{
+    // get nodes in current processor
+    Element *ele = 0;
+    auto &eles = domain->getElements();
+    while ((ele = eles()) != 0) {
+        const auto &elenodes = ele->getExternalNodes();
+        for (int j = 0; j < elenodes.Size(); ++j) {
+            auto &id = nind[elenodes(j)];
+            if (id >= 0) {
+                id = -id - 1;
+            }
+        }
+    }
+
+    // get nodes in current processor and remove mp
+    auto &mps = domain->getMPs();
+    MP_Constraint *mp = 0;
+    while ((mp = mps()) != 0) {
+        int rtag = mp->getNodeRetained();
+        int ctag = mp->getNodeConstrained();
+        auto &rid = nind[rtag];
+        auto &cid = nind[ctag];
+        if (rid < 0 || cid < 0) {
+            if (rid >= 0) {
+                rid = -rid - 1;
+            }
+            if (cid >= 0) {
+                cid = -cid - 1;
+            }
+        } else {
+            domain->removeMP_Constraint(mp->getTag());
+            delete mp;
+        }
+    }
+
+    // remove nodes
+    for (const auto& item: nind) {
+        int ndtag = item.first;
+        auto id = item.second;
+        if (id >= 0) {
+            auto node = domain->removeNode(ndtag);
+            if (node != 0) {
+                delete node;
+            }
+            auto pc = domain->removePressure_Constraint(ndtag);
+            if (pc != 0) {
+                delete pc;
+            }
+        }
+    }
+
+    // remove sps
+    auto& sps = domain->getSPs();
+    SP_Constraint* sp = 0;
+    while ((sp = sps()) != 0) {
+        int ndtag = sp->getNodeTag();
+        auto id = nind[ndtag];
+        if (id >= 0) {
+            domain->removeSP_Constraint(sp->getTag());
+            delete sp;
+        }
+    }
+
+    // go through load patterns
+    auto& lps = domain->getLoadPatterns();
+    LoadPattern* lp = 0;
+    while ((lp = lps()) != 0) {
+        // remove nodal loads
+        auto& nloads = lp->getNodalLoads();
+        NodalLoad* nload = 0;
+        while ((nload = nloads()) != 0) {
+            int ndtag = nload->getNodeTag();
+            auto id = nind[ndtag];
+            if (id >= 0) {
+                lp->removeNodalLoad(nload->getTag());
+                delete nload;
+            } else {
+                // nodal load can only appear in one place
+                id = -id - 1;
+                if (npart[id] != pid) {
+                    lp->removeNodalLoad(nload->getTag());
+                    delete nload;
+                }
+            }
+        }
+
+        // remove elemental loads
+        auto& eloads = lp->getElementalLoads();
+        ElementalLoad* eload = 0;
+        while ((eload = eloads()) != 0) {
+            int e = eload->getElementTag();
+            if (domain->getElement(e) == 0) {
+                lp->removeElementalLoad(eload->getTag());
+                delete eload;
+            }
+        }
+
+        // remove sps
+        auto& sps2 = lp->getSPs();
+        while ((sp = sps2()) != 0) {
+            int ndtag = sp->getNodeTag();
+            auto id = nind[ndtag];
+            if (id >= 0) {
+                lp->removeSP_Constraint(sp->getTag());
+                delete sp;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif
+
+bool OPS_isLocalElement(Element *theEle)
+{
+#ifdef _PARALLEL_INTERPRETERS
+    if (!modelPartition.on || theEle == 0) {
+        return true;
+    }
+
+    int pid = 0;
+    int np = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+    MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+    // elements not in the partition file go to processor 0
+    int part = 0;
+    const ID &elenodes = theEle->getExternalNodes();
+    if (modelPartition.dir < 0) {
+        auto it = modelPartition.elePart.find(theEle->getTag());
+        if (it != modelPartition.elePart.end()) {
+            part = it->second;
+        }
+    } else {
+        // the slab of the centroid, all nodes exist while the model is built
+        Domain *domain = OPS_GetDomain();
+        double x = 0.0;
+        int num = 0;
+        for (int i = 0; i < elenodes.Size(); ++i) {
+            Node *nd = domain != 0 ? domain->getNode(elenodes(i)) : 0;
+            if (nd == 0) continue;
+            const Vector &crds = nd->getCrds();
+            if (modelPartition.dir < crds.Size()) {
+                x += crds(modelPartition.dir);
+                num++;
+            }
+        }
+        if (num > 0) {
+            x /= num;
+        }
+        double dx = modelPartition.xmax - modelPartition.xmin;
+        if (dx > 0.0) {
+            part = (int)floor((x - modelPartition.xmin) / dx * np);
+        }
+        if (part < 0) part = 0;
+        if (part >= np) part = np - 1;
+    }
+
+    // a node shared by processors gets its loads on the lowest one
+    for (int i = 0; i < elenodes.Size(); ++i) {
+        auto res = modelPartition.nodePart.insert(std::make_pair(elenodes(i), part));
+        if (!res.second && part < res.first->second) {
+            res.first->second = part;
+        }
+    }
+
+    return part == pid;
+#else
+    return true;
+#endif
+}
+
+int OPS_setPartition() {
+#ifdef _PARALLEL_INTERPRETERS
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+        opserr << "WARNING: need setPartition -file fileName or "
+                  "-slab dir xmin xmax or -off\n";
+        return -1;
+    }
+
+    modelPartition.on = false;
+    modelPartition.dir = -1;
+    modelPartition.elePart.clear();
+    modelPartition.nodePart.clear();
+
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-off") == 0) {
+        return 0;
+
+    } else if (strcmp(opt, "-file") == 0) {
+        if (OPS_GetNumRemainingInputArgs() < 1) {
+            opserr << "WARNING: need setPartition -file fileName\n";
+            return -1;
+        }
+        const char *fname = OPS_GetString();
+
+        // one line per element: eleTag processor
+        std::ifstream file(fname);
+        if (!file.is_open()) {
+            opserr << "WARNING: failed to open partition file " << fname << "\n";
+            return -1;
+        }
+        int etag, part;
+        while (file >> etag >> part) {
+            modelPartition.elePart[etag] = part;
+        }
+
+    } else if (strcmp(opt, "-slab") == 0) {
+        if (OPS_GetNumRemainingInputArgs() < 3) {
+            opserr << "WARNING: need setPartition -slab dir xmin xmax\n";
+            return -1;
+        }
+        int num = 1;
+        if (OPS_GetIntInput(&num, &modelPartition.dir) < 0) {
+            opserr << "WARNING: failed to get dir\n";
+            return -1;
+        }
+        double data[2];
+        num = 2;
+        if (OPS_GetDoubleInput(&num, data) < 0) {
+            opserr << "WARNING: failed to get xmin xmax\n";
+            return -1;
+        }
+        modelPartition.dir -= 1;
+        modelPartition.xmin = data[0];
+        modelPartition.xmax = data[1];
+        if (modelPartition.dir < 0) {
+            opserr << "WARNING: setPartition -slab dir should be 1, 2 or 3\n";
+            return -1;
+        }
+
+    } else {
+        opserr << "WARNING: unknown option " << opt << " -- setPartition\n";
+        return -1;
+    }
+
+    modelPartition.on = true;
+#endif
+    return 0;
+}
+
 int OPS_partition() {
 #ifdef _PARALLEL_INTERPRETERS
     // domain
@@ -2019,6 +2433,21 @@ int OPS_partition() {
         }
     }
 
+    // the elements were partitioned while the model was built
+    if (modelPartition.on) {
+        std::map<int, idx_t> nind;
+        std::vector<idx_t> npart;
+        Node *nd = 0;
+        auto &nodes = domain->getNodes();
+        while ((nd = nodes()) != 0) {
+            int ndtag = nd->getTag();
+            nind[ndtag] = (idx_t)npart.size();
+            auto it = modelPartition.nodePart.find(ndtag);
+            npart.push_back(it != modelPartition.nodePart.end() ? it->second : pid);
+        }
+        return removeRemoteObjects(domain, nind, npart, pid);
+    }
+
 
     // map of node tag to index
     std::map<int, idx_t> nind;
@@ -2054,7 +2483,6 @@ int OPS_partition() {
     }
 
     // pair of arrays storing the mesh
-    std::map<int, idx_t> eindex;
     std::vector<idx_t> eptr;
     std::vector<idx_t> eind;
     std::vector<int> etag;
@@ -2062,7 +2490,6 @@ int OPS_partition() {
     Element *ele = 0;
     auto &eles = domain->getElements();
     eptr.push_back(0);
-    index = 0;
     while ((ele = eles()) != 0) {
         const auto &elenodes = ele->getExternalNodes();
         for (int i = 0; i < elenodes.Size(); ++i) {
@@ -2075,7 +2502,6 @@ int OPS_partition() {
             eind.push_back(nind[elenodes(i)]);
         }
         eptr.push_back((idx_t)eind.size());
-        eindex[ele->getTag()] = index++;
         etag.push_back(ele->getTag());
     }
 
@@ -2162,124 +2588,17 @@ int OPS_partition() {
         return -1;
     }
 
-    // get nodes in current processor and remove elements
+    // remove the elements of the other processors
     for (int i = 0; i < ne; ++i) {
-
-        // remove element
         if (epart[i] != pid) {
             Element *ele = domain->removeElement(etag[i]);
             if (ele != 0) {
                 delete ele;
             }
-            continue;
-        }
-
-        // get elenodes
-        Element *ele = domain->getElement(etag[i]);
-        const auto &elenodes = ele->getExternalNodes();
-        for (int j = 0; j < elenodes.Size(); ++j) {
-            auto &id = nind[elenodes(j)];
-            if (id >= 0) {
-                id = -id - 1;
-            }
-        }
-    }
-
-    // get nodes in current processor and remove mp
-    auto &mps = domain->getMPs();
-    MP_Constraint *mp = 0;
-    while ((mp = mps()) != 0) {
-        int rtag = mp->getNodeRetained();
-        int ctag = mp->getNodeConstrained();
-        auto &rid = nind[rtag];
-        auto &cid = nind[ctag];
-        if (rid < 0 || cid < 0) {
-            if (rid >= 0) {
-                rid = -rid - 1;
-            }
-            if (cid >= 0) {
-                cid = -cid - 1;
-            }
-        } else {
-            domain->removeMP_Constraint(mp->getTag());
-            delete mp;
         }
     }
 
-    // remove nodes
-    for (const auto& item: nind) {
-        int ndtag = item.first;
-        auto id = item.second;
-        if (id >= 0) {
-            auto node = domain->removeNode(ndtag);
-            if (node != 0) {
-                delete node;
-            }
-            auto pc = domain->removePressure_Constraint(ndtag);
-            if (pc != 0) {
-                delete pc;
-            }
-        }
-    }
-
-    // remove sps
-    auto& sps = domain->getSPs();
-    SP_Constraint* sp = 0;
-    while ((sp = sps()) != 0) {
-        int ndtag = sp->getNodeTag();
-        auto id = nind[ndtag];
-        if (id >= 0) {
-            domain->removeSP_Constraint(sp->getTag());
-            delete sp;
-        }
-    }
-
-    // go through load patterns
-    auto& lps = domain->getLoadPatterns();
-    LoadPattern* lp = 0;
-    while ((lp = lps()) != 0) {
-        // remove nodal loads
-        auto& nloads = lp->getNodalLoads();
-        NodalLoad* nload = 0;
-        while ((nload = nloads()) != 0) {
-            int ndtag = nload->getNodeTag();
-            auto id = nind[ndtag];
-            if (id >= 0) {
-                lp->removeNodalLoad(nload->getTag());
-                delete nload;
-            } else {
-                // nodal load can only appear in one place
-                id = -id - 1;
-                if (npart[id] != pid) {
-                    lp->removeNodalLoad(nload->getTag());
-                    delete nload;
-                }
-            }
-        }
-
-        // remove elemental loads
-        auto& eloads = lp->getElementalLoads();
-        ElementalLoad* eload = 0;
-        while ((eload = eloads()) != 0) {
-            int e = eload->getElementTag();
-            auto id = epart[eindex[e]];
-            if (id >= 0) {
-                lp->removeElementalLoad(eload->getTag());
-                delete eload;
-            }
-        }
-
-        // remove sps
-        auto& sps2 = lp->getSPs();
-        while ((sp = sps2()) != 0) {
-            int ndtag = sp->getNodeTag();
-            auto id = nind[ndtag];
-            if (id >= 0) {
-                lp->removeSP_Constraint(sp->getTag());
-                delete sp;
-            }
-        }
-    }
+    return removeRemoteObjects(domain, nind, npart, pid);
 
 #endif
     return 0;
@@ -297,6 +297,16 @@ OPS_updateMaterialStage()
 
     Domain* theDomain = OPS_GetDomain();
 
+#ifndef _PARALLEL_PROCESSING
+    // without a parameter tag, a stage kept per material tag is switched
+    // directly, without a MaterialStageParameter visiting the elements
+    if (OPS_GetNumRemainingInputArgs() < 2 &&
+	OPS_setNDMaterialStage(materialTag, value) == 0) {
+	theDomain->parameterChange();
+	return 0;
+    }
+#endif
+
     // This won't work ... what if there's one parameter with tag 2 already defined in the model?
     //int parTag = theDomain->getNumParameters();
     //parTag++;
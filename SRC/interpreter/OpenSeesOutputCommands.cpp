@@ -92,6 +92,9 @@ BackgroundMesh& OPS_getBgMesh();
 
 void* OPS_DriftRecorder();
 void* OPS_EnvelopeDriftRecorder();
+void* OPS_MetricsRecorder();
+void* OPS_FiberSectionRecorder();
+void* OPS_LiveViewRecorder();
 
 int OPS_sectionLocation();
 int OPS_sectionWeight();
@@ -124,6 +127,9 @@ namespace {
 	recordersMap.insert(std::make_pair("Collapse", &OPS_RemoveRecorder));
 	recordersMap.insert(std::make_pair("Drift", &OPS_DriftRecorder));
 	recordersMap.insert(std::make_pair("EnvelopeDrift", &OPS_EnvelopeDriftRecorder));
+	recordersMap.insert(std::make_pair("Metrics", &OPS_MetricsRecorder));
+	recordersMap.insert(std::make_pair("FiberSection", &OPS_FiberSectionRecorder));
+	recordersMap.insert(std::make_pair("LiveView", &OPS_LiveViewRecorder));
 #ifdef _HDF5
 	recordersMap.insert(std::make_pair("mpco", &OPS_MPCORecorder));
     recordersMap.insert(std::make_pair("VTKHDF", &OPS_VTKHDF_Recorder));
@@ -188,6 +194,153 @@ int OPS_Recorder()
     return 0;
 }
 
+// reads the tags of a bulk request, given as a list or an array: returns
+// 1 if it did, 0 if the next argument is a single tag, which is left to
+// be read, and -1 if it is neither
+static int getTagListInput(ID &tags)
+{
+    int tag;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &tag) == 0) {
+	OPS_ResetCurrentInputArg(-1);
+	return 0;
+    }
+    OPS_ResetCurrentInputArg(-1);
+
+    Vector values;
+    int size = 0;
+    if (OPS_GetDoubleListInput(&size, &values) < 0)
+	return -1;
+
+    tags.resize(size);
+    for (int i=0; i<size; i++)
+	tags(i) = (int)values(i);
+
+    return 1;
+}
+
+// sets as output the responses of the nodes, one row per node, padded
+// with zeros to the largest number of dofs; only dof if it is >= 0
+static int setNodeResponseArray(const ID &tags, NodeResponseType type, int dof)
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    int numNodes = tags.Size();
+    int numCols = 0;
+    for (int i=0; i<numNodes; i++) {
+	Node *theNode = theDomain->getNode(tags(i));
+	if (theNode == 0) {
+	    opserr << "WARNING node " << tags(i) << " does not exist\n";
+	    return -1;
+	}
+	if (theNode->getNumberDOF() > numCols)
+	    numCols = theNode->getNumberDOF();
+    }
+
+    if (dof >= numCols && numNodes > 0) {
+	opserr << "WARNING dof " << dof+1 << " too large\n";
+	return -1;
+    }
+
+    int rowSize = (dof >= 0) ? 1 : numCols;
+    std::vector<double> values(numNodes*rowSize+1, 0.0);
+    for (int i=0; i<numNodes; i++) {
+	const Vector *nodalResponse = theDomain->getNodeResponse(tags(i), type);
+	if (nodalResponse == 0) {
+	    opserr << "WARNING no response is found for node " << tags(i) << endln;
+	    return -1;
+	}
+
+	double *row = &values[i*rowSize];
+	int size = nodalResponse->Size();
+	if (dof >= 0) {
+	    if (dof < size)
+		row[0] = (*nodalResponse)(dof);
+	} else {
+	    for (int j=0; j<size && j<numCols; j++)
+		row[j] = (*nodalResponse)(j);
+	}
+    }
+
+    if (OPS_SetDoubleArrayOutput(numNodes, (dof >= 0) ? 0 : numCols, &values[0]) < 0) {
+	opserr << "WARNING failed to set node responses\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+// nodeDispAll <dof>, nodeVelAll ..., nodeAccelAll ...: one row per node,
+// in the order of getNodeTags
+static int nodeResponseAll(NodeResponseType type)
+{
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    int dof = -1;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	int numdata = 1;
+	if (OPS_GetIntInput(&numdata, &dof) < 0) {
+	    opserr << "WARNING failed to read dof\n";
+	    return -1;
+	}
+	dof--;
+    }
+
+    ID tags(theDomain->getNumNodes());
+    NodeIter &theNodes = theDomain->getNodes();
+    Node *theNode;
+    int numNodes = 0;
+
+    while ((theNode = theNodes()) != 0)
+	tags[numNodes++] = theNode->getTag();
+
+    return setNodeResponseArray(tags, type, dof);
+}
+
+int OPS_nodeDispAll()
+{
+    return nodeResponseAll(Disp);
+}
+
+int OPS_nodeVelAll()
+{
+    return nodeResponseAll(Vel);
+}
+
+int OPS_nodeAccelAll()
+{
+    return nodeResponseAll(Accel);
+}
+
+// nodeDisp, nodeVel & nodeAccel given a list of tags <dof>
+static int nodeResponseList(NodeResponseType type, const char *cmd)
+{
+    ID tags;
+    int res = getTagListInput(tags);
+    if (res <= 0) {
+	if (res < 0)
+	    opserr << "WARNING " << cmd << " - failed to read node tags\n";
+	return res;
+    }
+
+    int dof = -1;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	int numdata = 1;
+	if (OPS_GetIntInput(&numdata, &dof) < 0) {
+	    opserr << "WARNING " << cmd << " - failed to read dof\n";
+	    return -1;
+	}
+	dof--;
+    }
+
+    if (setNodeResponseArray(tags, type, dof) < 0)
+	return -1;
+
+    return 1;
+}
+
 int OPS_nodeDisp()
 {
     if (OPS_GetNumRemainingInputArgs() < 1) {
@@ -195,6 +348,10 @@ int OPS_nodeDisp()
 	return -1;
     }
 
+    int bulk = nodeResponseList(Disp, "nodeDisp");
+    if (bulk != 0)
+	return (bulk < 0) ? -1 : 0;
+
     // tag and dof
     int data[2] = {0, -1};
     int numdata = OPS_GetNumRemainingInputArgs();
@@ -474,6 +631,50 @@ int OPS_eleResponse()
 	return -1;
     }
 
+    // a list of tags: one row per element, padded with zeros to the
+    // largest response
+    ID tags;
+    int bulk = getTagListInput(tags);
+    if (bulk < 0) {
+	opserr << "could not read eleTag\n";
+	return -1;
+    }
+    if (bulk > 0) {
+	numdata = OPS_GetNumRemainingInputArgs();
+	std::vector<char> buffer(numdata*128);
+	std::vector<const char*> argv(numdata);
+	for (int i=0; i<numdata; i++) {
+	    argv[i] = &buffer[i*128];
+	    OPS_GetStringFromAll(&buffer[i*128], 128);
+	}
+
+	int numEle = tags.Size();
+	std::vector<Vector> responses(numEle);
+	int numCols = 0;
+	for (int i=0; i<numEle; i++) {
+	    const Vector* data = theDomain->getElementResponse(tags(i), &argv[0], numdata);
+	    if (data != 0)
+		responses[i] = *data;
+	    if (responses[i].Size() > numCols)
+		numCols = responses[i].Size();
+	}
+
+	std::vector<double> values(numEle*numCols+1, 0.0);
+	for (int i=0; i<numEle; i++)
+	    for (int j=0; j<responses[i].Size(); j++)
+		values[i*numCols+j] = responses[i](j);
+
+	// no element had a response: an empty array
+	if (numCols == 0)
+	    numEle = 0;
+
+	if (OPS_SetDoubleArrayOutput(numEle, numCols, &values[0]) < 0) {
+	    opserr << "WARNING failed to set response\n";
+	    return -1;
+	}
+	return 0;
+    }
+
     int tag;
     numdata = 1;
     if (OPS_GetIntInput(&numdata, &tag) < 0) {
@@ -1354,6 +1555,10 @@ int OPS_nodeVel()
 	return -1;
     }
 
+    int bulk = nodeResponseList(Vel, "nodeVel");
+    if (bulk != 0)
+	return (bulk < 0) ? -1 : 0;
+
     int tag;
     int dof = -1;
     int numdata = 1;
@@ -1425,6 +1630,10 @@ int OPS_nodeAccel()
 	return -1;
     }
 
+    int bulk = nodeResponseList(Accel, "nodeAccel");
+    if (bulk != 0)
+	return (bulk < 0) ? -1 : 0;
+
     int tag;
     int dof = -1;
     int numdata = 1;
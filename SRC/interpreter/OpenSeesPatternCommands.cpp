@@ -72,6 +72,9 @@ void* OPS_LoadPattern();
 void* OPS_UniformExcitationPattern();
 void* OPS_MultiSupportPattern();
 void* OPS_TimeSeriesIntegrator();
+#ifdef _H5DRM
+void* OPS_H5DRMLoadPattern();
+#endif
 
 namespace {
     static LoadPattern* theActiveLoadPattern = 0;
@@ -111,6 +114,12 @@ int OPS_Pattern()
 	theActiveMultiSupportPattern = (MultiSupportPattern*)OPS_MultiSupportPattern();
 	pattern = theActiveMultiSupportPattern;
 
+#ifdef _H5DRM
+    } else if (strcmp(type, "H5DRM") == 0 || strcmp(type, "h5drm") == 0) {
+
+	pattern = (LoadPattern*)OPS_H5DRMLoadPattern();
+
+#endif
     } else {
 	opserr<<"WARNING unknown pattern type"<<type<<"\n";
 	return -1;
@@ -69,6 +69,8 @@ MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include <fstream>
 #include <vector>
+#include <CompiledEvaluator.h>
+#include <CachedEvaluator.h>
 #ifdef _PYTHON3
 #include <PythonEvaluator.h>
 #include <PythonRV.h>
@@ -90,6 +92,7 @@ MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <AllIndependentTransformation.h>
 #include <ArmijoStepSizeRule.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 #include <FiniteDifferenceGradient.h>
 #include <FixedStepSizeRule.h>
 #include <GradientProjectionSearchDirection.h>
@@ -158,6 +161,10 @@ Domain *OpenSeesReliabilityCommands::getStructuralDomain() {
     return theStructuralDomain;
 }
 
+void OpenSeesReliabilityCommands::setActive() {
+    cmds = this;
+}
+
 void OpenSeesReliabilityCommands::wipe() {
     // wipe reliability domain
     if (theDomain != 0) {
@@ -1737,13 +1744,17 @@ int OPS_randomNumberGenerator() {
 
     // Get the type of generator
     const char *type = OPS_GetString();
-    if (strcmp(type, "CStdLib") != 0) {
+    RandomNumberGenerator *theGenerator = 0;
+    if (strcmp(type, "CStdLib") == 0) {
+        theGenerator = new CStdLibRandGenerator();
+    } else if (strcmp(type, "Philox") == 0) {
+        theGenerator = new PhiloxRandGenerator();
+    } else {
         opserr << "ERROR: unrecognized type of RandomNumberGenerator "
                << type << endln;
         return -1;
     }
 
-    RandomNumberGenerator *theGenerator = new CStdLibRandGenerator();
     if (theGenerator == 0) {
         opserr << "ERROR: could not create randomNumberGenerator" << endln;
         return -1;
@@ -2597,11 +2608,46 @@ int OPS_functionEvaluator() {
     // Get the type of functionEvaluator
     const char *type = OPS_GetString();
     const char *filename = 0;
-    if (OPS_GetNumRemainingInputArgs() > 0) {
-        filename = OPS_GetString();
-        if (strcmp(filename, "-file") == 0 &&
-            OPS_GetNumRemainingInputArgs() > 0) {
-            filename = OPS_GetString();
+    bool cache = false;
+    double cacheTol = 0.0;
+    int maxPoints = 1000;
+    double errorTol = 0.0;
+    double lengthScale = 1.0;
+    int minPoints = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char *arg = OPS_GetString();
+        int numdata = 1;
+        if (strcmp(arg, "-file") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                filename = OPS_GetString();
+        } else if (strcmp(arg, "-cache") == 0) {
+            cache = true;
+            if (OPS_GetNumRemainingInputArgs() > 0 &&
+                OPS_GetDoubleInput(&numdata, &cacheTol) < 0)
+                OPS_ResetCurrentInputArg(-1);
+        } else if (strcmp(arg, "-maxPoints") == 0) {
+            cache = true;
+            if (OPS_GetIntInput(&numdata, &maxPoints) < 0) {
+                opserr << "ERROR: invalid input: -maxPoints n" << endln;
+                return -1;
+            }
+        } else if (strcmp(arg, "-surrogate") == 0) {
+            cache = true;
+            if (OPS_GetDoubleInput(&numdata, &errorTol) < 0) {
+                opserr << "ERROR: invalid input: -surrogate errorTol "
+                          "<lengthScale> <minPoints>"
+                       << endln;
+                return -1;
+            }
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                if (OPS_GetDoubleInput(&numdata, &lengthScale) < 0)
+                    OPS_ResetCurrentInputArg(-1);
+                else if (OPS_GetNumRemainingInputArgs() > 0 &&
+                         OPS_GetIntInput(&numdata, &minPoints) < 0)
+                    OPS_ResetCurrentInputArg(-1);
+            }
+        } else if (filename == 0) {
+            filename = arg;
         }
     }
     if (strcmp(type, "Matlab") == 0) {
@@ -2625,6 +2671,29 @@ int OPS_functionEvaluator() {
                << endln;
         return -1;
 #endif
+    } else if (strcmp(type, "Compiled") == 0) {
+        // the expressions are compiled, the analysis is still run by
+        // the interpreter
+        FunctionEvaluator *theAnalysisEval = 0;
+#ifdef _PYTHON3
+        if (filename == 0) {
+            theAnalysisEval = new PythonEvaluator(cmds->getDomain(),
+                                                  cmds->getStructuralDomain());
+        } else {
+            theAnalysisEval = new PythonEvaluator(
+                cmds->getDomain(), cmds->getStructuralDomain(), filename);
+        }
+#else
+        if (filename != 0) {
+            opserr << "ERROR: Compiled function evaluator -file needs the "
+                      "Python interpreter"
+                   << endln;
+            return -1;
+        }
+#endif
+        theEval = new CompiledEvaluator(cmds->getDomain(),
+                                        cmds->getStructuralDomain(),
+                                        theAnalysisEval);
     } else {
         opserr << "ERROR: unrecognized type of function evaluator: "
                << type << endln;
@@ -2634,10 +2703,22 @@ int OPS_functionEvaluator() {
     if (theEval == 0) {
         opserr << "ERROR: could not create function evaluator" << endln;
         return -1;
-    } else {
-        cmds->setFunctionEvaluator(theEval);
     }
 
+    if (cache) {
+        CachedEvaluator *theCache =
+            new CachedEvaluator(cmds->getDomain(), cmds->getStructuralDomain(),
+                                theEval, cacheTol, maxPoints);
+        theEval = theCache;
+        if (errorTol > 0.0 &&
+            theCache->setSurrogate(errorTol, lengthScale, minPoints) < 0) {
+            delete theEval;
+            return -1;
+        }
+    }
+
+    cmds->setFunctionEvaluator(theEval);
+
     return 0;
 }
 
@@ -2655,10 +2736,23 @@ int OPS_gradientEvaluator() {
     const char *type = OPS_GetString();
     if (strcmp(type, "FiniteDifference") == 0) {
         double perturbationFactor = 1000.0;
+        int scheme = FiniteDifferenceGradient::Forward;
+        bool autoStep = false;
+        bool distributed = false;
         // bool doGradientCheck = false;
         while (OPS_GetNumRemainingInputArgs() > 0) {
             const char *arg = OPS_GetString();
             int numdata = 1;
+            if (strcmp(arg, "-forward") == 0)
+                scheme = FiniteDifferenceGradient::Forward;
+            if (strcmp(arg, "-backward") == 0)
+                scheme = FiniteDifferenceGradient::Backward;
+            if (strcmp(arg, "-central") == 0)
+                scheme = FiniteDifferenceGradient::Central;
+            if (strcmp(arg, "-auto") == 0)
+                autoStep = true;
+            if (strcmp(arg, "-distributed") == 0)
+                distributed = true;
             if (strcmp(arg, "-pert") == 0 &&
                 OPS_GetNumRemainingInputArgs() > 0) {
                 if (OPS_GetDoubleInput(&numdata, &perturbationFactor) <
@@ -2684,7 +2778,8 @@ int OPS_gradientEvaluator() {
         }
 
         theEval = new FiniteDifferenceGradient(theEvaluator, theRelDomain,
-                                               theStrDomain);
+                                               theStrDomain, scheme, autoStep,
+                                               distributed);
     } else if (strcmp(type, "OpenSees") == 0 ||
                strcmp(type, "Implicit") == 0) {
         // bool doGradientCheck = false;
@@ -3002,6 +3097,104 @@ int OPS_runFORMAnalysis() {
     return 0;
 }
 
+// runParametricReliabilityAnalysis fileName -par tag -range first last -numInt n
+//     <-workers w> <-noWarmStart>
+int OPS_runParametricReliabilityAnalysis() {
+    if (OPS_GetNumRemainingInputArgs() < 8) {
+        opserr << "WARNING: Wrong number of input parameter to parametric "
+                  "reliability analysis\n";
+        opserr << "Want: runParametricReliabilityAnalysis fileName -par tag "
+                  "-range first last -numInt n <-workers w> <-noWarmStart>\n";
+        return -1;
+    }
+
+    // get file name
+    const char *filename = OPS_GetString();
+
+    ReliabilityDomain *theReliabilityDomain = cmds->getDomain();
+    if (theReliabilityDomain == 0) {
+        opserr << "ParametricReliabilityAnalysis -- ReliabilityDomain is not defined\n";
+        return -1;
+    }
+
+    FindDesignPointAlgorithm *theFindDesignPointAlgorithm =
+        cmds->getFindDesignPointAlgorithm();
+    if (theFindDesignPointAlgorithm == 0) {
+        opserr << "Need theFindDesignPointAlgorithm before a "
+                  "ParametricReliabilityAnalysis can be created\n";
+        return -1;
+    }
+
+    Domain *theStructuralDomain = cmds->getStructuralDomain();
+    if (theStructuralDomain == 0) {
+        opserr << "Structural Domain is not defined\n";
+        return -1;
+    }
+
+    int parameterTag = 0;
+    double range[2] = {0.0, 0.0};
+    int numIntervals = 0;
+    int numWorkers = 1;
+    bool warmStart = true;
+    bool parGiven = false;
+    bool rangeGiven = false;
+    bool numIntGiven = false;
+    int numdata = 1;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char *type = OPS_GetString();
+        if (strcmp(type, "-par") == 0) {
+            if (OPS_GetIntInput(&numdata, &parameterTag) < 0) {
+                opserr << "ERROR: invalid input: parameter tag \n";
+                return -1;
+            }
+            parGiven = true;
+        } else if (strcmp(type, "-range") == 0) {
+            numdata = 2;
+            if (OPS_GetDoubleInput(&numdata, range) < 0) {
+                opserr << "ERROR: invalid input: range \n";
+                return -1;
+            }
+            numdata = 1;
+            rangeGiven = true;
+        } else if (strcmp(type, "-numInt") == 0 || strcmp(type, "-num") == 0) {
+            if (OPS_GetIntInput(&numdata, &numIntervals) < 0 || numIntervals < 1) {
+                opserr << "ERROR: invalid input: number of intervals \n";
+                return -1;
+            }
+            numIntGiven = true;
+        } else if (strcmp(type, "-workers") == 0) {
+            if (OPS_GetIntInput(&numdata, &numWorkers) < 0) {
+                opserr << "ERROR: invalid input: number of workers \n";
+                return -1;
+            }
+        } else if (strcmp(type, "-noWarmStart") == 0) {
+            warmStart = false;
+        } else {
+            opserr << "ERROR: Invalid input to ParametricReliabilityAnalysis: "
+                   << type << endln;
+            return -1;
+        }
+    }
+
+    if (!parGiven || !rangeGiven || !numIntGiven) {
+        opserr << "ERROR: some input to ParametricReliabilityAnalysis was not provided\n";
+        return -1;
+    }
+
+    ParametricReliabilityAnalysis theAnalysis(
+        theReliabilityDomain, theStructuralDomain, theFindDesignPointAlgorithm,
+        parameterTag, range[0], range[1], numIntervals, filename,
+        numWorkers, warmStart);
+
+    if (theAnalysis.analyze() < 0) {
+        opserr << "WARNING: the parametric reliability analysis failed\n";
+        return -1;
+    }
+
+    return 0;
+}
+
 int OPS_runSORMAnalysis() {
     if (OPS_GetNumRemainingInputArgs() < 1) {
         opserr << "WARNING: Wrong number of input parameter to SORM "
@@ -3138,6 +3331,10 @@ int OPS_runImportanceSamplingAnalysis() {
     //     default -print 1   (print to screen) -print 2   (print
     //     to restart file)
     //
+    //     -distributed 0  ...................... this is the
+    //     default -distributed 1 (share the samples among the
+    //     parallel processes)
+    //
 
     // Declaration of input parameters
     long int numberOfSimulations = 1000;
@@ -3145,6 +3342,7 @@ int OPS_runImportanceSamplingAnalysis() {
     double samplingVariance = 1.0;
     int printFlag = 0;
     int analysisTypeTag = 1;
+    int distributed = 0;
 
     while (OPS_GetNumRemainingInputArgs() > 1) {
         const char *type = OPS_GetString();
@@ -3211,6 +3409,13 @@ int OPS_runImportanceSamplingAnalysis() {
                 return -1;
             }
 
+        } else if (strcmp(type, "-distributed") == 0) {
+            int numdata = 1;
+            if (OPS_GetIntInput(&numdata, &distributed) < 0) {
+                opserr << "ERROR: invalid input: distributed \n";
+                return -1;
+            }
+
         } else {
             opserr << "ERROR: invalid input to sampling analysis. \n";
             return -1;
@@ -3231,7 +3436,8 @@ int OPS_runImportanceSamplingAnalysis() {
             theReliabilityDomain, theStructuralDomain,
             theProbabilityTransformation, theFunctionEvaluator,
             theRandomNumberGenerator, 0, numberOfSimulations, targetCOV,
-            samplingVariance, printFlag, filename, analysisTypeTag);
+            samplingVariance, printFlag, filename, analysisTypeTag,
+            distributed != 0);
 
     if (theImportanceSamplingAnalysis == 0) {
       opserr << "Unable to create ImportanceSampling analysis" << endln;
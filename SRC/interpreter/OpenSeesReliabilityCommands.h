@@ -54,6 +54,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <FORMAnalysis.h>
 #include <SORMAnalysis.h>
 #include <FOSMAnalysis.h>
+#include <ParametricReliabilityAnalysis.h>
 #include <FindDesignPointAlgorithm.h>
 #include <FindCurvatures.h>
 #include <FunctionEvaluator.h>
@@ -80,6 +81,9 @@ class OpenSeesReliabilityCommands {
   ReliabilityDomain *getDomain();
   Domain *getStructuralDomain();
 
+  // makes this the object the reliability commands work on
+  void setActive();
+
   void setProbabilityTransformation(
       ProbabilityTransformation *transform);
   ProbabilityTransformation *getProbabilityTransformation() {
@@ -46,6 +46,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <OPS_Globals.h>
 #include <cstring>
 #include <cctype>
+#include <stdint.h>
 
 // define opserr
 static PythonStream sserr;
@@ -220,6 +221,52 @@ int PythonModule::getDoubleList(int* size, Vector* data)
             }
         }
     }
+    else if (PyObject_CheckBuffer(o)) {
+        // numpy arrays & other objects exposing the buffer protocol are
+        // read in place, without a Python object per item
+        Py_buffer view;
+        if (PyObject_GetBuffer(o, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            PyErr_Clear();
+            opserr << "PythonModule::getDoubleList error: array is not contiguous\n";
+            return -1;
+        }
+
+        const char* fmt = (view.format != 0) ? view.format : "B";
+        if (*fmt == '@' || *fmt == '=' || *fmt == '<')
+            fmt++;
+
+        *size = int(view.len / view.itemsize);
+        data->resize(*size);
+
+        int res = 0;
+        if (*fmt == 'd' && view.itemsize == sizeof(double)) {
+            const double* values = (const double*)view.buf;
+            for (int i = 0; i < *size; i++)
+                (*data)(i) = values[i];
+        }
+        else if (*fmt == 'f' && view.itemsize == sizeof(float)) {
+            const float* values = (const float*)view.buf;
+            for (int i = 0; i < *size; i++)
+                (*data)(i) = values[i];
+        }
+        else if ((*fmt == 'i' || *fmt == 'l' || *fmt == 'q') && view.itemsize == 4) {
+            const int32_t* values = (const int32_t*)view.buf;
+            for (int i = 0; i < *size; i++)
+                (*data)(i) = values[i];
+        }
+        else if ((*fmt == 'i' || *fmt == 'l' || *fmt == 'q') && view.itemsize == 8) {
+            const int64_t* values = (const int64_t*)view.buf;
+            for (int i = 0; i < *size; i++)
+                (*data)(i) = double(values[i]);
+        }
+        else {
+            opserr << "PythonModule::getDoubleList error: unsupported array type " << view.format << "\n";
+            res = -1;
+        }
+
+        PyBuffer_Release(&view);
+        return res;
+    }
     else {
       // Removing this error message for Path series list inputs -- MHS
       //opserr << "PythonModule::getDoubleList error: input is neither a list nor a tuple\n";
@@ -411,6 +458,11 @@ int PythonModule::setDouble(std::map<const char*, std::vector<double>>& data) {
     return 0;
 }
 
+int PythonModule::setDoubleArray(double *data, int numRows, int numCols) {
+    wrapper.setArrayOutputs(data, numRows, numCols);
+    return 0;
+}
+
 int
 PythonModule::setString(const char *str) {
     wrapper.setOutputs(str);
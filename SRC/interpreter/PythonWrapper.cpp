@@ -42,6 +42,10 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "PythonWrapper.h"
 #include "OpenSeesCommands.h"
 #include <OPS_Globals.h>
+#include <ID.h>
+#include <Node.h>
+#include <UserBatchElement.h>
+#include <string.h>
 
 #define OPS_PYVERSION "3.4.0.4"
 
@@ -232,6 +236,56 @@ void PythonWrapper::setOutputs(std::map<const char*, std::vector<const char*>>&
     currentResult = dict;
 }
 
+// a memoryview of a new block of numRows x numCols doubles, row major, or
+// of numRows doubles if numCols is 0, which numpy.asarray() wraps without
+// a copy; values is set to the block
+static PyObject*
+newDoubleView(int numRows, int numCols, double** values)
+{
+    if (numRows < 0) numRows = 0;
+    if (numCols < 0) numCols = 0;
+
+    Py_ssize_t numValues = (numCols > 0) ? (Py_ssize_t)numRows*numCols : numRows;
+    PyObject* bytes = PyByteArray_FromStringAndSize(NULL, numValues*sizeof(double));
+    if (bytes == 0)
+	return 0;
+    *values = (double*)PyByteArray_AS_STRING(bytes);
+
+    PyObject* view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (view == 0)
+	return 0;
+
+    // memoryview can not have a 0 in its shape
+    PyObject* result;
+    if (numCols > 0 && numRows > 0)
+	result = PyObject_CallMethod(view, "cast", "s(nn)", "d",
+				     (Py_ssize_t)numRows, (Py_ssize_t)numCols);
+    else
+	result = PyObject_CallMethod(view, "cast", "s", "d");
+    Py_DECREF(view);
+
+    return result;
+}
+
+void
+PythonWrapper::setArrayOutputs(double* data, int numRows, int numCols)
+{
+    int numValues = (numCols > 0) ? numRows*numCols : numRows;
+    if (numValues < 0) numValues = 0;
+
+    double* values = 0;
+    currentResult = newDoubleView(numRows, numCols, &values);
+    if (currentResult == 0) {
+	PyErr_Clear();
+	setOutputs(data, numValues, false);
+	return;
+    }
+
+    if (numValues > 0)
+	memcpy(values, data, numValues*sizeof(double));
+}
+
 PyObject*
 PythonWrapper::getResults()
 {
@@ -357,6 +411,18 @@ static PyObject *Py_ops_wipeReliability(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_modelContext(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_modelContext() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_model(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -381,6 +447,18 @@ static PyObject *Py_ops_node(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_nodes(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_Nodes() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_fix(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -405,6 +483,18 @@ static PyObject *Py_ops_element(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_elements(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_Elements() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_timeSeries(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -501,6 +591,57 @@ static PyObject *Py_ops_algorithm(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_retryPolicy(PyObject *self, PyObject *args)
+{
+    // the -algorithm and -test lists are read as algorithm and test
+    // commands for the rung, the other arguments by retryPolicy
+    Py_ssize_t numArgs = PyTuple_Size(args);
+    PyObject *opts = PyList_New(0);
+    for (Py_ssize_t i = 0; i < numArgs; i++) {
+	PyObject *o = PyTuple_GetItem(args, i);
+	const char *opt = PyUnicode_Check(o) ? PyUnicode_AsUTF8(o) : 0;
+	bool isAlgo = opt != 0 && strcmp(opt, "-algorithm") == 0;
+	bool isTest = opt != 0 && strcmp(opt, "-test") == 0;
+	if (!isAlgo && !isTest) {
+	    PyList_Append(opts, o);
+	    continue;
+	}
+
+	// a missing list is an empty command, which the command reports
+	PyObject *cmd = 0;
+	if (i+1 < numArgs) {
+	    PyObject *list = PyTuple_GetItem(args, ++i);
+	    if (PyList_Check(list) || PyTuple_Check(list))
+		cmd = PySequence_Tuple(list);
+	    else if (PyUnicode_Check(list))
+		cmd = PyTuple_Pack(1, list);
+	}
+	if (cmd == 0)
+	    cmd = PyTuple_New(0);
+
+	wrapper->resetCommandLine(PyTuple_Size(cmd), 1, cmd);
+	int res = OPS_RetryRung(isAlgo);
+	Py_DECREF(cmd);
+	if (res < 0) {
+	    Py_DECREF(opts);
+	    opserr<<(void*)0;
+	    return NULL;
+	}
+    }
+
+    PyObject *rest = PyList_AsTuple(opts);
+    Py_DECREF(opts);
+    wrapper->resetCommandLine(PyTuple_Size(rest), 1, rest);
+    int res = OPS_RetryPolicy();
+    Py_DECREF(rest);
+    if (res < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_analysis(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -513,8 +654,152 @@ static PyObject *Py_ops_analysis(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+// analyze(numIncr, <dt>, '-callback', every, fn, <'-nodes', tags>)
+struct StepCallbackData {
+    PyObject* fn;
+    PyObject* view;       // displacements of the nodes, one row per node
+    double* values;
+    ID tags;
+    int numCols;
+};
+
+// fn(step, time) or fn(step, time, disp): None, True or 0 to go on, a
+// float for the dt of the next steps, False or another int to stop
+static int stepCallback(int step, double &dt, void *data)
+{
+    StepCallbackData* cb = (StepCallbackData*)data;
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) return -1;
+
+    // the same view is refilled for every call
+    if (cb->view != 0) {
+	int numNodes = cb->tags.Size();
+	for (int i = 0; i < numNodes; i++) {
+	    double* row = cb->values + i*cb->numCols;
+	    for (int j = 0; j < cb->numCols; j++)
+		row[j] = 0.0;
+	    const Vector* disp = theDomain->getNodeResponse(cb->tags(i), Disp);
+	    if (disp == 0) continue;
+	    for (int j = 0; j < disp->Size() && j < cb->numCols; j++)
+		row[j] = (*disp)(j);
+	}
+    }
+
+    double time = theDomain->getCurrentTime();
+    PyObject* res;
+    if (cb->view != 0)
+	res = PyObject_CallFunction(cb->fn, "idO", step, time, cb->view);
+    else
+	res = PyObject_CallFunction(cb->fn, "id", step, time);
+    if (res == 0)
+	return -1;
+
+    int control = 0;
+    if (res == Py_None || res == Py_True) {
+	control = 0;
+    } else if (res == Py_False) {
+	control = 1;
+    } else if (PyFloat_Check(res)) {
+	double newDt = PyFloat_AsDouble(res);
+	if (newDt > 0.0)
+	    dt = newDt;
+	else
+	    control = 1;
+    } else if (PyLong_Check(res)) {
+	control = (PyLong_AsLong(res) == 0) ? 0 : 1;
+    }
+    Py_DECREF(res);
+
+    return control;
+}
+
+static PyObject *Py_ops_analyzeCallback(PyObject *args, int loc)
+{
+    int numArgs = (int)PyTuple_Size(args);
+    if (loc+2 >= numArgs) {
+	PyErr_SetString(PyExc_RuntimeError, "WARNING want - analyze numIncr <dt> -callback every fn <-nodes tags>");
+	return NULL;
+    }
+
+    // the arguments before -callback
+    wrapper->resetCommandLine(loc, 1, args);
+    int numIncr;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &numIncr) < 0) {
+	PyErr_SetString(PyExc_RuntimeError, "WARNING: invalid numIncr");
+	return NULL;
+    }
+    double dt = 0.0;
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetDoubleInput(&numdata, &dt) < 0) {
+	    PyErr_SetString(PyExc_RuntimeError, "WARNING: invalid dt");
+	    return NULL;
+	}
+    }
+
+    StepCallbackData cb;
+    cb.view = 0;
+    cb.values = 0;
+    cb.numCols = 0;
+
+    int every = (int)PyLong_AsLong(PyTuple_GetItem(args, loc+1));
+    if (PyErr_Occurred())
+	return NULL;
+    cb.fn = PyTuple_GetItem(args, loc+2);
+    if (!PyCallable_Check(cb.fn)) {
+	PyErr_SetString(PyExc_RuntimeError, "WARNING analyze -callback: fn is not callable");
+	return NULL;
+    }
+
+    if (loc+3 < numArgs) {
+	wrapper->resetCommandLine(numArgs, loc+4, args);
+	const char* opt = OPS_GetString();
+	Vector tags;
+	int numNodes = 0;
+	if (opt == 0 || strcmp(opt, "-nodes") != 0 ||
+	    OPS_GetDoubleListInput(&numNodes, &tags) < 0) {
+	    PyErr_SetString(PyExc_RuntimeError, "WARNING analyze -callback: want -nodes tags");
+	    return NULL;
+	}
+
+	Domain* theDomain = OPS_GetDomain();
+	if (theDomain == 0)
+	    return NULL;
+	cb.tags.resize(numNodes);
+	for (int i = 0; i < numNodes; i++) {
+	    cb.tags(i) = (int)tags(i);
+	    Node* theNode = theDomain->getNode(cb.tags(i));
+	    if (theNode != 0 && theNode->getNumberDOF() > cb.numCols)
+		cb.numCols = theNode->getNumberDOF();
+	}
+	if (cb.numCols == 0)
+	    cb.numCols = 1;
+
+	cb.view = newDoubleView(numNodes, cb.numCols, &cb.values);
+	if (cb.view == 0)
+	    return NULL;
+    }
+
+    int result = OPS_analyzeSteps(numIncr, dt, every, stepCallback, &cb);
+    Py_XDECREF(cb.view);
+
+    // an exception raised by the callback
+    if (PyErr_Occurred())
+	return NULL;
+
+    return Py_BuildValue("i", result);
+}
+
 static PyObject *Py_ops_analyze(PyObject *self, PyObject *args)
 {
+    // the steps stay in C++ when there is a callback
+    int numArgs = (int)PyTuple_Size(args);
+    for (int i = 0; i < numArgs; i++) {
+	PyObject* o = PyTuple_GetItem(args, i);
+	if (PyUnicode_Check(o) && strcmp(PyUnicode_AsUTF8(o), "-callback") == 0)
+	    return Py_ops_analyzeCallback(args, i);
+    }
+
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
     if (OPS_analyze() < 0) {
@@ -525,6 +810,113 @@ static PyObject *Py_ops_analyze(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+// a memoryview of numRows x numCols (x numPages) doubles at values, row
+// major, only valid during the call it is made for
+static PyObject*
+wrapDoubleView(double* values, int numRows, int numCols, int numPages, bool writable)
+{
+    static double empty = 0.0;
+    Py_ssize_t numValues = (Py_ssize_t)numRows*numCols*(numPages > 0 ? numPages : 1);
+    if (numValues <= 0 || values == 0) {
+	values = &empty;
+	numValues = 0;
+    }
+
+    PyObject* view = PyMemoryView_FromMemory((char*)values, numValues*sizeof(double),
+					     writable ? PyBUF_WRITE : PyBUF_READ);
+    if (view == 0)
+	return 0;
+
+    // memoryview can not have a 0 in its shape
+    PyObject* result;
+    if (numValues == 0)
+	result = PyObject_CallMethod(view, "cast", "s", "d");
+    else if (numPages > 0)
+	result = PyObject_CallMethod(view, "cast", "s(nnn)", "d", (Py_ssize_t)numRows,
+				     (Py_ssize_t)numCols, (Py_ssize_t)numPages);
+    else
+	result = PyObject_CallMethod(view, "cast", "s(nn)", "d", (Py_ssize_t)numRows,
+				     (Py_ssize_t)numCols);
+    Py_DECREF(view);
+
+    return result;
+}
+
+// fn(x, u, state, K, P) of userElementType, called for all the elements of
+// the type; it fills K and P in place, and leaves the trial state in state.
+// None, True or 0 if all went well
+static int userBatchCallback(int numEle, int numCrd, int numDOF, int numState,
+			     const double* x, const double* u, double* state,
+			     double* K, double* P, void* data)
+{
+    PyObject* fn = (PyObject*)data;
+
+    PyObject* views[5];
+    views[0] = wrapDoubleView((double*)x, numEle, numCrd, 0, false);
+    views[1] = wrapDoubleView((double*)u, numEle, numDOF, 0, false);
+    views[2] = wrapDoubleView(state, numEle, numState, 0, true);
+    views[3] = wrapDoubleView(K, numEle, numDOF, numDOF, true);
+    views[4] = wrapDoubleView(P, numEle, numDOF, 0, true);
+
+    PyObject* res = 0;
+    if (views[0] != 0 && views[1] != 0 && views[2] != 0 && views[3] != 0 && views[4] != 0)
+	res = PyObject_CallFunctionObjArgs(fn, views[0], views[1], views[2], views[3], views[4], NULL);
+
+    // the arrays go away after the call
+    for (int i = 0; i < 5; i++) {
+	if (views[i] == 0) continue;
+	PyObject* rel = PyObject_CallMethod(views[i], "release", NULL);
+	if (rel == 0)
+	    PyErr_Clear();
+	Py_XDECREF(rel);
+	Py_DECREF(views[i]);
+    }
+
+    if (res == 0) {
+	PyErr_Print();
+	return -1;
+    }
+
+    int control = 0;
+    if (res == Py_False)
+	control = -1;
+    else if (PyLong_Check(res) && res != Py_True)
+	control = (PyLong_AsLong(res) == 0) ? 0 : -1;
+    Py_DECREF(res);
+
+    return control;
+}
+
+static void userBatchRelease(void* data)
+{
+    Py_XDECREF((PyObject*)data);
+}
+
+// userElementType(typeTag, numState, fn), fn(x, u, state, K, P) for all the
+// 'userBatch' elements of the type at once
+static PyObject *Py_ops_userElementType(PyObject *self, PyObject *args)
+{
+    int typeTag, numState;
+    PyObject* fn;
+    if (!PyArg_ParseTuple(args, "iiO", &typeTag, &numState, &fn))
+	return NULL;
+
+    if (!PyCallable_Check(fn)) {
+	PyErr_SetString(PyExc_RuntimeError, "WARNING userElementType: fn is not callable");
+	return NULL;
+    }
+
+    Py_INCREF(fn);
+    if (UserBatchElement::setTypeFunction(typeTag, numState, userBatchCallback, fn, userBatchRelease) < 0) {
+	Py_DECREF(fn);
+	PyErr_SetString(PyExc_RuntimeError, "WARNING userElementType: could not set the function");
+	return NULL;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *Py_ops_test(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -700,6 +1092,26 @@ static PyObject* Py_ops_responseSpectrumAnalysis(PyObject* self, PyObject* args)
     return wrapper->getResults();
 }
 
+static PyObject* Py_ops_modalTransient(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+    if (OPS_ModalTransientAnalysis() < 0) {
+        opserr<<(void*)0;
+        return NULL;
+    }
+    return wrapper->getResults();
+}
+
+static PyObject* Py_ops_frequencyAnalysis(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+    if (OPS_FrequencyDomainAnalysis() < 0) {
+        opserr<<(void*)0;
+        return NULL;
+    }
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_nDMaterial(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -1060,6 +1472,18 @@ static PyObject *Py_ops_database(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_checkpoint(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_checkpoint() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_save(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -1216,6 +1640,42 @@ static PyObject *Py_ops_nodeAccel(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_nodeDispAll(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_nodeDispAll() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_nodeVelAll(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_nodeVelAll() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_nodeAccelAll(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_nodeAccelAll() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_setNodeAccel(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -1504,6 +1964,42 @@ static PyObject *Py_ops_stopTimer(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_profile(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_profile() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_metrics(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_metrics() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_memoryReport(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_memoryReport() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_modalDamping(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -1949,6 +2445,30 @@ static PyObject *Py_ops_systemSize(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_influenceMatrix(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_influenceMatrix() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_numFactorizations(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_numFactorizations() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_version(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2751,6 +3271,18 @@ static PyObject *Py_ops_sdfResponse(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_sdfSpectra(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_sdfSpectra() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_getNumThreads(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2775,6 +3307,66 @@ static PyObject *Py_ops_setNumThreads(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_setParallelUpdate(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_setParallelUpdate() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_logWarnings(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_logWarnings() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_setGeometryCache(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_setGeometryCache() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_benchMaterial(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_benchMaterial() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_benchElement(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_benchElement() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_logFile(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -2859,6 +3451,18 @@ static PyObject *Py_ops_partition(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_setPartition(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_setPartition() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_pc(PyObject *self, PyObject *args) {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
@@ -2927,6 +3531,17 @@ static PyObject *Py_ops_runFORMAnalysis(PyObject *self, PyObject *args) {
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_runParametricReliabilityAnalysis(PyObject *self, PyObject *args) {
+    wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
+
+    if (OPS_runParametricReliabilityAnalysis() < 0) {
+        opserr << (void *)0;
+        return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_runSORMAnalysis(PyObject *self, PyObject *args) {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
@@ -2996,10 +3611,13 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("getTangent", &Py_ops_getTangent);
     addCommand("getDampTangent", &Py_ops_getDampTangent);
     addCommand("wipe", &Py_ops_wipe);
+    addCommand("modelContext", &Py_ops_modelContext);
     addCommand("model", &Py_ops_model);
     addCommand("node", &Py_ops_node);
+    addCommand("nodes", &Py_ops_nodes);
     addCommand("fix", &Py_ops_fix);
     addCommand("element", &Py_ops_element);
+    addCommand("elements", &Py_ops_elements);
     addCommand("timeSeries", &Py_ops_timeSeries);
     addCommand("pattern", &Py_ops_pattern);
     addCommand("load", &Py_ops_nodalLoad);
@@ -3008,8 +3626,10 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("constraints", &Py_ops_constraints);
     addCommand("integrator", &Py_ops_integrator);
     addCommand("algorithm", &Py_ops_algorithm);
+    addCommand("retryPolicy", &Py_ops_retryPolicy);
     addCommand("analysis", &Py_ops_analysis);
     addCommand("analyze", &Py_ops_analyze);
+    addCommand("userElementType", &Py_ops_userElementType);
     addCommand("test", &Py_ops_test);
     addCommand("section", &Py_ops_section);
     addCommand("fiber", &Py_ops_fiber);
@@ -3025,6 +3645,8 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("eigen", &Py_ops_eigen);
     addCommand("modalProperties", &Py_ops_modalProperties);
     addCommand("responseSpectrumAnalysis", &Py_ops_responseSpectrumAnalysis);
+    addCommand("modalTransient", &Py_ops_modalTransient);
+    addCommand("frequencyAnalysis", &Py_ops_frequencyAnalysis);
     addCommand("nDMaterial", &Py_ops_nDMaterial);
     addCommand("block2D", &Py_ops_block2d);
     addCommand("block3D", &Py_ops_block3d);
@@ -3056,6 +3678,7 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("testIter", &Py_ops_getCTestIter);
     addCommand("recorder", &Py_ops_recorder);
     addCommand("database", &Py_ops_database);
+    addCommand("checkpoint", &Py_ops_checkpoint);
     addCommand("save", &Py_ops_save);
     addCommand("restore", &Py_ops_restore);
     addCommand("eleForce", &Py_ops_eleForce);
@@ -3068,6 +3691,9 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("nodeVel", &Py_ops_nodeVel);
     addCommand("setNodeVel", &Py_ops_setNodeVel);
     addCommand("nodeAccel", &Py_ops_nodeAccel);
+    addCommand("nodeDispAll", &Py_ops_nodeDispAll);
+    addCommand("nodeVelAll", &Py_ops_nodeVelAll);
+    addCommand("nodeAccelAll", &Py_ops_nodeAccelAll);
     addCommand("setNodeAccel", &Py_ops_setNodeAccel);
     addCommand("nodeResponse", &Py_ops_nodeResponse);
     addCommand("nodeCoord", &Py_ops_nodeCoord);
@@ -3092,6 +3718,9 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("nodeBounds", &Py_ops_nodeBounds);
     addCommand("start", &Py_ops_startTimer);
     addCommand("stop", &Py_ops_stopTimer);
+    addCommand("profile", &Py_ops_profile);
+    addCommand("metrics", &Py_ops_metrics);
+    addCommand("memoryReport", &Py_ops_memoryReport);
     addCommand("modalDamping", &Py_ops_modalDamping);
     addCommand("modalDampingQ", &Py_ops_modalDampingQ);
     addCommand("setElementRayleighDampingFactors", &Py_ops_setElementRayleighDampingFactors);
@@ -3129,6 +3758,8 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("numFact", &Py_ops_numFact);
     addCommand("numIter", &Py_ops_numIter);
     addCommand("systemSize", &Py_ops_systemSize);
+    addCommand("numFactorizations", &Py_ops_numFactorizations);
+    addCommand("influenceMatrix", &Py_ops_influenceMatrix);
     addCommand("version", &Py_ops_version);
     addCommand("pyversion", &Py_ops_pyversion);
     addCommand("setMaxOpenFiles", &Py_ops_setMaxOpenFiles);
@@ -3188,6 +3819,7 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("wipeReliability", &Py_ops_wipeReliability);
     addCommand("updateMaterialStage", &Py_ops_updateMaterialStage);
     addCommand("sdfResponse", &Py_ops_sdfResponse);
+    addCommand("sdfSpectra", &Py_ops_sdfSpectra);
     addCommand("probabilityTransformation", &Py_ops_probabilityTransformation);
     addCommand("startPoint", &Py_ops_startPoint);
     addCommand("randomNumberGenerator", &Py_ops_randomNumberGenerator);
@@ -3200,6 +3832,11 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("gradientEvaluator", &Py_ops_gradientEvaluator);
     addCommand("getNumThreads", &Py_ops_getNumThreads);
     addCommand("setNumThreads", &Py_ops_setNumThreads);
+    addCommand("setParallelUpdate", &Py_ops_setParallelUpdate);
+    addCommand("setGeometryCache", &Py_ops_setGeometryCache);
+    addCommand("logWarnings", &Py_ops_logWarnings);
+    addCommand("benchMaterial", &Py_ops_benchMaterial);
+    addCommand("benchElement", &Py_ops_benchElement);
     addCommand("logFile", &Py_ops_logFile);
     addCommand("setStartNodeTag", &Py_ops_setStartNodeTag);
     addCommand("hystereticBackbone", &Py_ops_hystereticBackbone);
@@ -3208,12 +3845,14 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("strengthControl", &Py_ops_strengthDegradation);    
     addCommand("unloadingRule", &Py_ops_unloadingRule);
     addCommand("partition", &Py_ops_partition);
+    addCommand("setPartition", &Py_ops_setPartition);
     addCommand("pressureConstraint", &Py_ops_pc);
     addCommand("domainCommitTag", &Py_ops_domainCommitTag);
     addCommand("runFOSMAnalysis", &Py_ops_runFOSMAnalysis);
     addCommand("findDesignPoint", &Py_ops_findDesignPoint);
     addCommand("findCurvatures", &Py_ops_findCurvatures);
     addCommand("runFORMAnalysis", &Py_ops_runFORMAnalysis);
+    addCommand("runParametricReliabilityAnalysis", &Py_ops_runParametricReliabilityAnalysis);
     addCommand("runSORMAnalysis", &Py_ops_runSORMAnalysis);    
     addCommand("getLSFTags", &Py_ops_getLSFTags);
     addCommand("runImportanceSamplingAnalysis", &Py_ops_runImportanceSamplingAnalysis);
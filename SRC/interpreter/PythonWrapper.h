@@ -88,6 +88,7 @@ public:
     void setOutputs(std::vector<std::vector<const char*>> &data);
     void setOutputs(std::map<const char*, const char*>& data);
     void setOutputs(std::map<const char*, std::vector<const char*>>& data);
+    void setArrayOutputs(double* data, int numRows, int numCols);
     PyObject* getResults();
 
 private:
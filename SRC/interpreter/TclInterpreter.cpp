@@ -65,6 +65,7 @@ terms specified in this license.
 #include "TclInterpreter.h"
 #include <string.h>
 #include <StandardStream.h>
+#include <Vector.h>
 
 StandardStream sserr;
 OPS_Stream *opserrPtr = &sserr;
@@ -541,6 +542,35 @@ TclInterpreter::getDouble(double *data, int numArgs) {
     return 0;
 }
 
+// the list is a single Tcl list argument, e.g. [list 1 2 3] or $coords
+int
+TclInterpreter::getDoubleList(int* size, Vector* data) {
+
+    if (wrapper.getCurrentArg() >= wrapper.getNumberArgs()) {
+	return -1;
+    }
+
+    int argc;
+    const char **argv;
+    if (Tcl_SplitList(interp, wrapper.getCurrentArgv()[wrapper.getCurrentArg()],
+		      &argc, &argv) != TCL_OK) {
+	return -1;
+    }
+    wrapper.incrCurrentArg();
+
+    *size = argc;
+    data->resize(argc);
+    for (int i=0; i<argc; i++) {
+	if (Tcl_GetDouble(interp, argv[i], &(*data)(i)) != TCL_OK) {
+	    Tcl_Free((char *)argv);
+	    return -1;
+	}
+    }
+
+    Tcl_Free((char *)argv);
+    return 0;
+}
+
 const char*
 TclInterpreter::getString() {
 
@@ -181,6 +181,14 @@ static int Tcl_ops_node(ClientData clientData, Tcl_Interp *interp, int argc,   T
     return TCL_OK;
 }
 
+static int Tcl_ops_nodes(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_Nodes() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_fix(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -197,6 +205,14 @@ static int Tcl_ops_element(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_elements(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_Elements() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_timeSeries(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -421,6 +437,14 @@ static int Tcl_ops_wipeAnalysis(ClientData clientData, Tcl_Interp *interp, int a
     return TCL_OK;
 }
 
+static int Tcl_ops_modelContext(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_modelContext() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_setTime(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -613,6 +637,14 @@ static int Tcl_ops_database(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+static int Tcl_ops_checkpoint(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_checkpoint() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_record(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -693,6 +725,30 @@ static int Tcl_ops_nodeAccel(ClientData clientData, Tcl_Interp *interp, int argc
     return TCL_OK;
 }
 
+static int Tcl_ops_nodeDispAll(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_nodeDispAll() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_nodeVelAll(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_nodeVelAll() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_nodeAccelAll(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_nodeAccelAll() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_setNodeAccel(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -797,6 +853,30 @@ static int Tcl_ops_stopTimer(ClientData clientData, Tcl_Interp *interp, int argc
     return TCL_OK;
 }
 
+static int Tcl_ops_profile(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_profile() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_metrics(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_metrics() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_memoryReport(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_memoryReport() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_modalDamping(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1061,6 +1141,22 @@ static int Tcl_ops_systemSize(ClientData clientData, Tcl_Interp *interp, int arg
     return TCL_OK;
 }
 
+static int Tcl_ops_influenceMatrix(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_influenceMatrix() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_numFactorizations(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_numFactorizations() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_version(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1586,6 +1682,15 @@ static int Tcl_ops_sdfResponse(ClientData clientData, Tcl_Interp *interp, int ar
     return TCL_OK;
 }
 
+static int Tcl_ops_sdfSpectra(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_sdfSpectra() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_getNumThreads(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
 {
     wrapper->resetCommandLine(argc, 1, argv);
@@ -1604,6 +1709,51 @@ static int Tcl_ops_setNumThreads(ClientData clientData, Tcl_Interp *interp, int
     return TCL_OK;
 }
 
+static int Tcl_ops_setParallelUpdate(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_setParallelUpdate() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_setGeometryCache(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_setGeometryCache() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_logWarnings(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_logWarnings() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_benchMaterial(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_benchMaterial() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_benchElement(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_benchElement() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_logFile(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
 {
     wrapper->resetCommandLine(argc, 1, argv);
@@ -1667,6 +1817,15 @@ static int Tcl_ops_partition(ClientData clientData, Tcl_Interp *interp, int argc
     return TCL_OK;
 }
 
+static int Tcl_ops_setPartition(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_setPartition() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 //////////////////////////////////////////////
 ////////////// Add Tcl commands //////////////
 //////////////////////////////////////////////
@@ -1683,8 +1842,10 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"wipe", &Tcl_ops_wipe);
     addCommand(interp,"model", &Tcl_ops_model);
     addCommand(interp,"node", &Tcl_ops_node);
+    addCommand(interp,"nodes", &Tcl_ops_nodes);
     addCommand(interp,"fix", &Tcl_ops_fix);
     addCommand(interp,"element", &Tcl_ops_element);
+    addCommand(interp,"elements", &Tcl_ops_elements);
     addCommand(interp,"timeSeries", &Tcl_ops_timeSeries);
     addCommand(interp,"pattern", &Tcl_ops_pattern);
     addCommand(interp,"load", &Tcl_ops_nodalLoad);
@@ -1712,6 +1873,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"block3D", &Tcl_ops_block3d);
     addCommand(interp,"rayleigh", &Tcl_ops_rayleigh);
     addCommand(interp,"wipeAnalysis", &Tcl_ops_wipeAnalysis);
+    addCommand(interp,"modelContext", &Tcl_ops_modelContext);
     addCommand(interp,"setTime", &Tcl_ops_setTime);
     addCommand(interp,"remove", &Tcl_ops_remove);
     addCommand(interp,"mass", &Tcl_ops_mass);
@@ -1736,6 +1898,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"getCTestIter", &Tcl_ops_getCTestIter);
     addCommand(interp,"recorder", &Tcl_ops_recorder);
     addCommand(interp,"database", &Tcl_ops_database);
+    addCommand(interp,"checkpoint", &Tcl_ops_checkpoint);
     addCommand(interp,"save", &Tcl_ops_save);
     addCommand(interp,"restore", &Tcl_ops_restore);
     addCommand(interp,"eleForce", &Tcl_ops_eleForce);
@@ -1746,6 +1909,9 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"nodeVel", &Tcl_ops_nodeVel);
     addCommand(interp,"setNodeVel", &Tcl_ops_setNodeVel);
     addCommand(interp,"nodeAccel", &Tcl_ops_nodeAccel);
+    addCommand(interp,"nodeDispAll", &Tcl_ops_nodeDispAll);
+    addCommand(interp,"nodeVelAll", &Tcl_ops_nodeVelAll);
+    addCommand(interp,"nodeAccelAll", &Tcl_ops_nodeAccelAll);
     addCommand(interp,"setNodeAccel", &Tcl_ops_setNodeAccel);
     addCommand(interp,"nodeResponse", &Tcl_ops_nodeResponse);
     addCommand(interp,"nodeCoord", &Tcl_ops_nodeCoord);
@@ -1758,6 +1924,9 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"nodeBounds", &Tcl_ops_nodeBounds);
     addCommand(interp,"start", &Tcl_ops_startTimer);
     addCommand(interp,"stop", &Tcl_ops_stopTimer);
+    addCommand(interp,"profile", &Tcl_ops_profile);
+    addCommand(interp,"metrics", &Tcl_ops_metrics);
+    addCommand(interp,"memoryReport", &Tcl_ops_memoryReport);
     addCommand(interp,"modalDamping", &Tcl_ops_modalDamping);
     addCommand(interp,"modalDampingQ", &Tcl_ops_modalDampingQ);
     addCommand(interp,"setElementRayleighDampingFactors", &Tcl_ops_setElementRayleighDampingFactors);
@@ -1792,6 +1961,8 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"numFact", &Tcl_ops_numFact);
     addCommand(interp,"numIter", &Tcl_ops_numIter);
     addCommand(interp,"systemSize", &Tcl_ops_systemSize);
+    addCommand(interp,"numFactorizations", &Tcl_ops_numFactorizations);
+    addCommand(interp,"influenceMatrix", &Tcl_ops_influenceMatrix);
     addCommand(interp,"version", &Tcl_ops_version);
     addCommand(interp,"setMaxOpenFiles", &Tcl_ops_setMaxOpenFiles);
     addCommand(interp,"limitCurve", &Tcl_ops_limitCurve);
@@ -1843,6 +2014,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"performanceFunction", &Tcl_ops_performanceFunction);    
     addCommand(interp,"updateMaterialStage", &Tcl_ops_updateMaterialStage);
     addCommand(interp,"sdfResponse", &Tcl_ops_sdfResponse);
+    addCommand(interp,"sdfSpectra", &Tcl_ops_sdfSpectra);
     addCommand(interp,"probabilityTransformation", &Tcl_ops_probabilityTransformation);
     addCommand(interp,"startPoint", &Tcl_ops_startPoint);
     addCommand(interp,"randomNumberGenerator", &Tcl_ops_randomNumberGenerator);
@@ -1855,6 +2027,11 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"gradientEvaluator", &Tcl_ops_gradientEvaluator);
     addCommand(interp,"getNumThreads", &Tcl_ops_getNumThreads);
     addCommand(interp,"setNumThreads", &Tcl_ops_setNumThreads);
+    addCommand(interp,"setParallelUpdate", &Tcl_ops_setParallelUpdate);
+    addCommand(interp,"setGeometryCache", &Tcl_ops_setGeometryCache);
+    addCommand(interp,"logWarnings", &Tcl_ops_logWarnings);
+    addCommand(interp,"benchMaterial", &Tcl_ops_benchMaterial);
+    addCommand(interp,"benchElement", &Tcl_ops_benchElement);
     addCommand(interp,"logFile", &Tcl_ops_logFile);
     addCommand(interp,"setStartNodeTag", &Tcl_ops_setStartNodeTag);
     addCommand(interp,"hystereticBackbone", &Tcl_ops_hystereticBackbone);
@@ -1863,4 +2040,5 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"stiffnessDegradation", &Tcl_ops_strengthDegradation);
     addCommand(interp,"unloadingRule", &Tcl_ops_unloadingRule);
     addCommand(interp,"partition", &Tcl_ops_partition);
+    addCommand(interp,"setPartition", &Tcl_ops_setPartition);
 }
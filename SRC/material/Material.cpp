@@ -65,3 +65,14 @@ Material::getResponseSensitivity(int responseID, int gradIndex,
 {
   return -1;
 }
+
+double
+Material::implexExtrapolate(double xCommit, double xCommitOld,
+			    double dt, double dtCommit)
+{
+  double ratio = 1.0;
+  if (dt > 0.0 && dtCommit > 0.0)
+    ratio = dt/dtCommit;
+
+  return xCommit + ratio*(xCommit - xCommitOld);
+}
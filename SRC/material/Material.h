@@ -60,6 +60,15 @@ class Material : public TaggedObject, public MovableObject
     virtual void update(void) {return;}
 
   protected:
+    // IMPL-EX integration: the internal variables of the current step are
+    // extrapolated from the last two committed ones, so that within the step
+    // the stress is linear in the strain and the tangent is constant. The
+    // implicit solution is computed once in commitState(). Returns
+    // xCommit + dt/dtCommit*(xCommit - xCommitOld), dt being the current time
+    // step and dtCommit that of the last committed step (equal steps are
+    // assumed if either is not positive, as in static analyses)
+    static double implexExtrapolate(double xCommit, double xCommitOld,
+				    double dt, double dtCommit);
     
   private:
 };
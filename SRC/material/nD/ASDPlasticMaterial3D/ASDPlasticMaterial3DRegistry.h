@@ -0,0 +1,252 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Original implementation: José Abell (UANDES), Massimo Petracca (ASDEA)
+//
+// ASDPlasticMaterial3D
+//
+// Registry of the compiled ASDPlasticMaterial3D models. Every entry holds
+// the script names of one fully specialized EL/YF/PF combination and a
+// function that creates and populates an instance of it, so a script
+// command only instantiates the model it asks for. The entries are
+// generated by gen_ASD_material_definitions_CPP.py from the lists at the
+// top of that script, which also writes plugin libraries for combinations
+// that are not built in.
+
+#ifndef ASDPlasticMaterial3DRegistry_H
+#define ASDPlasticMaterial3DRegistry_H
+
+#include <elementAPI.h>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "AllASDPlasticMaterial3Ds.h"
+
+// yf_type, pf_type, el_type, iv_type
+typedef std::tuple<std::string, std::string, std::string, std::string> model_spec_t;
+
+struct ASDPlasticMaterial3DModel
+{
+    model_spec_t spec;
+    NDMaterial* (*create)(int tag);
+};
+
+typedef std::vector<ASDPlasticMaterial3DModel> ASDPlasticMaterial3DRegistry;
+
+// name of the function a plugin library exports to add its models
+#define ASD_PLASTIC_MATERIAL_3D_PLUGIN_FUNCTION "ASDPlasticMaterial3D_registerModels"
+typedef void (*ASDPlasticMaterial3DPluginFunction)(ASDPlasticMaterial3DRegistry &);
+
+
+template <typename T>
+void populate_ASDPlasticMaterial3D(T* instance)
+{
+
+    int get_one_value = 1;
+
+    cout << "\n\nDefined internal variables: \n";
+    auto iv_names = instance->getInternalVariablesNames();
+    for_each_in_tuple(iv_names, [instance](auto & name)
+    {
+        std::cout << "   "  << name << " size = " << instance->getInternalVariableSizeByName(name) << std::endl;
+    });
+
+    cout << "\n\nDefined model parameters\n";
+    auto parameter_names = instance->getParameterNames();
+    for_each_in_tuple(parameter_names, [](auto & name)
+    {
+        std::cout << "   "  <<  name << std::endl;
+    });
+
+    // Default integration options
+    int method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
+    int tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
+    double f_relative_tol = 1e-6; 
+    double stress_relative_tol = 1e-6; 
+    int n_max_iterations = 100;
+    int return_to_yield_surface = 1;
+
+    // Loop over input arguments
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+
+        //Current command
+        const char *cmd = OPS_GetString();
+
+
+        // Specifying internal variables
+        if (std::strcmp(cmd, "Begin_Internal_Variables") == 0)
+        {
+            cout << "\n\nReading internal variables from input\n";
+            while (OPS_GetNumRemainingInputArgs() > 0) {
+                double iv_values[6];
+                const char *iv_name = OPS_GetString();
+
+                if (std::strcmp(iv_name, "End_Internal_Variables") == 0)
+                {
+                    cout << "\n\n Done reading internal variables from input\n";
+                    break;
+                }
+
+                int iv_size = instance->getInternalVariableSizeByName(iv_name);
+                OPS_GetDouble(&iv_size, iv_values);
+                cout << iv_name << " = ";
+                for (int i = 0; i < iv_size; ++i)
+                {
+                    cout << iv_values[i] << " ";
+                }
+                cout << endl;
+                instance->setInternalVariableByName(iv_name, iv_size, &iv_values[0]);
+            }
+
+        }
+
+
+        // Specifying model parameters
+        if (std::strcmp(cmd, "Begin_Model_Parameters") == 0)
+        {
+            cout << "\n\nReading parameters from input\n";
+            while (OPS_GetNumRemainingInputArgs() > 0) {
+                double param_value;
+                const char *param_name = OPS_GetString();
+                if (std::strcmp(param_name, "End_Model_Parameters") == 0)
+                {
+                    cout << "\n\n Done reading parameters from input\n";
+                    break;
+                }
+
+                OPS_GetDouble(&get_one_value, &param_value);
+                cout << param_name << " = " << param_value << endl;
+                instance->setParameterByName(param_name, param_value);
+            }
+        }
+
+
+        // set_constitutive_integration_method(int method, double f_relative_tol, double stress_relative_tol, int n_max_iterations)
+        if (std::strcmp(cmd, "Begin_Integration_Options") == 0)
+        {
+            cout << "\n\nReading Integration Options\n";
+            while (OPS_GetNumRemainingInputArgs() > 0) {
+                const char *param_name = OPS_GetString();
+                if (std::strcmp(param_name, "End_Integration_Options") == 0)
+                {
+                    cout << "\n\nDone reading Integration Options\n";
+                    break;
+                }
+
+                if (std::strcmp(param_name, "f_relative_tol") == 0)
+                {
+                    OPS_GetDouble(&get_one_value, &f_relative_tol);
+                    cout << "   Setting f_relative_tol = " << f_relative_tol << endl;
+                }
+
+                if (std::strcmp(param_name, "stress_relative_tol") == 0)
+                {
+                    OPS_GetDouble(&get_one_value, &stress_relative_tol);
+                    cout << "   Setting stress_relative_tol = " << stress_relative_tol << endl;
+                }
+
+                if (std::strcmp(param_name, "n_max_iterations") == 0)
+                {
+                    OPS_GetInt(&get_one_value, &n_max_iterations);
+                    cout << "   Setting n_max_iterations = " << n_max_iterations << endl;
+                }
+                
+                if (std::strcmp(param_name, "return_to_yield_surface") == 0)
+                {
+                    OPS_GetInt(&get_one_value, &return_to_yield_surface);
+                    cout << "   Setting return_to_yield_surface = " << return_to_yield_surface << endl;
+                }
+
+                if (std::strcmp(param_name, "integration_method") == 0)
+                {
+                    const char *method_name = OPS_GetString();
+                    if (std::strcmp(method_name, "Forward_Euler") == 0)
+                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Forward_Euler;
+                    else if (std::strcmp(method_name, "Runge_Kutta_45_Error_Control") == 0)
+                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
+                    else
+                    {
+                        cout << "WARNING! Unrecognised ASDPlasticMaterial3D_Constitutive_Integration_Method name " << method_name << endl;
+                        cout << "Defaulting to Runge_Kutta_45_Error_Control" << endl;
+                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
+                    }
+                    cout << "   Setting integration method = " << method_name << " method_int = " << method << endl;
+                    
+                }
+
+                if (std::strcmp(param_name, "tangent_type") == 0)
+                {
+                    const char *tangent_type_name = OPS_GetString();
+                    if (std::strcmp(tangent_type_name, "Elastic") == 0)
+                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
+                    else if (std::strcmp(tangent_type_name, "Continuum") == 0)
+                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Continuum;
+                    else if (std::strcmp(tangent_type_name, "Secant") == 0)
+                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Secant;
+                    else
+                    {
+                        cout << "WARNING! Unrecognised ASDPlasticMaterial3D_Tangent_Operator_Type name " << tangent_type_name << endl;
+                        cout << "Defaulting to Elastic" << endl;
+                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
+                    }
+                    cout << "   Setting tangent type = " << tangent_type_name << " tangent int = " << tangent << endl;
+                    
+                }
+
+            }
+        }
+    }
+
+    instance->set_constitutive_integration_method(method, tangent, f_relative_tol, stress_relative_tol, n_max_iterations, return_to_yield_surface);
+}
+
+
+
+template<typename EL, typename YF, typename PF>
+NDMaterial* createASDPlasticMaterial3D(int instance_tag)
+{
+    auto instance = new ASDPlasticMaterial3D<EL, YF, PF, ND_TAG_ASDPlasticMaterial3D>(instance_tag);
+
+    populate_ASDPlasticMaterial3D(instance);
+    cout << "\n\nPrinting material info\n";
+    instance->Print(opserr);
+    cout << "\n\nDone creating ASDPlasticMaterial3D \n\n\n";
+
+    return static_cast<NDMaterial*>(instance);
+}
+
+
+template<typename EL, typename YF, typename PF>
+void registerASDPlasticMaterial3D(ASDPlasticMaterial3DRegistry &registry)
+{
+    // the internal variable name needs an instance, it is built only once
+    ASDPlasticMaterial3D<EL, YF, PF, ND_TAG_ASDPlasticMaterial3D> probe(0);
+
+    ASDPlasticMaterial3DModel model;
+    model.spec = std::make_tuple(
+        probe.getYFName(),
+        probe.getPFName(),
+        probe.getELName(),
+        probe.getIVName());
+    model.create = &createASDPlasticMaterial3D<EL, YF, PF>;
+    registry.push_back(model);
+}
+
+#endif
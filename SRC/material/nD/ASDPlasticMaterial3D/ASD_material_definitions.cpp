@@ -1,6 +1,6 @@
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -8,11 +8,11 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -20,23 +20,83 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >, 
         DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -44,11 +104,11 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -56,11 +116,35 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -68,11 +152,11 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -80,23 +164,83 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >, 
         DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -104,11 +248,11 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         LinearIsotropic3D_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -116,11 +260,35 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        LinearIsotropic3D_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -128,11 +296,11 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -140,23 +308,83 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >, 
         DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -164,11 +392,11 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         VonMises_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -176,11 +404,35 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        VonMises_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -188,11 +440,11 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -200,23 +452,83 @@ createASDPlasticMaterial3D<
         VonMises_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        VonMises_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >, 
         DruckerPrager_PF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        DruckerPrager_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -224,11 +536,11 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<TensorLinearHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         DuncanChang_EL, 
         DruckerPrager_YF<
             BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
@@ -236,5 +548,29 @@ createASDPlasticMaterial3D<
         ConstantDilatancy_PF<
             BackStress<ArmstrongFrederickHardeningFunction>
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<TensorLinearHardeningFunction>
+            >
+        > (registry);
+
+
+
+registerASDPlasticMaterial3D<
+        DuncanChang_EL, 
+        DruckerPrager_YF<
+            BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>
+            >, 
+        ConstantDilatancy_PF<
+            BackStress<ArmstrongFrederickHardeningFunction>
+            >
+        > (registry);
 
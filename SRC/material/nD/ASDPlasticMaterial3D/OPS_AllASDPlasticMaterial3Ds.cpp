@@ -30,21 +30,16 @@
 #include <OPS_Globals.h>
 #include <elementAPI.h>
 #include <list>
-#include "AllASDPlasticMaterial3Ds.h"
+#include "ASDPlasticMaterial3DRegistry.h"
 
-template <typename T>
-void populate_ASDPlasticMaterial3D(T* instance);
-
-typedef std::tuple<std::string, std::string, std::string, std::string> model_spec_t;
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
 
 
 NDMaterial*  ASDPlasticMaterial3DFactory(int tag, const char * yf_type, const char * pf_type, const char * el_type, const char * iv_type, std::list<model_spec_t> &available_models);
 
 
-template<typename EL, typename YF, typename PF>
-NDMaterial* createASDPlasticMaterial3D(int instance_tag, const char* yf_type, const char* pf_type, const char* el_type, const char* iv_type, std::list<NDMaterial*> &instance_pointers, std::list<model_spec_t> &available_models);
-
-
 void print_usage(void)
 {
     opserr <<
@@ -168,234 +163,84 @@ void *OPS_AllASDPlasticMaterial3Ds(void)
 
 
 
-NDMaterial*  ASDPlasticMaterial3DFactory(int instance_tag, const char * yf_type, const char * pf_type, const char * el_type, const char * iv_type, std::list<model_spec_t> &available_models)
+// the compiled models, built on first use
+static ASDPlasticMaterial3DRegistry &getASDPlasticMaterial3DRegistry(void)
 {
+    static ASDPlasticMaterial3DRegistry registry;
 
-    std::list<NDMaterial*> instance_pointers;
+    if (registry.empty()) {
+        #include "ASD_material_definitions.cpp"
+    }
 
+    return registry;
+}
 
-	#include "ASD_material_definitions.cpp"    
 
-    //Search for the valid pointer and return that one
-    for(auto instance : instance_pointers)
+static NDMaterial* findASDPlasticMaterial3D(const ASDPlasticMaterial3DRegistry &registry, int instance_tag,
+        const char * yf_type, const char * pf_type, const char * el_type, const char * iv_type)
+{
+    for (const ASDPlasticMaterial3DModel &model : registry)
     {
-        if(instance != nullptr)
-        {
-            return instance;
-        }
+        if (std::strcmp(yf_type, std::get<0>(model.spec).c_str()) == 0 &&
+            std::strcmp(pf_type, std::get<1>(model.spec).c_str()) == 0 &&
+            std::strcmp(el_type, std::get<2>(model.spec).c_str()) == 0 &&
+            std::strcmp(iv_type, std::get<3>(model.spec).c_str()) == 0)
+            return model.create(instance_tag);
     }
 
     return nullptr;
 }
 
 
-
-
-
-
-template<typename EL, typename YF, typename PF>
-NDMaterial* createASDPlasticMaterial3D(int instance_tag, 
-        const char* yf_type, const char* pf_type, const char* el_type, const char* iv_type, std::list<NDMaterial*> &instance_pointers, std::list<model_spec_t> &available_models) {
-    auto instance = new ASDPlasticMaterial3D<EL, YF, PF, ND_TAG_ASDPlasticMaterial3D>(instance_tag);
-
-
-    available_models.push_back(std::make_tuple(
-        instance->getYFName(),
-        instance->getPFName(),
-        instance->getELName(),
-        instance->getIVName())
-    );
-
-    if(
-        std::strcmp(yf_type,instance->getYFName().c_str())==0 &&
-        std::strcmp(pf_type,instance->getPFName().c_str())==0 &&
-        std::strcmp(el_type,instance->getELName().c_str())==0 &&
-        std::strcmp(iv_type,instance->getIVName().c_str())==0 
-        )
-    {
-        populate_ASDPlasticMaterial3D(instance);
-        cout << "\n\nPrinting material info\n";
-        instance->Print(opserr);
-        cout << "\n\nDone creating ASDPlasticMaterial3D \n\n\n";
-        instance_pointers.push_back(static_cast<NDMaterial*>(instance));
-        return static_cast<NDMaterial*>(instance);
-    }  
-    else
-    {
-        delete instance;
-        instance_pointers.push_back(nullptr);        
-        return nullptr;
+// models of a plugin library written by gen_ASD_material_definitions_CPP.py --plugin,
+// loaded once the first time a combination is not among the compiled ones
+static bool loadASDPlasticMaterial3DPlugin(ASDPlasticMaterial3DRegistry &registry)
+{
+#ifndef _WIN32
+    static bool tried = false;
+    if (tried)
+        return false;
+    tried = true;
+
+    const char *libName = "libASDPlasticMaterial3DModels.so";
+    void *libHandle = dlopen(libName, RTLD_NOW);
+    if (libHandle == 0)
+        return false;
+
+    ASDPlasticMaterial3DPluginFunction funcPtr =
+        (ASDPlasticMaterial3DPluginFunction) dlsym(libHandle, ASD_PLASTIC_MATERIAL_3D_PLUGIN_FUNCTION);
+    if (funcPtr == 0) {
+        opserr << "WARNING ASDPlasticMaterial3D - " << libName << " does not define "
+               << ASD_PLASTIC_MATERIAL_3D_PLUGIN_FUNCTION << "\n";
+        dlclose(libHandle);
+        return false;
     }
-}
-
-
-
-
 
+    size_t numCompiled = registry.size();
+    (*funcPtr)(registry);
+    cout << "Loaded " << registry.size() - numCompiled << " ASDPlasticMaterial3D models from " << libName << "\n";
 
+    return true;
+#else
+    return false;
+#endif
+}
 
 
-template <typename T>
-void populate_ASDPlasticMaterial3D(T* instance)
+NDMaterial*  ASDPlasticMaterial3DFactory(int instance_tag, const char * yf_type, const char * pf_type, const char * el_type, const char * iv_type, std::list<model_spec_t> &available_models)
 {
+    ASDPlasticMaterial3DRegistry &registry = getASDPlasticMaterial3DRegistry();
 
-    int get_one_value = 1;
-
-    cout << "\n\nDefined internal variables: \n";
-    auto iv_names = instance->getInternalVariablesNames();
-    for_each_in_tuple(iv_names, [instance](auto & name)
-    {
-        std::cout << "   "  << name << " size = " << instance->getInternalVariableSizeByName(name) << std::endl;
-    });
-
-    cout << "\n\nDefined model parameters\n";
-    auto parameter_names = instance->getParameterNames();
-    for_each_in_tuple(parameter_names, [](auto & name)
-    {
-        std::cout << "   "  <<  name << std::endl;
-    });
-
-    // Default integration options
-    int method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
-    int tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
-    double f_relative_tol = 1e-6; 
-    double stress_relative_tol = 1e-6; 
-    int n_max_iterations = 100;
-    int return_to_yield_surface = 1;
-
-    // Loop over input arguments
-    while (OPS_GetNumRemainingInputArgs() > 0) {
-
-        //Current command
-        const char *cmd = OPS_GetString();
-
-
-        // Specifying internal variables
-        if (std::strcmp(cmd, "Begin_Internal_Variables") == 0)
-        {
-            cout << "\n\nReading internal variables from input\n";
-            while (OPS_GetNumRemainingInputArgs() > 0) {
-                double iv_values[6];
-                const char *iv_name = OPS_GetString();
-
-                if (std::strcmp(iv_name, "End_Internal_Variables") == 0)
-                {
-                    cout << "\n\n Done reading internal variables from input\n";
-                    break;
-                }
-
-                int iv_size = instance->getInternalVariableSizeByName(iv_name);
-                OPS_GetDouble(&iv_size, iv_values);
-                cout << iv_name << " = ";
-                for (int i = 0; i < iv_size; ++i)
-                {
-                    cout << iv_values[i] << " ";
-                }
-                cout << endl;
-                instance->setInternalVariableByName(iv_name, iv_size, &iv_values[0]);
-            }
-
-        }
-
-
-        // Specifying model parameters
-        if (std::strcmp(cmd, "Begin_Model_Parameters") == 0)
-        {
-            cout << "\n\nReading parameters from input\n";
-            while (OPS_GetNumRemainingInputArgs() > 0) {
-                double param_value;
-                const char *param_name = OPS_GetString();
-                if (std::strcmp(param_name, "End_Model_Parameters") == 0)
-                {
-                    cout << "\n\n Done reading parameters from input\n";
-                    break;
-                }
-
-                OPS_GetDouble(&get_one_value, &param_value);
-                cout << param_name << " = " << param_value << endl;
-                instance->setParameterByName(param_name, param_value);
-            }
-        }
+    NDMaterial *instance = findASDPlasticMaterial3D(registry, instance_tag, yf_type, pf_type, el_type, iv_type);
 
+    if (instance == nullptr && loadASDPlasticMaterial3DPlugin(registry))
+        instance = findASDPlasticMaterial3D(registry, instance_tag, yf_type, pf_type, el_type, iv_type);
 
-        // set_constitutive_integration_method(int method, double f_relative_tol, double stress_relative_tol, int n_max_iterations)
-        if (std::strcmp(cmd, "Begin_Integration_Options") == 0)
-        {
-            cout << "\n\nReading Integration Options\n";
-            while (OPS_GetNumRemainingInputArgs() > 0) {
-                const char *param_name = OPS_GetString();
-                if (std::strcmp(param_name, "End_Integration_Options") == 0)
-                {
-                    cout << "\n\nDone reading Integration Options\n";
-                    break;
-                }
-
-                if (std::strcmp(param_name, "f_relative_tol") == 0)
-                {
-                    OPS_GetDouble(&get_one_value, &f_relative_tol);
-                    cout << "   Setting f_relative_tol = " << f_relative_tol << endl;
-                }
-
-                if (std::strcmp(param_name, "stress_relative_tol") == 0)
-                {
-                    OPS_GetDouble(&get_one_value, &stress_relative_tol);
-                    cout << "   Setting stress_relative_tol = " << stress_relative_tol << endl;
-                }
-
-                if (std::strcmp(param_name, "n_max_iterations") == 0)
-                {
-                    OPS_GetInt(&get_one_value, &n_max_iterations);
-                    cout << "   Setting n_max_iterations = " << n_max_iterations << endl;
-                }
-                
-                if (std::strcmp(param_name, "return_to_yield_surface") == 0)
-                {
-                    OPS_GetInt(&get_one_value, &return_to_yield_surface);
-                    cout << "   Setting return_to_yield_surface = " << return_to_yield_surface << endl;
-                }
-
-                if (std::strcmp(param_name, "integration_method") == 0)
-                {
-                    const char *method_name = OPS_GetString();
-                    if (std::strcmp(method_name, "Forward_Euler") == 0)
-                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Forward_Euler;
-                    else if (std::strcmp(method_name, "Runge_Kutta_45_Error_Control") == 0)
-                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
-                    else
-                    {
-                        cout << "WARNING! Unrecognised ASDPlasticMaterial3D_Constitutive_Integration_Method name " << method_name << endl;
-                        cout << "Defaulting to Runge_Kutta_45_Error_Control" << endl;
-                        method = (int) ASDPlasticMaterial3D_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
-                    }
-                    cout << "   Setting integration method = " << method_name << " method_int = " << method << endl;
-                    
-                }
-
-                if (std::strcmp(param_name, "tangent_type") == 0)
-                {
-                    const char *tangent_type_name = OPS_GetString();
-                    if (std::strcmp(tangent_type_name, "Elastic") == 0)
-                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
-                    else if (std::strcmp(tangent_type_name, "Continuum") == 0)
-                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Continuum;
-                    else if (std::strcmp(tangent_type_name, "Secant") == 0)
-                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Secant;
-                    else
-                    {
-                        cout << "WARNING! Unrecognised ASDPlasticMaterial3D_Tangent_Operator_Type name " << tangent_type_name << endl;
-                        cout << "Defaulting to Elastic" << endl;
-                        tangent = (int) ASDPlasticMaterial3D_Tangent_Operator_Type::Elastic;
-                    }
-                    cout << "   Setting tangent type = " << tangent_type_name << " tangent int = " << tangent << endl;
-                    
-                }
-
-            }
-        }
-    }
+    if (instance == nullptr)
+        for (const ASDPlasticMaterial3DModel &model : registry)
+            available_models.push_back(model.spec);
 
-    instance->set_constitutive_integration_method(method, tangent, f_relative_tol, stress_relative_tol, n_max_iterations, return_to_yield_surface);
+    return instance;
 }
 
-
 #endif // _EIGEN3
@@ -1,4 +1,5 @@
 #!/usr/bin/python
+import sys
 from itertools import product
 
 EL = [
@@ -22,7 +23,7 @@ IV_YF = {}
 
 IV_YF["VonMises_YF"] = [
     "BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
-    # "BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
+    "BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
 ]
 
 IV_YF["DruckerPrager_YF"] = IV_YF["VonMises_YF"] 
@@ -41,7 +42,7 @@ IV_PF = {
     "DruckerPrager_PF":
     [
     "BackStress<TensorLinearHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
-    # "BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
+    "BackStress<ArmstrongFrederickHardeningFunction>,VonMisesRadius<ScalarLinearHardeningFunction>",
     ]
 }
 
@@ -53,7 +54,7 @@ IV_PF["ConstantDilatancy_PF"] = IV_PF["VonMises_PF"]
 
 template = """
 
-createASDPlasticMaterial3D<
+registerASDPlasticMaterial3D<
         {EL}, 
         {YF}<
             {IV_YF}
@@ -61,17 +62,40 @@ createASDPlasticMaterial3D<
         {PF}<
             {IV_PF}
             >
-        > (instance_tag, yf_type, pf_type, el_type, iv_type, instance_pointers, available_models);
+        > (registry);
 
 """
 
 
-# with open("ASD_material_definitions.cpp","w") as fid:
-#     for el, yf, pf, iv_yf, iv_pf in product(EL, YF, PF, IV_YF, IV_PF):
-#         fid.write(template.format(EL=el, YF=yf, PF=pf, IV_YF=iv_yf, IV_PF=iv_pf))
+# Compiled into a shared library, this registers the listed models with
+# ASDPlasticMaterial3D at run time, without rebuilding OpenSees. Build it
+# against the same sources, e.g.
+#   python gen_ASD_material_definitions_CPP.py --plugin ASDPlasticMaterial3DModels.cpp
+#   g++ -shared -fPIC -D_EIGEN3 ... ASDPlasticMaterial3DModels.cpp -o libASDPlasticMaterial3DModels.so
+# and put the library on the loader path.
+plugin_header = """// generated by gen_ASD_material_definitions_CPP.py --plugin
 
-with open("ASD_material_definitions.cpp","w") as fid:
+#include "ASDPlasticMaterial3DRegistry.h"
+
+extern "C" void ASDPlasticMaterial3D_registerModels(ASDPlasticMaterial3DRegistry &registry)
+{{
+{DEFINITIONS}
+}}
+"""
+
+
+def definitions():
+    text = ""
     for el, yf, pf in product(EL, YF, PF):
         for iv_yf in IV_YF[yf]:
             for iv_pf in IV_PF[pf]:
-                fid.write(template.format(EL=el, YF=yf, PF=pf, IV_YF=iv_yf, IV_PF=iv_pf))
\ No newline at end of file
+                text += template.format(EL=el, YF=yf, PF=pf, IV_YF=iv_yf, IV_PF=iv_pf)
+    return text
+
+
+if len(sys.argv) == 3 and sys.argv[1] == "--plugin":
+    with open(sys.argv[2],"w") as fid:
+        fid.write(plugin_header.format(DEFINITIONS=definitions()))
+else:
+    with open("ASD_material_definitions.cpp","w") as fid:
+        fid.write(definitions())
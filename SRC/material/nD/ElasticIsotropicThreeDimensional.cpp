@@ -197,6 +197,48 @@ ElasticIsotropicThreeDimensional::revertToLastCommit (void)
   return 0;
 }
 
+// batch operations on an array of ElasticIsotropicThreeDimensional
+// objects, see NDMaterial; the strains are copied straight into the
+// strain arrays of the materials
+int
+ElasticIsotropicThreeDimensional::setTrialStrainBatch(int n, NDMaterial **theMaterials,
+						      const double *strain, int size)
+{
+  if (size != 6)
+    return this->NDMaterial::setTrialStrainBatch(n, theMaterials, strain, size);
+
+  for (int i = 0; i < n; i++) {
+    double *eps = &(static_cast<ElasticIsotropicThreeDimensional *>(theMaterials[i])->epsilon(0));
+    const double *strainI = strain + 6*i;
+    for (int j = 0; j < 6; j++)
+      eps[j] = strainI[j];
+  }
+
+  return 0;
+}
+
+int
+ElasticIsotropicThreeDimensional::commitStateBatch(int n, NDMaterial **theMaterials)
+{
+  for (int i = 0; i < n; i++) {
+    ElasticIsotropicThreeDimensional *theMat = static_cast<ElasticIsotropicThreeDimensional *>(theMaterials[i]);
+    theMat->Cepsilon = theMat->epsilon;
+  }
+
+  return 0;
+}
+
+int
+ElasticIsotropicThreeDimensional::revertToLastCommitBatch(int n, NDMaterial **theMaterials)
+{
+  for (int i = 0; i < n; i++) {
+    ElasticIsotropicThreeDimensional *theMat = static_cast<ElasticIsotropicThreeDimensional *>(theMaterials[i]);
+    theMat->epsilon = theMat->Cepsilon;
+  }
+
+  return 0;
+}
+
 int
 ElasticIsotropicThreeDimensional::revertToStart (void)
 {
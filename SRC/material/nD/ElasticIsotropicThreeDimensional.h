@@ -60,6 +60,12 @@ class ElasticIsotropicThreeDimensional : public ElasticIsotropicMaterial
     int commitState (void);
     int revertToLastCommit (void);
     int revertToStart (void);
+
+    int setTrialStrainBatch(int n, NDMaterial **theMaterials,
+			    const double *strain, int size);
+    int commitStateBatch(int n, NDMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, NDMaterial **theMaterials);
+    bool isThreadSafe(void) {return true;}
     
     NDMaterial *getCopy (void);
     const char *getType (void) const;
@@ -247,6 +247,8 @@ const Matrix& J2AxiSymm :: getInitialTangent( )
 //swap history variables
 int J2AxiSymm :: commitState( )  
 {
+  this->implexCommit( ) ;
+
   epsilon_p_n = epsilon_p_nplus1 ;
   xi_n        = xi_nplus1 ;
 
@@ -273,7 +275,7 @@ J2AxiSymm::sendSelf (int commitTag, Channel &theChannel)
 {
   // we place all the data needed to define material and it's state
   // int a vector object
-  static Vector data(10+9);
+  static Vector data(10+9+12);
   int cnt = 0;
   data(cnt++) = this->getTag();
   data(cnt++) = bulk;
@@ -290,6 +292,8 @@ J2AxiSymm::sendSelf (int commitTag, Channel &theChannel)
     for (int j=0; j<3; j++)
       data(cnt++) = epsilon_p_n(i,j);
 
+  this->getImplexData(data, cnt);
+
   // send the vector object to the channel
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2AxiSymm::recvSelf - failed to send vector to channel\n";
@@ -305,7 +309,7 @@ J2AxiSymm::recvSelf (int commitTag, Channel &theChannel,
 {
 
   // recv the vector object from the channel which defines material param and state
-  static Vector data(10+9);
+  static Vector data(10+9+12);
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2AxiSymm::recvSelf - failed to recv vector from channel\n";
     return -1;
@@ -329,6 +333,8 @@ J2AxiSymm::recvSelf (int commitTag, Channel &theChannel,
     for (int j=0; j<3; j++) 
       epsilon_p_n(i,j) = data(cnt++);
 
+  this->setImplexData(data, cnt);
+
   epsilon_p_nplus1 = epsilon_p_n;
   xi_nplus1        = xi_n;
 
@@ -246,6 +246,8 @@ const Matrix& J2PlaneStrain :: getInitialTangent( )
 int 
 J2PlaneStrain::commitState( ) 
 {
+  this->implexCommit( ) ;
+
   epsilon_p_n = epsilon_p_nplus1;
   xi_n        = xi_nplus1;
 
@@ -272,7 +274,7 @@ J2PlaneStrain::sendSelf (int commitTag, Channel &theChannel)
 {
   // we place all the data needed to define material and it's state
   // int a vector object
-  static Vector data(19);
+  static Vector data(19+12);
   int cnt = 0;
   data(cnt++) = this->getTag();
   data(cnt++) = bulk;
@@ -291,6 +293,8 @@ J2PlaneStrain::sendSelf (int commitTag, Channel &theChannel)
     for (int j=0; j<3; j++)
       data(cnt++) = epsilon_p_n(i,j);
 
+  this->getImplexData(data, cnt);
+
   // send the vector object to the channel
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2PlaneStrain::sendSelf - failed to send vector to channel\n";
@@ -305,7 +309,7 @@ J2PlaneStrain::recvSelf (int commitTag, Channel &theChannel,
 {
 
   // recv the vector object from the channel which defines material param and state
-  static Vector data(19);
+  static Vector data(19+12);
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2PlaneStrain::recvSelf - failed to sned vectorto channel\n";
     return -1;
@@ -327,6 +331,8 @@ J2PlaneStrain::recvSelf (int commitTag, Channel &theChannel,
     for (int j=0; j<3; j++) 
       epsilon_p_n(i,j) = data(cnt++);
 
+  this->setImplexData(data, cnt);
+
   epsilon_p_nplus1 = epsilon_p_n;
   xi_nplus1        = xi_n;
 
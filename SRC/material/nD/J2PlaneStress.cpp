@@ -285,6 +285,8 @@ const Matrix& J2PlaneStress :: getInitialTangent( )
 int 
 J2PlaneStress::commitState( ) 
 {
+  this->implexCommit( ) ;
+
   epsilon_p_n = epsilon_p_nplus1 ;
   xi_n        = xi_nplus1 ;
 
@@ -316,7 +318,7 @@ J2PlaneStress::sendSelf(int commitTag, Channel &theChannel)
 {
   // we place all the data needed to define material and it's state
   // int a vector object
-  static Vector data(11+9);
+  static Vector data(11+9+12);
   int cnt = 0;
   data(cnt++) = this->getTag();
   data(cnt++) = bulk;
@@ -335,6 +337,8 @@ J2PlaneStress::sendSelf(int commitTag, Channel &theChannel)
     for (int j=0; j<3; j++) 
       data(cnt++) = epsilon_p_n(i,j);
 
+  this->getImplexData(data, cnt);
+
   // send the vector object to the channel
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2PlaneStress::sendSelf - failed to send vector to channel\n";
@@ -350,7 +354,7 @@ J2PlaneStress::recvSelf (int commitTag, Channel &theChannel,
 {
 
   // recv the vector object from the channel which defines material param and state
-  static Vector data(11+9);
+  static Vector data(11+9+12);
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2PlaneStress::recvSelf - failed to recv vector from channel\n";
     return -1;
@@ -375,6 +379,8 @@ J2PlaneStress::recvSelf (int commitTag, Channel &theChannel,
     for (int j=0; j<3; j++) 
       epsilon_p_n(i,j) = data(cnt++);
 
+  this->setImplexData(data, cnt);
+
   epsilon_p_nplus1 = epsilon_p_n;
   xi_nplus1        = xi_n;
   strain(2,2) = commitEps22;
@@ -73,10 +73,12 @@ void* OPS_J2Plasticity()
     int numdata = OPS_GetNumRemainingInputArgs();
     if (numdata < 7) {
 	opserr << "WARNING: Insufficient arguments\n";
-	opserr << "Want: nDMaterial J2Plasticity tag? K? G? sig0? sigInf? delta? H? <eta?>\n";
+	opserr << "Want: nDMaterial J2Plasticity tag? K? G? sig0? sigInf? delta? H? <eta?> <-implex>\n";
 	return 0;
     }
 
+    bool implex = false;
+
     int tag;
     numdata = 1;
     if (OPS_GetIntInput(&numdata,&tag) < 0) {
@@ -89,16 +91,35 @@ void* OPS_J2Plasticity()
     if (numdata > 7) {
 	numdata = 7;
     }
-    if (OPS_GetDoubleInput(&numdata,data)) {
-	opserr << "WARNING invalid J2Plasticity double inputs\n";
-	return 0;
+    for (int i = 0; i < numdata; i++) {
+	int one = 1;
+	if (OPS_GetDoubleInput(&one,&data[i]) < 0) {
+	    if (i < 6) {
+		opserr << "WARNING invalid J2Plasticity double inputs\n";
+		return 0;
+	    }
+	    // no eta, step back to read the option
+	    OPS_ResetCurrentInputArg(-1);
+	    break;
+	}
+    }
+
+    if (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt,"-implex") == 0) {
+	    implex = true;
+	} else {
+	    opserr << "WARNING invalid J2Plasticity option " << opt << "\n";
+	    return 0;
+	}
     }
 
-    NDMaterial* mat = new J2Plasticity(tag,0,data[0],data[1],data[2],data[3],data[4],data[5],data[6]);
+    J2Plasticity* mat = new J2Plasticity(tag,0,data[0],data[1],data[2],data[3],data[4],data[5],data[6]);
     if (mat == 0) {
 	opserr << "WARNING: failed to create J2Plasticity material\n";
 	return 0;
     }
+    mat->setImplex(implex);
 
     return mat;
 }
@@ -112,6 +133,11 @@ void J2Plasticity :: zero ( )
   epsilon_p_n.Zero( ) ;
   epsilon_p_nplus1.Zero( ) ;
 
+  xi_nminus1 = 0.0 ;
+  epsilon_p_nminus1.Zero( ) ;
+  dt_n = 0.0 ;
+  dt_nplus1 = 0.0 ;
+
   stress.Zero();
   strain.Zero();
 }
@@ -122,6 +148,11 @@ J2Plasticity ::  J2Plasticity( ) :
 NDMaterial( ),
 epsilon_p_n(3,3),
 epsilon_p_nplus1(3,3),
+implex(false),
+epsilon_p_nminus1(3,3),
+xi_nminus1(0.0),
+dt_n(0.0),
+dt_nplus1(0.0),
 stress(3,3),
 strain(3,3),
 parameterID(0)
@@ -210,6 +241,11 @@ J2Plasticity :: J2Plasticity(int    tag,
   NDMaterial(tag, classTag),
   epsilon_p_n(3,3),
   epsilon_p_nplus1(3,3),
+  implex(false),
+  epsilon_p_nminus1(3,3),
+  xi_nminus1(0.0),
+  dt_n(0.0),
+  dt_nplus1(0.0),
   stress(3,3),
   strain(3,3),
   parameterID(0)
@@ -292,6 +328,11 @@ J2Plasticity(   int    tag,
 NDMaterial(tag, classTag),
 epsilon_p_n(3,3),
 epsilon_p_nplus1(3,3),
+implex(false),
+epsilon_p_nminus1(3,3),
+xi_nminus1(0.0),
+dt_n(0.0),
+dt_nplus1(0.0),
 stress(3,3),
 strain(3,3),
 parameterID(0)
@@ -376,6 +417,7 @@ J2Plasticity :: getCopy (const char *type)
 	J2PlaneStress  *clone ;
 	clone = new J2PlaneStress(this->getTag(), bulk, shear, sigma_0,
 				  sigma_infty, delta, Hard, eta, rho) ;
+	clone->implex = implex ;
 	return clone ;
     }
     else if (strcmp(type,"PlaneStrain2D") == 0 || strcmp(type,"PlaneStrain") == 0)
@@ -383,6 +425,7 @@ J2Plasticity :: getCopy (const char *type)
 	J2PlaneStrain  *clone ;
 	clone = new J2PlaneStrain(this->getTag(), bulk, shear, sigma_0,
 				  sigma_infty, delta, Hard, eta, rho) ;
+	clone->implex = implex ;
 	return clone ;
     }
     else if (strcmp(type,"AxiSymmetric2D") == 0 || strcmp(type,"AxiSymmetric") == 0)
@@ -390,6 +433,7 @@ J2Plasticity :: getCopy (const char *type)
 	J2AxiSymm  *clone ;
 	clone = new J2AxiSymm(this->getTag(), bulk, shear, sigma_0,
 			      sigma_infty, delta, Hard, eta, rho) ;
+	clone->implex = implex ;
 	return clone ;	
     }
     else if ((strcmp(type,"ThreeDimensional") == 0) ||
@@ -398,6 +442,7 @@ J2Plasticity :: getCopy (const char *type)
 	J2ThreeDimensional  *clone ;
 	clone = new J2ThreeDimensional(this->getTag(), bulk, shear, sigma_0,
 				       sigma_infty, delta, Hard, eta, rho) ;
+	clone->implex = implex ;
 	return clone ;	
     }
     else if ( (strcmp(type,"PlateFiber") == 0) )
@@ -405,6 +450,7 @@ J2Plasticity :: getCopy (const char *type)
 	J2PlateFiber  *clone ;
 	clone = new J2PlateFiber(this->getTag(), bulk, shear, sigma_0,
 				 sigma_infty, delta, Hard, eta, rho) ;
+	clone->implex = implex ;
 	return clone ;	
     }
 
@@ -430,6 +476,8 @@ void J2Plasticity :: Print( OPS_Stream &s, int flag )
   s << "H =              " << Hard        << endln ;
   s << "Eta =            " << eta         << endln ;
   s << "Rho =            " << rho         << endln ;
+  if (implex)
+    s << "IMPL-EX integration" << endln ;
   s << endln ;
 }
 
@@ -439,15 +487,20 @@ void J2Plasticity :: Print( OPS_Stream &s, int flag )
 //plasticity integration routine
 void J2Plasticity :: plastic_integrator( )
 {
+  if ( implex ) {
+    this->implex_integrator( ) ;
+    return ;
+  }
+
   const double tolerance = (1.0e-8)*sigma_0 ;
 
   const double dt = ops_Dt ; //time step
 
-  static Matrix dev_strain(3,3) ; //deviatoric strain
+  static thread_local Matrix dev_strain(3,3) ; //deviatoric strain
 
-  static Matrix dev_stress(3,3) ; //deviatoric stress
+  static thread_local Matrix dev_stress(3,3) ; //deviatoric stress
  
-  static Matrix normal(3,3) ;     //normal to yield surface
+  static thread_local Matrix normal(3,3) ;     //normal to yield surface
 
   double NbunN ; //normal bun normal 
 
@@ -631,6 +684,93 @@ void J2Plasticity :: plastic_integrator( )
 
 
 
+//IMPL-EX trial state : plastic strain and xi extrapolated from the
+//last two committed steps, so the stress is linear in the strain and
+//the tangent is the elastic one
+void J2Plasticity :: implex_integrator( )
+{
+  int ii,jj,i,j,k,l;
+
+  dt_nplus1 = ops_Dt ;
+
+  double trace = strain(0,0) + strain(1,1) + strain(2,2) ;
+
+  for ( i = 0; i < 3; i++ ) {
+    for ( j = 0; j < 3; j++ ) {
+      epsilon_p_nplus1(i,j) = implexExtrapolate( epsilon_p_n(i,j),
+						  epsilon_p_nminus1(i,j),
+						  dt_nplus1, dt_n ) ;
+      stress(i,j) = (2.0*shear) * ( strain(i,j) - epsilon_p_nplus1(i,j) ) ;
+    }
+    stress(i,i) += ( bulk - (2.0*shear)*one3 ) * trace ;
+  }
+
+  xi_nplus1 = implexExtrapolate( xi_n, xi_nminus1, dt_nplus1, dt_n ) ;
+
+  for ( ii = 0; ii < 6; ii++ ) {
+    for ( jj = 0; jj < 6; jj++ )  {
+
+          index_map( ii, i, j ) ;
+          index_map( jj, k, l ) ;
+
+          tangent[i][j][k][l]  = bulk * IbunI[i][j][k][l] ;
+          tangent[i][j][k][l] += (2.0*shear) * IIdev[i][j][k][l] ;
+
+          //minor symmetries 
+          tangent [j][i][k][l] = tangent[i][j][k][l] ;
+          tangent [i][j][l][k] = tangent[i][j][k][l] ;
+          tangent [j][i][l][k] = tangent[i][j][k][l] ;
+
+    } // end for jj
+  } // end for ii
+}
+
+
+//IMPL-EX commit : backward Euler update at the converged strain, then
+//shift the committed internal variables to time n-1
+int J2Plasticity :: implexCommit( )
+{
+  if ( implex == false )
+    return 0 ;
+
+  //the subclass setTrialStrain() also enforces its stress conditions
+  Vector eps( this->getStrain( ) ) ;
+  implex = false ;
+  int res = this->setTrialStrain( eps ) ;
+  implex = true ;
+
+  epsilon_p_nminus1 = epsilon_p_n ;
+  xi_nminus1        = xi_n ;
+  dt_n              = dt_nplus1 ;
+
+  return res ;
+}
+
+
+void J2Plasticity :: getImplexData( Vector &data, int &cnt )
+{
+  data(cnt++) = implex ? 1.0 : 0.0 ;
+  data(cnt++) = xi_nminus1 ;
+  data(cnt++) = dt_n ;
+
+  for (int i=0; i<3; i++) 
+    for (int j=0; j<3; j++) 
+      data(cnt++) = epsilon_p_nminus1(i,j);
+}
+
+
+void J2Plasticity :: setImplexData( const Vector &data, int &cnt )
+{
+  implex     = ( data(cnt++) != 0.0 ) ;
+  xi_nminus1 = data(cnt++) ;
+  dt_n       = data(cnt++) ;
+
+  for (int i=0; i<3; i++) 
+    for (int j=0; j<3; j++) 
+      epsilon_p_nminus1(i,j) = data(cnt++);
+}
+
+
 // set up for initial elastic
 void J2Plasticity :: doInitialTangent( )
 {
@@ -754,6 +894,8 @@ J2Plasticity::getOrder (void) const
 int 
 J2Plasticity::commitState( ) 
 {
+  this->implexCommit( ) ;
+
   epsilon_p_n = epsilon_p_nplus1 ;
   xi_n        = xi_nplus1 ;
 
@@ -828,7 +970,7 @@ J2Plasticity::sendSelf(int commitTag, Channel &theChannel)
 {
   // we place all the data needed to define material and it's state
   // int a vector object
-  static Vector data(10+9);
+  static Vector data(10+9+12);
   int cnt = 0;
   data(cnt++) = this->getTag();
   data(cnt++) = bulk;
@@ -846,6 +988,7 @@ J2Plasticity::sendSelf(int commitTag, Channel &theChannel)
     for (int j=0; j<3; j++) 
       data(cnt++) = epsilon_p_n(i,j);
 
+  this->getImplexData(data, cnt);
 
   // send the vector object to the channel
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
@@ -861,7 +1004,7 @@ J2Plasticity::recvSelf (int commitTag, Channel &theChannel,
 			 FEM_ObjectBroker &theBroker)
 {
   // recv the vector object from the channel which defines material param and state
-  static Vector data(10+9);
+  static Vector data(10+9+12);
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "J2Plasticity::recvSelf - failed to recv vector from channel\n";
     return -1;
@@ -885,6 +1028,8 @@ J2Plasticity::recvSelf (int commitTag, Channel &theChannel,
     for (int j=0; j<3; j++) 
       epsilon_p_n(i,j) = data(cnt++);
 
+  this->setImplexData(data, cnt);
+
   epsilon_p_nplus1 = epsilon_p_n;
   xi_nplus1        = xi_n;
 
@@ -45,6 +45,10 @@
 //
 //  set eta := 0 for rate independent case
 //
+//  IMPL-EX option (implex = true): the trial stress uses the plastic
+//  strain and xi extrapolated from the last two committed steps with
+//  the elastic tangent, the backward Euler update is done at commit
+//
 
 
 #include <stdio.h> 
@@ -110,6 +114,8 @@ class J2Plasticity : public NDMaterial {
 
   double getRho(void) {return rho;}
 
+  void setImplex(bool flag) {implex = flag;}
+
   virtual int setParameter(const char **argv, int argc, Parameter &param);
   virtual int updateParameter(int parameterID, Information &info);
   virtual int activateParameter(int paramID);
@@ -131,6 +137,13 @@ class J2Plasticity : public NDMaterial {
   double xi_n ;              // xi time n
   double xi_nplus1 ;         // xi time n+1
 
+  //IMPL-EX integration, see Material
+  bool implex ;
+  Matrix epsilon_p_nminus1 ; // plastic strain time n-1
+  double xi_nminus1 ;        // xi time n-1
+  double dt_n ;              // time step from n-1 to n
+  double dt_nplus1 ;         // time step from n to n+1
+
   //material response 
   Matrix stress ;                //stress tensor
   double tangent[3][3][3][3] ;   //material tangent
@@ -155,6 +168,15 @@ class J2Plasticity : public NDMaterial {
 
   void doInitialTangent( ) ;
 
+  //IMPL-EX trial state and the implicit update at commit, the latter
+  //is called by the commitState() of each subclass before the swap
+  void implex_integrator( ) ;
+  int implexCommit( ) ;
+
+  //IMPL-EX state in the sendSelf()/recvSelf() data, 12 entries
+  void getImplexData( Vector &data, int &cnt ) ;
+  void setImplexData( const Vector &data, int &cnt ) ;
+
   //hardening function
   double q( double xi ) ;
 
@@ -58,9 +58,9 @@
 #include <FEM_ObjectBroker.h>
 
 //static vectors and matrices
-Vector J2ThreeDimensional :: strain_vec(6) ;
-Vector J2ThreeDimensional :: stress_vec(6) ;
-Matrix J2ThreeDimensional :: tangent_matrix(6,6) ;
+thread_local Vector J2ThreeDimensional :: strain_vec(6) ;
+thread_local Vector J2ThreeDimensional :: stress_vec(6) ;
+thread_local Matrix J2ThreeDimensional :: tangent_matrix(6,6) ;
 
 
 //null constructor
@@ -150,6 +150,39 @@ int J2ThreeDimensional :: setTrialStrain( const Vector &strain_from_element)
 }
 
 
+//batch operations on an array of J2ThreeDimensional objects, the
+//calls are bound here rather than through the virtual table
+int J2ThreeDimensional :: setTrialStrainBatch( int n, NDMaterial **theMaterials,
+					       const double *strain, int size )
+{
+  int res = 0 ;
+  for ( int i = 0; i < n; i++ ) {
+    Vector eps( const_cast<double *>(strain) + i*size, size ) ;
+    res += static_cast<J2ThreeDimensional *>(theMaterials[i])->J2ThreeDimensional::setTrialStrain( eps ) ;
+  }
+
+  return res ;
+}
+
+int J2ThreeDimensional :: commitStateBatch( int n, NDMaterial **theMaterials )
+{
+  int res = 0 ;
+  for ( int i = 0; i < n; i++ )
+    res += static_cast<J2ThreeDimensional *>(theMaterials[i])->J2Plasticity::commitState( ) ;
+
+  return res ;
+}
+
+int J2ThreeDimensional :: revertToLastCommitBatch( int n, NDMaterial **theMaterials )
+{
+  int res = 0 ;
+  for ( int i = 0; i < n; i++ )
+    res += static_cast<J2ThreeDimensional *>(theMaterials[i])->J2Plasticity::revertToLastCommit( ) ;
+
+  return res ;
+}
+
+
 //unused trial strain functions
 int J2ThreeDimensional :: setTrialStrain( const Vector &v, const Vector &r )
 { 
@@ -158,7 +191,7 @@ int J2ThreeDimensional :: setTrialStrain( const Vector &v, const Vector &r )
 
 int J2ThreeDimensional :: setTrialStrainIncr( const Vector &v ) 
 {
-  static Vector newStrain(6);
+  static thread_local Vector newStrain(6);
   newStrain(0) = strain(0,0) + v(0);
   newStrain(1) = strain(1,1) + v(1);
   newStrain(2) = strain(2,2) + v(2);
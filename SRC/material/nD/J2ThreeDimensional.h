@@ -118,12 +118,20 @@ class J2ThreeDimensional : public J2Plasticity {
   const Matrix& getTangent( ) ;
   const Matrix& getInitialTangent( ) ;
 
+  //batch versions, see NDMaterial
+  int setTrialStrainBatch( int n, NDMaterial **theMaterials,
+			   const double *strain, int size ) ;
+  int commitStateBatch( int n, NDMaterial **theMaterials ) ;
+  int revertToLastCommitBatch( int n, NDMaterial **theMaterials ) ;
+
+  bool isThreadSafe( ) { return true ; }
+
   private :
 
-  //static vectors and matrices
-  static Vector strain_vec ;     //strain in vector notation
-  static Vector stress_vec ;     //stress in vector notation
-  static Matrix tangent_matrix ; //material tangent in matrix notation
+  //static vectors and matrices, one set per thread
+  static thread_local Vector strain_vec ;     //strain in vector notation
+  static thread_local Vector stress_vec ;     //stress in vector notation
+  static thread_local Matrix tangent_matrix ; //material tangent in matrix notation
 
 } ; //end of J2ThreeDimensional declarations
 
@@ -54,6 +54,7 @@ Matrix NDMaterial::errMatrix(1,1);
 Vector NDMaterial::errVector(1);
 
 static MapOfTaggedObjects theNDMaterialObjects;
+static bool theNDMaterialObjectsRegistered = MapOfTaggedObjects::addModelStorage(theNDMaterialObjects);
 
 bool OPS_addNDMaterial(NDMaterial *newComponent)
 {
@@ -82,6 +83,19 @@ NDMaterial *OPS_getNDMaterial(int tag)
   return theMat;
 }
 
+// switches the stage of all copies of the material with the tag through the
+// one kept by the model builder; -1 if there is none or its stage is not kept
+// per tag, e.g. PIMY/PDMY keep it per tag while other materials keep it in
+// each copy
+int OPS_setNDMaterialStage(int tag, int stage)
+{
+  NDMaterial *theMat = (NDMaterial *)theNDMaterialObjects.getComponentPtr(tag);
+  if (theMat == 0 || theMat->setMaterialStage(stage) != 1)
+    return -1;
+
+  return 0;
+}
+
 void OPS_clearAllNDMaterial(void)
 {
     theNDMaterialObjects.clearAll();
@@ -107,13 +121,13 @@ void OPS_printNDMaterial(OPS_Stream &s, int flag) {
 }
 
 NDMaterial::NDMaterial(int tag, int classTag)
-:Material(tag,classTag)
+:Material(tag,classTag), trialStateCurrent(false)
 {
 
 }
 
 NDMaterial::NDMaterial()
-:Material(0, 0)
+:Material(0, 0), trialStateCurrent(false)
 {
 
 }
@@ -123,6 +137,23 @@ NDMaterial::~NDMaterial()
 
 }
 
+bool
+NDMaterial::trialStateUnchanged(const Vector &eps, const Vector &epsLast) const
+{
+  if (trialStateCurrent == false)
+    return false;
+
+  int size = eps.Size();
+  if (size != epsLast.Size())
+    return false;
+
+  for (int i = 0; i < size; i++)
+    if (eps(i) != epsLast(i))
+      return false;
+
+  return true;
+}
+
 NDMaterial*
 NDMaterial::getCopy(const char *type)
 {
@@ -199,6 +230,114 @@ NDMaterial::setTrialStrainIncr(const Vector &v, const Vector &r)
    return -1;    
 }
 
+int
+NDMaterial::setTrialStrainBatch(int n, NDMaterial **theMaterials,
+				const double *strain, int size)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Vector eps(const_cast<double *>(strain) + i*size, size);
+    res += theMaterials[i]->setTrialStrain(eps);
+  }
+
+  return res;
+}
+
+int
+NDMaterial::commitStateBatch(int n, NDMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += theMaterials[i]->commitState();
+
+  return res;
+}
+
+int
+NDMaterial::revertToLastCommitBatch(int n, NDMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += theMaterials[i]->revertToLastCommit();
+
+  return res;
+}
+
+// length of the run of materials of the class of theMaterials[0]
+static int
+classRun(int n, NDMaterial **theMaterials)
+{
+  int classTag = theMaterials[0]->getClassTag();
+  int j = 1;
+  while (j < n && theMaterials[j]->getClassTag() == classTag)
+    j++;
+
+  return j;
+}
+
+int
+NDMaterial::setTrialStrainGroups(int n, NDMaterial **theMaterials,
+				 const double *strain, int size)
+{
+  int res = 0;
+  for (int i = 0; i < n; ) {
+    int m = classRun(n-i, theMaterials+i);
+    res += theMaterials[i]->setTrialStrainBatch(m, theMaterials+i, strain+i*size, size);
+    i += m;
+  }
+
+  return res;
+}
+
+int
+NDMaterial::commitStateGroups(int n, NDMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; ) {
+    int m = classRun(n-i, theMaterials+i);
+    res += theMaterials[i]->commitStateBatch(m, theMaterials+i);
+    i += m;
+  }
+
+  return res;
+}
+
+int
+NDMaterial::revertToLastCommitGroups(int n, NDMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; ) {
+    int m = classRun(n-i, theMaterials+i);
+    res += theMaterials[i]->revertToLastCommitBatch(m, theMaterials+i);
+    i += m;
+  }
+
+  return res;
+}
+
+int
+NDMaterial::setMaterialStageGroups(int n, NDMaterial **theMaterials, int stage)
+{
+  int res = 0;
+  for (int i = 0; i < n; ) {
+    int ok = theMaterials[i]->setMaterialStage(stage);
+    if (ok < 0)
+      res = -1;
+
+    int m = 1;
+    if (ok == 1) {
+      int tag = theMaterials[i]->getTag();
+      int classTag = theMaterials[i]->getClassTag();
+      while (i+m < n && theMaterials[i+m]->getTag() == tag &&
+	     theMaterials[i+m]->getClassTag() == classTag)
+	m++;
+    }
+    i += m;
+  }
+
+  return res;
+}
+
 const Matrix &
 NDMaterial::getTangent(void)
 {
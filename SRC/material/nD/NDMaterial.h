@@ -76,6 +76,41 @@ class NDMaterial : public Material
     virtual int revertToLastCommit(void) = 0;
     virtual int revertToStart(void) = 0;
 
+    // true while the stress & tangent held by the material are those of its
+    // current trial strain, so repeated getStress()/getTangent() calls are
+    // free; only set by materials that memoize their state update
+    bool isTrialStateCurrent(void) const {return trialStateCurrent;}
+
+    // true if the state methods of the object may be invoked concurrently
+    // with those of other materials, i.e. its work areas are thread local
+    virtual bool isThreadSafe(void) {return false;}
+
+    // batch versions of setTrialStrain(), commitState() and revertToLastCommit()
+    // for n materials of the same class as this one; the trial strain of
+    // theMaterials[i] is the size values starting at strain[i*size]
+    virtual int setTrialStrainBatch(int n, NDMaterial **theMaterials,
+				    const double *strain, int size);
+    virtual int commitStateBatch(int n, NDMaterial **theMaterials);
+    virtual int revertToLastCommitBatch(int n, NDMaterial **theMaterials);
+
+    // the batch calls above for n materials of any classes, each run of
+    // consecutive materials of one class is passed in one batch call
+    static int setTrialStrainGroups(int n, NDMaterial **theMaterials,
+				    const double *strain, int size);
+    static int commitStateGroups(int n, NDMaterial **theMaterials);
+    static int revertToLastCommitGroups(int n, NDMaterial **theMaterials);
+
+    // switches the stage (e.g. elastic to elastoplastic) without the string
+    // dispatch of setParameter(); returns 1 if the stage is kept for the
+    // material tag, so all copies of the tag were switched, 0 if only this
+    // object was switched and -1 if not supported (use updateParameter())
+    virtual int setMaterialStage(int stage) {return -1;}
+
+    // setMaterialStage() for n materials; a run of consecutive materials of
+    // one tag and class whose stage is kept per tag is switched in one call.
+    // Returns -1 if any of the materials does not support it
+    static int setMaterialStageGroups(int n, NDMaterial **theMaterials, int stage);
+
     virtual NDMaterial *getCopy(void) = 0;
     virtual NDMaterial *getCopy(const char *code);
 
@@ -97,14 +132,24 @@ class NDMaterial : public Material
     // AddingSensitivity:END ///////////////////////////////////////////
 
   protected:
+    // for setTrialStrain(): true if the state of the trial strain eps is
+    // already current, epsLast being the strain last evaluated
+    bool trialStateUnchanged(const Vector &eps, const Vector &epsLast) const;
+    // to be called with true after a state update and with false whenever
+    // the committed state, the parameters or the trial strain are changed
+    // by other means
+    void setTrialStateCurrent(bool current) {trialStateCurrent = current;}
 
   private:
+    bool trialStateCurrent;
+
     static Matrix errMatrix;
     static Vector errVector;
 };
 
 extern bool OPS_addNDMaterial(NDMaterial *newComponent);
 extern NDMaterial *OPS_getNDMaterial(int tag);
+extern int OPS_setNDMaterialStage(int tag, int stage);
 extern bool OPS_removeNDMaterial(int tag);
 extern void OPS_clearAllNDMaterial(void);
 extern void OPS_printNDMaterial(OPS_Stream &s, int flag = 0);
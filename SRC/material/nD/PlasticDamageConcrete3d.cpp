@@ -25,6 +25,8 @@
 #include <Channel.h>
 #include <cmath>
 #include <elementAPI.h>
+#include <OPS_Globals.h>
+#include <string.h>
 
 static Vector Iv6(6); 
 static Matrix Ivp(6,6); 
@@ -40,8 +42,8 @@ OPS_NewPlasticDamageConcrete3d(void)
   
   int numArgs = OPS_GetNumRemainingInputArgs();
   
-  if (numArgs < 5 || numArgs > 9) {
-    opserr << "Want: nDMaterial PlasticDamageConcrete3d $tag $E $nu $ft $fc <$beta $Ap $An $Bn>\n";
+  if (numArgs < 5 || numArgs > 10) {
+    opserr << "Want: nDMaterial PlasticDamageConcrete3d $tag $E $nu $ft $fc <$beta $Ap $An $Bn> <-implex>\n";
     return 0;	
   }
   
@@ -58,15 +60,37 @@ OPS_NewPlasticDamageConcrete3d(void)
     return 0;
   }
   
-  numData = numArgs - 1;;
-  if (OPS_GetDouble(&numData, dData) != 0) {
-    opserr << "WARNING invalid data: nDMaterial PlasticDamageConcrete3d : " << iData[0] <<"\n";
-    return 0;
-  }  
+  numData = numArgs - 1;
+  if (numData > 8)
+    numData = 8;
+  for (int i = 0; i < numData; i++) {
+    int one = 1;
+    if (OPS_GetDouble(&one, &dData[i]) != 0) {
+      if (i < 4) {
+	opserr << "WARNING invalid data: nDMaterial PlasticDamageConcrete3d : " << iData[0] <<"\n";
+	return 0;
+      }
+      // fewer optional values, step back to read the option
+      OPS_ResetCurrentInputArg(-1);
+      break;
+    }
+  }
+
+  bool implex = false;
+  if (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-implex") == 0)
+      implex = true;
+    else {
+      opserr << "WARNING invalid option " << opt << ": nDMaterial PlasticDamageConcrete3d : " << iData[0] <<"\n";
+      return 0;
+    }
+  }
   
   theMaterial = new PlasticDamageConcrete3d(iData[0], 
 					    dData[0], dData[1], dData[2],dData[3], 
-					    dData[4], dData[5], dData[6],dData[7]);
+					    dData[4], dData[5], dData[6],dData[7],
+					    implex);
 
   return theMaterial;
 }
@@ -80,11 +104,14 @@ PlasticDamageConcrete3d::PlasticDamageConcrete3d(int tag,
 						 double _beta, 
 						 double _Ap, 
 						 double _An, 
-						 double _Bn)
+						 double _Bn,
+						 bool _implex)
   :NDMaterial(tag,ND_TAG_PlasticDamageConcrete3d),
  E(_e), nu(_nu), ft(_ft), fc(_fc), beta(_beta), Ap(_Ap), An(_An), Bn(_Bn),
+ implex(false),
  eps(6), sig(6), sige(6), eps_p(6), sigeP(6),
  epsCommit(6), sigCommit(6), sigeCommit(6), eps_pCommit(6), sigePCommit(6),
+ rpCommitOld(0.0), rnCommitOld(0.0), dt(0.0), dtCommit(0.0),
  Ce(6,6), C(6,6), Ccommit(6,6)
 {
   eps.Zero();
@@ -111,6 +138,10 @@ PlasticDamageConcrete3d::PlasticDamageConcrete3d(int tag,
   dn = 0.;
 
   this->commitState();
+
+  rpCommitOld = rp;
+  rnCommitOld = rn;
+  implex = _implex;
 }
 
 void
@@ -152,8 +183,10 @@ PlasticDamageConcrete3d::setCe(void)
 
 PlasticDamageConcrete3d::PlasticDamageConcrete3d()
   :NDMaterial (0, ND_TAG_PlasticDamageConcrete3d),
+   implex(false),
    eps(6), sig(6), sige(6), eps_p(6), sigeP(6),
    epsCommit(6), sigCommit(6), sigeCommit(6), eps_pCommit(6), sigePCommit(6),
+   rpCommitOld(0.0), rnCommitOld(0.0), dt(0.0), dtCommit(0.0),
    Ce(6,6), C(6,6), Ccommit(6,6)
 {
 
@@ -232,6 +265,10 @@ PlasticDamageConcrete3d::setTrialStrain (const Vector &strain)
 {
   //  opserr << "PlasticDamageConcrete3d::setTrialStrain: " << strain << endln;
 
+  // sig and C are already those of this strain
+  if (this->trialStateUnchanged(strain, eps))
+    return 0;
+
   // bunch of Vectors and Matrices used in the method
   static Vector Depse_tr(6);
   static Vector Deps(6);  
@@ -374,6 +411,32 @@ PlasticDamageConcrete3d::setTrialStrain (const Vector &strain)
   // DAMAGE part
   // decompose into positive and negative effective stress tensor
   StrsDecA(sige, sigpos, signeg, Qpos, Qneg);    // decompose the effective stress  
+
+  if (implex) {
+    // IMPL-EX: damage from the extrapolated thresholds, the tangent has
+    // no damage evolution terms; the implicit update is done at commit
+    dt = ops_Dt;
+    rp = implexExtrapolate(rpCommit, rpCommitOld, dt, dtCommit);
+    rn = implexExtrapolate(rnCommit, rnCommitOld, dt, dtCommit);
+
+    if (rp > rpCommit) {
+      dp = (1 - rp0/rp * exp(Ap*(1 - rp/rp0)))*(1-tol);
+      if (dp > 1-tol) dp = 1-tol;
+    }
+    if (rn > rnCommit) {
+      dn = (1 - rn0/rn*(1-An) - An*exp(Bn*(1 - rn/rn0)))*(1-tol);
+      if (dn > 1-tol) dn = 1-tol;
+    }
+
+    sig = (1-dp)*sigpos + (1-dn)*signeg;
+
+    Dsigpos_Deps = Qpos*Cbar;
+    Dsigneg_Deps = Qneg*Cbar;
+    C = (1-dp)*Dsigpos_Deps + (1-dn)*Dsigneg_Deps;
+
+    this->setTrialStateCurrent(true);
+    return 0;
+  }
     
   // calculate equivalent stresses
   static Vector tmp(6);
@@ -519,12 +582,14 @@ PlasticDamageConcrete3d::setTrialStrain (const Vector &strain)
   opserr << "Stress: " << sig << endln;
   */
 
+  this->setTrialStateCurrent(true);
   return 0;
 }
 
 int
 PlasticDamageConcrete3d::setTrialStrainIncr (const Vector &strain)
 {
+  this->setTrialStateCurrent(false);
   eps += strain;
   this->setTrialStrain(eps);
   return 0;
@@ -533,6 +598,7 @@ PlasticDamageConcrete3d::setTrialStrainIncr (const Vector &strain)
 int
 PlasticDamageConcrete3d::setTrialStrainIncr (const Vector &strain, const Vector &rate)
 {
+  this->setTrialStateCurrent(false);
   eps += strain;
   this->setTrialStrain(eps);
   return 0;
@@ -565,6 +631,23 @@ PlasticDamageConcrete3d::getStrain (void)
 int
 PlasticDamageConcrete3d::commitState (void)
 {
+  // a trial state about the new committed one is to be different
+  this->setTrialStateCurrent(false);
+
+  if (implex) {
+    // implicit update at the converged strain
+    static Vector strain(6);
+    strain = eps;
+    implex = false;
+    this->setTrialStrain(strain);
+    implex = true;
+    this->setTrialStateCurrent(false);
+
+    rpCommitOld = rpCommit;
+    rnCommitOld = rnCommit;
+    dtCommit = dt;
+  }
+
   Ccommit = C;
   rpCommit = rp;
   rnCommit = rn;
@@ -581,6 +664,7 @@ PlasticDamageConcrete3d::commitState (void)
 int
 PlasticDamageConcrete3d::revertToLastCommit (void)
 {
+  this->setTrialStateCurrent(false);
   C = Ccommit;
   rp = rpCommit;
   rn = rnCommit;
@@ -597,6 +681,7 @@ PlasticDamageConcrete3d::revertToLastCommit (void)
 int
 PlasticDamageConcrete3d::revertToStart (void)
 {
+  this->setTrialStateCurrent(false);
   eps.Zero();
   sig.Zero();
   sige.Zero();
@@ -605,6 +690,11 @@ PlasticDamageConcrete3d::revertToStart (void)
   Ce.Zero();
 
   this->setCe();
+
+  rpCommitOld = rpCommit;
+  rnCommitOld = rnCommit;
+  dt = 0.0;
+  dtCommit = 0.0;
   
   return 0;
 }
@@ -614,7 +704,7 @@ PlasticDamageConcrete3d::getCopy(const char *type)
 {
   if (strcmp(type,"ThreeDimensional") == 0 || strcmp(type,"3D") == 0) {
     PlasticDamageConcrete3d *theCopy =
-      new PlasticDamageConcrete3d (this->getTag(), E, nu, ft, fc, beta, Ap, An, Bn);
+      new PlasticDamageConcrete3d (this->getTag(), E, nu, ft, fc, beta, Ap, An, Bn, implex);
   
     return theCopy;  
   } else {
@@ -626,7 +716,7 @@ NDMaterial*
 PlasticDamageConcrete3d::getCopy (void)
 {
   PlasticDamageConcrete3d *theCopy =
-    new PlasticDamageConcrete3d (this->getTag(), E, nu, ft, fc, beta, Ap, An, Bn);
+    new PlasticDamageConcrete3d (this->getTag(), E, nu, ft, fc, beta, Ap, An, Bn, implex);
   
   return theCopy;
 }
@@ -647,7 +737,7 @@ PlasticDamageConcrete3d::getOrder (void) const
 int 
 PlasticDamageConcrete3d::sendSelf(int commitTag, Channel &theChannel)
 {
-  static Vector data(1+8+4 + 5*6);
+  static Vector data(1+8+4 + 5*6 + 4);
 
   data(0) = this->getTag();
 
@@ -673,6 +763,11 @@ PlasticDamageConcrete3d::sendSelf(int commitTag, Channel &theChannel)
     data(13+24+i) = sigePCommit(i);    
   }
 
+  data(43) = implex ? 1.0 : 0.0;
+  data(44) = rpCommitOld;
+  data(45) = rnCommitOld;
+  data(46) = dtCommit;
+
   int res = 0;
   int dbTag = this->getDbTag();
 
@@ -698,7 +793,7 @@ PlasticDamageConcrete3d::recvSelf(int commitTag, Channel &theChannel,
   int res = 0;
   int dbTag = this->getDbTag();
 
-  static Vector data(43);  
+  static Vector data(47);  
   res = theChannel.recvVector(dbTag, commitTag, data);
   if (res < 0) {
     opserr << "PlasticDamageConcrete3d::recvSelf -- could not receive Vector\n";
@@ -728,6 +823,11 @@ PlasticDamageConcrete3d::recvSelf(int commitTag, Channel &theChannel,
     eps_pCommit(i) = data(13+18+i);
     sigePCommit(i) = data(13+24+i);
   }
+
+  implex = (data(43) != 0.0);
+  rpCommitOld = data(44);
+  rnCommitOld = data(45);
+  dtCommit = data(46);
   
   res = theChannel.recvMatrix(dbTag, commitTag, Ccommit);
   if (res < 0) {
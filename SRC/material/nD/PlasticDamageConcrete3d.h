@@ -49,7 +49,8 @@ class PlasticDamageConcrete3d : public NDMaterial
 			  double beta = 0.6, 
 			  double Ap = 0.5, 
 			  double An = 2.0, 
-			  double Bn = 0.75);
+			  double Bn = 0.75,
+			  bool implex = false);
     PlasticDamageConcrete3d();
     ~PlasticDamageConcrete3d();
 
@@ -91,6 +92,7 @@ class PlasticDamageConcrete3d : public NDMaterial
     double Ap;    // damage parameter
     double An;    // damage parameter
     double Bn;    // damage parameter
+    bool implex;  // IMPL-EX integration, see Material
 
     // current state variables
     double rp;    // positive damage threshold
@@ -116,6 +118,13 @@ class PlasticDamageConcrete3d : public NDMaterial
     Vector eps_pCommit; 
     Vector sigePCommit; 
 
+    // IMPL-EX: damage thresholds of the step before the last committed
+    // one and the time steps
+    double rpCommitOld;
+    double rnCommitOld;
+    double dt;
+    double dtCommit;
+
     // tangent matrices
     Matrix Ce; 
     Matrix C; 
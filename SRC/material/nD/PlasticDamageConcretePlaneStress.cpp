@@ -169,6 +169,11 @@ PlasticDamageConcretePlaneStress::setCe(void)
  int
  PlasticDamageConcretePlaneStress::setTrialStrain (const Vector &strain)
  {
+   // stress and Ce are already those of this strain
+   Vector epsLast(eps, 3);
+   if (this->trialStateUnchanged(strain, epsLast))
+     return 0;
+
    eps[0] = strain(0);
    eps[1] = strain(1);
    eps[2] = strain(2);
@@ -1004,9 +1009,11 @@ PlasticDamageConcretePlaneStress::setCe(void)
    Ce = dsig_ds*Ce + 1.0e-12*Ce;
    for (int i = 0; i < 3; i++) {
      stress(i) = sig[i];
+     this->strain(i) = eps[i];
    }
 
    //   opserr <<  "PlasticDamageConcretePlaneStress::sTS -18\n";         
+   this->setTrialStateCurrent(true);
    return 0;
  }
 
@@ -1014,6 +1021,7 @@ PlasticDamageConcretePlaneStress::setCe(void)
 int
 PlasticDamageConcretePlaneStress::setTrialStrainIncr (const Vector &dStrain)
 {
+  this->setTrialStateCurrent(false);
   strain += dStrain;
   this->setTrialStrain(strain);
   return 0;
@@ -1022,6 +1030,7 @@ PlasticDamageConcretePlaneStress::setTrialStrainIncr (const Vector &dStrain)
 int
 PlasticDamageConcretePlaneStress::setTrialStrainIncr (const Vector &dStrain, const Vector &rate)
 {
+  this->setTrialStateCurrent(false);
   strain += dStrain;
   this->setTrialStrain(strain);
   return 0;
@@ -1054,6 +1063,8 @@ PlasticDamageConcretePlaneStress::getStrain (void)
 int
 PlasticDamageConcretePlaneStress::commitState (void)
 {
+  this->setTrialStateCurrent(false);
+
   CeCommitted = Ce;
 
   for (int i=0; i<4; i++) {
@@ -1078,6 +1089,8 @@ PlasticDamageConcretePlaneStress::commitState (void)
 int
 PlasticDamageConcretePlaneStress::revertToLastCommit (void)
 {
+  this->setTrialStateCurrent(false);
+
   Ce = CeCommitted; 
 
   for (int i=0; i<4; i++) {
@@ -1101,6 +1114,8 @@ PlasticDamageConcretePlaneStress::revertToLastCommit (void)
 int
 PlasticDamageConcretePlaneStress::revertToStart (void)
 {
+  this->setTrialStateCurrent(false);
+
   for (int i=0; i<3; i++) {
     Committed_sig[i]=0.;
     Committed_eps[i]=0.;
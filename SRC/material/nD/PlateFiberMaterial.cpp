@@ -33,14 +33,16 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <elementAPI.h>
+#include <vector>
 
 //static vector and matrices
-Vector  PlateFiberMaterial::stress(5);
-Matrix  PlateFiberMaterial::tangent(5,5);
+thread_local Vector  PlateFiberMaterial::stress(5);
+thread_local Matrix  PlateFiberMaterial::tangent(5,5);
 
 //      0  1  2  3  4  5
 // ND: 11 22 33 12 23 31
 // PF: 11 22 12 23 31 33
+static const int pf2nd[5] = {0, 1, 3, 4, 5};
 
 void* OPS_PlateFiberMaterial()
 {
@@ -79,6 +81,7 @@ void* OPS_PlateFiberMaterial()
 //null constructor
 PlateFiberMaterial::PlateFiberMaterial() : 
 NDMaterial(0, ND_TAG_PlateFiberMaterial), 
+usePredictor(false),
 theMaterial(0),
 strain(5) 
 { 
@@ -92,6 +95,7 @@ PlateFiberMaterial::PlateFiberMaterial(
 				   int tag, 
                                    NDMaterial &the3DMaterial) :
 NDMaterial(tag, ND_TAG_PlateFiberMaterial),
+usePredictor(false),
 strain(5)
 {
   theMaterial = the3DMaterial.getCopy("ThreeDimensional");
@@ -166,6 +170,7 @@ int
 PlateFiberMaterial::revertToLastCommit()
 {
   Tstrain22 = Cstrain22;
+  usePredictor = false;
 
   return theMaterial->revertToLastCommit();
 }
@@ -177,6 +182,7 @@ PlateFiberMaterial::revertToStart()
 {
   this->Tstrain22 = 0.0;
   this->Cstrain22 = 0.0;
+  usePredictor = false;
 
   return theMaterial->revertToStart();
 }
@@ -195,69 +201,171 @@ int
 PlateFiberMaterial::setTrialStrain(const Vector &strainFromElement)
 {
   static const double tolerance = 1.0e-08;
+  const int maxCount = 20;
 
-  strain(0) = strainFromElement(0); //11
-  strain(1) = strainFromElement(1); //22
-  strain(2) = strainFromElement(2); //12
-  strain(3) = strainFromElement(3); //23
-  strain(4) = strainFromElement(4); //31
-
-  double norm;
-  double condensedStress;
-  double strainIncrement;
-  static Vector threeDstrain(6);
-  double dd22;
+  static thread_local Vector threeDstrain(6);
 
-  int count = 0;
-  const int maxCount = 20;
-  double norm0;
+  this->predictStrain22(strainFromElement);
 
   //newton loop to solve for out-of-plane strains
-  do {
+  for (int count = 0; ; count++) {
 
-    //set three dimensional strain
-    threeDstrain(0) = this->strain(0);
-    threeDstrain(1) = this->strain(1);
-    threeDstrain(2) = this->Tstrain22;
-    threeDstrain(3) = this->strain(2); 
-    threeDstrain(4) = this->strain(3);
-    threeDstrain(5) = this->strain(4);
+    this->getThreeDStrain(&threeDstrain(0));
 
     if (theMaterial->setTrialStrain(threeDstrain) < 0) {
       opserr << "PlateFiberMaterial::setTrialStrain - material failed in setTrialStrain() with strain " << threeDstrain;
       return -1;
     }
 
-    //three dimensional stress
-    const Vector &threeDstress = theMaterial->getStress();
+    if (this->condenseStrain22(tolerance, count < maxCount))
+      break;
+  }
 
-    //three dimensional tangent 
-    const Matrix &threeDtangent = theMaterial->getTangent();
+  usePredictor = true;
+
+  return 0;
+}
+
+
+//receive the strains of n plate fibers
+int 
+PlateFiberMaterial::setTrialStrainBatch(int n, NDMaterial **theMaterials,
+					const double *strainFromElement, int size)
+{
+  static const double tolerance = 1.0e-08;
+  const int maxCount = 20;
+
+  static thread_local std::vector<PlateFiberMaterial *> active;
+  static thread_local std::vector<NDMaterial *> threeDMaterials;
+  static thread_local std::vector<double> threeDstrain;
 
-    //NDmaterial strain order          = 11, 22, 33, 12, 23, 31 
-    //PlateFiberMaterial strain order =  11, 22, 12, 23, 31, 33 
+  active.resize(n);
+  for (int i = 0; i < n; i++) {
+    active[i] = static_cast<PlateFiberMaterial *>(theMaterials[i]);
+    Vector eps(const_cast<double *>(strainFromElement) + i*size, size);
+    active[i]->predictStrain22(eps);
+  }
 
-    condensedStress = threeDstress(2);
+  //newton loop on the fibers with a nonzero out-of-plane stress, the
+  //three dimensional materials of those are set in one call per class
+  int numActive = n;
+  for (int count = 0; numActive > 0; count++) {
 
-    dd22 = threeDtangent(2,2);
+    threeDMaterials.resize(numActive);
+    threeDstrain.resize(6*numActive);
+    for (int i = 0; i < numActive; i++) {
+      threeDMaterials[i] = active[i]->theMaterial;
+      active[i]->getThreeDStrain(&threeDstrain[6*i]);
+    }
 
-    //set norm
-    norm = fabs(condensedStress);
-    if (count == 0)
-      norm0 = norm;
+    if (NDMaterial::setTrialStrainGroups(numActive, &threeDMaterials[0],
+					 &threeDstrain[0], 6) < 0) {
+      opserr << "PlateFiberMaterial::setTrialStrainBatch - material failed in setTrialStrain()\n";
+      return -1;
+    }
 
-    //condensation 
-    strainIncrement = condensedStress/dd22;
+    int numLeft = 0;
+    for (int i = 0; i < numActive; i++)
+      if (active[i]->condenseStrain22(tolerance, count < maxCount) == false)
+	active[numLeft++] = active[i];
 
-    //update out of plane strains
-    Tstrain22 -= strainIncrement;
+    numActive = numLeft;
+  }
 
-  } while (count++ < maxCount && norm > tolerance);
+  for (int i = 0; i < n; i++)
+    static_cast<PlateFiberMaterial *>(theMaterials[i])->usePredictor = true;
 
   return 0;
 }
 
 
+int 
+PlateFiberMaterial::commitStateBatch(int n, NDMaterial **theMaterials)
+{
+  static thread_local std::vector<NDMaterial *> threeDMaterials;
+  threeDMaterials.resize(n);
+
+  for (int i = 0; i < n; i++) {
+    PlateFiberMaterial *theFiber = static_cast<PlateFiberMaterial *>(theMaterials[i]);
+    theFiber->Cstrain22 = theFiber->Tstrain22;
+    threeDMaterials[i] = theFiber->theMaterial;
+  }
+
+  return NDMaterial::commitStateGroups(n, &threeDMaterials[0]);
+}
+
+
+int 
+PlateFiberMaterial::revertToLastCommitBatch(int n, NDMaterial **theMaterials)
+{
+  static thread_local std::vector<NDMaterial *> threeDMaterials;
+  threeDMaterials.resize(n);
+
+  for (int i = 0; i < n; i++) {
+    PlateFiberMaterial *theFiber = static_cast<PlateFiberMaterial *>(theMaterials[i]);
+    theFiber->Tstrain22 = theFiber->Cstrain22;
+    theFiber->usePredictor = false;
+    threeDMaterials[i] = theFiber->theMaterial;
+  }
+
+  return NDMaterial::revertToLastCommitGroups(n, &threeDMaterials[0]);
+}
+
+
+void
+PlateFiberMaterial::predictStrain22(const Vector &strainFromElement)
+{
+  if (usePredictor) {
+    const Matrix &threeDtangent = theMaterial->getTangent();
+
+    double dd22 = threeDtangent(2,2);
+    if (dd22 != 0.0) {
+      double dsigma22 = 0.0;
+      for (int i = 0; i < 5; i++)
+	dsigma22 += threeDtangent(2,pf2nd[i]) * (strainFromElement(i) - strain(i));
+
+      Tstrain22 -= dsigma22/dd22;
+    }
+  }
+
+  strain(0) = strainFromElement(0); //11
+  strain(1) = strainFromElement(1); //22
+  strain(2) = strainFromElement(2); //12
+  strain(3) = strainFromElement(3); //23
+  strain(4) = strainFromElement(4); //31
+}
+
+
+void
+PlateFiberMaterial::getThreeDStrain(double *threeDstrain) const
+{
+  threeDstrain[0] = strain(0);
+  threeDstrain[1] = strain(1);
+  threeDstrain[2] = Tstrain22;
+  threeDstrain[3] = strain(2); 
+  threeDstrain[4] = strain(3);
+  threeDstrain[5] = strain(4);
+}
+
+
+bool
+PlateFiberMaterial::condenseStrain22(double tolerance, bool iterate)
+{
+  //NDmaterial strain order          = 11, 22, 33, 12, 23, 31 
+  //PlateFiberMaterial strain order =  11, 22, 12, 23, 31, 33 
+
+  double condensedStress = theMaterial->getStress()(2);
+
+  if (fabs(condensedStress) <= tolerance || iterate == false)
+    return true;
+
+  //update out of plane strains
+  Tstrain22 -= condensedStress / theMaterial->getTangent()(2,2);
+
+  return false;
+}
+
+
 //send back the strain
 const Vector& 
 PlateFiberMaterial::getStrain()
@@ -295,7 +403,7 @@ PlateFiberMaterial::getStressSensitivity(int gradIndex,
 
   const Matrix &threeDtangent = theMaterial->getTangent();
 
-  static Vector dd12(5);
+  static thread_local Vector dd12(5);
   dd12(0) = threeDtangent(0,2);
   dd12(1) = threeDtangent(1,2);
   dd12(2) = threeDtangent(3,2);
@@ -317,134 +425,29 @@ PlateFiberMaterial::getStressSensitivity(int gradIndex,
 const Matrix&  
 PlateFiberMaterial::getTangent()
 {
-  const Matrix &threeDtangent = theMaterial->getTangent();
-
-  static Matrix dd11(5,5);
-  dd11(0,0) = threeDtangent(0,0);
-  dd11(1,0) = threeDtangent(1,0);
-  dd11(2,0) = threeDtangent(3,0);
-  dd11(3,0) = threeDtangent(4,0);
-  dd11(4,0) = threeDtangent(5,0);
-
-  dd11(0,1) = threeDtangent(0,1);
-  dd11(1,1) = threeDtangent(1,1);
-  dd11(2,1) = threeDtangent(3,1);
-  dd11(3,1) = threeDtangent(4,1);
-  dd11(4,1) = threeDtangent(5,1);
-
-  dd11(0,2) = threeDtangent(0,3);
-  dd11(1,2) = threeDtangent(1,3);
-  dd11(2,2) = threeDtangent(3,3);
-  dd11(3,2) = threeDtangent(4,3);
-  dd11(4,2) = threeDtangent(5,3);
-
-  dd11(0,3) = threeDtangent(0,4);
-  dd11(1,3) = threeDtangent(1,4);
-  dd11(2,3) = threeDtangent(3,4);
-  dd11(3,3) = threeDtangent(4,4);
-  dd11(4,3) = threeDtangent(5,4);
-
-  dd11(0,4) = threeDtangent(0,5);
-  dd11(1,4) = threeDtangent(1,5);
-  dd11(2,4) = threeDtangent(3,5);
-  dd11(3,4) = threeDtangent(4,5);
-  dd11(4,4) = threeDtangent(5,5);
-
-  static Matrix dd12(5,1);
-  dd12(0,0) = threeDtangent(0,2);
-  dd12(1,0) = threeDtangent(1,2);
-  dd12(2,0) = threeDtangent(3,2);
-  dd12(3,0) = threeDtangent(4,2);
-  dd12(4,0) = threeDtangent(5,2);
-
-  static Matrix dd21(1,5);
-  dd21(0,0) = threeDtangent(2,0);
-  dd21(0,1) = threeDtangent(2,1);
-  dd21(0,2) = threeDtangent(2,3);
-  dd21(0,3) = threeDtangent(2,4);
-  dd21(0,4) = threeDtangent(2,5);
-
-  double dd22 = threeDtangent(2,2);
-
-  //int Solve(const Vector &V, Vector &res) const;
-  //int Solve(const Matrix &M, Matrix &res) const;
-  //condensation 
-  static Matrix dd22invdd21(1,5);
-  //dd22.Solve(dd21, dd22invdd21);
-  dd22invdd21.addMatrix(0.0, dd21, 1.0/dd22);
-
-  //this->tangent   = dd11; 
-  //this->tangent  -= (dd12*dd22invdd21);
-  dd11.addMatrixProduct(1.0, dd12, dd22invdd21, -1.0);
-  tangent = dd11;
-
-  return tangent;
+  return this->condenseTangent(theMaterial->getTangent());
 }
 
 
 const Matrix&  
 PlateFiberMaterial::getInitialTangent()
 {
-  const Matrix &threeDtangent = theMaterial->getInitialTangent();
-
-  static Matrix dd11(5,5);
-  dd11(0,0) = threeDtangent(0,0);
-  dd11(1,0) = threeDtangent(1,0);
-  dd11(2,0) = threeDtangent(3,0);
-  dd11(3,0) = threeDtangent(4,0);
-  dd11(4,0) = threeDtangent(5,0);
-
-  dd11(0,1) = threeDtangent(0,1);
-  dd11(1,1) = threeDtangent(1,1);
-  dd11(2,1) = threeDtangent(3,1);
-  dd11(3,1) = threeDtangent(4,1);
-  dd11(4,1) = threeDtangent(5,1);
-
-  dd11(0,2) = threeDtangent(0,3);
-  dd11(1,2) = threeDtangent(1,3);
-  dd11(2,2) = threeDtangent(3,3);
-  dd11(3,2) = threeDtangent(4,3);
-  dd11(4,2) = threeDtangent(5,3);
-
-  dd11(0,3) = threeDtangent(0,4);
-  dd11(1,3) = threeDtangent(1,4);
-  dd11(2,3) = threeDtangent(3,4);
-  dd11(3,3) = threeDtangent(4,4);
-  dd11(4,3) = threeDtangent(5,4);
-
-  dd11(0,4) = threeDtangent(0,5);
-  dd11(1,4) = threeDtangent(1,5);
-  dd11(2,4) = threeDtangent(3,5);
-  dd11(3,4) = threeDtangent(4,5);
-  dd11(4,4) = threeDtangent(5,5);
-
-  static Matrix dd12(5,1);
-  dd12(0,0) = threeDtangent(0,2);
-  dd12(1,0) = threeDtangent(1,2);
-  dd12(2,0) = threeDtangent(3,2);
-  dd12(3,0) = threeDtangent(4,2);
-  dd12(4,0) = threeDtangent(5,2);
-
-  static Matrix dd21(1,5);
-  dd21(0,0) = threeDtangent(2,0);
-  dd21(0,1) = threeDtangent(2,1);
-  dd21(0,2) = threeDtangent(2,3);
-  dd21(0,3) = threeDtangent(2,4);
-  dd21(0,4) = threeDtangent(2,5);
+  return this->condenseTangent(theMaterial->getInitialTangent());
+}
 
-  double dd22 = threeDtangent(2,2);
 
-  //int Solve(const Vector &V, Vector &res) const;
-  //int Solve(const Matrix &M, Matrix &res) const;
-  //condensation 
-  static Matrix dd22invdd21(1,5);
-  //dd22.Solve(dd21, dd22invdd21);
-  dd22invdd21.addMatrix(0.0, dd21, 1.0/dd22);
+//condensation of the out of plane stress
+//tangent = dd11 - dd12*dd21/dd22
+const Matrix&
+PlateFiberMaterial::condenseTangent(const Matrix &threeDtangent)
+{
+  double dd22 = threeDtangent(2,2);
 
-  //this->tangent   = dd11; 
-  //this->tangent  -= (dd12*dd22invdd21);
-  dd11.addMatrixProduct(1.0, dd12, dd22invdd21, -1.0);
-  tangent = dd11;
+  for (int j = 0; j < 5; j++) {
+    double dd21j = threeDtangent(2,pf2nd[j]) / dd22;
+    for (int i = 0; i < 5; i++)
+      tangent(i,j) = threeDtangent(pf2nd[i],pf2nd[j]) - threeDtangent(pf2nd[i],2)*dd21j;
+  }
 
   return tangent;
 }
@@ -549,6 +552,7 @@ PlateFiberMaterial::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroke
 
   Cstrain22 = vecData(0);
   Tstrain22 = Cstrain22;
+  usePredictor = false;
 
   // now receive the associated materials data
   res = theMaterial->recvSelf(commitTag, theChannel, theBroker);
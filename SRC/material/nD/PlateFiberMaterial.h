@@ -80,6 +80,13 @@ class PlateFiberMaterial: public NDMaterial{
     //get the strain 
     int setTrialStrain( const Vector &strainFromElement ) ;
 
+    //batch versions, the out-of-plane strains of the n fibers are
+    //iterated on together
+    int setTrialStrainBatch( int n, NDMaterial **theMaterials,
+			     const double *strain, int size ) ;
+    int commitStateBatch( int n, NDMaterial **theMaterials ) ;
+    int revertToLastCommitBatch( int n, NDMaterial **theMaterials ) ;
+
     //send back the strain
     const Vector& getStrain( ) ;
 
@@ -107,17 +114,34 @@ class PlateFiberMaterial: public NDMaterial{
 
   private :
 
+    //start the out of plane strain from the value that makes the
+    //stress zero for the last tangent, then set the in-plane strain
+    void predictStrain22( const Vector &strainFromElement ) ;
+
+    //three dimensional strain of the trial state
+    void getThreeDStrain( double *threeDstrain ) const ;
+
+    //newton update of the out of plane strain, true when converged
+    bool condenseStrain22( double tolerance, bool iterate ) ;
+
+    //condensed plate fiber tangent of a three dimensional one
+    const Matrix &condenseTangent( const Matrix &threeDtangent ) ;
+
     //out of plane strain
     double Tstrain22 ;
     double Cstrain22 ;
 
+    //strain and the tangent of theMaterial are those of the last trial
+    //state, so they can be used by the predictor
+    bool usePredictor ;
+
     NDMaterial *theMaterial ;  //pointer to three dimensional material
 
     Vector strain ;
 
-    static Vector stress ;
+    static thread_local Vector stress ;
 
-    static Matrix tangent ;
+    static thread_local Matrix tangent ;
 } ; //end of PlateFiberMaterial declarations
 
 
@@ -413,6 +413,13 @@ InitialStateAnalysisWrapper::setParameter(const char **argv, int argc, Parameter
 	return -1;
 }
 
+int
+InitialStateAnalysisWrapper::setMaterialStage(int stage)
+{
+	// routes the stage switch to the main material
+	return theMainMaterial->setMaterialStage(stage);
+}
+
 int
 InitialStateAnalysisWrapper::updateParameter(int responseID, Information &info)
 {
@@ -81,6 +81,7 @@ class InitialStateAnalysisWrapper : public NDMaterial
 
 	int setParameter(const char **argv, int argc, Parameter &param);
 	int updateParameter(int responseID, Information &eleInformation);
+	int setMaterialStage(int stage);
 	
 	friend class PyLiq1;
 	friend class TzLiq1;
@@ -765,6 +765,14 @@ PM4Sand::setParameter(const char **argv, int argc, Parameter &param)
 	return -1;
 }
 
+// me2p is shared by all the PM4Sand materials, see updateParameter()
+int
+PM4Sand::setMaterialStage(int stage)
+{
+	me2p = stage;
+	return 1;
+}
+
 int
 PM4Sand::updateParameter(int responseID, Information &info)
 {
@@ -763,6 +763,14 @@ PM4Silt::setParameter(const char **argv, int argc, Parameter &param)
 	return -1;
 }
 
+// me2p is shared by all the PM4Silt materials, see updateParameter()
+int
+PM4Silt::setMaterialStage(int stage)
+{
+	me2p = stage;
+	return 1;
+}
+
 int
 PM4Silt::updateParameter(int responseID, Information &info)
 {
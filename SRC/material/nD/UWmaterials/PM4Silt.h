@@ -115,6 +115,7 @@ public:
 
 	int setParameter(const char **argv, int argc, Parameter &param);
 	int updateParameter(int responseID, Information &info);
+	int setMaterialStage(int stage);
 
 
 protected:
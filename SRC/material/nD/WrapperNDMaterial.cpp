@@ -202,6 +202,80 @@ WrapperNDMaterial::revertToStart (void)
 }
 
 
+// as in WrapperUniaxialMaterial, runs of materials sharing a batched
+// entry point go to the library in one call, pointing it to the data of
+// each wrapper; strain is 0 for a commit or a revert
+int
+WrapperNDMaterial::invokeBatch(int n, NDMaterial **theMaterials, int isw,
+                               const double *strain, int size)
+{
+  const int chunk = 64;
+  matObject *mats[chunk];
+  double *e[chunk], *t[chunk], *s[chunk];
+
+  int res = 0;
+  int i = 0;
+  while (i < n) {
+    WrapperNDMaterial *theMat = static_cast<WrapperNDMaterial *>(theMaterials[i]);
+    matBatchFunct theFunct = theMat->theMat->matBatchFunctPtr;
+
+    if (theFunct == 0 || (strain != 0 && theMat->dataSize != size)) {
+      if (strain == 0)
+	res += (isw == ISW_COMMIT) ? theMat->commitState() : theMat->revertToLastCommit();
+      else {
+	Vector eps(const_cast<double *>(strain) + i*size, size);
+	res += theMat->setTrialStrain(eps);
+      }
+      i++;
+      continue;
+    }
+
+    int m = 0;
+    while (i < n && m < chunk) {
+      theMat = static_cast<WrapperNDMaterial *>(theMaterials[i]);
+      if (theMat->theMat->matBatchFunctPtr != theFunct || (strain != 0 && theMat->dataSize != size))
+	break;
+      int dataSize = theMat->dataSize;
+      double *data = theMat->data;
+      if (strain != 0)
+	for (int j = 0; j < size; j++)
+	  data[j] = strain[i*size + j];
+      mats[m] = theMat->theMat;
+      e[m] = &data[0];
+      s[m] = &data[dataSize];
+      t[m] = &data[2*dataSize];
+      m++;
+      i++;
+    }
+
+    int iswi = isw;
+    int error = 0;
+    theFunct(m, mats, &theModelState, e, t, s, &iswi, &error);
+    res += error;
+  }
+
+  return res;
+}
+
+int
+WrapperNDMaterial::setTrialStrainBatch(int n, NDMaterial **theMaterials, const double *strain, int size)
+{
+  return invokeBatch(n, theMaterials, ISW_FORM_TANG_AND_RESID, strain, size);
+}
+
+int
+WrapperNDMaterial::commitStateBatch(int n, NDMaterial **theMaterials)
+{
+  return invokeBatch(n, theMaterials, ISW_COMMIT, 0, 0);
+}
+
+int
+WrapperNDMaterial::revertToLastCommitBatch(int n, NDMaterial **theMaterials)
+{
+  return invokeBatch(n, theMaterials, ISW_REVERT, 0, 0);
+}
+
+
 const char*
 WrapperNDMaterial::getType (void) const
 {
@@ -235,6 +309,7 @@ WrapperNDMaterial::getCopy (void)
     }
 
     theMatObject->matFunctPtr = theMat->matFunctPtr;
+    theMatObject->matBatchFunctPtr = theMat->matBatchFunctPtr;
 
     WrapperNDMaterial *theResult = new WrapperNDMaterial(funcName, theMatObject, matType);
     return theResult;
@@ -281,6 +356,7 @@ WrapperNDMaterial::getCopy (const char *code)
   }
   
   theMatObject->matFunctPtr = theMat->matFunctPtr;
+  theMatObject->matBatchFunctPtr = theMat->matBatchFunctPtr;
   
   WrapperNDMaterial *theResult = new WrapperNDMaterial(funcName, theMatObject, matType);
   return theResult;
@@ -53,6 +53,10 @@ class WrapperNDMaterial : public NDMaterial
   int revertToLastCommit (void);    
   int revertToStart (void);        
 
+  int setTrialStrainBatch(int n, NDMaterial **theMaterials, const double *strain, int size);
+  int commitStateBatch(int n, NDMaterial **theMaterials);
+  int revertToLastCommitBatch(int n, NDMaterial **theMaterials);
+
 
   virtual const char *getType(void) const;  
   NDMaterial *getCopy (void);
@@ -75,6 +79,9 @@ class WrapperNDMaterial : public NDMaterial
   Vector *stress;
   Matrix *tangent;
   Matrix *initTangent;
+
+  static int invokeBatch(int n, NDMaterial **theMaterials, int isw,
+                         const double *strain, int size);
 };
 
 #endif
@@ -311,6 +311,13 @@ int FluidSolidPorousMaterial::setParameter(const char **argv, int argc, Paramete
   return theSoilMaterial->setParameter(argv, argc, param);
 }
 
+// the stage is kept for the material tag, see updateParameter()
+int FluidSolidPorousMaterial::setMaterialStage(int stage)
+{
+  loadStagex[matN] = stage;
+  return 1;
+}
+
 int FluidSolidPorousMaterial::updateParameter(int responseID, Information &info)
 {
   if (responseID == 1) {
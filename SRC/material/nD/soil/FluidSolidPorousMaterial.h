@@ -90,6 +90,7 @@ class FluidSolidPorousMaterial : public NDMaterial
 
      int setParameter(const char **argv, int argc, Parameter &param);
      int updateParameter(int responseID, Information &eleInformation);
+     int setMaterialStage(int stage);
 
      // RWB; PyLiq1 & TzLiq1 need to see the excess pore pressure and initial stresses.
     friend class PyLiq1;
@@ -17,16 +17,23 @@
 
 // YieldSurface class methods
 MultiYieldSurface::MultiYieldSurface():
-theSize(0.0), theCenter(6), plastShearModulus(0.0)
+theSize(0.0), theCenter(centerData,6), plastShearModulus(0.0)
 {
-
+  theCenter.Zero();
 }
 
 MultiYieldSurface::MultiYieldSurface(const Vector & theCenter_init, 
                                      double theSize_init, double plas_modul):
-theSize(theSize_init), theCenter(theCenter_init), plastShearModulus(plas_modul)
+theSize(theSize_init), theCenter(centerData,6), plastShearModulus(plas_modul)
 {
+  this->setCenter(theCenter_init);
+}
 
+MultiYieldSurface::MultiYieldSurface(const MultiYieldSurface & a):
+theSize(a.theSize), theCenter(centerData,6), plastShearModulus(a.plastShearModulus)
+{
+  for (int i=0; i<6; i++)
+    centerData[i] = a.centerData[i];
 }
 
 MultiYieldSurface::~MultiYieldSurface()
@@ -34,11 +41,21 @@ MultiYieldSurface::~MultiYieldSurface()
 
 }
 
+MultiYieldSurface & MultiYieldSurface::operator= (const MultiYieldSurface & a)
+{
+  theSize = a.theSize;
+  for (int i=0; i<6; i++)
+    centerData[i] = a.centerData[i];
+  plastShearModulus = a.plastShearModulus;
+
+  return *this;
+}
+
 void MultiYieldSurface::setData(const Vector & theCenter_init, 
                                 double theSize_init, double plas_modul)
 {
   theSize = theSize_init;
-  theCenter = theCenter_init;
+  this->setCenter(theCenter_init);
   plastShearModulus = plas_modul;
 }
 
@@ -29,7 +29,10 @@ public:
   MultiYieldSurface();
   MultiYieldSurface(const Vector & center_init, double size_init, 
                     double plas_modul); 
+  MultiYieldSurface(const MultiYieldSurface & a);
   ~MultiYieldSurface();
+
+  MultiYieldSurface & operator= (const MultiYieldSurface & a);
 	void setData(const Vector & center_init, double size_init, 
                double plas_modul); 
   const Vector & center() const {return theCenter; }
@@ -44,6 +47,7 @@ protected:
 
 private:
   double theSize;
+  double centerData[6];  // so an array of surfaces is one block of memory
   Vector theCenter;  
   double plastShearModulus;
 
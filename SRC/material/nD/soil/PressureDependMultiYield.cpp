@@ -929,6 +929,14 @@ int PressureDependMultiYield::setParameter(const char **argv, int argc, Paramete
   return -1;
 }
 
+// the stage is kept for the material tag, see updateParameter()
+int
+PressureDependMultiYield::setMaterialStage(int stage)
+{
+  loadStagex[matN] = stage;
+  return 1;
+}
+
 int
 PressureDependMultiYield::updateParameter(int responseID, Information &info)
 {
@@ -1030,6 +1030,13 @@ int PressureDependMultiYield02::setParameter(const char **argv, int argc, Parame
   return -1;
 }
 
+// the stage is kept for the material tag, see updateParameter()
+int PressureDependMultiYield02::setMaterialStage(int stage)
+{
+  loadStagex[matN] = stage;
+  return 1;
+}
+
 int PressureDependMultiYield02::updateParameter(int responseID, Information &info)
 {
  
@@ -1770,7 +1777,7 @@ void PressureDependMultiYield02::setUpSurfaces (double * gredu)
       if (ii==numOfSurfaces) plast_modul = 0;
       workV6.Zero();
 	  //opserr<<ii<<" "<<size<<" "<<plast_modul<<endln;
-      committedSurfaces[ii] = MultiYieldSurface(workV6,size,plast_modul);
+      committedSurfaces[ii].setData(workV6,size,plast_modul);
 		}  // ii
 	}
 	else {  //user defined surfaces
@@ -1829,13 +1836,13 @@ void PressureDependMultiYield02::setUpSurfaces (double * gredu)
 
       workV6.Zero();
 			//opserr<<size<<" "<<i<<" "<<plast_modul<<" "<<gredu[ii]<<" "<<gredu[ii+1]<<endln;
-      committedSurfaces[i] = MultiYieldSurface(workV6,size,plast_modul);
+      committedSurfaces[i].setData(workV6,size,plast_modul);
 
 	  if (i==(numOfSurfaces-1)) {
 		plast_modul = 0;
 		size = ratio2;
 		//opserr<<size<<" "<<i+1<<" "<<plast_modul<<" "<<gredu[ii+2]<<" "<<gredu[ii+3]<<endln;
-        committedSurfaces[i+1] = MultiYieldSurface(workV6,size,plast_modul);
+        committedSurfaces[i+1].setData(workV6,size,plast_modul);
 	  }
 	}
   }
@@ -2161,11 +2168,13 @@ double PressureDependMultiYield02::getPlasticPotential(const T2Vector & contactS
       else {
          workV6 = trialStress.deviator();
 		 workV6 /= (fabs(trialStress.volume())+fabs(residualPress));
-		 workV6	-= updatedTrialStress.deviator()/(fabs(updatedTrialStress.volume())+fabs(residualPress));
+		 double updatedNorm = fabs(updatedTrialStress.volume())+fabs(residualPress);
+		 for (int k=0; k<6; k++)
+		   workV6[k] -= updatedTrialStress.deviator()[k]/updatedNorm;
 		 //workV6	-= currentStress.deviator()/(fabs(currentStress.volume())+fabs(residualPress));
 		 //workV6.Normalize();
 		 //angle = updatedTrialStress.unitDeviator() && workV6;
-		 workT2V = T2Vector(workV6);
+		 workT2V.setData(workV6);
 		 if (workT2V.deviatorLength() == 0.) angle = 1.0;
 		 //angle = (currentStress.deviator() && workV6)/workT2V.deviatorLength()/currentStress.deviatorLength();
 		 else angle = (updatedTrialStress.deviator() && workV6)/workT2V.deviatorLength()/updatedTrialStress.deviatorLength();
@@ -115,6 +115,7 @@ public:
      //void setCurrentStress(const Vector stress) { currentStress=T2Vector(stress); }
      int setParameter(const char **argv, int argc, Parameter &param);
      int updateParameter(int responseID, Information &eleInformation);
+     int setMaterialStage(int stage);
 
 
     // RWB; PyLiq1 & TzLiq1 need to see the excess pore pressure and initial stresses.
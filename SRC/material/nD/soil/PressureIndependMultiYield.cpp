@@ -242,6 +242,7 @@ PressureIndependMultiYield::PressureIndependMultiYield (int tag, int nd,
   theSurfaces = new MultiYieldSurface[numberOfYieldSurf+1]; //first surface not used
   committedSurfaces = new MultiYieldSurface[numberOfYieldSurf+1];
   activeSurfaceNum = committedActiveSurf = 0;
+  numDirtySurfaces = numberOfYieldSurf;
 
   mGredu = gredu;
   setUpSurfaces(gredu);  // residualPress is calculated inside.
@@ -251,7 +252,7 @@ PressureIndependMultiYield::PressureIndependMultiYield (int tag, int nd,
 PressureIndependMultiYield::PressureIndependMultiYield ()
  : NDMaterial(0,ND_TAG_PressureIndependMultiYield),
    currentStress(), trialStress(), currentStrain(),
-  strainRate(), theSurfaces(0), committedSurfaces(0)
+  strainRate(), theSurfaces(0), committedSurfaces(0), numDirtySurfaces(0)
 {
   //does nothing
 }
@@ -271,6 +272,7 @@ PressureIndependMultiYield::PressureIndependMultiYield (const PressureIndependMu
 
   committedActiveSurf = a.committedActiveSurf;
   activeSurfaceNum = a.activeSurfaceNum;
+  numDirtySurfaces = a.numDirtySurfaces;
 
   theSurfaces = new MultiYieldSurface[numOfSurfaces+1];  //first surface not used
   committedSurfaces = new MultiYieldSurface[numOfSurfaces+1];
@@ -491,7 +493,6 @@ const Matrix & PressureIndependMultiYield::getInitialTangent (void)
 const Vector & PressureIndependMultiYield::getStress (void)
 {
   int loadStage = loadStagex[matN];
-  int numOfSurfaces = numOfSurfacesx[matN];
   int ndm = ndmx[matN];
   if (ndmx[matN] == 0) ndm = 3;
 
@@ -508,7 +509,8 @@ const Vector & PressureIndependMultiYield::getStress (void)
   }
 
   else {
-    for (i=1; i<=numOfSurfaces; i++) theSurfaces[i] = committedSurfaces[i];
+    for (i=1; i<=numDirtySurfaces; i++) theSurfaces[i] = committedSurfaces[i];
+    numDirtySurfaces = 0;
     activeSurfaceNum = committedActiveSurf;
     subStrainRate = strainRate;
     setTrialStress(currentStress);
@@ -556,7 +558,6 @@ const Vector & PressureIndependMultiYield::getStrain (void)
 int PressureIndependMultiYield::commitState (void)
 {
   int loadStage = loadStagex[matN];
-  int numOfSurfaces = numOfSurfacesx[matN];
 
   currentStress = trialStress;
 
@@ -570,7 +571,8 @@ int PressureIndependMultiYield::commitState (void)
 
   if (loadStage==1) {
     committedActiveSurf = activeSurfaceNum;
-    for (int i=1; i<=numOfSurfaces; i++) committedSurfaces[i] = theSurfaces[i];
+    for (int i=1; i<=numDirtySurfaces; i++) committedSurfaces[i] = theSurfaces[i];
+    numDirtySurfaces = 0;
   }
 
   return 0;
@@ -583,6 +585,35 @@ int PressureIndependMultiYield::revertToLastCommit (void)
 }
 
 
+int PressureIndependMultiYield::setTrialStrainBatch(int n, NDMaterial **theMaterials,
+                                                    const double *strain, int size)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Vector eps(const_cast<double *>(strain) + i*size, size);
+    res += static_cast<PressureIndependMultiYield *>(theMaterials[i])->PressureIndependMultiYield::setTrialStrain(eps);
+  }
+
+  return res;
+}
+
+
+int PressureIndependMultiYield::commitStateBatch(int n, NDMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<PressureIndependMultiYield *>(theMaterials[i])->PressureIndependMultiYield::commitState();
+
+  return res;
+}
+
+
+int PressureIndependMultiYield::revertToLastCommitBatch(int n, NDMaterial **theMaterials)
+{
+  return 0;
+}
+
+
 NDMaterial * PressureIndependMultiYield::getCopy (void)
 {
   PressureIndependMultiYield * copy = new PressureIndependMultiYield(*this);
@@ -647,6 +678,13 @@ int PressureIndependMultiYield::setParameter(const char **argv, int argc, Parame
   return -1;
 }
 
+// the stage is kept for the material tag, see updateParameter()
+int PressureIndependMultiYield::setMaterialStage(int stage)
+{
+  loadStagex[matN] = stage;
+  return 1;
+}
+
 int PressureIndependMultiYield::updateParameter(int responseID, Information &info)
 {    
   if (responseID == 1) {
@@ -808,6 +846,7 @@ int PressureIndependMultiYield::recvSelf(int commitTag, Channel &theChannel,
 
   theSurfaces = new MultiYieldSurface[numOfSurfaces+1]; //first surface not used
   committedSurfaces = new MultiYieldSurface[numOfSurfaces+1];
+  numDirtySurfaces = numOfSurfaces;
 
   for(i = 0; i < numOfSurfaces; i++) {
     int k = 24 + i*8;
@@ -1126,6 +1165,8 @@ void PressureIndependMultiYield::setUpSurfaces (double * gredu)
 	double cohesion = cohesionx[matN];
 	double peakShearStrain = peakShearStrainx[matN];
 
+	numDirtySurfaces = numOfSurfaces;
+
 	double  stress1, stress2, strain1, strain2, size, elasto_plast_modul, plast_modul;
 	double pi = 3.14159265358979;
 	double refStrain, peakShear, coneHeight;
@@ -1275,7 +1316,8 @@ void PressureIndependMultiYield::deviatorScaling(T2Vector & stress, const MultiY
 		static Vector devia(6);
 		devia = stress.deviator();
 		static Vector temp(6);
-		temp = devia - surfaces[surfaceNum].center();
+		temp = devia;
+		temp -= surfaces[surfaceNum].center();
 		double coeff = (sz-deviaSz) / deviaSz;
 		if (coeff < 1.e-13) coeff = 1.e-13;
 		devia.addVector(1.0, temp, coeff);
@@ -1297,6 +1339,7 @@ void PressureIndependMultiYield::initSurfaceUpdate()
 	if (committedActiveSurf == 0) return;
 
 	int numOfSurfaces = numOfSurfacesx[matN];
+	numDirtySurfaces = numOfSurfaces;
 
 	static Vector devia(6);
 	devia = currentStress.deviator();
@@ -1310,7 +1353,7 @@ void PressureIndependMultiYield::initSurfaceUpdate()
 	}
 
 	for (int i=1; i<committedActiveSurf; i++) {
-	  newCenter = devia * (1. - committedSurfaces[i].size() / Ms);
+	  newCenter.addVector(0.0, devia, 1. - committedSurfaces[i].size() / Ms);
 	  committedSurfaces[i].setCenter(newCenter);
 	}
 }
@@ -1325,6 +1368,7 @@ void PressureIndependMultiYield::paramScaling(void)
     double pressDependCoeff =pressDependCoeffx[matN];
 
 	if (frictionAngle == 0.) return;
+	numDirtySurfaces = numOfSurfaces;
 
 	double conHeig = - (currentStress.volume() - residualPress);
 	double scale = -conHeig / (refPressure-residualPress);
@@ -1338,7 +1382,7 @@ void PressureIndependMultiYield::paramScaling(void)
 	for (int i=1; i<=numOfSurfaces; i++) {
 	  plastModul = committedSurfaces[i].modulus() * scale;
 	  size = committedSurfaces[i].size() * conHeig;
-	  committedSurfaces[i] =  MultiYieldSurface(temp,size,plastModul);
+	  committedSurfaces[i].setData(temp,size,plastModul);
 	}
 
 }
@@ -1560,6 +1604,7 @@ void PressureIndependMultiYield::updateActiveSurface(void)
 	//center += temp * X;
 	center.addVector(1.0, temp, X);
 	theSurfaces[activeSurfaceNum].setCenter(center);
+	if (activeSurfaceNum > numDirtySurfaces) numDirtySurfaces = activeSurfaceNum;
 }
 
 
@@ -1583,6 +1628,7 @@ void PressureIndependMultiYield::updateInnerSurface(void)
 
 		theSurfaces[i].setCenter(newcenter);
 	}
+	if (activeSurfaceNum-1 > numDirtySurfaces) numDirtySurfaces = activeSurfaceNum-1;
 }
 
 
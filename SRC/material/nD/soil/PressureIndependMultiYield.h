@@ -76,6 +76,11 @@ public:
      // Revert the stress/strain states to the last committed states. Return 0 on success.
      int revertToLastCommit (void);
 
+     // Batch versions of setTrialStrain(), commitState() and revertToLastCommit(), see NDMaterial.
+     int setTrialStrainBatch(int n, NDMaterial **theMaterials, const double *strain, int size);
+     int commitStateBatch(int n, NDMaterial **theMaterials);
+     int revertToLastCommitBatch(int n, NDMaterial **theMaterials);
+
      int revertToStart(void) {return 0;}
 
      // Return an exact copy of itself.
@@ -101,6 +106,7 @@ public:
      //void setCurrentStress(const Vector stress) { currentStress=T2Vector(stress); }
      int setParameter(const char **argv, int argc, Parameter &param);
      int updateParameter(int responseID, Information &eleInformation);	
+     int setMaterialStage(int stage);
 
     // RWB; PyLiq1 & TzLiq1 need to see the excess pore pressure and initial stresses.
     friend class PyLiq1;
@@ -135,6 +141,10 @@ private:
 	MultiYieldSurface * committedSurfaces;  
 	int    activeSurfaceNum;  
 	int    committedActiveSurf;
+	// theSurfaces and committedSurfaces may only differ in 1 to
+	// numDirtySurfaces, the trial only moves the surfaces up to the
+	// active one, so that commit and the start of a trial copy those
+	int    numDirtySurfaces;
 	T2Vector currentStress;
 	T2Vector trialStress;
 	T2Vector currentStrain;
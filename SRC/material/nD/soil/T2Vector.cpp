@@ -99,14 +99,15 @@ double delta(int i,int j){
 
 // T2Vector class methods
 T2Vector::T2Vector() 
-:theT2Vector(6), theDeviator(6), theVolume(0.0)
+:theT2Vector(t2Data,6), theDeviator(deviatorData,6), theVolume(0.0)
 {
-	
+  for (int i=0; i<6; i++)
+    t2Data[i] = deviatorData[i] = 0.0;
 }
 
 
 T2Vector::T2Vector(const Vector &init, int isEngrgStrain)
-:theT2Vector(6), theDeviator(6), theVolume(0)
+:theT2Vector(t2Data,6), theDeviator(deviatorData,6), theVolume(0)
 {
   if (init.Size() != 6) {
     opserr << "FATAL:T2Vector::T2Vector(Vector &): vector size not equal to 6" << endln;
@@ -128,7 +129,7 @@ T2Vector::T2Vector(const Vector &init, int isEngrgStrain)
 
 
 T2Vector::T2Vector(const Vector & deviat_init, double volume_init)
- : theT2Vector(6), theDeviator(6), theVolume(volume_init)
+ : theT2Vector(t2Data,6), theDeviator(deviatorData,6), theVolume(volume_init)
 {
   if (deviat_init.Size() != 6) {
     opserr << "FATAL:T2Vector::T2Vector(Vector &, double): vector size not equal 6" << endln;
@@ -147,12 +148,35 @@ T2Vector::T2Vector(const Vector & deviat_init, double volume_init)
 }
 
 
+T2Vector::T2Vector(const T2Vector & a)
+ : theT2Vector(t2Data,6), theDeviator(deviatorData,6), theVolume(a.theVolume)
+{
+  for (int i=0; i<6; i++) {
+    t2Data[i] = a.t2Data[i];
+    deviatorData[i] = a.deviatorData[i];
+  }
+}
+
+
 T2Vector::~T2Vector()
 {
 
 }
 
 
+T2Vector &
+T2Vector::operator= (const T2Vector & a)
+{
+  for (int i=0; i<6; i++) {
+    t2Data[i] = a.t2Data[i];
+    deviatorData[i] = a.deviatorData[i];
+  }
+  theVolume = a.theVolume;
+
+  return *this;
+}
+
+
 void
 T2Vector::setData(const Vector &init, int isEngrgStrain)
 {
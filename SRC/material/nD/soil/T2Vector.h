@@ -46,9 +46,12 @@ public:
   T2Vector();
   T2Vector(const Vector & T2Vector_init, int isEngrgStrain=0);
   T2Vector(const Vector & deviat_init, double volume_init);
+  T2Vector(const T2Vector & a);
   
   ~T2Vector();
 
+  T2Vector & operator= (const T2Vector & a);
+
   void setData(const Vector &init, int isEngrgStrain =0);
   void setData(const Vector &deviat, double volume);
 
@@ -78,6 +81,9 @@ public:
 protected:
 
 private:
+  // the components are stored in the object, the Vectors wrap them
+  double t2Data[6];
+  double deviatorData[6];
   Vector theT2Vector;
   Vector theDeviator;
   double theVolume;
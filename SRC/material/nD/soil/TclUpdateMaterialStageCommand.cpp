@@ -46,6 +46,25 @@ TclModelBuilderUpdateMaterialStageCommand(ClientData clientData,
     return TCL_ERROR;		
   }
 
+  if (strcmp(argv[3],"-stage") != 0) {
+    opserr << "WARNING UpdateMaterialStage: Only accept parameter '-stage' for now" << endln;
+    return TCL_ERROR;		
+  }		
+  
+  if (Tcl_GetInt(interp, argv[4], &value) != TCL_OK) {
+    opserr << "WARNING UpdateMaterialStage: invalid parameter value" << endln;
+    return TCL_ERROR;		
+  }	
+
+#ifndef _PARALLEL_PROCESSING
+  // without a parameter tag, a stage kept per material tag is switched
+  // directly, without a MaterialStageParameter visiting the elements
+  if (argc < 7 && OPS_setNDMaterialStage(materialTag, value) == 0) {
+    theDomain->parameterChange();
+    return TCL_OK;
+  }
+#endif
+
   int parTag = theDomain->getNumParameters();
   parTag++;
 
@@ -64,17 +83,6 @@ TclModelBuilderUpdateMaterialStageCommand(ClientData clientData,
     return TCL_ERROR;		
   }
 
-  if (strcmp(argv[3],"-stage") != 0) {
-    opserr << "WARNING UpdateMaterialStage: Only accept parameter '-stage' for now" << endln;
-    return TCL_ERROR;		
-  }		
-  
-  
-  if (Tcl_GetInt(interp, argv[4], &value) != TCL_OK) {
-    opserr << "WARNING UpdateMaterialStage: invalid parameter value" << endln;
-    return TCL_ERROR;		
-  }	
-
   theDomain->updateParameter(parTag, value);
 
   theDomain->removeParameter(parTag);
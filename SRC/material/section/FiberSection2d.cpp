@@ -45,6 +45,20 @@
 #include <UniaxialMaterial.h>
 #include <SectionIntegration.h>
 #include <elementAPI.h>
+#include <vector>
+#include <new>
+#include <AnalysisProfiler.h>
+#include <MemoryReport.h>
+
+// the fiber geometry does not change once the section is built, so the
+// copies of a section share one block of it, aligned for vectorization
+static std::shared_ptr<double>
+newFiberGeometry(int size)
+{
+  const std::align_val_t align = static_cast<std::align_val_t>(64);
+  double *data = static_cast<double *>(::operator new[](size*sizeof(double), align));
+  return std::shared_ptr<double>(data, [align](double *p) {::operator delete[](p, align);});
+}
 
 ID FiberSection2d::code(2);
 
@@ -76,7 +90,7 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2), tangentRefresh(true)
 
 {
   if (numFibers > 0) {
@@ -87,7 +101,8 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
       exit(-1);
     }
 
-    matData = new double [numFibers*2];
+    matShared = newFiberGeometry(numFibers*2);
+    matData = matShared.get();
 
     if (matData == 0) {
       opserr << "FiberSection2d::FiberSection2d -- failed to allocate double array for material data\n";
@@ -136,7 +151,7 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2), tangentRefresh(true)
 {
     if(sizeFibers > 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -146,7 +161,8 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
 	    exit(-1);
 	}
 
-	matData = new double [sizeFibers*2];
+	matShared = newFiberGeometry(sizeFibers*2);
+	matData = matShared.get();
 
 	if(matData == 0) {
 	    opserr << "FiberSection2d::FiberSection2d -- failed to allocate double array for material data\n";
@@ -180,7 +196,7 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2), tangentRefresh(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -189,7 +205,8 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
       opserr << "FiberSection2d::FiberSection2d -- failed to allocate Material pointers";
       exit(-1);
     }
-    matData = new double [numFibers*2];
+    matShared = newFiberGeometry(numFibers*2);
+    matData = matShared.get();
 
     if (matData == 0) {
       opserr << "FiberSection2d::FiberSection2d -- failed to allocate double array for material data\n";
@@ -203,11 +220,13 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
     exit(-1);
   }
 
-  static double fiberLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
   
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
+  sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
 
   for (int i = 0; i < numFibers; i++) {
 
@@ -245,7 +264,7 @@ FiberSection2d::FiberSection2d():
   SectionForceDeformation(0, SEC_TAG_FiberSection2d),
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  sectionIntegr(0), e(2), s(0), ks(0), dedh(2), tangentRefresh(true)
 {
   s = new Vector(sData, 2);
   ks = new Matrix(kData, 2, 2);
@@ -265,12 +284,13 @@ FiberSection2d::FiberSection2d():
 int
 FiberSection2d::addFiber(Fiber &newFiber)
 {
-  // need to create larger arrays
-  if(numFibers == sizeFibers) {
+  // need to create larger arrays, or ones of its own if shared with copies
+  if(numFibers == sizeFibers || matShared.use_count() > 1) {
       int newsize = 2*sizeFibers;
       if(newsize == 0) newsize = 30;
       UniaxialMaterial **newArray = new UniaxialMaterial *[newsize]; 
-      double *newMatData = new double [2 * newsize];
+      std::shared_ptr<double> newMatShared = newFiberGeometry(2*newsize);
+      double *newMatData = newMatShared.get();
       if (newArray == 0 || newMatData == 0) {
 	  opserr <<"FiberSection2d::addFiber -- failed to allocate Fiber pointers\n";
 	  return -1;
@@ -296,10 +316,10 @@ FiberSection2d::addFiber(Fiber &newFiber)
       // set new memory
       if (theMaterials != 0) {
 	  delete [] theMaterials;
-	  delete [] matData;
       }
 
       theMaterials = newArray;
+      matShared = newMatShared;
       matData = newMatData;
   }
 
@@ -341,9 +361,6 @@ FiberSection2d::~FiberSection2d()
     delete [] theMaterials;
   }
 
-  if (matData != 0)
-    delete [] matData;
-
   if (s != 0)
     delete s;
 
@@ -367,12 +384,14 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
   double d0 = deforms(0);
   double d1 = deforms(1);
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -381,7 +400,47 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
     }
   }
   
-  for (int i = 0; i < numFibers; i++) {
+  static thread_local std::vector<double> fiberTangent;
+  fiberTangent.resize(numFibers);
+
+  if (this->isSingleMaterialType()) {
+
+    // all fibers are of one material class, set the fiber strains in a 
+    // single batch and then sum the section response over the fiber arrays
+    static thread_local std::vector<double> fiberStrain;
+    fiberStrain.resize(numFibers);
+    static thread_local std::vector<double> fiberStress;
+    fiberStress.resize(numFibers);
+
+    const double *yPtr = fiberLocs.data();
+    const double *APtr = fiberArea.data();
+    double *strainPtr = fiberStrain.data();
+    double *stressPtr = fiberStress.data();
+    double *tangentPtr = fiberTangent.data();
+
+#pragma omp simd
+    for (int i = 0; i < numFibers; i++)
+      strainPtr[i] = d0 - (yPtr[i] - yBar)*d1;
+
+    {
+      ProfileClass cost(ProfileClass::Material, theMaterials[0]);
+      res += theMaterials[0]->setTrialBatch(numFibers, theMaterials, strainPtr, stressPtr, tangentPtr);
+    }
+
+    double s0 = 0.0, s1 = 0.0;
+
+#pragma omp simd reduction(+:s0,s1)
+    for (int i = 0; i < numFibers; i++) {
+      double fs0 = stressPtr[i] * APtr[i];
+
+      s0 += fs0;
+      s1 += fs0 * -(yPtr[i] - yBar);
+    }
+
+    sData[0] = s0; sData[1] = s1;
+  }
+
+  else for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
     double y = fiberLocs[i] - yBar;
     double A = fiberArea[i];
@@ -389,24 +448,82 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
     // determine material strain and set it
     double strain = d0 - y*d1;
     double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
-
-    double ks0 = tangent * A;
-    double ks1 = ks0 * -y;
-    kData[0] += ks0;
-    kData[1] += ks1;
-    kData[3] += ks1 * -y;
+    {
+      ProfileClass cost(ProfileClass::Material, theMat);
+      res += theMat->setTrial(strain, stress, tangent);
+    }
+    fiberTangent[i] = tangent;
 
     double fs0 = stress * A;
     sData[0] += fs0;
     sData[1] += fs0 * -y;
   }
 
+  this->formFiberTangent(fiberLocs.data(), fiberArea.data(), fiberTangent.data());
+  kData[0] = kFiber[0]; kData[1] = kFiber[1]; kData[3] = kFiber[2];
   kData[2] = kData[1];
 
   return res;
 }
 
+// forms the section stiffness, kFiber, from the fiber tangents; between
+// refreshes only the fibers whose tangent has changed since the last
+// trial are added to it
+void
+FiberSection2d::formFiberTangent(const double *yPtr, const double *APtr,
+				 const double *tangentPtr)
+{
+  if (tangentRefresh || (int)lastTangent.size() != numFibers) {
+    lastTangent.assign(tangentPtr, tangentPtr + numFibers);
+
+    double k0 = 0.0, k1 = 0.0, k3 = 0.0;
+
+#pragma omp simd reduction(+:k0,k1,k3)
+    for (int i = 0; i < numFibers; i++) {
+      double y = yPtr[i] - yBar;
+      double ks0 = tangentPtr[i] * APtr[i];
+
+      k0 += ks0;
+      k1 += ks0 * -y;
+      k3 += ks0 * y*y;
+    }
+
+    kFiber[0] = k0; kFiber[1] = k1; kFiber[2] = k3;
+    tangentRefresh = false;
+    return;
+  }
+
+  for (int i = 0; i < numFibers; i++) {
+    double dTangent = tangentPtr[i] - lastTangent[i];
+    if (dTangent == 0.0)
+      continue;
+    lastTangent[i] = tangentPtr[i];
+
+    double y = yPtr[i] - yBar;
+    double ks0 = dTangent * APtr[i];
+
+    kFiber[0] += ks0;
+    kFiber[1] += ks0 * -y;
+    kFiber[2] += ks0 * y*y;
+  }
+}
+
+// returns true if there is more than one fiber and all fiber materials 
+// are of the same class, in which case they can be set as one batch
+bool
+FiberSection2d::isSingleMaterialType(void) const
+{
+  if (numFibers < 2)
+    return false;
+
+  int classTag = theMaterials[0]->getClassTag();
+  for (int i = 1; i < numFibers; i++)
+    if (theMaterials[i]->getClassTag() != classTag)
+      return false;
+
+  return true;
+}
+
 const Vector&
 FiberSection2d::getSectionDeformation(void)
 {
@@ -416,16 +533,18 @@ FiberSection2d::getSectionDeformation(void)
 const Matrix&
 FiberSection2d::getInitialTangent(void)
 {
-  static double kInitial[4];
-  static Matrix kInitialMatrix(kInitial, 2, 2);
+  static thread_local double kInitial[4];
+  static thread_local Matrix kInitialMatrix(kInitial, 2, 2);
   kInitial[0] = 0.0; kInitial[1] = 0.0; kInitial[2] = 0.0; kInitial[3] = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
   
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);    
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());    
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -482,16 +601,10 @@ FiberSection2d::getCopy(void)
       exit(-1);
     }
   
-    theCopy->matData = new double [numFibers*2];
+    theCopy->matShared = matShared;
+    theCopy->matData = matData;
 
-    if (theCopy->matData == 0) {
-      opserr << "FiberSection2d::getCopy -- failed to allocate double array for material data\n";
-      exit(-1);
-    }
-			    
     for (int i = 0; i < numFibers; i++) {
-      theCopy->matData[i*2] = matData[i*2];
-      theCopy->matData[i*2+1] = matData[i*2+1];
       theCopy->theMaterials[i] = theMaterials[i]->getCopy();
 
       if (theCopy->theMaterials[i] == 0) {
@@ -541,8 +654,15 @@ FiberSection2d::commitState(void)
 {
   int err = 0;
 
-  for (int i = 0; i < numFibers; i++)
-    err += theMaterials[i]->commitState();
+  // the fiber stiffness is formed from all fibers once per step, so the
+  // round-off of its updates does not build up
+  tangentRefresh = true;
+
+  if (this->isSingleMaterialType())
+    err += theMaterials[0]->commitStateBatch(numFibers, theMaterials);
+  else
+    for (int i = 0; i < numFibers; i++)
+      err += theMaterials[i]->commitState();
 
   return err;
 }
@@ -552,15 +672,19 @@ FiberSection2d::revertToLastCommit(void)
 {
   int err = 0;
 
+  tangentRefresh = true;
+
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -602,15 +726,19 @@ FiberSection2d::revertToStart(void)
   // revert the fibers to start    
   int err = 0;
 
+  tangentRefresh = true;
+
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -734,6 +862,8 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
 {
   int res = 0;
 
+  tangentRefresh = true;
+
   static ID data(7);
   
   int dbTag = this->getDbTag();
@@ -788,8 +918,7 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
 	for (int i=0; i<numFibers; i++)
 	  delete theMaterials[i];
 	delete [] theMaterials;
-	if (matData != 0)
-	  delete [] matData;
+	matShared.reset();
 	matData = 0;
 	theMaterials = 0;
       }
@@ -808,7 +937,8 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
 	for (int j=0; j<numFibers; j++)
 	  theMaterials[j] = 0;
 
-	matData = new double [numFibers*2];
+	matShared = newFiberGeometry(numFibers*2);
+	matData = matShared.get();
 
 	if (matData == 0) {
 	  opserr <<"FiberSection2d::recvSelf  -- failed to allocate double array for material data\n";
@@ -817,6 +947,12 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
       }
     }
 
+    // the received geometry must not overwrite that of the copies
+    if (matShared.use_count() > 1) {
+      matShared = newFiberGeometry(2*numFibers);
+      matData = matShared.get();
+    }
+
     Vector fiberData(matData, 2*numFibers);
     res += theChannel.recvVector(dbTag, commitTag, fiberData);
     if (res < 0) {
@@ -855,11 +991,13 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
   computeCentroid = data(2) ? true : false;
 
   if (sectionIntegr != 0) {
-    static double fiberLocs[10000];
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+    static thread_local std::vector<double> fiberLocs;
+    fiberLocs.resize(numFibers);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
     
-    static double fiberArea[10000];
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    static thread_local std::vector<double> fiberArea;
+    fiberArea.resize(numFibers);
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
     
     for (int i = 0; i < numFibers; i++) {
       ABar  += fiberArea[i];
@@ -885,6 +1023,41 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
   return res;
 }
 
+size_t
+FiberSection2d::getMemoryUsage(void)
+{
+  size_t result = MemoryReport::objectSize(this);
+  result += MemoryReport::vectorSize(s) + MemoryReport::matrixSize(ks);
+  result += sizeFibers*(sizeof(UniaxialMaterial *) + 2*sizeof(double));
+  for (int i = 0; i < numFibers; i++)
+    result += MemoryReport::objectSize(theMaterials[i]);
+
+  return result;
+}
+
+int
+FiberSection2d::getFiberGeometry(double *y, double *z, double *A)
+{
+  for (int i = 0; i < numFibers; i++) {
+    y[i] = matData[2*i];
+    z[i] = 0.0;
+    A[i] = matData[2*i+1];
+  }
+
+  return numFibers;
+}
+
+int
+FiberSection2d::getFiberStrainStress(double *strain, double *stress)
+{
+  for (int i = 0; i < numFibers; i++) {
+    strain[i] = theMaterials[i]->getStrain();
+    stress[i] = theMaterials[i]->getStress();
+  }
+
+  return numFibers;
+}
+
 void
 FiberSection2d::Print(OPS_Stream &s, int flag)
 {
@@ -944,10 +1117,11 @@ FiberSection2d::setResponse(const char **argv, int argc,
   
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
-    static double fiberLocs[10000];
+    static thread_local std::vector<double> fiberLocs;
+    fiberLocs.resize(numFibers);
     
     if (sectionIntegr != 0) {
-      sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+      sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
     }  
     else {
       for (int i = 0; i < numFibers; i++) {
@@ -1158,7 +1332,7 @@ FiberSection2d::getResponse(int responseID, Information &sectInfo)
 	  return sectInfo.setDouble(getEnergy());
   }
   else if (responseID == 20) {
-    static Vector centroid(2);
+    static thread_local Vector centroid(2);
     centroid(0) = yBar;
     centroid(1) = 0.0;
     return sectInfo.setVector(centroid);
@@ -1279,7 +1453,7 @@ FiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
 const Vector &
 FiberSection2d::getSectionDeformationSensitivity(int gradIndex)
 {
-  static Vector dummy(2);
+  static thread_local Vector dummy(2);
 
   return dummy;
 }
@@ -1287,7 +1461,7 @@ FiberSection2d::getSectionDeformationSensitivity(int gradIndex)
 const Vector &
 FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
 {
-  static Vector ds(2);
+  static thread_local Vector ds(2);
   
   ds.Zero();
   
@@ -1297,12 +1471,14 @@ FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
   double tangent = 0.0;
   double sig_dAdh = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1311,12 +1487,14 @@ FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
     }
   }
 
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  static thread_local std::vector<double> locsDeriv;
+  locsDeriv.resize(numFibers);
+  static thread_local std::vector<double> areaDeriv;
+  areaDeriv.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());  
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1365,7 +1543,7 @@ FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
 const Matrix &
 FiberSection2d::getInitialTangentSensitivity(int gradIndex)
 {
-  static Matrix dksdh(2,2);
+  static thread_local Matrix dksdh(2,2);
   
   dksdh.Zero();
 
@@ -1373,12 +1551,14 @@ FiberSection2d::getInitialTangentSensitivity(int gradIndex)
   double tangent = 0.0;
   double dtangentdh = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1387,12 +1567,14 @@ FiberSection2d::getInitialTangentSensitivity(int gradIndex)
     }
   }
 
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  static thread_local std::vector<double> locsDeriv;
+  locsDeriv.resize(numFibers);
+  static thread_local std::vector<double> areaDeriv;
+  areaDeriv.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());  
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1431,21 +1613,24 @@ FiberSection2d::commitSensitivity(const Vector& defSens,
 
   dedh = defSens;
 
-  static double fiberLocs[10000];
+  static thread_local std::vector<double> fiberLocs;
+  fiberLocs.resize(numFibers);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
+    sectionIntegr->getFiberLocations(numFibers, fiberLocs.data());
   else {
     for (int i = 0; i < numFibers; i++)
       fiberLocs[i] = matData[2*i];
   }
 
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  static thread_local std::vector<double> locsDeriv;
+  locsDeriv.resize(numFibers);
+  static thread_local std::vector<double> areaDeriv;
+  areaDeriv.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());  
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1474,10 +1659,11 @@ FiberSection2d::commitSensitivity(const Vector& defSens,
 //by SAJalali
 double FiberSection2d::getEnergy() const
 {
-	static double fiberArea[10000];
+	static thread_local std::vector<double> fiberArea;
+	fiberArea.resize(numFibers);
 
 	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
+		sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
 	}
 	else {
 		for (int i = 0; i < numFibers; i++) {
@@ -37,6 +37,8 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <FiberSectionRepr.h>
+#include <memory>
+#include <vector>
 
 class UniaxialMaterial;
 class Fiber;
@@ -74,6 +76,11 @@ class FiberSection2d : public SectionForceDeformation
     int recvSelf(int cTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
     void Print(OPS_Stream &s, int flag = 0);
+    size_t getMemoryUsage(void);
+
+    int getNumFibers(void) {return numFibers;}
+    int getFiberGeometry(double *y, double *z, double *A);
+    int getFiberStrainStress(double *strain, double *stress);
 	    
     Response *setResponse(const char **argv, int argc, 
 			  OPS_Stream &s);
@@ -94,11 +101,14 @@ class FiberSection2d : public SectionForceDeformation
 	double getEnergy() const;
 
   protected:
+    bool isSingleMaterialType(void) const;
+    void formFiberTangent(const double *yPtr, const double *APtr, const double *tangentPtr);
     
     //  private:
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    std::shared_ptr<double> matShared; // owner of matData, shared by the copies
     double   kData[4];               // data for ks matrix 
     double   sData[2];               // data for s vector 
     
@@ -116,6 +126,10 @@ class FiberSection2d : public SectionForceDeformation
 // AddingSensitivity:BEGIN //////////////////////////////////////////
     Vector dedh; // MHS hack
 // AddingSensitivity:END ///////////////////////////////////////////
+
+    bool tangentRefresh;             // form kFiber from all fibers at the next trial
+    std::vector<double> lastTangent; // fiber tangents kFiber was formed with
+    double kFiber[3];                // [k00, k10, k11] summed over the fibers
 };
 
 #endif
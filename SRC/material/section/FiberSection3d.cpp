@@ -45,7 +45,21 @@
 #include <ElasticMaterial.h>
 #include <SectionIntegration.h>
 #include <elementAPI.h>
+#include <vector>
+#include <new>
 #include <string.h>
+#include <AnalysisProfiler.h>
+#include <MemoryReport.h>
+
+// the fiber geometry does not change once the section is built, so the
+// copies of a section share one block of it, aligned for vectorization
+static std::shared_ptr<double>
+newFiberGeometry(int size)
+{
+  const std::align_val_t align = static_cast<std::align_val_t>(64);
+  double *data = static_cast<double *>(::operator new[](size*sizeof(double), align));
+  return std::shared_ptr<double>(data, [align](double *p) {::operator delete[](p, align);});
+}
 
 ID FiberSection3d::code(4);
 
@@ -71,11 +85,23 @@ void* OPS_FiberSection3d()
     UniaxialMaterial *torsion = 0;
     bool deleteTorsion = false;
     bool computeCentroid = true;
+    double adaptStrain = 0.0;
+    bool adaptReturn = false;
     while (OPS_GetNumRemainingInputArgs() > 0) {
       const char* opt = OPS_GetString();
       if (strcmp(opt,"-noCentroid") == 0) {
 	computeCentroid = false;
       }
+      if (strcmp(opt, "-adaptive") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	numData = 1;
+	if (OPS_GetDoubleInput(&numData, &adaptStrain) < 0 || adaptStrain <= 0.0) {
+	  opserr << "WARNING: invalid strain limit for -adaptive\n";
+	  return 0;
+	}
+      }
+      if (strcmp(opt, "-adaptiveReturn") == 0) {
+	adaptReturn = true;
+      }
       if (strcmp(opt, "-GJ") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
 	numData = 1;
 	double GJ;
@@ -104,9 +130,11 @@ void* OPS_FiberSection3d()
     }
     
     int num = 30;
-    SectionForceDeformation *section = new FiberSection3d(tag, num, *torsion, computeCentroid);
+    FiberSection3d *section = new FiberSection3d(tag, num, *torsion, computeCentroid);
     if (deleteTorsion)
       delete torsion;
+    if (adaptStrain > 0.0)
+      section->setAdaptive(adaptStrain, adaptReturn);
     return section;
 }
 
@@ -116,7 +144,9 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  adaptStrain(0.0), adaptReturn(false), elasticCommit(false), elasticTrial(false),
+  tangentRefresh(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -126,7 +156,8 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
       exit(-1);
     }
 
-    matData = new double [numFibers*3];
+    matShared = newFiberGeometry(numFibers*3);
+    matData = matShared.get();
 
     if (matData == 0) {
       opserr << "FiberSection3d::FiberSection3d -- failed to allocate double array for material data\n";
@@ -186,7 +217,9 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool
     SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
     numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
     QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-    sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+    sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  adaptStrain(0.0), adaptReturn(false), elasticCommit(false), elasticTrial(false),
+  tangentRefresh(true)
 {
     if(sizeFibers != 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -196,7 +229,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool
 	    exit(-1);
 	}
 
-	matData = new double [sizeFibers*3];
+	matShared = newFiberGeometry(sizeFibers*3);
+	matData = matShared.get();
 
 	if (matData == 0) {
 	    opserr << "FiberSection3d::FiberSection3d -- failed to allocate double array for material data\n";
@@ -238,7 +272,9 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  adaptStrain(0.0), adaptReturn(false), elasticCommit(false), elasticTrial(false),
+  tangentRefresh(true)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -247,7 +283,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
       opserr << "FiberSection3d::FiberSection3d -- failed to allocate Material pointers";
       exit(-1);
     }
-    matData = new double [numFibers*3];
+    matShared = newFiberGeometry(numFibers*3);
+    matData = matShared.get();
 
     if (matData == 0) {
       opserr << "FiberSection3d::FiberSection3d -- failed to allocate double array for material data\n";
@@ -261,12 +298,15 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
     exit(-1);
   }
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
   
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
+  sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   
   for (int i = 0; i < numFibers; i++) {
 
@@ -311,7 +351,9 @@ FiberSection3d::FiberSection3d():
   SectionForceDeformation(0, SEC_TAG_FiberSection3d),
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  adaptStrain(0.0), adaptReturn(false), elasticCommit(false), elasticTrial(false),
+  tangentRefresh(true)
 {
   s = new Vector(sData, 4);
   ks = new Matrix(kData, 4, 4);
@@ -333,11 +375,12 @@ FiberSection3d::FiberSection3d():
 int
 FiberSection3d::addFiber(Fiber &newFiber)
 {
-  // need to create a larger array
-  if(numFibers == sizeFibers) {
+  // need to create a larger array, or one of its own if shared with copies
+  if(numFibers == sizeFibers || matShared.use_count() > 1) {
       int newSize = 2*sizeFibers;
       UniaxialMaterial **newArray = new UniaxialMaterial *[newSize]; 
-      double *newMatData = new double [3 * newSize];
+      std::shared_ptr<double> newMatShared = newFiberGeometry(3*newSize);
+      double *newMatData = newMatShared.get();
       
       if (newArray == 0 || newMatData == 0) {
 	  opserr << "FiberSection3d::addFiber -- failed to allocate Fiber pointers\n";
@@ -364,10 +407,10 @@ FiberSection3d::addFiber(Fiber &newFiber)
       // set new memory
       if (theMaterials != 0) {
 	  delete [] theMaterials;
-	  delete [] matData;
       }
 
       theMaterials = newArray;
+      matShared = newMatShared;
       matData = newMatData;
   }
 	    
@@ -414,9 +457,6 @@ FiberSection3d::~FiberSection3d()
     delete [] theMaterials;
   }
 
-  if (matData != 0)
-    delete [] matData;
-
   if (s != 0)
     delete s;
 
@@ -446,13 +486,16 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   double d2 = deforms(2);
   double d3 = deforms(3);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
  
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
 	
@@ -465,28 +508,93 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   }
  
   double tangent, stress;
-  for (int i = 0; i < numFibers; i++) {
+
+  if (elasticTrial) {
+
+    // stay elastic while no fiber strain has moved by more than the limit
+    // from the reference state, once a trial leaves it the fibers are
+    // integrated until the next commit
+    double de0 = d0 - eRef[0];
+    double de1 = d1 - eRef[1];
+    double de2 = d2 - eRef[2];
+    double maxStrain = 0.0;
+    for (int i = 0; i < numFibers; i++) {
+      double dStrain = fabs(de0 - (yLocs[i] - yBar)*de1 + (zLocs[i] - zBar)*de2);
+      if (dStrain > maxStrain)
+	maxStrain = dStrain;
+    }
+
+    if (maxStrain <= adaptStrain) {
+      for (int i = 0; i < 3; i++) {
+	sData[i] = sRef[i] + kElastic[i]*de0 + kElastic[4+i]*de1 + kElastic[8+i]*de2;
+	for (int j = 0; j < 3; j++)
+	  kData[4*j+i] = kElastic[4*j+i];
+      }
+      if (theTorsion != 0) {
+	res += theTorsion->setTrial(d3, stress, tangent);
+	sData[3] = stress;
+	kData[15] = tangent;
+      }
+      return res;
+    }
+
+    elasticTrial = false;
+  }
+
+  static thread_local std::vector<double> fiberTangent;
+  fiberTangent.resize(numFibers);
+
+  if (this->isSingleMaterialType()) {
+
+    // all fibers are of one material class, set the fiber strains in a 
+    // single batch and then sum the section response over the fiber arrays
+    static thread_local std::vector<double> fiberStrain;
+    fiberStrain.resize(numFibers);
+    static thread_local std::vector<double> fiberStress;
+    fiberStress.resize(numFibers);
+
+    const double *yPtr = yLocs.data();
+    const double *zPtr = zLocs.data();
+    const double *APtr = fiberArea.data();
+    double *strainPtr = fiberStrain.data();
+    double *stressPtr = fiberStress.data();
+    double *tangentPtr = fiberTangent.data();
+
+#pragma omp simd
+    for (int i = 0; i < numFibers; i++)
+      strainPtr[i] = d0 - (yPtr[i] - yBar)*d1 + (zPtr[i] - zBar)*d2;
+
+    {
+      ProfileClass cost(ProfileClass::Material, theMaterials[0]);
+      res += theMaterials[0]->setTrialBatch(numFibers, theMaterials, strainPtr, stressPtr, tangentPtr);
+    }
+
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+
+#pragma omp simd reduction(+:s0,s1,s2)
+    for (int i = 0; i < numFibers; i++) {
+      double fs0 = stressPtr[i] * APtr[i];
+
+      s0 += fs0;
+      s1 += fs0 * -(yPtr[i] - yBar);
+      s2 += fs0 * (zPtr[i] - zBar);
+    }
+
+    sData[0] = s0; sData[1] = s1; sData[2] = s2;
+  }
+
+  else for (int i = 0; i < numFibers; i++) {
     double y = yLocs[i] - yBar;
     double z = zLocs[i] - zBar;
     double A = fiberArea[i];
 
     // determine material strain and set it
     double strain = d0 - y*d1 + z*d2;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    double value = tangent * A;
-    double vas1 = -y*value;
-    double vas2 = z*value;
-    double vas1as2 = vas1*z;
-
-    kData[0] += value;
-    kData[1] += vas1;
-    kData[2] += vas2;
-    
-    kData[5] += vas1 * -y;
-    kData[6] += vas1as2;
-    
-    kData[10] += vas2 * z; 
+    {
+      ProfileClass cost(ProfileClass::Material, theMaterials[i]);
+      res += theMaterials[i]->setTrial(strain, stress, tangent);
+    }
+    fiberTangent[i] = tangent;
 
     double fs0 = stress * A;
 
@@ -495,6 +603,10 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
     sData[2] += fs0 * z;
   }
 
+  this->formFiberTangent(yLocs.data(), zLocs.data(), fiberArea.data(), fiberTangent.data());
+  kData[0] = kFiber[0]; kData[1] = kFiber[1]; kData[2] = kFiber[2];
+  kData[5] = kFiber[3]; kData[6] = kFiber[4]; kData[10] = kFiber[5];
+
   kData[4] = kData[1];
   kData[8] = kData[2];
   kData[9] = kData[6];
@@ -508,21 +620,122 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   return res;
 }
 
+// forms the fiber part of the section stiffness, kFiber, from the
+// fiber tangents; between refreshes only the fibers whose tangent has
+// changed since the last trial are added to it
+void
+FiberSection3d::formFiberTangent(const double *yPtr, const double *zPtr,
+				 const double *APtr, const double *tangentPtr)
+{
+  if (tangentRefresh || (int)lastTangent.size() != numFibers) {
+    lastTangent.assign(tangentPtr, tangentPtr + numFibers);
+
+    double k0 = 0.0, k1 = 0.0, k2 = 0.0, k5 = 0.0, k6 = 0.0, k10 = 0.0;
+
+#pragma omp simd reduction(+:k0,k1,k2,k5,k6,k10)
+    for (int i = 0; i < numFibers; i++) {
+      double y = yPtr[i] - yBar;
+      double z = zPtr[i] - zBar;
+      double value = tangentPtr[i] * APtr[i];
+
+      k0 += value;
+      k1 += -y*value;
+      k2 += z*value;
+      k5 += y*y*value;
+      k6 += -y*z*value;
+      k10 += z*z*value;
+    }
+
+    kFiber[0] = k0; kFiber[1] = k1; kFiber[2] = k2;
+    kFiber[3] = k5; kFiber[4] = k6; kFiber[5] = k10;
+    tangentRefresh = false;
+    return;
+  }
+
+  for (int i = 0; i < numFibers; i++) {
+    double dTangent = tangentPtr[i] - lastTangent[i];
+    if (dTangent == 0.0)
+      continue;
+    lastTangent[i] = tangentPtr[i];
+
+    double y = yPtr[i] - yBar;
+    double z = zPtr[i] - zBar;
+    double value = dTangent * APtr[i];
+
+    kFiber[0] += value;
+    kFiber[1] += -y*value;
+    kFiber[2] += z*value;
+    kFiber[3] += y*y*value;
+    kFiber[4] += -y*z*value;
+    kFiber[5] += z*z*value;
+  }
+}
+
+// takes the current state of the fibers, the state they are committed
+// at, as the reference of the elastic mode
+void
+FiberSection3d::setElasticReference(void)
+{
+  const Matrix &kInitial = this->getInitialTangent();
+  for (int j = 0; j < 4; j++)
+    for (int i = 0; i < 4; i++)
+      kElastic[4*j+i] = kInitial(i,j);
+
+  for (int i = 0; i < 4; i++) {
+    eRef[i] = e(i);
+    sRef[i] = sData[i];
+  }
+}
+
+int
+FiberSection3d::setAdaptive(double strainLimit, bool allowReturn)
+{
+  if (strainLimit < 0.0) {
+    opserr << "FiberSection3d::setAdaptive - strain limit must not be negative\n";
+    return -1;
+  }
+
+  adaptStrain = strainLimit;
+  adaptReturn = allowReturn;
+
+  // the elastic mode starts from the initial state of the fibers
+  return this->revertToStart();
+}
+
+// returns true if there is more than one fiber and all fiber materials 
+// are of the same class, in which case they can be set as one batch
+bool
+FiberSection3d::isSingleMaterialType(void) const
+{
+  if (numFibers < 2)
+    return false;
+
+  int classTag = theMaterials[0]->getClassTag();
+  for (int i = 1; i < numFibers; i++)
+    if (theMaterials[i]->getClassTag() != classTag)
+      return false;
+
+  return true;
+}
+
 const Matrix&
 FiberSection3d::getInitialTangent(void)
 {
-  static double kInitialData[16];
-  static Matrix kInitial(kInitialData, 4, 4);
+  static thread_local double kInitialData[16];
+  static thread_local Matrix kInitial(kInitialData, 4, 4);
   
   kInitial.Zero();
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -599,18 +812,10 @@ FiberSection3d::getCopy(void)
       exit(-1);			    
     }
 
-    theCopy->matData = new double [numFibers*3];
+    theCopy->matShared = matShared;
+    theCopy->matData = matData;
 
-    if (theCopy->matData == 0) {
-      opserr << "FiberSection3d::FiberSection3d -- failed to allocate double array for material data\n";
-      exit(-1);
-    }
-			    
-    
     for (int i = 0; i < numFibers; i++) {
-      theCopy->matData[i*3] = matData[i*3];
-      theCopy->matData[i*3+1] = matData[i*3+1];
-      theCopy->matData[i*3+2] = matData[i*3+2];
       theCopy->theMaterials[i] = theMaterials[i]->getCopy();
 
       if (theCopy->theMaterials[i] == 0) {
@@ -636,6 +841,18 @@ FiberSection3d::getCopy(void)
   theCopy->sData[2] = sData[2];
   theCopy->sData[3] = sData[3];
 
+  theCopy->adaptStrain = adaptStrain;
+  theCopy->adaptReturn = adaptReturn;
+  theCopy->elasticCommit = elasticCommit;
+  theCopy->elasticTrial = elasticTrial;
+  for (int i = 0; i < 4; i++) {
+    theCopy->eRef[i] = eRef[i];
+    theCopy->sRef[i] = sRef[i];
+    theCopy->eCommit[i] = eCommit[i];
+  }
+  for (int i = 0; i < 16; i++)
+    theCopy->kElastic[i] = kElastic[i];
+
   if (theTorsion != 0)
     theCopy->theTorsion = theTorsion->getCopy();
   else
@@ -666,12 +883,38 @@ FiberSection3d::commitState(void)
 {
   int err = 0;
 
-  for (int i = 0; i < numFibers; i++)
-    err += theMaterials[i]->commitState();
+  // the fiber stiffness is formed from all fibers once per step, so the
+  // round-off of its updates does not build up
+  tangentRefresh = true;
+
+  // in the elastic mode the fibers are still at the reference state
+  if (elasticTrial == false) {
+    if (this->isSingleMaterialType())
+      err += theMaterials[0]->commitStateBatch(numFibers, theMaterials);
+    else
+      for (int i = 0; i < numFibers; i++)
+	err += theMaterials[i]->commitState();
+
+    elasticCommit = false;
+    if (adaptStrain > 0.0 && adaptReturn) {
+      elasticCommit = true;
+      for (int i = 0; i < numFibers && elasticCommit; i++) {
+	double E0 = theMaterials[i]->getInitialTangent();
+	if (fabs(theMaterials[i]->getTangent() - E0) > 1.0e-6*fabs(E0))
+	  elasticCommit = false;
+      }
+      if (elasticCommit)
+	this->setElasticReference();
+    }
+  }
 
   if (theTorsion != 0)
     err += theTorsion->commitState();
 
+  for (int i = 0; i < 4; i++)
+    eCommit[i] = e(i);
+  elasticTrial = elasticCommit;
+
   return err;
 }
 
@@ -680,19 +923,24 @@ FiberSection3d::revertToLastCommit(void)
 {
   int err = 0;
 
+  tangentRefresh = true;
+
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   kData[4] = 0.0; kData[5] = 0.0; kData[6] = 0.0; kData[7] = 0.0;
   kData[8] = 0.0; 
   kData[15] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -744,6 +992,18 @@ FiberSection3d::revertToLastCommit(void)
   } else
     kData[15] = 0.0;
 
+  elasticTrial = elasticCommit;
+  if (elasticCommit) {
+    double de0 = eCommit[0] - eRef[0];
+    double de1 = eCommit[1] - eRef[1];
+    double de2 = eCommit[2] - eRef[2];
+    for (int i = 0; i < 3; i++) {
+      sData[i] = sRef[i] + kElastic[i]*de0 + kElastic[4+i]*de1 + kElastic[8+i]*de2;
+      for (int j = 0; j < 3; j++)
+	kData[4*j+i] = kElastic[4*j+i];
+    }
+  }
+
   return err;
 }
 
@@ -753,19 +1013,24 @@ FiberSection3d::revertToStart(void)
   // revert the fibers to start    
   int err = 0;
 
+  tangentRefresh = true;
+
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   kData[4] = 0.0; kData[5] = 0.0; kData[6] = 0.0; kData[7] = 0.0;
   kData[8] = 0.0;
   kData[15] = 0.0; 
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -820,6 +1085,15 @@ FiberSection3d::revertToStart(void)
     sData[3] = 0.0;
   }
 
+  for (int i = 0; i < 4; i++)
+    eCommit[i] = 0.0;
+  if (adaptStrain > 0.0) {
+    e.Zero();
+    this->setElasticReference();
+  }
+  elasticCommit = (adaptStrain > 0.0);
+  elasticTrial = elasticCommit;
+
   return err;
 }
 
@@ -829,7 +1103,7 @@ FiberSection3d::sendSelf(int commitTag, Channel &theChannel)
   int res = 0;
 
   // create an id to send objects tag and numFibers, 
-  static ID data(9);
+  static ID data(10);
   data(0) = this->getTag();
   data(1) = numFibers;
   data(2) = (theTorsion != 0) ? 1 : 0;
@@ -855,6 +1129,7 @@ FiberSection3d::sendSelf(int commitTag, Channel &theChannel)
     }
     data(8) = sectionIntegrDbTag;
   }
+  data(9) = (adaptStrain > 0.0) ? (adaptReturn ? 2 : 1) : 0;
 
   int dbTag = this->getDbTag();  
   res += theChannel.sendID(dbTag, commitTag, data);
@@ -863,6 +1138,16 @@ FiberSection3d::sendSelf(int commitTag, Channel &theChannel)
     return res;
   }    
 
+  if (data(9) != 0) {
+    static Vector adaptData(1);
+    adaptData(0) = adaptStrain;
+    res = theChannel.sendVector(dbTag, commitTag, adaptData);
+    if (res < 0) {
+      opserr << "FiberSection3d::sendSelf - failed to send adaptive data\n";
+      return res;
+    }
+  }
+
   if (theTorsion != 0)
     theTorsion->sendSelf(commitTag, theChannel);
 
@@ -924,7 +1209,9 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 {
   int res = 0;
 
-  static ID data(9);
+  tangentRefresh = true;
+
+  static ID data(10);
   
   int dbTag = this->getDbTag();
   res += theChannel.recvID(dbTag, commitTag, data);
@@ -934,6 +1221,17 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
   } 
   this->setTag(data(0));
 
+  double recvAdaptStrain = 0.0;
+  if (data(9) != 0) {
+    static Vector adaptData(1);
+    res += theChannel.recvVector(dbTag, commitTag, adaptData);
+    if (res < 0) {
+      opserr << "FiberSection3d::recvSelf - failed to recv adaptive data\n";
+      return res;
+    }
+    recvAdaptStrain = adaptData(0);
+  }
+
   if (data(2) == 1 && theTorsion == 0) {	
     int torsionClassTag = data(3);
     int torsionDbTag = data(4);
@@ -994,8 +1292,7 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 	for (int i=0; i<numFibers; i++)
 	  delete theMaterials[i];
 	delete [] theMaterials;
-	if (matData != 0)
-	  delete [] matData;
+	matShared.reset();
 	matData = 0;
 	theMaterials = 0;
       }
@@ -1015,7 +1312,8 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 	for (int j=0; j<numFibers; j++)
 	  theMaterials[j] = 0;
 	
-	matData = new double [numFibers*3];
+	matShared = newFiberGeometry(numFibers*3);
+	matData = matShared.get();
 
 	if (matData == 0) {
 	  opserr << "FiberSection3d::recvSelf  -- failed to allocate double array for material data\n";
@@ -1024,6 +1322,12 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
       }
     }
 
+    // the received geometry must not overwrite that of the copies
+    if (matShared.use_count() > 1) {
+      matShared = newFiberGeometry(3*numFibers);
+      matData = matShared.get();
+    }
+
     Vector fiberData(matData, 3*numFibers);
     res += theChannel.recvVector(dbTag, commitTag, fiberData);
     if (res < 0) {
@@ -1061,12 +1365,15 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
     computeCentroid = data(5) ? true : false;
 
     if (sectionIntegr != 0) {
-      static double yLocs[10000];
-      static double zLocs[10000];
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+      static thread_local std::vector<double> yLocs;
+      yLocs.resize(numFibers);
+      static thread_local std::vector<double> zLocs;
+      zLocs.resize(numFibers);
+      sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
       
-      static double fiberArea[10000];
-      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+      static thread_local std::vector<double> fiberArea;
+      fiberArea.resize(numFibers);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
       
       for (int i = 0; i < numFibers; i++) {
 	Abar  += fiberArea[i];
@@ -1095,9 +1402,65 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
     }
   }   
 
+  // the section deformations are not sent, so a received section is
+  // only elastic if its fibers are unstrained, otherwise it goes back to
+  // the elastic mode at a commit as when it unloads
+  adaptStrain = recvAdaptStrain;
+  adaptReturn = (data(9) == 2);
+  elasticCommit = false;
+  bool unstrained = (adaptStrain > 0.0);
+  for (int i = 0; i < numFibers && unstrained; i++)
+    if (theMaterials[i]->getStrain() != 0.0)
+      unstrained = false;
+  if (unstrained) {
+    res += this->revertToLastCommit();
+    e.Zero();
+    for (int i = 0; i < 4; i++)
+      eCommit[i] = 0.0;
+    this->setElasticReference();
+    elasticCommit = true;
+  }
+  elasticTrial = elasticCommit;
+
   return res;
 }
 
+size_t
+FiberSection3d::getMemoryUsage(void)
+{
+  size_t result = MemoryReport::objectSize(this);
+  result += MemoryReport::vectorSize(s) + MemoryReport::matrixSize(ks);
+  result += sizeFibers*(sizeof(UniaxialMaterial *) + 3*sizeof(double));
+  for (int i = 0; i < numFibers; i++)
+    result += MemoryReport::objectSize(theMaterials[i]);
+  result += MemoryReport::objectSize(theTorsion);
+
+  return result;
+}
+
+int
+FiberSection3d::getFiberGeometry(double *y, double *z, double *A)
+{
+  for (int i = 0; i < numFibers; i++) {
+    y[i] = matData[3*i];
+    z[i] = matData[3*i+1];
+    A[i] = matData[3*i+2];
+  }
+
+  return numFibers;
+}
+
+int
+FiberSection3d::getFiberStrainStress(double *strain, double *stress)
+{
+  for (int i = 0; i < numFibers; i++) {
+    strain[i] = theMaterials[i]->getStrain();
+    stress[i] = theMaterials[i]->getStress();
+  }
+
+  return numFibers;
+}
+
 void
 FiberSection3d::Print(OPS_Stream &s, int flag)
 {
@@ -1166,12 +1529,15 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
   Response *theResponse = 0;
   
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
   
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1344,12 +1710,15 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 int 
 FiberSection3d::getResponse(int responseID, Information &sectInfo)
 {
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
   
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1412,7 +1781,7 @@ FiberSection3d::getResponse(int responseID, Information &sectInfo)
 	  return sectInfo.setDouble(getEnergy());
   }
   else if (responseID == 20) {
-    static Vector centroid(2);
+    static thread_local Vector centroid(2);
     centroid(0) = yBar;
     centroid(1) = zBar;
     return sectInfo.setVector(centroid);
@@ -1486,7 +1855,7 @@ FiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
 const Vector &
 FiberSection3d::getSectionDeformationSensitivity(int gradIndex)
 {
-  static Vector dummy(4);
+  static thread_local Vector dummy(4);
   
   dummy.Zero();
   
@@ -1497,7 +1866,7 @@ FiberSection3d::getSectionDeformationSensitivity(int gradIndex)
 const Vector &
 FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
 {
-  static Vector ds(4);
+  static thread_local Vector ds(4);
   
   ds.Zero();
   
@@ -1507,13 +1876,16 @@ FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
   double sig_dAdh = 0;
   double tangent = 0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
+  static thread_local std::vector<double> fiberArea;
+  fiberArea.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
+    sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
   }  
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1523,13 +1895,16 @@ FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
     }
   }
 
-  static double dydh[10000];
-  static double dzdh[10000];
-  static double areaDeriv[10000];
+  static thread_local std::vector<double> dydh;
+  dydh.resize(numFibers);
+  static thread_local std::vector<double> dzdh;
+  dzdh.resize(numFibers);
+  static thread_local std::vector<double> areaDeriv;
+  areaDeriv.resize(numFibers);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());  
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   else {
     for (int i = 0; i < numFibers; i++) {
@@ -1570,16 +1945,16 @@ FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
     if (dzdh[i] != 0.0)
       ds(2) +=  dzdh[i] * (stress*A);
 
-    static Matrix as(1,3);
+    static thread_local Matrix as(1,3);
     as(0,0) = 1;
     as(0,1) = -y;
     as(0,2) = z;
     
-    static Matrix dasdh(1,3);
+    static thread_local Matrix dasdh(1,3);
     dasdh(0,1) = -dydh[i];
     dasdh(0,2) = dzdh[i];
     
-    static Matrix tmpMatrix(3,3);
+    static thread_local Matrix tmpMatrix(3,3);
     tmpMatrix.addMatrixTransposeProduct(0.0, as, dasdh, tangent);
     
     //ds.addMatrixVector(1.0, tmpMatrix, e, A);
@@ -1596,7 +1971,7 @@ FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
 const Matrix &
 FiberSection3d::getSectionTangentSensitivity(int gradIndex)
 {
-  static Matrix something(4,4);
+  static thread_local Matrix something(4,4);
   
   something.Zero();
 
@@ -1616,11 +1991,13 @@ FiberSection3d::commitSensitivity(const Vector& defSens, int gradIndex, int numG
 
   //dedh = defSens;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
+  static thread_local std::vector<double> yLocs;
+  yLocs.resize(numFibers);
+  static thread_local std::vector<double> zLocs;
+  zLocs.resize(numFibers);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+    sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
   else {
     for (int i = 0; i < numFibers; i++) {
       yLocs[i] = matData[3*i];
@@ -1628,11 +2005,13 @@ FiberSection3d::commitSensitivity(const Vector& defSens, int gradIndex, int numG
     }
   }
 
-  static double dydh[10000];
-  static double dzdh[10000];
+  static thread_local std::vector<double> dydh;
+  dydh.resize(numFibers);
+  static thread_local std::vector<double> dzdh;
+  dzdh.resize(numFibers);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());  
   else {
     for (int i = 0; i < numFibers; i++) {
       dydh[i] = 0.0;
@@ -1665,10 +2044,11 @@ FiberSection3d::commitSensitivity(const Vector& defSens, int gradIndex, int numG
 //by SAJalali
 double FiberSection3d::getEnergy() const
 {
-	static double fiberArea[10000];
+	static thread_local std::vector<double> fiberArea;
+	fiberArea.resize(numFibers);
 
 	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
+		sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
 	}
 	else {
 		for (int i = 0; i < numFibers; i++) {
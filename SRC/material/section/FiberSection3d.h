@@ -37,6 +37,8 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <FiberSectionRepr.h>
+#include <memory>
+#include <vector>
 
 class UniaxialMaterial;
 class Fiber;
@@ -75,6 +77,11 @@ class FiberSection3d : public SectionForceDeformation
     int recvSelf(int cTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
     void Print(OPS_Stream &s, int flag = 0);
+    size_t getMemoryUsage(void);
+
+    int getNumFibers(void) {return numFibers;}
+    int getFiberGeometry(double *y, double *z, double *A);
+    int getFiberStrainStress(double *strain, double *stress);
 	    
     Response *setResponse(const char **argv, int argc, 
 			  OPS_Stream &s);
@@ -82,6 +89,14 @@ class FiberSection3d : public SectionForceDeformation
 
     int addFiber(Fiber &theFiber);
 
+    // adaptive integration: while no fiber strain has changed by more than
+    // strainLimit from the last state the fibers were integrated at, the
+    // section response is that state plus the initial section stiffness
+    // times the change in deformations; with allowReturn a section goes
+    // back to this elastic mode after a committed step in which every
+    // fiber is on its initial tangent
+    int setAdaptive(double strainLimit, bool allowReturn = false);
+
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
 
@@ -99,9 +114,15 @@ class FiberSection3d : public SectionForceDeformation
   protected:
     
   private:
+    bool isSingleMaterialType(void) const;
+    void setElasticReference(void);
+    void formFiberTangent(const double *yPtr, const double *zPtr,
+			  const double *APtr, const double *tangentPtr);
+
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc, zloc, area]
+    std::shared_ptr<double> matShared; // owner of matData, shared by the copies
     double   kData[16];              // data for ks matrix 
     double   sData[4];               // data for s vector 
 
@@ -119,6 +140,19 @@ class FiberSection3d : public SectionForceDeformation
     Matrix *ks;        // section stiffness
 
     UniaxialMaterial *theTorsion;
+
+    double adaptStrain;      // fiber strain change of the elastic mode, 0 if not adaptive
+    bool adaptReturn;        // return to the elastic mode after unloading
+    bool elasticCommit;      // committed state is in the elastic mode
+    bool elasticTrial;       // trial state is in the elastic mode
+    double eRef[4];          // deformations & resultants at which the fibers
+    double sRef[4];          //   were last integrated
+    double kElastic[16];     // initial section stiffness
+    double eCommit[4];       // committed deformations
+
+    bool tangentRefresh;     // form kFiber from all fibers at the next trial
+    std::vector<double> lastTangent; // fiber tangents kFiber was formed with
+    double kFiber[6];        // [k00, k10, k20, k11, k21, k22] summed over the fibers
 };
 
 #endif
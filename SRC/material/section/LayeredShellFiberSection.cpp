@@ -38,6 +38,7 @@ Earthquake Engineering & Structural Dynamics, 2013, 42(5): 705-723*/
 #include <Information.h>
 #include <elementAPI.h>
 #include <Parameter.h>
+#include <vector>
 
 void* OPS_LayeredShellFiberSection()
 {
@@ -141,9 +142,9 @@ void* OPS_LayeredShellFiberSection()
 }
 
 //static vector and matrices
-Vector  LayeredShellFiberSection::stressResultant(8) ;
-Matrix  LayeredShellFiberSection::tangent(8,8) ;
-ID      LayeredShellFiberSection::array(8) ;
+thread_local Vector  LayeredShellFiberSection::stressResultant(8) ;
+thread_local Matrix  LayeredShellFiberSection::tangent(8,8) ;
+thread_local ID      LayeredShellFiberSection::array(8) ;
 
 //null constructor
 LayeredShellFiberSection::LayeredShellFiberSection( ) : 
@@ -263,8 +264,7 @@ int LayeredShellFiberSection::commitState( )
 {
   int success = 0 ;
 
-  for (int i = 0; i < nLayers; i++ )
-    success += theFibers[i]->commitState( ) ;
+  success = NDMaterial::commitStateGroups( nLayers, theFibers ) ;
 
   return success ;
 }
@@ -274,8 +274,7 @@ int LayeredShellFiberSection::revertToLastCommit( )
 {
   int success = 0 ;
 
-  for (int i = 0; i < nLayers; i++ )
-    success += theFibers[i]->revertToLastCommit( ) ;
+  success = NDMaterial::revertToLastCommitGroups( nLayers, theFibers ) ;
 
   return success ;
 }
@@ -422,9 +421,9 @@ setTrialSectionDeformation( const Vector &strainResultant_from_element)
 {
   this->strainResultant = strainResultant_from_element ;
 
-  static Vector strain(5) ;
-
-  int success = 0 ;
+  //strains of all the layers, set in one call per material class
+  static thread_local std::vector<double> strain ;
+  strain.resize( 5*nLayers ) ;
 
   int i ;
 
@@ -433,22 +432,22 @@ setTrialSectionDeformation( const Vector &strainResultant_from_element)
   for ( i = 0; i < nLayers; i++ ) {
 
       z = ( 0.5*h ) * sg[i] ;
+
+      double *strainI = &strain[5*i] ;
   
-      strain(0) =  strainResultant(0)  - z*strainResultant(3) ;
+      strainI[0] =  strainResultant(0)  - z*strainResultant(3) ;
 
-      strain(1) =  strainResultant(1)  - z*strainResultant(4) ;
+      strainI[1] =  strainResultant(1)  - z*strainResultant(4) ;
 
-      strain(2) =  strainResultant(2)  - z*strainResultant(5) ;
+      strainI[2] =  strainResultant(2)  - z*strainResultant(5) ;
 
-      strain(4) =  strainResultant(6) ;
+      strainI[4] =  strainResultant(6) ;
 
-      strain(3) =  strainResultant(7) ;
-  
-      success += theFibers[i]->setTrialStrain( strain ) ;
+      strainI[3] =  strainResultant(7) ;
 
   } //end for i
 
-  return success ;
+  return NDMaterial::setTrialStrainGroups( nLayers, theFibers, &strain[0], 5 ) ;
 }
 
 
@@ -463,8 +462,6 @@ const Vector& LayeredShellFiberSection::getSectionDeformation( )
 const Vector&  LayeredShellFiberSection::getStressResultant( )
 {
 
-  static Vector stress(5) ;
-
   int i ;
 
   double z, weight ;
@@ -477,7 +474,7 @@ const Vector&  LayeredShellFiberSection::getStressResultant( )
 
       weight = ( 0.5*h ) * wg[i] ;
 
-      stress = theFibers[i]->getStress( ) ;
+      const Vector &stress = theFibers[i]->getStress( ) ;
   
       //membrane
       stressResultant(0)  +=  stress(0)*weight ;
@@ -507,7 +504,7 @@ const Vector&  LayeredShellFiberSection::getStressResultant( )
 //send back the tangent 
 const Matrix&  LayeredShellFiberSection::getSectionTangent( )
 {
-  static Matrix dd(5,5) ;
+  static thread_local Matrix dd(5,5) ;
 
 //  static Matrix Aeps(5,8) ;
 
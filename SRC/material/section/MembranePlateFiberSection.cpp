@@ -82,9 +82,9 @@ void* OPS_MembranePlateFiberSection()
 const double MembranePlateFiberSection::root56 = sqrt(5.0/6.0) ; //shear correction
 
 //static vector and matrices
-Vector  MembranePlateFiberSection::stressResultant(8) ;
-Matrix  MembranePlateFiberSection::tangent(8,8) ;
-ID      MembranePlateFiberSection::array(8) ;
+thread_local Vector  MembranePlateFiberSection::stressResultant(8) ;
+thread_local Matrix  MembranePlateFiberSection::tangent(8,8) ;
+thread_local ID      MembranePlateFiberSection::array(8) ;
 
 
 const double  MembranePlateFiberSection::sgLobatto[] = { -1, 
@@ -195,8 +195,7 @@ int MembranePlateFiberSection::commitState( )
 {
   int success = 0 ;
 
-  for ( int i = 0; i < numFibers; i++ )
-    success += theFibers[i]->commitState( ) ;
+  success = NDMaterial::commitStateGroups( numFibers, theFibers ) ;
 
   return success ;
 }
@@ -208,8 +207,7 @@ int MembranePlateFiberSection::revertToLastCommit( )
 {
   int success = 0 ;
 
-  for ( int i = 0; i < numFibers; i++ )
-    success += theFibers[i]->revertToLastCommit( ) ;
+  success = NDMaterial::revertToLastCommitGroups( numFibers, theFibers ) ;
 
   return success ;
 }
@@ -256,9 +254,8 @@ setTrialSectionDeformation( const Vector &strainResultant_from_element)
 {
   this->strainResultant = strainResultant_from_element ;
 
-  static Vector strain(numFibers) ;
-
-  int success = 0 ;
+  //strains of the five fibers, set in one call per material class
+  double strain[5*numFibers] ;
 
   double z ;
 
@@ -267,22 +264,22 @@ setTrialSectionDeformation( const Vector &strainResultant_from_element)
   for ( int i = 0; i < numFibers; i++ ) {
 
       z = ( 0.5*h ) * sg[i] ;
+
+      double *strainI = &strain[5*i] ;
   
-      strain(0) =  strainResultant(0)  - z*strainResultant(3) ;
+      strainI[0] =  strainResultant(0)  - z*strainResultant(3) ;
 
-      strain(1) =  strainResultant(1)  - z*strainResultant(4) ;
+      strainI[1] =  strainResultant(1)  - z*strainResultant(4) ;
 
-      strain(2) =  strainResultant(2)  - z*strainResultant(5) ;
+      strainI[2] =  strainResultant(2)  - z*strainResultant(5) ;
 
-      strain(4) =  root56*strainResultant(6) ;
+      strainI[4] =  root56*strainResultant(6) ;
 
-      strain(3) =  root56*strainResultant(7) ;
-  
-      success += theFibers[i]->setTrialStrain( strain ) ;
+      strainI[3] =  root56*strainResultant(7) ;
 
   } //end for i
 
-  return success ;
+  return NDMaterial::setTrialStrainGroups( numFibers, theFibers, strain, 5 ) ;
 }
 
 
@@ -297,8 +294,6 @@ const Vector& MembranePlateFiberSection::getSectionDeformation( )
 const Vector&  MembranePlateFiberSection::getStressResultant( )
 {
 
-  static Vector stress(numFibers) ;
-
   double z, weight ;
 
   stressResultant.Zero( ) ;
@@ -312,7 +307,7 @@ const Vector&  MembranePlateFiberSection::getStressResultant( )
 
       weight = ( 0.5*h ) * wg[i] ;
 
-      stress = theFibers[i]->getStress( ) ;
+      const Vector &stress = theFibers[i]->getStress( ) ;
   
       //membrane
       stressResultant(0)  +=  stress(0)*weight ;
@@ -346,11 +341,11 @@ const Vector&  MembranePlateFiberSection::getStressResultant( )
 //send back the tangent 
 const Matrix&  MembranePlateFiberSection::getSectionTangent( )
 {
-  static Matrix dd(5,5) ;
+  static thread_local Matrix dd(5,5) ;
 
-  static Matrix Aeps(5,8) ;
+  static thread_local Matrix Aeps(5,8) ;
 
-  static Matrix Asig(8,5) ;
+  static thread_local Matrix Asig(8,5) ;
 
   double z, weight ;
 
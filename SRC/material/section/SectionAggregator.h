@@ -103,6 +103,13 @@ class SectionAggregator : public SectionForceDeformation
 
     SectionForceDeformation* getSection() {return theSection;}
 
+    // the fibers are those of the aggregated section
+    int getNumFibers(void) {return theSection != 0 ? theSection->getNumFibers() : 0;}
+    int getFiberGeometry(double *y, double *z, double *A)
+      {return theSection != 0 ? theSection->getFiberGeometry(y, z, A) : -1;}
+    int getFiberStrainStress(double *strain, double *stress)
+      {return theSection != 0 ? theSection->getFiberStrainStress(strain, stress) : -1;}
+
   protected:
     
   private:
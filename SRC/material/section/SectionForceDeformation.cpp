@@ -38,6 +38,7 @@
 #include <MaterialResponse.h>
 
 #include <elementAPI.h>
+#include <MemoryReport.h>
 #include <DummyStream.h>
 #include <Element.h>
 #include <Domain.h>
@@ -49,6 +50,7 @@
 #include <MapOfTaggedObjectsIter.h>
 
 static MapOfTaggedObjects theSectionForceDeformationObjects;
+static bool theSectionForceDeformationObjectsRegistered = MapOfTaggedObjects::addModelStorage(theSectionForceDeformationObjects);
 
 bool OPS_addSectionForceDeformation(SectionForceDeformation *newComponent) {
   return theSectionForceDeformationObjects.addComponent(newComponent);
@@ -937,3 +939,10 @@ const Vector& SectionForceDeformation::getThermalElong(void)
     errRes.resize(this->getStressResultant().Size());
     return errRes;
 }
+
+size_t
+SectionForceDeformation::getMemoryUsage(void)
+{
+    return MemoryReport::objectSize(this) + MemoryReport::matrixSize(fDefault) +
+      MemoryReport::vectorSize(sDefault);
+}
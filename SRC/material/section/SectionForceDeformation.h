@@ -126,6 +126,16 @@ class SectionForceDeformation : public Material
   virtual const Vector& getThermalElong(void);
   virtual double getEnergy() const { return 0; };		//by SAJalali
 
+  // bytes held by the section & the materials it owns
+  virtual size_t getMemoryUsage(void);
+
+  // the fibers of a fiber section, read in bulk by the recorders: the
+  // location & area and the strain & stress of each fiber, into arrays of
+  // getNumFibers() doubles; -1 if the section has no fibers
+  virtual int getNumFibers(void) {return 0;};
+  virtual int getFiberGeometry(double *y, double *z, double *A) {return -1;};
+  virtual int getFiberStrainStress(double *strain, double *stress) {return -1;};
+
  protected:
   Matrix *fDefault;	// Default flexibility matrix
   Vector *sDefault;
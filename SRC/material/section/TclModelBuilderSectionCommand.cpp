@@ -518,6 +518,8 @@ static int currentSectionTag = 0;
 static bool currentSectionIsND = false;
 static bool currentSectionIsWarping = false;
 static bool currentSectionComputeCentroid = true;
+static double currentSectionAdaptiveStrain = 0.0;
+static bool currentSectionAdaptiveReturn = false;
 
 int
 buildSection(Tcl_Interp *interp, TclModelBuilder *theTclModelBuilder,
@@ -553,6 +555,8 @@ TclCommand_addFiberSection (ClientData clientData, Tcl_Interp *interp, int argc,
     currentSectionIsND = false;
     currentSectionIsWarping = false;
     currentSectionComputeCentroid = true;
+    currentSectionAdaptiveStrain = 0.0;
+    currentSectionAdaptiveReturn = false;
     if (strcmp(argv[1],"NDFiber") == 0)
       currentSectionIsND = true;
     if (strcmp(argv[1],"NDFiberWarping") == 0) {
@@ -587,6 +591,20 @@ TclCommand_addFiberSection (ClientData clientData, Tcl_Interp *interp, int argc,
 	currentSectionComputeCentroid = false;
 	brace += 1;
       }
+
+      if (strcmp(argv[iarg],"-adaptive") == 0 && iarg+1 < argc) {
+	if (Tcl_GetDouble(interp, argv[brace+1], &currentSectionAdaptiveStrain) != TCL_OK ||
+	    currentSectionAdaptiveStrain <= 0.0) {
+	  opserr << "WARNING invalid strain limit for -adaptive";
+	  return TCL_ERROR;
+	}
+	brace += 2;
+      }
+
+      if (strcmp(argv[iarg],"-adaptiveReturn") == 0) {
+	currentSectionAdaptiveReturn = true;
+	brace += 1;
+      }
       
       if (strcmp(argv[iarg],"-GJ") == 0 && iarg+1 < argc) {
 	if (Tcl_GetDouble(interp, argv[brace+1], &GJ) != TCL_OK) {
@@ -1866,8 +1884,12 @@ buildSection(Tcl_Interp *interp, TclModelBuilder *theTclModelBuilder,
 	 SectionForceDeformation *section = 0;
 	 if (currentSectionIsND)
 	   section = new NDFiberSection3d(secTag, numFibers, fiber, currentSectionComputeCentroid);
-	 else
-	   section = new FiberSection3d(secTag, numFibers, fiber, theTorsion, currentSectionComputeCentroid);
+	 else {
+	   FiberSection3d *section3d = new FiberSection3d(secTag, numFibers, fiber, theTorsion, currentSectionComputeCentroid);
+	   if (currentSectionAdaptiveStrain > 0.0)
+	     section3d->setAdaptive(currentSectionAdaptiveStrain, currentSectionAdaptiveReturn);
+	   section = section3d;
+	 }
    
 	 // Delete fibers
 	 for (i = numSectionRepresFibers; i < numFibers; i++)
@@ -33,6 +33,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theSectionRepresObjects;
+static bool theSectionRepresObjectsRegistered = MapOfTaggedObjects::addModelStorage(theSectionRepresObjects);
 
 bool OPS_addSectionRepres(SectionRepres *newComponent)
 {
@@ -7,6 +7,7 @@
 #include <Matrix.h>
 #include <Information.h>
 #include <Parameter.h>
+#include <BoucWenCore.h>
 
 
 void *
@@ -111,111 +112,87 @@ BWBN::setTrialStrain (double strain, double strainRate)
 
 
 	// Initial declarations (make sure not to declare class variables here!)
-	double Psi, Phi, f, Te_;
-	double Phi_, f_, Tznew, Tzold, sign;
-	double Tzeta1, Tzeta2, Tzeta1_, Tzeta2_, h, h_,zu;
+	double Psi, Phi, zn, zn1;
+	double Tzeta1, Tzeta2, h;
 
 
-	// Newton-Raphson scheme to solve for z_{i+1} := z1
-	int count = 0;
-	double startPoint = 0.01;
-	Tz = startPoint;
-	Tzold = startPoint;
-	Tznew = 1.0;  
-	while ( ( fabs(Tzold-Tznew) > tolerance ) && count<maxNumIter) {
+	// Terms of the pinching function that do not depend on z_{i+1}
+	double zu = pow(1/(beta+gamma),1/n);
+	double sDStrain = signum(dStrain);
+	double Te_ = (1.0-alpha)*ko*dStrain;
 
-		Te = Ce + (1.0-alpha)*ko*dStrain*Tz;
-		sign = signum(dStrain*Tz);
+
+	// Function f and its derivative f' (underscore:=prime)
+	auto residual = [&](double z, double &f, double &f_) {
+		Te = Ce + (1.0-alpha)*ko*dStrain*z;
+		Psi = gamma + beta*signum(dStrain*z);
 		Tzeta1 = zetas*(1-exp(-p*Te));
 		Tzeta2 = (Shi+deltaShi*Te)*(lamda+Tzeta1);
-		zu = pow(1/(beta+gamma),1/n);
-		h = 1.0-Tzeta1*exp(-pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2));
-		Psi = gamma + beta*sign;
-		Phi = Ao - pow(fabs(Tz),n)*Psi;
-		f = Tz - Cz - Phi*h*dStrain;
-
-
-		// Evaluate function derivative f' (underscore:=prime)
-		Te_ = (1.0-alpha)*ko*dStrain;
-		Tzeta1_ = zetas*p*exp(-p*Te)*Te_;
-		Tzeta2_ = Shi*Tzeta1_+lamda*deltaShi*Te_+deltaShi*Te*Tzeta1_+deltaShi*Te_*Tzeta1;
-		//h_ = -exp(-pow(Tz*signum(dStrain)-q*zu,2)/(Tzeta2*Tzeta2))*(Tzeta1_-Tzeta1*2*(Tz*signum(dStrain)-q*zu)/(Tzeta2*Tzeta2)+Tzeta2_*Tzeta1*2*pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2*Tzeta2));
-		h_ = -exp(-pow(Tz*signum(dStrain)-q*zu,2)/(Tzeta2*Tzeta2))*(Tzeta1_-Tzeta1*2*(Tz*signum(dStrain)-q*zu)*signum(dStrain)/(Tzeta2*Tzeta2)+Tzeta2_*Tzeta1*2*pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2*Tzeta2));
-		sign = signum(Tz);
-		double pow1;
-		if (Tz == 0.0) {
-			pow1 = 0.0;
-		}
-		else {
-			pow1 = pow(fabs(Tz),(n-1));
-		}
-		Phi_ = - n*pow1*sign*Psi;
+		double zq = z*sDStrain-q*zu;
+		double e = exp(-zq*zq/(Tzeta2*Tzeta2));
+		h = 1.0-Tzeta1*e;
+		boucWenPowers(z, n, zn, zn1);
+		Phi = Ao - zn*Psi;
+		f = z - Cz - Phi*h*dStrain;
+
+		double Tzeta1_ = zetas*p*exp(-p*Te)*Te_;
+		double Tzeta2_ = Shi*Tzeta1_+lamda*deltaShi*Te_+deltaShi*Te*Tzeta1_+deltaShi*Te_*Tzeta1;
+		double h_ = -e*(Tzeta1_-Tzeta1*2*zq*sDStrain/(Tzeta2*Tzeta2)+Tzeta2_*Tzeta1*2*zq*zq/(Tzeta2*Tzeta2*Tzeta2));
+		double Phi_ = - n*zn1*signum(z)*Psi;
 		f_ = 1.0 - (Phi_*h+Phi*h_)*dStrain;
+	};
 
 
-		// Issue warning if derivative is zero
-		if ( fabs(f_)<1.0e-10 ) {
-			opserr << "WARNING: BWBN::setTrialStrain() -- zero derivative " << endln
-				<< " in Newton-Raphson scheme" << endln;
-		}
-
-		// Take a Newton step
-		Tznew = Tz - f/f_;
-
-
-		// Update the root (but the keep the old for convergence check)
-		Tzold = Tz; 
-		Tz = Tznew;
-
-		// Update counter
-		count++;
-
-
-		// Issue warning if we didn't converge
-		if (count == maxNumIter) {
-
-			opserr << "WARNING: BWBN::setTrialStrain() -- did not" << endln
-				<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln
-				<< " and norm: " << fabs(Tzold-Tznew) << endln;
-		}
-
-		// Compute stress
-		Tstress = alpha*ko*Tstrain + (1-alpha)*ko*Tz;
+	// Newton-Raphson scheme to solve for z_{i+1} := z1
+	double startPoint = 0.01;
+	Tz = startPoint;
+	int res = boucWenNewton(residual, Tz, tolerance, maxNumIter, 1.0e-10);
 
+	// Issue warning if derivative is zero or we didn't converge
+	if (res == -1) {
+		opserr << "WARNING: BWBN::setTrialStrain() -- zero derivative " << endln
+			<< " in Newton-Raphson scheme" << endln;
+	}
+	else if (res == -2) {
+		opserr << "WARNING: BWBN::setTrialStrain() -- did not" << endln
+			<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln;
+	}
 
-		// Compute deterioration parameters
-		Te = Ce + (1-alpha)*ko*dStrain*Tz;
-		Tzeta1 = zetas*(1-exp(-p*Te));
-		Tzeta2 = (Shi+deltaShi*Te)*(lamda+Tzeta1);
+	// Compute stress
+	Tstress = alpha*ko*Tstrain + (1-alpha)*ko*Tz;
+
+
+	// Compute deterioration parameters
+	Te = Ce + (1-alpha)*ko*dStrain*Tz;
+	Tzeta1 = zetas*(1-exp(-p*Te));
+	Tzeta2 = (Shi+deltaShi*Te)*(lamda+Tzeta1);
+	
+
+	// Compute tangent
+	if (Tz != 0.0) {
+		Psi = gamma + beta*signum(dStrain*Tz);
+		boucWenPowers(Tz, n, zn, zn1);
+		Phi = Ao - zn*Psi;
+		double zq = Tz*sDStrain-q*zu;
+		double e = exp(-zq*zq/(Tzeta2*Tzeta2));
+		double b1, b2, b3, b4, b5, b6, b7, b8, b9;
+		b1 = (1-alpha)*ko*Tz;
+		b2 = zetas*p*exp(-p*Te)*b1;
+		b3 = Shi*b2+lamda*deltaShi*b1+deltaShi*Te*b2+deltaShi*b1*Tzeta1;
+		b4 = -e*(b2+b3*Tzeta1*2*zq*zq/(Tzeta2*Tzeta2*Tzeta2)); 
+		h = 1.0-Tzeta1*e;
 		
-
-		// Compute tangent
-		if (Tz != 0.0) {
-			Psi = gamma + beta*signum(dStrain*Tz);
-			Phi = Ao - pow(fabs(Tz),n)*Psi;
-			double b1, b2, b3, b4, b5, b6, b7, b8, b9;
-			b1 = (1-alpha)*ko*Tz;
-			b2 = zetas*p*exp(-p*Te)*b1;
-			b3 = Shi*b2+lamda*deltaShi*b1+deltaShi*Te*b2+deltaShi*b1*Tzeta1;
-			b4 = -exp(-pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2))*(b2+b3*Tzeta1*2*pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2*Tzeta2)); 
-			h = 1.0-Tzeta1*exp(-pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2));
-			
-			b5 = (1.0-alpha)*ko*dStrain;
-			b6 = zetas*p*exp(-p*Te)*b5;
-			b7 = Shi*b6+lamda*deltaShi*b5+deltaShi*Te*b6+deltaShi*b5*Tzeta1;
-			//b8 = -exp(-pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2))*(b6-Tzeta1*2*(Tz*signum(dStrain)-q*zu)/(Tzeta2*Tzeta2)+b7*Tzeta1*2*pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2*Tzeta2));
-			b8 = -exp(-pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2))*(b6-Tzeta1*2*(Tz*signum(dStrain)-q*zu)*signum(dStrain)/(Tzeta2*Tzeta2)+b7*Tzeta1*2*pow((Tz*signum(dStrain)-q*zu),2)/(Tzeta2*Tzeta2*Tzeta2));
-			sign = signum(Tz);
-			pow1 = pow(fabs(Tz),(n-1));
-			b9 = - n*pow1*sign*Psi;
-			double DzDeps = (h*Phi-b4*Phi)/(1.0 - (b9*h+Phi*b8)*dStrain);
-			Ttangent = alpha*ko + (1-alpha)*ko*DzDeps;
-			//Ttangent = Tstress/Tstrain;
-		}
-		else {
-			Ttangent = alpha*ko + (1-alpha)*ko;
-		}
-
+		b5 = (1.0-alpha)*ko*dStrain;
+		b6 = zetas*p*exp(-p*Te)*b5;
+		b7 = Shi*b6+lamda*deltaShi*b5+deltaShi*Te*b6+deltaShi*b5*Tzeta1;
+		b8 = -e*(b6-Tzeta1*2*zq*sDStrain/(Tzeta2*Tzeta2)+b7*Tzeta1*2*zq*zq/(Tzeta2*Tzeta2*Tzeta2));
+		b9 = - n*zn1*signum(Tz)*Psi;
+		double DzDeps = (h*Phi-b4*Phi)/(1.0 - (b9*h+Phi*b8)*dStrain);
+		Ttangent = alpha*ko + (1-alpha)*ko*DzDeps;
+		//Ttangent = Tstress/Tstrain;
+	}
+	else {
+		Ttangent = alpha*ko + (1-alpha)*ko;
 	}
 
     return 0;
@@ -264,6 +241,42 @@ BWBN::revertToLastCommit(void)
     return 0;
 }
 
+// batch operations on an array of BWBN objects, see UniaxialMaterial
+int
+BWBN::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                   double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    BWBN *theMat = static_cast<BWBN *>(theMaterials[i]);
+    res += theMat->BWBN::setTrialStrain(strain[i]);
+    stress[i] = theMat->Tstress;
+    tangent[i] = theMat->Ttangent;
+  }
+
+  return res;
+}
+
+int
+BWBN::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BWBN *>(theMaterials[i])->BWBN::commitState();
+
+  return res;
+}
+
+int
+BWBN::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BWBN *>(theMaterials[i])->BWBN::revertToLastCommit();
+
+  return res;
+}
+
 int 
 BWBN::revertToStart(void)
 {
@@ -38,6 +38,12 @@ class BWBN : public UniaxialMaterial
     double signum(double);
     int commitState(void);
     int revertToLastCommit(void);    
+
+    // batch versions, see UniaxialMaterial
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart(void);        
     UniaxialMaterial *getCopy(void);
     int sendSelf(int commitTag, Channel &theChannel);  
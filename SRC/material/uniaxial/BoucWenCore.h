@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: Integration helpers shared by the Bouc-Wen family of
+// uniaxial materials (BoucWenMaterial, BoucWenOriginal, DegradingPinchedBW,
+// BWBN and BoucWenInfill). Each of them solves the discretized evolution
+// equation of its hysteretic variable z with Newton iterations, with a
+// residual and an analytic derivative of its own.
+
+#ifndef BoucWenCore_h
+#define BoucWenCore_h
+
+#include <math.h>
+
+// x^e as pow(x,e). Integer and half-integer exponents up to 16, the
+// usual values of the Bouc-Wen exponent n, are evaluated by repeated
+// multiplication and at most one sqrt instead of a call to pow()
+inline double
+boucWenPow(double x, double e)
+{
+  double e2 = 2.0*e;
+  if (e2 == floor(e2) && fabs(e2) <= 32.0) {
+    int k = (int)fabs(e2);
+    double p = (k & 1) ? sqrt(x) : 1.0;
+    for (int i = 0; i < k/2; i++)
+      p *= x;
+    return (e < 0.0) ? 1.0/p : p;
+  }
+
+  return pow(x, e);
+}
+
+// |z|^n and |z|^(n-1) with one power evaluation; both are taken as zero
+// at z = 0, as the residual derivatives of the materials expect
+inline void
+boucWenPowers(double z, double n, double &zn, double &zn1)
+{
+  double zAbs = fabs(z);
+  if (zAbs == 0.0) {
+    zn = boucWenPow(0.0, n);
+    zn1 = 0.0;
+    return;
+  }
+
+  zn1 = boucWenPow(zAbs, n-1.0);
+  zn = zn1*zAbs;
+}
+
+// Newton iterations for residual(z, r, drdz) = 0 starting from z. Stops
+// as soon as the correction is at most tol or after maxIter iterations.
+// Returns the number of iterations, -1 if the derivative fell below
+// zeroTol (z is left at the last iterate) and -2 if it did not converge.
+template <class Residual>
+int
+boucWenNewton(Residual &residual, double &z, double tol, int maxIter,
+	      double zeroTol)
+{
+  double r, drdz, dz;
+  int iter = 0;
+
+  do {
+    residual(z, r, drdz);
+    if (fabs(drdz) < zeroTol)
+      return -1;
+
+    dz = r/drdz;
+    z -= dz;
+    iter++;
+  } while (fabs(dz) > tol && iter < maxIter);
+
+  if (fabs(dz) > tol)
+    return -2;
+
+  return iter;
+}
+
+#endif
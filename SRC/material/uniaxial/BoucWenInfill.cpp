@@ -45,6 +45,7 @@
 #include <Matrix.h>
 #include <Information.h>
 #include <Parameter.h>
+#include <BoucWenCore.h>
 
 
 void *
@@ -157,168 +158,143 @@ BoucWenInfill::setTrialStrain (double strain, double strainRate)
 	double dStrain = Tstrain - Cstrain;
 
 	// Initial declarations (make sure not to declare class variables here!)
-	double TDamIndex, Tpk, TA, Tbetak, Tbetaf, TPow, Psi, Phi, Tznew, Tzold, F;
-	double f_z, geps_z, Te_z, TDamIndex_z, Tpk_z, TA_z, Tbetak_z, Tbetaf_z, TPow_z, Phi_z, F_z;
+	double TDamIndex, Tpk, TA, Tbetak, Tbetaf, TPow, Psi, Phi, F;
+	double f_z, geps_z, TDamIndex_z, Tpk_z, TA_z, Tbetak_z, Tbetaf_z, TPow_z, Phi_z, F_z;
 	double geps_x, a_x, Te_x, TDamIndex_x, Tpk_x, TA_x, Tbetak_x, Tbetaf_x, Phi_x, F_x;
 	double geps_z_x, Te_z_x, TDamIndex_z_x, Tpk_z_x, TA_z_x, Tbetak_z_x, Tbetaf_z_x, Phi_z_x, F_z_x;
-	double f, a, geps;
+	double f, geps, TPow1;
 	double numerF_z, denomF_z;
 	double numerF_z_x, denomF_z_x;
 
-	// Newton-Raphson scheme to solve for z_{i+1} = z1
-	int count = 0;
-	double startPoint = 0.01;
-	Tz = startPoint;
-	Tzold = startPoint;
-	Tznew = 1.0;  
-	while ( ( fabs(Tzold-Tznew) > tolerance ) && count < maxNumIter) {
-
- 		// Trial energy and updating xmax
-		Te = Ce + (1.0-alpha)*k/mass*dStrain*Tz;
-		if ((fabs(Tstrain)) >= (fabs(xmax))) {
-			xmax = fabs(Tstrain);
-		}
-		else {
-			xmax = xmaxp;
-		}
+	// Updating xmax and the terms that do not depend on z_n+1
+	if (fabs(Tstrain) >= xmaxp) {
+		xmax = fabs(Tstrain);
+	}
+	else {
+		xmax = xmaxp;
+	}
+	double a = As*fabs(xmax)/xy;
+	double xy2 = xy*xy;
+	double epsp2 = epsp*epsp;
+	double Te_z = (1.0-alpha)*k/mass*dStrain;
+
+	// Root function F and its derivative F_z ( _z = derivative with respect to z_n+1 )
+	auto residual = [&](double z, double &r, double &r_z) {
+ 		// Trial energy
+		Te = Ce + (1.0-alpha)*k/mass*dStrain*z;
 
 		//Evaluate Slip-Lock functions
-		f = exp(-pow(Tz/Zs, 2));
-		a = As*fabs(xmax)/xy;
-		geps = 1.0 - exp((-0.5)*pow(Te/epsp,2));
+		f = exp(-z*z/(Zs*Zs));
+		double eTe = exp((-0.5)*Te*Te/epsp2);
+		geps = 1.0 - eTe;
 
 		// Damage index and degrading functions 
-		TDamIndex = Te*mass/(k*pow(xy,2)) + fabs(xmax)/xy;
+		TDamIndex = Te*mass/(k*xy2) + fabs(xmax)/xy;
 		Tpk = exp(-psi*TDamIndex);
 		TA = exp(-deltak*TDamIndex*Tpk);
 		Tbetak = beta0*TA;
 		Tbetaf = exp(n*deltaf*TDamIndex);
-		Psi = (eta0 + signum(dStrain*Tz));
-		TPow = pow(fabs(Tz),(n));
+		Psi = (eta0 + signum(dStrain*z));
+		boucWenPowers(z, n, TPow, TPow1);
 		Phi = TA - TPow*Tbetak*Tbetaf*Psi;
 
-		// Root function F
-		F = Tz - Cz - dStrain*Phi/(1 + a*f*geps*Phi);
+		double d = 1 + a*f*geps*Phi;
+		F = z - Cz - dStrain*Phi/d;
 
-		// Evaluate function derivative F_z ( _z = derivative with respect to z_n+1 )
-		Te_z = (1.0-alpha)*k/mass*dStrain;
-		f_z = -2*Tz/pow(Zs,2)*f;
-	    geps_z = exp((-0.5)*pow(Te/epsp,2))*Te*Te_z/pow(epsp,2);
-		TDamIndex_z = Te_z*mass/(k*pow(xy,2));
+		f_z = -2*z/(Zs*Zs)*f;
+		geps_z = eTe*Te*Te_z/epsp2;
+		TDamIndex_z = Te_z*mass/(k*xy2);
 		Tpk_z = Tpk*(-psi*TDamIndex_z);
 		TA_z = TA*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z);
 		Tbetak_z = beta0*TA_z;
 		Tbetaf_z = Tbetaf*(n*deltaf*TDamIndex_z);
-		if (Tz == 0.0) {
-			TPow = 0.0;
-			TPow_z = 0.0;
-		}
-		else {
-			TPow = pow(fabs(Tz),(n));
-			TPow_z = n*pow(fabs(Tz),(n-1))*signum(Tz);
-		}
+		TPow_z = n*TPow1*signum(z);
 		Phi_z = TA_z - (TPow_z*Tbetak*Tbetaf + TPow*Tbetak_z*Tbetaf + TPow*Tbetak*Tbetaf_z)*Psi;
-		F_z = 1.0 - dStrain*(Phi_z*(1 + a*f*geps*Phi) - Phi*(a*f_z*geps*Phi + a*f*geps_z*Phi + a*f*geps*Phi_z))/pow(1+a*f*geps*Phi,2);
-		numerF_z = Phi_z - a*f_z*geps*pow(Phi,2) - a*f*geps_z*pow(Phi,2);
-		denomF_z = pow(1 + a*f*geps*Phi,2);
-		
-		// Issue warning if derivative is zero
-		if ( fabs(F_z)<1.0e-10 ) {
-			opserr << "WARNING: BoucWenInfill::setTrialStrain() -- zero derivative " << endln
-				<< " in Newton-Raphson scheme" << endln;
-		}
-
-		// Take a Newton step
-		Tznew = Tz - F/F_z;
-
+		F_z = 1.0 - dStrain*(Phi_z*d - Phi*(a*f_z*geps*Phi + a*f*geps_z*Phi + a*f*geps*Phi_z))/(d*d);
+		numerF_z = Phi_z - a*f_z*geps*Phi*Phi - a*f*geps_z*Phi*Phi;
+		denomF_z = d*d;
 
-		// Update the root (but keep the old for convergence check)
-		Tzold = Tz; 
-		Tz = Tznew;
+		r = F;
+		r_z = F_z;
+	};
 
-		// Update counter
-		count++;
-
-
-		// Issue warning if we didn't converge
-		if (count == maxNumIter) {
+	// Newton-Raphson scheme to solve for z_{i+1} = z1
+	double startPoint = 0.01;
+	Tz = startPoint;
+	int res = boucWenNewton(residual, Tz, tolerance, maxNumIter, 1.0e-10);
 
-			opserr << "WARNING: BoucWenInfill::setTrialStrain() -- did not" << endln
-				<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln
-				<< " and norm: " << fabs(Tzold-Tznew) << endln;
-		}
+	// Issue warning if derivative is zero or we didn't converge
+	if (res == -1) {
+		opserr << "WARNING: BoucWenInfill::setTrialStrain() -- zero derivative " << endln
+			<< " in Newton-Raphson scheme" << endln;
+	}
+	else if (res == -2) {
+		opserr << "WARNING: BoucWenInfill::setTrialStrain() -- did not" << endln
+			<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln;
+	}
 
-		// Compute stress
-		
-		Tstress = alpha*k*Tstrain + (1-alpha)*k*Tz;
+	// Compute stress
+	
+	Tstress = alpha*k*Tstrain + (1-alpha)*k*Tz;
 
 
-		// Compute deterioration parameters
+	// Compute deterioration parameters
 	
-		Te = Ce + (1-alpha)*k/mass*dStrain*Tz;
-		TDamIndex = Te*mass/(k*pow(xy,2)) + fabs(xmax)/xy;
-		Tpk = exp(-psi*TDamIndex);
-		TA = exp(-deltak*TDamIndex*Tpk);
-		Tbetak = beta0*TA;
-		Tbetaf = exp(n*deltaf*TDamIndex);
-		if (Tz == 0.0) {
-			TPow = 0.0;
-			TPow_z = 0.0;
-		}
-		else {
-			TPow = pow(fabs(Tz),(n));
-			TPow_z = n*pow(fabs(Tz),(n-1))*signum(Tz);
-		}
-        Psi = eta0 + signum(dStrain*Tz);
-		Phi =  TA - TPow*Tbetak*Tbetaf*Psi;
-		
-		// Compute tangent ( _x = derivative with respect to x_n+1 )
-		
-		// Compute the derivative of F with respect to x_n+1
-		if (Tz != 0.0) {
-			Te_x = (1-alpha)*k/mass*Tz;
-			if (xmax == Tstrain) {
-				TDamIndex_x = Te_x*mass/(k*pow(xy,2)) + 1/xy;
-				a_x = As/xy;
-			}
-			else {
-				TDamIndex_x = Te_x*mass/(k*pow(xy,2));
-				a_x = 0;
-			}
-			geps_x = exp((-0.5)*pow(Te/epsp,2))*Te*Te_x/pow(epsp,2);
-			Tpk_x = Tpk*(-psi*TDamIndex_x);
-			TA_x = TA*(-deltak*TDamIndex_x*Tpk - deltak*TDamIndex*Tpk_x);
-			Tbetak_x = beta0*TA_x;
-			Tbetaf_x = Tbetaf*(n*deltaf*TDamIndex_x);
-			Phi_x = TA_x - (Tbetak_x*Tbetaf + Tbetak*Tbetaf_x)*TPow*Psi;
-			F_x = - Phi/(1 + a*f*geps*Phi) - dStrain*(Phi_x*(1 + a*f*geps*Phi) - Phi*(a_x*f*geps*Phi + a*f*geps_x*Phi + a*f*geps*Phi_x))/pow(1 + a*f*geps*Phi,2);
-			
-		// Compute the derivative of F_z with respect to x_n+1
-			Te_z_x = (1-alpha)*k/mass;
-			geps_z_x = - geps_x*Te*Te_z/pow(epsp,2) + exp((-0.5)*pow(Te/epsp,2))*Te_x*Te_z/pow(epsp,2) + exp((-0.5)*pow(Te/epsp,2))*Te*Te_z_x/pow(epsp,2);
-			TDamIndex_z_x = Te_z_x*mass/(k*pow(xy,2));
-			Tpk_z_x = Tpk_x*(-psi*TDamIndex_z) + Tpk*(-psi*TDamIndex_z_x);
-			TA_z_x = TA_x*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z) - TA*(deltak*TDamIndex_z_x*Tpk + deltak*TDamIndex_z*Tpk_x + deltak*TDamIndex_x*Tpk_z + deltak*TDamIndex*Tpk_z_x);
-			Tbetak_z_x = beta0*TA_z_x;
-			Tbetaf_z_x = Tbetaf_x*(n*deltaf*TDamIndex_z) + Tbetaf*(n*deltaf*TDamIndex_z_x);
-			Phi_z_x = TA_z_x - (TPow_z*Tbetak*Tbetaf_x + TPow_z*Tbetak_x*Tbetaf + TPow*Tbetaf_z_x*Tbetak + TPow*Tbetaf_z*Tbetak_x + TPow*Tbetaf_x*Tbetak_z + TPow*Tbetaf*Tbetak_z_x)*Psi;
-			numerF_z_x = Phi_z_x - (a_x*f_z*geps*pow(Phi,2) + a*f_z*geps_x*pow(Phi,2) + 2*a*f_z*geps*Phi*Phi_x) - (a_x*f*geps_z*pow(Phi,2) + a*f*geps_z_x*pow(Phi,2) + 2*a*f*geps_z*Phi*Phi_x);
-			denomF_z_x = 2*(1 + a*f*geps*Phi)*(a_x*f*geps*Phi + a*f*geps_x*Phi + a*f*geps*Phi_x);
-			F_z_x = - numerF_z/denomF_z - dStrain*(numerF_z_x*denomF_z - numerF_z*denomF_z_x)/pow(denomF_z,2);
-		
-		// Compute tangent	
-			double DzDx = -(F_x*F_z - F*F_z_x)/(pow(F_z,2));
-			Ttangent = alpha*k + (1-alpha)*k*DzDx;
-			
+	Te = Ce + (1-alpha)*k/mass*dStrain*Tz;
+	TDamIndex = Te*mass/(k*xy2) + fabs(xmax)/xy;
+	Tpk = exp(-psi*TDamIndex);
+	TA = exp(-deltak*TDamIndex*Tpk);
+	Tbetak = beta0*TA;
+	Tbetaf = exp(n*deltaf*TDamIndex);
+	boucWenPowers(Tz, n, TPow, TPow1);
+	TPow_z = n*TPow1*signum(Tz);
+	Psi = eta0 + signum(dStrain*Tz);
+	Phi =  TA - TPow*Tbetak*Tbetaf*Psi;
+	
+	// Compute tangent ( _x = derivative with respect to x_n+1 )
+	
+	// Compute the derivative of F with respect to x_n+1
+	if (Tz != 0.0) {
+		double eTe = exp((-0.5)*Te*Te/epsp2);
+		double d = 1 + a*f*geps*Phi;
+		Te_x = (1-alpha)*k/mass*Tz;
+		if (xmax == Tstrain) {
+			TDamIndex_x = Te_x*mass/(k*xy2) + 1/xy;
+			a_x = As/xy;
 		}
 		else {
-			Ttangent = alpha*k + (1-alpha)*k;
+			TDamIndex_x = Te_x*mass/(k*xy2);
+			a_x = 0;
 		}
+		geps_x = eTe*Te*Te_x/epsp2;
+		Tpk_x = Tpk*(-psi*TDamIndex_x);
+		TA_x = TA*(-deltak*TDamIndex_x*Tpk - deltak*TDamIndex*Tpk_x);
+		Tbetak_x = beta0*TA_x;
+		Tbetaf_x = Tbetaf*(n*deltaf*TDamIndex_x);
+		Phi_x = TA_x - (Tbetak_x*Tbetaf + Tbetak*Tbetaf_x)*TPow*Psi;
+		F_x = - Phi/d - dStrain*(Phi_x*d - Phi*(a_x*f*geps*Phi + a*f*geps_x*Phi + a*f*geps*Phi_x))/(d*d);
 		
+	// Compute the derivative of F_z with respect to x_n+1
+		Te_z_x = (1-alpha)*k/mass;
+		geps_z_x = - geps_x*Te*Te_z/epsp2 + eTe*Te_x*Te_z/epsp2 + eTe*Te*Te_z_x/epsp2;
+		TDamIndex_z_x = Te_z_x*mass/(k*xy2);
+		Tpk_z_x = Tpk_x*(-psi*TDamIndex_z) + Tpk*(-psi*TDamIndex_z_x);
+		TA_z_x = TA_x*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z) - TA*(deltak*TDamIndex_z_x*Tpk + deltak*TDamIndex_z*Tpk_x + deltak*TDamIndex_x*Tpk_z + deltak*TDamIndex*Tpk_z_x);
+		Tbetak_z_x = beta0*TA_z_x;
+		Tbetaf_z_x = Tbetaf_x*(n*deltaf*TDamIndex_z) + Tbetaf*(n*deltaf*TDamIndex_z_x);
+		Phi_z_x = TA_z_x - (TPow_z*Tbetak*Tbetaf_x + TPow_z*Tbetak_x*Tbetaf + TPow*Tbetaf_z_x*Tbetak + TPow*Tbetaf_z*Tbetak_x + TPow*Tbetaf_x*Tbetak_z + TPow*Tbetaf*Tbetak_z_x)*Psi;
+		numerF_z_x = Phi_z_x - (a_x*f_z*geps*Phi*Phi + a*f_z*geps_x*Phi*Phi + 2*a*f_z*geps*Phi*Phi_x) - (a_x*f*geps_z*Phi*Phi + a*f*geps_z_x*Phi*Phi + 2*a*f*geps_z*Phi*Phi_x);
+		denomF_z_x = 2*d*(a_x*f*geps*Phi + a*f*geps_x*Phi + a*f*geps*Phi_x);
+		F_z_x = - numerF_z/denomF_z - dStrain*(numerF_z_x*denomF_z - numerF_z*denomF_z_x)/(denomF_z*denomF_z);
 	
-
+	// Compute tangent	
+		double DzDx = -(F_x*F_z - F*F_z_x)/(F_z*F_z);
+		Ttangent = alpha*k + (1-alpha)*k*DzDx;
+		
+	}
+	else {
+		Ttangent = alpha*k + (1-alpha)*k;
 	}
-	
 	
     return 0;
 }
@@ -367,6 +343,42 @@ BoucWenInfill::revertToLastCommit(void)
     return 0;
 }
 
+// batch operations on an array of BoucWenInfill objects, see UniaxialMaterial
+int
+BoucWenInfill::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                            double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    BoucWenInfill *theMat = static_cast<BoucWenInfill *>(theMaterials[i]);
+    res += theMat->BoucWenInfill::setTrialStrain(strain[i]);
+    stress[i] = theMat->Tstress;
+    tangent[i] = theMat->Ttangent;
+  }
+
+  return res;
+}
+
+int
+BoucWenInfill::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenInfill *>(theMaterials[i])->BoucWenInfill::commitState();
+
+  return res;
+}
+
+int
+BoucWenInfill::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenInfill *>(theMaterials[i])->BoucWenInfill::revertToLastCommit();
+
+  return res;
+}
+
 int 
 BoucWenInfill::revertToStart(void)
 {
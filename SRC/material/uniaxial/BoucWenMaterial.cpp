@@ -40,6 +40,7 @@
 #include <Parameter.h>
 #include <string.h>
 #include <elementAPI.h>
+#include <BoucWenCore.h>
 
 void* OPS_BoucWenMaterial()
 {
@@ -151,105 +152,77 @@ BoucWenMaterial::setTrialStrain (double strain, double strainRate)
 
 
 	// Initial declarations (make sure not to declare class variables here!)
-	double TA, Tnu, Teta, Psi, Phi, f, Te_, TA_, Tnu_;
-	double Teta_, Phi_, f_, Tznew, Tzold, sign;
+	double TA, Tnu, Teta, Psi, Phi, zn, zn1;
 
 
-	// Newton-Raphson scheme to solve for z_{i+1} := z1
-	int count = 0;
-	double startPoint = 0.01;
-	Tz = startPoint;
-	Tzold = startPoint;
-	Tznew = 1.0;  
-	while ( ( fabs(Tzold-Tznew) > tolerance ) && count<maxNumIter) {
+	// Residual f and its derivative f' (underscore:=prime) of the
+	// evolution equation for z_{i+1}
+	double Te_ = (1.0-alpha)*ko*dStrain;
+	double TA_ = -deltaA*Te_;
+	double Tnu_ = deltaNu*Te_;
+	double Teta_ = deltaEta*Te_;
 
-		Te = Ce + (1-alpha)*ko*dStrain*Tz;
+	auto residual = [&](double z, double &f, double &f_) {
+		Te = Ce + (1-alpha)*ko*dStrain*z;
 		TA = Ao - deltaA*Te;
 		Tnu = 1.0 + deltaNu*Te;
 		Teta = 1.0 + deltaEta*Te;
-		sign = signum(dStrain*Tz);
-		Psi = gamma + beta*sign;
-		Phi = TA - pow(fabs(Tz),n)*Psi*Tnu;
-		f = Tz - Cz - Phi/Teta*dStrain;
-
-
-		// Evaluate function derivative f' (underscore:=prime)
-		Te_ = (1.0-alpha)*ko*dStrain;
-		TA_ = -deltaA*Te_;
-		Tnu_ = deltaNu*Te_;
-		Teta_ = deltaEta*Te_;
-		sign = signum(Tz);
-		double pow1;
-		double pow2;
-		if (Tz == 0.0) {
-			pow1 = 0.0;
-			pow2 = 0.0;
-		}
-		else {
-			pow1 = pow(fabs(Tz),(n-1));
-			pow2 = pow(fabs(Tz),n);
-		}
-		Phi_ = TA_ - n*pow1*sign*Psi*Tnu - pow2*Psi*Tnu_;
-		f_ = 1.0 - (Phi_*Teta-Phi*Teta_)/pow(Teta,2.0)*dStrain;
-
-
-		// Issue warning if derivative is zero
-		if ( fabs(f_)<1.0e-10 ) {
-			opserr << "WARNING: BoucWenMaterial::setTrialStrain() -- zero derivative " << endln
-				<< " in Newton-Raphson scheme" << endln;
-		}
-
-		// Take a Newton step
-		Tznew = Tz - f/f_;
-
-
-		// Update the root (but the keep the old for convergence check)
-		Tzold = Tz; 
-		Tz = Tznew;
+		Psi = gamma + beta*signum(dStrain*z);
+		boucWenPowers(z, n, zn, zn1);
+		Phi = TA - zn*Psi*Tnu;
+		f = z - Cz - Phi/Teta*dStrain;
 
-		// Update counter
-		count++;
+		double Phi_ = TA_ - n*zn1*signum(z)*Psi*Tnu - zn*Psi*Tnu_;
+		f_ = 1.0 - (Phi_*Teta-Phi*Teta_)/(Teta*Teta)*dStrain;
+	};
 
 
-		// Issue warning if we didn't converge
-		if (count == maxNumIter) {
+	// Newton-Raphson scheme to solve for z_{i+1} := z1
+	double startPoint = 0.01;
+	Tz = startPoint;
+	int res = boucWenNewton(residual, Tz, tolerance, maxNumIter, 1.0e-10);
 
-			opserr << "WARNING: BoucWenMaterial::setTrialStrain() -- did not" << endln
-				<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln
-				<< " and norm: " << fabs(Tzold-Tznew) << endln;
-		}
+	// Issue warning if derivative is zero or we didn't converge
+	if (res == -1) {
+		opserr << "WARNING: BoucWenMaterial::setTrialStrain() -- zero derivative " << endln
+			<< " in Newton-Raphson scheme" << endln;
+	}
+	else if (res == -2) {
+		opserr << "WARNING: BoucWenMaterial::setTrialStrain() -- did not" << endln
+			<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln;
+	}
 
-		// Compute stress
-		Tstress = alpha*ko*Tstrain + (1-alpha)*ko*Tz;
 
+	// Compute stress
+	Tstress = alpha*ko*Tstrain + (1-alpha)*ko*Tz;
 
-		// Compute deterioration parameters
-		Te = Ce + (1-alpha)*ko*dStrain*Tz;
-		TA = Ao - deltaA*Te;
-		Tnu = 1.0 + deltaNu*Te;
-		Teta = 1.0 + deltaEta*Te;
 
+	// Compute deterioration parameters
+	Te = Ce + (1-alpha)*ko*dStrain*Tz;
+	TA = Ao - deltaA*Te;
+	Tnu = 1.0 + deltaNu*Te;
+	Teta = 1.0 + deltaEta*Te;
 
-		// Compute tangent
-		if (Tz != 0.0) {
-			Psi = gamma + beta*signum(dStrain*Tz);
-			Phi = TA - pow(fabs(Tz),n)*Psi*Tnu;
-			double b1, b2, b3, b4, b5;
-			b1  = (1-alpha)*ko*Tz;
-			b2  = (1-alpha)*ko*dStrain;
-			b3  = dStrain/Teta;
-			b4  = -b3*deltaA*b1 - b3*pow(fabs(Tz),n)*Psi*deltaNu*b1 
-				- Phi/(Teta*Teta)*dStrain*deltaEta*b1 + Phi/Teta;
-			b5  = 1.0 + b3*deltaA*b2 + b3*n*pow(fabs(Tz),(n-1))*signum(Tz)*Psi*Tnu
-				+ b3*pow(fabs(Tz),n)*Psi*deltaNu*b2
-				+ Phi/(Teta*Teta)*dStrain*deltaEta*b2;
-			double DzDeps = b4/b5;
-			Ttangent = alpha*ko + (1-alpha)*ko*DzDeps;
-		}
-		else {
-			Ttangent = alpha*ko + (1-alpha)*ko;
-		}
 
+	// Compute tangent
+	if (Tz != 0.0) {
+		Psi = gamma + beta*signum(dStrain*Tz);
+		boucWenPowers(Tz, n, zn, zn1);
+		Phi = TA - zn*Psi*Tnu;
+		double b1, b2, b3, b4, b5;
+		b1  = (1-alpha)*ko*Tz;
+		b2  = (1-alpha)*ko*dStrain;
+		b3  = dStrain/Teta;
+		b4  = -b3*deltaA*b1 - b3*zn*Psi*deltaNu*b1 
+			- Phi/(Teta*Teta)*dStrain*deltaEta*b1 + Phi/Teta;
+		b5  = 1.0 + b3*deltaA*b2 + b3*n*zn1*signum(Tz)*Psi*Tnu
+			+ b3*zn*Psi*deltaNu*b2
+			+ Phi/(Teta*Teta)*dStrain*deltaEta*b2;
+		double DzDeps = b4/b5;
+		Ttangent = alpha*ko + (1-alpha)*ko*DzDeps;
+	}
+	else {
+		Ttangent = alpha*ko + (1-alpha)*ko;
 	}
 
     return 0;
@@ -298,6 +271,42 @@ BoucWenMaterial::revertToLastCommit(void)
     return 0;
 }
 
+// batch operations on an array of BoucWenMaterial objects, see UniaxialMaterial
+int
+BoucWenMaterial::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                              double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    BoucWenMaterial *theMat = static_cast<BoucWenMaterial *>(theMaterials[i]);
+    res += theMat->BoucWenMaterial::setTrialStrain(strain[i]);
+    stress[i] = theMat->Tstress;
+    tangent[i] = theMat->Ttangent;
+  }
+
+  return res;
+}
+
+int
+BoucWenMaterial::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenMaterial *>(theMaterials[i])->BoucWenMaterial::commitState();
+
+  return res;
+}
+
+int
+BoucWenMaterial::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenMaterial *>(theMaterials[i])->BoucWenMaterial::revertToLastCommit();
+
+  return res;
+}
+
 int 
 BoucWenMaterial::revertToStart(void)
 {
@@ -40,6 +40,8 @@
 #include <string.h>
 #include <elementAPI.h>
 #include <OPS_Globals.h>
+#include <LogCategory.h>
+#include <BoucWenCore.h>
 
 void* OPS_BoucWenOriginal()
 {
@@ -136,49 +138,48 @@ int BoucWenOriginal::setTrialStrain(double strain, double strainRate)
         double epsy = fy / Ei;
 
         // get yield force of hysteretic component
-        double qd = fy - k2*epsy - k3*pow(epsy, mu);
+        double qd = fy - k2*epsy - k3*boucWenPow(epsy, mu);
         
-        // calculate hysteretic evolution parameter z using Newton-Raphson
-        int iter = 0;
-        double zAbs, tmp1, f, Df, delta_z;
-        do {
-            zAbs = fabs(z);
+        // function and analytic derivative of the evolution equation
+        auto residual = [&](double zi, double &f, double &Df) {
+            double zAbs = fabs(zi);
             if (zAbs == 0.0)    // check because of negative exponents
                 zAbs = DBL_EPSILON;
-            tmp1 = gamma + beta*sgn(z*delta_eps);
-            
-            // function and derivative
-            f = z - zC - delta_eps / epsy*(1.0 - pow(zAbs, eta)*tmp1);
-            Df = 1.0 + delta_eps / epsy*eta*pow(zAbs, eta - 1.0)*sgn(z)*tmp1;
-            
-            // issue warning if derivative Df is zero
-            if (fabs(Df) <= DBL_EPSILON) {
-                opserr << "WARNING: BoucWenOriginal::setTrialStrain() - "
-                    << "zero derivative in Newton-Raphson scheme for "
-                    << "hysteretic evolution parameter z.\n";
-                return -1;
-            }
+            double tmp1 = gamma + beta*sgn(zi*delta_eps);
+            double zEta1 = boucWenPow(zAbs, eta - 1.0);
             
-            // advance one step
-            delta_z = f / Df;
-            z -= delta_z;
-            iter++;
-        } while ((fabs(delta_z) >= tol) && (iter < maxIter));
+            f = zi - zC - delta_eps / epsy*(1.0 - zEta1*zAbs*tmp1);
+            Df = 1.0 + delta_eps / epsy*eta*zEta1*sgn(zi)*tmp1;
+        };
         
-        // issue warning if Newton-Raphson scheme did not converge
-        if (iter >= maxIter) {
+        // calculate hysteretic evolution parameter z using Newton-Raphson
+        int iter = boucWenNewton(residual, z, tol, maxIter, DBL_EPSILON);
+        
+        // issue warning if derivative Df is zero
+        if (iter == -1) {
             opserr << "WARNING: BoucWenOriginal::setTrialStrain() - "
+                << "zero derivative in Newton-Raphson scheme for "
+                << "hysteretic evolution parameter z.\n";
+            return -1;
+        }
+        
+        // issue warning if Newton-Raphson scheme did not converge
+        if (iter == -2) {
+            OPS_WARNING("BoucWenOriginal::setTrialStrain", "did not converge")
+                << "WARNING: BoucWenOriginal::setTrialStrain() - "
                 << "did not find the hysteretic evolution parameter z after "
-                << iter << " iterations and norm: " << fabs(delta_z) << endln;
+                << maxIter << " iterations\n";
             return -2;
         }
         
         // get derivative of hysteretic evolution parameter * epsy
-        double dzdeps = 1.0 - pow(fabs(z), eta)*(gamma + beta*sgn(z*delta_eps));
-        // set stress
-        sig = qd*z + k2*eps + k3*sgn(eps)*pow(fabs(eps), mu);
-        // set tangent stiffness
-        Et = k0*dzdeps + k2 + k3*mu*pow(fabs(eps), mu - 1.0);
+        double dzdeps = 1.0 - boucWenPow(fabs(z), eta)*(gamma + beta*sgn(z*delta_eps));
+        // set stress and tangent stiffness
+        double epsAbs = fabs(eps);
+        double epsMu1 = boucWenPow(epsAbs, mu - 1.0);
+        double epsMu = (epsAbs == 0.0) ? boucWenPow(0.0, mu) : epsMu1*epsAbs;
+        sig = qd*z + k2*eps + k3*sgn(eps)*epsMu;
+        Et = k0*dzdeps + k2 + k3*mu*epsMu1;
     }
     
     return 0;
@@ -228,6 +229,42 @@ int BoucWenOriginal::revertToLastCommit()
     return 0;
 }
 
+// batch operations on an array of BoucWenOriginal objects, see UniaxialMaterial
+int
+BoucWenOriginal::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                              double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    BoucWenOriginal *theMat = static_cast<BoucWenOriginal *>(theMaterials[i]);
+    res += theMat->BoucWenOriginal::setTrialStrain(strain[i]);
+    stress[i] = theMat->sig;
+    tangent[i] = theMat->Et;
+  }
+
+  return res;
+}
+
+int
+BoucWenOriginal::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenOriginal *>(theMaterials[i])->BoucWenOriginal::commitState();
+
+  return res;
+}
+
+int
+BoucWenOriginal::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<BoucWenOriginal *>(theMaterials[i])->BoucWenOriginal::revertToLastCommit();
+
+  return res;
+}
+
 
 int BoucWenOriginal::revertToStart()
 {
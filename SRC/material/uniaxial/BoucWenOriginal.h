@@ -69,6 +69,12 @@ public:
     
     int commitState();
     int revertToLastCommit();
+
+    // batch versions, see UniaxialMaterial
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart();
     
     UniaxialMaterial *getCopy();
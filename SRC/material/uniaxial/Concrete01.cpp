@@ -90,26 +90,48 @@ OPS_Concrete01()
 Concrete01::Concrete01
 (int tag, double FPC, double EPSC0, double FPCU, double EPSCU)
   :UniaxialMaterial(tag, MAT_TAG_Concrete01),
-   fpc(FPC), epsc0(EPSC0), fpcu(FPCU), epscu(EPSCU), 
-   CminStrain(0.0), CendStrain(0.0),
-   Cstrain(0.0), Cstress(0.0) 
+   par(new Parameters)
 {
-	EnergyP = 0;	//SAJalali
+  par->fpc = FPC;
+  par->epsc0 = EPSC0;
+  par->fpcu = FPCU;
+  par->epscu = EPSCU;
+
   // Make all concrete parameters negative
-  if (fpc > 0.0)
-    fpc = -fpc;
+  if (par->fpc > 0.0)
+    par->fpc = -par->fpc;
   
-  if (epsc0 > 0.0)
-    epsc0 = -epsc0;
+  if (par->epsc0 > 0.0)
+    par->epsc0 = -par->epsc0;
   
-  if (fpcu > 0.0)
-    fpcu = -fpcu;
+  if (par->fpcu > 0.0)
+    par->fpcu = -par->fpcu;
   
-  if (epscu > 0.0)
-    epscu = -epscu;
+  if (par->epscu > 0.0)
+    par->epscu = -par->epscu;
   
+  this->initialize();
+}
+
+// a copy shares the parameters of the material it is copied from
+Concrete01::Concrete01(int tag, const std::shared_ptr<Parameters> &thePar)
+  :UniaxialMaterial(tag, MAT_TAG_Concrete01),
+   par(thePar)
+{
+  this->initialize();
+}
+
+// sets the material at the start of the envelope
+void Concrete01::initialize()
+{
+  EnergyP = 0;	//SAJalali
+  CminStrain = 0.0;
+  CendStrain = 0.0;
+  Cstrain = 0.0;
+  Cstress = 0.0;
+
   // Initial tangent
-  double Ec0 = 2*fpc/epsc0;
+  double Ec0 = 2*par->fpc/par->epsc0;
   Ctangent = Ec0;
   CunloadSlope = Ec0;
   Ttangent = Ec0;
@@ -124,7 +146,7 @@ Concrete01::Concrete01
 }
 
 Concrete01::Concrete01():UniaxialMaterial(0, MAT_TAG_Concrete01),
- fpc(0.0), epsc0(0.0), fpcu(0.0), epscu(0.0),
+ par(new Parameters()),
  CminStrain(0.0), CunloadSlope(0.0), CendStrain(0.0),
  Cstrain(0.0), Cstress(0.0)
 {
@@ -334,18 +356,18 @@ void Concrete01::reload ()
 
 void Concrete01::envelope ()
 {
-  if (Tstrain > epsc0) {
-    double eta = Tstrain/epsc0;
-    Tstress = fpc*(2*eta-eta*eta);
-    double Ec0 = 2.0*fpc/epsc0;
+  if (Tstrain > par->epsc0) {
+    double eta = Tstrain/par->epsc0;
+    Tstress = par->fpc*(2*eta-eta*eta);
+    double Ec0 = 2.0*par->fpc/par->epsc0;
     Ttangent = Ec0*(1.0-eta);
   }
-  else if (Tstrain > epscu) {
-    Ttangent = (fpc-fpcu)/(epsc0-epscu);
-    Tstress = fpc + Ttangent*(Tstrain-epsc0);
+  else if (Tstrain > par->epscu) {
+    Ttangent = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
+    Tstress = par->fpc + Ttangent*(Tstrain-par->epsc0);
   }
   else {
-    Tstress = fpcu;
+    Tstress = par->fpcu;
     Ttangent = 0.0;
   }
 }
@@ -354,21 +376,21 @@ void Concrete01::unload ()
 {
   double tempStrain = TminStrain;
   
-  if (tempStrain < epscu)
-    tempStrain = epscu;
+  if (tempStrain < par->epscu)
+    tempStrain = par->epscu;
   
-  double eta = tempStrain/epsc0;
+  double eta = tempStrain/par->epsc0;
   
   double ratio = 0.707*(eta-2.0) + 0.834;
   
   if (eta < 2.0)
     ratio = 0.145*eta*eta + 0.13*eta;
   
-  TendStrain = ratio*epsc0;
+  TendStrain = ratio*par->epsc0;
   
   double temp1 = TminStrain - TendStrain;
   
-  double Ec0 = 2.0*fpc/epsc0;
+  double Ec0 = 2.0*par->fpc/par->epsc0;
   
   double temp2 = Tstress/Ec0;
   
@@ -433,9 +455,43 @@ int Concrete01::revertToLastCommit ()
    return 0;
 }
 
+// batch operations on an array of Concrete01 objects, see UniaxialMaterial
+int
+Concrete01::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                          double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Concrete01 *theMat = static_cast<Concrete01 *>(theMaterials[i]);
+    res += theMat->Concrete01::setTrial(strain[i], stress[i], tangent[i]);
+  }
+
+  return res;
+}
+
+int
+Concrete01::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Concrete01 *>(theMaterials[i])->Concrete01::commitState();
+
+  return res;
+}
+
+int
+Concrete01::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Concrete01 *>(theMaterials[i])->Concrete01::revertToLastCommit();
+
+  return res;
+}
+
 int Concrete01::revertToStart ()
 {
-	double Ec0 = 2.0*fpc/epsc0;
+	double Ec0 = 2.0*par->fpc/par->epsc0;
 
    // History variables
    CminStrain = 0.0;
@@ -459,8 +515,7 @@ int Concrete01::revertToStart ()
 
 UniaxialMaterial* Concrete01::getCopy ()
 {
-   Concrete01* theCopy = new Concrete01(this->getTag(),
-                                    fpc, epsc0, fpcu, epscu);
+   Concrete01* theCopy = new Concrete01(this->getTag(), par);
 
    // Converged history variables
    theCopy->CminStrain = CminStrain;
@@ -482,10 +537,10 @@ int Concrete01::sendSelf (int commitTag, Channel& theChannel)
    data(0) = this->getTag();
 
    // Material properties
-   data(1) = fpc;
-   data(2) = epsc0;
-   data(3) = fpcu;
-   data(4) = epscu;
+   data(1) = par->fpc;
+   data(2) = par->epsc0;
+   data(3) = par->fpcu;
+   data(4) = par->epscu;
 
    // History variables from last converged state
    data(5) = CminStrain;
@@ -522,10 +577,11 @@ int Concrete01::recvSelf (int commitTag, Channel& theChannel,
       this->setTag(int(data(0)));
 
       // Material properties 
-      fpc = data(1);
-      epsc0 = data(2);
-      fpcu = data(3);
-      epscu = data(4);
+      this->ownParameters();
+      par->fpc = data(1);
+      par->epsc0 = data(2);
+      par->fpcu = data(3);
+      par->epscu = data(4);
 
       // History variables from last converged state
       CminStrain = data(5);
@@ -550,21 +606,21 @@ void Concrete01::Print (OPS_Stream& s, int flag)
 {
   if (flag == OPS_PRINT_PRINTMODEL_MATERIAL) {      
     s << "Concrete01, tag: " << this->getTag() << endln;
-    s << "  fpc: " << fpc << endln;
-    s << "  epsc0: " << epsc0 << endln;
-    s << "  fpcu: " << fpcu << endln;
-    s << "  epscu: " << epscu << endln;
+    s << "  fpc: " << par->fpc << endln;
+    s << "  epsc0: " << par->epsc0 << endln;
+    s << "  fpcu: " << par->fpcu << endln;
+    s << "  epscu: " << par->epscu << endln;
   }
   
   if (flag == OPS_PRINT_PRINTMODEL_JSON) {
     s << "\t\t\t{";
 	s << "\"name\": \"" << this->getTag() << "\", ";
 	s << "\"type\": \"Concrete01\", ";
-	s << "\"Ec\": " << 2.0*fpc/epsc0 << ", ";
-	s << "\"fc\": " << fpc << ", ";
-    s << "\"epsc\": " << epsc0 << ", ";
-    s << "\"fcu\": " << fpcu << ", ";
-    s << "\"epscu\": " << epscu << "}";
+	s << "\"Ec\": " << 2.0*par->fpc/par->epsc0 << ", ";
+	s << "\"fc\": " << par->fpc << ", ";
+    s << "\"epsc\": " << par->epsc0 << ", ";
+    s << "\"fcu\": " << par->fpcu << ", ";
+    s << "\"epscu\": " << par->epscu << "}";
   }
 }
 
@@ -577,19 +633,19 @@ Concrete01::setParameter(const char **argv, int argc, Parameter &param)
 {
 
   if (strcmp(argv[0],"fc") == 0) {// Compressive strength
-    param.setValue(fpc);
+    param.setValue(par->fpc);
     return param.addObject(1, this);
   }
   else if (strcmp(argv[0],"epsco") == 0) {// Strain at compressive strength
-    param.setValue(epsc0);
+    param.setValue(par->epsc0);
     return param.addObject(2, this);
   }
   else if (strcmp(argv[0],"fcu") == 0) {// Crushing strength
-    param.setValue(fpcu);
+    param.setValue(par->fpcu);
     return param.addObject(3, this);
   }
   else if (strcmp(argv[0],"epscu") == 0) {// Strain at crushing strength
-    param.setValue(epscu);
+    param.setValue(par->epscu);
     return param.addObject(4, this);
   }
   
@@ -601,38 +657,40 @@ Concrete01::setParameter(const char **argv, int argc, Parameter &param)
 int
 Concrete01::updateParameter(int parameterID, Information &info)
 {
+	this->ownParameters();
+
 	switch (parameterID) {
 	case 1:
-		this->fpc = info.theDouble;
+		par->fpc = info.theDouble;
 		break;
 	case 2:
-		this->epsc0 = info.theDouble;
+		par->epsc0 = info.theDouble;
 		break;
 	case 3:
-		this->fpcu = info.theDouble;
+		par->fpcu = info.theDouble;
 		break;
 	case 4:
-		this->epscu = info.theDouble;
+		par->epscu = info.theDouble;
 		break;
 	default:
 		break;
 	}
         
 	// Make all concrete parameters negative
-	if (fpc > 0.0)
-		fpc = -fpc;
+	if (par->fpc > 0.0)
+		par->fpc = -par->fpc;
 
-	if (epsc0 > 0.0)
-		epsc0 = -epsc0;
+	if (par->epsc0 > 0.0)
+		par->epsc0 = -par->epsc0;
 
-	if (fpcu > 0.0)
-		fpcu = -fpcu;
+	if (par->fpcu > 0.0)
+		par->fpcu = -par->fpcu;
 
-	if (epscu > 0.0)
-		epscu = -epscu;
+	if (par->epscu > 0.0)
+		par->epscu = -par->epscu;
 
 	// Initial tangent
-	double Ec0 = 2*fpc/epsc0;
+	double Ec0 = 2*par->fpc/par->epsc0;
 	Ctangent = Ec0;
 	CunloadSlope = Ec0;
 	Ttangent = Ec0;
@@ -704,30 +762,30 @@ Concrete01::getStressSensitivity(int gradIndex, bool conditional)
 
 		if (Tstrain < CminStrain) {			// loading along the backbone curve
 
-			if (Tstrain > epsc0) {			//on the parabola
+			if (Tstrain > par->epsc0) {			//on the parabola
 				
-				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/epsc0-(Tstrain/epsc0)*(Tstrain/epsc0))
-					      + fpc*( (2.0*TstrainSensitivity*epsc0-2.0*Tstrain*epsc0Sensitivity)/(epsc0*epsc0) 
-						  - 2.0*(Tstrain/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)/(epsc0*epsc0));
+				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/par->epsc0-(Tstrain/par->epsc0)*(Tstrain/par->epsc0))
+					      + par->fpc*( (2.0*TstrainSensitivity*par->epsc0-2.0*Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0) 
+						  - 2.0*(Tstrain/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0));
 				
-				dktdh = 2.0*((fpcSensitivity*epsc0-fpc*epsc0Sensitivity)/(epsc0*epsc0))
-					  * (1.0-Tstrain/epsc0)
-					  - 2.0*(fpc/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)
-					  / (epsc0*epsc0);
+				dktdh = 2.0*((fpcSensitivity*par->epsc0-par->fpc*epsc0Sensitivity)/(par->epsc0*par->epsc0))
+					  * (1.0-Tstrain/par->epsc0)
+					  - 2.0*(par->fpc/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)
+					  / (par->epsc0*par->epsc0);
 			}
-			else if (Tstrain > epscu) {		// on the straight inclined line
+			else if (Tstrain > par->epscu) {		// on the straight inclined line
 //cerr << "ON THE STRAIGHT INCLINED LINE" << endl;
 
 				dktdh = ( (fpcSensitivity-fpcuSensitivity)
-					  * (epsc0-epscu) 
-					  - (fpc-fpcu)
+					  * (par->epsc0-par->epscu) 
+					  - (par->fpc-par->fpcu)
 					  * (epsc0Sensitivity-epscuSensitivity) )
-					  / ((epsc0-epscu)*(epsc0-epscu));
+					  / ((par->epsc0-par->epscu)*(par->epsc0-par->epscu));
 
-				double kt = (fpc-fpcu)/(epsc0-epscu);
+				double kt = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
 
 				TstressSensitivity = fpcSensitivity 
-					      + dktdh*(Tstrain-epsc0)
+					      + dktdh*(Tstrain-par->epsc0)
 						  + kt*(TstrainSensitivity-epsc0Sensitivity);
 			}
 			else {							// on the horizontal line
@@ -810,7 +868,7 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 	
 	if (SHVs == 0) {
 		SHVs = new Matrix(5,numGrads);
-		CunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+		CunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 	}
 	else {
 		CminStrainSensitivity   = (*SHVs)(0,gradIndex);
@@ -829,29 +887,29 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 		if (Tstrain < CminStrain) {			// loading along the backbone curve
 
-			if (Tstrain > epsc0) {			//on the parabola
+			if (Tstrain > par->epsc0) {			//on the parabola
 				
-				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/epsc0-(Tstrain/epsc0)*(Tstrain/epsc0))
-					      + fpc*( (2.0*TstrainSensitivity*epsc0-2.0*Tstrain*epsc0Sensitivity)/(epsc0*epsc0) 
-						  - 2.0*(Tstrain/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)/(epsc0*epsc0));
+				TstressSensitivity = fpcSensitivity*(2.0*Tstrain/par->epsc0-(Tstrain/par->epsc0)*(Tstrain/par->epsc0))
+					      + par->fpc*( (2.0*TstrainSensitivity*par->epsc0-2.0*Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0) 
+						  - 2.0*(Tstrain/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)/(par->epsc0*par->epsc0));
 				
-				dktdh = 2.0*((fpcSensitivity*epsc0-fpc*epsc0Sensitivity)/(epsc0*epsc0))
-					  * (1.0-Tstrain/epsc0)
-					  - 2.0*(fpc/epsc0)*(TstrainSensitivity*epsc0-Tstrain*epsc0Sensitivity)
-					  / (epsc0*epsc0);
+				dktdh = 2.0*((fpcSensitivity*par->epsc0-par->fpc*epsc0Sensitivity)/(par->epsc0*par->epsc0))
+					  * (1.0-Tstrain/par->epsc0)
+					  - 2.0*(par->fpc/par->epsc0)*(TstrainSensitivity*par->epsc0-Tstrain*epsc0Sensitivity)
+					  / (par->epsc0*par->epsc0);
 			}
-			else if (Tstrain > epscu) {		// on the straight inclined line
+			else if (Tstrain > par->epscu) {		// on the straight inclined line
 
 				dktdh = ( (fpcSensitivity-fpcuSensitivity)
-					  * (epsc0-epscu) 
-					  - (fpc-fpcu)
+					  * (par->epsc0-par->epscu) 
+					  - (par->fpc-par->fpcu)
 					  * (epsc0Sensitivity-epscuSensitivity) )
-					  / ((epsc0-epscu)*(epsc0-epscu));
+					  / ((par->epsc0-par->epscu)*(par->epsc0-par->epscu));
 
-				double kt = (fpc-fpcu)/(epsc0-epscu);
+				double kt = (par->fpc-par->fpcu)/(par->epsc0-par->epscu);
 
 				TstressSensitivity = fpcSensitivity 
-					      + dktdh*(Tstrain-epsc0)
+					      + dktdh*(Tstrain-par->epsc0)
 						  + kt*(TstrainSensitivity-epsc0Sensitivity);
 			}
 			else {							// on the horizontal line
@@ -912,9 +970,9 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 		TminStrainSensitivity = TstrainSensitivity;
 
-		if (Tstrain < epscu) {
+		if (Tstrain < par->epscu) {
 
-			epsTemp = epscu; 
+			epsTemp = par->epscu; 
 
 			epsTempSensitivity = epscuSensitivity;
 
@@ -926,9 +984,9 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 			epsTempSensitivity = TstrainSensitivity;
 		}
 
-		eta = epsTemp/epsc0;
+		eta = epsTemp/par->epsc0;
 
-		etaSensitivity = (epsTempSensitivity*epsc0-epsTemp*epsc0Sensitivity) / (epsc0*epsc0);
+		etaSensitivity = (epsTempSensitivity*par->epsc0-epsTemp*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 
 		if (eta < 2.0) {
 
@@ -944,19 +1002,19 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 			ratioSensitivity = 0.707 * etaSensitivity;
 		}
 
-		temp1 = Tstrain - ratio * epsc0;
+		temp1 = Tstrain - ratio * par->epsc0;
 
-		temp1Sensitivity = TstrainSensitivity - ratioSensitivity * epsc0
+		temp1Sensitivity = TstrainSensitivity - ratioSensitivity * par->epsc0
 			                                  - ratio * epsc0Sensitivity;
 
-		temp2 = Tstress * epsc0 / (2.0*fpc); 
+		temp2 = Tstress * par->epsc0 / (2.0*par->fpc); 
 		
-		temp2Sensitivity = (2.0*fpc*(TstressSensitivity*epsc0+Tstress*epsc0Sensitivity)
-			-2.0*Tstress*epsc0*fpcSensitivity) / (4.0*fpc*fpc);
+		temp2Sensitivity = (2.0*par->fpc*(TstressSensitivity*par->epsc0+Tstress*epsc0Sensitivity)
+			-2.0*Tstress*par->epsc0*fpcSensitivity) / (4.0*par->fpc*par->fpc);
 
 		if (temp1 == 0.0) {
 
-			TunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+			TunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 		}
 		else if (temp1 < temp2) {
 
@@ -969,7 +1027,7 @@ Concrete01::commitSensitivity(double TstrainSensitivity, int gradIndex, int numG
 
 			TendStrainSensitivity = TstrainSensitivity - temp2Sensitivity;
 
-			TunloadSlopeSensitivity = (2.0*fpcSensitivity*epsc0-2.0*fpc*epsc0Sensitivity) / (epsc0*epsc0);
+			TunloadSlopeSensitivity = (2.0*fpcSensitivity*par->epsc0-2.0*par->fpc*epsc0Sensitivity) / (par->epsc0*par->epsc0);
 		}
 	}
 	else {
@@ -1099,8 +1157,16 @@ int
 Concrete01::getVariable(const char *varName, Information &theInfo)
 {
   if (strcmp(varName,"ec") == 0) {
-    theInfo.theDouble = epsc0;
+    theInfo.theDouble = par->epsc0;
     return 0;
   } else
     return -1;
 }
+
+// gives this material its own copy of the parameters before they are
+// changed, if they are shared with other copies
+void Concrete01::ownParameters()
+{
+  if (par.use_count() > 1)
+    par = std::make_shared<Parameters>(*par);
+}
@@ -40,6 +40,7 @@
 
 
 #include <UniaxialMaterial.h>
+#include <memory>
 
 class Concrete01 : public UniaxialMaterial
 {
@@ -55,10 +56,14 @@ class Concrete01 : public UniaxialMaterial
   double getStrain(void);      
   double getStress(void);
   double getTangent(void);
-  double getInitialTangent(void) {return 2.0*fpc/epsc0;}
+  double getInitialTangent(void) {return 2.0*par->fpc/par->epsc0;}
 
   int commitState(void);
   int revertToLastCommit(void);    
+  int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                    double *stress, double *tangent);
+  int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+  int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
   int revertToStart(void);        
   
   UniaxialMaterial *getCopy(void);
@@ -84,11 +89,18 @@ class Concrete01 : public UniaxialMaterial
  protected:
 
  private:
-  /*** Material Properties ***/
-  double fpc;    // Compressive strength
-  double epsc0;  // Strain at compressive strength
-  double fpcu;   // Crushing strength
-  double epscu;  // Strain at crushing strength
+  /*** Material Properties, shared by the copies of a material ***/
+  /*** until one of them has a parameter updated ***/
+  struct Parameters {
+    double fpc;    // Compressive strength
+    double epsc0;  // Strain at compressive strength
+    double fpcu;   // Crushing strength
+    double epscu;  // Strain at crushing strength
+  };
+  std::shared_ptr<Parameters> par;
+  Concrete01 (int tag, const std::shared_ptr<Parameters> &par);
+  void initialize();
+  void ownParameters();
   
   /*** CONVERGED History Variables ***/
   double CminStrain;   // Smallest previous concrete strain (compression)
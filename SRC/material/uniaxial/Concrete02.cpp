@@ -58,6 +58,7 @@ OPS_Concrete02()
   int    iData[1];
   double dData[7];
   int numData = 1;
+  bool implex = false;
 
   if (OPS_GetIntInput(&numData, iData) != 0) {
     opserr << "WARNING invalid uniaxialMaterial Concrete02 tag" << endln;
@@ -65,23 +66,34 @@ OPS_Concrete02()
   }
 
   numData = OPS_GetNumRemainingInputArgs();
+  if (numData == 5 || numData == 8)
+    numData--;
 
   if (numData != 4 && numData != 7) {
-    opserr << "Invalid #args, want: uniaxialMaterial Concrete02 " << iData[0] << " fpc? epsc0? fpcu? epscu? <rat? ft? Ets?>\n";
+    opserr << "Invalid #args, want: uniaxialMaterial Concrete02 " << iData[0] << " fpc? epsc0? fpcu? epscu? <rat? ft? Ets?> <-implex>\n";
     return 0;
   }
 
   if (OPS_GetDoubleInput(&numData, dData) != 0) {
-    opserr << "Invalid #args, want: uniaxialMaterial Concrete02 " << iData[0] << " fpc? epsc0? fpcu? epscu? <rat? ft? Ets?>\n";
+    opserr << "Invalid #args, want: uniaxialMaterial Concrete02 " << iData[0] << " fpc? epsc0? fpcu? epscu? <rat? ft? Ets?> <-implex>\n";
     return 0;
   }
 
+  if (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-implex") == 0)
+      implex = true;
+    else {
+      opserr << "WARNING uniaxialMaterial Concrete02 " << iData[0] << " unknown option " << opt << endln;
+      return 0;
+    }
+  }
 
   // Parsing was successful, allocate the material
   if (numData == 7)
-    theMaterial = new Concrete02(iData[0], dData[0], dData[1], dData[2], dData[3], dData[4], dData[5], dData[6]);
+    theMaterial = new Concrete02(iData[0], dData[0], dData[1], dData[2], dData[3], dData[4], dData[5], dData[6], implex);
   else
-    theMaterial = new Concrete02(iData[0], dData[0], dData[1], dData[2], dData[3]);
+    theMaterial = new Concrete02(iData[0], dData[0], dData[1], dData[2], dData[3], implex);
   
   if (theMaterial == 0) {
     opserr << "WARNING could not create uniaxialMaterial of type Concrete02 Material\n";
@@ -92,59 +104,84 @@ OPS_Concrete02()
 }
 
 Concrete02::Concrete02(int tag, double _fc, double _epsc0, double _fcu,
-		       double _epscu, double _rat, double _ft, double _Ets):
+		       double _epscu, double _rat, double _ft, double _Ets,
+		       bool implex):
   UniaxialMaterial(tag, MAT_TAG_Concrete02),
-  fc(_fc), epsc0(_epsc0), fcu(_fcu), epscu(_epscu), rat(_rat), ft(_ft), Ets(_Ets)
+  par(new Parameters)
 {
+  par->fc = _fc; par->epsc0 = _epsc0; par->fcu = _fcu; par->epscu = _epscu;
+  par->rat = _rat; par->ft = _ft; par->Ets = _Ets;
+  par->implex = implex;
+
   ecminP = 0.0;
   deptP = 0.0;
 
-  if (fc > 0) fc = -fc;
-  if (epsc0 > 0) epsc0 = -epsc0;
-  if (fcu > 0) fcu = -fcu;
-  if (epscu > 0) epscu = -epscu;
+  if (par->fc > 0) par->fc = -par->fc;
+  if (par->epsc0 > 0) par->epsc0 = -par->epsc0;
+  if (par->fcu > 0) par->fcu = -par->fcu;
+  if (par->epscu > 0) par->epscu = -par->epscu;
 
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
 }
 
 Concrete02::Concrete02(int tag, double _fc, double _epsc0, double _fcu,
-		       double _epscu):
+		       double _epscu, bool implex):
   UniaxialMaterial(tag, MAT_TAG_Concrete02),
-  fc(_fc), epsc0(_epsc0), fcu(_fcu), epscu(_epscu)
+  par(new Parameters)
 {
+  par->fc = _fc; par->epsc0 = _epsc0; par->fcu = _fcu; par->epscu = _epscu;
+  par->implex = implex;
+
   ecminP = 0.0;
   deptP = 0.0;
 
-  if (fc > 0) fc = -fc;
-  if (epsc0 > 0) epsc0 = -epsc0;
-  if (fcu > 0) fcu = -fcu;
-  if (epscu > 0) epscu = -epscu;
+  if (par->fc > 0) par->fc = -par->fc;
+  if (par->epsc0 > 0) par->epsc0 = -par->epsc0;
+  if (par->fcu > 0) par->fcu = -par->fcu;
+  if (par->epscu > 0) par->epscu = -par->epscu;
 	  
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
 
-  rat = 0.1;
-  ft = 0.1*fc;
-  if (ft < 0.0)
-    ft = -ft;
-  Ets = 0.1*fc/epsc0;
+  par->rat = 0.1;
+  par->ft = 0.1*par->fc;
+  if (par->ft < 0.0)
+    par->ft = -par->ft;
+  par->Ets = 0.1*par->fc/par->epsc0;
 }
 
 Concrete02::Concrete02(void):
-  UniaxialMaterial(0, MAT_TAG_Concrete02)
+  UniaxialMaterial(0, MAT_TAG_Concrete02),
+  par(new Parameters())
 {
  
 }
 
+// a copy shares the parameters of the material it is copied from
+Concrete02::Concrete02(int tag, const std::shared_ptr<Parameters> &thePar):
+  UniaxialMaterial(tag, MAT_TAG_Concrete02),
+  par(thePar)
+{
+  ecminP = 0.0;
+  deptP = 0.0;
+
+  eP = 2.0*par->fc/par->epsc0;
+  epsP = 0.0;
+  sigP = 0.0;
+  eps = 0.0;
+  sig = 0.0;
+  e = 2.0*par->fc/par->epsc0;
+}
+
 Concrete02::~Concrete02(void)
 {
   // Does nothing
@@ -153,7 +190,7 @@ Concrete02::~Concrete02(void)
 UniaxialMaterial*
 Concrete02::getCopy(void)
 {
-  Concrete02 *theCopy = new Concrete02(this->getTag(), fc, epsc0, fcu, epscu, rat, ft, Ets);
+  Concrete02 *theCopy = new Concrete02(this->getTag(), par);
   
   return theCopy;
 }
@@ -161,18 +198,39 @@ Concrete02::getCopy(void)
 double
 Concrete02::getInitialTangent(void)
 {
-  return 2.0*fc/epsc0;
+  return 2.0*par->fc/par->epsc0;
 }
 
 int
 Concrete02::setTrialStrain(double trialStrain, double strainRate)
 {
-  double  ec0 = fc * 2. / epsc0;
+  if (par->implex == false)
+    return this->implicitTrial(trialStrain);
+
+  // IMPL-EX: linear elastic about the extrapolated inelastic strain
+  double ec0 = par->fc * 2. / par->epsc0;
+
+  dt = ops_Dt;
+  double epsIn = implexExtrapolate(epsInP, epsInPP, dt, dtP);
+
+  eps = trialStrain;
+  sig = ec0 * (eps - epsIn);
+  e = ec0;
+  TEnergy = CEnergy + 0.5 * (sigP + sig) * (eps - epsP);
+
+  return 0;
+}
+
+int
+Concrete02::implicitTrial(double trialStrain)
+{
+  double  ec0 = par->fc * 2. / par->epsc0;
 
   // retrieve concrete history variables
 
   ecmin = ecminP;
   dept = deptP;
+  historyReverted = false;
   TEnergy = CEnergy;
 
   // calculate current strain
@@ -200,7 +258,7 @@ Concrete02::setTrialStrain(double trialStrain, double strainRate)
     // (corresponding equations are 2.31 and 2.32 
     // the strain of point R is epsR and the stress is sigmR 
     
-    double epsr = (fcu - rat * ec0 * epscu) / (ec0 * (1.0 - rat));
+    double epsr = (par->fcu - par->rat * ec0 * par->epscu) / (ec0 * (1.0 - par->rat));
     double sigmr = ec0 * epsr;
     
     // calculate the previous minimum stress sigmm from the minimum 
@@ -292,8 +350,21 @@ Concrete02::getTangent(void)
 int 
 Concrete02::commitState(void)
 {
-  ecminP = ecmin;
-  deptP = dept;
+  // IMPL-EX: the history variables come from the implicit solution
+  // at the converged strain
+  if (par->implex) {
+    sig = sigP;
+    e = eP;
+    this->implicitTrial(eps);
+    epsInPP = epsInP;
+    epsInP = eps - sig / (par->fc * 2. / par->epsc0);
+    dtP = dt;
+  }
+
+  if (historyReverted == false) {
+    ecminP = ecmin;
+    deptP = dept;
+  }
   
   eP = e;
   sigP = sig;
@@ -307,8 +378,8 @@ Concrete02::commitState(void)
 int 
 Concrete02::revertToLastCommit(void)
 {
-  ecmin = ecminP;;
-  dept = deptP;
+  // ecmin and dept are set from the committed values by the next trial
+  historyReverted = true;
   
   e = eP;
   sig = sigP;
@@ -319,41 +390,86 @@ Concrete02::revertToLastCommit(void)
   return 0;
 }
 
+// batch operations on an array of Concrete02 objects, see UniaxialMaterial
+int
+Concrete02::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                          double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Concrete02 *theMat = static_cast<Concrete02 *>(theMaterials[i]);
+    res += theMat->Concrete02::setTrialStrain(strain[i]);
+    stress[i] = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
+int
+Concrete02::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Concrete02 *>(theMaterials[i])->Concrete02::commitState();
+
+  return res;
+}
+
+int
+Concrete02::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Concrete02 *>(theMaterials[i])->Concrete02::revertToLastCommit();
+
+  return res;
+}
+
 int 
 Concrete02::revertToStart(void)
 {
   ecminP = 0.0;
   deptP = 0.0;
 
-  eP = 2.0*fc/epsc0;
+  eP = 2.0*par->fc/par->epsc0;
   epsP = 0.0;
   sigP = 0.0;
   eps = 0.0;
   sig = 0.0;
-  e = 2.0*fc/epsc0;
+  e = 2.0*par->fc/par->epsc0;
 
   TEnergy = CEnergy = 0.0;
 
+  epsInP = epsInPP = 0.0;
+  dtP = dt = 0.0;
+
+  historyReverted = true;
+
   return 0;
 }
 
 int 
 Concrete02::sendSelf(int commitTag, Channel &theChannel)
 {
-  static Vector data(13);
-  data(0) =fc;    
-  data(1) =epsc0; 
-  data(2) =fcu;   
-  data(3) =epscu; 
-  data(4) =rat;   
-  data(5) =ft;    
-  data(6) =Ets;   
+  static Vector data(17);
+  data(0) =par->fc;    
+  data(1) =par->epsc0; 
+  data(2) =par->fcu;   
+  data(3) =par->epscu; 
+  data(4) =par->rat;   
+  data(5) =par->ft;    
+  data(6) =par->Ets;   
   data(7) =ecminP;
   data(8) =deptP; 
   data(9) =epsP;  
   data(10) =sigP; 
   data(11) =eP;   
   data(12) = this->getTag();
+  data(13) = par->implex ? 1.0 : 0.0;
+  data(14) = epsInP;
+  data(15) = epsInPP;
+  data(16) = dtP;
 
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "Concrete02::sendSelf() - failed to sendSelf\n";
@@ -367,30 +483,39 @@ Concrete02::recvSelf(int commitTag, Channel &theChannel,
 	     FEM_ObjectBroker &theBroker)
 {
 
-  static Vector data(13);
+  static Vector data(17);
 
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "Concrete02::recvSelf() - failed to recvSelf\n";
     return -1;
   }
 
-  fc = data(0);
-  epsc0 = data(1);
-  fcu = data(2);
-  epscu = data(3);
-  rat = data(4);
-  ft = data(5);
-  Ets = data(6);
+  // the received parameters are not shared with other copies
+  if (par.use_count() > 1)
+    par = std::make_shared<Parameters>(*par);
+
+  par->fc = data(0);
+  par->epsc0 = data(1);
+  par->fcu = data(2);
+  par->epscu = data(3);
+  par->rat = data(4);
+  par->ft = data(5);
+  par->Ets = data(6);
   ecminP = data(7);
   deptP = data(8);
   epsP = data(9);
   sigP = data(10);
   eP = data(11);
   this->setTag(data(12));
+  par->implex = (data(13) != 0.0);
+  epsInP = data(14);
+  epsInPP = data(15);
+  dtP = data(16);
 
   e = eP;
   sig = sigP;
   eps = epsP;
+  historyReverted = true;
   
   return 0;
 }
@@ -406,14 +531,14 @@ Concrete02::Print(OPS_Stream &s, int flag)
     s << "\t\t\t{";
 	s << "\"name\": \"" << this->getTag() << "\", ";
 	s << "\"type\": \"Concrete02\", ";
-	s << "\"Ec\": " << 2.0*fc/epsc0 << ", ";
-	s << "\"fc\": " << fc << ", ";
-    s << "\"epsc\": " << epsc0 << ", ";
-    s << "\"fcu\": " << fcu << ", ";
-    s << "\"epscu\": " << epscu << ", ";
-    s << "\"ratio\": " << rat << ", ";
-    s << "\"ft\": " << ft << ", ";
-    s << "\"Ets\": " << Ets << "}";
+	s << "\"Ec\": " << 2.0*par->fc/par->epsc0 << ", ";
+	s << "\"fc\": " << par->fc << ", ";
+    s << "\"epsc\": " << par->epsc0 << ", ";
+    s << "\"fcu\": " << par->fcu << ", ";
+    s << "\"epscu\": " << par->epscu << ", ";
+    s << "\"ratio\": " << par->rat << ", ";
+    s << "\"ft\": " << par->ft << ", ";
+    s << "\"Ets\": " << par->Ets << "}";
   }
 }
 
@@ -434,17 +559,17 @@ Concrete02::Tens_Envlp (double epsc, double &sigc, double &Ect)
 !    Ect  = tangent concrete modulus
 !-----------------------------------------------------------------------*/
   
-  double Ec0  = 2.0*fc/epsc0;
+  double Ec0  = 2.0*par->fc/par->epsc0;
 
-  double eps0 = ft/Ec0;
-  double epsu = ft*(1.0/Ets+1.0/Ec0);
+  double eps0 = par->ft/Ec0;
+  double epsu = par->ft*(1.0/par->Ets+1.0/Ec0);
   if (epsc<=eps0) {
     sigc = epsc*Ec0;
     Ect  = Ec0;
   } else {
     if (epsc<=epsu) {
-      Ect  = -Ets;
-      sigc = ft-Ets*(epsc-eps0);
+      Ect  = -par->Ets;
+      sigc = par->ft-par->Ets*(epsc-eps0);
     } else {
       //      Ect  = 0.0
       Ect  = 1.0e-10;
@@ -473,23 +598,23 @@ Concrete02::Compr_Envlp (double epsc, double &sigc, double &Ect)
 !   Ect   = tangent concrete modulus
 -----------------------------------------------------------------------*/
 
-  double Ec0  = 2.0*fc/epsc0;
+  double Ec0  = 2.0*par->fc/par->epsc0;
 
-  double ratLocal = epsc/epsc0;
-  if (epsc>=epsc0) {
-    sigc = fc*ratLocal*(2.0-ratLocal);
+  double ratLocal = epsc/par->epsc0;
+  if (epsc>=par->epsc0) {
+    sigc = par->fc*ratLocal*(2.0-ratLocal);
     Ect  = Ec0*(1.0-ratLocal);
   } else {
     
     //   linear descending branch between epsc0 and epscu
-    if (epsc>epscu) {
-      sigc = (fcu-fc)*(epsc-epsc0)/(epscu-epsc0)+fc;
-      Ect  = (fcu-fc)/(epscu-epsc0);
+    if (epsc>par->epscu) {
+      sigc = (par->fcu-par->fc)*(epsc-par->epsc0)/(par->epscu-par->epsc0)+par->fc;
+      Ect  = (par->fcu-par->fc)/(par->epscu-par->epsc0);
     } else {
 	   
       // flat friction branch for strains larger than epscu
       
-      sigc = fcu;
+      sigc = par->fcu;
       Ect  = 1.0e-10;
       //       Ect  = 0.0
     }
@@ -501,7 +626,7 @@ int
 Concrete02::getVariable(const char *varName, Information &theInfo)
 {
   if (strcmp(varName,"ec") == 0) {
-    theInfo.theDouble = epsc0;
+    theInfo.theDouble = par->epsc0;
     return 0;
   } else
     return -1;
@@ -41,14 +41,16 @@
 #define Concrete02_h
 
 #include <UniaxialMaterial.h>
+#include <memory>
 
 class Concrete02 : public UniaxialMaterial
 {
   public:
     Concrete02(int tag, double _fc, double _epsc0, double _fcu,
-	     double _epscu, double _rat, double _ft, double _Ets);
+	     double _epscu, double _rat, double _ft, double _Ets,
+	     bool implex = false);
     Concrete02(int tag, double _fc, double _epsc0, double _fcu,
-	     double _epscu);
+	     double _epscu, bool implex = false);
 
     Concrete02(void);
 
@@ -65,6 +67,10 @@ class Concrete02 : public UniaxialMaterial
     
     int commitState(void);
     int revertToLastCommit(void);    
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart(void);        
     
     int sendSelf(int commitTag, Channel &theChannel);  
@@ -82,15 +88,21 @@ class Concrete02 : public UniaxialMaterial
  private:
     void Tens_Envlp (double epsc, double &sigc, double &Ect);
     void Compr_Envlp (double epsc, double &sigc, double &Ect);
-
-    // matpar : Concrete FIXED PROPERTIES
-    double fc;    // concrete compression strength           : mp(1)
-    double epsc0; // strain at compression strength          : mp(2)
-    double fcu;   // stress at ultimate (crushing) strain    : mp(3)
-    double epscu; // ultimate (crushing) strain              : mp(4)       
-    double rat;   // ratio between unloading slope at epscu and original slope : mp(5)
-    double ft;    // concrete tensile strength               : mp(6)
-    double Ets;   // tension stiffening slope                : mp(7)
+    int implicitTrial(double trialStrain);
+
+    // matpar : Concrete FIXED PROPERTIES, shared by the copies of a material
+    struct Parameters {
+      double fc;    // concrete compression strength           : mp(1)
+      double epsc0; // strain at compression strength          : mp(2)
+      double fcu;   // stress at ultimate (crushing) strain    : mp(3)
+      double epscu; // ultimate (crushing) strain              : mp(4)       
+      double rat;   // ratio between unloading slope at epscu and original slope : mp(5)
+      double ft;    // concrete tensile strength               : mp(6)
+      double Ets;   // tension stiffening slope                : mp(7)
+      bool implex;  // IMPL-EX integration, see Material
+    };
+    std::shared_ptr<Parameters> par;
+    Concrete02(int tag, const std::shared_ptr<Parameters> &par);
 
     // hstvP : Concerete HISTORY VARIABLES last committed step
     double ecminP;  //  hstP(1)
@@ -102,12 +114,20 @@ class Concrete02 : public UniaxialMaterial
     // hstv : Concerete HISTORY VARIABLES  current step
     double ecmin;  
     double dept;   
+    bool historyReverted = true;  // ecmin and dept are stale, see Steel02
     double sig;   
     double e;     
     double eps;   
 
     double TEnergy = 0.0;
     double CEnergy = 0.0;
+
+    // IMPL-EX: the inelastic strain eps - sig/Ec0 at the last two
+    // committed steps & the time steps they were reached with
+    double epsInP = 0.0;
+    double epsInPP = 0.0;
+    double dtP = 0.0;
+    double dt = 0.0;
 };
 
 
@@ -7,6 +7,7 @@
 #include <Matrix.h>
 #include <Information.h>
 #include <Parameter.h>
+#include <BoucWenCore.h>
 
 
 void *
@@ -112,153 +113,124 @@ DegradingPinchedBW::setTrialStrain (double strain, double strainRate)
 
 
 	// Initial declarations (make sure not to declare class variables here!)
-	double TDamIndex, Tpk, TA, Tbetak, Tbetaf, TPow, Psi, Phi, f, Tznew, Tzold;
-	double Te_z, TDamIndex_z, Tpk_z, TA_z, Tbetak_z, Tbetaf_z, TPow_z, Phi_z, f_z;
+	double TDamIndex, Tpk, TA, Tbetak, Tbetaf, TPow, Psi, Phi, f;
+	double TDamIndex_z, Tpk_z, TA_z, Tbetak_z, Tbetaf_z, TPow_z, Phi_z, f_z;
 	double Te_x, TDamIndex_x, Tpk_x, TA_x, Tbetak_x, Tbetaf_x, Phi_x, f_x;
 	double Te_z_x, TDamIndex_z_x, Tpk_z_x, TA_z_x, Tbetak_z_x, Tbetaf_z_x, Phi_z_x, f_z_x;
-	double gp, feps, kp;
+	double TPow1;
 
 
-	// Newton-Raphson scheme to solve for z_{i+1} = z1
-	int count = 0;
-	double startPoint = 0.01;
-	Tz = startPoint;
-	Tzold = startPoint;
-	Tznew = 1.0;  
-	while ( ( fabs(Tzold-Tznew) > tolerance ) && count < maxNumIter) {
-
-  
-		//Evaluate function f
-		gp = exp((-0.5)*pow(Cstrain/sigma, u));
-		feps = 1.0 - exp((-0.5)*pow(Ce/epsp, 8));
-		kp = ko*(1.0 - feps*gp*rhop);
-		Te = Ce + (1.0-alpha)*kp/m*dStrain*Tz;
-		if ((fabs(Tstrain)) >= (fabs(xmax))) {
-			xmax = fabs(Tstrain);
-		}
-		else {
-			xmax = xmaxp;
-		}
+	// The pinching stiffness and the maximum displacement do not depend
+	// on z_n+1, so they are evaluated once for the Newton-Raphson scheme
+	double gp = exp((-0.5)*boucWenPow(Cstrain/sigma, u));
+	double feps = 1.0 - exp((-0.5)*boucWenPow(Ce/epsp, 8));
+	double kp = ko*(1.0 - feps*gp*rhop);
+	if (fabs(Tstrain) >= xmaxp) {
+		xmax = fabs(Tstrain);
+	}
+	else {
+		xmax = xmaxp;
+	}
+	double Te_z = (1.0-alpha)*kp*dStrain/m;
+
+
+	// Function f and its derivative f_z ( _z = derivative with respect to z_n+1 )
+	auto residual = [&](double z, double &r, double &r_z) {
+		Te = Ce + (1.0-alpha)*kp/m*dStrain*z;
 		TDamIndex = rhoeps*Te*m/(Fy*xu) + rhox*fabs(xmax)/xu;
 		Tpk = exp(-phi*TDamIndex);
 		TA = exp(-deltak*TDamIndex*Tpk);
 		Tbetak = beta*TA;
 		Tbetaf = exp(n*deltaf*TDamIndex);
-		Psi = (eta + signum(dStrain*Tz));
-		TPow = pow(fabs(Tz),(n));
+		Psi = (eta + signum(dStrain*z));
+		boucWenPowers(z, n, TPow, TPow1);
 		Phi = TA - TPow*Tbetak*Tbetaf*Psi;
-		f = Tz - Cz - Phi*dStrain;
+		f = z - Cz - Phi*dStrain;
 
-		// Evaluate function derivative f_z ( _z = derivative with respect to z_n+1 )
-		Te_z = (1.0-alpha)*kp*dStrain/m;
 		TDamIndex_z = rhoeps*Te_z*m/(Fy*xu);
 		Tpk_z = Tpk*(-phi*TDamIndex_z);
 		TA_z = TA*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z);
 		Tbetak_z = beta*TA_z;
 		Tbetaf_z = Tbetaf*(n*deltaf*TDamIndex_z);
-		if (Tz == 0.0) {
-			TPow = 0.0;
-			TPow_z = 0.0;
-		}
-		else {
-			TPow = pow(fabs(Tz),(n));
-			TPow_z = n*pow(fabs(Tz),(n-1))*signum(Tz);
-		}
+		TPow_z = n*TPow1*signum(z);
 		Phi_z = TA_z - (TPow_z*Tbetak*Tbetaf + TPow*Tbetak_z*Tbetaf + TPow*Tbetak*Tbetaf_z)*Psi;
 		f_z = 1.0 - Phi_z*dStrain;
-		
-		
-		// Issue warning if derivative is zero
-		if ( fabs(f_z)<1.0e-10 ) {
-			opserr << "WARNING: DegradingPinchedBW::setTrialStrain() -- zero derivative " << endln
-				<< " in Newton-Raphson scheme" << endln;
-		}
 
-		// Take a Newton step
-		Tznew = Tz - f/f_z;
+		r = f;
+		r_z = f_z;
+	};
 
 
-		// Update the root (but the keep the old for convergence check)
-		Tzold = Tz; 
-		Tz = Tznew;
-
-		// Update counter
-		count++;
-
-
-		// Issue warning if we didn't converge
-		if (count == maxNumIter) {
+	// Newton-Raphson scheme to solve for z_{i+1} = z1
+	double startPoint = 0.01;
+	Tz = startPoint;
+	int res = boucWenNewton(residual, Tz, tolerance, maxNumIter, 1.0e-10);
 
-			opserr << "WARNING: DegradingPinchedBW::setTrialStrain() -- did not" << endln
-				<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln
-				<< " and norm: " << fabs(Tzold-Tznew) << endln;
-		}
+	// Issue warning if derivative is zero or we didn't converge
+	if (res == -1) {
+		opserr << "WARNING: DegradingPinchedBW::setTrialStrain() -- zero derivative " << endln
+			<< " in Newton-Raphson scheme" << endln;
+	}
+	else if (res == -2) {
+		opserr << "WARNING: DegradingPinchedBW::setTrialStrain() -- did not" << endln
+			<< " find the root z_{i+1}, after " << maxNumIter << " iterations" << endln;
+	}
 
-		// Compute stress
-		
-		Tstress = alpha*kp*Tstrain + (1-alpha)*kp*Tz;
+	// Compute stress
+	
+	Tstress = alpha*kp*Tstrain + (1-alpha)*kp*Tz;
 
 
-		// Compute deterioration parameters
+	// Compute deterioration parameters
 	
-		Te = Ce + (1-alpha)*kp*dStrain*Tz/m;
-		TDamIndex = rhoeps*Te*m/(Fy*xu) + rhox*fabs(xmax)/xu;
-		Tpk = exp(-phi*TDamIndex);
-		TA = exp(-deltak*TDamIndex*Tpk);
-		Tbetak = beta*TA;
-		Tbetaf = exp(n*deltaf*TDamIndex);
-		if (Tz == 0.0) {
-			TPow = 0.0;
-			TPow_z = 0.0;
-		}
-		else {
-			TPow = pow(fabs(Tz),(n));
-			TPow_z = n*pow(fabs(Tz),(n-1))*signum(Tz);
-		}
-        Psi = eta + signum(dStrain*Tz);
-		Phi =  TA - TPow*Tbetak*Tbetaf*Psi;
-		
-		// Compute tangent ( _x = derivative with respect to x_n+1 )
-		
-		// Compute the derivative of f with respect to x_n+1
-		if (Tz != 0.0) {
-			Te_x = (1 - alpha)*kp*Tz/m;
-			if (xmax == Tstrain) {
-				TDamIndex_x = rhoeps*Te_x*m/(Fy*xu) + rhox/xu;
-			}
-			else {
-				TDamIndex_x = rhoeps*Te_x*m/(Fy*xu);
-			}
-			Tpk_x = Tpk*(-phi*TDamIndex_x);
-			TA_x = TA*(-deltak*TDamIndex_x*Tpk - deltak*TDamIndex*Tpk_x);
-			Tbetak_x = beta*TA_x;
-			Tbetaf_x = Tbetaf*(n*deltaf*TDamIndex_x);
-			Phi_x = TA_x - (TPow*Tbetak_x*Tbetaf + TPow*Tbetak*Tbetaf_x)*Psi;
-			f_x = -Phi - Phi_x*dStrain;
-			
-		// Compute the derivative of f_z with respect to x_n+1
-			Te_z_x = (1 - alpha)*kp/m;
-			TDamIndex_z_x = rhoeps*Te_z_x*m/(Fy*xu);
-			Tpk_z_x = Tpk_x*(-phi*TDamIndex_z) + Tpk*(-phi*TDamIndex_z_x);
-			TA_z_x = TA_x*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z) - TA*(deltak*TDamIndex_z_x*Tpk + deltak*TDamIndex_z*Tpk_x + deltak*TDamIndex_x*Tpk_z + deltak*TDamIndex*Tpk_z_x);
-			Tbetak_z_x = beta*TA_z_x;
-			Tbetaf_z_x = Tbetaf_x*(n*deltaf*TDamIndex_z) + Tbetaf*(n*deltaf*TDamIndex_z_x);
-			Phi_z_x = TA_z_x - (TPow_z*Tbetak*Tbetaf_x + TPow_z*Tbetak_x*Tbetaf + TPow*Tbetaf_z_x*Tbetak + TPow*Tbetaf_z*Tbetak_x + TPow*Tbetaf_x*Tbetak_z + TPow*Tbetaf*Tbetak_z_x)*Psi;
-			f_z_x = -Phi_z - Phi_z_x*dStrain ;
-		
-		
-		// Compute tangent	
-			double DzDeps = -(f_x*f_z - f*f_z_x)/(pow(f_z,2));
-			Ttangent = alpha*kp + (1-alpha)*kp*DzDeps;
-			//Ttangent = Tstress/Tstrain;
-			
+	Te = Ce + (1-alpha)*kp*dStrain*Tz/m;
+	TDamIndex = rhoeps*Te*m/(Fy*xu) + rhox*fabs(xmax)/xu;
+	Tpk = exp(-phi*TDamIndex);
+	TA = exp(-deltak*TDamIndex*Tpk);
+	Tbetak = beta*TA;
+	Tbetaf = exp(n*deltaf*TDamIndex);
+	boucWenPowers(Tz, n, TPow, TPow1);
+	TPow_z = n*TPow1*signum(Tz);
+	Psi = eta + signum(dStrain*Tz);
+	Phi =  TA - TPow*Tbetak*Tbetaf*Psi;
+	
+	// Compute tangent ( _x = derivative with respect to x_n+1 )
+	
+	// Compute the derivative of f with respect to x_n+1
+	if (Tz != 0.0) {
+		Te_x = (1 - alpha)*kp*Tz/m;
+		if (xmax == Tstrain) {
+			TDamIndex_x = rhoeps*Te_x*m/(Fy*xu) + rhox/xu;
 		}
 		else {
-			Ttangent = alpha*ko + (1-alpha)*ko;
+			TDamIndex_x = rhoeps*Te_x*m/(Fy*xu);
 		}
+		Tpk_x = Tpk*(-phi*TDamIndex_x);
+		TA_x = TA*(-deltak*TDamIndex_x*Tpk - deltak*TDamIndex*Tpk_x);
+		Tbetak_x = beta*TA_x;
+		Tbetaf_x = Tbetaf*(n*deltaf*TDamIndex_x);
+		Phi_x = TA_x - (TPow*Tbetak_x*Tbetaf + TPow*Tbetak*Tbetaf_x)*Psi;
+		f_x = -Phi - Phi_x*dStrain;
 		
+	// Compute the derivative of f_z with respect to x_n+1
+		Te_z_x = (1 - alpha)*kp/m;
+		TDamIndex_z_x = rhoeps*Te_z_x*m/(Fy*xu);
+		Tpk_z_x = Tpk_x*(-phi*TDamIndex_z) + Tpk*(-phi*TDamIndex_z_x);
+		TA_z_x = TA_x*(-deltak*TDamIndex_z*Tpk - deltak*TDamIndex*Tpk_z) - TA*(deltak*TDamIndex_z_x*Tpk + deltak*TDamIndex_z*Tpk_x + deltak*TDamIndex_x*Tpk_z + deltak*TDamIndex*Tpk_z_x);
+		Tbetak_z_x = beta*TA_z_x;
+		Tbetaf_z_x = Tbetaf_x*(n*deltaf*TDamIndex_z) + Tbetaf*(n*deltaf*TDamIndex_z_x);
+		Phi_z_x = TA_z_x - (TPow_z*Tbetak*Tbetaf_x + TPow_z*Tbetak_x*Tbetaf + TPow*Tbetaf_z_x*Tbetak + TPow*Tbetaf_z*Tbetak_x + TPow*Tbetaf_x*Tbetak_z + TPow*Tbetaf*Tbetak_z_x)*Psi;
+		f_z_x = -Phi_z - Phi_z_x*dStrain ;
 	
-
+	
+	// Compute tangent	
+		double DzDeps = -(f_x*f_z - f*f_z_x)/(f_z*f_z);
+		Ttangent = alpha*kp + (1-alpha)*kp*DzDeps;
+		//Ttangent = Tstress/Tstrain;
+		
+	}
+	else {
+		Ttangent = alpha*ko + (1-alpha)*ko;
 	}
 	
 	
@@ -309,6 +281,42 @@ DegradingPinchedBW::revertToLastCommit(void)
     return 0;
 }
 
+// batch operations on an array of DegradingPinchedBW objects, see UniaxialMaterial
+int
+DegradingPinchedBW::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                                 double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    DegradingPinchedBW *theMat = static_cast<DegradingPinchedBW *>(theMaterials[i]);
+    res += theMat->DegradingPinchedBW::setTrialStrain(strain[i]);
+    stress[i] = theMat->Tstress;
+    tangent[i] = theMat->Ttangent;
+  }
+
+  return res;
+}
+
+int
+DegradingPinchedBW::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<DegradingPinchedBW *>(theMaterials[i])->DegradingPinchedBW::commitState();
+
+  return res;
+}
+
+int
+DegradingPinchedBW::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<DegradingPinchedBW *>(theMaterials[i])->DegradingPinchedBW::revertToLastCommit();
+
+  return res;
+}
+
 int 
 DegradingPinchedBW::revertToStart(void)
 {
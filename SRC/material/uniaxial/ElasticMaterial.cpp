@@ -101,25 +101,39 @@ OPS_ElasticMaterial(void)
 ElasticMaterial::ElasticMaterial(int tag, double e, double et)
 :UniaxialMaterial(tag,MAT_TAG_ElasticMaterial),
  trialStrain(0.0),  trialStrainRate(0.0),
- Epos(e), Eneg(e), eta(et), parameterID(0)
+ par(new Parameters), parameterID(0)
 {
-
+  par->Epos = e;
+  par->Eneg = e;
+  par->eta = et;
 }
 
 
 ElasticMaterial::ElasticMaterial(int tag, double ep, double et, double en)
 :UniaxialMaterial(tag,MAT_TAG_ElasticMaterial),
  trialStrain(0.0),  trialStrainRate(0.0),
- Epos(ep), Eneg(en), eta(et), parameterID(0)
+ par(new Parameters), parameterID(0)
 {
-
+  par->Epos = ep;
+  par->Eneg = en;
+  par->eta = et;
 }
 
 
 ElasticMaterial::ElasticMaterial()
 :UniaxialMaterial(0,MAT_TAG_ElasticMaterial),
  trialStrain(0.0),  trialStrainRate(0.0),
- Epos(0.0), Eneg(0.0), eta(0.0), parameterID(0)
+ par(new Parameters()), parameterID(0)
+{
+
+}
+
+
+// a copy shares the moduli of the material it is copied from
+ElasticMaterial::ElasticMaterial(int tag, const std::shared_ptr<Parameters> &thePar)
+:UniaxialMaterial(tag,MAT_TAG_ElasticMaterial),
+ trialStrain(0.0),  trialStrainRate(0.0),
+ par(thePar), parameterID(0)
 {
 
 }
@@ -147,11 +161,11 @@ ElasticMaterial::setTrial(double strain, double &stress, double &tangent, double
     trialStrainRate = strainRate;
 
     if (trialStrain >= 0.0) {
-        stress = Epos*trialStrain + eta*trialStrainRate;
-        tangent = Epos;
+        stress = par->Epos*trialStrain + par->eta*trialStrainRate;
+        tangent = par->Epos;
     } else {
-        stress = Eneg*trialStrain + eta*trialStrainRate;
-        tangent = Eneg;
+        stress = par->Eneg*trialStrain + par->eta*trialStrainRate;
+        tangent = par->Eneg;
     }
 
     return 0;
@@ -162,9 +176,9 @@ double
 ElasticMaterial::getStress(void)
 {
     if (trialStrain >= 0.0)
-        return Epos*trialStrain + eta*trialStrainRate;
+        return par->Epos*trialStrain + par->eta*trialStrainRate;
     else
-        return Eneg*trialStrain + eta*trialStrainRate;
+        return par->Eneg*trialStrain + par->eta*trialStrainRate;
 }
 
 
@@ -172,16 +186,16 @@ double
 ElasticMaterial::getTangent(void)
 {
     if (trialStrain >= 0.0)
-        return Epos;
+        return par->Epos;
     else 
-        return Eneg;
+        return par->Eneg;
 }
 
 
 double 
 ElasticMaterial::getInitialTangent(void)
 {
-  return Epos;
+  return par->Epos;
 }
 
 
@@ -199,6 +213,40 @@ ElasticMaterial::revertToLastCommit(void)
 }
 
 
+// batch operations on an array of ElasticMaterial objects, see UniaxialMaterial
+int
+ElasticMaterial::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                               double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    ElasticMaterial *theMat = static_cast<ElasticMaterial *>(theMaterials[i]);
+    res += theMat->ElasticMaterial::setTrial(strain[i], stress[i], tangent[i]);
+  }
+
+  return res;
+}
+
+int
+ElasticMaterial::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<ElasticMaterial *>(theMaterials[i])->ElasticMaterial::commitState();
+
+  return res;
+}
+
+int
+ElasticMaterial::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<ElasticMaterial *>(theMaterials[i])->ElasticMaterial::revertToLastCommit();
+
+  return res;
+}
+
 int 
 ElasticMaterial::revertToStart(void)
 {
@@ -211,7 +259,7 @@ ElasticMaterial::revertToStart(void)
 UniaxialMaterial *
 ElasticMaterial::getCopy(void)
 {
-    ElasticMaterial *theCopy = new ElasticMaterial(this->getTag(),Epos,eta,Eneg);
+    ElasticMaterial *theCopy = new ElasticMaterial(this->getTag(), par);
     theCopy->trialStrain     = trialStrain;
     theCopy->trialStrainRate = trialStrainRate;
     theCopy->parameterID = parameterID;
@@ -225,9 +273,9 @@ ElasticMaterial::sendSelf(int cTag, Channel &theChannel)
   int res = 0;
   static Vector data(5);
   data(0) = this->getTag();
-  data(1) = Epos;
-  data(2) = Eneg;
-  data(3) = eta;
+  data(1) = par->Epos;
+  data(2) = par->Eneg;
+  data(3) = par->eta;
   data(4) = parameterID;
   res = theChannel.sendVector(this->getDbTag(), cTag, data);
   if (res < 0) 
@@ -244,17 +292,18 @@ ElasticMaterial::recvSelf(int cTag, Channel &theChannel,
   int res = 0;
   static Vector data(5);
   res = theChannel.recvVector(this->getDbTag(), cTag, data);
+  this->ownParameters();
   
   if (res < 0) {
     opserr << "ElasticMaterial::recvSelf() - failed to receive data" << endln;
-    Epos = Eneg = 0; 
+    par->Epos = par->Eneg = 0; 
     this->setTag(0);      
   }
   else {
     this->setTag(int(data(0)));
-    Epos = data(1);
-    Eneg = data(2);
-    eta  = data(3);
+    par->Epos = data(1);
+    par->Eneg = data(2);
+    par->eta  = data(3);
     parameterID = (int)data(4);
   }
     
@@ -267,16 +316,16 @@ ElasticMaterial::Print(OPS_Stream &s, int flag)
 {
 	if (flag == OPS_PRINT_PRINTMODEL_MATERIAL) {
 		s << "ElasticMaterial tag: " << this->getTag() << endln;
-		s << "  Epos: " << Epos << " Eneg: " << Eneg << " eta: " << eta << endln;
+		s << "  Epos: " << par->Epos << " Eneg: " << par->Eneg << " eta: " << par->eta << endln;
 	}
     
 	if (flag == OPS_PRINT_PRINTMODEL_JSON) {
 		s << "\t\t\t{";
 		s << "\"name\": \"" << this->getTag() << "\", ";
 		s << "\"type\": \"ElasticMaterial\", ";
-		s << "\"Epos\": " << Epos << ", ";
-		s << "\"Eneg\": " << Eneg << ", ";
-		s << "\"eta\": " << eta << "}";
+		s << "\"Epos\": " << par->Epos << ", ";
+		s << "\"Eneg\": " << par->Eneg << ", ";
+		s << "\"eta\": " << par->eta << "}";
 	}
 }
 
@@ -286,19 +335,19 @@ ElasticMaterial::setParameter(const char **argv, int argc, Parameter &param)
 {
 
   if (strcmp(argv[0],"E") == 0) {
-    param.setValue(Epos);
+    param.setValue(par->Epos);
     return param.addObject(1, this);
   }
   if (strcmp(argv[0],"Epos") == 0) {
-    param.setValue(Epos);
+    param.setValue(par->Epos);
     return param.addObject(2, this);
   }
   if (strcmp(argv[0],"Eneg") == 0) {
-    param.setValue(Eneg);
+    param.setValue(par->Eneg);
     return param.addObject(3, this);
   }
   if (strcmp(argv[0],"eta") == 0) {
-    param.setValue(eta);
+    param.setValue(par->eta);
     return param.addObject(4, this);
   }
   return -1;
@@ -308,19 +357,21 @@ ElasticMaterial::setParameter(const char **argv, int argc, Parameter &param)
 int 
 ElasticMaterial::updateParameter(int parameterID, Information &info)
 {
+  this->ownParameters();
+
   switch(parameterID) {
   case 1:
-    Epos = info.theDouble;
-    Eneg = info.theDouble;
+    par->Epos = info.theDouble;
+    par->Eneg = info.theDouble;
     return 0;
   case 2:
-    Epos = info.theDouble;
+    par->Epos = info.theDouble;
     return 0;
   case 3:
-    Eneg = info.theDouble;
+    par->Eneg = info.theDouble;
     return 0;
   case 4:
-    eta = info.theDouble;
+    par->eta = info.theDouble;
     return 0;
   default:
     return -1;
@@ -386,3 +437,13 @@ ElasticMaterial::commitSensitivity(double strainGradient,
   // Nothing to commit ... path independent
   return 0;
 }
+
+
+// gives this material its own copy of the moduli before they are
+// changed, if they are shared with other copies
+void
+ElasticMaterial::ownParameters(void)
+{
+  if (par.use_count() > 1)
+    par = std::make_shared<Parameters>(*par);
+}
@@ -37,6 +37,7 @@
 
 
 #include <UniaxialMaterial.h>
+#include <memory>
 
 class ElasticMaterial : public UniaxialMaterial
 {
@@ -54,11 +55,18 @@ class ElasticMaterial : public UniaxialMaterial
     double getStrainRate(void) {return trialStrainRate;}
     double getStress(void);
     double getTangent(void);
-    double getDampTangent(void) {return eta;}
+    double getDampTangent(void) {return par->eta;}
+    // E if the stress is E*strain at any strain & rate, 0 otherwise
+    double getLinearModulus(void) const
+      {return (par->Epos == par->Eneg && par->eta == 0.0) ? par->Epos : 0.0;}
     double getInitialTangent(void);
 
     int commitState(void);
     int revertToLastCommit(void);    
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
@@ -85,9 +93,17 @@ class ElasticMaterial : public UniaxialMaterial
   private:
     double trialStrain;
     double trialStrainRate;
-    double Epos;
-    double Eneg;
-    double eta;
+
+    // the moduli, shared by the copies of a material until one of them
+    // has a parameter updated
+    struct Parameters {
+      double Epos;
+      double Eneg;
+      double eta;
+    };
+    std::shared_ptr<Parameters> par;
+    ElasticMaterial(int tag, const std::shared_ptr<Parameters> &par);
+    void ownParameters(void);
 
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int parameterID;
@@ -275,9 +275,10 @@ HystereticMaterial::getTangent(void)
 void
 HystereticMaterial::positiveIncrement(double dStrain)
 {
-	double kn = pow(CrotMin/rot1n,beta);
+	// the unloading stiffness is not degraded for beta = 0, the default
+	double kn = (beta == 0.0) ? 1.0 : pow(CrotMin/rot1n,beta);
 	kn = (kn < 1.0) ? 1.0 : 1.0/kn;
-	double kp = pow(CrotMax/rot1p,beta);
+	double kp = (beta == 0.0) ? 1.0 : pow(CrotMax/rot1p,beta);
 	kp = (kp < 1.0) ? 1.0 : 1.0/kp;
 
 	if (TloadIndicator == 2) {
@@ -363,9 +364,10 @@ HystereticMaterial::positiveIncrement(double dStrain)
 void
 HystereticMaterial::negativeIncrement(double dStrain)
 {
-	double kn = pow(CrotMin/rot1n,beta);
+	// the unloading stiffness is not degraded for beta = 0, the default
+	double kn = (beta == 0.0) ? 1.0 : pow(CrotMin/rot1n,beta);
 	kn = (kn < 1.0) ? 1.0 : 1.0/kn;
-	double kp = pow(CrotMax/rot1p,beta);
+	double kp = (beta == 0.0) ? 1.0 : pow(CrotMax/rot1p,beta);
 	kp = (kp < 1.0) ? 1.0 : 1.0/kp;
 
 	if (TloadIndicator == 1) {
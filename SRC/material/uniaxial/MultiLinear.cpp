@@ -168,20 +168,33 @@ MultiLinear::setTrialStrain(double strain, double strainRate)
         tTangent = data(0, 4);
     }
     else if (tStrain < data(0, 0)) { // search neg of data
-        tSlope = 1;
-        while (tSlope < numSlope && tStrain < data(tSlope, 0))
-            tSlope++;
-        if (tSlope == numSlope)
-            tSlope = numSlope - 1;
+        // the neg bounds decrease with the slope, bisect for the first
+        // one reached, the last slope if none
+        int lo = (numSlope > 1) ? 1 : 0;
+        int hi = numSlope - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (tStrain < data(mid, 0))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        tSlope = lo;
         tStress = data(tSlope, 2) + (tStrain - data(tSlope, 0)) * data(tSlope, 4);
         tTangent = data(tSlope, 4);
     }
     else { // search pos side of data
-        tSlope = 1;
-        while (tSlope < numSlope && tStrain > data(tSlope, 1))
-            tSlope++;
-        if (tSlope == numSlope)
-            tSlope = numSlope - 1;
+        // the pos bounds increase with the slope
+        int lo = (numSlope > 1) ? 1 : 0;
+        int hi = numSlope - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (tStrain > data(mid, 1))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        tSlope = lo;
         tStress = data(tSlope, 3) + (tStrain - data(tSlope, 1)) * data(tSlope, 4);
         tTangent = data(tSlope, 4);
     }
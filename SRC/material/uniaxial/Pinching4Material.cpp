@@ -1461,7 +1461,7 @@ void Pinching4Material::getState4(Vector& state4Strain,Vector& state4Stress, dou
 				}
 			}
 
-double Pinching4Material::Envlp3Tangent(Vector s3Strain, Vector s3Stress, double u)
+double Pinching4Material::Envlp3Tangent(const Vector& s3Strain, const Vector& s3Stress, double u)
 			{
 				double k = 0.0;
 				int i = 0;
@@ -1485,7 +1485,7 @@ double Pinching4Material::Envlp3Tangent(Vector s3Strain, Vector s3Stress, double
 				return k;
 			}
 
-double Pinching4Material::Envlp4Tangent(Vector s4Strain, Vector s4Stress, double u)
+double Pinching4Material::Envlp4Tangent(const Vector& s4Strain, const Vector& s4Stress, double u)
 			{
 				double k = 0.0;
 				int i = 0;
@@ -1510,7 +1510,7 @@ double Pinching4Material::Envlp4Tangent(Vector s4Strain, Vector s4Stress, double
 			}
 
 
-  double Pinching4Material::Envlp3Stress(Vector s3Strain, Vector s3Stress, double u)
+  double Pinching4Material::Envlp3Stress(const Vector& s3Strain, const Vector& s3Stress, double u)
 			{
 				double k = 0.0;
 				int i = 0;
@@ -1536,7 +1536,7 @@ double Pinching4Material::Envlp4Tangent(Vector s4Strain, Vector s4Stress, double
 				return f;
 			}
 
-double Pinching4Material::Envlp4Stress(Vector s4Strain, Vector s4Stress, double u)
+double Pinching4Material::Envlp4Stress(const Vector& s4Strain, const Vector& s4Stress, double u)
 			{
 				double k = 0.0;
 				int i = 0;
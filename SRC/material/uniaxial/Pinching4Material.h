@@ -185,10 +185,10 @@ private:
 	double negEnvlpTangent(double);
 	void getState3(Vector& , Vector& , double);
 	void getState4(Vector& , Vector& , double);
-	double Envlp3Tangent(Vector , Vector , double);
-	double Envlp3Stress(Vector , Vector , double);
-	double Envlp4Tangent(Vector , Vector , double);
-	double Envlp4Stress(Vector , Vector , double);
+	double Envlp3Tangent(const Vector& , const Vector& , double);
+	double Envlp3Stress(const Vector& , const Vector& , double);
+	double Envlp4Tangent(const Vector& , const Vector& , double);
+	double Envlp4Stress(const Vector& , const Vector& , double);
 	void updateDmg(double, double);
 
 
@@ -365,6 +365,40 @@ int Steel01::revertToLastCommit ()
    return 0;
 }
 
+// batch operations on an array of Steel01 objects, see UniaxialMaterial
+int
+Steel01::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                       double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Steel01 *theMat = static_cast<Steel01 *>(theMaterials[i]);
+    res += theMat->Steel01::setTrial(strain[i], stress[i], tangent[i]);
+  }
+
+  return res;
+}
+
+int
+Steel01::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Steel01 *>(theMaterials[i])->Steel01::commitState();
+
+  return res;
+}
+
+int
+Steel01::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Steel01 *>(theMaterials[i])->Steel01::revertToLastCommit();
+
+  return res;
+}
+
 int Steel01::revertToStart ()
 {
    // History variables
@@ -66,6 +66,10 @@ class Steel01 : public UniaxialMaterial
 
     int commitState(void);
     int revertToLastCommit(void);    
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
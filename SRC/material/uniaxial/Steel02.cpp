@@ -63,59 +63,47 @@ OPS_Steel02()
     return 0;
   }
 
-  numData = OPS_GetNumRemainingInputArgs();
+  // the numeric arguments, then the optional -implex flag
+  numData = 0;
+  int numValue = 1;
+  while (numData < 11 && OPS_GetNumRemainingInputArgs() > 0) {
+    int numRemaining = OPS_GetNumRemainingInputArgs();
+    if (OPS_GetDoubleInput(&numValue, &dData[numData]) < 0) {
+      if (OPS_GetNumRemainingInputArgs() < numRemaining)
+	OPS_ResetCurrentInputArg(-1);
+      break;
+    }
+    numData++;
+  }
+
+  bool implex = false;
+  if (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-implex") == 0)
+      implex = true;
+    else
+      numData = -1;
+  }
 
   if (numData != 3 && numData != 6 && numData != 10 && numData != 11) {
     opserr << "Invalid #args, want: uniaxialMaterial Steel02 " << iData[0] << 
-      " fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>>" << endln;
+      " fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>> <-implex>" << endln;
     return 0;
   }
 
-  if (numData == 3) {
-    if (OPS_GetDoubleInput(&numData, dData) != 0) {
-      opserr << "Invalid double: uniaxialMaterial Steel02 " << iData[0] << 
-	" fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>>" << endln;
-      return 0;
-    }
-
-    // Parsing was successful, allocate the material
-    theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2]);    
-
-  } else if (numData == 6) {
-    if (OPS_GetDoubleInput(&numData, dData) != 0) {
-      opserr << "Invalid int: uniaxialMaterial Steel02 " << iData[0] << 
-	" fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>>" << endln;
-      return 0;
-    }
-
-    // Parsing was successful, allocate the material
-    theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2], dData[3], dData[4], dData[5]);    
-
-  } else if (numData == 10) {
-    if (OPS_GetDoubleInput(&numData, dData) != 0) {
-      opserr << "Invalid arggs: uniaxialMaterial Steel02 " << iData[0] << 
-	" fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>>" << endln;
-      return 0;
-    }
-
-    // Parsing was successful, allocate the material
+  // Parsing was successful, allocate the material
+  if (numData == 3)
+    theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2], implex);
+  else if (numData == 6)
+    theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2], dData[3], dData[4], dData[5], implex);
+  else if (numData == 10)
     theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2], 
 			      dData[3], dData[4], dData[5], dData[6], 
-			      dData[7], dData[8], dData[9]);    
-
-  } else if (numData == 11) {
-    if (OPS_GetDoubleInput(&numData, dData) != 0) {
-      opserr << "Invalid arggs: uniaxialMaterial Steel02 " << iData[0] << 
-	" fy? E? b? <R0? cR1? cR2? <a1? a2? a3? a4?>>" << endln;
-      return 0;
-    }
-
-    // Parsing was successful, allocate the material
+			      dData[7], dData[8], dData[9], 0.0, implex);
+  else
     theMaterial = new Steel02(iData[0], dData[0], dData[1], dData[2], 
 			      dData[3], dData[4], dData[5], dData[6], 
-			      dData[7], dData[8], dData[9], dData[10]);    
-
-  }   
+			      dData[7], dData[8], dData[9], dData[10], implex);
 
   if (theMaterial == 0) {
     opserr << "WARNING could not create uniaxialMaterial of type Steel02 Material\n";
@@ -129,22 +117,27 @@ OPS_Steel02()
 Steel02::Steel02(int tag,
 		 double _Fy, double _E0, double _b,
 		 double _R0, double _cR1, double _cR2,
-		 double _a1, double _a2, double _a3, double _a4, double sigInit):
+		 double _a1, double _a2, double _a3, double _a4, double sigInit,
+		 bool implex):
   UniaxialMaterial(tag, MAT_TAG_Steel02),
-  Fy(_Fy), E0(_E0), b(_b), R0(_R0), cR1(_cR1), cR2(_cR2), a1(_a1), a2(_a2), a3(_a3), a4(_a4), 
-  sigini(sigInit)
+  par(new Parameters)
 {
+  par->Fy = _Fy; par->E0 = _E0; par->b = _b; par->R0 = _R0; par->cR1 = _cR1; par->cR2 = _cR2;
+  par->a1 = _a1; par->a2 = _a2; par->a3 = _a3; par->a4 = _a4;
+  par->sigini = sigInit;
+  par->implex = implex;
+
 	EnergyP = 0;	//by SAJalali
 	konP = 0;
   kon = 0;
-  eP = E0;
+  eP = par->E0;
   epsP = 0.0;
   sigP = 0.0;
   sig = 0.0;
   eps = 0.0;
-  e = E0;
+  e = par->E0;
 
-  epsmaxP = Fy/E0;
+  epsmaxP = par->Fy/par->E0;
   epsminP = -epsmaxP;
   epsplP = 0.0;
   epss0P = 0.0;
@@ -152,35 +145,39 @@ Steel02::Steel02(int tag,
   epssrP = 0.0;
   sigsrP = 0.0;
 
-  if (sigini != 0.0) {
-    epsP = sigini/E0;
-    sigP = sigini;
+  if (par->sigini != 0.0) {
+    epsP = par->sigini/par->E0;
+    sigP = par->sigini;
   } 
 }
 
 Steel02::Steel02(int tag,
 		 double _Fy, double _E0, double _b,
-		 double _R0, double _cR1, double _cR2):
+		 double _R0, double _cR1, double _cR2, bool implex):
   UniaxialMaterial(tag, MAT_TAG_Steel02),
-  Fy(_Fy), E0(_E0), b(_b), R0(_R0), cR1(_cR1), cR2(_cR2), sigini(0.0)
+  par(new Parameters)
 {
+  par->Fy = _Fy; par->E0 = _E0; par->b = _b; par->R0 = _R0; par->cR1 = _cR1; par->cR2 = _cR2;
+  par->sigini = 0.0;
+  par->implex = implex;
+
 	EnergyP = 0;	//by SAJalali
 	konP = 0;
 
   // Default values for no isotropic hardening
-  a1 = 0.0;
-  a2 = 1.0;
-  a3 = 0.0;
-  a4 = 1.0;
+  par->a1 = 0.0;
+  par->a2 = 1.0;
+  par->a3 = 0.0;
+  par->a4 = 1.0;
 
-  eP = E0;
+  eP = par->E0;
   epsP = 0.0;
   sigP = 0.0;
   sig = 0.0;
   eps = 0.0;
-  e = E0;
+  e = par->E0;
 
-  epsmaxP = Fy/E0;
+  epsmaxP = par->Fy/par->E0;
   epsminP = -epsmaxP;
   epsplP = 0.0;
   epss0P = 0.0;
@@ -189,32 +186,36 @@ Steel02::Steel02(int tag,
   sigsrP = 0.0;
 }
 
-Steel02::Steel02(int tag, double _Fy, double _E0, double _b):
+Steel02::Steel02(int tag, double _Fy, double _E0, double _b, bool implex):
   UniaxialMaterial(tag, MAT_TAG_Steel02),
-  Fy(_Fy), E0(_E0), b(_b), sigini(0.0)
+  par(new Parameters)
 {
+  par->Fy = _Fy; par->E0 = _E0; par->b = _b;
+  par->sigini = 0.0;
+  par->implex = implex;
+
 	EnergyP = 0;	//by SAJalali
 	konP = 0;
 
   // Default values for elastic to hardening transitions
-  R0 = 15.0;
-  cR1 = 0.925;
-  cR2 = 0.15;
+  par->R0 = 15.0;
+  par->cR1 = 0.925;
+  par->cR2 = 0.15;
 
   // Default values for no isotropic hardening
-  a1 = 0.0;
-  a2 = 1.0;
-  a3 = 0.0;
-  a4 = 1.0;
+  par->a1 = 0.0;
+  par->a2 = 1.0;
+  par->a3 = 0.0;
+  par->a4 = 1.0;
 
-  eP = E0;
+  eP = par->E0;
   epsP = 0.0;
   sigP = 0.0;
   sig = 0.0;
   eps = 0.0;
-  e = E0;
+  e = par->E0;
 
-  epsmaxP = Fy/E0;
+  epsmaxP = par->Fy/par->E0;
   epsminP = -epsmaxP;
   epsplP = 0.0;
   epss0P = 0.0;
@@ -224,12 +225,22 @@ Steel02::Steel02(int tag, double _Fy, double _E0, double _b):
 }
 
 Steel02::Steel02(void):
-  UniaxialMaterial(0, MAT_TAG_Steel02)
+  UniaxialMaterial(0, MAT_TAG_Steel02),
+  par(new Parameters())
 {
 	EnergyP = 0;	//by SAJalali
 	konP = 0;
 }
 
+// a copy shares the parameters of the material it is copied from
+Steel02::Steel02(int tag, const std::shared_ptr<Parameters> &thePar):
+  UniaxialMaterial(tag, MAT_TAG_Steel02),
+  par(thePar)
+{
+  kon = 0;
+  this->revertToStart();
+}
+
 Steel02::~Steel02(void)
 {
   // Does nothing
@@ -238,7 +249,7 @@ Steel02::~Steel02(void)
 UniaxialMaterial*
 Steel02::getCopy(void)
 {
-  Steel02 *theCopy = new Steel02(this->getTag(), Fy, E0, b, R0, cR1, cR2, a1, a2, a3, a4, sigini);
+  Steel02 *theCopy = new Steel02(this->getTag(), par);
   
   return theCopy;
 }
@@ -246,18 +257,35 @@ Steel02::getCopy(void)
 double
 Steel02::getInitialTangent(void)
 {
-  return E0;
+  return par->E0;
 }
 
 int
 Steel02::setTrialStrain(double trialStrain, double strainRate)
 {
-  double Esh = b * E0;
-  double epsy = Fy / E0;
+  if (par->implex == false)
+    return this->implicitTrial(trialStrain);
+
+  // IMPL-EX: linear elastic about the extrapolated inelastic strain
+  dt = ops_Dt;
+  double epsIn = implexExtrapolate(epsInP, epsInPP, dt, dtP);
+
+  eps = trialStrain + par->sigini/par->E0;
+  sig = par->E0*(eps - epsIn);
+  e = par->E0;
+
+  return 0;
+}
+
+int
+Steel02::implicitTrial(double trialStrain)
+{
+  double Esh = par->b * par->E0;
+  double epsy = par->Fy / par->E0;
 
   // modified C-P. Lamarche 2006
-  if (sigini != 0.0) {
-    double epsini = sigini/E0;
+  if (par->sigini != 0.0) {
+    double epsini = par->sigini/par->E0;
     eps = trialStrain+epsini;
   } else
     eps = trialStrain;
@@ -273,14 +301,15 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
   epsr   = epssrP;  
   sigr   = sigsrP;  
   kon = konP;
+  historyReverted = false;
 
   if (kon == 0 || kon == 3) { // modified C-P. Lamarche 2006
 
 
     if (fabs(deps) < 10.0*DBL_EPSILON) {
 
-      e = E0;
-      sig = sigini;                // modified C-P. Lamarche 2006
+      e = par->E0;
+      sig = par->sigini;                // modified C-P. Lamarche 2006
       kon = 3;                     // modified C-P. Lamarche 2006 flag to impose initial stess/strain
       return 0;
 
@@ -291,12 +320,12 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
       if (deps < 0.0) {
 	kon = 2;
 	epss0 = epsmin;
-	sigs0 = -Fy;
+	sigs0 = -par->Fy;
 	epspl = epsmin;
       } else {
 	kon = 1;
 	epss0 = epsmax;
-	sigs0 = Fy;
+	sigs0 = par->Fy;
 	epspl = epsmax;
       }
     }
@@ -319,10 +348,10 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
     //epsmin = min(epsP, epsmin);
     if (epsP < epsmin)
       epsmin = epsP;
-    double d1 = (epsmax - epsmin) / (2.0*(a4 * epsy));
-    double shft = 1.0 + a3 * pow(d1, 0.8);
-    epss0 = (Fy * shft - Esh * epsy * shft - sigr + E0 * epsr) / (E0 - Esh);
-    sigs0 = Fy * shft + Esh * (epss0 - epsy * shft);
+    double d1 = (epsmax - epsmin) / (2.0*(par->a4 * epsy));
+    double shft = 1.0 + par->a3 * pow(d1, 0.8);
+    epss0 = (par->Fy * shft - Esh * epsy * shft - sigr + par->E0 * epsr) / (par->E0 - Esh);
+    sigs0 = par->Fy * shft + Esh * (epss0 - epsy * shft);
     epspl = epsmax;
 
   } else if (kon == 1 && deps < 0.0) {
@@ -341,10 +370,10 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
     if (epsP > epsmax)
       epsmax = epsP;
     
-    double d1 = (epsmax - epsmin) / (2.0*(a2 * epsy));
-    double shft = 1.0 + a1 * pow(d1, 0.8);
-    epss0 = (-Fy * shft + Esh * epsy * shft - sigr + E0 * epsr) / (E0 - Esh);
-    sigs0 = -Fy * shft + Esh * (epss0 + epsy * shft);
+    double d1 = (epsmax - epsmin) / (2.0*(par->a2 * epsy));
+    double shft = 1.0 + par->a1 * pow(d1, 0.8);
+    epss0 = (-par->Fy * shft + Esh * epsy * shft - sigr + par->E0 * epsr) / (par->E0 - Esh);
+    sigs0 = -par->Fy * shft + Esh * (epss0 + epsy * shft);
     epspl = epsmin;
   }
 
@@ -352,15 +381,15 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
   // calculate current stress sig and tangent modulus E 
 
   double xi     = fabs((epspl-epss0)/epsy);
-  double R      = R0*(1.0 - (cR1*xi)/(cR2+xi));
+  double R      = par->R0*(1.0 - (par->cR1*xi)/(par->cR2+xi));
   double epsrat = (eps-epsr)/(epss0-epsr);
   double dum1  = 1.0 + pow(fabs(epsrat),R);
   double dum2  = pow(dum1,(1/R));
 
-  sig   = b*epsrat +(1.0-b)*epsrat/dum2;
+  sig   = par->b*epsrat +(1.0-par->b)*epsrat/dum2;
   sig   = sig*(sigs0-sigr)+sigr;
 
-  e = b + (1.0-b)/(dum1*dum2);
+  e = par->b + (1.0-par->b)/(dum1*dum2);
   e = e*(sigs0-sigr)/(epss0-epsr);
 
   return 0;
@@ -389,14 +418,27 @@ Steel02::getTangent(void)
 int 
 Steel02::commitState(void)
 {
-  epsminP = epsmin;
-  epsmaxP = epsmax;
-  epsplP = epspl;
-  epss0P = epss0;
-  sigs0P = sigs0;
-  epssrP = epsr;
-  sigsrP = sigr;
-  konP = kon;
+  // IMPL-EX: the history variables come from the implicit solution
+  // at the converged strain
+  if (par->implex) {
+    sig = sigP;
+    e = eP;
+    this->implicitTrial(eps - par->sigini/par->E0);
+    epsInPP = epsInP;
+    epsInP = eps - sig/par->E0;
+    dtP = dt;
+  }
+
+  if (historyReverted == false) {
+    epsminP = epsmin;
+    epsmaxP = epsmax;
+    epsplP = epspl;
+    epss0P = epss0;
+    sigs0P = sigs0;
+    epssrP = epsr;
+    sigsrP = sigr;
+    konP = kon;
+  }
 
   //by SAJalali
   EnergyP += 0.5*(sig + sigP)*(eps - epsP);
@@ -411,14 +453,9 @@ Steel02::commitState(void)
 int 
 Steel02::revertToLastCommit(void)
 {
-  epsmin = epsminP;
-  epsmax = epsmaxP;
-  epspl = epsplP;
-  epss0 = epss0P;
-  sigs0 = sigs0P;
-  epsr = epssrP;
-  sigr = sigsrP;
-  kon = konP;
+  // the trial history variables are set from the committed ones at the
+  // start of the next trial
+  historyReverted = true;
   
   e = eP;
   sig = sigP;
@@ -426,19 +463,55 @@ Steel02::revertToLastCommit(void)
   return 0;
 }
 
+// batch operations on an array of Steel02 objects, see UniaxialMaterial
+int
+Steel02::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                       double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Steel02 *theMat = static_cast<Steel02 *>(theMaterials[i]);
+    res += theMat->Steel02::setTrialStrain(strain[i]);
+    stress[i] = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
+int
+Steel02::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Steel02 *>(theMaterials[i])->Steel02::commitState();
+
+  return res;
+}
+
+int
+Steel02::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += static_cast<Steel02 *>(theMaterials[i])->Steel02::revertToLastCommit();
+
+  return res;
+}
+
 int 
 Steel02::revertToStart(void)
 {
 	EnergyP = 0;	//by SAJalali
-	eP = E0;
+	eP = par->E0;
   epsP = 0.0;
   sigP = 0.0;
   sig = 0.0;
   eps = 0.0;
-  e = E0;  
+  e = par->E0;  
 
   konP = 0;
-  epsmaxP = Fy/E0;
+  epsmaxP = par->Fy/par->E0;
   epsminP = -epsmaxP;
   epsplP = 0.0;
   epss0P = 0.0;
@@ -446,28 +519,33 @@ Steel02::revertToStart(void)
   epssrP = 0.0;
   sigsrP = 0.0;
 
-  if (sigini != 0.0) {
-	  epsP = sigini/E0;
-	  sigP = sigini;
+  if (par->sigini != 0.0) {
+	  epsP = par->sigini/par->E0;
+	  sigP = par->sigini;
    } 
 
+  epsInP = epsInPP = 0.0;
+  dtP = dt = 0.0;
+
+  historyReverted = true;
+
   return 0;
 }
 
 int 
 Steel02::sendSelf(int commitTag, Channel &theChannel)
 {
-  static Vector data(23);
-  data(0) = Fy;
-  data(1) = E0;
-  data(2) = b;
-  data(3) = R0;
-  data(4) = cR1;
-  data(5) = cR2;
-  data(6) = a1;
-  data(7) = a2;
-  data(8) = a3;
-  data(9) = a4;
+  static Vector data(27);
+  data(0) = par->Fy;
+  data(1) = par->E0;
+  data(2) = par->b;
+  data(3) = par->R0;
+  data(4) = par->cR1;
+  data(5) = par->cR2;
+  data(6) = par->a1;
+  data(7) = par->a2;
+  data(8) = par->a3;
+  data(9) = par->a4;
   data(10) = epsminP;
   data(11) = epsmaxP;
   data(12) = epsplP;
@@ -480,7 +558,11 @@ Steel02::sendSelf(int commitTag, Channel &theChannel)
   data(19) = sigP;  
   data(20) = eP;    
   data(21) = this->getTag();
-  data(22) = sigini;
+  data(22) = par->sigini;
+  data(23) = par->implex ? 1.0 : 0.0;
+  data(24) = epsInP;
+  data(25) = epsInPP;
+  data(26) = dtP;
 
   if (theChannel.sendVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "Steel02::sendSelf() - failed to sendSelf\n";
@@ -493,23 +575,25 @@ int
 Steel02::recvSelf(int commitTag, Channel &theChannel, 
 	     FEM_ObjectBroker &theBroker)
 {
-  static Vector data(23);
+  static Vector data(27);
 
   if (theChannel.recvVector(this->getDbTag(), commitTag, data) < 0) {
     opserr << "Steel02::recvSelf() - failed to recvSelf\n";
     return -1;
   }
 
-  Fy = data(0);
-  E0 = data(1);
-  b = data(2); 
-  R0 = data(3);
-  cR1 = data(4);
-  cR2 = data(5);
-  a1 = data(6); 
-  a2 = data(7); 
-  a3 = data(8); 
-  a4 = data(9); 
+  this->ownParameters();
+
+  par->Fy = data(0);
+  par->E0 = data(1);
+  par->b = data(2); 
+  par->R0 = data(3);
+  par->cR1 = data(4);
+  par->cR2 = data(5);
+  par->a1 = data(6); 
+  par->a2 = data(7); 
+  par->a3 = data(8); 
+  par->a4 = data(9); 
   epsminP = data(10);
   epsmaxP = data(11);
   epsplP = data(12); 
@@ -522,11 +606,16 @@ Steel02::recvSelf(int commitTag, Channel &theChannel,
   sigP = data(19);   
   eP   = data(20);   
   this->setTag(int(data(21)));
-  sigini = data(22);
+  par->sigini = data(22);
+  par->implex = (data(23) != 0.0);
+  epsInP = data(24);
+  epsInPP = data(25);
+  dtP = data(26);
 
   e = eP;
   sig = sigP;
   eps = epsP;
+  historyReverted = true;
   
   return 0;
 }
@@ -537,33 +626,33 @@ Steel02::Print(OPS_Stream &s, int flag)
   if (flag == OPS_PRINT_PRINTMODEL_MATERIAL) {      
     //    s << "Steel02:(strain, stress, tangent) " << eps << " " << sig << " " << e << endln;
     s << "Steel02 tag: " << this->getTag() << endln;
-    s << "  fy: " << Fy << ", ";
-    s << "  E0: " << E0 << ", ";
-    s << "   b: " << b << ", ";
-    s << "  R0: " << R0 << ", ";
-    s << " cR1: " << cR1 << ", ";
-    s << " cR2: " << cR2 << ", ";    
-    s << "  a1: " << a1 << ", ";
-    s << "  a2: " << a2 << ", ";
-    s << "  a3: " << a3 << ", ";
-    s << "  a4: " << a4;    
+    s << "  fy: " << par->Fy << ", ";
+    s << "  E0: " << par->E0 << ", ";
+    s << "   b: " << par->b << ", ";
+    s << "  R0: " << par->R0 << ", ";
+    s << " cR1: " << par->cR1 << ", ";
+    s << " cR2: " << par->cR2 << ", ";    
+    s << "  a1: " << par->a1 << ", ";
+    s << "  a2: " << par->a2 << ", ";
+    s << "  a3: " << par->a3 << ", ";
+    s << "  a4: " << par->a4;    
   }
   
   if (flag == OPS_PRINT_PRINTMODEL_JSON) {
     s << "\t\t\t{";
 	s << "\"name\": \"" << this->getTag() << "\", ";
 	s << "\"type\": \"Steel02\", ";
-	s << "\"E\": " << E0 << ", ";
-	s << "\"fy\": " << Fy << ", ";
-    s << "\"b\": " << b << ", ";
-    s << "\"R0\": " << R0 << ", ";
-    s << "\"cR1\": " << cR1 << ", ";
-    s << "\"cR2\": " << cR2 << ", ";
-    s << "\"a1\": " << a1 << ", ";
-    s << "\"a2\": " << a2 << ", ";
-    s << "\"a3\": " << a3 << ", ";
-    s << "\"a4\": " << a4 << ", ";    
-    s << "\"sigini\": " << sigini << "}";
+	s << "\"E\": " << par->E0 << ", ";
+	s << "\"fy\": " << par->Fy << ", ";
+    s << "\"b\": " << par->b << ", ";
+    s << "\"R0\": " << par->R0 << ", ";
+    s << "\"cR1\": " << par->cR1 << ", ";
+    s << "\"cR2\": " << par->cR2 << ", ";
+    s << "\"a1\": " << par->a1 << ", ";
+    s << "\"a2\": " << par->a2 << ", ";
+    s << "\"a3\": " << par->a3 << ", ";
+    s << "\"a4\": " << par->a4 << ", ";    
+    s << "\"sigini\": " << par->sigini << "}";
   }
 }
 
@@ -573,47 +662,47 @@ Steel02::setParameter(const char **argv, int argc, Parameter &param)
 {
 
   if (strcmp(argv[0],"sigmaY") == 0 || strcmp(argv[0],"fy") == 0 || strcmp(argv[0],"Fy") == 0) {
-    param.setValue(Fy);
+    param.setValue(par->Fy);
     return param.addObject(1, this);
   }
   if (strcmp(argv[0],"E") == 0) {
-    param.setValue(E0);
+    param.setValue(par->E0);
     return param.addObject(2, this);
   }
   if (strcmp(argv[0],"b") == 0) {
-    param.setValue(b);
+    param.setValue(par->b);
     return param.addObject(3, this);
   }
   if (strcmp(argv[0],"a1") == 0) {
-    param.setValue(a1);
+    param.setValue(par->a1);
     return param.addObject(4, this);
   }
   if (strcmp(argv[0],"a2") == 0) {
-    param.setValue(a2);
+    param.setValue(par->a2);
     return param.addObject(5, this);
   }
   if (strcmp(argv[0],"a3") == 0) {
-    param.setValue(a3);
+    param.setValue(par->a3);
     return param.addObject(6, this);
   }
   if (strcmp(argv[0],"a4") == 0) {
-    param.setValue(a4);
+    param.setValue(par->a4);
     return param.addObject(7, this);
   }
   if (strcmp(argv[0],"R0") == 0) {
-    param.setValue(R0);
+    param.setValue(par->R0);
     return param.addObject(8, this);
   }
   if (strcmp(argv[0],"cR1") == 0) {
-    param.setValue(cR1);
+    param.setValue(par->cR1);
     return param.addObject(9, this);
   }
   if (strcmp(argv[0],"cR2") == 0) {
-    param.setValue(cR2);
+    param.setValue(par->cR2);
     return param.addObject(10, this);
   }
   if (strcmp(argv[0],"sig0") == 0) {
-    param.setValue(sigini);
+    param.setValue(par->sigini);
     return param.addObject(11, this);
   }
 	
@@ -625,41 +714,43 @@ Steel02::setParameter(const char **argv, int argc, Parameter &param)
 int
 Steel02::updateParameter(int parameterID, Information &info)
 {
+  this->ownParameters();
+
   switch (parameterID) {
   case -1:
     return -1;
   case 1:
-    this->Fy = info.theDouble;
+    par->Fy = info.theDouble;
     break;
   case 2:
-    this->E0 = info.theDouble;
+    par->E0 = info.theDouble;
     break;
   case 3:
-    this->b = info.theDouble;
+    par->b = info.theDouble;
     break;
   case 4:
-    this->a1 = info.theDouble;
+    par->a1 = info.theDouble;
     break;
   case 5:
-    this->a2 = info.theDouble;
+    par->a2 = info.theDouble;
     break;
   case 6:
-    this->a3 = info.theDouble;
+    par->a3 = info.theDouble;
     break;
   case 7:
-    this->a4 = info.theDouble;
+    par->a4 = info.theDouble;
     break;
   case 8:
-    this->R0 = info.theDouble;
+    par->R0 = info.theDouble;
     break;
   case 9:
-    this->cR1 = info.theDouble;
+    par->cR1 = info.theDouble;
     break;
   case 10:
-    this->cR2 = info.theDouble;
+    par->cR2 = info.theDouble;
     break;
   case 11:
-    this->sigini = info.theDouble;
+    par->sigini = info.theDouble;
     break;	  
   default:
     return -1;
@@ -668,4 +759,11 @@ Steel02::updateParameter(int parameterID, Information &info)
   return 0;
 }
 
-
+// gives this material its own copy of the parameters before they are
+// changed, if they are shared with other copies
+void
+Steel02::ownParameters(void)
+{
+  if (par.use_count() > 1)
+    par = std::make_shared<Parameters>(*par);
+}
@@ -40,6 +40,7 @@
 #define Steel02_h
 
 #include <UniaxialMaterial.h>
+#include <memory>
 
 class Steel02 : public UniaxialMaterial
 {
@@ -47,16 +48,17 @@ class Steel02 : public UniaxialMaterial
     Steel02(int tag,
 	    double fy, double E0, double b,
 	    double R0, double cR1, double cR2,
-	    double a1, double a2, double a3, double a4, double sigInit =0.0);
+	    double a1, double a2, double a3, double a4, double sigInit =0.0,
+	    bool implex =false);
     
     // Constructor for no isotropic hardening
     Steel02(int tag,
 	    double fy, double E0, double b,
-	    double R0, double cR1, double cR2);
+	    double R0, double cR1, double cR2, bool implex =false);
     
     // Constructor for no isotropic hardening
     // Also provides default values for R0, cR1, and cR2
-    Steel02(int tag, double fy, double E0, double b);
+    Steel02(int tag, double fy, double E0, double b, bool implex =false);
 	    
     Steel02(void);
     virtual ~Steel02();
@@ -74,6 +76,10 @@ class Steel02 : public UniaxialMaterial
     
     int commitState(void);
     int revertToLastCommit(void);    
+    int setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                      double *stress, double *tangent);
+    int commitStateBatch(int n, UniaxialMaterial **theMaterials);
+    int revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials);
     int revertToStart(void);        
     
     int sendSelf(int commitTag, Channel &theChannel);  
@@ -91,19 +97,28 @@ class Steel02 : public UniaxialMaterial
  protected:
     
  private:
+    // matpar : STEEL FIXED PROPERTIES, shared by the copies of a material
+    // until one of them has a parameter updated
+    struct Parameters {
+      double Fy;  //  = matpar(1)  : yield stress
+      double E0;  //  = matpar(2)  : initial stiffness
+      double b;   //  = matpar(3)  : hardening ratio (Esh/E0)
+      double R0;  //  = matpar(4)  : exp transition elastic-plastic
+      double cR1; //  = matpar(5)  : coefficient for changing R0 to R
+      double cR2; //  = matpar(6)  : coefficient for changing R0 to R
+      double a1;  //  = matpar(7)  : coefficient for isotropic hardening in compression
+      double a2;  //  = matpar(8)  : coefficient for isotropic hardening in compression
+      double a3;  //  = matpar(9)  : coefficient for isotropic hardening in tension
+      double a4;  //  = matpar(10) : coefficient for isotropic hardening in tension
+      double sigini; // initial 
+      bool implex;   // IMPL-EX integration, see Material
+    };
+    std::shared_ptr<Parameters> par;
+    Steel02(int tag, const std::shared_ptr<Parameters> &par);
+    void ownParameters(void);
+    int implicitTrial(double trialStrain);
+
 	 double EnergyP; //by SAJalali
-	 // matpar : STEEL FIXED PROPERTIES
-    double Fy;  //  = matpar(1)  : yield stress
-    double E0;  //  = matpar(2)  : initial stiffness
-    double b;   //  = matpar(3)  : hardening ratio (Esh/E0)
-    double R0;  //  = matpar(4)  : exp transition elastic-plastic
-    double cR1; //  = matpar(5)  : coefficient for changing R0 to R
-    double cR2; //  = matpar(6)  : coefficient for changing R0 to R
-    double a1;  //  = matpar(7)  : coefficient for isotropic hardening in compression
-    double a2;  //  = matpar(8)  : coefficient for isotropic hardening in compression
-    double a3;  //  = matpar(9)  : coefficient for isotropic hardening in tension
-    double a4;  //  = matpar(10) : coefficient for isotropic hardening in tension
-    double sigini; // initial 
     // hstvP : STEEL HISTORY VARIABLES
     double epsminP; //  = hstvP(1) : max eps in compression
     double epsmaxP; //  = hstvP(2) : max eps in tension
@@ -112,7 +127,6 @@ class Steel02 : public UniaxialMaterial
     double sigs0P;  //  = hstvP(5) : sig at asymptotes intersection
     double epssrP;  //  = hstvP(6) : eps at last inversion point
     double sigsrP;  //  = hstvP(7) : sig at last inversion point
-    int    konP;    //  = hstvP(8) : index for loading/unloading
     // hstv : STEEL HISTORY VARIABLES   
     double epsP;  //  = strain at previous converged step
     double sigP;  //  = stress at previous converged step
@@ -125,10 +139,23 @@ class Steel02 : public UniaxialMaterial
     double sigs0; 
     double epsr;  
     double sigr;  
-    int    kon;    
     double sig;   
     double e;     
     double eps;   //  = strain at current step
+    int    konP;    //  = hstvP(8) : index for loading/unloading
+    int    kon;    
+
+    // set when the trial history variables above have not been computed
+    // since the last revert, so that a commit leaves the committed ones
+    // alone and a revert only has to restore the strain, stress and tangent
+    bool historyReverted = true;
+
+    // IMPL-EX: the inelastic strain eps - sig/E0 at the last two
+    // committed steps & the time steps they were reached with
+    double epsInP = 0.0;
+    double epsInPP = 0.0;
+    double dtP = 0.0;
+    double dt = 0.0;
 };
 
 
@@ -44,6 +44,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theUniaxialMaterialObjects;
+static bool theUniaxialMaterialObjectsRegistered = MapOfTaggedObjects::addModelStorage(theUniaxialMaterialObjects);
 
 bool OPS_addUniaxialMaterial(UniaxialMaterial *newComponent) {
   return theUniaxialMaterialObjects.addComponent(newComponent);
@@ -162,6 +163,40 @@ UniaxialMaterial::setTrial(double strain, double temperature, double &stress, do
 }
 
 
+// default operation for a batch of materials is to invoke setTrial() on each,
+// subclasses can override to avoid the virtual call per material
+int
+UniaxialMaterial::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain, 
+				double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += theMaterials[i]->setTrial(strain[i], stress[i], tangent[i]);
+
+  return res;
+}
+
+int
+UniaxialMaterial::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += theMaterials[i]->commitState();
+
+  return res;
+}
+
+int
+UniaxialMaterial::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += theMaterials[i]->revertToLastCommit();
+
+  return res;
+}
+
+
 // default operation for strain rate is zero
 double
 UniaxialMaterial::getStrainRate(void)
@@ -61,6 +61,11 @@ class UniaxialMaterial : public Material
     virtual int setTrial (double strain, double &stress, double &tangent, double strainRate = 0.0);
     virtual int setTrial (double strain, double temperature, double &stress, double &tangent, double &thermalElongation, double strainRate = 0.0);
 
+    // sets the trial strain of n materials of the same class as this one, 
+    // i.e. theMaterials[i]->setTrial(strain[i], stress[i], tangent[i]) 
+    virtual int setTrialBatch (int n, UniaxialMaterial **theMaterials, const double *strain, 
+			       double *stress, double *tangent);
+
     virtual double getStrain (void) = 0;
     virtual double getStrainRate (void);
     virtual double getStress (void) = 0;
@@ -72,6 +77,11 @@ class UniaxialMaterial : public Material
     virtual int commitState (void) = 0;
     virtual int revertToLastCommit (void) = 0;    
     virtual int revertToStart (void) = 0;        
+
+    // batch versions of commitState() and revertToLastCommit() for n
+    // materials of the same class as this one, see setTrialBatch()
+    virtual int commitStateBatch (int n, UniaxialMaterial **theMaterials);
+    virtual int revertToLastCommitBatch (int n, UniaxialMaterial **theMaterials);
     
     virtual UniaxialMaterial *getCopy (void) = 0;
     virtual UniaxialMaterial *getCopy(SectionForceDeformation *s);
@@ -159,6 +159,89 @@ WrapperUniaxialMaterial::revertToStart (void)
   return error;
 }
 
+// the batch operations hand runs of materials sharing a batched entry
+// point to the library in one call, pointing it to the strain, stress and
+// tangent of each wrapper; the others are invoked one at a time
+int
+WrapperUniaxialMaterial::invokeBatch(int n, UniaxialMaterial **theMaterials, int isw,
+                                     const double *strain, double *stress, double *tangent)
+{
+  const int chunk = 64;
+  matObject *mats[chunk];
+  double *e[chunk], *t[chunk], *s[chunk];
+
+  int res = 0;
+  int i = 0;
+  while (i < n) {
+    WrapperUniaxialMaterial *theMat = static_cast<WrapperUniaxialMaterial *>(theMaterials[i]);
+    matBatchFunct theFunct = theMat->theMat->matBatchFunctPtr;
+
+    if (theFunct == 0) {
+      int iswi = isw;
+      int error = 0;
+      if (strain != 0)
+	theMat->strain = strain[i];
+      theMat->theMat->matFunctPtr(theMat->theMat, &theModelState, &theMat->strain,
+				  &theMat->tangent, &theMat->stress, &iswi, &error);
+      if (stress != 0) {
+	stress[i] = theMat->stress;
+	tangent[i] = theMat->tangent;
+      }
+      res += error;
+      i++;
+      continue;
+    }
+
+    int start = i;
+    int m = 0;
+    while (i < n && m < chunk) {
+      theMat = static_cast<WrapperUniaxialMaterial *>(theMaterials[i]);
+      if (theMat->theMat->matBatchFunctPtr != theFunct)
+	break;
+      if (strain != 0)
+	theMat->strain = strain[i];
+      mats[m] = theMat->theMat;
+      e[m] = &theMat->strain;
+      t[m] = &theMat->tangent;
+      s[m] = &theMat->stress;
+      m++;
+      i++;
+    }
+
+    int iswi = isw;
+    int error = 0;
+    theFunct(m, mats, &theModelState, e, t, s, &iswi, &error);
+    res += error;
+
+    if (stress != 0)
+      for (int k = 0; k < m; k++) {
+	stress[start+k] = *s[k];
+	tangent[start+k] = *t[k];
+      }
+  }
+
+  return res;
+}
+
+int
+WrapperUniaxialMaterial::setTrialBatch(int n, UniaxialMaterial **theMaterials, const double *strain,
+                                       double *stress, double *tangent)
+{
+  return invokeBatch(n, theMaterials, ISW_FORM_TANG_AND_RESID, strain, stress, tangent);
+}
+
+int
+WrapperUniaxialMaterial::commitStateBatch(int n, UniaxialMaterial **theMaterials)
+{
+  return invokeBatch(n, theMaterials, ISW_COMMIT, 0, 0, 0);
+}
+
+int
+WrapperUniaxialMaterial::revertToLastCommitBatch(int n, UniaxialMaterial **theMaterials)
+{
+  return invokeBatch(n, theMaterials, ISW_REVERT, 0, 0, 0);
+}
+
 UniaxialMaterial *
 WrapperUniaxialMaterial::getCopy (void) 
 {
@@ -178,6 +261,7 @@ WrapperUniaxialMaterial::getCopy (void)
     }
 
     theMatObject->matFunctPtr = theMat->matFunctPtr;
+    theMatObject->matBatchFunctPtr = theMat->matBatchFunctPtr;
 
     WrapperUniaxialMaterial *theResult = new WrapperUniaxialMaterial(funcName, theMatObject);
     return theResult;
@@ -53,6 +53,11 @@ class WrapperUniaxialMaterial : public UniaxialMaterial
   int commitState (void);
   int revertToLastCommit (void);    
   int revertToStart (void);        
+
+  int setTrialBatch (int n, UniaxialMaterial **theMaterials, const double *strain,
+                     double *stress, double *tangent);
+  int commitStateBatch (int n, UniaxialMaterial **theMaterials);
+  int revertToLastCommitBatch (int n, UniaxialMaterial **theMaterials);
   
   UniaxialMaterial *getCopy (void);
 
@@ -71,6 +76,9 @@ class WrapperUniaxialMaterial : public UniaxialMaterial
   double stress;
   double tangent;
   double initTangent;
+
+  static int invokeBatch(int n, UniaxialMaterial **theMaterials, int isw,
+                         const double *strain, double *stress, double *tangent);
 };
 
 #endif
@@ -34,6 +34,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theHystereticBackboneObjects;
+static bool theHystereticBackboneObjectsRegistered = MapOfTaggedObjects::addModelStorage(theHystereticBackboneObjects);
 
 bool OPS_addHystereticBackbone(HystereticBackbone *newComponent) {
   return theHystereticBackboneObjects.addComponent(newComponent);
@@ -81,7 +81,7 @@ OPS_MultilinearBackbone(void)
 MultilinearBackbone::MultilinearBackbone(int tag, int num,
 					 const Vector &def, const Vector &force):
   HystereticBackbone(tag,BACKBONE_TAG_Multilinear),
-  E(0), e(0), s(0), c(0), numPoints(num)
+  E(0), e(0), s(0), c(0), numPoints(num), lastSegment(1)
 {
   E = new double [numPoints];
   if (E == 0)
@@ -130,7 +130,7 @@ MultilinearBackbone::MultilinearBackbone(int tag, int num,
 
 MultilinearBackbone::MultilinearBackbone():
   HystereticBackbone(0,BACKBONE_TAG_Multilinear), 
-  E(0), e(0), s(0), c(0), numPoints(0)
+  E(0), e(0), s(0), c(0), numPoints(0), lastSegment(1)
 {
 
 }
@@ -153,10 +153,9 @@ MultilinearBackbone::~MultilinearBackbone()
 double
 MultilinearBackbone::getTangent (double strain)
 {
-  for (int i = 1; i <= numPoints; i++) {
-    if (strain < e[i])
-      return E[i-1];
-  }
+  int i = this->findSegment(strain);
+  if (i <= numPoints)
+    return E[i-1];
   
   return E[0]*1.0e-9;
 }
@@ -164,10 +163,9 @@ MultilinearBackbone::getTangent (double strain)
 double
 MultilinearBackbone::getStress (double strain)
 {
-  for (int i = 1; i <= numPoints; i++) {
-    if (strain < e[i])
-      return s[i-1] + E[i-1]*(strain-e[i-1]);
-  }
+  int i = this->findSegment(strain);
+  if (i <= numPoints)
+    return s[i-1] + E[i-1]*(strain-e[i-1]);
   
   return s[numPoints];
 }
@@ -175,14 +173,38 @@ MultilinearBackbone::getStress (double strain)
 double
 MultilinearBackbone::getEnergy (double strain)
 {
-  for (int i = 1; i <= numPoints; i++) {
-    if (strain < e[i])
-      return c[i-1] + 0.5*E[i-1]*(strain-e[i-1])*(strain-e[i-1]);
-  }
+  int i = this->findSegment(strain);
+  if (i <= numPoints)
+    return c[i-1] + 0.5*E[i-1]*(strain-e[i-1])*(strain-e[i-1]);
   
   return c[numPoints] + s[numPoints]*(strain-e[numPoints]);
 }
 
+// first i with strain < e[i], numPoints+1 if there is none. The segment
+// of the last call is tried first, the material asks for the stress and
+// the tangent at the same strain and the strain moves little between
+// steps, otherwise the sorted strains are bisected
+int
+MultilinearBackbone::findSegment (double strain)
+{
+  int i = lastSegment;
+  if (i >= 1 && i <= numPoints && strain < e[i] && (i == 1 || strain >= e[i-1]))
+    return i;
+
+  int lo = 1;
+  int hi = numPoints+1;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (strain < e[mid])
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  lastSegment = lo;
+  return lo;
+}
+
 double
 MultilinearBackbone::getYieldStrain(void)
 {
@@ -69,6 +69,9 @@ class MultilinearBackbone : public HystereticBackbone
   double *s;
   double *c;
   int numPoints;
+
+  int lastSegment;  // segment of the last lookup, see findSegment
+  int findSegment(double strain);
 };
 
 #endif
@@ -41,6 +41,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theLimitCurveObjects;
+static bool theLimitCurveObjectsRegistered = MapOfTaggedObjects::addModelStorage(theLimitCurveObjects);
 
 
 bool OPS_addLimitCurve(LimitCurve *newComponent) {
@@ -34,6 +34,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theStiffnessDegradationObjects;
+static bool theStiffnessDegradationObjectsRegistered = MapOfTaggedObjects::addModelStorage(theStiffnessDegradationObjects);
 
 bool OPS_addStiffnessDegradation(StiffnessDegradation *newComponent)
 {
@@ -34,6 +34,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theStrengthDegradationObjects;
+static bool theStrengthDegradationObjectsRegistered = MapOfTaggedObjects::addModelStorage(theStrengthDegradationObjects);
 
 bool OPS_addStrengthDegradation(StrengthDegradation *newComponent)
 {
@@ -34,6 +34,7 @@
 #include <MapOfTaggedObjects.h>
 
 static MapOfTaggedObjects theUnloadingRuleObjects;
+static bool theUnloadingRuleObjectsRegistered = MapOfTaggedObjects::addModelStorage(theUnloadingRuleObjects);
 
 bool OPS_addUnloadingRule(UnloadingRule *newComponent)
 {
@@ -15,6 +15,7 @@ const int YieldSurface_BC::SurfOnly(5);
 const int YieldSurface_BC::StateLoading(6);
 
 static MapOfTaggedObjects theYieldSurface_BCObjects;
+static bool theYieldSurface_BCObjectsRegistered = MapOfTaggedObjects::addModelStorage(theYieldSurface_BCObjects);
 
 bool OPS_addYieldSurface_BC(YieldSurface_BC *newComponent)
 {
@@ -34,14 +34,19 @@
 #include "Matrix.h"
 #include "Vector.h"
 #include "ID.h"
+#include "MatrixPool.h"
 
 #include <stdlib.h>
 #include <iostream>
+#include <utility>
 using std::nothrow;
 
 #define MATRIX_WORK_AREA 400
 #define INT_WORK_AREA 20
 
+// products with at least this many multiplications are passed to dgemm
+#define MATRIX_BLAS_MULTS 262144
+
 #include <math.h>
 
 int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
@@ -101,8 +106,7 @@ Matrix::Matrix(int nRows,int nCols)
     data = 0;
 
     if (dataSize > 0) {
-      data = new (nothrow) double[dataSize];
-      //data = (double *)malloc(dataSize*sizeof(double));
+      data = MatrixPool::allocate(dataSize);
       if (data == 0) {
 	opserr << "WARNING:Matrix::Matrix(int,int): Ran out of memory on init ";
 	opserr << "of size " << dataSize << endln;
@@ -163,8 +167,7 @@ Matrix::Matrix(const Matrix &other)
     dataSize = other.dataSize;
 
     if (dataSize != 0) {
-      data = new (nothrow) double[dataSize];
-      // data = (double *)malloc(dataSize*sizeof(double));
+      data = MatrixPool::allocate(dataSize);
       if (data == 0) {
 	opserr << "WARNING:Matrix::Matrix(Matrix &): ";
 	opserr << "Ran out of memory on init of size " << dataSize << endln; 
@@ -180,7 +183,6 @@ Matrix::Matrix(const Matrix &other)
 }
 
 // Move ctor
-#ifdef USE_CXX11
 Matrix::Matrix(Matrix &&other)
 :numRows(other.numRows), numCols(other.numCols), dataSize(other.dataSize), data(other.data), fromFree(other.fromFree)
 {
@@ -190,7 +192,6 @@ Matrix::Matrix(Matrix &&other)
   other.data = 0;
   other.fromFree = 1;
 }
-#endif
 
 //
 // DESTRUCTOR
@@ -200,11 +201,10 @@ Matrix::~Matrix()
 {
   if (data != 0 ) {
     if (fromFree == 0 && dataSize > 0){
-      delete [] data; 
+      MatrixPool::release(data);
       data = 0;
     }
   }
-  //  if (data != 0) free((void *) data);
 }
     
 
@@ -219,7 +219,7 @@ Matrix::setData(double *theData, int row, int col)
   if (data != 0) 
     if (fromFree == 0)
     {
-      delete [] data; 
+      MatrixPool::release(data);
       data = 0;
     }
   numRows = row;
@@ -270,15 +270,13 @@ Matrix::resize(int rows, int cols) {
     // free the old space
     if (data != 0) 
       if (fromFree == 0){
-	delete [] data; 
+	MatrixPool::release(data);
         data = 0;
       }
-    //  if (data != 0) free((void *) data);
 
     fromFree = 0;
     // create new space
-    data = new (nothrow) double[newSize];
-    // data = (double *)malloc(dataSize*sizeof(double));
+    data = MatrixPool::allocate(newSize);
     if (data == 0) {
       opserr << "Matrix::resize(" << rows << "," << cols << ") - out of memory\n";
       numRows = 0; numCols =0; dataSize = 0;
@@ -342,6 +340,10 @@ extern "C" int  DGETRS(char *TRANS, unsigned int sizeT,
 
 extern "C" int  DGETRI(int *N, double *A, int *LDA, 
 			      int *iPiv, double *Work, int *WORKL, int *INFO);
+
+extern "C" int  DGEMM(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
 //#endif
 #else
 extern "C" int dgesv_(int *N, int *NRHS, double *A, int *LDA, int *iPiv, 
@@ -360,6 +362,10 @@ extern "C" int dgerfs_(char *TRANS, int *N, int *NRHS, double *A, int *LDA,
 		       double *X, int *LDX, double *FERR, double *BERR, 
 		       double *WORK, int *IWORK, int *INFO);
 
+extern "C" int dgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
+
 #endif
 
 int
@@ -807,6 +813,23 @@ Matrix::addMatrixProduct(double thisFact,
       return -1;
     }
 #endif
+    if (numRows*numCols*B.numCols >= MATRIX_BLAS_MULTS) {
+      char N = 'N';
+      int m = numRows;
+      int n = numCols;
+      int k = B.numCols;
+      int ldB = B.numRows;
+      int ldC = C.numRows;
+#ifdef _WIN32
+      DGEMM(&N, &N, &m, &n, &k, &otherFact, B.data, &ldB, C.data, &ldC,
+	    &thisFact, data, &m);
+#else
+      dgemm_(&N, &N, &m, &n, &k, &otherFact, B.data, &ldB, C.data, &ldC,
+	     &thisFact, data, &m);
+#endif
+      return 0;
+    }
+
     // NOTE: looping as per blas3 dgemm_: j,k,i
     if (thisFact == 1.0) {
 
@@ -883,6 +906,22 @@ Matrix::addMatrixTransposeProduct(double thisFact,
   }
 #endif
 
+  if (numRows*numCols*C.numRows >= MATRIX_BLAS_MULTS) {
+    char N = 'N';
+    char T = 'T';
+    int m = numRows;
+    int n = numCols;
+    int k = C.numRows;
+#ifdef _WIN32
+    DGEMM(&T, &N, &m, &n, &k, &otherFact, B.data, &k, C.data, &k,
+	  &thisFact, data, &m);
+#else
+    dgemm_(&T, &N, &m, &n, &k, &otherFact, B.data, &k, C.data, &k,
+	   &thisFact, data, &m);
+#endif
+    return 0;
+  }
+
   if (thisFact == 1.0) {
     int numMults = C.numRows;
     double *aijPtr = data;
@@ -931,6 +970,65 @@ Matrix::addMatrixTransposeProduct(double thisFact,
   return 0;
 }
 
+// tripleProduct<NB,NC>(A, T, B, thisFact, otherFact)
+//	A = A*thisFact + T'*B*T*otherFact for a NBxNC T and a NBxNB B, the
+//	sizes of the coordinate transformations and the beam elements. With
+//	the sizes known at compile time the loops are unrolled and, the
+//	second product being done on a transposed copy of T, both products
+//	vectorize along the columns. The sums are taken in the same order as
+//	the general loops below, so the results are identical.
+
+template <int NB, int NC>
+static void
+tripleProduct(double *A, const double *T, const double *B,
+	      double thisFact, double otherFact)
+{
+  double work[NB*NC];
+  double Tt[NC*NB];
+
+  // work = B * T * otherFact, looping as per blas3 dgemm_: j,k,i
+  for (int j=0; j<NC; j++) {
+    double *wj = &work[j*NB];
+    for (int i=0; i<NB; i++)
+      wj[i] = 0.0;
+    for (int k=0; k<NB; k++) {
+      double tmp = T[j*NB+k] * otherFact;
+      const double *bk = &B[k*NB];
+      for (int i=0; i<NB; i++)
+	wj[i] += bk[i] * tmp;
+    }
+  }
+
+  for (int j=0; j<NC; j++)
+    for (int k=0; k<NB; k++)
+      Tt[k*NC+j] = T[j*NB+k];
+
+  // A = A * thisFact + T' * work
+  for (int j=0; j<NC; j++) {
+    double aj[NC];
+    for (int i=0; i<NC; i++)
+      aj[i] = 0.0;
+    const double *wj = &work[j*NB];
+    for (int k=0; k<NB; k++) {
+      double tmp = wj[k];
+      const double *tk = &Tt[k*NC];
+      for (int i=0; i<NC; i++)
+	aj[i] += tk[i] * tmp;
+    }
+
+    double *Aj = &A[j*NC];
+    if (thisFact == 1.0)
+      for (int i=0; i<NC; i++)
+	Aj[i] += aj[i];
+    else if (thisFact == 0.0)
+      for (int i=0; i<NC; i++)
+	Aj[i] = aj[i];
+    else
+      for (int i=0; i<NC; i++)
+	Aj[i] = Aj[i] * thisFact + aj[i];
+  }
+}
+
 
 // to perform this += T' * B * T
 int
@@ -949,15 +1047,59 @@ Matrix::addMatrixTripleProduct(double thisFact,
     }
 #endif
 
-    // cheack work area can hold the temporary matrix
     int dimB = B.numCols;
-    int sizeWork = dimB * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
-      this->addMatrix(thisFact, T^B*T, otherFact);
+    // the common small sizes have their own kernels
+    if (dimB == numCols) {
+      switch (dimB) {
+      case 3:
+	tripleProduct<3,3>(data, T.data, B.data, thisFact, otherFact);
+	return 0;
+      case 6:
+	tripleProduct<6,6>(data, T.data, B.data, thisFact, otherFact);
+	return 0;
+      case 12:
+	tripleProduct<12,12>(data, T.data, B.data, thisFact, otherFact);
+	return 0;
+      case 24:
+	tripleProduct<24,24>(data, T.data, B.data, thisFact, otherFact);
+	return 0;
+      default:
+	break;
+      }
+    } else if (dimB == 3 && numCols == 6) {
+      tripleProduct<3,6>(data, T.data, B.data, thisFact, otherFact);
+      return 0;
+    } else if (dimB == 6 && numCols == 12) {
+      tripleProduct<6,12>(data, T.data, B.data, thisFact, otherFact);
+      return 0;
+    } else if (dimB == 6 && numCols == 7) {
+      // the two steps of CorotCrdTransf3d, basic to local to global
+      tripleProduct<6,7>(data, T.data, B.data, thisFact, otherFact);
+      return 0;
+    } else if (dimB == 7 && numCols == 12) {
+      tripleProduct<7,12>(data, T.data, B.data, thisFact, otherFact);
       return 0;
     }
 
+    // check work area can hold the temporary matrix
+    int sizeWork = dimB * numCols;
+
+    if (sizeWork > sizeDoubleWork || matrixWork == 0) {
+      if (matrixWork != 0) {
+	delete [] matrixWork;
+	matrixWork = 0;
+      }
+      matrixWork = new (nothrow) double[sizeWork];
+      sizeDoubleWork = sizeWork;
+
+      if (matrixWork == 0) {
+	opserr << "WARNING: Matrix::addMatrixTripleProduct() - out of memory creating work area's\n";
+	sizeDoubleWork = 0;
+	return -3;
+      }
+    }
+
     // zero out the work area
     double *matrixWorkPtr = matrixWork;
     for (int l=0; l<sizeWork; l++)
@@ -1048,12 +1190,22 @@ Matrix::addMatrixTripleProduct(double thisFact,
     }
 #endif
 
-    // cheack work area can hold the temporary matrix
+    // check work area can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
-      this->addMatrix(thisFact, A^B*C, otherFact);
-      return 0;
+    if (sizeWork > sizeDoubleWork || matrixWork == 0) {
+      if (matrixWork != 0) {
+	delete [] matrixWork;
+	matrixWork = 0;
+      }
+      matrixWork = new (nothrow) double[sizeWork];
+      sizeDoubleWork = sizeWork;
+
+      if (matrixWork == 0) {
+	opserr << "WARNING: Matrix::addMatrixTripleProduct() - out of memory creating work area's\n";
+	sizeDoubleWork = 0;
+	return -3;
+      }
     }
 
     // zero out the work area
@@ -1177,16 +1329,17 @@ Matrix::operator=(const Matrix &other)
       opserr << "Matrix::operator=() - matrix dimensions do not match\n";
 #endif
 
-      if (this->data != 0)
+      if (this->data != 0 && fromFree == 0)
       {
-	  delete [] this->data;
+	  MatrixPool::release(this->data);
           this->data = 0;
       }
       
       int theSize = other.numCols*other.numRows;
       
-      data = new (nothrow) double[theSize];
+      data = MatrixPool::allocate(theSize);
       
+      this->fromFree = 0;
       this->dataSize = theSize;
       this->numCols = other.numCols;
       this->numRows = other.numRows;
@@ -1205,7 +1358,6 @@ Matrix::operator=(const Matrix &other)
 
 // Move assignment
 //
-#ifdef USE_CXX11
 Matrix &
 Matrix::operator=( Matrix &&other)
 {
@@ -1215,7 +1367,7 @@ Matrix::operator=( Matrix &&other)
 
 
   if (this->data != 0 && fromFree == 0){
-    delete [] this->data;
+    MatrixPool::release(this->data);
     this->data = 0;
   }
         
@@ -1232,7 +1384,6 @@ Matrix::operator=( Matrix &&other)
 
   return *this;
 }
-#endif
 
 
 // virtual Matrix &operator+=(double fact);
@@ -1324,7 +1475,7 @@ Matrix::operator/=(double fact)
 //	The above methods all return a new full general matrix.
 
 Matrix
-Matrix::operator+(double fact) const
+Matrix::operator+(double fact) const &
 {
     Matrix result(*this);
     result += fact;
@@ -1332,7 +1483,7 @@ Matrix::operator+(double fact) const
 }
 
 Matrix
-Matrix::operator-(double fact) const
+Matrix::operator-(double fact) const &
 {
     Matrix result(*this);
     result -= fact;
@@ -1340,7 +1491,7 @@ Matrix::operator-(double fact) const
 }
 
 Matrix
-Matrix::operator*(double fact) const
+Matrix::operator*(double fact) const &
 {
     Matrix result(*this);
     result *= fact;
@@ -1348,7 +1499,7 @@ Matrix::operator*(double fact) const
 }
 
 Matrix
-Matrix::operator/(double fact) const
+Matrix::operator/(double fact) const &
 {
     if (fact == 0.0) {
 	opserr << "Matrix::operator/(const double &fact): ERROR divide-by-zero\n";
@@ -1360,6 +1511,51 @@ Matrix::operator/(double fact) const
 }
 
 
+//    Matrix operator+(double fact) &&; etc.
+//	The same operations on a temporary matrix reuse its data for the
+//	result. A temporary wrapping external data is not written to.
+
+Matrix
+Matrix::operator+(double fact) &&
+{
+    if (fromFree != 0)
+	return *this + fact;
+    *this += fact;
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator-(double fact) &&
+{
+    if (fromFree != 0)
+	return *this - fact;
+    *this -= fact;
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator*(double fact) &&
+{
+    if (fromFree != 0)
+	return *this * fact;
+    *this *= fact;
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator/(double fact) &&
+{
+    if (fromFree != 0)
+	return *this / fact;
+    if (fact == 0.0) {
+	opserr << "Matrix::operator/(const double &fact): ERROR divide-by-zero\n";
+	exit(0);
+    }
+    *this /= fact;
+    return std::move(*this);
+}
+
+
 //
 // MATRIX_VECTOR OPERATIONS
 //
@@ -1422,7 +1618,7 @@ Matrix::operator^(const Vector &V) const
 	    
 
 Matrix
-Matrix::operator+(const Matrix &M) const
+Matrix::operator+(const Matrix &M) const &
 {
     Matrix result(*this);
     result.addMatrix(1.0,M,1.0);    
@@ -1430,12 +1626,73 @@ Matrix::operator+(const Matrix &M) const
 }
 	    
 Matrix
-Matrix::operator-(const Matrix &M) const
+Matrix::operator-(const Matrix &M) const &
 {
     Matrix result(*this);
     result.addMatrix(1.0,M,-1.0);    
     return result;
 }
+
+Matrix
+Matrix::operator+(const Matrix &M) &&
+{
+    if (fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this + M;
+    this->addMatrix(1.0,M,1.0);
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator-(const Matrix &M) &&
+{
+    if (fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this - M;
+    this->addMatrix(1.0,M,-1.0);
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator+(Matrix &&M) const &
+{
+    if (M.fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this + M;
+    M.addMatrix(1.0,*this,1.0);
+    return std::move(M);
+}
+
+Matrix
+Matrix::operator-(Matrix &&M) const &
+{
+    if (M.fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this - M;
+    M.addMatrix(-1.0,*this,1.0);
+    return std::move(M);
+}
+
+// with two temporaries, e.g. (A*2.0)+(B*3.0), the left one is reused
+Matrix
+Matrix::operator+(Matrix &&M) &&
+{
+    if (fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this + std::move(M);
+    this->addMatrix(1.0,M,1.0);
+    return std::move(*this);
+}
+
+Matrix
+Matrix::operator-(Matrix &&M) &&
+{
+    if (fromFree != 0 || numRows != M.numRows || numCols != M.numCols ||
+	dataSize != M.dataSize)
+	return *this - std::move(M);
+    this->addMatrix(1.0,M,-1.0);
+    return std::move(*this);
+}
 	    
     
 Matrix
@@ -1783,6 +2040,11 @@ Matrix operator*(double a, const Matrix &V)
   return V * a;
 }
 
+Matrix operator*(double a, Matrix &&V)
+{
+  return std::move(V) * a;
+}
+
 
 
 
@@ -53,9 +53,7 @@ class Matrix
     Matrix(int nrows, int ncols);
     Matrix(double *data, int nrows, int ncols);    
     Matrix(const Matrix &M);    
-#ifdef USE_CXX11
     Matrix( Matrix &&M);    
-#endif
     ~Matrix();
 
     // utility methods
@@ -87,9 +85,7 @@ class Matrix
     
     Matrix &operator=(const Matrix &M);
 
-#ifdef USE_CXX11
     Matrix &operator=(Matrix &&M);
-#endif
     
     // matrix operations which will preserve the derived type and
     // which can be implemented efficiently without many constructor calls.
@@ -105,10 +101,16 @@ class Matrix
     // however are useful for matlab like expressions involving Matrices.
 
     // matrix-scalar operations
-    Matrix operator+(double fact) const;
-    Matrix operator-(double fact) const;
-    Matrix operator*(double fact) const;
-    Matrix operator/(double fact) const;
+    Matrix operator+(double fact) const &;
+    Matrix operator-(double fact) const &;
+    Matrix operator*(double fact) const &;
+    Matrix operator/(double fact) const &;
+
+    // on a temporary the result is computed in place of its data
+    Matrix operator+(double fact) &&;
+    Matrix operator-(double fact) &&;
+    Matrix operator*(double fact) &&;
+    Matrix operator/(double fact) &&;
     
     // matrix-vector operations
     Vector operator*(const Vector &V) const;
@@ -116,8 +118,14 @@ class Matrix
 
     
     // matrix-matrix operations
-    Matrix operator+(const Matrix &M) const;
-    Matrix operator-(const Matrix &M) const;
+    Matrix operator+(const Matrix &M) const &;
+    Matrix operator-(const Matrix &M) const &;
+    Matrix operator+(const Matrix &M) &&;
+    Matrix operator-(const Matrix &M) &&;
+    Matrix operator+(Matrix &&M) const &;
+    Matrix operator-(Matrix &&M) const &;
+    Matrix operator+(Matrix &&M) &&;
+    Matrix operator-(Matrix &&M) &&;
     Matrix operator*(const Matrix &M) const;
 //     Matrix operator/(const Matrix &M) const;    
     Matrix operator^(const Matrix &M) const;
@@ -140,6 +148,7 @@ class Matrix
     friend OPS_Stream &operator<<(OPS_Stream &s, const Matrix &M);
     //    friend istream &operator>>(istream &s, Matrix &M);    
     friend Matrix operator*(double a, const Matrix &M);
+    friend Matrix operator*(double a, Matrix &&M);
     
     
     friend class Vector;    
@@ -148,9 +157,12 @@ class Matrix
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
+    friend class SharedMemoryChannel;
+    friend class BufferedChannel;
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class MemoryDatastore;
 
   protected:
 
@@ -0,0 +1,145 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for MatrixPool.
+//
+// What: "@(#) MatrixPool.cpp, revA"
+
+#include "MatrixPool.h"
+#include <new>
+
+// each block starts with a header of two doubles holding the size class
+// of the block (-1 if it is not pooled); two keep the data 16 byte aligned
+#define MATRIX_POOL_HEADER 2
+#define MATRIX_POOL_NUM_CLASSES 13     // 1, 2, 4, ..., 4096 doubles
+#define MATRIX_POOL_MAX_CACHED 65536   // doubles kept per class and thread
+
+namespace {
+
+  struct FreeLists {
+    double *head[MATRIX_POOL_NUM_CLASSES];
+    int count[MATRIX_POOL_NUM_CLASSES];
+
+    FreeLists();
+    ~FreeLists();
+  };
+
+  // set once the lists of the thread are destroyed, blocks released
+  // after that (by static objects at exit) are simply deleted
+  thread_local bool listsClosed = false;
+  thread_local FreeLists theLists;
+
+  inline double *&
+  nextBlock(double *block)
+  {
+    return *reinterpret_cast<double **>(block + MATRIX_POOL_HEADER);
+  }
+
+  inline int &
+  blockClass(double *block)
+  {
+    return *reinterpret_cast<int *>(block);
+  }
+
+  FreeLists::FreeLists()
+  {
+    for (int i = 0; i < MATRIX_POOL_NUM_CLASSES; i++) {
+      head[i] = 0;
+      count[i] = 0;
+    }
+  }
+
+  FreeLists::~FreeLists()
+  {
+    listsClosed = true;
+    for (int i = 0; i < MATRIX_POOL_NUM_CLASSES; i++) {
+      double *block = head[i];
+      while (block != 0) {
+	double *next = nextBlock(block);
+	delete [] block;
+	block = next;
+      }
+      head[i] = 0;
+      count[i] = 0;
+    }
+  }
+}
+
+
+double *
+MatrixPool::allocate(int size)
+{
+  if (size <= 0)
+    return 0;
+
+  int cls = -1;
+  int blockSize = size;
+  if (size <= MATRIX_POOL_MAX_SIZE) {
+    cls = 0;
+    blockSize = 1;
+    while (blockSize < size) {
+      blockSize <<= 1;
+      cls++;
+    }
+
+    if (!listsClosed) {
+      FreeLists &lists = theLists;
+      double *block = lists.head[cls];
+      if (block != 0) {
+	lists.head[cls] = nextBlock(block);
+	lists.count[cls]--;
+	return block + MATRIX_POOL_HEADER;
+      }
+    }
+  }
+
+  double *block = new (std::nothrow) double[MATRIX_POOL_HEADER + blockSize];
+  if (block == 0)
+    return 0;
+
+  blockClass(block) = cls;
+  return block + MATRIX_POOL_HEADER;
+}
+
+
+void
+MatrixPool::release(double *data)
+{
+  if (data == 0)
+    return;
+
+  double *block = data - MATRIX_POOL_HEADER;
+  int cls = blockClass(block);
+
+  if (cls < 0 || listsClosed) {
+    delete [] block;
+    return;
+  }
+
+  FreeLists &lists = theLists;
+  if ((lists.count[cls] + 1) << cls > MATRIX_POOL_MAX_CACHED) {
+    delete [] block;
+    return;
+  }
+
+  nextBlock(block) = lists.head[cls];
+  lists.head[cls] = block;
+  lists.count[cls]++;
+}
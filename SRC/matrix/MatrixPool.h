@@ -0,0 +1,45 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for MatrixPool.
+// MatrixPool provides the storage of the data of Vector and Matrix
+// objects. Blocks of up to MATRIX_POOL_MAX_SIZE doubles are rounded up
+// to a power of two and, when released, kept on a free list of the
+// calling thread for the next request of that size, so the temporaries
+// created in the element loops do not go through new and delete each
+// time. Larger blocks are allocated and deleted directly.
+//
+// What: "@(#) MatrixPool.h, revA"
+
+#ifndef MatrixPool_h
+#define MatrixPool_h
+
+#define MATRIX_POOL_MAX_SIZE 4096     // 64x64, the largest pooled block
+
+class MatrixPool
+{
+  public:
+    // returns a block of at least size doubles, or 0 if out of memory
+    static double *allocate(int size);
+    // returns a block obtained from allocate() to the pool
+    static void release(double *data);
+};
+
+#endif
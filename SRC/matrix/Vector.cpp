@@ -34,7 +34,9 @@
 #include "Vector.h"
 #include "Matrix.h"
 #include "ID.h"
+#include "MatrixPool.h"
 #include <iostream>
+#include <utility>
 using std::nothrow;
 
 #include <math.h>
@@ -66,7 +68,7 @@ Vector::Vector(int size)
   // get some space for the vector
   //  theData = (double *)malloc(size*sizeof(double));
   if (size > 0) {
-    theData = new (nothrow) double [size];
+    theData = MatrixPool::allocate(size);
 
     if (theData == 0) {
       opserr << "Vector::Vector(int) - out of memory creating vector of size " << size << endln;
@@ -102,7 +104,7 @@ Vector::Vector(const Vector &other)
 : sz(other.sz),theData(0),fromFree(0)
 {
   if (sz != 0) {
-    theData = new (nothrow) double [other.sz];    
+    theData = MatrixPool::allocate(other.sz);
     
     if (theData == 0) {
       opserr << "Vector::Vector(int) - out of memory creating vector of size " << sz << endln;
@@ -117,15 +119,13 @@ Vector::Vector(const Vector &other)
 
 // Vector(const Vector&):
 //  Move constructor
-#ifdef USE_CXX11   
 Vector::Vector(Vector &&other)
-: sz(other.sz),theData(other.theData),fromFree(0)
+: sz(other.sz),theData(other.theData),fromFree(other.fromFree)
 {
-  //opserr << "move ctor!\n";
   other.theData = 0;
   other.sz = 0;
+  other.fromFree = 0;
 } 
-#endif
 
 
 
@@ -136,7 +136,7 @@ Vector::Vector(Vector &&other)
 Vector::~Vector()
 {
   if (theData != 0 && fromFree == 0) 
-    delete [] theData;
+    MatrixPool::release(theData);
   theData = 0;
 }
 
@@ -144,7 +144,7 @@ Vector::~Vector()
 int 
 Vector::setData(double *newData, int size){
   if (theData != 0 && fromFree == 0) {
-    delete [] theData;      
+    MatrixPool::release(theData);
     theData = 0;
   }
   sz = size;
@@ -175,7 +175,7 @@ Vector::resize(int newSize){
 
     // delete the old array
     if (theData != 0 && fromFree == 0) {
-	delete [] theData;
+	MatrixPool::release(theData);
   theData = 0;
 }
     sz = 0;
@@ -183,7 +183,7 @@ Vector::resize(int newSize){
     
     // create new memory
     // theData = (double *)malloc(newSize*sizeof(double));    
-    theData = new (nothrow) double[newSize];
+    theData = MatrixPool::allocate(newSize);
     if (theData == 0) {
       opserr << "Vector::resize() - out of memory for size " << newSize << endln;
       sz = 0;
@@ -649,7 +649,7 @@ Vector::operator[](int x)
 #endif
   
   if (x >= sz) {
-    double *dataNew = new (nothrow) double[x+1];
+    double *dataNew = MatrixPool::allocate(x+1);
     for (int i=0; i<sz; i++)
       dataNew[i] = theData[i];
     for (int j=sz; j<x; j++)
@@ -657,10 +657,11 @@ Vector::operator[](int x)
     
     if (fromFree == 0)
       if (theData != 0){
-	delete [] theData;
+	MatrixPool::release(theData);
   theData = 0;
 }
     theData = dataNew;
+    fromFree = 0;
     sz = x+1;
   }
 
@@ -738,14 +739,15 @@ Vector::operator=(const Vector &V)
 #endif
 
 	  // Check that we are not deleting an empty Vector
-	  if (this->theData != 0){
-      delete [] this->theData;
+	  if (this->theData != 0 && fromFree == 0){
+      MatrixPool::release(this->theData);
       this->theData = 0;
     }
 	  this->sz = V.sz;
+	  this->fromFree = 0;
 	  
 	  // Check that we are not creating an empty Vector
-	  theData = (sz != 0) ? new (nothrow) double[sz] : 0;
+	  theData = (sz != 0) ? MatrixPool::allocate(sz) : 0;
       }
 
 
@@ -758,25 +760,24 @@ Vector::operator=(const Vector &V)
 }
 
 // Move assignment operator.  
-#ifdef USE_CXX11   
 Vector &
 Vector::operator=(Vector &&V) 
 {
   // first check we are not trying v = v
   if (this != &V) {
-    // opserr << "move assign!\n";
-    if (this->theData != 0){ 
-      delete [] this->theData;
+    if (this->theData != 0 && fromFree == 0){ 
+      MatrixPool::release(this->theData);
       this->theData = 0;
     }
     theData = V.theData;
     this->sz = V.sz;
+    this->fromFree = V.fromFree;
     V.theData = 0;
     V.sz = 0;
+    V.fromFree = 0;
   }
   return *this;
 }
-#endif
 
 
 
@@ -845,7 +846,7 @@ Vector &Vector::operator/=(double fact)
 //	are return(i) = theData[i]+fact;
 
 Vector 
-Vector::operator+(double fact) const
+Vector::operator+(double fact) const &
 {
   Vector result(*this);
   if (result.Size() != sz) 
@@ -862,7 +863,7 @@ Vector::operator+(double fact) const
 //	are return(i) = theData[i]-fact;
 
 Vector 
-Vector::operator-(double fact) const
+Vector::operator-(double fact) const &
 {
     Vector result(*this);
     if (result.Size() != sz) 
@@ -879,7 +880,7 @@ Vector::operator-(double fact) const
 //	are return(i) = theData[i]*fact;
 
 Vector 
-Vector::operator*(double fact) const
+Vector::operator*(double fact) const &
 {
     Vector result(*this);
     if (result.Size() != sz) 
@@ -895,7 +896,7 @@ Vector::operator*(double fact) const
 //	are return(i) = theData[i]/fact; Exits if divide-by-zero error.
 
 Vector 
-Vector::operator/(double fact) const
+Vector::operator/(double fact) const &
 {
     if (fact == 0.0) 
       opserr << "Vector::operator/(double fact) - divide-by-zero error coming\n";
@@ -957,7 +958,7 @@ Vector::operator-=(const Vector &other)
 // 	Then returns a Vector whose components are the vector sum of current and V's data.
 
 Vector 
-Vector::operator+(const Vector &b) const
+Vector::operator+(const Vector &b) const &
 {
 #ifdef _G3DEBUG
   if (sz != b.sz) {
@@ -983,7 +984,7 @@ Vector::operator+(const Vector &b) const
 //	whose components are the vector difference of current and V's data.
 
 Vector 
-Vector::operator-(const Vector &b) const
+Vector::operator-(const Vector &b) const &
 {
 #ifdef _G3DEBUG
   if (sz != b.sz) {
@@ -1005,6 +1006,118 @@ Vector::operator-(const Vector &b) const
 }
 
 
+// Vector operator+(double fact) &&: etc.
+//	The same operations on a temporary Vector, e.g. the result of
+//	another operator, reuse its data for the result instead of
+//	allocating a new Vector. A temporary wrapping external data
+//	(fromFree != 0) is not written to, the copying versions are used.
+
+Vector 
+Vector::operator+(double fact) &&
+{
+  if (fromFree != 0)
+    return *this + fact;
+
+  *this += fact;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator-(double fact) &&
+{
+  if (fromFree != 0)
+    return *this - fact;
+
+  *this -= fact;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator*(double fact) &&
+{
+  if (fromFree != 0)
+    return *this * fact;
+
+  *this *= fact;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator/(double fact) &&
+{
+  if (fromFree != 0)
+    return *this / fact;
+
+  if (fact == 0.0) 
+    opserr << "Vector::operator/(double fact) - divide-by-zero error coming\n";
+
+  *this /= fact;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator+(const Vector &b) &&
+{
+  if (fromFree != 0 || sz != b.sz)
+    return *this + b;
+
+  *this += b;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator-(const Vector &b) &&
+{
+  if (fromFree != 0 || sz != b.sz)
+    return *this - b;
+
+  *this -= b;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator+(Vector &&b) const &
+{
+  if (b.fromFree != 0 || sz != b.sz)
+    return *this + b;
+
+  b += *this;
+  return std::move(b);
+}
+
+Vector 
+Vector::operator-(Vector &&b) const &
+{
+  if (b.fromFree != 0 || sz != b.sz)
+    return *this - b;
+
+  for (int i=0; i<sz; i++)
+    b.theData[i] = theData[i] - b.theData[i];
+  return std::move(b);
+}
+
+// with two temporaries, e.g. (a*2.0)+(b*3.0), the left one is reused
+Vector 
+Vector::operator+(Vector &&b) &&
+{
+  if (fromFree != 0 || sz != b.sz)
+    return *this + std::move(b);
+
+  *this += b;
+  return std::move(*this);
+}
+
+Vector 
+Vector::operator-(Vector &&b) &&
+{
+  if (fromFree != 0 || sz != b.sz)
+    return *this - std::move(b);
+
+  *this -= b;
+  return std::move(*this);
+}
+
+
 
 // double operator^(const Vector &V) const;
 //	Method to perform (Vector)transposed * vector.
@@ -1148,6 +1261,11 @@ Vector operator*(double a, const Vector &V)
   return V * a;
 }
 
+Vector operator*(double a, Vector &&V)
+{
+  return std::move(V) * a;
+}
+
 
 int
 Vector::Assemble(const Vector &V, int init_pos, double fact) 
@@ -47,9 +47,7 @@ class Vector
     Vector();
     Vector(int);
     Vector(const Vector &);    
-#ifdef USE_CXX11   
     Vector(Vector &&);    
-#endif
 
     Vector(double *data, int size);
     ~Vector();
@@ -75,24 +73,34 @@ class Vector
     double &operator[](int x);
     Vector operator()(const ID &rows) const;
     Vector &operator=(const Vector  &V);
-#ifdef USE_CXX11   
     Vector &operator=(Vector  &&V);
-#endif
     Vector &operator+=(double fact);
     Vector &operator-=(double fact);
     Vector &operator*=(double fact);
     Vector &operator/=(double fact); 
 
-    Vector operator+(double fact) const;
-    Vector operator-(double fact) const;
-    Vector operator*(double fact) const;
-    Vector operator/(double fact) const;
+    Vector operator+(double fact) const &;
+    Vector operator-(double fact) const &;
+    Vector operator*(double fact) const &;
+    Vector operator/(double fact) const &;
+
+    // on a temporary the result is computed in place of its data
+    Vector operator+(double fact) &&;
+    Vector operator-(double fact) &&;
+    Vector operator*(double fact) &&;
+    Vector operator/(double fact) &&;
     
     Vector &operator+=(const Vector &V);
     Vector &operator-=(const Vector &V);
     
-    Vector operator+(const Vector &V) const;
-    Vector operator-(const Vector &V) const;
+    Vector operator+(const Vector &V) const &;
+    Vector operator-(const Vector &V) const &;
+    Vector operator+(const Vector &V) &&;
+    Vector operator-(const Vector &V) &&;
+    Vector operator+(Vector &&V) const &;
+    Vector operator-(Vector &&V) const &;
+    Vector operator+(Vector &&V) &&;
+    Vector operator-(Vector &&V) &&;
     double operator^(const Vector &V) const;
     Vector operator/(const Matrix &M) const;
 
@@ -111,6 +119,7 @@ class Vector
     friend OPS_Stream &operator<<(OPS_Stream &s, const Vector &V);
     // friend istream &operator>>(istream &s, Vector &V);    
     friend Vector operator*(double a, const Vector &V);
+    friend Vector operator*(double a, Vector &&V);
     
     friend class Message;
     friend class SystemOfEqn;
@@ -119,9 +128,12 @@ class Vector
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;    
+    friend class SharedMemoryChannel;
+    friend class BufferedChannel;
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class MemoryDatastore;
     
   private:
     static double VECTOR_NOT_VALID_ENTRY;
@@ -60,6 +60,9 @@ SNOPTAnalysis::~SNOPTAnalysis()
 	if (xnames !=0) delete [] xnames;
 	if (Fnames !=0) delete [] Fnames;
 	if (tclFileToRun !=0) delete [] tclFileToRun;
+	if (cachedX !=0) delete [] cachedX;
+	if (cachedF !=0) delete [] cachedF;
+	if (cachedG !=0) delete [] cachedG;
 
 
 
@@ -354,7 +357,11 @@ iPrint=0;
 
 	temp = 0;
 
-
+	cachedX = new double[n];
+	cachedF = new double[neF];
+	cachedG = new double[lenG];
+	cachedResult = 0;
+	isCached = false;
 
 }
 
@@ -364,6 +371,9 @@ int SNOPTAnalysis::runOptAnalysis (OptimizationDomain *passedOptimizationDomain)
 
 	this->theOptimizationDomain = passedOptimizationDomain;	
 //	int result;
+
+	// the design variables may have been changed since the last run
+	isCached = false;
 	
 	// Prepare output file to store the search points
 	ofstream outputFile2( fileNamePrint, ios::out );
@@ -447,6 +457,34 @@ double * SNOPTAnalysis::getUnScaledX(){
 
 int SNOPTAnalysis::updateXFG(double * newScaledX){
 
+// 0. --- reuse F and G if x has not changed since the last evaluation
+
+	if (isCached) {
+		int i = 0;
+		while (i < n && cachedX[i] == newScaledX[i])
+			i++;
+
+		if (i == n) {
+			for (i=0; i<neF; i++)  F[i] = cachedF[i];
+			for (i=0; i<lenG; i++) gradient[i] = cachedG[i];
+			return cachedResult;
+		}
+	}
+
+	int result = this->evaluateXFG(newScaledX);
+
+	for (int i=0; i<n; i++)    cachedX[i] = newScaledX[i];
+	for (int i=0; i<neF; i++)  cachedF[i] = F[i];
+	for (int i=0; i<lenG; i++) cachedG[i] = gradient[i];
+	cachedResult = result;
+	isCached = true;
+
+	return result;
+}
+
+
+int SNOPTAnalysis::evaluateXFG(double * newScaledX){
+
 //--------------- get objective function and gradient from ---------------------------------------
 	 
 // 1. --- reset
@@ -81,6 +81,7 @@ public:
 
 private:
 
+  int evaluateXFG(double * newScaledX);   // run the analysis at x, fill F and G
 
 // The domain and tools for the analysis
 	OptimizationDomain *theOptimizationDomain;
@@ -105,6 +106,14 @@ private:
 	char * tclFileToRun;
 	Tcl_Interp * theTclInterp;
 
+	// last evaluated point; SNOPT often asks for F and G again at the
+	// same x, which would otherwise rerun the whole structural analysis
+	double * cachedX;
+	double * cachedF;
+	double * cachedG;
+	int cachedResult;
+	bool isCached;
+
 
 };
 
@@ -31,6 +31,7 @@
 
 #include <ElementRecorder.h>
 #include <Domain.h>
+#include <ResponseCache.h>
 #include <Element.h>
 #include <ElementIter.h>
 #include <Vector.h>
@@ -49,12 +50,15 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
+#include <AsyncStream.h>
 #include <DatabaseStream.h>
 #include <TCP_Stream.h>
 
 #include <elementAPI.h>
 
 #include <string.h>
+#include <MemoryReport.h>
 
 void*
 OPS_ElementRecorder()
@@ -78,8 +82,13 @@ OPS_ElementRecorder()
     const int DATA_STREAM_CSV = 5;
     const int TCP_STREAM = 6;
     const int DATA_STREAM_ADD = 7;
+    const int COLUMNAR_STREAM = 8;
 
     int eMode = STANDARD_STREAM;
+    int asyncRows = 0;
+    int tcpBatch = 0;
+    bool sharded = false;
+    const char *compression = 0;
 
     bool echoTimeFlag = false;
     double dT = 0.0;
@@ -96,6 +105,8 @@ OPS_ElementRecorder()
     ID elements(0, 6);
     ID dofs(0, 6);
 
+    RecorderSampler *theSampler = 0;
+
     char **argv = 0;
     
     while (OPS_GetNumRemainingInputArgs() > 0) {
@@ -157,6 +168,38 @@ OPS_ElementRecorder()
             }
             eMode = BINARY_STREAM;
         }
+        else if (strcmp(option, "-columnar") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                filename = OPS_GetString();
+            }
+            eMode = COLUMNAR_STREAM;
+        }
+        else if (strcmp(option, "-compress") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                compression = OPS_GetString();
+        }
+        else if (strcmp(option, "-shards") == 0) {
+            sharded = true;
+        }
+        else if (strcmp(option, "-tcpBatch") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                int num = 1;
+                if (OPS_GetIntInput(&num, &tcpBatch) < 0) {
+                    opserr << "WARNING: failed to read tcpBatch\n";
+                    return 0;
+                }
+            }
+        }
+        else if (strcmp(option, "-async") == 0) {
+            asyncRows = 1000;
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                int num = 1;
+                if (OPS_GetIntInput(&num, &asyncRows) < 0) {
+                    asyncRows = 1000;
+                    OPS_ResetCurrentInputArg(-1);
+                }
+            }
+        }
         else if (strcmp(option, "-dT") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 int num = 1;
@@ -253,6 +296,13 @@ OPS_ElementRecorder()
                 dofs[numDOF++] = dof - 1;
             }
         }
+        else if (strcmp(option, "-every") == 0 || strcmp(option, "-trigger") == 0) {
+            if (OPS_RecorderSamplerOption(option, theSampler) < 0) {
+                if (theSampler != 0)
+                    delete theSampler;
+                return 0;
+            }
+        }
         else {
             // first unknown string then is assumed to start 
             // element response request
@@ -284,11 +334,22 @@ OPS_ElementRecorder()
     //    theOutputStream = new DatabaseStream(theDatabase, tableName);
     else if (eMode == BINARY_STREAM && filename != 0)
         theOutputStream = new BinaryFileStream(filename);
+    else if (eMode == COLUMNAR_STREAM && filename != 0)
+        theOutputStream = new ColumnarFileStream(filename);
     else if (eMode == TCP_STREAM && inetAddr != 0)
-        theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        theOutputStream = new TCP_Stream(inetPort, inetAddr, false, tcpBatch);
     else
         theOutputStream = new StandardStream();
 
+    if (compression != 0 && theOutputStream->setCompression(compression) < 0)
+        opserr << "WARNING recorder - -compress " << compression << " not available for this output, written uncompressed\n";
+
+    if (sharded && theOutputStream->setSharded(true) < 0)
+        opserr << "WARNING recorder - -shards only applies to -file and -csv output, ignored\n";
+
+    if (asyncRows > 0)
+        theOutputStream = new AsyncStream(theOutputStream, asyncRows);
+
     theOutputStream->setPrecision(precision);
 
     Domain* domain = OPS_GetDomain();
@@ -297,6 +358,8 @@ OPS_ElementRecorder()
     ElementRecorder* recorder = new ElementRecorder(&elements,
         data, nargrem, echoTimeFlag, *domain, *theOutputStream,
         dT, rTolDt, &dofs);
+    if (theSampler != 0)
+        recorder->setSampler(theSampler);
 
     if (data != 0) {
       for (int i=1; i<nargrem; ++i) {
@@ -312,9 +375,9 @@ OPS_ElementRecorder()
 ElementRecorder::ElementRecorder()
 :Recorder(RECORDER_TAGS_ElementRecorder),
  numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), 
- theDomain(0), theOutputHandler(0),
+ gatherOffset(0), gatherSize(0), theDomain(0), theOutputHandler(0),
  echoTimeFlag(true), deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0), data(0),
- initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
+ initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0), theSampler(0)
 {
 
 }
@@ -330,9 +393,9 @@ ElementRecorder::ElementRecorder(const ID *ele,
 				 const ID *theDOFs)
 :Recorder(RECORDER_TAGS_ElementRecorder),
  numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), 
- theDomain(&theDom), theOutputHandler(&theOutput),
+ gatherOffset(0), gatherSize(0), theDomain(&theDom), theOutputHandler(&theOutput),
  echoTimeFlag(echoTime), deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0), data(0),
- initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
+ initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0), theSampler(0)
 {
 
   if (ele != 0) {
@@ -394,6 +457,11 @@ ElementRecorder::~ElementRecorder()
     delete [] theResponses;
   }
 
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
+
   if (data != 0)
     delete data;
   
@@ -405,6 +473,17 @@ ElementRecorder::~ElementRecorder()
     delete [] responseArgs[i];
   delete [] responseArgs;
 
+  if (theSampler != 0)
+    delete theSampler;
+}
+
+
+void
+ElementRecorder::setSampler(RecorderSampler *sampler)
+{
+  if (theSampler != 0)
+    delete theSampler;
+  theSampler = sampler;
 }
 
 
@@ -430,35 +509,43 @@ ElementRecorder::record(int commitTag, double timeStamp)
     if (deltaT != 0.0)
       nextTimeStampToRecord = timeStamp + deltaT;
 
-    int loc = 0;
     if (echoTimeFlag == true) 
-      (*data)(loc++) = timeStamp;
+      (*data)(0) = timeStamp;
     
     //
-    // for each element if responses exist, put them in response vector
+    // for each element if responses exist, gather them into the response
+    // vector at the columns fixed for them in initialize()
     //
     for (int i=0; i< numEle; i++) {
-      if (theResponses[i] != 0) {
-	// ask the element for the response
-	int res;
-	if (( res = theResponses[i]->getResponse()) < 0)
-	  result += res;
-	else {
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
-	  if (numDOF == 0) {
-	    for (int j=0; j<eleData.Size(); j++)
-	      (*data)(loc++) = eleData(j);
-	  } else {
-	    int dataSize = data->Size();
-	    for (int j=0; j<numDOF; j++) {
-	      int index = (*dof)(j);
-	      if (index >= 0 && index < dataSize)
-		(*data)(loc++) = eleData(index);		
-	      else
-		(*data)(loc++) = 0.0;		
-	    }
-	  }
+      if (theResponses[i] == 0)
+	continue;
+
+      int loc = (*gatherOffset)(i);
+      int size = (*gatherSize)(i);
+      int numCols = (numDOF == 0) ? size : numDOF;
+
+      // ask the element for the response
+      int res;
+      if (( res = theResponses[i]->getResponse()) < 0) {
+	result += res;
+	for (int j=0; j<numCols; j++)
+	  (*data)(loc+j) = 0.0;
+	continue;
+      }
+
+      const Vector &eleData = theResponses[i]->getInformation().getData();
+      if (numDOF == 0) {
+	if (eleData.Size() < size)
+	  size = eleData.Size();
+	for (int j=0; j<size; j++)
+	  (*data)(loc+j) = eleData(j);
+      } else {
+	for (int j=0; j<numDOF; j++) {
+	  int index = (*dof)(j);
+	  if (index >= 0 && index < size)
+	    (*data)(loc+j) = eleData(index);
+	  else
+	    (*data)(loc+j) = 0.0;
 	}
       }
     }
@@ -466,7 +553,10 @@ ElementRecorder::record(int commitTag, double timeStamp)
     //
     // send the response vector to the output handler for o/p
     //
-    theOutputHandler->write(*data);
+    if (theSampler != 0)
+      theSampler->write(*data, *theOutputHandler);
+    else
+      theOutputHandler->write(*data);
   }
   
   // successful completion - return 0
@@ -478,6 +568,8 @@ ElementRecorder::restart(void)
 {
   if (data != 0)
     data->Zero();
+  if (theSampler != 0)
+    theSampler->restart();
   return 0;
 }
 
@@ -486,9 +578,26 @@ int
 ElementRecorder::setDomain(Domain &theDom)
 {
   theDomain = &theDom;
+  initializationDone = false;
   return 0;
 }
 
+size_t
+ElementRecorder::getMemoryUsage(void)
+{
+  size_t result = MemoryReport::objectSize(this);
+  result += MemoryReport::vectorSize(data);
+  result += MemoryReport::idSize(eleID) + MemoryReport::idSize(dof);
+  result += MemoryReport::idSize(gatherOffset) + MemoryReport::idSize(gatherSize);
+  if (theResponses != 0) {
+    result += numEle*sizeof(Response *);
+    for (int i=0; i<numEle; i++)
+      result += MemoryReport::objectSize(theResponses[i]);
+  }
+
+  return result;
+}
+
 int
 ElementRecorder::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -852,6 +961,7 @@ ElementRecorder::initialize(void)
 	theResponses[i] = 0;
       } else {
 	theResponses[i] = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
+	theResponses[i] = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponses[i]);
 	if (theResponses[i] != 0) {
 	  // from the response type determine no of cols for each
 	  Information &eleInfo = theResponses[i]->getInformation();
@@ -909,18 +1019,17 @@ ElementRecorder::initialize(void)
 
     while ((theEle = theElements()) != 0) {
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
+      theResponse = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponse);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
-	  // Why is this created locally and not used? -- MHS
 	  Response **theNextResponses = new Response *[numEle*2];
-	  if (theNextResponses != 0) {
-	    for (int i=0; i<numEle; i++)
-	      theNextResponses[i] = theResponses[i];
-	    for (int j=numEle; j<2*numEle; j++)
-	      theNextResponses[j] = 0;
-	  }
+	  for (int i=0; i<numEle; i++)
+	    theNextResponses[i] = theResponses[i];
+	  for (int j=numEle; j<2*numEle; j++)
+	    theNextResponses[j] = 0;
 	  numEle = 2*numEle;
-	  delete [] theNextResponses;
+	  delete [] theResponses;
+	  theResponses = theNextResponses;
 	}
 	theResponses[numResponse] = theResponse;
 
@@ -936,7 +1045,33 @@ ElementRecorder::initialize(void)
     numEle = numResponse;
   }
 
+  //
+  // fix the columns of each response so record() need not count them
+  //
+
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
+  gatherOffset = new ID(numEle);
+  gatherSize = new ID(numEle);
+
+  int loc = (echoTimeFlag == true) ? 1 : 0;
+  for (i=0; i<numEle; i++) {
+    (*gatherOffset)(i) = -1;
+    (*gatherSize)(i) = 0;
+    if (theResponses[i] != 0) {
+      int dataSize = theResponses[i]->getInformation().getData().Size();
+      (*gatherOffset)(i) = loc;
+      (*gatherSize)(i) = dataSize;
+      loc += (numDOF == 0) ? dataSize : numDOF;
+    }
+  }
+  numDbColumns = loc;
+
   // create the vector to hold the data
+  if (data != 0)
+    delete data;
   data = new Vector(numDbColumns);
 
   if (data == 0) {
@@ -945,6 +1080,10 @@ ElementRecorder::initialize(void)
   }
   
   theOutputHandler->tag("Data");
+
+  if (theSampler != 0)
+    theSampler->setDomain(*theDomain);
+
   initializationDone = true;
 
   return 0;
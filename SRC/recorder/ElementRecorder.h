@@ -40,6 +40,7 @@
 #include <Recorder.h>
 #include <Information.h>
 #include <ID.h>
+#include <RecorderSampler.h>
 
 class Domain;
 class Vector;
@@ -64,6 +65,9 @@ class ElementRecorder: public Recorder
 
     ~ElementRecorder();
 
+    // the recorder takes ownership of the sampler deciding the rows written
+    void setSampler(RecorderSampler *theSampler);
+
     int record(int commitTag, double timeStamp);
     int restart(void);    
     int flush(void);    
@@ -72,6 +76,7 @@ class ElementRecorder: public Recorder
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
+    size_t getMemoryUsage(void);
 	virtual double getRecordedValue(int clmnId, int rowOffset, bool reset); //added by SAJalali
 
   protected:
@@ -88,6 +93,11 @@ class ElementRecorder: public Recorder
 
     Response **theResponses;
 
+    // gather plan set in initialize(): the first column in data of each
+    // response (-1 if there is none) & the size of its data vector
+    ID *gatherOffset;
+    ID *gatherSize;
+
     Domain *theDomain;
     OPS_Stream *theOutputHandler;
 
@@ -103,6 +113,8 @@ class ElementRecorder: public Recorder
     int numArgs;
 
     int addColumnInfo;
+
+    RecorderSampler *theSampler;
 };
 
 
@@ -27,6 +27,7 @@
 
 #include <ElementRecorderRMS.h>
 #include <Domain.h>
+#include <ResponseCache.h>
 #include <Element.h>
 #include <ElementIter.h>
 #include <Vector.h>
@@ -292,7 +293,7 @@ ElementRecorderRMS::ElementRecorderRMS()
 :Recorder(RECORDER_TAGS_ElementRecorderRMS),
  numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), theDomain(0),
  theHandler(0), deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0),
- runningTotal(0), currentData(0), count(0), 
+ runningTotal(0), gatherOffset(0), gatherSize(0), count(0), 
  initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
 {
 
@@ -310,7 +311,7 @@ ElementRecorderRMS::ElementRecorderRMS(const ID *ele,
   :Recorder(RECORDER_TAGS_ElementRecorderRMS),
   numEle(0), eleID(0), numDOF(0), dof(0), theResponses(0), theDomain(&theDom),
   theHandler(&theOutputHandler), deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0),
-   runningTotal(0), currentData(0), count(0),
+   runningTotal(0), gatherOffset(0), gatherSize(0), count(0),
   initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
 {
   opserr << "ElementRMS:: constructor\n";
@@ -359,16 +360,12 @@ ElementRecorderRMS::~ElementRecorderRMS()
   if (eleID != 0)
     delete eleID;
 
-  opserr << "ElementRMS DESTRUCTOR\n";
-
-  if (theHandler != 0 && currentData != 0) {
+  if (theHandler != 0 && runningTotal != 0) {
 
     theHandler->tag("Data"); // Data
 
     if (runningTotal != 0) {
 
-      opserr << "ElementRMS DESTRUCTOR - runin\n" << runningTotal->Size() << "\n";
-
       for (int j=0; j<runningTotal->Size(); j++)
 	if (count != 0) {
 	  double value = (*runningTotal)(j);
@@ -385,9 +382,11 @@ ElementRecorderRMS::~ElementRecorderRMS()
 
   if (runningTotal != 0)
     delete runningTotal;
-  
-  if (currentData != 0)
-    delete currentData;
+
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
 
   //
   // clean up the memory
@@ -435,44 +434,45 @@ ElementRecorderRMS::record(int commitTag, double timeStamp)
     if (deltaT != 0.0) 
       nextTimeStampToRecord = timeStamp + deltaT;
     
-    int loc = 0;
-    // for each element do a getResponse() & put the result in current data
+    //
+    // for each element with a response, add the squares of its values
+    // straight into the running totals of the columns fixed in initialize()
+    //
     for (int i=0; i< numEle; i++) {
-      if (theResponses[i] != 0) {
-	// ask the element for the response
-	int res;
-	if (( res = theResponses[i]->getResponse()) < 0)
-	  result += res;
-	else {
-	  // from the response determine no of cols for each
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
-	  //	  for (int j=0; j<eleData.Size(); j++) 
-	  //	    (*currentData)(loc++) = eleData(j);
-	  if (numDOF == 0) {
-	    for (int j=0; j<eleData.Size(); j++)
-	      (*currentData)(loc++) = eleData(j);
-	  } else {
-	    int dataSize = eleData.Size();
-	    for (int j=0; j<numDOF; j++) {
-	      int index = (*dof)(j);
-	      if (index >= 0 && index < dataSize)
-		(*currentData)(loc++) = eleData(index);		
-	      else
-		(*currentData)(loc++) = 0.0;		
-	    }
+      if (theResponses[i] == 0)
+	continue;
+
+      // ask the element for the response
+      int res;
+      if (( res = theResponses[i]->getResponse()) < 0) {
+	result += res;
+	continue;
+      }
+
+      const Vector &eleData = theResponses[i]->getInformation().getData();
+      int loc = (*gatherOffset)(i);
+      int size = (*gatherSize)(i);
+      if (eleData.Size() < size)
+	size = eleData.Size();
+
+      if (numDOF == 0) {
+	for (int j=0; j<size; j++) {
+	  double value = eleData(j);
+	  (*runningTotal)(loc+j) += value*value;
+	}
+      } else {
+	int dataSize = eleData.Size();
+	for (int j=0; j<numDOF; j++) {
+	  int index = (*dof)(j);
+	  if (index >= 0 && index < dataSize) {
+	    double value = eleData(index);
+	    (*runningTotal)(loc+j) += value*value;
 	  }
 	}
       }
     }
 
-    // add data contribution to runningTotal
     count++;
-    int sizeData = currentData->Size();
-    for (int i=0; i<sizeData; i++) {
-      double value = (*currentData)(i);
-      (*runningTotal)(i) += value*value;
-    } 
   }    
 
   // successful completion - return 0
@@ -830,14 +830,9 @@ ElementRecorderRMS::initialize(void)
       if (theEle == 0) {
 	theResponses[i] = 0;
       } else {
-	opserr << *theEle;
-
-	for (int a=0; a<numArgs; a++)
-	  opserr << responseArgs[i];
-
 	theResponses[i] = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+	theResponses[i] = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponses[i]);
 	if (theResponses[i] != 0) {
-	  opserr << "HAS RESPONSE\n";
 	  // from the response type determine no of cols for each
 	  Information &eleInfo = theResponses[i]->getInformation();
 	  const Vector &eleData = eleInfo.getData();
@@ -855,7 +850,7 @@ ElementRecorderRMS::initialize(void)
 	      for (int j=0; j<numDOF; j++)
 		responseOrder[responseCount++] = i+1;
 	  }
-	} else { opserr << "NO RESPONSE\n";}
+	}
       } 
     }
 
@@ -887,18 +882,17 @@ ElementRecorderRMS::initialize(void)
 
     while ((theEle = theElements()) != 0) {
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+      theResponse = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponse);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
-	  // Why is this created locally and not used? -- MHS
 	  Response **theNextResponses = new Response *[numEle*2];
-	  if (theNextResponses != 0) {
-	    for (int i=0; i<numEle; i++)
-	      theNextResponses[i] = theResponses[i];
-	    for (int j=numEle; j<2*numEle; j++)
-	      theNextResponses[j] = 0;
-	  }
+	  for (int i=0; i<numEle; i++)
+	    theNextResponses[i] = theResponses[i];
+	  for (int j=numEle; j<2*numEle; j++)
+	    theNextResponses[j] = 0;
 	  numEle = 2*numEle;
-	  delete [] theNextResponses;
+	  delete [] theResponses;
+	  theResponses = theNextResponses;
 	}
 	theResponses[numResponse] = theResponse;
 
@@ -915,19 +909,37 @@ ElementRecorderRMS::initialize(void)
   }
 
   //
-  // create the matrix & vector that holds the data
+  // fix the value columns of each response so record() need not count them
   //
 
-  opserr << numEle << " " << numDbColumns << "\n";
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
+  gatherOffset = new ID(numEle);
+  gatherSize = new ID(numEle);
 
-  runningTotal = new Vector(numDbColumns);
-  currentData = new Vector(numDbColumns);
-  if (runningTotal == 0 || currentData == 0) {
-    opserr << "ElementRecorderRMS::ElementRecorderRMS() - out of memory\n";
-    exit(-1);
+  int loc = 0;
+  for (i=0; i<numEle; i++) {
+    (*gatherOffset)(i) = -1;
+    (*gatherSize)(i) = 0;
+    if (theResponses[i] != 0) {
+      int dataSize = theResponses[i]->getInformation().getData().Size();
+      (*gatherOffset)(i) = loc;
+      (*gatherSize)(i) = dataSize;
+      loc += (numDOF == 0) ? dataSize : numDOF;
+    }
   }
+  numDbColumns = loc;
+
+  //
+  // create the vector that holds the running totals
+  //
+
+  if (runningTotal != 0)
+    delete runningTotal;
+  runningTotal = new Vector(numDbColumns);
   runningTotal->Zero();
-  currentData->Zero();
 
   initializationDone = true;  
   return 0;
@@ -88,7 +88,11 @@ class ElementRecorderRMS: public Recorder
     double nextTimeStampToRecord;
 
     Vector *runningTotal;
-    Vector *currentData;
+
+    // gather plan set in initialize(): the first column of each response
+    // (-1 if there is none) & the size of its data vector
+    ID *gatherOffset;
+    ID *gatherSize;
     int count;
 
     bool initializationDone;
@@ -27,6 +27,7 @@
 
 #include <EnvelopeElementRecorder.h>
 #include <Domain.h>
+#include <ResponseCache.h>
 #include <Element.h>
 #include <ElementIter.h>
 #include <Vector.h>
@@ -52,6 +53,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <EnvelopeReduction.h>
 
 void*
 OPS_EnvelopeElementRecorder()
@@ -86,6 +88,7 @@ OPS_EnvelopeElementRecorder()
     int precision = 6;
 
     bool closeOnWrite = false;
+    bool doRMS = false;
 
     const char *inetAddr = 0;
     int inetPort;
@@ -121,6 +124,10 @@ OPS_EnvelopeElementRecorder()
         else if (strcmp(option, "-closeOnWrite") == 0) {
             closeOnWrite = true;
         }
+        else if (strcmp(option, "-rms") == 0) {
+            // a fourth row with the RMS, reduced in the same pass
+            doRMS = true;
+        }
         else if (strcmp(option, "-csv") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 filename = OPS_GetString();
@@ -289,7 +296,7 @@ OPS_EnvelopeElementRecorder()
     if (domain == 0)
         return 0;
     EnvelopeElementRecorder* recorder = new EnvelopeElementRecorder(&elements,
-								    data, nargrem, *domain, *theOutputStream, dT, rTolDt, echoTimeFlag, &dofs, closeOnWrite);
+								    data, nargrem, *domain, *theOutputStream, dT, rTolDt, echoTimeFlag, &dofs, closeOnWrite, doRMS);
 
     return recorder;
 }
@@ -297,9 +304,10 @@ OPS_EnvelopeElementRecorder()
 
 EnvelopeElementRecorder::EnvelopeElementRecorder()
 :Recorder(RECORDER_TAGS_EnvelopeElementRecorder),
- numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0), theDomain(0),
+ numEle(0), numDOF(0), eleID(0), dof(0), theResponses(0),
+ gatherOffset(0), gatherSize(0), theDomain(0),
  theHandler(0), deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0),
- data(0), currentData(0), first(true),
+ data(0), currentData(0), first(true), numStats(3), count(0),
  initializationDone(false), responseArgs(0), numArgs(0), echoTimeFlag(false), addColumnInfo(0)
 {
 
@@ -315,11 +323,13 @@ EnvelopeElementRecorder::EnvelopeElementRecorder(const ID *ele,
 						 double rTolDt,
 						 bool echoTime,
 						 const ID *indexValues,
-						 bool closeOnW)
+						 bool closeOnW,
+						 bool doRMS)
  :Recorder(RECORDER_TAGS_EnvelopeElementRecorder),
-  numEle(0), eleID(0), numDOF(0), dof(0), theResponses(0), theDomain(&theDom),
+  numEle(0), eleID(0), numDOF(0), dof(0), theResponses(0),
+  gatherOffset(0), gatherSize(0), theDomain(&theDom),
   theHandler(&theOutputHandler), deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0),
-  data(0), currentData(0), first(true),
+  data(0), currentData(0), first(true), numStats(doRMS ? 4 : 3), count(0),
   initializationDone(false), responseArgs(0), numArgs(0), echoTimeFlag(echoTime), addColumnInfo(0), closeOnWrite(closeOnW)
 {
 
@@ -367,19 +377,8 @@ EnvelopeElementRecorder::~EnvelopeElementRecorder()
   if (eleID != 0)
     delete eleID;
 
-  if (theHandler != 0 && currentData != 0) {
-
-    theHandler->tag("Data"); // Data
-
-    for (int i=0; i<3; i++) {
-      int numResponse = currentData->Size();
-      for (int j=0; j<numResponse; j++)
-	(*currentData)(j) = (*data)(i,j);
-      theHandler->write(*currentData);
-    }
-
-    theHandler->endTag(); // Data
-  }
+  if (theHandler != 0 && currentData != 0)
+    this->writeEnvelope();
 
   if (theHandler != 0)
     delete theHandler;
@@ -390,6 +389,11 @@ EnvelopeElementRecorder::~EnvelopeElementRecorder()
   if (currentData != 0)
     delete currentData;
 
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
+
   //
   // clean up the memory
   //
@@ -439,123 +443,59 @@ EnvelopeElementRecorder::record(int commitTag, double timeStamp)
     if (deltaT != 0.0) 
       nextTimeStampToRecord = timeStamp + deltaT;
     
-    int loc = 0;
-    // for each element do a getResponse() & put the result in current data
+    //
+    // for each element with a response, reduce its values straight into
+    // the statistics of the columns fixed for them in initialize()
+    //
+    double *stats = (data->noCols() != 0) ? &(*data)(0,0) : 0;
     for (int i=0; i< numEle; i++) {
-      if (theResponses[i] != 0) {
-	// ask the element for the response
-	int res;
-	if (( res = theResponses[i]->getResponse()) < 0)
-	  result += res;
-	else {
-	  // from the response determine no of cols for each
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
-	  //	  for (int j=0; j<eleData.Size(); j++) 
-	  //	    (*currentData)(loc++) = eleData(j);
-	  if (numDOF == 0) {
-	    for (int j=0; j<eleData.Size(); j++)
-	      (*currentData)(loc++) = eleData(j);
-	  } else {
-	    int dataSize = eleData.Size();
-	    for (int j=0; j<numDOF; j++) {
-	      int index = (*dof)(j);
-	      if (index >= 0 && index < dataSize)
-		(*currentData)(loc++) = eleData(index);		
-	      else
-		(*currentData)(loc++) = 0.0;		
-	    }
-	  }
-	}
+      if (theResponses[i] == 0)
+	continue;
+
+      // ask the element for the response
+      int res;
+      if (( res = theResponses[i]->getResponse()) < 0) {
+	result += res;
+	continue;
       }
-    }
 
-    int sizeData = currentData->Size();
-    
-    if (echoTimeFlag == false) {
-
-      if (first == true) {
-	for (int i=0; i<sizeData; i++) {
-	  (*data)(0,i) = (*currentData)(i);
-	  (*data)(1,i) = (*currentData)(i);
-	  (*data)(2,i) = fabs((*currentData)(i));
-	  first = false;
-	  writeIt = true;
-	} 
-      } else {
-	for (int i=0; i<sizeData; i++) {
-	  double value = (*currentData)(i);
-	  if ((*data)(0,i) > value) {
-	    (*data)(0,i) = value;
-	    double absValue = fabs(value);
-	    if ((*data)(2,i) < absValue) 
-	      (*data)(2,i) = absValue;
-	    writeIt = true;
-	  } else if ((*data)(1,i) < value) {
-	    (*data)(1,i) = value;
-	    double absValue = fabs(value);
-	    if ((*data)(2,i) < absValue) 
-	      (*data)(2,i) = absValue;
-	    writeIt = true;
-	  }
+      const Vector &eleData = theResponses[i]->getInformation().getData();
+      int loc = (*gatherOffset)(i);
+      int size = (*gatherSize)(i);
+      if (eleData.Size() < size)
+	size = eleData.Size();
+      int numCols = (numDOF == 0) ? size : numDOF;
+
+      for (int j=0; j<numCols; j++) {
+	double value = 0.0;
+	if (numDOF == 0)
+	  value = eleData(j);
+	else {
+	  int index = (*dof)(j);
+	  if (index >= 0 && index < eleData.Size())
+	    value = eleData(index);
 	}
-      }
-    } else {
-      sizeData /= 2;
-      if (first == true) {
-	for (int i=0; i<sizeData; i++) {
-	  
-	  (*data)(0,i*2) = timeStamp;
-	  (*data)(1,i*2) = timeStamp;
-	  (*data)(2,i*2) = timeStamp;
-	  (*data)(0,i*2+1) = (*currentData)(i);
-	  (*data)(1,i*2+1) = (*currentData)(i);
-	  (*data)(2,i*2+1) = fabs((*currentData)(i));
-	  first = false;
+
+	int col = loc+j;
+	bool changed;
+	if (echoTimeFlag == false)
+	  changed = EnvelopeReduction::reduce(&stats[col*numStats], numStats, value, first);
+	else
+	  changed = EnvelopeReduction::reduce(&stats[(2*col+1)*numStats], &stats[2*col*numStats],
+					      numStats, value, timeStamp, first);
+	if (changed == true)
 	  writeIt = true;
-	} 
-      } else {
-	for (int i=0; i<sizeData; i++) {
-	  double value = (*currentData)(i);
-	  if ((*data)(0,2*i+1) > value) {
-	    (*data)(0,i*2) = timeStamp;
-	    (*data)(0,i*2+1) = value;
-	    double absValue = fabs(value);
-	    if ((*data)(2,i*2+1) < absValue) {
-	      (*data)(2,i*2+1) = absValue;
-	      (*data)(2,i*2) = timeStamp;
-	    }
-	    writeIt = true;
-	  } else if ((*data)(1,i*2+1) < value) {
-	    (*data)(1,i*2) = timeStamp;
-	    (*data)(1,i*2+1) = value;
-	    double absValue = fabs(value);
-	    if ((*data)(2,i*2+1) < absValue) { 
-	      (*data)(2,i*2) = timeStamp;
-	      (*data)(2,i*2+1) = absValue;
-	    }
-	    writeIt = true;
-	  }
-	}
       }
     }
+    first = false;
+    count++;
     }
 
     // deal with close on write flag
     if (closeOnWrite == true && writeIt == true) {
       if (theHandler != 0 && currentData != 0) {
-
 	theHandler->open(); // need to explicittly open
-	theHandler->tag("Data"); // Data
-	
-	for (int i=0; i<3; i++) {
-	  int numResponse = currentData->Size();
-	  for (int j=0; j<numResponse; j++)
-	    (*currentData)(j) = (*data)(i,j);
-	  theHandler->write(*currentData);
-	}
-	
-	theHandler->endTag(); // Data
+	this->writeEnvelope();
       }
     }
     
@@ -563,11 +503,35 @@ EnvelopeElementRecorder::record(int commitTag, double timeStamp)
   return result;
 }
 
+// void writeEnvelope(void);
+//	writes a row for each statistic, the RMS from the sum of squares.
+
+void
+EnvelopeElementRecorder::writeEnvelope(void)
+{
+  theHandler->tag("Data"); // Data
+
+  int numResponse = currentData->Size();
+  for (int i=0; i<numStats; i++) {
+    for (int j=0; j<numResponse; j++) {
+      // the time columns hold the time itself
+      if (echoTimeFlag == true && j%2 == 0)
+	(*currentData)(j) = (*data)(i,j);
+      else
+	(*currentData)(j) = EnvelopeReduction::result(i, (*data)(i,j), count);
+    }
+    theHandler->write(*currentData);
+  }
+
+  theHandler->endTag(); // Data
+}
+
 int
 EnvelopeElementRecorder::restart(void)
 {
   data->Zero();
   first = true;
+  count = 0;
   return 0;
 }
 
@@ -575,6 +539,7 @@ int
 EnvelopeElementRecorder::setDomain(Domain &theDom)
 {
   theDomain = &theDom;
+  initializationDone = false;
   return 0;
 }
 
@@ -592,7 +557,7 @@ EnvelopeElementRecorder::sendSelf(int commitTag, Channel &theChannel)
   // into an ID, place & send eleID size, numArgs and length of all responseArgs
   //
 
-  static ID idData(7);
+  static ID idData(8);
   if (eleID != 0)
     idData(0) = eleID->Size();
   else
@@ -602,6 +567,7 @@ EnvelopeElementRecorder::sendSelf(int commitTag, Channel &theChannel)
 
   idData(5) = this->getTag();
   idData(6) = numDOF;
+  idData(7) = numStats;
 
   int msgLength = 0;
   for (int i=0; i<numArgs; i++) 
@@ -723,7 +689,7 @@ EnvelopeElementRecorder::recvSelf(int commitTag, Channel &theChannel,
   // into an ID of size 2 recv eleID size and length of all responseArgs
   //
 
-  static ID idData(7);
+  static ID idData(8);
   if (theChannel.recvID(0, commitTag, idData) < 0) {
     opserr << "EnvelopeElementRecorder::recvSelf() - failed to recv idData\n";
     return -1;
@@ -733,6 +699,7 @@ EnvelopeElementRecorder::recvSelf(int commitTag, Channel &theChannel,
   numArgs = idData(1);
   int msgLength = idData(2);
   numDOF = idData(6);
+  numStats = idData(7);
 
   this->setTag(idData(5));
 
@@ -920,6 +887,7 @@ EnvelopeElementRecorder::initialize(void)
 	  theHandler->tag("EnvelopeElementOutput");	  
 	
 	theResponses[ii] = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+	theResponses[ii] = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponses[ii]);
 	if (theResponses[ii] != 0) {
 	  // from the response type determine no of cols for each      
 	  Information &eleInfo = theResponses[ii]->getInformation();
@@ -990,6 +958,7 @@ EnvelopeElementRecorder::initialize(void)
 
     while ((theEle = theElements()) != 0) {
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+      theResponse = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponse);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
 	  Response **theNextResponses = new Response *[numEle*2];
@@ -999,6 +968,8 @@ EnvelopeElementRecorder::initialize(void)
 	    for (int j=numEle; j<2*numEle; j++)
 	      theNextResponses[j] = 0;
 	  }
+	  delete [] theResponses;
+	  theResponses = theNextResponses;
 	  numEle = 2*numEle;
 	}
 	theResponses[numResponse] = theResponse;
@@ -1025,6 +996,30 @@ EnvelopeElementRecorder::initialize(void)
     numEle = numResponse;
   }
 
+  //
+  // fix the value columns of each response so record() need not count them
+  //
+
+  if (gatherOffset != 0)
+    delete gatherOffset;
+  if (gatherSize != 0)
+    delete gatherSize;
+  gatherOffset = new ID(numEle);
+  gatherSize = new ID(numEle);
+
+  int loc = 0;
+  for (i=0; i<numEle; i++) {
+    (*gatherOffset)(i) = -1;
+    (*gatherSize)(i) = 0;
+    if (theResponses[i] != 0) {
+      int dataSize = theResponses[i]->getInformation().getData().Size();
+      (*gatherOffset)(i) = loc;
+      (*gatherSize)(i) = dataSize;
+      loc += (numDOF == 0) ? dataSize : numDOF;
+    }
+  }
+  numDbColumns = loc;
+
   //
   // create the matrix & vector that holds the data
   //
@@ -1033,7 +1028,11 @@ EnvelopeElementRecorder::initialize(void)
     numDbColumns *= 2;
   }
 
-  data = new Matrix(3, numDbColumns);
+  if (data != 0)
+    delete data;
+  if (currentData != 0)
+    delete currentData;
+  data = new Matrix(numStats, numDbColumns);
   currentData = new Vector(numDbColumns);
   if (data == 0 || currentData == 0) {
     opserr << "EnvelopeElementRecorder::EnvelopeElementRecorder() - out of memory\n";
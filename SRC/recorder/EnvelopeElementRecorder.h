@@ -55,7 +55,8 @@ class EnvelopeElementRecorder: public Recorder
 			    double relDeltaTTol = 0.00001,
 			    bool echoTimeFlag = true,
 			    const ID *dof =0,
-			    bool closeOnWrite = false); 
+			    bool closeOnWrite = false,
+			    bool doRMS = false); 
 
 
     ~EnvelopeElementRecorder();
@@ -74,6 +75,7 @@ class EnvelopeElementRecorder: public Recorder
     
   private:	
     int initialize(void);
+    void writeEnvelope(void);
 
     int numEle;
     int numDOF;
@@ -83,6 +85,11 @@ class EnvelopeElementRecorder: public Recorder
 
     Response **theResponses;
 
+    // gather plan set in initialize(): the first value column of each
+    // response (-1 if there is none) & the size of its data vector
+    ID *gatherOffset;
+    ID *gatherSize;
+
     Domain *theDomain;
     OPS_Stream *theHandler;
 
@@ -90,9 +97,11 @@ class EnvelopeElementRecorder: public Recorder
     double relDeltaTTol;
     double nextTimeStampToRecord;
 
-    Matrix *data;
-    Vector *currentData;
+    Matrix *data;          // numStats rows, see EnvelopeReduction
+    Vector *currentData;   // a row of data when written
     bool first;
+    int numStats;          // 3, or 4 when the RMS is also recorded
+    int count;             // steps reduced, for the RMS
 
     bool initializationDone;
     char **responseArgs;
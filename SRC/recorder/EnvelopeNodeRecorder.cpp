@@ -38,6 +38,7 @@
 #include <FEM_ObjectBroker.h>
 #include <MeshRegion.h>
 #include <TimeSeries.h>
+#include <EnvelopeReduction.h>
 
 #include <StandardStream.h>
 #include <DataFileStream.h>
@@ -85,6 +86,7 @@ OPS_EnvelopeNodeRecorder()
     int precision = 6;
 
     bool closeOnWrite = false;
+    bool doRMS = false;
 
     const char *inetAddr = 0;
     int inetPort;
@@ -124,6 +126,9 @@ OPS_EnvelopeNodeRecorder()
         else if (strcmp(option, "-closeOnWrite") == 0) {
             closeOnWrite = true;
         }
+        else if (strcmp(option, "-rms") == 0) {
+            doRMS = true;
+        }
         else if (strcmp(option, "-csv") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 filename = OPS_GetString();
@@ -297,7 +302,7 @@ OPS_EnvelopeNodeRecorder()
         return 0;
     EnvelopeNodeRecorder* recorder = new EnvelopeNodeRecorder(dofs, &nodes,
 							      responseID, *domain, *theOutputStream,
-							      dT, rTolDt, echoTimeFlag, theTimeSeries, closeOnWrite);
+							      dT, rTolDt, echoTimeFlag, theTimeSeries, closeOnWrite, doRMS);
 
     return recorder;
 }
@@ -310,7 +315,8 @@ EnvelopeNodeRecorder::EnvelopeNodeRecorder()
  theDomain(0), theHandler(0),
  deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0),
  first(true), initializationDone(false), 
- numValidNodes(0), addColumnInfo(0), theTimeSeries(0), timeSeriesValues(0)
+ numValidNodes(0), addColumnInfo(0), theTimeSeries(0), timeSeriesValues(0),
+ closeOnWrite(false), numStats(3), count(0)
 {
 
 }
@@ -324,14 +330,16 @@ EnvelopeNodeRecorder::EnvelopeNodeRecorder(const ID &dofs,
 					   double rTolDt,
 					   bool echoTime,
 					   TimeSeries **theSeries,
-					   bool closeOnW)
+					   bool closeOnW,
+					   bool doRMS)
 :Recorder(RECORDER_TAGS_EnvelopeNodeRecorder),
  theDofs(0), theNodalTags(0), theNodes(0),
  currentData(0), data(0), 
  theDomain(&theDom), theHandler(&theOutputHandler),
  deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0),
  first(true), initializationDone(false), numValidNodes(0), echoTimeFlag(echoTime), 
- addColumnInfo(0), theTimeSeries(theSeries), timeSeriesValues(0), closeOnWrite(closeOnW)
+ addColumnInfo(0), theTimeSeries(theSeries), timeSeriesValues(0), closeOnWrite(closeOnW),
+ numStats(doRMS ? 4 : 3), count(0)
 {
   // verify dof are valid 
   int numDOF = dofs.Size();
@@ -450,20 +458,8 @@ EnvelopeNodeRecorder::~EnvelopeNodeRecorder()
   // write the data
   //
 
-  if (theHandler != 0 && data != 0) {
-    
-    theHandler->tag("Data"); // Data
-    
-    int numResponse = data->noCols();
-    
-    for (int i=0; i<3; i++) {
-      for (int j=0; j<numResponse; j++)
-	(*currentData)(j) = (*data)(i,j);
-      theHandler->write(*currentData);
-    }
-      
-    theHandler->endTag(); // Data
-  }
+  if (theHandler != 0 && data != 0)
+    this->writeEnvelope();
 
   //
   // clean up the memory
@@ -571,9 +567,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	  }
 
 	  if (response.Size() > dof) {
-	    (*currentData)(cnt) = response(dof) + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, response(dof) + timeSeriesTerm, timeStamp);
 	  }else 
-	    (*currentData)(cnt) = 0.0 + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, 0.0 + timeSeriesTerm, timeStamp);
 	  
 	  cnt++;
 	}
@@ -594,7 +590,7 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	    sum += timeSeriesTerm * timeSeriesTerm;    
 	}
 
-	(*currentData)(cnt) = sqrt(sum);
+	writeIt |= this->reduceValue(cnt, sqrt(sum), timeStamp);
 	cnt++;
 
       } else if (dataFlag == 1) {
@@ -607,9 +603,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 
 	  int dof = (*theDofs)(j);
 	  if (response.Size() > dof) {
-	    (*currentData)(cnt) = response(dof) + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, response(dof) + timeSeriesTerm, timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0 + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, 0.0 + timeSeriesTerm, timeStamp);
 	  
 	  cnt++;
 	}
@@ -623,9 +619,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 
 	  int dof = (*theDofs)(j);
 	  if (response.Size() > dof) {
-	    (*currentData)(cnt) = response(dof) + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, response(dof) + timeSeriesTerm, timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0 + timeSeriesTerm;
+	    writeIt |= this->reduceValue(cnt, 0.0 + timeSeriesTerm, timeStamp);
 	  
 	  cnt++;
 	}
@@ -634,9 +630,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	for (int j=0; j<numDOF; j++) {
 	  int dof = (*theDofs)(j);
 	  if (response.Size() > dof) {
-	    (*currentData)(cnt) = response(dof);
+	    writeIt |= this->reduceValue(cnt, response(dof), timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	  
 	  cnt++;
 	}
@@ -645,9 +641,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	for (int j=0; j<numDOF; j++) {
 	  int dof = (*theDofs)(j);
 	  if (response.Size() > dof) {
-	    (*currentData)(cnt) = response(dof);
+	    writeIt |= this->reduceValue(cnt, response(dof), timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	  
 	  cnt++;
 	}
@@ -656,9 +652,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	for (int j=0; j<numDOF; j++) {
 	  int dof = (*theDofs)(j);
 	  if (theResponse.Size() > dof) {
-	    (*currentData)(cnt) = theResponse(dof);
+	    writeIt |= this->reduceValue(cnt, theResponse(dof), timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	  
 	  cnt++;
 	}
@@ -668,9 +664,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	for (int j=0; j<numDOF; j++) {
 	  int dof = (*theDofs)(j);
 	  if (theResponse.Size() > dof) {
-	    (*currentData)(cnt) = theResponse(dof);
+	    writeIt |= this->reduceValue(cnt, theResponse(dof), timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	  
 	  cnt++;
 	}
@@ -680,9 +676,9 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	for (int j=0; j<numDOF; j++) {
 	  int dof = (*theDofs)(j);
 	  if (theResponse.Size() > dof) {
-	    (*currentData)(cnt) = theResponse(dof);
+	    writeIt |= this->reduceValue(cnt, theResponse(dof), timeStamp);
 	  } else 
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	  
 	  cnt++;
 	}
@@ -696,105 +692,27 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 	  for (int j=0; j<numDOF; j++) {
 	    int dof = (*theDofs)(j);
 	    if (noRows > dof) {
-	      (*currentData)(cnt) = theEigenvectors(dof,column);
+	      writeIt |= this->reduceValue(cnt, theEigenvectors(dof,column), timeStamp);
 	    } else 
-	      (*currentData)(cnt) = 0.0;
+	      writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	    cnt++;		
 	  }
 	} else {
 	  for (int j=0; j<numDOF; j++) {
-	    (*currentData)(cnt) = 0.0;
+	    writeIt |= this->reduceValue(cnt, 0.0, timeStamp);
 	    cnt++;		
 	  }
 	}
       }
     }
-  }
-
-  // check if currentData modifies the saved data
-  int sizeData = currentData->Size();
-  if (echoTimeFlag == false) {
-
-    if (first == true) {
-      for (int i=0; i<sizeData; i++) {
-	(*data)(0,i) = (*currentData)(i);
-	(*data)(1,i) = (*currentData)(i);
-	(*data)(2,i) = fabs((*currentData)(i));
-	first = false;
-      } 
-    } else {
-      for (int i=0; i<sizeData; i++) {
-	double value = (*currentData)(i);
-	if ((*data)(0,i) > value) {
-	  (*data)(0,i) = value;
-	  double absValue = fabs(value);
-	  if ((*data)(2,i) < absValue) 
-	    (*data)(2,i) = absValue;
-	  writeIt = true;
-	} else if ((*data)(1,i) < value) {
-	  (*data)(1,i) = value;
-	  double absValue = fabs(value);
-	  if ((*data)(2,i) < absValue) 
-	    (*data)(2,i) = absValue;
-	  writeIt = true;
-	}
-      }
-    }
-  } else {
-    sizeData /= 2;
-    if (first == true) {
-      for (int i=0; i<sizeData; i++) {
-
-	(*data)(0,i*2) = timeStamp;
-	(*data)(1,i*2) = timeStamp;
-	(*data)(2,i*2) = timeStamp;
-	(*data)(0,i*2+1) = (*currentData)(i);
-	(*data)(1,i*2+1) = (*currentData)(i);
-	(*data)(2,i*2+1) = fabs((*currentData)(i));
-	first = false;
-	writeIt = true;
-      } 
-    } else {
-      for (int i=0; i<sizeData; i++) {
-	double value = (*currentData)(i);
-	if ((*data)(0,2*i+1) > value) {
-	  (*data)(0,i*2) = timeStamp;
-	  (*data)(0,i*2+1) = value;
-	  double absValue = fabs(value);
-	  if ((*data)(2,i*2+1) < absValue) {
-	    (*data)(2,i*2+1) = absValue;
-	    (*data)(2,i*2) = timeStamp;
-	  }
-	  writeIt = true;
-	} else if ((*data)(1,i*2+1) < value) {
-	  (*data)(1,i*2) = timeStamp;
-	  (*data)(1,i*2+1) = value;
-	  double absValue = fabs(value);
-	  if ((*data)(2,i*2+1) < absValue) { 
-	    (*data)(2,i*2) = timeStamp;
-	    (*data)(2,i*2+1) = absValue;
-	  }
-	  writeIt = true;
-	}
-      }
-    }
+    first = false;
+    count++;
   }
 
   if (closeOnWrite == true && writeIt == true) {
     if (theHandler != 0 && data != 0) {
-
       theHandler->open(); // open the handler to force it to write
-      theHandler->tag("Data"); // Data
-      
-      int numResponse = data->noCols();
-      
-      for (int i=0; i<3; i++) {
-	for (int j=0; j<numResponse; j++)
-	  (*currentData)(j) = (*data)(i,j);
-	theHandler->write(*currentData);
-      }
-
-      theHandler->endTag(); // Data
+      this->writeEnvelope();
     }
   }
   
@@ -802,11 +720,51 @@ EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 }
 
 
+// bool reduceValue(int col, double value, double time);
+//	reduces the value of response col into its statistics, returns true if
+//	its min or max changed. With the time echoed the column's statistics
+//	follow those of the times they were reached.
+
+bool
+EnvelopeNodeRecorder::reduceValue(int col, double value, double time)
+{
+  double *stats = &(*data)(0,0);
+  if (echoTimeFlag == false)
+    return EnvelopeReduction::reduce(&stats[col*numStats], numStats, value, first);
+  else
+    return EnvelopeReduction::reduce(&stats[(2*col+1)*numStats], &stats[2*col*numStats],
+				     numStats, value, time, first);
+}
+
+// void writeEnvelope(void);
+//	writes a row for each statistic, the RMS from the sum of squares.
+
+void
+EnvelopeNodeRecorder::writeEnvelope(void)
+{
+  theHandler->tag("Data"); // Data
+
+  int numResponse = data->noCols();
+  for (int i=0; i<numStats; i++) {
+    for (int j=0; j<numResponse; j++) {
+      // the time columns hold the time itself
+      if (echoTimeFlag == true && j%2 == 0)
+	(*currentData)(j) = (*data)(i,j);
+      else
+	(*currentData)(j) = EnvelopeReduction::result(i, (*data)(i,j), count);
+    }
+    theHandler->write(*currentData);
+  }
+
+  theHandler->endTag(); // Data
+}
+
 int
 EnvelopeNodeRecorder::restart(void)
 {
   data->Zero();
   first = true;
+  count = 0;
   return 0;
 }
 
@@ -833,7 +791,7 @@ EnvelopeNodeRecorder::sendSelf(int commitTag, Channel &theChannel)
   }
 
   initializationDone = false;
-  static ID idData(7); 
+  static ID idData(8); 
   idData.Zero();
 
   if (theDofs != 0)
@@ -858,6 +816,8 @@ EnvelopeNodeRecorder::sendSelf(int commitTag, Channel &theChannel)
   else
     idData[6] = 1;
 
+  idData(7) = numStats;
+
   if (theChannel.sendID(0, commitTag, idData) < 0) {
     opserr << "EnvelopeNodeRecorder::sendSelf() - failed to send idData\n";
     return -1;
@@ -926,7 +886,7 @@ EnvelopeNodeRecorder::recvSelf(int commitTag, Channel &theChannel,
     return -1;
   }
 
-  static ID idData(7); 
+  static ID idData(8); 
   if (theChannel.recvID(0, commitTag, idData) < 0) {
     opserr << "EnvelopeNodeRecorder::recvSelf() - failed to send idData\n";
     return -1;
@@ -938,6 +898,7 @@ EnvelopeNodeRecorder::recvSelf(int commitTag, Channel &theChannel,
   dataFlag = idData(3);
 
   this->setTag(idData(5));
+  numStats = idData(7);
 
   if (idData(4) == 1)
     echoTimeFlag = true;
@@ -1143,8 +1104,13 @@ EnvelopeNodeRecorder::initialize(void)
     numValidResponse *= 2;
   }
 
+  if (currentData != 0)
+    delete currentData;
+  if (data != 0)
+    delete data;
+
   currentData = new Vector(numValidResponse);
-  data = new Matrix(3, numValidResponse);
+  data = new Matrix(numStats, numValidResponse);
   data->Zero();
 
   ID dataOrder(numValidResponse);
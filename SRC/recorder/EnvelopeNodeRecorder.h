@@ -61,7 +61,8 @@ class EnvelopeNodeRecorder: public Recorder
 			 double relDeltaTTol = 0.00001,
 			 bool echoTimeFlag = false,
 			 TimeSeries **theTimeSeries =0,
-			 bool closeOnWrite = false); 
+			 bool closeOnWrite = false,
+			 bool doRMS = false); 
     
     ~EnvelopeNodeRecorder();
 
@@ -80,13 +81,15 @@ class EnvelopeNodeRecorder: public Recorder
     
   private:	
     int initialize(void);
+    bool reduceValue(int col, double value, double time);
+    void writeEnvelope(void);
 
     ID *theDofs;
     ID *theNodalTags;
     Node **theNodes;
 
-    Vector *currentData;
-    Matrix *data;
+    Vector *currentData;   // a row of data when written
+    Matrix *data;          // numStats rows, see EnvelopeReduction
 
     Domain *theDomain;
     OPS_Stream *theHandler;
@@ -107,6 +110,8 @@ class EnvelopeNodeRecorder: public Recorder
     TimeSeries **theTimeSeries;
     double *timeSeriesValues;
   bool closeOnWrite;
+    int numStats;          // 3, or 4 when the RMS is also recorded
+    int count;             // steps reduced, for the RMS
 };
 
 #endif
@@ -0,0 +1,115 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef EnvelopeReduction_h
+#define EnvelopeReduction_h
+
+// Description: the in place reductions of the envelope and RMS recorders.
+// The statistics of a recorded column are kept one after the other in a
+// column of the recorder's Matrix, [min max absMax sumSquares], so a
+// response value is taken straight from the Response or Node into its
+// statistics without a copy into a Vector of the step's values. The
+// sumSquares row is kept only when the recorder is asked for the RMS too,
+// which gives the four statistics in the one pass over the responses.
+
+#include <math.h>
+
+class EnvelopeReduction
+{
+  public:
+    enum {MIN = 0, MAX = 1, ABSMAX = 2, SUMSQUARES = 3};
+
+    // reduces value into the numStats statistics at stats, returns true
+    // if the min or max changed; the first value sets all of them
+    static bool reduce(double *stats, int numStats, double value, bool first)
+    {
+      double absValue = fabs(value);
+      if (first == true) {
+	stats[MIN] = value;
+	stats[MAX] = value;
+	stats[ABSMAX] = absValue;
+	if (numStats > SUMSQUARES)
+	  stats[SUMSQUARES] = value*value;
+	return true;
+      }
+
+      bool changed = false;
+      if (value < stats[MIN]) {
+	stats[MIN] = value;
+	changed = true;
+      }
+      if (value > stats[MAX]) {
+	stats[MAX] = value;
+	changed = true;
+      }
+      if (absValue > stats[ABSMAX])
+	stats[ABSMAX] = absValue;
+      if (numStats > SUMSQUARES)
+	stats[SUMSQUARES] += value*value;
+
+      return changed;
+    }
+
+    // as above, also keeping at timeStats the time each statistic was
+    // reached, the time of the last step for the sum of squares
+    static bool reduce(double *stats, double *timeStats, int numStats,
+		       double value, double time, bool first)
+    {
+      double absValue = fabs(value);
+      if (first == true) {
+	for (int i=0; i<numStats; i++)
+	  timeStats[i] = time;
+	return reduce(stats, numStats, value, true);
+      }
+
+      bool changed = false;
+      if (value < stats[MIN]) {
+	stats[MIN] = value;
+	timeStats[MIN] = time;
+	changed = true;
+      }
+      if (value > stats[MAX]) {
+	stats[MAX] = value;
+	timeStats[MAX] = time;
+	changed = true;
+      }
+      if (absValue > stats[ABSMAX]) {
+	stats[ABSMAX] = absValue;
+	timeStats[ABSMAX] = time;
+      }
+      if (numStats > SUMSQUARES) {
+	stats[SUMSQUARES] += value*value;
+	timeStats[SUMSQUARES] = time;
+      }
+
+      return changed;
+    }
+
+    // the value written for statistic i of a column, given its stored
+    // value & the number of steps reduced
+    static double result(int i, double stat, int count)
+    {
+      if (i == SUMSQUARES)
+	return (count > 0) ? sqrt(stat/count) : 0.0;
+      return stat;
+    }
+};
+
+#endif
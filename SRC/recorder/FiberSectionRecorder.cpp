@@ -0,0 +1,514 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+// Description: This file contains the class implementation for
+// FiberSectionRecorder.
+
+#include <FiberSectionRecorder.h>
+#include <CompressedFileBuf.h>
+#include <SectionForceDeformation.h>
+#include <Domain.h>
+#include <Element.h>
+#include <elementAPI.h>
+#include <string.h>
+
+void *
+OPS_FiberSectionRecorder()
+{
+  if (OPS_GetNumRemainingInputArgs() < 4) {
+    opserr << "WARNING recorder FiberSection -file fileName? <-float32 | -float16> <-compress codec?> "
+	   << "<-dT dT?> <-rTolDt tol?> -ele eleTags? | -eleRange start? end? <-section secNums?>\n";
+    return 0;
+  }
+
+  Domain *domain = OPS_GetDomain();
+  if (domain == 0)
+    return 0;
+
+  const char *filename = 0;
+  const char *compression = 0;
+  int valueType = FiberSectionRecorder::DOUBLE;
+  double dT = 0.0;
+  double rTolDt = 0.00001;
+
+  ID elements(0, 6);
+  ID sections(0, 6);
+  int numEle = 0;
+  int numSec = 0;
+
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *option = OPS_GetString();
+    int numdata = 1;
+
+    if (strcmp(option, "-file") == 0 || strcmp(option, "-binary") == 0) {
+      if (OPS_GetNumRemainingInputArgs() > 0)
+	filename = OPS_GetString();
+    }
+    else if (strcmp(option, "-float32") == 0) {
+      valueType = FiberSectionRecorder::FLOAT32;
+    }
+    else if (strcmp(option, "-float16") == 0) {
+      valueType = FiberSectionRecorder::FLOAT16;
+    }
+    else if (strcmp(option, "-compress") == 0) {
+      if (OPS_GetNumRemainingInputArgs() > 0)
+	compression = OPS_GetString();
+    }
+    else if (strcmp(option, "-dT") == 0) {
+      if (OPS_GetDoubleInput(&numdata, &dT) < 0) {
+	opserr << "WARNING recorder FiberSection - failed to read dT\n";
+	return 0;
+      }
+    }
+    else if (strcmp(option, "-rTolDt") == 0) {
+      if (OPS_GetDoubleInput(&numdata, &rTolDt) < 0) {
+	opserr << "WARNING recorder FiberSection - failed to read rTolDt\n";
+	return 0;
+      }
+    }
+    else if (strcmp(option, "-ele") == 0) {
+      while (OPS_GetNumRemainingInputArgs() > 0) {
+	int el;
+	if (OPS_GetIntInput(&numdata, &el) < 0) {
+	  OPS_ResetCurrentInputArg(-1);
+	  break;
+	}
+	elements[numEle++] = el;
+      }
+    }
+    else if (strcmp(option, "-eleRange") == 0) {
+      int range[2];
+      numdata = 2;
+      if (OPS_GetIntInput(&numdata, range) < 0) {
+	opserr << "WARNING recorder FiberSection - failed to read -eleRange start? end?\n";
+	return 0;
+      }
+      int start = range[0] < range[1] ? range[0] : range[1];
+      int end = range[0] < range[1] ? range[1] : range[0];
+      for (int i = start; i <= end; i++)
+	elements[numEle++] = i;
+    }
+    else if (strcmp(option, "-section") == 0 || strcmp(option, "section") == 0) {
+      while (OPS_GetNumRemainingInputArgs() > 0) {
+	int sec;
+	if (OPS_GetIntInput(&numdata, &sec) < 0) {
+	  OPS_ResetCurrentInputArg(-1);
+	  break;
+	}
+	sections[numSec++] = sec;
+      }
+    }
+    else {
+      opserr << "WARNING recorder FiberSection - unknown option " << option << endln;
+      return 0;
+    }
+  }
+
+  if (filename == 0) {
+    opserr << "WARNING recorder FiberSection - no -file given\n";
+    return 0;
+  }
+  if (numEle == 0) {
+    opserr << "WARNING recorder FiberSection - no elements given\n";
+    return 0;
+  }
+  if (compression != 0 && CompressedFileBuf::getCodec(compression) < 0) {
+    opserr << "WARNING recorder FiberSection - -compress " << compression
+	   << " not available in this build, written uncompressed\n";
+    compression = 0;
+  }
+
+  return new FiberSectionRecorder(elements, numSec != 0 ? &sections : 0, *domain,
+				  filename, valueType, compression, dT, rTolDt);
+}
+
+
+FiberSectionRecorder::FiberSectionRecorder()
+  :Recorder(RECORDER_TAGS_FiberSectionRecorder),
+   eleTags(0), secNums(0), theDomain(0), fileName(0), theCompression(0), fileOpen(false),
+   valueType(DOUBLE), theSections(0), numSections(0), sectionEle(0),
+   fiberData(0), outData(0), maxFibers(0),
+   initializationDone(false), headerWritten(false),
+   deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0)
+{
+
+}
+
+
+FiberSectionRecorder::FiberSectionRecorder(const ID &theEleTags,
+					   const ID *theSecNums,
+					   Domain &theDom,
+					   const char *theFileName,
+					   int type,
+					   const char *codec,
+					   double dT,
+					   double rTolDt)
+  :Recorder(RECORDER_TAGS_FiberSectionRecorder),
+   eleTags(theEleTags), secNums(0), theDomain(&theDom), fileName(0), theCompression(0), fileOpen(false),
+   valueType(type), theSections(0), numSections(0), sectionEle(0),
+   fiberData(0), outData(0), maxFibers(0),
+   initializationDone(false), headerWritten(false),
+   deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0)
+{
+  if (theSecNums != 0)
+    secNums = new ID(*theSecNums);
+
+  fileName = new char[strlen(theFileName)+1];
+  strcpy(fileName, theFileName);
+
+  if (codec != 0) {
+    int theCodec = CompressedFileBuf::getCodec(codec);
+    if (theCodec > CompressedFileBuf::NONE)
+      theCompression = new CompressedFileBuf(theCodec);
+  }
+}
+
+
+FiberSectionRecorder::~FiberSectionRecorder()
+{
+  this->closeFile();
+
+  if (theCompression != 0)
+    delete theCompression;
+
+  if (secNums != 0)
+    delete secNums;
+
+  if (fileName != 0)
+    delete [] fileName;
+
+  if (theSections != 0)
+    delete [] theSections;
+
+  if (fiberData != 0)
+    delete [] fiberData;
+
+  if (outData != 0)
+    delete [] outData;
+}
+
+
+int
+FiberSectionRecorder::record(int commitTag, double timeStamp)
+{
+  if (theDomain == 0 || eleTags.Size() == 0)
+    return 0;
+
+  if (initializationDone == false) {
+    if (this->initialize() != 0) {
+      opserr << "FiberSectionRecorder::record() - failed to initialize\n";
+      return -1;
+    }
+  }
+
+  if (numSections == 0 || fileOpen == false)
+    return 0;
+
+  // where relDeltaTTol is the maximum reliable ratio between analysis time step and deltaT
+  // and provides tolerance for floating point precision (see floating-point-tolerance-for-recorder-time-step.md)
+  if (deltaT == 0.0 || timeStamp - nextTimeStampToRecord >= -deltaT * relDeltaTTol) {
+
+    if (deltaT != 0.0)
+      nextTimeStampToRecord = timeStamp + deltaT;
+
+    theFile.write((const char *)&timeStamp, sizeof(double));
+
+    //
+    // each section fills the strains & then the stresses of its fibers
+    //
+
+    for (int i = 0; i < numSections; i++) {
+      int numFibers = sectionEle(3*i+2);
+      if (theSections[i]->getFiberStrainStress(fiberData, &fiberData[numFibers]) < 0) {
+	for (int j = 0; j < 2*numFibers; j++)
+	  fiberData[j] = 0.0;
+      }
+      this->writeValues(fiberData, 2*numFibers);
+    }
+
+    if (theFile.bad()) {
+      opserr << "FiberSectionRecorder::record() - failed to write to file " << fileName << endln;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+
+int
+FiberSectionRecorder::restart(void)
+{
+  // the next record starts the file over with its header
+  this->closeFile();
+  headerWritten = false;
+  initializationDone = false;
+  nextTimeStampToRecord = 0.0;
+  return 0;
+}
+
+
+int
+FiberSectionRecorder::flush(void)
+{
+  if (fileOpen == true)
+    theFile.flush();
+  return 0;
+}
+
+
+int
+FiberSectionRecorder::setDomain(Domain &theDom)
+{
+  theDomain = &theDom;
+  initializationDone = false;
+  return 0;
+}
+
+
+int
+FiberSectionRecorder::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "FiberSectionRecorder::sendSelf() - not implemented, the fibers are recorded on the main process\n";
+  return -1;
+}
+
+
+int
+FiberSectionRecorder::recvSelf(int commitTag, Channel &theChannel,
+			       FEM_ObjectBroker &theBroker)
+{
+  opserr << "FiberSectionRecorder::recvSelf() - not implemented\n";
+  return -1;
+}
+
+
+// unsigned short toFloat16(double value);
+//	the IEEE 754 half precision bits of value, rounded to nearest even;
+//	values beyond the range of a half become infinite, those below it 0.
+unsigned short
+FiberSectionRecorder::toFloat16(double value)
+{
+  float f = (float)value;
+  unsigned int bits;
+  memcpy(&bits, &f, sizeof(bits));
+
+  unsigned int sign = (bits >> 16) & 0x8000;
+  unsigned int mant = bits & 0x007fffff;
+  int exp = (int)((bits >> 23) & 0xff) - 127 + 15;
+
+  // inf & nan
+  if ((bits & 0x7fffffff) >= 0x7f800000)
+    return (unsigned short)(sign | 0x7c00 | (mant != 0 ? 0x200 : 0));
+
+  // overflow
+  if (exp >= 31)
+    return (unsigned short)(sign | 0x7c00);
+
+  // subnormal or 0
+  if (exp <= 0) {
+    if (exp < -10)
+      return (unsigned short)sign;
+    mant |= 0x00800000;
+    int shift = 14 - exp;
+    unsigned int half = mant >> shift;
+    unsigned int rem = mant & ((1u << shift) - 1);
+    unsigned int halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (half & 1)))
+      half++;
+    return (unsigned short)(sign | half);
+  }
+
+  // a carry out of the mantissa correctly bumps the exponent
+  unsigned int half = sign | ((unsigned int)exp << 10) | (mant >> 13);
+  unsigned int rem = mant & 0x1fff;
+  if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+    half++;
+  return (unsigned short)half;
+}
+
+
+void
+FiberSectionRecorder::writeValues(const double *values, int n)
+{
+  if (valueType == DOUBLE) {
+    theFile.write((const char *)values, n*sizeof(double));
+    return;
+  }
+
+  if (valueType == FLOAT32) {
+    float *out = (float *)outData;
+    for (int i = 0; i < n; i++)
+      out[i] = (float)values[i];
+    theFile.write(outData, n*sizeof(float));
+  }
+  else {
+    unsigned short *out = (unsigned short *)outData;
+    for (int i = 0; i < n; i++)
+      out[i] = toFloat16(values[i]);
+    theFile.write(outData, n*sizeof(unsigned short));
+  }
+}
+
+
+int
+FiberSectionRecorder::openFile(void)
+{
+  if (theCompression != 0)
+    theCompression->open(theFile, fileName, false);
+  else
+    theFile.open(fileName, std::ios::out | std::ios::binary);
+
+  if (theFile.bad() || (theCompression == 0 && !theFile.is_open())) {
+    opserr << "WARNING FiberSectionRecorder - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  fileOpen = true;
+  return 0;
+}
+
+
+void
+FiberSectionRecorder::closeFile(void)
+{
+  if (theCompression != 0 && theCompression->isOpen())
+    theCompression->close(theFile);
+  else if (theFile.is_open())
+    theFile.close();
+  fileOpen = false;
+}
+
+
+int
+FiberSectionRecorder::initialize(void)
+{
+  initializationDone = true; // still might fail but don't want back in again
+
+  //
+  // collect the fiber sections of the elements
+  //
+
+  ID theSectionEle(0, 3*eleTags.Size());
+  int maxSections = 0;
+  for (int i = 0; i < eleTags.Size(); i++) {
+    Element *theEle = theDomain->getElement(eleTags(i));
+    if (theEle != 0)
+      maxSections += theEle->getNumSections();
+  }
+
+  SectionForceDeformation **theNewSections = 0;
+  if (maxSections > 0)
+    theNewSections = new SectionForceDeformation *[maxSections];
+
+  int count = 0;
+  int maxFib = 0;
+  for (int i = 0; i < eleTags.Size(); i++) {
+    Element *theEle = theDomain->getElement(eleTags(i));
+    if (theEle == 0) {
+      opserr << "WARNING FiberSectionRecorder - element " << eleTags(i) << " not found\n";
+      continue;
+    }
+    int numSec = theEle->getNumSections();
+    if (numSec == 0) {
+      opserr << "WARNING FiberSectionRecorder - element " << eleTags(i)
+	     << " gives no access to its sections\n";
+      continue;
+    }
+    int numWanted = secNums != 0 ? secNums->Size() : numSec;
+    for (int j = 0; j < numWanted; j++) {
+      int secNum = secNums != 0 ? (*secNums)(j) : j+1;
+      SectionForceDeformation *theSection = theEle->getSection(secNum-1);
+      if (theSection == 0 || theSection->getNumFibers() <= 0)
+	continue;
+      int numFibers = theSection->getNumFibers();
+      theNewSections[count] = theSection;
+      theSectionEle[3*count] = eleTags(i);
+      theSectionEle[3*count+1] = secNum;
+      theSectionEle[3*count+2] = numFibers;
+      if (numFibers > maxFib)
+	maxFib = numFibers;
+      count++;
+    }
+  }
+
+  // once the header is written the layout of the records is fixed
+  if (headerWritten == true && (count != numSections || theSectionEle != sectionEle)) {
+    opserr << "WARNING FiberSectionRecorder - the fiber sections have changed since file "
+	   << fileName << " was started\n";
+    if (theNewSections != 0)
+      delete [] theNewSections;
+    return -1;
+  }
+
+  if (theSections != 0)
+    delete [] theSections;
+  theSections = theNewSections;
+  numSections = count;
+  sectionEle = theSectionEle;
+
+  if (numSections == 0) {
+    opserr << "WARNING FiberSectionRecorder - no fiber sections in the elements given\n";
+    return 0;
+  }
+
+  if (maxFib > maxFibers) {
+    if (fiberData != 0)
+      delete [] fiberData;
+    if (outData != 0)
+      delete [] outData;
+    maxFibers = maxFib;
+    fiberData = new double[3*maxFibers];
+    outData = new char[2*maxFibers*sizeof(float)];
+  }
+
+  if (headerWritten == true)
+    return 0;
+
+  //
+  // open the file & write the header
+  //
+
+  if (this->openFile() != 0)
+    return -1;
+
+  const char magic[8] = {'O','P','S','F','I','B','E','R'};
+  int info[3] = {1, valueType, numSections};
+  theFile.write(magic, 8);
+  theFile.write((const char *)info, sizeof(info));
+  for (int i = 0; i < numSections; i++) {
+    int secInfo[3] = {sectionEle(3*i), sectionEle(3*i+1), sectionEle(3*i+2)};
+    theFile.write((const char *)secInfo, sizeof(secInfo));
+  }
+  for (int i = 0; i < numSections; i++) {
+    int numFibers = sectionEle(3*i+2);
+    double *y = fiberData;
+    double *z = &fiberData[numFibers];
+    double *A = &fiberData[2*numFibers];
+    if (theSections[i]->getFiberGeometry(y, z, A) < 0) {
+      for (int j = 0; j < 3*numFibers; j++)
+	fiberData[j] = 0.0;
+    }
+    theFile.write((const char *)fiberData, 3*numFibers*sizeof(double));
+  }
+
+  headerWritten = true;
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+// Description: This file contains the class definition for
+// FiberSectionRecorder. A FiberSectionRecorder writes the strain & stress
+// of every fiber of the sections of a set of beam-column elements to a
+// binary file. Each section gives its fibers in bulk, as an array of the
+// strains and one of the stresses, so no Response object is made per
+// fiber. The values may be written as float16 or float32 to halve or
+// quarter the file, and the file may be compressed.
+//
+// The file holds, in the byte order of the machine:
+//    char[8] "OPSFIBER", int version, int bytes per value, int numSections
+//    per section: int eleTag, int section (from 1), int numFibers
+//    per section: double y[numFibers], z[numFibers], A[numFibers]
+// then a record per step:
+//    double time
+//    per section: strain[numFibers], stress[numFibers]
+
+#ifndef FiberSectionRecorder_h
+#define FiberSectionRecorder_h
+
+#include <Recorder.h>
+#include <ID.h>
+#include <fstream>
+
+class Domain;
+class SectionForceDeformation;
+class CompressedFileBuf;
+
+class FiberSectionRecorder: public Recorder
+{
+  public:
+    enum {FLOAT16 = 2, FLOAT32 = 4, DOUBLE = 8}; // the bytes per value
+
+    FiberSectionRecorder();
+    FiberSectionRecorder(const ID &eleTags,
+			 const ID *secNums,
+			 Domain &theDomain,
+			 const char *fileName,
+			 int valueType = DOUBLE,
+			 const char *codec = 0,
+			 double deltaT = 0.0,
+			 double relDeltaTTol = 0.00001);
+    ~FiberSectionRecorder();
+
+    int record(int commitTag, double timeStamp);
+    int restart(void);
+    int flush(void);
+
+    int setDomain(Domain &theDomain);
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    static unsigned short toFloat16(double value);
+
+  protected:
+
+  private:
+    int initialize(void);
+    int openFile(void);
+    void closeFile(void);
+    void writeValues(const double *values, int n);
+
+    ID eleTags;
+    ID *secNums;           // the sections of each element, 0 for all
+
+    Domain *theDomain;
+    char *fileName;
+    std::ofstream theFile;
+    CompressedFileBuf *theCompression;
+    bool fileOpen;
+    int valueType;
+
+    SectionForceDeformation **theSections;
+    int numSections;
+    ID sectionEle;         // eleTag, section & numFibers of the sections
+    double *fiberData;     // strains & stresses of a section
+    char *outData;         // the same as they are written
+    int maxFibers;
+
+    bool initializationDone;
+    bool headerWritten;
+
+    double deltaT;
+    double relDeltaTTol;
+    double nextTimeStampToRecord;
+};
+
+#endif
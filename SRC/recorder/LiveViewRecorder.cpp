@@ -0,0 +1,501 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// LiveViewRecorder.
+
+#include <LiveViewRecorder.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Vector.h>
+#include <Socket.h>
+#include <elementAPI.h>
+#include <classTags.h>
+
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define closeSocket closesocket
+#else
+#include <fcntl.h>
+#include <errno.h>
+#define closeSocket close
+#endif
+
+// a send to a viewer gone away fails rather than raising SIGPIPE
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static int
+setNonBlocking(socket_type s)
+{
+#ifdef _WIN32
+  u_long on = 1;
+  return ioctlsocket(s, FIONBIO, &on);
+#else
+  int flags = fcntl(s, F_GETFL, 0);
+  return fcntl(s, F_SETFL, flags | O_NONBLOCK);
+#endif
+}
+
+// true if the failed call on a non-blocking socket only has to wait
+static bool
+wouldBlock(void)
+{
+#ifdef _WIN32
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR;
+#endif
+}
+
+static bool
+isValid(socket_type s)
+{
+#ifdef _WIN32
+  return s != INVALID_SOCKET;
+#else
+  return s >= 0;
+#endif
+}
+
+static void
+addBytes(std::vector<char> &buffer, const void *data, size_t numBytes)
+{
+  if (numBytes > 0)
+    buffer.insert(buffer.end(), (const char *)data, (const char *)data + numBytes);
+}
+
+
+void *
+OPS_LiveViewRecorder()
+{
+  if (OPS_GetNumRemainingInputArgs() < 2) {
+    opserr << "WARNING recorder LiveView -port port? <-bind address?> <-fps fps?> <-stride n?> "
+	   << "<-node tags? | -nodeRange start? end?> <-dof dofs?> <-scalar nodeTag? dof? ...>\n";
+    return 0;
+  }
+
+  Domain *domain = OPS_GetDomain();
+  if (domain == 0)
+    return 0;
+
+  int port = 0;
+  const char *bindAddress = "127.0.0.1";
+  double fps = 10.0;
+  int stride = 1;
+  ID nodes(0, 16);
+  bool allNodes = true;
+  ID dofs(0, 6);
+  ID scalarNodes(0, 4);
+  ID scalarDOFs(0, 4);
+
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *option = OPS_GetString();
+    int numdata = 1;
+
+    if (strcmp(option, "-port") == 0) {
+      if (OPS_GetIntInput(&numdata, &port) < 0) {
+	opserr << "WARNING recorder LiveView - failed to read port\n";
+	return 0;
+      }
+    }
+    else if (strcmp(option, "-bind") == 0) {
+      if (OPS_GetNumRemainingInputArgs() > 0)
+	bindAddress = OPS_GetString();
+    }
+    else if (strcmp(option, "-fps") == 0) {
+      if (OPS_GetDoubleInput(&numdata, &fps) < 0 || fps <= 0.0) {
+	opserr << "WARNING recorder LiveView - failed to read fps > 0\n";
+	return 0;
+      }
+    }
+    else if (strcmp(option, "-stride") == 0) {
+      if (OPS_GetIntInput(&numdata, &stride) < 0 || stride < 1) {
+	opserr << "WARNING recorder LiveView - failed to read stride >= 1\n";
+	return 0;
+      }
+    }
+    else if (strcmp(option, "-node") == 0) {
+      allNodes = false;
+      while (OPS_GetNumRemainingInputArgs() > 0) {
+	int nd;
+	if (OPS_GetIntInput(&numdata, &nd) < 0) {
+	  OPS_ResetCurrentInputArg(-1);
+	  break;
+	}
+	nodes[nodes.Size()] = nd;
+      }
+    }
+    else if (strcmp(option, "-nodeRange") == 0) {
+      int range[2];
+      numdata = 2;
+      if (OPS_GetIntInput(&numdata, range) < 0) {
+	opserr << "WARNING recorder LiveView -nodeRange start? end?\n";
+	return 0;
+      }
+      allNodes = false;
+      int start = range[0] < range[1] ? range[0] : range[1];
+      int end = range[0] < range[1] ? range[1] : range[0];
+      for (int i = start; i <= end; i++)
+	nodes[nodes.Size()] = i;
+    }
+    else if (strcmp(option, "-dof") == 0) {
+      while (OPS_GetNumRemainingInputArgs() > 0) {
+	int dof;
+	if (OPS_GetIntInput(&numdata, &dof) < 0) {
+	  OPS_ResetCurrentInputArg(-1);
+	  break;
+	}
+	dofs[dofs.Size()] = dof - 1;
+      }
+    }
+    else if (strcmp(option, "-scalar") == 0) {
+      int idata[2];
+      numdata = 2;
+      if (OPS_GetIntInput(&numdata, idata) < 0) {
+	opserr << "WARNING recorder LiveView -scalar nodeTag? dof?\n";
+	return 0;
+      }
+      scalarNodes[scalarNodes.Size()] = idata[0];
+      scalarDOFs[scalarDOFs.Size()] = idata[1] - 1;
+    }
+    else {
+      opserr << "WARNING recorder LiveView - unknown option " << option << endln;
+      return 0;
+    }
+  }
+
+  if (port <= 0) {
+    opserr << "WARNING recorder LiveView - need -port port\n";
+    return 0;
+  }
+
+  // the translations by default
+  if (dofs.Size() == 0) {
+    for (int i = 0; i < 3; i++)
+      dofs[i] = i;
+  }
+
+  return new LiveViewRecorder(*domain, (unsigned int)port, bindAddress,
+			      allNodes ? 0 : &nodes, dofs,
+			      scalarNodes, scalarDOFs, stride, fps);
+}
+
+
+LiveViewRecorder::LiveViewRecorder()
+  :Recorder(RECORDER_TAGS_LiveViewRecorder),
+   theDomain(0), nodeTags(0), dofs(0), scalarNodes(0), scalarDOFs(0), stride(1),
+   initializationDone(false), port(0), bindAddress(), listener(-1), viewer(-1),
+   period(), nextFrame(), numSent(0), frame(0), numDropped(0)
+{
+
+}
+
+
+LiveViewRecorder::LiveViewRecorder(Domain &theDom,
+				   unsigned int thePort,
+				   const char *address,
+				   const ID *theNodeTags,
+				   const ID &theDofs,
+				   const ID &theScalarNodes,
+				   const ID &theScalarDOFs,
+				   int theStride,
+				   double fps)
+  :Recorder(RECORDER_TAGS_LiveViewRecorder),
+   theDomain(&theDom), nodeTags(0), dofs(theDofs),
+   scalarNodes(theScalarNodes), scalarDOFs(theScalarDOFs), stride(theStride),
+   initializationDone(false), port(thePort), bindAddress(address != 0 ? address : "127.0.0.1"),
+   listener(-1), viewer(-1),
+   period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0/fps))),
+   nextFrame(std::chrono::steady_clock::now()),
+   numSent(0), frame(0), numDropped(0)
+{
+  if (theNodeTags != 0)
+    nodeTags = new ID(*theNodeTags);
+}
+
+
+LiveViewRecorder::~LiveViewRecorder()
+{
+  this->closeViewer();
+
+  if (listener >= 0)
+    closeSocket((socket_type)listener);
+
+  if (nodeTags != 0)
+    delete nodeTags;
+}
+
+
+int
+LiveViewRecorder::record(int commitTag, double timeStamp)
+{
+  if (theDomain == 0)
+    return 0;
+
+  if (initializationDone == false)
+    this->initialize();
+
+  // a viewer that cannot be reached never stops the analysis
+  if (listener < 0)
+    return 0;
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (now < nextFrame)
+    return 0;
+  nextFrame = now + period;
+
+  if (viewer < 0) {
+    socket_type theViewer = accept((socket_type)listener, 0, 0);
+    if (!isValid(theViewer))
+      return 0;
+    setNonBlocking(theViewer);
+    viewer = (long long)theViewer;
+    pending.clear();
+    numSent = 0;
+    this->addMesh();
+  }
+
+  // the viewer has not taken the last frame yet
+  if (this->sendPending() == false) {
+    if (viewer >= 0)
+      numDropped++;
+    return 0;
+  }
+
+  this->addFrame(timeStamp);
+  this->sendPending();
+
+  return 0;
+}
+
+
+int
+LiveViewRecorder::restart(void)
+{
+  return 0;
+}
+
+
+int
+LiveViewRecorder::setDomain(Domain &theDom)
+{
+  theDomain = &theDom;
+  initializationDone = false;
+  return 0;
+}
+
+
+int
+LiveViewRecorder::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "LiveViewRecorder::sendSelf() - not implemented, the viewer is served by the main process\n";
+  return -1;
+}
+
+
+int
+LiveViewRecorder::recvSelf(int commitTag, Channel &theChannel,
+			   FEM_ObjectBroker &theBroker)
+{
+  opserr << "LiveViewRecorder::recvSelf() - not implemented\n";
+  return -1;
+}
+
+
+int
+LiveViewRecorder::initialize(void)
+{
+  initializationDone = true; // still might fail but don't want back in again
+
+  // a viewer connected to the old nodes has to get the new mesh
+  this->closeViewer();
+
+  //
+  // every stride-th node of those asked for
+  //
+
+  theNodes.clear();
+  int count = 0;
+  if (nodeTags == 0) {
+    NodeIter &theIter = theDomain->getNodes();
+    Node *theNode;
+    while ((theNode = theIter()) != 0)
+      if (count++ % stride == 0)
+	theNodes.push_back(theNode);
+  } else {
+    for (int i = 0; i < nodeTags->Size(); i++) {
+      Node *theNode = theDomain->getNode((*nodeTags)(i));
+      if (theNode == 0)
+	continue;
+      if (count++ % stride == 0)
+	theNodes.push_back(theNode);
+    }
+  }
+
+  theScalarNodes.resize(scalarNodes.Size());
+  for (int i = 0; i < scalarNodes.Size(); i++) {
+    theScalarNodes[i] = theDomain->getNode(scalarNodes(i));
+    if (theScalarNodes[i] == 0)
+      opserr << "WARNING LiveViewRecorder - scalar node " << scalarNodes(i) << " not found\n";
+  }
+
+  if (listener < 0)
+    return this->openListener();
+
+  return 0;
+}
+
+
+int
+LiveViewRecorder::openListener(void)
+{
+  startup_sockets();
+
+  socket_type s = socket(AF_INET, SOCK_STREAM, 0);
+  if (!isValid(s)) {
+    opserr << "WARNING LiveViewRecorder - could not open a socket\n";
+    return -1;
+  }
+
+  int on = 1;
+  setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char *)&on, sizeof(on));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons((unsigned short)port);
+  addr.sin_addr.s_addr = inet_addr(bindAddress.c_str());
+
+  if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(s, 1) < 0 || setNonBlocking(s) != 0) {
+    opserr << "WARNING LiveViewRecorder - could not listen on "
+	   << bindAddress.c_str() << ":" << (int)port << ", no live view\n";
+    closeSocket(s);
+    return -1;
+  }
+
+  listener = (long long)s;
+  return 0;
+}
+
+
+void
+LiveViewRecorder::closeViewer(void)
+{
+  if (viewer >= 0)
+    closeSocket((socket_type)viewer);
+  viewer = -1;
+  pending.clear();
+  numSent = 0;
+}
+
+
+// bool sendPending(void);
+//	sends what the viewer still has to take without blocking, true
+//	once all of it is out. A viewer gone away is closed, and the
+//	next one is then accepted.
+
+bool
+LiveViewRecorder::sendPending(void)
+{
+  if (viewer < 0)
+    return false;
+
+  while (numSent < pending.size()) {
+    int numBytes = (int)(pending.size() - numSent);
+    int res = send((socket_type)viewer, &pending[numSent], numBytes, MSG_NOSIGNAL);
+    if (res < 0) {
+      if (wouldBlock() == false)
+	this->closeViewer();
+      return false;
+    }
+    numSent += res;
+  }
+
+  pending.clear();
+  numSent = 0;
+  return true;
+}
+
+
+void
+LiveViewRecorder::addMesh(void)
+{
+  uint32_t header[3];
+  header[0] = (uint32_t)theNodes.size();
+  header[1] = (uint32_t)dofs.Size();
+  header[2] = (uint32_t)scalarNodes.Size();
+
+  addBytes(pending, "OPSM", 4);
+  addBytes(pending, header, sizeof(header));
+
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    int32_t tag = theNodes[i]->getTag();
+    addBytes(pending, &tag, sizeof(tag));
+  }
+
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    const Vector &crds = theNodes[i]->getCrds();
+    double xyz[3] = {0.0, 0.0, 0.0};
+    for (int j = 0; j < crds.Size() && j < 3; j++)
+      xyz[j] = crds(j);
+    addBytes(pending, xyz, sizeof(xyz));
+  }
+}
+
+
+void
+LiveViewRecorder::addFrame(double timeStamp)
+{
+  int numDOF = dofs.Size();
+  uint32_t numValues = (uint32_t)(scalarNodes.Size() + theNodes.size()*numDOF);
+  uint64_t theFrame = frame++;
+
+  pending.reserve(4 + sizeof(numValues) + sizeof(theFrame) + (1 + numValues)*sizeof(double));
+  addBytes(pending, "OPSF", 4);
+  addBytes(pending, &numValues, sizeof(numValues));
+  addBytes(pending, &theFrame, sizeof(theFrame));
+  addBytes(pending, &timeStamp, sizeof(timeStamp));
+
+  for (size_t i = 0; i < theScalarNodes.size(); i++) {
+    double value = 0.0;
+    if (theScalarNodes[i] != 0) {
+      const Vector &disp = theScalarNodes[i]->getTrialDisp();
+      int dof = scalarDOFs(i);
+      if (dof >= 0 && dof < disp.Size())
+	value = disp(dof);
+    }
+    addBytes(pending, &value, sizeof(value));
+  }
+
+  for (size_t i = 0; i < theNodes.size(); i++) {
+    const Vector &disp = theNodes[i]->getTrialDisp();
+    for (int j = 0; j < numDOF; j++) {
+      int dof = dofs(j);
+      double value = (dof >= 0 && dof < disp.Size()) ? disp(dof) : 0.0;
+      addBytes(pending, &value, sizeof(value));
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// LiveViewRecorder. A LiveViewRecorder publishes a decimated displacement
+// field of the model, with a few selected scalars, to an external viewer
+// while the analysis runs. It listens on a TCP port for one viewer at a
+// time; frames are sent at most fps times per second of wall clock time,
+// whatever the rate of the commits. With no viewer connected a commit
+// costs a clock read and, once per frame period, a non-blocking accept().
+// The socket is non-blocking and a frame that finds the previous one not
+// yet taken by the viewer is dropped, so a slow or stalled viewer never
+// holds up the analysis.
+//
+// On connection the viewer is sent the mesh, then the frames:
+//
+//   char    magic[4]    "OPSM"
+//   uint32  numNodes    nodes in each frame (every stride-th node)
+//   uint32  numDOF      displacement dofs of each node
+//   uint32  numScalars  scalars in each frame
+//   int32   tags[numNodes]
+//   double  crds[3*numNodes]
+//
+//   char    magic[4]    "OPSF"
+//   uint32  numValues   numScalars + numNodes*numDOF
+//   uint64  frame       counted from 0 over all connections
+//   double  time
+//   double  values[numValues]   the scalars, then the displacements
+//
+// all in the byte order of the process.
+
+#ifndef LiveViewRecorder_h
+#define LiveViewRecorder_h
+
+#include <Recorder.h>
+#include <ID.h>
+#include <vector>
+#include <string>
+#include <chrono>
+
+class Domain;
+class Node;
+
+class LiveViewRecorder: public Recorder
+{
+  public:
+    LiveViewRecorder();
+    LiveViewRecorder(Domain &theDomain,
+		     unsigned int port,
+		     const char *bindAddress,
+		     const ID *nodeTags,      // 0 for all the nodes
+		     const ID &dofs,
+		     const ID &scalarNodes,
+		     const ID &scalarDOFs,
+		     int stride = 1,
+		     double fps = 10.0);
+    ~LiveViewRecorder();
+
+    int record(int commitTag, double timeStamp);
+    int restart(void);
+
+    int setDomain(Domain &theDomain);
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int initialize(void);
+    int openListener(void);
+    void closeViewer(void);
+    bool sendPending(void);
+    void addMesh(void);
+    void addFrame(double timeStamp);
+
+    Domain *theDomain;
+    ID *nodeTags;
+    ID dofs;
+    ID scalarNodes, scalarDOFs;
+    int stride;
+
+    std::vector<Node *> theNodes;
+    std::vector<Node *> theScalarNodes;
+    bool initializationDone;
+
+    unsigned int port;
+    std::string bindAddress;
+    long long listener;          // the listening socket, -1 if none
+    long long viewer;            // the connected viewer, -1 if none
+
+    std::chrono::steady_clock::duration period;
+    std::chrono::steady_clock::time_point nextFrame;
+
+    std::vector<char> pending;   // what the viewer has not taken yet
+    size_t numSent;
+    unsigned long long frame;
+    long numDropped;
+};
+
+#endif
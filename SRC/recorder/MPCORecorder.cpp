@@ -385,6 +385,8 @@ private:
 		MPCO_LIBLOADER_LOAD_SYM(H5Pclose);
 		MPCO_LIBLOADER_LOAD_SYM(H5Pset_link_creation_order);
 		MPCO_LIBLOADER_LOAD_SYM(H5Pset_libver_bounds);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_chunk);
+		MPCO_LIBLOADER_LOAD_SYM(H5Pset_deflate);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fcreate);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fflush);
 		MPCO_LIBLOADER_LOAD_SYM(H5Fclose);
@@ -401,6 +403,7 @@ private:
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_FILE_CREATE_ID_g);
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_FILE_ACCESS_ID_g);
 		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_GROUP_CREATE_ID_g);
+		MPCO_LIBLOADER_LOAD_SYM(H5P_CLS_DATASET_CREATE_ID_g);
 	}
 	~LibraryLoader() {
 		if (loaded) {
@@ -443,6 +446,8 @@ public:
 	herr_t (*ptr_H5Pclose)(hid_t plist_id);
 	herr_t (*ptr_H5Pset_link_creation_order)(hid_t plist_id, unsigned crt_order_flags);
 	herr_t (*ptr_H5Pset_libver_bounds)(hid_t plist_id, H5F_libver_t low, H5F_libver_t high);
+	herr_t (*ptr_H5Pset_chunk)(hid_t plist_id, int ndims, const hsize_t dim[]);
+	herr_t (*ptr_H5Pset_deflate)(hid_t plist_id, unsigned aggression);
 	hid_t  (*ptr_H5Fcreate)(const char *filename, unsigned flags, hid_t create_plist, hid_t access_plist);
 	herr_t (*ptr_H5Fflush)(hid_t object_id, H5F_scope_t scope);
 	herr_t (*ptr_H5Fclose)(hid_t file_id);
@@ -459,6 +464,7 @@ public:
 	hid_t *ptr_H5P_CLS_FILE_CREATE_ID_g;
 	hid_t *ptr_H5P_CLS_FILE_ACCESS_ID_g;
 	hid_t *ptr_H5P_CLS_GROUP_CREATE_ID_g;
+	hid_t *ptr_H5P_CLS_DATASET_CREATE_ID_g;
 };
 
 /*
@@ -497,6 +503,8 @@ macros for loaded HDF5 functions
 #define H5Pclose (*LibraryLoader::instance().ptr_H5Pclose)
 #define H5Pset_link_creation_order (*LibraryLoader::instance().ptr_H5Pset_link_creation_order)
 #define H5Pset_libver_bounds (*LibraryLoader::instance().ptr_H5Pset_libver_bounds)
+#define H5Pset_chunk (*LibraryLoader::instance().ptr_H5Pset_chunk)
+#define H5Pset_deflate (*LibraryLoader::instance().ptr_H5Pset_deflate)
 
 #define H5Fcreate (*LibraryLoader::instance().ptr_H5Fcreate)
 #define H5Fflush (*LibraryLoader::instance().ptr_H5Fflush)
@@ -525,6 +533,8 @@ macros for loaded HDF5 global variables
 #define H5P_FILE_ACCESS (H5OPEN H5P_CLS_FILE_ACCESS_ID_g)
 #define H5P_CLS_GROUP_CREATE_ID_g (*LibraryLoader::instance().ptr_H5P_CLS_GROUP_CREATE_ID_g)
 #define H5P_GROUP_CREATE (H5OPEN H5P_CLS_GROUP_CREATE_ID_g)
+#define H5P_CLS_DATASET_CREATE_ID_g (*LibraryLoader::instance().ptr_H5P_CLS_DATASET_CREATE_ID_g)
+#define H5P_DATASET_CREATE (H5OPEN H5P_CLS_DATASET_CREATE_ID_g)
 
 /*
 some other useful things defined in HDF5 headers
@@ -1055,17 +1065,27 @@ namespace h5 {
 			status = H5Sclose(space);
 			return dset;
 		}
-		hid_t createAndWrited2(hid_t obj, const char *name, const double *data, hsize_t rows, hsize_t cols)
+		hid_t createAndWrited2(hid_t obj, const char *name, const double *data, hsize_t rows, hsize_t cols, int compression = 0)
 		{
 			// error flags
 			herr_t status;
 			// create the dataspace
 			hsize_t dim[2] = { rows, cols };
 			hid_t space = H5Screate_simple(2, dim, NULL);
+			// a compressed dataset is stored in a single chunk,
+			// since it is written at once
+			hid_t dcpl = H5P_DEFAULT;
+			if (compression > 0) {
+				dcpl = H5Pcreate(H5P_DATASET_CREATE);
+				status = H5Pset_chunk(dcpl, 2, dim);
+				status = H5Pset_deflate(dcpl, (unsigned int)compression);
+			}
 			// create the dataset and write data to it.
-			hid_t dset = H5Dcreate(obj, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			hid_t dset = H5Dcreate(obj, name, H5T_IEEE_F64LE, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
 			status = H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
 			// close and release resources
+			if (dcpl != H5P_DEFAULT)
+				status = H5Pclose(dcpl);
 			status = H5Sclose(space);
 			return dset;
 		}
@@ -1128,10 +1148,10 @@ namespace h5 {
 			}
 			return HID_INVALID;
 		}
-		hid_t createAndWrite(hid_t obj, const char *name, const std::vector<double> &data, size_t rows, size_t cols)
+		hid_t createAndWrite(hid_t obj, const char *name, const std::vector<double> &data, size_t rows, size_t cols, int compression = 0)
 		{
 			if (data.size() > 0 && data.size() == rows*cols) {
-				return createAndWrited2(obj, name, &data[0], rows, cols);
+				return createAndWrited2(obj, name, &data[0], rows, cols, compression);
 			}
 			return HID_INVALID;
 		}
@@ -1441,6 +1461,7 @@ namespace mpco {
 			, h_file_acc_proplist(HID_INVALID)
 #endif // MPCO_USE_SWMR
 			, h_group_proplist(HID_INVALID)
+			, compression_level(0)
 			// time step info
 			, current_time_step_id(0)
 			, current_time_step(0.0)
@@ -1462,6 +1483,7 @@ namespace mpco {
 		hid_t h_file_acc_proplist;
 #endif // MPCO_USE_SWMR
 		hid_t h_group_proplist;
+		int compression_level; // deflate level of the step datasets, 0 = none
 		// time step info
 		int current_time_step_id;
 		double current_time_step;
@@ -1546,7 +1568,7 @@ namespace mpco {
 				std::stringstream ss_dset_name;
 				ss_dset_name << m_result_name << "/DATA/STEP_" << info.current_time_step_id;
 				std::string dset_name = ss_dset_name.str();
-				hid_t h_dset_data = h5::dataset::createAndWrite(info.h_file_id, dset_name.c_str(), buffer_data, nodes.size(), m_num_components);
+				hid_t h_dset_data = h5::dataset::createAndWrite(info.h_file_id, dset_name.c_str(), buffer_data, nodes.size(), m_num_components, info.compression_level);
 				status = h5::attribute::write(h_dset_data, "STEP", info.current_time_step_id);
 				status = h5::attribute::write(h_dset_data, "TIME", info.current_time_step);
 				status = h5::dataset::close(h_dset_data);
@@ -2171,7 +2193,7 @@ namespace mpco {
 					std::stringstream ss_dset_name;
 					ss_dset_name << "MODE_" << k;
 					std::string dset_name = ss_dset_name.str();
-					hid_t h_dset_data = h5::dataset::createAndWrite(h_gp_step, dset_name.c_str(), buffer, nodes.size(), m_num_components);
+					hid_t h_dset_data = h5::dataset::createAndWrite(h_gp_step, dset_name.c_str(), buffer, nodes.size(), m_num_components, info.compression_level);
 					status = h5::attribute::write(h_dset_data, "MODE", k);
 					status = h5::attribute::write(h_dset_data, "LAMBDA", lambda);
 					status = h5::attribute::write(h_dset_data, "OMEGA", omega);
@@ -4411,6 +4433,8 @@ public:
 		, first_domain_changed_done(false)
 		, info()
 		, output_freq()
+		, flush_freq(1)
+		, records_since_flush(0)
 		, has_region(false)
 		, node_set()
 		, elem_set()
@@ -4440,6 +4464,10 @@ public:
 	// output frequency
 	mpco::OutputFrequency output_freq;
 
+	// the file is flushed every flush_freq records (and when closed)
+	int flush_freq;
+	int records_since_flush;
+
 	// nodes and elements
 	bool has_region;
 	std::vector<int> node_set;
@@ -4633,6 +4661,9 @@ int MPCORecorder::record(int commitTag, double timeStamp)
 	/*
 	flush file
 	*/ 
+	if (++m_data->records_since_flush < m_data->flush_freq)
+		return retval;
+	m_data->records_since_flush = 0;
 	status = h5::file::flush(m_data->info.h_file_id);
 	if (status < 0) {
 		opserr << "MPCORecorder Error: cannot flush file on record()\n";
@@ -4704,6 +4735,9 @@ int MPCORecorder::sendSelf(int commitTag, Channel &theChannel)
 		<< m_data->output_freq.type
 		<< m_data->output_freq.dt
 		<< m_data->output_freq.nsteps
+		// flush frequency and compression
+		<< m_data->flush_freq
+		<< m_data->info.compression_level
 		// node result requests
 		<< m_data->nodal_results_requests
 		// node result requests (sens grad indices)
@@ -4795,6 +4829,9 @@ int MPCORecorder::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker
 		>> m_data->output_freq.type
 		>> m_data->output_freq.dt
 		>> m_data->output_freq.nsteps
+		// flush frequency and compression
+		>> m_data->flush_freq
+		>> m_data->info.compression_level
 		// node result requests
 		>> m_data->nodal_results_requests
 		// node result requests (sens grad indices)
@@ -6622,7 +6659,7 @@ int MPCORecorder::recordResultsOnElements()
 							for (size_t j = 0; j < header.num_columns; j++)
 								buffer_data[offset + j] = current_data[(int)j];
 						}
-						hid_t h_dset_data = h5::dataset::createAndWrite(m_data->info.h_file_id, dset_name.c_str(), buffer_data, num_rows, header.num_columns);
+						hid_t h_dset_data = h5::dataset::createAndWrite(m_data->info.h_file_id, dset_name.c_str(), buffer_data, num_rows, header.num_columns, m_data->info.compression_level);
 						status = h5::attribute::write(h_dset_data, "STEP", m_data->info.current_time_step_id);
 						status = h5::attribute::write(h_dset_data, "TIME", m_data->info.current_time_step);
 						status = h5::dataset::close(h_dset_data);
@@ -6698,6 +6735,8 @@ void* OPS_MPCORecorder()
 	bool has_region = false;
 	std::set<int> node_set;
 	std::set<int> elem_set;
+	int flush_freq = 1;
+	int compression_level = 0;
 	int one_item = 1;
 
 	while (numdata > 0) {
@@ -6716,6 +6755,23 @@ void* OPS_MPCORecorder()
 			curr_opt = utils::parsing::opt_time;
 			output_freq.reset();
 		}
+		else if (strcmp(data, "-flush") == 0) {
+			if (numdata < 1 || OPS_GetInt(&one_item, &flush_freq) != 0) {
+				opserr << "MPCORecorder error: option -flush requires an extra parameter (int) for the number of records between flushes\n";
+				return 0;
+			}
+			if (flush_freq < 1) flush_freq = 1;
+			numdata--;
+		}
+		else if (strcmp(data, "-compress") == 0) {
+			if (numdata < 1 || OPS_GetInt(&one_item, &compression_level) != 0) {
+				opserr << "MPCORecorder error: option -compress requires an extra parameter (int) for the deflate level (0-9)\n";
+				return 0;
+			}
+			if (compression_level < 0) compression_level = 0;
+			if (compression_level > 9) compression_level = 9;
+			numdata--;
+		}
 		else if (strcmp(data, "-R") == 0) {
 			curr_opt = utils::parsing::opt_region;
 			if (numdata > 0) {
@@ -6883,6 +6939,8 @@ void* OPS_MPCORecorder()
 	MPCORecorder *new_recorder = new MPCORecorder();
 	new_recorder->m_data->filename = filename;
 	new_recorder->m_data->output_freq = output_freq;
+	new_recorder->m_data->flush_freq = flush_freq;
+	new_recorder->m_data->info.compression_level = compression_level;
 	new_recorder->m_data->nodal_results_requests.swap(nodal_results_requests);
 	new_recorder->m_data->sens_grad_indices.swap(sens_grad_indices);
 	new_recorder->m_data->elemental_results_requests.swap(elemental_results_requests);
@@ -0,0 +1,684 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// MetricsRecorder & the metrics it evaluates.
+
+#include <MetricsRecorder.h>
+#include <EnvelopeReduction.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Element.h>
+#include <Response.h>
+#include <Information.h>
+#include <TimeSeries.h>
+#include <DamageModel.h>
+#include <ID.h>
+
+#include <StandardStream.h>
+#include <DataFileStream.h>
+#include <XmlFileStream.h>
+#include <BinaryFileStream.h>
+#include <DummyStream.h>
+
+#include <elementAPI.h>
+#include <string.h>
+#include <stdio.h>
+
+//
+// the metrics
+//
+
+// the drift (uJ-uI)/L in dof between two nodes L apart in perpDirn
+class DriftMetric: public RecorderMetric
+{
+  public:
+    DriftMetric(int ni, int nj, int df, int perp)
+      :ndI(ni), ndJ(nj), dof(df), perpDirn(perp), nodeI(0), nodeJ(0), oneOverL(0.0) {}
+
+    int initialize(Domain &theDomain) {
+      nodeI = theDomain.getNode(ndI);
+      nodeJ = theDomain.getNode(ndJ);
+      if (nodeI == 0 || nodeJ == 0) {
+	opserr << "WARNING recorder Metrics -drift - node " << ndI << " or " << ndJ << " not found\n";
+	return -1;
+      }
+      const Vector &crdI = nodeI->getCrds();
+      const Vector &crdJ = nodeJ->getCrds();
+      if (perpDirn < 0 || crdI.Size() <= perpDirn || crdJ.Size() <= perpDirn ||
+	  crdI(perpDirn) == crdJ(perpDirn)) {
+	opserr << "WARNING recorder Metrics -drift - nodes " << ndI << " and " << ndJ
+	       << " are not apart in direction " << perpDirn+1 << endln;
+	return -1;
+      }
+      oneOverL = 1.0/(crdJ(perpDirn) - crdI(perpDirn));
+      return 0;
+    }
+
+    double evaluate(double timeStamp) {
+      const Vector &dispI = nodeI->getTrialDisp();
+      const Vector &dispJ = nodeJ->getTrialDisp();
+      if (dof < 0 || dispI.Size() <= dof || dispJ.Size() <= dof)
+	return 0.0;
+      return (dispJ(dof) - dispI(dof))*oneOverL;
+    }
+
+    const char *getName(void) {return "drift";}
+
+  private:
+    int ndI, ndJ, dof, perpDirn;
+    Node *nodeI, *nodeJ;
+    double oneOverL;
+};
+
+// the acceleration of a node in dof plus the factor of an optional
+// TimeSeries, the ground acceleration of a uniform excitation
+class AbsAccelMetric: public RecorderMetric
+{
+  public:
+    AbsAccelMetric(int nd, int df, TimeSeries *ts)
+      :ndTag(nd), dof(df), theSeries(ts), theNode(0) {}
+
+    ~AbsAccelMetric() {
+      if (theSeries != 0)
+	delete theSeries;
+    }
+
+    int initialize(Domain &theDomain) {
+      theNode = theDomain.getNode(ndTag);
+      if (theNode == 0) {
+	opserr << "WARNING recorder Metrics -absAccel - node " << ndTag << " not found\n";
+	return -1;
+      }
+      return 0;
+    }
+
+    double evaluate(double timeStamp) {
+      const Vector &accel = theNode->getTrialAccel();
+      double value = (dof >= 0 && accel.Size() > dof) ? accel(dof) : 0.0;
+      if (theSeries != 0)
+	value += theSeries->getFactor(timeStamp);
+      return value;
+    }
+
+    const char *getName(void) {return "absAccel";}
+
+  private:
+    int ndTag, dof;
+    TimeSeries *theSeries;
+    Node *theNode;
+};
+
+// the energy dissipated by an element, the work of its resisting force on
+// the displacements of its nodes accumulated with the trapezoidal rule
+class EnergyMetric: public RecorderMetric
+{
+  public:
+    EnergyMetric(int tag)
+      :eleTag(tag), theElement(0), lastForce(0), lastDisp(0), disp(0), energy(0.0) {}
+
+    ~EnergyMetric() {
+      if (lastForce != 0)
+	delete lastForce;
+      if (lastDisp != 0)
+	delete lastDisp;
+      if (disp != 0)
+	delete disp;
+    }
+
+    int initialize(Domain &theDomain) {
+      theElement = theDomain.getElement(eleTag);
+      if (theElement == 0) {
+	opserr << "WARNING recorder Metrics -energy - element " << eleTag << " not found\n";
+	return -1;
+      }
+      int numDOF = theElement->getNumDOF();
+      if (lastForce != 0)
+	delete lastForce;
+      if (lastDisp != 0)
+	delete lastDisp;
+      if (disp != 0)
+	delete disp;
+      lastForce = new Vector(numDOF);
+      lastDisp = new Vector(numDOF);
+      disp = new Vector(numDOF);
+
+      this->restart();
+      return 0;
+    }
+
+    double evaluate(double timeStamp) {
+      const Vector &force = theElement->getResistingForce();
+      this->getDisp();
+
+      int numDOF = disp->Size();
+      if (force.Size() < numDOF)
+	numDOF = force.Size();
+      double work = 0.0;
+      for (int i=0; i<numDOF; i++)
+	work += ((*lastForce)(i) + force(i))*((*disp)(i) - (*lastDisp)(i));
+      energy += 0.5*work;
+
+      *lastDisp = *disp;
+      for (int i=0; i<numDOF; i++)
+	(*lastForce)(i) = force(i);
+
+      return energy;
+    }
+
+    void restart(void) {
+      energy = 0.0;
+      if (theElement == 0)
+	return;
+      this->getDisp();
+      *lastDisp = *disp;
+      const Vector &force = theElement->getResistingForce();
+      lastForce->Zero();
+      for (int i=0; i<force.Size() && i<lastForce->Size(); i++)
+	(*lastForce)(i) = force(i);
+    }
+
+    const char *getName(void) {return "energy";}
+
+  private:
+    // the displacements of the element's nodes, in the order of its dof
+    void getDisp(void) {
+      Node **theNodes = theElement->getNodePtrs();
+      int numNodes = theElement->getNumExternalNodes();
+      int loc = 0;
+      for (int i=0; i<numNodes; i++) {
+	const Vector &nodeDisp = theNodes[i]->getTrialDisp();
+	for (int j=0; j<nodeDisp.Size() && loc<disp->Size(); j++)
+	  (*disp)(loc++) = nodeDisp(j);
+      }
+    }
+
+    int eleTag;
+    Element *theElement;
+    Vector *lastForce;
+    Vector *lastDisp;
+    Vector *disp;
+    double energy;
+};
+
+// the index of a damage model driven by the deformation & force of a
+// section of an element, as the DamageRecorder does
+class DamageMetric: public RecorderMetric
+{
+  public:
+    DamageMetric(int tag, int sec, int df, DamageModel *theModel)
+      :eleTag(tag), secTag(sec), dof(df), theDamage(theModel),
+       theDeformation(0), theForce(0), trial(3) {}
+
+    ~DamageMetric() {
+      if (theDamage != 0)
+	delete theDamage;
+      if (theDeformation != 0)
+	delete theDeformation;
+      if (theForce != 0)
+	delete theForce;
+    }
+
+    int initialize(Domain &theDomain) {
+      Element *theElement = theDomain.getElement(eleTag);
+      if (theElement == 0) {
+	opserr << "WARNING recorder Metrics -damage - element " << eleTag << " not found\n";
+	return -1;
+      }
+
+      char secArg[20];
+      sprintf(secArg, "%d", secTag);
+      const char *argv[3] = {"section", secArg, "deformation"};
+      DummyStream theDummy;
+
+      if (theDeformation != 0)
+	delete theDeformation;
+      if (theForce != 0)
+	delete theForce;
+      theDeformation = theElement->setResponse(argv, 3, theDummy);
+      argv[2] = "force";
+      theForce = theElement->setResponse(argv, 3, theDummy);
+
+      if (theDeformation == 0 || theForce == 0) {
+	opserr << "WARNING recorder Metrics -damage - element " << eleTag
+	       << " has no deformation and force for section " << secTag << endln;
+	return -1;
+      }
+
+      theDamage->revertToStart();
+      return 0;
+    }
+
+    double evaluate(double timeStamp) {
+      trial.Zero();
+      if (theDeformation->getResponse() >= 0) {
+	const Vector &data = theDeformation->getInformation().getData();
+	if (dof >= 0 && dof < data.Size())
+	  trial(0) = data(dof);
+      }
+      if (theForce->getResponse() >= 0) {
+	const Vector &data = theForce->getInformation().getData();
+	if (dof >= 0 && dof < data.Size())
+	  trial(1) = data(dof);
+      }
+      theDamage->setTrial(trial);
+      theDamage->commitState();
+      return theDamage->getDamage();
+    }
+
+    void restart(void) {
+      theDamage->revertToStart();
+    }
+
+    const char *getName(void) {return "damage";}
+
+  private:
+    int eleTag, secTag, dof;
+    DamageModel *theDamage;
+    Response *theDeformation;
+    Response *theForce;
+    Vector trial;
+};
+
+
+void *
+OPS_MetricsRecorder()
+{
+  if (OPS_GetNumRemainingInputArgs() < 2) {
+    opserr << "WARNING recorder Metrics <-file fileName?> <-time> <-dT dT?> "
+	   << "-drift iNode? jNode? dof? perpDirn? | -absAccel node? dof? <tsTag?> | "
+	   << "-energy eleTag? | -damage eleTag? secTag? dof? dmgTag? ...\n";
+    return 0;
+  }
+
+  Domain *domain = OPS_GetDomain();
+  if (domain == 0)
+    return 0;
+
+  const char *filename = 0;
+  int eMode = 0; // 0 standard, 1 data, 2 csv, 3 xml, 4 binary
+  int precision = 6;
+  bool doScientific = false;
+  bool echoTimeFlag = false;
+  double dT = 0.0;
+  double rTolDt = 0.00001;
+
+  int numMetrics = 0;
+  int maxMetrics = 8;
+  RecorderMetric **theMetrics = new RecorderMetric *[maxMetrics];
+  RecorderMetric *theMetric = 0;
+
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *option = OPS_GetString();
+    theMetric = 0;
+    int numdata = 1;
+
+    if (strcmp(option, "-file") == 0 || strcmp(option, "-fileCSV") == 0 ||
+	strcmp(option, "-xml") == 0 || strcmp(option, "-binary") == 0) {
+      if (strcmp(option, "-file") == 0)
+	eMode = 1;
+      else if (strcmp(option, "-fileCSV") == 0)
+	eMode = 2;
+      else if (strcmp(option, "-xml") == 0)
+	eMode = 3;
+      else
+	eMode = 4;
+      if (OPS_GetNumRemainingInputArgs() > 0)
+	filename = OPS_GetString();
+    }
+    else if (strcmp(option, "-precision") == 0) {
+      if (OPS_GetIntInput(&numdata, &precision) < 0) {
+	opserr << "WARNING recorder Metrics - failed to read precision\n";
+	break;
+      }
+    }
+    else if (strcmp(option, "-scientific") == 0) {
+      doScientific = true;
+    }
+    else if (strcmp(option, "-time") == 0) {
+      echoTimeFlag = true;
+    }
+    else if (strcmp(option, "-dT") == 0) {
+      if (OPS_GetDoubleInput(&numdata, &dT) < 0) {
+	opserr << "WARNING recorder Metrics - failed to read dT\n";
+	break;
+      }
+    }
+    else if (strcmp(option, "-rTolDt") == 0) {
+      if (OPS_GetDoubleInput(&numdata, &rTolDt) < 0) {
+	opserr << "WARNING recorder Metrics - failed to read rTolDt\n";
+	break;
+      }
+    }
+    else if (strcmp(option, "-drift") == 0) {
+      int idata[4];
+      numdata = 4;
+      if (OPS_GetIntInput(&numdata, idata) < 0) {
+	opserr << "WARNING recorder Metrics -drift iNode? jNode? dof? perpDirn?\n";
+	break;
+      }
+      theMetric = new DriftMetric(idata[0], idata[1], idata[2]-1, idata[3]-1);
+    }
+    else if (strcmp(option, "-absAccel") == 0) {
+      int idata[2];
+      numdata = 2;
+      if (OPS_GetIntInput(&numdata, idata) < 0) {
+	opserr << "WARNING recorder Metrics -absAccel node? dof? <tsTag?>\n";
+	break;
+      }
+      TimeSeries *theSeries = 0;
+      int tsTag;
+      numdata = 1;
+      if (OPS_GetNumRemainingInputArgs() > 0) {
+	if (OPS_GetIntInput(&numdata, &tsTag) < 0)
+	  OPS_ResetCurrentInputArg(-1);
+	else {
+	  TimeSeries *theSeriesTag = OPS_getTimeSeries(tsTag);
+	  if (theSeriesTag == 0) {
+	    opserr << "WARNING recorder Metrics -absAccel - TimeSeries " << tsTag << " not found\n";
+	    break;
+	  }
+	  theSeries = theSeriesTag->getCopy();
+	}
+      }
+      theMetric = new AbsAccelMetric(idata[0], idata[1]-1, theSeries);
+    }
+    else if (strcmp(option, "-energy") == 0) {
+      int eleTag;
+      if (OPS_GetIntInput(&numdata, &eleTag) < 0) {
+	opserr << "WARNING recorder Metrics -energy eleTag?\n";
+	break;
+      }
+      theMetric = new EnergyMetric(eleTag);
+    }
+    else if (strcmp(option, "-damage") == 0) {
+      int idata[4];
+      numdata = 4;
+      if (OPS_GetIntInput(&numdata, idata) < 0) {
+	opserr << "WARNING recorder Metrics -damage eleTag? secTag? dof? dmgTag?\n";
+	break;
+      }
+      DamageModel *theModel = OPS_getDamageModel(idata[3]);
+      if (theModel == 0) {
+	opserr << "WARNING recorder Metrics -damage - damage model " << idata[3] << " not found\n";
+	break;
+      }
+      theMetric = new DamageMetric(idata[0], idata[1], idata[2]-1, theModel->getCopy());
+    }
+    else {
+      opserr << "WARNING recorder Metrics - unknown option " << option << endln;
+      break;
+    }
+
+    if (theMetric != 0) {
+      if (numMetrics == maxMetrics) {
+	RecorderMetric **theNextMetrics = new RecorderMetric *[2*maxMetrics];
+	for (int i=0; i<numMetrics; i++)
+	  theNextMetrics[i] = theMetrics[i];
+	delete [] theMetrics;
+	theMetrics = theNextMetrics;
+	maxMetrics *= 2;
+      }
+      theMetrics[numMetrics++] = theMetric;
+    }
+  }
+
+  if (OPS_GetNumRemainingInputArgs() > 0 || numMetrics == 0) {
+    if (numMetrics == 0)
+      opserr << "WARNING recorder Metrics - no metrics given\n";
+    for (int i=0; i<numMetrics; i++)
+      delete theMetrics[i];
+    delete [] theMetrics;
+    return 0;
+  }
+
+  OPS_Stream *theOutputStream = 0;
+  if (eMode == 1 && filename != 0)
+    theOutputStream = new DataFileStream(filename, OVERWRITE, 2, 0, false, precision, doScientific);
+  else if (eMode == 2 && filename != 0)
+    theOutputStream = new DataFileStream(filename, OVERWRITE, 2, 1, false, precision, doScientific);
+  else if (eMode == 3 && filename != 0)
+    theOutputStream = new XmlFileStream(filename);
+  else if (eMode == 4 && filename != 0)
+    theOutputStream = new BinaryFileStream(filename);
+  else
+    theOutputStream = new StandardStream();
+
+  theOutputStream->setPrecision(precision);
+
+  MetricsRecorder *theRecorder = new MetricsRecorder(theMetrics, numMetrics, *domain, *theOutputStream,
+						     echoTimeFlag, dT, rTolDt);
+  delete [] theMetrics;
+
+  return theRecorder;
+}
+
+
+MetricsRecorder::MetricsRecorder()
+  :Recorder(RECORDER_TAGS_MetricsRecorder),
+   theMetrics(0), numMetrics(0), theDomain(0), theHandler(0),
+   data(0), currentData(0), first(true), count(0),
+   initializationDone(false), echoTimeFlag(false),
+   deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0)
+{
+
+}
+
+
+MetricsRecorder::MetricsRecorder(RecorderMetric **metrics, int num,
+				 Domain &theDom,
+				 OPS_Stream &theOutputHandler,
+				 bool echoTime,
+				 double dT,
+				 double rTolDt)
+  :Recorder(RECORDER_TAGS_MetricsRecorder),
+   theMetrics(0), numMetrics(num), theDomain(&theDom), theHandler(&theOutputHandler),
+   data(0), currentData(0), first(true), count(0),
+   initializationDone(false), echoTimeFlag(echoTime),
+   deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0)
+{
+  // the recorder takes ownership of the metrics
+  theMetrics = new RecorderMetric *[numMetrics];
+  for (int i=0; i<numMetrics; i++)
+    theMetrics[i] = metrics[i];
+}
+
+
+MetricsRecorder::~MetricsRecorder()
+{
+  //
+  // write the reductions
+  //
+
+  if (theHandler != 0 && data != 0) {
+    theHandler->tag("Data"); // Data
+
+    int numResponse = data->noCols();
+    for (int i=0; i<4; i++) {
+      for (int j=0; j<numResponse; j++) {
+	// the time columns hold the time itself
+	if (echoTimeFlag == true && j%2 == 0)
+	  (*currentData)(j) = (*data)(i,j);
+	else
+	  (*currentData)(j) = EnvelopeReduction::result(i, (*data)(i,j), count);
+      }
+      theHandler->write(*currentData);
+    }
+
+    theHandler->endTag(); // Data
+  }
+
+  if (theHandler != 0)
+    delete theHandler;
+
+  if (data != 0)
+    delete data;
+
+  if (currentData != 0)
+    delete currentData;
+
+  for (int i=0; i<numMetrics; i++)
+    delete theMetrics[i];
+  if (theMetrics != 0)
+    delete [] theMetrics;
+}
+
+
+int
+MetricsRecorder::record(int commitTag, double timeStamp)
+{
+  if (theDomain == 0 || numMetrics == 0)
+    return 0;
+
+  if (initializationDone == false) {
+    if (this->initialize() != 0) {
+      opserr << "MetricsRecorder::record() - failed to initialize\n";
+      return -1;
+    }
+  }
+
+  // where relDeltaTTol is the maximum reliable ratio between analysis time step and deltaT
+  // and provides tolerance for floating point precision (see floating-point-tolerance-for-recorder-time-step.md)
+  if (deltaT == 0.0 || timeStamp - nextTimeStampToRecord >= -deltaT * relDeltaTTol) {
+
+    if (deltaT != 0.0)
+      nextTimeStampToRecord = timeStamp + deltaT;
+
+    //
+    // evaluate each metric & reduce it straight into its statistics
+    //
+
+    double *stats = &(*data)(0,0);
+    for (int i=0; i<numMetrics; i++) {
+      double value = theMetrics[i]->evaluate(timeStamp);
+      if (echoTimeFlag == false)
+	EnvelopeReduction::reduce(&stats[i*4], 4, value, first);
+      else
+	EnvelopeReduction::reduce(&stats[(2*i+1)*4], &stats[2*i*4], 4, value, timeStamp, first);
+    }
+    first = false;
+    count++;
+  }
+
+  return 0;
+}
+
+
+int
+MetricsRecorder::restart(void)
+{
+  if (data != 0)
+    data->Zero();
+  for (int i=0; i<numMetrics; i++)
+    theMetrics[i]->restart();
+  first = true;
+  count = 0;
+  return 0;
+}
+
+
+int
+MetricsRecorder::flush(void)
+{
+  if (theHandler != 0)
+    return theHandler->flush();
+  return 0;
+}
+
+
+int
+MetricsRecorder::setDomain(Domain &theDom)
+{
+  theDomain = &theDom;
+  initializationDone = false;
+  return 0;
+}
+
+
+int
+MetricsRecorder::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "MetricsRecorder::sendSelf() - not implemented, the metrics are evaluated on the main process\n";
+  return -1;
+}
+
+
+int
+MetricsRecorder::recvSelf(int commitTag, Channel &theChannel,
+			  FEM_ObjectBroker &theBroker)
+{
+  opserr << "MetricsRecorder::recvSelf() - not implemented\n";
+  return -1;
+}
+
+
+double
+MetricsRecorder::getRecordedValue(int clmnId, int rowOffset, bool reset)
+{
+  double res = 0;
+  if (!initializationDone)
+    return res;
+  int row = 2 - rowOffset;
+  if (clmnId < 0 || clmnId >= data->noCols() || row < 0 || row > 3)
+    return res;
+  res = EnvelopeReduction::result(row, (*data)(row, clmnId), count);
+  if (reset)
+    first = true;
+  return res;
+}
+
+
+int
+MetricsRecorder::initialize(void)
+{
+  initializationDone = true; // still might fail but don't want back in again
+
+  for (int i=0; i<numMetrics; i++)
+    if (theMetrics[i]->initialize(*theDomain) != 0)
+      return -1;
+
+  int numColumns = numMetrics;
+  if (echoTimeFlag == true)
+    numColumns *= 2;
+
+  if (data != 0)
+    delete data;
+  if (currentData != 0)
+    delete currentData;
+  data = new Matrix(4, numColumns);
+  currentData = new Vector(numColumns);
+
+  theHandler->tag("OpenSeesOutput");
+  for (int i=0; i<numMetrics; i++) {
+    if (echoTimeFlag == true) {
+      theHandler->tag("TimeOutput");
+      theHandler->tag("ResponseType", "time");
+      theHandler->endTag();
+    }
+    theHandler->tag("MetricOutput");
+    theHandler->tag("ResponseType", theMetrics[i]->getName());
+    theHandler->endTag();
+  }
+
+  first = true;
+  count = 0;
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for MetricsRecorder.
+// A MetricsRecorder evaluates a set of quantities derived from the node &
+// element responses, the drift between two nodes, the absolute
+// acceleration of a node, the cumulative energy dissipated by an element
+// and the index of a damage model, in one pass over them at each commit.
+// Only their reductions, the min, max, absMax and RMS over the analysis,
+// are written, so the raw histories need not be recorded to obtain them.
+
+#ifndef MetricsRecorder_h
+#define MetricsRecorder_h
+
+#include <Recorder.h>
+#include <Matrix.h>
+#include <Vector.h>
+
+class Domain;
+class Node;
+class Element;
+class Response;
+class TimeSeries;
+class DamageModel;
+class OPS_Stream;
+
+// a quantity evaluated by the MetricsRecorder; initialize() looks up what
+// it needs in the domain once, evaluate() then gives its value at a commit
+class RecorderMetric
+{
+  public:
+    RecorderMetric() {};
+    virtual ~RecorderMetric() {};
+
+    virtual int initialize(Domain &theDomain) = 0;
+    virtual double evaluate(double timeStamp) = 0;
+    virtual void restart(void) {};
+    virtual const char *getName(void) = 0;
+};
+
+class MetricsRecorder: public Recorder
+{
+  public:
+    MetricsRecorder();
+    MetricsRecorder(RecorderMetric **theMetrics, int numMetrics,
+		    Domain &theDomain,
+		    OPS_Stream &theOutputHandler,
+		    bool echoTimeFlag = false,
+		    double deltaT = 0.0,
+		    double relDeltaTTol = 0.00001);
+    ~MetricsRecorder();
+
+    int record(int commitTag, double timeStamp);
+    int restart(void);
+    int flush(void);
+
+    int setDomain(Domain &theDomain);
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    virtual double getRecordedValue(int clmnId, int rowOffset, bool reset);
+
+  protected:
+
+  private:
+    int initialize(void);
+
+    RecorderMetric **theMetrics;
+    int numMetrics;
+
+    Domain *theDomain;
+    OPS_Stream *theHandler;
+
+    Matrix *data;          // the 4 statistics of EnvelopeReduction per column
+    Vector *currentData;   // a row of data when written
+    bool first;
+    int count;             // steps reduced, for the RMS
+
+    bool initializationDone;
+    bool echoTimeFlag;
+
+    double deltaT;
+    double relDeltaTTol;
+    double nextTimeStampToRecord;
+};
+
+#endif
@@ -46,6 +46,8 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
+#include <AsyncStream.h>
 #include <DatabaseStream.h>
 #include <TCP_Stream.h>
 
@@ -54,6 +56,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <MemoryReport.h>
 
 void*
 OPS_NodeRecorder()
@@ -76,8 +79,13 @@ OPS_NodeRecorder()
     const int DATA_STREAM_CSV = 5;
     const int TCP_STREAM = 6;
     const int DATA_STREAM_ADD = 7;
+    const int COLUMNAR_STREAM = 8;
     
     int eMode = STANDARD_STREAM;
+    int asyncRows = 0;
+    int tcpBatch = 0;
+    bool sharded = false;
+    const char *compression = 0;
     
     bool echoTimeFlag = false;
     double dT = 0.0;
@@ -99,6 +107,8 @@ OPS_NodeRecorder()
     ID dofs(0, 6);
     ID timeseries(0, 6);
 
+    RecorderSampler *theSampler = 0;
+
     while (OPS_GetNumRemainingInputArgs() > 0) {
 
         const char* option = OPS_GetString();
@@ -159,6 +169,38 @@ OPS_NodeRecorder()
             }
             eMode = BINARY_STREAM;
         }
+        else if (strcmp(option, "-columnar") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                filename = OPS_GetString();
+            }
+            eMode = COLUMNAR_STREAM;
+        }
+        else if (strcmp(option, "-compress") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0)
+                compression = OPS_GetString();
+        }
+        else if (strcmp(option, "-shards") == 0) {
+            sharded = true;
+        }
+        else if (strcmp(option, "-tcpBatch") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                int num = 1;
+                if (OPS_GetIntInput(&num, &tcpBatch) < 0) {
+                    opserr << "WARNING: failed to read tcpBatch\n";
+                    return 0;
+                }
+            }
+        }
+        else if (strcmp(option, "-async") == 0) {
+            asyncRows = 1000;
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                int num = 1;
+                if (OPS_GetIntInput(&num, &asyncRows) < 0) {
+                    asyncRows = 1000;
+                    OPS_ResetCurrentInputArg(-1);
+                }
+            }
+        }
         else if (strcmp(option, "-dT") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 int num = 1;
@@ -274,6 +316,14 @@ OPS_NodeRecorder()
                 dofs[numDOF++] = dof - 1;
             }
         }
+        else {
+            int res = OPS_RecorderSamplerOption(option, theSampler);
+            if (res < 0) {
+                if (theSampler != 0)
+                    delete theSampler;
+                return 0;
+            }
+        }
     }
 
     // data handler
@@ -289,11 +339,22 @@ OPS_NodeRecorder()
     //    theOutputStream = new DatabaseStream(theDatabase, tableName);
     else if (eMode == BINARY_STREAM && filename != 0)
         theOutputStream = new BinaryFileStream(filename);
+    else if (eMode == COLUMNAR_STREAM && filename != 0)
+        theOutputStream = new ColumnarFileStream(filename);
     else if (eMode == TCP_STREAM && inetAddr != 0)
-        theOutputStream = new TCP_Stream(inetPort, inetAddr);
+        theOutputStream = new TCP_Stream(inetPort, inetAddr, false, tcpBatch);
     else
         theOutputStream = new StandardStream();
 
+    if (compression != 0 && theOutputStream->setCompression(compression) < 0)
+        opserr << "WARNING recorder - -compress " << compression << " not available for this output, written uncompressed\n";
+
+    if (sharded && theOutputStream->setSharded(true) < 0)
+        opserr << "WARNING recorder - -shards only applies to -file and -csv output, ignored\n";
+
+    if (asyncRows > 0)
+        theOutputStream = new AsyncStream(theOutputStream, asyncRows);
+
     theOutputStream->setPrecision(precision);
 
     Domain* domain = OPS_GetDomain();
@@ -302,6 +363,8 @@ OPS_NodeRecorder()
     NodeRecorder* recorder = new NodeRecorder(dofs, &nodes, gradIndex,
         responseID, *domain, *theOutputStream,
         dT, rTolDt, echoTimeFlag, theTimeSeries);
+    if (theSampler != 0)
+        recorder->setSampler(theSampler);
 
     return recorder;
 }
@@ -314,7 +377,8 @@ NodeRecorder::NodeRecorder()
  echoTimeFlag(true), dataFlag(0),
  deltaT(0.0), relDeltaTTol(0.00001), nextTimeStampToRecord(0.0),
  gradIndex(-1),
- initializationDone(false), numValidNodes(0), addColumnInfo(0), theTimeSeries(0), timeSeriesValues(0)
+ initializationDone(false), numValidNodes(0), addColumnInfo(0), theTimeSeries(0), timeSeriesValues(0),
+ theSampler(0)
 {
 
 }
@@ -337,7 +401,7 @@ NodeRecorder::NodeRecorder(const ID &dofs,
  deltaT(dT), relDeltaTTol(rTolDt), nextTimeStampToRecord(0.0),
  gradIndex(pgradIndex),
  initializationDone(false), numValidNodes(0), addColumnInfo(0),
- theTimeSeries(theSeries), timeSeriesValues(0)
+ theTimeSeries(theSeries), timeSeriesValues(0), theSampler(0)
 {
 
   //
@@ -507,6 +571,17 @@ NodeRecorder::~NodeRecorder()
     delete [] theTimeSeries;
   }
 
+  if (theSampler != 0)
+    delete theSampler;
+}
+
+
+void
+NodeRecorder::setSampler(RecorderSampler *sampler)
+{
+  if (theSampler != 0)
+    delete theSampler;
+  theSampler = sampler;
 }
 
 
@@ -820,7 +895,10 @@ NodeRecorder::record(int commitTag, double timeStamp)
       }
 
       // insert the data into the database
-      theOutputHandler->write(response);
+      if (theSampler != 0)
+	theSampler->write(response, *theOutputHandler);
+      else
+	theOutputHandler->write(response);
 
     } else { // output all eigenvalues
 
@@ -861,10 +939,24 @@ int
 NodeRecorder::setDomain(Domain &theDom)
 {
   theDomain = &theDom;
+  initializationDone = false;
   return 0;
 }
 
 
+size_t
+NodeRecorder::getMemoryUsage(void)
+{
+  size_t result = MemoryReport::objectSize(this);
+  result += response.Size()*sizeof(double);
+  result += MemoryReport::idSize(theDofs) + MemoryReport::idSize(theNodalTags);
+  if (theNodes != 0)
+    result += numValidNodes*sizeof(Node *);
+
+  return result;
+}
+
+
 int
 NodeRecorder::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -1299,6 +1391,10 @@ NodeRecorder::initialize(void)
   }
 
   theOutputHandler->tag("Data");
+
+  if (theSampler != 0)
+    theSampler->setDomain(*theDomain);
+
   initializationDone = true;
 
   return 0;
@@ -40,6 +40,7 @@
 #include <ID.h>
 #include <Vector.h>
 #include <TimeSeries.h>
+#include <RecorderSampler.h>
 
 class Domain;
 class FE_Datastore;
@@ -62,6 +63,9 @@ class NodeRecorder: public Recorder
 
     ~NodeRecorder();
 
+    // the recorder takes ownership of the sampler deciding the rows written
+    void setSampler(RecorderSampler *theSampler);
+
     int record(int commitTag, double timeStamp);
     int flush();
 
@@ -70,6 +74,7 @@ class NodeRecorder: public Recorder
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel,
 		 FEM_ObjectBroker &theBroker);
+    size_t getMemoryUsage(void);
 	virtual double getRecordedValue(int clmnId, int rowOffset, bool reset); //added by SAJalali
 
   protected:
@@ -103,6 +108,8 @@ class NodeRecorder: public Recorder
 
     TimeSeries **theTimeSeries;
     double *timeSeriesValues;
+
+    RecorderSampler *theSampler;
 };
 
 #endif
@@ -31,6 +31,7 @@
 
 #include <NormElementRecorder.h>
 #include <Domain.h>
+#include <ResponseCache.h>
 #include <Element.h>
 #include <ElementIter.h>
 #include <Matrix.h>
@@ -590,6 +591,7 @@ NormElementRecorder::initialize(void)
 	theResponses[i] = 0;
       } else {
 	theResponses[i] = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
+	theResponses[i] = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponses[i]);
 	if (theResponses[i] != 0) {
 	  // from the response type determine no of cols for each
 	  Information &eleInfo = theResponses[i]->getInformation();
@@ -640,6 +642,7 @@ NormElementRecorder::initialize(void)
 
     while ((theEle = theElements()) != 0) {
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
+      theResponse = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponse);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
 	  // Why is this created locally and not used? -- MHS
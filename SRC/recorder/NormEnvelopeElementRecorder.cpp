@@ -31,6 +31,7 @@
 
 #include <NormEnvelopeElementRecorder.h>
 #include <Domain.h>
+#include <ResponseCache.h>
 #include <Element.h>
 #include <ElementIter.h>
 #include <Matrix.h>
@@ -624,6 +625,7 @@ NormEnvelopeElementRecorder::initialize(void)
 	  theHandler->tag("NormEnvelopeElementOutput");	  
 	
 	theResponses[ii] = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+	theResponses[ii] = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponses[ii]);
 	if (theResponses[ii] != 0) {
 	  // from the response type determine no of cols for each      
 	  Information &eleInfo = theResponses[ii]->getInformation();
@@ -683,6 +685,7 @@ NormEnvelopeElementRecorder::initialize(void)
 
     while ((theEle = theElements()) != 0) {
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
+      theResponse = theDomain->getResponseCache().share(theEle->getTag(), (const char **)responseArgs, numArgs, theResponse);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
 	  Response **theNextResponses = new Response *[numEle*2];
@@ -35,6 +35,12 @@
 #include <Matrix.h>
 #include <classTags.h>
 #include <NodeIter.h>
+#include <MeshRegion.h>
+#include <algorithm>
+#include <cstdint>
+#ifdef _ZLIB
+#include <zlib.h>
+#endif
 
 #include "PFEMElement/BackgroundDef.h"
 #include "PFEMElement/Particle.h"
@@ -61,6 +67,10 @@ void* OPS_PVDRecorder()
     std::vector<PVDRecorder::EleData> eledata;
     double dT = 0.0;
     double rTolDt = 0.00001;
+    bool binary = false;
+    bool compress = false;
+    int stride = 1;
+    int regionTag = -1;
     while(numdata > 0) {
 	const char* type = OPS_GetString();
 	if(strcmp(type, "disp") == 0) {
@@ -139,29 +149,58 @@ void* OPS_PVDRecorder()
 		return 0;
 	    }
 	    if (rTolDt < 0) rTolDt = 0;
+	} else if(strcmp(type, "-binary") == 0) {
+	    binary = true;
+	} else if(strcmp(type, "-compress") == 0) {
+	    binary = true;
+#ifdef _ZLIB
+	    compress = true;
+#else
+	    opserr<<"WARNING: -compress needs zlib, the binary data is written uncompressed\n";
+#endif
+	} else if(strcmp(type, "-stride") == 0) {
+	    numdata = 1;
+	    if(OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numdata,&stride) < 0) {
+		opserr << "WARNING: failed to read stride\n";
+		return 0;
+	    }
+	    if (stride < 1) stride = 1;
+	} else if(strcmp(type, "-region") == 0) {
+	    numdata = 1;
+	    if(OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numdata,&regionTag) < 0) {
+		opserr << "WARNING: failed to read region tag\n";
+		return 0;
+	    }
 	}
 	numdata = OPS_GetNumRemainingInputArgs();
     }
 
     // create recorder
-    return new PVDRecorder(name,nodedata,eledata,indent,precision,dT, rTolDt);
+    return new PVDRecorder(name,nodedata,eledata,indent,precision,dT, rTolDt,
+			   binary,compress,stride,regionTag);
 }
 
 PVDRecorder::PVDRecorder(const char *name, const NodeData& ndata,
 			 const std::vector<EleData>& edata, int ind, int pre,
-			 double dt, double rTolDt)
+			 double dt, double rTolDt, bool bin, bool comp,
+			 int strd, int rtag)
     :Recorder(RECORDER_TAGS_PVDRecorder), indentsize(ind), precision(pre),
      indentlevel(0), pathname(), basename(),
      timestep(), timeparts(), theFile(), quota('\"'), parts(),
      nodedata(ndata), eledata(edata), theDomain(0), partnum(),
-     dT(dt), relDeltaTTol(rTolDt), nextTime(0.0)
+     dT(dt), relDeltaTTol(rTolDt), nextTime(0.0),
+     binary(bin), compress(comp), arrayType(0), inData(false),
+     appended(), arrayData(), stride(strd), numSteps(0), regionTag(rtag),
+     regionNodes(), regionEles()
 {
     PVDRecorder::setVTKType();
     getfilename(name);
 }
 
 PVDRecorder::PVDRecorder()
-    :Recorder(RECORDER_TAGS_PVDRecorder)
+    :Recorder(RECORDER_TAGS_PVDRecorder),
+     binary(false), compress(false), arrayType(0), inData(false),
+     stride(1), numSteps(0), regionTag(-1)
 {
 }
 
@@ -190,6 +229,10 @@ PVDRecorder::record(int ctag, double timestamp)
       if(precision==0)
          return 0;
 
+      // only every stride-th step is written
+      if (numSteps++ % stride != 0)
+         return 0;
+
       // get current time
       timestep.push_back(timestamp);
 
@@ -207,6 +250,7 @@ PVDRecorder::restart()
 {
     timestep.clear();
     timeparts.clear();
+    numSteps = 0;
     return 0;
 }
 
@@ -230,7 +274,7 @@ PVDRecorder::pvd()
     theFile.close();
     std::string pvdname = pathname+basename+".pvd";
 
-    theFile.open(pvdname.c_str(), std::ios::trunc|std::ios::out);
+    theFile.open(pvdname.c_str(), std::ios::trunc|std::ios::out|std::ios::binary);
     if(theFile.fail()) {
 	opserr<<"WARNING: Failed to open file "<<pvdname.c_str()<<"\n";
 	return -1;
@@ -363,11 +407,17 @@ PVDRecorder::getParts()
 	return;
     }
 
+    this->getRegion();
+
     ElementIter* eiter = &(theDomain->getElements());
     Element* theEle = 0;
     while((theEle = (*eiter)()) != 0) {
 	int ctag = theEle->getClassTag();
 	int etag = theEle->getTag();
+	if (regionTag >= 0 &&
+	    !std::binary_search(regionEles.begin(), regionEles.end(), etag)) {
+	    continue;
+	}
 	parts[ctag].insert(etag);
     }
 }
@@ -391,7 +441,7 @@ PVDRecorder::savePart0(int nodendf)
     // open file
     theFile.close();
     std::string vtuname = pathname+basename+"/"+basename+"_T"+stime+"_P"+spart+".vtu";
-    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out);
+    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out|std::ios::binary);
     if(theFile.fail()) {
 	opserr<<"WARNING: Failed to open file "<<vtuname.c_str()<<"\n";
 	return -1;
@@ -404,7 +454,7 @@ PVDRecorder::savePart0(int nodendf)
     theFile<<"<VTKFile type="<<quota<<"UnstructuredGrid"<<quota;
     theFile<<" version="<<quota<<"1.0"<<quota;
     theFile<<" byte_order="<<quota<<"LittleEndian"<<quota;
-    theFile<<" compressor="<<quota<<"vtkZLibDataCompressor"<<quota;
+    this->formatAttributes();
     theFile<<">\n";
     this->incrLevel();
     this->indent();
@@ -427,6 +477,10 @@ PVDRecorder::savePart0(int nodendf)
     Node* theNode = 0;
     while ((theNode = theNodes()) != 0) {
 	int nd = theNode->getTag();
+	if (regionTag >= 0 &&
+	    !std::binary_search(regionNodes.begin(), regionNodes.end(), nd)) {
+	    continue;
+	}
 	if (ptags.getLocationOrdered(nd) < 0) {
 	    nodes.push_back(theNode);
 	}
@@ -446,10 +500,10 @@ PVDRecorder::savePart0(int nodendf)
     // points header
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+    this->beginArray("Float64");
     theFile<<" Name="<<quota<<"Points"<<quota;
     theFile<<" NumberOfComponents="<<quota<<3<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
 
     // points coordinates
     this->incrLevel();
@@ -458,18 +512,18 @@ PVDRecorder::savePart0(int nodendf)
 	this->indent();
 	for(int j=0; j<3; j++) {
 	    if(j < crds.Size()) {
-		theFile<<crds(j)<<' ';
+		this->value(crds(j));
 	    } else {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
 	}
-	theFile<<std::endl;
+	this->endLine();
     }
 
     // points footer
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
     this->decrLevel();
     this->indent();
     theFile<<"</Points>\n";
@@ -481,41 +535,41 @@ PVDRecorder::savePart0(int nodendf)
     // connectivity
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"connectivity"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<(int)nodes.size(); i++) {
 	this->indent();
-	theFile<<i<<std::endl;
+	this->value(i, true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // offsets
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"offsets"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<(int)nodes.size()<<std::endl;
+    this->value((int)nodes.size(), true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // types
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"types"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<VTK_POLY_VERTEX<<std::endl;
+    this->value(VTK_POLY_VERTEX, true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // cells footer
     this->decrLevel();
@@ -529,41 +583,41 @@ PVDRecorder::savePart0(int nodendf)
     // node tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"NodeTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<(int)nodes.size(); i++) {
 	this->indent();
-	theFile<<nodes[i]->getTag()<<std::endl;
+	this->value(nodes[i]->getTag(), true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // node velocity
     if(nodedata.vel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Velocity"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialVel();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node displacement
@@ -593,84 +647,84 @@ PVDRecorder::savePart0(int nodendf)
 
     // displacement
     this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Displacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<3<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialDisp();
 	    this->indent();
 	    for(int j=0; j<3; j++) {
 		if(j < vel.Size() && j < nodes[i]->getCrds().Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node incr displacement
     if(nodedata.incrdisp) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"IncrDisplacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getIncrDisp();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node acceleration
     if(nodedata.accel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Acceleration"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialAccel();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node pressure
     if(nodedata.pressure) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Pressure"<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    double pressure = 0.0;
@@ -679,95 +733,95 @@ PVDRecorder::savePart0(int nodendf)
 		pressure = thePC->getPressure();
 	    }
 	    this->indent();
-	    theFile<<pressure<<std::endl;
+	    this->value(pressure, true);
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node reaction
     if(nodedata.reaction) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Reaction"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getReaction();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node unbalanced load
     if(nodedata.unbalanced) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"UnbalancedLoad"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Vector& vel = nodes[i]->getUnbalancedLoad();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node mass
     if(nodedata.mass) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"NodeMass"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Matrix& mat = nodes[i]->getMass();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < mat.noRows()) {
-		    theFile<<mat(j,j)<<' ';
+		    this->value(mat(j,j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node eigen vector
     for(int k=0; k<nodedata.numeigen; k++) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"EigenVector"<<k+1<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)nodes.size(); i++) {
 	    const Matrix& eigens = nodes[i]->getEigenvectors();
@@ -778,16 +832,16 @@ PVDRecorder::savePart0(int nodendf)
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < eigens.noRows()) {
-		    theFile<<eigens(j,k)<<' ';
+		    this->value(eigens(j,k));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // point data footer
@@ -802,15 +856,15 @@ PVDRecorder::savePart0(int nodendf)
     // element tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"ElementTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<0<<std::endl;
+    this->value(0, true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // cell data footer
     this->decrLevel();
@@ -826,6 +880,9 @@ PVDRecorder::savePart0(int nodendf)
     this->indent();
     theFile<<"</UnstructuredGrid>\n";
 
+    // appended data
+    this->appendedData();
+
     this->decrLevel();
     this->indent();
     theFile<<"</VTKFile>\n";
@@ -854,7 +911,7 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     // open file
     theFile.close();
     std::string vtuname = pathname+basename+"/"+basename+"_T"+stime+"_P"+spart+".vtu";
-    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out);
+    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out|std::ios::binary);
     if(theFile.fail()) {
 	opserr<<"WARNING: Failed to open file "<<vtuname.c_str()<<"\n";
 	return -1;
@@ -867,7 +924,7 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     theFile<<"<VTKFile type="<<quota<<"UnstructuredGrid"<<quota;
     theFile<<" version="<<quota<<"1.0"<<quota;
     theFile<<" byte_order="<<quota<<"LittleEndian"<<quota;
-    theFile<<" compressor="<<quota<<"vtkZLibDataCompressor"<<quota;
+    this->formatAttributes();
     theFile<<">\n";
     this->incrLevel();
     this->indent();
@@ -900,10 +957,10 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     // points header
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+    this->beginArray("Float64");
     theFile<<" Name="<<quota<<"Points"<<quota;
     theFile<<" NumberOfComponents="<<quota<<3<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
 
     // points coordinates
     this->incrLevel();
@@ -912,18 +969,18 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
 	this->indent();
 	for(int j=0; j<3; j++) {
 	    if(j < (int)crds.size()) {
-		theFile<<crds[j]<<' ';
+		this->value(crds[j]);
 	    } else {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
 	}
-	theFile<<std::endl;
+	this->endLine();
     }
 
     // points footer
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
     this->decrLevel();
     this->indent();
     theFile<<"</Points>\n";
@@ -935,41 +992,41 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     // connectivity
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"connectivity"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<(int)particles.size(); i++) {
 	this->indent();
-	theFile<<i<<std::endl;
+	this->value(i, true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // offsets
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"offsets"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<(int)particles.size()<<std::endl;
+    this->value((int)particles.size(), true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // types
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"types"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<VTK_POLY_VERTEX<<std::endl;
+    this->value(VTK_POLY_VERTEX, true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // cells footer
     this->decrLevel();
@@ -983,198 +1040,198 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     // node tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"NodeTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<(int)particles.size(); i++) {
 	this->indent();
-	theFile<<particles[i]->getTag()<<std::endl;
+	this->value((int)particles[i]->getTag(), true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // node velocity
     if(nodedata.vel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Velocity"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    const VDouble& vel = particles[i]->getVel();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < (int)vel.size()) {
-		    theFile<<vel[j]<<' ';
+		    this->value(vel[j]);
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node displacement
     if(nodedata.disp) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Displacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node incr displacement
     if(nodedata.incrdisp) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"IncrDisplacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node acceleration
     if(nodedata.accel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Acceleration"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node pressure
     if(nodedata.pressure) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Pressure"<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    double pressure = particles[i]->getPressure();
 	    this->indent();
-	    theFile<<pressure<<std::endl;
+	    this->value(pressure, true);
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node reaction
     if(nodedata.reaction) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Reaction"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node unbalanced load
     if(nodedata.unbalanced) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"UnbalancedLoad"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node mass
     if(nodedata.mass) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"NodeMass"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node eigen vector
     for(int k=0; k<nodedata.numeigen; k++) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"EigenVector"<<k+1<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<(int)particles.size(); i++) {
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // point data footer
@@ -1189,15 +1246,15 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     // element tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"ElementTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     this->indent();
-    theFile<<0<<std::endl;
+    this->value(0, true);
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // cell data footer
     this->decrLevel();
@@ -1213,6 +1270,9 @@ PVDRecorder::savePartParticle(int pno, int bgtag, int nodendf)
     this->indent();
     theFile<<"</UnstructuredGrid>\n";
 
+    // appended data
+    this->appendedData();
+
     this->decrLevel();
     this->indent();
     theFile<<"</VTKFile>\n";
@@ -1241,7 +1301,7 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // open file
     theFile.close();
     std::string vtuname = pathname+basename+"/"+basename+"_T"+stime+"_P"+spart+".vtu";
-    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out);
+    theFile.open(vtuname.c_str(), std::ios::trunc|std::ios::out|std::ios::binary);
     if(theFile.fail()) {
 	opserr<<"WARNING: Failed to open file "<<vtuname.c_str()<<"\n";
 	return -1;
@@ -1254,7 +1314,7 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     theFile<<"<VTKFile type="<<quota<<"UnstructuredGrid"<<quota;
     theFile<<" version="<<quota<<"1.0"<<quota;
     theFile<<" byte_order="<<quota<<"LittleEndian"<<quota;
-    theFile<<" compressor="<<quota<<"vtkZLibDataCompressor"<<quota;
+    this->formatAttributes();
     theFile<<">\n";
     this->incrLevel();
     this->indent();
@@ -1310,10 +1370,10 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // points header
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+    this->beginArray("Float64");
     theFile<<" Name="<<quota<<"Points"<<quota;
     theFile<<" NumberOfComponents="<<quota<<3<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
 
     // points coordinates
     this->incrLevel();
@@ -1328,18 +1388,18 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 	this->indent();
 	for(int j=0; j<3; j++) {
 	    if(j < crds.Size()) {
-		theFile<<crds(j)<<' ';
+		this->value(crds(j));
 	    } else {
-		theFile<<0.0<<' ';
+		this->value(0.0);
 	    }
 	}
-	theFile<<std::endl;
+	this->endLine();
     }
 
     // points footer
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
     this->decrLevel();
     this->indent();
     theFile<<"</Points>\n";
@@ -1351,9 +1411,9 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // connectivity
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"connectivity"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<eletags.Size(); i++) {
 	const ID& elenodes = eles[i]->getExternalNodes();
@@ -1364,42 +1424,42 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 	    // is different to VTK
 	    int vtkOrder[] = {0,1,2,5,3,4};
 	    for(int j=0; j<numelenodes; j++) {
-		theFile<<ndtags.getLocationOrdered(elenodes(vtkOrder[j]*increlenodes))<<' ';
+		this->value(ndtags.getLocationOrdered(elenodes(vtkOrder[j]*increlenodes)));
 	    }
 
 	} else {
 
 	    for(int j=0; j<numelenodes; j++) {
-		theFile<<ndtags.getLocationOrdered(elenodes(j*increlenodes))<<' ';
+		this->value(ndtags.getLocationOrdered(elenodes(j*increlenodes)));
 	    }
 	}
-	theFile<<std::endl;
+	this->endLine();
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // offsets
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"offsets"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     int offset = numelenodes;
     for(int i=0; i<eletags.Size(); i++) {
 	this->indent();
-	theFile<<offset<<std::endl;
+	this->value(offset, true);
 	offset += numelenodes;
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // types
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"types"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     int type = vtktypes[ctag];
     if (type == 0) {
@@ -1408,11 +1468,11 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     }
     for(int i=0; i<eletags.Size(); i++) {
 	this->indent();
-	theFile<<type<<std::endl;
+	this->value(type, true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // cells footer
     this->decrLevel();
@@ -1426,41 +1486,41 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // node tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"NodeTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<ndtags.Size(); i++) {
 	this->indent();
-	theFile<<ndtags(i)<<std::endl;
+	this->value(ndtags(i), true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // node velocity
     if(nodedata.vel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Velocity"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialVel();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node displacement
@@ -1490,84 +1550,84 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 
     // displacement
     this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Displacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<3<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialDisp();
 	    this->indent();
 	    for(int j=0; j<3; j++) {
 		if(j < vel.Size() && j < nodes[i]->getCrds().Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node incr displacement
     if(nodedata.incrdisp) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"IncrDisplacement"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getIncrDisp();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node acceleration
     if(nodedata.accel) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Acceleration"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getTrialAccel();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node pressure
     if(nodedata.pressure) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Pressure"<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    double pressure = 0.0;
@@ -1576,95 +1636,95 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 		pressure = thePC->getPressure();
 	    }
 	    this->indent();
-	    theFile<<pressure<<std::endl;
+	    this->value(pressure, true);
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node reaction
     if(nodedata.reaction) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"Reaction"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getReaction();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node unbalanced load
     if(nodedata.unbalanced) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"UnbalancedLoad"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Vector& vel = nodes[i]->getUnbalancedLoad();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < vel.Size()) {
-		    theFile<<vel(j)<<' ';
+		    this->value(vel(j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node mass
     if(nodedata.mass) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"NodeMass"<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Matrix& mat = nodes[i]->getMass();
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < mat.noRows()) {
-		    theFile<<mat(j,j)<<' ';
+		    this->value(mat(j,j));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // node eigen vector
     for(int k=0; k<nodedata.numeigen; k++) {
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<"EigenVector"<<k+1<<quota;
 	theFile<<" NumberOfComponents="<<quota<<nodendf<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int i=0; i<ndtags.Size(); i++) {
 	    const Matrix& eigens = nodes[i]->getEigenvectors();
@@ -1675,16 +1735,16 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 	    this->indent();
 	    for(int j=0; j<nodendf; j++) {
 		if(j < eigens.noRows()) {
-		    theFile<<eigens(j,k)<<' ';
+		    this->value(eigens(j,k));
 		} else {
-		    theFile<<0.0<<' ';
+		    this->value(0.0);
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // point data footer
@@ -1699,17 +1759,17 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     // element tags
     this->incrLevel();
     this->indent();
-    theFile<<"<DataArray type="<<quota<<"Int64"<<quota;
+    this->beginArray("Int64");
     theFile<<" Name="<<quota<<"ElementTag"<<quota;
-    theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    this->beginData();
     this->incrLevel();
     for(int i=0; i<eletags.Size(); i++) {
 	this->indent();
-	theFile<<eletags(i)<<std::endl;
+	this->value(eletags(i), true);
     }
     this->decrLevel();
     this->indent();
-    theFile<<"</DataArray>\n";
+    this->endArray();
 
     // element response
     for(int i=0; i<(int)eledata.size(); i++) {
@@ -1730,14 +1790,14 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 
 	// save data
 	this->indent();
-	theFile<<"<DataArray type="<<quota<<"Float64"<<quota;
+	this->beginArray("Float64");
 	theFile<<" Name="<<quota<<eles[0]->getClassType();
 	for(int j=0; j<argc; j++) {
 	    theFile<<argv[j];
 	}
 	theFile<<quota;
 	theFile<<" NumberOfComponents="<<quota<<eressize<<quota;
-	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+	this->beginData();
 	this->incrLevel();
 	for(int j=0; j<eletags.Size(); j++) {
 	    data=theDomain->getElementResponse(eletags(j),&(argv[0]),argc);
@@ -1748,16 +1808,16 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
 	    this->indent();
 	    for(int k=0; k<eressize; k++) {
 		if (k>=data->Size()) {
-		    theFile<<0.0<<" ";
+		    this->value(0.0);
 		} else {
-		    theFile<<(*data)(k)<<" ";
+		    this->value((*data)(k));
 		}
 	    }
-	    theFile<<std::endl;
+	    this->endLine();
 	}
 	this->decrLevel();
 	this->indent();
-	theFile<<"</DataArray>\n";
+	this->endArray();
     }
 
     // cell data footer
@@ -1774,6 +1834,9 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     this->indent();
     theFile<<"</UnstructuredGrid>\n";
 
+    // appended data
+    this->appendedData();
+
     this->decrLevel();
     this->indent();
     theFile<<"</VTKFile>\n";
@@ -1783,8 +1846,210 @@ PVDRecorder::savePart(int partno, int ctag, int nodendf)
     return 0;
 }
 
+void
+PVDRecorder::getRegion()
+{
+    regionNodes.clear();
+    regionEles.clear();
+    if (regionTag < 0) {
+	return;
+    }
+
+    MeshRegion* theRegion = theDomain->getRegion(regionTag);
+    if (theRegion == 0) {
+	opserr<<"WARNING: region "<<regionTag<<" does not exist -- PVDRecorder\n";
+	return;
+    }
+
+    // sorted copies to look the tags up in
+    const ID& nodes = theRegion->getNodes();
+    for (int i=0; i<nodes.Size(); i++) {
+	regionNodes.push_back(nodes(i));
+    }
+    std::sort(regionNodes.begin(), regionNodes.end());
+    const ID& eles = theRegion->getElements();
+    for (int i=0; i<eles.Size(); i++) {
+	regionEles.push_back(eles(i));
+    }
+    std::sort(regionEles.begin(), regionEles.end());
+}
+
+// the VTKFile attributes of the data format, starts a new vtu file
+void
+PVDRecorder::formatAttributes()
+{
+    if (binary) {
+	theFile<<" header_type="<<quota<<"UInt64"<<quota;
+	if (compress) {
+	    theFile<<" compressor="<<quota<<"vtkZLibDataCompressor"<<quota;
+	}
+    } else {
+	theFile<<" compressor="<<quota<<"vtkZLibDataCompressor"<<quota;
+    }
+    appended.clear();
+    arrayData.clear();
+    inData = false;
+}
+
+enum {PVD_FLOAT64, PVD_FLOAT32, PVD_INT64, PVD_INT32, PVD_UINT8};
+
+void
+PVDRecorder::beginArray(const char* type)
+{
+    theFile<<"<DataArray type="<<quota<<type<<quota;
+    if (strcmp(type, "Float32") == 0) {
+	arrayType = PVD_FLOAT32;
+    } else if (strcmp(type, "Int64") == 0) {
+	arrayType = PVD_INT64;
+    } else if (strcmp(type, "Int32") == 0) {
+	arrayType = PVD_INT32;
+    } else if (strcmp(type, "UInt8") == 0) {
+	arrayType = PVD_UINT8;
+    } else {
+	arrayType = PVD_FLOAT64;
+    }
+}
+
+void
+PVDRecorder::beginData()
+{
+    if (binary) {
+	// the block of the array starts at the end of those before it
+	theFile<<" format="<<quota<<"appended"<<quota;
+	theFile<<" offset="<<quota<<(unsigned long)appended.size()<<quota<<">\n";
+	arrayData.clear();
+    } else {
+	theFile<<" format="<<quota<<"ascii"<<quota<<">\n";
+    }
+    inData = true;
+}
+
+template<class T> void
+PVDRecorder::appendRaw(T v)
+{
+    const char* p = reinterpret_cast<const char*>(&v);
+    arrayData.insert(arrayData.end(), p, p+sizeof(T));
+}
+
+void
+PVDRecorder::appendValue(double v)
+{
+    switch (arrayType) {
+    case PVD_FLOAT32: this->appendRaw((float)v); break;
+    case PVD_INT64: this->appendRaw((int64_t)v); break;
+    case PVD_INT32: this->appendRaw((int32_t)v); break;
+    case PVD_UINT8: this->appendRaw((uint8_t)v); break;
+    default: this->appendRaw(v); break;
+    }
+}
+
+void
+PVDRecorder::value(double v, bool endOfLine)
+{
+    if (binary) {
+	this->appendValue(v);
+	return;
+    }
+    theFile<<v;
+    if (endOfLine) {
+	theFile<<'\n';
+    } else {
+	theFile<<' ';
+    }
+}
+
+void
+PVDRecorder::value(int v, bool endOfLine)
+{
+    if (binary) {
+	this->appendValue(v);
+	return;
+    }
+    theFile<<v;
+    if (endOfLine) {
+	theFile<<'\n';
+    } else {
+	theFile<<' ';
+    }
+}
+
+void
+PVDRecorder::endLine()
+{
+    if (!binary) {
+	theFile<<'\n';
+    }
+}
+
+void
+PVDRecorder::endArray()
+{
+    inData = false;
+    if (!binary) {
+	theFile<<"</DataArray>\n";
+	return;
+    }
+
+    // the indent before this call was skipped with the array values
+    this->indent();
+    theFile<<"</DataArray>\n";
+
+    // the block: its size in bytes and the data, or with compression the
+    // header of its one zlib block (count, size, last size, compressed size)
+    uint64_t nbytes = arrayData.size();
+    std::vector<uint64_t> header;
+    const char* data = arrayData.data();
+    uint64_t ndata = nbytes;
+#ifdef _ZLIB
+    std::vector<char> zdata;
+    if (compress) {
+	uLongf zsize = compressBound((uLong)nbytes);
+	zdata.resize(zsize);
+	if (nbytes > 0 &&
+	    compress2((Bytef*)zdata.data(), &zsize, (const Bytef*)data, (uLong)nbytes, Z_DEFAULT_COMPRESSION) != Z_OK) {
+	    opserr<<"WARNING: failed to compress a DataArray -- PVDRecorder\n";
+	    zsize = 0;
+	}
+	header.push_back(nbytes > 0 ? 1 : 0);
+	header.push_back(nbytes);
+	header.push_back(nbytes);
+	if (nbytes > 0) {
+	    header.push_back(zsize);
+	}
+	data = zdata.data();
+	ndata = nbytes > 0 ? zsize : 0;
+    } else
+#endif
+    header.push_back(nbytes);
+
+    const char* h = reinterpret_cast<const char*>(header.data());
+    appended.insert(appended.end(), h, h+header.size()*sizeof(uint64_t));
+    appended.insert(appended.end(), data, data+ndata);
+    arrayData.clear();
+}
+
+void
+PVDRecorder::appendedData()
+{
+    if (!binary || appended.empty()) {
+	return;
+    }
+    this->indent();
+    theFile<<"<AppendedData encoding="<<quota<<"raw"<<quota<<">\n";
+    theFile<<'_';
+    theFile.write(appended.data(), appended.size());
+    theFile<<'\n';
+    this->indent();
+    theFile<<"</AppendedData>\n";
+    appended.clear();
+}
+
 void
 PVDRecorder::indent() {
+    // no white space between the values of a binary array
+    if (binary && inData) {
+	return;
+    }
     for(int i=0; i<indentlevel*indentsize; i++) {
 	theFile<<' ';
     }
@@ -54,7 +54,8 @@ public:
     
 public:
     PVDRecorder(const char *filename, const NodeData& ndata,
-		const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double relDeltaTTol = 0.00001);
+		const std::vector<EleData>& edata, int ind=2, int pre=10, double dt=0, double relDeltaTTol = 0.00001,
+		bool binary=false, bool compress=false, int stride=1, int regionTag=-1);
     PVDRecorder();
     ~PVDRecorder();
 
@@ -81,6 +82,20 @@ private:
     virtual int savePart0(int ndf);
     virtual int savePartParticle(int partno, int gtag, int ndf);
     void getfilename(const char* name);
+
+    // the DataArrays are written either as ascii or, with binary set,
+    // as raw (or zlib compressed) blocks of the AppendedData section
+    void formatAttributes();
+    void beginArray(const char* type);
+    void beginData();
+    void value(double v, bool endOfLine=false);
+    void value(int v, bool endOfLine=false);
+    void endLine();
+    void endArray();
+    void appendedData();
+    void appendValue(double v);
+    template<class T> void appendRaw(T v);
+    void getRegion();
     
 private:
     int indentsize, precision, indentlevel;
@@ -97,6 +112,17 @@ private:
     double dT, nextTime;
     double relDeltaTTol;
 
+    bool binary, compress;
+    int arrayType;
+    bool inData;
+    std::vector<char> appended;
+    std::vector<char> arrayData;
+
+    // every stride-th time step is written, of the region if regionTag >= 0
+    int stride, numSteps;
+    int regionTag;
+    std::vector<int> regionNodes, regionEles;
+
 public:
     enum VtkType {
 	VTK_VERTEX=1,VTK_POLY_VERTEX=2,VTK_LINE=3,VTK_POLY_LINE=4,
@@ -33,6 +33,7 @@
 
 #include <Recorder.h>
 #include <OPS_Globals.h>
+#include <MemoryReport.h>
 
 int Recorder::lastRecorderTag(0);
 
@@ -91,3 +92,9 @@ Recorder::Print(OPS_Stream &s, int flag)
 {
   return;
 }
+
+size_t
+Recorder::getMemoryUsage(void)
+{
+  return MemoryReport::objectSize(this);
+}
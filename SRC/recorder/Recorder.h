@@ -39,6 +39,7 @@
 class Domain;
 #include <MovableObject.h>
 #include <TaggedObject.h>
+#include <stddef.h>
 
 
 class Recorder: public MovableObject, public TaggedObject
@@ -58,6 +59,7 @@ class Recorder: public MovableObject, public TaggedObject
 			 FEM_ObjectBroker &theBroker);
 
     virtual void Print(OPS_Stream &s, int flag); 
+    virtual size_t getMemoryUsage(void);
 	virtual double getRecordedValue(int clmnId, int rowOffset, bool reset) { return 0; } //added by SAJalali
 
   protected:
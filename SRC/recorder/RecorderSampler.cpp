@@ -0,0 +1,243 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// RecorderSampler.
+
+#include <RecorderSampler.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Vector.h>
+#include <OPS_Stream.h>
+#include <elementAPI.h>
+#include <string.h>
+#include <math.h>
+
+RecorderSampler::RecorderSampler(int n)
+  :every(n), numSteps(0),
+   hasTrigger(false), nodeTag(0), dof(0), responseType(0), threshold(0.0),
+   preSteps(0), postSteps(0), theNode(0),
+   active(false), quietSteps(0),
+   ring(), ringWritten(), ringStart(0), ringCount(0), rowSize(0)
+{
+  if (every < 1)
+    every = 1;
+}
+
+RecorderSampler::~RecorderSampler()
+{
+
+}
+
+void
+RecorderSampler::setEvery(int n)
+{
+  every = (n > 0) ? n : 1;
+}
+
+void
+RecorderSampler::setTrigger(int tag, int df, int type, double value,
+			    int pre, int post)
+{
+  hasTrigger = true;
+  nodeTag = tag;
+  dof = df;
+  responseType = type;
+  threshold = fabs(value);
+  preSteps = (pre > 0) ? pre : 0;
+  postSteps = (post > 0) ? post : 0;
+}
+
+int
+RecorderSampler::setDomain(Domain &theDomain)
+{
+  if (hasTrigger == false)
+    return 0;
+
+  theNode = theDomain.getNode(nodeTag);
+  if (theNode == 0) {
+    opserr << "WARNING RecorderSampler::setDomain() - trigger node " << nodeTag
+	   << " not found, no event will be triggered\n";
+    return -1;
+  }
+  return 0;
+}
+
+void
+RecorderSampler::restart(void)
+{
+  numSteps = 0;
+  active = false;
+  quietSteps = 0;
+  ringStart = 0;
+  ringCount = 0;
+}
+
+int
+RecorderSampler::write(Vector &row, OPS_Stream &theHandler)
+{
+  bool everyNth = (numSteps++ % every == 0);
+
+  if (hasTrigger == false) {
+    if (everyNth == true)
+      return theHandler.write(row);
+    return 0;
+  }
+
+  //
+  // check the monitored response against the threshold
+  //
+
+  bool above = false;
+  if (theNode != 0) {
+    const Vector *theResponse;
+    if (responseType == 1)
+      theResponse = &(theNode->getTrialVel());
+    else if (responseType == 2)
+      theResponse = &(theNode->getTrialAccel());
+    else
+      theResponse = &(theNode->getTrialDisp());
+    if (dof >= 0 && dof < theResponse->Size())
+      above = (fabs((*theResponse)(dof)) >= threshold);
+  }
+
+  if (above == true) {
+    if (active == false) {
+      // an event starts, write the steps before it first
+      active = true;
+      this->flushRing(theHandler);
+    }
+    quietSteps = 0;
+  } else if (active == true) {
+    if (++quietSteps > postSteps)
+      active = false;
+  }
+
+  if (active == true)
+    return theHandler.write(row);
+
+  //
+  // between events, keep the row for the next one
+  //
+
+  bool written = false;
+  int res = 0;
+  if (every > 1 && everyNth == true) {
+    res = theHandler.write(row);
+    written = true;
+  }
+
+  if (preSteps > 0) {
+    if (row.Size() != rowSize) {
+      rowSize = row.Size();
+      ring.assign(preSteps*rowSize, 0.0);
+      ringWritten.assign(preSteps, false);
+      ringStart = 0;
+      ringCount = 0;
+    }
+
+    int slot;
+    if (ringCount < preSteps)
+      slot = (ringStart + ringCount++) % preSteps;
+    else {
+      slot = ringStart;
+      ringStart = (ringStart + 1) % preSteps;
+    }
+    double *data = &ring[slot*rowSize];
+    for (int i=0; i<rowSize; i++)
+      data[i] = row(i);
+    ringWritten[slot] = written;
+  }
+
+  return res;
+}
+
+void
+RecorderSampler::flushRing(OPS_Stream &theHandler)
+{
+  for (int k=0; k<ringCount; k++) {
+    int slot = (ringStart + k) % preSteps;
+    if (ringWritten[slot] == false) {
+      Vector theRow(&ring[slot*rowSize], rowSize);
+      theHandler.write(theRow);
+    }
+  }
+  ringStart = 0;
+  ringCount = 0;
+}
+
+int
+OPS_RecorderSamplerOption(const char *option, RecorderSampler *&theSampler)
+{
+  if (strcmp(option, "-every") == 0) {
+    int every;
+    int numdata = 1;
+    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numdata, &every) < 0) {
+      opserr << "WARNING recorder -every N? - failed to read N\n";
+      return -1;
+    }
+    if (theSampler == 0)
+      theSampler = new RecorderSampler(every);
+    else
+      theSampler->setEvery(every);
+    return 1;
+  }
+
+  if (strcmp(option, "-trigger") == 0) {
+    if (OPS_GetNumRemainingInputArgs() < 6) {
+      opserr << "WARNING recorder -trigger nodeTag? dof? disp|vel|accel threshold? preSteps? postSteps?\n";
+      return -1;
+    }
+    int idata[2];
+    int numdata = 2;
+    if (OPS_GetIntInput(&numdata, idata) < 0) {
+      opserr << "WARNING recorder -trigger - failed to read the node and dof\n";
+      return -1;
+    }
+    const char *type = OPS_GetString();
+    int responseType = 0;
+    if (strcmp(type, "vel") == 0)
+      responseType = 1;
+    else if (strcmp(type, "accel") == 0)
+      responseType = 2;
+    else if (strcmp(type, "disp") != 0) {
+      opserr << "WARNING recorder -trigger - unknown response " << type << ", use disp, vel or accel\n";
+      return -1;
+    }
+    double threshold;
+    numdata = 1;
+    if (OPS_GetDoubleInput(&numdata, &threshold) < 0) {
+      opserr << "WARNING recorder -trigger - failed to read the threshold\n";
+      return -1;
+    }
+    int steps[2];
+    numdata = 2;
+    if (OPS_GetIntInput(&numdata, steps) < 0) {
+      opserr << "WARNING recorder -trigger - failed to read the pre and post trigger steps\n";
+      return -1;
+    }
+    if (theSampler == 0)
+      theSampler = new RecorderSampler();
+    theSampler->setTrigger(idata[0], idata[1]-1, responseType, threshold, steps[0], steps[1]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for RecorderSampler.
+// A RecorderSampler decides which of the rows a time history recorder
+// produces are written. Of the steps passing the recorder's -dT only every
+// Nth is written; with a trigger, a node response monitored against a
+// threshold, the steps of an event are written at the full rate: the
+// pre-trigger steps kept in a ring buffer when the threshold is crossed &
+// those after it until postSteps steps have been quiet again. Between
+// events only the every Nth rows are written, none without -every.
+
+#ifndef RecorderSampler_h
+#define RecorderSampler_h
+
+#include <vector>
+
+class Domain;
+class Node;
+class Vector;
+class OPS_Stream;
+
+class RecorderSampler
+{
+  public:
+    RecorderSampler(int every = 1);
+    ~RecorderSampler();
+
+    // the node response (0 disp, 1 vel, 2 accel) monitored in dof
+    void setEvery(int every);
+    void setTrigger(int nodeTag, int dof, int responseType, double threshold,
+		    int preSteps, int postSteps);
+    int setDomain(Domain &theDomain);
+    void restart(void);
+
+    // writes row, or keeps it for a later event, as set above
+    int write(Vector &row, OPS_Stream &theHandler);
+
+  private:
+    void flushRing(OPS_Stream &theHandler);
+
+    int every;
+    int numSteps;
+
+    bool hasTrigger;
+    int nodeTag, dof, responseType;
+    double threshold;
+    int preSteps, postSteps;
+    Node *theNode;
+
+    bool active;          // within an event
+    int quietSteps;       // steps below the threshold in an event
+
+    // the last preSteps rows, oldest at ringStart, & whether each was
+    // already written as an every Nth row
+    std::vector<double> ring;
+    std::vector<bool> ringWritten;
+    int ringStart, ringCount, rowSize;
+};
+
+// parses the -every & -trigger options of the recorder commands, returns 1
+// if option is one of them, 0 if not and -1 on an error in its arguments
+extern int OPS_RecorderSamplerOption(const char *option, RecorderSampler *&theSampler);
+
+#endif
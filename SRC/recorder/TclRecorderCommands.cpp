@@ -39,6 +39,7 @@
 
  #include <stdio.h>
  #include <stdlib.h>
+ #include <ctype.h>
  #include <string.h>
  #include <Domain.h>
  #include <EquiSolnAlgo.h>
@@ -71,6 +72,9 @@ extern void* OPS_VTKHDF_Recorder();
 extern void* OPS_VTK_Recorder();
 extern void* OPS_ElementRecorderRMS();
 extern void* OPS_NodeRecorderRMS();
+extern void* OPS_MetricsRecorder();
+extern void* OPS_FiberSectionRecorder();
+extern void* OPS_LiveViewRecorder();
 
 
  #include <NodeIter.h>
@@ -91,6 +95,8 @@ extern void* OPS_NodeRecorderRMS();
  #include <DataFileStreamAdd.h>
  #include <XmlFileStream.h>
  #include <BinaryFileStream.h>
+ #include <ColumnarFileStream.h>
+ #include <AsyncStream.h>
  #include <DatabaseStream.h>
  #include <DummyStream.h>
  #include <TCP_Stream.h>
@@ -114,7 +120,7 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 
  static ExternalRecorderCommand *theExternalRecorderCommands = NULL;
 
-enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD};
+enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMNAR_STREAM};
 
 
  #include <EquiSolnAlgo.h>
@@ -138,6 +144,57 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
  extern FE_Datastore *theDatabase;
  extern FEM_ObjectBroker theBroker;
 
+ // -every n and -trigger nodeTag dof disp|vel|accel threshold preSteps postSteps,
+ // returns 1 and moves loc past the option if it is one of them, -1 on error
+ static int
+ TclSamplerOption(Tcl_Interp *interp, int argc, TCL_Char **argv, int &loc,
+		  RecorderSampler *&theSampler)
+ {
+   if (strcmp(argv[loc],"-every") == 0) {
+     int every;
+     if (loc+1 >= argc || Tcl_GetInt(interp, argv[loc+1], &every) != TCL_OK) {
+       opserr << "WARNING recorder -every n? - failed to read n\n";
+       return -1;
+     }
+     if (theSampler == 0)
+       theSampler = new RecorderSampler(every);
+     else
+       theSampler->setEvery(every);
+     loc += 2;
+     return 1;
+   }
+
+   if (strcmp(argv[loc],"-trigger") == 0) {
+     int nodeTag, dof, preSteps, postSteps;
+     double threshold;
+     if (loc+6 >= argc ||
+	 Tcl_GetInt(interp, argv[loc+1], &nodeTag) != TCL_OK ||
+	 Tcl_GetInt(interp, argv[loc+2], &dof) != TCL_OK ||
+	 Tcl_GetDouble(interp, argv[loc+4], &threshold) != TCL_OK ||
+	 Tcl_GetInt(interp, argv[loc+5], &preSteps) != TCL_OK ||
+	 Tcl_GetInt(interp, argv[loc+6], &postSteps) != TCL_OK) {
+       opserr << "WARNING recorder -trigger nodeTag? dof? disp|vel|accel threshold? preSteps? postSteps?\n";
+       return -1;
+     }
+     int responseType = 0;
+     if (strcmp(argv[loc+3],"vel") == 0)
+       responseType = 1;
+     else if (strcmp(argv[loc+3],"accel") == 0)
+       responseType = 2;
+     else if (strcmp(argv[loc+3],"disp") != 0) {
+       opserr << "WARNING recorder -trigger - unknown response " << argv[loc+3] << ", use disp, vel or accel\n";
+       return -1;
+     }
+     if (theSampler == 0)
+       theSampler = new RecorderSampler();
+     theSampler->setTrigger(nodeTag, dof-1, responseType, threshold, preSteps, postSteps);
+     loc += 7;
+     return 1;
+   }
+
+   return 0;
+ }
+
  int
  TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 		   TCL_Char **argv, Domain &theDomain, Recorder **theRecorder)
@@ -172,6 +229,10 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        int flags = 0;
        int eleData = 0;
        outputMode eMode = STANDARD_STREAM; 
+       int asyncRows = 0;
+       const char *compression = 0;
+       int tcpBatch = 0;
+       bool sharded = false;
        ID *eleIDs = 0;
        int precision = 6;
        const char *inetAddr = 0;
@@ -179,12 +240,23 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        bool closeOnWrite = false;
        int writeBufferSize = 0;
        bool doScientific = false;
+       bool doRMS = false;
+       RecorderSampler *theSampler = 0;
 
        ID *specificIndices = 0;
 
        while (flags == 0 && loc < argc) {
 
-	 if ((strcmp(argv[loc],"-ele") == 0) ||
+	 int samplerOption = 0;
+	 if (strcmp(argv[1],"Element") == 0 &&
+	     (samplerOption = TclSamplerOption(interp, argc, argv, loc, theSampler)) != 0) {
+	   if (samplerOption < 0) {
+	     if (theSampler != 0)
+	       delete theSampler;
+	     return TCL_ERROR;
+	   }
+	 }
+	 else if ((strcmp(argv[loc],"-ele") == 0) ||
 	     (strcmp(argv[loc],"-eles") == 0) ||
 	     (strcmp(argv[loc],"-element") == 0)) {
 
@@ -429,6 +501,42 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   simulationInfo.addOutputFile(fileName, pwd);
 	   eMode = BINARY_STREAM;
 	   loc += 2;
+	 }
+	 else if ((strcmp(argv[loc],"-columnar") == 0)) {
+	   fileName = argv[loc+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMNAR_STREAM;
+	   loc += 2;
+	 }
+	 else if ((strcmp(argv[loc],"-rms") == 0)) {
+	   // EnvelopeElement also records the RMS in the same pass
+	   doRMS = true;
+	   loc++;
+	 }
+	 else if ((strcmp(argv[loc],"-compress") == 0)) {
+	   // compress the -file, -binary or -xml output, zstd or lz4
+	   if (loc+1 < argc)
+	     compression = argv[loc+1];
+	   loc += 2;
+	 }
+	 else if ((strcmp(argv[loc],"-async") == 0)) {
+	   // write from a separate thread, at most n rows waiting
+	   asyncRows = 1000;
+	   loc++;
+	   if (loc < argc && isdigit(argv[loc][0]))
+	     asyncRows = atoi(argv[loc++]);
+	 }	    
+	 else if ((strcmp(argv[loc],"-shards") == 0)) {
+	   // in parallel each process writes its own columns
+	   sharded = true;
+	   loc++;
+	 }
+	 else if ((strcmp(argv[loc],"-tcpBatch") == 0)) {
+	   // send the -tcp rows in chunks of n rows
+	   if (loc+1 < argc)
+	     tcpBatch = atoi(argv[loc+1]);
+	   loc += 2;
 	 }	    
 
 	 else {
@@ -468,11 +576,22 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM && fileName != 0) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+	 theOutputStream = new ColumnarFileStream(fileName);
        } else if (eMode == TCP_STREAM && inetAddr != 0) {
-	 theOutputStream = new TCP_Stream(inetPort, inetAddr);
+	 theOutputStream = new TCP_Stream(inetPort, inetAddr, false, tcpBatch);
        } else 
 	 theOutputStream = new StandardStream();
 
+       if (compression != 0 && theOutputStream->setCompression(compression) < 0)
+	 opserr << "WARNING recorder - -compress " << compression << " not available for this output, written uncompressed\n";
+
+       if (sharded && theOutputStream->setSharded(true) < 0)
+	 opserr << "WARNING recorder - -shards only applies to -file and -csv output, ignored\n";
+
+       if (asyncRows > 0)
+	 theOutputStream = new AsyncStream(theOutputStream, asyncRows);
+
        theOutputStream->setPrecision(precision);
 
        if (strcmp(argv[1],"Element") == 0) {
@@ -486,6 +605,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 					      dT,
 					      rTolDt,
 					      specificIndices);
+	 if (theSampler != 0)
+	   ((ElementRecorder *)(*theRecorder))->setSampler(theSampler);
 
        } else if (strcmp(argv[1],"EnvelopeElement") == 0) {
 
@@ -498,7 +619,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 						      rTolDt,
 						      echoTime,
 						      specificIndices,
-						      closeOnWrite);
+						      closeOnWrite,
+						      doRMS);
 
        } else if (strcmp(argv[1],"NormElement") == 0) {
 
@@ -1102,6 +1224,12 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        TCL_Char *responseID = 0;
 
        outputMode eMode = STANDARD_STREAM;
+       int asyncRows = 0;
+       const char *compression = 0;
+       int tcpBatch = 0;
+       bool sharded = false;
+       bool doRMS = false;
+       RecorderSampler *theSampler = 0;
 
        int pos = 2;
 
@@ -1221,6 +1349,50 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   simulationInfo.addOutputFile(fileName, pwd);
 	   eMode = BINARY_STREAM;
 	   pos += 2;
+	 }
+	 else if ((strcmp(argv[pos],"-columnar") == 0)) {
+	   fileName = argv[pos+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMNAR_STREAM;
+	   pos += 2;
+	 }
+	 else if (strcmp(argv[1],"Node") == 0 &&
+		  (strcmp(argv[pos],"-every") == 0 || strcmp(argv[pos],"-trigger") == 0)) {
+	   if (TclSamplerOption(interp, argc, argv, pos, theSampler) < 0) {
+	     if (theSampler != 0)
+	       delete theSampler;
+	     return TCL_ERROR;
+	   }
+	 }
+	 else if ((strcmp(argv[pos],"-rms") == 0)) {
+	   // EnvelopeNode also records the RMS in the same pass
+	   doRMS = true;
+	   pos++;
+	 }
+	 else if ((strcmp(argv[pos],"-compress") == 0)) {
+	   // compress the -file, -binary or -xml output, zstd or lz4
+	   if (pos+1 < argc)
+	     compression = argv[pos+1];
+	   pos += 2;
+	 }
+	 else if ((strcmp(argv[pos],"-async") == 0)) {
+	   // write from a separate thread, at most n rows waiting
+	   asyncRows = 1000;
+	   pos++;
+	   if (pos < argc && isdigit(argv[pos][0]))
+	     asyncRows = atoi(argv[pos++]);
+	 }	    
+	 else if ((strcmp(argv[pos],"-shards") == 0)) {
+	   // in parallel each process writes its own columns
+	   sharded = true;
+	   pos++;
+	 }
+	 else if ((strcmp(argv[pos],"-tcpBatch") == 0)) {
+	   // send the -tcp rows in chunks of n rows
+	   if (pos+1 < argc)
+	     tcpBatch = atoi(argv[pos+1]);
+	   pos += 2;
 	 }	    
 
 
@@ -1411,12 +1583,23 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM && fileName != 0) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+	 theOutputStream = new ColumnarFileStream(fileName);
        } else if (eMode == TCP_STREAM && inetAddr != 0) {
-	 theOutputStream = new TCP_Stream(inetPort, inetAddr);
+	 theOutputStream = new TCP_Stream(inetPort, inetAddr, false, tcpBatch);
        } else {
 	 theOutputStream = new StandardStream();
        }
 
+       if (compression != 0 && theOutputStream->setCompression(compression) < 0)
+	 opserr << "WARNING recorder - -compress " << compression << " not available for this output, written uncompressed\n";
+
+       if (sharded && theOutputStream->setSharded(true) < 0)
+	 opserr << "WARNING recorder - -shards only applies to -file and -csv output, ignored\n";
+
+       if (asyncRows > 0)
+	 theOutputStream = new AsyncStream(theOutputStream, asyncRows);
+
        theOutputStream->setPrecision(precision);
 
        if (theTimeSeries != 0 && theTimeSeriesID.Size() < theDofs.Size()) {
@@ -1441,6 +1624,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 					   rTolDt,
 					   echoTimeFlag,
 					   theTimeSeries);
+	 if (theSampler != 0)
+	   ((NodeRecorder *)(*theRecorder))->setSampler(theSampler);
 
        } else {
 
@@ -1453,7 +1638,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 						   rTolDt,
 						   echoTimeFlag,
 						   theTimeSeries,
-						   closeOnWrite);
+						   closeOnWrite,
+						   doRMS);
        }
 
        if (theNodes != 0)
@@ -1487,6 +1673,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
      else if ((strcmp(argv[1],"Drift") == 0) || (strcmp(argv[1],"EnvelopeDrift") == 0)) {
 
        outputMode eMode = STANDARD_STREAM;       // enum found in DataOutputFileHandler.h
+       int asyncRows = 0;
+       const char *compression = 0;
 
        bool echoTimeFlag = false;
        ID iNodes(0,16);
@@ -1545,6 +1733,26 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   simulationInfo.addOutputFile(fileName, pwd);
 	   eMode = BINARY_STREAM;
 	   pos += 2;
+	 }
+	 else if ((strcmp(argv[pos],"-columnar") == 0)) {
+	   fileName = argv[pos+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMNAR_STREAM;
+	   pos += 2;
+	 }
+	 else if ((strcmp(argv[pos],"-compress") == 0)) {
+	   // compress the -file, -binary or -xml output, zstd or lz4
+	   if (pos+1 < argc)
+	     compression = argv[pos+1];
+	   pos += 2;
+	 }
+	 else if ((strcmp(argv[pos],"-async") == 0)) {
+	   // write from a separate thread, at most n rows waiting
+	   asyncRows = 1000;
+	   pos++;
+	   if (pos < argc && isdigit(argv[pos][0]))
+	     asyncRows = atoi(argv[pos++]);
 	 }	    
 
 	 else if ((strcmp(argv[pos],"-nees") == 0) || (strcmp(argv[pos],"-xml") == 0)) {
@@ -1660,9 +1868,17 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMNAR_STREAM) {
+	 theOutputStream = new ColumnarFileStream(fileName);
        } else
 	 theOutputStream = new StandardStream();
 
+       if (compression != 0 && theOutputStream->setCompression(compression) < 0)
+	 opserr << "WARNING recorder - -compress " << compression << " not available for this output, written uncompressed\n";
+
+       if (asyncRows > 0)
+	 theOutputStream = new AsyncStream(theOutputStream, asyncRows);
+
        // Subtract one from dof and perpDirn for C indexing
        if (strcmp(argv[1],"Drift") == 0) 
 	 (*theRecorder) = new DriftRecorder(iNodes, jNodes, dof-1, perpDirn-1,
@@ -1930,6 +2146,18 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
        (*theRecorder) = (Recorder*) OPS_NodeRecorderRMS();
      }
+     else if (strcmp(argv[1],"Metrics") == 0) {
+       OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+       (*theRecorder) = (Recorder*) OPS_MetricsRecorder();
+     }
+     else if (strcmp(argv[1],"FiberSection") == 0) {
+       OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+       (*theRecorder) = (Recorder*) OPS_FiberSectionRecorder();
+     }
+     else if (strcmp(argv[1],"LiveView") == 0) {
+       OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+       (*theRecorder) = (Recorder*) OPS_LiveViewRecorder();
+     }
 #ifdef _HDF5
      else if (strcmp(argv[1], "mpco") == 0) {
        OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
@@ -50,6 +50,11 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+
+#ifdef _PARALLEL_INTERPRETERS
+#include <mpi.h>
+#endif
+
 using std::ifstream;
 using std::ios;
 using std::setw;
@@ -66,7 +71,8 @@ ImportanceSamplingAnalysis::ImportanceSamplingAnalysis(ReliabilityDomain *passed
 							long int passedNumberOfSimulations,
                             double passedTargetCOV, double passedSamplingStdv,
 							int passedPrintFlag, TCL_Char *passedFileName,
-							int passedAnalysisTypeTag)
+							int passedAnalysisTypeTag,
+							bool passedDistributed)
 :ReliabilityAnalysis(), theReliabilityDomain(passedReliabilityDomain), 
 theOpenSeesDomain(passedOpenSeesDomain)
 {
@@ -80,6 +86,7 @@ theOpenSeesDomain(passedOpenSeesDomain)
 	printFlag = passedPrintFlag;
 	strcpy(fileName,passedFileName);
 	analysisTypeTag = passedAnalysisTypeTag;
+	distributed = passedDistributed;
 }
 
 
@@ -209,27 +216,62 @@ ImportanceSamplingAnalysis::analyze(void)
 	bool FEconvergence;
 
 
+	// When distributed, with a generator that gives each sample its own
+	// stream, the failure probability samples of a round are shared out
+	// among the processes, each evaluates one in its own domain and the
+	// sums are added up over the processes after every round; all the
+	// processes must then run this analysis of the same model
+	int myid = 0;
+	int numProcs = 1;
+#ifdef _PARALLEL_INTERPRETERS
+	if (distributed) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+		MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+	}
+#endif
+	bool parallel = numProcs > 1 && analysisTypeTag == 1 &&
+		theRandomNumberGenerator->setStream(0) == 0;
+
+
 	// Prepare output file
-	ofstream resultsOutputFile( fileName, ios::out );
+	ofstream resultsOutputFile;
+	if (myid == 0 || !parallel)
+		resultsOutputFile.open( fileName, ios::out );
 
 
 	bool isFirstSimulation = true;
 	while( ( k <= numberOfSimulations && govCov > targetCOV || k <= 2 ) ) {
 
+		// Samples k, ..., k+numInRound-1 are evaluated in this round,
+		// this process evaluates 'sample'; k is then set to the last one
+		long int sample = k;
+		long int numInRound = 1;
+		if (parallel) {
+			long int lastSample = numberOfSimulations > 2 ? numberOfSimulations : 2;
+			numInRound = lastSample - k + 1;
+			if (numInRound > numProcs)
+				numInRound = numProcs;
+			if (numInRound < 1)
+				numInRound = 1;
+			sample = k + myid;
+			k += numInRound - 1;
+		}
+		bool evaluate = sample <= k;
+
 		// Keep the user posted
-		if (printFlag == 1 || printFlag == 2) {
-            sprintf(myString,"%li",k);
+		if ((printFlag == 1 || printFlag == 2) && evaluate) {
+            sprintf(myString,"%li",sample);
 			opserr << "Sample #" << myString << ":" << endln;
 		}
 
 		
-		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
-		}
-		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+		// Create array of standard normal random numbers, a generator
+		// with streams draws those of each sample from its own stream
+		if (isFirstSimulation && seed != 0) {
+			theRandomNumberGenerator->setSeed(seed);
 		}
+		theRandomNumberGenerator->setStream(sample);
+		result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
 		seed = theRandomNumberGenerator->getSeed();
 		if (result < 0) {
 			opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
@@ -251,7 +293,7 @@ ImportanceSamplingAnalysis::analyze(void)
 		}
         
         // update domain with new x values
-        for (int j = 0; j < numRV; j++) {
+        for (int j = 0; j < numRV && evaluate; j++) {
             RandomVariable *theRV = theReliabilityDomain->getRandomVariablePtrFromIndex(j);
             int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
             Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
@@ -262,7 +304,7 @@ ImportanceSamplingAnalysis::analyze(void)
 		
         
         // set values in the variable namespace
-        if (theGFunEvaluator->setVariables() < 0) {
+        if (evaluate && theGFunEvaluator->setVariables() < 0) {
             opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
                 << " could not set variables in namespace. " << endln;
             return -1;
@@ -270,7 +312,7 @@ ImportanceSamplingAnalysis::analyze(void)
         
 		// Evaluate limit-state function
 		FEconvergence = true;
-		if (theGFunEvaluator -> runAnalysis() < 0) {
+		if (evaluate && theGFunEvaluator -> runAnalysis() < 0) {
 			// In this case a failure happened during the analysis
 			// Hence, register this as failure
             opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
@@ -293,7 +335,7 @@ ImportanceSamplingAnalysis::analyze(void)
             const char *lsfExpression = theLimitStateFunction->getExpression();
             theGFunEvaluator->setExpression(lsfExpression);
             
-            gFunctionValue = theGFunEvaluator->evaluateExpression();
+            gFunctionValue = evaluate ? theGFunEvaluator->evaluateExpression() : 1.0;
             if (!FEconvergence) {
 				gFunctionValue = -1.0;
 			}
@@ -325,10 +367,19 @@ ImportanceSamplingAnalysis::analyze(void)
 				h   = factor2 * exp( -0.5 * temp2 );
 
 
-				// Update sums
+				// Update sums, with the samples of the other processes
 				q = I * phi / h;
-				sum_q(lsf) = sum_q(lsf) + q;
-				sum_q_squared(lsf) = sum_q_squared(lsf) + q*q;
+				double qSums[2] = {q, q*q};
+#ifdef _PARALLEL_INTERPRETERS
+				if (parallel) {
+					double qLocal[2] = {q, q*q};
+					MPI_Allreduce(qLocal, qSums, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+					if (qSums[0] > 0.0)
+						failureHasOccured = true;
+				}
+#endif
+				sum_q(lsf) = sum_q(lsf) + qSums[0];
+				sum_q_squared(lsf) = sum_q_squared(lsf) + qSums[1];
 
 
 
@@ -454,7 +505,7 @@ ImportanceSamplingAnalysis::analyze(void)
 
 
 		// Print to the restart file, if requested. 
-		if (printFlag == 2) {
+		if (printFlag == 2 && (myid == 0 || !parallel)) {
 			ofstream outputFile( restartFileName, ios::out );
 			outputFile << k << endln;
 			outputFile << seed << endln;
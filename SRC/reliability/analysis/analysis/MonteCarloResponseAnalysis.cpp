@@ -132,6 +132,13 @@ int MonteCarloResponseAnalysis::analyze(){
 	ofstream resultsOutputFile( fileName, ios::out );
 
 
+	// A generator with streams draws the numbers of sample kk from stream
+	// kk, so a restart with the saved seed goes on with the same samples
+	bool hasStreams = theRandomNumberGenerator->setStream(0) == 0;
+	if (hasStreams && seed != 0)
+		theRandomNumberGenerator->setSeed(seed);
+
+
 
 	while( kk< numberOfSimulations){ // && govCov>targetCOV || k<=2) ) {
 
@@ -144,7 +151,11 @@ int MonteCarloResponseAnalysis::analyze(){
 
 		
 		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
+		if (hasStreams) {
+			theRandomNumberGenerator->setStream(kk);
+			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+		}
+		else if (isFirstSimulation) {
 			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
 		}
 		else {
@@ -296,6 +296,12 @@ int OrthogonalPlaneSamplingAnalysis::analyze(void)
 
 	bool isFirstSimulation = true;
 
+	// A generator with streams draws the numbers of sample k from stream
+	// k, so a restart with the saved seed goes on with the same samples
+	bool hasStreams = theRandomNumberGenerator->setStream(0) == 0;
+	if (hasStreams && seed != 0)
+		theRandomNumberGenerator->setSeed(seed);
+
 	while( (k<=numOfSimulations && cov>targetCOV || k<=2) ) {
 
 
@@ -322,7 +328,11 @@ int OrthogonalPlaneSamplingAnalysis::analyze(void)
 		// ---- step 1, simulate independent U_n ~ N(0,1)----
 		
 		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
+		if (hasStreams) {
+			theRandomNumberGenerator->setStream(k);
+			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+		}
+		else if (isFirstSimulation) {
 			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
 		}
 		else {
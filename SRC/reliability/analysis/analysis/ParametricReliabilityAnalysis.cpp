@@ -35,45 +35,60 @@
 #include <ReliabilityAnalysis.h>
 #include <ReliabilityDomain.h>
 #include <FindDesignPointAlgorithm.h>
-#include <GradientEvaluator.h>
-#include <ParameterPositioner.h>
-#include <NormalRV.h>
-#include <tcl.h>
+#include <RandomVariable.h>
+#include <LimitStateFunction.h>
 #include <LimitStateFunctionIter.h>
+#include <NormalRV.h>
+#include <Domain.h>
+#include <Parameter.h>
 #include <math.h>
+#include <stdio.h>
+#include <string.h>
 
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-using std::ifstream;
+using std::ofstream;
 using std::ios;
 using std::setw;
 using std::setprecision;
 using std::setiosflags;
 
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _OPS_PARAMETRIC_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+// results stored for each parameter value: beta, pf, steps, evaluations
+// and 1 if the design point was found
+#define PRA_NUM_RESULTS 5
+
 ParametricReliabilityAnalysis::ParametricReliabilityAnalysis(ReliabilityDomain *passedReliabilityDomain,
+									 Domain *passedStructuralDomain,
 									 FindDesignPointAlgorithm *passedFindDesignPointAlgorithm,
-									 GradientEvaluator *passedGradGEvaluator,
-									 int pParameterNumber,
+									 int pParameterTag,
 									 double pFirst,
 									 double pLast,
 									 int pNumIntervals,
-									 TCL_Char *passedFileName,
-									 Tcl_Interp *passedTclInterp)
+									 const char *passedFileName,
+									 int pNumWorkers,
+									 bool pWarmStart)
 :ReliabilityAnalysis()
 {
-	parameterNumber = pParameterNumber;
+	parameterTag = pParameterTag;
 	first = pFirst;
 	last = pLast;
 	numIntervals = pNumIntervals;
+	numWorkers = pNumWorkers;
+	warmStart = pWarmStart;
 
 	theReliabilityDomain = passedReliabilityDomain;
+	theStructuralDomain = passedStructuralDomain;
 	theFindDesignPointAlgorithm = passedFindDesignPointAlgorithm;
-	theGradGEvaluator = passedGradGEvaluator;
 
 	strcpy(fileName,passedFileName);
-
-	theTclInterp = passedTclInterp;
 }
 
 
@@ -83,6 +98,51 @@ ParametricReliabilityAnalysis::~ParametricReliabilityAnalysis()
 }
 
 
+int
+ParametricReliabilityAnalysis::analyzeRange(int start, int end, double *results)
+{
+	static NormalRV aStdNormRV(1,0.0,1.0);
+
+	Parameter *theParameter = theStructuralDomain->getParameter(parameterTag);
+	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
+
+	for (int counter=start; counter<end; counter++) {
+
+		double *res = &results[PRA_NUM_RESULTS*counter];
+		double currentValue = first + counter*(last-first)/numIntervals;
+
+		theParameter->update(currentValue);
+
+		if (theFindDesignPointAlgorithm->findDesignPoint() < 0) {
+			res[0] = 0.0;
+			res[1] = -1.0;
+			res[2] = theFindDesignPointAlgorithm->getNumberOfSteps();
+			res[3] = theFindDesignPointAlgorithm->getNumberOfEvaluations();
+			res[4] = 0.0;
+			continue;
+		}
+
+		const Vector &uStar = theFindDesignPointAlgorithm->get_u();
+		const Vector &alpha = theFindDesignPointAlgorithm->get_alpha();
+		double beta = alpha ^ uStar;
+
+		res[0] = beta;
+		res[1] = 1.0 - aStdNormRV.getCDFvalue(beta);
+		res[2] = theFindDesignPointAlgorithm->getNumberOfSteps();
+		res[3] = theFindDesignPointAlgorithm->getNumberOfEvaluations();
+		res[4] = 1.0;
+
+		// the next value is close, so is its design point
+		if (warmStart) {
+			const Vector &xStar = theFindDesignPointAlgorithm->get_x();
+			for (int i=0; i<numRV; i++)
+				theReliabilityDomain->getRandomVariablePtrFromIndex(i)->setStartValue(xStar(i));
+		}
+	}
+
+	return 0;
+}
+
 
 int 
 ParametricReliabilityAnalysis::analyze(void)
@@ -91,177 +151,187 @@ ParametricReliabilityAnalysis::analyze(void)
 	// Alert the user that the FORM analysis has started
 	opserr << "Fragility Analysis is running ... " << endln;
 
+	// runParametricReliabilityAnalysis output.out -par 1 -range 14.0 16.0 -numInt 10
 
-	// The relevant commands are now, for instance, given like this
-	// performanceFunction 1 "{par_1}-{u_7_1}"
-	// KRM note:	{par_1}  -->  \$par(1)
-	//				{u_7_1}  -->  \$u(7,1)
-	// runParametricReliabilityAnalysis output.out -par 1 -range 14.0 16.0 -num 10
-
+	Parameter *theParameter = theStructuralDomain->getParameter(parameterTag);
+	if (theParameter == 0) {
+		opserr << "ParametricReliabilityAnalysis::analyze() - parameter " << parameterTag
+			<< " does not exist" << endln;
+		return -1;
+	}
+	if (numIntervals < 1) {
+		opserr << "ParametricReliabilityAnalysis::analyze() - the number of intervals must be positive" << endln;
+		return -1;
+	}
 
 	// Open output file
 	ofstream outputFile( fileName, ios::out );
 
 
 	// Initial declarations
-	Vector pf(numIntervals+1);
-	Vector pdf(numIntervals+1);
-	static NormalRV aStdNormRV(1,0.0,1.0);
-	int numPars, numPos;
-	double thedGdPar = 0, currentValue, beta;
-	Vector currentValues(numIntervals+1);
-	ParameterPositioner *theParameterPositioner = 0;
+	int numValues = numIntervals+1;
+	double *results = new double[PRA_NUM_RESULTS*numValues];
+	Vector pdf(numValues);
+	double dx = (last-first)/numIntervals;
+
+	// everything is put back as it was after each limit-state function
+	double originalValue = theParameter->getValue();
+	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
+	Vector startValues(numRV);
+	for (int i=0; i<numRV; i++)
+		startValues(i) = theReliabilityDomain->getRandomVariablePtrFromIndex(i)->getStartValue();
+
+	int numChunks = numWorkers;
+	if (numChunks > numValues)
+		numChunks = numValues;
+	if (numChunks < 1)
+		numChunks = 1;
+#ifndef _OPS_PARAMETRIC_FORK
+	numChunks = 1;
+#endif
 
 	LimitStateFunctionIter lsfIter = theReliabilityDomain->getLimitStateFunctions();
 	LimitStateFunction *theLimitStateFunction;
 	// Loop over number of limit-state functions and perform FORM analysis
-	//for (lsf=1; lsf <= numLsf; lsf++ ) {
 	while ((theLimitStateFunction = lsfIter()) != 0) {
 		int lsf = theLimitStateFunction->getTag();
 
 		// Inform the user which limit-state function is being evaluated
 		opserr << "Limit-state function number: " << lsf << endln;
-		Tcl_SetVar2Ex(theTclInterp,"RELIABILITY_lsf",NULL,Tcl_NewIntObj(lsf),TCL_NAMESPACE_ONLY);
 
 		// Set tag of "active" limit-state function
 		theReliabilityDomain->setTagOfActiveLimitStateFunction(lsf);
 
-		// Print results to output file
-		outputFile << "#######################################################################" << endln;
-		outputFile << "#  FORM ANALYSIS RESULTS, LIMIT-STATE FUNCTION NUMBER "
-			<<setiosflags(ios::left)<<setprecision(1)<<setw(4)<<lsf <<"            #" << endln;
-		outputFile << "#                                                                     #" << endln;
-		outputFile << "#                                                                     #" << endln;
-		outputFile << "#                    Failure probability     Estimated probability    #" << endln;
-		outputFile << "#    Parameter       estimate (fragility)     density function        #" << endln;
-		outputFile << "#     value               (CDF)                    (PDF)              #" << endln;
-		outputFile.setf(ios::scientific, ios::floatfield);
-		outputFile.flush();
+		if (numChunks == 1)
+			this->analyzeRange(0, numValues, results);
 
-		// Detect parameter, first the case where the parameter is represented by a parameterPositioner
-		numPos = theReliabilityDomain->getNumberOfParameterPositioners();
-		if (numPos != 0) {
-			theParameterPositioner = theReliabilityDomain->getParameterPositionerPtr(parameterNumber);
-			if (theParameterPositioner == 0) {
-				opserr << "ParametricReliabilityAnalysis::analyze() -- The parameter number in the " << endln
-					<< " fragility analysis object does not match the parameter number " << endln
-					<< " being set by the parameter positioner." << endln;
-			}
-		}
-		
-		// Now when the original \$par(i) syntax is used
+#ifdef _OPS_PARAMETRIC_FORK
 		else {
-			
-			// check that par(i) exists in the LSF
-			int llength = 0;
-			int foundit = 0;
-			// This Tcl stuff should disappear -- MHS 10/7/2011
-			//Tcl_Obj *passedList = theLimitStateFunction->getParameters();
-			Tcl_Obj *passedList = 0; // Added by MHS 10/7/2011
-
-			Tcl_Obj *paramList = Tcl_DuplicateObj(passedList);
-			Tcl_Obj *objPtr;
-			Tcl_ListObjLength(theTclInterp,paramList,&llength);
-				
-			for (int jk = 0; jk < llength; jk++) {
-				Tcl_ListObjIndex(theTclInterp,paramList,jk,&objPtr);
-				char *listStr = Tcl_GetStringFromObj(objPtr,NULL);
-				
-				int tempNumber;
-				int args = sscanf(listStr,"par(%i)",&tempNumber);
-				if (args == 1 && tempNumber == parameterNumber)
-					foundit = 1;
-			}
-			
-			// reclaim Tcl object space
-			Tcl_DecrRefCount(paramList);
-			
-			if (foundit == 0) {
-				opserr << "ParametricReliabilityAnalysis::analyze() -- The parameter number " << endln
-									<< " in the limit-state function does not match the parameter " << endln
-									<< " number in the fragility analysis object." << endln;
-			}
-		}
-
-		// Range over parameter values
-		currentValue = first;
-		for (int counter=0; counter<(numIntervals+1); counter++) {
-
-			currentValues(counter) = currentValue;
-			
-			if (theParameterPositioner != 0) {
-				// Possibly set the parameter value in the FE domain
-				theParameterPositioner->update(currentValue);
-			}
-			else {
-				// set parameter value in Tcl domain
-				char theIndex[20];
-				sprintf(theIndex,"%d",parameterNumber);
-							
-				Tcl_Obj *outp = Tcl_SetVar2Ex(theTclInterp,"par",theIndex,Tcl_NewDoubleObj(currentValue),TCL_LEAVE_ERR_MSG);
-				if (outp == NULL) {
-					opserr << "ERROR ParametricReliabilityAnalysis -- error setting parameter with tag " << parameterNumber << endln;
-					opserr << theTclInterp->result << endln;
-					return -1;
+			// each worker does a contiguous chunk, so the warm starts
+			// still follow each other, and sends its results back
+			opserr.flush();
+			fflush(NULL);
+
+			pid_t *pids = new pid_t[numChunks];
+			int *fds = new int[numChunks];
+			int *starts = new int[numChunks+1];
+			for (int c=0; c<=numChunks; c++)
+				starts[c] = (c*numValues)/numChunks;
+
+			for (int c=0; c<numChunks; c++) {
+				int fd[2];
+				pids[c] = -1;
+				fds[c] = -1;
+				if (pipe(fd) != 0)
+					continue;
+
+				pid_t pid = fork();
+				if (pid == 0) {
+					close(fd[0]);
+					theStructuralDomain->releaseRecorders();
+
+					this->analyzeRange(starts[c], starts[c+1], results);
+
+					const char *data = (const char *)&results[PRA_NUM_RESULTS*starts[c]];
+					size_t numBytes = sizeof(double)*PRA_NUM_RESULTS*(starts[c+1]-starts[c]);
+					while (numBytes > 0) {
+						ssize_t numWritten = write(fd[1], data, numBytes);
+						if (numWritten <= 0)
+							break;
+						data += numWritten;
+						numBytes -= numWritten;
+					}
+					close(fd[1]);
+					opserr.flush();
+					fflush(NULL);
+					_exit(0);
 				}
-			}
 
-			// Find the design point
-			if (theFindDesignPointAlgorithm->findDesignPoint() < 0) {
-
-				// Set detectable 'crazy' values when the design point wasn't found
-				pf(counter) = -1.0;
-				pdf(counter) = -1.0;
+				close(fd[1]);
+				if (pid < 0)
+					close(fd[0]);
+				else {
+					pids[c] = pid;
+					fds[c] = fd[0];
+				}
 			}
-			else {
 
-				// Store probability of failure
-				const Vector &uStar				= theFindDesignPointAlgorithm->get_u();
-				const Vector &alpha				= theFindDesignPointAlgorithm->get_alpha();
-				beta = alpha ^ uStar;
-				pf(counter) = 1.0 - aStdNormRV.getCDFvalue(beta);
-
-				// Compute PDF, first; derivative of lsf wrt. parameter
-				// Needs to be retooled -- MHS 10/7/2011
-				//const Matrix &dGdPar = theGradGEvaluator->getDgDpar();
-				Matrix dGdPar(5,5); // So it will compile
-
-				// Find the right element
-				numPars = dGdPar.noRows();
-				for (int i=0; i<numPars; i++) {
-					if (((int)(dGdPar(i,0))) == parameterNumber) {
-						thedGdPar = dGdPar(i,1);
+			for (int c=0; c<numChunks; c++) {
+				char *data = (char *)&results[PRA_NUM_RESULTS*starts[c]];
+				size_t numBytes = sizeof(double)*PRA_NUM_RESULTS*(starts[c+1]-starts[c]);
+				if (fds[c] >= 0) {
+					while (numBytes > 0) {
+						ssize_t numRead = read(fds[c], data, numBytes);
+						if (numRead <= 0)
+							break;
+						data += numRead;
+						numBytes -= numRead;
 					}
+					close(fds[c]);
+					waitpid(pids[c], 0, 0);
 				}
 
-				// Gradient of limit-state function
-				const Vector &gradient = theFindDesignPointAlgorithm->getGradientInStandardNormalSpace();
-
-				// Compute PDF value
-				pdf(counter) = fabs( aStdNormRV.getPDFvalue(-beta) / gradient.Norm() * thedGdPar );
-
+				// a worker that could not be started, or did not finish,
+				// leaves its chunk to be done here
+				if (numBytes > 0) {
+					opserr << "ParametricReliabilityAnalysis::analyze() - worker " << c
+						<< " failed, its values are analyzed in this process" << endln;
+					this->analyzeRange(starts[c], starts[c+1], results);
+				}
 			}
 
-			currentValue = currentValue + (last-first)/numIntervals;
+			delete [] pids;
+			delete [] fds;
+			delete [] starts;
+		}
+#endif
+
+		// probability density from the slope of the fragility curve
+		for (int counter=0; counter<numValues; counter++) {
+			int lo = (counter > 0) ? counter-1 : counter;
+			int hi = (counter < numIntervals) ? counter+1 : counter;
+			double pfLo = results[PRA_NUM_RESULTS*lo+1];
+			double pfHi = results[PRA_NUM_RESULTS*hi+1];
+			if (hi == lo || pfLo < 0.0 || pfHi < 0.0)
+				pdf(counter) = -1.0;
+			else
+				pdf(counter) = fabs((pfHi-pfLo)/((hi-lo)*dx));
+		}
 
+		// Print results to output file
+		outputFile << "#######################################################################" << endln;
+		outputFile << "#  FORM ANALYSIS RESULTS, LIMIT-STATE FUNCTION NUMBER "
+			<<setiosflags(ios::left)<<setprecision(1)<<setw(4)<<lsf <<"            #" << endln;
+		outputFile << "#                                                                     #" << endln;
+		outputFile << "#                                                                     #" << endln;
+		outputFile << "#                    Failure probability     Estimated probability    #" << endln;
+		outputFile << "#    Parameter       estimate (fragility)     density function        #" << endln;
+		outputFile << "#     value               (CDF)                    (PDF)              #" << endln;
+		outputFile.setf(ios::scientific, ios::floatfield);
 
-			// Print results to output file
-			outputFile << "#   " << setprecision(3)<<setw(11)<<currentValues(counter)<<"         ";
-			if (pf(counter)==-1.0) {
+		for (int counter=0; counter<numValues; counter++) {
+			double *res = &results[PRA_NUM_RESULTS*counter];
+			outputFile << "#   " << setprecision(3)<<setw(11)<<first+counter*dx<<"         ";
+			if (res[4] == 0.0) {
 				outputFile << "--failed--              ";
 				outputFile << "--failed--            #" << endln;
 			}
 			else {
-				outputFile <<setprecision(3)<<setw(11)<<pf(counter)<<"             ";
-				outputFile <<setprecision(3)<<setw(11)<<pdf(counter)<<"           #" << endln;
+				outputFile <<setprecision(3)<<setw(11)<<res[1]<<"             ";
+				if (pdf(counter) < 0.0)
+					outputFile << "--failed--            #" << endln;
+				else
+					outputFile <<setprecision(3)<<setw(11)<<pdf(counter)<<"           #" << endln;
 			}
-			outputFile.flush();
-
-		} // Done looping over parameter range
-
+		}
 
 		outputFile << "#                                                                     #" << endln;
 		outputFile << "#######################################################################" << endln << endln << endln;
+		outputFile.flush();
+
+		theParameter->update(originalValue);
+		for (int i=0; i<numRV; i++)
+			theReliabilityDomain->getRandomVariablePtrFromIndex(i)->setStartValue(startValues(i));
 
 	} // Done looping over limit-state functions
 		
@@ -272,7 +342,7 @@ ParametricReliabilityAnalysis::analyze(void)
 
 	// Clean up
 	outputFile.close();
+	delete [] results;
 
 	return 0;
 }
-
@@ -37,25 +37,30 @@
 #include <ReliabilityAnalysis.h>
 #include <ReliabilityDomain.h>
 #include <FindDesignPointAlgorithm.h>
-#include <GradientEvaluator.h>
-#include <tcl.h>
+#include <Vector.h>
 
-#include <fstream>
-using std::ofstream;
+class Domain;
+
+// FORM analysis repeated over a range of values of a (deterministic)
+// parameter, giving the fragility curve of each limit-state function. The
+// design point found at one value is used as the start point at the next.
+// Where the process can be forked, the values are split in contiguous
+// chunks that are run at the same time by numWorkers copies of the process.
 
 class ParametricReliabilityAnalysis : public ReliabilityAnalysis
 {
 
 public:
 	ParametricReliabilityAnalysis(ReliabilityDomain *theReliabilityDomain,
+					  Domain *theStructuralDomain,
 					  FindDesignPointAlgorithm *theFindDesignPointAlgorithm,
-					  GradientEvaluator *theGradGEvaluator,
-					  int parameterNumber,
+					  int parameterTag,
 					  double first,
 					  double last,
 					  int numIntervals,
-					  TCL_Char *fileName,
-					  Tcl_Interp *theTclInterp);
+					  const char *fileName,
+					  int numWorkers = 1,
+					  bool warmStart = true);
 	virtual ~ParametricReliabilityAnalysis();
 
 	int analyze(void);
@@ -63,13 +68,16 @@ public:
 protected:
 
 private:
+	int analyzeRange(int start, int end, double *results);
+
 	ReliabilityDomain *theReliabilityDomain;
+	Domain *theStructuralDomain;
 	FindDesignPointAlgorithm *theFindDesignPointAlgorithm;
-	GradientEvaluator *theGradGEvaluator;
 	char fileName[256];
 	double first, last;
-	int parameterNumber, numIntervals;
-	Tcl_Interp *theTclInterp;
+	int parameterTag, numIntervals;
+	int numWorkers;
+	bool warmStart;
 };
 
 #endif
@@ -39,15 +39,32 @@
 #include <LimitStateFunction.h>
 #include <ReliabilityDomain.h>
 #include <Vector.h>
+#include <Parameter.h>
+#include <RandomVariable.h>
 #include <string.h>
+#include <math.h>
+#include <float.h>
+
+#ifdef _PARALLEL_INTERPRETERS
+#include <mpi.h>
+#endif
+
+// number of times a step whose analysis fails is halved
+#define FD_MAX_STEP_HALVINGS 4
+
+// relative noise assumed in the limit-state function when the step is
+// chosen automatically, that of a converged nonlinear analysis
+#define FD_FUNCTION_NOISE 1.0e-10
 
 FiniteDifferenceGradient::FiniteDifferenceGradient(
     FunctionEvaluator *passedGFunEvaluator,
     ReliabilityDomain *passedReliabilityDomain,
-    Domain *passedOpenSeesDomain)
+    Domain *passedOpenSeesDomain, int passedScheme, bool passedAutoStep,
+    bool passedDistributed)
 
     : GradientEvaluator(passedReliabilityDomain, passedGFunEvaluator),
-      theOpenSeesDomain(passedOpenSeesDomain) {
+      theOpenSeesDomain(passedOpenSeesDomain), scheme(passedScheme),
+      autoStep(passedAutoStep), distributed(passedDistributed) {
     int nrv = passedReliabilityDomain->getNumberOfRandomVariables();
     grad_g = new Vector(nrv);
 }
@@ -77,64 +94,150 @@ int FiniteDifferenceGradient::computeGradient(double g) {
     // get RVs created in the reliability domain
     int nrv = this->theReliabilityDomain->getNumberOfRandomVariables();
 
+    // when distributed with parallel interpreters each process perturbs
+    // every numProcs-th RV, the perturbed analyses are independent of each
+    // other; all the processes must then run the same model
+    int myid = 0;
+    int numProcs = 1;
+#ifdef _PARALLEL_INTERPRETERS
+    if (distributed) {
+        MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+        MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+    }
+#endif
+
     // now loop through to create gradient vector
     // for all RVs
-    for (int i = 0; i < nrv; i++) {
-        // get RV
-        auto *theRV =
-            this->theReliabilityDomain->getRandomVariablePtrFromIndex(i);
-        if (theRV == 0) {
-            opserr << "ERROR: can't get RV " << i
-                   << " -- FiniteDifferenceGradient::computeGradient\n";
-            return -1;
-        }
+    int result = 0;
+    for (int i = myid; i < nrv && result == 0; i += numProcs)
+        result = this->computeDerivative(i, g, lsfExpression, (*grad_g)(i));
+
+#ifdef _PARALLEL_INTERPRETERS
+    if (numProcs > 1) {
+        // sum the derivatives of all processes, the last entry counts
+        // the processes that failed
+        Vector local(nrv + 1);
+        Vector global(nrv + 1);
+        for (int i = 0; i < nrv; i++)
+            local(i) = (*grad_g)(i);
+        local(nrv) = (result < 0) ? 1.0 : 0.0;
+
+        MPI_Allreduce(&local(0), &global(0), nrv + 1, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+
+        for (int i = 0; i < nrv; i++)
+            (*grad_g)(i) = global(i);
+        result = (global(nrv) > 0.0) ? -1 : 0;
+    }
+#endif
 
-        // get RV parameter
-        int param_indx =
-            theReliabilityDomain->getParameterIndexFromRandomVariableIndex(
-                i);
-
-        auto *theParam =
-            theOpenSeesDomain->getParameterFromIndex(param_indx);
-        if (theParam == 0) {
-            opserr << "ERROR: can't get param " << i
-                   << " -- FiniteDifferenceGradient::computeGradient\n";
-            return -1;
-        }
+    return result;
+}
 
-        // use parameter defined perturbation
-        double h = theParam->getPerturbation();
-        double original = theParam->getValue();
-        theParam->update(original + h);
-
-        // set perturbed values in the variable namespace
-        if (theFunctionEvaluator->setVariables() < 0) {
-            opserr << "ERROR FiniteDifferenceGradient -- error "
-                      "setting variables in namespace"
-                   << endln;
-            theParam->update(original);
-            return -1;
-        }
+int FiniteDifferenceGradient::computeDerivative(int i, double g,
+                                                const char *lsfExpression,
+                                                double &dgdx) {
+    // get RV
+    auto *theRV = this->theReliabilityDomain->getRandomVariablePtrFromIndex(i);
+    if (theRV == 0) {
+        opserr << "ERROR: can't get RV " << i
+               << " -- FiniteDifferenceGradient::computeGradient\n";
+        return -1;
+    }
+
+    // get RV parameter
+    int param_indx =
+        theReliabilityDomain->getParameterIndexFromRandomVariableIndex(i);
+
+    auto *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
+    if (theParam == 0) {
+        opserr << "ERROR: can't get param " << i
+               << " -- FiniteDifferenceGradient::computeGradient\n";
+        return -1;
+    }
 
-        // run analysis
-        if (theFunctionEvaluator->runAnalysis() < 0) {
-            opserr << "ERROR FiniteDifferenceGradient -- error "
-                      "running analysis"
-                   << endln;
-            theParam->update(original);
-            return -1;
+    // use parameter defined perturbation
+    double h = theParam->getPerturbation();
+    double original = theParam->getValue();
+
+    // or balance truncation against the noise in g: sqrt(noise) for the
+    // one-sided schemes, cbrt(noise) for the central one, relative to
+    // the larger of the value and the standard deviation of the RV
+    if (autoStep) {
+        double scale = fabs(original);
+        double stdv = theRV->getStdv();
+        if (stdv > scale)
+            scale = stdv;
+        if (scale > 0.0) {
+            if (scheme == Central)
+                h = cbrt(FD_FUNCTION_NOISE) * scale;
+            else
+                h = sqrt(FD_FUNCTION_NOISE) * scale;
         }
+    }
 
-        // evaluate LSF and obtain result
-        theFunctionEvaluator->setExpression(lsfExpression);
+    for (int k = 0; k <= FD_MAX_STEP_HALVINGS; k++) {
+        double gPlus = g;
+        double gMinus = g;
+        int ok = 0;
 
-        // perturbed lsf
-        double g_perturbed = theFunctionEvaluator->evaluateExpression();
-        (*grad_g)(i) = (g_perturbed - g) / h;
+        if (scheme != Backward)
+            ok = this->evaluatePerturbed(theParam, original + h,
+                                         lsfExpression, gPlus);
+        if (ok == 0 && scheme != Forward)
+            ok = this->evaluatePerturbed(theParam, original - h,
+                                         lsfExpression, gMinus);
 
         // return parameter values to previous state
         theParam->update(original);
+
+        if (ok == 0) {
+            if (scheme == Central)
+                dgdx = (gPlus - gMinus) / (2.0 * h);
+            else
+                dgdx = (gPlus - gMinus) / h;
+            return 0;
+        }
+
+        if (k < FD_MAX_STEP_HALVINGS) {
+            opserr << "WARNING FiniteDifferenceGradient -- analysis failed "
+                      "for RV " << theRV->getTag()
+                   << ", trying half the perturbation" << endln;
+            h *= 0.5;
+        }
     }
 
+    opserr << "ERROR FiniteDifferenceGradient -- error "
+              "running analysis"
+           << endln;
+    return -1;
+}
+
+// sets the parameter to value, runs the analysis and evaluates the
+// limit-state function, the caller restores the parameter
+int FiniteDifferenceGradient::evaluatePerturbed(Parameter *theParam,
+                                                double value,
+                                                const char *lsfExpression,
+                                                double &gValue) {
+    theParam->update(value);
+
+    // set perturbed values in the variable namespace
+    if (theFunctionEvaluator->setVariables() < 0) {
+        opserr << "ERROR FiniteDifferenceGradient -- error "
+                  "setting variables in namespace"
+               << endln;
+        return -1;
+    }
+
+    // run analysis
+    if (theFunctionEvaluator->runAnalysis() < 0)
+        return -1;
+
+    // evaluate LSF and obtain result
+    theFunctionEvaluator->setExpression(lsfExpression);
+
+    // perturbed lsf
+    gValue = theFunctionEvaluator->evaluateExpression();
+
     return 0;
 }
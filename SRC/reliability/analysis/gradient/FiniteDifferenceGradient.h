@@ -41,13 +41,25 @@
 #include <Domain.h>
 #include <FunctionEvaluator.h>
 
+class Parameter;
+
+// The derivatives are forward, backward or central differences. The step
+// is the perturbation of the parameter or, with autoStep, one scaled to
+// the value of the random variable and the scheme. A step whose analysis
+// fails is halved and tried again. With distributed and parallel
+// interpreters the random variables are divided among the processes,
+// which must all compute the gradient of the same model.
 class FiniteDifferenceGradient : public GradientEvaluator
 {
 	
 public:
+	enum { Forward = 0, Backward = 1, Central = 2 };
+
 	FiniteDifferenceGradient(FunctionEvaluator *passedGFunEvaluator,
 				 ReliabilityDomain *passedReliabilityDomain,
-				 Domain *passedOpenSeesDomain);
+				 Domain *passedOpenSeesDomain,
+				 int scheme = Forward, bool autoStep = false,
+				 bool distributed = false);
 	~FiniteDifferenceGradient();
 	
 	int		computeGradient(double gFunValue);
@@ -56,8 +68,16 @@ public:
 protected:
 	
 private:
+	int computeDerivative(int rvIndex, double g, const char *lsfExpression,
+			      double &dgdx);
+	int evaluatePerturbed(Parameter *theParam, double value,
+			      const char *lsfExpression, double &gValue);
+
 	Domain *theOpenSeesDomain;
 	Vector *grad_g;
+	int scheme;
+	bool autoStep;
+	bool distributed;
 	
 };
 
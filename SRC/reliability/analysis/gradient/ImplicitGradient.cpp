@@ -77,6 +77,29 @@ int ImplicitGradient::computeGradient(double g) {
     // get RVs created in the reliability domain
     int nrv = this->theReliabilityDomain->getNumberOfRandomVariables();
 
+    // the gradient expressions not provided are differentiated by the
+    // evaluator, if it can
+    bool haveAllExpressions = true;
+    for (int i = 0; i < nrv; i++) {
+        auto *theRV =
+            this->theReliabilityDomain->getRandomVariablePtrFromIndex(i);
+        if (theRV != 0 &&
+            theLimitStateFunction->getGradientExpression(theRV->getTag()) == 0)
+            haveAllExpressions = false;
+    }
+    Vector dgdx(nrv);
+    bool haveDerivative = false;
+    if (!haveAllExpressions) {
+        theFunctionEvaluator->setExpression(lsfExpression);
+        if (theFunctionEvaluator->setVariables() < 0) {
+            opserr << "ERROR ImplicitGradient -- error setting "
+                      "variables in namespace"
+                   << endln;
+            return -1;
+        }
+        haveDerivative = theFunctionEvaluator->evaluateGradient(dgdx) == 0;
+    }
+
     // first check for dg/dimplicit partials
     for (int i = 0; i < nrv; i++) {
         // get RV
@@ -95,6 +118,11 @@ int ImplicitGradient::computeGradient(double g) {
         const char *gradExpression =
             theLimitStateFunction->getGradientExpression(rvTag);
 
+        if (gradExpression == 0 && haveDerivative) {
+            (*grad_g)(i) = dgdx(i);
+            continue;
+        }
+
         // not provided means zero
         if (gradExpression == 0) {
             opserr
@@ -0,0 +1,208 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+#include <PhiloxRandGenerator.h>
+#include <NormalRV.h>
+#include <Vector.h>
+#include <time.h>
+#include <stdint.h>
+
+
+// one block of 4 32-bit words of Philox4x32 with 10 rounds
+static void
+philox4x32(uint32_t key0, uint32_t key1, uint32_t ctr[4])
+{
+	const uint32_t M0 = 0xD2511F53;
+	const uint32_t M1 = 0xCD9E8D57;
+	const uint32_t W0 = 0x9E3779B9;
+	const uint32_t W1 = 0xBB67AE85;
+
+	for (int r=0; r<10; r++) {
+		uint64_t p0 = (uint64_t)M0*ctr[0];
+		uint64_t p1 = (uint64_t)M1*ctr[2];
+		uint32_t c0 = (uint32_t)(p1 >> 32) ^ ctr[1] ^ key0;
+		uint32_t c2 = (uint32_t)(p0 >> 32) ^ ctr[3] ^ key1;
+		ctr[0] = c0;
+		ctr[1] = (uint32_t)p1;
+		ctr[2] = c2;
+		ctr[3] = (uint32_t)p0;
+		key0 += W0;
+		key1 += W1;
+	}
+}
+
+
+void
+PhiloxRandGenerator::getUniformNumbers(unsigned int seed, unsigned long long stream,
+				       unsigned long long position, int n, double *u)
+{
+	// each block gives two numbers with 53 random bits, shifted to be
+	// strictly inside (0,1)
+	const double scale = 1.0/9007199254740992.0;
+
+	unsigned long long block = position/2;
+	int j = 0;
+	while (j < n) {
+		uint32_t ctr[4] = {(uint32_t)block, (uint32_t)(block >> 32),
+				   (uint32_t)stream, (uint32_t)(stream >> 32)};
+		philox4x32(seed, 0x2545F491, ctr);
+
+		for (int half = (j == 0) ? (int)(position%2) : 0; half < 2 && j < n; half++, j++) {
+			uint64_t bits = ((uint64_t)ctr[2*half] << 32) | ctr[2*half+1];
+			u[j] = ((bits >> 11) + 0.5)*scale;
+		}
+		block++;
+	}
+}
+
+
+PhiloxRandGenerator::PhiloxRandGenerator()
+:RandomNumberGenerator(), generatedNumbers(0), seed(0), stream(0), position(0)
+{
+	setSeed(0);
+}
+
+
+PhiloxRandGenerator::~PhiloxRandGenerator()
+{
+	if (generatedNumbers != 0)
+		delete generatedNumbers;
+}
+
+
+double
+PhiloxRandGenerator::nextUniform(void)
+{
+	double u;
+	getUniformNumbers(seed, stream, position, 1, &u);
+	position++;
+	return u;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentUniformNumbers(int n, double lower, double upper, int seedIn)
+{
+	if (seedIn != 0)
+		setSeed(seedIn);
+
+	if (generatedNumbers == 0) {
+		generatedNumbers = new Vector(n);
+	}
+	else if (generatedNumbers->Size() != n) {
+		delete generatedNumbers;
+		generatedNumbers = new Vector(n);
+	}
+	Vector &randomArray = *generatedNumbers;
+
+	if (n > 0) {
+		getUniformNumbers(seed, stream, position, n, &randomArray(0));
+		position += n;
+	}
+	for (int j=0; j<n; j++)
+		randomArray(j) = (upper-lower)*randomArray(j) + lower;
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentStdNormalNumbers(int n, int seedIn)
+{
+	if (seedIn != 0)
+		setSeed(seedIn);
+
+	if (generatedNumbers == 0) {
+		generatedNumbers = new Vector(n);
+	}
+	else if (generatedNumbers->Size() != n) {
+		delete generatedNumbers;
+		generatedNumbers = new Vector(n);
+	}
+	Vector &randomArray = *generatedNumbers;
+
+	if (n > 0) {
+		getUniformNumbers(seed, stream, position, n, &randomArray(0));
+		position += n;
+	}
+
+	// z = invPhi(u), u is never exactly 0 or 1
+	static NormalRV uRV(1, 0.0, 1.0);
+	for (int j=0; j<n; j++)
+		randomArray(j) = uRV.getInverseCDFvalue(randomArray(j));
+
+	return 0;
+}
+
+
+const Vector&
+PhiloxRandGenerator::getGeneratedNumbers()
+{
+	return (*generatedNumbers);
+}
+
+
+int
+PhiloxRandGenerator::getSeed()
+{
+	return seed;
+}
+
+
+void
+PhiloxRandGenerator::setSeed(int passedSeed)
+{
+	if (passedSeed != 0)
+		seed = passedSeed;
+	else
+		seed = time(NULL);
+
+	stream = 0;
+	position = 0;
+}
+
+
+int
+PhiloxRandGenerator::setStream(long passedStream)
+{
+	stream = passedStream;
+	position = 0;
+
+	return 0;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleUniformNumber(double lower, double upper)
+{
+	return (upper-lower)*nextUniform() + lower;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleStdNormalNumber(void)
+{
+	static NormalRV uRV(1, 0.0, 1.0);
+	return uRV.getInverseCDFvalue(nextUniform());
+}
@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef PhiloxRandGenerator_h
+#define PhiloxRandGenerator_h
+
+// Description: PhiloxRandGenerator is a counter-based random number
+// generator (Philox4x32-10, Salmon et al. 2011). The numbers are a pure
+// function of the seed, a stream number and the position in the stream,
+// so any stream can be regenerated without drawing the ones before it.
+// The sampling analyses use the sample number as the stream, which makes
+// each sample reproducible whatever the order or the process it is
+// evaluated on.
+
+#include <RandomNumberGenerator.h>
+#include <Vector.h>
+
+class PhiloxRandGenerator : public RandomNumberGenerator
+{
+
+public:
+	PhiloxRandGenerator();
+	~PhiloxRandGenerator();
+
+	int		generate_nIndependentStdNormalNumbers(int n, int seed=0);
+	int     generate_nIndependentUniformNumbers(int n, double lower, double upper, int seed=0);
+	const   Vector& getGeneratedNumbers();
+	int     getSeed();
+
+ 	double  generate_singleStdNormalNumber();
+ 	double  generate_singleUniformNumber(double lower=0.0, double upper=1.0);
+ 	void    setSeed(int passedSeed=0);
+
+	int     setStream(long stream);
+
+	// the uniform numbers position, ..., position+n-1 in (0,1) of a
+	// stream, without changing the state of a generator
+	static void getUniformNumbers(unsigned int seed, unsigned long long stream,
+				      unsigned long long position, int n, double *u);
+
+protected:
+
+private:
+	double nextUniform(void);
+
+	Vector *generatedNumbers;
+	int seed;
+	unsigned long long stream;
+	unsigned long long position;
+
+};
+
+#endif
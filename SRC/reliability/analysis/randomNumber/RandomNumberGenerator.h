@@ -53,6 +53,10 @@ public:
 	virtual double  generate_singleUniformNumber(double lower=0.0, double upper=1.0)=0;		
 	virtual void setSeed(int)=0;
 
+	// restart the numbers at the beginning of stream number 'stream';
+	// returns -1 if the generator has a single stream
+	virtual int setStream(long stream) {return -1;}
+
 
 protected:
 
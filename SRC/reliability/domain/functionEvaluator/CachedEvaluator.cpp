@@ -0,0 +1,462 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// CachedEvaluator.
+
+#include <CachedEvaluator.h>
+#include <ReliabilityDomain.h>
+#include <RandomVariable.h>
+#include <LimitStateFunction.h>
+#include <Domain.h>
+#include <Parameter.h>
+#include <Vector.h>
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+
+CachedEvaluator::CachedEvaluator(ReliabilityDomain *passedReliabilityDomain,
+				 Domain *passedOpenSeesDomain,
+				 FunctionEvaluator *passedModelEvaluator,
+				 double passedTol,
+				 int passedMaxPoints)
+  :FunctionEvaluator(), theReliabilityDomain(passedReliabilityDomain),
+   theOpenSeesDomain(passedOpenSeesDomain), theModelEvaluator(passedModelEvaluator),
+   currentPoint(-1), analyzedPoint(-1),
+   tol(passedTol), maxPoints(passedMaxPoints),
+   surrogate(false), errorTol(0.0), lengthScale(1.0), minPoints(0), gScale(0.0)
+{
+  if (maxPoints < 1)
+    maxPoints = 1;
+}
+
+
+CachedEvaluator::~CachedEvaluator()
+{
+  if (theModelEvaluator != 0)
+    delete theModelEvaluator;
+}
+
+
+int
+CachedEvaluator::setSurrogate(double passedErrorTol, double passedLengthScale, int passedMinPoints)
+{
+  if (passedErrorTol <= 0.0 || passedLengthScale <= 0.0) {
+    opserr << "WARNING CachedEvaluator::setSurrogate - errorTol and lengthScale must be positive\n";
+    return -1;
+  }
+
+  surrogate = true;
+  errorTol = passedErrorTol;
+  lengthScale = passedLengthScale;
+  minPoints = passedMinPoints;
+
+  return 0;
+}
+
+
+// int formKey(std::vector<double> &key);
+//	the values of the parameters, those of the random variables divided by
+//	their standard deviation so that the distances are in standard deviations
+int
+CachedEvaluator::formKey(std::vector<double> &key)
+{
+  int nparam = theOpenSeesDomain->getNumParameters();
+  key.resize(nparam);
+  isRV.resize(nparam);
+  scale.resize(nparam);
+
+  for (int j = 0; j < nparam; j++) {
+    Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(j);
+    double stdv = 0.0;
+    if (strcmp(theParam->getType(), "RandomVariable") == 0) {
+      RandomVariable *theRV = theReliabilityDomain->getRandomVariablePtr(theParam->getPointerTag());
+      if (theRV != 0)
+	stdv = theRV->getStdv();
+    }
+    isRV[j] = stdv > 0.0;
+    scale[j] = stdv > 0.0 ? stdv : 1.0;
+    key[j] = theParam->getValue()/scale[j];
+  }
+
+  return 0;
+}
+
+
+int
+CachedEvaluator::findPoint(const std::vector<double> &key)
+{
+  int n = key.size();
+
+  // the most recent points are the likeliest to be revisited
+  for (int i = (int)thePoints.size()-1; i >= 0; i--) {
+    const std::vector<double> &other = thePoints[i].key;
+    if ((int)other.size() != n)
+      continue;
+    double d2 = 0.0;
+    bool same = true;
+    for (int j = 0; j < n && same; j++) {
+      double d = key[j] - other[j];
+      if (isRV[j])
+	d2 += d*d;
+      else
+	same = fabs(d) <= tol*std::max(fabs(key[j]), fabs(other[j]));
+    }
+    if (same && d2 <= tol*tol)
+      return i;
+  }
+
+  return -1;
+}
+
+
+int
+CachedEvaluator::addPoint(const std::vector<double> &key)
+{
+  // the oldest point makes room for the new one
+  if ((int)thePoints.size() >= maxPoints) {
+    thePoints.erase(thePoints.begin());
+    currentPoint = currentPoint > 0 ? currentPoint-1 : -1;
+    analyzedPoint = analyzedPoint > 0 ? analyzedPoint-1 : -1;
+  }
+
+  CachedPoint thePoint;
+  thePoint.key = key;
+  thePoint.predicted = false;
+  thePoint.prediction = 0.0;
+  thePoints.push_back(thePoint);
+
+  return thePoints.size()-1;
+}
+
+
+int
+CachedEvaluator::analyze(void)
+{
+  analyzedPoint = -1;
+
+  if (theModelEvaluator->setVariables() < 0)
+    return -1;
+  if (theModelEvaluator->runAnalysis() < 0)
+    return -1;
+
+  analyzedPoint = currentPoint;
+  return 0;
+}
+
+
+bool
+CachedEvaluator::isLimitStateFunction(void)
+{
+  int lsfTag = theReliabilityDomain->getTagOfActiveLimitStateFunction();
+  LimitStateFunction *theLSF = theReliabilityDomain->getLimitStateFunctionPtr(lsfTag);
+  if (theLSF == 0 || theLSF->getExpression() == 0)
+    return false;
+
+  return theExpression == theLSF->getExpression();
+}
+
+
+// bool predict(const std::vector<double> &key, double &g);
+//	the limit-state function at key by simple kriging over the nearest
+//	points analyzed with the same values of the other parameters, with a
+//	squared exponential covariance of lengthScale standard deviations. True
+//	if the standard deviation of the prediction is within the tolerance.
+bool
+CachedEvaluator::predict(const std::vector<double> &key, double &g)
+{
+  if (gScale == 0.0 || !this->isLimitStateFunction())
+    return false;
+
+  int n = key.size();
+  int nrv = 0;
+  for (int j = 0; j < n; j++)
+    nrv += isRV[j];
+  int minNeeded = minPoints > 0 ? minPoints : nrv+2;
+
+  // the analyzed points, nearest first
+  std::vector<std::pair<double, int> > near;
+  std::vector<double> y(thePoints.size());
+  for (size_t i = 0; i < thePoints.size(); i++) {
+    const CachedPoint &thePoint = thePoints[i];
+    if ((int)thePoint.key.size() != n)
+      continue;
+    int k = 0;
+    int numExpr = thePoint.expressions.size();
+    while (k < numExpr && thePoint.expressions[k] != theExpression)
+      k++;
+    if (k == numExpr)
+      continue;
+    double d2 = 0.0;
+    bool same = true;
+    for (int j = 0; j < n && same; j++) {
+      double d = key[j] - thePoint.key[j];
+      if (isRV[j])
+	d2 += d*d;
+      else
+	same = d == 0.0;
+    }
+    if (same) {
+      near.push_back(std::make_pair(d2, (int)i));
+      y[i] = thePoint.values[k];
+    }
+  }
+
+  int m = near.size();
+  if (m < minNeeded)
+    return false;
+  int maxNear = std::max(2*minNeeded, 10);
+  if (m > maxNear) {
+    std::partial_sort(near.begin(), near.begin()+maxNear, near.end());
+    m = maxNear;
+  }
+
+  std::vector<const std::vector<double> *> x(m);
+  std::vector<double> ym(m);
+  for (int l = 0; l < m; l++) {
+    x[l] = &thePoints[near[l].second].key;
+    ym[l] = y[near[l].second];
+  }
+
+  double mean = 0.0;
+  for (int l = 0; l < m; l++)
+    mean += ym[l];
+  mean /= m;
+  double var = 0.0;
+  for (int l = 0; l < m; l++)
+    var += (ym[l]-mean)*(ym[l]-mean);
+  var /= m;
+  if (var <= 1.0e-14*gScale*gScale)
+    var = 1.0e-14*gScale*gScale;
+
+  // covariances & their Cholesky factor, with a small nugget
+  double twoL2 = 2.0*lengthScale*lengthScale;
+  std::vector<double> K(m*m);
+  std::vector<double> k0(m);
+  for (int a = 0; a < m; a++) {
+    for (int b = 0; b <= a; b++) {
+      double d2 = 0.0;
+      for (int j = 0; j < n; j++)
+	if (isRV[j]) {
+	  double d = (*x[a])[j] - (*x[b])[j];
+	  d2 += d*d;
+	}
+      K[a*m+b] = var*exp(-d2/twoL2);
+    }
+    K[a*m+a] += 1.0e-10*var;
+    k0[a] = var*exp(-near[a].first/twoL2);
+  }
+  for (int a = 0; a < m; a++) {
+    for (int b = 0; b <= a; b++) {
+      double sum = K[a*m+b];
+      for (int c = 0; c < b; c++)
+	sum -= K[a*m+c]*K[b*m+c];
+      if (a == b) {
+	if (sum <= 0.0)
+	  return false;
+	K[a*m+a] = sqrt(sum);
+      }
+      else
+	K[a*m+b] = sum/K[b*m+b];
+    }
+  }
+
+  // L z = k0 gives the variance, L L^T alpha = y - mean the mean
+  std::vector<double> z(m), w(m);
+  for (int a = 0; a < m; a++) {
+    double sz = k0[a];
+    double sw = ym[a] - mean;
+    for (int c = 0; c < a; c++) {
+      sz -= K[a*m+c]*z[c];
+      sw -= K[a*m+c]*w[c];
+    }
+    z[a] = sz/K[a*m+a];
+    w[a] = sw/K[a*m+a];
+  }
+  double predVar = var;
+  double predMean = mean;
+  for (int a = 0; a < m; a++) {
+    predVar -= z[a]*z[a];
+    predMean += z[a]*w[a];
+  }
+
+  if (predVar < 0.0)
+    predVar = 0.0;
+  if (sqrt(predVar) > errorTol*gScale)
+    return false;
+
+  g = predMean;
+  return true;
+}
+
+
+int
+CachedEvaluator::setVariables(void)
+{
+  // the parameters may have moved since the last analysis
+  if (currentPoint >= 0) {
+    std::vector<double> key;
+    this->formKey(key);
+    if (this->findPoint(key) != currentPoint)
+      currentPoint = -1;
+  }
+
+  return theModelEvaluator->setVariables();
+}
+
+
+int
+CachedEvaluator::setExpression(const char *passedExpression)
+{
+  theExpression = passedExpression;
+  return theModelEvaluator->setExpression(passedExpression);
+}
+
+
+int
+CachedEvaluator::addToExpression(const char *in)
+{
+  return theModelEvaluator->addToExpression(in);
+}
+
+
+double
+CachedEvaluator::evaluateExpression(void)
+{
+  this->incrementEvaluations();
+
+  // not at a point of runAnalysis(), evaluated as it is
+  if (currentPoint < 0)
+    return theModelEvaluator->evaluateExpression();
+
+  CachedPoint &thePoint = thePoints[currentPoint];
+  for (size_t k = 0; k < thePoint.expressions.size(); k++)
+    if (thePoint.expressions[k] == theExpression)
+      return thePoint.values[k];
+
+  bool isLSF = this->isLimitStateFunction();
+  if (thePoint.predicted && isLSF)
+    return thePoint.prediction;
+
+  // a new expression at this point, the model is analyzed here if it is not
+  if (analyzedPoint != currentPoint) {
+    if (this->analyze() < 0) {
+      opserr << "ERROR CachedEvaluator -- error running analysis" << endln;
+      return -1;
+    }
+  }
+
+  double value = theModelEvaluator->evaluateExpression();
+  thePoint.expressions.push_back(theExpression);
+  thePoint.values.push_back(value);
+
+  if (isLSF && gScale == 0.0)
+    gScale = value != 0.0 ? fabs(value) : 1.0;
+
+  return value;
+}
+
+
+int
+CachedEvaluator::evaluateGradient(Vector &grad)
+{
+  // the gradient needs the sensitivities of the model at this point
+  if (currentPoint >= 0 && analyzedPoint != currentPoint) {
+    if (this->analyze() < 0)
+      return -1;
+  }
+
+  return theModelEvaluator->evaluateGradient(grad);
+}
+
+
+int
+CachedEvaluator::runAnalysis(void)
+{
+  std::vector<double> key;
+  this->formKey(key);
+
+  int i = this->findPoint(key);
+  if (i >= 0) {
+    currentPoint = i;
+    return 0;
+  }
+
+  currentPoint = this->addPoint(key);
+
+  // the analysis is left until an expression not predicted needs it
+  double g;
+  if (surrogate && this->predict(key, g)) {
+    thePoints[currentPoint].predicted = true;
+    thePoints[currentPoint].prediction = g;
+    return 0;
+  }
+
+  return this->analyze();
+}
+
+
+int
+CachedEvaluator::setResponseVariable(const char *label, int lsfTag,
+				     int rvTag, double value)
+{
+  return theModelEvaluator->setResponseVariable(label, lsfTag, rvTag, value);
+}
+
+
+int
+CachedEvaluator::setResponseVariable(const char *label, int lsfTag, double value)
+{
+  return theModelEvaluator->setResponseVariable(label, lsfTag, value);
+}
+
+
+double
+CachedEvaluator::getResponseVariable(const char *label, int lsfTag, int rvTag)
+{
+  return theModelEvaluator->getResponseVariable(label, lsfTag, rvTag);
+}
+
+
+double
+CachedEvaluator::getResponseVariable(const char *label, int lsfTag)
+{
+  return theModelEvaluator->getResponseVariable(label, lsfTag);
+}
+
+
+void
+CachedEvaluator::setNsteps(int nsteps)
+{
+  theModelEvaluator->setNsteps(nsteps);
+}
+
+
+double
+CachedEvaluator::getDt()
+{
+  return theModelEvaluator->getDt();
+}
@@ -0,0 +1,118 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// CachedEvaluator. A CachedEvaluator wraps the evaluator of the model and
+// remembers the expressions it evaluated at each point, the values of the
+// parameters. An analysis at a point seen before is skipped and the values
+// are given from the cache; the model is analyzed again only for an
+// expression not evaluated there yet. Points within a relative distance
+// tol of each other, in standard deviations of the random variables, are
+// the same point.
+//
+// Optionally the limit-state function is also predicted by a Gaussian
+// process fit to the values of the nearest points analyzed. When the
+// standard deviation of the prediction is below errorTol times |g| at the
+// first point, the analysis is skipped and the prediction is used.
+
+#ifndef CachedEvaluator_h
+#define CachedEvaluator_h
+
+#include <FunctionEvaluator.h>
+#include <vector>
+#include <string>
+
+class Domain;
+class ReliabilityDomain;
+
+class CachedEvaluator : public FunctionEvaluator
+{
+ public:
+  CachedEvaluator(ReliabilityDomain *passedReliabilityDomain,
+		  Domain *passedOpenSeesDomain,
+		  FunctionEvaluator *theModelEvaluator,
+		  double tol = 0.0,
+		  int maxPoints = 1000);
+  ~CachedEvaluator();
+
+  // predict the limit-state function where the surrogate is confident
+  int setSurrogate(double errorTol, double lengthScale = 1.0, int minPoints = 0);
+
+  int setVariables(void);
+  int setExpression(const char *expression);
+  int addToExpression(const char *expression);
+
+  double evaluateExpression(void);
+  int evaluateGradient(Vector &grad);
+  int runAnalysis(void);
+
+  int setResponseVariable(const char *label, int lsfTag,
+			  int rvTag, double value);
+  int setResponseVariable(const char *label, int lsfTag, double value);
+  double getResponseVariable(const char *label, int lsfTag, int rvTag);
+  double getResponseVariable(const char *label, int lsfTag);
+
+  void setNsteps(int nsteps);
+  double getDt();
+
+ protected:
+
+ private:
+  struct CachedPoint {
+    std::vector<double> key;   // the parameter values, scaled for the RVs
+    std::vector<std::string> expressions;
+    std::vector<double> values;
+    bool predicted;            // the limit-state function is the surrogate's
+    double prediction;
+  };
+
+  int formKey(std::vector<double> &key);
+  int findPoint(const std::vector<double> &key);
+  int addPoint(const std::vector<double> &key);
+  int analyze(void);
+  bool isLimitStateFunction(void);
+  bool predict(const std::vector<double> &key, double &g);
+
+  ReliabilityDomain *theReliabilityDomain;
+  Domain *theOpenSeesDomain;
+  FunctionEvaluator *theModelEvaluator;
+
+  std::vector<CachedPoint> thePoints;
+  std::vector<int> isRV;     // the parameters of the random variables
+  std::vector<double> scale; // & the standard deviations they are scaled with
+  int currentPoint;          // the point of the last runAnalysis()
+  int analyzedPoint;         // the point the model was last analyzed at
+  std::string theExpression;
+
+  double tol;
+  int maxPoints;
+
+  bool surrogate;
+  double errorTol;
+  double lengthScale;
+  int minPoints;
+  double gScale;
+};
+
+#endif
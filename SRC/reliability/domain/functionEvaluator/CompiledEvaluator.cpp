@@ -0,0 +1,795 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// CompiledEvaluator.
+
+#include <CompiledEvaluator.h>
+#include <ReliabilityDomain.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Parameter.h>
+#include <Vector.h>
+
+#include <vector>
+#include <math.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+  enum {OP_CONST, OP_PARAM, OP_DISP, OP_VEL, OP_ACCEL,
+	OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_FMOD, OP_NEG,
+	OP_LT, OP_GT, OP_LE, OP_GE, OP_EQ, OP_NE,
+	OP_SIN, OP_COS, OP_TAN, OP_ASIN, OP_ACOS, OP_ATAN, OP_SINH, OP_COSH, OP_TANH,
+	OP_EXP, OP_LOG, OP_LOG10, OP_SQRT, OP_ABS, OP_ATAN2, OP_MIN, OP_MAX};
+
+  struct Function {
+    const char *name;
+    int op;
+    int numArgs;
+  };
+
+  const Function theFunctions[] = {
+    {"sin", OP_SIN, 1}, {"cos", OP_COS, 1}, {"tan", OP_TAN, 1},
+    {"asin", OP_ASIN, 1}, {"acos", OP_ACOS, 1}, {"atan", OP_ATAN, 1},
+    {"sinh", OP_SINH, 1}, {"cosh", OP_COSH, 1}, {"tanh", OP_TANH, 1},
+    {"exp", OP_EXP, 1}, {"log", OP_LOG, 1}, {"log10", OP_LOG10, 1},
+    {"sqrt", OP_SQRT, 1}, {"abs", OP_ABS, 1}, {"fabs", OP_ABS, 1},
+    {"atan2", OP_ATAN2, 2}, {"pow", OP_POW, 2}, {"fmod", OP_FMOD, 2},
+    {"min", OP_MIN, 2}, {"max", OP_MAX, 2},
+    {0, 0, 0}
+  };
+
+  // an instruction; its result is the value of the slot of its index
+  struct Instruction {
+    int op;
+    int a, b;          // the slots of the operands
+    double value;      // OP_CONST
+    int tag, dof;      // OP_PARAM & the node responses
+    void *ptr;         // the Parameter or Node, once bound
+  };
+}
+
+class CompiledExpression
+{
+ public:
+  CompiledExpression(const char *text);
+
+  bool isValid(void) {return valid;}
+  int bind(Domain *theDomain);
+  double evaluate(void);
+  int differentiate(Domain *theDomain, ReliabilityDomain *theRelDomain, Vector &grad);
+
+ private:
+  // the parser, recursive descent over the precedence levels
+  int parseComparison(void);
+  int parseSum(void);
+  int parseProduct(void);
+  int parseUnary(void);
+  int parsePower(void);
+  int parsePrimary(void);
+  int parseCall(const char *name, bool tclStyle);
+  int parseIndex(void);
+
+  void skipSpace(void);
+  bool accept(const char *token);
+  bool readName(std::string &name);
+  int add(int op, int a = -1, int b = -1);
+  int error(const char *message);
+
+  std::string theText;
+  const char *pos;
+  bool valid;
+
+  std::vector<Instruction> code;
+  std::vector<double> value;
+  std::vector<double> adjoint;
+};
+
+
+CompiledExpression::CompiledExpression(const char *text)
+  :theText(text), pos(0), valid(true)
+{
+  pos = theText.c_str();
+  int result = this->parseComparison();
+  this->skipSpace();
+  if (valid && (result < 0 || *pos != '\0'))
+    this->error("unexpected input");
+
+  value.resize(code.size());
+  adjoint.resize(code.size());
+}
+
+
+int
+CompiledExpression::error(const char *message)
+{
+  if (valid) {
+    opserr << "WARNING CompiledEvaluator - " << message << " at position "
+	   << (int)(pos - theText.c_str()) + 1 << " of expression \"" << theText.c_str() << "\"\n";
+    opserr << "Note: use par(paramTag) for the parameters and nodeDisp(node, dof), "
+	   << "nodeVel & nodeAccel for the node responses\n";
+  }
+  valid = false;
+  return -1;
+}
+
+
+void
+CompiledExpression::skipSpace(void)
+{
+  while (*pos != '\0' && isspace(*pos))
+    pos++;
+}
+
+
+bool
+CompiledExpression::accept(const char *token)
+{
+  this->skipSpace();
+  int n = strlen(token);
+  if (strncmp(pos, token, n) != 0)
+    return false;
+  pos += n;
+  return true;
+}
+
+
+bool
+CompiledExpression::readName(std::string &name)
+{
+  this->skipSpace();
+  if (*pos == '$')
+    pos++;
+  if (!isalpha(*pos) && *pos != '_')
+    return false;
+
+  const char *start = pos;
+  while (isalnum(*pos) || *pos == '_' || *pos == '.')
+    pos++;
+  name.assign(start, pos - start);
+
+  // the module prefixes of the Python expressions
+  const char *prefixes[] = {"math.", "ops.", "opensees.", 0};
+  for (int i = 0; prefixes[i] != 0; i++) {
+    int n = strlen(prefixes[i]);
+    if (name.compare(0, n, prefixes[i]) == 0) {
+      name.erase(0, n);
+      break;
+    }
+  }
+
+  return true;
+}
+
+
+int
+CompiledExpression::add(int op, int a, int b)
+{
+  Instruction theInstr;
+  theInstr.op = op;
+  theInstr.a = a;
+  theInstr.b = b;
+  theInstr.value = 0.0;
+  theInstr.tag = 0;
+  theInstr.dof = 0;
+  theInstr.ptr = 0;
+  code.push_back(theInstr);
+  return code.size()-1;
+}
+
+
+int
+CompiledExpression::parseComparison(void)
+{
+  int a = this->parseSum();
+  while (valid) {
+    int op;
+    if (this->accept("<="))
+      op = OP_LE;
+    else if (this->accept(">="))
+      op = OP_GE;
+    else if (this->accept("=="))
+      op = OP_EQ;
+    else if (this->accept("!="))
+      op = OP_NE;
+    else if (this->accept("<"))
+      op = OP_LT;
+    else if (this->accept(">"))
+      op = OP_GT;
+    else
+      break;
+    int b = this->parseSum();
+    if (b < 0)
+      return -1;
+    a = this->add(op, a, b);
+  }
+  return valid ? a : -1;
+}
+
+
+int
+CompiledExpression::parseSum(void)
+{
+  int a = this->parseProduct();
+  while (valid) {
+    int op;
+    if (this->accept("+"))
+      op = OP_ADD;
+    else if (this->accept("-"))
+      op = OP_SUB;
+    else
+      break;
+    int b = this->parseProduct();
+    if (b < 0)
+      return -1;
+    a = this->add(op, a, b);
+  }
+  return valid ? a : -1;
+}
+
+
+int
+CompiledExpression::parseProduct(void)
+{
+  int a = this->parseUnary();
+  while (valid) {
+    int op;
+    this->skipSpace();
+    if (pos[0] == '*' && pos[1] != '*') {
+      pos++;
+      op = OP_MUL;
+    }
+    else if (this->accept("/"))
+      op = OP_DIV;
+    else if (this->accept("%"))
+      op = OP_FMOD;
+    else
+      break;
+    int b = this->parseUnary();
+    if (b < 0)
+      return -1;
+    a = this->add(op, a, b);
+  }
+  return valid ? a : -1;
+}
+
+
+int
+CompiledExpression::parseUnary(void)
+{
+  if (this->accept("-")) {
+    int a = this->parseUnary();
+    return a < 0 ? -1 : this->add(OP_NEG, a);
+  }
+  if (this->accept("+"))
+    return this->parseUnary();
+  return this->parsePower();
+}
+
+
+int
+CompiledExpression::parsePower(void)
+{
+  int a = this->parsePrimary();
+  if (a < 0)
+    return -1;
+
+  // ** is right associative and binds tighter than a unary minus on its left
+  if (this->accept("**")) {
+    int b = this->parseUnary();
+    if (b < 0)
+      return -1;
+    a = this->add(OP_POW, a, b);
+  }
+  return a;
+}
+
+
+int
+CompiledExpression::parsePrimary(void)
+{
+  this->skipSpace();
+
+  if (isdigit(*pos) || (*pos == '.' && isdigit(pos[1]))) {
+    char *end;
+    double v = strtod(pos, &end);
+    pos = end;
+    int slot = this->add(OP_CONST);
+    code[slot].value = v;
+    return slot;
+  }
+
+  if (*pos == '(') {
+    pos++;
+    int a = this->parseComparison();
+    if (a < 0)
+      return -1;
+    if (!this->accept(")"))
+      return this->error("missing )");
+    return a;
+  }
+
+  // a Tcl command substitution, [nodeDisp node dof]
+  if (*pos == '[') {
+    pos++;
+    std::string name;
+    if (!this->readName(name))
+      return this->error("command name expected");
+    int a = this->parseCall(name.c_str(), true);
+    if (a < 0)
+      return -1;
+    if (!this->accept("]"))
+      return this->error("missing ]");
+    return a;
+  }
+
+  std::string name;
+  if (!this->readName(name))
+    return this->error("number, name or ( expected");
+
+  if (name == "pi") {
+    int slot = this->add(OP_CONST);
+    code[slot].value = 3.14159265358979323846;
+    return slot;
+  }
+  if (name == "e") {
+    int slot = this->add(OP_CONST);
+    code[slot].value = 2.71828182845904523536;
+    return slot;
+  }
+
+  return this->parseCall(name.c_str(), false);
+}
+
+
+// the tag of par(tag) or par[tag]
+int
+CompiledExpression::parseIndex(void)
+{
+  this->skipSpace();
+  char close;
+  if (*pos == '(')
+    close = ')';
+  else if (*pos == '[')
+    close = ']';
+  else
+    return this->error("par must be followed by (tag) or [tag]");
+  pos++;
+  this->skipSpace();
+  char *end;
+  long tag = strtol(pos, &end, 10);
+  if (end == pos)
+    return this->error("parameter tag expected");
+  pos = end;
+  this->skipSpace();
+  if (*pos != close)
+    return this->error("missing ) or ] after the parameter tag");
+  pos++;
+  return (int)tag;
+}
+
+
+int
+CompiledExpression::parseCall(const char *name, bool tclStyle)
+{
+  if (strcmp(name, "par") == 0) {
+    int tag = this->parseIndex();
+    if (!valid)
+      return -1;
+    int slot = this->add(OP_PARAM);
+    code[slot].tag = tag;
+    return slot;
+  }
+
+  int op = -1;
+  int numArgs = 0;
+  if (strcmp(name, "nodeDisp") == 0) {
+    op = OP_DISP;
+    numArgs = 2;
+  }
+  else if (strcmp(name, "nodeVel") == 0) {
+    op = OP_VEL;
+    numArgs = 2;
+  }
+  else if (strcmp(name, "nodeAccel") == 0) {
+    op = OP_ACCEL;
+    numArgs = 2;
+  }
+  else {
+    for (int i = 0; theFunctions[i].name != 0; i++)
+      if (strcmp(name, theFunctions[i].name) == 0) {
+	op = theFunctions[i].op;
+	numArgs = theFunctions[i].numArgs;
+	break;
+      }
+  }
+  if (op < 0)
+    return this->error("unknown function or variable");
+
+  // the node responses take integer arguments, read as they are
+  if (op == OP_DISP || op == OP_VEL || op == OP_ACCEL) {
+    int args[2];
+    if (!tclStyle && !this->accept("("))
+      return this->error("( expected");
+    for (int i = 0; i < 2; i++) {
+      if (i > 0 && !tclStyle && !this->accept(","))
+	return this->error(", expected");
+      this->skipSpace();
+      char *end;
+      args[i] = (int)strtol(pos, &end, 10);
+      if (end == pos)
+	return this->error("node tag or dof expected");
+      pos = end;
+    }
+    if (!tclStyle && !this->accept(")"))
+      return this->error(") expected");
+    int slot = this->add(op);
+    code[slot].tag = args[0];
+    code[slot].dof = args[1];
+    return slot;
+  }
+
+  if (tclStyle)
+    return this->error("only the node responses can be substituted with [ ]");
+
+  if (!this->accept("("))
+    return this->error("( expected");
+  int a = this->parseComparison();
+  int b = -1;
+  if (a < 0)
+    return -1;
+  if (numArgs == 2) {
+    if (!this->accept(","))
+      return this->error(", expected");
+    b = this->parseComparison();
+    if (b < 0)
+      return -1;
+  }
+  if (!this->accept(")"))
+    return this->error(") expected");
+
+  return this->add(op, a, b);
+}
+
+
+int
+CompiledExpression::bind(Domain *theDomain)
+{
+  for (size_t i = 0; i < code.size(); i++) {
+    Instruction &theInstr = code[i];
+    if (theInstr.op == OP_PARAM) {
+      theInstr.ptr = theDomain->getParameter(theInstr.tag);
+      if (theInstr.ptr == 0) {
+	opserr << "WARNING CompiledEvaluator - parameter " << theInstr.tag << " not found\n";
+	return -1;
+      }
+    }
+    else if (theInstr.op == OP_DISP || theInstr.op == OP_VEL || theInstr.op == OP_ACCEL) {
+      theInstr.ptr = theDomain->getNode(theInstr.tag);
+      if (theInstr.ptr == 0) {
+	opserr << "WARNING CompiledEvaluator - node " << theInstr.tag << " not found\n";
+	return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+
+double
+CompiledExpression::evaluate(void)
+{
+  double *v = &value[0];
+  int n = code.size();
+  for (int i = 0; i < n; i++) {
+    const Instruction &theInstr = code[i];
+    double x = theInstr.a >= 0 ? v[theInstr.a] : 0.0;
+    double y = theInstr.b >= 0 ? v[theInstr.b] : 0.0;
+    switch (theInstr.op) {
+    case OP_CONST: v[i] = theInstr.value; break;
+    case OP_PARAM: v[i] = ((Parameter *)theInstr.ptr)->getValue(); break;
+    case OP_DISP: case OP_VEL: case OP_ACCEL: {
+      Node *theNode = (Node *)theInstr.ptr;
+      const Vector &theResponse = theInstr.op == OP_DISP ? theNode->getDisp() :
+	(theInstr.op == OP_VEL ? theNode->getVel() : theNode->getAccel());
+      int dof = theInstr.dof - 1;
+      v[i] = (dof >= 0 && dof < theResponse.Size()) ? theResponse(dof) : 0.0;
+      break;
+    }
+    case OP_ADD: v[i] = x + y; break;
+    case OP_SUB: v[i] = x - y; break;
+    case OP_MUL: v[i] = x * y; break;
+    case OP_DIV: v[i] = x / y; break;
+    case OP_POW: v[i] = pow(x, y); break;
+    case OP_FMOD: v[i] = fmod(x, y); break;
+    case OP_NEG: v[i] = -x; break;
+    case OP_LT: v[i] = x < y; break;
+    case OP_GT: v[i] = x > y; break;
+    case OP_LE: v[i] = x <= y; break;
+    case OP_GE: v[i] = x >= y; break;
+    case OP_EQ: v[i] = x == y; break;
+    case OP_NE: v[i] = x != y; break;
+    case OP_SIN: v[i] = sin(x); break;
+    case OP_COS: v[i] = cos(x); break;
+    case OP_TAN: v[i] = tan(x); break;
+    case OP_ASIN: v[i] = asin(x); break;
+    case OP_ACOS: v[i] = acos(x); break;
+    case OP_ATAN: v[i] = atan(x); break;
+    case OP_SINH: v[i] = sinh(x); break;
+    case OP_COSH: v[i] = cosh(x); break;
+    case OP_TANH: v[i] = tanh(x); break;
+    case OP_EXP: v[i] = exp(x); break;
+    case OP_LOG: v[i] = log(x); break;
+    case OP_LOG10: v[i] = log10(x); break;
+    case OP_SQRT: v[i] = sqrt(x); break;
+    case OP_ABS: v[i] = fabs(x); break;
+    case OP_ATAN2: v[i] = atan2(x, y); break;
+    case OP_MIN: v[i] = x < y ? x : y; break;
+    case OP_MAX: v[i] = x > y ? x : y; break;
+    }
+  }
+  return n > 0 ? v[n-1] : 0.0;
+}
+
+
+// int differentiate(Domain *, ReliabilityDomain *, Vector &grad);
+//	the gradient of the expression with respect to the random variables,
+//	at the values of the last evaluate(). The adjoints of the slots are
+//	accumulated back from the result to the leaves, then each random
+//	variable gathers those of its parameter and of the node responses,
+//	through their sensitivities to it.
+int
+CompiledExpression::differentiate(Domain *theDomain, ReliabilityDomain *theRelDomain, Vector &grad)
+{
+  int n = code.size();
+  if (n == 0)
+    return 0;
+
+  const double *v = &value[0];
+  double *adj = &adjoint[0];
+  for (int i = 0; i < n; i++)
+    adj[i] = 0.0;
+  adj[n-1] = 1.0;
+
+  for (int i = n-1; i >= 0; i--) {
+    const Instruction &theInstr = code[i];
+    double g = adj[i];
+    if (g == 0.0 || theInstr.a < 0)
+      continue;
+    int a = theInstr.a;
+    int b = theInstr.b;
+    double x = v[a];
+    double y = b >= 0 ? v[b] : 0.0;
+    switch (theInstr.op) {
+    case OP_ADD: adj[a] += g; adj[b] += g; break;
+    case OP_SUB: adj[a] += g; adj[b] -= g; break;
+    case OP_MUL: adj[a] += g*y; adj[b] += g*x; break;
+    case OP_DIV: adj[a] += g/y; adj[b] -= g*x/(y*y); break;
+    case OP_POW:
+      adj[a] += (y == 0.0) ? 0.0 : g*y*pow(x, y-1.0);
+      if (x > 0.0)
+	adj[b] += g*v[i]*log(x);
+      break;
+    case OP_FMOD: adj[a] += g; adj[b] -= g*trunc(x/y); break;
+    case OP_NEG: adj[a] -= g; break;
+    case OP_SIN: adj[a] += g*cos(x); break;
+    case OP_COS: adj[a] -= g*sin(x); break;
+    case OP_TAN: adj[a] += g/(cos(x)*cos(x)); break;
+    case OP_ASIN: adj[a] += g/sqrt(1.0-x*x); break;
+    case OP_ACOS: adj[a] -= g/sqrt(1.0-x*x); break;
+    case OP_ATAN: adj[a] += g/(1.0+x*x); break;
+    case OP_SINH: adj[a] += g*cosh(x); break;
+    case OP_COSH: adj[a] += g*sinh(x); break;
+    case OP_TANH: adj[a] += g*(1.0-v[i]*v[i]); break;
+    case OP_EXP: adj[a] += g*v[i]; break;
+    case OP_LOG: adj[a] += g/x; break;
+    case OP_LOG10: adj[a] += g/(x*log(10.0)); break;
+    case OP_SQRT: adj[a] += g/(2.0*v[i]); break;
+    case OP_ABS: adj[a] += x < 0.0 ? -g : g; break;
+    case OP_ATAN2: adj[a] += g*y/(x*x+y*y); adj[b] -= g*x/(x*x+y*y); break;
+    case OP_MIN: if (x <= y) adj[a] += g; else adj[b] += g; break;
+    case OP_MAX: if (x >= y) adj[a] += g; else adj[b] += g; break;
+    default: break; // the comparisons are piecewise constant
+    }
+  }
+
+  grad.Zero();
+
+  int nparam = theDomain->getNumParameters();
+  for (int j = 0; j < nparam; j++) {
+    Parameter *theParam = theDomain->getParameterFromIndex(j);
+    if (strcmp(theParam->getType(), "RandomVariable") != 0)
+      continue;
+    int rvIndex = theRelDomain->getRandomVariableIndex(theParam->getPointerTag());
+    if (rvIndex < 0 || rvIndex >= grad.Size())
+      continue;
+    int gradIndex = theParam->getGradIndex();
+
+    double dg = 0.0;
+    for (int i = 0; i < n; i++) {
+      const Instruction &theInstr = code[i];
+      if (adj[i] == 0.0)
+	continue;
+      if (theInstr.op == OP_PARAM) {
+	if (theInstr.ptr == theParam)
+	  dg += adj[i];
+      }
+      else if (theInstr.op == OP_DISP)
+	dg += adj[i]*((Node *)theInstr.ptr)->getDispSensitivity(theInstr.dof, gradIndex);
+      else if (theInstr.op == OP_VEL)
+	dg += adj[i]*((Node *)theInstr.ptr)->getVelSensitivity(theInstr.dof, gradIndex);
+      else if (theInstr.op == OP_ACCEL)
+	dg += adj[i]*((Node *)theInstr.ptr)->getAccSensitivity(theInstr.dof, gradIndex);
+    }
+    grad(rvIndex) = dg;
+  }
+
+  return 0;
+}
+
+
+CompiledEvaluator::CompiledEvaluator(ReliabilityDomain *passedReliabilityDomain,
+				     Domain *passedOpenSeesDomain,
+				     FunctionEvaluator *passedAnalysisEvaluator)
+  :FunctionEvaluator(), theReliabilityDomain(passedReliabilityDomain),
+   theOpenSeesDomain(passedOpenSeesDomain), theAnalysisEvaluator(passedAnalysisEvaluator),
+   theExpression(0), current_val(0.0)
+{
+
+}
+
+
+CompiledEvaluator::~CompiledEvaluator()
+{
+  std::map<std::string, CompiledExpression *>::iterator it;
+  for (it = theExpressions.begin(); it != theExpressions.end(); it++)
+    delete it->second;
+
+  if (theAnalysisEvaluator != 0)
+    delete theAnalysisEvaluator;
+}
+
+
+int
+CompiledEvaluator::setVariables(void)
+{
+  // the parameters are read directly, only the pointers are refreshed
+  if (theExpression == 0 || !theExpression->isValid())
+    return 0;
+
+  return theExpression->bind(theOpenSeesDomain);
+}
+
+
+int
+CompiledEvaluator::setExpression(const char *passedExpression)
+{
+  std::map<std::string, CompiledExpression *>::iterator it = theExpressions.find(passedExpression);
+  if (it != theExpressions.end()) {
+    theExpression = it->second;
+    return theExpression->isValid() ? 0 : -1;
+  }
+
+  theExpression = new CompiledExpression(passedExpression);
+  theExpressions[passedExpression] = theExpression;
+  if (!theExpression->isValid())
+    return -1;
+
+  return theExpression->bind(theOpenSeesDomain);
+}
+
+
+int
+CompiledEvaluator::addToExpression(const char *in)
+{
+  return 0;
+}
+
+
+double
+CompiledEvaluator::evaluateExpression(void)
+{
+  if (theExpression == 0) {
+    opserr << "CompiledEvaluator::evaluateExpression -- must set the expression before trying ";
+    opserr << "to evaluate" << endln;
+    return -1;
+  }
+  if (!theExpression->isValid())
+    return -1;
+
+  current_val = theExpression->evaluate();
+
+  this->incrementEvaluations();
+  return current_val;
+}
+
+
+int
+CompiledEvaluator::evaluateGradient(Vector &grad)
+{
+  if (theExpression == 0 || !theExpression->isValid())
+    return -1;
+
+  if (theExpression->bind(theOpenSeesDomain) != 0)
+    return -1;
+  theExpression->evaluate();
+
+  return theExpression->differentiate(theOpenSeesDomain, theReliabilityDomain, grad);
+}
+
+
+int
+CompiledEvaluator::runAnalysis(void)
+{
+  if (theAnalysisEvaluator != 0)
+    return theAnalysisEvaluator->runAnalysis();
+
+  // no analysis script, as for the basic evaluator
+  if (theOpenSeesDomain->revertToStart() != 0) {
+    opserr << "ERROR CompiledEvaluator -- error in resetting Domain" << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+CompiledEvaluator::setResponseVariable(const char *label, int lsfTag,
+				       int rvTag, double value)
+{
+  if (theAnalysisEvaluator != 0)
+    return theAnalysisEvaluator->setResponseVariable(label, lsfTag, rvTag, value);
+  return this->FunctionEvaluator::setResponseVariable(label, lsfTag, rvTag, value);
+}
+
+
+int
+CompiledEvaluator::setResponseVariable(const char *label, int lsfTag, double value)
+{
+  if (theAnalysisEvaluator != 0)
+    return theAnalysisEvaluator->setResponseVariable(label, lsfTag, value);
+  return this->FunctionEvaluator::setResponseVariable(label, lsfTag, value);
+}
+
+
+double
+CompiledEvaluator::getResponseVariable(const char *label, int lsfTag, int rvTag)
+{
+  if (theAnalysisEvaluator != 0)
+    return theAnalysisEvaluator->getResponseVariable(label, lsfTag, rvTag);
+  return this->FunctionEvaluator::getResponseVariable(label, lsfTag, rvTag);
+}
+
+
+double
+CompiledEvaluator::getResponseVariable(const char *label, int lsfTag)
+{
+  if (theAnalysisEvaluator != 0)
+    return theAnalysisEvaluator->getResponseVariable(label, lsfTag);
+  return this->FunctionEvaluator::getResponseVariable(label, lsfTag);
+}
@@ -0,0 +1,89 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// CompiledEvaluator. A CompiledEvaluator evaluates the limit-state
+// functions natively instead of in an interpreter. Each expression is
+// parsed once into a list of instructions bound to the parameters & nodes
+// it reads, and is evaluated from their values directly. The parameters
+// are read as par(tag), $par(tag) or par[tag] and the node responses as
+// nodeDisp(node, dof), nodeVel & nodeAccel, or as [nodeDisp node dof], so
+// the expressions written for the Tcl and Python evaluators compile as
+// they are. The gradient of an expression with respect to the random
+// variables is formed by reverse mode differentiation of the instructions,
+// with the sensitivities of the node responses.
+//
+// The analysis of each trial point is still run by the evaluator of the
+// interpreter, if one is given, as are the response variables set by the
+// reliability recorders.
+
+#ifndef CompiledEvaluator_h
+#define CompiledEvaluator_h
+
+#include <FunctionEvaluator.h>
+#include <map>
+#include <string>
+
+class Domain;
+class ReliabilityDomain;
+class CompiledExpression;
+
+class CompiledEvaluator : public FunctionEvaluator
+{
+ public:
+  CompiledEvaluator(ReliabilityDomain *passedReliabilityDomain,
+		    Domain *passedOpenSeesDomain,
+		    FunctionEvaluator *theAnalysisEvaluator = 0);
+  ~CompiledEvaluator();
+
+  int setVariables(void);
+  int setExpression(const char *expression);
+  int addToExpression(const char *expression);
+
+  double evaluateExpression(void);
+  int evaluateGradient(Vector &grad);
+  int runAnalysis(void);
+
+  int setResponseVariable(const char *label, int lsfTag,
+			  int rvTag, double value);
+  int setResponseVariable(const char *label, int lsfTag, double value);
+  double getResponseVariable(const char *label, int lsfTag, int rvTag);
+  double getResponseVariable(const char *label, int lsfTag);
+
+ protected:
+
+ private:
+  ReliabilityDomain *theReliabilityDomain;
+  Domain *theOpenSeesDomain;
+  FunctionEvaluator *theAnalysisEvaluator;
+
+  // the expressions compiled so far, as the gradient evaluators switch
+  // between the limit-state function & its gradient expressions
+  std::map<std::string, CompiledExpression *> theExpressions;
+  CompiledExpression *theExpression;
+
+  double current_val;
+};
+
+#endif
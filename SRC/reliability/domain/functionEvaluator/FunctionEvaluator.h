@@ -61,6 +61,10 @@ public:
 	virtual int addToExpression(const char *expression) = 0;
 	virtual double evaluateExpression(void) = 0;
 	virtual int runAnalysis(void) = 0;
+
+	// the gradient of the expression with respect to the random variables,
+	// for the evaluators that differentiate it; -1 if they do not
+	virtual int evaluateGradient(Vector &grad) {return -1;}
 	
 	// MHS hack for reliability recorders ... set value in namespace
 	virtual int setResponseVariable(const char *label, int lsfTag,
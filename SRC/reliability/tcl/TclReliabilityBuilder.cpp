@@ -87,6 +87,8 @@ using std::setiosflags;
 #include <GradientEvaluator.h>
 #include <HessianEvaluator.h>
 #include <TclEvaluator.h>
+#include <CompiledEvaluator.h>
+#include <CachedEvaluator.h>
 #include <ImplicitGradient.h>
 #include <FiniteDifferenceGradient.h>
 #include <FiniteDifferenceHessian.h>
@@ -102,6 +104,7 @@ using std::setiosflags;
 #include <SearchWithStepSizeAndStepDirection.h>
 #include <RandomNumberGenerator.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 #include <FindCurvatures.h>
 #include <FirstPrincipalCurvature.h>
 #include <CurvaturesBySearchAlgorithm.h>
@@ -120,7 +123,7 @@ using std::setiosflags;
 //#include <OpenSeesGradGEvaluator.h>
 #include <FORMAnalysis.h>
 #include <FOSMAnalysis.h>
-//#include <ParametricReliabilityAnalysis.h>
+#include <ParametricReliabilityAnalysis.h>
 #include <GFunVisualizationAnalysis.h>
 #include <OutCrossingAnalysis.h>
 #include <ImportanceSamplingAnalysis.h>
@@ -297,7 +300,7 @@ int TclReliabilityModelBuilder_addFindDesignPointAlgorithm(ClientData clientData
 int TclReliabilityModelBuilder_addFindCurvatures(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int TclReliabilityModelBuilder_runFORMAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int TclReliabilityModelBuilder_runFOSMAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
-//int TclReliabilityModelBuilder_runParametricReliabilityAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+int TclReliabilityModelBuilder_runParametricReliabilityAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int TclReliabilityModelBuilder_runGFunVisualizationAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int TclReliabilityModelBuilder_runOutCrossingAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int TclReliabilityModelBuilder_runSORMAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
@@ -386,7 +389,7 @@ TclReliabilityBuilder::TclReliabilityBuilder(Domain &passedDomain, Tcl_Interp *i
   Tcl_CreateCommand(interp, "randomNumberGenerator",TclReliabilityModelBuilder_addRandomNumberGenerator,(ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "runFORMAnalysis",TclReliabilityModelBuilder_runFORMAnalysis,(ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "runFOSMAnalysis",TclReliabilityModelBuilder_runFOSMAnalysis,(ClientData)NULL, NULL);
-  //  Tcl_CreateCommand(interp, "runParametricReliabilityAnalysis",TclReliabilityModelBuilder_runParametricReliabilityAnalysis,(ClientData)NULL, NULL);
+  Tcl_CreateCommand(interp, "runParametricReliabilityAnalysis",TclReliabilityModelBuilder_runParametricReliabilityAnalysis,(ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "runGFunVizAnalysis",TclReliabilityModelBuilder_runGFunVisualizationAnalysis,(ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "runOutCrossingAnalysis",TclReliabilityModelBuilder_runOutCrossingAnalysis,(ClientData)NULL, NULL);
   Tcl_CreateCommand(interp, "runSORMAnalysis",TclReliabilityModelBuilder_runSORMAnalysis,(ClientData)NULL, NULL);
@@ -605,7 +608,7 @@ TclReliabilityBuilder::~TclReliabilityBuilder()
   Tcl_DeleteCommand(theInterp, "randomNumberGenerator");
   Tcl_DeleteCommand(theInterp, "runFORMAnalysis");
   Tcl_DeleteCommand(theInterp, "runFOSMAnalysis");
-  //  Tcl_DeleteCommand(theInterp, "runParametricReliabilityAnalysis");
+  Tcl_DeleteCommand(theInterp, "runParametricReliabilityAnalysis");
   Tcl_DeleteCommand(theInterp, "runGFunVizAnalysis");
   Tcl_DeleteCommand(theInterp, "runOutCrossingAnalysis");
   Tcl_DeleteCommand(theInterp, "runSORMAnalysis");
@@ -2202,6 +2205,9 @@ TclReliabilityModelBuilder_addRandomNumberGenerator(ClientData clientData, Tcl_I
   if (strcmp(argv[1],"CStdLib") == 0) {
 	  theRandomNumberGenerator = new CStdLibRandGenerator();
   }
+  else if (strcmp(argv[1],"Philox") == 0) {
+	  theRandomNumberGenerator = new PhiloxRandGenerator();
+  }
   else {
 	opserr << "ERROR: unrecognized type of RandomNumberGenerator \n";
 	return TCL_ERROR;
@@ -3002,6 +3008,57 @@ TclReliabilityModelBuilder_addFunctionEvaluator(ClientData clientData, Tcl_Inter
 		theFunctionEvaluator = 0;
 	}
 
+	if (argc < 2) {
+		opserr << "ERROR: Wrong number of arguments to functionEvaluator" << endln;
+		return TCL_ERROR;
+	}
+
+	// the cache options trail those of the evaluator
+	// <-cache <tol?>> <-maxPoints n?> <-surrogate errorTol? <lengthScale?> <minPoints?>>
+	bool cache = false;
+	double cacheTol = 0.0;
+	int maxPoints = 1000;
+	double errorTol = 0.0;
+	double lengthScale = 1.0;
+	int minPoints = 0;
+	for (int i = 2; i < argc; i++) {
+		if (strcmp(argv[i],"-cache") != 0 && strcmp(argv[i],"-surrogate") != 0 &&
+		    strcmp(argv[i],"-maxPoints") != 0)
+			continue;
+		int numArgs = i;
+		cache = true;
+		while (i < argc) {
+			if (strcmp(argv[i],"-cache") == 0) {
+				if (i+1 < argc && Tcl_GetDouble(interp, argv[i+1], &cacheTol) == TCL_OK)
+					i++;
+			}
+			else if (strcmp(argv[i],"-maxPoints") == 0) {
+				if (i+1 >= argc || Tcl_GetInt(interp, argv[i+1], &maxPoints) != TCL_OK) {
+					opserr << "ERROR: invalid input: -maxPoints n" << endln;
+					return TCL_ERROR;
+				}
+				i++;
+			}
+			else if (strcmp(argv[i],"-surrogate") == 0) {
+				if (i+1 >= argc || Tcl_GetDouble(interp, argv[i+1], &errorTol) != TCL_OK) {
+					opserr << "ERROR: invalid input: -surrogate errorTol <lengthScale> <minPoints>" << endln;
+					return TCL_ERROR;
+				}
+				i++;
+				if (i+1 < argc && Tcl_GetDouble(interp, argv[i+1], &lengthScale) == TCL_OK) {
+					i++;
+					if (i+1 < argc && Tcl_GetInt(interp, argv[i+1], &minPoints) == TCL_OK)
+						i++;
+				}
+			}
+			else {
+				opserr << "ERROR: unknown functionEvaluator cache option " << argv[i] << endln;
+				return TCL_ERROR;
+			}
+			i++;
+		}
+		argc = numArgs;
+	}
 
 	// GET INPUT PARAMETER (string) AND CREATE THE OBJECT
 	if (strcmp(argv[1],"Matlab") == 0) {
@@ -3029,6 +3086,21 @@ TclReliabilityModelBuilder_addFunctionEvaluator(ClientData clientData, Tcl_Inter
 			return TCL_ERROR;
 		}
 	}
+	else if (strcmp(argv[1],"Compiled") == 0) {
+		// the expressions are compiled, the analysis is still run by Tcl
+		TclEvaluator *theAnalysisEvaluator = 0;
+		if (argc == 2)
+			theAnalysisEvaluator = new TclEvaluator(interp, theReliabilityDomain, theStructuralDomain);
+		else if (argc == 4 && (strcmp(argv[2],"-file") == 0 || strcmp(argv[2],"-command") == 0))
+			theAnalysisEvaluator = new TclEvaluator(interp, theReliabilityDomain,
+								theStructuralDomain, argv[3]);
+		else {
+			opserr << "ERROR: Compiled function evaluator only takes -file and -command arguments." << endln;
+			return TCL_ERROR;
+		}
+		theFunctionEvaluator = new CompiledEvaluator(theReliabilityDomain, theStructuralDomain,
+							     theAnalysisEvaluator);
+	}
 
 /////////////////////////////////////////
 ////////S modified by K Fujimura 10/10/2004
@@ -3076,6 +3148,14 @@ TclReliabilityModelBuilder_addFunctionEvaluator(ClientData clientData, Tcl_Inter
 		opserr << "ERROR: could not create the theFunctionEvaluator \n";
 		return TCL_ERROR;
 	}
+
+	if (cache) {
+		CachedEvaluator *theCache = new CachedEvaluator(theReliabilityDomain, theStructuralDomain,
+								theFunctionEvaluator, cacheTol, maxPoints);
+		theFunctionEvaluator = theCache;
+		if (errorTol > 0.0 && theCache->setSurrogate(errorTol, lengthScale, minPoints) < 0)
+			return TCL_ERROR;
+	}
 	return TCL_OK;
 }
 
@@ -3097,6 +3177,9 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 
 		double perturbationFactor = 1000.0;
 		bool doGradientCheck = false;
+		int scheme = FiniteDifferenceGradient::Forward;
+		bool autoStep = false;
+		bool distributed = false;
 
 		// Check that the necessary ingredients are present
 		if (theFunctionEvaluator == 0 ) {
@@ -3104,25 +3187,13 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 			return TCL_ERROR;
 		}
 
-		// Possibly read perturbation factor
+		// Possibly read perturbation factor, scheme and step control
 		if (argc>2) {
-			int numExtras;
-			if (argc==3 || argc==4) {
-				numExtras = 1;
-			}
-			else if (argc==5) {
-				numExtras = 2;
-			}
-			else {
-				opserr << "ERROR: Wrong number of arguments to FiniteDifferenceGradient. " << endln;
-				return TCL_ERROR;
-			}
-
 			int counter = 2;
 
-			for (int i=1; i<=numExtras; i++) {
+			while (counter < argc) {
 
-				if (strcmp(argv[counter],"-pert") == 0) {
+				if (strcmp(argv[counter],"-pert") == 0 && counter+1 < argc) {
 					counter ++;
 
 					if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
@@ -3135,6 +3206,26 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 					counter++;
 					doGradientCheck = true;
 				}
+				else if (strcmp(argv[counter],"-forward") == 0) {
+					counter++;
+					scheme = FiniteDifferenceGradient::Forward;
+				}
+				else if (strcmp(argv[counter],"-backward") == 0) {
+					counter++;
+					scheme = FiniteDifferenceGradient::Backward;
+				}
+				else if (strcmp(argv[counter],"-central") == 0) {
+					counter++;
+					scheme = FiniteDifferenceGradient::Central;
+				}
+				else if (strcmp(argv[counter],"-auto") == 0) {
+					counter++;
+					autoStep = true;
+				}
+				else if (strcmp(argv[counter],"-distributed") == 0) {
+					counter++;
+					distributed = true;
+				}
 				else {
 					opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
 					return TCL_ERROR;
@@ -3143,7 +3234,8 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 		}
 
 		theGradientEvaluator = new FiniteDifferenceGradient(theFunctionEvaluator, theReliabilityDomain, 
-								    theStructuralDomain);
+								    theStructuralDomain, scheme, autoStep,
+								    distributed);
 	}
 
 	else if (strcmp(argv[1],"OpenSees") == 0 || strcmp(argv[1],"Implicit") == 0) {
@@ -3851,25 +3943,14 @@ TclReliabilityModelBuilder_runFOSMAnalysis(ClientData clientData, Tcl_Interp *in
 
 
 
-/*
 //////////////////////////////////////////////////////////////////
+// runParametricReliabilityAnalysis fileName -par tag -range first last -numInt n
+//     <-workers w> <-noWarmStart>
 int 
 TclReliabilityModelBuilder_runParametricReliabilityAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
-	// In case this is a replacement
-	if (theParametricReliabilityAnalysis != 0) {
-		delete theParametricReliabilityAnalysis;
-		theParametricReliabilityAnalysis = 0;
-	}
-
-
-	// Do input check
-	char theCommand[15] = "inputCheck";
-	Tcl_Eval( interp, theCommand );
-
-
 	// Check number of arguments
-	if (argc != 9)  {
+	if (argc < 9)  {
 		opserr << "ERROR: Wrong number of input parameter to Fragility analysis" << endln;
 		return TCL_ERROR;
 	}
@@ -3880,90 +3961,91 @@ TclReliabilityModelBuilder_runParametricReliabilityAnalysis(ClientData clientDat
 		opserr << "Need theFindDesignPointAlgorithm before a ParametricReliabilityAnalysis can be created" << endln;
 		return TCL_ERROR;
 	}
-	if (theGradientEvaluator == 0 ) {
-		opserr << "Need theGradientEvaluator before a ParametricReliabilityAnalysis can be created" << endln;
-		return TCL_ERROR;
-	}
 
 
 	// Read input
 	bool parGiven = false;
 	bool rangeGiven = false; 
 	bool numIntGiven = false;
-	int parameterNumber;
-	double first;
-	double last;
-	int numIntervals;
-	int counter = 3;
-	for (int i=1; i<=3; i++) {
-
-		if (strcmp(argv[counter-1],"-par") == 0) {
-			// GET INPUT PARAMETER (int)
-			if (Tcl_GetInt(interp, argv[counter], &parameterNumber) != TCL_OK) {
-				opserr << "ERROR: invalid input: parameterNumber \n";
+	int parameterTag = 0;
+	double first = 0.0;
+	double last = 0.0;
+	int numIntervals = 0;
+	int numWorkers = 1;
+	bool warmStart = true;
+	int counter = 2;
+	while (counter < argc) {
+
+		if (strcmp(argv[counter],"-par") == 0 && counter+1 < argc) {
+			if (Tcl_GetInt(interp, argv[counter+1], &parameterTag) != TCL_OK) {
+				opserr << "ERROR: invalid input: parameter tag \n";
 				return TCL_ERROR;
 			}
-			counter++; counter++;
+			counter += 2;
 			parGiven = true;
 		}
-		else if (strcmp(argv[counter-1],"-range") == 0) {
-			// GET INPUT PARAMETER (double)
-			if (Tcl_GetDouble(interp, argv[counter], &first) != TCL_OK) {
+		else if (strcmp(argv[counter],"-range") == 0 && counter+2 < argc) {
+			if (Tcl_GetDouble(interp, argv[counter+1], &first) != TCL_OK) {
 				opserr << "ERROR: invalid input: first bound to range \n";
 				return TCL_ERROR;
 			}
-			counter++; 
-			// GET INPUT PARAMETER (double)
-			if (Tcl_GetDouble(interp, argv[counter], &last) != TCL_OK) {
+			if (Tcl_GetDouble(interp, argv[counter+2], &last) != TCL_OK) {
 				opserr << "ERROR: invalid input: last bound to range \n";
 				return TCL_ERROR;
 			}
-			counter++; counter++;
+			counter += 3;
 			rangeGiven = true;
 		}
-		else if (strcmp(argv[counter-1],"-numInt") == 0) {
-			// GET INPUT PARAMETER (int)
-			if (Tcl_GetInt(interp, argv[counter], &numIntervals) != TCL_OK) {
+		else if ((strcmp(argv[counter],"-numInt") == 0 || strcmp(argv[counter],"-num") == 0) && counter+1 < argc) {
+			if (Tcl_GetInt(interp, argv[counter+1], &numIntervals) != TCL_OK || numIntervals < 1) {
 				opserr << "ERROR: invalid input: number of intervals \n";
 				return TCL_ERROR;
 			}
-			counter++; counter++;
+			counter += 2;
 			numIntGiven = true;
 		}
+		else if (strcmp(argv[counter],"-workers") == 0 && counter+1 < argc) {
+			if (Tcl_GetInt(interp, argv[counter+1], &numWorkers) != TCL_OK) {
+				opserr << "ERROR: invalid input: number of workers \n";
+				return TCL_ERROR;
+			}
+			counter += 2;
+		}
+		else if (strcmp(argv[counter],"-noWarmStart") == 0) {
+			warmStart = false;
+			counter++;
+		}
 		else {
-			opserr << "ERROR: invalid input to Fragility analysis " << endln;
+			opserr << "ERROR: invalid input to Fragility analysis " << argv[counter] << endln;
 			return TCL_ERROR;
 		}
 
 	}
 
-	if (parGiven && rangeGiven && numIntGiven) {
-		theParametricReliabilityAnalysis = new ParametricReliabilityAnalysis( theReliabilityDomain,
+	if (!parGiven || !rangeGiven || !numIntGiven) {
+		opserr << "ERROR:: some input to theParametricReliabilityAnalysis was not provided" << endln;
+		return TCL_ERROR;
+	}
+
+	ParametricReliabilityAnalysis theParametricReliabilityAnalysis(theReliabilityDomain,
+												  theStructuralDomain,
 												  theFindDesignPointAlgorithm,
-												  theGradientEvaluator,
-												  parameterNumber,
+												  parameterTag,
 												  first,
 												  last,
 												  numIntervals,
 												  argv[1],
-												  interp);
-	}
-	else {
-		opserr << "ERROR:: some input to theParametricReliabilityAnalysis was not provided" << endln;
-		return TCL_ERROR;
-	}
+												  numWorkers,
+												  warmStart);
 
-	if (theParametricReliabilityAnalysis == 0) {
-		opserr << "ERROR: could not create theParametricReliabilityAnalysis \n";
+	// Now run the analysis
+	if (theParametricReliabilityAnalysis.analyze() < 0) {
+		opserr << "WARNING: the parametric reliability analysis failed" << endln;
 		return TCL_ERROR;
 	}
 
-	// Now run the analysis
-	theParametricReliabilityAnalysis->analyze();
-
 	return TCL_OK;
 }
-*/
 
 //////////////////////////////////////////////////////////////////
 int 
@@ -4158,8 +4240,11 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	//     -print 1   (print to screen)
 	//     -print 2   (print to restart file)
 	//
+	//     -distributed 0  ...................... this is the default
+	//     -distributed 1  (share the samples among the parallel processes)
+	//
 
-	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12) {
+	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12 && argc!=14) {
 		opserr << "ERROR: Wrong number of arguments to Sampling analysis" << endln;
 		return TCL_ERROR;
 	}
@@ -4171,6 +4256,7 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	double samplingVariance	= 1.0;
 	int printFlag			= 0;
 	int analysisTypeTag		= 1;
+	int distributed			= 0;
 
 
 	for (int i=2; i<argc; i=i+2) {
@@ -4240,6 +4326,13 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 				return TCL_ERROR;
 			}
 		}
+		else if (strcmp(argv[i],"-distributed") == 0) {
+			// GET INPUT PARAMETER (integer)
+			if (Tcl_GetInt(interp, argv[i+1], &distributed) != TCL_OK) {
+				opserr << "ERROR: invalid input: distributed \n";
+				return TCL_ERROR;
+			}
+		}
 		else {
 			opserr << "ERROR: invalid input to sampling analysis. " << endln;
 			return TCL_ERROR;
@@ -4263,7 +4356,8 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 							 numberOfSimulations, targetCOV, samplingVariance,
 							 printFlag,
 							 argv[1],
-							 analysisTypeTag);
+							 analysisTypeTag,
+							 distributed != 0);
 
 	if (theImportanceSamplingAnalysis == 0) {
 		opserr << "ERROR: could not create theImportanceSamplingAnalysis \n";
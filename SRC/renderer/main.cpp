@@ -34,9 +34,9 @@ using std::cin;
 StandardStream sserr;
 OPS_Stream *opserrPtr  = &sserr;
 
-double        ops_Dt = 0;
-Domain       *ops_TheActiveDomain = 0;
-Element      *ops_TheActiveElement = 0;
+thread_local double        ops_Dt = 0;
+thread_local Domain       *ops_TheActiveDomain = 0;
+thread_local Element      *ops_TheActiveElement = 0;
 
 #include <OpenGLRenderer.h>
 #include <PlainMap.h>
@@ -58,6 +58,7 @@ typedef EquiSolnAlgo *(TclEquiSolnAlgo)(ClientData, Tcl_Interp *, int, TCL_Char
 OPS_Routine OPS_NewtonRaphsonAlgorithm;
 OPS_Routine OPS_ExpressNewton;
 OPS_Routine OPS_ModifiedNewton;
+OPS_Routine OPS_AdaptiveNewton;
 OPS_Routine OPS_NewtonHallM;
 
 TclEquiSolnAlgo G3Parse_newEquiSolnAlgo;
@@ -164,6 +165,11 @@ G3Parse_newEquiSolnAlgo(ClientData clientData, Tcl_Interp *interp, int argc,
     theNewAlgo = (EquiSolnAlgo *)theNewtonAlgo;
   }
 
+  else if (strcmp(argv[1], "AdaptiveNewton") == 0) {
+    void *theNewtonAlgo = OPS_AdaptiveNewton(rt, argc, argv);
+    theNewAlgo = (EquiSolnAlgo *)theNewtonAlgo;
+  }
+
   else {
     opserr << G3_ERROR_PROMPT << "No EquiSolnAlgo of type '" << argv[1] << "' exists\n";
     return nullptr;
@@ -211,9 +217,13 @@ TclCommand_newNewtonRaphson(ClientData clientData, Tcl_Interp* interp, int argc,
   int formTangent = CURRENT_TANGENT;
   double iFactor = 0;
   double cFactor = 1;
+  bool fused = false;
 
   for (int i=2; i<argc; i++) {
-    if (strcmp(argv[i],"-secant")==0 || 
+    if (strcmp(argv[i],"-fused")==0) {
+      fused = true;
+
+    } else if (strcmp(argv[i],"-secant")==0 || 
         strcmp(argv[i],"-Secant")==0) {
       formTangent = CURRENT_SECANT;
       iFactor = 0;
@@ -251,7 +261,7 @@ TclCommand_newNewtonRaphson(ClientData clientData, Tcl_Interp* interp, int argc,
     }
   }
 
-  builder->set(new NewtonRaphson(formTangent, iFactor, cFactor));
+  builder->set(new NewtonRaphson(formTangent, iFactor, cFactor, fused));
 
   return TCL_OK;
 }
@@ -480,9 +490,14 @@ G3_newNewtonLineSearch(ClientData clientData, Tcl_Interp *interp, int argc,
   double minEta = 0.1;
   int pFlag = 1;
   int typeSearch = 0;
+  bool reduced = false;
 
   while (count < argc) {
-    if (strcmp(argv[count], "-tol") == 0) {
+    if (strcmp(argv[count], "-reduced") == 0) {
+      reduced = true;
+      count++;
+
+    } else if (strcmp(argv[count], "-tol") == 0) {
       count++;
       if (Tcl_GetDouble(interp, argv[count], &tol) != TCL_OK)
         return nullptr;
@@ -542,7 +557,7 @@ G3_newNewtonLineSearch(ClientData clientData, Tcl_Interp *interp, int argc,
 
 
   EquiSolnAlgo *theNewAlgo = nullptr;
-  theNewAlgo = new NewtonLineSearch(*theTest, theLineSearch);
+  theNewAlgo = new NewtonLineSearch(*theTest, theLineSearch, reduced);
   return theNewAlgo;
 }
 
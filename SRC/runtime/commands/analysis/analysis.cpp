@@ -15,6 +15,10 @@
 #include <FileStream.h>
 
 #include <Matrix.h>
+#include <Vector.h>
+#include <Node.h>
+#include <math.h>
+#include <vector>
 #include <Domain.h> // for modal damping
 #include <AnalysisModel.h>
 
@@ -176,19 +180,24 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc,
       if (Tcl_GetDouble(interp, argv[2], &dT) != TCL_OK)
         return TCL_ERROR;
 
-      if (argc == 6) {
+      if (argc == 6 || (argc == 8 && strcmp(argv[6], "-errorTol") == 0)) {
         int Jd;
         double dtMin, dtMax;
+        double errorTol = 0.0;
         if (Tcl_GetDouble(interp, argv[3], &dtMin) != TCL_OK)
           return TCL_ERROR;
         if (Tcl_GetDouble(interp, argv[4], &dtMax) != TCL_OK)
           return TCL_ERROR;
         if (Tcl_GetInt(interp, argv[5], &Jd) != TCL_OK)
           return TCL_ERROR;
+        if (argc == 8 && Tcl_GetDouble(interp, argv[7], &errorTol) != TCL_OK)
+          return TCL_ERROR;
 
-        if (theVariableTimeStepTransientAnalysis != nullptr)
+        if (theVariableTimeStepTransientAnalysis != nullptr) {
+          theVariableTimeStepTransientAnalysis->setErrorTolerance(errorTol);
           result = theVariableTimeStepTransientAnalysis->analyze(
               numIncr, dT, dtMin, dtMax, Jd);
+        }
         else {
           opserr << G3_ERROR_PROMPT << "analyze - no variable time step transient analysis "
                     "object constructed\n";
@@ -213,6 +222,223 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc,
   return TCL_OK;
 }
 
+//
+// Run the current analysis until the domain time (the load factor for a
+// static analysis) reaches a target, without going back to the interpreter
+// at every step.
+//
+//   analyzeTo target ?-dt dt? ?-maxSteps n? ?-divide n levels?
+//                    ?-fallback {script ...}? ?-restore script?
+//                    ?-stopDisp node dof limit ...?
+//
+// When a step fails, it is retried with dt/n, dt/n^2, ... (transient only,
+// up to levels times), then once after each fallback script in turn. If a
+// fallback was needed, the restore script runs after the step succeeds.
+// The analysis stops early once any |u(node,dof)| exceeds its limit.
+//
+// The result is 0 when the target is reached, 1 when a stop condition or
+// maxSteps ended the run, and the failed analyze() code otherwise.
+//
+struct StopDisp {
+  int node, dof;
+  double limit;
+};
+
+static int
+analyzeSubdivided(BasicAnalysisBuilder *builder, int level, int numLevels,
+                  int numDivisions, double dT)
+{
+  int result = builder->analyze(1, dT);
+  if (result >= 0 || level >= numLevels || numDivisions < 2)
+    return result;
+
+  for (int i = 0; i < numDivisions; i++) {
+    result = analyzeSubdivided(builder, level+1, numLevels, numDivisions, dT/numDivisions);
+    if (result < 0)
+      return result;
+  }
+  return result;
+}
+
+static int
+analyzeTo(ClientData clientData, Tcl_Interp *interp, int argc,
+          TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+  Domain *domain = builder->getDomain();
+
+  bool isTransient = false;
+  switch (builder->CurrentAnalysisFlag) {
+    case BasicAnalysisBuilder::STATIC_ANALYSIS:
+      break;
+    case BasicAnalysisBuilder::TRANSIENT_ANALYSIS:
+      isTransient = true;
+      break;
+    default:
+      opserr << G3_ERROR_PROMPT << "No Analysis type has been specified \n";
+      return TCL_ERROR;
+  }
+
+  if (argc < 2) {
+    opserr << G3_ERROR_PROMPT << "analyzeTo target? <-dt dt> ...\n";
+    return TCL_ERROR;
+  }
+
+  double target;
+  if (Tcl_GetDouble(interp, argv[1], &target) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "invalid target " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  double dT = 0.0;
+  int maxSteps = 0;
+  int numDivisions = 0, numLevels = 0;
+  const char *restore = nullptr;
+  int numFallbacks = 0;
+  const char **fallbacks = nullptr;
+  std::vector<StopDisp> stops;
+
+  for (int argi = 2; argi < argc; argi++) {
+    if (strcmp(argv[argi], "-dt") == 0 && argi+1 < argc) {
+      if (Tcl_GetDouble(interp, argv[++argi], &dT) != TCL_OK || dT <= 0.0) {
+        opserr << G3_ERROR_PROMPT << "invalid -dt " << argv[argi] << "\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[argi], "-maxSteps") == 0 && argi+1 < argc) {
+      if (Tcl_GetInt(interp, argv[++argi], &maxSteps) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid -maxSteps " << argv[argi] << "\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[argi], "-divide") == 0 && argi+2 < argc) {
+      if (Tcl_GetInt(interp, argv[argi+1], &numDivisions) != TCL_OK ||
+          Tcl_GetInt(interp, argv[argi+2], &numLevels) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid -divide numDivisions? numLevels?\n";
+        return TCL_ERROR;
+      }
+      argi += 2;
+    }
+    else if (strcmp(argv[argi], "-fallback") == 0 && argi+1 < argc) {
+      if (fallbacks != nullptr)
+        Tcl_Free((char *)fallbacks);
+      if (Tcl_SplitList(interp, argv[++argi], &numFallbacks, &fallbacks) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-fallback expects a list of scripts\n";
+        return TCL_ERROR;
+      }
+    }
+    else if (strcmp(argv[argi], "-restore") == 0 && argi+1 < argc) {
+      restore = argv[++argi];
+    }
+    else if (strcmp(argv[argi], "-stopDisp") == 0 && argi+3 < argc) {
+      StopDisp stop;
+      if (Tcl_GetInt(interp, argv[argi+1], &stop.node) != TCL_OK ||
+          Tcl_GetInt(interp, argv[argi+2], &stop.dof) != TCL_OK ||
+          Tcl_GetDouble(interp, argv[argi+3], &stop.limit) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid -stopDisp node? dof? limit?\n";
+        if (fallbacks != nullptr)
+          Tcl_Free((char *)fallbacks);
+        return TCL_ERROR;
+      }
+      if (domain->getNode(stop.node) == nullptr || stop.dof < 1) {
+        opserr << G3_ERROR_PROMPT << "-stopDisp node " << stop.node 
+               << " dof " << stop.dof << " does not exist\n";
+        if (fallbacks != nullptr)
+          Tcl_Free((char *)fallbacks);
+        return TCL_ERROR;
+      }
+      stop.dof--;
+      stops.push_back(stop);
+      argi += 3;
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "analyzeTo - unknown option " << argv[argi] << "\n";
+      if (fallbacks != nullptr)
+        Tcl_Free((char *)fallbacks);
+      return TCL_ERROR;
+    }
+  }
+
+  if (isTransient && dT <= 0.0) {
+    opserr << G3_ERROR_PROMPT << "transient analysis: analyzeTo target? -dt dt?\n";
+    if (fallbacks != nullptr)
+      Tcl_Free((char *)fallbacks);
+    return TCL_ERROR;
+  }
+
+  // direction of the run and a tolerance on reaching the target
+  double start = domain->getCurrentTime();
+  double sign  = (target >= start) ? 1.0 : -1.0;
+  double tol   = 1.0e-10*(isTransient ? dT : (fabs(target - start) > 0.0 ? fabs(target - start) : 1.0));
+
+  int result = 0;
+  int numSteps = 0;
+  bool stopped = false;
+
+  while (sign*(target - domain->getCurrentTime()) > tol) {
+
+    if (maxSteps > 0 && numSteps >= maxSteps) {
+      stopped = true;
+      break;
+    }
+
+    // land on the target with the last transient step
+    double stepDT = 0.0;
+    if (isTransient) {
+      stepDT = target - domain->getCurrentTime();
+      if (stepDT > dT)
+        stepDT = dT;
+    }
+
+    result = isTransient ? analyzeSubdivided(builder, 0, numLevels, numDivisions, stepDT)
+                         : builder->analyze(1, 0.0);
+
+    // climb the fallback ladder
+    int rung = 0;
+    while (result < 0 && rung < numFallbacks) {
+      if (Tcl_Eval(interp, fallbacks[rung]) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "analyzeTo - fallback script " << rung+1 << " failed\n";
+        break;
+      }
+      result = isTransient ? analyzeSubdivided(builder, 0, numLevels, numDivisions, stepDT)
+                           : builder->analyze(1, 0.0);
+      rung++;
+    }
+
+    if (result < 0)
+      break;
+
+    if (rung > 0 && restore != nullptr && Tcl_Eval(interp, restore) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "analyzeTo - restore script failed\n";
+      if (fallbacks != nullptr)
+        Tcl_Free((char *)fallbacks);
+      return TCL_ERROR;
+    }
+
+    numSteps++;
+
+    for (const StopDisp &stop : stops) {
+      const Vector &disp = domain->getNode(stop.node)->getDisp();
+      if (stop.dof < disp.Size() && fabs(disp(stop.dof)) > stop.limit) {
+        stopped = true;
+        break;
+      }
+    }
+    if (stopped)
+      break;
+  }
+
+  if (fallbacks != nullptr)
+    Tcl_Free((char *)fallbacks);
+
+  if (result >= 0)
+    result = stopped ? 1 : 0;
+
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(result));
+  return TCL_OK;
+}
+
 
 static int
 initializeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
@@ -20,6 +20,7 @@ static Tcl_CmdProc printB;
 static Tcl_CmdProc initializeAnalysis;
 static Tcl_CmdProc resetModel;
 static Tcl_CmdProc analyzeModel;
+static Tcl_CmdProc analyzeTo;
 static Tcl_CmdProc specifyConstraintHandler;
 static Tcl_CmdProc modalDamping;
 
@@ -60,6 +61,7 @@ struct char_cmd {
     {"analysis",            &specifyAnalysis},
 
     {"analyze",             &analyzeModel},
+    {"analyzeTo",           &analyzeTo},
     {"initialize",          &initializeAnalysis},
     {"modalProperties",     &modalProperties},
     {"modalDamping",        &modalDamping},
@@ -14,6 +14,7 @@
 #include <DOF_Numberer.h>
 #include <RCM.h>
 #include <AMDNumberer.h>
+#include <NestedDissectionNumberer.h>
 
 #if defined(_PARALLEL_PROCESSING) || defined(_PARALLEL_INTERPRETERS)
 #  include <ParallelNumberer.h>
@@ -54,13 +55,32 @@ TclCommand_setNumberer(ClientData clientData, Tcl_Interp* interp, int argc, TCL_
   if (strcmp(argv[1], "Plain") == 0) {
     theNumberer = new PlainNumberer();
 
-  } else if (strcmp(argv[1], "RCM") == 0) {
-    RCM *theRCM = new RCM(false);
-    theNumberer = new DOF_Numberer(*theRCM);
+  } else if (strcmp(argv[1], "RCM") == 0 || strcmp(argv[1], "AMD") == 0) {
+    GraphNumberer *theGN = nullptr;
+    if (strcmp(argv[1], "RCM") == 0)
+      theGN = new RCM(false);
+    else
+      theGN = new AMD();
+
+    // numberer RCM|AMD <-warmStart tol>
+    for (int i = 2; i < argc; i++) {
+      if (strcmp(argv[i], "-warmStart") == 0) {
+        double tol;
+        if (i + 1 >= argc || Tcl_GetDouble(interp, argv[i + 1], &tol) != TCL_OK) {
+          opserr << "WARNING numberer " << argv[1] << " -warmStart tol - invalid tol\n";
+          delete theGN;
+          return TCL_ERROR;
+        }
+        theGN->setWarmStart(tol);
+        i++;
+      }
+    }
+    theNumberer = new DOF_Numberer(*theGN);
 
-  } else if (strcmp(argv[1], "AMD") == 0) {
-    AMD *theAMD = new AMD();
-    theNumberer = new DOF_Numberer(*theAMD);
+  } else if (strcmp(argv[1], "ND") == 0 ||
+             strcmp(argv[1], "NestedDissection") == 0) {
+    NestedDissection *theND = new NestedDissection();
+    theNumberer = new DOF_Numberer(*theND);
   }
 
 #  ifdef _PARALLEL_INTERPRETERS
@@ -70,6 +70,29 @@ TclCommand_updateMaterialStage(ClientData clientData,
     return TCL_ERROR;
   }
 
+  if (strcmp(argv[3], "-stage") != 0) {
+    opserr
+        << "WARNING UpdateMaterialStage: Only accept parameter '-stage' for now"
+        << endln;
+    return TCL_ERROR;
+  }
+
+  if (Tcl_GetInt(interp, argv[4], &value) != TCL_OK) {
+    opserr << "WARNING UpdateMaterialStage: invalid parameter value" << endln;
+    return TCL_ERROR;
+  }
+
+  // without a parameter tag, a stage kept per material tag is switched
+  // directly, without a MaterialStageParameter visiting the elements
+  if (argc < 7) {
+    NDMaterial *theMaterial = builder->getTypedObject<NDMaterial>(
+        materialTag, BasicModelBuilder::SilentLookup);
+    if (theMaterial != nullptr && theMaterial->setMaterialStage(value) == 1) {
+      domain->parameterChange();
+      return TCL_OK;
+    }
+  }
+
   int parTag = domain->getNumParameters();
   parTag++;
 
@@ -92,18 +115,6 @@ TclCommand_updateMaterialStage(ClientData clientData,
     return TCL_ERROR;
   }
 
-  if (strcmp(argv[3], "-stage") != 0) {
-    opserr
-        << "WARNING UpdateMaterialStage: Only accept parameter '-stage' for now"
-        << endln;
-    return TCL_ERROR;
-  }
-
-  if (Tcl_GetInt(interp, argv[4], &value) != TCL_OK) {
-    opserr << "WARNING UpdateMaterialStage: invalid parameter value" << endln;
-    return TCL_ERROR;
-  }
-
   domain->updateParameter(parTag, value);
 
   domain->removeParameter(parTag);
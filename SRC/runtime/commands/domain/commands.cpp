@@ -94,6 +94,8 @@ G3_AddTclDomainCommands(Tcl_Interp *interp, Domain* the_domain)
   Tcl_CreateCommand(interp, "region",              &TclCommand_addMeshRegion, domain, nullptr);
 
   Tcl_CreateCommand(interp, "printGID",            &printModelGID, domain, nullptr);
+  Tcl_CreateCommand(interp, "saveModel",           &TclCommand_saveModel, domain, nullptr);
+  Tcl_CreateCommand(interp, "loadModel",           &TclCommand_loadModel, domain, nullptr);
 
   Tcl_CreateCommand(interp, "setTime",             &TclCommand_setTime,  domain, nullptr);
   Tcl_CreateCommand(interp, "getTime",             &TclCommand_getTime,  domain, nullptr);
@@ -47,6 +47,10 @@ Tcl_CmdProc getLoadFactor;
 
 Tcl_CmdProc printModelGID;
 
+// domain/model_file.cpp
+Tcl_CmdProc TclCommand_saveModel;
+Tcl_CmdProc TclCommand_loadModel;
+
 Tcl_CmdProc TclAddRecorder;
 
 Tcl_CmdProc addAlgoRecorder;
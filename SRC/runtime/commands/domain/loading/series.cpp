@@ -457,6 +457,7 @@ TclDispatch_newTimeSeries(ClientData clientData, Tcl_Interp *interp, int argc, T
     Vector *dataTime = nullptr;
     bool useLast = false;
     bool prependZero = false;
+    bool binaryFile = false;
     double startTime = 0.0;
 
     struct stat fileInfo;
@@ -515,8 +516,10 @@ TclDispatch_newTimeSeries(ClientData clientData, Tcl_Interp *interp, int argc, T
         }
       }
 
-      else if (strcmp(argv[endMarker], "-filePath") == 0) {
+      else if (strcmp(argv[endMarker], "-filePath") == 0 ||
+               strcmp(argv[endMarker], "-filePathBinary") == 0) {
         // allow user to specify the file name containing the data points
+        binaryFile = (strcmp(argv[endMarker], "-filePathBinary") == 0);
         endMarker++;
         if (endMarker != argc) {
           filePathName = endMarker; // argv[endMarker];
@@ -634,7 +637,7 @@ TclDispatch_newTimeSeries(ClientData clientData, Tcl_Interp *interp, int argc, T
 
     if (filePathName != 0 && fileTimeName == 0 && timeIncr != 0.0) {
       theSeries = new PathSeries(tag, argv[filePathName], timeIncr, cFactor,
-                                 useLast, prependZero, startTime);
+                                 useLast, prependZero, startTime, binaryFile);
     }
 
     else if (fileName != 0) {
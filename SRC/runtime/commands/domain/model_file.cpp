@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Commands that write the domain to a binary model file and
+// read it back, so that a model built once by a script can be reloaded
+// without interpreting the script again:
+//
+//   saveModel $fileName
+//   loadModel $fileName
+//
+// The file is written by a CheckpointDatastore holding a single commit of
+// the domain, so nodes, elements (with their materials and sections),
+// constraints and load patterns are stored through their sendSelf()
+// methods as contiguous binary records, and are read back in one go and
+// rebuilt in the domain by Domain::recvSelf(). Materials and sections
+// defined in the model builder but not used by an element are not saved.
+//
+#include <assert.h>
+#include <tcl.h>
+#include <G3_Logging.h>
+#include <stdio.h>
+#include <Domain.h>
+#include <CheckpointDatastore.h>
+#include <TclPackageClassBroker.h>
+
+static const int modelCommitTag = 0;
+
+int
+TclCommand_saveModel(ClientData clientData, Tcl_Interp *interp, int argc,
+                     TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  Domain *theDomain = (Domain *)clientData;
+
+  if (argc < 2) {
+    opserr << G3_ERROR_PROMPT << "want saveModel fileName\n";
+    return TCL_ERROR;
+  }
+
+  // a model file only ever holds one commit
+  remove(argv[1]);
+
+  TclPackageClassBroker theBroker;
+  CheckpointDatastore theFile(argv[1], *theDomain, theBroker);
+  if (theFile.commitState(modelCommitTag) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to write the model to file " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+int
+TclCommand_loadModel(ClientData clientData, Tcl_Interp *interp, int argc,
+                     TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  Domain *theDomain = (Domain *)clientData;
+
+  if (argc < 2) {
+    opserr << G3_ERROR_PROMPT << "want loadModel fileName\n";
+    return TCL_ERROR;
+  }
+
+  TclPackageClassBroker theBroker;
+  CheckpointDatastore theFile(argv[1], *theDomain, theBroker);
+  if (theFile.getLastCommitTag() != modelCommitTag) {
+    opserr << G3_ERROR_PROMPT << "file " << argv[1] << " is not a model file\n";
+    return TCL_ERROR;
+  }
+
+  if (theFile.restoreState(modelCommitTag) < 0) {
+    opserr << G3_ERROR_PROMPT << "failed to read the model from file " << argv[1] << "\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
@@ -16,6 +16,7 @@ extern Tcl_CmdProc  buildModel;
 extern Tcl_CmdProc  TclCommand_getNDM;
 extern Tcl_CmdProc  TclCommand_getNDF;
 extern Tcl_CmdProc  TclCommand_addNode;
+extern Tcl_CmdProc  TclCommand_addNodes;
 extern Tcl_CmdProc  TclCommand_addNodalMass;
 extern Tcl_CmdProc  TclCommand_addNodalLoad;
 // 
@@ -94,6 +95,7 @@ struct char_cmd {
   {"getNDM",               TclCommand_getNDM},
   {"getNDF",               TclCommand_getNDF},
   {"node",                 TclCommand_addNode},
+  {"nodes",                TclCommand_addNodes},
   {"mass",                 TclCommand_addNodalMass},
   {"element",              TclCommand_addElement},
 
@@ -232,6 +232,95 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
   return TCL_OK;
 }
 
+//
+// nodes $tags $coords <-ndf ndf>
+//
+// creates many nodes at once from a list of n tags and a list of the
+// n*ndm coordinates, node after node
+//
+int
+TclCommand_addNodes(ClientData clientData, Tcl_Interp *interp, int argc,
+                    TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+
+  BasicModelBuilder *builder = static_cast<BasicModelBuilder*>(clientData);
+
+  Domain *theTclDomain = builder->getDomain();
+
+  int ndm = builder->getNDM();
+  int ndf = builder->getNDF();
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "insufficient arguments, expected:\n";
+    opserr << "      nodes tags? coords? <-ndf ndf?>\n";
+    return TCL_ERROR;
+  }
+
+  if (argc > 4 && strcmp(argv[3], "-ndf") == 0) {
+    if (Tcl_GetInt(interp, argv[4], &ndf) != TCL_OK || ndf <= 0) {
+      opserr << G3_ERROR_PROMPT << "invalid ndf\n";
+      return TCL_ERROR;
+    }
+  }
+
+  int numTags, numCrds;
+  TCL_Char **tags, **crds;
+  if (Tcl_SplitList(interp, argv[1], &numTags, &tags) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "tags is not a list\n";
+    return TCL_ERROR;
+  }
+  if (Tcl_SplitList(interp, argv[2], &numCrds, &crds) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "coords is not a list\n";
+    Tcl_Free((char *)tags);
+    return TCL_ERROR;
+  }
+
+  int status = TCL_OK;
+  if (numCrds != numTags*ndm) {
+    opserr << G3_ERROR_PROMPT << numTags << " tags need " << numTags*ndm
+           << " coordinates, " << numCrds << " given\n";
+    status = TCL_ERROR;
+  } else
+    theTclDomain->reserveNodes(numTags);
+
+  double x[3] = {0.0, 0.0, 0.0};
+  for (int i = 0; i < numTags && status == TCL_OK; i++) {
+    int nodeId;
+    if (Tcl_GetInt(interp, tags[i], &nodeId) != TCL_OK) {
+      opserr << G3_ERROR_PROMPT << "invalid nodeTag " << tags[i] << "\n";
+      status = TCL_ERROR;
+      break;
+    }
+    for (int j = 0; j < ndm; j++)
+      if (Tcl_GetDouble(interp, crds[i*ndm+j], &x[j]) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "invalid coordinate for node " << nodeId << "\n";
+        status = TCL_ERROR;
+        break;
+      }
+    if (status != TCL_OK)
+      break;
+
+    Node *theNode;
+    if (ndm == 1)
+      theNode = new Node(nodeId, ndf, x[0]);
+    else if (ndm == 2)
+      theNode = new Node(nodeId, ndf, x[0], x[1]);
+    else
+      theNode = new Node(nodeId, ndf, x[0], x[1], x[2]);
+
+    if (theTclDomain->addNode(theNode) == false) {
+      opserr << G3_ERROR_PROMPT << "failed to add node " << nodeId << " to the domain\n";
+      delete theNode;
+      status = TCL_ERROR;
+    }
+  }
+
+  Tcl_Free((char *)tags);
+  Tcl_Free((char *)crds);
+  return status;
+}
+
 int
 TclCommand_addNodalMass(ClientData clientData, Tcl_Interp *interp, int argc,
                         TCL_Char ** const argv)
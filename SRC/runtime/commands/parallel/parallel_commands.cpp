@@ -44,6 +44,8 @@
    DomainPartitioner     *OPS_DOMAIN_PARTITIONER = nullptr;
    GraphPartitioner      *OPS_GRAPH_PARTITIONER  = nullptr;
    LoadBalancer          *OPS_BALANCER           = nullptr;
+   int                   OPS_BALANCE_COMMITS     = 0;  // commits between balance checks
+   double                OPS_BALANCE_RATIO       = 0.0;
    TclPackageClassBroker *OPS_OBJECT_BROKER      = nullptr;
    MachineBroker         *OPS_MACHINE            = nullptr;
    Channel               **OPS_theChannels       = nullptr;  
@@ -140,11 +142,13 @@ partitionModel(int eleTag)
 
   // create a partitioner & partition the domain
   if (OPS_DOMAIN_PARTITIONER == nullptr) {
-    //      OPS_BALANCER = new ShedHeaviest();
     OPS_GRAPH_PARTITIONER = new Metis;
-    // OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER,
-    // *OPS_BALANCER);
-    OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+    if (OPS_BALANCE_COMMITS > 0) {
+      OPS_BALANCER = new ShedHeaviest();
+      OPS_DOMAIN_PARTITIONER =
+          new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+    } else
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
     theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
   }
 
@@ -156,6 +160,9 @@ partitionModel(int eleTag)
 
   OPS_PARTITIONED = true;
 
+  if (OPS_BALANCE_COMMITS > 0)
+    theDomain.setLoadBalancing(OPS_BALANCE_COMMITS, OPS_BALANCE_RATIO);
+
   DomainDecompositionAnalysis *theSubAnalysis;
   SubdomainIter &theSubdomains = theDomain.getSubdomains();
   Subdomain *theSub = 0;
@@ -325,11 +332,22 @@ opsPartition(ClientData clientData, Tcl_Interp *interp, int argc,
              TCL_Char ** const argv)
 {
 #ifdef _PARALLEL_SP
-  int eleTag;
-  if (argc == 2) {
-    if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
+  // partition <eleTag> <-balance numCommits maxOverMeanCost>
+  int eleTag = 0;
+  int argi = 1;
+  if (argi < argc && strcmp(argv[argi], "-balance") != 0) {
+    if (Tcl_GetInt(interp, argv[argi], &eleTag) != TCL_OK) {
       ;
     }
+    argi++;
+  }
+  if (argi < argc && strcmp(argv[argi], "-balance") == 0) {
+    if (argi+2 >= argc ||
+        Tcl_GetInt(interp, argv[argi+1], &OPS_BALANCE_COMMITS) != TCL_OK ||
+        Tcl_GetDouble(interp, argv[argi+2], &OPS_BALANCE_RATIO) != TCL_OK) {
+      opserr << "WARNING partition <eleTag> -balance numCommits ratio\n";
+      return TCL_ERROR;
+    }
   }
   partitionModel(eleTag);
 #endif
@@ -409,6 +409,7 @@ using namespace OpenSees::Hash::literals;
 #include "NewtonLineSearch.h"
 #include "KrylovNewton.h"
 #include "AcceleratedNewton.h"
+#include "AdaptiveNewton.h"
 #include "ModifiedNewton.h"
 
 #include "accelerator/KrylovAccelerator.h"
@@ -460,6 +461,7 @@ using namespace OpenSees::Hash::literals;
 #include "KRAlphaExplicit.h"
 #include "KRAlphaExplicit_TP.h"
 #include "Newmark.h"
+#include "ImplicitExplicit.h"
 // #include "StagedNewmark.h"
 #include "NewmarkExplicit.h"
 #include "NewmarkHSFixedNumIter.h"
@@ -1770,6 +1772,9 @@ TclPackageClassBroker::getNewEquiSolnAlgo(int classTag)
   case EquiALGORITHM_TAGS_AcceleratedNewton:
     return new AcceleratedNewton();
 
+  case EquiALGORITHM_TAGS_AdaptiveNewton:
+    return new AdaptiveNewton();
+
   case EquiALGORITHM_TAGS_ModifiedNewton:
     return new ModifiedNewton(CURRENT_TANGENT);
 
@@ -1954,6 +1959,8 @@ TclPackageClassBroker::getNewTransientIntegrator(int classTag)
 
   case INTEGRATOR_TAGS_Newmark:
     return new Newmark();
+  case INTEGRATOR_TAGS_ImplicitExplicit:
+    return new ImplicitExplicit();
 #if 0
   case INTEGRATOR_TAGS_StagedNewmark:
     return new StagedNewmark();
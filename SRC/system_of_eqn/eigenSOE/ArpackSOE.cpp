@@ -27,6 +27,7 @@
 //
 // Description: This file contains the class definition for ArpackSOE
 
+#include <algorithm>
 #include <ArpackSOE.h>
 #include <ArpackSolver.h>
 #include <Matrix.h>
@@ -39,12 +40,36 @@
 #include <FEM_ObjectBroker.h>
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
+#include <LinearSOESolver.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <string.h>
+
+#define ARPACK_HASH_SEED  14695981039346656037ULL
+#define ARPACK_HASH_PRIME 1099511628211ULL
+
+static inline unsigned long long
+hashWord(unsigned long long h, unsigned long long w)
+{
+  return (h ^ w) * ARPACK_HASH_PRIME;
+}
 
+static inline unsigned long long
+hashDouble(unsigned long long h, double d)
+{
+  unsigned long long w;
+  memcpy(&w, &d, sizeof(w));
+  return hashWord(h, w);
+}
 
 
 ArpackSOE::ArpackSOE(double s)
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
  M(0), Msize(0), mDiagonal(false), shift(s), theModel(0), theSOE(0),
+ hashA(ARPACK_HASH_SEED), hashFactored(0), holdA(false), factoredValid(false),
+ massInA(false), numSymbolic(0), numNumeric(0), numEqnFactored(0),
  processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
@@ -145,6 +170,10 @@ ArpackSOE::setSize(Graph &theGraph)
   }
   */
 
+  // a new numbering, the factorization in theSOE is not ours any more
+  factoredValid = false;
+  holdA = false;
+
   if (size != Msize && size > 0) {
 
     if (M != 0) 
@@ -190,6 +219,16 @@ ArpackSOE::addA(const Matrix &m, const ID &id, double fact)
   // check for a quick return 
   if (fact == 0.0)  return 0;
 
+  int idSize = id.Size();
+  for (int i=0; i<idSize; i++) {
+    hashA = hashWord(hashA, (unsigned long long)(long long)id(i));
+    for (int j=0; j<idSize; j++)
+      hashA = hashDouble(hashA, fact*m(i,j));
+  }
+
+  if (holdA == true)
+    return 0;
+
   return theSOE->addA(m, id, fact);
 }
 
@@ -201,7 +240,116 @@ ArpackSOE::zeroA(void)
     opserr << "ArpackSOE::zeroA() - no SOE set\n";
     return;
   }
-  return theSOE->zeroA();
+
+  hashA = hashWord(ARPACK_HASH_SEED, (unsigned long long)(long long)theSOE->getNumEqn());
+  hashA = hashDouble(hashA, shift);
+
+  // if theSOE has not been factored since our last solve it may still hold
+  // the factors of the operator about to be assembled; the contributions
+  // are then only fingerprinted until formA() can compare
+  holdA = false;
+  if (factoredValid == true && processID == -1) {
+    LinearSOESolver *theSolver = theSOE->getSolver();
+    if (theSolver != 0 &&
+	theSolver->getNumNumericFactor() == numNumeric &&
+	theSolver->getNumSymbolicFactor() == numSymbolic &&
+	theSOE->getNumEqn() == numEqnFactored)
+      holdA = true;
+  }
+
+  if (holdA == false) {
+    factoredValid = false;
+    theSOE->zeroA();
+  }
+}
+
+
+// returns 1 if the factorization held by theSOE is for the operator just
+// assembled, 0 if theSOE has to factor; when the contributions were held back
+// and the operator has changed they are formed again and passed on
+int
+ArpackSOE::formA(void)
+{
+  if (theSOE == 0)
+    return -1;
+
+  if (holdA == false)
+    return 0;
+
+  holdA = false;
+
+  LinearSOESolver *theSolver = theSOE->getSolver();
+  if (hashA == hashFactored && theSolver != 0 &&
+      theSolver->getNumNumericFactor() == numNumeric &&
+      theSolver->getNumSymbolicFactor() == numSymbolic)
+    return 1;
+
+  factoredValid = false;
+  theSOE->zeroA();
+
+  int result = 0;
+  FE_Element *elePtr;
+  FE_EleIter &theEles = theModel->getFEs();
+  while ((elePtr = theEles()) != 0) {
+    elePtr->zeroTangent();
+    elePtr->addKtToTang(1.0);
+    if (theSOE->addA(elePtr->getTangent(0), elePtr->getID()) < 0)
+      result = -1;
+  }
+
+  if (massInA == true) {
+    FE_EleIter &theEles2 = theModel->getFEs();
+    while ((elePtr = theEles2()) != 0) {
+      elePtr->zeroTangent();
+      elePtr->addMtoTang(1.0);
+      if (theSOE->addA(elePtr->getTangent(0), elePtr->getID(), -shift) < 0)
+	result = -1;
+    }
+
+    DOF_Group *dofPtr;
+    DOF_GrpIter &theDofs = theModel->getDOFs();
+    while ((dofPtr = theDofs()) != 0) {
+      dofPtr->zeroTangent();
+      dofPtr->addMtoTang(1.0);
+      if (theSOE->addA(dofPtr->getTangent(0), dofPtr->getID(), -shift) < 0)
+	result = -1;
+    }
+  }
+
+  if (result < 0)
+    opserr << "WARNING ArpackSOE::formA() - failed to add to the LinearSOE\n";
+
+  return result;
+}
+
+
+// to be called after theSOE has solved with the operator last assembled; the
+// factorization is only trusted for reuse if the solver counts it
+void
+ArpackSOE::factoredA(void)
+{
+  if (factoredValid == true && hashFactored == hashA)
+    return;
+
+  factoredValid = false;
+
+  LinearSOESolver *theSolver = theSOE->getSolver();
+  if (theSolver == 0 || processID != -1)
+    return;
+
+  if (theSolver->getNumNumericFactor() > numNumeric ||
+      theSolver->getNumSymbolicFactor() > numSymbolic) {
+    numNumeric = theSolver->getNumNumericFactor();
+    numSymbolic = theSolver->getNumSymbolicFactor();
+    numEqnFactored = theSOE->getNumEqn();
+    hashFactored = hashA;
+    factoredValid = true;
+  } else {
+    // the counts did not move; the solver does not report its
+    // factorizations (or they were reset) so nothing is kept
+    numNumeric = theSolver->getNumNumericFactor();
+    numSymbolic = theSolver->getNumSymbolicFactor();
+  }
 }
 
 int 
@@ -217,10 +365,30 @@ ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
   if (res < 0)
     return res;
 
+  if (shift != 0.0)
+    massInA = true;
+
+  int idSize = id.Size();
+
+  // keep the entries for the compressed row copy of M
+  for (int i=0; i<idSize; i++) {
+    int locI = id(i);
+    if (locI < 0 || locI >= Msize)
+      continue;
+    for (int j=0; j<idSize; j++) {
+      int locJ = id(j);
+      double mij = m(i,j);
+      if (locJ >= 0 && locJ < Msize && mij != 0.0) {
+	mRow.push_back(locI);
+	mCol.push_back(locJ);
+	mVal.push_back(fact*mij);
+      }
+    }
+  }
+
   if (mDiagonal == false)
     return  res;
 
-  int idSize = id.Size();
   for (int i=0; i<idSize; i++) {
     int locI = id(i);
     if (locI >= 0 && locI < Msize) {
@@ -228,7 +396,7 @@ ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
 	int locJ = id(j);
 	if (locJ >= 0 && locJ < Msize) {
 	  if (locI == locJ) {
-	    M[locI] += m(i,i);
+	    M[locI] += fact*m(i,i);
 	  } else {
 	    if (m(i,j) != 0.0) {
 	      mDiagonal = false;
@@ -252,9 +420,69 @@ ArpackSOE::zeroM(void)
   }
 
   mDiagonal = true;
+  massInA = false;
 
   for (int i=0; i<Msize; i++)
     M[i] = 0;
+
+  mRow.clear();
+  mCol.clear();
+  mVal.clear();
+  mRowStart.clear();
+  mColIndex.clear();
+  mValues.clear();
+}
+
+
+// compresses the triplets gathered since zeroM() into rows with sorted,
+// distinct columns; nothing is done if M is diagonal
+int
+ArpackSOE::formM(void)
+{
+  if (mDiagonal == true || mRow.empty())
+    return 0;
+
+  int n = Msize;
+  int numT = mRow.size();
+
+  mRowStart.assign(n+1, 0);
+  for (int k=0; k<numT; k++)
+    mRowStart[mRow[k]+1]++;
+  for (int i=0; i<n; i++)
+    mRowStart[i+1] += mRowStart[i];
+
+  std::vector<int> next(mRowStart.begin(), mRowStart.end()-1);
+  std::vector<std::pair<int,double> > entries(numT);
+  for (int k=0; k<numT; k++)
+    entries[next[mRow[k]]++] = std::pair<int,double>(mCol[k], mVal[k]);
+
+  mColIndex.resize(numT);
+  mValues.resize(numT);
+  int nnz = 0;
+  for (int i=0; i<n; i++) {
+    int rowBegin = nnz;
+    std::sort(entries.begin()+mRowStart[i], entries.begin()+mRowStart[i+1]);
+    for (int k=mRowStart[i]; k<mRowStart[i+1]; k++) {
+      if (nnz > rowBegin && mColIndex[nnz-1] == entries[k].first) {
+	mValues[nnz-1] += entries[k].second;
+      } else {
+	mColIndex[nnz] = entries[k].first;
+	mValues[nnz] = entries[k].second;
+	nnz++;
+      }
+    }
+    mRowStart[i] = rowBegin;
+  }
+  mRowStart[n] = nnz;
+  mColIndex.resize(nnz);
+  mValues.resize(nnz);
+
+  // the triplets are not needed again until the next zeroM()
+  std::vector<int>().swap(mRow);
+  std::vector<int>().swap(mCol);
+  std::vector<double>().swap(mVal);
+
+  return 0;
 }
 
 
@@ -26,6 +26,12 @@
 // Created: 05/09
 //
 // Description: This file contains the class definition for ArpackSOE
+//
+// The shifted stiffness K - shift*M goes to the LinearSOE. A fingerprint of
+// what is assembled is kept so that when the next eigen() assembles the
+// same operator, and the LinearSOE has not been factored since, the
+// existing factorization is used again. A non-diagonal M is stored in
+// compressed row form for the products the solver needs.
 
 
 #ifndef ArpackSOE_h
@@ -33,6 +39,7 @@
 
 #include "eigenSOE/EigenSOE.h"
 #include <Vector.h>
+#include <vector>
 
 class AnalysisModel;
 class ArpackSolver;
@@ -66,6 +73,11 @@ class ArpackSOE : public EigenSOE
 
 	int checkSameInt(int);
 
+    // to be called by the solver before the LinearSOE is used
+    int formA(void);
+    void factoredA(void);
+    int formM(void);
+
   protected:
     
   private:
@@ -76,6 +88,21 @@ class ArpackSOE : public EigenSOE
     AnalysisModel *theModel;
     LinearSOE *theSOE;
 
+    // operator reuse
+    unsigned long long hashA;     // fingerprint of the contributions to A
+    unsigned long long hashFactored;
+    bool holdA;                   // contributions held back from theSOE
+    bool factoredValid;           // theSOE still holds the factors of hashFactored
+    bool massInA;                 // -shift*M was added since zeroM()
+    int numSymbolic, numNumeric;  // solver counts when it was factored
+    int numEqnFactored;
+
+    // M in compressed row storage, built from triplets gathered by addM()
+    std::vector<int> mRow, mCol;
+    std::vector<double> mVal;
+    std::vector<int> mRowStart, mColIndex;
+    std::vector<double> mValues;
+
     int processID;
     int numChannels;
     Channel **theChannels;
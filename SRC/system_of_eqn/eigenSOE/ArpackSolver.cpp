@@ -60,15 +60,20 @@
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 using namespace std;
 
+#ifdef _PARPACK
+#include <mpi.h>
+#endif
+
 static double *workArea = 0;
 static int sizeWork = 0;
 
 ArpackSolver::ArpackSolver()
 :EigenSolver(EigenSOLVER_TAGS_ArpackSolver),
  theSOE(0), numModesMax(0), numMode(0), size(0),
- eigenvalues(0), eigenvectors(0), 
+ eigenvalues(0), eigenvectors(0), ncv(0), sizeAlloc(0),
  v(0), workl(0), workd(0), resid(0), select(0)
 {
   // do nothing here.    
@@ -129,6 +134,20 @@ extern "C" int dseupd_(bool *rvec, char *howmny, logical *select, double *d, dou
 		       double *workl, int *lworkl, int *info);
 #endif
 
+#ifdef _PARPACK
+
+extern "C" int pdsaupd_(MPI_Fint *comm, int *ido, char* bmat, int *n, char *which, int *nev, 
+			double *tol, double *resid, int *ncv, double *v, int *ldv,
+			int *iparam, int *ipntr, double *workd, double *workl,
+			int *lworkl, int *info);
+
+extern "C" int pdseupd_(MPI_Fint *comm, int *rvec, char *howmny, int *select, double *d, double *z,
+			int *ldz, double *sigma, char *bmat, int *n, char *which,
+			int *nev, double *tol, double *resid, int *ncv, double *v,
+			int *ldv, int *iparam, int *ipntr, double *workd, 
+			double *workl, int *lworkl, int *info);
+#endif
+
 
 
 
@@ -146,6 +165,11 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
     opserr << "ArpackSolver::setSize() - no LinearSOE set\n";
     return -1;
   }
+
+#ifdef _PARPACK
+  if (theArpackSOE->processID != -1)
+    return this->solveDistributed(numModes, findSmallest);
+#endif
   
   // set up the space for ARPACK functions.
   // this is done each time method is called!! .. this needs to be cleaned up
@@ -158,9 +182,8 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
 
   int processID = theArpackSOE->processID;
   
-  // set up the space for ARPACK functions.
-  // this is done each time method is called!! .. this needs to be cleaned up
-  if (numModes > numModesMax) {
+  // set up the space for ARPACK functions, kept while the size allows
+  if (numModes > numModesMax || n != sizeAlloc || eigenvalues == 0) {
     
     if (v != 0) delete [] v;
     if (workl != 0) delete [] workl;
@@ -187,7 +210,17 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
       v[i] = 0;
     
     numModesMax = numModes;
+    sizeAlloc = n;
+  }
+
+  // pass on, or reuse, the operator & build the compressed copy of M
+  int reuseA = theArpackSOE->formA();
+  if (reuseA < 0) {
+    opserr << "ArpackSolver::solve() - failed to form K - shift*M\n";
+    return -1;
   }
+  theArpackSOE->formM();
+  bool factoredA = false;
 
   char which[3];
   if (findSmallest == true) {
@@ -256,6 +289,10 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
 	theSOE->setB(theVector);
 
       ierr = theSOE->solve();
+      if (factoredA == false && ierr >= 0) {
+	theArpackSOE->factoredA();
+	factoredA = true;
+      }
       const Vector &X = theSOE->getX();
       theVector = X;
       
@@ -273,7 +310,11 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
       else
 	      theSOE->setB(theVector);
 
-      theSOE->solve();
+      ierr = theSOE->solve();
+      if (factoredA == false && ierr >= 0) {
+	theArpackSOE->factoredA();
+	factoredA = true;
+      }
    
       const Vector &X = theSOE->getX();
       theVector = X;
@@ -469,15 +510,14 @@ ArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
 }
 
 
+// ARPACK advises at least twice as many Lanczos vectors as modes; with
+// fewer the restarts dominate once a few hundred modes are wanted
 int 
 ArpackSolver::getNCV(int n, int nev)
 {
-  int result;
-  if (2*nev > nev+8) {
+  int result = 2*nev;
+  if (result < nev+8)
     result = nev+8;
-  } else {
-    result = 2*nev;
-  }
   
   if (result >= n) {
     result = n;
@@ -489,6 +529,36 @@ ArpackSolver::getNCV(int n, int nev)
 
 void
 ArpackSolver::myMv(int n, double *v, double *result)
+{
+  this->localMv(n, v, result);
+
+  // if paallel we have to merge the results
+  int processID = theArpackSOE->processID;
+  if (processID != -1) {
+    Vector y(result,n);
+    Channel **theChannels = theArpackSOE->theChannels;
+    int numChannels = theArpackSOE->numChannels;
+    if (processID != 0) {
+      theChannels[0]->sendVector(0, 0, y);
+      theChannels[0]->recvVector(0, 0, y);
+    } else {
+      Vector other(workArea, n);
+      // recv contribution from remote & add
+      for (int i=0; i<numChannels; i++) {
+	theChannels[i]->recvVector(0,0,other);
+	y += other;
+      }
+      // send result back
+      for (int i=0; i<numChannels; i++) {
+	theChannels[i]->sendVector(0,0,y);
+      }
+    }
+  }
+}
+
+// the product with the M assembled by this process only
+void
+ArpackSolver::localMv(int n, double *v, double *result)
 {
   Vector x(v, n);
   Vector y(result,n);
@@ -509,6 +579,7 @@ ArpackSolver::myMv(int n, double *v, double *result)
     */
 
     if (n <= Msize) {
+#pragma omp parallel for
       for (int i=0; i<n; i++)
 	result[i] = M[i]*v[i];
     } else {
@@ -516,6 +587,20 @@ ArpackSolver::myMv(int n, double *v, double *result)
       return;
     }
 
+  } else if ((int)theArpackSOE->mRowStart.size() == n+1) {
+
+    const int *rowStart = &(theArpackSOE->mRowStart[0]);
+    const int *col = theArpackSOE->mColIndex.empty() ? 0 : &(theArpackSOE->mColIndex[0]);
+    const double *val = theArpackSOE->mValues.empty() ? 0 : &(theArpackSOE->mValues[0]);
+
+#pragma omp parallel for
+    for (int i=0; i<n; i++) {
+      double sum = 0.0;
+      for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+	sum += val[k]*v[col[k]];
+      result[i] = sum;
+    }
+
   } else {
 
     y.Zero();
@@ -538,29 +623,159 @@ ArpackSolver::myMv(int n, double *v, double *result)
       y.Assemble(a, dofPtr->getID(), 1.0);
     }
   }
+}
 
-  // if paallel we have to merge the results
-  int processID = theArpackSOE->processID;
-  if (processID != -1) {
-    Channel **theChannels = theArpackSOE->theChannels;
-    int numChannels = theArpackSOE->numChannels;
-    if (processID != 0) {
-      theChannels[0]->sendVector(0, 0, y);
-      theChannels[0]->recvVector(0, 0, y);
-    } else {
-      Vector other(workArea, n);
-      // recv contribution from remote & add
-      for (int i=0; i<numChannels; i++) {
-	theChannels[i]->recvVector(0,0,other);
-	y += other;
-      }
-      // send result back
-      for (int i=0; i<numChannels; i++) {
-	theChannels[i]->sendVector(0,0,y);
-      }
+#ifdef _PARPACK
+
+// int solveDistributed(int numModes, bool findSmallest);
+//	the shift-invert Lanczos of solve() with the distributed ARPACK. The
+//	equations are split into contiguous blocks over the processes of
+//	MPI_COMM_WORLD, P0 being rank 0; a process keeps only its block of the
+//	Lanczos vectors. Products with M gather the block, multiply by the M
+//	of the process and sum the blocks back; the operator gathers the right
+//	hand side on P0 for the LinearSOE, whose solution is on all processes.
+
+int
+ArpackSolver::solveDistributed(int numModes, bool findSmallest)
+{
+  MPI_Comm theComm = MPI_COMM_WORLD;
+  MPI_Fint comm = MPI_Comm_c2f(theComm);
+  int rank, numP;
+  MPI_Comm_rank(theComm, &rank);
+  MPI_Comm_size(theComm, &numP);
+
+  int n = size;
+  std::vector<int> counts(numP), starts(numP);
+  for (int p=0, first=0; p<numP; p++) {
+    counts[p] = n/numP + ((p < n%numP) ? 1 : 0);
+    starts[p] = first;
+    first += counts[p];
+  }
+  int nLocal = counts[rank];
+  int first = starts[rank];
+
+  int nev = numModes;
+  int ncv = getNCV(n, nev);
+  int ldv = (nLocal > 0) ? nLocal : 1;
+  int lworkl = ncv*ncv + 8*ncv;
+
+  std::vector<double> vLocal(ldv*ncv, 0.0), worklLocal(lworkl+1, 0.0);
+  std::vector<double> workdLocal(3*ldv+1, 0.0), residLocal(ldv, 0.0);
+  std::vector<double> zLocal(ldv*nev, 0.0);
+  std::vector<int> selectLocal(ncv, 0);
+  std::vector<double> full(n), other(n);
+
+  // the results are kept in full on every process for getEigenvector()
+  if (eigenvalues != 0) delete [] eigenvalues;
+  if (eigenvectors != 0) delete [] eigenvectors;
+  eigenvalues = new double[nev];
+  eigenvectors = new double[n * nev];
+  sizeAlloc = 0;   // the serial work space is not ours any more
+
+  int reuseA = theArpackSOE->formA();
+  if (reuseA < 0) {
+    opserr << "ArpackSolver::solve() - failed to form K - shift*M\n";
+    return -1;
+  }
+  theArpackSOE->formM();
+  bool factoredA = false;
+
+  char which[3];
+  if (findSmallest == true)
+    strcpy(which, "LM");
+  else
+    strcpy(which, "SM");
+
+  char bmat = 'G';
+  char howmy = 'A';
+  double tol = 0.0;
+  int info = 0;
+
+  iparam[0] = 1;
+  iparam[2] = 1000;
+  iparam[6] = 3;
+
+  int ido = 0;
+
+  while (1) {
+
+    pdsaupd_(&comm, &ido, &bmat, &nLocal, which, &nev, &tol, &residLocal[0], 
+	     &ncv, &vLocal[0], &ldv, iparam, ipntr, &workdLocal[0], &worklLocal[0],
+	     &lworkl, &info);
+
+    if (ido != -1 && ido != 1 && ido != 2)
+      break;
+
+    double *x = &workdLocal[ipntr[0]-1];
+    double *y = &workdLocal[ipntr[1]-1];
+
+    // y = M x, or for ido 1 the M x ARPACK already has
+    double *mx = y;
+    if (ido == 1)
+      mx = &workdLocal[ipntr[2]-1];
+    else {
+      MPI_Allgatherv(x, nLocal, MPI_DOUBLE, &full[0], &counts[0], &starts[0], MPI_DOUBLE, theComm);
+      this->localMv(n, &full[0], &other[0]);
+      MPI_Reduce_scatter(&other[0], y, &counts[0], MPI_DOUBLE, MPI_SUM, theComm);
+    }
+
+    if (ido == 2)
+      continue;
+
+    // y = inv(K - shift*M) M x
+    MPI_Gatherv(mx, nLocal, MPI_DOUBLE, &full[0], &counts[0], &starts[0], MPI_DOUBLE, 0, theComm);
+
+    theVector.setData(&full[0], n);
+    if (theArpackSOE->processID > 0)
+      theSOE->zeroB();
+    else
+      theSOE->setB(theVector);
+
+    int ierr = theSOE->solve();
+    if (factoredA == false && ierr >= 0) {
+      theArpackSOE->factoredA();
+      factoredA = true;
     }
+
+    const Vector &X = theSOE->getX();
+    for (int i=0; i<nLocal; i++)
+      y[i] = X(first+i);
   }
+
+  if (info < 0) {
+    opserr << "ArpackSolver::Error with pdsaupd info = " << info << endln;
+    delete [] eigenvalues;
+    eigenvalues = 0;
+    delete [] eigenvectors;
+    eigenvectors = 0;
+    return info;
+  }
+
+  if (info == 1)
+    opserr << "ArpackSolver::Maximum number of iteration reached." << endln;
+  else if (info == 3)
+    opserr << "ArpackSolver::No Shifts could be applied during implicit, Arnoldi update, try increasing NCV." << endln;
+
+  int rvec = 1;
+  double sigma = shift;
+  pdseupd_(&comm, &rvec, &howmy, &selectLocal[0], eigenvalues, &zLocal[0], &ldv, &sigma, 
+	   &bmat, &nLocal, which, &nev, &tol, &residLocal[0], &ncv, &vLocal[0], &ldv, 
+	   iparam, ipntr, &workdLocal[0], &worklLocal[0], &lworkl, &info);
+
+  if (info != 0) {
+    opserr << "ArpackSolver::Error with pdseupd " << info << endln;
+    return info;
+  }
+
+  for (int j=0; j<nev; j++)
+    MPI_Allgatherv(&zLocal[j*ldv], nLocal, MPI_DOUBLE, &eigenvectors[j*n], 
+		   &counts[0], &starts[0], MPI_DOUBLE, theComm);
+
+  numMode = numModes;
+  return 0;
 }
+
+#endif
     
 void
 ArpackSolver::myCopy(int n, double *v, double *result)
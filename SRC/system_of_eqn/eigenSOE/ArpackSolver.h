@@ -39,6 +39,12 @@
 //
 // It is based on previous work of Jun Peng(Stanford)
 //
+// Built with _PARPACK for the parallel interpreter, the processes sharing
+// the ArpackSOE of a PartitionedDomain run the distributed ARPACK: each
+// holds a contiguous block of the Lanczos vectors instead of all of them,
+// the products with M are reduced onto the blocks and the operator is
+// applied by the distributed LinearSOE as before.
+//
 
 
 #ifndef ArpackSolver_h
@@ -82,6 +88,7 @@ class ArpackSolver : public EigenSolver
 
     double shift;
     int ncv;
+    int sizeAlloc;
     double *v;
     double *workl;
     double *workd;
@@ -92,6 +99,8 @@ class ArpackSolver : public EigenSolver
   int* select;
     
     void myMv(int n, double *v, double *result);
+    void localMv(int n, double *v, double *result);
+    int solveDistributed(int numModes, bool findSmallest);
     void myCopy(int n, double *v, double *result);
     int getNCV(int n, int nev);
 };
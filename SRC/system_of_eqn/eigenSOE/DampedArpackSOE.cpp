@@ -0,0 +1,294 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of DampedArpackSOE
+
+#include <algorithm>
+#include <DampedArpackSOE.h>
+#include <DampedArpackSolver.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <Graph.h>
+#include <LinearSOE.h>
+
+DampedArpackSOE::DampedArpackSOE()
+:EigenSOE(EigenSOE_TAGS_DampedArpackSOE),
+ size(0), theModel(0), theSOE(0)
+{
+  DampedArpackSolver *theSolvr = new DampedArpackSolver();
+  this->setSolver(*theSolvr);
+  theSolvr->setEigenSOE(*this);
+}
+
+
+DampedArpackSOE::~DampedArpackSOE()
+{
+
+}
+
+
+int
+DampedArpackSOE::getNumEqn(void) const
+{
+  return size;
+}
+
+
+int
+DampedArpackSOE::setSize(Graph &theGraph)
+{
+  if (theSOE == 0) {
+    opserr << "DampedArpackSOE::setSize() - no LinearSOE set\n";
+    return -1;
+  }
+
+  // the LinearSOE has been sized by the analysis for K
+  size = theGraph.getNumVertex();
+
+  M.zero();
+  C.zero();
+
+  EigenSolver *theSolvr = this->getSolver();
+  if (theSolvr == 0) {
+    opserr << "DampedArpackSOE::setSize() - no EigenSolver set\n";
+    return -1;
+  }
+
+  return theSolvr->setSize();
+}
+
+
+int
+DampedArpackSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+  if (theSOE == 0) {
+    opserr << "DampedArpackSOE::addA() - no LinearSOE set\n";
+    return -1;
+  }
+
+  return theSOE->addA(m, id, fact);
+}
+
+
+int
+DampedArpackSOE::addM(const Matrix &m, const ID &id, double fact)
+{
+  M.add(m, id, fact, size);
+  return 0;
+}
+
+
+int
+DampedArpackSOE::addC(const Matrix &m, const ID &id, double fact)
+{
+  C.add(m, id, fact, size);
+  return 0;
+}
+
+
+void
+DampedArpackSOE::zeroA(void)
+{
+  if (theSOE == 0) {
+    opserr << "DampedArpackSOE::zeroA() - no LinearSOE set\n";
+    return;
+  }
+
+  theSOE->zeroA();
+}
+
+
+void
+DampedArpackSOE::zeroM(void)
+{
+  M.zero();
+}
+
+
+void
+DampedArpackSOE::zeroC(void)
+{
+  C.zero();
+}
+
+
+// compresses M and C, to be called by the solver before the products
+int
+DampedArpackSOE::form(void)
+{
+  M.compress(size);
+  C.compress(size);
+
+  if (M.colIndex.empty()) {
+    opserr << "WARNING DampedArpackSOE::form() - the mass matrix is zero\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+double
+DampedArpackSOE::getDampingRatio(int mode)
+{
+  DampedArpackSolver *theSolvr = (DampedArpackSolver *)this->getSolver();
+  if (theSolvr == 0)
+    return 0.0;
+
+  return theSolvr->getDampingRatio(mode);
+}
+
+
+int
+DampedArpackSOE::sendSelf(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+
+int
+DampedArpackSOE::recvSelf(int commitTag, Channel &theChannel,
+			  FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
+
+
+int
+DampedArpackSOE::setLinks(AnalysisModel &theAnalysisModel)
+{
+  theModel = &theAnalysisModel;
+  return 0;
+}
+
+
+int
+DampedArpackSOE::setLinearSOE(LinearSOE &theLinearSOE)
+{
+  theSOE = &theLinearSOE;
+  return 0;
+}
+
+
+void
+DampedArpackSOE::SparseRows::zero(void)
+{
+  row.clear();
+  col.clear();
+  val.clear();
+  rowStart.clear();
+  colIndex.clear();
+  values.clear();
+}
+
+
+void
+DampedArpackSOE::SparseRows::add(const Matrix &m, const ID &id, double fact, int n)
+{
+  if (fact == 0.0)
+    return;
+
+  int idSize = id.Size();
+  for (int i=0; i<idSize; i++) {
+    int locI = id(i);
+    if (locI < 0 || locI >= n)
+      continue;
+    for (int j=0; j<idSize; j++) {
+      int locJ = id(j);
+      double mij = m(i,j);
+      if (locJ >= 0 && locJ < n && mij != 0.0) {
+	row.push_back(locI);
+	col.push_back(locJ);
+	val.push_back(fact*mij);
+      }
+    }
+  }
+}
+
+
+void
+DampedArpackSOE::SparseRows::compress(int n)
+{
+  // already compressed and nothing added since
+  if (row.empty() && (int)rowStart.size() == n+1)
+    return;
+
+  int numT = row.size();
+
+  rowStart.assign(n+1, 0);
+  for (int k=0; k<numT; k++)
+    rowStart[row[k]+1]++;
+  for (int i=0; i<n; i++)
+    rowStart[i+1] += rowStart[i];
+
+  std::vector<int> next(rowStart.begin(), rowStart.end()-1);
+  std::vector<std::pair<int,double> > entries(numT);
+  for (int k=0; k<numT; k++)
+    entries[next[row[k]]++] = std::pair<int,double>(col[k], val[k]);
+
+  colIndex.resize(numT);
+  values.resize(numT);
+  int nnz = 0;
+  for (int i=0; i<n; i++) {
+    int rowBegin = nnz;
+    std::sort(entries.begin()+rowStart[i], entries.begin()+rowStart[i+1]);
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+      if (nnz > rowBegin && colIndex[nnz-1] == entries[k].first) {
+	values[nnz-1] += entries[k].second;
+      } else {
+	colIndex[nnz] = entries[k].first;
+	values[nnz] = entries[k].second;
+	nnz++;
+      }
+    }
+    rowStart[i] = rowBegin;
+  }
+  rowStart[n] = nnz;
+  colIndex.resize(nnz);
+  values.resize(nnz);
+
+  std::vector<int>().swap(row);
+  std::vector<int>().swap(col);
+  std::vector<double>().swap(val);
+}
+
+
+// y = A x
+void
+DampedArpackSOE::SparseRows::multiply(const double *x, double *y, int n) const
+{
+  if ((int)rowStart.size() != n+1) {
+    for (int i=0; i<n; i++)
+      y[i] = 0.0;
+    return;
+  }
+
+  const int *start = &rowStart[0];
+  const int *cols = colIndex.empty() ? 0 : &colIndex[0];
+  const double *vals = values.empty() ? 0 : &values[0];
+
+#pragma omp parallel for
+  for (int i=0; i<n; i++) {
+    double sum = 0.0;
+    for (int k=start[i]; k<start[i+1]; k++)
+      sum += vals[k]*x[cols[k]];
+    y[i] = sum;
+  }
+}
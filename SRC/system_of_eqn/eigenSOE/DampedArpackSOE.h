@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// DampedArpackSOE, the EigenSOE of the quadratic eigenproblem
+//    (lambda^2 M + lambda C + K) phi = 0
+// of a non-classically damped model. K goes to the LinearSOE of the
+// analysis, which is factored for the solves; M and C are kept in
+// compressed row storage for the products. Nothing is stored densely,
+// so the memory is that of the LinearSOE plus the nonzeros of M and C.
+
+#ifndef DampedArpackSOE_h
+#define DampedArpackSOE_h
+
+#include <EigenSOE.h>
+#include <vector>
+
+class AnalysisModel;
+class DampedArpackSolver;
+class LinearSOE;
+
+class DampedArpackSOE : public EigenSOE
+{
+  public:
+    DampedArpackSOE();
+    ~DampedArpackSOE();
+
+    int setLinks(AnalysisModel &theModel);
+    int setLinearSOE(LinearSOE &theSOE);
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addM(const Matrix &, const ID &, double fact = 1.0);
+    bool needsC(void) {return true;};
+    int addC(const Matrix &, const ID &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroM(void);
+    void zeroC(void);
+
+    // the damping ratio -Re(lambda)/|lambda| of a mode, the eigenvalue
+    // of the mode being |lambda|^2
+    double getDampingRatio(int mode);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+    friend class DampedArpackSolver;
+
+  protected:
+
+  private:
+    // a matrix gathered as triplets and compressed to rows with sorted,
+    // distinct columns before the solve
+    struct SparseRows {
+      std::vector<int> row, col;
+      std::vector<double> val;
+      std::vector<int> rowStart, colIndex;
+      std::vector<double> values;
+
+      void zero(void);
+      void add(const Matrix &m, const ID &id, double fact, int n);
+      void compress(int n);
+      void multiply(const double *x, double *y, int n) const;
+    };
+
+    int form(void);
+
+    int size;
+    SparseRows M, C;
+    AnalysisModel *theModel;
+    LinearSOE *theSOE;
+};
+
+#endif
@@ -0,0 +1,401 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// DampedArpackSolver.
+
+#include <algorithm>
+#include <DampedArpackSolver.h>
+#include <DampedArpackSOE.h>
+#include <LinearSOE.h>
+#include <math.h>
+#include <string.h>
+#include <f2c.h>
+
+#ifdef _WIN32
+
+extern "C" int DNAUPD(int *ido, char *bmat, int *n, char *which, int *nev,
+		      double *tol, double *resid, int *ncv, double *v, int *ldv,
+		      int *iparam, int *ipntr, double *workd, double *workl,
+		      int *lworkl, int *info);
+
+extern "C" int DNEUPD(bool *rvec, char *howmny, logical *select, double *dr,
+		      double *di, double *z, int *ldz, double *sigmar,
+		      double *sigmai, double *workev, char *bmat, int *n,
+		      char *which, int *nev, double *tol, double *resid,
+		      int *ncv, double *v, int *ldv, int *iparam, int *ipntr,
+		      double *workd, double *workl, int *lworkl, int *info);
+#else
+
+extern "C" int dnaupd_(int *ido, char *bmat, int *n, char *which, int *nev,
+		       double *tol, double *resid, int *ncv, double *v, int *ldv,
+		       int *iparam, int *ipntr, double *workd, double *workl,
+		       int *lworkl, int *info);
+
+extern "C" int dneupd_(bool *rvec, char *howmny, logical *select, double *dr,
+		       double *di, double *z, int *ldz, double *sigmar,
+		       double *sigmai, double *workev, char *bmat, int *n,
+		       char *which, int *nev, double *tol, double *resid,
+		       int *ncv, double *v, int *ldv, int *iparam, int *ipntr,
+		       double *workd, double *workl, int *lworkl, int *info);
+#endif
+
+
+DampedArpackSolver::DampedArpackSolver()
+:EigenSolver(EigenSOLVER_TAGS_DampedArpackSolver),
+ theDampedSOE(0), numMode(0), size(0)
+{
+
+}
+
+
+DampedArpackSolver::~DampedArpackSolver()
+{
+
+}
+
+
+int
+DampedArpackSolver::solve(int numModes, bool generalized, bool findSmallest)
+{
+  if (generalized == false) {
+    opserr << "DampedArpackSolver::solve() - only solves the generalized problem\n";
+    return -1;
+  }
+
+  if (theDampedSOE == 0 || theDampedSOE->theSOE == 0) {
+    opserr << "DampedArpackSolver::solve() - no EigenSOE or LinearSOE set\n";
+    return -1;
+  }
+
+  numMode = 0;
+  int n = size;
+  int n2 = 2*n;
+
+  // a conjugate pair takes two of the Ritz values, one more keeps the
+  // last pair from being split
+  int nev = 2*numModes + 1;
+  if (nev > n2 - 2)
+    nev = n2 - 2;
+  if (nev < 1 || numModes > n) {
+    opserr << "DampedArpackSolver::solve() - " << numModes;
+    opserr << " modes asked for with " << n << " equations\n";
+    return -1;
+  }
+
+  int ncv = 2*nev + 1;
+  if (ncv < nev + 8)
+    ncv = nev + 8;
+  if (ncv > n2)
+    ncv = n2;
+
+  if (theDampedSOE->form() < 0)
+    return -1;
+
+  int ldv = n2;
+  int lworkl = 3*ncv*ncv + 6*ncv;
+  std::vector<double> v((size_t)ldv*ncv, 0.0);
+  std::vector<double> workl(lworkl, 0.0);
+  std::vector<double> workd(3*n2, 0.0);
+  std::vector<double> resid(n2, 0.0);
+  std::vector<int> select(ncv, 0);
+  work.resize(2*n);
+
+  char which[3];
+  if (findSmallest == true)
+    strcpy(which, "LM");
+  else
+    strcpy(which, "SM");
+
+  char bmat = 'I';
+  char howmy = 'A';
+  double tol = 0.0;
+  int info = 0;
+  int iparam[11];
+  int ipntr[14];
+  for (int i=0; i<11; i++)
+    iparam[i] = 0;
+  iparam[0] = 1;
+  iparam[2] = 1000;
+  iparam[6] = 1;
+
+  int ido = 0;
+  while (1) {
+#ifdef _WIN32
+    DNAUPD(&ido, &bmat, &n2, which, &nev, &tol, &resid[0], &ncv, &v[0], &ldv,
+	   iparam, ipntr, &workd[0], &workl[0], &lworkl, &info);
+#else
+    dnaupd_(&ido, &bmat, &n2, which, &nev, &tol, &resid[0], &ncv, &v[0], &ldv,
+	    iparam, ipntr, &workd[0], &workl[0], &lworkl, &info);
+#endif
+
+    if (ido != -1 && ido != 1)
+      break;
+
+    if (this->applyOperator(&workd[ipntr[0]-1], &workd[ipntr[1]-1]) < 0)
+      return -1;
+  }
+
+  if (info < 0) {
+    opserr << "DampedArpackSolver::solve() - error with dnaupd, info = " << info << endln;
+    return info;
+  }
+  if (info == 1)
+    opserr << "DampedArpackSolver::solve() - maximum number of iterations reached\n";
+  else if (info == 3)
+    opserr << "DampedArpackSolver::solve() - no shifts could be applied, try more modes\n";
+
+  int nconv = iparam[4];
+  if (nconv <= 0) {
+    opserr << "DampedArpackSolver::solve() - no eigenvalue converged\n";
+    return -1;
+  }
+
+  bool rvec = true;
+  double sigmar = 0.0, sigmai = 0.0;
+  std::vector<double> dr(nev+1), di(nev+1);
+  std::vector<double> z((size_t)n2*(nev+1));
+  std::vector<double> workev(3*ncv);
+#ifdef _WIN32
+  DNEUPD(&rvec, &howmy, (logical *)&select[0], &dr[0], &di[0], &z[0], &ldv,
+	 &sigmar, &sigmai, &workev[0], &bmat, &n2, which, &nev, &tol, &resid[0],
+	 &ncv, &v[0], &ldv, iparam, ipntr, &workd[0], &workl[0], &lworkl, &info);
+#else
+  dneupd_(&rvec, &howmy, (logical *)&select[0], &dr[0], &di[0], &z[0], &ldv,
+	  &sigmar, &sigmai, &workev[0], &bmat, &n2, which, &nev, &tol, &resid[0],
+	  &ncv, &v[0], &ldv, iparam, ipntr, &workd[0], &workl[0], &lworkl, &info);
+#endif
+  if (info != 0) {
+    opserr << "DampedArpackSolver::solve() - error with dneupd, info = " << info << endln;
+    return -1;
+  }
+
+  // one root of each pair: (|lambda|^2, column of the real part, sign of
+  // the imaginary part, or 0 for a real root)
+  std::vector<std::pair<double, std::pair<int,int> > > roots;
+  for (int j=0; j<nconv && j<nev; j++) {
+    double absMu2 = dr[j]*dr[j] + di[j]*di[j];
+    if (absMu2 == 0.0)
+      continue;
+    if (di[j] == 0.0) {
+      roots.push_back(std::make_pair(1.0/absMu2, std::make_pair(j, 0)));
+    } else if (j+1 < nconv) {
+      // mu = dr - i|di| is lambda with positive imaginary part
+      roots.push_back(std::make_pair(1.0/absMu2, std::make_pair(j, di[j] < 0.0 ? 1 : -1)));
+      j++;
+    }
+  }
+  std::stable_sort(roots.begin(), roots.end(),
+		   [](const std::pair<double, std::pair<int,int> > &a,
+		      const std::pair<double, std::pair<int,int> > &b) {return a.first < b.first;});
+
+  if ((int)roots.size() < numModes) {
+    opserr << "DampedArpackSolver::solve() - only " << (int)roots.size();
+    opserr << " of the " << numModes << " modes converged\n";
+    return -1;
+  }
+
+  eigenvalues.resize(numModes);
+  dampingRatios.resize(numModes);
+  vectorsRe.assign((size_t)n*numModes, 0.0);
+  vectorsIm.assign((size_t)n*numModes, 0.0);
+
+  for (int i=0; i<numModes; i++) {
+    int j = roots[i].second.first;
+    int s = roots[i].second.second;
+    const double *re = &z[(size_t)j*n2];
+    const double *im = s != 0 ? &z[(size_t)(j+1)*n2] : 0;
+
+    eigenvalues[i] = roots[i].first;
+    dampingRatios[i] = -dr[j]*sqrt(roots[i].first);
+
+    // turn the shape so that its largest component is real & positive
+    int kMax = 0;
+    double aMax = -1.0;
+    for (int k=0; k<n; k++) {
+      double ik = im != 0 ? s*im[k] : 0.0;
+      double a = re[k]*re[k] + ik*ik;
+      if (a > aMax) {
+	aMax = a;
+	kMax = k;
+      }
+    }
+    double cr = 1.0, ci = 0.0;
+    if (aMax > 0.0) {
+      double ik = im != 0 ? s*im[kMax] : 0.0;
+      cr = re[kMax]/sqrt(aMax);
+      ci = -ik/sqrt(aMax);
+    }
+
+    double *phiRe = &vectorsRe[(size_t)i*n];
+    double *phiIm = &vectorsIm[(size_t)i*n];
+    for (int k=0; k<n; k++) {
+      double ik = im != 0 ? s*im[k] : 0.0;
+      phiRe[k] = re[k]*cr - ik*ci;
+      phiIm[k] = re[k]*ci + ik*cr;
+    }
+
+    // phi^H M phi for a symmetric M
+    double *Mphi = &work[0];
+    double norm = 0.0;
+    theDampedSOE->M.multiply(phiRe, Mphi, n);
+    for (int k=0; k<n; k++)
+      norm += phiRe[k]*Mphi[k];
+    theDampedSOE->M.multiply(phiIm, Mphi, n);
+    for (int k=0; k<n; k++)
+      norm += phiIm[k]*Mphi[k];
+    if (norm > 0.0) {
+      norm = 1.0/sqrt(norm);
+      for (int k=0; k<n; k++) {
+	phiRe[k] *= norm;
+	phiIm[k] *= norm;
+      }
+    }
+  }
+
+  numMode = numModes;
+
+  return 0;
+}
+
+
+// result = [-K^-1 (C x + M y); x] for z = [x; y]
+int
+DampedArpackSolver::applyOperator(const double *z, double *result)
+{
+  int n = size;
+  const double *x = z;
+  const double *y = z + n;
+  double *b = &work[0];
+  double *cx = &work[n];
+
+  theDampedSOE->M.multiply(y, b, n);
+  theDampedSOE->C.multiply(x, cx, n);
+  for (int i=0; i<n; i++)
+    b[i] += cx[i];
+
+  LinearSOE *theSOE = theDampedSOE->theSOE;
+  Vector B(b, n);
+  theSOE->setB(B);
+  if (theSOE->solve() < 0) {
+    opserr << "DampedArpackSolver::solve() - the LinearSOE failed to solve with K\n";
+    return -1;
+  }
+
+  const Vector &X = theSOE->getX();
+  for (int i=0; i<n; i++) {
+    result[n+i] = x[i];
+    result[i] = -X(i);
+  }
+
+  return 0;
+}
+
+
+int
+DampedArpackSolver::setEigenSOE(DampedArpackSOE &theSOE)
+{
+  theDampedSOE = &theSOE;
+  return 0;
+}
+
+
+int
+DampedArpackSolver::setSize(void)
+{
+  size = theDampedSOE->size;
+  theVector.resize(size);
+  return 0;
+}
+
+
+const Vector &
+DampedArpackSolver::getEigenvector(int mode)
+{
+  if (mode <= 0 || mode > numMode) {
+    opserr << "DampedArpackSolver::getEigenvector() - mode " << mode;
+    opserr << " is out of range (1 - " << numMode << ")\n";
+    theVector.Zero();
+    return theVector;
+  }
+
+  for (int i=0; i<size; i++)
+    theVector(i) = vectorsRe[(size_t)(mode-1)*size + i];
+
+  return theVector;
+}
+
+
+const Vector &
+DampedArpackSolver::getEigenvectorImag(int mode)
+{
+  if (mode <= 0 || mode > numMode) {
+    opserr << "DampedArpackSolver::getEigenvectorImag() - mode " << mode;
+    opserr << " is out of range (1 - " << numMode << ")\n";
+    theVector.Zero();
+    return theVector;
+  }
+
+  for (int i=0; i<size; i++)
+    theVector(i) = vectorsIm[(size_t)(mode-1)*size + i];
+
+  return theVector;
+}
+
+
+double
+DampedArpackSolver::getEigenvalue(int mode)
+{
+  if (mode <= 0 || mode > numMode) {
+    opserr << "DampedArpackSolver::getEigenvalue() - mode " << mode;
+    opserr << " is out of range (1 - " << numMode << ")\n";
+    return 0.0;
+  }
+
+  return eigenvalues[mode-1];
+}
+
+
+double
+DampedArpackSolver::getDampingRatio(int mode)
+{
+  if (mode <= 0 || mode > numMode) {
+    opserr << "DampedArpackSolver::getDampingRatio() - mode " << mode;
+    opserr << " is out of range (1 - " << numMode << ")\n";
+    return 0.0;
+  }
+
+  return dampingRatios[mode-1];
+}
+
+
+int
+DampedArpackSolver::sendSelf(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+
+int
+DampedArpackSolver::recvSelf(int commitTag, Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
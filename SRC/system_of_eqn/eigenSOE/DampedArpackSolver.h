@@ -0,0 +1,79 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// DampedArpackSolver. It finds the eigenvalues of smallest magnitude of
+// the quadratic eigenproblem of a DampedArpackSOE with ARPACK's
+// implicitly restarted Arnoldi method (dnaupd) applied to the inverse
+// of the first companion linearization, of size 2n:
+//    mu [x; y] = [-K^-1 (C x + M y); x],   mu = 1/lambda, y = lambda x
+// so each step needs one solve with the factored K and products with M
+// and C only. Of each complex conjugate pair the root with positive
+// imaginary part is kept; the eigenvalue of a mode is |lambda|^2, which
+// is omega^2 for an undamped model, and the eigenvector is the complex
+// displacement shape turned so that its largest component is real,
+// normalized to phi^H M phi = 1, of which the real part is returned.
+
+#ifndef DampedArpackSolver_h
+#define DampedArpackSolver_h
+
+#include <EigenSolver.h>
+#include <DampedArpackSOE.h>
+#include <Vector.h>
+#include <vector>
+
+class LinearSOE;
+
+class DampedArpackSolver : public EigenSolver
+{
+  public:
+    DampedArpackSolver();
+    ~DampedArpackSolver();
+
+    int solve(int numMode, bool generalized, bool findSmallest = true);
+    int setSize(void);
+    int setEigenSOE(DampedArpackSOE &theSOE);
+
+    const Vector &getEigenvector(int mode);
+    double getEigenvalue(int mode);
+    double getDampingRatio(int mode);
+    const Vector &getEigenvectorImag(int mode);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int applyOperator(const double *z, double *result);
+
+    DampedArpackSOE *theDampedSOE;
+    int numMode;
+    int size;
+
+    std::vector<double> eigenvalues;    // |lambda|^2
+    std::vector<double> dampingRatios;
+    std::vector<double> vectorsRe, vectorsIm;
+    std::vector<double> work;
+    Vector theVector;
+};
+
+#endif
@@ -44,6 +44,10 @@ class EigenSOE : public MovableObject
      virtual int solve(int numModes, bool generalized, bool findSmallest = true);
      virtual int setLinks(AnalysisModel &theModel);    
      virtual int setLinearSOE(LinearSOE &theSOE) {return -1;};
+
+     // true if solve() uses no other object of the analysis, so that
+     // it can run on another thread while the analysis goes on
+     virtual bool canSolveAsync(void) {return false;};
      
      // pure virtual functions
      virtual int addA(const Matrix &, const ID &, double fact = 1.0) = 0;
@@ -53,6 +57,11 @@ class EigenSOE : public MovableObject
      virtual void zeroA(void) = 0;
      virtual void zeroM(void) = 0;
 
+     // an EigenSOE of the damped problem is also given C
+     virtual bool needsC(void) {return false;};
+     virtual int addC(const Matrix &, const ID &, double fact = 1.0) {return 0;};
+     virtual void zeroC(void) {};
+
      // methods to get the eigenvectors and eigenvalues
      virtual const Vector &getEigenvector(int mode);
      virtual double getEigenvalue(int mode);          
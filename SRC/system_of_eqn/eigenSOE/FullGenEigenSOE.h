@@ -50,6 +50,7 @@ public:
 
     virtual int getNumEqn(void) const;
     virtual int setSize(Graph &theGraph);
+    virtual bool canSolveAsync(void) {return true;};
 
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
     virtual int addM(const Matrix &, const ID &, double fact = 1.0);    
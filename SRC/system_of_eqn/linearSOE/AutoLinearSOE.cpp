@@ -0,0 +1,601 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of AutoLinearSOE.
+//
+// What: "@(#) AutoLinearSOE.cpp, revA"
+
+#include <AutoLinearSOE.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <elementAPI.h>
+#include <BandGenLinSOE.h>
+#include <BandGenLinLapackSolver.h>
+#include <BandSPDLinSOE.h>
+#include <BandSPDLinLapackSolver.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
+#include <SymSparseLinSOE.h>
+#include <SymSparseLinSolver.h>
+#include <UmfpackGenLinSOE.h>
+#include <UmfpackGenLinSolver.h>
+#include <SparseGenColLinSOE.h>
+#include <SuperLU.h>
+#include <DiagonalSOE.h>
+#include <DiagonalDirectSolver.h>
+#include <chrono>
+#include <math.h>
+#include <string.h>
+
+// a band or profile storage is only tried when it is within this
+// factor of the number of nonzeros of A
+#define AUTO_SOE_STORAGE_RATIO 30
+
+// relative difference allowed between the solution of a candidate and
+// the one of the reference UmfPack system
+#define AUTO_SOE_CHECK_TOL 1.0e-6
+
+Vector AutoLinearSOE::zeroVector(0);
+
+void* OPS_AutoLinearSOE()
+{
+    // system Auto <-max $numCandidates> <-quiet>
+    int maxCandidates = 3;
+    bool verbose = true;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-max") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    int numData = 1;
+	    if (OPS_GetIntInput(&numData, &maxCandidates) < 0 || maxCandidates < 1) {
+		opserr << "WARNING system Auto -max $numCandidates - invalid number\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-quiet") == 0) {
+	    verbose = false;
+	}
+    }
+
+    return new AutoLinearSOE(maxCandidates, verbose);
+}
+
+
+AutoLinearSOE::AutoLinearSOE(int max, bool verb)
+:LinearSOE(LinSOE_TAGS_AutoLinearSOE),
+ maxCandidates(max), verbose(verb), symmetric(true), theSelected(0)
+{
+
+}
+
+
+AutoLinearSOE::~AutoLinearSOE()
+{
+    this->clearCandidates();
+    if (theSelected != 0)
+	delete theSelected;
+}
+
+
+void
+AutoLinearSOE::addCandidate(const char *name, LinearSOE *theSOE, bool symmetricOnly)
+{
+    Candidate candidate;
+    candidate.name = name;
+    candidate.theSOE = theSOE;
+    candidate.symmetricOnly = symmetricOnly;
+    candidates.push_back(candidate);
+}
+
+
+void
+AutoLinearSOE::clearCandidates(void)
+{
+    for (size_t i = 0; i < candidates.size(); i++)
+	if (candidates[i].theSOE != 0)
+	    delete candidates[i].theSOE;
+    candidates.clear();
+}
+
+
+const char *
+AutoLinearSOE::getSelectedName(void)
+{
+    return selectedName.c_str();
+}
+
+
+int
+AutoLinearSOE::setLinks(AnalysisModel &theModel)
+{
+    this->LinearSOE::setLinks(theModel);
+
+    if (theSelected != 0)
+	return theSelected->setLinks(theModel);
+
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->setLinks(theModel);
+    return res;
+}
+
+
+int
+AutoLinearSOE::setSize(Graph &theGraph)
+{
+    // once picked the system is kept for the rest of the analysis
+    if (theSelected != 0)
+	return theSelected->setSize(theGraph);
+
+    this->clearCandidates();
+    symmetric = true;
+
+    // size, half bandwidth, profile & nonzeros of A from the graph
+    int size = theGraph.getNumVertex();
+    int halfBand = 0;
+    double profile = size;
+    double nnz = size;
+
+    Vertex *vertexPtr;
+    VertexIter &theVertices = theGraph.getVertices();
+    while ((vertexPtr = theVertices()) != 0) {
+	int vertexNum = vertexPtr->getTag();
+	const ID &theAdjacency = vertexPtr->getAdjacency();
+	int minNum = vertexNum;
+	for (int i = 0; i < theAdjacency.Size(); i++) {
+	    int otherNum = theAdjacency(i);
+	    int diff = vertexNum - otherNum;
+	    if (diff > halfBand)
+		halfBand = diff;
+	    if (otherNum < minNum)
+		minNum = otherNum;
+	}
+	profile += vertexNum - minNum;
+	nnz += theAdjacency.Size();
+    }
+
+    if (verbose) {
+	opserr << "AutoLinearSOE - " << size << " equations, " << nnz;
+	opserr << " nonzeros, half bandwidth " << halfBand << endln;
+    }
+
+    // no coupling between the equations, A is diagonal
+    if (nnz == size) {
+	DiagonalSolver *theSolver = new DiagonalDirectSolver();
+	theSelected = new DiagonalSOE(*theSolver);
+	selectedName = "Diagonal";
+	if (verbose)
+	    opserr << "AutoLinearSOE - A is diagonal, using Diagonal\n";
+	if (theModel != 0)
+	    theSelected->setLinks(*theModel);
+	return theSelected->setSize(theGraph);
+    }
+
+    bool narrow = ((double)size*(halfBand+1) <= AUTO_SOE_STORAGE_RATIO*nnz);
+    bool shallow = (profile <= AUTO_SOE_STORAGE_RATIO*nnz);
+
+    // UmfPack first, it is the reference the others are checked against,
+    // the symmetric solvers are only tried if A turns out symmetric
+    this->addCandidate("UmfPack", new UmfpackGenLinSOE(*(new UmfpackGenLinSolver())), false);
+    this->addCandidate("SparseSYM", new SymSparseLinSOE(*(new SymSparseLinSolver()), 1), true);
+    if (shallow)
+	this->addCandidate("ProfileSPD", new ProfileSPDLinSOE(*(new ProfileSPDLinDirectSolver())), true);
+    if (narrow) {
+	this->addCandidate("BandSPD", new BandSPDLinSOE(*(new BandSPDLinLapackSolver())), true);
+	this->addCandidate("BandGeneral", new BandGenLinSOE(*(new BandGenLinLapackSolver())), false);
+    }
+    this->addCandidate("SparseGeneral", new SparseGenColLinSOE(*(new SuperLU())), false);
+
+    int result = 0;
+    for (size_t i = 0; i < candidates.size(); ) {
+	if (theModel != 0)
+	    candidates[i].theSOE->setLinks(*theModel);
+	if (candidates[i].theSOE->setSize(theGraph) < 0) {
+	    if (verbose)
+		opserr << "AutoLinearSOE - " << candidates[i].name.c_str() << " failed setSize()\n";
+	    delete candidates[i].theSOE;
+	    candidates.erase(candidates.begin() + i);
+	} else
+	    i++;
+    }
+
+    if (candidates.empty()) {
+	opserr << "WARNING AutoLinearSOE::setSize() - no system could be set up\n";
+	result = -1;
+    }
+
+    return result;
+}
+
+
+int
+AutoLinearSOE::select(void)
+{
+    int numCandidates = (int)candidates.size();
+    std::vector<double> times(numCandidates, -1.0);
+    std::vector<int> results(numCandidates, 0);
+
+    Vector reference;
+    bool haveReference = false;
+    int best = -1;
+    int numTried = 0;
+
+    for (int i = 0; i < numCandidates && numTried < maxCandidates; i++) {
+	Candidate &candidate = candidates[i];
+	if (candidate.symmetricOnly && !symmetric)
+	    continue;
+	numTried++;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	results[i] = candidate.theSOE->solve();
+	std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+	times[i] = time.count();
+	if (results[i] < 0)
+	    continue;
+
+	const Vector &X = candidate.theSOE->getX();
+	if (!haveReference) {
+	    reference = X;
+	    haveReference = true;
+	} else if (haveReference) {
+	    double diff = 0.0;
+	    double norm = 0.0;
+	    for (int j = 0; j < X.Size(); j++) {
+		diff += (X(j) - reference(j))*(X(j) - reference(j));
+		norm += reference(j)*reference(j);
+	    }
+	    if (diff > AUTO_SOE_CHECK_TOL*AUTO_SOE_CHECK_TOL*norm + 1.0e-300) {
+		results[i] = -1;
+		continue;
+	    }
+	}
+
+	if (best < 0 || times[i] < times[best])
+	    best = i;
+    }
+
+    if (verbose) {
+	opserr << "AutoLinearSOE - A is " << (symmetric ? "symmetric" : "unsymmetric");
+	opserr << ", first solve with each system:\n";
+	for (int i = 0; i < numCandidates; i++) {
+	    if (times[i] < 0.0)
+		continue;
+	    opserr << "    " << candidates[i].name.c_str() << ": ";
+	    if (results[i] < 0)
+		opserr << "failed\n";
+	    else
+		opserr << times[i] << " s\n";
+	}
+    }
+
+    if (best < 0) {
+	opserr << "WARNING AutoLinearSOE::solve() - no system could solve A\n";
+	return -1;
+    }
+
+    if (verbose)
+	opserr << "AutoLinearSOE - using " << candidates[best].name.c_str() << endln;
+
+    theSelected = candidates[best].theSOE;
+    selectedName = candidates[best].name;
+    candidates[best].theSOE = 0;
+    this->clearCandidates();
+
+    return 0;
+}
+
+
+int
+AutoLinearSOE::solve(void)
+{
+    if (theSelected != 0)
+	return theSelected->solve();
+
+    if (candidates.empty()) {
+	opserr << "WARNING AutoLinearSOE::solve() - setSize() has not been called\n";
+	return -1;
+    }
+
+    return this->select();
+}
+
+
+int
+AutoLinearSOE::getNumEqn(void) const
+{
+    if (theSelected != 0)
+	return theSelected->getNumEqn();
+    if (!candidates.empty())
+	return candidates[0].theSOE->getNumEqn();
+    return 0;
+}
+
+
+int
+AutoLinearSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    if (theSelected != 0)
+	return theSelected->addA(m, id, fact);
+
+    // A is symmetric if all the matrices assembled are
+    if (symmetric) {
+	int n = m.noRows();
+	if (n != m.noCols())
+	    symmetric = false;
+	else {
+	    double maxValue = 0.0;
+	    for (int i = 0; i < n; i++)
+		for (int j = 0; j < n; j++)
+		    if (fabs(m(i,j)) > maxValue)
+			maxValue = fabs(m(i,j));
+	    double tol = 1.0e-10*maxValue;
+	    for (int i = 0; i < n && symmetric; i++)
+		for (int j = 0; j < i; j++)
+		    if (fabs(m(i,j) - m(j,i)) > tol) {
+			symmetric = false;
+			break;
+		    }
+	}
+    }
+
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->addA(m, id, fact);
+    return res;
+}
+
+
+int
+AutoLinearSOE::addA(const Matrix &m)
+{
+    if (theSelected != 0)
+	return theSelected->addA(m);
+
+    symmetric = false;
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->addA(m);
+    return res;
+}
+
+
+int
+AutoLinearSOE::addColA(const Vector &col, int colIndex, double fact)
+{
+    if (theSelected != 0)
+	return theSelected->addColA(col, colIndex, fact);
+
+    symmetric = false;
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->addColA(col, colIndex, fact);
+    return res;
+}
+
+
+int
+AutoLinearSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    if (theSelected != 0)
+	return theSelected->addB(v, id, fact);
+
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->addB(v, id, fact);
+    return res;
+}
+
+
+int
+AutoLinearSOE::setB(const Vector &v, double fact)
+{
+    if (theSelected != 0)
+	return theSelected->setB(v, fact);
+
+    int res = 0;
+    for (size_t i = 0; i < candidates.size(); i++)
+	res += candidates[i].theSOE->setB(v, fact);
+    return res;
+}
+
+
+void
+AutoLinearSOE::zeroA(void)
+{
+    if (theSelected != 0) {
+	theSelected->zeroA();
+	return;
+    }
+
+    symmetric = true;
+    for (size_t i = 0; i < candidates.size(); i++)
+	candidates[i].theSOE->zeroA();
+}
+
+
+void
+AutoLinearSOE::zeroB(void)
+{
+    if (theSelected != 0) {
+	theSelected->zeroB();
+	return;
+    }
+
+    for (size_t i = 0; i < candidates.size(); i++)
+	candidates[i].theSOE->zeroB();
+}
+
+
+int
+AutoLinearSOE::formAp(const Vector &p, Vector &Ap)
+{
+    if (theSelected != 0)
+	return theSelected->formAp(p, Ap);
+    if (!candidates.empty())
+	return candidates[0].theSOE->formAp(p, Ap);
+    return 0;
+}
+
+
+const Vector &
+AutoLinearSOE::getX(void)
+{
+    if (theSelected != 0)
+	return theSelected->getX();
+    if (!candidates.empty())
+	return candidates[0].theSOE->getX();
+    return zeroVector;
+}
+
+
+const Vector &
+AutoLinearSOE::getB(void)
+{
+    if (theSelected != 0)
+	return theSelected->getB();
+    if (!candidates.empty())
+	return candidates[0].theSOE->getB();
+    return zeroVector;
+}
+
+
+const Matrix *
+AutoLinearSOE::getA(void)
+{
+    if (theSelected != 0)
+	return theSelected->getA();
+    if (!candidates.empty())
+	return candidates[0].theSOE->getA();
+    return 0;
+}
+
+
+double
+AutoLinearSOE::getDeterminant(void)
+{
+    if (theSelected != 0)
+	return theSelected->getDeterminant();
+    return 0.0;
+}
+
+
+double
+AutoLinearSOE::normRHS(void)
+{
+    if (theSelected != 0)
+	return theSelected->normRHS();
+    if (!candidates.empty())
+	return candidates[0].theSOE->normRHS();
+    return 0.0;
+}
+
+
+// until a system is picked all the candidates are assembled, so all count
+size_t
+AutoLinearSOE::getMemoryUsage(void)
+{
+    if (theSelected != 0)
+	return theSelected->getMemoryUsage();
+    size_t result = 0;
+    for (size_t i=0; i<candidates.size(); i++)
+	result += candidates[i].theSOE->getMemoryUsage();
+    return result;
+}
+
+
+size_t
+AutoLinearSOE::getFactorMemoryUsage(void)
+{
+    if (theSelected != 0)
+	return theSelected->getFactorMemoryUsage();
+    size_t result = 0;
+    for (size_t i=0; i<candidates.size(); i++)
+	result += candidates[i].theSOE->getFactorMemoryUsage();
+    return result;
+}
+
+
+int
+AutoLinearSOE::getNorms(int normType, double *normB, double *normX,
+			double *productXB)
+{
+    if (theSelected != 0)
+	return theSelected->getNorms(normType, normB, normX, productXB);
+    if (!candidates.empty())
+	return candidates[0].theSOE->getNorms(normType, normB, normX, productXB);
+    return this->LinearSOE::getNorms(normType, normB, normX, productXB);
+}
+
+
+void
+AutoLinearSOE::setX(int loc, double value)
+{
+    if (theSelected != 0) {
+	theSelected->setX(loc, value);
+	return;
+    }
+
+    for (size_t i = 0; i < candidates.size(); i++)
+	candidates[i].theSOE->setX(loc, value);
+}
+
+
+void
+AutoLinearSOE::setX(const Vector &X)
+{
+    if (theSelected != 0) {
+	theSelected->setX(X);
+	return;
+    }
+
+    for (size_t i = 0; i < candidates.size(); i++)
+	candidates[i].theSOE->setX(X);
+}
+
+
+int
+AutoLinearSOE::solveMultiple(const Matrix &B, Matrix &X)
+{
+    // the system is picked with a single right hand side
+    if (theSelected == 0 && this->solve() < 0)
+	return -1;
+
+    return theSelected->solveMultiple(B, X);
+}
+
+
+int
+AutoLinearSOE::sendSelf(int commitTag, Channel &theChannel)
+{
+    opserr << "WARNING AutoLinearSOE::sendSelf() - not implemented\n";
+    return -1;
+}
+
+
+int
+AutoLinearSOE::recvSelf(int commitTag, Channel &theChannel,
+			FEM_ObjectBroker &theBroker)
+{
+    opserr << "WARNING AutoLinearSOE::recvSelf() - not implemented\n";
+    return -1;
+}
@@ -0,0 +1,111 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef AutoLinearSOE_h
+#define AutoLinearSOE_h
+
+// Description: This file contains the class definition for AutoLinearSOE.
+// AutoLinearSOE picks the system of equations for the model. In the first
+// setSize() it looks at the size, half bandwidth and profile of the Graph
+// and sets up the candidates that suit it, and the first assembly goes
+// into all of them, which also shows whether A is symmetric. The first
+// solve() factors A with each candidate still valid for it, the fastest
+// one is kept and the others are deleted; from then on every call goes to
+// the system picked. A candidate that fails to factor A, e.g. a positive
+// definite solver for an indefinite A, is dropped.
+//
+// What: "@(#) AutoLinearSOE.h, revA"
+
+#include <LinearSOE.h>
+#include <vector>
+#include <string>
+
+class AutoLinearSOE : public LinearSOE
+{
+  public:
+    AutoLinearSOE(int maxCandidates = 3, bool verbose = true);
+    ~AutoLinearSOE();
+
+    int solve(void);
+    int setLinks(AnalysisModel &theModel);
+
+    int setSize(Graph &theGraph);
+    int getNumEqn(void) const;
+
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    int addA(const Matrix &);
+    int addColA(const Vector &col, int colIndex, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    int formAp(const Vector &p, Vector &Ap);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    const Matrix *getA(void);
+    double getDeterminant(void);
+    double normRHS(void);
+    size_t getMemoryUsage(void);
+    size_t getFactorMemoryUsage(void);
+    int getNorms(int normType, double *normB, double *normX,
+		 double *productXB = 0);
+
+    void setX(int loc, double value);
+    void setX(const Vector &X);
+
+    int solveMultiple(const Matrix &B, Matrix &X);
+
+    // the system picked, 0 until the first solve()
+    LinearSOE *getSelected(void) {return theSelected;};
+    const char *getSelectedName(void);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    struct Candidate {
+	std::string name;
+	LinearSOE *theSOE;
+	bool symmetricOnly;   // needs a symmetric A
+    };
+
+    void addCandidate(const char *name, LinearSOE *theSOE, bool symmetricOnly);
+    void clearCandidates(void);
+    int select(void);
+
+    int maxCandidates;
+    bool verbose;
+    bool symmetric;        // all the matrices assembled so far were symmetric
+
+    std::vector<Candidate> candidates;
+    LinearSOE *theSelected;
+    std::string selectedName;
+
+    static Vector zeroVector;
+};
+
+#endif
@@ -0,0 +1,345 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of KrylovIteration.
+
+#include <KrylovIteration.h>
+#include <OPS_Globals.h>
+#include <math.h>
+
+
+KrylovIteration::KrylovIteration(int meth, double tolerance,
+				 int maxIterations, int m, bool warm)
+:method(meth), tol(tolerance), maxIter(maxIterations),
+ restart(m), warmStart(warm), n(0)
+{
+    if (restart < 1)
+	restart = 1;
+}
+
+
+KrylovIteration::~KrylovIteration()
+{
+
+}
+
+
+double
+KrylovIteration::dotProduct(int n, const double *a, const double *b)
+{
+    double sum = 0.0;
+    for (int i=0; i<n; i++)
+	sum += a[i]*b[i];
+    return sum;
+}
+
+
+void
+KrylovIteration::setSize(int size)
+{
+    n = size;
+
+    size_t numVectors = 4;
+    if (method == BiCGStab)
+	numVectors = 8;
+    else if (method == GMRES)
+	numVectors = restart + 4;
+    work.assign(numVectors*n, 0.0);
+}
+
+
+// r = b - A x, starting from x = 0 instead if the previous solution in x
+// is a worse guess than that
+int
+KrylovIteration::initialResidual(KrylovOperator &theOperator,
+				 double *x, const double *b, double *r, double bNorm)
+{
+    if (warmStart) {
+	if (theOperator.multiply(x, r) < 0)
+	    return -1;
+	for (int i=0; i<n; i++)
+	    r[i] = b[i] - r[i];
+	if (sqrt(dotProduct(n, r, r)) < bNorm)
+	    return 0;
+    }
+
+    for (int i=0; i<n; i++) {
+	x[i] = 0.0;
+	r[i] = b[i];
+    }
+    return 0;
+}
+
+
+int
+KrylovIteration::solveCG(KrylovOperator &theOperator,
+			 double *x, const double *b, double bNorm)
+{
+    double *r = &work[0];
+    double *z = r + n;
+    double *p = z + n;
+    double *Ap = p + n;
+
+    if (this->initialResidual(theOperator, x, b, r, bNorm) < 0)
+	return -1;
+
+    double tolNorm = tol*bNorm;
+    if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	return 0;
+
+    theOperator.precondition(r, z);
+    for (int i=0; i<n; i++)
+	p[i] = z[i];
+    double rz = dotProduct(n, r, z);
+
+    for (int iter=1; iter<=maxIter; iter++) {
+	if (theOperator.multiply(p, Ap) < 0)
+	    return -1;
+	double pAp = dotProduct(n, p, Ap);
+	if (pAp <= 0.0) {
+	    opserr << "WARNING KrylovIteration::solveCG()- ";
+	    opserr << " matrix or preconditioner not positive definite\n";
+	    return -1;
+	}
+
+	double alpha = rz/pAp;
+	for (int i=0; i<n; i++) {
+	    x[i] += alpha*p[i];
+	    r[i] -= alpha*Ap[i];
+	}
+	if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	    return iter;
+
+	theOperator.precondition(r, z);
+	double rzNew = dotProduct(n, r, z);
+	double beta = rzNew/rz;
+	rz = rzNew;
+	for (int i=0; i<n; i++)
+	    p[i] = z[i] + beta*p[i];
+    }
+
+    return -1;
+}
+
+
+int
+KrylovIteration::solveBiCGStab(KrylovOperator &theOperator,
+			       double *x, const double *b, double bNorm)
+{
+    double *r = &work[0];
+    double *rhat = r + n;
+    double *p = rhat + n;
+    double *v = p + n;
+    double *phat = v + n;
+    double *s = phat + n;
+    double *shat = s + n;
+    double *t = shat + n;
+
+    if (this->initialResidual(theOperator, x, b, r, bNorm) < 0)
+	return -1;
+
+    double tolNorm = tol*bNorm;
+    if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	return 0;
+
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    for (int i=0; i<n; i++) {
+	rhat[i] = r[i];
+	p[i] = 0.0;
+	v[i] = 0.0;
+    }
+
+    for (int iter=1; iter<=maxIter; iter++) {
+	double rhoNew = dotProduct(n, rhat, r);
+	if (rhoNew == 0.0)
+	    return -1;
+
+	double beta = (rhoNew/rho)*(alpha/omega);
+	for (int i=0; i<n; i++)
+	    p[i] = r[i] + beta*(p[i] - omega*v[i]);
+
+	theOperator.precondition(p, phat);
+	if (theOperator.multiply(phat, v) < 0)
+	    return -1;
+	double rv = dotProduct(n, rhat, v);
+	if (rv == 0.0)
+	    return -1;
+	alpha = rhoNew/rv;
+
+	for (int i=0; i<n; i++)
+	    s[i] = r[i] - alpha*v[i];
+	if (sqrt(dotProduct(n, s, s)) <= tolNorm) {
+	    for (int i=0; i<n; i++)
+		x[i] += alpha*phat[i];
+	    return iter;
+	}
+
+	theOperator.precondition(s, shat);
+	if (theOperator.multiply(shat, t) < 0)
+	    return -1;
+	double tt = dotProduct(n, t, t);
+	omega = (tt > 0.0) ? dotProduct(n, t, s)/tt : 0.0;
+
+	for (int i=0; i<n; i++) {
+	    x[i] += alpha*phat[i] + omega*shat[i];
+	    r[i] = s[i] - omega*t[i];
+	}
+	if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	    return iter;
+	if (omega == 0.0)
+	    return -1;
+
+	rho = rhoNew;
+    }
+
+    return -1;
+}
+
+
+int
+KrylovIteration::solveGMRES(KrylovOperator &theOperator,
+			    double *x, const double *b, double bNorm)
+{
+    // right preconditioned GMRES(m), V holds the m+1 basis vectors
+    int m = restart;
+    int ldH = m+1;
+    double *V = &work[0];
+    double *r = V + (size_t)(m+1)*n;
+    double *u = r + n;
+    double *z = u + n;
+
+    std::vector<double> H((size_t)ldH*m), cs(m), sn(m), g(m+1), y(m);
+
+    if (this->initialResidual(theOperator, x, b, r, bNorm) < 0)
+	return -1;
+
+    double tolNorm = tol*bNorm;
+    int iter = 0;
+
+    while (true) {
+	double beta = sqrt(dotProduct(n, r, r));
+	if (beta <= tolNorm)
+	    return iter;
+	if (iter >= maxIter)
+	    return -1;
+
+	for (int i=0; i<n; i++)
+	    V[i] = r[i]/beta;
+	for (int i=0; i<=m; i++)
+	    g[i] = 0.0;
+	g[0] = beta;
+
+	int k = 0;
+	while (k < m && iter < maxIter) {
+	    double *vk = V + (size_t)k*n;
+	    double *w = vk + n;
+	    theOperator.precondition(vk, z);
+	    if (theOperator.multiply(z, w) < 0)
+		return -1;
+
+	    // modified Gram-Schmidt
+	    double *Hk = &H[(size_t)k*ldH];
+	    for (int i=0; i<=k; i++) {
+		double *vi = V + (size_t)i*n;
+		double h = dotProduct(n, w, vi);
+		Hk[i] = h;
+		for (int j=0; j<n; j++)
+		    w[j] -= h*vi[j];
+	    }
+	    double hNext = sqrt(dotProduct(n, w, w));
+	    Hk[k+1] = hNext;
+	    if (hNext != 0.0)
+		for (int j=0; j<n; j++)
+		    w[j] /= hNext;
+
+	    // apply the previous rotations and find the one eliminating H(k+1,k)
+	    for (int i=0; i<k; i++) {
+		double temp = cs[i]*Hk[i] + sn[i]*Hk[i+1];
+		Hk[i+1] = -sn[i]*Hk[i] + cs[i]*Hk[i+1];
+		Hk[i] = temp;
+	    }
+	    double d = sqrt(Hk[k]*Hk[k] + Hk[k+1]*Hk[k+1]);
+	    if (d == 0.0) {
+		cs[k] = 1.0;
+		sn[k] = 0.0;
+	    } else {
+		cs[k] = Hk[k]/d;
+		sn[k] = Hk[k+1]/d;
+	    }
+	    Hk[k] = d;
+	    Hk[k+1] = 0.0;
+	    g[k+1] = -sn[k]*g[k];
+	    g[k] = cs[k]*g[k];
+
+	    k++;
+	    iter++;
+	    if (fabs(g[k]) <= tolNorm || hNext == 0.0)
+		break;
+	}
+
+	// x += M^-1 V y with H y = g
+	for (int i=k-1; i>=0; i--) {
+	    double sum = g[i];
+	    for (int j=i+1; j<k; j++)
+		sum -= H[i + (size_t)j*ldH]*y[j];
+	    double hii = H[i + (size_t)i*ldH];
+	    y[i] = (hii != 0.0) ? sum/hii : 0.0;
+	}
+	for (int i=0; i<n; i++)
+	    u[i] = 0.0;
+	for (int j=0; j<k; j++) {
+	    double *vj = V + (size_t)j*n;
+	    for (int i=0; i<n; i++)
+		u[i] += y[j]*vj[i];
+	}
+	theOperator.precondition(u, z);
+	for (int i=0; i<n; i++)
+	    x[i] += z[i];
+
+	if (theOperator.multiply(x, r) < 0)
+	    return -1;
+	for (int i=0; i<n; i++)
+	    r[i] = b[i] - r[i];
+    }
+
+    return -1;
+}
+
+
+int
+KrylovIteration::solve(KrylovOperator &theOperator, double *x, const double *b)
+{
+    if (n == 0)
+	return 0;
+
+    double bNorm = sqrt(dotProduct(n, b, b));
+    if (bNorm == 0.0) {
+	for (int i=0; i<n; i++)
+	    x[i] = 0.0;
+	return 0;
+    }
+
+    if (method == GMRES)
+	return this->solveGMRES(theOperator, x, b, bNorm);
+    else if (method == BiCGStab)
+	return this->solveBiCGStab(theOperator, x, b, bNorm);
+    else
+	return this->solveCG(theOperator, x, b, bNorm);
+}
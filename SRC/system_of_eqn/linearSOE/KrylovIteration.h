@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+// Description: This file contains the class definitions for KrylovOperator
+// and KrylovIteration. KrylovIteration holds the conjugate gradient,
+// restarted GMRES and BiCGStab loops shared by the iterative solvers. A
+// solver supplies the product A*x and the preconditioner M^-1 r through
+// the KrylovOperator it passes to solve(); GMRES and BiCGStab apply the
+// preconditioner from the right, CG symmetrically. The iterations start
+// from the x passed in when that is a better guess than zero.
+
+#ifndef KrylovIteration_h
+#define KrylovIteration_h
+
+#include <vector>
+
+class KrylovOperator
+{
+  public:
+    virtual ~KrylovOperator() {}
+
+    // y = A*x, returns < 0 if the product could not be formed
+    virtual int multiply(const double *x, double *y) = 0;
+    // z = M^-1 r
+    virtual void precondition(const double *r, double *z) = 0;
+};
+
+class KrylovIteration
+{
+  public:
+    enum { CG = 0, GMRES = 1, BiCGStab = 2 };
+
+    KrylovIteration(int method = CG, double tol = 1.0e-8,
+		    int maxIter = 1000, int restart = 50,
+		    bool warmStart = true);
+    ~KrylovIteration();
+
+    void setSize(int n);
+
+    // returns the number of iterations, or < 0 if A*x could not be formed
+    // or the iterations did not converge in maxIter
+    int solve(KrylovOperator &theOperator, double *x, const double *b);
+
+    int getMaxIter(void) const {return maxIter;}
+
+  private:
+    static double dotProduct(int n, const double *a, const double *b);
+    int initialResidual(KrylovOperator &theOperator,
+			double *x, const double *b, double *r, double bNorm);
+    int solveCG(KrylovOperator &theOperator, double *x, const double *b, double bNorm);
+    int solveGMRES(KrylovOperator &theOperator, double *x, const double *b, double bNorm);
+    int solveBiCGStab(KrylovOperator &theOperator, double *x, const double *b, double bNorm);
+
+    int method;
+    double tol;
+    int maxIter, restart;
+    bool warmStart;
+
+    int n;
+    std::vector<double> work;             // Krylov vectors
+};
+
+#endif
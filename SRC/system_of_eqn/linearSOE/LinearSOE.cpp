@@ -32,6 +32,52 @@
 
 #include<LinearSOE.h>
 #include<LinearSOESolver.h>
+#include<Vector.h>
+#include<Matrix.h>
+#include<AnalysisProfiler.h>
+#include<AnalysisModel.h>
+#include<Domain.h>
+#include<math.h>
+#include<vector>
+
+static double
+normSum(double sum, double value, int normType)
+{
+  if (normType == 2)
+    return sum + value*value;
+  else if (normType == 1)
+    return sum + fabs(value);
+  else if (normType <= 0)
+    return (fabs(value) > sum) ? fabs(value) : sum;
+  else
+    return sum + pow(fabs(value), normType);
+}
+
+// the partial sums of the blocks added pairwise, in a tree fixed by the
+// number of blocks, the max norm taking the largest
+static double
+normPairwise(std::vector<double> &part, int normType)
+{
+  int num = part.size();
+  for (int step=1; step<num; step*=2)
+    for (int i=0; i+step<num; i+=2*step)
+      if (normType <= 0)
+	part[i] = (part[i+step] > part[i]) ? part[i+step] : part[i];
+      else
+	part[i] += part[i+step];
+  return (num > 0) ? part[0] : 0.0;
+}
+
+static double
+normFinish(double sum, int normType)
+{
+  if (normType == 2)
+    return sqrt(sum);
+  else if (normType > 2)
+    return pow(sum, 1.0/normType);
+  else
+    return sum;
+}
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
     :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
@@ -55,10 +101,18 @@ LinearSOE::~LinearSOE()
 int 
 LinearSOE::solve(void)
 {
-  if (theSolver != 0)
-    return (theSolver->solve());
-  else 
+  if (theSolver == 0)
     return -1;
+
+  // a solve that factors A is counted as factorization, for the solvers
+  // that count their factorizations
+  ProfilePhase phase(AnalysisProfiler::Solve);
+  int numFactor = theSolver->getNumNumericFactor();
+  int res = theSolver->solve();
+  if (theSolver->getNumNumericFactor() != numFactor)
+    phase.setPhase(AnalysisProfiler::Factorization);
+
+  return res;
 }
 
 int
@@ -67,6 +121,15 @@ LinearSOE::formAp(const Vector &p, Vector &Ap)
   return 0;
 }
 
+size_t
+LinearSOE::getFactorMemoryUsage(void)
+{
+  if (theSolver != 0)
+    return theSolver->getMemoryUsage();
+  else
+    return 0;
+}
+
 double
 LinearSOE::getDeterminant(void)
 {
@@ -77,6 +140,86 @@ LinearSOE::getDeterminant(void)
 }
 
 
+// the convergence tests need up to three reductions over B & X every
+// iteration, they are done together so that each vector is read once;
+// getB() is an exchange for the distributed systems & is only invoked
+// when a quantity involving B is asked for
+int
+LinearSOE::getNorms(int normType, double *normB, double *normX,
+		    double *productXB)
+{
+  bool wantB = (normB != 0 || productXB != 0);
+  bool wantX = (normX != 0 || productXB != 0);
+
+  const Vector *b = wantB ? &(this->getB()) : 0;
+  const Vector *x = wantX ? &(this->getX()) : 0;
+
+  if (b != 0 && x != 0 && b->Size() != x->Size()) {
+    opserr << "WARNING LinearSOE::getNorms() - B and X differ in size\n";
+    return -1;
+  }
+
+  double sumB = 0.0;
+  double sumX = 0.0;
+  double product = 0.0;
+
+  // deterministic: blocks of a fixed size are summed concurrently and the
+  // block sums added pairwise, the same whatever the number of threads
+  const int blockSize = 4096;
+  int size = (b != 0) ? b->Size() : ((x != 0) ? x->Size() : 0);
+  Domain *theDomain = (theModel != 0) ? theModel->getDomainPtr() : 0;
+  if (theDomain != 0 && theDomain->getDeterministic() == true && size > blockSize) {
+    int numBlock = (size + blockSize - 1)/blockSize;
+    std::vector<double> partB(numBlock, 0.0), partX(numBlock, 0.0), partXB(numBlock, 0.0);
+#pragma omp parallel for schedule(static)
+    for (int k=0; k<numBlock; k++) {
+      int first = k*blockSize;
+      int last = (first + blockSize < size) ? first + blockSize : size;
+      double sB = 0.0, sX = 0.0, sXB = 0.0;
+      for (int i=first; i<last; i++) {
+	if (b != 0)
+	  sB = normSum(sB, (*b)(i), normType);
+	if (x != 0)
+	  sX = normSum(sX, (*x)(i), normType);
+	if (b != 0 && x != 0)
+	  sXB += (*x)(i)*(*b)(i);
+      }
+      partB[k] = sB;
+      partX[k] = sX;
+      partXB[k] = sXB;
+    }
+    sumB = normPairwise(partB, normType);
+    sumX = normPairwise(partX, normType);
+    product = normPairwise(partXB, 1);
+  } else if (b != 0 && x != 0) {
+    int size = b->Size();
+    for (int i=0; i<size; i++) {
+      double bi = (*b)(i);
+      double xi = (*x)(i);
+      sumB = normSum(sumB, bi, normType);
+      sumX = normSum(sumX, xi, normType);
+      product += xi*bi;
+    }
+  } else if (b != 0) {
+    int size = b->Size();
+    for (int i=0; i<size; i++)
+      sumB = normSum(sumB, (*b)(i), normType);
+  } else if (x != 0) {
+    int size = x->Size();
+    for (int i=0; i<size; i++)
+      sumX = normSum(sumX, (*x)(i), normType);
+  }
+
+  if (normB != 0)
+    *normB = normFinish(sumB, normType);
+  if (normX != 0)
+    *normX = normFinish(sumX, normType);
+  if (productXB != 0)
+    *productXB = product;
+
+  return 0;
+}
+
 
 int 
 LinearSOE::setSolver(LinearSOESolver &newSolver)
@@ -108,3 +251,34 @@ int
 LinearSOE::addColA(const Vector &col, int colIndex, double fact) {
   return -1;
 }
+
+
+int
+LinearSOE::solveMultiple(const Matrix &B, Matrix &X)
+{
+    int n = this->getNumEqn();
+    int numRHS = B.noCols();
+    if (B.noRows() != n) {
+	opserr << "LinearSOE::solveMultiple() - B has " << B.noRows();
+	opserr << " rows, the system " << n << " equations\n";
+	return -1;
+    }
+    if (X.noRows() != n || X.noCols() != numRHS)
+	X.resize(n, numRHS);
+
+    // one column at a time, only the first solve factors A
+    Vector b(n);
+    for (int j = 0; j < numRHS; j++) {
+	for (int i = 0; i < n; i++)
+	    b(i) = B(i,j);
+	this->setB(b);
+	int res = this->solve();
+	if (res < 0)
+	    return res;
+	const Vector &x = this->getX();
+	for (int i = 0; i < n; i++)
+	    X(i,j) = x(i);
+    }
+
+    return 0;
+}
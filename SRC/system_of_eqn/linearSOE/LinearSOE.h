@@ -40,6 +40,7 @@
 // What: "@(#) LinearSOE.h, revA"
 
 #include <MovableObject.h>
+#include <stddef.h>
 
 class LinearSOESolver;
 class Graph;
@@ -72,6 +73,10 @@ class LinearSOE : public MovableObject
     virtual void zeroA(void) =0;
     virtual void zeroB(void) =0;
 
+    // true if addA and addB may be called concurrently for matrices and
+    // vectors with no equation in common, each touching only its entries
+    virtual bool isAddConcurrent(void) {return false;};
+
     virtual int formAp(const Vector &p, Vector &Ap);
 
     virtual const Vector &getX(void) = 0;
@@ -80,8 +85,22 @@ class LinearSOE : public MovableObject
     virtual double getDeterminant(void);
     virtual double normRHS(void) = 0;
 
+    // bytes of the storage of A, B & X, and of the factors held by the
+    // solver apart from that storage, for the memory report
+    virtual size_t getMemoryUsage(void) {return 0;};
+    virtual size_t getFactorMemoryUsage(void);
+
+    // p-norms (p <= 0 the max norm) of B & X and X'B in one pass, only
+    // the quantities with a non-null pointer are computed
+    virtual int getNorms(int normType, double *normB, double *normX,
+			 double *productXB = 0);
+
     virtual void setX(int loc, double value) =0;
     virtual void setX(const Vector &X) =0;
+
+    // solves A X = B for all the columns of B with the current A, which
+    // is factored at most once; X is resized to the size of B
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
     
     LinearSOESolver *getSolver(void);
     
@@ -38,7 +38,8 @@
 
 
 LinearSOESolver::LinearSOESolver(int classtag)
-:MovableObject(classtag)
+:MovableObject(classtag), numSymbolicFactor(0), numNumericFactor(0),
+ equationsOrdered(false)
 {
     
 }
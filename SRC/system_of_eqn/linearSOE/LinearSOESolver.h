@@ -38,6 +38,7 @@
 #define LinearSOESolver_h
 
 #include <MovableObject.h>
+#include <stddef.h>
 class LinearSOE;
 
 class LinearSOESolver : public MovableObject
@@ -49,8 +50,27 @@ class LinearSOESolver : public MovableObject
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
     virtual double getDeterminant(void) {return 1.0;};
+
+    // bytes of the factors & work storage held by the solver, apart from
+    // the storage of its LinearSOE, for the memory report
+    virtual size_t getMemoryUsage(void) {return 0;};
+
+    // number of symbolic (ordering + structure) and numeric factorizations
+    // performed since construction or the last resetFactorCounts()
+    int getNumSymbolicFactor(void) const {return numSymbolicFactor;};
+    int getNumNumericFactor(void) const {return numNumericFactor;};
+    void resetFactorCounts(void) {numSymbolicFactor = 0; numNumericFactor = 0;};
+
+    // set before setSize() by the analysis when the DOF_Numberer has put
+    // the equations in a fill-reducing order; solvers that compute their
+    // own ordering can then keep the equations as they are
+    virtual void setEquationsOrdered(bool ordered) {equationsOrdered = ordered;};
+    bool getEquationsOrdered(void) const {return equationsOrdered;};
     
   protected:
+    int numSymbolicFactor;
+    int numNumericFactor;
+    bool equationsOrdered;
     
   private:
 
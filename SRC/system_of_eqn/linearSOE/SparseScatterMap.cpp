@@ -0,0 +1,180 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of SparseScatterMap.
+
+#include <SparseScatterMap.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <ID.h>
+#include <Matrix.h>
+
+SparseScatterMap::SparseScatterMap()
+{
+
+}
+
+
+SparseScatterMap::~SparseScatterMap()
+{
+
+}
+
+
+void
+SparseScatterMap::clear(void)
+{
+  theIDs.clear();
+  theData.clear();
+}
+
+
+int
+SparseScatterMap::build(AnalysisModel &theModel, int size,
+			const int *outerStart, const int *innerIndex,
+			bool lowerOnly)
+{
+  this->clear();
+
+  if (size == 0 || outerStart == 0 || innerIndex == 0)
+    return 0;
+
+  FE_Element *theEle;
+  FE_EleIter &theEles = theModel.getFEs();
+  while ((theEle = theEles()) != 0)
+    if (this->addID(theEle->getID(), size, outerStart, innerIndex, lowerOnly) < 0)
+      return -1;
+
+  DOF_Group *theDOF;
+  DOF_GrpIter &theDOFs = theModel.getDOFs();
+  while ((theDOF = theDOFs()) != 0)
+    if (this->addID(theDOF->getID(), size, outerStart, innerIndex, lowerOnly) < 0)
+      return -1;
+
+  return 0;
+}
+
+
+int
+SparseScatterMap::addID(const ID &id, int size,
+			const int *outerStart, const int *innerIndex,
+			bool lowerOnly)
+{
+  int idSize = id.Size();
+  if (idSize == 0)
+    return 0;
+
+  int start = theData.size();
+  theData.resize(start + 1 + idSize + idSize*idSize);
+  int *data = &theData[start];
+
+  data[0] = idSize;
+  for (int i=0; i<idSize; i++)
+    data[1+i] = id(i);
+
+  int *loc = data + 1 + idSize;
+  for (int i=0; i<idSize; i++) {
+    int outer = id(i);
+    bool inSystem = (outer >= 0 && outer < size);
+    for (int j=0; j<idSize; j++, loc++) {
+      *loc = -1;
+      int inner = id(j);
+      if (inSystem == false || inner < 0 || inner >= size)
+	continue;
+      if (lowerOnly == true && inner < outer)
+	continue;
+      for (int k=outerStart[outer]; k<outerStart[outer+1]; k++)
+	if (innerIndex[k] == inner) {
+	  *loc = k;
+	  break;
+	}
+      if (*loc == -1) {
+	// the graph does not hold the entry, leave this ID to the search
+	theData.resize(start);
+	return 0;
+      }
+    }
+  }
+
+  theIDs[&id] = start;
+
+  return 0;
+}
+
+
+const int *
+SparseScatterMap::getLocations(const ID &id) const
+{
+  std::unordered_map<const ID *, int>::const_iterator it = theIDs.find(&id);
+  if (it == theIDs.end())
+    return 0;
+
+  // check the ID has not been changed since the map was built
+  const int *data = &theData[it->second];
+  int idSize = id.Size();
+  if (data[0] != idSize)
+    return 0;
+  for (int i=0; i<idSize; i++)
+    if (data[1+i] != id(i))
+      return 0;
+
+  return data + 1 + idSize;
+}
+
+
+// the common element sizes (2 and 4 node frames, 8 node bricks) are
+// instantiated with the size known at compile time so the loops unroll
+template <int n, bool colStorage>
+void
+SparseScatterMap::addMatrix(double *A, const int *loc, const Matrix &m, double fact)
+{
+  for (int i=0; i<n; i++)
+    for (int j=0; j<n; j++, loc++)
+      if (*loc >= 0)
+	A[*loc] += fact * (colStorage ? m(j,i) : m(i,j));
+}
+
+
+void
+SparseScatterMap::addMatrix(double *A, const int *loc, const Matrix &m, int n,
+			    double fact, bool colStorage)
+{
+  switch (n) {
+  case 6:
+    if (colStorage) addMatrix<6,true>(A, loc, m, fact); else addMatrix<6,false>(A, loc, m, fact);
+    return;
+  case 12:
+    if (colStorage) addMatrix<12,true>(A, loc, m, fact); else addMatrix<12,false>(A, loc, m, fact);
+    return;
+  case 24:
+    if (colStorage) addMatrix<24,true>(A, loc, m, fact); else addMatrix<24,false>(A, loc, m, fact);
+    return;
+  default:
+    break;
+  }
+
+  for (int i=0; i<n; i++)
+    for (int j=0; j<n; j++, loc++)
+      if (*loc >= 0)
+	A[*loc] += fact * (colStorage ? m(j,i) : m(i,j));
+}
@@ -0,0 +1,72 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the class definition for SparseScatterMap.
+// SparseScatterMap stores, for every FE_Element and DOF_Group ID of an
+// AnalysisModel, the locations in a compressed row or column storage
+// array of the entries that the ID maps to. It is built once when the
+// SOE is sized so that addA() can add directly into the storage instead
+// of searching the index array for every entry on every assembly.
+// Locations are stored outer index major, i.e. loc[i*n+j] is the
+// location of (outer = id(i), inner = id(j)); -1 marks an entry not
+// in the system (negative or out of range equation number). If only the
+// lower triangle (inner >= outer) is stored, build() is told so and the
+// entries above the diagonal are marked -1.
+
+#ifndef SparseScatterMap_h
+#define SparseScatterMap_h
+
+#include <unordered_map>
+#include <vector>
+
+class ID;
+class Matrix;
+class AnalysisModel;
+
+class SparseScatterMap
+{
+  public:
+    SparseScatterMap();
+    ~SparseScatterMap();
+
+    int  build(AnalysisModel &theModel, int size,
+	       const int *outerStart, const int *innerIndex,
+	       bool lowerOnly = false);
+    void clear(void);
+
+    // returns 0 if the ID was not mapped or has changed since build()
+    const int *getLocations(const ID &id) const;
+
+    // adds fact*m into A at the locations of an ID of size n, with 
+    // m(inner,outer) at loc[i*n+j] if colStorage is true, else m(outer,inner)
+    static void addMatrix(double *A, const int *loc, const Matrix &m, int n,
+			  double fact, bool colStorage);
+
+  private:
+    template <int n, bool colStorage>
+      static void addMatrix(double *A, const int *loc, const Matrix &m, double fact);
+    int addID(const ID &id, int size,
+	      const int *outerStart, const int *innerIndex, bool lowerOnly);
+
+    std::unordered_map<const ID *, int> theIDs; // ID address -> start in theData
+    std::vector<int> theData;  // per ID: a copy of the ID followed by the locations
+};
+
+#endif
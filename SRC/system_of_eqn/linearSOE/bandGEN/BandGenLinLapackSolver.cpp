@@ -70,6 +70,9 @@ extern "C" int DGBTRS(char *TRANS,
 			       double *A, int *LDA, int *iPiv, 
 			       double *B, int *LDB, int *INFO);
 
+extern "C" int DGBTRF(int *M, int *N, int *KL, int *KU, double *A, 
+			       int *LDA, int *iPiv, int *INFO);
+
 #else
 
 extern "C" int dgbsv_(int *N, int *KL, int *KU, int *NRHS, double *A, 
@@ -79,6 +82,9 @@ extern "C" int dgbsv_(int *N, int *KL, int *KU, int *NRHS, double *A,
 extern "C" int dgbtrs_(char *TRANS, int *N, int *KL, int *KU, int *NRHS, 
 		       double *A, int *LDA, int *iPiv, double *B, int *LDB, 
 		       int *INFO);
+
+extern "C" int dgbtrf_(int *M, int *N, int *KL, int *KU, double *A, 
+		       int *LDA, int *iPiv, int *INFO);
 #endif
 int
 BandGenLinLapackSolver::solve(void)
@@ -148,12 +154,74 @@ BandGenLinLapackSolver::solve(void)
       }
     }
 
+    if (theSOE->factored == false)
+      numNumericFactor++;
     theSOE->factored = true;
     return 0;
 }
     
 
 
+// factors A if it has not been and then solves for all the columns
+// with one call, so the factors are only read once per block
+int
+BandGenLinLapackSolver::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;    
+    if (iPivSize < n) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple()- ";
+	opserr << " iPiv not large enough - has setSize() been called?\n";
+	return -1;
+    }	    
+
+    int kl = theSOE->numSubD;
+    int ku = theSOE->numSuperD;
+    int ldA = 2*kl + ku +1;
+    int ldB = n;
+    int info = 0;
+    double *Aptr = theSOE->A;
+
+    if (theSOE->factored == false) {
+#ifdef _WIN32
+	DGBTRF(&n,&n,&kl,&ku,Aptr,&ldA,iPiv,&info);
+#else
+	dgbtrf_(&n,&n,&kl,&ku,Aptr,&ldA,iPiv,&info);
+#endif
+	if (info != 0) {
+	  if (info > 0) {
+	    opserr << "WARNING BandGenLinLapackSolver::solveMultiple() -";
+	    opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	    return -info+1;
+	  } else {
+	    opserr << "WARNING BandGenLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	    return info;
+	  }
+	}
+	numNumericFactor++;
+	theSOE->factored = true;
+    }
+
+    char type[] = "N";
+#ifdef _WIN32
+    DGBTRS(type,&n,&kl,&ku,&numRHS,Aptr,&ldA,iPiv,BX,&ldB,&info);
+#else
+    dgbtrs_(type,&n,&kl,&ku,&numRHS,Aptr,&ldA,iPiv,BX,&ldB,&info);
+#endif
+    if (info != 0) {
+	opserr << "WARNING BandGenLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	return info;
+    }
+
+    return 0;
+}
+
+
 int
 BandGenLinLapackSolver::setSize()
 {
@@ -175,6 +243,13 @@ BandGenLinLapackSolver::setSize()
     return 0;
 }
 
+// the factors overwrite A, only the pivots are the solver's
+size_t
+BandGenLinLapackSolver::getMemoryUsage(void)
+{
+    return iPivSize*sizeof(int);
+}
+
 int    
 BandGenLinLapackSolver::sendSelf(int commitTag, Channel &theChannel)
 {
@@ -47,7 +47,9 @@ class BandGenLinLapackSolver : public BandGenLinSolver
     ~BandGenLinLapackSolver();
 
     int solve(void);
+    int solveMultiple(int numRHS, double *BX);
     int setSize(void);
+    size_t getMemoryUsage(void);
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
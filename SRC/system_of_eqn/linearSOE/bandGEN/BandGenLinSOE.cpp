@@ -494,6 +494,13 @@ BandGenLinSOE::getB(void)
 }
 
 
+// A, B & X, the factors of the solver are computed in A
+size_t
+BandGenLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + 2*sizeof(Vector);
+}
+
 double 
 BandGenLinSOE::normRHS(void)
 {
@@ -554,3 +561,21 @@ BandGenLinSOE::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &th
 }
 
 
+int
+BandGenLinSOE::solveMultiple(const Matrix &Bm, Matrix &Xm)
+{
+    int numRHS = Bm.noCols();
+    if (Bm.noRows() != size) {
+	opserr << "WARNING BandGenLinSOE::solveMultiple() - B has " << Bm.noRows();
+	opserr << " rows, the system " << size << " equations\n";
+	return -1;
+    }
+
+    // the columns are solved in place in X
+    Xm = Bm;
+    if (size == 0 || numRHS == 0)
+	return 0;
+
+    BandGenLinSolver *theSolvr = (BandGenLinSolver *)this->getSolver();
+    return theSolvr->solveMultiple(numRHS, &Xm(0,0));
+}
@@ -67,14 +67,18 @@ class BandGenLinSOE : public LinearSOE
     virtual const Vector &getX(void);
     virtual const Vector &getB(void);
     virtual double normRHS(void);
+    virtual size_t getMemoryUsage(void);
 
     virtual void setX(int loc, double value);    
     virtual void setX(const Vector &x);    
 
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
+
     virtual int setBandGenSolver(BandGenLinSolver &newSolver);    
 
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
+    friend class BandGenLinSolver;
     friend class BandGenLinLapackSolver;
 
   protected:
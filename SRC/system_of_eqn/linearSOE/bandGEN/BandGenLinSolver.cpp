@@ -59,3 +59,27 @@ BandGenLinSolver::setLinearSOE(BandGenLinSOE &theBandGenSOE)
     return 0;
 }
 
+
+int
+BandGenLinSolver::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandGenLinSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    for (int j=0; j<numRHS; j++) {
+	double *col = BX + (long)j*n;
+	for (int i=0; i<n; i++)
+	    theSOE->B[i] = col[i];
+	int res = this->solve();
+	if (res < 0)
+	    return res;
+	for (int i=0; i<n; i++)
+	    col[i] = theSOE->X[i];
+    }
+
+    return 0;
+}
@@ -40,7 +40,8 @@
 
 DistributedBandGenLinSOE::DistributedBandGenLinSOE(BandGenLinSolver &theSolvr)
   :BandGenLinSOE(LinSOE_TAGS_DistributedBandGenLinSOE), 
-   processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0), myVectB(0)
+   processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0), myVectB(0),
+   remoteB(0), sizeRemoteB(0)
 {
 	this->setSolver(theSolvr);
     theSolvr.setLinearSOE(*this);
@@ -48,7 +49,8 @@ DistributedBandGenLinSOE::DistributedBandGenLinSOE(BandGenLinSolver &theSolvr)
 
 DistributedBandGenLinSOE::DistributedBandGenLinSOE()
   :BandGenLinSOE(LinSOE_TAGS_DistributedBandGenLinSOE), 
-   processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0), myVectB(0)
+   processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0), myVectB(0),
+   remoteB(0), sizeRemoteB(0)
 {
 
 }
@@ -73,6 +75,46 @@ DistributedBandGenLinSOE::~DistributedBandGenLinSOE()
 
   if (myB == 0)
     delete [] myB;
+
+  if (remoteB != 0)
+    delete [] remoteB;
+}
+
+
+// P0 posts the receives of the B contributions of all subprocesses at
+// once; each goes into its own part of remoteB so they can arrive in any order
+int
+DistributedBandGenLinSOE::postRecvB(void)
+{
+  int needed = numChannels * size;
+  if (needed > sizeRemoteB) {
+    if (remoteB != 0)
+      delete [] remoteB;
+    remoteB = new double[needed];
+    sizeRemoteB = needed;
+  }
+
+  for (int j=0; j<numChannels; j++) {
+    Vector theB(&remoteB[j*size], size);
+    theChannels[j]->irecvVector(0, 0, theB);
+  }
+
+  return 0;
+}
+
+
+// P0 waits on the posted receives and adds the contributions into B
+int
+DistributedBandGenLinSOE::addRemoteB(void)
+{
+  for (int j=0; j<numChannels; j++) {
+    theChannels[j]->waitAll();
+    double *theB = &remoteB[j*size];
+    for (int i=0; i<size; i++)
+      B[i] += theB[i];
+  }
+
+  return 0;
 }
 
 
@@ -400,19 +442,19 @@ DistributedBandGenLinSOE::solve(void)
     Channel *theChannel = theChannels[0];
 
     // send B
-    theChannel->sendVector(0, 0, *myVectB);
+    theChannel->isendVector(0, 0, *myVectB);
 
     // send A in packets placed in vector X
     //    Vector vectA(A, Asize);    
-    if (factored == false) {
-      Vector vectA(A, sizeWork);        
-      theChannel->sendVector(0, 0, vectA);
-    }
+    Vector vectA(A, sizeWork);        
+    if (factored == false)
+      theChannel->isendVector(0, 0, vectA);
 
     // receive X,B and result
-    theChannel->recvVector(0, 0, *vectX);
-    theChannel->recvVector(0, 0, *vectB);
-    theChannel->recvID(0, 0, result);
+    theChannel->irecvVector(0, 0, *vectX);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->irecvID(0, 0, result);
+    theChannel->waitAll();
     
     factored = true;
   } 
@@ -426,13 +468,12 @@ DistributedBandGenLinSOE::solve(void)
     // add P0 contribution to B
     *vectB = *myVectB;
 
-    // receive X and A contribution from subprocess & add them in
-    for (int j=0; j<numChannels; j++) {
+    // post the receives of the B contributions, they come in while A is added
+    this->postRecvB();
 
-      // get X & add
+    // receive A contribution from subprocess & add them in
+    for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, *vectX);
-      *vectB += *vectX;
 
       // get A & add using local map
       if (factored == false) {
@@ -450,17 +491,21 @@ DistributedBandGenLinSOE::solve(void)
 	}    
       }
     }
+
+    this->addRemoteB();
     
     // solve
     result(0) = this->LinearSOE::solve();
 
-    // send results back
+    // send results back to all at once
     for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectX);
-      theChannel->sendVector(0, 0, *vectB);
-      theChannel->sendID(0, 0, result);      
+      theChannel->isendVector(0, 0, *vectX);
+      theChannel->isendVector(0, 0, *vectB);
+      theChannel->isendID(0, 0, result);      
     }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
 
   return result(0);
@@ -549,8 +594,9 @@ DistributedBandGenLinSOE::getB(void)
     Channel *theChannel = theChannels[0];
 
     // send B & recv merged B
-    theChannel->sendVector(0, 0, *myVectB);
-    theChannel->recvVector(0, 0, *vectB);
+    theChannel->isendVector(0, 0, *myVectB);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->waitAll();
   } 
 
   //
@@ -561,21 +607,15 @@ DistributedBandGenLinSOE::getB(void)
 
     *vectB = *myVectB;
 
-    Vector remoteB(workArea, size);    
-    // receive X and A contribution from subprocess & add them in
-
-    for (int j=0; j<numChannels; j++) {
-
-      Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, remoteB);
-      *vectB += remoteB;
-    }
+    // receive B contribution from subprocess & add them in
+    this->postRecvB();
+    this->addRemoteB();
   
     // send results back
-    for (int j=0; j<numChannels; j++) {
-      Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectB);
-    }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->isendVector(0, 0, *vectB);
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
 
   return *vectB;
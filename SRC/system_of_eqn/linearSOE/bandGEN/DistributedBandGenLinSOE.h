@@ -66,6 +66,9 @@ class DistributedBandGenLinSOE : public BandGenLinSOE
   protected:
     
   private:
+    int postRecvB(void);
+    int addRemoteB(void);
+
     int processID;
     int numChannels;
     Channel **theChannels;
@@ -75,6 +78,8 @@ class DistributedBandGenLinSOE : public BandGenLinSOE
     int sizeWork;
     double *myB;
     Vector *myVectB;
+    double *remoteB;     // B contributions of the subprocesses, on P0
+    int sizeRemoteB;
 };
 
 
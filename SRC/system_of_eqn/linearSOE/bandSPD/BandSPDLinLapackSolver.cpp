@@ -64,6 +64,9 @@ extern "C" int  DPBTRS(char *UPLO,
 			       int *N, int *KD, int *NRHS, 
 			       double *A, int *LDA, double *B, int *LDB, 
 			       int *INFO);
+
+extern "C" int  DPBTRF(char *UPLO, int *N, int *KD, 
+			       double *A, int *LDA, int *INFO);
 #else
 
 extern "C" int dpbsv_(char *UPLO, int *N, int *KD, int *NRHS, 
@@ -74,6 +77,9 @@ extern "C" int dpbtrs_(char *UPLO, int *N, int *KD, int *NRHS,
 		       double *A, int *LDA, double *B, int *LDB, 
 		       int *INFO);
 
+extern "C" int dpbtrf_(char *UPLO, int *N, int *KD, 
+		       double *A, int *LDA, int *INFO);
+
 #endif
 		       
 
@@ -137,12 +143,67 @@ BandSPDLinLapackSolver::solve(void)
       }      
     }
 
+    if (theSOE->factored == false)
+      numNumericFactor++;
     theSOE->factored = true;
     return 0;
 }
     
 
 
+// factors A if it has not been and then solves for all the columns
+// with one call, so the factors are only read once per block
+int
+BandSPDLinLapackSolver::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    int kd = theSOE->half_band -1;
+    int ldA = kd +1;
+    int ldB = n;
+    int info = 0;
+    double *Aptr = theSOE->A;
+    char uplo[] = "U";
+
+    if (theSOE->factored == false) {
+#ifdef _WIN32
+	DPBTRF(uplo,&n,&kd,Aptr,&ldA,&info);
+#else
+	dpbtrf_(uplo,&n,&kd,Aptr,&ldA,&info);
+#endif
+	if (info != 0) {
+	  if (info > 0) {
+	    opserr << "WARNING BandSPDLinLapackSolver::solveMultiple() -";
+	    opserr << "factorization failed, matrix singular U(i,i) = 0, i= " << info-1 << endln;
+	    return -info+1;
+	  } else {
+	    opserr << "WARNING BandSPDLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	    return info;
+	  }
+	}
+	numNumericFactor++;
+	theSOE->factored = true;
+    }
+
+#ifdef _WIN32
+    DPBTRS(uplo,&n,&kd,&numRHS,Aptr,&ldA,BX,&ldB,&info);
+#else
+    dpbtrs_(uplo,&n,&kd,&numRHS,Aptr,&ldA,BX,&ldB,&info);
+#endif
+    if (info != 0) {
+	opserr << "WARNING BandSPDLinLapackSolver::solveMultiple() - OpenSees code error\n";
+	return info;
+    }
+
+    return 0;
+}
+
+
 int
 BandSPDLinLapackSolver::setSize()
 {
@@ -461,6 +461,13 @@ BandSPDLinSOE::getB(void)
     return *vectB;
 }
 
+// A, B & X, the factors of the solver are computed in A
+size_t
+BandSPDLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + 2*sizeof(Vector);
+}
+
 double 
 BandSPDLinSOE::normRHS(void)
 {
@@ -505,3 +512,23 @@ BandSPDLinSOE::recvSelf(int tag, Channel &theChannel, FEM_ObjectBroker &theBroke
   opserr << "BandSPDLinSOE::recvSelf( - not implemented\n";
   return -1;
 }
+
+
+int
+BandSPDLinSOE::solveMultiple(const Matrix &Bm, Matrix &Xm)
+{
+    int numRHS = Bm.noCols();
+    if (Bm.noRows() != size) {
+	opserr << "WARNING BandSPDLinSOE::solveMultiple() - B has " << Bm.noRows();
+	opserr << " rows, the system " << size << " equations\n";
+	return -1;
+    }
+
+    // the columns are solved in place in X
+    Xm = Bm;
+    if (size == 0 || numRHS == 0)
+	return 0;
+
+    BandSPDLinSolver *theSolvr = (BandSPDLinSolver *)this->getSolver();
+    return theSolvr->solveMultiple(numRHS, &Xm(0,0));
+}
@@ -69,9 +69,13 @@ class BandSPDLinSOE : public LinearSOE
     virtual const Vector &getX(void);
     virtual const Vector &getB(void);    
     virtual double normRHS(void);
+    virtual size_t getMemoryUsage(void);
+    virtual bool isAddConcurrent(void) {return true;};
 
     virtual void setX(int loc, double value);    
     virtual void setX(const Vector &x);    
+
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
     virtual int setBandSPDSolver(BandSPDLinSolver &newSolver);    
 
     virtual int sendSelf(int commitTag, Channel &theChannel);
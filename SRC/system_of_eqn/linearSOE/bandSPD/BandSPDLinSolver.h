@@ -47,6 +47,10 @@ class BandSPDLinSolver : public LinearSOESolver
     virtual ~BandSPDLinSolver();
 
     virtual int solve(void) = 0;
+
+    // solves for the numRHS columns (of size n, one after the other) in
+    // BX, which are replaced by the solutions; by default one at a time
+    virtual int solveMultiple(int numRHS, double *BX);
     virtual int setLinearSOE(BandSPDLinSOE &theSOE);
     
   protected:
@@ -52,6 +52,7 @@ class DistributedBandSPDLinSOE : public BandSPDLinSOE
     int addB(const Vector &, const ID &, double fact = 1.0);    
     int setB(const Vector &, double fact = 1.0);            
     void zeroB(void);
+    bool isAddConcurrent(void) {return false;};
     int setSize(Graph &theGraph);
     int solve(void);
     const Vector &getB(void);
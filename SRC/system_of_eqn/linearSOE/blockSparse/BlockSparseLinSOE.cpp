@@ -0,0 +1,449 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for BlockSparseLinSOE
+
+#include <stdlib.h>
+#include <BlockSparseLinSOE.h>
+#include <BlockSparseLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <AnalysisModel.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <math.h>
+#include <algorithm>
+
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <iostream>
+using std::nothrow;
+
+BlockSparseLinSOE::BlockSparseLinSOE(BlockSparseLinSolver &the_Solver)
+:LinearSOE(the_Solver, LinSOE_TAGS_BlockSparseLinSOE),
+ size(0), numBlocks(0), B(0), X(0), vectX(0), vectB(0), Bsize(0),
+ changedA(true)
+{
+    the_Solver.setLinearSOE(*this);
+}
+
+
+BlockSparseLinSOE::~BlockSparseLinSOE()
+{
+    if (B != 0) delete [] B;
+    if (X != 0) delete [] X;
+    if (vectX != 0) delete vectX;
+    if (vectB != 0) delete vectB;
+}
+
+
+int
+BlockSparseLinSOE::getNumEqn(void) const
+{
+    return size;
+}
+
+
+int
+BlockSparseLinSOE::setSize(Graph &theGraph)
+{
+    int oldSize = size;
+    size = theGraph.getNumVertex();
+
+    try {
+	// the blocks: the equations of each DOF_Group, in the order of the
+	// group, then one block for each equation left over
+	eqBlock.assign(size, -1);
+	eqOffset.assign(size, 0);
+	blockEqStart.clear();
+	blockEq.clear();
+	blockEqStart.push_back(0);
+
+	if (theModel != 0) {
+	    DOF_Group *dofPtr;
+	    DOF_GrpIter &theDOFs = theModel->getDOFs();
+	    while ((dofPtr = theDOFs()) != 0) {
+		const ID &id = dofPtr->getID();
+		int numBlock = blockEqStart.size() - 1;
+		for (int i=0; i<id.Size(); i++) {
+		    int eq = id(i);
+		    if (eq >= 0 && eq < size && eqBlock[eq] < 0) {
+			eqBlock[eq] = numBlock;
+			eqOffset[eq] = blockEq.size() - blockEqStart.back();
+			blockEq.push_back(eq);
+		    }
+		}
+		if ((int)blockEq.size() > blockEqStart.back())
+		    blockEqStart.push_back(blockEq.size());
+	    }
+	}
+
+	for (int eq=0; eq<size; eq++)
+	    if (eqBlock[eq] < 0) {
+		eqBlock[eq] = blockEqStart.size() - 1;
+		eqOffset[eq] = 0;
+		blockEq.push_back(eq);
+		blockEqStart.push_back(blockEq.size());
+	    }
+
+	numBlocks = blockEqStart.size() - 1;
+
+	// the nonzero blocks of each block row, from the adjacency of its
+	// equations, and the location of their values
+	std::vector<int> mark(numBlocks, -1);
+	blockRowStart.assign(numBlocks+1, 0);
+	blockCol.clear();
+	valStart.clear();
+	valStart.push_back(0);
+
+	for (int I=0; I<numBlocks; I++) {
+	    int first = blockCol.size();
+	    mark[I] = I;
+	    blockCol.push_back(I);
+	    for (int p=blockEqStart[I]; p<blockEqStart[I+1]; p++) {
+		Vertex *theVertex = theGraph.getVertexPtr(blockEq[p]);
+		if (theVertex == 0)
+		    continue;
+		const ID &adj = theVertex->getAdjacency();
+		for (int a=0; a<adj.Size(); a++) {
+		    int col = adj(a);
+		    if (col < 0 || col >= size)
+			continue;
+		    int J = eqBlock[col];
+		    if (mark[J] != I) {
+			mark[J] = I;
+			blockCol.push_back(J);
+		    }
+		}
+	    }
+	    std::sort(blockCol.begin()+first, blockCol.end());
+	    blockRowStart[I+1] = blockCol.size();
+
+	    int bI = blockEqStart[I+1] - blockEqStart[I];
+	    for (int k=first; k<(int)blockCol.size(); k++) {
+		int J = blockCol[k];
+		int bJ = blockEqStart[J+1] - blockEqStart[J];
+		valStart.push_back(valStart.back() + bI*bJ);
+	    }
+	}
+
+	A.assign(valStart.back(), 0.0);
+
+    } catch (std::bad_alloc &) {
+	opserr << "WARNING BlockSparseLinSOE::setSize :";
+	opserr << " ran out of memory for A (size) (";
+	opserr << size << ") \n";
+	size = 0; numBlocks = 0;
+	return -1;
+    }
+
+    if (size > Bsize) { // we have to get space for the vectors
+
+	// delete the old
+	if (B != 0) delete [] B;
+	if (X != 0) delete [] X;
+
+	// create the new
+	B = new (nothrow) double[size];
+	X = new (nothrow) double[size];
+
+	if (B == 0 || X == 0) {
+	    opserr << "WARNING BlockSparseLinSOE::setSize :";
+	    opserr << " ran out of memory for vectors (size) (";
+	    opserr << size << ") \n";
+	    size = 0; Bsize = 0;
+	    return -1;
+	}
+	else
+	    Bsize = size;
+    }
+
+    // zero the vectors
+    for (int j=0; j<size; j++) {
+	B[j] = 0;
+	X[j] = 0;
+    }
+    changedA = true;
+
+    // create new Vectors objects
+    if (size != oldSize) {
+	if (vectX != 0)
+	    delete vectX;
+
+	if (vectB != 0)
+	    delete vectB;
+
+	vectX = new Vector(X,size);
+	vectB = new Vector(B,size);
+    }
+
+    // invoke setSize() on the Solver
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING:BlockSparseLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
+    return 0;
+}
+
+
+// the location of block (I,J) in blockCol, -1 if it is not in the graph
+int
+BlockSparseLinSOE::findBlock(int I, int J) const
+{
+    const int *first = &blockCol[0] + blockRowStart[I];
+    const int *last = &blockCol[0] + blockRowStart[I+1];
+    const int *pos = std::lower_bound(first, last, J);
+    if (pos == last || *pos != J)
+	return -1;
+    return pos - &blockCol[0];
+}
+
+
+int
+BlockSparseLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)
+	return 0;
+
+    int idSize = id.Size();
+
+    // check that m and id are of similar size
+    if (idSize != m.noRows() && idSize != m.noCols()) {
+	opserr << "BlockSparseLinSOE::addA() ";
+	opserr << " - Matrix and ID not of similar sizes\n";
+	return -1;
+    }
+
+    // the columns of one node follow each other in the ID, so the block
+    // found for the last column is tried first
+    for (int i=0; i<idSize; i++) {
+	int row = id(i);
+	if (row < 0 || row >= size)
+	    continue;
+	int I = eqBlock[row];
+	int ri = eqOffset[row];
+	int lastJ = -1;
+	double *blockRow = 0;
+	for (int j=0; j<idSize; j++) {
+	    int col = id(j);
+	    if (col < 0 || col >= size)
+		continue;
+	    int J = eqBlock[col];
+	    if (J != lastJ) {
+		int k = this->findBlock(I, J);
+		if (k < 0) {
+		    opserr << "WARNING BlockSparseLinSOE::addA() - entry (" << row << "," << col;
+		    opserr << ") is not in the graph of the SOE\n";
+		    return -1;
+		}
+		int bJ = blockEqStart[J+1] - blockEqStart[J];
+		blockRow = &A[valStart[k]] + ri*bJ;
+		lastJ = J;
+	    }
+	    blockRow[eqOffset[col]] += fact * m(i,j);
+	}
+    }
+    changedA = true;
+
+    return 0;
+}
+
+
+int
+BlockSparseLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    int idSize = id.Size();
+    // check that m and id are of similar size
+    if (idSize != v.Size() ) {
+	opserr << "BlockSparseLinSOE::addB() ";
+	opserr << " - Vector and ID not of similar sizes\n";
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i);
+	}
+    } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] -= v(i);
+	}
+    } else {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+BlockSparseLinSOE::setB(const Vector &v, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    if (v.Size() != size) {
+	opserr << "WARNING BlockSparseLinSOE::setB() -";
+	opserr << " incompatible sizes " << size << " and " << v.Size() << endln;
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i);
+	}
+    } else if (fact == -1.0) {
+	for (int i=0; i<size; i++) {
+	    B[i] = -v(i);
+	}
+    } else {
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i) * fact;
+	}
+    }
+    return 0;
+}
+
+
+void
+BlockSparseLinSOE::zeroA(void)
+{
+    std::fill(A.begin(), A.end(), 0.0);
+    changedA = true;
+}
+
+
+void
+BlockSparseLinSOE::zeroB(void)
+{
+    double *Bptr = B;
+    for (int i=0; i<size; i++)
+	*Bptr++ = 0;
+}
+
+
+void
+BlockSparseLinSOE::setX(int loc, double value)
+{
+    if (loc < size && loc >=0)
+	X[loc] = value;
+}
+
+
+void
+BlockSparseLinSOE::setX(const Vector &x)
+{
+    if (x.Size() == size && vectX != 0)
+	*vectX = x;
+}
+
+
+const Vector &
+BlockSparseLinSOE::getX(void)
+{
+    if (vectX == 0) {
+	opserr << "FATAL BlockSparseLinSOE::getX - vectX == 0";
+	exit(-1);
+    }
+    return *vectX;
+}
+
+
+const Vector &
+BlockSparseLinSOE::getB(void)
+{
+    if (vectB == 0) {
+	opserr << "FATAL BlockSparseLinSOE::getB - vectB == 0";
+	exit(-1);
+    }
+    return *vectB;
+}
+
+
+double
+BlockSparseLinSOE::normRHS(void)
+{
+    double norm =0.0;
+    for (int i=0; i<size; i++) {
+	double Yi = B[i];
+	norm += Yi*Yi;
+    }
+    return sqrt(norm);
+}
+
+
+size_t
+BlockSparseLinSOE::getMemoryUsage(void)
+{
+    return (A.size() + 2*Bsize)*sizeof(double)
+	+ (eqBlock.size() + eqOffset.size() + blockEqStart.size() + blockEq.size()
+	   + blockRowStart.size() + blockCol.size() + valStart.size())*sizeof(int)
+	+ 2*sizeof(Vector);
+}
+
+
+int
+BlockSparseLinSOE::setBlockSparseLinSolver(BlockSparseLinSolver &newSolver)
+{
+    newSolver.setLinearSOE(*this);
+
+    if (size != 0) {
+	int solverOK = newSolver.setSize();
+	if (solverOK < 0) {
+	    opserr << "WARNING:BlockSparseLinSOE::setSolver :";
+	    opserr << "the new solver could not setSize() - staying with old\n";
+	    return -1;
+	}
+    }
+
+    return this->LinearSOE::setSolver(newSolver);
+}
+
+
+int
+BlockSparseLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+BlockSparseLinSOE::recvSelf(int cTag, Channel &theChannel,
+			    FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef BlockSparseLinSOE_h
+#define BlockSparseLinSOE_h
+
+// Description: This file contains the class definition for
+// BlockSparseLinSOE. BlockSparseLinSOE is a subclass of LinearSOE that
+// stores A in block compressed row storage, with the equations of each
+// DOF_Group of the AnalysisModel forming one block. Only the block column
+// and the start of the values are stored for each nonzero block, the
+// values of a block (bI x bJ) are stored dense and row major. Equations
+// that are not in a DOF_Group form blocks of their own. The blocks are
+// numbered in the order of the DOF_Groups, and the solver works with the
+// vectors in this block order (block I holds the equations
+// blockEq[blockEqStart[I]] ... blockEq[blockEqStart[I+1]-1]).
+//
+// What: "@(#) BlockSparseLinSOE.h, revA"
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <vector>
+
+class BlockSparseLinSolver;
+
+class BlockSparseLinSOE : public LinearSOE
+{
+  public:
+    BlockSparseLinSOE(BlockSparseLinSolver &theSolver);
+
+    ~BlockSparseLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+    size_t getMemoryUsage(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setBlockSparseLinSolver(BlockSparseLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class BlockSparseLinSolver;
+
+  protected:
+
+  private:
+    int findBlock(int I, int J) const;
+
+    int size;                          // order of A
+    int numBlocks;
+    std::vector<int> eqBlock, eqOffset;    // block of each equation and its
+                                           // position in the block
+    std::vector<int> blockEqStart, blockEq;  // equations of each block
+    std::vector<int> blockRowStart, blockCol; // nonzero blocks of each block row
+    std::vector<int> valStart;             // start of each nonzero block in A
+    std::vector<double> A;
+    double *B, *X;
+    Vector *vectX;
+    Vector *vectB;
+    int Bsize;
+    bool changedA;                     // A has been reformed since the last solve
+};
+
+#endif
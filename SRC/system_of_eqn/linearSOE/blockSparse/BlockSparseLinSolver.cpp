@@ -0,0 +1,475 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of BlockSparseLinSolver.
+
+#include <BlockSparseLinSolver.h>
+#include <BlockSparseLinSOE.h>
+#include <elementAPI.h>
+#include <math.h>
+#include <string.h>
+
+void* OPS_BlockSparseLinSolver()
+{
+    // system BlockSparse <-cg|-bicgstab> <-tol $tol> <-maxIter $maxIter>
+    //    <-noWarmStart>
+    int method = BlockSparseLinSolver::CG;
+    double tol = 1.0e-8;
+    int maxIter = 1000;
+    bool warmStart = true;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (opt == 0)
+	    continue;
+	if (strcmp(opt, "-cg") == 0 || strcmp(opt, "-CG") == 0) {
+	    method = BlockSparseLinSolver::CG;
+	} else if (strcmp(opt, "-bicgstab") == 0 || strcmp(opt, "-BiCGStab") == 0) {
+	    method = BlockSparseLinSolver::BiCGStab;
+	} else if (strcmp(opt, "-tol") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &tol) < 0) {
+		opserr << "WARNING system BlockSparse - invalid -tol value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-maxIter") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &maxIter) < 0) {
+		opserr << "WARNING system BlockSparse - invalid -maxIter value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-noWarmStart") == 0) {
+	    warmStart = false;
+	}
+    }
+
+    BlockSparseLinSolver *theSolver = new BlockSparseLinSolver(method, tol, maxIter, warmStart);
+    return new BlockSparseLinSOE(*theSolver);
+}
+
+
+static double
+dotProduct(int n, const double *a, const double *b)
+{
+    double sum = 0.0;
+    for (int i=0; i<n; i++)
+	sum += a[i]*b[i];
+    return sum;
+}
+
+
+// inverts the m x m row major matrix a into inv with partial pivoting,
+// a is overwritten; returns -1 if a is singular
+static int
+invertBlock(int m, double *a, double *inv)
+{
+    for (int i=0; i<m*m; i++)
+	inv[i] = 0.0;
+    for (int i=0; i<m; i++)
+	inv[i*m+i] = 1.0;
+
+    double aMax = 0.0;
+    for (int i=0; i<m*m; i++)
+	if (fabs(a[i]) > aMax)
+	    aMax = fabs(a[i]);
+    if (aMax == 0.0)
+	return -1;
+
+    for (int c=0; c<m; c++) {
+	int piv = c;
+	for (int r=c+1; r<m; r++)
+	    if (fabs(a[r*m+c]) > fabs(a[piv*m+c]))
+		piv = r;
+	if (fabs(a[piv*m+c]) <= 1.0e-14*aMax)
+	    return -1;
+	if (piv != c)
+	    for (int k=0; k<m; k++) {
+		double t = a[c*m+k]; a[c*m+k] = a[piv*m+k]; a[piv*m+k] = t;
+		t = inv[c*m+k]; inv[c*m+k] = inv[piv*m+k]; inv[piv*m+k] = t;
+	    }
+	double d = 1.0/a[c*m+c];
+	for (int k=0; k<m; k++) {
+	    a[c*m+k] *= d;
+	    inv[c*m+k] *= d;
+	}
+	for (int r=0; r<m; r++) {
+	    double f = a[r*m+c];
+	    if (r == c || f == 0.0)
+		continue;
+	    for (int k=0; k<m; k++) {
+		a[r*m+k] -= f*a[c*m+k];
+		inv[r*m+k] -= f*inv[c*m+k];
+	    }
+	}
+    }
+
+    return 0;
+}
+
+
+BlockSparseLinSolver::BlockSparseLinSolver(int meth, double tolerance,
+					   int maxIterations, bool warm)
+:LinearSOESolver(SOLVER_TAGS_BlockSparseLinSolver),
+ theSOE(0), method(meth), tol(tolerance), maxIter(maxIterations),
+ warmStart(warm), n(0)
+{
+
+}
+
+
+BlockSparseLinSolver::~BlockSparseLinSolver()
+{
+
+}
+
+
+int
+BlockSparseLinSolver::setLinearSOE(BlockSparseLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+
+int
+BlockSparseLinSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BlockSparseLinSolver::setSize(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    n = theSOE->size;
+    int numBlocks = theSOE->numBlocks;
+    const int *blockEqStart = &theSOE->blockEqStart[0];
+
+    invStart.resize(numBlocks+1);
+    invStart[0] = 0;
+    for (int I=0; I<numBlocks; I++) {
+	int bI = blockEqStart[I+1] - blockEqStart[I];
+	invStart[I+1] = invStart[I] + bI*bI;
+    }
+    invBlock.assign(invStart[numBlocks], 0.0);
+
+    xb.assign(n, 0.0);
+    bb.assign(n, 0.0);
+    work.assign((method == BiCGStab ? 8 : 4)*(size_t)n, 0.0);
+
+    return 0;
+}
+
+
+// the inverses of the diagonal blocks; a singular block, e.g. one with
+// a zero diagonal for a Lagrange multiplier, is preconditioned with its
+// diagonal instead
+int
+BlockSparseLinSolver::formPrecond(void)
+{
+    int numBlocks = theSOE->numBlocks;
+    const int *blockEqStart = &theSOE->blockEqStart[0];
+    const double *A = &theSOE->A[0];
+
+    std::vector<double> a;
+    for (int I=0; I<numBlocks; I++) {
+	int bI = blockEqStart[I+1] - blockEqStart[I];
+	int k = theSOE->findBlock(I, I);
+	const double *aII = A + theSOE->valStart[k];
+	double *inv = &invBlock[invStart[I]];
+
+	a.assign(aII, aII + bI*bI);
+	if (invertBlock(bI, &a[0], inv) < 0) {
+	    for (int i=0; i<bI*bI; i++)
+		inv[i] = 0.0;
+	    for (int i=0; i<bI; i++) {
+		double d = aII[i*bI+i];
+		inv[i*bI+i] = (d != 0.0) ? 1.0/d : 1.0;
+	    }
+	}
+    }
+
+    return 0;
+}
+
+
+// Ap = A*p, vectors in the block order
+void
+BlockSparseLinSolver::multiply(const double *p, double *Ap)
+{
+    int numBlocks = theSOE->numBlocks;
+    const int *blockEqStart = &theSOE->blockEqStart[0];
+    const int *blockRowStart = &theSOE->blockRowStart[0];
+    const int *blockCol = &theSOE->blockCol[0];
+    const int *valStart = &theSOE->valStart[0];
+    const double *A = &theSOE->A[0];
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int I=0; I<numBlocks; I++) {
+	int bI = blockEqStart[I+1] - blockEqStart[I];
+	double *y = Ap + blockEqStart[I];
+	for (int r=0; r<bI; r++)
+	    y[r] = 0.0;
+	for (int k=blockRowStart[I]; k<blockRowStart[I+1]; k++) {
+	    int J = blockCol[k];
+	    int bJ = blockEqStart[J+1] - blockEqStart[J];
+	    const double *x = p + blockEqStart[J];
+	    const double *a = A + valStart[k];
+	    for (int r=0; r<bI; r++, a += bJ) {
+		double sum = 0.0;
+		for (int c=0; c<bJ; c++)
+		    sum += a[c]*x[c];
+		y[r] += sum;
+	    }
+	}
+    }
+}
+
+
+void
+BlockSparseLinSolver::precondition(const double *r, double *z)
+{
+    int numBlocks = theSOE->numBlocks;
+    const int *blockEqStart = &theSOE->blockEqStart[0];
+
+    for (int I=0; I<numBlocks; I++) {
+	int first = blockEqStart[I];
+	int bI = blockEqStart[I+1] - first;
+	const double *inv = &invBlock[invStart[I]];
+	for (int i=0; i<bI; i++, inv += bI) {
+	    double sum = 0.0;
+	    for (int j=0; j<bI; j++)
+		sum += inv[j]*r[first+j];
+	    z[first+i] = sum;
+	}
+    }
+}
+
+
+// r = b - A x, starting from x = 0 instead if the previous solution in x
+// is a worse guess than that
+void
+BlockSparseLinSolver::initialResidual(double *x, const double *b, double *r, double bNorm)
+{
+    if (warmStart) {
+	this->multiply(x, r);
+	for (int i=0; i<n; i++)
+	    r[i] = b[i] - r[i];
+	if (sqrt(dotProduct(n, r, r)) < bNorm)
+	    return;
+    }
+
+    for (int i=0; i<n; i++) {
+	x[i] = 0.0;
+	r[i] = b[i];
+    }
+}
+
+
+int
+BlockSparseLinSolver::solveCG(double *x, const double *b, double bNorm)
+{
+    double *r = &work[0];
+    double *z = r + n;
+    double *p = z + n;
+    double *Ap = p + n;
+
+    this->initialResidual(x, b, r, bNorm);
+
+    double tolNorm = tol*bNorm;
+    if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	return 0;
+
+    this->precondition(r, z);
+    for (int i=0; i<n; i++)
+	p[i] = z[i];
+    double rz = dotProduct(n, r, z);
+
+    for (int iter=1; iter<=maxIter; iter++) {
+	this->multiply(p, Ap);
+	double pAp = dotProduct(n, p, Ap);
+	if (pAp <= 0.0) {
+	    opserr << "WARNING BlockSparseLinSolver::solveCG()- ";
+	    opserr << " matrix not positive definite\n";
+	    return -1;
+	}
+
+	double alpha = rz/pAp;
+	for (int i=0; i<n; i++) {
+	    x[i] += alpha*p[i];
+	    r[i] -= alpha*Ap[i];
+	}
+	if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	    return iter;
+
+	this->precondition(r, z);
+	double rzNew = dotProduct(n, r, z);
+	double beta = rzNew/rz;
+	rz = rzNew;
+	for (int i=0; i<n; i++)
+	    p[i] = z[i] + beta*p[i];
+    }
+
+    return -1;
+}
+
+
+int
+BlockSparseLinSolver::solveBiCGStab(double *x, const double *b, double bNorm)
+{
+    double *r = &work[0];
+    double *rhat = r + n;
+    double *p = rhat + n;
+    double *v = p + n;
+    double *phat = v + n;
+    double *s = phat + n;
+    double *shat = s + n;
+    double *t = shat + n;
+
+    this->initialResidual(x, b, r, bNorm);
+
+    double tolNorm = tol*bNorm;
+    if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	return 0;
+
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    for (int i=0; i<n; i++) {
+	rhat[i] = r[i];
+	p[i] = 0.0;
+	v[i] = 0.0;
+    }
+
+    for (int iter=1; iter<=maxIter; iter++) {
+	double rhoNew = dotProduct(n, rhat, r);
+	if (rhoNew == 0.0)
+	    return -1;
+
+	double beta = (rhoNew/rho)*(alpha/omega);
+	for (int i=0; i<n; i++)
+	    p[i] = r[i] + beta*(p[i] - omega*v[i]);
+
+	this->precondition(p, phat);
+	this->multiply(phat, v);
+	double rv = dotProduct(n, rhat, v);
+	if (rv == 0.0)
+	    return -1;
+	alpha = rhoNew/rv;
+
+	for (int i=0; i<n; i++)
+	    s[i] = r[i] - alpha*v[i];
+	if (sqrt(dotProduct(n, s, s)) <= tolNorm) {
+	    for (int i=0; i<n; i++)
+		x[i] += alpha*phat[i];
+	    return iter;
+	}
+
+	this->precondition(s, shat);
+	this->multiply(shat, t);
+	double tt = dotProduct(n, t, t);
+	omega = (tt > 0.0) ? dotProduct(n, t, s)/tt : 0.0;
+
+	for (int i=0; i<n; i++) {
+	    x[i] += alpha*phat[i] + omega*shat[i];
+	    r[i] = s[i] - omega*t[i];
+	}
+	if (sqrt(dotProduct(n, r, r)) <= tolNorm)
+	    return iter;
+	if (omega == 0.0)
+	    return -1;
+
+	rho = rhoNew;
+    }
+
+    return -1;
+}
+
+
+int
+BlockSparseLinSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING BlockSparseLinSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    if (n != theSOE->size || (int)invStart.size() != theSOE->numBlocks+1) {
+	opserr << "WARNING BlockSparseLinSolver::solve(void)- ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    // X and B in the block order
+    const int *blockEq = &theSOE->blockEq[0];
+    double *X = theSOE->X;
+    const double *B = theSOE->B;
+    for (int p=0; p<n; p++) {
+	xb[p] = X[blockEq[p]];
+	bb[p] = B[blockEq[p]];
+    }
+
+    double bNorm = sqrt(dotProduct(n, &bb[0], &bb[0]));
+    if (bNorm == 0.0) {
+	for (int i=0; i<n; i++)
+	    X[i] = 0.0;
+	return 0;
+    }
+
+    if (theSOE->changedA) {
+	this->formPrecond();
+	theSOE->changedA = false;
+	numNumericFactor++;
+    }
+
+    int numIter;
+    if (method == BiCGStab)
+	numIter = this->solveBiCGStab(&xb[0], &bb[0], bNorm);
+    else
+	numIter = this->solveCG(&xb[0], &bb[0], bNorm);
+
+    if (numIter < 0) {
+	opserr << "WARNING BlockSparseLinSolver::solve(void)- ";
+	opserr << " failed to converge in " << maxIter << " iterations\n";
+	return -1;
+    }
+
+    for (int p=0; p<n; p++)
+	X[blockEq[p]] = xb[p];
+
+    return 0;
+}
+
+
+int
+BlockSparseLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+BlockSparseLinSolver::recvSelf(int cTag, Channel &theChannel,
+			       FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef BlockSparseLinSolver_h
+#define BlockSparseLinSolver_h
+
+// Description: This file contains the class definition for
+// BlockSparseLinSolver. It solves a BlockSparseLinSOE with conjugate
+// gradients, or BiCGStab for a nonsymmetric A, preconditioned with the
+// inverses of the diagonal blocks of A (block Jacobi), which couple the
+// dofs of each node. The products A*p are formed block by block. The
+// iterations start from the previous solution when that is a better
+// guess than zero.
+//
+// What: "@(#) BlockSparseLinSolver.h, revA"
+
+#include <LinearSOESolver.h>
+#include <vector>
+
+class BlockSparseLinSOE;
+
+class BlockSparseLinSolver : public LinearSOESolver
+{
+  public:
+    enum { CG = 0, BiCGStab = 1 };
+
+    BlockSparseLinSolver(int method = CG, double tol = 1.0e-8,
+			 int maxIter = 1000, bool warmStart = true);
+    ~BlockSparseLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(BlockSparseLinSOE &theSOE);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int formPrecond(void);
+    void multiply(const double *p, double *Ap);
+    void precondition(const double *r, double *z);
+    void initialResidual(double *x, const double *b, double *r, double bNorm);
+    int solveCG(double *x, const double *b, double bNorm);
+    int solveBiCGStab(double *x, const double *b, double bNorm);
+
+    BlockSparseLinSOE *theSOE;
+
+    int method;
+    double tol;
+    int maxIter;
+    bool warmStart;
+
+    int n;
+    std::vector<int> invStart;      // start of the inverse of each diagonal block
+    std::vector<double> invBlock;   // inverses of the diagonal blocks, row major
+    std::vector<double> xb, bb;     // X and B in the block order
+    std::vector<double> work;       // Krylov vectors
+};
+
+#endif
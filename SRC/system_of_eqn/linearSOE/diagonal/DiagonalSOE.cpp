@@ -375,6 +375,13 @@ DiagonalSOE::getA(void)
   return matA;
 }
 
+// A, B & X, the factors of the solver are computed in A
+size_t
+DiagonalSOE::getMemoryUsage(void)
+{
+    return 3*size*sizeof(double) + 2*sizeof(Vector);
+}
+
 double 
 DiagonalSOE::normRHS(void)
 {
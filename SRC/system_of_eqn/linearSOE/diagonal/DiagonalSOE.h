@@ -65,6 +65,7 @@ class DiagonalSOE : public LinearSOE
     const Vector &getB(void);
   const Matrix *getA(void);
     double normRHS(void);
+    size_t getMemoryUsage(void);
 
     int setDiagonalSolver(DiagonalSolver &newSolver);    
     
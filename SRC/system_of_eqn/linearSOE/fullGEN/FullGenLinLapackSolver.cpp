@@ -138,7 +138,8 @@ FullGenLinLapackSolver::solve(void)
       }      
     }
 
-    
+    if (theSOE->factored == false)
+      numNumericFactor++;
     theSOE->factored = true;
     return 0;
 }
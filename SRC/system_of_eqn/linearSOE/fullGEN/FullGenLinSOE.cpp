@@ -454,6 +454,13 @@ FullGenLinSOE::getA(void)
     return matA;
 }
 
+// A, B & X, the factors of the solver are computed in A
+size_t
+FullGenLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + 2*sizeof(Vector) + sizeof(Matrix);
+}
+
 double 
 FullGenLinSOE::normRHS(void)
 {
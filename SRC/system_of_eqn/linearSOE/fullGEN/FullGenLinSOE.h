@@ -69,6 +69,7 @@ class FullGenLinSOE : public LinearSOE
     const Matrix *getA(void);
 
     double normRHS(void);
+    size_t getMemoryUsage(void);
 
     void setX(int loc, double value);        
     void setX(const Vector &x);        
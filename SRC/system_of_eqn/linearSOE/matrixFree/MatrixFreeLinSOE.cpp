@@ -0,0 +1,386 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for MatrixFreeLinSOE
+
+#include <stdlib.h>
+#include <MatrixFreeLinSOE.h>
+#include <MatrixFreeLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <Integrator.h>
+#include <TransientIntegrator.h>
+#include <math.h>
+
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <iostream>
+using std::nothrow;
+
+MatrixFreeLinSOE::MatrixFreeLinSOE(MatrixFreeLinSolver &the_Solver)
+:LinearSOE(the_Solver, LinSOE_TAGS_MatrixFreeLinSOE),
+ size(0), diagA(0), B(0), X(0), vectX(0), vectB(0), Bsize(0),
+ changedA(true)
+{
+    the_Solver.setLinearSOE(*this);
+}
+
+
+MatrixFreeLinSOE::~MatrixFreeLinSOE()
+{
+    if (diagA != 0) delete [] diagA;
+    if (B != 0) delete [] B;
+    if (X != 0) delete [] X;
+    if (vectX != 0) delete vectX;
+    if (vectB != 0) delete vectB;
+}
+
+
+int
+MatrixFreeLinSOE::getNumEqn(void) const
+{
+    return size;
+}
+
+
+int
+MatrixFreeLinSOE::setSize(Graph &theGraph)
+{
+    int oldSize = size;
+    size = theGraph.getNumVertex();
+
+    if (size > Bsize) { // we have to get space for the vectors
+
+	// delete the old
+	if (diagA != 0) delete [] diagA;
+	if (B != 0) delete [] B;
+	if (X != 0) delete [] X;
+
+	// create the new
+	diagA = new (nothrow) double[size];
+	B = new (nothrow) double[size];
+	X = new (nothrow) double[size];
+
+	if (diagA == 0 || B == 0 || X == 0) {
+	    opserr << "WARNING MatrixFreeLinSOE::setSize :";
+	    opserr << " ran out of memory for vectors (size) (";
+	    opserr << size << ") \n";
+	    size = 0; Bsize = 0;
+	    return -1;
+	}
+	else
+	    Bsize = size;
+    }
+
+    // zero the vectors
+    for (int j=0; j<size; j++) {
+	diagA[j] = 0;
+	B[j] = 0;
+	X[j] = 0;
+    }
+    changedA = true;
+
+    // create new Vectors objects
+    if (size != oldSize) {
+	if (vectX != 0)
+	    delete vectX;
+
+	if (vectB != 0)
+	    delete vectB;
+
+	vectX = new Vector(X,size);
+	vectB = new Vector(B,size);
+    }
+
+    // invoke setSize() on the Solver
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING:MatrixFreeLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
+    return 0;
+}
+
+
+int
+MatrixFreeLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)
+	return 0;
+
+    int idSize = id.Size();
+
+    // check that m and id are of similar size
+    if (idSize != m.noRows() && idSize != m.noCols()) {
+	opserr << "MatrixFreeLinSOE::addA() ";
+	opserr << " - Matrix and ID not of similar sizes\n";
+	return -1;
+    }
+
+    // only the diagonal is kept, the rest is formed again in formAp()
+    for (int i=0; i<idSize; i++) {
+	int pos = id(i);
+	if (pos < size && pos >= 0)
+	    diagA[pos] += fact * m(i,i);
+    }
+    changedA = true;
+
+    return 0;
+}
+
+
+int
+MatrixFreeLinSOE::formAp(const Vector &p, Vector &Ap)
+{
+    Ap.Zero();
+
+    if (theModel == 0) {
+	opserr << "WARNING MatrixFreeLinSOE::formAp() - no AnalysisModel has been set\n";
+	return -1;
+    }
+
+    // the element tangents are formed again by the integrator that was
+    // last used to form them
+    Integrator *theIntegrator = 0;
+    FE_Element *elePtr;
+    FE_EleIter &theEles = theModel->getFEs();
+    while ((elePtr = theEles()) != 0) {
+	theIntegrator = elePtr->getLastIntegrator();
+	const Matrix &k = elePtr->getTangent(theIntegrator);
+	const ID &id = elePtr->getID();
+	int idSize = id.Size();
+	for (int i=0; i<idSize; i++) {
+	    int row = id(i);
+	    if (row < 0 || row >= size)
+		continue;
+	    double sum = 0.0;
+	    for (int j=0; j<idSize; j++) {
+		int col = id(j);
+		if (col >= 0 && col < size)
+		    sum += k(i,j) * p(col);
+	    }
+	    Ap(row) += sum;
+	}
+    }
+
+    // the nodes only contribute to the tangent of a transient analysis
+    if (dynamic_cast<TransientIntegrator *>(theIntegrator) == 0)
+	return 0;
+
+    DOF_Group *dofPtr;
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    while ((dofPtr = theDOFs()) != 0) {
+	const Matrix &k = dofPtr->getTangent(theIntegrator);
+	const ID &id = dofPtr->getID();
+	int idSize = id.Size();
+	for (int i=0; i<idSize; i++) {
+	    int row = id(i);
+	    if (row < 0 || row >= size)
+		continue;
+	    double sum = 0.0;
+	    for (int j=0; j<idSize; j++) {
+		int col = id(j);
+		if (col >= 0 && col < size)
+		    sum += k(i,j) * p(col);
+	    }
+	    Ap(row) += sum;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+MatrixFreeLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    int idSize = id.Size();
+    // check that m and id are of similar size
+    if (idSize != v.Size() ) {
+	opserr << "MatrixFreeLinSOE::addB() ";
+	opserr << " - Vector and ID not of similar sizes\n";
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i);
+	}
+    } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] -= v(i);
+	}
+    } else {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+MatrixFreeLinSOE::setB(const Vector &v, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    if (v.Size() != size) {
+	opserr << "WARNING MatrixFreeLinSOE::setB() -";
+	opserr << " incompatible sizes " << size << " and " << v.Size() << endln;
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i);
+	}
+    } else if (fact == -1.0) {
+	for (int i=0; i<size; i++) {
+	    B[i] = -v(i);
+	}
+    } else {
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i) * fact;
+	}
+    }
+    return 0;
+}
+
+
+void
+MatrixFreeLinSOE::zeroA(void)
+{
+    for (int i=0; i<size; i++)
+	diagA[i] = 0;
+
+    changedA = true;
+}
+
+
+void
+MatrixFreeLinSOE::zeroB(void)
+{
+    double *Bptr = B;
+    for (int i=0; i<size; i++)
+	*Bptr++ = 0;
+}
+
+
+void
+MatrixFreeLinSOE::setX(int loc, double value)
+{
+    if (loc < size && loc >=0)
+	X[loc] = value;
+}
+
+
+void
+MatrixFreeLinSOE::setX(const Vector &x)
+{
+    if (x.Size() == size && vectX != 0)
+	*vectX = x;
+}
+
+
+const Vector &
+MatrixFreeLinSOE::getX(void)
+{
+    if (vectX == 0) {
+	opserr << "FATAL MatrixFreeLinSOE::getX - vectX == 0";
+	exit(-1);
+    }
+    return *vectX;
+}
+
+
+const Vector &
+MatrixFreeLinSOE::getB(void)
+{
+    if (vectB == 0) {
+	opserr << "FATAL MatrixFreeLinSOE::getB - vectB == 0";
+	exit(-1);
+    }
+    return *vectB;
+}
+
+
+double
+MatrixFreeLinSOE::normRHS(void)
+{
+    double norm =0.0;
+    for (int i=0; i<size; i++) {
+	double Yi = B[i];
+	norm += Yi*Yi;
+    }
+    return sqrt(norm);
+}
+
+
+int
+MatrixFreeLinSOE::setMatrixFreeLinSolver(MatrixFreeLinSolver &newSolver)
+{
+    newSolver.setLinearSOE(*this);
+
+    if (size != 0) {
+	int solverOK = newSolver.setSize();
+	if (solverOK < 0) {
+	    opserr << "WARNING:MatrixFreeLinSOE::setSolver :";
+	    opserr << "the new solver could not setSize() - staying with old\n";
+	    return -1;
+	}
+    }
+
+    return this->LinearSOE::setSolver(newSolver);
+}
+
+
+int
+MatrixFreeLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+MatrixFreeLinSOE::recvSelf(int cTag, Channel &theChannel,
+			   FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
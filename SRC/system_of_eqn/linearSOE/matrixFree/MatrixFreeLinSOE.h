@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MatrixFreeLinSOE_h
+#define MatrixFreeLinSOE_h
+
+// Description: This file contains the class definition for
+// MatrixFreeLinSOE. MatrixFreeLinSOE is a subclass of LinearSOE that never
+// assembles A. Only the diagonal of A is kept, for preconditioning; the
+// product A*p is formed element by element in formAp() from the tangents
+// of the FE_Elements (and, in a transient analysis, the DOF_Groups) of the
+// AnalysisModel, formed by the integrator last used on them.
+//
+// What: "@(#) MatrixFreeLinSOE.h, revA"
+
+#include <LinearSOE.h>
+#include <Vector.h>
+
+class MatrixFreeLinSolver;
+
+class MatrixFreeLinSOE : public LinearSOE
+{
+  public:
+    MatrixFreeLinSOE(MatrixFreeLinSolver &theSolver);
+
+    ~MatrixFreeLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    int formAp(const Vector &p, Vector &Ap);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setMatrixFreeLinSolver(MatrixFreeLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class MatrixFreeLinSolver;
+
+  protected:
+
+  private:
+    int size;
+    double *diagA, *B, *X;   // diagonal of A, B and X
+    Vector *vectX;
+    Vector *vectB;
+    int Bsize;
+    bool changedA;           // A has been reformed since the last solve
+};
+
+#endif
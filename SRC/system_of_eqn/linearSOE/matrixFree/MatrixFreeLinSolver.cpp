@@ -0,0 +1,183 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of MatrixFreeLinSolver.
+
+#include <MatrixFreeLinSolver.h>
+#include <MatrixFreeLinSOE.h>
+#include <Vector.h>
+#include <elementAPI.h>
+#include <string.h>
+
+void* OPS_MatrixFreeLinSolver()
+{
+    // system MatrixFree <-cg|-gmres|-bicgstab> <-tol $tol> <-maxIter $maxIter>
+    //    <-restart $m> <-noWarmStart>
+    int method = MatrixFreeLinSolver::CG;
+    double tol = 1.0e-8;
+    int maxIter = 1000;
+    int restart = 50;
+    bool warmStart = true;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-cg") == 0 || strcmp(opt, "-CG") == 0) {
+	    method = MatrixFreeLinSolver::CG;
+	} else if (strcmp(opt, "-gmres") == 0 || strcmp(opt, "-GMRES") == 0) {
+	    method = MatrixFreeLinSolver::GMRES;
+	} else if (strcmp(opt, "-bicgstab") == 0 || strcmp(opt, "-BiCGStab") == 0) {
+	    method = MatrixFreeLinSolver::BiCGStab;
+	} else if (strcmp(opt, "-tol") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &tol) < 0) {
+		opserr << "WARNING system MatrixFree - invalid -tol value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-maxIter") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &maxIter) < 0) {
+		opserr << "WARNING system MatrixFree - invalid -maxIter value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-restart") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &restart) < 0 ||
+		restart < 1) {
+		opserr << "WARNING system MatrixFree - invalid -restart value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-noWarmStart") == 0) {
+	    warmStart = false;
+	}
+    }
+
+    MatrixFreeLinSolver *theSolver = new MatrixFreeLinSolver(method, tol, maxIter, restart, warmStart);
+    return new MatrixFreeLinSOE(*theSolver);
+}
+
+
+MatrixFreeLinSolver::MatrixFreeLinSolver(int meth, double tolerance,
+					 int maxIterations, int m, bool warm)
+:LinearSOESolver(SOLVER_TAGS_MatrixFreeLinSolver),
+ theSOE(0), theIteration(meth, tolerance, maxIterations, m, warm), n(0)
+{
+
+}
+
+
+MatrixFreeLinSolver::~MatrixFreeLinSolver()
+{
+
+}
+
+
+int
+MatrixFreeLinSolver::setLinearSOE(MatrixFreeLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+
+int
+MatrixFreeLinSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING MatrixFreeLinSolver::setSize(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    n = theSOE->size;
+    invDiag.assign(n, 0.0);
+    theIteration.setSize(n);
+
+    return 0;
+}
+
+
+// Ap = A*p through the SOE
+int
+MatrixFreeLinSolver::multiply(const double *p, double *Ap)
+{
+    Vector theP((double *)p, n);
+    Vector theAp(Ap, n);
+    return theSOE->formAp(theP, theAp);
+}
+
+
+void
+MatrixFreeLinSolver::precondition(const double *r, double *z)
+{
+    for (int i=0; i<n; i++)
+	z[i] = invDiag[i]*r[i];
+}
+
+
+int
+MatrixFreeLinSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING MatrixFreeLinSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    if (n != theSOE->size) {
+	opserr << "WARNING MatrixFreeLinSolver::solve(void)- ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    // the Jacobi preconditioner from the diagonal kept by the SOE
+    if (theSOE->changedA) {
+	const double *diag = theSOE->diagA;
+	for (int i=0; i<n; i++)
+	    invDiag[i] = (diag[i] != 0.0) ? 1.0/diag[i] : 1.0;
+	theSOE->changedA = false;
+	numNumericFactor++;
+    }
+
+    if (theIteration.solve(*this, theSOE->X, theSOE->B) < 0) {
+	opserr << "WARNING MatrixFreeLinSolver::solve(void)- ";
+	opserr << " failed to converge in " << theIteration.getMaxIter() << " iterations\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+int
+MatrixFreeLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+MatrixFreeLinSolver::recvSelf(int cTag, Channel &theChannel,
+			      FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
@@ -0,0 +1,72 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MatrixFreeLinSolver_h
+#define MatrixFreeLinSolver_h
+
+// Description: This file contains the class definition for
+// MatrixFreeLinSolver. It solves a MatrixFreeLinSOE with Jacobi
+// preconditioned conjugate gradients, or GMRES or BiCGStab for a
+// nonsymmetric A, using only the products A*p of the SOE. The iterations
+// are those of KrylovIteration and start from the previous solution when
+// that is a better guess than zero.
+//
+// What: "@(#) MatrixFreeLinSolver.h, revA"
+
+#include <LinearSOESolver.h>
+#include <KrylovIteration.h>
+#include <vector>
+
+class MatrixFreeLinSOE;
+
+class MatrixFreeLinSolver : public LinearSOESolver, public KrylovOperator
+{
+  public:
+    enum { CG = KrylovIteration::CG, GMRES = KrylovIteration::GMRES,
+	   BiCGStab = KrylovIteration::BiCGStab };
+
+    MatrixFreeLinSolver(int method = CG, double tol = 1.0e-8,
+			int maxIter = 1000, int restart = 50,
+			bool warmStart = true);
+    ~MatrixFreeLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(MatrixFreeLinSOE &theSOE);
+
+    int multiply(const double *p, double *Ap);
+    void precondition(const double *r, double *z);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    MatrixFreeLinSOE *theSOE;
+    KrylovIteration theIteration;
+
+    int n;
+    std::vector<double> invDiag;
+};
+
+#endif
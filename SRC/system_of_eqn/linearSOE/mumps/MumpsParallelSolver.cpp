@@ -33,32 +33,57 @@
 #include <FEM_ObjectBroker.h>
 #include <OPS_Globals.h>
 #include <ID.h>
+#include <Message.h>
 #include <iostream>
+#include <string.h>
+#include <algorithm>
 
 #define ICNTL(I) icntl[(I)-1] /* macro s.t. indices match documentation */
 
 #include <mpi.h>
 
-MumpsParallelSolver::MumpsParallelSolver(int ICNTL7, int ICNTL14)
+// the out-of-core option: with a directory given the factors are written
+// to files there during the factorization and read back panel by panel
+// in the solves, so that only the active fronts are held in memory; each
+// process writes its own files, so the directory is best a local disk
+static void
+copyOutOfCoreDir(char *dst, const char *oocDir, int &icntl22)
+{
+  dst[0] = '\0';
+  icntl22 = 0;
+  if (oocDir != 0) {
+    strncpy(dst, oocDir, 255);
+    dst[255] = '\0';
+    icntl22 = 1;
+  }
+}
+
+MumpsParallelSolver::MumpsParallelSolver(int ICNTL7, int ICNTL14, const char *oocDir,
+					 int numThreads)
   :LinearSOESolver(SOLVER_TAGS_MumpsParallelSolver),
-   theMumpsSOE(0), rank(0), np(0)
+   theMumpsSOE(0), rank(0), np(0), analysedSize(-1)
 {
   memset(&id, 0, sizeof(id));
+  copyOutOfCoreDir(oocTmpDir, oocDir, icntl22);
 
   icntl7 = ICNTL7;
   icntl14 = ICNTL14;
+  icntl16 = numThreads;
   init = false;
   needsSetSize = false;
 }
 
-MumpsParallelSolver::MumpsParallelSolver(int mpi_comm, int ICNTL7, int ICNTL14)
+MumpsParallelSolver::MumpsParallelSolver(int mpi_comm, int ICNTL7, int ICNTL14,
+					 const char *oocDir, int numThreads)
   :LinearSOESolver(SOLVER_TAGS_MumpsParallelSolver),
-   theMumpsSOE(0), rank(0), np(0)
+   theMumpsSOE(0), rank(0), np(0), analysedSize(-1)
 {
   memset(&id, 0, sizeof(id));
+  copyOutOfCoreDir(oocTmpDir, oocDir, icntl22);
 
   icntl14 = ICNTL14;
   icntl7 = ICNTL7;
+  icntl16 = numThreads;
   init = false;
   needsSetSize = false;
 }
@@ -79,32 +104,40 @@ MumpsParallelSolver::initializeMumps()
   }
   else {
 
-    if (init == true) {
-      id.job=-2; 
-      dmumps_c(&id); /* Terminate instance */
-      init = false;
-    } 
-    
-    id.job = -1;
+    // the instance is kept from one setSize() to the next, it is only
+    // created the first time
+    if (init == false) {
+      id.job = -1;
       
-    id.par = 1; // host involved in calcs
-    id.sym = theMumpsSOE->matType;
+      id.par = 1; // host involved in calcs
+      id.sym = theMumpsSOE->matType;
     
 #ifdef _OPENMPI    
-    //    id.comm_fortran=-987654;
-    id.comm_fortran = 0;
+      //    id.comm_fortran=-987654;
+      id.comm_fortran = 0;
 #else
-    id.comm_fortran = MPI_COMM_WORLD;
+      id.comm_fortran = MPI_COMM_WORLD;
 #endif
     
-    id.ICNTL(5) = 0; id.ICNTL(18) = 3;
+      id.ICNTL(5) = 0; id.ICNTL(18) = 3;
     
-    dmumps_c(&id);
+      dmumps_c(&id);
     
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &np);
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &np);
     
-    init = true;
+      init = true;
+    }
+
+    // the analysis depends only on the structure of A, a setSize() that
+    // leaves the local structure on every process as it was keeps it
+    int changed = this->structureChanged() ? 1 : 0;
+    int anyChanged = changed;
+    MPI_Allreduce(&changed, &anyChanged, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (anyChanged == 0) {
+      needsSetSize = false;
+      return 0;
+    }
     
     // parallel solver; distributed i/p matrix A
     id.ICNTL(5) = 0; id.ICNTL(18) = 3;
@@ -114,8 +147,7 @@ MumpsParallelSolver::initializeMumps()
     id.ICNTL(1) = -1; id.ICNTL(2) = -1; id.ICNTL(3) = -1; id.ICNTL(4) = 3;
     //id.ICNTL(1) = 1; id.ICNTL(2) = 1; id.ICNTL(3) = 1; id.ICNTL(4) = 3;
     
-    id.ICNTL(14) = icntl14;
-    id.ICNTL(7) = icntl7;
+    this->setControls();
     
     int nnz = theMumpsSOE->nnz;
     int *colA = theMumpsSOE->colA;
@@ -183,6 +215,7 @@ MumpsParallelSolver::initializeMumps()
       return info;
     
     needsSetSize = false;
+    numSymbolicFactor++;
     
     return info;
   }
@@ -207,8 +240,7 @@ MumpsParallelSolver::solveAfterInitialization(void)
   //id.ICNTL(1) = 1; id.ICNTL(2) = 1; id.ICNTL(3) = 1; id.ICNTL(4) = 3;
 
 
-  id.ICNTL(14)=icntl14; 
-  id.ICNTL(7)=icntl7; 
+  this->setControls();
   
   // increment row and col A values by 1 for mumps fortran indexing
   for (int i=0; i<nnz; i++) {
@@ -236,6 +268,7 @@ MumpsParallelSolver::solveAfterInitialization(void)
     id.job = 5;
     dmumps_c(&id);
     theMumpsSOE->factored = true;
+    numNumericFactor++;
 
   } else {
 
@@ -300,6 +333,42 @@ MumpsParallelSolver::solve(void)
 		return initializationResult;
 }
 
+void
+MumpsParallelSolver::setControls(void)
+{
+  id.ICNTL(14) = icntl14;
+  id.ICNTL(7) = icntl7;
+  id.ICNTL(16) = icntl16;
+  id.ICNTL(22) = icntl22;
+  if (icntl22 != 0) {
+    strcpy(id.ooc_tmpdir, oocTmpDir);
+    strcpy(id.ooc_prefix, "opensees_");
+  }
+}
+
+// compares the local structure of A with the one of the last analysis
+// and keeps a copy of it
+bool
+MumpsParallelSolver::structureChanged(void)
+{
+  int n = theMumpsSOE->size;
+  int nnz = theMumpsSOE->nnz;
+  const int *rowA = theMumpsSOE->rowA;
+  const int *colA = theMumpsSOE->colA;
+
+  bool changed = (n != analysedSize || nnz != (int)analysedRow.size() ||
+		  !std::equal(rowA, rowA+nnz, analysedRow.begin()) ||
+		  !std::equal(colA, colA+nnz, analysedCol.begin()));
+
+  if (changed) {
+    analysedSize = n;
+    analysedRow.assign(rowA, rowA+nnz);
+    analysedCol.assign(colA, colA+nnz);
+  }
+
+  return changed;
+}
+
 int
 MumpsParallelSolver::setSize(void)
 {
@@ -311,12 +380,19 @@ int
 MumpsParallelSolver::sendSelf(int cTag, Channel &theChannel)
 {
   // nothing to do
-  ID icntlData(2);
+  ID icntlData(4);
 
   icntlData(0) = icntl7;  
   icntlData(1) = icntl14;
+  icntlData(2) = icntl22;
+  icntlData(3) = icntl16;
   theChannel.sendID(0, cTag, icntlData);
 
+  if (icntl22 != 0) {
+    Message theMessage(oocTmpDir, 256);
+    theChannel.sendMsg(0, cTag, theMessage);
+  }
+
   return 0;
 }
 
@@ -326,12 +402,20 @@ MumpsParallelSolver::recvSelf(int ctag,
 		      FEM_ObjectBroker &theBroker)
 {
   // nothing to do
-  ID icntlData(2);
+  ID icntlData(4);
 
   theChannel.recvID(0, ctag, icntlData);
 
   icntl7 = icntlData(0);
   icntl14 = icntlData(1);
+  icntl22 = icntlData(2);
+  icntl16 = icntlData(3);
+
+  if (icntl22 != 0) {
+    Message theMessage(oocTmpDir, 256);
+    theChannel.recvMsg(0, ctag, theMessage);
+    oocTmpDir[255] = '\0';
+  }
   return 0;
 }
 
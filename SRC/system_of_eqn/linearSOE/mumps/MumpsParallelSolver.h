@@ -47,6 +47,7 @@
 #include <mpi.h>
 
 #include <LinearSOESolver.h>
+#include <vector>
 extern "C" {
 #include <dmumps_c.h>
 }
@@ -56,11 +57,14 @@ class MumpsParallelSOE;
 class MumpsParallelSolver : public LinearSOESolver
 {
   public:
-  MumpsParallelSolver(int ICNTL7 = 7, int ICNTL14 = 20);
+  MumpsParallelSolver(int ICNTL7 = 7, int ICNTL14 = 20, const char *oocDir = 0,
+		      int numThreads = 0);
 
   MumpsParallelSolver(int MPI_COMM, 		      
 		      int ICNTL7,
-		      int ICNTL14);
+		      int ICNTL14,
+		      const char *oocDir = 0,
+		      int numThreads = 0);
 
   virtual ~MumpsParallelSolver();
   
@@ -78,6 +82,8 @@ class MumpsParallelSolver : public LinearSOESolver
 
   int initializeMumps(void);
   int solveAfterInitialization(void);
+  void setControls(void);
+  bool structureChanged(void);
 
   bool init;
   MumpsParallelSOE *theMumpsSOE;
@@ -86,6 +92,13 @@ class MumpsParallelSolver : public LinearSOESolver
   int np;
   int icntl14;
   int icntl7;
+  int icntl22;            // 1 if the factors are written out of core
+  char oocTmpDir[256];    // directory of the out-of-core files
+  int icntl16;            // number of OpenMP threads, 0 for the MUMPS default
+
+  // the local structure of A at the last analysis
+  int analysedSize;
+  std::vector<int> analysedRow, analysedCol;
 
   DMUMPS_STRUC_C id;
 
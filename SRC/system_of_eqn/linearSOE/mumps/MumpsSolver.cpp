@@ -34,6 +34,8 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <OPS_Globals.h>
+#include <string.h>
+#include <algorithm>
 
 #define ICNTL(I) icntl[(I)-1] /* macro s.t. indices match documentation */
 
@@ -51,9 +53,26 @@
 #include <libseq\mpi.h>
 #endif
 
-MumpsSolver::MumpsSolver(int ICNTL7, int ICNTL14)
+// the out-of-core option: with a directory given the factors are written
+// to files there during the factorization and read back panel by panel
+// in the solves, so that only the active fronts are held in memory; each
+// process writes its own files, so the directory is best a local disk
+static void
+copyOutOfCoreDir(char *dst, const char *oocDir, int &icntl22)
+{
+  dst[0] = '\0';
+  icntl22 = 0;
+  if (oocDir != 0) {
+    strncpy(dst, oocDir, 255);
+    dst[255] = '\0';
+    icntl22 = 1;
+  }
+}
+
+MumpsSolver::MumpsSolver(int ICNTL7, int ICNTL14, const char *oocDir, int numThreads)
   :LinearSOESolver(SOLVER_TAGS_MumpsSolver),
-   theMumpsSOE(0)
+   theMumpsSOE(0), icntl14(ICNTL14), icntl7(ICNTL7), icntl16(numThreads),
+   analysedSize(-1)
 {
 
   std::cerr << "MumpsSOlver - constructor\n";
@@ -74,9 +93,27 @@ MumpsSolver::MumpsSolver(int ICNTL7, int ICNTL14)
   id.ICNTL(14) = ICNTL14;
   id.ICNTL(7)=ICNTL7;;
 
+  copyOutOfCoreDir(oocTmpDir, oocDir, icntl22);
+
   needsSetSize = false;
 }
 
+
+// the initialization job resets the controls to the MUMPS defaults, so
+// the options are set again after it
+void
+MumpsSolver::setControls(void)
+{
+  id.ICNTL(14) = icntl14;
+  id.ICNTL(7) = icntl7;
+  id.ICNTL(16) = icntl16;
+  id.ICNTL(22) = icntl22;
+  if (icntl22 != 0) {
+    strcpy(id.ooc_tmpdir, oocTmpDir);
+    strcpy(id.ooc_prefix, "opensees_");
+  }
+}
+
 MumpsSolver::~MumpsSolver()
 {
   std::cerr << "MumpsSOlver - destructor\n";
@@ -99,8 +136,16 @@ MumpsSolver::initializeMumps(void)
       id.sym = theMumpsSOE->matType;
       id.job=-1; 
       dmumps_c(&id);
+      this->setControls();
       init = true;
     }
+
+    // the analysis depends only on the structure of A, a setSize() that
+    // leaves it as it was keeps the analysis
+    if (this->structureChanged() == false) {
+      needsSetSize = false;
+      return 0;
+    }
     
     int nnz = theMumpsSOE->nnz;
     int *rowA = theMumpsSOE->rowA;
@@ -141,6 +186,7 @@ MumpsSolver::initializeMumps(void)
     }
     
     needsSetSize = false;
+    numSymbolicFactor++;
     
     return info;
   }
@@ -185,6 +231,7 @@ MumpsSolver::solveAfterInitialization(void)
     dmumps_c(&id);
 
     theMumpsSOE->factored = true;
+    numNumericFactor++;
   } else {
     // factor the matrix
     id.n   = theMumpsSOE->size; 
@@ -246,6 +293,29 @@ MumpsSolver::solve(void)
 		return initializationResult;
 }
 
+// compares the structure of A with the one of the last analysis and
+// keeps a copy of it
+bool
+MumpsSolver::structureChanged(void)
+{
+  int n = theMumpsSOE->size;
+  int nnz = theMumpsSOE->nnz;
+  const int *rowA = theMumpsSOE->rowA;
+  const int *colA = theMumpsSOE->colA;
+
+  bool changed = (n != analysedSize || nnz != (int)analysedRow.size() ||
+		  !std::equal(rowA, rowA+nnz, analysedRow.begin()) ||
+		  !std::equal(colA, colA+nnz, analysedCol.begin()));
+
+  if (changed) {
+    analysedSize = n;
+    analysedRow.assign(rowA, rowA+nnz);
+    analysedCol.assign(colA, colA+nnz);
+  }
+
+  return changed;
+}
+
 int 
 MumpsSOE::setMumpsSolver(MumpsSolver &newSolver)
 {
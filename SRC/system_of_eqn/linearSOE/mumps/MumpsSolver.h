@@ -45,6 +45,7 @@
 // What: "@(#) Mumps.h, revA"
 
 #include <LinearSOESolver.h>
+#include <vector>
 extern "C" {
 #include <dmumps_c.h>
 }
@@ -54,7 +55,7 @@ class MumpsSOE;
 class MumpsSolver : public LinearSOESolver
 {
   public:
-  MumpsSolver(int ICNTL7=7, int ICNTL14=20);
+  MumpsSolver(int ICNTL7=7, int ICNTL14=20, const char *oocDir=0, int numThreads=0);
 	      
   virtual ~MumpsSolver();
   
@@ -72,13 +73,22 @@ class MumpsSolver : public LinearSOESolver
 
   int initializeMumps(void);
   int solveAfterInitialization(void);
+  void setControls(void);
+  bool structureChanged(void);
 
   DMUMPS_STRUC_C id;
   MumpsSOE *theMumpsSOE;
   bool init;
   int icntl14;
   int icntl7;
+  int icntl22;            // 1 if the factors are written out of core
+  char oocTmpDir[256];    // directory of the out-of-core files
+  int icntl16;            // number of OpenMP threads, 0 for the MUMPS default
   bool needsSetSize;
+
+  // the structure of A at the last analysis
+  int analysedSize;
+  std::vector<int> analysedRow, analysedCol;
 };
 
 #endif
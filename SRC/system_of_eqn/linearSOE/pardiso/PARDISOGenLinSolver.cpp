@@ -25,18 +25,59 @@
 
 PARDISOGenLinSolver::PARDISOGenLinSolver()
 :LinearSOESolver(SOLVER_TAGS_PARDISOGenLinSolver),
- theSOE(0)
+ theSOE(0), analysed(false)
 {
-	
+	for (int i = 0; i < 64; i++)
+	{
+		iparm[i] = 0;
+		pt[i] = 0;
+	}
 }
 
 
 PARDISOGenLinSolver::~PARDISOGenLinSolver()
 { 
-
+	this->release();
 }
 
 
+// releases the memory PARDISO holds for the reordering and factors
+void
+PARDISOGenLinSolver::release(void)
+{
+	if (analysed == false)
+		return;
+
+	/*1	Real and structurally symmetric	IN
+	2	Real and symmetric positive definite
+	-2	Real and symmetric indefinite
+	3	Complex and structurally symmetric
+	4	Complex and Hermitian positive definite
+	-4	Complex and Hermitian indefinite
+	6	Complex and symmetric matrix
+	11	Real and unsymmetric matrix
+	13	Complex and unsymmetric matrix*/
+	int mtype = 11;
+	int nrhs = 1;
+	int maxfct = 1;
+	int mnum = 1;
+	int msglvl = 0;
+	int error = 0;
+	int phase = -1;
+	int n = 0;
+	double ddum;			/* Double dummy */
+	int idum;			/* Integer dummy. */
+
+	PARDISO(pt, &maxfct, &mnum, &mtype, &phase,
+		&n, &ddum, &idum, &idum, &idum, &nrhs,
+		iparm, &msglvl, &ddum, &ddum, &error);
+
+	for (int i = 0; i < 64; i++)
+		pt[i] = 0;
+
+	analysed = false;
+}
+
 
 int
 PARDISOGenLinSolver::solve(void)
@@ -54,113 +95,65 @@ PARDISOGenLinSolver::solve(void)
 	double* Xptr = theSOE->X;
 	double* Bptr = theSOE->B;
 
-	/*opserr << "ia : ";
-	for (int i = 0; i < n + 1; i++)
-	{
-		opserr << ia[i] << " ";
-	}
-
-	opserr << "\nja : ";
-	for (int i = 0; i < theSOE->nnz; i++)
-	{
-		opserr << ja[i] << " ";
-	}
-	opserr << endln;
-
-	opserr << "\na : ";
-	for (int i = 0; i < theSOE->nnz; i++)
-	{
-		opserr << a[i] << " ";
-	}
-	opserr << endln;*/
-
-
-	/*1	Real and structurally symmetric	IN
-	2	Real and symmetric positive definite
-	-2	Real and symmetric indefinite
-	3	Complex and structurally symmetric
-	4	Complex and Hermitian positive definite
-	-4	Complex and Hermitian indefinite
-	6	Complex and symmetric matrix
-	11	Real and unsymmetric matrix
-	13	Complex and unsymmetric matrix*/
 	int mtype = 11;
-	int nrhs =1;
-	void* pt[64];
-	int* iparm = new int[64];
-	int maxfct, mnum, phase, error, msglvl;
+	int nrhs = 1;
+	int maxfct = 1;			/* Maximum number of numerical factorizations. */
+	int mnum = 1;			/* Which factorization to use. */
+	int msglvl = 0;			/* Print statistical information in file */
+	int error = 0;			/* Initialize error flag */
+	int phase;
 
-	
-   
 	double ddum;			/* Double dummy */
 	int idum;			/* Integer dummy. */
 
-	for (int i = 0; i < 64; i++)
-	{
-		iparm[i] = 0;
-		pt[i] = 0;
-	}
-
-	iparm[0] = 1;			/* No solver default */
-	iparm[1] = 2;			/* Fill-in reordering from METIS */
-	/* Numbers of processors, value of OMP_NUM_THREADS */
-	iparm[2] = 1;
-	iparm[3] = 0;			/* No iterative-direct algorithm */
-	iparm[4] = 0;			/* No user fill-in reducing permutation */
-	iparm[5] = 0;			/* Write solution into x */
-	iparm[6] = 0;			/* Not in use */
-	iparm[7] = 2;			/* Max numbers of iterative refinement steps */
-	iparm[8] = 0;			/* Not in use */
-	iparm[9] = 13;		/* Perturb the pivot elements with 1E-13 */
-	iparm[10] = 1;		/* Use nonsymmetric permutation and scaling MPS */
-	iparm[11] = 0;		/* Not in use */
-	iparm[12] = 0;		/* Maximum weighted matching algorithm is switched-off (default for symmetric). Try iparm[12] = 1 in case of inappropriate accuracy */
-	iparm[13] = 0;		/* Output: Number of perturbed pivots */
-	iparm[14] = 0;		/* Not in use */
-	iparm[15] = 0;		/* Not in use */
-	iparm[16] = 0;		/* Not in use */
-	iparm[17] = -1;		/* Output: Number of nonzeros in the factor LU */
-	iparm[18] = -1;		/* Output: Mflops for LU factorization */
-	iparm[19] = 0;		/* Output: Numbers of CG Iterations */
-	maxfct = 1;			/* Maximum number of numerical factorizations. */
-	mnum = 1;			/* Which factorization to use. */
-	msglvl = 0;			/* Print statistical information in file */
-	error = 0;			/* Initialize error flag */
-
 	/* -------------------------------------------------------------------- */
 	/* .. Reordering and Symbolic Factorization. This step also allocates */
-	/* all memory that is necessary for the factorization. */
+	/* all memory that is necessary for the factorization. It is kept */
+	/* until setSize() is invoked with a new graph. */
 	/* -------------------------------------------------------------------- */
 
-//#if _DEBUG
-	//opserr << "zise :" << theSOE->size << endln;
-	//opserr << "non zero length :" << n << endln;
-	//opserr << "A :";
-	//for (int i = 0; i < theSOE->nnz; i++)
-	//{
-	//	opserr << " " << a[i];
-	//}
-	//opserr << endln << "ja :" << n << endln;
-	//for (int i = 0; i < theSOE->nnz; i++)
-	//{
-	//	opserr << " " << (int)ja[i];
-	//}
-	//opserr << endln << "ia :" << n << endln;
-	//for (int i = 0; i < theSOE->size + 1; i++)
-	//{
-	//	opserr << " " << (int)ia[i];
-	//}
-	//opserr << endln;
-//#endif
-
-	phase = 11;
-	PARDISO(pt, &maxfct, &mnum, &mtype, &phase,
-		&n, a, ia, ja, &idum, &nrhs, iparm, &msglvl, &ddum, &ddum, &error);
-
-	if (error != 0)
-	{
-		opserr << "\nERROR during symbolic factorization: " << error;
-		return -1;
+	if (analysed == false) {
+
+		for (int i = 0; i < 64; i++)
+		{
+			iparm[i] = 0;
+			pt[i] = 0;
+		}
+
+		iparm[0] = 1;			/* No solver default */
+		iparm[1] = 2;			/* Fill-in reordering from METIS */
+		/* Numbers of processors, value of OMP_NUM_THREADS */
+		iparm[2] = 1;
+		iparm[3] = 0;			/* No iterative-direct algorithm */
+		iparm[4] = 0;			/* No user fill-in reducing permutation */
+		iparm[5] = 0;			/* Write solution into x */
+		iparm[6] = 0;			/* Not in use */
+		iparm[7] = 2;			/* Max numbers of iterative refinement steps */
+		iparm[8] = 0;			/* Not in use */
+		iparm[9] = 13;		/* Perturb the pivot elements with 1E-13 */
+		iparm[10] = 1;		/* Use nonsymmetric permutation and scaling MPS */
+		iparm[11] = 0;		/* Not in use */
+		iparm[12] = 0;		/* Maximum weighted matching algorithm is switched-off (default for symmetric). Try iparm[12] = 1 in case of inappropriate accuracy */
+		iparm[13] = 0;		/* Output: Number of perturbed pivots */
+		iparm[14] = 0;		/* Not in use */
+		iparm[15] = 0;		/* Not in use */
+		iparm[16] = 0;		/* Not in use */
+		iparm[17] = -1;		/* Output: Number of nonzeros in the factor LU */
+		iparm[18] = -1;		/* Output: Mflops for LU factorization */
+		iparm[19] = 0;		/* Output: Numbers of CG Iterations */
+
+		phase = 11;
+		PARDISO(pt, &maxfct, &mnum, &mtype, &phase,
+			&n, a, ia, ja, &idum, &nrhs, iparm, &msglvl, &ddum, &ddum, &error);
+
+		if (error != 0)
+		{
+			opserr << "\nERROR during symbolic factorization: " << error;
+			return -1;
+		}
+
+		analysed = true;
+		numSymbolicFactor++;
 	}
 
 	/* -------------------------------------------------------------------- */
@@ -175,6 +168,7 @@ PARDISOGenLinSolver::solve(void)
 		opserr << "\nERROR during numerical factorization: " << error;
 		return -2;
 	}
+	numNumericFactor++;
 
 	/* -------------------------------------------------------------------- */
 	/* .. Back substitution and iterative refinement. */
@@ -191,29 +185,6 @@ PARDISOGenLinSolver::solve(void)
 		return -3;
 	}
 
-	/* Solve completed ... 
-	   The solution of the system is: */
-
-	/* -------------------------------------------------------------------- */
-	/* .. Termination and release of memory. */
-	/* -------------------------------------------------------------------- */
-	phase = -1;			/* Release internal memory. */
-	PARDISO(pt, &maxfct, &mnum, &mtype, &phase,
-		&n, &ddum, ia, ja, &idum, &nrhs,
-		iparm, &msglvl, &ddum, &ddum, &error);
-
-	//if (pt != 0)
-	//	delete[] pt;
-
-	//if (iparm != 0)
-	//	delete[] iparm;
-
-	/*opserr << endln << "x :" << n << endln;
-	for (int i = 0; i < theSOE->size; i++)
-	{
-		opserr << " " << Xptr[i];
-	}
-	opserr << endln;*/
     return 0;
 }
 
@@ -221,7 +192,8 @@ PARDISOGenLinSolver::solve(void)
 int
 PARDISOGenLinSolver::setSize()
 {
-    // nothing to do
+    // the graph has changed, the reordering is redone on the next solve
+    this->release();
     return 0;
 }
 
@@ -39,7 +39,12 @@ class PARDISOGenLinSolver : public LinearSOESolver
   protected:
 
   private:
+	  void release(void);
+
 	  PARDISOGenLinSOE *theSOE;
+	  void *pt[64];		// PARDISO internal data, kept between solves
+	  int iparm[64];
+	  bool analysed;	// true if the reordering & symbolic factorization are done
 };
 
 #endif
@@ -39,7 +39,12 @@ class PARDISOSymLinSolver : public LinearSOESolver
   protected:
 
   private:
+	  void release(void);
+
 	  PARDISOSymLinSOE *theSOE;
+	  void *pt[64];		// PARDISO internal data, kept between solves
+	  int iparm[64];
+	  bool analysed;	// true if the reordering & symbolic factorization are done
 };
 
 #endif
@@ -495,20 +495,8 @@ PetscSOE::setSize(Graph &theGraph)
             }
           }
 
-          // Check the symmetric condition of this (dofs are symmetricly connected!)
-          // If the dof number belongs to this processor
-          if ( startRow_vec[proc] <= col && col <= endRow_vec[proc]   )
-          {
-            int row = col - startRow_vec[proc];
-            if ( startRow_vec[proc] <= dof && dof <= endRow_vec[proc]   )
-            {
-              d_nnz[proc][row ] += 1;
-            }
-            else
-            {
-              o_nnz[proc][row ] += 1;
-            }
-          }
+          // The adjacency of the graph is symmetric, the entry (col, dof)
+          // is counted when the vertex of col is visited
         }
       }
     }
@@ -537,23 +525,18 @@ PetscSOE::setSize(Graph &theGraph)
 
 
 
+    // The counts are exact for the rows of one process; a dof shared
+    // by several processes is counted once for each, which can only
+    // overestimate its row, so that the assembly never allocates
     for (int row = 0; row < nlocaldofs[processID]; row++)
     {
-      if (d_nnz_global[row] < PETSCSOE_MIN_DNNZ)
-      {
-        d_nnz_global[row] =  PETSCSOE_MIN_DNNZ;
-      }
-      if (o_nnz_global[row] < PETSCSOE_MIN_ONNZ)
-      {
-        o_nnz_global[row] =  PETSCSOE_MIN_ONNZ;
-      }
       if (d_nnz_global[row] > ndofs)
       {
         d_nnz_global[row] =  ndofs;
       }
-      if (o_nnz_global[row] > ndofs)
+      if (o_nnz_global[row] > size - ndofs)
       {
-        o_nnz_global[row] =  ndofs;
+        o_nnz_global[row] =  size - ndofs;
       }
     }
 
@@ -44,7 +44,7 @@ using namespace std;
 PetscSolver::PetscSolver()
     : LinearSOESolver(SOLVER_TAGS_PetscSolver),
       rTol(PETSC_DEFAULT), aTol(PETSC_DEFAULT), dTol(PETSC_DEFAULT), maxIts(PETSC_DEFAULT), matType(MATMPIAIJ),
-      is_KSP_initialized(false)
+      is_KSP_initialized(false), numPCReuse(0), numSolvesWithPC(0), matrixFrozen(false)
 {
 
 }
@@ -52,7 +52,7 @@ PetscSolver::PetscSolver()
 PetscSolver::PetscSolver(KSPType meth, PCType pre)
     : LinearSOESolver(SOLVER_TAGS_PetscSolver), method(meth), preconditioner(pre),
       rTol(PETSC_DEFAULT), aTol(PETSC_DEFAULT), dTol(PETSC_DEFAULT), maxIts(PETSC_DEFAULT), matType(MATMPIAIJ),
-      is_KSP_initialized(false)
+      is_KSP_initialized(false), numPCReuse(0), numSolvesWithPC(0), matrixFrozen(false)
 {
 
 }
@@ -60,15 +60,22 @@ PetscSolver::PetscSolver(KSPType meth, PCType pre)
 PetscSolver::PetscSolver(KSPType meth, PCType pre, double relTol, double absTol, double divTol, int maxIterations, MatType mat)
     : LinearSOESolver(SOLVER_TAGS_PetscSolver), method(meth), preconditioner(pre),
       rTol(relTol), aTol(absTol), dTol(divTol), maxIts(maxIterations), matType(mat),
-      is_KSP_initialized(false)
+      is_KSP_initialized(false), numPCReuse(0), numSolvesWithPC(0), matrixFrozen(false)
 {
 
 }
 
 PetscSolver::~PetscSolver()
 {
-    // KSPDestroy(&ksp);
-    // CHKERRQ(ierr);
+    if (is_KSP_initialized)
+        KSPDestroy(&ksp);
+}
+
+
+void
+PetscSolver::setPreconditionerReuse(int numReuse)
+{
+    numPCReuse = (numReuse > 0) ? numReuse : 0;
 }
 
 
@@ -93,6 +100,14 @@ PetscSolver::solve(void)
         CHKERRQ(ierr);
         PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") MatAssemblyEnd\n";
 
+        // the first assembly has placed every entry of the graph, later
+        // ones only add to them
+        if (not matrixFrozen)
+        {
+            MatSetOption(theSOE->A, MAT_NEW_NONZERO_LOCATIONS, PETSC_FALSE);
+            matrixFrozen = true;
+        }
+
 
         if (not is_KSP_initialized)
         {
@@ -104,12 +119,26 @@ PetscSolver::solve(void)
 
 
             is_KSP_initialized = true;
+            numSolvesWithPC = numPCReuse;
         }
         
         PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") KSPSetOperators Begin\n";
         KSPSetOperators(ksp, theSOE->A, theSOE->A);
         PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") KSPSetOperators End\n";
 
+        // the new operator only resets the preconditioner once it is
+        // numPCReuse solves old
+        if (numSolvesWithPC < numPCReuse)
+        {
+            KSPSetReusePreconditioner(ksp, PETSC_TRUE);
+            numSolvesWithPC++;
+        }
+        else
+        {
+            KSPSetReusePreconditioner(ksp, PETSC_FALSE);
+            numSolvesWithPC = 0;
+        }
+
     }
 
 
@@ -192,6 +221,18 @@ PetscSolver::solve(void)
     {
         ierr = KSPSolve(ksp, theSOE->b, theSOE->x);
         CHKERRQ(ierr);
+
+        // a kept preconditioner that no longer fits the matrix is formed
+        // again and the system solved once more
+        KSPConvergedReason reason;
+        KSPGetConvergedReason(ksp, &reason);
+        if (reason < 0 && numSolvesWithPC > 0)
+        {
+            KSPSetReusePreconditioner(ksp, PETSC_FALSE);
+            numSolvesWithPC = 0;
+            ierr = KSPSolve(ksp, theSOE->b, theSOE->x);
+            CHKERRQ(ierr);
+        }
         theSOE->isFactored = 1;
     }
     PetscTime(&t2);
@@ -243,9 +284,6 @@ PetscSolver::solve(void)
     }
 
     PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") SendXEnd\n";
-    // Destroy KSP and collect the error at P0
-    KSPDestroy(&ksp);
-    is_KSP_initialized = false;
 
     PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") Logging Begin\n";
 
@@ -269,12 +307,15 @@ int
 PetscSolver::setSize()
 {
     /*
-     * Create linear solver context
+     * The solver context is created again with the new matrix in the
+     * next solve
      */
-    if (theSOE->processID >= 0)
+    if (theSOE->processID >= 0 && is_KSP_initialized)
     {
-        KSPCreate(PETSC_COMM_WORLD, &ksp);
+        KSPDestroy(&ksp);
+        is_KSP_initialized = false;
     }
+    matrixFrozen = false;
 
 
     return 0;
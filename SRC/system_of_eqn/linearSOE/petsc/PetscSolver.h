@@ -47,6 +47,10 @@ public:
     PetscSolver();
     PetscSolver(KSPType method, PCType preconditioner);
     PetscSolver(KSPType method, PCType preconditioner, double rTol, double aTol, double dTol, int maxIts, MatType mat=MATMPIAIJ);//Guanzhou
+
+    // keeps the preconditioner for numReuse solves after it is formed,
+    // e.g. over the iterations of a Newton step; 0 forms it every solve
+    void setPreconditionerReuse(int numReuse);
     ~PetscSolver();
 
     int solve(void);
@@ -76,6 +80,9 @@ private:
     MatType matType;
 
     bool is_KSP_initialized;
+    int numPCReuse;
+    int numSolvesWithPC;
+    bool matrixFrozen;
 };
 
 #endif
@@ -40,7 +40,8 @@
 DistributedProfileSPDLinSOE::DistributedProfileSPDLinSOE(ProfileSPDLinSolver &theSolvr)
   :ProfileSPDLinSOE(theSolvr, LinSOE_TAGS_DistributedProfileSPDLinSOE), 
    processID(0), numChannels(0), theChannels(0), 
-   localCol(0), sizeLocal(0), workArea(0), sizeWork(0), myVectB(0), myB(0)
+   localCol(0), sizeLocal(0), workArea(0), sizeWork(0), myVectB(0), myB(0),
+   remoteB(0), sizeRemoteB(0)
 {
     theSolvr.setLinearSOE(*this);
 }
@@ -49,7 +50,8 @@ DistributedProfileSPDLinSOE::DistributedProfileSPDLinSOE(ProfileSPDLinSolver &th
 DistributedProfileSPDLinSOE::DistributedProfileSPDLinSOE()
   :ProfileSPDLinSOE(LinSOE_TAGS_DistributedProfileSPDLinSOE), 
    processID(0), numChannels(0), theChannels(0), 
-   localCol(0), sizeLocal(0), workArea(0), sizeWork(0), myVectB(0), myB(0)
+   localCol(0), sizeLocal(0), workArea(0), sizeWork(0), myVectB(0), myB(0),
+   remoteB(0), sizeRemoteB(0)
 {
 
 }
@@ -77,6 +79,46 @@ DistributedProfileSPDLinSOE::~DistributedProfileSPDLinSOE()
 
   if (myB != 0)
     delete [] myB;
+
+  if (remoteB != 0)
+    delete [] remoteB;
+}
+
+
+// P0 posts the receives of the B contributions of all subprocesses at
+// once; each goes into its own part of remoteB so they can arrive in any order
+int
+DistributedProfileSPDLinSOE::postRecvB(void)
+{
+  int needed = numChannels * size;
+  if (needed > sizeRemoteB) {
+    if (remoteB != 0)
+      delete [] remoteB;
+    remoteB = new double[needed];
+    sizeRemoteB = needed;
+  }
+
+  for (int j=0; j<numChannels; j++) {
+    Vector theB(&remoteB[j*size], size);
+    theChannels[j]->irecvVector(0, 0, theB);
+  }
+
+  return 0;
+}
+
+
+// P0 waits on the posted receives and adds the contributions into B
+int
+DistributedProfileSPDLinSOE::addRemoteB(void)
+{
+  for (int j=0; j<numChannels; j++) {
+    theChannels[j]->waitAll();
+    double *theB = &remoteB[j*size];
+    for (int i=0; i<size; i++)
+      B[i] += theB[i];
+  }
+
+  return 0;
 }
 
 
@@ -425,6 +467,12 @@ DistributedProfileSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
   return 0;
 }
 
+int
+DistributedProfileSPDLinSOE::solveMultiple(const Matrix &B, Matrix &X)
+{
+    return this->LinearSOE::solveMultiple(B, X);
+}
+
 int 
 DistributedProfileSPDLinSOE::solve(void)
 {
@@ -438,17 +486,18 @@ DistributedProfileSPDLinSOE::solve(void)
     Channel *theChannel = theChannels[0];
 
     // send B
-    theChannel->sendVector(0, 0, *myVectB);
+    theChannel->isendVector(0, 0, *myVectB);
+
+    // send A in packets placed in vector X
+    Vector vectA(A, (*sizeLocal)(0));    
+    if (isAfactored == false)
+      theChannel->isendVector(0, 0, vectA);
 
-    if (isAfactored == false) {
-      // send A in packets placed in vector X
-      Vector vectA(A, (*sizeLocal)(0));    
-      theChannel->sendVector(0, 0, vectA);
-    }
     // receive X,B and result
-    theChannel->recvVector(0, 0, *vectX);
-    theChannel->recvVector(0, 0, *vectB);
-    theChannel->recvID(0, 0, result);
+    theChannel->irecvVector(0, 0, *vectX);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->irecvID(0, 0, result);
+    theChannel->waitAll();
     isAfactored = true;
   } 
 
@@ -460,14 +509,13 @@ DistributedProfileSPDLinSOE::solve(void)
     
     // add P0 contribution to B
     *vectB = *myVectB;
+
+    // post the receives of the B contributions, they come in while A is added
+    this->postRecvB();
     
-    // receive X and A contribution from subprocess & add them in
+    // receive A contribution from subprocess & add them in
     for (int j=0; j<numChannels; j++) {
-
-      // get X & add
       Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, *vectX);
-      *vectB += *vectX;
 
       // get A & add using local map
       if (isAfactored == false) {
@@ -496,18 +544,22 @@ DistributedProfileSPDLinSOE::solve(void)
       }    
     }
 
+    this->addRemoteB();
+
     // solve
     result(0) = this->LinearSOE::solve();
 
     //    opserr << *vectX;
 
-    // send results back
+    // send results back to all at once
     for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectX);
-      theChannel->sendVector(0, 0, *vectB);
-      theChannel->sendID(0, 0, result);      
+      theChannel->isendVector(0, 0, *vectX);
+      theChannel->isendVector(0, 0, *vectB);
+      theChannel->isendID(0, 0, result);      
     }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
 
   return result(0);
@@ -597,8 +649,9 @@ DistributedProfileSPDLinSOE::getB(void)
     Channel *theChannel = theChannels[0];
 
     // send B & recv merged B
-    theChannel->sendVector(0, 0, *myVectB);
-    theChannel->recvVector(0, 0, *vectB);
+    theChannel->isendVector(0, 0, *myVectB);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->waitAll();
   } 
 
   //
@@ -607,23 +660,17 @@ DistributedProfileSPDLinSOE::getB(void)
 
   else {
 
-    // receive X and A contribution from subprocess & add them in
+    // receive B contribution from subprocess & add them in
 
     *vectB = *myVectB;
-    Vector remoteB(workArea, size);    
-
-    for (int j=0; j<numChannels; j++) {
-
-      Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, remoteB);
-      *vectB += remoteB;
-    }
+    this->postRecvB();
+    this->addRemoteB();
   
     // send results back
-    for (int j=0; j<numChannels; j++) {
-      Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectB);
-    }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->isendVector(0, 0, *vectB);
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
 
   return *vectB;
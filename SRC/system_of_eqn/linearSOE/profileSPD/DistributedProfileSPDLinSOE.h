@@ -56,6 +56,9 @@ class DistributedProfileSPDLinSOE : public ProfileSPDLinSOE
     int solve(void);
     const Vector &getB(void);
 
+    // the columns are solved one at a time through solve()
+    int solveMultiple(const Matrix &B, Matrix &X);
+
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
     friend class ProfileSPDLinSolver;    
@@ -72,6 +75,9 @@ class DistributedProfileSPDLinSOE : public ProfileSPDLinSOE
   protected:
     
   private:
+    int postRecvB(void);
+    int addRemoteB(void);
+
     int processID;
     int numChannels;
     Channel **theChannels;
@@ -82,6 +88,8 @@ class DistributedProfileSPDLinSOE : public ProfileSPDLinSOE
     int sizeWork;
     Vector *myVectB;
     double *myB;
+    double *remoteB;     // B contributions of the subprocesses, on P0
+    int sizeRemoteB;
 };
 
 
@@ -241,6 +241,7 @@ ProfileSPDLinDirectSolver::solve(void)
 
 	theSOE->isAfactored = true;
 	theSOE->numInt = 0;
+	numNumericFactor++;
 	
 	
 	// divide by diag term 
@@ -310,6 +311,74 @@ ProfileSPDLinDirectSolver::solve(void)
     return 0;
 }
 
+// the first column is solved by solve(), which factors A if it has not
+// been; the others are then reduced together, each column of the factor
+// being read once for all of them
+int
+ProfileSPDLinDirectSolver::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "ProfileSPDLinDirectSolver::solveMultiple(): ";
+	opserr << " - No ProfileSPDSOE has been assigned\n";
+	return -1;
+    }
+
+    int theSize = theSOE->size;
+    if (theSize == 0 || numRHS == 0)
+	return 0;
+
+    int first = 0;
+    if (theSOE->isAfactored == false) {
+	for (int i=0; i<theSize; i++)
+	    theSOE->B[i] = BX[i];
+	int res = this->solve();
+	if (res < 0)
+	    return res;
+	for (int i=0; i<theSize; i++)
+	    BX[i] = theSOE->X[i];
+	first = 1;
+    }
+
+    double *BX0 = BX + (long)first*theSize;
+    int num = numRHS - first;
+
+    // forward substitution
+    for (int i=1; i<theSize; i++) {
+	int rowitop = RowTop[i];
+	const double *aji = topRowPtr[i];
+	for (int r=0; r<num; r++) {
+	    double *col = BX0 + (long)r*theSize;
+	    const double *bj = col + rowitop;
+	    double tmp = 0.0;
+	    for (int j=0; j<i-rowitop; j++)
+		tmp -= aji[j] * bj[j];
+	    col[i] += tmp;
+	}
+    }
+
+    // divide by the diagonal terms
+    for (int r=0; r<num; r++) {
+	double *col = BX0 + (long)r*theSize;
+	for (int j=0; j<theSize; j++)
+	    col[j] *= invD[j];
+    }
+
+    // back substitution
+    for (int k=theSize-1; k>0; k--) {
+	int rowktop = RowTop[k];
+	const double *ajk = topRowPtr[k];
+	for (int r=0; r<num; r++) {
+	    double *col = BX0 + (long)r*theSize;
+	    double bk = col[k];
+	    double *bj = col + rowktop;
+	    for (int j=0; j<k-rowktop; j++)
+		bj[j] -= ajk[j] * bk;
+	}
+    }
+
+    return 0;
+}
+
 double
 ProfileSPDLinDirectSolver::getDeterminant(void) 
 {
@@ -430,6 +499,7 @@ ProfileSPDLinDirectSolver::factor(int n)
 
 	theSOE->isAfactored = true;
 	theSOE->numInt = n;
+	numNumericFactor++;
 	
     }	
     return 0;
@@ -494,6 +564,7 @@ ProfileSPDLinDirectSolver::factor(int n)
 	    if (aii <= minDiagTol) return(-1);
 	    invD[i] = 1.0/aii; 
 	}
+	numNumericFactor++;
     }
     
     theSOE->isAfactored = true;
@@ -506,6 +577,15 @@ ProfileSPDLinDirectSolver::factor(int n)
 }
 */
 
+// the factors overwrite A, only the row data are the solver's
+size_t
+ProfileSPDLinDirectSolver::getMemoryUsage(void)
+{
+    if (RowTop == 0)
+	return 0;
+    return size*(sizeof(int) + sizeof(double *) + sizeof(double));
+}
+
 int
 ProfileSPDLinDirectSolver::sendSelf(int cTag,
 				    Channel &theChannel)
@@ -50,8 +50,10 @@ class ProfileSPDLinDirectSolver : public ProfileSPDLinSolver
     virtual ~ProfileSPDLinDirectSolver();
 
     virtual int solve(void);        
+    virtual int solveMultiple(int numRHS, double *BX);
     virtual int setSize(void);    
     double getDeterminant(void);
+    size_t getMemoryUsage(void);
 
     
     virtual int factor(int n);
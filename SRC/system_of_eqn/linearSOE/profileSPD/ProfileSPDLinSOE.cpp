@@ -542,6 +542,13 @@ ProfileSPDLinSOE::getB(void)
     return *vectB;
 }
 
+// A, B & X, the factors of the solver are computed in A
+size_t
+ProfileSPDLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + (size+1)*sizeof(int) + 2*sizeof(Vector);
+}
+
 double 
 ProfileSPDLinSOE::normRHS(void)
 {
@@ -585,3 +592,23 @@ ProfileSPDLinSOE::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theB
 {
     return 0;
 }
+
+
+int
+ProfileSPDLinSOE::solveMultiple(const Matrix &Bm, Matrix &Xm)
+{
+    int numRHS = Bm.noCols();
+    if (Bm.noRows() != size) {
+	opserr << "WARNING ProfileSPDLinSOE::solveMultiple() - B has " << Bm.noRows();
+	opserr << " rows, the system " << size << " equations\n";
+	return -1;
+    }
+
+    // the columns are solved in place in X
+    Xm = Bm;
+    if (size == 0 || numRHS == 0)
+	return 0;
+
+    ProfileSPDLinSolver *theSolvr = (ProfileSPDLinSolver *)this->getSolver();
+    return theSolvr->solveMultiple(numRHS, &Xm(0,0));
+}
@@ -66,7 +66,9 @@ class ProfileSPDLinSOE : public LinearSOE
     virtual const Vector &getX(void);
     virtual const Vector &getB(void);
     virtual double normRHS(void);
+    virtual size_t getMemoryUsage(void);
 
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
     virtual int setProfileSPDSolver(ProfileSPDLinSolver &newSolver);    
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -50,6 +50,10 @@ class ProfileSPDLinSolver : public LinearSOESolver
     virtual ~ProfileSPDLinSolver();
 
     virtual int solve(void) = 0;
+
+    // solves for the numRHS columns (of size n, one after the other) in
+    // BX, which are replaced by the solutions; by default one at a time
+    virtual int solveMultiple(int numRHS, double *BX);
     virtual int setLinearSOE(ProfileSPDLinSOE &theSOE);
     
   protected:
@@ -0,0 +1,333 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of CuDSSSolver.
+
+#include <CuDSSSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <elementAPI.h>
+#include <string.h>
+
+// number of values compared and, if changed, copied to the device at a time
+#define CUDSS_BLOCK_SIZE 4096
+
+void* OPS_CuDSSSolver()
+{
+    // system CuDSS <-sym> <-spd>
+    int matrixType = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-sym") == 0)
+	    matrixType = 1;
+	else if (strcmp(opt, "-spd") == 0)
+	    matrixType = 2;
+    }
+
+    CuDSSSolver *theSolver = new CuDSSSolver(matrixType);
+    return new SparseGenRowLinSOE(*theSolver);
+}
+
+
+static int
+cudaFailed(cudaError_t status, const char *what)
+{
+    if (status == cudaSuccess)
+	return 0;
+    opserr << "WARNING CuDSSSolver - " << what << " failed: ";
+    opserr << cudaGetErrorString(status) << endln;
+    return -1;
+}
+
+
+static int
+cudssFailed(cudssStatus_t status, const char *what)
+{
+    if (status == CUDSS_STATUS_SUCCESS)
+	return 0;
+    opserr << "WARNING CuDSSSolver - " << what << " returned ";
+    opserr << (int)status << endln;
+    return -1;
+}
+
+
+CuDSSSolver::CuDSSSolver(int type)
+:SparseGenRowLinSolver(SOLVER_TAGS_CuDSSSolver),
+ matrixType(type), n(0), nnz(0), factorized(false),
+ handle(0), config(0), data(0), matA(0), matX(0), matB(0), stream(0),
+ rowStartD(0), colD(0), AD(0), XD(0), BD(0), Asent(0)
+{
+
+}
+
+
+CuDSSSolver::~CuDSSSolver()
+{
+    this->clear();
+
+    if (config != 0)
+	cudssConfigDestroy(config);
+    if (handle != 0)
+	cudssDestroy(handle);
+    if (stream != 0)
+	cudaStreamDestroy(stream);
+}
+
+
+// releases the device storage & the analysis of the current pattern
+void
+CuDSSSolver::clear(void)
+{
+    if (matA != 0) cudssMatrixDestroy(matA);
+    if (matX != 0) cudssMatrixDestroy(matX);
+    if (matB != 0) cudssMatrixDestroy(matB);
+    if (data != 0) cudssDataDestroy(handle, data);
+    matA = 0; matX = 0; matB = 0; data = 0;
+
+    if (rowStartD != 0) cudaFree(rowStartD);
+    if (colD != 0) cudaFree(colD);
+    if (AD != 0) cudaFree(AD);
+    if (XD != 0) cudaFree(XD);
+    if (BD != 0) cudaFree(BD);
+    if (Asent != 0) cudaFreeHost(Asent);
+    rowStartD = 0; colD = 0; AD = 0; XD = 0; BD = 0; Asent = 0;
+
+    n = 0;
+    nnz = 0;
+    factorized = false;
+}
+
+
+int
+CuDSSSolver::setLinearSOE(SparseGenRowLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+
+int
+CuDSSSolver::setSize(void)
+{
+    this->clear();
+
+    if (theSOE == 0) {
+	opserr << "WARNING CuDSSSolver::setSize(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0 || theSOE->nnz == 0)
+	return 0;
+
+    if (handle == 0) {
+	if (cudaFailed(cudaStreamCreate(&stream), "cudaStreamCreate") < 0) {
+	    stream = 0;
+	    return -1;
+	}
+	// whatever was created before a failure is destroyed again
+	if (cudssFailed(cudssCreate(&handle), "cudssCreate") < 0) {
+	    handle = 0;
+	} else if (cudssFailed(cudssSetStream(handle, stream), "cudssSetStream") < 0 ||
+		   cudssFailed(cudssConfigCreate(&config), "cudssConfigCreate") < 0) {
+	    config = 0;
+	    cudssDestroy(handle);
+	    handle = 0;
+	}
+	if (handle == 0) {
+	    cudaStreamDestroy(stream);
+	    stream = 0;
+	    return -1;
+	}
+    }
+
+    int size = theSOE->size;
+    int numNZ = theSOE->nnz;
+
+    // the pattern is copied once per setSize()
+    if (cudaFailed(cudaMalloc((void **)&rowStartD, (size+1)*sizeof(int)), "cudaMalloc") < 0 ||
+	cudaFailed(cudaMalloc((void **)&colD, numNZ*sizeof(int)), "cudaMalloc") < 0 ||
+	cudaFailed(cudaMalloc((void **)&AD, numNZ*sizeof(double)), "cudaMalloc") < 0 ||
+	cudaFailed(cudaMalloc((void **)&XD, size*sizeof(double)), "cudaMalloc") < 0 ||
+	cudaFailed(cudaMalloc((void **)&BD, size*sizeof(double)), "cudaMalloc") < 0 ||
+	cudaFailed(cudaMallocHost((void **)&Asent, numNZ*sizeof(double)), "cudaMallocHost") < 0) {
+	this->clear();
+	return -1;
+    }
+
+    memcpy(Asent, theSOE->A, numNZ*sizeof(double));
+    if (cudaFailed(cudaMemcpyAsync(rowStartD, theSOE->rowStartA, (size+1)*sizeof(int),
+				   cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0 ||
+	cudaFailed(cudaMemcpyAsync(colD, theSOE->colA, numNZ*sizeof(int),
+				   cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0 ||
+	cudaFailed(cudaMemcpyAsync(AD, Asent, numNZ*sizeof(double),
+				   cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0) {
+	this->clear();
+	return -1;
+    }
+
+    cudssMatrixType_t mtype = CUDSS_MTYPE_GENERAL;
+    cudssMatrixViewType_t mview = CUDSS_MVIEW_FULL;
+    if (matrixType == 1) {
+	mtype = CUDSS_MTYPE_SYMMETRIC;
+	mview = CUDSS_MVIEW_UPPER;
+    } else if (matrixType == 2) {
+	mtype = CUDSS_MTYPE_SPD;
+	mview = CUDSS_MVIEW_UPPER;
+    }
+
+    if (cudssFailed(cudssDataCreate(handle, &data), "cudssDataCreate") < 0 ||
+	cudssFailed(cudssMatrixCreateCsr(&matA, size, size, numNZ, rowStartD, NULL,
+					 colD, AD, CUDA_R_32I, CUDA_R_64F,
+					 mtype, mview, CUDSS_BASE_ZERO),
+		    "cudssMatrixCreateCsr") < 0 ||
+	cudssFailed(cudssMatrixCreateDn(&matX, size, 1, size, XD, CUDA_R_64F,
+					CUDSS_LAYOUT_COL_MAJOR), "cudssMatrixCreateDn") < 0 ||
+	cudssFailed(cudssMatrixCreateDn(&matB, size, 1, size, BD, CUDA_R_64F,
+					CUDSS_LAYOUT_COL_MAJOR), "cudssMatrixCreateDn") < 0) {
+	this->clear();
+	return -1;
+    }
+
+    // reordering & symbolic factorization, kept until the next setSize()
+    if (cudssFailed(cudssExecute(handle, CUDSS_PHASE_ANALYSIS, config, data,
+				 matA, matX, matB), "analysis") < 0) {
+	this->clear();
+	return -1;
+    }
+
+    n = size;
+    nnz = numNZ;
+    numSymbolicFactor++;
+
+    return 0;
+}
+
+
+// copies to the device the blocks of A that differ from the values
+// already there, adjacent changed blocks go in one copy
+int
+CuDSSSolver::sendA(void)
+{
+    const double *A = theSOE->A;
+    int runStart = -1;
+
+    for (int start = 0; start < nnz; start += CUDSS_BLOCK_SIZE) {
+	int len = nnz - start;
+	if (len > CUDSS_BLOCK_SIZE)
+	    len = CUDSS_BLOCK_SIZE;
+
+	if (memcmp(Asent+start, A+start, len*sizeof(double)) != 0) {
+	    memcpy(Asent+start, A+start, len*sizeof(double));
+	    if (runStart < 0)
+		runStart = start;
+	} else if (runStart >= 0) {
+	    size_t count = start - runStart;
+	    if (cudaFailed(cudaMemcpyAsync(AD+runStart, Asent+runStart, count*sizeof(double),
+					   cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0)
+		return -1;
+	    runStart = -1;
+	}
+    }
+
+    if (runStart >= 0) {
+	size_t count = nnz - runStart;
+	if (cudaFailed(cudaMemcpyAsync(AD+runStart, Asent+runStart, count*sizeof(double),
+				       cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0)
+	    return -1;
+    }
+
+    return 0;
+}
+
+
+int
+CuDSSSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING CuDSSSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    if (n != theSOE->size || nnz != theSOE->nnz) {
+	opserr << "WARNING CuDSSSolver::solve(void)- ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    if (theSOE->factored == false) {
+
+	if (this->sendA() < 0)
+	    return -1;
+
+	cudssPhase_t phase = factorized ? CUDSS_PHASE_REFACTORIZATION : CUDSS_PHASE_FACTORIZATION;
+	if (cudssFailed(cudssExecute(handle, phase, config, data, matA, matX, matB),
+			"factorization") < 0)
+	    return -1;
+
+	int info = 0;
+	size_t sizeWritten = 0;
+	if (cudssDataGet(handle, data, CUDSS_DATA_INFO, &info, sizeof(info),
+			 &sizeWritten) == CUDSS_STATUS_SUCCESS && info != 0) {
+	    opserr << "WARNING CuDSSSolver::solve(void)- ";
+	    opserr << " factorization failed, info = " << info << endln;
+	    return -info;
+	}
+
+	factorized = true;
+	theSOE->factored = true;
+	numNumericFactor++;
+    }
+
+    if (cudaFailed(cudaMemcpyAsync(BD, theSOE->B, n*sizeof(double),
+				   cudaMemcpyHostToDevice, stream), "cudaMemcpy") < 0)
+	return -1;
+
+    if (cudssFailed(cudssExecute(handle, CUDSS_PHASE_SOLVE, config, data,
+				 matA, matX, matB), "solve") < 0)
+	return -1;
+
+    if (cudaFailed(cudaMemcpyAsync(theSOE->X, XD, n*sizeof(double),
+				   cudaMemcpyDeviceToHost, stream), "cudaMemcpy") < 0 ||
+	cudaFailed(cudaStreamSynchronize(stream), "cudaStreamSynchronize") < 0)
+	return -1;
+
+    return 0;
+}
+
+
+int
+CuDSSSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+CuDSSSolver::recvSelf(int cTag, Channel &theChannel,
+		      FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
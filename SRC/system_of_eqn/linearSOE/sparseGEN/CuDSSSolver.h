@@ -0,0 +1,77 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef CuDSSSolver_h
+#define CuDSSSolver_h
+
+// Description: This file contains the class definition for CuDSSSolver.
+// CuDSSSolver solves a SparseGenRowLinSOE on an NVIDIA GPU with the cuDSS
+// direct sparse solver. The row starts and column indices are copied to
+// the device once in setSize(), where the reordering and symbolic analysis
+// are also done. The factors stay on the device: the first factorization
+// after setSize() is a full one, later ones are refactorizations with the
+// same pattern and pivot order. When A has been reassembled only the
+// blocks of values that differ from those already on the device are
+// copied across.
+//
+// What: "@(#) CuDSSSolver.h, revA"
+
+#include <SparseGenRowLinSolver.h>
+#include <cuda_runtime.h>
+#include <cudss.h>
+
+class CuDSSSolver : public SparseGenRowLinSolver
+{
+  public:
+    // matrixType: 0 general, 1 symmetric, 2 symmetric positive definite
+    CuDSSSolver(int matrixType = 0);
+    ~CuDSSSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(SparseGenRowLinSOE &theSOE);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    void clear(void);
+    int sendA(void);
+
+    int matrixType;
+    int n, nnz;
+    bool factorized;     // true after the first factorization since setSize()
+
+    cudssHandle_t handle;
+    cudssConfig_t config;
+    cudssData_t data;
+    cudssMatrix_t matA, matX, matB;
+    cudaStream_t stream;
+
+    int *rowStartD, *colD;   // the pattern of A on the device
+    double *AD, *XD, *BD;    // A, X and B on the device
+    double *Asent;           // host (pinned) copy of the values in AD
+};
+
+#endif
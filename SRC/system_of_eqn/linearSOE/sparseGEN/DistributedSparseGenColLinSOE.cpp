@@ -43,7 +43,7 @@
 DistributedSparseGenColLinSOE::DistributedSparseGenColLinSOE(SparseGenColLinSolver &theSolvr)
   :SparseGenColLinSOE(theSolvr, LinSOE_TAGS_DistributedSparseGenColLinSOE), 
    processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0),
-   myVectB(0)
+   myVectB(0), remoteB(0), sizeRemoteB(0)
   
 {
     theSolvr.setLinearSOE(*this);
@@ -52,7 +52,7 @@ DistributedSparseGenColLinSOE::DistributedSparseGenColLinSOE(SparseGenColLinSolv
 DistributedSparseGenColLinSOE::DistributedSparseGenColLinSOE()
   :SparseGenColLinSOE(LinSOE_TAGS_DistributedSparseGenColLinSOE), 
    processID(0), numChannels(0), theChannels(0), localCol(0), workArea(0), sizeWork(0), myB(0),
-   myVectB(0)
+   myVectB(0), remoteB(0), sizeRemoteB(0)
   
 {
 
@@ -75,6 +75,46 @@ DistributedSparseGenColLinSOE::~DistributedSparseGenColLinSOE()
 
   if (myVectB != 0)
     delete myVectB;
+
+  if (remoteB != 0)
+    delete [] remoteB;
+}
+
+
+// P0 posts the receives of the B contributions of all subprocesses at
+// once; each goes into its own part of remoteB so they can arrive in any order
+int
+DistributedSparseGenColLinSOE::postRecvB(void)
+{
+  int needed = numChannels * size;
+  if (needed > sizeRemoteB) {
+    if (remoteB != 0)
+      delete [] remoteB;
+    remoteB = new double[needed];
+    sizeRemoteB = needed;
+  }
+
+  for (int j=0; j<numChannels; j++) {
+    Vector theB(&remoteB[j*size], size);
+    theChannels[j]->irecvVector(0, 0, theB);
+  }
+
+  return 0;
+}
+
+
+// P0 waits on the posted receives and adds the contributions into B
+int
+DistributedSparseGenColLinSOE::addRemoteB(void)
+{
+  for (int j=0; j<numChannels; j++) {
+    theChannels[j]->waitAll();
+    double *theB = &remoteB[j*size];
+    for (int i=0; i<size; i++)
+      B[i] += theB[i];
+  }
+
+  return 0;
 }
 
 
@@ -496,6 +536,12 @@ DistributedSparseGenColLinSOE::zeroB(void)
     *Bptr++ = 0;
 }
 
+int
+DistributedSparseGenColLinSOE::solveMultiple(const Matrix &B, Matrix &X)
+{
+    return this->LinearSOE::solveMultiple(B, X);
+}
+
 int 
 DistributedSparseGenColLinSOE::solve(void)
 {
@@ -509,22 +555,25 @@ DistributedSparseGenColLinSOE::solve(void)
     Channel *theChannel = theChannels[0];
 
     // send B
-    theChannel->sendVector(0, 0, *myVectB);
+    theChannel->isendVector(0, 0, *myVectB);
 
     // send A in packets placed in vector X
-    if (factored == false) {
-      Vector vectA(A, nnz);    
-      theChannel->sendVector(0, 0, vectA);
-    }
+    Vector vectA(A, nnz);    
+    if (factored == false)
+      theChannel->isendVector(0, 0, vectA);
 
+    // the sends are completed before the solver starts its own messages
     LinearSOESolver *theSoeSolver = this->getSolver();
-    if (theSoeSolver->getClassTag() == SOLVER_TAGS_DistributedSuperLU)
+    if (theSoeSolver->getClassTag() == SOLVER_TAGS_DistributedSuperLU) {
+      theChannel->waitAll();
       this->LinearSOE::solve();
+    }
 
     // receive X,B and result
-    theChannel->recvVector(0, 0, *vectX);
-    theChannel->recvVector(0, 0, *vectB);
-    theChannel->recvID(0, 0, result);
+    theChannel->irecvVector(0, 0, *vectX);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->irecvID(0, 0, result);
+    theChannel->waitAll();
     factored = true;
   } 
 
@@ -537,13 +586,12 @@ DistributedSparseGenColLinSOE::solve(void)
     // add P0 contribution to B
     *vectB = *myVectB;
 
-    // receive X and A contribution from subprocess & add them in
-    for (int j=0; j<numChannels; j++) {
+    // post the receives of the B contributions, they come in while A is added
+    this->postRecvB();
 
-      // get X & add
+    // receive A contribution from subprocess & add them in
+    for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, *vectX);
-      *vectB += *vectX;
 
       if (factored == false) {
 	Vector vectA(workArea, nnz);
@@ -568,18 +616,21 @@ DistributedSparseGenColLinSOE::solve(void)
       */
     }
 
+    this->addRemoteB();
 
     // solve
     result(0) = this->LinearSOE::solve();
 
-    // send results back
+    // send results back to all at once
     for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectX);
-      theChannel->sendVector(0, 0, *vectB);
+      theChannel->isendVector(0, 0, *vectX);
+      theChannel->isendVector(0, 0, *vectB);
 
-      theChannel->sendID(0, 0, result);      
+      theChannel->isendID(0, 0, result);      
     }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
   
   return result(0);
@@ -594,8 +645,9 @@ DistributedSparseGenColLinSOE::getB(void)
     Channel *theChannel = theChannels[0];
 
     // send B & recv merged B
-    theChannel->sendVector(0, 0, *myVectB);
-    theChannel->recvVector(0, 0, *vectB);
+    theChannel->isendVector(0, 0, *myVectB);
+    theChannel->irecvVector(0, 0, *vectB);
+    theChannel->waitAll();
   } 
 
   //
@@ -606,21 +658,15 @@ DistributedSparseGenColLinSOE::getB(void)
 
     *vectB = *myVectB;
 
-    Vector remoteB(workArea, size);    
-    // receive X and A contribution from subprocess & add them in
-
-    for (int j=0; j<numChannels; j++) {
-
-      Channel *theChannel = theChannels[j];
-      theChannel->recvVector(0, 0, remoteB);
-      *vectB += remoteB;
-    }
+    // receive B contribution from subprocess & add them in
+    this->postRecvB();
+    this->addRemoteB();
   
     // send results back
-    for (int j=0; j<numChannels; j++) {
-      Channel *theChannel = theChannels[j];
-      theChannel->sendVector(0, 0, *vectB);
-    }
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->isendVector(0, 0, *vectB);
+    for (int j=0; j<numChannels; j++)
+      theChannels[j]->waitAll();
   } 
 
   return *vectB;
@@ -54,9 +54,13 @@ class DistributedSparseGenColLinSOE : public SparseGenColLinSOE
     int addB(const Vector &, const ID &, double fact = 1.0);    
     int setB(const Vector &, double fact = 1.0);            
     const Vector &getB(void);
+    bool isAddConcurrent(void) {return false;};
     void zeroB(void);
     int solve(void);
 
+    // the columns are solved one at a time through solve()
+    int solveMultiple(const Matrix &B, Matrix &X);
+
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
@@ -70,6 +74,9 @@ class DistributedSparseGenColLinSOE : public SparseGenColLinSOE
   protected:
     
   private:
+    int postRecvB(void);
+    int addRemoteB(void);
+
     int processID;
     int numChannels;
     Channel **theChannels;
@@ -79,6 +86,8 @@ class DistributedSparseGenColLinSOE : public SparseGenColLinSOE
     int sizeWork;
     double *myB;
     Vector *myVectB;
+    double *remoteB;     // B contributions of the subprocesses, on P0
+    int sizeRemoteB;
 };
 
 
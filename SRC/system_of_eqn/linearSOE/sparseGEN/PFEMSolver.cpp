@@ -41,10 +41,30 @@ void* OPS_PFEMSolver()
 }
 
 PFEMSolver::PFEMSolver()
-    :LinearSOESolver(SOLVER_TAGS_PFEMSolver), theSOE(0), Msym(0), Mnum(0)
+    :LinearSOESolver(SOLVER_TAGS_PFEMSolver), theSOE(0), Msym(0), Mnum(0), Ssym(0)
 {
 }
 
+// true if A has the pattern saved in p and i, else A's pattern is saved
+static bool
+samePattern(const cs* A, std::vector<int>& p, std::vector<int>& i)
+{
+    int n = A->n;
+    int nnz = A->p[n];
+    bool same = (int)p.size() == n+1 && (int)i.size() == nnz;
+    for(int k=0; same && k<=n; k++) {
+        same = p[k] == A->p[k];
+    }
+    for(int k=0; same && k<nnz; k++) {
+        same = i[k] == A->i[k];
+    }
+    if(!same) {
+        p.assign(A->p, A->p+n+1);
+        i.assign(A->i, A->i+nnz);
+    }
+    return same;
+}
+
 PFEMSolver::~PFEMSolver()
 {
     if(Msym != 0) {
@@ -53,6 +73,9 @@ PFEMSolver::~PFEMSolver()
     if(Mnum != 0) {
         cs_nfree(Mnum);
     }
+    if(Ssym != 0) {
+        cs_sfree(Ssym);
+    }
 }
 
 int
@@ -243,7 +266,9 @@ PFEMSolver::solve()
             S = L;
 
             // solve
-            cs_lusol(3, S, deltaP_ptr, 1e-6);  
+            if(solveS(S, deltaP_ptr) < 0) {
+                return -1;
+            }
 
         } else {
             cs* S1 = cs_add(S, L, 1.0, 1.0);
@@ -251,8 +276,11 @@ PFEMSolver::solve()
             S = S1;
 
             // solve
-            cs_lusol(3, S, deltaP_ptr, 1e-6);  
+            int res = solveS(S, deltaP_ptr);
             cs_spfree(S);
+            if(res < 0) {
+                return -1;
+            }
         }
     }
 
@@ -353,10 +381,50 @@ PFEMSolver::solve()
     return 0;
 }
 
+// same as cs_lusol(3,S,b,1e-6), but the symbolic analysis of S is only
+// redone when its pattern has changed since the last solve
+int
+PFEMSolver::solveS(cs* S, double* b)
+{
+    if(Ssym == 0 || !samePattern(S, Sp, Si)) {
+        if(Ssym != 0) {
+            cs_sfree(Ssym);
+        }
+        Ssym = cs_sqr(3, S, 0);
+        if(Ssym == 0) {
+            Sp.clear();
+            opserr<<"WARNING: failed to do symbolic analysis of S";
+            opserr<<" -- PFEMSolver::solve\n";
+            return -1;
+        }
+    }
+
+    csn* Snum = cs_lu(S, Ssym, 1e-6);
+    if(Snum == 0) {
+        opserr<<"WARNING: failed to do LU factorization of S";
+        opserr<<" -- PFEMSolver::solve\n";
+        return -1;
+    }
+
+    int n = S->n;
+    std::vector<double> x(n);
+    cs_ipvec(Snum->pinv, b, &x[0], n);
+    cs_lsolve(Snum->L, &x[0]);
+    cs_usolve(Snum->U, &x[0]);
+    cs_ipvec(Ssym->q, &x[0], b, n);
+    cs_nfree(Snum);
+
+    return 0;
+}
+
 int PFEMSolver::setSize()
 {
     cs* M = theSOE->M;
     if(M->n > 0) {
+        bool same = samePattern(M, Mp, Mi);
+        if(Msym != 0 && same) {
+            return 0;
+        }
         if(Msym != 0) {
             cs_sfree(Msym);
             Msym = 0;
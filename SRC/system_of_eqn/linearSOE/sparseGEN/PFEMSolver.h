@@ -39,6 +39,7 @@
 // What: "@(#) PFEMSolver.h, revA"
 
 #include <LinearSOESolver.h>
+#include <vector>
 extern "C" {
 #include <cs.h>
 }
@@ -59,10 +60,17 @@ public:
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);  
 
 private:
+
+    int solveS(cs* S, double* b);
     
     PFEMLinSOE* theSOE;
     css* Msym;
     csn* Mnum;
+
+    // the symbolic analyses are kept while the patterns of M and of
+    // the pressure matrix S do not change
+    css* Ssym;
+    std::vector<int> Mp, Mi, Sp, Si;
 };
 
 #endif
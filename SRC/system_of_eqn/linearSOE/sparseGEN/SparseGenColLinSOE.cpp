@@ -291,6 +291,11 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
       }
     }
 
+
+    // build the locations in A of the entries of the FE_Elements & DOF_Groups
+    theScatterMap.clear();
+    if (theModel != 0 && size != 0)
+      theScatterMap.build(*theModel, size, colStartA, rowA);
     
     // invoke setSize() on the Solver    
     LinearSOESolver *the_Solver = this->getSolver();
@@ -319,6 +324,13 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	opserr << " - Matrix and ID not of similar sizes\n";
 	return -1;
     }
+
+    // if the locations in A are known add directly, loc is column major
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0) {
+      SparseScatterMap::addMatrix(A, loc, m, idSize, fact, true);
+      return 0;
+    }
     
     if (fact == 1.0) { // do not need to multiply 
       for (int i=0; i<idSize; i++) {
@@ -482,6 +494,14 @@ SparseGenColLinSOE::getB(void)
     return *vectB;
 }
 
+// A, B & X, the factors are kept by the solver
+size_t
+SparseGenColLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + (Asize + size+1)*sizeof(int)
+	+ 2*sizeof(Vector);
+}
+
 double 
 SparseGenColLinSOE::normRHS(void)
 {
@@ -526,3 +546,22 @@ SparseGenColLinSOE::recvSelf(int cTag, Channel &theChannel,
     return 0;
 }
 
+
+int
+SparseGenColLinSOE::solveMultiple(const Matrix &Bm, Matrix &Xm)
+{
+    int numRHS = Bm.noCols();
+    if (Bm.noRows() != size) {
+	opserr << "WARNING SparseGenColLinSOE::solveMultiple() - B has " << Bm.noRows();
+	opserr << " rows, the system " << size << " equations\n";
+	return -1;
+    }
+
+    // the columns are solved in place in X
+    Xm = Bm;
+    if (size == 0 || numRHS == 0)
+	return 0;
+
+    SparseGenColLinSolver *theSolvr = (SparseGenColLinSolver *)this->getSolver();
+    return theSolvr->solveMultiple(numRHS, &Xm(0,0));
+}
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <SparseScatterMap.h>
 
 class SparseGenColLinSolver;
 
@@ -65,6 +66,10 @@ class SparseGenColLinSOE : public LinearSOE
     virtual const Vector &getX(void);
     virtual const Vector &getB(void);    
     virtual double normRHS(void);
+    virtual size_t getMemoryUsage(void);
+    virtual bool isAddConcurrent(void) {return true;};
+
+    virtual int solveMultiple(const Matrix &B, Matrix &X);
 
     virtual void setX(int loc, double value);        
     virtual void setX(const Vector &x);        
@@ -96,6 +101,7 @@ class SparseGenColLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    SparseScatterMap theScatterMap; // locations in A of the FE & DOF entries
     
   private:
 
@@ -35,6 +35,7 @@
 
 #include <SparseGenColLinSolver.h>
 #include <SparseGenColLinSOE.h>
+#include <Vector.h>
 
 SparseGenColLinSolver::SparseGenColLinSolver(int theClassTag)    
 :LinearSOESolver(theClassTag),
@@ -56,6 +57,29 @@ SparseGenColLinSolver::setLinearSOE(SparseGenColLinSOE &theSparseGenColSOE)
 }
 
 
+int
+SparseGenColLinSolver::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseGenColLinSolver::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->getNumEqn();
+    for (int j=0; j<numRHS; j++) {
+	Vector col(BX + (long)j*n, n);
+	theSOE->setB(col);
+	int res = this->solve();
+	if (res < 0)
+	    return res;
+	col = theSOE->getX();
+    }
+
+    return 0;
+}
+
+
 
 
 
@@ -50,6 +50,10 @@ class SparseGenColLinSolver : public LinearSOESolver
     virtual ~SparseGenColLinSolver();
 
     virtual int setLinearSOE(SparseGenColLinSOE &theSOE);
+
+    // solves for the numRHS columns (of size n, one after the other) in
+    // BX, which are replaced by the solutions; by default one at a time
+    virtual int solveMultiple(int numRHS, double *BX);
     
   protected:
     SparseGenColLinSOE *theSOE;
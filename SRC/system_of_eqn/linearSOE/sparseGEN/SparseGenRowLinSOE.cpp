@@ -255,6 +255,11 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
       }
     }
 
+    // build the locations in A of the entries of the FE_Elements & DOF_Groups
+    theScatterMap.clear();
+    if (theModel != 0 && size != 0)
+      theScatterMap.build(*theModel, size, rowStartA, colA);
+
     // invoke setSize() on the Solver   
      LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -281,6 +286,13 @@ SparseGenRowLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	opserr << " - Matrix and ID not of similar sizes\n";
 	return -1;
     }
+
+    // if the locations in A are known add directly, loc is row major
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0) {
+	SparseScatterMap::addMatrix(A, loc, m, idSize, fact, false);
+	return 0;
+    }
     
     if (fact == 1.0) { // do not need to multiply 
 	for (int i=0; i<idSize; i++) {
@@ -444,6 +456,14 @@ SparseGenRowLinSOE::getB(void)
     return *vectB;
 }
 
+// A, B & X, the factors are kept by the solver
+size_t
+SparseGenRowLinSOE::getMemoryUsage(void)
+{
+    return (Asize + 2*Bsize)*sizeof(double) + (Asize + size+1)*sizeof(int)
+	+ 2*sizeof(Vector);
+}
+
 double 
 SparseGenRowLinSOE::normRHS(void)
 {
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <SparseScatterMap.h>
 
 class SparseGenRowLinSolver;
 
@@ -60,6 +61,7 @@ class SparseGenRowLinSOE : public LinearSOE
     const Vector &getX(void);
     const Vector &getB(void);    
     double normRHS(void);
+    size_t getMemoryUsage(void);
 
     void setX(int loc, double value);        
     void setX(const Vector &x);        
@@ -71,6 +73,8 @@ class SparseGenRowLinSOE : public LinearSOE
     friend class CulaSparseSolverS4;    
     friend class CulaSparseSolverS5;    
 	friend class CuSPSolver;
+    friend class CuDSSSolver;
+    friend class SparseKrylovSolver;
 
   protected:
     
@@ -83,6 +87,7 @@ class SparseGenRowLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    SparseScatterMap theScatterMap; // locations in A of the FE & DOF entries
 };
 
 
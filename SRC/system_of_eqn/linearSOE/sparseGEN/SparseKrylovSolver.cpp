@@ -0,0 +1,731 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of SparseKrylovSolver.
+
+#include <SparseKrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <elementAPI.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef _WIN32
+extern "C" int DGETRF(int *M, int *N, double *A, int *LDA, int *iPiv, int *INFO);
+
+extern "C" int DGETRS(char *TRANS, int *N, int *NRHS, double *A, int *LDA,
+		      int *iPiv, double *B, int *LDB, int *INFO);
+#else
+extern "C" int dgetrf_(int *M, int *N, double *A, int *LDA, int *iPiv, int *INFO);
+
+extern "C" int dgetrs_(char *TRANS, int *N, int *NRHS, double *A, int *LDA,
+		       int *iPiv, double *B, int *LDB, int *INFO);
+#endif
+
+// parameters of the multigrid hierarchy
+#define AMG_STRENGTH     0.08  // threshold on |a_ij|/sqrt(|a_ii a_jj|),
+                               // halved on each coarser level
+#define AMG_COARSE_SIZE  500   // stop coarsening at this many equations
+#define AMG_MAX_DENSE    4000  // largest coarsest level solved with dense LU
+#define AMG_MAX_LEVELS   20
+#define AMG_COARSE_SWEEPS 10   // sweeps when the coarsest level is not factored
+
+void* OPS_SparseKrylovSolver()
+{
+    // system Krylov <-cg|-gmres|-bicgstab> <-precond none|Jacobi|ILU|AMG>
+    //    <-tol $tol> <-maxIter $maxIter> <-restart $m> <-reuse $ratio>
+    //    <-noWarmStart>
+    int method = SparseKrylovSolver::CG;
+    int precond = SparseKrylovSolver::AMGPrecond;
+    double tol = 1.0e-8;
+    int maxIter = 1000;
+    int restart = 50;
+    double reuseRatio = 2.0;
+    bool warmStart = true;
+
+    int numData = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-cg") == 0 || strcmp(opt, "-CG") == 0) {
+	    method = SparseKrylovSolver::CG;
+	} else if (strcmp(opt, "-gmres") == 0 || strcmp(opt, "-GMRES") == 0) {
+	    method = SparseKrylovSolver::GMRES;
+	} else if (strcmp(opt, "-bicgstab") == 0 || strcmp(opt, "-BiCGStab") == 0) {
+	    method = SparseKrylovSolver::BiCGStab;
+	} else if (strcmp(opt, "-precond") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1) {
+		opserr << "WARNING system Krylov -precond needs a type\n";
+		return 0;
+	    }
+	    const char *type = OPS_GetString();
+	    if (strcmp(type, "none") == 0)
+		precond = SparseKrylovSolver::NoPrecond;
+	    else if (strcmp(type, "Jacobi") == 0 || strcmp(type, "jacobi") == 0)
+		precond = SparseKrylovSolver::JacobiPrecond;
+	    else if (strcmp(type, "ILU") == 0 || strcmp(type, "ILU0") == 0 ||
+		     strcmp(type, "IC") == 0 || strcmp(type, "IC0") == 0)
+		precond = SparseKrylovSolver::ILUPrecond;
+	    else if (strcmp(type, "AMG") == 0 || strcmp(type, "amg") == 0)
+		precond = SparseKrylovSolver::AMGPrecond;
+	    else {
+		opserr << "WARNING system Krylov - unknown preconditioner " << type << endln;
+		return 0;
+	    }
+	} else if (strcmp(opt, "-tol") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &tol) < 0) {
+		opserr << "WARNING system Krylov - invalid -tol value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-maxIter") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &maxIter) < 0) {
+		opserr << "WARNING system Krylov - invalid -maxIter value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-restart") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData, &restart) < 0 ||
+		restart < 1) {
+		opserr << "WARNING system Krylov - invalid -restart value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-reuse") == 0) {
+	    if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetDoubleInput(&numData, &reuseRatio) < 0) {
+		opserr << "WARNING system Krylov - invalid -reuse value\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-noWarmStart") == 0) {
+	    warmStart = false;
+	}
+    }
+
+    SparseKrylovSolver *theSolver =
+	new SparseKrylovSolver(method, precond, tol, maxIter, restart, reuseRatio, warmStart);
+    return new SparseGenRowLinSOE(*theSolver);
+}
+
+
+// locations of the diagonal & its inverse (0 for a zero or missing diagonal)
+static void
+invertDiagonal(int n, const int *rowStart, const int *col, const double *val,
+	       std::vector<double> &invD)
+{
+    invD.assign(n, 0.0);
+    for (int i=0; i<n; i++)
+	for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+	    if (col[k] == i && val[k] != 0.0)
+		invD[i] = 1.0/val[k];
+}
+
+
+// C = A*B with A, B & C in compressed row storage, A having nRowA rows and
+// B nColB columns; the columns in a row of C are in no particular order
+static void
+multiplyCSR(int nRowA, const int *Ap, const int *Aj, const double *Ax,
+	    const int *Bp, const int *Bj, const double *Bx, int nColB,
+	    std::vector<int> &Cp, std::vector<int> &Cj, std::vector<double> &Cx)
+{
+    std::vector<int> marker(nColB, -1);
+    Cp.assign(nRowA+1, 0);
+    Cj.clear();
+    Cx.clear();
+
+    for (int i=0; i<nRowA; i++) {
+	int rowBegin = Cj.size();
+	for (int a=Ap[i]; a<Ap[i+1]; a++) {
+	    int k = Aj[a];
+	    double v = Ax[a];
+	    for (int b=Bp[k]; b<Bp[k+1]; b++) {
+		int c = Bj[b];
+		if (marker[c] < rowBegin) {
+		    marker[c] = Cj.size();
+		    Cj.push_back(c);
+		    Cx.push_back(v*Bx[b]);
+		} else
+		    Cx[marker[c]] += v*Bx[b];
+	    }
+	}
+	Cp[i+1] = Cj.size();
+    }
+}
+
+
+static void
+transposeCSR(int nRow, int nCol, const int *Ap, const int *Aj, const double *Ax,
+	     std::vector<int> &Tp, std::vector<int> &Tj, std::vector<double> &Tx)
+{
+    int nnz = Ap[nRow];
+    Tp.assign(nCol+1, 0);
+    Tj.resize(nnz);
+    Tx.resize(nnz);
+
+    for (int k=0; k<nnz; k++)
+	Tp[Aj[k]+1]++;
+    for (int j=0; j<nCol; j++)
+	Tp[j+1] += Tp[j];
+
+    std::vector<int> next(Tp.begin(), Tp.end()-1);
+    for (int i=0; i<nRow; i++)
+	for (int k=Ap[i]; k<Ap[i+1]; k++) {
+	    int pos = next[Aj[k]]++;
+	    Tj[pos] = i;
+	    Tx[pos] = Ax[k];
+	}
+}
+
+
+// y = A*x for a matrix in compressed row storage
+static void
+multiplyCSR(int n, const int *rowStart, const int *col, const double *val,
+	    const double *x, double *y)
+{
+#pragma omp parallel for
+    for (int i=0; i<n; i++) {
+	double sum = 0.0;
+	for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+	    sum += val[k]*x[col[k]];
+	y[i] = sum;
+    }
+}
+
+
+// one Gauss-Seidel sweep on A x = b, forward or backward
+static void
+gaussSeidel(int n, const int *rowStart, const int *col, const double *val,
+	    const double *invD, const double *b, double *x, bool forward)
+{
+    for (int ii=0; ii<n; ii++) {
+	int i = forward ? ii : n-1-ii;
+	double sum = b[i];
+	double aii = 0.0;
+	for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+	    if (col[k] != i)
+		sum -= val[k]*x[col[k]];
+	    else
+		aii = val[k];
+	}
+	if (aii != 0.0)
+	    x[i] = sum*invD[i];
+    }
+}
+
+
+SparseKrylovSolver::SparseKrylovSolver(int meth, int pre, double tolerance,
+				       int maxIterations, int m,
+				       double ratio, bool warm)
+:SparseGenRowLinSolver(SOLVER_TAGS_SparseKrylovSolver),
+ theIteration(meth, tolerance, maxIterations, m, warm),
+ precond(pre), reuseRatio(ratio),
+ n(0), precondValid(false), rebuild(false), setupIter(0)
+{
+
+}
+
+
+SparseKrylovSolver::~SparseKrylovSolver()
+{
+
+}
+
+
+int
+SparseKrylovSolver::setLinearSOE(SparseGenRowLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseKrylovSolver::setSize(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    n = theSOE->size;
+
+    // the pattern has changed, everything built on the old one goes
+    invDiag.clear();
+    LU.clear();
+    diagLoc.clear();
+    levels.clear();
+    coarseLU.clear();
+    coarsePiv.clear();
+    precondValid = false;
+    rebuild = false;
+    setupIter = 0;
+
+    theIteration.setSize(n);
+
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::setupPrecond(void)
+{
+    precondValid = false;
+
+    const int *rowStart = theSOE->rowStartA;
+    const int *col = theSOE->colA;
+    const double *A = theSOE->A;
+
+    if (precond == JacobiPrecond) {
+
+	invertDiagonal(n, rowStart, col, A, invDiag);
+
+    } else if (precond == ILUPrecond) {
+
+	// incomplete LU with no fill, the rows of A are sorted
+	LU.assign(A, A + rowStart[n]);
+	diagLoc.assign(n, -1);
+	for (int i=0; i<n; i++)
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+		if (col[k] == i)
+		    diagLoc[i] = k;
+
+	std::vector<int> loc(n, -1);
+	for (int i=0; i<n; i++) {
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+		loc[col[k]] = k;
+
+	    for (int k=rowStart[i]; k<rowStart[i+1] && col[k]<i; k++) {
+		int c = col[k];
+		LU[k] /= LU[diagLoc[c]];
+		double lik = LU[k];
+		for (int q=diagLoc[c]+1; q<rowStart[c+1]; q++) {
+		    int pos = loc[col[q]];
+		    if (pos >= 0)
+			LU[pos] -= lik*LU[q];
+		}
+	    }
+
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+		loc[col[k]] = -1;
+
+	    if (diagLoc[i] < 0 || LU[diagLoc[i]] == 0.0) {
+		opserr << "WARNING SparseKrylovSolver::setupPrecond(void)- ";
+		opserr << " zero pivot in ILU(0) at equation " << i << endln;
+		LU.clear();
+		return -1;
+	    }
+	}
+
+    } else if (precond == AMGPrecond) {
+
+	if (this->setupAMG() < 0)
+	    return -1;
+    }
+
+    if (precond != NoPrecond)
+	numNumericFactor++;
+    precondValid = true;
+
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::setupAMG(void)
+{
+    levels.clear();
+    levels.reserve(AMG_MAX_LEVELS);
+    levels.resize(1);
+    coarseLU.clear();
+    coarsePiv.clear();
+
+    levels[0].n = n;
+    levels[0].rowStart = theSOE->rowStartA;
+    levels[0].col = theSOE->colA;
+    levels[0].val = theSOE->A;
+
+    while (true) {
+	Level &L = levels.back();
+	int nf = L.n;
+	const int *rowStart = L.rowStart;
+	const int *col = L.col;
+	const double *val = L.val;
+
+	invertDiagonal(nf, rowStart, col, val, L.invDiag);
+	L.r.resize(nf);
+	if (levels.size() > 1) {
+	    L.b.resize(nf);
+	    L.x.resize(nf);
+	}
+
+	if (nf <= AMG_COARSE_SIZE || (int)levels.size() == AMG_MAX_LEVELS)
+	    break;
+
+	// aggregate the strongly connected equations, j is strongly
+	// connected to i if a_ij^2 >= theta^2 |a_ii a_jj|
+	const std::vector<double> &invD = L.invDiag;
+	double theta = AMG_STRENGTH;
+	for (size_t l=1; l<levels.size(); l++)
+	    theta *= 0.5;
+	const double theta2 = theta*theta;
+	std::vector<int> agg(nf, -1);
+	int nAgg = 0;
+
+	// 1) equations whose strong neighbours are all free make an aggregate
+	for (int i=0; i<nf; i++) {
+	    if (agg[i] >= 0 || invD[i] == 0.0)
+		continue;
+	    bool allFree = true;
+	    int numStrong = 0;
+	    for (int k=rowStart[i]; k<rowStart[i+1] && allFree; k++) {
+		int j = col[k];
+		if (j == i || invD[j] == 0.0)
+		    continue;
+		if (val[k]*val[k]*fabs(invD[i]*invD[j]) >= theta2) {
+		    numStrong++;
+		    if (agg[j] >= 0)
+			allFree = false;
+		}
+	    }
+	    if (allFree == false || numStrong == 0)
+		continue;
+	    agg[i] = nAgg;
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+		int j = col[k];
+		if (j != i && invD[j] != 0.0 &&
+		    val[k]*val[k]*fabs(invD[i]*invD[j]) >= theta2)
+		    agg[j] = nAgg;
+	    }
+	    nAgg++;
+	}
+
+	// 2) the rest join the aggregate they are most strongly connected to
+	std::vector<int> firstAgg(agg);
+	for (int i=0; i<nf; i++) {
+	    if (agg[i] >= 0 || invD[i] == 0.0)
+		continue;
+	    double best = 0.0;
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+		int j = col[k];
+		if (j == i || firstAgg[j] < 0)
+		    continue;
+		double s = val[k]*val[k]*fabs(invD[i]*invD[j]);
+		if (s >= theta2 && s > best) {
+		    best = s;
+		    agg[i] = firstAgg[j];
+		}
+	    }
+	}
+
+	// 3) what is left forms aggregates with its free strong neighbours
+	for (int i=0; i<nf; i++) {
+	    if (agg[i] >= 0)
+		continue;
+	    agg[i] = nAgg;
+	    if (invD[i] != 0.0)
+		for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+		    int j = col[k];
+		    if (j != i && agg[j] < 0 && invD[j] != 0.0 &&
+			val[k]*val[k]*fabs(invD[i]*invD[j]) >= theta2)
+			agg[j] = nAgg;
+		}
+	    nAgg++;
+	}
+
+	// stop if the aggregation no longer coarsens
+	if (10.0*nAgg > 9.0*nf)
+	    break;
+
+	// tentative prolongation, the normalised constant on each aggregate
+	std::vector<double> scale(nAgg, 0.0);
+	for (int i=0; i<nf; i++)
+	    scale[agg[i]] += 1.0;
+	for (int c=0; c<nAgg; c++)
+	    scale[c] = 1.0/sqrt(scale[c]);
+
+	// the prolongation is smoothed with the filtered matrix, in which the
+	// weak connections are added to the diagonal; this keeps P as sparse
+	// as the aggregates and A_F the same as A on the constant
+	std::vector<double> diagF(nf, 0.0);
+	double rho = 0.0;
+	for (int i=0; i<nf; i++) {
+	    if (invD[i] == 0.0)
+		continue;
+	    double dF = 0.0;
+	    double sum = 0.0;
+	    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+		int j = col[k];
+		if (j == i || invD[j] == 0.0 ||
+		    val[k]*val[k]*fabs(invD[i]*invD[j]) < theta2)
+		    dF += val[k];
+		else
+		    sum += fabs(val[k]);
+	    }
+	    diagF[i] = dF;
+	    // Gershgorin bound on the spectral radius of D^-1 A_F
+	    sum = (sum + fabs(dF))*fabs(invD[i]);
+	    if (sum > rho)
+		rho = sum;
+	}
+	double omega = (rho > 0.0) ? 4.0/(3.0*rho) : 0.0;
+
+	// P = (I - omega D^-1 A_F) T
+	std::vector<int> marker(nAgg, -1);
+	L.Pp.assign(nf+1, 0);
+	L.Pj.clear();
+	L.Px.clear();
+	for (int i=0; i<nf; i++) {
+	    int rowBegin = L.Pj.size();
+	    double w = omega*invD[i];
+	    int ci = agg[i];
+	    marker[ci] = L.Pj.size();
+	    L.Pj.push_back(ci);
+	    L.Px.push_back((1.0 - w*diagF[i])*scale[ci]);
+
+	    if (w != 0.0)
+		for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+		    int j = col[k];
+		    if (j == i || invD[j] == 0.0 ||
+			val[k]*val[k]*fabs(invD[i]*invD[j]) < theta2)
+			continue;
+		    int c = agg[j];
+		    double v = -w*val[k]*scale[c];
+		    if (marker[c] < rowBegin) {
+			marker[c] = L.Pj.size();
+			L.Pj.push_back(c);
+			L.Px.push_back(v);
+		    } else
+			L.Px[marker[c]] += v;
+		}
+	    L.Pp[i+1] = L.Pj.size();
+	}
+
+	transposeCSR(nf, nAgg, &L.Pp[0], &L.Pj[0], &L.Px[0], L.Rp, L.Rj, L.Rx);
+
+	// Galerkin coarse matrix R A P
+	std::vector<int> APp, APj;
+	std::vector<double> APx;
+	multiplyCSR(nf, rowStart, col, val, &L.Pp[0], &L.Pj[0], &L.Px[0], nAgg,
+		    APp, APj, APx);
+
+	levels.push_back(Level());
+	Level &R = levels[levels.size()-2];
+	Level &C = levels.back();
+	multiplyCSR(nAgg, &R.Rp[0], &R.Rj[0], &R.Rx[0], &APp[0], &APj[0], &APx[0],
+		    nAgg, C.ownRowStart, C.ownCol, C.ownVal);
+	C.n = nAgg;
+	C.rowStart = &C.ownRowStart[0];
+	C.col = &C.ownCol[0];
+	C.val = &C.ownVal[0];
+    }
+
+    // factor the coarsest level if it is small enough
+    Level &C = levels.back();
+    int nc = C.n;
+    if (nc <= AMG_MAX_DENSE) {
+	coarseLU.assign((size_t)nc*nc, 0.0);
+	coarsePiv.resize(nc);
+	for (int i=0; i<nc; i++)
+	    for (int k=C.rowStart[i]; k<C.rowStart[i+1]; k++)
+		coarseLU[i + (size_t)C.col[k]*nc] += C.val[k];
+
+	int info = 0;
+#ifdef _WIN32
+	DGETRF(&nc, &nc, &coarseLU[0], &nc, &coarsePiv[0], &info);
+#else
+	dgetrf_(&nc, &nc, &coarseLU[0], &nc, &coarsePiv[0], &info);
+#endif
+	if (info != 0) {
+	    opserr << "WARNING SparseKrylovSolver::setupAMG(void)- ";
+	    opserr << " coarsest level of " << nc << " equations is singular\n";
+	    coarseLU.clear();
+	    levels.clear();
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+
+void
+SparseKrylovSolver::vcycle(int lev, const double *b, double *x)
+{
+    Level &L = levels[lev];
+    int nl = L.n;
+
+    if (lev == (int)levels.size()-1) {
+	if (coarseLU.empty() == false) {
+	    for (int i=0; i<nl; i++)
+		x[i] = b[i];
+	    char trans[] = "N";
+	    int nrhs = 1;
+	    int info = 0;
+#ifdef _WIN32
+	    DGETRS(trans, &nl, &nrhs, &coarseLU[0], &nl, &coarsePiv[0], x, &nl, &info);
+#else
+	    dgetrs_(trans, &nl, &nrhs, &coarseLU[0], &nl, &coarsePiv[0], x, &nl, &info);
+#endif
+	} else {
+	    for (int i=0; i<nl; i++)
+		x[i] = 0.0;
+	    for (int s=0; s<AMG_COARSE_SWEEPS; s++) {
+		gaussSeidel(nl, L.rowStart, L.col, L.val, &L.invDiag[0], b, x, true);
+		gaussSeidel(nl, L.rowStart, L.col, L.val, &L.invDiag[0], b, x, false);
+	    }
+	}
+	return;
+    }
+
+    // forward sweep before and backward sweep after the coarse correction
+    // so that the cycle is symmetric for a symmetric A
+    for (int i=0; i<nl; i++)
+	x[i] = 0.0;
+    gaussSeidel(nl, L.rowStart, L.col, L.val, &L.invDiag[0], b, x, true);
+
+    double *r = &L.r[0];
+    multiplyCSR(nl, L.rowStart, L.col, L.val, x, r);
+    for (int i=0; i<nl; i++)
+	r[i] = b[i] - r[i];
+
+    Level &C = levels[lev+1];
+    multiplyCSR(C.n, &L.Rp[0], &L.Rj[0], &L.Rx[0], r, &C.b[0]);
+    this->vcycle(lev+1, &C.b[0], &C.x[0]);
+
+    const double *xc = &C.x[0];
+    for (int i=0; i<nl; i++)
+	for (int k=L.Pp[i]; k<L.Pp[i+1]; k++)
+	    x[i] += L.Px[k]*xc[L.Pj[k]];
+
+    gaussSeidel(nl, L.rowStart, L.col, L.val, &L.invDiag[0], b, x, false);
+}
+
+
+void
+SparseKrylovSolver::precondition(const double *r, double *z)
+{
+    if (precond == JacobiPrecond) {
+	for (int i=0; i<n; i++)
+	    z[i] = invDiag[i]*r[i];
+
+    } else if (precond == ILUPrecond) {
+	const int *rowStart = theSOE->rowStartA;
+	const int *col = theSOE->colA;
+
+	for (int i=0; i<n; i++) {
+	    double sum = r[i];
+	    for (int k=rowStart[i]; k<diagLoc[i]; k++)
+		sum -= LU[k]*z[col[k]];
+	    z[i] = sum;
+	}
+	for (int i=n-1; i>=0; i--) {
+	    double sum = z[i];
+	    for (int k=diagLoc[i]+1; k<rowStart[i+1]; k++)
+		sum -= LU[k]*z[col[k]];
+	    z[i] = sum/LU[diagLoc[i]];
+	}
+
+    } else if (precond == AMGPrecond) {
+	this->vcycle(0, r, z);
+
+    } else {
+	for (int i=0; i<n; i++)
+	    z[i] = r[i];
+    }
+}
+
+
+int
+SparseKrylovSolver::multiply(const double *x, double *y)
+{
+    multiplyCSR(n, theSOE->rowStartA, theSOE->colA, theSOE->A, x, y);
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseKrylovSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (theSOE->size == 0)
+	return 0;
+
+    if (n != theSOE->size) {
+	opserr << "WARNING SparseKrylovSolver::solve(void)- ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    double *x = theSOE->X;
+    const double *b = theSOE->B;
+
+    // a new A keeps the old preconditioner unless it has been flagged
+    bool fresh = false;
+    if (theSOE->factored == false) {
+	if (precondValid == false || rebuild == true || reuseRatio <= 0.0) {
+	    if (this->setupPrecond() < 0)
+		return -1;
+	    fresh = true;
+	}
+	theSOE->factored = true;
+    }
+
+    int numIter = theIteration.solve(*this, x, b);
+
+    // an old preconditioner that no longer does gets one more chance
+    if (numIter < 0 && fresh == false && precond != NoPrecond) {
+	if (this->setupPrecond() < 0)
+	    return -1;
+	fresh = true;
+	numIter = theIteration.solve(*this, x, b);
+    }
+
+    if (numIter < 0) {
+	opserr << "WARNING SparseKrylovSolver::solve(void)- ";
+	opserr << " failed to converge in " << theIteration.getMaxIter() << " iterations\n";
+	return -1;
+    }
+
+    if (fresh) {
+	setupIter = numIter;
+	rebuild = false;
+    } else if (numIter > reuseRatio*(setupIter > 0 ? setupIter : 1)) {
+	rebuild = true;
+    }
+
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+SparseKrylovSolver::recvSelf(int cTag, Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SparseKrylovSolver_h
+#define SparseKrylovSolver_h
+
+// Description: This file contains the class definition for
+// SparseKrylovSolver. SparseKrylovSolver solves a SparseGenRowLinSOE with
+// a preconditioned Krylov method: conjugate gradients for symmetric
+// positive definite systems, restarted GMRES or BiCGStab for general ones.
+// The preconditioner is Jacobi, ILU(0) (which for a symmetric matrix is the
+// incomplete Cholesky factorization) or a smoothed aggregation algebraic
+// multigrid V-cycle. The iterations are those of KrylovIteration and
+// start from the previous solution when that is a better guess than zero.
+// Once built, the preconditioner is kept
+// when A changes and is only rebuilt when a solve needs more than
+// reuseRatio times the iterations it took when it was fresh, or fails.
+//
+// What: "@(#) SparseKrylovSolver.h, revA"
+
+#include <SparseGenRowLinSolver.h>
+#include <KrylovIteration.h>
+#include <vector>
+
+class SparseKrylovSolver : public SparseGenRowLinSolver, public KrylovOperator
+{
+  public:
+    enum { CG = KrylovIteration::CG, GMRES = KrylovIteration::GMRES,
+	   BiCGStab = KrylovIteration::BiCGStab };
+    enum { NoPrecond = 0, JacobiPrecond = 1, ILUPrecond = 2, AMGPrecond = 3 };
+
+    SparseKrylovSolver(int method = CG, int precond = AMGPrecond,
+		       double tol = 1.0e-8, int maxIter = 1000,
+		       int restart = 50, double reuseRatio = 2.0,
+		       bool warmStart = true);
+    ~SparseKrylovSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(SparseGenRowLinSOE &theSOE);
+
+    int multiply(const double *x, double *y);
+    void precondition(const double *r, double *z);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    // one level of the multigrid hierarchy, level 0 uses the arrays of
+    // the SOE; P is the prolongation from the next coarser level, R = P'
+    struct Level {
+	int n;
+	const int *rowStart, *col;
+	const double *val;
+	std::vector<int> ownRowStart, ownCol;
+	std::vector<double> ownVal;
+	std::vector<double> invDiag;
+	std::vector<int> Pp, Pj, Rp, Rj;
+	std::vector<double> Px, Rx;
+	std::vector<double> b, x, r;
+    };
+
+    int setupPrecond(void);
+    int setupAMG(void);
+    void vcycle(int lev, const double *b, double *x);
+
+    KrylovIteration theIteration;
+
+    int precond;
+    double reuseRatio;
+
+    int n;
+    bool precondValid;    // a preconditioner has been built since setSize()
+    bool rebuild;         // the preconditioner is to be rebuilt for the next A
+    int setupIter;        // iterations of the first solve with the current one
+
+    std::vector<double> invDiag;          // Jacobi
+    std::vector<double> LU;               // ILU(0) factors in the pattern of A
+    std::vector<int> diagLoc;             // location of the diagonal in each row
+    std::vector<Level> levels;            // AMG
+    std::vector<double> coarseLU;         // dense LU of the coarsest level,
+                                          // empty if it is smoothed instead
+    std::vector<int> coarsePiv;
+};
+
+#endif
@@ -231,33 +231,10 @@ SuperLU::solve(void)
     for (int i=0; i<n; i++)
 	*(Xptr++) = *(Bptr++);
 
-    GlobalLU_t Glu; /* Not needed on return. */
-
     if (theSOE->factored == false) {
-	// factor the matrix
-	int info;
-
-	if (L.ncol != 0 && symmetric == 'N') {
-	  Destroy_SuperNode_Matrix(&L);
-	  Destroy_CompCol_Matrix(&U);	  
-	}
-
-	dgstrf(&options, &AC, relax, panelSize,
-	       etree, NULL, 0, perm_c, perm_r, &L, &U, &Glu, &stat, &info);
-
-
-	if (info != 0) {	
-	  opserr << "WARNING SuperLU::solve(void)- ";
-	  opserr << " Error " << info << " returned in factorization dgstrf()\n";
-	  return -info;
-	}
-
-	if (symmetric == 'Y')
-	  options.Fact= SamePattern_SameRowPerm;
-	else
-	  options.Fact = SamePattern;
-	
-	theSOE->factored = true;
+	int res = this->factor();
+	if (res < 0)
+	    return res;
     }	
 
     // do forward and backward substitution
@@ -277,6 +254,83 @@ SuperLU::solve(void)
 
 
 
+// the numRHS columns are substituted with one call, in place in BX
+int
+SuperLU::solveMultiple(int numRHS, double *BX)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SuperLU::solveMultiple()- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+    if (n == 0 || numRHS == 0)
+	return 0;
+
+    if (sizePerm == 0) {
+	opserr << "WARNING SuperLU::solveMultiple()- ";
+	opserr << " size for row and col permutations 0 - has setSize() been called?\n";
+	return -1;
+    }
+
+    if (theSOE->factored == false) {
+	int res = this->factor();
+	if (res < 0)
+	    return res;
+    }
+
+    SuperMatrix BX_;
+    dCreate_Dense_Matrix(&BX_, n, numRHS, BX, n, SLU_DN, SLU_D, SLU_GE);
+
+    trans_t trans = NOTRANS;
+    int info;
+    dgstrs (trans, &L, &U, perm_c, perm_r, &BX_, &stat, &info);
+    Destroy_SuperMatrix_Store(&BX_);
+
+    if (info != 0) {
+       opserr << "WARNING SuperLU::solveMultiple()- ";
+       opserr << " Error " << info << " returned in substitution dgstrs()\n";
+       return -info;
+    }
+
+    return 0;
+}
+
+
+// factors the matrix, reusing the pattern of an earlier factorization
+int
+SuperLU::factor(void)
+{
+    GlobalLU_t Glu; /* Not needed on return. */
+    int info;
+
+    if (L.ncol != 0 && symmetric == 'N') {
+      Destroy_SuperNode_Matrix(&L);
+      Destroy_CompCol_Matrix(&U);	  
+    }
+
+    dgstrf(&options, &AC, relax, panelSize,
+	   etree, NULL, 0, perm_c, perm_r, &L, &U, &Glu, &stat, &info);
+
+    if (info != 0) {	
+      opserr << "WARNING SuperLU::solve(void)- ";
+      opserr << " Error " << info << " returned in factorization dgstrf()\n";
+      return -info;
+    }
+    numNumericFactor++;
+
+    if (symmetric == 'Y')
+      options.Fact= SamePattern_SameRowPerm;
+    else
+      options.Fact = SamePattern;
+
+    theSOE->factored = true;
+
+    return 0;
+}
+
+
 int
 SuperLU::setSize()
 {
@@ -316,10 +370,12 @@ SuperLU::setSize()
 			     theSOE->rowA, theSOE->colStartA, 
 			     SLU_NC, SLU_D, SLU_GE);
 
-      // obtain and apply column permutation to give SuperMatrix AC
-      get_perm_c(permSpec, &A, perm_c);
+      // obtain and apply column permutation to give SuperMatrix AC,
+      // the natural order if the equations are already ordered
+      get_perm_c(equationsOrdered ? 0 : permSpec, &A, perm_c);
 
       sp_preorder(&options, &A, perm_c, etree, &AC);
+      numSymbolicFactor++;
 
       // create the rhs SuperMatrix B 
       dCreate_Dense_Matrix(&B, n, 1, theSOE->X, n, SLU_DN, SLU_D, SLU_GE);
@@ -342,6 +398,25 @@ SuperLU::setSize()
     return 0;
 }
 
+// the supernodal L stores its values with a row index per supernode row,
+// U (the part outside the supernodes) a row index per value
+size_t
+SuperLU::getMemoryUsage(void)
+{
+    size_t result = 3*sizePerm*sizeof(int);
+
+    if (L.ncol != 0 && L.Store != 0) {
+	SCformat *Lstore = (SCformat *)L.Store;
+	result += Lstore->nnz*sizeof(double) + (L.ncol+1)*3*sizeof(int);
+    }
+    if (U.ncol != 0 && U.Store != 0) {
+	NCformat *Ustore = (NCformat *)U.Store;
+	result += Ustore->nnz*(sizeof(double) + sizeof(int)) + (U.ncol+1)*sizeof(int);
+    }
+
+    return result;
+}
+
 int
 SuperLU::sendSelf(int cTag, Channel &theChannel)
 {
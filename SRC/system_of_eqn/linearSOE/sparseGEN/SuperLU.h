@@ -59,7 +59,9 @@ class SuperLU : public SparseGenColLinSolver
     ~SuperLU();
 
     int solve(void);
+    int solveMultiple(int numRHS, double *BX);
     int setSize(void);
+    size_t getMemoryUsage(void);
 
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
@@ -67,6 +69,8 @@ class SuperLU : public SparseGenColLinSolver
   protected:
 
   private:
+    int factor(void);
+
     SuperMatrix A,L,U,B,AC;
     int *perm_r;
     int *perm_c;
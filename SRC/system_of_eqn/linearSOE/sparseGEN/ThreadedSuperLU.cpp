@@ -180,8 +180,9 @@ ThreadedSuperLU::setSize()
 			     theSOE->rowA, theSOE->colStartA, 
 			     NC, _D, GE);
 
-      // obtain and apply column permutation to give SuperMatrixMT AC
-      get_perm_c(permSpec, &A, perm_c);
+      // obtain and apply column permutation to give SuperMatrixMT AC,
+      // the natural order if the equations are already ordered
+      get_perm_c(equationsOrdered ? 0 : permSpec, &A, perm_c);
       //      sp_preorder(refact, &A, perm_c, etree, &AC);
 
       // create the rhs SuperMatrixMT B 
@@ -0,0 +1,415 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for SparseSPDLinSOE
+
+#include <stdlib.h>
+#include <SparseSPDLinSOE.h>
+#include <SparseSPDLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <math.h>
+#include <algorithm>
+
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <iostream>
+using std::nothrow;
+
+SparseSPDLinSOE::SparseSPDLinSOE(SparseSPDLinSolver &the_Solver)
+:LinearSOE(the_Solver, LinSOE_TAGS_SparseSPDLinSOE),
+ size(0), nnz(0), A(0), B(0), X(0), rowA(0), colStartA(0),
+ vectX(0), vectB(0),
+ Asize(0), Bsize(0),
+ factored(false)
+{
+    the_Solver.setLinearSOE(*this);
+}
+
+
+SparseSPDLinSOE::~SparseSPDLinSOE()
+{
+    if (A != 0) delete [] A;
+    if (B != 0) delete [] B;
+    if (X != 0) delete [] X;
+    if (colStartA != 0) delete [] colStartA;
+    if (rowA != 0) delete [] rowA;
+    if (vectX != 0) delete vectX;
+    if (vectB != 0) delete vectB;
+}
+
+
+int
+SparseSPDLinSOE::getNumEqn(void) const
+{
+    return size;
+}
+
+
+int
+SparseSPDLinSOE::setSize(Graph &theGraph)
+{
+    int result = 0;
+    int oldSize = size;
+    size = theGraph.getNumVertex();
+
+    // first iterate through the vertices of the graph to get nnz,
+    // only the diagonal and the rows below it are stored
+    Vertex *theVertex;
+    int newNNZ = 0;
+    VertexIter &theVertices = theGraph.getVertices();
+    while ((theVertex = theVertices()) != 0) {
+	int col = theVertex->getTag();
+	const ID &theAdjacency = theVertex->getAdjacency();
+	newNNZ++;
+	for (int i=0; i<theAdjacency.Size(); i++)
+	    if (theAdjacency(i) > col)
+		newNNZ++;
+    }
+    nnz = newNNZ;
+
+    if (newNNZ > Asize) { // we have to get more space for A and rowA
+	if (A != 0)
+	    delete [] A;
+	if (rowA != 0)
+	    delete [] rowA;
+
+	A = new (nothrow) double[newNNZ];
+	rowA = new (nothrow) int[newNNZ];
+
+	if (A == 0 || rowA == 0) {
+	    opserr << "WARNING SparseSPDLinSOE::setSize :";
+	    opserr << " ran out of memory for A and rowA with nnz = ";
+	    opserr << newNNZ << " \n";
+	    size = 0; Asize = 0; nnz = 0;
+	    return -1;
+	}
+
+	Asize = newNNZ;
+    }
+
+    // zero the matrix
+    for (int i=0; i<Asize; i++)
+	A[i] = 0;
+
+    factored = false;
+
+    if (size > Bsize) { // we have to get space for the vectors
+
+	// delete the old
+	if (B != 0) delete [] B;
+	if (X != 0) delete [] X;
+	if (colStartA != 0) delete [] colStartA;
+
+	// create the new
+	B = new (nothrow) double[size];
+	X = new (nothrow) double[size];
+	colStartA = new (nothrow) int[size+1];
+
+	if (B == 0 || X == 0 || colStartA == 0) {
+	    opserr << "WARNING SparseSPDLinSOE::setSize :";
+	    opserr << " ran out of memory for vectors (size) (";
+	    opserr << size << ") \n";
+	    size = 0; Bsize = 0;
+	    return -1;
+	}
+	else
+	    Bsize = size;
+    }
+
+    // zero the vectors
+    for (int j=0; j<size; j++) {
+	B[j] = 0;
+	X[j] = 0;
+    }
+
+    // create new Vectors objects
+    if (size != oldSize) {
+	if (vectX != 0)
+	    delete vectX;
+
+	if (vectB != 0)
+	    delete vectB;
+
+	vectX = new Vector(X,size);
+	vectB = new Vector(B,size);
+    }
+
+    // fill in colStartA and rowA, the rows of each column in ascending order
+    if (size != 0) {
+	colStartA[0] = 0;
+	int lastLoc = 0;
+	for (int a=0; a<size; a++) {
+
+	    theVertex = theGraph.getVertexPtr(a);
+	    if (theVertex == 0) {
+		opserr << "WARNING:SparseSPDLinSOE::setSize :";
+		opserr << " vertex " << a << " not in graph! - size set to 0\n";
+		size = 0;
+		return -1;
+	    }
+
+	    int startLoc = lastLoc;
+	    rowA[lastLoc++] = a; // the diagonal
+	    const ID &theAdjacency = theVertex->getAdjacency();
+	    for (int i=0; i<theAdjacency.Size(); i++) {
+		int row = theAdjacency(i);
+		if (row > a)
+		    rowA[lastLoc++] = row;
+	    }
+	    std::sort(rowA+startLoc, rowA+lastLoc);
+	    colStartA[a+1] = lastLoc;
+	}
+    }
+
+    // build the locations in A of the entries of the FE_Elements & DOF_Groups
+    theScatterMap.clear();
+    if (theModel != 0 && size != 0)
+	theScatterMap.build(*theModel, size, colStartA, rowA, true);
+
+    // invoke setSize() on the Solver
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING:SparseSPDLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
+    return result;
+}
+
+
+int
+SparseSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)
+	return 0;
+
+    int idSize = id.Size();
+
+    // check that m and id are of similar size
+    if (idSize != m.noRows() && idSize != m.noCols()) {
+	opserr << "SparseSPDLinSOE::addA() ";
+	opserr << " - Matrix and ID not of similar sizes\n";
+	return -1;
+    }
+
+    // if the locations in A are known add directly, loc is column major
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0) {
+	SparseScatterMap::addMatrix(A, loc, m, idSize, fact, true);
+	return 0;
+    }
+
+    for (int i=0; i<idSize; i++) {
+	int col = id(i);
+	if (col < size && col >= 0) {
+	    int startColLoc = colStartA[col];
+	    int endColLoc = colStartA[col+1];
+	    for (int j=0; j<idSize; j++) {
+		int row = id(j);
+		if (row < size && row >= col) {
+		    // find place in A using rowA
+		    for (int k=startColLoc; k<endColLoc; k++)
+			if (rowA[k] == row) {
+			    A[k] += fact * m(j,i);
+			    k = endColLoc;
+			}
+		}
+	    }  // for j
+	}
+    }  // for i
+
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    int idSize = id.Size();
+    // check that m and id are of similar size
+    if (idSize != v.Size() ) {
+	opserr << "SparseSPDLinSOE::addB() ";
+	opserr << " - Vector and ID not of similar sizes\n";
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i);
+	}
+    } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] -= v(i);
+	}
+    } else {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::setB(const Vector &v, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    if (v.Size() != size) {
+	opserr << "WARNING SparseSPDLinSOE::setB() -";
+	opserr << " incompatible sizes " << size << " and " << v.Size() << endln;
+	return -1;
+    }
+
+    if (fact == 1.0) { // do not need to multiply if fact == 1.0
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i);
+	}
+    } else if (fact == -1.0) {
+	for (int i=0; i<size; i++) {
+	    B[i] = -v(i);
+	}
+    } else {
+	for (int i=0; i<size; i++) {
+	    B[i] = v(i) * fact;
+	}
+    }
+    return 0;
+}
+
+
+void
+SparseSPDLinSOE::zeroA(void)
+{
+    double *Aptr = A;
+    for (int i=0; i<Asize; i++)
+	*Aptr++ = 0;
+
+    factored = false;
+}
+
+
+void
+SparseSPDLinSOE::zeroB(void)
+{
+    double *Bptr = B;
+    for (int i=0; i<size; i++)
+	*Bptr++ = 0;
+}
+
+
+void
+SparseSPDLinSOE::setX(int loc, double value)
+{
+    if (loc < size && loc >=0)
+	X[loc] = value;
+}
+
+
+void
+SparseSPDLinSOE::setX(const Vector &x)
+{
+    if (x.Size() == size && vectX != 0)
+	*vectX = x;
+}
+
+
+const Vector &
+SparseSPDLinSOE::getX(void)
+{
+    if (vectX == 0) {
+	opserr << "FATAL SparseSPDLinSOE::getX - vectX == 0";
+	exit(-1);
+    }
+    return *vectX;
+}
+
+
+const Vector &
+SparseSPDLinSOE::getB(void)
+{
+    if (vectB == 0) {
+	opserr << "FATAL SparseSPDLinSOE::getB - vectB == 0";
+	exit(-1);
+    }
+    return *vectB;
+}
+
+
+double
+SparseSPDLinSOE::normRHS(void)
+{
+    double norm =0.0;
+    for (int i=0; i<size; i++) {
+	double Yi = B[i];
+	norm += Yi*Yi;
+    }
+    return sqrt(norm);
+}
+
+
+int
+SparseSPDLinSOE::setSparseSPDLinSolver(SparseSPDLinSolver &newSolver)
+{
+    newSolver.setLinearSOE(*this);
+
+    if (size != 0) {
+	int solverOK = newSolver.setSize();
+	if (solverOK < 0) {
+	    opserr << "WARNING:SparseSPDLinSOE::setSolver :";
+	    opserr << "the new solver could not setSize() - staying with old\n";
+	    return -1;
+	}
+    }
+
+    return this->LinearSOE::setSolver(newSolver);
+}
+
+
+int
+SparseSPDLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::recvSelf(int cTag, Channel &theChannel,
+			  FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
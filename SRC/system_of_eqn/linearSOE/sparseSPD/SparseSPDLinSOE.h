@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SparseSPDLinSOE_h
+#define SparseSPDLinSOE_h
+
+// Description: This file contains the class definition for SparseSPDLinSOE.
+// SparseSPDLinSOE is a subclass of LinearSOE. It stores the lower triangle
+// of a symmetric positive definite matrix A in compressed column storage,
+// i.e. column j holds the rows i >= j, in the original equation numbering.
+// The reordering and factorization are left to the SparseSPDLinSolver.
+//
+// What: "@(#) SparseSPDLinSOE.h, revA"
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <SparseScatterMap.h>
+
+class SparseSPDLinSolver;
+
+class SparseSPDLinSOE : public LinearSOE
+{
+  public:
+    SparseSPDLinSOE(SparseSPDLinSolver &theSolver);
+
+    ~SparseSPDLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setSparseSPDLinSolver(SparseSPDLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class SparseSPDLinSolver;
+
+  protected:
+
+  private:
+    int size;              // order of A
+    int nnz;               // number of non-zeros in the lower triangle of A
+    double *A, *B, *X;     // 1d arrays containing coefficients of A, B and X
+    int *rowA, *colStartA; // row indices & column starts of the lower triangle
+    Vector *vectX;
+    Vector *vectB;
+    int Asize, Bsize;      // sizes of the 1d arrays holding A and B
+    bool factored;
+    SparseScatterMap theScatterMap; // locations in A of the FE & DOF entries
+};
+
+#endif
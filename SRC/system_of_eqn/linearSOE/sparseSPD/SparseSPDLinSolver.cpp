@@ -0,0 +1,841 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of SparseSPDLinSolver.
+
+#include <SparseSPDLinSolver.h>
+#include <SparseSPDLinSOE.h>
+#include <elementAPI.h>
+#include <AnalysisModel.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <LagrangeDOF_Group.h>
+#include <algorithm>
+#include <new>
+#include <math.h>
+#include <string.h>
+
+#include <amd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+extern "C" int DGEMM(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		     double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		     double *BETA, double *C, int *LDC);
+
+extern "C" int DPOTRF(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+
+extern "C" int DTRSM(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		     int *M, int *N, double *ALPHA, double *A, int *LDA,
+		     double *B, int *LDB);
+#else
+extern "C" int dgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
+
+extern "C" int dpotrf_(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+
+extern "C" int dtrsm_(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		      int *M, int *N, double *ALPHA, double *A, int *LDA,
+		      double *B, int *LDB);
+#endif
+
+#ifdef _SINGLE_LAPACK
+#ifdef _WIN32
+extern "C" int SGEMM(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		     float *ALPHA, float *A, int *LDA, float *B, int *LDB,
+		     float *BETA, float *C, int *LDC);
+
+extern "C" int SPOTRF(char *UPLO, int *N, float *A, int *LDA, int *INFO);
+
+extern "C" int STRSM(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		     int *M, int *N, float *ALPHA, float *A, int *LDA,
+		     float *B, int *LDB);
+#else
+extern "C" int sgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      float *ALPHA, float *A, int *LDA, float *B, int *LDB,
+		      float *BETA, float *C, int *LDC);
+
+extern "C" int spotrf_(char *UPLO, int *N, float *A, int *LDA, int *INFO);
+
+extern "C" int strsm_(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		      int *M, int *N, float *ALPHA, float *A, int *LDA,
+		      float *B, int *LDB);
+#endif
+#endif
+
+// the dense kernels of the supernodes: C = A A' for the m x k block C of
+// the rows of A, the Cholesky factor of the leading n x n block and the
+// solve B = B L^-T below it
+static inline void
+gemmNT(int m, int k, int nc, const double *A, int lda, double *C)
+{
+    char N = 'N';
+    char T = 'T';
+    double one = 1.0;
+    double zero = 0.0;
+    double *Ap = const_cast<double *>(A);
+#ifdef _WIN32
+    DGEMM(&N, &T, &m, &k, &nc, &one, Ap, &lda, Ap, &lda, &zero, C, &m);
+#else
+    dgemm_(&N, &T, &m, &k, &nc, &one, Ap, &lda, Ap, &lda, &zero, C, &m);
+#endif
+}
+
+static inline int
+potrfL(int n, double *A, int lda)
+{
+    char L = 'L';
+    int info = 0;
+#ifdef _WIN32
+    DPOTRF(&L, &n, A, &lda, &info);
+#else
+    dpotrf_(&L, &n, A, &lda, &info);
+#endif
+    return info;
+}
+
+static inline void
+trsmRLT(int m, int n, double *A, int lda, double *B)
+{
+    char R = 'R';
+    char L = 'L';
+    char T = 'T';
+    char N = 'N';
+    double one = 1.0;
+#ifdef _WIN32
+    DTRSM(&R, &L, &T, &N, &m, &n, &one, A, &lda, B, &lda);
+#else
+    dtrsm_(&R, &L, &T, &N, &m, &n, &one, A, &lda, B, &lda);
+#endif
+}
+
+#ifdef _SINGLE_LAPACK
+static inline void
+gemmNT(int m, int k, int nc, const float *A, int lda, float *C)
+{
+    char N = 'N';
+    char T = 'T';
+    float one = 1.0f;
+    float zero = 0.0f;
+    float *Ap = const_cast<float *>(A);
+#ifdef _WIN32
+    SGEMM(&N, &T, &m, &k, &nc, &one, Ap, &lda, Ap, &lda, &zero, C, &m);
+#else
+    sgemm_(&N, &T, &m, &k, &nc, &one, Ap, &lda, Ap, &lda, &zero, C, &m);
+#endif
+}
+
+static inline int
+potrfL(int n, float *A, int lda)
+{
+    char L = 'L';
+    int info = 0;
+#ifdef _WIN32
+    SPOTRF(&L, &n, A, &lda, &info);
+#else
+    spotrf_(&L, &n, A, &lda, &info);
+#endif
+    return info;
+}
+
+static inline void
+trsmRLT(int m, int n, float *A, int lda, float *B)
+{
+    char R = 'R';
+    char L = 'L';
+    char T = 'T';
+    char N = 'N';
+    float one = 1.0f;
+#ifdef _WIN32
+    STRSM(&R, &L, &T, &N, &m, &n, &one, A, &lda, B, &lda);
+#else
+    strsm_(&R, &L, &T, &N, &m, &n, &one, A, &lda, B, &lda);
+#endif
+}
+#endif
+
+// system SupernodalSPD <-mixed>
+void* OPS_SparseSPDLinSolver()
+{
+    bool mixed = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (opt != 0 && strcmp(opt, "-mixed") == 0)
+	    mixed = true;
+    }
+
+    SparseSPDLinSolver *theSolver = new SparseSPDLinSolver(mixed);
+    return new SparseSPDLinSOE(*theSolver);
+}
+
+
+SparseSPDLinSolver::SparseSPDLinSolver(bool mixedPrecision)
+:LinearSOESolver(SOLVER_TAGS_SparseSPDLinSolver),
+ theSOE(0), n(0), numPrimal(0), numSuper(0), mixed(mixedPrecision)
+{
+#ifndef _SINGLE_LAPACK
+    if (mixed == true) {
+	opserr << "WARNING SparseSPDLinSolver - the single precision LAPACK routines";
+	opserr << " are not available, the factor is formed in double precision\n";
+	mixed = false;
+    }
+#endif
+}
+
+
+SparseSPDLinSolver::~SparseSPDLinSolver()
+{
+
+}
+
+
+int
+SparseSPDLinSolver::setLinearSOE(SparseSPDLinSOE &theLinearSOE)
+{
+    theSOE = &theLinearSOE;
+    return 0;
+}
+
+
+// forms the pattern of the upper triangle of PAP', column c holding the
+// rows r < c, and the elimination tree of PAP'
+void
+SparseSPDLinSolver::buildPattern(std::vector<int> &Cp, std::vector<int> &Ci,
+				 std::vector<int> &parent)
+{
+    const int *colStartA = theSOE->colStartA;
+    const int *rowA = theSOE->rowA;
+
+    Cp.assign(n+1, 0);
+    for (int j=0; j<n; j++)
+	for (int p=colStartA[j]; p<colStartA[j+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[j];
+	    if (a != b)
+		Cp[(a > b ? a : b)+1]++;
+	}
+    for (int j=0; j<n; j++)
+	Cp[j+1] += Cp[j];
+
+    Ci.resize(Cp[n]);
+    std::vector<int> next(Cp.begin(), Cp.end()-1);
+    for (int j=0; j<n; j++)
+	for (int p=colStartA[j]; p<colStartA[j+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[j];
+	    if (a > b)
+		Ci[next[a]++] = b;
+	    else if (a < b)
+		Ci[next[b]++] = a;
+	}
+
+    // elimination tree, Liu's algorithm with path compression
+    parent.assign(n, -1);
+    std::vector<int> &ancestor = next;
+    for (int k=0; k<n; k++) {
+	ancestor[k] = -1;
+	for (int p=Cp[k]; p<Cp[k+1]; p++) {
+	    int i = Ci[p];
+	    while (i != -1 && i < k) {
+		int inext = ancestor[i];
+		ancestor[i] = k;
+		if (inext == -1)
+		    parent[i] = k;
+		i = inext;
+	    }
+	}
+    }
+}
+
+
+int
+SparseSPDLinSolver::setSize(void)
+{
+    perm.clear(); invp.clear();
+    superStart.clear(); colSuper.clear();
+    rowStart.clear(); rowIndex.clear();
+    Lstart.clear(); Lx.clear(); Lsx.clear(); aMap.clear();
+    updStart.clear(); updSuper.clear(); updRow.clear();
+    levelStart.clear(); levelSuper.clear();
+    numPrimal = 0;
+    numSuper = 0;
+
+    if (theSOE == 0) {
+	opserr << "WARNING SparseSPDLinSolver::setSize(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    n = theSOE->size;
+    if (n == 0)
+	return 0;
+
+    try {
+
+	// fill reducing ordering of A + A'
+	double Control[AMD_CONTROL], Info[AMD_INFO];
+	amd_defaults(Control);
+	perm.resize(n);
+	int status = amd_order(n, theSOE->colStartA, theSOE->rowA, &perm[0], Control, Info);
+	if (status != AMD_OK && status != AMD_OK_BUT_JUMBLED) {
+	    opserr << "WARNING SparseSPDLinSolver::setSize(void)- ";
+	    opserr << " amd_order returned " << status << endln;
+	    perm.clear();
+	    return -1;
+	}
+
+	// the Lagrange multipliers are eliminated after all the displacement
+	// equations, keeping their order from AMD
+	std::vector<char> isMultiplier(n, 0);
+	AnalysisModel *theModel = theSOE->theModel;
+	if (theModel != 0) {
+	    DOF_Group *dofPtr;
+	    DOF_GrpIter &theDOFs = theModel->getDOFs();
+	    while ((dofPtr = theDOFs()) != 0) {
+		if (dynamic_cast<LagrangeDOF_Group *>(dofPtr) == 0)
+		    continue;
+		const ID &id = dofPtr->getID();
+		for (int i=0; i<id.Size(); i++)
+		    if (id(i) >= 0 && id(i) < n)
+			isMultiplier[id(i)] = 1;
+	    }
+	}
+	numPrimal = std::stable_partition(perm.begin(), perm.end(),
+					  [&isMultiplier](int eqn) {return isMultiplier[eqn] == 0;})
+	    - perm.begin();
+
+	invp.resize(n);
+	for (int k=0; k<n; k++)
+	    invp[perm[k]] = k;
+
+	std::vector<int> Cp, Ci, parent;
+	this->buildPattern(Cp, Ci, parent);
+
+	// postorder the elimination tree so the columns of a supernode are
+	// contiguous, the fill is unchanged; the displacement and multiplier
+	// parts of the tree are postordered on their own to keep the
+	// multipliers last
+	std::vector<int> head(n, -1), next(n, -1), post(n), stack(n);
+	for (int j=n-1; j>=0; j--)
+	    if (parent[j] != -1 && (j < numPrimal) == (parent[j] < numPrimal)) {
+		next[j] = head[parent[j]];
+		head[parent[j]] = j;
+	    }
+	int k = 0;
+	for (int j=0; j<n; j++) {
+	    if (parent[j] != -1 && (j < numPrimal) == (parent[j] < numPrimal))
+		continue;
+	    int top = 0;
+	    stack[0] = j;
+	    while (top >= 0) {
+		int p = stack[top];
+		int i = head[p];
+		if (i == -1) {
+		    top--;
+		    post[k++] = p;
+		} else {
+		    head[p] = next[i];
+		    stack[++top] = i;
+		}
+	    }
+	}
+	for (int j=0; j<n; j++)
+	    post[j] = perm[post[j]];
+	perm.swap(post);
+	for (int k=0; k<n; k++)
+	    invp[perm[k]] = k;
+
+	this->buildPattern(Cp, Ci, parent);
+
+	// column counts of L from the row subtrees of the elimination tree
+	std::vector<int> count(n, 1), mark(n, -1), numChild(n, 0);
+	for (int k=0; k<n; k++) {
+	    if (parent[k] != -1)
+		numChild[parent[k]]++;
+	    for (int p=Cp[k]; p<Cp[k+1]; p++)
+		for (int j=Ci[p]; j != -1 && j < k && mark[j] != k; j=parent[j]) {
+		    mark[j] = k;
+		    count[j]++;
+		}
+	}
+
+	// fundamental supernodes: j joins j-1 if it is the only child of
+	// j and the structure of L(:,j-1) is that of L(:,j) plus the diagonal;
+	// the first multiplier starts a supernode
+	superStart.push_back(0);
+	for (int j=1; j<n; j++)
+	    if (parent[j-1] != j || count[j-1] != count[j]+1 || numChild[j] != 1 ||
+		j == numPrimal)
+		superStart.push_back(j);
+	numSuper = superStart.size();
+	superStart.push_back(n);
+
+	colSuper.resize(n);
+	rowStart.assign(numSuper+1, 0);
+	Lstart.assign(numSuper+1, 0);
+	for (int J=0; J<numSuper; J++) {
+	    int nc = superStart[J+1] - superStart[J];
+	    int nr = count[superStart[J]];
+	    for (int j=superStart[J]; j<superStart[J+1]; j++)
+		colSuper[j] = J;
+	    rowStart[J+1] = rowStart[J] + nr;
+	    Lstart[J+1] = Lstart[J] + (size_t)nr*nc;
+	}
+
+	// the rows of a supernode are those of its first column
+	rowIndex.resize(rowStart[numSuper]);
+	std::vector<int> pos(rowStart.begin(), rowStart.end()-1);
+	for (int J=0; J<numSuper; J++)
+	    rowIndex[pos[J]++] = superStart[J];
+	mark.assign(n, -1);
+	for (int k=0; k<n; k++)
+	    for (int p=Cp[k]; p<Cp[k+1]; p++)
+		for (int j=Ci[p]; j != -1 && j < k && mark[j] != k; j=parent[j]) {
+		    mark[j] = k;
+		    int J = colSuper[j];
+		    if (superStart[J] == j)
+			rowIndex[pos[J]++] = k;
+		}
+
+	if (mixed == true)
+	    Lsx.resize(Lstart[numSuper]);
+	else
+	    Lx.resize(Lstart[numSuper]);
+
+	// the location in Lx of each entry of A
+	const int *colStartA = theSOE->colStartA;
+	const int *rowA = theSOE->rowA;
+	aMap.resize(colStartA[n]);
+	for (int j=0; j<n; j++)
+	    for (int p=colStartA[j]; p<colStartA[j+1]; p++) {
+		int a = invp[rowA[p]];
+		int b = invp[j];
+		int r = (a > b) ? a : b;
+		int c = (a > b) ? b : a;
+		int K = colSuper[c];
+		const int *R = &rowIndex[rowStart[K]];
+		int nr = rowStart[K+1] - rowStart[K];
+		int loc = std::lower_bound(R, R+nr, r) - R;
+		aMap[p] = Lstart[K] + (size_t)(c - superStart[K])*nr + loc;
+	    }
+
+	// the supernodes updating each supernode, the rows of J below its
+	// diagonal block fall into the supernodes of its ancestors
+	updStart.assign(numSuper+1, 0);
+	for (int pass=0; pass<2; pass++) {
+	    for (int J=0; J<numSuper; J++) {
+		const int *R = &rowIndex[rowStart[J]];
+		int nr = rowStart[J+1] - rowStart[J];
+		int q = superStart[J+1] - superStart[J];
+		while (q < nr) {
+		    int K = colSuper[R[q]];
+		    if (pass == 0)
+			updStart[K+1]++;
+		    else {
+			updSuper[pos[K]] = J;
+			updRow[pos[K]++] = q;
+		    }
+		    while (q < nr && R[q] < superStart[K+1])
+			q++;
+		}
+	    }
+	    if (pass == 0) {
+		for (int K=0; K<numSuper; K++)
+		    updStart[K+1] += updStart[K];
+		updSuper.resize(updStart[numSuper]);
+		updRow.resize(updStart[numSuper]);
+		pos.assign(updStart.begin(), updStart.end()-1);
+	    }
+	}
+
+	// level of each supernode above the leaves of the supernodal tree
+	std::vector<int> level(numSuper, 0);
+	int numLevels = 0;
+	for (int J=0; J<numSuper; J++) {
+	    int nc = superStart[J+1] - superStart[J];
+	    int nr = rowStart[J+1] - rowStart[J];
+	    if (level[J]+1 > numLevels)
+		numLevels = level[J]+1;
+	    if (nr > nc) {
+		int K = colSuper[rowIndex[rowStart[J]+nc]];
+		if (level[K] < level[J]+1)
+		    level[K] = level[J]+1;
+	    }
+	}
+	levelStart.assign(numLevels+1, 0);
+	for (int J=0; J<numSuper; J++)
+	    levelStart[level[J]+1]++;
+	for (int l=0; l<numLevels; l++)
+	    levelStart[l+1] += levelStart[l];
+	levelSuper.resize(numSuper);
+	pos.assign(levelStart.begin(), levelStart.end()-1);
+	for (int J=0; J<numSuper; J++)
+	    levelSuper[pos[level[J]]++] = J;
+
+	Y.resize(n);
+
+    } catch (std::bad_alloc &) {
+	opserr << "WARNING SparseSPDLinSolver::setSize(void)- ";
+	opserr << " ran out of memory for the factor of size " << n << endln;
+	n = 0;
+	return -1;
+    }
+
+    numSymbolicFactor++;
+
+    return 0;
+}
+
+
+// adds the updates of the supernodes below K and factors it, the rows
+// of K are given their position in relpos; returns -(j+1) if column j
+// of PAP' does not have a positive pivot. The factor is PAP' = LDL',
+// with D = 1 for the displacement equations and D = -1 for the Lagrange
+// multipliers, whose block -C K^-1 C' of the Schur complement is
+// negative definite when K is positive definite
+template <class T>
+int
+SparseSPDLinSolver::factorSupernode(int K, int *relpos, std::vector<T> &work, T *L)
+{
+    int f = superStart[K];
+    int lastCol = superStart[K+1];
+    int nc = lastCol - f;
+    int nr = rowStart[K+1] - rowStart[K];
+    const int *R = &rowIndex[rowStart[K]];
+    T *LK = L + Lstart[K];
+
+    for (int i=0; i<nr; i++)
+	relpos[R[i]] = i;
+
+    for (int u=updStart[K]; u<updStart[K+1]; u++) {
+	int J = updSuper[u];
+	int p = updRow[u];
+	int ncJ = superStart[J+1] - superStart[J];
+	int nrJ = rowStart[J+1] - rowStart[J];
+	const int *RJ = &rowIndex[rowStart[J]];
+	const T *LJ = L + Lstart[J];
+
+	int q = p;
+	while (q < nrJ && RJ[q] < lastCol)
+	    q++;
+	int m = nrJ - p;
+	int k = q - p;
+
+	// W = LJ(p:nrJ,:) * LJ(p:q,:)'
+	if (work.size() < (size_t)m*k)
+	    work.resize((size_t)m*k);
+	gemmNT(m, k, ncJ, LJ+p, nrJ, &work[0]);
+
+	// subtract the lower part of D(J) W from the matching entries of K
+	T d = (superStart[J] < numPrimal) ? 1 : -1;
+	for (int c=0; c<k; c++) {
+	    T *dst = LK + (size_t)(RJ[p+c]-f)*nr;
+	    const T *src = &work[(size_t)c*m];
+	    for (int r=c; r<m; r++)
+		dst[relpos[RJ[p+r]]] -= d*src[r];
+	}
+    }
+
+    // a multiplier supernode holds -D(K) L(K) L(K)'
+    if (f >= numPrimal)
+	for (int c=0; c<nc; c++) {
+	    T *col = LK + (size_t)c*nr;
+	    for (int r=c; r<nr; r++)
+		col[r] = -col[r];
+	}
+
+    int info = potrfL(nc, LK, nr);
+    if (info != 0)
+	return (info > 0) ? -(f+info) : -(f+1);
+
+    if (nr > nc)
+	trsmRLT(nr - nc, nc, LK, nr, LK+nc);
+
+    return 0;
+}
+
+
+int
+SparseSPDLinSolver::factor(void)
+{
+    const double *A = theSOE->A;
+    int nnz = aMap.size();
+    if (mixed == true) {
+	std::fill(Lsx.begin(), Lsx.end(), 0.0f);
+	for (int p=0; p<nnz; p++)
+	    Lsx[aMap[p]] += (float)A[p];
+    } else {
+	std::fill(Lx.begin(), Lx.end(), 0.0);
+	for (int p=0; p<nnz; p++)
+	    Lx[aMap[p]] += A[p];
+    }
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    if ((int)threadRelpos.size() < numThreads) {
+	threadRelpos.resize(numThreads);
+	threadWork.resize(numThreads);
+	threadWorkS.resize(numThreads);
+    }
+    for (int t=0; t<numThreads; t++)
+	if ((int)threadRelpos[t].size() < n)
+	    threadRelpos[t].resize(n);
+
+    auto factorOne = [this](int K, int t) -> int {
+#ifdef _SINGLE_LAPACK
+	if (mixed == true)
+	    return this->factorSupernode(K, &threadRelpos[t][0], threadWorkS[t], &Lsx[0]);
+#endif
+	return this->factorSupernode(K, &threadRelpos[t][0], threadWork[t], &Lx[0]);
+    };
+
+    int result = 0;
+    int numLevels = levelStart.size() - 1;
+    for (int l=0; l<numLevels && result == 0; l++) {
+	int begin = levelStart[l];
+	int end = levelStart[l+1];
+
+	// near the root there is little to do in parallel, leave the
+	// threads to the BLAS
+	if (end - begin == 1) {
+	    result = factorOne(levelSuper[begin], 0);
+	    continue;
+	}
+
+#pragma omp parallel for schedule(dynamic)
+	for (int s=begin; s<end; s++) {
+	    int t = 0;
+#ifdef _OPENMP
+	    t = omp_get_thread_num();
+#endif
+	    int res = factorOne(levelSuper[s], t);
+	    if (res < 0) {
+#pragma omp critical
+		result = res;
+	    }
+	}
+    }
+
+    if (result < 0) {
+	opserr << "WARNING SparseSPDLinSolver::solve() - factorization failed,";
+	if (-result-1 < numPrimal)
+	    opserr << " matrix not positive definite at equation " << perm[-result-1] << endln;
+	else
+	    opserr << " constraints not independent at Lagrange multiplier equation " << perm[-result-1] << endln;
+	return -1;
+    }
+
+    numNumericFactor++;
+
+    return 0;
+}
+
+
+// solves L D L' y = y in place, y in the elimination order
+template <class T>
+void
+SparseSPDLinSolver::substitute(const T *L, double *y) const
+{
+    // forward substitution L y = P b
+    for (int J=0; J<numSuper; J++) {
+	int f = superStart[J];
+	int nc = superStart[J+1] - f;
+	int nr = rowStart[J+1] - rowStart[J];
+	const int *R = &rowIndex[rowStart[J]];
+	const T *LJ = L + Lstart[J];
+	for (int c=0; c<nc; c++, LJ += nr) {
+	    double yj = y[f+c] / LJ[c];
+	    y[f+c] = yj;
+	    for (int r=c+1; r<nr; r++)
+		y[R[r]] -= LJ[r]*yj;
+	}
+    }
+
+    for (int k=numPrimal; k<n; k++)
+	y[k] = -y[k];
+
+    // backward substitution L' x = y
+    for (int J=numSuper-1; J>=0; J--) {
+	int f = superStart[J];
+	int nc = superStart[J+1] - f;
+	int nr = rowStart[J+1] - rowStart[J];
+	const int *R = &rowIndex[rowStart[J]];
+	for (int c=nc-1; c>=0; c--) {
+	    const T *LJ = L + Lstart[J] + (size_t)c*nr;
+	    double yj = y[f+c];
+	    for (int r=c+1; r<nr; r++)
+		yj -= LJ[r]*y[R[r]];
+	    y[f+c] = yj / LJ[c];
+	}
+    }
+}
+
+
+int
+SparseSPDLinSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SparseSPDLinSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    if (n == 0)
+	return 0;
+
+    if (n != theSOE->size || (int)aMap.size() != theSOE->nnz) {
+	opserr << "WARNING SparseSPDLinSolver::solve(void)- ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    if (theSOE->factored == false) {
+	if (this->factor() < 0)
+	    return -1;
+	theSOE->factored = true;
+    }
+
+    if (mixed == true)
+	return this->solveRefined();
+
+    const double *B = theSOE->B;
+    double *X = theSOE->X;
+    double *y = &Y[0];
+
+    for (int k=0; k<n; k++)
+	y[k] = B[perm[k]];
+
+    this->substitute(&Lx[0], y);
+
+    for (int k=0; k<n; k++)
+	X[perm[k]] = y[k];
+
+    return 0;
+}
+
+
+// the solve with the single precision factor, refined with the residual
+// of the double precision A (its lower triangle) until the correction is
+// below refineTol of the solution; the refinement contracts by about
+// cond(A) times the single precision round-off in each step, so if it
+// stops contracting the factor is formed again in double precision
+int
+SparseSPDLinSolver::solveRefined(void)
+{
+    static const int maxRefine = 20;
+    static const double refineTol = 1.0e-12;
+
+    const double *A = theSOE->A;
+    const int *colStartA = theSOE->colStartA;
+    const int *rowA = theSOE->rowA;
+    const double *B = theSOE->B;
+    double *X = theSOE->X;
+    double *y = &Y[0];
+
+    if ((int)resid.size() != n)
+	resid.resize(n);
+    double *r = &resid[0];
+
+    for (int k=0; k<n; k++)
+	y[k] = B[perm[k]];
+    this->substitute(&Lsx[0], y);
+    for (int k=0; k<n; k++)
+	X[perm[k]] = y[k];
+
+    double lastNormDx = 0.0;
+    for (int iter=0; iter<maxRefine; iter++) {
+
+	for (int i=0; i<n; i++)
+	    r[i] = B[i];
+	for (int j=0; j<n; j++) {
+	    double xj = X[j];
+	    double rj = 0.0;
+	    for (int p=colStartA[j]; p<colStartA[j+1]; p++) {
+		int i = rowA[p];
+		r[i] -= A[p]*xj;
+		if (i != j)
+		    rj += A[p]*X[i];
+	    }
+	    r[j] -= rj;
+	}
+
+	for (int k=0; k<n; k++)
+	    y[k] = r[perm[k]];
+	this->substitute(&Lsx[0], y);
+
+	double normDx = 0.0;
+	double normX = 0.0;
+	for (int k=0; k<n; k++) {
+	    double &xk = X[perm[k]];
+	    xk += y[k];
+	    if (fabs(y[k]) > normDx)
+		normDx = fabs(y[k]);
+	    if (fabs(xk) > normX)
+		normX = fabs(xk);
+	}
+
+	if (normDx <= refineTol*normX)
+	    return 0;
+
+	if (iter > 0 && normDx > 0.5*lastNormDx)
+	    break;
+	lastNormDx = normDx;
+    }
+
+    opserr << "WARNING SparseSPDLinSolver::solve() - the refinement of the single precision";
+    opserr << " solution does not converge, the factor is formed in double precision\n";
+
+    try {
+	mixed = false;
+	std::vector<float>().swap(Lsx);
+	Lx.resize(Lstart[numSuper]);
+    } catch (std::bad_alloc &) {
+	opserr << "WARNING SparseSPDLinSolver::solve(void)- ";
+	opserr << " ran out of memory for the factor of size " << n << endln;
+	return -1;
+    }
+
+    theSOE->factored = false;
+    return this->solve();
+}
+
+
+int
+SparseSPDLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+SparseSPDLinSolver::recvSelf(int ctag,
+			     Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
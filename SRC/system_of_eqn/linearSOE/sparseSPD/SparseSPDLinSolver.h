@@ -0,0 +1,113 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SparseSPDLinSolver_h
+#define SparseSPDLinSolver_h
+
+// Description: This file contains the class definition for
+// SparseSPDLinSolver. It solves a SparseSPDLinSOE with a supernodal
+// sparse Cholesky factorization A = P'LL'P. setSize() finds a fill
+// reducing ordering with AMD, postorders the elimination tree and sets
+// up the supernodes and their row structures; this symbolic part is kept
+// until the graph changes. The numeric factorization is left-looking,
+// each supernode being a dense block updated with dgemm and factored with
+// dpotrf/dtrsm. Supernodes on the same level of the supernodal elimination
+// tree do not update each other and are factored in parallel with OpenMP.
+//
+// The equations of LagrangeDOF_Groups are ordered after all the others,
+// so a saddle point system [K C'; C 0] with K positive definite is
+// factored as LDL' with D = diag(1, -1): the multiplier block of L is the
+// Cholesky factor of the Schur complement C K^-1 C', formed sparse.
+//
+// With mixedPrecision the factor is formed and kept in single precision,
+// halving its memory, and each solve is refined against the double
+// precision A until the correction is at round-off; should the refinement
+// not converge, A being too ill-conditioned for a single precision
+// factor, the solver reverts to the double precision factor. This needs
+// a LAPACK with the single precision routines (_SINGLE_LAPACK).
+//
+// What: "@(#) SparseSPDLinSolver.h, revA"
+
+#include <LinearSOESolver.h>
+#include <vector>
+#include <stddef.h>
+
+class SparseSPDLinSOE;
+
+class SparseSPDLinSolver : public LinearSOESolver
+{
+  public:
+    SparseSPDLinSolver(bool mixedPrecision = false);
+    ~SparseSPDLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(SparseSPDLinSOE &theSOE);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int factor(void);
+    template <class T>
+    int factorSupernode(int K, int *relpos, std::vector<T> &work, T *L);
+    template <class T>
+    void substitute(const T *L, double *y) const;
+    int solveRefined(void);
+    void buildPattern(std::vector<int> &Cp, std::vector<int> &Ci,
+		      std::vector<int> &parent);
+
+    SparseSPDLinSOE *theSOE;
+
+    int n;
+    int numPrimal;                // equations before the Lagrange multipliers
+    std::vector<int> perm;        // perm[k] is the equation eliminated k'th
+    std::vector<int> invp;        // inverse of perm
+
+    int numSuper;
+    std::vector<int> superStart;  // first column of each supernode
+    std::vector<int> colSuper;    // supernode of each column
+    std::vector<int> rowStart;    // start in rowIndex of each supernode
+    std::vector<int> rowIndex;    // rows of each supernode, diagonal block first
+    std::vector<size_t> Lstart;   // start in Lx of each supernode
+    std::vector<double> Lx;       // supernodes stored column major
+    bool mixed;
+    std::vector<float> Lsx;       // the supernodes in single precision
+
+    std::vector<size_t> aMap;     // location in Lx of each entry of A
+
+    // the supernodes J updating supernode K, updSuper[updStart[K]...], and
+    // the position in the rows of J of the first row in K
+    std::vector<int> updStart, updSuper, updRow;
+
+    // supernodes grouped on their level in the supernodal elimination tree
+    std::vector<int> levelStart, levelSuper;
+
+    std::vector<std::vector<int> > threadRelpos;
+    std::vector<std::vector<double> > threadWork;
+    std::vector<std::vector<float> > threadWorkS;
+    std::vector<double> Y, resid;
+};
+
+#endif
@@ -25,6 +25,11 @@
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
 
 #include <iostream>
 using std::nothrow;
@@ -232,14 +237,193 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
 	}
     }
     
-    // call "C" function to form elimination tree and to do the symbolic factorization.
-    nblks = symFactorization(rowStartA, colA, size, this->LSPARSE,
+    // call "C" function to form elimination tree and to do the symbolic factorization;
+    // if the equations are already in a fill-reducing order they are kept (LSPARSE 4)
+    int ordering = this->LSPARSE;
+    LinearSOESolver *theSolver = this->getSolver();
+    if (theSolver != 0 && theSolver->getEquationsOrdered() == true)
+	ordering = 4;
+    nblks = symFactorization(rowStartA, colA, size, ordering,
 			     &xblk, &invp, &rowblks, &begblk, &first, &penv, &diag);
 
+    // build the addresses of the FE_Element & DOF_Group entries
+    this->buildScatterMap();
+
     return result;
 }
 
 
+/* Find the addresses in the factor storage of the entries of in_id.
+ * loc[ii*n+jj], ii <= jj, is set to the address that in_m(ii,jj) is
+ * added to, or 0 if either equation is not in the system. This follows
+ * the same traversal of the blocks as addA().
+ */
+int SymSparseLinSOE::locateA(const ID &in_id, double **loc)
+{
+   int n = in_id.Size();
+   for (int ii = 0; ii < n*n; ii++)
+       loc[ii] = 0;
+
+   int *newID = new (nothrow) int[n];
+   int *isort = new (nothrow) int[n];
+   if (newID == 0 || isort == 0) {
+       if (newID != 0) delete [] newID;
+       if (isort != 0) delete [] isort;
+       return -1;
+   }
+
+   int  i, j, k, lnee;
+   int  ipos, jpos, iblk;
+   long int  i_eq, j_eq;
+   OFFDBLK  *ptr;
+   OFFDBLK  *saveblk;
+   double  *iloc;
+
+   for (i = 0, k = 0; i < n; i++) {
+       if (in_id(i) >= 0 && in_id(i) < size) {
+	   newID[i] = invp[in_id(i)];
+	   isort[k] = i;
+	   k++;
+       } else
+	   newID[i] = -1;
+   }
+   lnee = k;
+
+   if (lnee == 0) {
+       delete [] newID;
+       delete [] isort;
+       return 0;
+   }
+
+   /* sort isort on the new equation numbers */
+   i = k - 1;
+   do
+   {
+       k = 0 ;
+       for (j = 0 ; j < i ; j++)
+       {  
+	   if ( newID[isort[j]] > newID[isort[j+1]]) {  
+	       int tmp = isort[j];
+	       isort[j] = isort[j+1];
+	       isort[j+1] = tmp;
+	       k = j ;
+	   }
+       }
+       i = k ;
+   }  while ( k > 0) ;
+
+   k = rowblks[newID[isort[0]]] ;
+   saveblk  = begblk[k] ;
+
+   for (i=0; i<lnee; i++)
+   { 
+       ipos = isort[i] ;
+       i_eq = newID[ipos] ;
+       iblk = rowblks[i_eq] ;
+       iloc = penv[i_eq +1] - i_eq ;
+       if (k < iblk)
+	   while (saveblk->row != i_eq) saveblk = saveblk->bnext ;
+	 
+       ptr = saveblk ;
+       for (j=0; j< i ; j++)
+       {   
+	   jpos = isort[j] ;
+	   j_eq = newID[jpos] ;
+
+	   double *address;
+	   if (j_eq >= xblk[iblk]) /* diagonal block (profile) */
+	       address = iloc + j_eq ;
+	   else /* row segment */
+	   { 
+	       while((j_eq >= (ptr->next)->beg) && ((ptr->next)->row == i_eq))
+		   ptr = ptr->next ;
+	       address = ptr->nz + j_eq - ptr->beg;
+	   }
+
+	   if (ipos < jpos)
+	       loc[ipos*n + jpos] = address;
+	   else
+	       loc[jpos*n + ipos] = address;
+       }
+       loc[ipos*n + ipos] = &diag[i_eq]; /* diagonal element */
+   }
+
+   delete [] newID;
+   delete [] isort;
+
+   return 0;
+}
+
+
+int SymSparseLinSOE::buildScatterMap(void)
+{
+    scatterIDs.clear();
+    scatterData.clear();
+    scatterLocs.clear();
+
+    if (theModel == 0 || size == 0)
+	return 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+	FE_Element *theEle = 0;
+	DOF_Group *theDOF = 0;
+	FE_EleIter &theEles = theModel->getFEs();
+	DOF_GrpIter &theDOFs = theModel->getDOFs();
+
+	while (1) {
+	    const ID *theID = 0;
+	    if (pass == 0 && (theEle = theEles()) != 0)
+		theID = &(theEle->getID());
+	    else if (pass == 1 && (theDOF = theDOFs()) != 0)
+		theID = &(theDOF->getID());
+	    else
+		break;
+
+	    int n = theID->Size();
+	    if (n == 0)
+		continue;
+
+	    int start = scatterData.size();
+	    int locStart = scatterLocs.size();
+	    scatterData.push_back(n);
+	    scatterData.push_back(locStart);
+	    for (int i = 0; i < n; i++)
+		scatterData.push_back((*theID)(i));
+
+	    scatterLocs.resize(locStart + n*n);
+	    if (this->locateA(*theID, &scatterLocs[locStart]) < 0) {
+		scatterIDs.clear();
+		scatterData.clear();
+		scatterLocs.clear();
+		return -1;
+	    }
+	    scatterIDs[theID] = start;
+	}
+    }
+
+    return 0;
+}
+
+
+double **SymSparseLinSOE::getScatterLocations(const ID &in_id)
+{
+    std::unordered_map<const ID *, int>::const_iterator it = scatterIDs.find(&in_id);
+    if (it == scatterIDs.end())
+	return 0;
+
+    // check the ID has not been changed since the map was built
+    const int *data = &scatterData[it->second];
+    int n = in_id.Size();
+    if (data[0] != n)
+	return 0;
+    for (int i = 0; i < n; i++)
+	if (data[2+i] != in_id(i))
+	    return 0;
+
+    return &scatterLocs[data[1]];
+}
+
+
 /* Perform the element stiffness assembly here.
  */
 int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
@@ -258,6 +442,19 @@ int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
        return -1;
    }
 
+   // if the addresses are known add directly, only the upper triangle
+   // of in_m is used as in the search below
+   double **locs = this->getScatterLocations(in_id);
+   if (locs != 0) {
+       for (int ii = 0; ii < idSize; ii++) {
+	   double **loc = locs + ii*idSize + ii;
+	   for (int jj = ii; jj < idSize; jj++, loc++)
+	       if (*loc != 0)
+		   **loc += in_m(ii, jj) * fact;
+       }
+       return 0;
+   }
+
    // construct m and id based on non-negative id values.
    int newPt = 0;
    int *id = new (nothrow) int[idSize];
@@ -601,6 +798,32 @@ int SymSparseLinSOE::setSymSparseLinSolver(SymSparseLinSolver &newSolver)
 }
 
 
+// the factors overwrite the diagonal, the envelope and the off-diagonal
+// blocks, so they are all counted here
+size_t
+SymSparseLinSOE::getMemoryUsage(void)
+{
+    size_t result = 2*Bsize*sizeof(double) + 2*sizeof(Vector);
+    result += (nnz + size + 1)*sizeof(int);
+
+    if (diag == 0 || penv == 0 || xblk == 0)
+	return result;
+
+    result += size*sizeof(double) + (size+1)*sizeof(double *);
+    result += (penv[size] - penv[0])*sizeof(double);
+    result += 3*size*sizeof(int);
+
+    OFFDBLK *blkPtr = first;
+    while (blkPtr != 0 && blkPtr->beg != size) {
+	int rLen = xblk[rowblks[blkPtr->beg]+1] - blkPtr->beg;
+	result += rLen*sizeof(double) + sizeof(OFFDBLK);
+	blkPtr = blkPtr->next;
+    }
+
+    return result;
+}
+
+
 int 
 SymSparseLinSOE::sendSelf(int cTag, Channel &theChannel)
 {
@@ -21,6 +21,8 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
    #include <FeStructs.h>
@@ -49,6 +51,7 @@ class SymSparseLinSOE : public LinearSOE
     const Vector &getX(void);
     const Vector &getB(void);    
     double normRHS(void);
+    size_t getMemoryUsage(void);
 
     void setX(int loc, double value);        
     void setX(const Vector &x);        
@@ -63,6 +66,10 @@ class SymSparseLinSOE : public LinearSOE
   protected:
     
   private:
+    int buildScatterMap(void);
+    int locateA(const ID &in_id, double **loc);
+    double **getScatterLocations(const ID &in_id);
+
     int size;            // order of A
     int nnz;             // number of non-zeros in A
     double *B, *X;       // 1d arrays containing coefficients of B and X
@@ -81,6 +88,11 @@ class SymSparseLinSOE : public LinearSOE
     OFFDBLK  **begblk;
     OFFDBLK  *first;
 
+    // addresses in the factor storage of the FE_Element & DOF_Group
+    // entries, built in setSize() after the symbolic factorization
+    std::unordered_map<const ID *, int> scatterIDs;
+    std::vector<int> scatterData;     // per ID: size, start in scatterLocs, ID
+    std::vector<double *> scatterLocs;
 };
 
 #endif
@@ -106,6 +106,7 @@ SymSparseLinSolver::solve(void)
 	    opserr << "In SymSparseLinSolver: error in factorization.\n";
 	    return -1;
 	}
+	numNumericFactor++;
 	theSOE->factored = true;
     }
 
@@ -152,6 +152,15 @@ int symFactorization(int *fxadj, int *adjncy, int neq, int LSPARSE,
          genrcm(neq, padj, wperm, marker, fchild, sibling ) ;
          forminv(neq,wperm, winvp) ;
          break ;
+
+      case 4:
+	/* keep the given order, it is already a fill-reducing one */
+
+         for (i=0; i<=neq; i++) {
+            wperm[i] = i ;
+            winvp[i] = i ;
+         }
+         break ;
    }
 
    /* free up space used just for mygenmmd and the fortran program */
@@ -164,7 +173,7 @@ int symFactorization(int *fxadj, int *adjncy, int neq, int LSPARSE,
    assert(rowblks != 0) ;
 
 /* set up the elimination tree, perform postordering           */
-   if (LSPARSE > 0 && LSPARSE < 4) {
+   if (LSPARSE > 0 && LSPARSE < 5) {
        nblks = pfordr( neq, padj, perm, invp, parent, fchild, sibling,
 		       winvp, wperm, marker, rowblks ) ;
    } 
@@ -90,9 +90,11 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
     }
 
     // resize A, B, X
+    Ap.clear();
+    Ai.clear();
     Ap.reserve(size+1);
     Ai.reserve(nnz);
-    Ax.resize(nnz,0.0);
+    Ax.assign(nnz,0.0);
     B.resize(size);
     B.Zero();
     X.resize(size);
@@ -132,6 +134,11 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	Ap.push_back(Ap[a]+col.Size());
     }
 
+    // build the locations in Ax of the entries of the FE_Elements & DOF_Groups
+    theScatterMap.clear();
+    if (theModel != 0 && size != 0)
+	theScatterMap.build(*theModel, size, &Ap[0], &Ai[0]);
+
     // invoke setSize() on the Solver
     LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -158,6 +165,13 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
 
+    // if the locations in Ax are known add directly, loc is column major
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0) {
+	SparseScatterMap::addMatrix(&Ax[0], loc, m, idSize, fact, true);
+	return 0;
+    }
+
     int size = X.Size();
     if (fact == 1.0) { // do not need to multiply
 	for (int j=0; j<idSize; j++) {
@@ -318,6 +332,14 @@ UmfpackGenLinSOE::getB(void)
     return B;
 }
 
+// A, B & X, the factors are kept by the solver
+size_t
+UmfpackGenLinSOE::getMemoryUsage(void)
+{
+    return (Ax.capacity() + X.Size() + B.Size())*sizeof(double)
+	+ (Ap.capacity() + Ai.capacity())*sizeof(int);
+}
+
 double
 UmfpackGenLinSOE::normRHS(void)
 {
@@ -353,3 +375,24 @@ UmfpackGenLinSOE::recvSelf(int cTag, Channel &theChannel,
 {
     return 0;
 }
+
+
+int
+UmfpackGenLinSOE::solveMultiple(const Matrix &Bm, Matrix &Xm)
+{
+    int size = X.Size();
+    int numRHS = Bm.noCols();
+    if (Bm.noRows() != size) {
+	opserr << "WARNING UmfpackGenLinSOE::solveMultiple() - B has " << Bm.noRows();
+	opserr << " rows, the system " << size << " equations\n";
+	return -1;
+    }
+
+    // the columns are solved in place in X
+    Xm = Bm;
+    if (size == 0 || numRHS == 0)
+	return 0;
+
+    UmfpackGenLinSolver *theSolvr = (UmfpackGenLinSolver *)this->getSolver();
+    return theSolvr->solveMultiple(numRHS, &Xm(0,0));
+}
@@ -38,6 +38,7 @@
 #include <LinearSOE.h>
 #include <Vector.h>
 #include <vector>
+#include <SparseScatterMap.h>
 
 class UmfpackGenLinSolver;
 
@@ -61,6 +62,9 @@ public:
     const Vector &getX(void);
     const Vector &getB(void);    
     double normRHS(void);
+    size_t getMemoryUsage(void);
+
+    int solveMultiple(const Matrix &B, Matrix &X);
 
     void setX(int loc, double value);        
     void setX(const Vector &x);        
@@ -78,6 +82,7 @@ private:
     Vector X,B;
     std::vector<int> Ap, Ai;
     std::vector<double> Ax;
+    SparseScatterMap theScatterMap; // locations in Ax of the FE & DOF entries
 };
 
 
@@ -37,16 +37,39 @@
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <Element.h>
+#include <ID.h>
+#include <elementAPI.h>
+#include <string>
+
+#ifdef _WIN32
+extern "C" int  DGESV(int *N, int *NRHS, double *A, int *LDA, 
+		      int *iPiv, double *B, int *LDB, int *INFO);
+#else
+extern "C" int dgesv_(int *N, int *NRHS, double *A, int *LDA, int *iPiv, 
+		      double *B, int *LDB, int *INFO);
+#endif
 
 void* OPS_UmfpackGenLinSolver()
 {
-    UmfpackGenLinSolver *theSolver = new UmfpackGenLinSolver();
+    bool condense = false;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	std::string type = OPS_GetString();
+	if (type == "-condense" || type == "condense")
+	    condense = true;
+    }
+
+    UmfpackGenLinSolver *theSolver = new UmfpackGenLinSolver(condense);
     return new UmfpackGenLinSOE(*theSolver);  
 }
 
 UmfpackGenLinSolver::
-UmfpackGenLinSolver()
-    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0), theSOE(0)
+UmfpackGenLinSolver(bool cond)
+    :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver), Symbolic(0), theSOE(0),
+     condense(cond), numI(0), numB(0), KiiSymbolic(0), KiiNumeric(0)
 {
 }
 
@@ -56,6 +79,7 @@ UmfpackGenLinSolver::~UmfpackGenLinSolver()
     if (Symbolic != 0) {
 	umfpack_di_free_symbolic(&Symbolic);
     }
+    this->clearCondensed();
 }
 
 int
@@ -64,6 +88,15 @@ UmfpackGenLinSolver::solve(void)
     int n = theSOE->X.Size();
     int nnz = (int)theSOE->Ai.size();
     if (n == 0 || nnz==0) return 0;
+
+    if (condense == true && numI > 0) {
+	if (this->solveCondensed() == 0)
+	    return 0;
+
+	// Kii could not be factored, use the full matrix until next setSize
+	opserr<<"WARNING: condensed solve failed, using full factorization -- Umfpackgenlinsolver::solve\n";
+	this->clearCondensed();
+    }
     
     int* Ap = &(theSOE->Ap[0]);
     int* Ai = &(theSOE->Ai[0]);
@@ -71,6 +104,15 @@ UmfpackGenLinSolver::solve(void)
     double* X = &(theSOE->X(0));
     double* B = &(theSOE->B(0));
 
+    // the symbolic analysis of the full matrix is not done in setSize
+    // when the linear equations are condensed out
+    if (Symbolic == 0 && condense == true) {
+	if (umfpack_di_symbolic(n,n,Ap,Ai,Ax,&Symbolic,Control,Info) != UMFPACK_OK)
+	    Symbolic = 0;
+	else
+	    numSymbolicFactor++;
+    }
+
     // check if symbolic is done
     if (Symbolic == 0) {
 	opserr<<"WARNING: setSize has not been called -- Umfpackgenlinsolver::solve\n";
@@ -86,6 +128,7 @@ UmfpackGenLinSolver::solve(void)
 	opserr<<"WARNING: numeric analysis returns "<<status<<" -- Umfpackgenlinsolver::solve\n";
 	return -1;
     }
+    numNumericFactor++;
 
     // solve
     status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,X,B,Numeric,Control,Info);
@@ -105,6 +148,70 @@ UmfpackGenLinSolver::solve(void)
 }
 
 
+// the numeric factorization of solve() is done once for all the columns
+// of BX; with the condensed equations the columns go through solve()
+int
+UmfpackGenLinSolver::solveMultiple(int numRHS, double *BX)
+{
+    int n = theSOE->X.Size();
+    int nnz = (int)theSOE->Ai.size();
+    if (n == 0 || nnz==0 || numRHS == 0) return 0;
+
+    if (condense == true && numI > 0) {
+	for (int j=0; j<numRHS; j++) {
+	    Vector col(BX + (long)j*n, n);
+	    theSOE->B = col;
+	    int res = this->solve();
+	    if (res < 0)
+		return res;
+	    col = theSOE->X;
+	}
+	return 0;
+    }
+
+    int* Ap = &(theSOE->Ap[0]);
+    int* Ai = &(theSOE->Ai[0]);
+    double* Ax = &(theSOE->Ax[0]);
+    double* X = &(theSOE->X(0));
+
+    if (Symbolic == 0 && condense == true) {
+	if (umfpack_di_symbolic(n,n,Ap,Ai,Ax,&Symbolic,Control,Info) != UMFPACK_OK)
+	    Symbolic = 0;
+	else
+	    numSymbolicFactor++;
+    }
+
+    if (Symbolic == 0) {
+	opserr<<"WARNING: setSize has not been called -- Umfpackgenlinsolver::solveMultiple\n";
+	return -1;
+    }
+
+    void* Numeric = 0;
+    int status = umfpack_di_numeric(Ap,Ai,Ax,Symbolic,&Numeric,Control,Info);
+    if (status!=UMFPACK_OK) {
+	opserr<<"WARNING: numeric analysis returns "<<status<<" -- Umfpackgenlinsolver::solveMultiple\n";
+	return -1;
+    }
+    numNumericFactor++;
+
+    for (int j=0; j<numRHS && status==UMFPACK_OK; j++) {
+	double *col = BX + (long)j*n;
+	status = umfpack_di_solve(UMFPACK_A,Ap,Ai,Ax,X,col,Numeric,Control,Info);
+	for (int i=0; i<n; i++)
+	    col[i] = X[i];
+    }
+
+    umfpack_di_free_numeric(&Numeric);
+
+    if (status!=UMFPACK_OK) {
+	opserr<<"WARNING: solving returns "<<status<<" -- Umfpackgenlinsolver::solveMultiple\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
 int
 UmfpackGenLinSolver::setSize()
 {
@@ -112,19 +219,31 @@ UmfpackGenLinSolver::setSize()
     umfpack_di_defaults(Control);
     Control[UMFPACK_PIVOT_TOLERANCE] = 1.0;
     Control[UMFPACK_STRATEGY] = UMFPACK_STRATEGY_SYMMETRIC;
+    if (equationsOrdered == true)
+	Control[UMFPACK_ORDERING] = UMFPACK_ORDERING_NONE;
 
     int n = theSOE->X.Size();
     int nnz = (int)theSOE->Ai.size();
+
+    // symbolic analysis
+    if (Symbolic != 0) {
+	umfpack_di_free_symbolic(&Symbolic);
+    }
+    this->clearCondensed();
+
     if (n == 0 || nnz==0) return 0;
     
     int* Ap = &(theSOE->Ap[0]);
     int* Ai = &(theSOE->Ai[0]);
     double* Ax = &(theSOE->Ax[0]);
 
-    // symbolic analysis
-    if (Symbolic != 0) {
-	umfpack_di_free_symbolic(&Symbolic);
+    if (condense == true) {
+	if (this->setSizeCondensed() < 0)
+	    return -1;
+	if (numI > 0)
+	    return 0;
     }
+
     int status = umfpack_di_symbolic(n,n,Ap,Ai,Ax,&Symbolic,Control,Info);
 
     // check error
@@ -133,9 +252,260 @@ UmfpackGenLinSolver::setSize()
 	Symbolic = 0;
 	return -1;
     }
+    numSymbolicFactor++;
+
     return 0;
 }
 
+void
+UmfpackGenLinSolver::clearCondensed(void)
+{
+    if (KiiNumeric != 0)
+	umfpack_di_free_numeric(&KiiNumeric);
+    if (KiiSymbolic != 0)
+	umfpack_di_free_symbolic(&KiiSymbolic);
+    KiiNumeric = 0;
+    KiiSymbolic = 0;
+
+    numI = 0;
+    numB = 0;
+    localEqn.clear(); isB.clear(); eqnI.clear(); eqnB.clear();
+    KiiP.clear(); KiiI.clear(); KiiLoc.clear(); KiiX.clear();
+    locIB.clear(); locBI.clear(); locBB.clear();
+    rowIB.clear(); colIB.clear(); rowBI.clear(); colBI.clear(); 
+    rowBB.clear(); colBB.clear();
+    linearAx.clear();
+    S0.clear(); S.clear(); workI.clear(); workI2.clear(); workB.clear();
+    iPiv.clear();
+}
+
+
+// splits the equations into those only elements with a constant tangent
+// contribute to (set i) and the rest (set b), builds Kii and the
+// locations of the Kib, Kbi and Kbb entries in Ax
+int
+UmfpackGenLinSolver::setSizeCondensed(void)
+{
+    AnalysisModel *theModel = theSOE->theModel;
+    if (theModel == 0)
+	return 0;
+
+    int n = theSOE->X.Size();
+    const int *Ap = &(theSOE->Ap[0]);
+    const int *Ai = &(theSOE->Ai[0]);
+
+    // any equation of an element without a constant tangent, or of an
+    // FE_Element without an element (constraint handlers), is kept
+    isB.assign(n, 0);
+    FE_Element *theFE;
+    FE_EleIter &theFEs = theModel->getFEs();
+    while ((theFE = theFEs()) != 0) {
+	Element *theEle = theFE->getElement();
+	if (theEle != 0 && theEle->isSubdomain() == false && 
+	    theEle->hasConstantTangent() == true)
+	    continue;
+	const ID &id = theFE->getID();
+	for (int i=0; i<id.Size(); i++)
+	    if (id(i) >= 0 && id(i) < n)
+		isB[id(i)] = 1;
+    }
+
+    localEqn.resize(n);
+    for (int i=0; i<n; i++) {
+	if (isB[i] == 0) {
+	    localEqn[i] = eqnI.size();
+	    eqnI.push_back(i);
+	} else {
+	    localEqn[i] = eqnB.size();
+	    eqnB.push_back(i);
+	}
+    }
+    numI = eqnI.size();
+    numB = eqnB.size();
+
+    if (numI == 0) {
+	this->clearCondensed();
+	return 0;
+    }
+
+    // sort the entries of A into the blocks, the columns and rows of Kii
+    // stay in ascending order as localEqn is increasing in each set
+    KiiP.assign(numI+1, 0);
+    for (int col=0; col<n; col++) {
+	for (int k=Ap[col]; k<Ap[col+1]; k++) {
+	    int row = Ai[k];
+	    if (isB[col] == 0 && isB[row] == 0) {
+		KiiI.push_back(localEqn[row]);
+		KiiLoc.push_back(k);
+	    } else if (isB[col] == 0) {
+		locBI.push_back(k); rowBI.push_back(localEqn[row]); colBI.push_back(localEqn[col]);
+	    } else if (isB[row] == 0) {
+		locIB.push_back(k); rowIB.push_back(localEqn[row]); colIB.push_back(localEqn[col]);
+	    } else {
+		locBB.push_back(k); rowBB.push_back(localEqn[row]); colBB.push_back(localEqn[col]);
+	    }
+	}
+	if (isB[col] == 0)
+	    KiiP[localEqn[col]+1] = KiiI.size();
+    }
+
+    KiiX.assign(KiiI.size(), 0.0);
+    linearAx.assign(KiiLoc.size() + locIB.size() + locBI.size(), 0.0);
+    S0.assign(numB*numB, 0.0);
+    S.assign(numB*numB, 0.0);
+    workI.assign(numI, 0.0);
+    workI2.assign(numI, 0.0);
+    workB.assign(numB, 0.0);
+    iPiv.assign(numB, 0);
+
+    int status = umfpack_di_symbolic(numI, numI, &KiiP[0], &KiiI[0], &KiiX[0],
+				     &KiiSymbolic, Control, Info);
+    if (status != UMFPACK_OK) {
+	opserr<<"WARNING: symbolic analysis of Kii returns "<<status<<" -- Umfpackgenlinsolver::setsize\n";
+	KiiSymbolic = 0;
+	this->clearCondensed();
+	return -1;
+    }
+    numSymbolicFactor++;
+
+    return 0;
+}
+
+
+// factors Kii and forms S0 = -Kbi Kii^-1 Kib
+int
+UmfpackGenLinSolver::factorCondensed(void)
+{
+    const double *Ax = &(theSOE->Ax[0]);
+
+    for (int k=0; k<(int)KiiLoc.size(); k++)
+	KiiX[k] = Ax[KiiLoc[k]];
+
+    if (KiiNumeric != 0)
+	umfpack_di_free_numeric(&KiiNumeric);
+    KiiNumeric = 0;
+
+    int status = umfpack_di_numeric(&KiiP[0], &KiiI[0], &KiiX[0], KiiSymbolic,
+				    &KiiNumeric, Control, Info);
+    if (status != UMFPACK_OK) {
+	if (KiiNumeric != 0)
+	    umfpack_di_free_numeric(&KiiNumeric);
+	KiiNumeric = 0;
+	return -1;
+    }
+    numNumericFactor++;
+
+    // one column of Kib at a time, the Kib entries are in column order
+    for (int k=0; k<numB*numB; k++)
+	S0[k] = 0.0;
+
+    int numIB = locIB.size();
+    int k = 0;
+    while (k < numIB) {
+	int colB = colIB[k];
+	for (int i=0; i<numI; i++)
+	    workI[i] = 0.0;
+	for (; k < numIB && colIB[k] == colB; k++)
+	    workI[rowIB[k]] = Ax[locIB[k]];
+
+	status = umfpack_di_solve(UMFPACK_A, &KiiP[0], &KiiI[0], &KiiX[0], &workI2[0],
+				  &workI[0], KiiNumeric, Control, Info);
+	if (status != UMFPACK_OK)
+	    return -1;
+
+	double *S0col = &S0[colB*numB];
+	for (int j=0; j<(int)locBI.size(); j++)
+	    S0col[rowBI[j]] -= Ax[locBI[j]] * workI2[colBI[j]];
+    }
+
+    // keep the values the factorization was done with
+    int loc = 0;
+    for (int j=0; j<(int)KiiLoc.size(); j++) linearAx[loc++] = Ax[KiiLoc[j]];
+    for (int j=0; j<numIB; j++) linearAx[loc++] = Ax[locIB[j]];
+    for (int j=0; j<(int)locBI.size(); j++) linearAx[loc++] = Ax[locBI[j]];
+
+    return 0;
+}
+
+
+int
+UmfpackGenLinSolver::solveCondensed(void)
+{
+    const double *Ax = &(theSOE->Ax[0]);
+    double *X = &(theSOE->X(0));
+    const double *B = &(theSOE->B(0));
+
+    // refactor Kii only if the linear part of A has changed
+    bool changed = (KiiNumeric == 0);
+    int loc = 0;
+    for (int j=0; j<(int)KiiLoc.size() && changed == false; j++) 
+	if (linearAx[loc++] != Ax[KiiLoc[j]]) changed = true;
+    for (int j=0; j<(int)locIB.size() && changed == false; j++) 
+	if (linearAx[loc++] != Ax[locIB[j]]) changed = true;
+    for (int j=0; j<(int)locBI.size() && changed == false; j++) 
+	if (linearAx[loc++] != Ax[locBI[j]]) changed = true;
+
+    if (changed == true && this->factorCondensed() != 0)
+	return -1;
+
+    int status;
+    if (numB > 0) {
+
+	// y = Kii^-1 Bi
+	for (int i=0; i<numI; i++)
+	    workI[i] = B[eqnI[i]];
+	status = umfpack_di_solve(UMFPACK_A, &KiiP[0], &KiiI[0], &KiiX[0], &workI2[0],
+				  &workI[0], KiiNumeric, Control, Info);
+	if (status != UMFPACK_OK)
+	    return -1;
+
+	// S = Kbb + S0, g = Bb - Kbi y
+	for (int j=0; j<numB*numB; j++)
+	    S[j] = S0[j];
+	for (int j=0; j<(int)locBB.size(); j++)
+	    S[colBB[j]*numB + rowBB[j]] += Ax[locBB[j]];
+
+	for (int j=0; j<numB; j++)
+	    workB[j] = B[eqnB[j]];
+	for (int j=0; j<(int)locBI.size(); j++)
+	    workB[rowBI[j]] -= Ax[locBI[j]] * workI2[colBI[j]];
+
+	// Xb = S^-1 g
+	int nrhs = 1;
+	int ldA = numB;
+	int ldB = numB;
+	int info = 0;
+#ifdef _WIN32
+	DGESV(&numB,&nrhs,&S[0],&ldA,&iPiv[0],&workB[0],&ldB,&info);
+#else
+	dgesv_(&numB,&nrhs,&S[0],&ldA,&iPiv[0],&workB[0],&ldB,&info);
+#endif
+	if (info != 0) {
+	    opserr<<"WARNING: factoring the condensed matrix returns "<<info<<" -- Umfpackgenlinsolver::solve\n";
+	    return -1;
+	}
+    }
+
+    // Xi = Kii^-1 (Bi - Kib Xb)
+    for (int i=0; i<numI; i++)
+	workI[i] = B[eqnI[i]];
+    for (int j=0; j<(int)locIB.size(); j++)
+	workI[rowIB[j]] -= Ax[locIB[j]] * workB[colIB[j]];
+
+    status = umfpack_di_solve(UMFPACK_A, &KiiP[0], &KiiI[0], &KiiX[0], &workI2[0],
+			      &workI[0], KiiNumeric, Control, Info);
+    if (status != UMFPACK_OK)
+	return -1;
+
+    for (int i=0; i<numI; i++)
+	X[eqnI[i]] = workI2[i];
+    for (int j=0; j<numB; j++)
+	X[eqnB[j]] = workB[j];
+
+    return 0;
+}
+
+
 int
 UmfpackGenLinSolver::setLinearSOE(UmfpackGenLinSOE &theLinearSOE)
 {
@@ -143,6 +513,36 @@ UmfpackGenLinSolver::setLinearSOE(UmfpackGenLinSOE &theLinearSOE)
     return 0;
 }
 
+// the numeric factors are freed after each solve, so the peak of the last
+// factorization (which includes the symbolic analysis) is reported
+size_t
+UmfpackGenLinSolver::getMemoryUsage(void)
+{
+    size_t result = 0;
+    double unit = Info[UMFPACK_SIZE_OF_UNIT];
+    if (Symbolic != 0 && unit > 0.0) {
+	if (Info[UMFPACK_PEAK_MEMORY] > 0.0)
+	    result += (size_t)(Info[UMFPACK_PEAK_MEMORY]*unit);
+	else if (Info[UMFPACK_SYMBOLIC_SIZE] > 0.0)
+	    result += (size_t)(Info[UMFPACK_SYMBOLIC_SIZE]*unit);
+    }
+
+    if (condense) {
+	result += (localEqn.capacity() + eqnI.capacity() + eqnB.capacity() +
+		   KiiP.capacity() + KiiI.capacity() + KiiLoc.capacity() +
+		   locIB.capacity() + locBI.capacity() + locBB.capacity() +
+		   rowIB.capacity() + colIB.capacity() + rowBI.capacity() +
+		   colBI.capacity() + rowBB.capacity() + colBB.capacity() +
+		   iPiv.capacity())*sizeof(int);
+	result += isB.capacity();
+	result += (KiiX.capacity() + linearAx.capacity() + S0.capacity() +
+		   S.capacity() + workI.capacity() + workI2.capacity() +
+		   workB.capacity())*sizeof(double);
+    }
+
+    return result;
+}
+
 int
 UmfpackGenLinSolver::sendSelf(int cTag, Channel &theChannel)
 {
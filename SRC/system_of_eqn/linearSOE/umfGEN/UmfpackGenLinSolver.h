@@ -30,6 +30,12 @@
 // UmfpackGenLinSolver. It solves the UmfpackGenLinSOEobject by calling
 // UMFPACK5.7.1 routines.
 //
+// With the condense option the equations that only the elements with a
+// constant tangent (see Element::hasConstantTangent()) contribute to are
+// condensed out: their block Kii is factored once and kept until its
+// values change, and each solve only factors the dense Schur complement
+// of the remaining (nonlinear) equations, S = Kbb - Kbi Kii^-1 Kib.
+//
 // What: "@(#) UmfpackGenLinSolver.h, revA"
 
 #ifndef UmfpackGenLinSolver_h
@@ -37,19 +43,22 @@
 
 #include <LinearSOESolver.h>
 #include "../../../../OTHER/UMFPACK/umfpack.h"
+#include <vector>
 
 class UmfpackGenLinSOE;
 
 class UmfpackGenLinSolver : public LinearSOESolver
 {
   public:
-    UmfpackGenLinSolver();     
+    UmfpackGenLinSolver(bool condense = false);     
     ~UmfpackGenLinSolver();
 
     int solve(void);
+    int solveMultiple(int numRHS, double *BX);
     int setSize(void);
 
     int setLinearSOE(UmfpackGenLinSOE &theSOE);
+    size_t getMemoryUsage(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -58,9 +67,31 @@ class UmfpackGenLinSolver : public LinearSOESolver
   protected:
 
   private:
+    int setSizeCondensed(void);
+    int solveCondensed(void);
+    int factorCondensed(void);
+    void clearCondensed(void);
+
     void *Symbolic;
     double Control[UMFPACK_CONTROL], Info[UMFPACK_INFO];
     UmfpackGenLinSOE *theSOE;
+
+    // data for the condensed solve; equations are split into the linear
+    // set i (condensed out) and the remaining set b
+    bool condense;
+    int numI, numB;
+    std::vector<int> localEqn;        // eqn -> position in the i or b set
+    std::vector<char> isB;            // eqn -> 1 if in the b set
+    std::vector<int> eqnI, eqnB;      // position in set -> eqn
+    std::vector<int> KiiP, KiiI, KiiLoc; // Kii in column storage, KiiLoc = location in Ax
+    std::vector<double> KiiX;
+    std::vector<int> locIB, locBI, locBB; // locations in Ax of the Kib, Kbi and Kbb entries
+    std::vector<int> rowIB, colIB, rowBI, colBI, rowBB, colBB; // their positions in the sets
+    std::vector<double> linearAx;     // Ax outside Kbb when Kii was last factored
+    void *KiiSymbolic, *KiiNumeric;
+    std::vector<double> S0;           // -Kbi Kii^-1 Kib, column major
+    std::vector<double> S, workI, workI2, workB;
+    std::vector<int> iPiv;
 };
 
 #endif
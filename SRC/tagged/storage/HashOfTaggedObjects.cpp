@@ -0,0 +1,274 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of the
+// HashOfTaggedObjects class.
+//
+// What: "@(#) HashOfTaggedObjects.cpp, revA"
+
+#include <TaggedObject.h>
+#include <HashOfTaggedObjects.h>
+#include <OPS_Globals.h>
+#include <algorithm>
+
+#define HASH_SLOT_EMPTY   -1
+#define HASH_SLOT_REMOVED -2
+#define HASH_MIN_SLOTS    16
+
+static inline unsigned int
+hashTag(int tag)
+{
+    unsigned int h = (unsigned int)tag * 2654435761u;
+    return h ^ (h >> 16);
+}
+
+static bool
+lessTag(TaggedObject *a, TaggedObject *b)
+{
+    return a->getTag() < b->getTag();
+}
+
+
+HashOfTaggedObjects::HashOfTaggedObjects()
+:numComponents(0), numUsedSlots(0), sorted(true), myIter(*this)
+{
+    Slot empty = {0, HASH_SLOT_EMPTY};
+    theSlots.assign(HASH_MIN_SLOTS, empty);
+}
+
+
+HashOfTaggedObjects::~HashOfTaggedObjects()
+{
+    this->clearAll();
+}
+
+
+int
+HashOfTaggedObjects::setSize(int newSize)
+{
+    if (newSize < 0)
+	return -1;
+
+    theObjects.reserve(newSize);
+    if (2*newSize > int(theSlots.size()))
+	this->rehash(newSize);
+
+    return 0;
+}
+
+
+bool 
+HashOfTaggedObjects::addComponent(TaggedObject *newComponent)
+{
+    int tag = newComponent->getTag();
+
+    if (this->findSlot(tag) >= 0) {
+      opserr << "HashOfTaggedObjects::addComponent - not adding as one with similar tag exists, tag: " <<
+	tag << "\n";
+      return false;
+    }
+
+    // adding in increasing tag order, the usual case, keeps the array sorted
+    if (sorted == true && !theObjects.empty() && theObjects.back()->getTag() > tag)
+	sorted = false;
+
+    // grow first, so the rehash does not see the new object and insertSlot
+    // gives it its only slot
+    if (2*(numUsedSlots+1) > int(theSlots.size())) 
+	this->rehash(numComponents+1);
+
+    int index = int(theObjects.size());
+    theObjects.push_back(newComponent);
+    this->insertSlot(tag, index);
+    numComponents++;
+
+    return true;
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::removeComponent(int tag)
+{
+    int slot = this->findSlot(tag);
+    if (slot < 0) // the object has not been added
+	return 0;
+
+    // leave a hole, an iteration under way simply steps over it
+    int index = theSlots[slot].index;
+    TaggedObject *removed = theObjects[index];
+    theObjects[index] = 0;
+    theSlots[slot].index = HASH_SLOT_REMOVED;
+    numComponents--;
+    sorted = false;
+
+    return removed;
+}
+
+
+int
+HashOfTaggedObjects::getNumComponents(void) const
+{
+    return numComponents;
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::getComponentPtr(int tag)
+{
+    int slot = this->findSlot(tag);
+    if (slot < 0) 
+	return 0;
+
+    return theObjects[theSlots[slot].index];
+}
+
+
+TaggedObjectIter &
+HashOfTaggedObjects::getComponents()
+{
+    myIter.reset();
+    return myIter;
+}
+
+
+TaggedObjectStorage *
+HashOfTaggedObjects::getEmptyCopy(void)
+{
+    HashOfTaggedObjects *theCopy = new HashOfTaggedObjects();
+    
+    if (theCopy == 0) {
+      opserr << "HashOfTaggedObjects::getEmptyCopy-out of memory\n";
+    }	
+
+    return theCopy;
+}
+
+
+void
+HashOfTaggedObjects::clearAll(bool invokeDestructor)
+{
+    // invoke the destructor on all the tagged objects stored
+    if (invokeDestructor == true) {
+	for (size_t i=0; i<theObjects.size(); i++)
+	    if (theObjects[i] != 0)
+		delete theObjects[i];
+    }
+
+    // now clear the array & the table of all entries
+    theObjects.clear();
+    Slot empty = {0, HASH_SLOT_EMPTY};
+    theSlots.assign(HASH_MIN_SLOTS, empty);
+    numComponents = 0;
+    numUsedSlots = 0;
+    sorted = true;
+}
+
+
+void
+HashOfTaggedObjects::Print(OPS_Stream &s, int flag)
+{
+    this->prepareIteration();
+
+    s << "\nnumComponents: " << this->getNumComponents() << endln;
+    // go through the array invoking Print on non-zero entries
+    for (size_t i=0; i<theObjects.size(); i++)
+	if (theObjects[i] != 0)
+	    theObjects[i]->Print(s, flag);
+}
+
+
+// returns the slot holding tag, -1 if there is none; there is always an
+// empty slot as the table is kept at most half full
+int
+HashOfTaggedObjects::findSlot(int tag) const
+{
+    unsigned int mask = (unsigned int)theSlots.size() - 1;
+    unsigned int i = hashTag(tag) & mask;
+
+    while (theSlots[i].index != HASH_SLOT_EMPTY) {
+	if (theSlots[i].index >= 0 && theSlots[i].tag == tag)
+	    return int(i);
+	i = (i+1) & mask;
+    }
+
+    return -1;
+}
+
+
+// the table must have room for the slot, addComponent() grows it first
+void
+HashOfTaggedObjects::insertSlot(int tag, int index)
+{
+    unsigned int mask = (unsigned int)theSlots.size() - 1;
+    unsigned int i = hashTag(tag) & mask;
+
+    while (theSlots[i].index >= 0)
+	i = (i+1) & mask;
+
+    if (theSlots[i].index == HASH_SLOT_EMPTY)
+	numUsedSlots++;
+    theSlots[i].tag = tag;
+    theSlots[i].index = index;
+}
+
+
+// rebuilds the table for the objects now in the array, dropping the
+// slots of removed objects; the array itself is not touched
+void
+HashOfTaggedObjects::rehash(int minCapacity)
+{
+    int numSlots = HASH_MIN_SLOTS;
+    while (numSlots < 2*minCapacity)
+	numSlots *= 2;
+
+    Slot empty = {0, HASH_SLOT_EMPTY};
+    theSlots.assign(numSlots, empty);
+    numUsedSlots = 0;
+
+    unsigned int mask = (unsigned int)numSlots - 1;
+    for (size_t j=0; j<theObjects.size(); j++) {
+	if (theObjects[j] == 0)
+	    continue;
+	int tag = theObjects[j]->getTag();
+	unsigned int i = hashTag(tag) & mask;
+	while (theSlots[i].index != HASH_SLOT_EMPTY)
+	    i = (i+1) & mask;
+	theSlots[i].tag = tag;
+	theSlots[i].index = int(j);
+	numUsedSlots++;
+    }
+}
+
+
+// invoked as an iteration starts: squeezes out the holes & sorts the
+// array by tag if need be, then points the table at the new locations
+void
+HashOfTaggedObjects::prepareIteration(void)
+{
+    if (sorted == true)
+	return;
+
+    theObjects.erase(std::remove(theObjects.begin(), theObjects.end(),
+				 (TaggedObject *)0), theObjects.end());
+    std::sort(theObjects.begin(), theObjects.end(), lessTag);
+
+    this->rehash(numComponents);
+    sorted = true;
+}
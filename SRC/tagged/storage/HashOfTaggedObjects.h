@@ -0,0 +1,83 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+#ifndef HashOfTaggedObjects_h
+#define HashOfTaggedObjects_h
+
+// Description: This file contains the class definition for
+// HashOfTaggedObjects. HashOfTaggedObjects is a storage class. The class
+// is responsible for holding and providing access to objects of type
+// TaggedObject. The pointers are held in one contiguous array; an open
+// addressing hash table maps each tag to its place in that array, so a
+// lookup costs a probe or two whatever the number of objects. Iteration
+// walks the array in increasing tag order, as it does for
+// MapOfTaggedObjects: the array is only sorted (and emptied of the holes
+// left by removed objects) when an iteration starts after objects have
+// been added out of order or removed.
+//
+// What: "@(#) HashOfTaggedObjects.h, revA"
+
+#include <TaggedObjectStorage.h>
+#include <HashOfTaggedObjectsIter.h>
+#include <vector>
+
+class HashOfTaggedObjects : public TaggedObjectStorage
+{
+  public:
+    HashOfTaggedObjects();
+    ~HashOfTaggedObjects();    
+
+    // public methods to populate a domain
+    int  setSize(int newSize);
+    bool addComponent(TaggedObject *newComponent);
+    TaggedObject *removeComponent(int tag);    
+    int getNumComponents(void) const;
+    
+    TaggedObject     *getComponentPtr(int tag);
+    TaggedObjectIter &getComponents();
+
+    TaggedObjectStorage *getEmptyCopy(void);
+    void clearAll(bool invokeDestructor = true);
+    
+    void Print(OPS_Stream &s, int flag =0);
+    friend class HashOfTaggedObjectsIter;
+    
+  protected:    
+    
+  private:
+    struct Slot {
+      int tag;
+      int index;       // location in theObjects, EMPTY or REMOVED
+    };
+
+    int findSlot(int tag) const;
+    void insertSlot(int tag, int index);
+    void rehash(int minCapacity);
+    void prepareIteration(void);
+
+    std::vector<TaggedObject *> theObjects; // 0 where an object was removed
+    std::vector<Slot> theSlots;              // size is a power of 2
+    int numComponents;
+    int numUsedSlots;                        // slots not EMPTY
+    bool sorted;                             // theObjects in tag order, no holes
+    HashOfTaggedObjectsIter myIter;          // the iter for this object
+};
+
+#endif
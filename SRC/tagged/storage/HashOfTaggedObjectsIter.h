@@ -0,0 +1,48 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+#ifndef HashOfTaggedObjectsIter_h
+#define HashOfTaggedObjectsIter_h
+
+// Description: This file contains the class definition for
+// HashOfTaggedObjectsIter. A HashOfTaggedObjectsIter is an iter for
+// returning the TaggedObjects of a storage object of type
+// HashOfTaggedObjects. Objects removed, and objects added, while an
+// iteration is under way are skipped, respectively returned.
+
+#include <TaggedObjectIter.h>
+
+class HashOfTaggedObjects;
+
+class HashOfTaggedObjectsIter: public TaggedObjectIter
+{
+  public:
+    HashOfTaggedObjectsIter(HashOfTaggedObjects &theComponents);
+    virtual ~HashOfTaggedObjectsIter();
+    
+    virtual void reset(void);
+    virtual TaggedObject *operator()(void);
+    
+  private:
+    HashOfTaggedObjects *theStorage;
+    int currentIndex;
+};
+
+#endif
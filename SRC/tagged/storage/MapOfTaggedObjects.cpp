@@ -200,6 +200,28 @@ MapOfTaggedObjects::clearAll(bool invokeDestructor)
     theMap.clear();
 }
 
+void
+MapOfTaggedObjects::swap(MapOfTaggedObjects &other)
+{
+    theMap.swap(other.theMap);
+}
+
+std::vector<MapOfTaggedObjects *> &
+MapOfTaggedObjects::getModelStorages(void)
+{
+    // function static so the storages can register during static
+    // initialization, whatever the order of the translation units
+    static std::vector<MapOfTaggedObjects *> theModelStorages;
+    return theModelStorages;
+}
+
+bool
+MapOfTaggedObjects::addModelStorage(MapOfTaggedObjects &theStorage)
+{
+    getModelStorages().push_back(&theStorage);
+    return true;
+}
+
 void
 MapOfTaggedObjects::Print(OPS_Stream &s, int flag)
 {
@@ -43,6 +43,7 @@
 
 #include <TaggedObjectStorage.h>
 #include <MapOfTaggedObjectsIter.h>
+#include <vector>
 
 class MapOfTaggedObjects : public TaggedObjectStorage
 {
@@ -64,6 +65,15 @@ class MapOfTaggedObjects : public TaggedObjectStorage
     
     TaggedObjectStorage *getEmptyCopy(void);
     void clearAll(bool invokeDestructor = true);
+
+    // exchanges the stored objects with those of other, without copying
+    void swap(MapOfTaggedObjects &other);
+
+    // the file-static storages of the modelling objects (materials,
+    // sections, time series, ...) register here, so the interpreter
+    // can swap all of them when it switches between models
+    static bool addModelStorage(MapOfTaggedObjects &theStorage);
+    static std::vector<MapOfTaggedObjects *> &getModelStorages(void);
     
     void Print(OPS_Stream &s, int flag =0);
     friend class MapOfTaggedObjectsIter;
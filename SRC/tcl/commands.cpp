@@ -48,6 +48,16 @@ extern "C" {
 #include <TclModelBuilder.h>
 #include <Matrix.h>
 #include <iostream>
+
+#if !defined(_WIN32) && !defined(_PARALLEL_PROCESSING) && !defined(_PARALLEL_INTERPRETERS)
+#define _OPS_BATCH_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <errno.h>
+#endif
+
 #include <set>
 #include <algorithm>
 
@@ -185,6 +195,11 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 #include <TransformationConstraintHandler.h>
 
 extern void* OPS_AutoConstraintHandler(void);
+extern void* OPS_SparseKrylovSolver(void);
+extern void* OPS_SparseSPDLinSolver(void);
+extern void* OPS_MatrixFreeLinSolver(void);
+extern void* OPS_BlockSparseLinSolver(void);
+extern void* OPS_AutoLinearSOE(void);
 
 // numberers
 #include <PlainNumberer.h>
@@ -213,11 +228,13 @@ extern void* OPS_AutoConstraintHandler(void);
 
 extern void *OPS_NewtonRaphsonAlgorithm(void);
 extern void *OPS_ExpressNewton(void);
+extern void *OPS_AdaptiveNewton(void);
 extern void *OPS_ModifiedNewton(void);
 extern void *OPS_NewtonHallM(void);
 
 extern void *OPS_Newmark(void);
 extern void *OPS_StagedNewmark(void);
+extern void *OPS_ImplicitExplicit(void);
 extern void *OPS_GimmeMCK(void);
 //extern void *OPS_HarmonicSteadyState(void);
 extern void *OPS_AlphaOS(void);
@@ -258,7 +275,10 @@ extern void *OPS_WilsonTheta(void);
 // for response spectrum analysis
 extern int OPS_DomainModalProperties(void);
 extern int OPS_ResponseSpectrumAnalysis(void);
+extern int OPS_ModalTransientAnalysis(void);
+extern int OPS_FrequencyDomainAnalysis(void);
 extern int OPS_sdfResponse(void);
+extern int OPS_sdfSpectra(void);
 
 extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 
@@ -275,6 +295,11 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 // analysis
 #include <StaticAnalysis.h>
 #include <DirectIntegrationAnalysis.h>
+#include <StepRetryPolicy.h>
+#include <AnalysisCheckpoint.h>
+#include <CheckpointDatastore.h>
+#include <MemoryDatastore.h>
+#include <ExplicitDynamicAnalysis.h>
 #include <VariableTimeStepDirectIntegrationAnalysis.h>
 
 #include <PFEMAnalysis.h>
@@ -330,6 +355,10 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 #include <CuSPSolver.h>
 #endif
 
+#ifdef _CUDSS
+#include <CuDSSSolver.h>
+#endif
+
 #ifdef _CULAS4
 #include <CulaSparseSolverS4.h>
 #endif
@@ -361,6 +390,7 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 #include <SparseGenRowLinSOE.h>
 #include <SymSparseLinSOE.h>
 #include <SymSparseLinSolver.h>
+#include <SparseKrylovSolver.h>
 #include <UmfpackGenLinSOE.h>
 #include <UmfpackGenLinSolver.h>
 #include <EigenSOE.h>
@@ -375,6 +405,7 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 #include <SymBandEigenSolver.h>
 #include <FullGenEigenSOE.h>
 #include <FullGenEigenSolver.h>
+#include <DampedArpackSOE.h>
 
 #ifdef _CUDA
 #include <BandGenLinSOE_Single.h>
@@ -385,6 +416,7 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 // graph
 #include <RCM.h>
 #include <AMDNumberer.h>
+#include <NestedDissectionNumberer.h>
 
 #include <ErrorHandler.h>
 #include <ConsoleErrorHandler.h>
@@ -474,6 +506,8 @@ int OPS_MAIN_DOMAIN_PARTITION_ID =0;
 DomainPartitioner *OPS_DOMAIN_PARTITIONER =0;
 GraphPartitioner  *OPS_GRAPH_PARTITIONER =0;
 LoadBalancer      *OPS_BALANCER = 0;
+int OPS_BALANCE_COMMITS = 0;         // commits between balance checks, 0 none
+double OPS_BALANCE_RATIO = 0.0;
 FEM_ObjectBroker  *OPS_OBJECT_BROKER =0;
 MachineBroker     *OPS_MACHINE =0;
 Channel          **OPS_theChannels = 0;
@@ -549,8 +583,15 @@ EigenSOE *theEigenSOE =0;
 StaticAnalysis *theStaticAnalysis = 0;
 DirectIntegrationAnalysis *theTransientAnalysis = 0;
 VariableTimeStepDirectIntegrationAnalysis *theVariableTimeStepTransientAnalysis = 0;
+StepRetryPolicy *theRetryPolicy = 0;
+static AnalysisCheckpoint *theCheckpoint = 0;
+static ExplicitDynamicAnalysis *theExplicitAnalysis = 0;
 int numEigen = 0;
 
+// set by retryPolicy while the algorithm & test of a rung are built
+static EquiSolnAlgo **theRungAlgorithm = 0;
+static ConvergenceTest **theRungTest = 0;
+
 static PFEMAnalysis* thePFEMAnalysis = 0;
 
 // AddingSensitivity:BEGIN /////////////////////////////////////////////
@@ -858,6 +899,9 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);    
     Tcl_CreateCommand(interp, "reset", &resetModel,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+
+    Tcl_CreateCommand(interp, "batchAnalysis", &batchAnalysis,
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
 	
     Tcl_CreateCommand(interp, "initialize", &initializeAnalysis,
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);        
@@ -901,6 +945,12 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "test", &specifyCTest, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);    
+    Tcl_CreateCommand(interp, "retryPolicy", &specifyRetryPolicy, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "checkpoint", &specifyCheckpoint, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+    Tcl_CreateCommand(interp, "criticalTimeStep", &getCriticalTimeStep, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "testNorm", &getCTestNorms, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "testNorms", &getCTestNorms, 
@@ -922,6 +972,10 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     Tcl_CreateCommand(interp, "responseSpectrumAnalysis", &responseSpectrumAnalysis,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    Tcl_CreateCommand(interp, "modalTransient", &modalTransientAnalysis,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    Tcl_CreateCommand(interp, "frequencyAnalysis", &frequencyDomainAnalysis,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     Tcl_CreateCommand(interp, "video", &videoPlayer, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);       
     Tcl_CreateCommand(interp, "remove", &removeObject, 
@@ -1066,6 +1120,8 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 
     Tcl_CreateCommand(interp, "sdfResponse", &sdfResponse, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "sdfSpectra", &sdfSpectra, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
 
     Tcl_CreateCommand(interp, "sectionForce", &sectionForce, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
@@ -1449,6 +1505,10 @@ wipeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   if (theDatabase != 0)
     delete theDatabase;
 
+  if (theCheckpoint != 0)
+    delete theCheckpoint;
+  theCheckpoint = 0;
+
   theDomain.clearAll();
   OPS_clearAllUniaxialMaterial();
   OPS_clearAllNDMaterial();
@@ -1517,6 +1577,11 @@ wipeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
   }
 #endif
 
+  // an existing analysis deletes the retry policy in clearAll()
+  if (theRetryPolicy != 0 && theStaticAnalysis == 0 && theTransientAnalysis == 0)
+    delete theRetryPolicy;
+  theRetryPolicy = 0;
+
   if (theStaticAnalysis != 0) {
       theStaticAnalysis->clearAll();
       delete theStaticAnalysis;
@@ -1527,6 +1592,11 @@ wipeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
       delete theTransientAnalysis;  
   }
 
+  if (theExplicitAnalysis != 0) {
+      delete theExplicitAnalysis;
+      theExplicitAnalysis = 0;
+  }
+
   // NOTE : DON'T do the above on theVariableTimeStepAnalysis
   // as it and theTransientAnalysis are one in the same
 
@@ -1621,6 +1691,209 @@ resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 	return TCL_OK;
 }
 
+//
+// batchAnalysis <-workers $n> <-var $name> <-dir $prefix> $numRuns $script
+//
+// evaluates script once for each run, with the variable (runID by default)
+// set to 0 through numRuns-1, and returns the list of run results: 0 if the
+// script ran and returned 0 or nothing, 1 if it raised an error, 2 otherwise.
+// On POSIX systems every run is done in a forked copy of the process, so
+// the model, and any analysis already done, is built once and shared; up to
+// n (the number of processors by default) runs are done at a time. Recorders
+// already defined are not written to by the runs, the script should create
+// its own; with -dir each run works in its own directory prefix$runID. Where
+// fork() cannot be used the runs are done one after the other in this
+// process: the recorders already defined are set aside, and after each run
+// its recorders are removed and the domain is restored to the state saved
+// before the first run; -dir is ignored.
+//
+
+static int
+batchRun(Tcl_Interp *interp, TCL_Char *var, int runID, TCL_Char *script)
+{
+  char buffer[32];
+  sprintf(buffer, "%d", runID);
+  if (Tcl_SetVar(interp, var, buffer, TCL_GLOBAL_ONLY) == NULL)
+    return 1;
+
+  if (Tcl_Eval(interp, script) != TCL_OK) {
+    opserr << "WARNING batchAnalysis - run " << runID << " failed: ";
+    opserr << Tcl_GetStringResult(interp) << endln;
+    return 1;
+  }
+
+  const char *res = Tcl_GetStringResult(interp);
+  int value = 0;
+  if (res[0] != '\0' && (Tcl_GetInt(interp, res, &value) != TCL_OK || value != 0))
+    return 2;
+
+  return 0;
+}
+
+int 
+batchAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  int numWorkers = 0;
+  TCL_Char *var = "runID";
+  TCL_Char *dirPrefix = 0;
+
+  int loc = 1;
+  while (loc < argc-2) {
+    if (strcmp(argv[loc],"-workers") == 0 && loc+1 < argc-2) {
+      if (Tcl_GetInt(interp, argv[loc+1], &numWorkers) != TCL_OK) {
+	opserr << "WARNING batchAnalysis - invalid number of workers " << argv[loc+1] << endln;
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else if (strcmp(argv[loc],"-var") == 0 && loc+1 < argc-2) {
+      var = argv[loc+1];
+      loc += 2;
+    } else if (strcmp(argv[loc],"-dir") == 0 && loc+1 < argc-2) {
+      dirPrefix = argv[loc+1];
+      loc += 2;
+    } else {
+      opserr << "WARNING batchAnalysis - unknown option " << argv[loc] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  int numRuns;
+  if (loc != argc-2 || Tcl_GetInt(interp, argv[loc], &numRuns) != TCL_OK || numRuns < 0) {
+    opserr << "WARNING want - batchAnalysis <-workers $n> <-var $name> <-dir $prefix> $numRuns $script\n";
+    return TCL_ERROR;
+  }
+  TCL_Char *script = argv[loc+1];
+
+  ID status(numRuns);
+
+#ifdef _OPS_BATCH_FORK
+
+  if (numWorkers <= 0)
+    numWorkers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (numWorkers <= 0)
+    numWorkers = 1;
+
+  // anything buffered now would otherwise be written again by every run
+  theDomain.flushRecorders();
+  opserr.flush();
+  fflush(NULL);
+
+  pid_t *pids = new pid_t[numRuns];
+  for (int i=0; i<numRuns; i++)
+    pids[i] = 0;
+  int numRunning = 0;
+  int next = 0;
+  int numDone = 0;
+
+  while (numDone < numRuns) {
+
+    while (next < numRuns && numRunning < numWorkers) {
+      pid_t pid = fork();
+      if (pid == 0) {
+	// the run; the recorders belong to the parent
+	theDomain.releaseRecorders();
+
+	int res = 0;
+	if (dirPrefix != 0) {
+	  char *dir = new char[strlen(dirPrefix) + 32];
+	  sprintf(dir, "%s%d", dirPrefix, next);
+	  if ((mkdir(dir, 0777) != 0 && errno != EEXIST) || chdir(dir) != 0) {
+	    opserr << "WARNING batchAnalysis - could not work in directory " << dir << endln;
+	    res = 1;
+	  }
+	  delete [] dir;
+	}
+
+	if (res == 0)
+	  res = batchRun(interp, var, next, script);
+
+	theDomain.removeRecorders();
+	opserr.flush();
+	fflush(NULL);
+	_exit(res);
+      }
+
+      if (pid < 0) {
+	opserr << "WARNING batchAnalysis - fork failed for run " << next << endln;
+	status(next) = 1;
+	numDone++;
+      } else {
+	pids[next] = pid;
+	numRunning++;
+      }
+      next++;
+    }
+
+    if (numRunning == 0)
+      continue;
+
+    int exitStatus;
+    pid_t pid = wait(&exitStatus);
+    if (pid < 0)
+      break;
+
+    for (int i=0; i<next; i++)
+      if (pids[i] == pid && pid != 0) {
+	if (WIFEXITED(exitStatus))
+	  status(i) = WEXITSTATUS(exitStatus);
+	else
+	  status(i) = 1;
+	pids[i] = 0;
+	numRunning--;
+	numDone++;
+      }
+  }
+
+  delete [] pids;
+
+#else
+
+  if (dirPrefix != 0)
+    opserr << "WARNING batchAnalysis - -dir " << dirPrefix << " is ignored, the runs are not forked\n";
+
+  // what a forked run leaves untouched is kept here: the committed state,
+  // in memory, and the recorders, set aside
+  MemoryDatastore theSnapshot(theDomain, theBroker);
+  int snapshotTag = theDomain.getCommitTag();
+  if (theSnapshot.commitState(snapshotTag) < 0) {
+    opserr << "WARNING batchAnalysis - failed to save the state the runs start from\n";
+    return TCL_ERROR;
+  }
+
+  theDomain.flushRecorders();
+  Recorder **keptRecorders = 0;
+  int numKept = 0;
+  theDomain.swapRecorders(keptRecorders, numKept);
+
+  for (int i=0; i<numRuns; i++) {
+    status(i) = batchRun(interp, var, i, script);
+
+    theDomain.removeRecorders();
+    if (theDomain.restoreState(theSnapshot, snapshotTag) < 0) {
+      opserr << "WARNING batchAnalysis - failed to restore the state after run " << i << endln;
+      for (int j=i+1; j<numRuns; j++)
+	status(j) = 1;
+      break;
+    }
+
+    // the analysis takes the restored state of the nodes, not the run's
+    theDomain.domainChange();
+  }
+
+  theDomain.swapRecorders(keptRecorders, numKept);
+
+#endif
+
+  char buffer[32];
+  Tcl_ResetResult(interp);
+  for (int i=0; i<numRuns; i++) {
+    sprintf(buffer, "%d ", status(i));
+    Tcl_AppendResult(interp, buffer, NULL);
+  }
+
+  return TCL_OK;
+}
+
 int
 initializeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -1853,10 +2126,12 @@ partitionModel(int eleTag)
 
   // create a partitioner & partition the domain
   if (OPS_DOMAIN_PARTITIONER == 0) {
-    //      OPS_BALANCER = new ShedHeaviest();
     OPS_GRAPH_PARTITIONER  = new Metis;
-    //OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
-    OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+    if (OPS_BALANCE_COMMITS > 0) {
+      OPS_BALANCER = new ShedHeaviest();
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+    } else
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
     theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
   }
 
@@ -1868,6 +2143,9 @@ partitionModel(int eleTag)
     return result;
 
   OPS_PARTITIONED = true;
+
+  if (OPS_BALANCE_COMMITS > 0)
+    theDomain.setLoadBalancing(OPS_BALANCE_COMMITS, OPS_BALANCE_RATIO);
   
   DomainDecompositionAnalysis *theSubAnalysis;
   SubdomainIter &theSubdomains = theDomain.getSubdomains();
@@ -1911,11 +2189,22 @@ int
 opsPartition(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
 #ifdef _PARALLEL_PROCESSING
-  int eleTag;
-  if (argc == 2) {
-    if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
+  // partition <eleTag> <-balance numCommits maxOverMeanCost>
+  int eleTag = 0;
+  int argi = 1;
+  if (argi < argc && strcmp(argv[argi], "-balance") != 0) {
+    if (Tcl_GetInt(interp, argv[argi], &eleTag) != TCL_OK) {
       ;
     }
+    argi++;
+  }
+  if (argi < argc && strcmp(argv[argi], "-balance") == 0) {
+    if (argi+2 >= argc ||
+        Tcl_GetInt(interp, argv[argi+1], &OPS_BALANCE_COMMITS) != TCL_OK ||
+        Tcl_GetDouble(interp, argv[argi+2], &OPS_BALANCE_RATIO) != TCL_OK) {
+      opserr << "WARNING partition <eleTag> -balance numCommits ratio\n";
+      return TCL_ERROR;
+    }
   }
   partitionModel(eleTag);
 #endif
@@ -1967,6 +2256,25 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
       }
     }
     result = thePFEMAnalysis->analyze(flush);
+  } else if (theExplicitAnalysis != 0) {
+    if (argc < 3) {
+      opserr << "WARNING explicit analysis: analysis numIncr? deltaT? <-noFlush>\n";
+      return TCL_ERROR;
+    }
+    int numIncr;
+    if (Tcl_GetInt(interp, argv[1], &numIncr) != TCL_OK)	
+      return TCL_ERROR;
+    double dT;
+    if (Tcl_GetDouble(interp, argv[2], &dT) != TCL_OK)	
+      return TCL_ERROR;
+
+    ops_Dt = dT;
+
+    bool flush = true;
+    if (argc > 3 && strcmp(argv[3], "-noFlush") == 0)
+      flush = false;
+
+    result = theExplicitAnalysis->analyze(numIncr, dT, flush);
   } else if (theTransientAnalysis != 0) {
     if (argc < 3) {
       opserr << "WARNING transient analysis: analysis numIncr? deltaT? <-noFlush>\n";
@@ -1983,9 +2291,13 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
     ops_Dt = dT;
 
     bool flush = true;
-    if (argc == 4) {
-      if (strcmp(argv[3], "-noFlush") == 0) {
-        flush = false;
+    bool resume = false;
+    if (argc == 4 || argc == 5) {
+      for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "-noFlush") == 0)
+          flush = false;
+        else if (strcmp(argv[i], "-resume") == 0)
+          resume = true;
       }
     }
 
@@ -1998,21 +2310,38 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
 	return TCL_ERROR;
       if (Tcl_GetInt(interp, argv[5], &Jd) != TCL_OK)	
 	return TCL_ERROR;
-      if (argc > 6) {
-        if (strcmp(argv[6], "-noFlush") == 0) {
-        flush = false;
-      }
+      double errorTol = 0.0;
+      for (int i = 6; i < argc; i++) {
+        if (strcmp(argv[i], "-noFlush") == 0) {
+          flush = false;
+        } else if (strcmp(argv[i], "-errorTol") == 0 && i+1 < argc) {
+          if (Tcl_GetDouble(interp, argv[++i], &errorTol) != TCL_OK)	
+            return TCL_ERROR;
+        }
       }
 
-      if (theVariableTimeStepTransientAnalysis != 0)
+      if (theVariableTimeStepTransientAnalysis != 0) {
+	theVariableTimeStepTransientAnalysis->setErrorTolerance(errorTol);
 	result =  theVariableTimeStepTransientAnalysis->analyze(numIncr, dT, dtMin, dtMax, Jd, flush);
-      else {
+      } else {
 	opserr << "WARNING analyze - no variable time step transient analysis object constructed\n";
 	return TCL_ERROR;
       }
 
     } else {
-      result = theTransientAnalysis->analyze(numIncr, dT, flush);
+      // pick up from the latest checkpoint the steps it already covers
+      if (resume == true) {
+	if (theCheckpoint == 0) {
+	  opserr << "WARNING analyze -resume - no checkpoint has been specified\n";
+	  return TCL_ERROR;
+	}
+	int numDone = theCheckpoint->resume(dT);
+	if (numDone < 0)
+	  return TCL_ERROR;
+	numIncr -= numDone;
+      }
+      if (numIncr > 0)
+	result = theTransientAnalysis->analyze(numIncr, dT, flush);
     }
 
   } else {
@@ -2473,6 +2802,9 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
     if ((strcmp(argv[1],"Transient") == 0) && (theTransientAnalysis != 0))
       return TCL_OK;
 
+    if ((strcmp(argv[1],"ExplicitDynamics") == 0) && (theExplicitAnalysis != 0))
+      return TCL_OK;
+
     //
     // analysis changing .. delete the old analysis
     //
@@ -2489,6 +2821,11 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	theVariableTimeStepTransientAnalysis = 0;
 	opserr << "WARNING: analysis .. TransientAnalysis already exists => wipeAnalysis not invoked, problems may arise\n";
     }
+
+    if (theExplicitAnalysis != 0) {
+	delete theExplicitAnalysis;
+	theExplicitAnalysis = 0;
+    }
     
     // check argv[1] for type of SOE and create it
     if (strcmp(argv[1],"Static") == 0) {
@@ -2542,6 +2879,8 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 					       *theSOE,
 					       *theStaticIntegrator,
 					       theTest);
+	if (theRetryPolicy != 0)
+	  theStaticAnalysis->setRetryPolicy(theRetryPolicy);
 
 	#ifdef _PARALLEL_INTERPRETERS
 	if (setMPIDSOEFlag) {
@@ -2689,7 +3028,10 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 							     theTest,
 							     numSubLevels,
 							     numSubSteps);
-	  ;
+	if (theRetryPolicy != 0)
+	  theTransientAnalysis->setRetryPolicy(theRetryPolicy);
+	if (theCheckpoint != 0)
+	  theTransientAnalysis->setCheckpoint(theCheckpoint);
 #ifdef _PARALLEL_INTERPRETERS
 	if (setMPIDSOEFlag) {
 	  ((MPIDiagonalSOE*) theSOE)->setAnalysisModel(*theAnalysisModel);
@@ -2773,6 +3115,10 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 
 	// set the pointer for variable time step analysis
 	theTransientAnalysis = theVariableTimeStepTransientAnalysis;
+	if (theRetryPolicy != 0)
+	  theTransientAnalysis->setRetryPolicy(theRetryPolicy);
+	if (theCheckpoint != 0)
+	  theTransientAnalysis->setCheckpoint(theCheckpoint);
 
 	#ifdef _RELIABILITY
 
@@ -2905,6 +3251,60 @@ specifyAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 // AddingSensitivity:END /////////////////////////////////
 #endif
 
+    } else if (strcmp(argv[1],"ExplicitDynamics") == 0) {
+	// analysis ExplicitDynamics <-alphaM $alphaM> <-subcycle $maxLevel> <-regions $tag1 ...> <-kernels>
+	// the handler, numberer, algorithm, system & integrator are not used
+	double alphaM = 0.0;
+	int maxLevel = 0;
+	bool useKernels = false;
+	ID regionTags(0);
+	for (int i=2; i<argc; i++) {
+	  if (strcmp(argv[i],"-alphaM") == 0 && i+1 < argc) {
+	    if (Tcl_GetDouble(interp, argv[++i], &alphaM) != TCL_OK) {
+	      opserr << "WARNING analysis ExplicitDynamics -alphaM $alphaM - invalid alphaM\n";
+	      return TCL_ERROR;
+	    }
+	  } else if (strcmp(argv[i],"-subcycle") == 0 && i+1 < argc) {
+	    if (Tcl_GetInt(interp, argv[++i], &maxLevel) != TCL_OK) {
+	      opserr << "WARNING analysis ExplicitDynamics -subcycle $maxLevel - invalid maxLevel\n";
+	      return TCL_ERROR;
+	    }
+	  } else if (strcmp(argv[i],"-regions") == 0) {
+	    int tag;
+	    while (i+1 < argc && Tcl_GetInt(interp, argv[i+1], &tag) == TCL_OK) {
+	      regionTags[regionTags.Size()] = tag;
+	      i++;
+	    }
+	    Tcl_ResetResult(interp);
+	  } else if (strcmp(argv[i],"-kernels") == 0) {
+	    useKernels = true;
+	  } else {
+	    opserr << "WARNING analysis ExplicitDynamics - unknown option " << argv[i] << endln;
+	    return TCL_ERROR;
+	  }
+	}
+
+#ifdef _PARALLEL_PROCESSING
+	if (OPS_PARTITIONED == true && OPS_NUM_SUBDOMAINS > 1) {
+	  opserr << "WARNING analysis ExplicitDynamics - not available for a partitioned domain\n";
+	  return TCL_ERROR;
+	}
+#endif
+
+	theExplicitAnalysis = new ExplicitDynamicAnalysis(theDomain, alphaM);
+	if ((maxLevel != 0 || regionTags.Size() != 0) &&
+	    theExplicitAnalysis->setSubcycling(maxLevel, regionTags) < 0) {
+	  delete theExplicitAnalysis;
+	  theExplicitAnalysis = 0;
+	  return TCL_ERROR;
+	}
+	if (useKernels == true && theExplicitAnalysis->setForceKernels(true) < 0) {
+	  delete theExplicitAnalysis;
+	  theExplicitAnalysis = 0;
+	  return TCL_ERROR;
+	}
+	return TCL_OK;
+
     } else {
 	opserr << "WARNING No Analysis type exists (Static Transient only) \n";
 	return TCL_ERROR;
@@ -3213,6 +3613,22 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   }
 #endif // _CUSP
 
+#ifdef _CUDSS
+  else if ((strcmp(argv[1],"CuDSS")==0)) {
+    // system CuDSS <-sym> <-spd>
+    int matrixType = 0;
+    for (int count = 2; count < argc; count++) {
+      if (strcmp(argv[count],"-sym") == 0)
+	matrixType = 1;
+      else if (strcmp(argv[count],"-spd") == 0)
+	matrixType = 2;
+    }
+
+    CuDSSSolver *theSolver = new CuDSSSolver(matrixType);
+    theSOE = new SparseGenRowLinSOE(*theSolver);
+  }
+#endif // _CUDSS
+
 #if defined(_CULAS4) || defined(_CULAS5)
   // CULA SPARSE
   else if ((strcmp(argv[1],"CulaSparse")==0))
@@ -3393,6 +3809,41 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   }
 
   
+  else if (strcmp(argv[1],"SupernodalSPD") == 0) {
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_SparseSPDLinSolver();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
+  else if (strcmp(argv[1],"Krylov") == 0) {
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_SparseKrylovSolver();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
+  else if (strcmp(argv[1],"MatrixFree") == 0) {
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_MatrixFreeLinSolver();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
+  else if (strcmp(argv[1],"BlockSparse") == 0) {
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_BlockSparseLinSolver();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
+  else if (strcmp(argv[1],"Auto") == 0) {
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_AutoLinearSOE();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
   else if ((strcmp(argv[1],"SparseSPD") == 0) || (strcmp(argv[1],"SparseSYM") == 0)) {
     // now must determine the type of solver to create from rest of args
 
@@ -3415,6 +3866,7 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     int factLVALUE = 10;
     int factorOnce=0;
     int printTime = 0;
+    bool condense = false;
     int count = 2;
 
     while (count < argc) {
@@ -3426,11 +3878,13 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 	factorOnce = 1;
       } else if ((strcmp(argv[count],"-printTime") == 0) || (strcmp(argv[count],"-time") ==0 )) {
 	printTime = 1;
+      } else if (strcmp(argv[count],"-condense") == 0) {
+	condense = true;
       }
       count++;
     }
     
-    UmfpackGenLinSolver *theSolver = new UmfpackGenLinSolver();
+    UmfpackGenLinSolver *theSolver = new UmfpackGenLinSolver(condense);
     // theSOE = new UmfpackGenLinSOE(*theSolver, factLVALUE, factorOnce, printTime);      
     theSOE = new UmfpackGenLinSOE(*theSolver);      
   }
@@ -3467,29 +3921,34 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     double aTol = 1.0e-50;
     double dTol = 1.0e5;
     int maxIts = 100000;
+    int numPCReuse = 0;
     int count = 2;
     while (count < argc-1) {
-      if (strcmp(argv[count],"-matrixType") == 0 || strcmp(argv[count],"-matrix")){	
+      if (strcmp(argv[count],"-matrixType") == 0 || strcmp(argv[count],"-matrix") == 0){	
 	if (strcmp(argv[count+1],"sparse") == 0)
 	  matType = 1;
       }
-      else if (strcmp(argv[count],"-rTol") == 0 || strcmp(argv[count],"-relTol") ||
-	       strcmp(argv[count],"-relativeTolerance")) {
+      else if (strcmp(argv[count],"-rTol") == 0 || strcmp(argv[count],"-relTol") == 0 ||
+	       strcmp(argv[count],"-relativeTolerance") == 0) {
 	if (Tcl_GetDouble(interp, argv[count+1], &rTol) != TCL_OK)
 	  return TCL_ERROR;		     
-      } else if (strcmp(argv[count],"-aTol") == 0 || strcmp(argv[count],"-absTol") ||
-		 strcmp(argv[count],"-absoluteTolerance")) {
+      } else if (strcmp(argv[count],"-aTol") == 0 || strcmp(argv[count],"-absTol") == 0 ||
+		 strcmp(argv[count],"-absoluteTolerance") == 0) {
 	if (Tcl_GetDouble(interp, argv[count+1], &aTol) != TCL_OK)
 	  return TCL_ERROR;		     
-      } else if (strcmp(argv[count],"-dTol") == 0 || strcmp(argv[count],"-divTol") ||
-		 strcmp(argv[count],"-divergenceTolerance")) {
+      } else if (strcmp(argv[count],"-dTol") == 0 || strcmp(argv[count],"-divTol") == 0 ||
+		 strcmp(argv[count],"-divergenceTolerance") == 0) {
 	if (Tcl_GetDouble(interp, argv[count+1], &dTol) != TCL_OK)
 	  return TCL_ERROR;		     
-      } else if (strcmp(argv[count],"-mIts") == 0 || strcmp(argv[count],"-maxIts") ||
-		 strcmp(argv[count],"-maxIterations")) {
+      } else if (strcmp(argv[count],"-mIts") == 0 || strcmp(argv[count],"-maxIts") == 0 ||
+		 strcmp(argv[count],"-maxIterations") == 0) {
 	if (Tcl_GetInt(interp, argv[count+1], &maxIts) != TCL_OK)
 	  return TCL_ERROR;		     
-      } else if (strcmp(argv[count],"-KSP") == 0 || strcmp(argv[count],"-KSPType")){	
+      } else if (strcmp(argv[count],"-reusePC") == 0) {
+	// number of solves the preconditioner is kept for
+	if (Tcl_GetInt(interp, argv[count+1], &numPCReuse) != TCL_OK)
+	  return TCL_ERROR;		     
+      } else if (strcmp(argv[count],"-KSP") == 0 || strcmp(argv[count],"-KSPType") == 0){	
 	if (strcmp(argv[count+1],"KSPCG") == 0)
 	  method = KSPCG;
 	else if (strcmp(argv[count+1],"KSPBICG") == 0)
@@ -3500,7 +3959,7 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 	  method = KSPCHEBYSHEV;
 	else if (strcmp(argv[count+1],"KSPGMRES") == 0)
 	  method = KSPGMRES;
-      } else if (strcmp(argv[count],"-PC") == 0 || strcmp(argv[count],"-PCType")){	
+      } else if (strcmp(argv[count],"-PC") == 0 || strcmp(argv[count],"-PCType") == 0){	
 	if ((strcmp(argv[count+1],"PCJACOBI") == 0) || (strcmp(argv[count+1],"JACOBI") == 0))
 	  preconditioner = PCJACOBI;
 	else if ((strcmp(argv[count+1],"PCILU") == 0) || (strcmp(argv[count+1],"ILU") == 0))
@@ -3519,6 +3978,7 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     if (matType == 0) {
       // PetscSolver *theSolver = new PetscSolver(method, preconditioner, rTol, aTol, dTol, maxIts);
       PetscSolver *theSolver = new PetscSolver(method, preconditioner, rTol, aTol, dTol, maxIts);
+      theSolver->setPreconditionerReuse(numPCReuse);
       theSOE = new PetscSOE(*theSolver);
     } else {
       // PetscSparseSeqSolver *theSolver = new PetscSparseSeqSolver(method, preconditioner, rTol, aTol, dTol, maxIts);
@@ -3538,6 +3998,8 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     int icntl14 = 20;    
     int icntl7 = 7;
     int matType = 0; // 0: unsymmetric, 1: symmetric positive definite, 2: symmetric general
+    const char *oocDir = 0;
+    int numThreads = 0;
 
     int currentArg = 2;
     while (currentArg < argc) {
@@ -3558,22 +4020,31 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 		  matType = 0;
 	  }
 	  currentArg += 2;
+	} else  if (strcmp(argv[currentArg],"-ooc") == 0 && currentArg+1 < argc) {
+	  oocDir = argv[currentArg+1];
+	  currentArg += 2;
+	} else  if (strcmp(argv[currentArg],"-numThreads") == 0 && currentArg+1 < argc) {
+	  if (Tcl_GetInt(interp, argv[currentArg+1], &numThreads) != TCL_OK || numThreads < 0) {
+	    opserr << "Mumps Warning: failed to get -numThreads, the MUMPS default is used\n";
+	    numThreads = 0;
+	  }
+	  currentArg += 2;
 	} else 
 	  currentArg++;
       }    
     }
 
 #ifdef _PARALLEL_PROCESSING
-    MumpsParallelSolver *theSolver = new MumpsParallelSolver(icntl7, icntl14);
+    MumpsParallelSolver *theSolver = new MumpsParallelSolver(icntl7, icntl14, oocDir, numThreads);
     theSOE = new MumpsParallelSOE(*theSolver);
 #elif _PARALLEL_INTERPRETERS
-    MumpsParallelSolver *theSolver = new MumpsParallelSolver(icntl7, icntl14);
+    MumpsParallelSolver *theSolver = new MumpsParallelSolver(icntl7, icntl14, oocDir, numThreads);
     MumpsParallelSOE *theParallelSOE = new MumpsParallelSOE(*theSolver, matType);
     theParallelSOE->setProcessID(OPS_rank);
     theParallelSOE->setChannels(numChannels, theChannels);
     theSOE = theParallelSOE;
 #else
-    MumpsSolver *theSolver = new MumpsSolver(icntl7, icntl14);
+    MumpsSolver *theSolver = new MumpsSolver(icntl7, icntl14, oocDir, numThreads);
     theSOE = new MumpsSOE(*theSolver, matType);
 #endif
 
@@ -3700,12 +4171,30 @@ specifyNumberer(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **
   // check argv[1] for type of Numberer and create the object
   if (strcmp(argv[1],"Plain") == 0) {
     theNumberer = new PlainNumberer();       
-  } else if (strcmp(argv[1],"RCM") == 0) {
-    RCM *theRCM = new RCM(false);	
-    theNumberer = new DOF_Numberer(*theRCM);    	
-  } else if (strcmp(argv[1],"AMD") == 0) {
-    AMD *theAMD = new AMD();	
-    theNumberer = new DOF_Numberer(*theAMD);    	
+  } else if (strcmp(argv[1],"RCM") == 0 || strcmp(argv[1],"AMD") == 0) {
+    GraphNumberer *theGN = 0;
+    if (strcmp(argv[1],"RCM") == 0)
+      theGN = new RCM(false);
+    else
+      theGN = new AMD();
+
+    // numberer RCM|AMD <-warmStart tol>
+    for (int i = 2; i < argc; i++) {
+      if (strcmp(argv[i],"-warmStart") == 0) {
+        double tol;
+        if (i+1 >= argc || Tcl_GetDouble(interp, argv[i+1], &tol) != TCL_OK) {
+          opserr << "WARNING numberer " << argv[1] << " -warmStart tol - invalid tol\n";
+          delete theGN;
+          return TCL_ERROR;
+        }
+        theGN->setWarmStart(tol);
+        i++;
+      }
+    }
+    theNumberer = new DOF_Numberer(*theGN);
+  } else if (strcmp(argv[1],"ND") == 0 || strcmp(argv[1],"NestedDissection") == 0) {
+    NestedDissection *theND = new NestedDissection();
+    theNumberer = new DOF_Numberer(*theND);
   } 
 
 #ifdef _PARALLEL_INTERPRETERS
@@ -4164,9 +4653,13 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
       double minEta     = 0.1;
       int    pFlag      = 1;
       int    typeSearch = 0;
+      bool   reduced    = false;
       
       while (count < argc) {
-	if (strcmp(argv[count], "-tol") == 0) {
+	if (strcmp(argv[count], "-reduced") == 0) {
+	  reduced = true;
+	  count++;
+	} else if (strcmp(argv[count], "-tol") == 0) {
 	  count++;
 	  if (Tcl_GetDouble(interp, argv[count], &tol) != TCL_OK)	
 	    return TCL_ERROR;	      	  
@@ -4219,7 +4712,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
       else if (typeSearch == 3)
 	theLineSearch = new RegulaFalsiLineSearch(tol, maxIter, minEta, maxEta, pFlag);
 
-      theNewAlgo = new NewtonLineSearch(*theTest, theLineSearch); 
+      theNewAlgo = new NewtonLineSearch(*theTest, theLineSearch, reduced); 
   }
 
   else if (strcmp(argv[1],"ExpressNewton") == 0) {
@@ -4232,12 +4725,28 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
       theNewAlgo->setConvergenceTest(theTest);
   }
 
+  else if (strcmp(argv[1],"AdaptiveNewton") == 0) {
+    void *theNewtonAlgo = OPS_AdaptiveNewton();
+    if (theNewtonAlgo == 0)
+      return TCL_ERROR;
+
+    theNewAlgo = (EquiSolnAlgo *)theNewtonAlgo;
+    if (theTest != 0)
+      theNewAlgo->setConvergenceTest(theTest);
+  }
+
   else {
     opserr << "WARNING No EquiSolnAlgo type " << argv[1] << " exists\n";
       return TCL_ERROR;
   }    
 
 
+  // a rung of the retry policy, the analysis keeps its algorithm
+  if (theNewAlgo != 0 && theRungAlgorithm != 0) {
+    *theRungAlgorithm = theNewAlgo;
+    return TCL_OK;
+  }
+
   if (theNewAlgo != 0) {
     theAlgorithm = theNewAlgo;
     
@@ -4469,6 +4978,11 @@ specifyCTest(ClientData clientData, Tcl_Interp *interp, int argc,
     }    
   }
 
+  if (theNewTest != 0 && theRungTest != 0) {
+    *theRungTest = theNewTest;
+    return TCL_OK;
+  }
+
   if (theNewTest != 0) {
     theTest = theNewTest;
 
@@ -4883,6 +5397,13 @@ specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
     if (theTransientAnalysis != 0)
       theTransientAnalysis->setIntegrator(*theTransientIntegrator);
   }
+  else if (strcmp(argv[1],"ImplicitExplicit") == 0) {
+    theTransientIntegrator = (TransientIntegrator*)OPS_ImplicitExplicit();
+
+    // if the analysis exists - we want to change the Integrator
+    if (theTransientAnalysis != 0)
+      theTransientAnalysis->setIntegrator(*theTransientIntegrator);
+  }
   else if (strcmp(argv[1],"PFEM") == 0) {
     theTransientIntegrator = new PFEMIntegrator();
 
@@ -5692,6 +6213,10 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
          (strcmp(argv[loc],"-fullGenLapackEigen") == 0))
       typeSolver = EigenSOE_TAGS_FullGenEigenSOE;
     
+    else if ((strcmp(argv[loc],"dampedArpack") == 0) || 
+         (strcmp(argv[loc],"-dampedArpack") == 0))
+      typeSolver = EigenSOE_TAGS_DampedArpackSOE;
+    
     else {
       opserr << "eigen - unknown option specified " << argv[loc] << endln;
     }
@@ -5747,6 +6272,10 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 							     *theSOE,
 							     *theTransientIntegrator,
 							     theTest);
+	if (theRetryPolicy != 0)
+	  theTransientAnalysis->setRetryPolicy(theRetryPolicy);
+	if (theCheckpoint != 0)
+	  theTransientAnalysis->setCheckpoint(theCheckpoint);
     }
 
     //
@@ -5774,6 +6303,10 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
 	theEigenSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
 
+      } else if (typeSolver == EigenSOE_TAGS_DampedArpackSOE) {
+
+	theEigenSOE = new DampedArpackSOE();
+
       } else {
 
 	theEigenSOE = new ArpackSOE(shift);    
@@ -5814,7 +6347,14 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
     } // theEigenSOE != 0    
 
 
+    // the damped solver also returns the damping ratios of the modes
+    DampedArpackSOE *theDampedSOE = 0;
+    if (theEigenSOE->getClassTag() == EigenSOE_TAGS_DampedArpackSOE)
+      theDampedSOE = (DampedArpackSOE *)theEigenSOE;
+
     int requiredDataSize = 40*numEigen;
+    if (theDampedSOE != 0)
+      requiredDataSize *= 2;
     if (requiredDataSize > resDataSize) {
       if (resDataPtr != 0) {
 	delete [] resDataPtr;
@@ -5841,6 +6381,9 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
       for (int i=0; i<numEigen; i++) {
 	cnt += sprintf(&resDataPtr[cnt], "%35.20f  ", eigenvalues[i]);
       }
+      if (theDampedSOE != 0)
+	for (int i=0; i<numEigen; i++)
+	  cnt += sprintf(&resDataPtr[cnt], "%35.20f  ", theDampedSOE->getDampingRatio(i+1));
       
       Tcl_SetResult(interp, resDataPtr, TCL_STATIC);
     }
@@ -5866,6 +6409,24 @@ responseSpectrumAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TC
     return TCL_OK;
 }
 
+int
+modalTransientAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+    OPS_ResetInputNoBuilder(clientData, interp, 1, argc, argv, &theDomain);
+    if (OPS_ModalTransientAnalysis() < 0)
+	    return TCL_ERROR;
+    return TCL_OK;
+}
+
+int
+frequencyDomainAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+    OPS_ResetInputNoBuilder(clientData, interp, 1, argc, argv, &theDomain);
+    if (OPS_FrequencyDomainAnalysis() < 0)
+	    return TCL_ERROR;
+    return TCL_OK;
+}
+
 int 
 videoPlayer(ClientData clientData, Tcl_Interp *interp, int argc, 
 	    TCL_Char **argv)
@@ -6192,6 +6753,187 @@ removeObject(ClientData clientData, Tcl_Interp *interp, int argc,
 }
 
 
+//
+// command invoked to build the ladder of fallbacks an analysis works
+// through when a step fails:
+//   retryPolicy add <-subSteps $n> <-algorithm {type args}> <-test {type args}>
+//   retryPolicy clear
+//
+int 
+specifyRetryPolicy(ClientData clientData, Tcl_Interp *interp, int argc, 
+		   TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING want - retryPolicy add <-subSteps n> <-algorithm {type args}> <-test {type args}>\n";
+    opserr << "          or - retryPolicy clear\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1],"clear") == 0) {
+    if (theRetryPolicy != 0)
+      theRetryPolicy->clear();
+    return TCL_OK;
+  }
+
+  if (strcmp(argv[1],"add") != 0) {
+    opserr << "WARNING retryPolicy - unknown option " << argv[1] << ", want add or clear\n";
+    return TCL_ERROR;
+  }
+
+  int numSubSteps = 1;
+  EquiSolnAlgo *theNewAlgo = 0;
+  ConvergenceTest *theNewTest = 0;
+  int res = TCL_OK;
+
+  for (int i = 2; i < argc && res == TCL_OK; i++) {
+    if (strcmp(argv[i],"-subSteps") == 0 && i+1 < argc) {
+      if (Tcl_GetInt(interp, argv[++i], &numSubSteps) != TCL_OK || numSubSteps < 1) {
+	opserr << "WARNING retryPolicy add - invalid number of subSteps " << argv[i] << endln;
+	res = TCL_ERROR;
+      }
+    }
+    else if ((strcmp(argv[i],"-algorithm") == 0 || strcmp(argv[i],"-test") == 0) && i+1 < argc) {
+      bool isAlgo = (strcmp(argv[i],"-algorithm") == 0);
+      int listArgc;
+      TCL_Char **listArgv;
+      if (Tcl_SplitList(interp, argv[++i], &listArgc, &listArgv) != TCL_OK) {
+	res = TCL_ERROR;
+	break;
+      }
+
+      // the list is parsed by the algorithm or test command as usual
+      TCL_Char **cmdArgv = new TCL_Char *[listArgc+1];
+      cmdArgv[0] = isAlgo ? "algorithm" : "test";
+      for (int j=0; j<listArgc; j++)
+	cmdArgv[j+1] = listArgv[j];
+
+      if (isAlgo) {
+	if (theNewAlgo != 0)
+	  delete theNewAlgo;
+	theNewAlgo = 0;
+	theRungAlgorithm = &theNewAlgo;
+	res = specifyAlgorithm(clientData, interp, listArgc+1, cmdArgv);
+	theRungAlgorithm = 0;
+      } else {
+	if (theNewTest != 0)
+	  delete theNewTest;
+	theNewTest = 0;
+	theRungTest = &theNewTest;
+	res = specifyCTest(clientData, interp, listArgc+1, cmdArgv);
+	theRungTest = 0;
+      }
+
+      delete [] cmdArgv;
+      Tcl_Free((char *)listArgv);
+    }
+    else {
+      opserr << "WARNING retryPolicy add - unknown option " << argv[i] << endln;
+      res = TCL_ERROR;
+    }
+  }
+
+  if (res == TCL_OK) {
+    if (theRetryPolicy == 0) {
+      theRetryPolicy = new StepRetryPolicy();
+      if (theStaticAnalysis != 0)
+	theStaticAnalysis->setRetryPolicy(theRetryPolicy);
+      else if (theTransientAnalysis != 0)
+	theTransientAnalysis->setRetryPolicy(theRetryPolicy);
+    }
+    if (theRetryPolicy->addRung(theNewAlgo, theNewTest, numSubSteps) == 0)
+      return TCL_OK;
+  }
+
+  if (theNewAlgo != 0)
+    delete theNewAlgo;
+  if (theNewTest != 0)
+    delete theNewTest;
+
+  return TCL_ERROR;
+}
+
+
+//
+// command invoked to save the domain as a transient analysis goes:
+//   checkpoint fileName <-steps $n> <-minutes $m> <-async>
+//   checkpoint off
+// analyze $numIncr $dt -resume then restores the latest of them
+//
+int 
+specifyCheckpoint(ClientData clientData, Tcl_Interp *interp, int argc, 
+		  TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING want - checkpoint fileName <-steps n> <-minutes m> <-async>\n";
+    opserr << "          or - checkpoint off\n";
+    return TCL_ERROR;
+  }
+
+  if (theCheckpoint != 0) {
+    if (theTransientAnalysis != 0)
+      theTransientAnalysis->setCheckpoint(0);
+    delete theCheckpoint;
+    theCheckpoint = 0;
+  }
+
+  if (strcmp(argv[1],"off") == 0)
+    return TCL_OK;
+
+  int everySteps = 0;
+  double everyMinutes = 0.0;
+  bool async = false;
+  for (int i=2; i<argc; i++) {
+    if (strcmp(argv[i],"-steps") == 0 && i+1 < argc) {
+      if (Tcl_GetInt(interp, argv[++i], &everySteps) != TCL_OK)
+	return TCL_ERROR;
+    } else if (strcmp(argv[i],"-minutes") == 0 && i+1 < argc) {
+      if (Tcl_GetDouble(interp, argv[++i], &everyMinutes) != TCL_OK)
+	return TCL_ERROR;
+    } else if (strcmp(argv[i],"-async") == 0) {
+      async = true;
+    } else {
+      opserr << "WARNING checkpoint - unknown option " << argv[i] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  if (everySteps <= 0 && everyMinutes <= 0.0) {
+    opserr << "WARNING checkpoint - need -steps n and/or -minutes m\n";
+    return TCL_ERROR;
+  }
+
+  CheckpointDatastore *theDatastore = new CheckpointDatastore(argv[1], theDomain, theBroker);
+  theDatastore->setAsync(async);
+  theCheckpoint = new AnalysisCheckpoint(theDomain, theDatastore, everySteps, everyMinutes);
+
+  if (theTransientAnalysis != 0)
+    theTransientAnalysis->setCheckpoint(theCheckpoint);
+
+  return TCL_OK;
+}
+
+
+//
+// command invoked to get the critical time step estimated by the
+// ExplicitDynamics analysis:  criticalTimeStep
+//
+int 
+getCriticalTimeStep(ClientData clientData, Tcl_Interp *interp, int argc, 
+		    TCL_Char **argv)
+{
+  if (theExplicitAnalysis == 0) {
+    opserr << "WARNING criticalTimeStep - no ExplicitDynamics analysis has been specified\n";
+    return TCL_ERROR;
+  }
+
+  char buffer[40];
+  sprintf(buffer, "%.10e", theExplicitAnalysis->getCriticalTimeStep());
+  Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+  return TCL_OK;
+}
+
+
 int
 getCTestNorms(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -9424,6 +10166,15 @@ sdfResponse(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv
   return TCL_OK;
 }
 
+int
+sdfSpectra(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  OPS_ResetInputNoBuilder(clientData, interp, 1, argc, argv, &theDomain);
+  if (OPS_sdfSpectra() < 0)
+    return TCL_ERROR;
+  return TCL_OK;
+}
+
 int 
 opsBarrier(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
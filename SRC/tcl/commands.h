@@ -62,6 +62,9 @@ wipeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
 int 
 resetModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+batchAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 initializeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -103,6 +106,12 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char *
 int
 specifyCTest(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int
+getCriticalTimeStep(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+int
+specifyRetryPolicy(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+int
+specifyCheckpoint(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+int
 getCTestNorms(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int
 getCTestIter(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
@@ -135,6 +144,12 @@ modalProperties(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char**
 int
 responseSpectrumAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
 
+int
+modalTransientAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
+int
+frequencyDomainAnalysis(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char** argv);
+
 int 
 videoPlayer(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -253,6 +268,9 @@ getParamValue(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **ar
 int 
 sdfResponse(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+sdfSpectra(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 // AddingSensitivity:BEGIN /////////////////////////////////////////////////
 
 
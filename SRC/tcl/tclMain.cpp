@@ -65,6 +65,9 @@ terms specified in this license.
 
 
 #include <string.h>
+#include <stdio.h>
+#include <set>
+#include <string>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -141,6 +144,142 @@ extern "C" int EvalFileWithParameters(Tcl_Interp *interp,
 				      int rank, 
 				      int np);
 
+static bool batchMode = false;
+static bool batchExit = false;
+static int batchExitCode = 0;
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * BatchExitCmd --
+ *
+ *	Replaces "exit" while running a batch job: it unwinds the job
+ *      script with an error, so the process stays alive for the next
+ *      job, and remembers the exit code.
+ *
+ *----------------------------------------------------------------------
+ */
+static int
+BatchExitCmd(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    batchExit = true;
+    batchExitCode = 0;
+    if (argc > 1 && Tcl_GetInt(interp, argv[1], &batchExitCode) != TCL_OK)
+	batchExitCode = 1;
+    Tcl_SetResult(interp, (char *)"exit", TCL_STATIC);
+    return TCL_ERROR;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * g3TclBatch --
+ *
+ *	Runs the warm process mode (OpenSees -batch): the names of the
+ *      scripts to run are read from stdin, one per line, and each one is
+ *      sourced in the same interpreter, so the jobs don't pay for the
+ *      process start, the loading of Tcl and the registration of the
+ *      commands again. Between two jobs the model is wiped, the global
+ *      variables the job created are unset and the working directory
+ *      is restored. When a job is done the line
+ *
+ *          batch done <exitCode> <fileName>
+ *
+ *      is written to stdout, the output of the scripts themselves goes
+ *      to stderr. Procedures a job defines are not removed.
+ *
+ * Results:
+ *	The exit code of the last job.
+ *
+ *----------------------------------------------------------------------
+ */
+static int
+g3TclBatch(Tcl_Interp *interp)
+{
+    int exitCode = 0;
+
+    Tcl_CreateCommand(interp, "exit", BatchExitCmd, NULL, NULL);
+
+    // the global variables of the fresh interpreter, and where it started
+    std::set<std::string> keepGlobals;
+    if (Tcl_Eval(interp, "info globals") == TCL_OK) {
+	int numGlobals = 0;
+	Tcl_Obj **globals = 0;
+	Tcl_ListObjGetElements(interp, Tcl_GetObjResult(interp), &numGlobals, &globals);
+	for (int i=0; i<numGlobals; i++)
+	    keepGlobals.insert(Tcl_GetString(globals[i]));
+    }
+    Tcl_Obj *startDir = Tcl_FSGetCwd(interp);
+
+    Tcl_Channel inChannel = Tcl_GetStdChannel(TCL_STDIN);
+    Tcl_Obj *lineObj = Tcl_NewObj();
+    Tcl_IncrRefCount(lineObj);
+
+    while (inChannel != 0) {
+	Tcl_SetObjLength(lineObj, 0);
+	if (Tcl_GetsObj(inChannel, lineObj) < 0)
+	    break;
+
+	std::string fileName(Tcl_GetString(lineObj));
+	size_t first = fileName.find_first_not_of(" \t\r");
+	if (first == std::string::npos || fileName[first] == '#')
+	    continue;
+	fileName = fileName.substr(first, fileName.find_last_not_of(" \t\r") - first + 1);
+
+	batchExit = false;
+	int code = Tcl_EvalFile(interp, fileName.c_str());
+	if (batchExit) {
+	    exitCode = batchExitCode;
+	} else if (code != TCL_OK) {
+	    Tcl_Channel errChannel = Tcl_GetStdChannel(TCL_STDERR);
+	    if (errChannel) {
+		Tcl_AddErrorInfo(interp, "");
+		Tcl_WriteObj(errChannel, Tcl_GetVar2Ex(interp, "errorInfo",
+						       NULL, TCL_GLOBAL_ONLY));
+		Tcl_WriteChars(errChannel, "\n", 1);
+	    }
+	    exitCode = 1;
+	} else
+	    exitCode = 0;
+
+	// leave a clean interpreter for the next job
+	Tcl_Eval(interp, "wipe");
+	if (Tcl_Eval(interp, "info globals") == TCL_OK) {
+	    Tcl_Obj *globals = Tcl_DuplicateObj(Tcl_GetObjResult(interp));
+	    Tcl_IncrRefCount(globals);
+	    int numGlobals = 0;
+	    Tcl_Obj **names = 0;
+	    Tcl_ListObjGetElements(interp, globals, &numGlobals, &names);
+	    for (int i=0; i<numGlobals; i++) {
+		const char *name = Tcl_GetString(names[i]);
+		if (keepGlobals.find(name) == keepGlobals.end())
+		    Tcl_UnsetVar(interp, name, TCL_GLOBAL_ONLY);
+	    }
+	    Tcl_DecrRefCount(globals);
+	}
+	if (startDir != 0)
+	    Tcl_FSChdir(startDir);
+	Tcl_ResetResult(interp);
+
+	Tcl_Channel outChannel = Tcl_GetStdChannel(TCL_STDOUT);
+	if (outChannel) {
+	    char doneLine[32];
+	    sprintf(doneLine, "batch done %d ", exitCode);
+	    Tcl_WriteChars(outChannel, doneLine, -1);
+	    Tcl_WriteChars(outChannel, fileName.c_str(), -1);
+	    Tcl_WriteChars(outChannel, "\n", 1);
+	    Tcl_Flush(outChannel);
+	}
+	inChannel = Tcl_GetStdChannel(TCL_STDIN);
+    }
+
+    Tcl_DecrRefCount(lineObj);
+    if (startDir != 0)
+	Tcl_DecrRefCount(startDir);
+
+    return exitCode;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -232,6 +371,9 @@ g3TclMain(int argc, char **argv, Tcl_AppInitProc * appInitProc, int rank, int np
 	  else if (strcmp(argv[i], "-noHeader") == 0) {
 		OPS_showHeader = false;
 	  }
+	  else if (strcmp(argv[i], "-batch") == 0) {
+		batchMode = true;
+	  }
     }	
 
 #ifdef _PARALLEL_INTERPRETERS
@@ -324,6 +466,19 @@ g3TclMain(int argc, char **argv, Tcl_AppInitProc * appInitProc, int rank, int np
 	}
     }
 
+    /*
+     * In batch mode run the scripts named on stdin and quit.
+     */
+
+    if (batchMode) {
+      exitCode = g3TclBatch(interp);
+      Tcl_DStringFree(&argString);
+      sprintf(buffer, "%d", exitCode);
+      const char *exitArgv[2] = {"exit", buffer};
+      OpenSeesExit(NULL, interp, 2, (TCL_Char **)exitArgv);
+      goto done;
+    }
+
     /*
      * If a script file was specified then just source that file
      * and quit.
@@ -0,0 +1,292 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of AnalysisMetrics.
+//
+// What: "@(#) AnalysisMetrics.cpp, revA"
+
+#include <AnalysisMetrics.h>
+#include <AnalysisProfiler.h>
+#include <LogCategory.h>
+#include <AsyncStream.h>
+#include <Domain.h>
+#include <EquiSolnAlgo.h>
+#include <ConvergenceTest.h>
+
+#include <stdio.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+bool AnalysisMetrics::enabled = false;
+
+static std::mutex theMetricsMutex;
+static std::string theFileName;
+static std::string theLabel;          // {run="..."} or empty
+static double theInterval = 10.0;
+
+static long numSteps = 0;
+static long numFailures = 0;
+static long numIterations = 0;
+static int lastIterations = 0;
+static double lastTime = 0.0;
+static long stepsAtLastWrite = 0;
+
+static std::chrono::steady_clock::time_point startedAt;
+static std::chrono::steady_clock::time_point lastWrite;
+static double lastStepAt = 0.0;       // unix time of the last step
+static double stepsPerSecond = 0.0;
+
+// the resident set size in bytes, -1 if it is not known
+static double
+residentBytes(void)
+{
+#if defined(__linux__)
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (statm != 0) {
+    long size, resident;
+    int n = fscanf(statm, "%ld %ld", &size, &resident);
+    fclose(statm);
+    if (n == 2)
+      return (double)resident * (double)sysconf(_SC_PAGESIZE);
+  }
+  return -1.0;
+#elif defined(_WIN32)
+  return -1.0;
+#else
+  // the peak, in bytes on macOS
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return (double)usage.ru_maxrss;
+  return -1.0;
+#endif
+}
+
+int
+AnalysisMetrics::start(const char *fileName, double interval, const char *label)
+{
+  std::lock_guard<std::mutex> lock(theMetricsMutex);
+
+  theFileName = fileName;
+  theInterval = (interval > 0.0) ? interval : 0.0;
+  theLabel.clear();
+  if (label != 0)
+    theLabel = std::string("run=\"") + label + "\"";
+
+  numSteps = 0;
+  numFailures = 0;
+  numIterations = 0;
+  lastIterations = 0;
+  stepsAtLastWrite = 0;
+  stepsPerSecond = 0.0;
+  startedAt = std::chrono::steady_clock::now();
+  lastWrite = startedAt;
+  lastStepAt = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+  enabled = true;
+  return 0;
+}
+
+void
+AnalysisMetrics::stop(void)
+{
+  if (enabled == false)
+    return;
+  write();
+  enabled = false;
+}
+
+void
+AnalysisMetrics::stepDone(double domainTime, int numIter, bool converged)
+{
+  bool due = false;
+  {
+    std::lock_guard<std::mutex> lock(theMetricsMutex);
+    if (enabled == false)
+      return;
+
+    numSteps++;
+    if (converged == false)
+      numFailures++;
+    numIterations += numIter;
+    lastIterations = numIter;
+    lastTime = domainTime;
+    lastStepAt = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double sinceWrite = std::chrono::duration<double>(now - lastWrite).count();
+    if (sinceWrite >= theInterval) {
+      if (sinceWrite > 0.0)
+	stepsPerSecond = (numSteps - stepsAtLastWrite)/sinceWrite;
+      stepsAtLastWrite = numSteps;
+      lastWrite = now;
+      due = true;
+    }
+  }
+
+  if (due)
+    write();
+}
+
+// the time of the domain and the iterations of the test of the algorithm
+void
+AnalysisMetrics::stepDone(Domain *theDomain, EquiSolnAlgo *theAlgo, bool converged)
+{
+  double domainTime = (theDomain != 0) ? theDomain->getCurrentTime() : 0.0;
+  int numIter = 0;
+  if (theAlgo != 0) {
+    ConvergenceTest *theTest = theAlgo->getConvergenceTest();
+    if (theTest != 0)
+      numIter = theTest->getNumTests();
+  }
+  stepDone(domainTime, numIter, converged);
+}
+
+// one sample, with the run label and the extra one if any
+static void
+addSample(std::string &out, const char *name, const std::string &extra, double value)
+{
+  char buffer[64];
+  out += name;
+  if (theLabel.empty() == false || extra.empty() == false) {
+    out += "{";
+    out += theLabel;
+    if (theLabel.empty() == false && extra.empty() == false)
+      out += ",";
+    out += extra;
+    out += "}";
+  }
+  sprintf(buffer, " %.10g\n", value);
+  out += buffer;
+}
+
+static void
+addMetric(std::string &out, const char *name, const char *type, const char *help)
+{
+  out += "# HELP ";
+  out += name;
+  out += " ";
+  out += help;
+  out += "\n# TYPE ";
+  out += name;
+  out += " ";
+  out += type;
+  out += "\n";
+}
+
+int
+AnalysisMetrics::write(void)
+{
+  std::string out;
+  std::string none;
+  std::string fileName;
+  {
+    std::lock_guard<std::mutex> lock(theMetricsMutex);
+    if (enabled == false)
+      return -1;
+    fileName = theFileName;
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count();
+
+    addMetric(out, "opensees_steps_total", "counter", "Analysis steps done");
+    addSample(out, "opensees_steps_total", none, (double)numSteps);
+    addMetric(out, "opensees_step_failures_total", "counter", "Analysis steps that failed to converge");
+    addSample(out, "opensees_step_failures_total", none, (double)numFailures);
+    addMetric(out, "opensees_iterations_total", "counter", "Iterations of the solution algorithm");
+    addSample(out, "opensees_iterations_total", none, (double)numIterations);
+    addMetric(out, "opensees_last_step_iterations", "gauge", "Iterations of the last step");
+    addSample(out, "opensees_last_step_iterations", none, (double)lastIterations);
+    addMetric(out, "opensees_steps_per_second", "gauge", "Steps per second over the last interval");
+    addSample(out, "opensees_steps_per_second", none, stepsPerSecond);
+    addMetric(out, "opensees_domain_time", "gauge", "Current time of the domain");
+    addSample(out, "opensees_domain_time", none, lastTime);
+    addMetric(out, "opensees_last_step_timestamp_seconds", "gauge", "Unix time of the end of the last step");
+    addSample(out, "opensees_last_step_timestamp_seconds", none, lastStepAt);
+    addMetric(out, "opensees_wall_seconds", "gauge", "Wall time since the metrics were started");
+    addSample(out, "opensees_wall_seconds", none, wall);
+    addMetric(out, "opensees_process_id", "gauge", "Id of the process");
+    addSample(out, "opensees_process_id", none, (double)getpid());
+  }
+
+  double rss = residentBytes();
+  if (rss >= 0.0) {
+    addMetric(out, "opensees_resident_memory_bytes", "gauge", "Resident memory of the process");
+    addSample(out, "opensees_resident_memory_bytes", none, rss);
+  }
+
+  addMetric(out, "opensees_recorder_rows_buffered", "gauge", "Rows waiting in the asynchronous recorder streams");
+  addSample(out, "opensees_recorder_rows_buffered", none, (double)AsyncStream::getNumRowsBuffered());
+
+  std::vector<std::pair<std::string, long> > warnings;
+  LogCategory::getCounts(warnings);
+  if (warnings.empty() == false) {
+    addMetric(out, "opensees_warnings_total", "counter", "Warnings per category");
+    for (size_t i = 0; i < warnings.size(); i++)
+      addSample(out, "opensees_warnings_total",
+		std::string("category=\"") + warnings[i].first + "\"",
+		(double)warnings[i].second);
+  }
+
+  if (AnalysisProfiler::isEnabled()) {
+    addMetric(out, "opensees_phase_calls_total", "counter", "Calls of each profiled phase");
+    for (int i = 0; i < AnalysisProfiler::NumPhases; i++)
+      addSample(out, "opensees_phase_calls_total",
+		std::string("phase=\"") + AnalysisProfiler::getName(i) + "\"",
+		(double)AnalysisProfiler::getCount(i));
+    addMetric(out, "opensees_phase_seconds_total", "counter", "Wall time of each profiled phase");
+    for (int i = 0; i < AnalysisProfiler::NumPhases; i++)
+      addSample(out, "opensees_phase_seconds_total",
+		std::string("phase=\"") + AnalysisProfiler::getName(i) + "\"",
+		AnalysisProfiler::getTime(i));
+  }
+
+  // written aside & renamed, so a reader never sees a partial file
+  std::string tmpName = fileName + ".tmp";
+  FILE *file = fopen(tmpName.c_str(), "w");
+  if (file == 0) {
+    opserr << "WARNING AnalysisMetrics::write - could not open " << tmpName.c_str() << endln;
+    return -1;
+  }
+  size_t n = fwrite(out.data(), 1, out.size(), file);
+  fclose(file);
+  if (n != out.size()) {
+    opserr << "WARNING AnalysisMetrics::write - failed to write " << tmpName.c_str() << endln;
+    return -1;
+  }
+
+#ifdef _WIN32
+  remove(fileName.c_str());
+#endif
+  if (rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    opserr << "WARNING AnalysisMetrics::write - could not replace " << fileName.c_str() << endln;
+    return -1;
+  }
+
+  return 0;
+}
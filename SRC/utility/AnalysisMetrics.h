@@ -0,0 +1,67 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// AnalysisMetrics. AnalysisMetrics counts the steps of the analyses, the
+// failed ones and the iterations taken, and at the end of a step, once
+// the given wall time interval has passed since the last time, writes
+// them to a file in the text format of Prometheus, with the domain time,
+// the steps per second over the interval, the wall time of the last
+// step, the resident memory, the rows buffered by the asynchronous
+// recorder streams, the warnings counted per LogCategory and, when the
+// AnalysisProfiler is enabled, the calls & time of each of its phases,
+// e.g. the number & time of the factorizations. The file is replaced as
+// a whole, so it can be read at any time, e.g. by the textfile collector
+// of the node exporter, to find stalled runs.
+//
+// What: "@(#) AnalysisMetrics.h, revA"
+
+#ifndef AnalysisMetrics_h
+#define AnalysisMetrics_h
+
+#include <OPS_Globals.h>
+#include <string>
+
+class Domain;
+class EquiSolnAlgo;
+
+class AnalysisMetrics
+{
+  public:
+    // starts writing to fileName every interval seconds, with a run
+    // label on each sample if label is not 0
+    static int start(const char *fileName, double interval, const char *label = 0);
+    static void stop(void);
+    static bool isEnabled(void) {return enabled;};
+
+    // called by the analyses at the end of each step
+    static void stepDone(double domainTime, int numIterations, bool converged);
+    static void stepDone(Domain *theDomain, EquiSolnAlgo *theAlgo, bool converged);
+
+    // writes the file now
+    static int write(void);
+
+  protected:
+
+  private:
+    static bool enabled;
+};
+
+#endif
@@ -0,0 +1,338 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of AnalysisProfiler.
+
+#include <AnalysisProfiler.h>
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+
+bool AnalysisProfiler::enabled = false;
+double AnalysisProfiler::times[AnalysisProfiler::NumPhases];
+long AnalysisProfiler::counts[AnalysisProfiler::NumPhases];
+double AnalysisProfiler::elapsed = 0.0;
+std::chrono::steady_clock::time_point AnalysisProfiler::enabledAt;
+
+ProfilePhase *ProfilePhase::current = 0;
+
+bool AnalysisProfiler::classesEnabled = false;
+std::map<int, AnalysisProfiler::ClassCost> AnalysisProfiler::elementCosts;
+std::map<std::pair<int,int>, AnalysisProfiler::ClassCost> AnalysisProfiler::materialCosts;
+
+int ProfileClass::currentElement = -1;
+
+static const char *phaseNames[AnalysisProfiler::NumPhases] = {
+  "elementUpdate", "tangentFormation", "residualFormation", "assembly",
+  "factorization", "solve", "convergenceTest", "integratorUpdate",
+  "recorderOutput", "commit"
+};
+
+
+void
+AnalysisProfiler::enable(bool onOff)
+{
+  if (onOff == enabled)
+    return;
+
+  if (onOff) {
+    enabledAt = std::chrono::steady_clock::now();
+  } else {
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - enabledAt;
+    elapsed += time.count();
+  }
+
+  enabled = onOff;
+}
+
+
+void
+AnalysisProfiler::reset(void)
+{
+  for (int i=0; i<NumPhases; i++) {
+    times[i] = 0.0;
+    counts[i] = 0;
+  }
+
+  elapsed = 0.0;
+  enabledAt = std::chrono::steady_clock::now();
+
+  elementCosts.clear();
+  materialCosts.clear();
+}
+
+
+void
+AnalysisProfiler::enableClasses(bool onOff)
+{
+  classesEnabled = onOff;
+}
+
+
+void
+AnalysisProfiler::addElement(int classTag, const char *name, double seconds)
+{
+  ClassCost &cost = elementCosts[classTag];
+  if (cost.calls == 0)
+    cost.name = name;
+  cost.time += seconds;
+  cost.calls++;
+}
+
+
+void
+AnalysisProfiler::addMaterial(int eleClassTag, int classTag, const char *name,
+			      double seconds)
+{
+  ClassCost &cost = materialCosts[std::make_pair(eleClassTag, classTag)];
+  if (cost.calls == 0)
+    cost.name = name;
+  cost.time += seconds;
+  cost.calls++;
+}
+
+
+void
+ProfileClass::begin(int theKind, const MovableObject *theObject)
+{
+  kind = theKind;
+  classTag = theObject->getClassTag();
+  name = theObject->getClassType();
+  parentElement = currentElement;
+  if (kind == Element)
+    currentElement = classTag;
+  start = std::chrono::steady_clock::now();
+}
+
+
+void
+ProfileClass::end(void)
+{
+  std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+  if (kind == Element) {
+    currentElement = parentElement;
+    AnalysisProfiler::addElement(classTag, name, time.count());
+  } else
+    AnalysisProfiler::addMaterial(parentElement, classTag, name, time.count());
+}
+
+
+void
+AnalysisProfiler::add(int phase, double seconds)
+{
+  if (phase < 0 || phase >= NumPhases)
+    return;
+
+  times[phase] += seconds;
+  counts[phase]++;
+}
+
+
+double
+AnalysisProfiler::getTime(int phase)
+{
+  if (phase < 0 || phase >= NumPhases)
+    return 0.0;
+
+  return times[phase];
+}
+
+
+long
+AnalysisProfiler::getCount(int phase)
+{
+  if (phase < 0 || phase >= NumPhases)
+    return 0;
+
+  return counts[phase];
+}
+
+
+const char *
+AnalysisProfiler::getName(int phase)
+{
+  if (phase < 0 || phase >= NumPhases)
+    return 0;
+
+  return phaseNames[phase];
+}
+
+
+// the wall time the profiler has been enabled for since the last reset
+double
+AnalysisProfiler::getElapsed(void)
+{
+  double total = elapsed;
+  if (enabled) {
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - enabledAt;
+    total += time.count();
+  }
+
+  return total;
+}
+
+
+// the element & material class costs, the most expensive first
+struct ClassRow {
+  std::string name;
+  int classTag;
+  std::string element;
+  double time;
+  long calls;
+};
+
+static bool
+costlier(const ClassRow &a, const ClassRow &b)
+{
+  return a.time > b.time;
+}
+
+
+static void
+getClassRows(const std::map<int, AnalysisProfiler::ClassCost> &elements,
+	     const std::map<std::pair<int,int>, AnalysisProfiler::ClassCost> &materials,
+	     std::vector<ClassRow> &eleRows, std::vector<ClassRow> &matRows)
+{
+  for (auto it = elements.begin(); it != elements.end(); ++it) {
+    ClassRow row = {it->second.name ? it->second.name : "", it->first, "",
+		    it->second.time, it->second.calls};
+    eleRows.push_back(row);
+  }
+
+  for (auto it = materials.begin(); it != materials.end(); ++it) {
+    auto ele = elements.find(it->first.first);
+    const char *eleName = (ele != elements.end() && ele->second.name) ? ele->second.name : "";
+    ClassRow row = {it->second.name ? it->second.name : "", it->first.second, eleName,
+		    it->second.time, it->second.calls};
+    matRows.push_back(row);
+  }
+
+  std::sort(eleRows.begin(), eleRows.end(), costlier);
+  std::sort(matRows.begin(), matRows.end(), costlier);
+}
+
+
+// {"elapsed": t, "phases": {"elementUpdate": {"time": t, "calls": n}, ...},
+//  "elements": [{"name": s, "classTag": n, "time": t, "calls": n}, ...],
+//  "materials": [{"element": s, "name": s, "classTag": n, ...}, ...]}
+// the last two only if the class accounting has been on
+std::string
+AnalysisProfiler::getJSON(void)
+{
+  char buffer[128];
+
+  std::string json("{\"elapsed\": ");
+  sprintf(buffer, "%.6e", getElapsed());
+  json += buffer;
+  json += ", \"phases\": {";
+  for (int i=0; i<NumPhases; i++) {
+    sprintf(buffer, "\"%s\": {\"time\": %.6e, \"calls\": %ld}",
+	    phaseNames[i], times[i], counts[i]);
+    json += buffer;
+    if (i < NumPhases-1)
+      json += ", ";
+  }
+  json += "}";
+
+  if (!elementCosts.empty() || !materialCosts.empty()) {
+    std::vector<ClassRow> eleRows, matRows;
+    getClassRows(elementCosts, materialCosts, eleRows, matRows);
+
+    json += ", \"elements\": [";
+    for (size_t i=0; i<eleRows.size(); i++) {
+      json += (i > 0) ? ", {\"name\": \"" : "{\"name\": \"";
+      json += eleRows[i].name;
+      sprintf(buffer, "\", \"classTag\": %d, \"time\": %.6e, \"calls\": %ld}",
+	      eleRows[i].classTag, eleRows[i].time, eleRows[i].calls);
+      json += buffer;
+    }
+    json += "], \"materials\": [";
+    for (size_t i=0; i<matRows.size(); i++) {
+      json += (i > 0) ? ", {\"element\": \"" : "{\"element\": \"";
+      json += matRows[i].element;
+      json += "\", \"name\": \"";
+      json += matRows[i].name;
+      sprintf(buffer, "\", \"classTag\": %d, \"time\": %.6e, \"calls\": %ld}",
+	      matRows[i].classTag, matRows[i].time, matRows[i].calls);
+      json += buffer;
+    }
+    json += "]";
+  }
+  json += "}";
+
+  return json;
+}
+
+
+void
+AnalysisProfiler::Print(OPS_Stream &s, bool json)
+{
+  if (json) {
+    s << getJSON().c_str() << endln;
+    return;
+  }
+
+  double total = getElapsed();
+  double profiled = 0.0;
+  for (int i=0; i<NumPhases; i++)
+    profiled += times[i];
+
+  char buffer[128];
+
+  sprintf(buffer, "%-20s %14s %12s %8s\n", "phase", "time (s)", "calls", "%");
+  s << buffer;
+  for (int i=0; i<NumPhases; i++) {
+    double percent = (total > 0.0) ? 100.0*times[i]/total : 0.0;
+    sprintf(buffer, "%-20s %14.6f %12ld %8.2f\n", phaseNames[i], times[i], counts[i], percent);
+    s << buffer;
+  }
+  double percent = (total > 0.0) ? 100.0*(total-profiled)/total : 0.0;
+  sprintf(buffer, "%-20s %14.6f %12s %8.2f\n", "other", total-profiled, "", percent);
+  s << buffer;
+  sprintf(buffer, "%-20s %14.6f\n", "elapsed", total);
+  s << buffer;
+
+  if (elementCosts.empty() && materialCosts.empty())
+    return;
+
+  // the materials are part of the time of their element
+  std::vector<ClassRow> eleRows, matRows;
+  getClassRows(elementCosts, materialCosts, eleRows, matRows);
+
+  char line[256];
+  sprintf(line, "\n%-40s %10s %14s %12s %8s\n", "element", "classTag", "time (s)", "calls", "%");
+  s << line;
+  for (size_t i=0; i<eleRows.size(); i++) {
+    double percent = (total > 0.0) ? 100.0*eleRows[i].time/total : 0.0;
+    sprintf(line, "%-40.40s %10d %14.6f %12ld %8.2f\n", eleRows[i].name.c_str(),
+	    eleRows[i].classTag, eleRows[i].time, eleRows[i].calls, percent);
+    s << line;
+  }
+
+  sprintf(line, "\n%-40s %10s %14s %12s %8s\n", "element/material", "classTag", "time (s)", "calls", "%");
+  s << line;
+  for (size_t i=0; i<matRows.size(); i++) {
+    std::string pair = matRows[i].element + "/" + matRows[i].name;
+    double percent = (total > 0.0) ? 100.0*matRows[i].time/total : 0.0;
+    sprintf(line, "%-40.40s %10d %14.6f %12ld %8.2f\n", pair.c_str(),
+	    matRows[i].classTag, matRows[i].time, matRows[i].calls, percent);
+    s << line;
+  }
+}
@@ -0,0 +1,178 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// AnalysisProfiler. AnalysisProfiler accumulates the wall time and the
+// number of calls of the phases of an analysis while it is enabled. The
+// phases are timed with ProfilePhase objects in the scopes to be timed;
+// the time of a phase nested in another is only counted in the inner
+// one, so the times of the phases add up. The timing is done on the
+// analysis thread only, the disabled profiler costs a test of a flag.
+// With the class accounting also enabled, ProfileClass objects sum the
+// time and calls per element class, and per material class within each
+// element class, outside of parallel regions.
+//
+// What: "@(#) AnalysisProfiler.h, revA"
+
+#ifndef AnalysisProfiler_h
+#define AnalysisProfiler_h
+
+#include <OPS_Globals.h>
+#include <chrono>
+#include <string>
+#include <map>
+#include <utility>
+#include <MovableObject.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+class AnalysisProfiler
+{
+  public:
+    enum { ElementUpdate = 0, TangentFormation, ResidualFormation, Assembly,
+	   Factorization, Solve, ConvergenceTest, IntegratorUpdate,
+	   RecorderOutput, Commit, NumPhases };
+
+    static void enable(bool onOff);
+    static bool isEnabled(void) {return enabled;};
+    static void reset(void);
+
+    static void add(int phase, double seconds);
+    static double getTime(int phase);
+    static long getCount(int phase);
+    static const char *getName(int phase);
+
+    static double getElapsed(void);
+
+    // the accounting per element & material class
+    static void enableClasses(bool onOff);
+    static bool isClassesEnabled(void) {return classesEnabled;};
+
+    struct ClassCost {
+      const char *name;
+      double time;
+      long calls;
+    };
+
+    // a table, or the JSON object of getJSON() if json is true
+    static void Print(OPS_Stream &s, bool json = false);
+    static std::string getJSON(void);
+
+  protected:
+
+  private:
+    friend class ProfilePhase;
+    friend class ProfileClass;
+
+    static void addElement(int classTag, const char *name, double seconds);
+    static void addMaterial(int eleClassTag, int classTag, const char *name,
+			    double seconds);
+
+    static bool enabled;
+    static double times[NumPhases];
+    static long counts[NumPhases];
+    static double elapsed;     // between enable(true) & enable(false)
+    static std::chrono::steady_clock::time_point enabledAt;
+
+    static bool classesEnabled;
+    static std::map<int, ClassCost> elementCosts;
+    static std::map<std::pair<int,int>, ClassCost> materialCosts;  // (element, material)
+};
+
+// times the scope it is declared in as phase when the profiler is enabled
+class ProfilePhase
+{
+  public:
+    ProfilePhase(int thePhase)
+      :phase(thePhase), on(AnalysisProfiler::enabled), childTime(0.0), parent(0)
+    {
+      if (on) {
+	parent = current;
+	current = this;
+	start = std::chrono::steady_clock::now();
+      }
+    };
+
+    ~ProfilePhase()
+    {
+      if (on) {
+	std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+	AnalysisProfiler::add(phase, total.count() - childTime);
+	if (parent != 0)
+	  parent->childTime += total.count();
+	current = parent;
+      }
+    };
+
+    // counts the scope as another phase, e.g. once it is known what it did
+    void setPhase(int thePhase) {phase = thePhase;};
+
+  private:
+    int phase;
+    bool on;
+    double childTime;
+    ProfilePhase *parent;
+    std::chrono::steady_clock::time_point start;
+
+    static ProfilePhase *current;
+};
+
+// times the scope it is declared in as a call of theObject, an element or
+// a material, when the class accounting is enabled; the time of the
+// materials is included in that of the element calling them
+class ProfileClass
+{
+  public:
+    enum { Element = 0, Material = 1 };
+
+    ProfileClass(int theKind, const MovableObject *theObject)
+      :on(AnalysisProfiler::enabled && AnalysisProfiler::classesEnabled)
+    {
+#ifdef _OPENMP
+      if (on && omp_in_parallel())
+	on = false;
+#endif
+      if (on)
+	this->begin(theKind, theObject);
+    };
+
+    ~ProfileClass()
+    {
+      if (on)
+	this->end();
+    };
+
+  private:
+    void begin(int theKind, const MovableObject *theObject);
+    void end(void);
+
+    bool on;
+    int kind;
+    int classTag;
+    const char *name;
+    int parentElement;   // class tag of the enclosing element scope
+    std::chrono::steady_clock::time_point start;
+
+    static int currentElement;
+};
+
+#endif
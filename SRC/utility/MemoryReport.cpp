@@ -0,0 +1,306 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of MemoryReport.
+//
+// What: "@(#) MemoryReport.cpp, revA"
+
+#include <MemoryReport.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Element.h>
+#include <ElementIter.h>
+#include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <MP_Constraint.h>
+#include <MP_ConstraintIter.h>
+#include <LoadPattern.h>
+#include <LoadPatternIter.h>
+#include <NodalLoad.h>
+#include <NodalLoadIter.h>
+#include <ElementalLoad.h>
+#include <ElementalLoadIter.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <stdio.h>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// the bytes of an entry of the tagged object storages of the Domain
+#define MEMORY_REPORT_STORAGE_ENTRY 48
+
+static const char *categoryNames[MemoryReport::NumCategories] = {
+  "nodes", "elements", "materials", "constraintsLoads", "analysisModel",
+  "systemOfEqn", "solverFactors", "recorders"
+};
+
+
+MemoryReport::MemoryReport()
+{
+  for (int i=0; i<NumCategories; i++) {
+    bytes[i] = 0.0;
+    counts[i] = 0;
+  }
+}
+
+
+size_t
+MemoryReport::heapSize(const void *object, size_t size)
+{
+  if (object == 0)
+    return 0;
+
+  size_t blockSize = 0;
+#if defined(__APPLE__)
+  blockSize = malloc_size(object);
+#elif defined(_WIN32)
+  blockSize = _msize((void *)object);
+#elif defined(__GLIBC__)
+  blockSize = malloc_usable_size((void *)object);
+#endif
+
+  return (blockSize > size) ? blockSize : size;
+}
+
+
+size_t
+MemoryReport::vectorSize(const Vector *theVector)
+{
+  if (theVector == 0)
+    return 0;
+  return sizeof(Vector) + theVector->Size()*sizeof(double);
+}
+
+
+size_t
+MemoryReport::matrixSize(const Matrix *theMatrix)
+{
+  if (theMatrix == 0)
+    return 0;
+  return sizeof(Matrix) + theMatrix->noRows()*theMatrix->noCols()*sizeof(double);
+}
+
+
+size_t
+MemoryReport::idSize(const ID *theID)
+{
+  if (theID == 0)
+    return 0;
+  return sizeof(ID) + theID->Size()*sizeof(int);
+}
+
+
+int
+MemoryReport::compute(Domain &theDomain, AnalysisModel *theModel, LinearSOE *theSOE)
+{
+  for (int i=0; i<NumCategories; i++) {
+    bytes[i] = 0.0;
+    counts[i] = 0;
+  }
+
+  Node *theNode;
+  NodeIter &theNodes = theDomain.getNodes();
+  while ((theNode = theNodes()) != 0) {
+    bytes[Nodes] += theNode->getMemoryUsage() + MEMORY_REPORT_STORAGE_ENTRY;
+    counts[Nodes]++;
+  }
+
+  // the materials & sections are separated from their elements
+  Element *theEle;
+  ElementIter &theElements = theDomain.getElements();
+  while ((theEle = theElements()) != 0) {
+    bytes[Elements] += objectSize(theEle) + MEMORY_REPORT_STORAGE_ENTRY;
+    counts[Elements]++;
+    size_t matBytes = theEle->getMaterialMemoryUsage();
+    if (matBytes > 0) {
+      bytes[Materials] += matBytes;
+      counts[Materials]++;
+    }
+  }
+
+  SP_Constraint *theSP;
+  SP_ConstraintIter &theSPs = theDomain.getSPs();
+  while ((theSP = theSPs()) != 0) {
+    bytes[ConstraintsLoads] += objectSize(theSP) + MEMORY_REPORT_STORAGE_ENTRY;
+    counts[ConstraintsLoads]++;
+  }
+
+  MP_Constraint *theMP;
+  MP_ConstraintIter &theMPs = theDomain.getMPs();
+  while ((theMP = theMPs()) != 0) {
+    bytes[ConstraintsLoads] += objectSize(theMP) + MEMORY_REPORT_STORAGE_ENTRY
+      + idSize(&theMP->getConstrainedDOFs()) + idSize(&theMP->getRetainedDOFs())
+      + matrixSize(&theMP->getConstraint());
+    counts[ConstraintsLoads]++;
+  }
+
+  LoadPattern *thePattern;
+  LoadPatternIter &thePatterns = theDomain.getLoadPatterns();
+  while ((thePattern = thePatterns()) != 0) {
+    bytes[ConstraintsLoads] += objectSize(thePattern) + MEMORY_REPORT_STORAGE_ENTRY;
+    counts[ConstraintsLoads]++;
+
+    NodalLoad *theLoad;
+    NodalLoadIter &theLoads = thePattern->getNodalLoads();
+    while ((theLoad = theLoads()) != 0) {
+      bytes[ConstraintsLoads] += objectSize(theLoad) + MEMORY_REPORT_STORAGE_ENTRY;
+      counts[ConstraintsLoads]++;
+    }
+
+    ElementalLoad *theEleLoad;
+    ElementalLoadIter &theEleLoads = thePattern->getElementalLoads();
+    while ((theEleLoad = theEleLoads()) != 0) {
+      bytes[ConstraintsLoads] += objectSize(theEleLoad) + MEMORY_REPORT_STORAGE_ENTRY;
+      counts[ConstraintsLoads]++;
+    }
+
+    SP_ConstraintIter &thePatternSPs = thePattern->getSPs();
+    while ((theSP = thePatternSPs()) != 0) {
+      bytes[ConstraintsLoads] += objectSize(theSP) + MEMORY_REPORT_STORAGE_ENTRY;
+      counts[ConstraintsLoads]++;
+    }
+  }
+
+  if (theModel != 0) {
+    FE_Element *theFE;
+    FE_EleIter &theFEs = theModel->getFEs();
+    while ((theFE = theFEs()) != 0) {
+      bytes[Analysis] += theFE->getMemoryUsage();
+      counts[Analysis]++;
+    }
+
+    DOF_Group *theDOF;
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    while ((theDOF = theDOFs()) != 0) {
+      bytes[Analysis] += theDOF->getMemoryUsage();
+      counts[Analysis]++;
+    }
+  }
+
+  if (theSOE != 0) {
+    bytes[SystemOfEqn] = objectSize(theSOE) + theSOE->getMemoryUsage();
+    counts[SystemOfEqn] = theSOE->getNumEqn();
+    bytes[SolverFactors] = theSOE->getFactorMemoryUsage();
+  }
+
+  int numRecorders = 0;
+  bytes[Recorders] = theDomain.getRecorderMemoryUsage(numRecorders);
+  counts[Recorders] = numRecorders;
+
+  return 0;
+}
+
+
+double
+MemoryReport::getBytes(int category) const
+{
+  if (category < 0 || category >= NumCategories)
+    return 0.0;
+  return bytes[category];
+}
+
+
+long
+MemoryReport::getCount(int category) const
+{
+  if (category < 0 || category >= NumCategories)
+    return 0;
+  return counts[category];
+}
+
+
+double
+MemoryReport::getTotal(void) const
+{
+  double total = 0.0;
+  for (int i=0; i<NumCategories; i++)
+    total += bytes[i];
+  return total;
+}
+
+
+const char *
+MemoryReport::getName(int category)
+{
+  if (category < 0 || category >= NumCategories)
+    return "unknown";
+  return categoryNames[category];
+}
+
+
+// {"total": b, "categories": {"nodes": {"bytes": b, "count": n}, ...}}
+std::string
+MemoryReport::getJSON(void)
+{
+  char buffer[128];
+
+  std::string json("{\"total\": ");
+  sprintf(buffer, "%.0f", this->getTotal());
+  json += buffer;
+  json += ", \"categories\": {";
+  for (int i=0; i<NumCategories; i++) {
+    sprintf(buffer, "\"%s\": {\"bytes\": %.0f, \"count\": %ld}",
+	    categoryNames[i], bytes[i], counts[i]);
+    json += buffer;
+    if (i < NumCategories-1)
+      json += ", ";
+  }
+  json += "}}";
+
+  return json;
+}
+
+
+void
+MemoryReport::Print(OPS_Stream &s, bool json)
+{
+  if (json) {
+    s << this->getJSON().c_str() << endln;
+    return;
+  }
+
+  double total = this->getTotal();
+  char buffer[128];
+
+  sprintf(buffer, "%-20s %12s %14s %8s\n", "category", "count", "MB", "%");
+  s << buffer;
+  for (int i=0; i<NumCategories; i++) {
+    double percent = (total > 0.0) ? 100.0*bytes[i]/total : 0.0;
+    sprintf(buffer, "%-20s %12ld %14.3f %8.2f\n", categoryNames[i], counts[i],
+	    bytes[i]/1048576.0, percent);
+    s << buffer;
+  }
+  sprintf(buffer, "%-20s %12s %14.3f\n", "total", "", total/1048576.0);
+  s << buffer;
+}
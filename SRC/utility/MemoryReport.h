@@ -0,0 +1,85 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for MemoryReport.
+// MemoryReport adds up the bytes held by the parts of a model: the nodes,
+// the elements, their materials, the constraints & loads, the FE_Element
+// & DOF_Group objects of the AnalysisModel, the storage of the system of
+// equations, the factors held by its solver and the recorders. Each
+// object is counted with the size of the heap block holding it, where the
+// C library can tell it, plus the storage it is known to own, so that the
+// report is a walk over the model with no allocation & no exchange.
+//
+// What: "@(#) MemoryReport.h, revA"
+
+#ifndef MemoryReport_h
+#define MemoryReport_h
+
+#include <OPS_Globals.h>
+#include <stddef.h>
+#include <string>
+
+class Domain;
+class AnalysisModel;
+class LinearSOE;
+class Vector;
+class Matrix;
+class ID;
+
+class MemoryReport
+{
+  public:
+    enum { Nodes = 0, Elements, Materials, ConstraintsLoads, Analysis,
+	   SystemOfEqn, SolverFactors, Recorders, NumCategories };
+
+    MemoryReport();
+
+    int compute(Domain &theDomain, AnalysisModel *theModel, LinearSOE *theSOE);
+
+    double getBytes(int category) const;
+    long getCount(int category) const;
+    double getTotal(void) const;
+    static const char *getName(int category);
+
+    // a table, or the JSON object of getJSON() if json is true
+    void Print(OPS_Stream &s, bool json = false);
+    std::string getJSON(void);
+
+    // the size of the heap block at object, or size if it is not known
+    static size_t heapSize(const void *object, size_t size);
+
+    // the bytes of a polymorphic object allocated on its own with new
+    template <class T> static size_t objectSize(const T *object) {
+      return (object == 0) ? 0 : heapSize(dynamic_cast<const void *>(object), sizeof(T));
+    }
+
+    // the bytes of an object & its data, 0 for a null pointer
+    static size_t vectorSize(const Vector *theVector);
+    static size_t matrixSize(const Matrix *theMatrix);
+    static size_t idSize(const ID *theID);
+
+  protected:
+
+  private:
+    double bytes[NumCategories];
+    long counts[NumCategories];
+};
+
+#endif
@@ -0,0 +1,71 @@
+"""Material driver for the backbone materials: a long cyclic strain
+protocol with growing amplitudes is applied to one uniaxial material
+through testUniaxialMaterial, about 200000 strain steps at scale 1. The
+driver calls from Python weigh in the absolute times, compare the
+variants with earlier runs of the same variant."""
+
+from math import pi, sin
+
+from common import size
+
+VARIANTS = ['MultiLinear', 'Pinching4', 'Hysteretic', 'IMKBilin',
+            'ModIMKPeakOriented', 'Backbone']
+
+# yield strain of all the variants, the protocol goes to 8 times it
+ey = 0.002
+
+
+def build(ops, scale, variant):
+   ops.wipe()
+   ops.model('basic', '-ndm', 1, '-ndf', 1)
+
+   if variant == 'MultiLinear':
+      ops.uniaxialMaterial('MultiLinear', 1, ey, 400.0, 3*ey, 480.0, 6*ey, 520.0,
+                           10*ey, 530.0)
+   elif variant == 'Pinching4':
+      ops.uniaxialMaterial('Pinching4', 1,
+                           400.0, ey, 480.0, 3*ey, 520.0, 6*ey, 100.0, 10*ey,
+                           -400.0, -ey, -480.0, -3*ey, -520.0, -6*ey, -100.0, -10*ey,
+                           0.5, 0.25, 0.05, 0.5, 0.25, 0.05,
+                           1.0, 0.2, 0.3, 0.2, 0.9,
+                           0.5, 0.5, 2.0, 2.0, 0.5,
+                           1.0, 0.0, 1.0, 1.0, 0.9,
+                           10.0, 'energy')
+   elif variant == 'Hysteretic':
+      ops.uniaxialMaterial('Hysteretic', 1, 400.0, ey, 480.0, 3*ey, 520.0, 6*ey,
+                           -400.0, -ey, -480.0, -3*ey, -520.0, -6*ey,
+                           0.8, 0.2, 0.0, 0.01, 0.3)
+   elif variant == 'IMKBilin':
+      ops.uniaxialMaterial('IMKBilin', 1, 400.0/ey,
+                           3*ey, 6*ey, 12*ey, 400.0, 1.2, 0.2,
+                           3*ey, 6*ey, 12*ey, 400.0, 1.2, 0.2,
+                           50.0, 50.0, 50.0, 1.0, 1.0, 1.0, 1.0, 1.0)
+   elif variant == 'ModIMKPeakOriented':
+      ops.uniaxialMaterial('ModIMKPeakOriented', 1, 400.0/ey, 0.05, 0.05,
+                           400.0, -400.0, 50.0, 50.0, 50.0, 50.0,
+                           1.0, 1.0, 1.0, 1.0, 3*ey, 3*ey, 6*ey, 6*ey,
+                           0.2, 0.2, 12*ey, 12*ey, 1.0, 1.0)
+   elif variant == 'Backbone':
+      ops.hystereticBackbone('Multilinear', 1, ey, 400.0, 2*ey, 440.0, 3*ey, 480.0,
+                             4*ey, 500.0, 6*ey, 520.0, 8*ey, 525.0, 10*ey, 530.0)
+      ops.uniaxialMaterial('Backbone', 1, 1)
+
+   ops.testUniaxialMaterial(1)
+
+
+def run(ops, scale, variant):
+   # cycles of 400 steps, two at each amplitude, up to 8 times the yield
+   # strain and back down
+   numCycles = size(500, scale, 1.0)
+   stepsPerCycle = 400
+   steps = 0
+   for c in range(numCycles):
+      level = (c//2) % 16
+      amplitude = ey*(1 + (level if level < 8 else 15 - level))
+      for i in range(1, stepsPerCycle + 1):
+         ops.setStrain(amplitude*sin(2.0*pi*i/stepsPerCycle))
+         ops.getStress()
+         ops.getTangent()
+         steps += 1
+
+   return steps, 0
@@ -0,0 +1,32 @@
+"""Helpers shared by the benchmark models."""
+
+from math import exp, pi, sin
+
+
+def ground_motion(ops, tag, dt, duration, amplitude=0.3):
+   # a deterministic 0.5-5 Hz sweep with a build-up and decay envelope,
+   # so that every run of a benchmark does the same iterations
+   n = int(duration/dt) + 1
+   values = []
+   phase = 0.0
+   for i in range(n):
+      t = i*dt
+      f = 0.5 + 4.5*t/duration
+      phase += 2.0*pi*f*dt
+      envelope = (t/(0.2*duration))**2 if t < 0.2*duration else exp(-2.0*(t/duration - 0.2))
+      values.append(amplitude*envelope*sin(phase))
+   ops.timeSeries('Path', tag, '-dt', dt, '-values', *values, '-factor', 9.81)
+
+
+def transient(ops, numSteps, dt):
+   # one step at a time, so a step that fails to converge is counted and
+   # the benchmark carries on with the same number of steps
+   failed = 0
+   for i in range(numSteps):
+      if ops.analyze(1, dt) != 0:
+         failed += 1
+   return numSteps, failed
+
+
+def size(base, scale, power):
+   return max(1, int(round(base*scale**power)))
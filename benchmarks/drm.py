@@ -0,0 +1,70 @@
+"""Soil box of 8-node bricks loaded by the domain reduction method from
+an HDF5 DRM input file, 16384 elements at scale 1.
+
+The input is not part of the repository: set OPS_BENCHMARK_DRM_FILE to
+an H5DRM file for a 64 x 64 x 32 m box of 2 m elements, with the origin
+at a corner of its surface and z downwards. Without it, or in a build
+without HDF5, the benchmark is reported as skipped."""
+
+import os
+
+from common import transient, size
+
+numSteps = 200
+dt = 0.01
+
+
+def build(ops, scale, variant):
+   filename = os.environ.get('OPS_BENCHMARK_DRM_FILE')
+   if not filename or not os.path.exists(filename):
+      return 'OPS_BENCHMARK_DRM_FILE is not set'
+
+   # the box of the DRM file, only refined with the scale
+   refine = size(1, scale, 1.0/3)
+   nx = 32*refine
+   ny = 32*refine
+   nz = 16*refine
+   h = 2.0/refine
+   rho = 2.0
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 3)
+
+   def tag(i, j, k):
+      return 1 + i + j*(nx+1) + k*(nx+1)*(ny+1)
+
+   for k in range(nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.node(tag(i, j, k), i*h, j*h, -k*h)
+
+   # bedrock-like elastic box, kN, m, t
+   ops.nDMaterial('ElasticIsotropic', 1, 1.0e6, 0.25, rho)
+
+   eleTag = 1
+   for k in range(nz):
+      for j in range(ny):
+         for i in range(nx):
+            ops.element('stdBrick', eleTag,
+                        tag(i, j, k+1), tag(i+1, j, k+1), tag(i+1, j+1, k+1), tag(i, j+1, k+1),
+                        tag(i, j, k), tag(i+1, j, k), tag(i+1, j+1, k), tag(i, j+1, k), 1)
+            eleTag += 1
+
+   try:
+      ops.pattern('H5DRM', 1, filename, 1.0)
+   except Exception:
+      return 'H5DRM load pattern is not available'
+
+   ops.rayleigh(0.2, 0.0, 0.0, 0.001)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-6, 10)
+   ops.algorithm('Linear')
+   ops.integrator('Newmark', 0.5, 0.25)
+   ops.analysis('Transient', '-noWarnings')
+
+
+def run(ops, scale, variant):
+   return transient(ops, numSteps, dt)
@@ -0,0 +1,188 @@
+"""Times single elements outside of an analysis with the benchElement
+command: each element of ELEMENTS is built between synthetic nodes,
+driven by random trial displacements, and the nanoseconds of update,
+getTangentStiff, getResistingForce and commitState and the allocations
+per step are written as JSON, in the format of run.py so that --compare
+works the same way.
+
+   python element_bench.py --module path/to/OpenSeesPy.so --output elements.json
+   python element_bench.py --only forceBeamColumn dispBeamColumn --steps 5000
+   python element_bench.py --compare baseline.json --tolerance 0.1
+
+Allocations are only counted in a build with OPS_Benchmark_CountAllocations.
+"""
+
+import argparse
+import json
+import os
+import platform
+import sys
+
+from run import compare, load_opensees
+
+
+def fiber_section(ops, tag):
+   # a 300 x 500 reinforced concrete section, the beams use it with 5 points
+   ops.uniaxialMaterial('Concrete02', 1, -30.0, -0.002, -6.0, -0.005, 0.1, 3.0, 1500.0)
+   ops.uniaxialMaterial('Steel02', 2, 400.0, 200000.0, 0.01, 18.0, 0.925, 0.15)
+   ops.section('Fiber', tag, '-GJ', 1.0e10)
+   ops.patch('rect', 1, 10, 4, -250.0, -150.0, 250.0, 150.0)
+   ops.layer('straight', 2, 3, 491.0, 210.0, 110.0, 210.0, -110.0)
+   ops.layer('straight', 2, 3, 491.0, -210.0, 110.0, -210.0, -110.0)
+
+
+def frame_nodes(ops):
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+   ops.node(1, 0.0, 0.0, 0.0)
+   ops.node(2, 0.0, 0.0, 3000.0)
+   ops.geomTransf('Linear', 1, 1.0, 0.0, 0.0)
+
+
+def beam(kind):
+   def build(ops):
+      frame_nodes(ops)
+      fiber_section(ops, 1)
+      ops.beamIntegration('Lobatto', 1, 1, 5)
+      ops.element(kind, 1, 1, 2, 1, 1)
+   return build
+
+
+def timoshenko(ops):
+   frame_nodes(ops)
+   ops.element('ElasticTimoshenkoBeam', 1, 1, 2, 30000.0, 12500.0, 1.5e5, 2.0e9,
+               1.1e9, 3.1e9, 1.25e5, 1.25e5, 1)
+
+
+def quad(ops):
+   ops.model('basic', '-ndm', 2, '-ndf', 2)
+   for i, (x, y) in enumerate([(0.0, 0.0), (1.0, 0.0), (1.0, 1.0), (0.0, 1.0)]):
+      ops.node(i+1, x, y)
+   ops.nDMaterial('J2Plasticity', 1, 20000.0, 10000.0, 30.0, 40.0, 100.0, 0.0)
+   ops.element('quad', 1, 1, 2, 3, 4, 1.0, 'PlaneStrain', 1)
+
+
+def brick(ops):
+   ops.model('basic', '-ndm', 3, '-ndf', 3)
+   corners = [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0),
+              (0, 0, 1), (1, 0, 1), (1, 1, 1), (0, 1, 1)]
+   for i, c in enumerate(corners):
+      ops.node(i+1, *[float(x) for x in c])
+   ops.nDMaterial('J2Plasticity', 1, 20000.0, 10000.0, 30.0, 40.0, 100.0, 0.0)
+   ops.element('stdBrick', 1, 1, 2, 3, 4, 5, 6, 7, 8, 1)
+
+
+def shell(ops):
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+   for i, (x, y) in enumerate([(0.0, 0.0), (1000.0, 0.0), (1000.0, 1000.0), (0.0, 1000.0)]):
+      ops.node(i+1, x, y, 0.0)
+   ops.nDMaterial('ElasticIsotropic', 1, 30000.0, 0.2)
+   ops.nDMaterial('PlateFiber', 2, 1)
+   ops.section('LayeredShell', 1, 4, 2, 50.0, 2, 50.0, 2, 50.0, 2, 50.0)
+   ops.element('ShellMITC4', 1, 1, 2, 3, 4, 1)
+
+
+def beam_column_joint(ops):
+   # a 500 x 500 panel, nodes at the bottom, right, top and left faces
+   ops.model('basic', '-ndm', 2, '-ndf', 3)
+   for i, (x, y) in enumerate([(0.0, -250.0), (250.0, 0.0), (0.0, 250.0), (-250.0, 0.0)]):
+      ops.node(i+1, x, y)
+   ops.uniaxialMaterial('Steel01', 1, 400.0, 200000.0, 0.01)
+   ops.uniaxialMaterial('Steel01', 2, 4.0e7, 2.0e10, 0.01)
+   ops.element('beamColumnJoint', 1, 1, 2, 3, 4, *([1]*12 + [2]))
+
+
+def component(ops):
+   ops.model('basic', '-ndm', 2, '-ndf', 3)
+   ops.node(1, 0.0, 0.0)
+   ops.node(2, 0.0, 3000.0)
+   ops.geomTransf('Linear', 1)
+   ops.uniaxialMaterial('Steel01', 1, 2.0e8, 1.0e12, 0.02)
+   ops.element('componentElement', 1, 1, 2, 1.5e5, 30000.0, 3.1e9, 1, 1, 1)
+
+
+# name, how to build it between synthetic nodes, amplitude of the
+# trial displacements
+ELEMENTS = [
+   ('forceBeamColumn', beam('forceBeamColumn'), 10.0),
+   ('dispBeamColumn', beam('dispBeamColumn'), 10.0),
+   ('mixedBeamColumn', beam('mixedBeamColumn'), 10.0),
+   ('ElasticTimoshenkoBeam', timoshenko, 10.0),
+   ('quad', quad, 0.005),
+   ('stdBrick', brick, 0.005),
+   ('ShellMITC4', shell, 1.0),
+   ('beamColumnJoint', beam_column_joint, 0.5),
+   ('componentElement', component, 10.0),
+]
+
+
+def main():
+   names = [e[0] for e in ELEMENTS]
+   parser = argparse.ArgumentParser(description='OpenSees element benchmarks')
+   parser.add_argument('--module', help='path of the OpenSeesPy library to benchmark')
+   parser.add_argument('--only', nargs='+', choices=names)
+   parser.add_argument('--steps', type=int, default=2000)
+   parser.add_argument('--repeat', type=int, default=5)
+   parser.add_argument('--seed', type=int, default=12345)
+   parser.add_argument('--output', help='file for the JSON results')
+   parser.add_argument('--compare', help='earlier JSON results to compare with')
+   parser.add_argument('--tolerance', type=float, default=0.1,
+                       help='slowdown in steps/s reported as a regression')
+   args = parser.parse_args()
+
+   if args.module is not None:
+      args.module = os.path.abspath(args.module)
+   ops = load_opensees(args.module)
+
+   results = []
+   for name, build, amplitude in ELEMENTS:
+      if args.only and name not in args.only:
+         continue
+
+      ops.wipe()
+      try:
+         build(ops)
+         out = ops.benchElement(1, '-steps', args.steps, '-repeat', args.repeat,
+                                '-amplitude', amplitude, '-seed', args.seed)
+      except Exception as e:
+         results.append({'name': 'element_bench', 'variant': name, 'error': str(e)})
+         print('%-24s failed: %s' % (name, e))
+         continue
+
+      steps, update, tangent, force, commit, allocations = out
+      perStep = update + tangent + force + commit
+      results.append({'name': 'element_bench',
+                      'variant': name,
+                      'steps': int(steps),
+                      'ns_update': update,
+                      'ns_tangent': tangent,
+                      'ns_resisting_force': force,
+                      'ns_commit': commit,
+                      'allocations_per_step': allocations if allocations >= 0 else None,
+                      'steps_per_s': 1.0e9/perStep if perStep > 0 else 0.0})
+      print('%-24s %10.1f ns update %9.1f ns tangent %9.1f ns force %9.1f ns commit%s' %
+            (name, update, tangent, force, commit,
+             '' if allocations < 0 else ' %6.2f allocs/step' % allocations))
+
+   ops.wipe()
+
+   output = {'python': platform.python_version(),
+             'platform': platform.platform(),
+             'processor': platform.processor(),
+             'cpus': os.cpu_count(),
+             'benchmarks': results}
+
+   if args.output is not None:
+      with open(args.output, 'w') as f:
+         json.dump(output, f, indent=1)
+
+   if args.compare is not None:
+      with open(args.compare) as f:
+         baseline = json.load(f)
+      if compare(output, baseline, args.tolerance) > 0:
+         return 1
+
+   return 0
+
+
+if __name__ == '__main__':
+   sys.exit(main())
@@ -0,0 +1,81 @@
+"""Large linear elastic 3D frame, run once for each of the sparse
+solvers compared, about 10000 elements at scale 1. A solver that is not
+in the build is reported as skipped."""
+
+from common import size
+
+VARIANTS = ['BandSPD', 'ProfileSPD', 'SparseSYM', 'UmfPack', 'Mumps', 'Krylov']
+
+numSteps = 20
+
+
+def build(ops, scale, variant):
+   nx = size(10, scale, 1.0/3)
+   ny = size(10, scale, 1.0/3)
+   nz = size(30, scale, 1.0/3)
+   bay = 6.0
+   story = 3.5
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+
+   def tag(i, j, k):
+      return 1 + i + j*(nx+1) + k*(nx+1)*(ny+1)
+
+   for k in range(nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.node(tag(i, j, k), i*bay, j*bay, k*story)
+            if k == 0:
+               ops.fix(tag(i, j, k), 1, 1, 1, 1, 1, 1)
+
+   # kN, m
+   E = 30.0e6
+   G = 12.5e6
+   ops.geomTransf('Linear', 1, 1.0, 0.0, 0.0)
+   ops.geomTransf('Linear', 2, 0.0, 0.0, 1.0)
+
+   eleTag = 1
+   for k in range(nz):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.element('elasticBeamColumn', eleTag, tag(i, j, k), tag(i, j, k+1),
+                        0.36, E, G, 0.0183, 0.0108, 0.0108, 1)
+            eleTag += 1
+   for k in range(1, nz+1):
+      for j in range(ny+1):
+         for i in range(nx):
+            ops.element('elasticBeamColumn', eleTag, tag(i, j, k), tag(i+1, j, k),
+                        0.24, E, G, 0.0094, 0.0032, 0.0072, 2)
+            eleTag += 1
+      for j in range(ny):
+         for i in range(nx+1):
+            ops.element('elasticBeamColumn', eleTag, tag(i, j, k), tag(i, j+1, k),
+                        0.24, E, G, 0.0094, 0.0032, 0.0072, 2)
+            eleTag += 1
+
+   ops.timeSeries('Linear', 1)
+   ops.pattern('Plain', 1, 1)
+   for k in range(1, nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.load(tag(i, j, k), 10.0*k/nz, 5.0*k/nz, -200.0, 0.0, 0.0, 0.0)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   try:
+      ops.system(variant)
+   except Exception:
+      return 'system %s is not available' % variant
+   ops.test('NormUnbalance', 1.0e-6, 10, 0)
+   ops.algorithm('Linear')
+   ops.integrator('LoadControl', 1.0/numSteps)
+   ops.analysis('Static', '-noWarnings')
+
+
+def run(ops, scale, variant):
+   failed = 0
+   for i in range(numSteps):
+      if ops.analyze(1) != 0:
+         failed += 1
+   return numSteps, failed
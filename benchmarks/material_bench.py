@@ -0,0 +1,207 @@
+"""Times materials outside of an analysis with the benchMaterial command:
+each material of the suite file is driven through the standard strain
+protocols, and the nanoseconds per trial, commit and revert and the
+allocations per step are written as JSON, in the format of run.py so
+that --compare works the same way.
+
+   python material_bench.py --module path/to/OpenSeesPy.so --output materials.json
+   python material_bench.py --only Steel02 Concrete02 --protocol my_history.txt
+   python material_bench.py --compare baseline.json --tolerance 0.1
+
+Each line of the suite file is
+
+   uniaxial|nD|section  strainScale  name  arguments...
+
+and defines the material name with the tag 1 and the arguments. The
+protocols go up to a few times strainScale, the yield strain say.
+Allocations are only counted in a build with OPS_Benchmark_CountAllocations.
+"""
+
+import argparse
+import json
+import os
+import platform
+import sys
+import tempfile
+from math import pi, sin
+
+from run import compare, load_opensees
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+PROTOCOLS = ['monotonic', 'cyclic', 'random']
+
+
+def protocol(kind, numSteps):
+   # strains relative to the strain scale, deterministic so that every run
+   # does the same work
+   if kind == 'monotonic':
+      return [8.0*i/numSteps for i in range(1, numSteps+1)]
+   if kind == 'cyclic':
+      # cycles of 200 steps, two at each of 1, 2, ... 8 and back down
+      values = []
+      for i in range(numSteps):
+         c = i//200
+         level = (c//2) % 16
+         amplitude = 1 + (level if level < 8 else 15 - level)
+         values.append(amplitude*sin(2.0*pi*(i % 200 + 1)/200))
+      return values
+   # a linear congruential walk, bounded to +-8
+   values = []
+   x = 0.0
+   seed = 12345
+   for i in range(numSteps):
+      seed = (1103515245*seed + 12345) % 2147483648
+      x += 0.2*(seed/2147483648.0 - 0.5)
+      x = max(-8.0, min(8.0, x))
+      values.append(x)
+   return values
+
+
+def write_protocol(path, values, scale, numComp):
+   # the components of nD strains and section deformations follow the
+   # same history with different weights
+   weights = [1.0, -0.5, 0.3, 0.2, -0.1, 0.1][:numComp] + [0.1]*max(0, numComp-6)
+   with open(path, 'w') as f:
+      f.write('# %d components, scale %g\n' % (numComp, scale))
+      for v in values:
+         f.write(' '.join('%.12g' % (w*v*scale) for w in weights) + '\n')
+
+
+def read_suite(fileName):
+   suite = []
+   with open(fileName) as f:
+      for line in f:
+         words = line.split()
+         if not words or words[0].startswith('#'):
+            continue
+         args = []
+         for w in words[3:]:
+            try:
+               args.append(int(w) if w.lstrip('-').isdigit() else float(w))
+            except ValueError:
+               args.append(w)
+         suite.append((words[0], float(words[1]), words[2], args))
+   return suite
+
+
+def define(ops, kind, name, args):
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+   if kind == 'uniaxial':
+      ops.uniaxialMaterial(name, 1, *args)
+   elif kind == 'nD':
+      ops.nDMaterial(name, 1, *args)
+   else:
+      ops.section(name, 1, *args)
+
+
+def main():
+   parser = argparse.ArgumentParser(description='OpenSees material driver benchmarks')
+   parser.add_argument('--module', help='path of the OpenSeesPy library to benchmark')
+   parser.add_argument('--suite', default=os.path.join(here, 'materials.txt'),
+                       help='file with the materials to drive')
+   parser.add_argument('--only', nargs='+', help='names of the materials to drive')
+   parser.add_argument('--protocol', nargs='+',
+                       help='protocol files to use instead of the standard ones')
+   parser.add_argument('--steps', type=int, default=20000,
+                       help='steps of the standard protocols')
+   parser.add_argument('--repeat', type=int, default=5)
+   parser.add_argument('--output', help='file for the JSON results')
+   parser.add_argument('--compare', help='earlier JSON results to compare with')
+   parser.add_argument('--tolerance', type=float, default=0.1,
+                       help='slowdown in steps/s reported as a regression')
+   args = parser.parse_args()
+
+   if args.module is not None:
+      args.module = os.path.abspath(args.module)
+   ops = load_opensees(args.module)
+
+   tmp = tempfile.mkdtemp()
+   results = []
+   for kind, scale, name, matArgs in read_suite(args.suite):
+      if args.only and name not in args.only:
+         continue
+
+      try:
+         define(ops, kind, name, matArgs)
+      except Exception as e:
+         results.append({'name': name, 'variant': kind, 'skipped': str(e)})
+         print('%-40s skipped: %s' % (name, e))
+         continue
+
+      if args.protocol:
+         files = [(os.path.basename(p), p) for p in args.protocol]
+      else:
+         files = []
+         for p in PROTOCOLS:
+            values = protocol(p, args.steps)
+            numComp = 1 if kind == 'uniaxial' else None
+            files.append((p, values, numComp))
+
+      for entry in files:
+         if len(entry) == 2:
+            label, path = entry
+            candidates = [path]
+         else:
+            # the number of components of an nD material or a section is
+            # found by trying the usual sizes
+            label, values, numComp = entry
+            candidates = []
+            for n in ([numComp] if numComp else [1, 2, 3, 4, 5, 6]):
+               path = os.path.join(tmp, '%s_%s_%d.txt' % (name, label, n))
+               write_protocol(path, values, scale, n)
+               candidates.append(path)
+
+         out = None
+         for path in candidates:
+            try:
+               out = ops.benchMaterial(kind, 1, path, '-repeat', args.repeat)
+               break
+            except Exception:
+               continue
+
+         variant = '%s %s %s' % (kind, name, label)
+         if out is None:
+            results.append({'name': 'material_bench', 'variant': variant, 'error': 1})
+            print('%-40s failed' % variant)
+            continue
+
+         steps, trial, commit, revert, allocations = out
+         perStep = 2.0*trial + commit + revert
+         result = {'name': 'material_bench',
+                   'variant': variant,
+                   'steps': int(steps),
+                   'ns_trial': trial,
+                   'ns_commit': commit,
+                   'ns_revert': revert,
+                   'allocations_per_step': allocations if allocations >= 0 else None,
+                   'steps_per_s': 1.0e9/perStep if perStep > 0 else 0.0}
+         results.append(result)
+         print('%-40s %9.1f ns trial %8.1f ns commit %8.1f ns revert%s' %
+               (variant, trial, commit, revert,
+                '' if allocations < 0 else ' %6.2f allocs/step' % allocations))
+
+   ops.wipe()
+
+   output = {'python': platform.python_version(),
+             'platform': platform.platform(),
+             'processor': platform.processor(),
+             'cpus': os.cpu_count(),
+             'benchmarks': results}
+
+   if args.output is not None:
+      with open(args.output, 'w') as f:
+         json.dump(output, f, indent=1)
+
+   if args.compare is not None:
+      with open(args.compare) as f:
+         baseline = json.load(f)
+      if compare(output, baseline, args.tolerance) > 0:
+         return 1
+
+   return 0
+
+
+if __name__ == '__main__':
+   sys.exit(main())
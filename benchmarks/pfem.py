@@ -0,0 +1,65 @@
+"""Two-dimensional dam break with the particle finite element method,
+3200 fluid particles at scale 1."""
+
+from common import size
+
+numSteps = 100
+
+L = 0.146
+H = 2*L
+tank = 4*L
+rho = 1000.0
+mu = 1.0e-3
+g = -9.81
+
+
+def build(ops, scale, variant):
+   nx = size(40, scale, 0.5)
+   ny = 2*nx
+   h = L/nx
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 2, '-ndf', 2)
+
+   # fixed walls of the tank, the bottom and the two sides
+   wallNodes = []
+   nw = int(round(tank/h))
+   nd = 1
+   for i in range(nw+1):
+      ops.node(nd, i*h, 0.0)
+      wallNodes.append(nd)
+      nd += 1
+   for i in range(1, int(round(H/h))+1):
+      ops.node(nd, 0.0, i*h)
+      wallNodes.append(nd)
+      nd += 1
+      ops.node(nd, tank, i*h)
+      wallNodes.append(nd)
+      nd += 1
+   for tag in wallNodes:
+      ops.fix(tag, 1, 1)
+
+   # the column of water
+   ops.mesh('part', 1, 'quad', h/2, h/2, L, h/2, L, H, h/2, H, nx, ny,
+            'PFEMElementBubble', rho, mu, 0.0, g, 1.0, -1.0,
+            '-vel', 0.0, 0.0, '-pressure', 0.0)
+
+   ops.mesh('bg', h, -0.1*tank, -0.1*tank, 1.1*tank, 1.5*H,
+            '-structure', 0, len(wallNodes), *wallNodes)
+
+   ops.constraints('Plain')
+   ops.numberer('Plain')
+   ops.system('PFEM')
+   ops.test('PFEM', 1.0e-5, 1.0e-5, 1.0e-5, 1.0e-5, 1.0e-15, 1.0e-15, 20, 3, 0, 2)
+   ops.algorithm('Newton')
+   ops.integrator('PFEM')
+   ops.analysis('PFEM', 1.0e-3, 1.0e-4, g)
+
+
+def run(ops, scale, variant):
+   # each analyze is one step of the PFEM analysis, with remeshing
+   failed = 0
+   for i in range(numSteps):
+      if ops.analyze() != 0:
+         failed += 1
+   return numSteps, failed
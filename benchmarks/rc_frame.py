@@ -0,0 +1,109 @@
+"""3D reinforced concrete frame with force-based fiber beam-columns
+subjected to a ground motion, 520 elements at scale 1."""
+
+from common import ground_motion, transient, size
+
+numSteps = 200
+dt = 0.01
+
+
+def fiber_section(ops, tag, b, h, cover, numBars, barArea, GJ):
+   y = h/2.0
+   z = b/2.0
+   ops.section('Fiber', tag, '-GJ', GJ)
+   # confined core, unconfined cover and the top and bottom bars
+   ops.patch('rect', 2, 10, 8, cover-y, cover-z, y-cover, z-cover)
+   ops.patch('rect', 1, 10, 1, -y, -z, y, cover-z)
+   ops.patch('rect', 1, 10, 1, -y, z-cover, y, z)
+   ops.patch('rect', 1, 1, 8, -y, cover-z, cover-y, z-cover)
+   ops.patch('rect', 1, 1, 8, y-cover, cover-z, y, z-cover)
+   ops.layer('straight', 3, numBars, barArea, y-cover, z-cover, y-cover, cover-z)
+   ops.layer('straight', 3, numBars, barArea, cover-y, z-cover, cover-y, cover-z)
+
+
+def build(ops, scale, variant):
+   nx = size(4, scale, 1.0/3)
+   ny = size(4, scale, 1.0/3)
+   nz = size(8, scale, 1.0/3)
+   bay = 6.0
+   story = 3.5
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+
+   def tag(i, j, k):
+      return 1 + i + j*(nx+1) + k*(nx+1)*(ny+1)
+
+   # about 0.8 t/m2 of floor at each node
+   mass = 0.8*bay*bay
+   for k in range(nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.node(tag(i, j, k), i*bay, j*bay, k*story)
+            if k == 0:
+               ops.fix(tag(i, j, k), 1, 1, 1, 1, 1, 1)
+            else:
+               ops.mass(tag(i, j, k), mass, mass, mass, 0.0, 0.0, 0.0)
+
+   # kN, m
+   ops.uniaxialMaterial('Concrete01', 1, -30.0e3, -0.002, -6.0e3, -0.006)
+   ops.uniaxialMaterial('Concrete01', 2, -39.0e3, -0.003, -30.0e3, -0.02)
+   ops.uniaxialMaterial('Steel02', 3, 420.0e3, 200.0e6, 0.01, 18.0, 0.925, 0.15)
+   fiber_section(ops, 1, 0.6, 0.6, 0.04, 4, 5.1e-4, 1.0e5)
+   fiber_section(ops, 2, 0.4, 0.6, 0.04, 3, 5.1e-4, 1.0e5)
+
+   ops.geomTransf('PDelta', 1, 1.0, 0.0, 0.0)
+   ops.geomTransf('Linear', 2, 0.0, 0.0, 1.0)
+   ops.beamIntegration('Lobatto', 1, 1, 5)
+   ops.beamIntegration('Lobatto', 2, 2, 5)
+
+   eleTag = 1
+   for k in range(nz):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.element('forceBeamColumn', eleTag, tag(i, j, k), tag(i, j, k+1), 1, 1)
+            eleTag += 1
+   for k in range(1, nz+1):
+      for j in range(ny+1):
+         for i in range(nx):
+            ops.element('forceBeamColumn', eleTag, tag(i, j, k), tag(i+1, j, k), 2, 2)
+            eleTag += 1
+      for j in range(ny):
+         for i in range(nx+1):
+            ops.element('forceBeamColumn', eleTag, tag(i, j, k), tag(i, j+1, k), 2, 2)
+            eleTag += 1
+
+   # gravity
+   ops.timeSeries('Linear', 1)
+   ops.pattern('Plain', 1, 1)
+   for k in range(1, nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            ops.load(tag(i, j, k), 0.0, 0.0, -mass*9.81, 0.0, 0.0, 0.0)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-8, 20)
+   ops.algorithm('Newton')
+   ops.integrator('LoadControl', 0.1)
+   ops.analysis('Static', '-noWarnings')
+   ops.analyze(10)
+   ops.loadConst('-time', 0.0)
+   ops.wipeAnalysis()
+
+   ground_motion(ops, 2, dt, numSteps*dt)
+   ops.pattern('UniformExcitation', 2, 1, '-accel', 2)
+   ops.rayleigh(0.2, 0.0, 0.0, 0.002)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-8, 20)
+   ops.algorithm('Newton')
+   ops.integrator('Newmark', 0.5, 0.25)
+   ops.analysis('Transient', '-noWarnings')
+
+
+def run(ops, scale, variant):
+   return transient(ops, numSteps, dt)
@@ -0,0 +1,196 @@
+"""Runs the performance benchmarks and writes their results as JSON.
+
+Each benchmark runs in its own process, so that its peak resident set
+size is its own, and reports the number of analysis steps per second,
+the time of the analysis phases from the profile command and the peak
+RSS. With --compare the results are checked against an earlier output
+file and the run fails when a benchmark got slower than the tolerance.
+
+   python run.py --module path/to/OpenSeesPy.so --output results.json
+   python run.py --only rc_frame pfem --scale 0.5
+   python run.py --compare baseline.json --tolerance 0.1
+"""
+
+import argparse
+import importlib
+import importlib.machinery
+import importlib.util
+import json
+import os
+import platform
+import subprocess
+import sys
+import time
+
+BENCHMARKS = ['rc_frame', 'soil_pimy', 'shell_core', 'linear_frame', 'pfem', 'drm',
+              'backbone_cyclic']
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+
+def load_opensees(module):
+   # the target builds OpenSeesPy.so but the module is named opensees
+   if module is None:
+      try:
+         import opensees as ops
+      except ModuleNotFoundError:
+         import openseespy.opensees as ops
+      return ops
+
+   loader = importlib.machinery.ExtensionFileLoader('opensees', module)
+   spec = importlib.util.spec_from_file_location('opensees', module, loader=loader)
+   ops = importlib.util.module_from_spec(spec)
+   loader.exec_module(ops)
+   sys.modules['opensees'] = ops
+   return ops
+
+
+def peak_rss_mb():
+   try:
+      import resource
+   except ImportError:
+      return None
+   rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+   # kilobytes on Linux, bytes on macOS
+   if sys.platform == 'darwin':
+      return rss/1048576.0
+   return rss/1024.0
+
+
+def run_single(name, variant, scale, module, classes):
+   ops = load_opensees(module)
+   sys.path.insert(0, here)
+   bench = importlib.import_module(name)
+
+   start = time.perf_counter()
+   skip = bench.build(ops, scale, variant)
+   build_time = time.perf_counter() - start
+   if skip:
+      return {'name': name, 'variant': variant, 'skipped': skip}
+
+   ops.profile('reset')
+   if classes:
+      ops.profile('on', '-classes')
+   else:
+      ops.profile('on')
+   start = time.perf_counter()
+   steps, failed = bench.run(ops, scale, variant)
+   wall = time.perf_counter() - start
+   ops.profile('off')
+   profile = json.loads(ops.profile('-json'))
+   ops.wipe()
+
+   return {'name': name,
+           'variant': variant,
+           'scale': scale,
+           'build_time': build_time,
+           'wall_time': wall,
+           'steps': steps,
+           'failed': failed,
+           'steps_per_s': steps/wall if wall > 0 else 0.0,
+           'profile': profile,
+           'peak_rss_mb': peak_rss_mb()}
+
+
+def run_all(args):
+   sys.path.insert(0, here)
+   results = []
+   for name in args.only or BENCHMARKS:
+      variants = getattr(importlib.import_module(name), 'VARIANTS', [None])
+      for variant in variants:
+         label = name if variant is None else '%s[%s]' % (name, variant)
+         cmd = [sys.executable, os.path.abspath(__file__), '--single', name,
+                '--scale', str(args.scale)]
+         if variant is not None:
+            cmd += ['--variant', variant]
+         if args.module is not None:
+            cmd += ['--module', args.module]
+         if args.classes:
+            cmd += ['--classes']
+
+         proc = subprocess.run(cmd, stdout=subprocess.PIPE, universal_newlines=True)
+         lines = proc.stdout.strip().splitlines()
+         if proc.returncode != 0 or not lines:
+            result = {'name': name, 'variant': variant, 'error': proc.returncode}
+            print('%-28s failed with exit code %d' % (label, proc.returncode))
+         else:
+            # the model may print to stdout too, the result is the last line
+            result = json.loads(lines[-1])
+            if 'skipped' in result:
+               print('%-28s skipped: %s' % (label, result['skipped']))
+            else:
+               print('%-28s %10.2f steps/s %10.1f MB' %
+                     (label, result['steps_per_s'], result['peak_rss_mb'] or 0.0))
+         results.append(result)
+
+   return {'python': platform.python_version(),
+           'platform': platform.platform(),
+           'processor': platform.processor(),
+           'cpus': os.cpu_count(),
+           'scale': args.scale,
+           'benchmarks': results}
+
+
+def compare(output, baseline, tolerance):
+   def key(r):
+      return (r['name'], r.get('variant'))
+
+   old = dict((key(r), r) for r in baseline['benchmarks'] if 'steps_per_s' in r)
+   slower = 0
+   for r in output['benchmarks']:
+      if 'steps_per_s' not in r or key(r) not in old:
+         continue
+      before = old[key(r)]['steps_per_s']
+      if before <= 0:
+         continue
+      change = r['steps_per_s']/before - 1.0
+      flag = ''
+      if change < -tolerance:
+         flag = '  SLOWER'
+         slower += 1
+      label = r['name'] if r.get('variant') is None else '%s[%s]' % key(r)
+      print('%-28s %+7.1f%%%s' % (label, 100.0*change, flag))
+
+   return slower
+
+
+def main():
+   parser = argparse.ArgumentParser(description='OpenSees performance benchmarks')
+   parser.add_argument('--module', help='path of the OpenSeesPy library to benchmark')
+   parser.add_argument('--scale', type=float, default=1.0,
+                       help='size of the models relative to the default')
+   parser.add_argument('--only', nargs='+', choices=BENCHMARKS)
+   parser.add_argument('--output', help='file for the JSON results')
+   parser.add_argument('--compare', help='earlier JSON results to compare with')
+   parser.add_argument('--tolerance', type=float, default=0.1,
+                       help='slowdown in steps/s reported as a regression')
+   parser.add_argument('--classes', action='store_true',
+                       help='also profile the element and material classes')
+   parser.add_argument('--single', help=argparse.SUPPRESS)
+   parser.add_argument('--variant', help=argparse.SUPPRESS)
+   args = parser.parse_args()
+
+   if args.module is not None:
+      args.module = os.path.abspath(args.module)
+
+   if args.single is not None:
+      result = run_single(args.single, args.variant, args.scale, args.module, args.classes)
+      sys.stdout.write('\n' + json.dumps(result) + '\n')
+      return 0
+
+   output = run_all(args)
+   if args.output is not None:
+      with open(args.output, 'w') as f:
+         json.dump(output, f, indent=1)
+
+   if args.compare is not None:
+      with open(args.compare) as f:
+         baseline = json.load(f)
+      if compare(output, baseline, args.tolerance) > 0:
+         return 1
+
+   return 0
+
+
+if __name__ == '__main__':
+   sys.exit(main())
@@ -0,0 +1,90 @@
+"""Reinforced concrete core of four walls of layered MITC4 shells pushed
+over under displacement control, 320 elements at scale 1."""
+
+from common import size
+
+numSteps = 100
+
+
+def build(ops, scale, variant):
+   ne = size(4, scale, 1.0/3)
+   nz = size(10, scale, 1.0/3)
+   nh = 2
+   a = 6.0
+   story = 3.0
+   numRing = 4*ne
+   numLevels = nz*nh
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 6)
+
+   def tag(p, l):
+      return 1 + p % numRing + l*numRing
+
+   for l in range(numLevels+1):
+      z = l*story/nh
+      for p in range(numRing):
+         side = p//ne
+         t = (p % ne)*a/ne
+         x, y = [(t - a/2, -a/2), (a/2, t - a/2), (a/2 - t, a/2), (-a/2, a/2 - t)][side]
+         ops.node(tag(p, l), x, y, z)
+         if l == 0:
+            ops.fix(tag(p, l), 1, 1, 1, 1, 1, 1)
+
+   # kN, m
+   ops.nDMaterial('J2Plasticity', 1, 1.4e7, 1.1e7, 3.0e4, 3.5e4, 10.0, 0.0)
+   ops.nDMaterial('PlateFiber', 2, 1)
+   ops.uniaxialMaterial('Steel02', 3, 420.0e3, 200.0e6, 0.01, 18.0, 0.925, 0.15)
+   ops.nDMaterial('PlateRebar', 4, 3, 90.0)
+   ops.nDMaterial('PlateRebar', 5, 3, 0.0)
+   ops.section('LayeredShell', 1, 8,
+               2, 0.03, 4, 0.0015, 5, 0.0015, 2, 0.117,
+               2, 0.117, 5, 0.0015, 4, 0.0015, 2, 0.03)
+
+   eleTag = 1
+   for l in range(numLevels):
+      for p in range(numRing):
+         ops.element('ShellMITC4', eleTag, tag(p, l), tag(p+1, l),
+                     tag(p+1, l+1), tag(p, l+1), 1)
+         eleTag += 1
+
+   # gravity
+   ops.timeSeries('Linear', 1)
+   ops.pattern('Plain', 1, 1)
+   for k in range(1, nz+1):
+      for p in range(numRing):
+         ops.load(tag(p, k*nh), 0.0, 0.0, -50.0, 0.0, 0.0, 0.0)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-6, 50)
+   ops.algorithm('Newton')
+   ops.integrator('LoadControl', 0.1)
+   ops.analysis('Static', '-noWarnings')
+   ops.analyze(10)
+   ops.loadConst('-time', 0.0)
+   ops.wipeAnalysis()
+
+   # lateral loads in proportion to the height, pushed to a 1% drift
+   ops.timeSeries('Linear', 2)
+   ops.pattern('Plain', 2, 2)
+   for k in range(1, nz+1):
+      for p in range(numRing):
+         ops.load(tag(p, k*nh), k/float(nz), 0.0, 0.0, 0.0, 0.0, 0.0)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-6, 50)
+   ops.algorithm('Newton')
+   ops.integrator('DisplacementControl', tag(0, numLevels), 1, 0.01*nz*story/numSteps)
+   ops.analysis('Static', '-noWarnings')
+
+
+def run(ops, scale, variant):
+   failed = 0
+   for i in range(numSteps):
+      if ops.analyze(1) != 0:
+         failed += 1
+   return numSteps, failed
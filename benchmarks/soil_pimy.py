@@ -0,0 +1,79 @@
+"""Block of soil of 8-node bricks with the PressureIndependMultiYield
+material, gravity then shaken at the base, 640 elements at scale 1."""
+
+from common import ground_motion, transient, size
+
+numSteps = 200
+dt = 0.01
+
+
+def build(ops, scale, variant):
+   nx = size(8, scale, 1.0/3)
+   ny = size(8, scale, 1.0/3)
+   nz = size(10, scale, 1.0/3)
+   h = 1.0
+   rho = 1.8
+
+   ops.wipe()
+   ops.model('basic', '-ndm', 3, '-ndf', 3)
+
+   def tag(i, j, k):
+      return 1 + i + j*(nx+1) + k*(nx+1)*(ny+1)
+
+   for k in range(nz+1):
+      for j in range(ny+1):
+         for i in range(nx+1):
+            nd = tag(i, j, k)
+            ops.node(nd, i*h, j*h, k*h)
+            if k == 0:
+               ops.fix(nd, 1, 1, 1)
+            elif j == 0 or j == ny:
+               ops.fix(nd, 0, 1, 0)
+
+   # the two sides normal to the shaking move together
+   for k in range(1, nz+1):
+      for j in range(ny+1):
+         ops.equalDOF(tag(0, j, k), tag(nx, j, k), 1, 3)
+
+   # kN, m, t
+   ops.nDMaterial('PressureIndependMultiYield', 1, 3, rho, 6.0e4, 2.4e5, 30.0, 0.1)
+
+   eleTag = 1
+   for k in range(nz):
+      for j in range(ny):
+         for i in range(nx):
+            ops.element('stdBrick', eleTag,
+                        tag(i, j, k), tag(i+1, j, k), tag(i+1, j+1, k), tag(i, j+1, k),
+                        tag(i, j, k+1), tag(i+1, j, k+1), tag(i+1, j+1, k+1), tag(i, j+1, k+1),
+                        1, 0.0, 0.0, -9.81*rho)
+            eleTag += 1
+
+   # gravity, elastic and then plastic, with large time steps
+   ops.constraints('Penalty', 1.0e12, 1.0e12)
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-5, 30)
+   ops.algorithm('Newton')
+   ops.integrator('Newmark', 0.5, 0.25)
+   ops.analysis('Transient', '-noWarnings')
+   ops.analyze(10, 5.0e2)
+   ops.updateMaterialStage('-material', 1, '-stage', 1)
+   ops.analyze(10, 5.0e2)
+   ops.setTime(0.0)
+   ops.wipeAnalysis()
+
+   ground_motion(ops, 1, dt, numSteps*dt)
+   ops.pattern('UniformExcitation', 1, 1, '-accel', 1)
+   ops.rayleigh(0.1, 0.0, 0.0, 0.002)
+
+   ops.constraints('Penalty', 1.0e12, 1.0e12)
+   ops.numberer('RCM')
+   ops.system('UmfPack')
+   ops.test('NormDispIncr', 1.0e-5, 30)
+   ops.algorithm('Newton')
+   ops.integrator('Newmark', 0.6, 0.3025)
+   ops.analysis('Transient', '-noWarnings')
+
+
+def run(ops, scale, variant):
+   return transient(ops, numSteps, dt)
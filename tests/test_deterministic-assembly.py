@@ -0,0 +1,82 @@
+try:
+   import opensees as ops
+except ModuleNotFoundError:
+   import openseespy.opensees as ops
+from math import isclose
+
+# a frame of elastic beams of different lengths and sections, with member
+# loads, so that each element gives its own stiffness and residual; the
+# FullGeneral SOE cannot be added to concurrently, so the deterministic
+# parallel assembly forms the elements in parallel & adds them in order
+
+NUM_BAYS = 6
+NUM_STORIES = 4
+
+def frame_system(parallel):
+   ops.wipe()
+   ops.model('basic','-ndm',2,'-ndf',3)
+
+   for j in range(NUM_STORIES+1):
+      for i in range(NUM_BAYS+1):
+         ops.node(j*(NUM_BAYS+1)+i+1, 100.0*i + 7.0*i*i, 120.0*j + 5.0*i*j)
+   for i in range(NUM_BAYS+1):
+      ops.fix(i+1,1,1,1)
+
+   ops.geomTransf('Linear',1)
+   ops.timeSeries('Linear',1)
+   ops.pattern('Plain',1,1)
+
+   tag = 0
+   for j in range(NUM_STORIES):
+      for i in range(NUM_BAYS+1):
+         tag += 1
+         nd = j*(NUM_BAYS+1)+i+1
+         ops.element('elasticBeamColumn',tag,nd,nd+NUM_BAYS+1,20.0+i,29000.0,800.0+10.0*tag,1)
+         ops.eleLoad('-ele',tag,'-type','-beamUniform',0.01*tag)
+      for i in range(NUM_BAYS):
+         tag += 1
+         nd = (j+1)*(NUM_BAYS+1)+i+1
+         ops.element('elasticBeamColumn',tag,nd,nd+1,15.0+j,29000.0,600.0+5.0*tag,1)
+         ops.eleLoad('-ele',tag,'-type','-beamUniform',-0.02*tag,0.001*tag)
+
+   if parallel:
+      ops.setParallelUpdate(1,'-deterministic',1)
+   else:
+      ops.setParallelUpdate(0)
+
+   ops.system('FullGeneral')
+   ops.numberer('Plain')
+   ops.constraints('Plain')
+   ops.integrator('LoadControl',1.0)
+   ops.algorithm('Linear')
+   ops.analysis('Static','-noWarnings')
+   ops.analyze(1)
+
+   A = ops.printA('-ret')
+   B = ops.printB('-ret')
+   U = [u for nd in ops.getNodeTags() for u in ops.nodeDisp(nd)]
+   ops.setParallelUpdate(0)
+   return A, B, U
+
+def assert_same(a, b, abs_tol=0.0):
+   assert len(a) == len(b) and len(a) > 0
+   scale = max(abs(x) for x in a)
+   for x, y in zip(a, b):
+      assert isclose(x, y, rel_tol=1e-12, abs_tol=max(abs_tol, 1e-12*scale))
+
+def test_deterministic_tangent():
+   A_serial, _, _ = frame_system(False)
+   A_parallel, _, _ = frame_system(True)
+   assert_same(A_serial, A_parallel)
+
+def test_deterministic_residual():
+   # the unbalance is zero but for round off once the step has converged,
+   # the loads are of order 1
+   _, B_serial, U_serial = frame_system(False)
+   _, B_parallel, U_parallel = frame_system(True)
+   assert_same(B_serial, B_parallel, 1e-8)
+   assert_same(U_serial, U_parallel)
+
+if __name__ == '__main__':
+   test_deterministic_tangent()
+   test_deterministic_residual()
@@ -0,0 +1,43 @@
+try:
+   import opensees as ops
+except ModuleNotFoundError:
+   import openseespy.opensees as ops
+
+# the domain storage grows at 8, 16, 32, ... components; removing and
+# re-adding every tag covers the tags added as the table grew
+
+N = 100
+
+def define_model():
+   ops.wipe()
+   ops.model('basic','-ndm',1,'-ndf',1)
+   ops.uniaxialMaterial('Elastic',1,1.0)
+
+   for i in range(N+1):
+      ops.node(i+1,float(i))
+   for i in range(N):
+      ops.element('zeroLength',i+1,i+1,i+2,'-mat',1,'-dir',1)
+
+def test_readd_elements():
+   define_model()
+
+   for i in range(N):
+      ops.remove('element',i+1)
+      ops.element('zeroLength',i+1,i+1,i+2,'-mat',1,'-dir',1)
+
+   assert len(ops.getEleTags()) == N
+
+def test_readd_nodes():
+   define_model()
+
+   for i in range(N):
+      ops.remove('element',i+1)
+   for i in range(N+1):
+      ops.remove('node',i+1)
+      ops.node(i+1,float(i))
+
+   assert len(ops.getNodeTags()) == N+1
+
+if __name__ == '__main__':
+   test_readd_elements()
+   test_readd_nodes()